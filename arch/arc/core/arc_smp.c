@@ -108,6 +108,17 @@ void arch_sched_ipi(void)
 	}
 }
 
+void arch_sched_ipi_mask(uint32_t cpu_mask)
+{
+	uint32_t i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu_mask & BIT(i)) != 0) {
+			z_arc_connect_ici_generate(i);
+		}
+	}
+}
+
 static int arc_smp_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -69,6 +69,8 @@ extern void z_arc_fatal_error(unsigned int reason, const z_arch_esf_t *esf);
 
 extern void arch_sched_ipi(void);
 
+extern void arch_sched_ipi_mask(uint32_t cpu_mask);
+
 extern void z_arc_switch(void *switch_to, void **switched_from);
 
 static inline void arch_switch(void *switch_to, void **switched_from)
@@ -20,6 +20,43 @@ static void mpu_init(void)
 	/* No specific configuration at init for ARMv7-M MPU. */
 }
 
+/* Region registers as last written by the driver. The dynamic regions are
+ * reprogrammed on every context switch, but usually only the ones of the
+ * thread stacks change: the others, e.g. the memory domain partitions of
+ * threads of the same domain, are left alone.
+ */
+#define MPU_REGIONS_CACHE_NUM 16
+
+static struct {
+	uint32_t rbar;
+	uint32_t rasr;
+} mpu_regions_cache[MPU_REGIONS_CACHE_NUM];
+
+/* Regions of mpu_regions_cache holding a value, the MPU may have been
+ * programmed before boot.
+ */
+static uint32_t mpu_regions_cached;
+
+static bool region_cache_update(const uint32_t index, uint32_t rbar,
+	uint32_t rasr)
+{
+	if (index >= MPU_REGIONS_CACHE_NUM) {
+		return true;
+	}
+
+	if ((mpu_regions_cached & BIT(index)) != 0U &&
+	    mpu_regions_cache[index].rbar == rbar &&
+	    mpu_regions_cache[index].rasr == rasr) {
+		return false;
+	}
+
+	mpu_regions_cache[index].rbar = rbar;
+	mpu_regions_cache[index].rasr = rasr;
+	mpu_regions_cached |= BIT(index);
+
+	return true;
+}
+
 /* This internal function performs MPU region initialization.
  *
  * Note:
@@ -28,16 +65,32 @@ static void mpu_init(void)
 static void region_init(const uint32_t index,
 	const struct arm_mpu_region *region_conf)
 {
+	uint32_t rbar = (region_conf->base & MPU_RBAR_ADDR_Msk)
+				| MPU_RBAR_VALID_Msk | index;
+	uint32_t rasr = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+
+	if (!region_cache_update(index, rbar, rasr)) {
+		/* Already programmed */
+		return;
+	}
+
 	/* Select the region you want to access */
 	MPU->RNR = index;
 	/* Configure the region */
-	MPU->RBAR = (region_conf->base & MPU_RBAR_ADDR_Msk)
-				| MPU_RBAR_VALID_Msk | index;
-	MPU->RASR = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+	MPU->RBAR = rbar;
+	MPU->RASR = rasr;
 	LOG_DBG("[%d] 0x%08x 0x%08x",
 		index, region_conf->base, region_conf->attr.rasr);
 }
 
+/* This internal function disables an MPU region, unless it already is. */
+static void region_clear(const uint32_t index)
+{
+	if (region_cache_update(index, 0U, 0U)) {
+		ARM_MPU_ClrRegion(index);
+	}
+}
+
 /* @brief Partition sanity check
  *
  * This internal function performs run-time sanity check for
@@ -342,7 +395,7 @@ static int mpu_configure_dynamic_mpu_regions(const struct k_mem_partition
 
 		/* Disable the non-programmed MPU regions. */
 		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
-			ARM_MPU_ClrRegion(i);
+			region_clear(i);
 		}
 	}
 
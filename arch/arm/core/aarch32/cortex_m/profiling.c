@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM Cortex-M interrupted context lookup for the sampling profiler
+ */
+
+#include <kernel.h>
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+#include <errno.h>
+
+int arch_profiling_pc_get(uintptr_t *pc, uintptr_t *caller)
+{
+	const z_arch_esf_t *esf;
+
+	/* Threads run on the process stack, the frame stacked on interrupt
+	 * entry is found there as long as no other exception is active.
+	 */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U) {
+		return -EBUSY;
+	}
+
+	esf = (const z_arch_esf_t *)__get_PSP();
+	*pc = esf->basic.pc;
+	*caller = esf->basic.lr;
+
+	return 0;
+}
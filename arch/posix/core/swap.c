@@ -50,8 +50,8 @@ int arch_swap(unsigned int key)
 
 
 	_current = _kernel.ready_q.cache;
-#if CONFIG_TRACING
-	sys_trace_thread_switched_in();
+#if defined(CONFIG_TRACING) || defined(CONFIG_THREAD_RUNTIME_STATS)
+	z_thread_mark_switched_in();
 #endif
 
 	/*
@@ -93,7 +93,7 @@ void arch_switch_to_main_thread(struct k_thread *main_thread, char *stack_ptr,
 
 	_current = _kernel.ready_q.cache;
 
-	sys_trace_thread_switched_in();
+	z_thread_mark_switched_in();
 
 	posix_main_thread_start(ready_thread_ptr->thread_idx);
 } /* LCOV_EXCL_LINE */
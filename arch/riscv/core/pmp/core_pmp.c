@@ -139,6 +139,27 @@ void csr_write_enum(int pmp_csr_enum, ulong_t value)
 	}
 }
 
+/*
+ * PMP CSRs as last written, so that only the ones which change are written
+ * when the PMP is reprogrammed for the incoming thread: most entries, e.g.
+ * the ones of the memory domain partitions, stay the same between threads.
+ * Locked entries ignore writes, skipping them changes nothing.
+ */
+static ulong_t pmp_csr_shadow[CSR_PMPADDR15 + 1];
+static uint32_t pmp_csr_shadowed;
+
+static void pmp_csr_write(int pmp_csr_enum, ulong_t value)
+{
+	if (((pmp_csr_shadowed & BIT(pmp_csr_enum)) != 0U) &&
+	    (pmp_csr_shadow[pmp_csr_enum] == value)) {
+		return;
+	}
+
+	pmp_csr_shadow[pmp_csr_enum] = value;
+	pmp_csr_shadowed |= BIT(pmp_csr_enum);
+	csr_write_enum(pmp_csr_enum, value);
+}
+
 int z_riscv_pmp_set(unsigned int index, ulong_t cfg_val, ulong_t addr_val)
 {
 	ulong_t reg_val;
@@ -170,8 +191,8 @@ int z_riscv_pmp_set(unsigned int index, ulong_t cfg_val, ulong_t addr_val)
 	reg_val = reg_val & ~mask;
 	reg_val = reg_val | cfg_val;
 
-	csr_write_enum(pmpaddr_csr, addr_val);
-	csr_write_enum(pmpcfg_csr, reg_val);
+	pmp_csr_write(pmpaddr_csr, addr_val);
+	pmp_csr_write(pmpcfg_csr, reg_val);
 	return 0;
 }
 
@@ -204,7 +225,7 @@ int pmp_get(unsigned int index, ulong_t *cfg_val, ulong_t *addr_val)
 void z_riscv_pmp_clear_config(void)
 {
 	for (unsigned int i = 0; i < RISCV_PMP_CFG_NUM; i++)
-		csr_write_enum(CSR_PMPCFG0 + i, 0);
+		pmp_csr_write(CSR_PMPCFG0 + i, 0);
 }
 
 /* Function to help debug */
@@ -275,13 +296,12 @@ void z_riscv_configure_user_allowed_stack(struct k_thread *thread)
 {
 	unsigned int i;
 
-	z_riscv_pmp_clear_config();
-
+	/* All the configuration CSRs are written, no need to clear them */
 	for (i = 0; i < CONFIG_PMP_SLOT; i++)
-		csr_write_enum(CSR_PMPADDR0 + i, thread->arch.u_pmpaddr[i]);
+		pmp_csr_write(CSR_PMPADDR0 + i, thread->arch.u_pmpaddr[i]);
 
 	for (i = 0; i < RISCV_PMP_CFG_NUM; i++)
-		csr_write_enum(CSR_PMPCFG0 + i, thread->arch.u_pmpcfg[i]);
+		pmp_csr_write(CSR_PMPCFG0 + i, thread->arch.u_pmpcfg[i]);
 }
 
 void z_riscv_pmp_add_dynamic(struct k_thread *thread,
@@ -532,6 +552,15 @@ void arch_mem_domain_partition_add(struct k_mem_domain *domain,
 	}
 }
 
+/* The PMP registers of the threads are updated on every change */
+void arch_mem_domain_update_begin(struct k_mem_domain *domain)
+{
+}
+
+void arch_mem_domain_update_end(struct k_mem_domain *domain)
+{
+}
+
 void arch_mem_domain_thread_remove(struct k_thread *thread)
 {
 	uint32_t i;
@@ -604,13 +633,15 @@ void z_riscv_configure_stack_guard(struct k_thread *thread)
 	/* Disable PMP for machine mode */
 	csr_clear(mstatus, MSTATUS_MPRV);
 
-	z_riscv_pmp_clear_config();
-
 	for (i = 0; i < PMP_REGION_NUM_FOR_STACK_GUARD; i++)
-		csr_write_enum(CSR_PMPADDR1 + i, thread->arch.s_pmpaddr[i]);
+		pmp_csr_write(CSR_PMPADDR1 + i, thread->arch.s_pmpaddr[i]);
 
 	for (i = 0; i < PMP_CFG_CSR_NUM_FOR_STACK_GUARD; i++)
-		csr_write_enum(CSR_PMPCFG0 + i, thread->arch.s_pmpcfg[i]);
+		pmp_csr_write(CSR_PMPCFG0 + i, thread->arch.s_pmpcfg[i]);
+
+	/* The remaining entries are disabled */
+	for (; i < RISCV_PMP_CFG_NUM; i++)
+		pmp_csr_write(CSR_PMPCFG0 + i, 0);
 
 	/* Enable PMP for machine mode */
 	csr_set(mstatus, MSTATUS_MPRV);
@@ -10,6 +10,7 @@
 #include <exc_handle.h>
 #include <logging/log.h>
 #include <x86_mmu.h>
+#include <mmu.h>
 LOG_MODULE_DECLARE(os);
 
 #if defined(CONFIG_BOARD_QEMU_X86) || defined(CONFIG_BOARD_QEMU_X86_64)
@@ -43,7 +44,7 @@ static inline uintptr_t esf_get_sp(const z_arch_esf_t *esf)
 }
 #endif
 
-#ifdef CONFIG_EXCEPTION_DEBUG
+#if defined(CONFIG_EXCEPTION_DEBUG) || defined(CONFIG_DEMAND_PAGING)
 static inline uintptr_t esf_get_code(const z_arch_esf_t *esf)
 {
 #ifdef CONFIG_X86_64
@@ -376,6 +377,19 @@ void z_x86_page_fault_handler(z_arch_esf_t *esf)
 #if !defined(CONFIG_X86_64) && defined(CONFIG_DEBUG_COREDUMP)
 	z_x86_exception_vector = IV_PAGE_FAULT;
 #endif
+#ifdef CONFIG_DEMAND_PAGING
+	/* Non-present page, possibly paged out. The error code Present bit
+	 * is clear then.
+	 */
+	if ((esf_get_code(esf) & BIT(0)) == 0U) {
+		uintptr_t cr2;
+
+		__asm__ ("mov %%cr2, %0" : "=r" (cr2));
+		if (z_page_fault((void *)cr2)) {
+			return;
+		}
+	}
+#endif
 
 #ifdef CONFIG_USERSPACE
 	int i;
@@ -41,6 +41,13 @@
  * sharing. All other threads have CR0[TS] set to 1 so that an attempt
  * to perform an FP operation will cause an exception, allowing the kernel
  * to enable FP register sharing on its behalf.
+ *
+ * With CONFIG_LAZY_FPU_SWITCH, CR0[TS] is only 0 for the thread owning the
+ * FPU. An FP-capable thread which does not own it traps the same way on
+ * its first FP operation, and the exception handler moves the FP context
+ * in and out of the TCSes: the owner's context is saved if it was switched
+ * out preemptively, and the saved context of the current thread, if any,
+ * is restored (X86_THREAD_FLAG_FP_SAVED).
  */
 
 #include <kernel.h>
@@ -136,6 +143,42 @@ static inline void z_do_sse_regs_init(void)
 	__asm__ volatile("ldmxcsr _sse_mxcsr_default_value\n\t");
 }
 
+#ifdef CONFIG_LAZY_FPU_SWITCH
+/**
+ *
+ * @brief Restore non-integer context information
+ *
+ * This routine loads the system's "live" non-integer context from the
+ * specified area, x87/MMX thread info only.
+ *
+ * @return N/A
+ */
+static inline void z_do_fp_regs_restore(void *preemp_float_reg)
+{
+	__asm__ volatile("frstor (%0);\n\t"
+			 :
+			 : "r"(preemp_float_reg)
+			 : "memory");
+}
+
+/**
+ *
+ * @brief Restore non-integer context information
+ *
+ * This routine loads the system's "live" non-integer context from the
+ * specified area, x87/MMX/SSEx thread info.
+ *
+ * @return N/A
+ */
+static inline void z_do_fp_and_sse_regs_restore(void *preemp_float_reg)
+{
+	__asm__ volatile("fxrstor (%0);\n\t"
+			 :
+			 : "r"(preemp_float_reg)
+			 : "memory");
+}
+#endif /* CONFIG_LAZY_FPU_SWITCH */
+
 /*
  * Save a thread's floating point context information.
  *
@@ -154,6 +197,44 @@ static void FpCtxSave(struct k_thread *thread)
 	z_do_fp_regs_save(&thread->arch.preempFloatReg);
 }
 
+#ifdef CONFIG_LAZY_FPU_SWITCH
+/*
+ * Restore a thread's floating point context information.
+ *
+ * This routine loads the floating point context saved in the specified
+ * thread control block into the system's "live" registers.
+ */
+static void FpCtxRestore(struct k_thread *thread)
+{
+#ifdef CONFIG_SSE
+	if ((thread->base.user_options & K_SSE_REGS) != 0) {
+		z_do_fp_and_sse_regs_restore(&thread->arch.preempFloatReg);
+		return;
+	}
+#endif
+	z_do_fp_regs_restore(&thread->arch.preempFloatReg);
+}
+#endif /* CONFIG_LAZY_FPU_SWITCH */
+
+/*
+ * Save the floating point context of the thread owning the FPU, if it may
+ * not be discarded: only threads switched out preemptively expect their
+ * floating point registers to be preserved.
+ */
+static void FpOwnerSave(struct k_thread *fp_owner)
+{
+	if (fp_owner != NULL) {
+		if ((fp_owner->arch.flags & X86_THREAD_FLAG_ALL) != 0) {
+			FpCtxSave(fp_owner);
+#ifdef CONFIG_LAZY_FPU_SWITCH
+			fp_owner->arch.flags |= X86_THREAD_FLAG_FP_SAVED;
+		} else {
+			fp_owner->arch.flags &= ~X86_THREAD_FLAG_FP_SAVED;
+#endif
+		}
+	}
+}
+
 /*
  * Initialize a thread's floating point context information.
  *
@@ -182,7 +263,6 @@ static inline void FpCtxInit(struct k_thread *thread)
 void k_float_enable(struct k_thread *thread, unsigned int options)
 {
 	unsigned int imask;
-	struct k_thread *fp_owner;
 
 	/* Ensure a preemptive context switch does not occur */
 
@@ -206,12 +286,7 @@ void k_float_enable(struct k_thread *thread, unsigned int options)
 	 * must be preserved).
 	 */
 
-	fp_owner = _kernel.current_fp;
-	if (fp_owner != NULL) {
-		if ((fp_owner->arch.flags & X86_THREAD_FLAG_ALL) != 0) {
-			FpCtxSave(fp_owner);
-		}
-	}
+	FpOwnerSave(_kernel.current_fp);
 
 	/* Now create a virgin FP context */
 
@@ -228,7 +303,24 @@ void k_float_enable(struct k_thread *thread, unsigned int options)
 		 */
 
 		_kernel.current_fp = thread;
+#ifdef CONFIG_LAZY_FPU_SWITCH
+		thread->arch.flags &= ~X86_THREAD_FLAG_FP_SAVED;
+#endif
 	} else {
+#ifdef CONFIG_LAZY_FPU_SWITCH
+		/*
+		 * When enabling FP support for someone else, save the new
+		 * FP context in their TCS, to be restored when they first
+		 * use the FPU. The FPU is left without owner, the current
+		 * thread does not necessarily own it and its FP context
+		 * was just lost anyway.
+		 */
+
+		FpCtxSave(thread);
+		thread->arch.flags |= X86_THREAD_FLAG_FP_SAVED;
+		_kernel.current_fp = NULL;
+		z_FpAccessDisable();
+#else
 		/*
 		 * When enabling FP support for someone else, assign ownership
 		 * of the FPU to them (unless we need it ourselves).
@@ -264,6 +356,7 @@ void k_float_enable(struct k_thread *thread, unsigned int options)
 
 			FpCtxSave(thread);
 		}
+#endif /* CONFIG_LAZY_FPU_SWITCH */
 	}
 
 	irq_unlock(imask);
@@ -292,11 +385,14 @@ int z_float_disable(struct k_thread *thread)
 
 	if (thread == _current) {
 		z_FpAccessDisable();
+	}
+
+	/*
+	 * The current thread may be FP-capable without owning the FPU with
+	 * CONFIG_LAZY_FPU_SWITCH, leave the owner's FP context alone then.
+	 */
+	if (_kernel.current_fp == thread) {
 		_kernel.current_fp = (struct k_thread *)0;
-	} else {
-		if (_kernel.current_fp == thread) {
-			_kernel.current_fp = (struct k_thread *)0;
-		}
 	}
 
 	irq_unlock(imask);
@@ -324,6 +420,33 @@ void _FpNotAvailableExcHandler(z_arch_esf_t *pEsf)
 	 * error checking to ensure the exception was not generated in an ISR.)
 	 */
 
+#ifdef CONFIG_LAZY_FPU_SWITCH
+	if ((_current->base.user_options & _FP_USER_MASK) != 0) {
+		/*
+		 * FP-capable thread not owning the FPU: this is where its
+		 * FP context is switched in, z_swap() only set CR0[TS].
+		 */
+
+		unsigned int imask = irq_lock();
+
+		__asm__ volatile("clts\n\t");
+
+		FpOwnerSave(_kernel.current_fp);
+
+		if ((_current->arch.flags & X86_THREAD_FLAG_FP_SAVED) != 0) {
+			FpCtxRestore(_current);
+			_current->arch.flags &= ~X86_THREAD_FLAG_FP_SAVED;
+		} else {
+			FpCtxInit(_current);
+		}
+
+		_kernel.current_fp = _current;
+
+		irq_unlock(imask);
+		return;
+	}
+#endif /* CONFIG_LAZY_FPU_SWITCH */
+
 	/* Enable highest level of FP capability configured into the kernel */
 
 	k_float_enable(_current, _FP_USER_MASK);
@@ -168,6 +168,16 @@ FUNC_NORETURN void z_x86_cpu_init(struct x86_cpuboot *cpuboot)
 	z_x86_msr_write(X86_FMASK_MSR, EFLAGS_SYSCALL);
 #endif
 
+#ifdef CONFIG_X86_PCID
+	/* Only possible in long mode and with a PCID of 0 in CR3, which is
+	 * the case of the kernel's page tables installed by locore.S
+	 */
+	__asm__ volatile("movq %%cr4, %%rax\n\t"
+			 "orq %0, %%rax\n\t"
+			 "movq %%rax, %%cr4\n\t"
+			 : : "i" (CR4_PCIDE) : "rax", "memory");
+#endif
+
 	/* Enter kernel, never return */
 	cpuboot->ready++;
 	cpuboot->fn(cpuboot->arg);
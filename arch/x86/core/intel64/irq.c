@@ -144,4 +144,17 @@ void arch_sched_ipi(void)
 {
 	z_loapic_ipi(0, LOAPIC_ICR_IPI_OTHERS, CONFIG_SCHED_IPI_VECTOR);
 }
+
+void arch_sched_ipi_mask(uint32_t cpu_mask)
+{
+	cpu_mask &= ~BIT(arch_curr_cpu()->id);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu_mask & BIT(i)) != 0) {
+			z_loapic_ipi(x86_cpu_loapics[i],
+				     LOAPIC_ICR_IPI_SPECIFIC,
+				     CONFIG_SCHED_IPI_VECTOR);
+		}
+	}
+}
 #endif
@@ -33,6 +33,9 @@ GEN_OFFSET_SYM(_thread_arch_t, psp);
 #ifndef CONFIG_X86_COMMON_PAGE_TABLE
 GEN_OFFSET_SYM(_thread_arch_t, ptables);
 #endif
+#ifdef CONFIG_X86_PCID
+GEN_OFFSET_SYM(_thread_arch_t, cr3);
+#endif
 #endif /* CONFIG_USERSPACE */
 
 GEN_OFFSET_SYM(x86_tss64_t, ist1);
@@ -48,7 +48,11 @@ void z_x86_swap_update_page_tables(struct k_thread *incoming)
 		 incoming);
 
 	if (ptables_phys != z_x86_cr3_get()) {
+#ifdef CONFIG_X86_PCID
+		z_x86_cr3_set(incoming->arch.cr3);
+#else
 		z_x86_cr3_set(ptables_phys);
+#endif
 	}
 #endif /* CONFIG_X86_COMMON_PAGE_TABLE */
 }
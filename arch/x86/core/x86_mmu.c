@@ -17,6 +17,7 @@
 #include <x86_mmu.h>
 #include <init.h>
 #include <kernel_internal.h>
+#include <mmu.h>
 #include <drivers/interrupt_controller/loapic.h>
 
 LOG_MODULE_DECLARE(os);
@@ -61,6 +62,17 @@ static struct k_spinlock x86_mmu_lock;
 static sys_slist_t x86_domain_list;
 #endif
 
+#ifdef CONFIG_X86_PCID
+/* PCIDs tag the TLB entries of each set of page tables, loading CR3 keeps
+ * the entries of the other PCIDs. PCID 0 is the kernel's page tables, the
+ * memory domains get theirs in arch_mem_domain_init().
+ */
+#define PCID_KERNEL	0U
+#define PCID_MAX	X86_CR3_PCID_MASK
+
+static uint16_t pcid_next = PCID_KERNEL + 1U;
+#endif
+
 /*
  * Definitions for building an ontology of paging levels and capabilities
  * at each level
@@ -337,14 +349,43 @@ static inline bool is_leaf(int level, pentry_t entry)
 	return ((entry & MMU_PS) != 0U);
 }
 
-static inline void tlb_flush_page(void *addr)
+#ifdef CONFIG_X86_PCID
+/* PCID of a set of page tables. Called with x86_mmu_lock held */
+static uint16_t ptables_pcid(pentry_t *ptables)
+{
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(&x86_domain_list, node) {
+		struct arch_mem_domain *domain =
+			CONTAINER_OF(node, struct arch_mem_domain, node);
+
+		if (domain->ptables == ptables) {
+			return domain->pcid;
+		}
+	}
+
+	return PCID_KERNEL;
+}
+#endif /* CONFIG_X86_PCID */
+
+static inline void tlb_flush_page(pentry_t *ptables, void *addr)
 {
+#ifdef CONFIG_X86_PCID
+	/* Entries of page tables which are not active are not flushed by
+	 * loading them in CR3 anymore, target their PCID whether they are
+	 * active or not.
+	 */
+	z_x86_invpcid(X86_INVPCID_ADDR, ptables_pcid(ptables), addr);
+#else
 	/* Invalidate TLB entries corresponding to the page containing the
 	 * specified address
 	 */
 	char *page = (char *)addr;
 
+	ARG_UNUSED(ptables);
+
 	__asm__ ("invlpg %0" :: "m" (*page));
+#endif /* CONFIG_X86_PCID */
 
 	/* TODO: Need to implement TLB shootdown for SMP */
 }
@@ -383,7 +424,13 @@ void z_x86_tlb_ipi(const void *arg)
 	 */
 	LOG_DBG("%s on CPU %d\n", __func__, arch_curr_cpu()->id);
 
+#ifdef CONFIG_X86_PCID
+	/* Reloading CR3 would only flush the entries of its PCID */
+	ARG_UNUSED(ptables);
+	z_x86_invpcid(X86_INVPCID_ALL, 0, NULL);
+#else
 	z_x86_cr3_set(ptables);
+#endif
 }
 
 static inline void tlb_shootdown(void)
@@ -866,7 +913,7 @@ static int page_map_set(pentry_t *ptables, void *virt, pentry_t entry_val,
 	}
 
 	if (flush) {
-		tlb_flush_page(virt);
+		tlb_flush_page(ptables, virt);
 	}
 
 	return 0;
@@ -1092,7 +1139,170 @@ void z_x86_set_stack_guard(k_thread_stack_t *stack)
 }
 #endif /* CONFIG_X86_STACK_PROTECTION */
 
+#ifdef CONFIG_DEMAND_PAGING
+#define PTE_MASK	(paging_levels[NUM_LEVELS - 1].mask)
+
+/* Pointer to the PTE for virt, or NULL if no page table covers it */
+static pentry_t *pte_ptr_get(pentry_t *ptables, void *virt)
+{
+	pentry_t *table = ptables;
+
+	for (int level = 0; level < NUM_LEVELS - 1; level++) {
+		pentry_t entry = get_entry(table, virt, level);
+
+		if ((entry & MMU_P) == 0U) {
+			return NULL;
+		}
+
+		__ASSERT((entry & MMU_PS) == 0U, "large page encountered");
+		table = next_table(entry, level);
+	}
+
+	return get_entry_ptr(table, virt, NUM_LEVELS - 1);
+}
+
+static pentry_t pte_get(pentry_t *ptables, void *virt)
+{
+	pentry_t *ptep = pte_ptr_get(ptables, virt);
+	pentry_t pte;
+
+	if (ptep == NULL) {
+		return 0;
+	}
+
+	pte = *ptep;
+#ifdef CONFIG_X86_KPTI
+	if (is_flipped_pte(pte)) {
+		pte = ~pte;
+	}
+#endif
+	return pte;
+}
+
+/* The permission bits of a paged-out page are kept, only the Present bit
+ * and the address change. The backing store location, page aligned and
+ * never 0, tells a paged-out PTE from an unmapped one.
+ */
+void arch_mem_page_out(void *addr, uintptr_t location)
+{
+	(void)range_map(addr, location, CONFIG_MMU_PAGE_SIZE, 0,
+			MMU_P | MMU_A | MMU_D | PTE_MASK, OPTION_FLUSH);
+}
+
+void arch_mem_page_in(void *addr, uintptr_t phys)
+{
+	(void)range_map(addr, phys, CONFIG_MMU_PAGE_SIZE, MMU_P,
+			MMU_P | MMU_A | MMU_D | PTE_MASK, OPTION_FLUSH);
+}
+
+void arch_mem_scratch(uintptr_t phys)
+{
+	(void)range_map(Z_SCRATCH_PAGE, phys, CONFIG_MMU_PAGE_SIZE,
+			MMU_P | ENTRY_RW | ENTRY_XD, MASK_ALL,
+			OPTION_FLUSH | OPTION_ALLOC);
+}
+
+enum arch_page_location arch_page_location_get(void *addr,
+					       uintptr_t *location)
+{
+	pentry_t pte = pte_get(z_x86_kernel_ptables, addr);
+
+	*location = pte & PTE_MASK;
+
+	if ((pte & MMU_P) != 0U) {
+		return ARCH_PAGE_LOCATION_PAGED_IN;
+	} else if (*location != 0U) {
+		return ARCH_PAGE_LOCATION_PAGED_OUT;
+	}
+
+	return ARCH_PAGE_LOCATION_BAD;
+}
+
+/* Accessed and dirty bits of a page in a set of page tables, optionally
+ * clearing the accessed bit. Called with x86_mmu_lock held.
+ */
+static pentry_t page_usage_get(pentry_t *ptables, void *addr,
+			       bool clear_accessed, uint32_t options)
+{
+	pentry_t pte = pte_get(ptables, addr);
+
+	if (clear_accessed && (pte & MMU_A) != 0U) {
+		(void)page_map_set(ptables, addr, 0, MMU_A,
+				   options | OPTION_FLUSH);
+	}
+
+	return pte & (MMU_A | MMU_D);
+}
+
+uintptr_t arch_page_info_get(void *addr, uintptr_t *phys, bool clear_accessed)
+{
+	pentry_t pte = pte_get(z_x86_kernel_ptables, addr);
+	uintptr_t ret = 0;
+	pentry_t usage;
+	k_spinlock_key_t key;
+
+	if (phys != NULL) {
+		*phys = pte & PTE_MASK;
+	}
+
+	if ((pte & MMU_P) == 0U) {
+		return (pte & PTE_MASK) == 0U ? ARCH_DATA_PAGE_NOT_MAPPED : 0U;
+	}
+
+	/* The processor sets the bits in whichever page tables were in use
+	 * at the time of the access.
+	 */
+	key = k_spin_lock(&x86_mmu_lock);
+	usage = page_usage_get(z_x86_kernel_ptables, addr, clear_accessed, 0);
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_X86_COMMON_PAGE_TABLE)
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(&x86_domain_list, node) {
+		struct arch_mem_domain *domain =
+			CONTAINER_OF(node, struct arch_mem_domain, node);
+
+		usage |= page_usage_get(domain->ptables, addr, clear_accessed,
+					OPTION_USER);
+	}
+#endif
+	k_spin_unlock(&x86_mmu_lock, key);
+
+#ifdef CONFIG_SMP
+	if (clear_accessed) {
+		tlb_shootdown();
+	}
+#endif
+
+	ret |= ARCH_DATA_PAGE_LOADED;
+	if ((usage & MMU_A) != 0U) {
+		ret |= ARCH_DATA_PAGE_ACCESSED;
+	}
+	if ((usage & MMU_D) != 0U) {
+		ret |= ARCH_DATA_PAGE_DIRTY;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_DEMAND_PAGING */
+
 #ifdef CONFIG_USERSPACE
+/* A paged-out PTE keeps its permission bits, and the access pages it back
+ * in
+ */
+static inline bool is_paged_out(int level, pentry_t entry)
+{
+#ifdef CONFIG_DEMAND_PAGING
+	/* Entries flipped for KPTI have PTE_ZERO set, page-outs never */
+	return level == NUM_LEVELS - 1 && (entry & PTE_ZERO) == 0U &&
+	       get_entry_phys(entry, level) != 0U;
+#else
+	ARG_UNUSED(level);
+	ARG_UNUSED(entry);
+
+	return false;
+#endif
+}
+
 static bool page_validate(pentry_t *ptables, uint8_t *addr, bool write)
 {
 	pentry_t *table = (pentry_t *)ptables;
@@ -1100,11 +1310,8 @@ static bool page_validate(pentry_t *ptables, uint8_t *addr, bool write)
 	for (int level = 0; level < NUM_LEVELS; level++) {
 		pentry_t entry = get_entry(table, addr, level);
 
-		if ((entry & MMU_P) == 0U) {
-			/* Non-present, no access.
-			 * TODO: will need re-visiting with demand paging
-			 * implemented, could just be paged out
-			 */
+		if ((entry & MMU_P) == 0U && !is_paged_out(level, entry)) {
+			/* Non-present, no access */
 			return false;
 		}
 
@@ -1295,6 +1502,16 @@ void arch_mem_domain_partition_add(struct k_mem_domain *domain,
 }
 
 /* Rest of the APIs don't need to do anything */
+void arch_mem_domain_update_begin(struct k_mem_domain *domain)
+{
+
+}
+
+void arch_mem_domain_update_end(struct k_mem_domain *domain)
+{
+
+}
+
 void arch_mem_domain_thread_add(struct k_thread *thread)
 {
 
@@ -1375,6 +1592,15 @@ static int copy_page_table(pentry_t *dst, pentry_t *src, int level)
 	return 0;
 }
 
+#ifdef CONFIG_SMP
+/* Set by arch_mem_domain_update_begin(), the other CPUs then get their TLB
+ * flushed once by arch_mem_domain_update_end(). Both are called with
+ * z_mem_domain_lock held.
+ */
+static bool shootdown_deferred;
+static bool shootdown_pending;
+#endif
+
 static void region_map_update(pentry_t *ptables, void *start,
 			      size_t size, pentry_t flags, bool reset)
 {
@@ -1384,7 +1610,11 @@ static void region_map_update(pentry_t *ptables, void *start,
 	if (reset) {
 		options |= OPTION_RESET;
 	}
-	if (ptables == z_x86_page_tables_get()) {
+	if (IS_ENABLED(CONFIG_X86_PCID) ||
+	    ptables == z_x86_page_tables_get()) {
+		/* With PCIDs, the TLB may hold entries of page tables
+		 * which are not active as well
+		 */
 		options |= OPTION_FLUSH;
 	}
 
@@ -1394,6 +1624,11 @@ static void region_map_update(pentry_t *ptables, void *start,
 	k_spin_unlock(&x86_mmu_lock, key);
 
 #ifdef CONFIG_SMP
+	if (shootdown_deferred) {
+		shootdown_pending = true;
+		return;
+	}
+
 	tlb_shootdown();
 #endif
 }
@@ -1454,10 +1689,19 @@ int arch_mem_domain_init(struct k_mem_domain *domain)
 	 */
 	if (domain == &k_mem_domain_default) {
 		domain->arch.ptables = z_x86_kernel_ptables;
+#ifdef CONFIG_X86_PCID
+		domain->arch.pcid = PCID_KERNEL;
+#endif
 		k_spin_unlock(&x86_mmu_lock, key);
 		return 0;
 	}
 #endif /* CONFIG_X86_KPTI */
+#ifdef CONFIG_X86_PCID
+	if (pcid_next > PCID_MAX) {
+		k_spin_unlock(&x86_mmu_lock, key);
+		return -ENOMEM;
+	}
+#endif /* CONFIG_X86_PCID */
 #ifdef CONFIG_X86_PAE
 	/* PDPT is stored within the memory domain itself since it is
 	 * much smaller than a full page
@@ -1479,6 +1723,9 @@ int arch_mem_domain_init(struct k_mem_domain *domain)
 	/* Make a copy of the boot page tables created by gen_mmu.py */
 	ret = copy_page_table(domain->arch.ptables, z_x86_kernel_ptables, 0);
 	if (ret == 0) {
+#ifdef CONFIG_X86_PCID
+		domain->arch.pcid = pcid_next++;
+#endif
 		sys_slist_append(&x86_domain_list, &domain->arch.node);
 	}
 
@@ -1499,6 +1746,24 @@ void arch_mem_domain_partition_remove(struct k_mem_domain *domain,
 		     partition->size);
 }
 
+void arch_mem_domain_update_begin(struct k_mem_domain *domain)
+{
+#ifdef CONFIG_SMP
+	shootdown_deferred = true;
+#endif
+}
+
+void arch_mem_domain_update_end(struct k_mem_domain *domain)
+{
+#ifdef CONFIG_SMP
+	shootdown_deferred = false;
+	if (shootdown_pending) {
+		shootdown_pending = false;
+		tlb_shootdown();
+	}
+#endif
+}
+
 void arch_mem_domain_destroy(struct k_mem_domain *domain)
 {
 	/* No-op, this is eventually getting removed in 2.5 */
@@ -1560,6 +1825,10 @@ void arch_mem_domain_thread_add(struct k_thread *thread)
 	}
 
 	thread->arch.ptables = (uintptr_t)domain->arch.ptables;
+#ifdef CONFIG_X86_PCID
+	thread->arch.cr3 = thread->arch.ptables | domain->arch.pcid |
+			   BIT64(X86_CR3_NOFLUSH_BIT);
+#endif
 	LOG_DBG("set thread %p page tables to %p", thread,
 		(void *)thread->arch.ptables);
 
@@ -1583,7 +1852,11 @@ void arch_mem_domain_thread_add(struct k_thread *thread)
 	 * other CPU.
 	 */
 	if (thread == _current && thread->arch.ptables != z_x86_cr3_get()) {
+#ifdef CONFIG_X86_PCID
+		z_x86_cr3_set(thread->arch.cr3);
+#else
 		z_x86_cr3_set(thread->arch.ptables);
+#endif
 	}
 #endif /* CONFIG_X86_KPTI */
 }
@@ -55,6 +55,13 @@
 
 #define CR4_PAE		BIT(5)		/* enable PAE */
 #define CR4_OSFXSR	BIT(9)		/* enable SSE (OS FXSAVE/RSTOR) */
+#define CR4_PCIDE	BIT(17)		/* enable PCIDs (64-bit only) */
+
+/* With CR4_PCIDE, the low bits of CR3 hold the PCID of the page tables, and
+ * loading CR3 with bit 63 set keeps the TLB entries of that PCID.
+ */
+#define X86_CR3_PCID_MASK	0xfffU
+#define X86_CR3_NOFLUSH_BIT	63
 
 #ifdef CONFIG_X86_64
 #include <intel64/kernel_arch_data.h>
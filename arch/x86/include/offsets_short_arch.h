@@ -21,6 +21,14 @@
 
 #define _thread_offset_to_ptables \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_ptables_OFFSET)
+
+/* Value to load in CR3 to switch to the thread's page tables */
+#ifdef CONFIG_X86_PCID
+#define _thread_offset_to_cr3 \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_cr3_OFFSET)
+#else
+#define _thread_offset_to_cr3 _thread_offset_to_ptables
+#endif /* CONFIG_X86_PCID */
 #endif /* CONFIG_USERSPACE */
 
 #endif /* ZEPHYR_ARCH_X86_INCLUDE_OFFSETS_SHORT_ARCH_H_ */
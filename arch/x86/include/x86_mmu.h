@@ -14,6 +14,7 @@
 
 #include <kernel.h>
 #include <arch/x86/mmustructs.h>
+#include <kernel_arch_data.h>
 
 #if defined(CONFIG_X86_64) || defined(CONFIG_X86_PAE)
 #define XD_SUPPORTED
@@ -135,10 +136,14 @@ extern uint8_t z_shared_kernel_page_start;
  * structure here or the CPU will triple fault. The incoming page tables must
  * have the same kernel mappings wrt supervisor mode. Don't use this function
  * unless you know exactly what you are doing.
+ *
+ * With CONFIG_X86_PCID, this is a full CR3 value, see struct _thread_arch.
  */
 static inline void z_x86_cr3_set(uintptr_t phys)
 {
+#ifndef CONFIG_X86_PCID
 	__ASSERT((phys & PTABLES_ALIGN) == 0U, "unaligned page tables");
+#endif
 #ifdef CONFIG_X86_64
 	__asm__ volatile("movq %0, %%cr3\n\t" : : "r" (phys) : "memory");
 #else
@@ -156,10 +161,32 @@ static inline uintptr_t z_x86_cr3_get(void)
 	__asm__ volatile("movq %%cr3, %0\n\t" : "=r" (cr3));
 #else
 	__asm__ volatile("movl %%cr3, %0\n\t" : "=r" (cr3));
+#endif
+#ifdef CONFIG_X86_PCID
+	cr3 &= ~(uintptr_t)X86_CR3_PCID_MASK;
 #endif
 	return cr3;
 }
 
+#ifdef CONFIG_X86_PCID
+#define X86_INVPCID_ADDR	0	/* One page of one PCID */
+#define X86_INVPCID_PCID	1	/* All pages of one PCID */
+#define X86_INVPCID_ALL		2	/* All pages of all PCIDs */
+
+/* Invalidate TLB entries of the given PCID, or of all of them */
+static inline void z_x86_invpcid(unsigned long type, uint16_t pcid,
+				 void *addr)
+{
+	struct {
+		uint64_t pcid;
+		uint64_t addr;
+	} desc = { pcid, (uint64_t)addr };
+
+	__asm__ volatile("invpcid %0, %1\n\t"
+			 : : "m" (desc), "r" (type) : "memory");
+}
+#endif /* CONFIG_X86_PCID */
+
 /* Return the virtual address of the page tables installed in this CPU in CR3 */
 static inline pentry_t *z_x86_page_tables_get(void)
 {
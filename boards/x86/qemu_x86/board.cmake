@@ -9,6 +9,9 @@ endif()
 if(CONFIG_X86_64)
   set(QEMU_binary_suffix x86_64)
   set(QEMU_CPU_TYPE_${ARCH} qemu64,+x2apic)
+  if(CONFIG_X86_PCID)
+    set(QEMU_CPU_TYPE_${ARCH} ${QEMU_CPU_TYPE_${ARCH}},+pcid,+invpcid)
+  endif()
   if("${CONFIG_MP_NUM_CPUS}" STREQUAL "1")
     # icount works with 1 CPU so we can enable it here.
     # FIXME: once this works across configs, remove this line and set
@@ -155,6 +155,10 @@ set_compiler_property(PROPERTY no_common -fno-common)
 # at present, zephyr only support gnu coverage
 set_compiler_property(PROPERTY coverage "")
 
+# mwdt has no function entry and exit instrumentation
+set_compiler_property(PROPERTY instrument_functions "")
+set_compiler_property(PROPERTY instrument_functions_exclude_files "")
+
 # mwdt compiler flags for imacros. The specific header must be appended by user.
 set_compiler_property(PROPERTY imacros -imacros)
 
@@ -13,6 +13,9 @@ check_set_compiler_property(PROPERTY hosted)
 # clang flags for coverage generation
 set_property(TARGET compiler PROPERTY coverage --coverage -fno-inline)
 
+# clang has no file exclusion list for instrumented functions
+set_compiler_property(PROPERTY instrument_functions_exclude_files)
+
 #######################################################
 # This section covers flags related to warning levels #
 #######################################################
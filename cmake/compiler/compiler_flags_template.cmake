@@ -74,6 +74,11 @@ set_property(TARGET compiler-cpp PROPERTY no_rtti)
 # Flags for coverage generation
 set_compiler_property(PROPERTY coverage)
 
+# Flags for function entry and exit instrumentation, and the flag prefix of
+# the list of files excluded from it.
+set_compiler_property(PROPERTY instrument_functions)
+set_compiler_property(PROPERTY instrument_functions_exclude_files)
+
 # Security canaries flags.
 set_compiler_property(PROPERTY security_canaries)
 
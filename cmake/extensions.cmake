@@ -1013,16 +1013,54 @@ endfunction(zephyr_linker_sources)
 
 
 # Helper function for CONFIG_CODE_DATA_RELOCATION
-# Call this function with 2 arguments file and then memory location
+# Call this function with 2 arguments file and then memory location.
+# Only the code of the given functions of the file is relocated if
+# FUNCTIONS is given:
+#   zephyr_code_relocate(src/main.c SRAM FUNCTIONS func1 func2)
 function(zephyr_code_relocate file location)
+  cmake_parse_arguments(CODE_REL "" "" "FUNCTIONS" ${ARGN})
   if(NOT IS_ABSOLUTE ${file})
     set(file ${CMAKE_CURRENT_SOURCE_DIR}/${file})
   endif()
+  if(CODE_REL_FUNCTIONS)
+    string(REPLACE ";" "," functions "${CODE_REL_FUNCTIONS}")
+    set(file "${file}:${functions}")
+  endif()
   set_property(TARGET code_data_relocation_target
     APPEND PROPERTY COMPILE_DEFINITIONS
     "${location}:${file}")
 endfunction()
 
+# Helper function for CONFIG_CODE_DATA_RELOCATION
+# Relocates the code of the functions of a list file to a memory location,
+# whatever file they are defined in. The list file holds one function name
+# per line, '#' starting a comment, as generated from a profile by
+# scripts/profiling/profile_hot.py:
+#   zephyr_code_relocate_list(hot.txt ITCM_TEXT)
+function(zephyr_code_relocate_list list_file location)
+  if(NOT IS_ABSOLUTE ${list_file})
+    set(list_file ${CMAKE_CURRENT_SOURCE_DIR}/${list_file})
+  endif()
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${list_file})
+
+  file(STRINGS ${list_file} lines)
+  set(functions)
+  foreach(line ${lines})
+    string(REGEX REPLACE "#.*" "" line "${line}")
+    string(STRIP "${line}" line)
+    if(line)
+      list(APPEND functions ${line})
+    endif()
+  endforeach()
+
+  if(functions)
+    string(REPLACE ";" "," functions "${functions}")
+    set_property(TARGET code_data_relocation_target
+      APPEND PROPERTY COMPILE_DEFINITIONS
+      "${location}::${functions}")
+  endif()
+endfunction()
+
 # Usage:
 #   check_dtc_flag("-Wtest" DTC_WARN_TEST)
 #
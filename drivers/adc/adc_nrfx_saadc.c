@@ -14,10 +14,26 @@ LOG_MODULE_REGISTER(adc_nrfx_saadc);
 
 #define DT_DRV_COMPAT nordic_nrf_saadc
 
+/* The SAADC sample rate timer runs at 16 MHz, its compare value has to
+ * be within 80 and 2047.
+ */
+#define STREAM_TIMER_FREQ_MHZ	16
+#define STREAM_TIMER_CC_MIN	80
+#define STREAM_TIMER_CC_MAX	2047
+
 struct driver_data {
 	struct adc_context ctx;
 
 	uint8_t positive_inputs[SAADC_CH_NUM];
+
+#ifdef CONFIG_ADC_STREAM
+	/* Halves of the stream buffer, the SAADC fills them in turn */
+	nrf_saadc_value_t *stream_buf[2];
+	uint16_t stream_len;
+	uint8_t stream_idx;
+	adc_stream_callback stream_cb;
+	void *stream_user_data;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -253,8 +269,10 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
-static int start_read(const struct device *dev,
-		      const struct adc_sequence *sequence)
+/* Configure the channels, resolution and oversampling of a sequence,
+ * returns the number of active channels.
+ */
+static int setup_sequence(const struct adc_sequence *sequence)
 {
 	int error;
 	uint32_t selected_channels = sequence->channels;
@@ -322,6 +340,20 @@ static int start_read(const struct device *dev,
 		return error;
 	}
 
+	return active_channels;
+}
+
+static int start_read(const struct device *dev,
+		      const struct adc_sequence *sequence)
+{
+	int error;
+	int active_channels;
+
+	active_channels = setup_sequence(sequence);
+	if (active_channels < 0) {
+		return active_channels;
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -366,8 +398,140 @@ static int adc_nrfx_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_STREAM
+/* Implementation of the ADC driver API function: adc_stream_start. */
+static int adc_nrfx_stream_start(const struct device *dev,
+				 const struct adc_sequence *sequence,
+				 adc_stream_callback callback,
+				 void *user_data)
+{
+	uint32_t cc;
+	size_t len;
+	int active_channels;
+
+	if (!sequence->options || !callback) {
+		return -EINVAL;
+	}
+
+	/* The sample rate timer can only trigger single channel sampling */
+	if ((sequence->channels & (sequence->channels - 1)) ||
+	    sequence->oversampling) {
+		LOG_ERR("Streaming is supported for one channel only");
+		return -ENOTSUP;
+	}
+
+	cc = sequence->options->interval_us * STREAM_TIMER_FREQ_MHZ;
+	if (cc < STREAM_TIMER_CC_MIN || cc > STREAM_TIMER_CC_MAX) {
+		LOG_ERR("Stream interval %u us is not valid",
+			sequence->options->interval_us);
+		return -EINVAL;
+	}
+
+	len = sequence->buffer_size / 2 / sizeof(nrf_saadc_value_t);
+	if (len == 0 || len > UINT16_MAX) {
+		return -ENOMEM;
+	}
+
+	adc_context_lock(&m_data.ctx, false, NULL);
+
+	active_channels = setup_sequence(sequence);
+	if (active_channels < 0) {
+		adc_context_release(&m_data.ctx, active_channels);
+		return active_channels;
+	}
+
+	m_data.stream_buf[0] = sequence->buffer;
+	m_data.stream_buf[1] = m_data.stream_buf[0] + len;
+	m_data.stream_len = len;
+	m_data.stream_idx = 0;
+	m_data.stream_user_data = user_data;
+	m_data.stream_cb = callback;
+
+	nrf_saadc_buffer_init(NRF_SAADC, m_data.stream_buf[0], len);
+	nrf_saadc_continuous_mode_enable(NRF_SAADC, cc);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+
+	nrf_saadc_enable(NRF_SAADC);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_SAMPLE);
+
+	return 0;
+}
+
+/* Implementation of the ADC driver API function: adc_stream_stop. */
+static int adc_nrfx_stream_stop(const struct device *dev)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	if (!m_data.stream_cb) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	m_data.stream_cb = NULL;
+	nrf_saadc_int_disable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+	nrf_saadc_continuous_mode_disable(NRF_SAADC);
+
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_STOP);
+	while (!nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_STOPPED)) {
+	}
+
+	/* Stopping ends the buffer being filled, drop it */
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_disable(NRF_SAADC);
+	irq_unlock(key);
+
+	adc_context_release(&m_data.ctx, 0);
+
+	return 0;
+}
+
+static bool stream_irq_handler(const struct device *dev)
+{
+	nrf_saadc_value_t *done;
+
+	if (!m_data.stream_cb) {
+		return false;
+	}
+
+	/* The buffer pointer is latched by START, queue the other half */
+	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_STARTED)) {
+		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+		nrf_saadc_buffer_pointer_set(NRF_SAADC,
+			m_data.stream_buf[m_data.stream_idx ^ 1]);
+	}
+
+	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
+		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+		nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+
+		done = m_data.stream_buf[m_data.stream_idx];
+		m_data.stream_idx ^= 1;
+		m_data.stream_cb(dev, done,
+				 m_data.stream_len * sizeof(nrf_saadc_value_t),
+				 m_data.stream_user_data);
+	}
+
+	return true;
+}
+#else
+static inline bool stream_irq_handler(const struct device *dev)
+{
+	return false;
+}
+#endif /* CONFIG_ADC_STREAM */
+
 static void saadc_irq_handler(const struct device *dev)
 {
+	if (stream_irq_handler(dev)) {
+		return;
+	}
+
 	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
 
@@ -413,6 +577,10 @@ static const struct adc_driver_api adc_nrfx_driver_api = {
 	.read          = adc_nrfx_read,
 #ifdef CONFIG_ADC_ASYNC
 	.read_async    = adc_nrfx_read_async,
+#endif
+#ifdef CONFIG_ADC_STREAM
+	.stream_start  = adc_nrfx_stream_start,
+	.stream_stop   = adc_nrfx_stream_stop,
 #endif
 	.ref_internal  = 600,
 };
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/can_id_filter.h>
+#include <string.h>
+
+#define LOG_LEVEL CONFIG_CAN_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(can_id_filter);
+
+/* Hash slots hold the identifier with this bit set, 0 marks a free slot */
+#define HASH_USED BIT(31)
+
+void can_rx_ring_init(struct can_rx_ring *ring, struct zcan_frame *frames,
+		      size_t count)
+{
+	ring_buf_init(&ring->rb, count * sizeof(struct zcan_frame), frames);
+	k_sem_init(&ring->sem, 0, 1);
+	ring->dropped = 0U;
+}
+
+int can_rx_ring_get(struct can_rx_ring *ring, struct zcan_frame *frames,
+		    size_t count, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	while (true) {
+		key = k_spin_lock(&ring->lock);
+		len = ring_buf_get(&ring->rb, (uint8_t *)frames,
+				   count * sizeof(struct zcan_frame));
+		k_spin_unlock(&ring->lock, key);
+
+		if (len) {
+			return len / sizeof(struct zcan_frame);
+		}
+
+		/* The semaphore may be left over from frames read by the
+		 * previous call, in which case the ring is checked again.
+		 */
+		if (k_sem_take(&ring->sem, timeout)) {
+			return -EAGAIN;
+		}
+	}
+}
+
+static void can_rx_ring_put(struct can_rx_ring *ring,
+			    const struct zcan_frame *frame)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring->lock);
+	bool was_empty;
+
+	if (ring_buf_space_get(&ring->rb) < sizeof(*frame)) {
+		ring->dropped++;
+		k_spin_unlock(&ring->lock, key);
+		return;
+	}
+
+	was_empty = ring_buf_is_empty(&ring->rb);
+	ring_buf_put(&ring->rb, (const uint8_t *)frame, sizeof(*frame));
+	k_spin_unlock(&ring->lock, key);
+
+	if (was_empty) {
+		k_sem_give(&ring->sem);
+	}
+}
+
+static inline uint32_t hash_slot(uint32_t id)
+{
+	/* Multiplicative hash, consecutive identifiers are spread out */
+	return (id * 2654435761U) % CAN_ID_FILTER_HASH_SIZE;
+}
+
+static bool hash_insert(struct can_id_filter *filter, uint32_t id)
+{
+	uint32_t slot = hash_slot(id);
+
+	while (filter->hash[slot] != 0U) {
+		if (filter->hash[slot] == (id | HASH_USED)) {
+			return false;
+		}
+		slot = (slot + 1U) % CAN_ID_FILTER_HASH_SIZE;
+	}
+
+	filter->hash[slot] = id | HASH_USED;
+
+	return true;
+}
+
+static bool hash_contains(const struct can_id_filter *filter, uint32_t id)
+{
+	uint32_t slot = hash_slot(id);
+
+	while (filter->hash[slot] != 0U) {
+		if (filter->hash[slot] == (id | HASH_USED)) {
+			return true;
+		}
+		slot = (slot + 1U) % CAN_ID_FILTER_HASH_SIZE;
+	}
+
+	return false;
+}
+
+static void can_id_filter_isr(struct zcan_frame *frame, void *arg)
+{
+	struct can_id_filter *filter = arg;
+	uint32_t id = frame->id_type == CAN_STANDARD_IDENTIFIER ?
+		      frame->std_id : frame->ext_id;
+
+	if (frame->id_type != filter->id_type ||
+	    !hash_contains(filter, id)) {
+		return;
+	}
+
+	can_rx_ring_put(filter->ring, frame);
+}
+
+/* Number of identifiers a mask lets through */
+static inline uint32_t mask_coverage(const struct can_id_filter *filter,
+				     uint32_t mask)
+{
+	uint32_t full = filter->id_type == CAN_STANDARD_IDENTIFIER ?
+			CAN_STD_ID_MASK : CAN_EXT_ID_MASK;
+
+	return BIT(popcount(full & ~mask));
+}
+
+static inline uint32_t merged_mask(const struct can_id_mask *a,
+				   const struct can_id_mask *b)
+{
+	return a->mask & b->mask & ~(a->id ^ b->id);
+}
+
+/*
+ * Merge neighbouring masks of the sorted identifiers until there are at most
+ * max_masks of them, each time picking the pair that lets the fewest extra
+ * identifiers through.
+ */
+static void compact_masks(struct can_id_filter *filter, uint16_t max_masks)
+{
+	struct can_id_mask *masks = filter->masks;
+
+	while (filter->num_masks > max_masks) {
+		int64_t best_cost = INT64_MAX;
+		uint16_t best = 0U;
+
+		/* Negative when the masks already overlap */
+		for (uint16_t i = 0U; i + 1U < filter->num_masks; i++) {
+			int64_t cost = (int64_t)mask_coverage(filter,
+					merged_mask(&masks[i], &masks[i + 1])) -
+					mask_coverage(filter, masks[i].mask) -
+					mask_coverage(filter, masks[i + 1].mask);
+
+			if (cost < best_cost) {
+				best_cost = cost;
+				best = i;
+			}
+		}
+
+		masks[best].mask = merged_mask(&masks[best], &masks[best + 1]);
+		masks[best].id &= masks[best].mask;
+		filter->num_masks--;
+		memmove(&masks[best + 1], &masks[best + 2],
+			(filter->num_masks - best - 1U) * sizeof(*masks));
+	}
+}
+
+static int attach_masks(struct can_id_filter *filter)
+{
+	struct zcan_filter zfilter = {
+		.id_type = filter->id_type,
+		.rtr = CAN_DATAFRAME,
+		.rtr_mask = 1,
+	};
+	int ret;
+
+	for (uint16_t i = 0U; i < filter->num_masks; i++) {
+		if (filter->id_type == CAN_STANDARD_IDENTIFIER) {
+			zfilter.std_id = filter->masks[i].id;
+			zfilter.std_id_mask = filter->masks[i].mask;
+		} else {
+			zfilter.ext_id = filter->masks[i].id;
+			zfilter.ext_id_mask = filter->masks[i].mask;
+		}
+
+		ret = can_attach_isr(filter->dev, can_id_filter_isr, filter,
+				     &zfilter);
+		if (ret < 0) {
+			/* Release the filters attached so far */
+			while (i-- > 0U) {
+				can_detach(filter->dev, filter->filter_ids[i]);
+			}
+			return ret;
+		}
+
+		filter->filter_ids[i] = ret;
+	}
+
+	return 0;
+}
+
+int can_id_filter_attach(struct can_id_filter *filter,
+			 const struct device *dev, const uint32_t *ids,
+			 size_t count, enum can_ide id_type,
+			 struct can_rx_ring *ring)
+{
+	struct can_id_mask *masks = filter->masks;
+	uint32_t full = id_type == CAN_STANDARD_IDENTIFIER ?
+			CAN_STD_ID_MASK : CAN_EXT_ID_MASK;
+	uint16_t max_masks = CONFIG_CAN_ID_FILTER_HW_MAX;
+	int ret;
+
+	if (count == 0U || count > CONFIG_CAN_ID_FILTER_MAX_IDS) {
+		return -EINVAL;
+	}
+
+	memset(filter->hash, 0, sizeof(filter->hash));
+	filter->dev = dev;
+	filter->ring = ring;
+	filter->id_type = id_type;
+	filter->num_masks = 0U;
+
+	/* Keep the unique identifiers sorted, neighbours share the most
+	 * bits and make the best candidates for a common mask.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		uint32_t id = ids[i] & full;
+		uint16_t j;
+
+		if (!hash_insert(filter, id)) {
+			continue;
+		}
+
+		for (j = filter->num_masks; j > 0U && masks[j - 1].id > id;
+		     j--) {
+			masks[j] = masks[j - 1];
+		}
+
+		masks[j].id = id;
+		masks[j].mask = full;
+		filter->num_masks++;
+	}
+
+	/* Use fewer, wider masks for as long as the controller runs out of
+	 * filters. A single mask still works, the software filter then
+	 * does most of the work.
+	 */
+	while (true) {
+		compact_masks(filter, max_masks);
+
+		ret = attach_masks(filter);
+		if (ret != CAN_NO_FREE_FILTER || max_masks == 1U) {
+			break;
+		}
+
+		max_masks--;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Cannot attach identifier set (%d)", ret);
+		filter->num_masks = 0U;
+		return ret;
+	}
+
+	LOG_DBG("%u identifiers on %u filters", (uint32_t)count,
+		filter->num_masks);
+
+	return 0;
+}
+
+void can_id_filter_detach(struct can_id_filter *filter)
+{
+	for (uint16_t i = 0U; i < filter->num_masks; i++) {
+		can_detach(filter->dev, filter->filter_ids[i]);
+	}
+
+	filter->num_masks = 0U;
+}
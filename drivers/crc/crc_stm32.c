@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT st_stm32_crc
+
+#include <kernel.h>
+#include <device.h>
+#include <drivers/crc.h>
+#include <sys/atomic.h>
+#include <sys/byteorder.h>
+#include <soc.h>
+#include <drivers/clock_control.h>
+#include <drivers/clock_control/stm32_clock_control.h>
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(crc_stm32, CONFIG_CRC_LOG_LEVEL);
+
+struct crc_stm32_config {
+	CRC_TypeDef *crc;
+	struct stm32_pclken pclken;
+};
+
+struct crc_stm32_data {
+	atomic_t busy;
+};
+
+#define DEV_CFG(dev) \
+	((const struct crc_stm32_config *)(dev)->config)
+
+#define DEV_DATA(dev) \
+	((struct crc_stm32_data *)(dev)->data)
+
+/*
+ * The unit shifts the data in most significant bit first while the
+ * CRC-32/IEEE is reflected: the input is bit reversed by the unit and the
+ * state is handed over bit reversed in both directions.
+ */
+static int crc_stm32_crc32_ieee_update(const struct device *dev,
+				       uint32_t *crc, const uint8_t *data,
+				       size_t len)
+{
+	CRC_TypeDef *regs = DEV_CFG(dev)->crc;
+	struct crc_stm32_data *dev_data = DEV_DATA(dev);
+
+	if (!atomic_cas(&dev_data->busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	LL_CRC_SetInitialData(regs, __RBIT(~*crc));
+	LL_CRC_ResetCRCCalculationUnit(regs);
+
+	LL_CRC_SetInputDataReverseMode(regs, LL_CRC_INDATA_REVERSE_WORD);
+	for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+		LL_CRC_FeedData32(regs, sys_get_le32(data));
+		data += sizeof(uint32_t);
+	}
+
+	LL_CRC_SetInputDataReverseMode(regs, LL_CRC_INDATA_REVERSE_BYTE);
+	for (; len > 0; len--) {
+		LL_CRC_FeedData8(regs, *data++);
+	}
+
+	*crc = ~__RBIT(LL_CRC_ReadData32(regs));
+
+	atomic_clear(&dev_data->busy);
+
+	return 0;
+}
+
+static int crc_stm32_init(const struct device *dev)
+{
+	const struct crc_stm32_config *cfg = DEV_CFG(dev);
+	const struct device *clk = device_get_binding(STM32_CLOCK_CONTROL_NAME);
+	int ret;
+
+	ret = clock_control_on(clk, (clock_control_subsys_t *)&cfg->pclken);
+	if (ret < 0) {
+		LOG_ERR("Cannot enable the CRC clock (%d)", ret);
+		return ret;
+	}
+
+	LL_CRC_SetPolynomialSize(cfg->crc, LL_CRC_POLYLENGTH_32B);
+	LL_CRC_SetPolynomialCoef(cfg->crc, LL_CRC_DEFAULT_CRC32_POLY);
+	LL_CRC_SetOutputDataReverseMode(cfg->crc,
+					LL_CRC_OUTDATA_REVERSE_NONE);
+
+	return 0;
+}
+
+static const struct crc_driver_api crc_stm32_api = {
+	.crc32_ieee_update = crc_stm32_crc32_ieee_update,
+};
+
+static const struct crc_stm32_config crc_stm32_config = {
+	.crc = (CRC_TypeDef *)DT_INST_REG_ADDR(0),
+	.pclken = { .bus = DT_INST_CLOCKS_CELL(0, bus),
+		    .enr = DT_INST_CLOCKS_CELL(0, bits) },
+};
+
+static struct crc_stm32_data crc_stm32_data;
+
+DEVICE_AND_API_INIT(crc_stm32, DT_INST_LABEL(0), crc_stm32_init,
+		    &crc_stm32_data, &crc_stm32_config,
+		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+		    &crc_stm32_api);
@@ -22,7 +22,7 @@
 LOG_MODULE_REGISTER(crypto_stm32);
 
 #define CRYP_SUPPORT (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS | \
-		      CAP_NO_IV_PREFIX)
+		      CAP_ASYNC_OPS | CAP_NO_IV_PREFIX)
 #define BLOCK_LEN_BYTES 16
 #define BLOCK_LEN_WORDS (BLOCK_LEN_BYTES / sizeof(uint32_t))
 #define CRYPTO_MAX_SESSION CONFIG_CRYPTO_STM32_MAX_SESSION
@@ -43,8 +43,8 @@ static void copy_reverse_words(uint8_t *dst_buf, int dst_len,
 	}
 }
 
-static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
-		      uint8_t *out_buf)
+static int do_crypt(struct cipher_ctx *ctx, struct cipher_pkt *pkt,
+		    uint8_t *in_buf, int in_len, uint8_t *out_buf, bool encrypt)
 {
 	HAL_StatusTypeDef status;
 
@@ -60,47 +60,80 @@ static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 		return -EIO;
 	}
 
-	status = HAL_CRYP_Encrypt(&data->hcryp, (uint32_t *)in_buf, in_len,
-				  (uint32_t *)out_buf, HAL_MAX_DELAY);
-	if (status != HAL_OK) {
-		LOG_ERR("Encryption error");
-		k_sem_give(&data->device_sem);
-		return -EIO;
+	/* Asynchronous operations hold the device until they complete, the
+	 * ones submitted meanwhile wait for it in order.
+	 */
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		data->async_pkt = pkt;
+
+		if (encrypt) {
+			status = HAL_CRYP_Encrypt_IT(&data->hcryp,
+						     (uint32_t *)in_buf, in_len,
+						     (uint32_t *)out_buf);
+		} else {
+			status = HAL_CRYP_Decrypt_IT(&data->hcryp,
+						     (uint32_t *)in_buf, in_len,
+						     (uint32_t *)out_buf);
+		}
+
+		if (status != HAL_OK) {
+			LOG_ERR("%s error", encrypt ? "Encryption" :
+				"Decryption");
+			data->async_pkt = NULL;
+			k_sem_give(&data->device_sem);
+			return -EIO;
+		}
+
+		return 0;
+	}
+
+	if (encrypt) {
+		status = HAL_CRYP_Encrypt(&data->hcryp, (uint32_t *)in_buf,
+					  in_len, (uint32_t *)out_buf,
+					  HAL_MAX_DELAY);
+	} else {
+		status = HAL_CRYP_Decrypt(&data->hcryp, (uint32_t *)in_buf,
+					  in_len, (uint32_t *)out_buf,
+					  HAL_MAX_DELAY);
 	}
 
 	k_sem_give(&data->device_sem);
 
+	if (status != HAL_OK) {
+		LOG_ERR("%s error", encrypt ? "Encryption" : "Decryption");
+		return -EIO;
+	}
+
 	return 0;
 }
 
-static int do_decrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
-		      uint8_t *out_buf)
+static void crypto_stm32_complete(CRYP_HandleTypeDef *hcryp, int status)
 {
-	HAL_StatusTypeDef status;
-
-	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(ctx->device);
-	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
-
-	k_sem_take(&data->device_sem, K_FOREVER);
+	struct crypto_stm32_data *data =
+		CONTAINER_OF(hcryp, struct crypto_stm32_data, hcryp);
+	struct cipher_pkt *pkt = data->async_pkt;
 
-	status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
-	if (status != HAL_OK) {
-		LOG_ERR("Configuration error");
-		k_sem_give(&data->device_sem);
-		return -EIO;
+	if (pkt == NULL) {
+		return;
 	}
 
-	status = HAL_CRYP_Decrypt(&data->hcryp, (uint32_t *)in_buf, in_len,
-				  (uint32_t *)out_buf, HAL_MAX_DELAY);
-	if (status != HAL_OK) {
-		LOG_ERR("Decryption error");
-		k_sem_give(&data->device_sem);
-		return -EIO;
+	data->async_pkt = NULL;
+	k_sem_give(&data->device_sem);
+
+	if (data->async_cb != NULL) {
+		data->async_cb(pkt, status);
 	}
+}
 
-	k_sem_give(&data->device_sem);
+void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef *hcryp)
+{
+	crypto_stm32_complete(hcryp, 0);
+}
 
-	return 0;
+void HAL_CRYP_ErrorCallback(CRYP_HandleTypeDef *hcryp)
+{
+	LOG_ERR("Asynchronous operation error");
+	crypto_stm32_complete(hcryp, -EIO);
 }
 
 static int crypto_stm32_ecb_encrypt(struct cipher_ctx *ctx,
@@ -116,7 +149,7 @@ static int crypto_stm32_ecb_encrypt(struct cipher_ctx *ctx,
 		return -EINVAL;
 	}
 
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
+	ret = do_crypt(ctx, pkt, pkt->in_buf, pkt->in_len, pkt->out_buf, true);
 	if (ret == 0) {
 		pkt->out_len = 16;
 	}
@@ -137,7 +170,8 @@ static int crypto_stm32_ecb_decrypt(struct cipher_ctx *ctx,
 		return -EINVAL;
 	}
 
-	ret = do_decrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
+	ret = do_crypt(ctx, pkt, pkt->in_buf, pkt->in_len, pkt->out_buf,
+		       false);
 	if (ret == 0) {
 		pkt->out_len = 16;
 	}
@@ -163,8 +197,8 @@ static int crypto_stm32_cbc_encrypt(struct cipher_ctx *ctx,
 		out_offset = 16;
 	}
 
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len,
-			 pkt->out_buf + out_offset);
+	ret = do_crypt(ctx, pkt, pkt->in_buf, pkt->in_len,
+		       pkt->out_buf + out_offset, true);
 	if (ret == 0) {
 		pkt->out_len = pkt->in_len + out_offset;
 	}
@@ -188,8 +222,8 @@ static int crypto_stm32_cbc_decrypt(struct cipher_ctx *ctx,
 		in_offset = 16;
 	}
 
-	ret = do_decrypt(ctx, pkt->in_buf + in_offset, pkt->in_len,
-			 pkt->out_buf);
+	ret = do_crypt(ctx, pkt, pkt->in_buf + in_offset, pkt->in_len,
+		       pkt->out_buf, false);
 	if (ret == 0) {
 		pkt->out_len = pkt->in_len - in_offset;
 	}
@@ -209,7 +243,7 @@ static int crypto_stm32_ctr_encrypt(struct cipher_ctx *ctx,
 	copy_reverse_words((uint8_t *)ctr, sizeof(ctr), iv, ivlen);
 	session->config.pInitVect = ctr;
 
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
+	ret = do_crypt(ctx, pkt, pkt->in_buf, pkt->in_len, pkt->out_buf, true);
 	if (ret == 0) {
 		pkt->out_len = pkt->in_len;
 	}
@@ -229,7 +263,8 @@ static int crypto_stm32_ctr_decrypt(struct cipher_ctx *ctx,
 	copy_reverse_words((uint8_t *)ctr, sizeof(ctr), iv, ivlen);
 	session->config.pInitVect = ctr;
 
-	ret = do_decrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
+	ret = do_crypt(ctx, pkt, pkt->in_buf, pkt->in_len, pkt->out_buf,
+		       false);
 	if (ret == 0) {
 		pkt->out_len = pkt->in_len;
 	}
@@ -421,6 +456,23 @@ static int crypto_stm32_query_caps(const struct device *dev)
 	return CRYP_SUPPORT;
 }
 
+static int crypto_stm32_callback_set(const struct device *dev,
+				     crypto_completion_cb cb)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+
+	data->async_cb = cb;
+
+	return 0;
+}
+
+static void crypto_stm32_isr(const struct device *dev)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+
+	HAL_CRYP_IRQHandler(&data->hcryp);
+}
+
 static int crypto_stm32_init(const struct device *dev)
 {
 	const struct device *clk = device_get_binding(STM32_CLOCK_CONTROL_NAME);
@@ -439,13 +491,15 @@ static int crypto_stm32_init(const struct device *dev)
 		return -EIO;
 	}
 
+	cfg->irq_config();
+
 	return 0;
 }
 
 static struct crypto_driver_api crypto_enc_funcs = {
 	.begin_session = crypto_stm32_session_setup,
 	.free_session = crypto_stm32_session_free,
-	.crypto_async_callback_set = NULL,
+	.crypto_async_callback_set = crypto_stm32_callback_set,
 	.query_hw_caps = crypto_stm32_query_caps,
 };
 
@@ -455,14 +509,24 @@ static struct crypto_stm32_data crypto_stm32_dev_data = {
 	}
 };
 
+static void crypto_stm32_irq_config(void);
+
 static struct crypto_stm32_config crypto_stm32_dev_config = {
 	.pclken = {
 		.enr = DT_INST_CLOCKS_CELL(0, bits),
 		.bus = DT_INST_CLOCKS_CELL(0, bus)
-	}
+	},
+	.irq_config = crypto_stm32_irq_config,
 };
 
 DEVICE_AND_API_INIT(crypto_stm32, DT_INST_LABEL(0),
 		    crypto_stm32_init, &crypto_stm32_dev_data,
 		    &crypto_stm32_dev_config, POST_KERNEL,
 		    CONFIG_CRYPTO_INIT_PRIORITY, (void *)&crypto_enc_funcs);
+
+static void crypto_stm32_irq_config(void)
+{
+	IRQ_CONNECT(DT_INST_IRQN(0), DT_INST_IRQ(0, priority),
+		    crypto_stm32_isr, DEVICE_GET(crypto_stm32), 0);
+	irq_enable(DT_INST_IRQN(0));
+}
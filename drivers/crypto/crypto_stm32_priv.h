@@ -13,12 +13,16 @@
 
 struct crypto_stm32_config {
 	struct stm32_pclken pclken;
+	void (*irq_config)(void);
 };
 
 struct crypto_stm32_data {
 	CRYP_HandleTypeDef hcryp;
 	struct k_sem device_sem;
 	struct k_sem session_sem;
+	crypto_completion_cb async_cb;
+	/* Asynchronous operation in progress */
+	struct cipher_pkt *async_pkt;
 };
 
 struct crypto_stm32_session {
@@ -16,6 +16,10 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(display_ili9xxx, CONFIG_DISPLAY_LOG_LEVEL);
 
+#if defined(CONFIG_DISPLAY_ASYNC) && defined(CONFIG_SPI_ASYNC)
+#define ILI9XXX_WRITE_ASYNC
+#endif
+
 struct ili9xxx_data {
 	const struct device *reset_gpio;
 	const struct device *command_data_gpio;
@@ -25,6 +29,16 @@ struct ili9xxx_data {
 	uint8_t bytes_per_pixel;
 	enum display_pixel_format pixel_format;
 	enum display_orientation orientation;
+#ifdef ILI9XXX_WRITE_ASYNC
+	/* Taken while an asynchronous write is in progress */
+	struct k_sem async_sem;
+	struct spi_buf async_buf;
+	struct spi_buf_set async_bufs;
+	struct k_poll_signal spi_signal;
+	struct k_poll_event spi_event;
+	struct k_work_poll async_work;
+	struct k_poll_signal *user_signal;
+#endif
 };
 
 int ili9xxx_transmit(const struct device *dev, uint8_t cmd, const void *tx_data,
@@ -65,6 +79,21 @@ int ili9xxx_transmit(const struct device *dev, uint8_t cmd, const void *tx_data,
 	return 0;
 }
 
+#ifdef ILI9XXX_WRITE_ASYNC
+/* Commands must not be sent while the pixels of an asynchronous write are */
+static void ili9xxx_wait_idle(const struct device *dev)
+{
+	struct ili9xxx_data *data = (struct ili9xxx_data *)dev->data;
+
+	k_sem_take(&data->async_sem, K_FOREVER);
+	k_sem_give(&data->async_sem);
+}
+#else
+static inline void ili9xxx_wait_idle(const struct device *dev)
+{
+}
+#endif
+
 static int ili9xxx_exit_sleep(const struct device *dev)
 {
 	int r;
@@ -142,6 +171,7 @@ static int ili9xxx_write(const struct device *dev, const uint16_t x,
 
 	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)", desc->width, desc->height,
 		x, y);
+	ili9xxx_wait_idle(dev);
 	r = ili9xxx_set_mem_area(dev, x, y, desc->width, desc->height);
 	if (r < 0) {
 		return r;
@@ -180,6 +210,103 @@ static int ili9xxx_write(const struct device *dev, const uint16_t x,
 	return 0;
 }
 
+#ifdef ILI9XXX_WRITE_ASYNC
+static void ili9xxx_async_done(struct k_work *work)
+{
+	struct ili9xxx_data *data =
+		CONTAINER_OF(work, struct ili9xxx_data, async_work);
+	struct k_poll_signal *signal = data->user_signal;
+	unsigned int signaled;
+	int result;
+
+	k_poll_signal_check(&data->spi_signal, &signaled, &result);
+	k_sem_give(&data->async_sem);
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, result);
+	}
+}
+
+static int ili9xxx_write_async(const struct device *dev, const uint16_t x,
+			       const uint16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf, struct k_poll_signal *signal)
+{
+	const struct ili9xxx_config *config =
+		(struct ili9xxx_config *)dev->config;
+	struct ili9xxx_data *data = (struct ili9xxx_data *)dev->data;
+
+	int r;
+
+	/* Rows that are not contiguous are not worth a DMA transfer each */
+	if (desc->pitch > desc->width) {
+		r = ili9xxx_write(dev, x, y, desc, buf);
+		if (r == 0) {
+			k_poll_signal_raise(signal, 0);
+		}
+		return r;
+	}
+
+	__ASSERT((desc->pitch * data->bytes_per_pixel * desc->height) <=
+			 desc->buf_size,
+		 "Input buffer to small");
+
+	k_sem_take(&data->async_sem, K_FOREVER);
+
+	r = ili9xxx_set_mem_area(dev, x, y, desc->width, desc->height);
+	if (r == 0) {
+		r = ili9xxx_transmit(dev, ILI9XXX_RAMWR, NULL, 0);
+	}
+
+	if (r < 0) {
+		k_sem_give(&data->async_sem);
+		return r;
+	}
+
+	data->async_buf.buf = (void *)buf;
+	data->async_buf.len = desc->width * data->bytes_per_pixel *
+			      desc->height;
+	data->user_signal = signal;
+
+	k_poll_signal_reset(&data->spi_signal);
+	r = k_work_poll_submit(&data->async_work, &data->spi_event, 1,
+			       K_FOREVER);
+	if (r < 0) {
+		k_sem_give(&data->async_sem);
+		return r;
+	}
+
+	gpio_pin_set(data->command_data_gpio, config->cmd_data_pin,
+		     ILI9XXX_DATA);
+	r = spi_transceive_async(data->spi_dev, &data->spi_config,
+				 &data->async_bufs, NULL, &data->spi_signal);
+	if (r < 0) {
+		k_work_poll_cancel(&data->async_work);
+		k_sem_give(&data->async_sem);
+		return r;
+	}
+
+	return 0;
+}
+
+static void ili9xxx_async_init(const struct device *dev)
+{
+	struct ili9xxx_data *data = (struct ili9xxx_data *)dev->data;
+
+	k_sem_init(&data->async_sem, 1, 1);
+	data->async_bufs.buffers = &data->async_buf;
+	data->async_bufs.count = 1U;
+	k_poll_signal_init(&data->spi_signal);
+	k_poll_event_init(&data->spi_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &data->spi_signal);
+	k_work_poll_init(&data->async_work, ili9xxx_async_done);
+}
+#else
+static inline void ili9xxx_async_init(const struct device *dev)
+{
+}
+#endif
+
 static int ili9xxx_read(const struct device *dev, const uint16_t x,
 			const uint16_t y,
 			const struct display_buffer_descriptor *desc, void *buf)
@@ -197,12 +324,14 @@ static void *ili9xxx_get_framebuffer(const struct device *dev)
 static int ili9xxx_display_blanking_off(const struct device *dev)
 {
 	LOG_DBG("Turning display blanking off");
+	ili9xxx_wait_idle(dev);
 	return ili9xxx_transmit(dev, ILI9XXX_DISPON, NULL, 0);
 }
 
 static int ili9xxx_display_blanking_on(const struct device *dev)
 {
 	LOG_DBG("Turning display blanking on");
+	ili9xxx_wait_idle(dev);
 	return ili9xxx_transmit(dev, ILI9XXX_DISPOFF, NULL, 0);
 }
 
@@ -241,6 +370,7 @@ ili9xxx_set_pixel_format(const struct device *dev,
 		return -ENOTSUP;
 	}
 
+	ili9xxx_wait_idle(dev);
 	r = ili9xxx_transmit(dev, ILI9XXX_PIXSET, &tx_data, 1U);
 	if (r < 0) {
 		return r;
@@ -271,6 +401,7 @@ static int ili9xxx_set_orientation(const struct device *dev,
 			   ILI9XXX_MADCTL_MY;
 	}
 
+	ili9xxx_wait_idle(dev);
 	r = ili9xxx_transmit(dev, ILI9XXX_MADCTL, &tx_data, 1U);
 	if (r < 0) {
 		return r;
@@ -359,6 +490,8 @@ static int ili9xxx_init(const struct device *dev)
 
 	int r;
 
+	ili9xxx_async_init(dev);
+
 	data->spi_dev = device_get_binding(config->spi_name);
 	if (data->spi_dev == NULL) {
 		LOG_ERR("Could not get SPI device %s", config->spi_name);
@@ -430,6 +563,9 @@ static const struct display_driver_api ili9xxx_api = {
 	.get_capabilities = ili9xxx_get_capabilities,
 	.set_pixel_format = ili9xxx_set_pixel_format,
 	.set_orientation = ili9xxx_set_orientation,
+#ifdef ILI9XXX_WRITE_ASYNC
+	.write_async = ili9xxx_write_async,
+#endif
 };
 
 #define INST_DT_ILI9XXX(n, t) DT_INST(n, ilitek_ili##t)
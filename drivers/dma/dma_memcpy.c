@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <drivers/dma_memcpy.h>
+
+#define LOG_LEVEL CONFIG_DMA_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(dma_memcpy);
+
+static struct dma_memcpy_chan *chan_alloc(struct dma_memcpy *mc)
+{
+	for (int i = 0; i < ARRAY_SIZE(mc->chan); i++) {
+		if (!atomic_test_and_set_bit(&mc->used, i)) {
+			return &mc->chan[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void chan_free(struct dma_memcpy_chan *chan)
+{
+	struct dma_memcpy *mc = chan->mc;
+
+	atomic_clear_bit(&mc->used, chan - mc->chan);
+}
+
+static uint32_t chan_id(struct dma_memcpy_chan *chan)
+{
+	return chan->mc->first_channel + (chan - chan->mc->chan);
+}
+
+/* Widest data size the addresses and the length are aligned on */
+static uint32_t seg_data_size(const struct dma_memcpy_seg *seg)
+{
+	uintptr_t bits = (uintptr_t)seg->dst | (uintptr_t)seg->src | seg->len;
+
+	if ((bits & 0x3) == 0) {
+		return 4;
+	} else if ((bits & 0x1) == 0) {
+		return 2;
+	}
+
+	return 1;
+}
+
+static void chan_done(const struct device *dev, void *user_data,
+		      uint32_t channel, int status);
+
+/* Program and start the next segment of the copy. The configuration is
+ * redone for every segment, not all the controllers can chain blocks and
+ * the data size may change.
+ */
+static int chan_start_next(struct dma_memcpy_chan *chan)
+{
+	const struct dma_memcpy_seg *seg = &chan->segs[chan->next++];
+	uint32_t size = seg_data_size(seg);
+	int err;
+
+	chan->block = (struct dma_block_config) {
+		.source_address = (uintptr_t)seg->src,
+		.dest_address = (uintptr_t)seg->dst,
+		.block_size = seg->len,
+	};
+
+	chan->cfg = (struct dma_config) {
+		.channel_direction = MEMORY_TO_MEMORY,
+		.source_data_size = size,
+		.dest_data_size = size,
+		.source_burst_length = 1U,
+		.dest_burst_length = 1U,
+		.block_count = 1U,
+		.head_block = &chan->block,
+		.user_data = chan,
+		.dma_callback = chan_done,
+	};
+
+	err = dma_config(chan->mc->dev, chan_id(chan), &chan->cfg);
+	if (err) {
+		return err;
+	}
+
+	return dma_start(chan->mc->dev, chan_id(chan));
+}
+
+static void chan_complete(struct dma_memcpy_chan *chan, int status)
+{
+	dma_memcpy_callback_t cb = chan->cb;
+	void *user_data = chan->user_data;
+
+	/* Free the channel first so that the callback can submit again */
+	chan_free(chan);
+
+	if (cb) {
+		cb(user_data, status);
+	}
+}
+
+static void chan_done(const struct device *dev, void *user_data,
+		      uint32_t channel, int status)
+{
+	struct dma_memcpy_chan *chan = user_data;
+
+	if (status == 0 && chan->next < chan->count) {
+		status = chan_start_next(chan);
+		if (status == 0) {
+			return;
+		}
+
+		LOG_ERR("Cannot start segment %zu on channel %u (%d)",
+			chan->next - 1, channel, status);
+	}
+
+	chan_complete(chan, status);
+}
+
+static int chan_submit(struct dma_memcpy_chan *chan,
+		       const struct dma_memcpy_seg *segs, size_t count,
+		       dma_memcpy_callback_t cb, void *user_data)
+{
+	int err;
+
+	chan->segs = segs;
+	chan->count = count;
+	chan->next = 0;
+	chan->cb = cb;
+	chan->user_data = user_data;
+
+	err = chan_start_next(chan);
+	if (err) {
+		chan_free(chan);
+	}
+
+	return err;
+}
+
+void dma_memcpy_init(struct dma_memcpy *mc, const struct device *dev,
+		     uint32_t first_channel)
+{
+	mc->dev = dev;
+	mc->first_channel = first_channel;
+	atomic_clear(&mc->used);
+
+	for (int i = 0; i < ARRAY_SIZE(mc->chan); i++) {
+		mc->chan[i].mc = mc;
+	}
+}
+
+int dma_memcpy_sg_async(struct dma_memcpy *mc,
+			const struct dma_memcpy_seg *segs, size_t count,
+			dma_memcpy_callback_t cb, void *user_data)
+{
+	struct dma_memcpy_chan *chan;
+
+	if (count == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (segs[i].len == 0) {
+			return -EINVAL;
+		}
+	}
+
+	chan = chan_alloc(mc);
+	if (!chan) {
+		return -EBUSY;
+	}
+
+	return chan_submit(chan, segs, count, cb, user_data);
+}
+
+int dma_memcpy_async(struct dma_memcpy *mc, void *dst, const void *src,
+		     size_t len, dma_memcpy_callback_t cb, void *user_data)
+{
+	struct dma_memcpy_chan *chan;
+
+	if (len == 0) {
+		return -EINVAL;
+	}
+
+	chan = chan_alloc(mc);
+	if (!chan) {
+		return -EBUSY;
+	}
+
+	chan->seg.dst = dst;
+	chan->seg.src = src;
+	chan->seg.len = len;
+
+	return chan_submit(chan, &chan->seg, 1, cb, user_data);
+}
@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/ethernet.h>
+#include <net/ethernet_rx_poll.h>
 #include <ethernet/eth_stats.h>
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -139,6 +140,7 @@ struct eth_context {
 	void (*generate_mac)(uint8_t *);
 	struct k_work phy_work;
 	struct k_delayed_work delayed_phy_work;
+	struct net_eth_rx_poll rx_poll;
 	/* TODO: FIXME. This Ethernet frame sized buffer is used for
 	 * interfacing with MCUX. How it works is that hardware uses
 	 * DMA scatter buffers to receive a frame, and then public
@@ -702,7 +704,8 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
-static void eth_rx(struct eth_context *context)
+/* Receive one frame, returns false if there was none */
+static bool eth_rx(struct eth_context *context)
 {
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 	uint32_t frame_length = 0U;
@@ -717,6 +720,10 @@ static void eth_rx(struct eth_context *context)
 
 	status = ENET_GetRxFrameSize(&context->enet_handle,
 				     (uint32_t *)&frame_length, RING_ID);
+	if (status == kStatus_ENET_RxFrameEmpty) {
+		return false;
+	}
+
 	if (status) {
 		enet_data_error_stats_t error_stats;
 
@@ -732,7 +739,7 @@ static void eth_rx(struct eth_context *context)
 		goto flush;
 	}
 
-	/* Using root iface. It will be updated in net_recv_data() */
+	/* Using root iface. It is updated once the VLAN tag is known */
 	pkt = net_pkt_rx_alloc_with_buffer(context->iface, frame_length,
 					   AF_UNSPEC, 0, K_NO_WAIT);
 	if (!pkt) {
@@ -807,12 +814,10 @@ static void eth_rx(struct eth_context *context)
 
 	irq_unlock(imask);
 
-	if (net_recv_data(get_iface(context, vlan_tag), pkt) < 0) {
-		net_pkt_unref(pkt);
-		goto error;
-	}
+	net_pkt_set_iface(pkt, get_iface(context, vlan_tag));
+	net_eth_rx_poll_receive(&context->rx_poll, pkt);
 
-	return;
+	return true;
 flush:
 	/* Flush the current read buffer.  This operation can
 	 * only report failure if there is no frame to flush,
@@ -823,6 +828,41 @@ flush:
 	__ASSERT_NO_MSG(status == kStatus_Success);
 error:
 	eth_stats_update_errors_rx(get_iface(context, vlan_tag));
+
+	return true;
+}
+
+static int eth_rx_poll(struct net_eth_rx_poll *poll, int budget)
+{
+	struct eth_context *context =
+		CONTAINER_OF(poll, struct eth_context, rx_poll);
+	int count = 0;
+
+	while (count < budget && eth_rx(context)) {
+		count++;
+	}
+
+	return count;
+}
+
+static void eth_rx_poll_complete(struct net_eth_rx_poll *poll)
+{
+	struct eth_context *context =
+		CONTAINER_OF(poll, struct eth_context, rx_poll);
+
+	ENET_EnableInterrupts(context->base, kENET_RxFrameInterrupt);
+}
+
+/* Frames are received from the RX poll thread. The RX interrupt stays
+ * masked until the poll finds the ring empty.
+ */
+static void eth_rx_irq(struct eth_context *context)
+{
+	ENET_DisableInterrupts(context->base, kENET_RxFrameInterrupt);
+	ENET_ClearInterruptStatus(context->base, kENET_RxBufferInterrupt |
+				  kENET_RxFrameInterrupt);
+
+	net_eth_rx_poll_schedule(&context->rx_poll);
 }
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -869,7 +909,7 @@ static void eth_callback(ENET_Type *base, enet_handle_t *handle,
 
 	switch (event) {
 	case kENET_RxEvent:
-		eth_rx(context);
+		/* Not used, received frames are polled */
 		break;
 	case kENET_TxEvent:
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -998,6 +1038,8 @@ static int eth_init(const struct device *dev)
 	k_sem_init(&context->tx_buf_sem,
 		   0, CONFIG_ETH_MCUX_TX_BUFFERS);
 	k_work_init(&context->phy_work, eth_mcux_phy_work);
+	net_eth_rx_poll_init(&context->rx_poll, eth_rx_poll,
+			     eth_rx_poll_complete);
 	k_delayed_work_init(&context->delayed_phy_work,
 			    eth_mcux_delayed_phy_work);
 
@@ -1140,11 +1182,13 @@ static void eth_mcux_ptp_isr(const struct device *dev)
 static void eth_mcux_common_isr(const struct device *dev)
 {
 	struct eth_context *context = dev->data;
-	uint32_t EIR = ENET_GetInterruptStatus(context->base);
+	/* Leave out the RX events latched while RX polling masks them */
+	uint32_t EIR = ENET_GetInterruptStatus(context->base) &
+		       context->base->EIMR;
 	int irq_lock_key = irq_lock();
 
 	if (EIR & (kENET_RxBufferInterrupt | kENET_RxFrameInterrupt)) {
-		ENET_ReceiveIRQHandler(context->base, &context->enet_handle);
+		eth_rx_irq(context);
 	} else if (EIR & (kENET_TxBufferInterrupt | kENET_TxFrameInterrupt)) {
 		ENET_TransmitIRQHandler(context->base, &context->enet_handle);
 	} else if (EIR & ENET_EIR_MII_MASK) {
@@ -1163,7 +1207,7 @@ static void eth_mcux_rx_isr(const struct device *dev)
 {
 	struct eth_context *context = dev->data;
 
-	ENET_ReceiveIRQHandler(context->base, &context->enet_handle);
+	eth_rx_irq(context);
 }
 #endif
 
@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/ethernet.h>
+#include <net/ethernet_rx_poll.h>
 #include <ethernet/eth_stats.h>
 #include <drivers/i2c.h>
 #include <soc.h>
@@ -1342,13 +1343,17 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	return rx_frame;
 }
 
-static void eth_rx(struct gmac_queue *queue)
+static int eth_rx_poll(struct net_eth_rx_poll *poll, int budget)
 {
+	struct gmac_queue *queue =
+		CONTAINER_OF(poll, struct gmac_queue, rx_poll);
 	struct eth_sam_dev_data *dev_data =
 		CONTAINER_OF(queue, struct eth_sam_dev_data,
 			     queue_list[queue->que_idx]);
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 	struct net_pkt *rx_frame;
+	unsigned int key;
+	int count = 0;
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	const struct device *dev = net_if_get_device(dev_data->iface);
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
@@ -1356,11 +1361,22 @@ static void eth_rx(struct gmac_queue *queue)
 	struct gptp_hdr *hdr;
 #endif
 
-	/* More than one frame could have been received by GMAC, get all
-	 * complete frames stored in the GMAC RX descriptor list.
+	/* More than one frame could have been received by GMAC, get the
+	 * complete frames stored in the GMAC RX descriptor list up to the
+	 * budget. The RX error interrupt may reset the list, so it is only
+	 * walked with interrupts locked.
 	 */
-	rx_frame = frame_get(queue);
-	while (rx_frame) {
+	while (count < budget) {
+		key = irq_lock();
+		rx_frame = frame_get(queue);
+		irq_unlock(key);
+
+		if (!rx_frame) {
+			break;
+		}
+
+		count++;
+
 		LOG_DBG("ETH rx");
 
 #if defined(CONFIG_NET_VLAN)
@@ -1402,15 +1418,31 @@ static void eth_rx(struct gmac_queue *queue)
 		}
 #endif /* CONFIG_PTP_CLOCK_SAM_GMAC */
 
-		if (net_recv_data(get_iface(dev_data, vlan_tag),
-				  rx_frame) < 0) {
-			eth_stats_update_errors_rx(get_iface(dev_data,
-							     vlan_tag));
-			net_pkt_unref(rx_frame);
-		}
+		net_pkt_set_iface(rx_frame, get_iface(dev_data, vlan_tag));
+		net_eth_rx_poll_receive(poll, rx_frame);
+	}
 
-		rx_frame = frame_get(queue);
+	return count;
+}
+
+static void eth_rx_poll_complete(struct net_eth_rx_poll *poll)
+{
+	struct gmac_queue *queue =
+		CONTAINER_OF(poll, struct gmac_queue, rx_poll);
+	struct eth_sam_dev_data *dev_data =
+		CONTAINER_OF(queue, struct eth_sam_dev_data,
+			     queue_list[queue->que_idx]);
+	const struct device *dev = net_if_get_device(dev_data->iface);
+	Gmac *gmac = DEV_CFG(dev)->regs;
+
+#if GMAC_ACTIVE_PRIORITY_QUEUE_NUM >= 1
+	if (queue->que_idx != GMAC_QUE_0) {
+		gmac->GMAC_IERPQ[queue->que_idx - 1] = GMAC_IERPQ_RCOMP;
+		return;
 	}
+#endif
+
+	gmac->GMAC_IER = GMAC_IER_RCOMP;
 }
 
 #if !defined(CONFIG_ETH_SAM_GMAC_FORCE_QUEUE) && \
@@ -1443,7 +1475,11 @@ static int priority2queue(enum net_priority priority)
 }
 #endif
 
-static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+/* Queue the frame's descriptors, and start the transmission unless start
+ * is false, in which case the caller starts it after queueing more frames.
+ */
+static int eth_tx_frame(const struct device *dev, struct net_pkt *pkt,
+			bool start)
 {
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
 	struct eth_sam_dev_data *const dev_data = DEV_DATA(dev);
@@ -1505,7 +1541,13 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 		dcache_clean((uint32_t)frag_data, frag->size);
 
 #if GMAC_MULTIPLE_TX_PACKETS == 1
-		k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		if (k_sem_take(&queue->tx_desc_sem, K_NO_WAIT) != 0) {
+			/* Descriptors of frames queued but not started yet
+			 * are only released once the controller sends them.
+			 */
+			gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+			k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		}
 
 		/* The following section becomes critical and requires IRQ lock
 		 * / unlock protection only due to the possibility of executing
@@ -1596,7 +1638,9 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 	__DMB();  /* data memory barrier */
 
 	/* Start transmission */
-	gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+	if (start) {
+		gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+	}
 
 #if GMAC_MULTIPLE_TX_PACKETS == 0
 	/* Wait until the packet is sent */
@@ -1624,6 +1668,39 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	return eth_tx_frame(dev, pkt, true);
+}
+
+#if defined(CONFIG_NET_IF_TX_BATCH) && GMAC_MULTIPLE_TX_PACKETS == 1
+/* Queue all the frames first and start the controller once. Without
+ * GMAC_MULTIPLE_TX_PACKETS every frame is waited for, so there is nothing
+ * to gain from batching.
+ */
+static int eth_tx_batch(const struct device *dev, struct net_pkt **pkts,
+			int count)
+{
+	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
+	Gmac *gmac = cfg->regs;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (eth_tx_frame(dev, pkts[i], false) < 0) {
+			break;
+		}
+	}
+
+	if (i > 0) {
+		__DMB();  /* data memory barrier */
+
+		gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+	}
+
+	return i;
+}
+#endif
+
 static void queue0_isr(const struct device *dev)
 {
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
@@ -1651,7 +1728,9 @@ static void queue0_isr(const struct device *dev)
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+		/* Masked until the poll has emptied the RX descriptor list */
+		gmac->GMAC_IDR = GMAC_IDR_RCOMP;
+		net_eth_rx_poll_schedule(&queue->rx_poll);
 	}
 
 	/* TX packet */
@@ -1701,7 +1780,8 @@ static inline void priority_queue_isr(const struct device *dev,
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+		gmac->GMAC_IDRPQ[queue_idx - 1] = GMAC_IDRPQ_RCOMP;
+		net_eth_rx_poll_schedule(&queue->rx_poll);
 	}
 
 	/* TX packet */
@@ -1908,6 +1988,9 @@ static void eth0_iface_init(struct net_if *iface)
 
 	/* Initialize GMAC queues */
 	for (i = GMAC_QUE_0; i < GMAC_QUEUE_NUM; i++) {
+		net_eth_rx_poll_init(&dev_data->queue_list[i].rx_poll,
+				     eth_rx_poll, eth_rx_poll_complete);
+
 		result = queue_init(cfg->regs, &dev_data->queue_list[i]);
 		if (result < 0) {
 			LOG_ERR("Unable to initialize ETH queue%d", i);
@@ -2133,6 +2216,9 @@ static const struct ethernet_api eth_api = {
 	.set_config = eth_sam_gmac_set_config,
 	.get_config = eth_sam_gmac_get_config,
 	.send = eth_tx,
+#if defined(CONFIG_NET_IF_TX_BATCH) && GMAC_MULTIPLE_TX_PACKETS == 1
+	.send_batch = eth_tx_batch,
+#endif
 
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	.get_ptp_clock = eth_sam_gmac_get_ptp_clock,
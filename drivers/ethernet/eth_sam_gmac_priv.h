@@ -255,6 +255,9 @@ struct gmac_queue {
 	/** Number of times transmit queue was flushed */
 	volatile uint32_t err_tx_flushed_count;
 
+	/** Polled receive of this queue */
+	struct net_eth_rx_poll rx_poll;
+
 	enum queue_idx que_idx;
 };
 
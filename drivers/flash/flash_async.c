@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <errno.h>
+#include <drivers/flash.h>
+
+static K_KERNEL_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_q;
+
+void z_flash_async_done(const struct device *dev, struct flash_async_req *req,
+			int result)
+{
+	struct k_poll_signal *signal = req->signal;
+
+	/* The callback may reuse the request, take what is needed first */
+	if (req->cb != NULL) {
+		req->cb(dev, req, result);
+	}
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, result);
+	}
+}
+
+static void flash_async_work(struct k_work *work)
+{
+	struct flash_async_req *req =
+		CONTAINER_OF(work, struct flash_async_req, work);
+	const struct device *dev = req->dev;
+	int rc;
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		rc = flash_read(dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_WRITE:
+		rc = flash_write(dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_ERASE:
+		rc = flash_erase(dev, req->offset, req->len);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	z_flash_async_done(dev, req, rc);
+}
+
+int flash_submit_async(const struct device *dev, struct flash_async_req *req)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if (req->op > FLASH_ASYNC_ERASE) {
+		return -EINVAL;
+	}
+
+	if (api->submit_async != NULL) {
+		return api->submit_async(dev, req);
+	}
+
+	req->dev = dev;
+	k_work_init(&req->work, flash_async_work);
+	k_work_submit_to_queue(&flash_async_q, &req->work);
+
+	return 0;
+}
+
+static int flash_async_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&flash_async_q, flash_async_stack,
+		       K_KERNEL_STACK_SIZEOF(flash_async_stack),
+		       K_PRIO_PREEMPT(CONFIG_FLASH_ASYNC_PRIORITY));
+	k_thread_name_set(&flash_async_q.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -359,6 +359,20 @@ flash_sim_get_parameters(const struct device *dev)
 	return &flash_sim_parameters;
 }
 
+#ifdef CONFIG_FLASH_XIP_API
+static int flash_sim_xip_address(const struct device *dev, off_t offset,
+				 size_t len, const void **addr)
+{
+	if (!flash_range_is_valid(dev, offset, len)) {
+		return -EINVAL;
+	}
+
+	*addr = FLASH(offset);
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_XIP_API */
+
 static const struct flash_driver_api flash_sim_api = {
 	.read = flash_sim_read,
 	.write = flash_sim_write,
@@ -368,6 +382,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_XIP_API
+	.xip_address = flash_sim_xip_address,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
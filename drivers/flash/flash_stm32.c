@@ -203,6 +203,20 @@ static int flash_stm32_read(const struct device *dev, off_t offset,
 	return 0;
 }
 
+#ifdef CONFIG_FLASH_XIP_API
+static int flash_stm32_xip_address(const struct device *dev, off_t offset,
+				   size_t len, const void **addr)
+{
+	if (!flash_stm32_valid_range(dev, offset, len, false)) {
+		return -EINVAL;
+	}
+
+	*addr = (const uint8_t *)CONFIG_FLASH_BASE_ADDRESS + offset;
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_XIP_API */
+
 static int flash_stm32_erase(const struct device *dev, off_t offset,
 			     size_t len)
 {
@@ -342,6 +356,9 @@ static const struct flash_driver_api flash_stm32_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_stm32_page_layout,
 #endif
+#ifdef CONFIG_FLASH_XIP_API
+	.xip_address = flash_stm32_xip_address,
+#endif
 };
 
 static int stm32_flash_init(const struct device *dev)
@@ -139,6 +139,20 @@ static int flash_nrf_read(const struct device *dev, off_t addr,
 	return 0;
 }
 
+#if defined(CONFIG_FLASH_XIP_API)
+static int flash_nrf_xip_address(const struct device *dev, off_t addr,
+				 size_t len, const void **map)
+{
+	if (!is_regular_addr_valid(addr, len)) {
+		return -EINVAL;
+	}
+
+	*map = (const void *)(addr + DT_REG_ADDR(SOC_NV_FLASH_NODE));
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_XIP_API */
+
 static int flash_nrf_write(const struct device *dev, off_t addr,
 			     const void *data, size_t len)
 {
@@ -263,6 +277,9 @@ static const struct flash_driver_api flash_nrf_api = {
 #if defined(CONFIG_FLASH_PAGE_LAYOUT)
 	.page_layout = flash_nrf_pages_layout,
 #endif
+#if defined(CONFIG_FLASH_XIP_API)
+	.xip_address = flash_nrf_xip_address,
+#endif
 };
 
 static int nrf_flash_init(const struct device *dev)
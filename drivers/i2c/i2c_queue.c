@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <drivers/i2c_queue.h>
+
+static struct i2c_transaction *queue_get(struct i2c_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	sys_snode_t *node;
+
+	node = sys_slist_get(&queue->pending);
+
+	k_spin_unlock(&queue->lock, key);
+
+	if (!node) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(node, struct i2c_transaction, node);
+}
+
+static void queue_work(struct k_work *work)
+{
+	struct i2c_queue *queue = CONTAINER_OF(work, struct i2c_queue, work);
+	struct i2c_transaction *txn;
+	int result;
+
+	while ((txn = queue_get(queue))) {
+		result = i2c_transfer(queue->dev, txn->msgs, txn->num_msgs,
+				      txn->addr);
+
+		if (txn->cb) {
+			txn->cb(txn, result);
+		}
+	}
+}
+
+void i2c_queue_init(struct i2c_queue *queue, const struct device *dev,
+		    struct k_work_q *work_q)
+{
+	queue->dev = dev;
+	queue->work_q = work_q ? work_q : &k_sys_work_q;
+	sys_slist_init(&queue->pending);
+	k_work_init(&queue->work, queue_work);
+}
+
+int i2c_queue_submit(struct i2c_queue *queue, struct i2c_transaction *txn)
+{
+	k_spinlock_key_t key;
+
+	if (!txn->msgs || !txn->num_msgs) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	sys_slist_append(&queue->pending, &txn->node);
+	k_spin_unlock(&queue->lock, key);
+
+	k_work_submit_to_queue(queue->work_q, &queue->work);
+
+	return 0;
+}
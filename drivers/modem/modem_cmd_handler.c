@@ -48,24 +48,19 @@ static void skipcrlf(struct modem_cmd_handler_data *data)
 static uint16_t findcrlf(struct modem_cmd_handler_data *data,
 		      struct net_buf **frag, uint16_t *offset)
 {
-	struct net_buf *buf = data->rx_buf;
-	uint16_t len = 0U, pos = 0U;
-
-	while (buf && buf->len && !is_crlf(*(buf->data + pos))) {
-		if (pos + 1 >= buf->len) {
-			len += buf->len;
-			buf = buf->frags;
-			pos = 0U;
-		} else {
-			pos++;
+	struct net_buf *buf;
+	uint16_t len = 0U, pos;
+
+	for (buf = data->rx_buf; buf && buf->len; buf = buf->frags) {
+		for (pos = 0U; pos < buf->len; pos++) {
+			if (is_crlf(buf->data[pos])) {
+				*offset = pos;
+				*frag = buf;
+				return len + pos;
+			}
 		}
-	}
 
-	if (buf && buf->len && is_crlf(*(buf->data + pos))) {
-		len += pos;
-		*offset = pos;
-		*frag = buf;
-		return len;
+		len += buf->len;
 	}
 
 	return 0;
@@ -110,28 +105,26 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 			struct modem_cmd *cmd,
 			uint8_t **argv, size_t argv_len, uint16_t *argc)
 {
-	int i, count = 0;
-	size_t begin, end;
+	int count = 0;
+	size_t begin, end, delim_len;
 
 	if (!data || !data->match_buf || !match_len || !cmd || !argv || !argc) {
 		return -EINVAL;
 	}
 
+	delim_len = strlen(cmd->delim);
 	begin = cmd->cmd_len;
 	end = cmd->cmd_len;
 	while (end < match_len) {
-		for (i = 0; i < strlen(cmd->delim); i++) {
-			if (data->match_buf[end] == cmd->delim[i]) {
-				/* mark a parameter beginning */
-				argv[*argc] = &data->match_buf[begin];
-				/* end parameter with NUL char */
-				data->match_buf[end] = '\0';
-				/* bump begin */
-				begin = end + 1;
-				count += 1;
-				(*argc)++;
-				break;
-			}
+		if (memchr(cmd->delim, data->match_buf[end], delim_len)) {
+			/* mark a parameter beginning */
+			argv[*argc] = &data->match_buf[begin];
+			/* end parameter with NUL char */
+			data->match_buf[end] = '\0';
+			/* bump begin */
+			begin = end + 1;
+			count += 1;
+			(*argc)++;
 		}
 
 		if (count >= cmd->arg_count) {
@@ -207,12 +200,14 @@ static int process_cmd(struct modem_cmd *cmd, size_t match_len,
 }
 
 /*
- * check 3 arrays of commands for a match in match_buf:
+ * check 3 arrays of commands for a match of the line of len bytes at the
+ * start of rx_buf, before it is copied:
  * - response handlers[0]
  * - unsolicited handlers[1]
  * - current assigned handlers[2]
  */
-static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data)
+static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data,
+					size_t len)
 {
 	int j, i;
 
@@ -222,11 +217,13 @@ static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data)
 		}
 
 		for (i = 0; i < data->cmds_len[j]; i++) {
+			struct modem_cmd *cmd = &data->cmds[j][i];
+
 			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
-				return &data->cmds[j][i];
+			if (cmd->cmd_len == 0U ||
+			    (cmd->cmd_len <= len &&
+			     starts_with(data->rx_buf, cmd->cmd))) {
+				return cmd;
 			}
 		}
 	}
@@ -309,7 +306,7 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 {
 	struct modem_cmd *cmd;
 	struct net_buf *frag = NULL;
-	size_t match_len;
+	size_t match_len = 0;
 	int ret;
 	uint16_t offset, len;
 
@@ -346,24 +343,28 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 			break;
 		}
 
-		/* load match_buf with content up to the next CR/LF */
-		/* NOTE: keep room in match_buf for ending NUL char */
-		match_len = net_buf_linearize(data->match_buf,
-					      data->match_buf_len - 1,
-					      data->rx_buf, 0, len);
-		if ((data->match_buf_len - 1) < match_len) {
-			LOG_ERR("Match buffer size (%zu) is too small for "
-				"incoming command size: %u!  Truncating!",
-				data->match_buf_len - 1, match_len);
-		}
+		k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+		/* The lines no handler is interested in are not copied */
+		cmd = find_cmd_match(data, len);
+		if (cmd || IS_ENABLED(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)) {
+			/* load match_buf with content up to the next CR/LF */
+			/* NOTE: keep room in match_buf for ending NUL char */
+			match_len = net_buf_linearize(data->match_buf,
+						      data->match_buf_len - 1,
+						      data->rx_buf, 0, len);
+			if ((data->match_buf_len - 1) < match_len) {
+				LOG_ERR("Match buffer size (%zu) is too small "
+					"for incoming command size: %u!  "
+					"Truncating!",
+					data->match_buf_len - 1, match_len);
+			}
 
 #if defined(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)
-		LOG_HEXDUMP_DBG(data->match_buf, match_len, "RECV");
+			LOG_HEXDUMP_DBG(data->match_buf, match_len, "RECV");
 #endif
+		}
 
-		k_sem_take(&data->sem_parse_lock, K_FOREVER);
-
-		cmd = find_cmd_match(data);
 		if (cmd) {
 			LOG_DBG("match cmd [%s] (len:%u)",
 				log_strdup(cmd->cmd), match_len);
@@ -567,7 +568,7 @@ int modem_cmd_handler_setup_cmds(struct modem_iface *iface,
 
 	for (i = 0; i < cmds_len; i++) {
 		if (i) {
-			k_sleep(K_MSEC(50));
+			k_sleep(K_MSEC(CONFIG_MODEM_CMD_HANDLER_SETUP_DELAY));
 		}
 
 		if (cmds[i].handle_cmd.cmd && cmds[i].handle_cmd.func) {
@@ -601,7 +602,7 @@ int modem_cmd_handler_setup_cmds_nolock(struct modem_iface *iface,
 
 	for (i = 0; i < cmds_len; i++) {
 		if (i) {
-			k_sleep(K_MSEC(50));
+			k_sleep(K_MSEC(CONFIG_MODEM_CMD_HANDLER_SETUP_DELAY));
 		}
 
 		if (cmds[i].handle_cmd.cmd && cmds[i].handle_cmd.func) {
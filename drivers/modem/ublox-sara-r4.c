@@ -76,6 +76,8 @@ static struct modem_pin modem_pins[] = {
 #define MDM_REGISTRATION_TIMEOUT	K_SECONDS(180)
 #define MDM_PROMPT_CMD_DELAY		K_MSEC(75)
 #define MDM_SENDMSG_SLEEP       K_MSEC(1)
+/* Messages up to this size are sent with a single command */
+#define MDM_SENDMSG_BUF_LEN     128
 
 #define MDM_MAX_DATA_LENGTH		1024
 #define MDM_RECV_MAX_BUF		30
@@ -1490,11 +1492,33 @@ static ssize_t offload_write(void *obj, const void *buffer, size_t count)
 
 static ssize_t offload_sendmsg(void *obj, const struct msghdr *msg, int flags)
 {
+	uint8_t buf[MDM_SENDMSG_BUF_LEN];
 	ssize_t sent = 0;
+	size_t total = 0;
 	int rc;
 
 	LOG_DBG("msg_iovlen:%d flags:%d", msg->msg_iovlen, flags);
 
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		total += msg->msg_iov[i].iov_len;
+	}
+
+	/* Gather the small messages, each modem command costs a round
+	 * trip, and a datagram has to be sent as a whole.
+	 */
+	if (msg->msg_iovlen > 1 && total > 0 && total <= sizeof(buf)) {
+		size_t len = 0;
+
+		for (int i = 0; i < msg->msg_iovlen; i++) {
+			memcpy(&buf[len], msg->msg_iov[i].iov_base,
+			       msg->msg_iov[i].iov_len);
+			len += msg->msg_iov[i].iov_len;
+		}
+
+		return offload_sendto(obj, buf, len, flags, msg->msg_name,
+				      msg->msg_namelen);
+	}
+
 	for (int i = 0; i < msg->msg_iovlen; i++) {
 
 		const char *buf = msg->msg_iov[i].iov_base;
@@ -1505,7 +1529,7 @@ static ssize_t offload_sendmsg(void *obj, const struct msghdr *msg, int flags)
 							msg->msg_name,
 							msg->msg_namelen);
 			if (rc < 0) {
-				if (rc == -EAGAIN) {
+				if (errno == EAGAIN) {
 					k_sleep(MDM_SENDMSG_SLEEP);
 				} else {
 					sent = rc;
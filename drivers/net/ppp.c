@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <net/net_core.h>
 #include <sys/ring_buffer.h>
 #include <sys/crc.h>
+#include <sys/byteorder.h>
 #include <drivers/uart.h>
 #include <drivers/console/uart_mux.h>
 #include <random/rand32.h>
@@ -37,6 +38,15 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include "../../subsys/net/ip/net_private.h"
 
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_BUF_LEN
+#define UART_TX_BUF_LEN CONFIG_NET_PPP_UART_TX_BUF_LEN
+
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+#define UART_TX_BUFS 2
+/* Line idle time after which the received bytes are passed on */
+#define UART_RX_TIMEOUT_MS 1
+#else
+#define UART_TX_BUFS 1
+#endif
 
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
@@ -59,11 +69,21 @@ struct ppp_driver_context {
 	/* How much free space we have in the net_pkt */
 	size_t available;
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	/* ppp data is received into these bufs in turn */
+	uint8_t rx_bufs[2][UART_BUF_LEN];
+	uint8_t rx_buf_next;
+
+	/* Given back once the UART is done sending */
+	struct k_sem tx_sem;
+#else
 	/* ppp data is read into this buf */
 	uint8_t buf[UART_BUF_LEN];
+#endif
 
-	/* ppp buf use when sending data */
-	uint8_t send_buf[UART_BUF_LEN];
+	/* ppp bufs used when sending data, send_buf is the one filled */
+	uint8_t send_bufs[UART_TX_BUFS][UART_TX_BUF_LEN];
+	uint8_t *send_buf;
 
 	uint8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
@@ -95,7 +115,17 @@ struct ppp_driver_context {
 
 static struct ppp_driver_context ppp_driver_context_data;
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+#if defined(CONFIG_NET_TEST)
+static void (*ppp_test_tx_cb)(const uint8_t *data, size_t len);
+
+void ppp_driver_set_tx_cb(void (*cb)(const uint8_t *data, size_t len))
+{
+	ppp_test_tx_cb = cb;
+}
+#endif
+
+static int ppp_save_bytes(struct ppp_driver_context *ppp,
+			  const uint8_t *data, size_t len)
 {
 	int ret;
 
@@ -118,16 +148,17 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving bytes");
 	}
 
 	/* This is not very intuitive but we must allocate new buffer
 	 * before we write a byte to last available cursor position.
 	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
+	if (ppp->available <= len) {
+		size_t size = MAX(len + 1U, CONFIG_NET_BUF_DATA_SIZE);
+
+		ret = net_pkt_alloc_buffer(ppp->pkt, size, AF_UNSPEC,
+					   K_NO_WAIT);
 		if (ret < 0) {
 			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
 			goto out_of_mem;
@@ -136,17 +167,15 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 		ppp->available = net_pkt_available_buffer(ppp->pkt);
 	}
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
-		if (ret < 0) {
-			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
-				ppp, ppp->pkt, ret);
-			goto out_of_mem;
-		}
-
-		ppp->available--;
+	ret = net_pkt_write(ppp->pkt, data, len);
+	if (ret < 0) {
+		LOG_ERR("[%p] Cannot write to pkt %p (%d)",
+			ppp, ppp->pkt, ret);
+		goto out_of_mem;
 	}
 
+	ppp->available -= len;
+
 	return 0;
 
 out_of_mem:
@@ -194,9 +223,29 @@ static void ppp_change_state(struct ppp_driver_context *ctx,
 
 static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 {
-	if (IS_ENABLED(CONFIG_NET_TEST)) {
+#if defined(CONFIG_NET_TEST)
+	if (ppp_test_tx_cb) {
+		ppp_test_tx_cb(ppp->send_buf, off);
+	}
+#elif defined(CONFIG_NET_PPP_ASYNC_UART)
+	int ret;
+
+	if (off == 0) {
 		return 0;
 	}
+
+	/* One transfer at a time, the other buf is filled meanwhile */
+	(void)k_sem_take(&ppp->tx_sem, K_FOREVER);
+
+	ret = uart_tx(ppp->dev, ppp->send_buf, off, SYS_FOREVER_MS);
+	if (ret < 0) {
+		LOG_ERR("[%p] Cannot send %d bytes (%d)", ppp, off, ret);
+		k_sem_give(&ppp->tx_sem);
+	}
+
+	ppp->send_buf = (ppp->send_buf == ppp->send_bufs[0]) ?
+			ppp->send_bufs[1] : ppp->send_bufs[0];
+#else
 	uint8_t *buf = ppp->send_buf;
 
 	/* If we're using gsm_mux, We don't want to use poll_out because sending
@@ -211,6 +260,7 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 			uart_poll_out(ppp->dev, *buf++);
 		}
 	}
+#endif
 
 	return 0;
 }
@@ -218,12 +268,15 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const uint8_t *data, int len, int off)
 {
-	int i;
+	while (len > 0) {
+		int chunk = MIN(len, UART_TX_BUF_LEN - off);
 
-	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+		memcpy(ppp->send_buf + off, data, chunk);
+		data += chunk;
+		len -= chunk;
+		off += chunk;
 
-		if (off >= sizeof(ppp->send_buf)) {
+		if (off >= UART_TX_BUF_LEN) {
 			off = ppp_send_flush(ppp, off);
 		}
 	}
@@ -231,6 +284,88 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
+/* Checks of the four bytes of a word at once, the result is only
+ * meaningful as a boolean.
+ */
+#define BYTES_ALL(x) (0x01010101U * (x))
+#define HAS_BYTE_LESS(w, n) (((w) - BYTES_ALL(n)) & ~(w) & BYTES_ALL(0x80))
+#define HAS_BYTE(w, b) HAS_BYTE_LESS((w) ^ BYTES_ALL(b), 1)
+
+/* RFC 1662 ch. 4.2, all the control characters are escaped as the
+ * Async-Control-Character-Map is not negotiated.
+ */
+static inline bool ppp_needs_escape(uint8_t byte)
+{
+	return byte == 0x7e || byte == 0x7d || byte < 0x20;
+}
+
+/* Length of the run of bytes at data sent as they are */
+static size_t ppp_escape_free_len(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t w;
+
+	for (; i + sizeof(w) <= len; i += sizeof(w)) {
+		memcpy(&w, &data[i], sizeof(w));
+
+		if (HAS_BYTE_LESS(w, 0x20) | HAS_BYTE(w, 0x7d) |
+		    HAS_BYTE(w, 0x7e)) {
+			break;
+		}
+	}
+
+	while (i < len && !ppp_needs_escape(data[i])) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Length of the run of received bytes at data with no flag or escape */
+static size_t ppp_unescaped_len(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t w;
+
+	for (; i + sizeof(w) <= len; i += sizeof(w)) {
+		memcpy(&w, &data[i], sizeof(w));
+
+		if (HAS_BYTE(w, 0x7d) | HAS_BYTE(w, 0x7e)) {
+			break;
+		}
+	}
+
+	while (i < len && data[i] != 0x7d && data[i] != 0x7e) {
+		i++;
+	}
+
+	return i;
+}
+
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const uint8_t *data, size_t len, int off)
+{
+	while (len > 0) {
+		size_t run = ppp_escape_free_len(data, len);
+		uint8_t escaped[2];
+
+		if (run > 0) {
+			off = ppp_send_bytes(ppp, data, run, off);
+			data += run;
+			len -= run;
+			continue;
+		}
+
+		escaped[0] = 0x7d;
+		escaped[1] = *data++ ^ 0x20;
+		len--;
+
+		off = ppp_send_bytes(ppp, escaped, sizeof(escaped), off);
+	}
+
+	return off;
+}
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 
 #define CLIENT "CLIENT"
@@ -308,7 +443,7 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 			 * the FCS. The address field will not be passed
 			 * to upper stack.
 			 */
-			ret = ppp_save_byte(ppp, byte);
+			ret = ppp_save_bytes(ppp, &byte, 1);
 			if (ret < 0) {
 				ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 			}
@@ -339,7 +474,7 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 				ppp->next_escaped = false;
 			}
 
-			ret = ppp_save_byte(ppp, byte);
+			ret = ppp_save_bytes(ppp, &byte, 1);
 			if (ret < 0) {
 				ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 			}
@@ -434,38 +569,57 @@ static void ppp_process_msg(struct ppp_driver_context *ppp)
 	ppp->pkt = NULL;
 }
 
-#if defined(CONFIG_NET_TEST)
-static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+static void ppp_input(struct ppp_driver_context *ppp, const uint8_t *data,
+		      size_t len)
 {
-	struct ppp_driver_context *ppp =
-		CONTAINER_OF(buf, struct ppp_driver_context, buf);
-	size_t i, len = *off;
+	while (len > 0) {
+		size_t run = 0;
 
-	for (i = 0; i < *off; i++) {
-		if (0) {
-			/* Extra debugging can be enabled separately if really
-			 * needed. Normally it would just print too much data.
-			 */
-			LOG_DBG("[%zd] %02x", i, buf[i]);
+		/* Runs of frame data with no flag or escape byte in them
+		 * are saved at once.
+		 */
+		if (ppp->state == STATE_HDLC_FRAME_DATA && !ppp->next_escaped) {
+			run = ppp_unescaped_len(data, len);
+		}
+
+		if (run > 0) {
+			if (ppp_save_bytes(ppp, data, run) < 0) {
+				ppp_change_state(ppp, STATE_HDLC_FRAME_START);
+			}
+
+			data += run;
+			len -= run;
+			continue;
 		}
 
-		if (ppp_input_byte(ppp, buf[i]) == 0) {
+		if (ppp_input_byte(ppp, *data) == 0) {
 			/* Ignore empty or too short frames */
 			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
 				ppp_process_msg(ppp);
-				break;
 			}
 		}
+
+		data++;
+		len--;
 	}
+}
 
-	if (i == *off) {
-		*off = 0;
-	} else {
-		*off = len - i - 1;
+#if defined(CONFIG_NET_TEST)
+static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+{
+	struct ppp_driver_context *ppp =
+		CONTAINER_OF(buf, struct ppp_driver_context, buf);
 
-		memmove(&buf[0], &buf[i + 1], *off);
+	if (0) {
+		/* Extra debugging can be enabled separately if really
+		 * needed. Normally it would just print too much data.
+		 */
+		LOG_HEXDUMP_DBG(buf, *off, "recv");
 	}
 
+	ppp_input(ppp, buf, *off);
+	*off = 0;
+
 	return buf;
 }
 
@@ -535,17 +689,6 @@ static bool calc_fcs(struct net_pkt *pkt, uint16_t *fcs, uint16_t protocol)
 	return true;
 }
 
-static uint16_t ppp_escape_byte(uint8_t byte, int *offset)
-{
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
-	}
-
-	*offset = 1;
-	return byte;
-}
-
 static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct ppp_driver_context *ppp = dev->data;
@@ -553,13 +696,9 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	uint16_t protocol = 0;
 	int send_off = 0;
 	uint32_t sync_addr_ctrl;
-	uint16_t fcs, escaped;
+	uint8_t fcs_bytes[2];
+	uint16_t fcs;
 	uint8_t byte;
-	int i, offset;
-
-#if defined(CONFIG_NET_TEST)
-	return 0;
-#endif
 
 	ARG_UNUSED(dev);
 
@@ -592,15 +731,8 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 				  sizeof(sync_addr_ctrl), send_off);
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
-
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		send_off = ppp_send_escaped(ppp, (const uint8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -612,27 +744,15 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	}
 
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (uint8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
-
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len,
+					    send_off);
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	/* The FCS is sent least significant byte first */
+	sys_put_le16(fcs, fcs_bytes);
+	send_off = ppp_send_escaped(ppp, fcs_bytes, sizeof(fcs_bytes),
+				    send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
@@ -646,7 +766,7 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 {
 	uint8_t *data;
-	size_t len, tmp;
+	size_t len;
 	int ret;
 
 	len = ring_buf_get_claim(&ppp->rx_ringbuf, &data,
@@ -661,16 +781,7 @@ static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 		LOG_HEXDUMP_DBG(data, len, ppp->dev->name);
 	}
 
-	tmp = len;
-
-	do {
-		if (ppp_input_byte(ppp, *data++) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-			}
-		}
-	} while (--tmp);
+	ppp_input(ppp, data, len);
 
 	ret = ring_buf_get_finish(&ppp->rx_ringbuf, len);
 	if (ret < 0) {
@@ -708,6 +819,10 @@ static int ppp_driver_init(const struct device *dev)
 	k_thread_name_set(&ppp->cb_workq.thread, "ppp_workq");
 #endif
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	k_sem_init(&ppp->tx_sem, 1, 1);
+#endif
+	ppp->send_buf = ppp->send_bufs[0];
 	ppp->pkt = NULL;
 	ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
@@ -765,7 +880,9 @@ use_random_mac:
 	net_if_set_link_addr(iface, ll_addr->addr, ll_addr->len,
 			     NET_LINK_ETHERNET);
 
+#if !defined(CONFIG_NET_PPP_ASYNC_UART)
 	memset(ppp->buf, 0, sizeof(ppp->buf));
+#endif
 
 	/* If we have a GSM modem with PPP support, then do not start the
 	 * interface automatically but only after the modem is ready.
@@ -784,7 +901,51 @@ static struct net_stats_ppp *ppp_get_stats(const struct device *dev)
 }
 #endif
 
-#if !defined(CONFIG_NET_TEST)
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+static void ppp_uart_async_cb(const struct device *uart,
+			      struct uart_event *evt, void *user_data)
+{
+	struct ppp_driver_context *context = user_data;
+	int ret;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&context->tx_sem);
+		break;
+	case UART_RX_RDY:
+		ret = ring_buf_put(&context->rx_ringbuf,
+				   evt->data.rx.buf + evt->data.rx.offset,
+				   evt->data.rx.len);
+		if (ret < evt->data.rx.len) {
+			LOG_ERR("Rx buffer doesn't have enough space. "
+				"Bytes pending: %d, written: %d",
+				evt->data.rx.len, ret);
+		}
+
+		k_work_submit_to_queue(&context->cb_workq, &context->cb_work);
+		break;
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(uart,
+				      context->rx_bufs[context->rx_buf_next],
+				      UART_BUF_LEN);
+		context->rx_buf_next ^= 1U;
+		break;
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors, it is resumed unless the
+		 * interface was stopped.
+		 */
+		if (atomic_get(&context->modem_init_done)) {
+			context->rx_buf_next = 1U;
+			(void)uart_rx_enable(uart, context->rx_bufs[0],
+					     UART_BUF_LEN, UART_RX_TIMEOUT_MS);
+		}
+		break;
+	default:
+		break;
+	}
+}
+#elif !defined(CONFIG_NET_TEST)
 static void ppp_uart_flush(const struct device *dev)
 {
 	uint8_t c;
@@ -865,12 +1026,38 @@ static int ppp_start(const struct device *dev)
 			return -ENODEV;
 		}
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+		int ret;
+
+		ret = uart_callback_set(context->dev, ppp_uart_async_cb,
+					context);
+		if (ret < 0) {
+			LOG_ERR("Cannot set callback of %s (%d)", dev_name,
+				ret);
+			context->modem_init_done = false;
+			return ret;
+		}
+
+		/* If reception still is being disabled after a stop, it is
+		 * enabled again once it is.
+		 */
+		context->rx_buf_next = 1U;
+		ret = uart_rx_enable(context->dev, context->rx_bufs[0],
+				     UART_BUF_LEN, UART_RX_TIMEOUT_MS);
+		if (ret < 0 && ret != -EBUSY) {
+			LOG_ERR("Cannot enable reception on %s (%d)",
+				dev_name, ret);
+			context->modem_init_done = false;
+			return ret;
+		}
+#else
 		uart_irq_rx_disable(context->dev);
 		uart_irq_tx_disable(context->dev);
 		ppp_uart_flush(context->dev);
 		uart_irq_callback_user_data_set(context->dev, ppp_uart_isr,
 						context);
 		uart_irq_rx_enable(context->dev);
+#endif
 	}
 #endif /* !CONFIG_NET_TEST */
 
@@ -885,6 +1072,9 @@ static int ppp_stop(const struct device *dev)
 
 	net_ppp_carrier_off(context->iface);
 	context->modem_init_done = false;
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	(void)uart_rx_disable(context->dev);
+#endif
 	return 0;
 }
 
@@ -26,7 +26,8 @@ LOG_MODULE_REGISTER(LSM6DSL, CONFIG_SENSOR_LOG_LEVEL);
 static const uint16_t lsm6dsl_odr_map[] = {0, 12, 26, 52, 104, 208, 416, 833,
 					1660, 3330, 6660};
 
-#if defined(LSM6DSL_ACCEL_ODR_RUNTIME) || defined(LSM6DSL_GYRO_ODR_RUNTIME)
+#if defined(LSM6DSL_ACCEL_ODR_RUNTIME) || defined(LSM6DSL_GYRO_ODR_RUNTIME) || \
+	defined(CONFIG_LSM6DSL_FIFO)
 static int lsm6dsl_freq_to_odr_val(uint16_t freq)
 {
 	size_t i;
@@ -170,6 +171,8 @@ static int lsm6dsl_gyro_set_odr_raw(const struct device *dev, uint8_t odr)
 		return -EIO;
 	}
 
+	data->gyro_freq = lsm6dsl_odr_to_freq_val(odr);
+
 	return 0;
 }
 
@@ -299,6 +302,95 @@ static int lsm6dsl_gyro_config(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_LSM6DSL_FIFO
+static int lsm6dsl_fifo_watermark_set(const struct device *dev,
+				      uint16_t frames)
+{
+	struct lsm6dsl_data *data = dev->data;
+	uint32_t fth = frames * LSM6DSL_FIFO_FRAME_WORDS;
+	int odr;
+
+	/* Leaving the bypass mode empties the FIFO */
+	if (data->hw_tf->update_reg(dev,
+				    LSM6DSL_REG_FIFO_CTRL5,
+				    LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE,
+				    LSM6DSL_FIFO_MODE_BYPASS <<
+				    LSM6DSL_SHIFT_FIFO_CTRL5_FIFO_MODE) < 0) {
+		return -EIO;
+	}
+
+	if (frames == 0U) {
+		return 0;
+	}
+
+	/* Both sensors are stored once per frame */
+	if (data->accel_freq == 0U || data->accel_freq != data->gyro_freq) {
+		LOG_DBG("FIFO needs the same accel and gyro sampling rate");
+		return -EINVAL;
+	}
+
+	if (fth > (LSM6DSL_MASK_FIFO_CTRL1_FTH |
+		   (LSM6DSL_MASK_FIFO_CTRL2_FTH << 8))) {
+		return -EINVAL;
+	}
+
+	odr = lsm6dsl_freq_to_odr_val(data->accel_freq);
+	if (odr < 0) {
+		return odr;
+	}
+
+	if (data->hw_tf->update_reg(dev,
+				    LSM6DSL_REG_FIFO_CTRL1,
+				    LSM6DSL_MASK_FIFO_CTRL1_FTH,
+				    fth & 0xFF) < 0 ||
+	    data->hw_tf->update_reg(dev,
+				    LSM6DSL_REG_FIFO_CTRL2,
+				    LSM6DSL_MASK_FIFO_CTRL2_FTH,
+				    fth >> 8) < 0) {
+		return -EIO;
+	}
+
+	/* No decimation for both sensors */
+	if (data->hw_tf->update_reg(dev,
+				    LSM6DSL_REG_FIFO_CTRL3,
+				    LSM6DSL_MASK_FIFO_CTRL3_DEC_FIFO_GYRO |
+				    LSM6DSL_MASK_FIFO_CTRL3_DEC_FIFO_XL,
+				    (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_GYRO) |
+				    (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_XL)) < 0) {
+		return -EIO;
+	}
+
+	if (data->hw_tf->update_reg(dev,
+				    LSM6DSL_REG_FIFO_CTRL5,
+				    LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO |
+				    LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE,
+				    (odr << LSM6DSL_SHIFT_FIFO_CTRL5_ODR_FIFO) |
+				    (LSM6DSL_FIFO_MODE_CONTINUOUS <<
+				     LSM6DSL_SHIFT_FIFO_CTRL5_FIFO_MODE)) < 0) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int lsm6dsl_fifo_config(const struct device *dev,
+			       enum sensor_attribute attr,
+			       const struct sensor_value *val)
+{
+	switch (attr) {
+	case SENSOR_ATTR_FIFO_WATERMARK:
+		if (val->val1 < 0 || val->val1 > UINT16_MAX) {
+			return -EINVAL;
+		}
+
+		return lsm6dsl_fifo_watermark_set(dev, val->val1);
+	default:
+		LOG_DBG("FIFO attribute not supported.");
+		return -ENOTSUP;
+	}
+}
+#endif
+
 static int lsm6dsl_attr_set(const struct device *dev,
 			    enum sensor_channel chan,
 			    enum sensor_attribute attr,
@@ -309,6 +401,10 @@ static int lsm6dsl_attr_set(const struct device *dev,
 		return lsm6dsl_accel_config(dev, chan, attr, val);
 	case SENSOR_CHAN_GYRO_XYZ:
 		return lsm6dsl_gyro_config(dev, chan, attr, val);
+#ifdef CONFIG_LSM6DSL_FIFO
+	case SENSOR_CHAN_ALL:
+		return lsm6dsl_fifo_config(dev, attr, val);
+#endif
 	default:
 		LOG_WRN("attr_set() not supported on this channel.");
 		return -ENOTSUP;
@@ -699,6 +795,111 @@ static int lsm6dsl_channel_get(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_LSM6DSL_FIFO
+static int lsm6dsl_fifo_read(const struct device *dev, void *buf, size_t len)
+{
+	struct lsm6dsl_data *data = dev->data;
+	/* Largest multiple of the frame size a single transfer can read */
+	const size_t chunk_max = UINT8_MAX / LSM6DSL_FIFO_FRAME_SIZE *
+				 LSM6DSL_FIFO_FRAME_SIZE;
+	uint8_t *frames = buf;
+	uint8_t status[4], word[LSM6DSL_FIFO_WORD_SIZE];
+	uint16_t words, pattern, skip;
+	size_t size, chunk;
+
+	if (data->hw_tf->read_data(dev, LSM6DSL_REG_FIFO_STATUS1,
+				   status, sizeof(status)) < 0) {
+		return -EIO;
+	}
+
+	if (status[1] & LSM6DSL_MASK_FIFO_STATUS2_OVER_RUN) {
+		LOG_WRN("FIFO overrun, samples were lost");
+	}
+
+	if (status[1] & LSM6DSL_MASK_FIFO_STATUS2_FIFO_EMPTY) {
+		return 0;
+	}
+
+	words = status[0] |
+		((status[1] & LSM6DSL_MASK_FIFO_STATUS2_DIFF_FIFO) << 8);
+	pattern = status[2] |
+		  ((status[3] & LSM6DSL_MASK_FIFO_STATUS4_FIFO_PATTERN) << 8);
+
+	/* Drop the words of a partial frame, an overrun may leave the read
+	 * pointer in the middle of one.
+	 */
+	skip = (LSM6DSL_FIFO_FRAME_WORDS - pattern) % LSM6DSL_FIFO_FRAME_WORDS;
+	if (skip > words) {
+		skip = words;
+	}
+
+	while (skip--) {
+		if (data->hw_tf->read_data(dev, LSM6DSL_REG_FIFO_DATA_OUT_L,
+					   word, sizeof(word)) < 0) {
+			return -EIO;
+		}
+		words--;
+	}
+
+	size = MIN(words / LSM6DSL_FIFO_FRAME_WORDS,
+		   len / LSM6DSL_FIFO_FRAME_SIZE) * LSM6DSL_FIFO_FRAME_SIZE;
+
+	/* Burst reads of the FIFO output wrap back to its low byte, each
+	 * word read is popped from the FIFO.
+	 */
+	for (size_t off = 0; off < size; off += chunk) {
+		chunk = MIN(size - off, chunk_max);
+		if (data->hw_tf->read_data(dev, LSM6DSL_REG_FIFO_DATA_OUT_L,
+					   frames + off, chunk) < 0) {
+			return -EIO;
+		}
+	}
+
+	return size;
+}
+
+static int lsm6dsl_fifo_decode(const struct device *dev,
+			       enum sensor_channel chan,
+			       const void *buf, size_t len,
+			       struct sensor_value *val, size_t count)
+{
+	struct lsm6dsl_data *data = dev->data;
+	const uint8_t *frame = buf;
+	size_t frames = MIN(len / LSM6DSL_FIFO_FRAME_SIZE, count / 3);
+	size_t off;
+
+	switch (chan) {
+	case SENSOR_CHAN_GYRO_XYZ:
+		off = 0;
+		break;
+	case SENSOR_CHAN_ACCEL_XYZ:
+		off = 3 * LSM6DSL_FIFO_WORD_SIZE;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	for (size_t i = 0; i < frames; i++) {
+		for (size_t axis = 0; axis < 3; axis++) {
+			int16_t raw = sys_get_le16(&frame[off + axis *
+						   LSM6DSL_FIFO_WORD_SIZE]);
+
+			if (chan == SENSOR_CHAN_GYRO_XYZ) {
+				lsm6dsl_gyro_convert(val++, raw,
+						     data->gyro_sensitivity);
+			} else {
+				lsm6dsl_accel_convert(val++, raw,
+						      data->accel_sensitivity);
+			}
+		}
+
+		frame += LSM6DSL_FIFO_FRAME_SIZE;
+	}
+
+	return frames;
+}
+#endif
+
 static const struct sensor_driver_api lsm6dsl_driver_api = {
 	.attr_set = lsm6dsl_attr_set,
 #if CONFIG_LSM6DSL_TRIGGER
@@ -706,6 +907,10 @@ static const struct sensor_driver_api lsm6dsl_driver_api = {
 #endif
 	.sample_fetch = lsm6dsl_sample_fetch,
 	.channel_get = lsm6dsl_channel_get,
+#ifdef CONFIG_LSM6DSL_FIFO
+	.fifo_read = lsm6dsl_fifo_read,
+	.fifo_decode = lsm6dsl_fifo_decode,
+#endif
 };
 
 static int lsm6dsl_init_chip(const struct device *dev)
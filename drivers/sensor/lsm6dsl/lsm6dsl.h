@@ -376,7 +376,7 @@
 #define LSM6DSL_MASK_FIFO_STATUS3_FIFO_PATTERN		0x0F
 #define LSM6DSL_SHIFT_FIFO_STATUS3_FIFO_PATTERN		0
 
-#define LSM6DSL_REG_FIFO_STATUS4			0x3C
+#define LSM6DSL_REG_FIFO_STATUS4			0x3D
 #define LSM6DSL_MASK_FIFO_STATUS4_FIFO_PATTERN		(BIT(1) | BIT(0))
 #define LSM6DSL_SHIFT_FIFO_STATUS4_FIFO_PATTERN		0
 
@@ -720,4 +720,15 @@ int lsm6dsl_trigger_set(const struct device *dev,
 int lsm6dsl_init_interrupt(const struct device *dev);
 #endif
 
+#ifdef CONFIG_LSM6DSL_FIFO
+/* A FIFO frame holds the gyroscope then the accelerometer X, Y and Z words */
+#define LSM6DSL_FIFO_WORD_SIZE		2
+#define LSM6DSL_FIFO_FRAME_WORDS	6
+#define LSM6DSL_FIFO_FRAME_SIZE		(LSM6DSL_FIFO_FRAME_WORDS * \
+					 LSM6DSL_FIFO_WORD_SIZE)
+/* FIFO_CTRL5 mode value, older samples are overwritten once full */
+#define LSM6DSL_FIFO_MODE_BYPASS	0
+#define LSM6DSL_FIFO_MODE_CONTINUOUS	6
+#endif
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_LSM6DSL_LSM6DSL_H_ */
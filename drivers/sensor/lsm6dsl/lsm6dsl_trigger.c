@@ -40,6 +40,28 @@ static inline void handle_irq(struct lsm6dsl_data *drv_data,
 #endif
 }
 
+/* Route INT1 to the data-ready or to the FIFO threshold events */
+static int lsm6dsl_int1_route(const struct device *dev,
+			      enum sensor_trigger_type type)
+{
+	struct lsm6dsl_data *drv_data = dev->data;
+	uint8_t val;
+
+	if (type == SENSOR_TRIG_FIFO_WATERMARK) {
+		val = BIT(LSM6DSL_SHIFT_INT1_FTH);
+	} else {
+		val = BIT(LSM6DSL_SHIFT_INT1_CTRL_DRDY_XL) |
+		      BIT(LSM6DSL_SHIFT_INT1_CTRL_DRDY_G);
+	}
+
+	return drv_data->hw_tf->update_reg(dev,
+					   LSM6DSL_REG_INT1_CTRL,
+					   LSM6DSL_MASK_INT1_FTH |
+					   LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+					   LSM6DSL_MASK_INT1_CTRL_DRDY_G,
+					   val);
+}
+
 int lsm6dsl_trigger_set(const struct device *dev,
 			const struct sensor_trigger *trig,
 			sensor_trigger_handler_t handler)
@@ -47,7 +69,11 @@ int lsm6dsl_trigger_set(const struct device *dev,
 	const struct lsm6dsl_config *config = dev->config;
 	struct lsm6dsl_data *drv_data = dev->data;
 
-	__ASSERT_NO_MSG(trig->type == SENSOR_TRIG_DATA_READY);
+	if (trig->type != SENSOR_TRIG_DATA_READY &&
+	    !(IS_ENABLED(CONFIG_LSM6DSL_FIFO) &&
+	      trig->type == SENSOR_TRIG_FIFO_WATERMARK)) {
+		return -ENOTSUP;
+	}
 
 	/* If irq_gpio is not configured in DT just return error */
 	if (!drv_data->gpio) {
@@ -57,6 +83,12 @@ int lsm6dsl_trigger_set(const struct device *dev,
 
 	setup_irq(drv_data, config->irq_pin, false);
 
+	if (IS_ENABLED(CONFIG_LSM6DSL_FIFO) &&
+	    lsm6dsl_int1_route(dev, trig->type) < 0) {
+		LOG_ERR("Could not route the interrupt.");
+		return -EIO;
+	}
+
 	drv_data->data_ready_handler = handler;
 	if (handler == NULL) {
 		return 0;
@@ -95,6 +127,15 @@ static void lsm6dsl_thread_cb(const struct device *dev)
 	}
 
 	setup_irq(drv_data, config->irq_pin, true);
+
+	/* The FIFO threshold stays asserted until enough words are read,
+	 * no edge would be seen if the handler left the line active.
+	 */
+	if (IS_ENABLED(CONFIG_LSM6DSL_FIFO) &&
+	    drv_data->data_ready_trigger.type == SENSOR_TRIG_FIFO_WATERMARK &&
+	    gpio_pin_get(drv_data->gpio, config->irq_pin) > 0) {
+		handle_irq(drv_data, config->irq_pin);
+	}
 }
 
 #ifdef CONFIG_LSM6DSL_TRIGGER_OWN_THREAD
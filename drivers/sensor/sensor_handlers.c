@@ -57,3 +57,29 @@ static inline int z_vrfy_sensor_channel_get(const struct device *dev,
 					 (struct sensor_value *)val);
 }
 #include <syscalls/sensor_channel_get_mrsh.c>
+
+static inline int z_vrfy_sensor_fifo_read(const struct device *dev,
+					  void *buf, size_t len)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, fifo_read));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(buf, len));
+	return z_impl_sensor_fifo_read((const struct device *)dev,
+				       (void *)buf, len);
+}
+#include <syscalls/sensor_fifo_read_mrsh.c>
+
+static inline int z_vrfy_sensor_fifo_decode(const struct device *dev,
+					    enum sensor_channel chan,
+					    const void *buf, size_t len,
+					    struct sensor_value *val,
+					    size_t count)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, fifo_decode));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(buf, len));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(val, count,
+					    sizeof(struct sensor_value)));
+	return z_impl_sensor_fifo_decode((const struct device *)dev, chan,
+					 (const void *)buf, len,
+					 (struct sensor_value *)val, count);
+}
+#include <syscalls/sensor_fifo_decode_mrsh.c>
@@ -28,6 +28,10 @@
 #include <drivers/clock_control/stm32_clock_control.h>
 #include "uart_stm32.h"
 
+#ifdef CONFIG_UART_ASYNC_API
+#include <dt-bindings/dma/stm32_dma.h>
+#endif
+
 #include <logging/log.h>
 LOG_MODULE_REGISTER(uart_stm32);
 
@@ -618,16 +622,491 @@ static void uart_stm32_irq_callback_set(const struct device *dev,
 	data->user_data = cb_data;
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+
+static inline uint32_t uart_stm32_dma_rx_addr(USART_TypeDef *UartInstance)
+{
+#ifdef USART_DR_DR
+	return (uint32_t)&UartInstance->DR;
+#else
+	return (uint32_t)&UartInstance->RDR;
+#endif
+}
+
+static inline uint32_t uart_stm32_dma_tx_addr(USART_TypeDef *UartInstance)
+{
+#ifdef USART_DR_DR
+	return (uint32_t)&UartInstance->DR;
+#else
+	return (uint32_t)&UartInstance->TDR;
+#endif
+}
+
+static void async_user_callback(struct uart_stm32_data *data,
+				struct uart_event *event)
+{
+	if (data->async_cb) {
+		data->async_cb(data->dev, event, data->async_user_data);
+	}
+}
+
+static void async_evt_rx_buf_release(struct uart_stm32_data *data,
+				     uint8_t *buf)
+{
+	struct uart_event event = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = buf,
+	};
+
+	async_user_callback(data, &event);
+}
+
+static void async_timer_start(struct k_delayed_work *work, int32_t timeout)
+{
+	if (timeout != SYS_FOREVER_MS && timeout != 0) {
+		k_delayed_work_submit(work, K_MSEC(timeout));
+	}
+}
+
+/* Report the data written by the DMA since the last report */
+static void uart_stm32_dma_rx_flush(const struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	size_t counter;
+
+	if (dma_get_status(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+			   &stat) != 0) {
+		return;
+	}
+
+	counter = data->dma_rx.buffer_length - stat.pending_length;
+	if (counter > data->dma_rx.offset) {
+		struct uart_event event = {
+			.type = UART_RX_RDY,
+			.data.rx.buf = data->dma_rx.buffer,
+			.data.rx.offset = data->dma_rx.offset,
+			.data.rx.len = counter - data->dma_rx.offset,
+		};
+
+		data->dma_rx.offset = counter;
+		async_user_callback(data, &event);
+	}
+}
+
+static int uart_stm32_dma_rx_stop(const struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_RX_DISABLED,
+	};
+
+	if (!data->dma_rx.enabled) {
+		return -EFAULT;
+	}
+
+	LL_USART_DisableIT_IDLE(UartInstance);
+	LL_USART_DisableDMAReq_RX(UartInstance);
+	k_delayed_work_cancel(&data->dma_rx.timeout_work);
+
+	uart_stm32_dma_rx_flush(dev);
+	dma_stop(data->dma_rx.dma_dev, data->dma_rx.dma_channel);
+	data->dma_rx.enabled = false;
+
+	async_evt_rx_buf_release(data, data->dma_rx.buffer);
+	data->dma_rx.buffer = NULL;
+
+	if (data->rx_next_buffer) {
+		async_evt_rx_buf_release(data, data->rx_next_buffer);
+		data->rx_next_buffer = NULL;
+		data->rx_next_buffer_len = 0;
+	}
+
+	async_user_callback(data, &event);
+
+	return 0;
+}
+
+/* The RX buffer is full, carry on in the next one if there is one */
+static void uart_stm32_dma_rx_cb(const struct device *dma_dev, void *user_data,
+				 uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	unsigned int key = irq_lock();
+	size_t done_len;
+	uint8_t *done;
+
+	if (!data->dma_rx.enabled) {
+		irq_unlock(key);
+		return;
+	}
+
+	k_delayed_work_cancel(&data->dma_rx.timeout_work);
+
+	if (status != 0 || !data->rx_next_buffer) {
+		uart_stm32_dma_rx_stop(dev);
+		irq_unlock(key);
+		return;
+	}
+
+	/* Restart on the next buffer before reporting the full one, the
+	 * receive register only holds one character.
+	 */
+	done = data->dma_rx.buffer;
+	done_len = data->dma_rx.buffer_length;
+	data->dma_rx.buffer = data->rx_next_buffer;
+	data->dma_rx.buffer_length = data->rx_next_buffer_len;
+	data->rx_next_buffer = NULL;
+	data->rx_next_buffer_len = 0;
+
+	dma_reload(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+		   uart_stm32_dma_rx_addr(UartInstance),
+		   (uint32_t)data->dma_rx.buffer,
+		   data->dma_rx.buffer_length);
+
+	if (data->dma_rx.offset < done_len) {
+		struct uart_event rdy = {
+			.type = UART_RX_RDY,
+			.data.rx.buf = done,
+			.data.rx.offset = data->dma_rx.offset,
+			.data.rx.len = done_len - data->dma_rx.offset,
+		};
+
+		async_user_callback(data, &rdy);
+	}
+
+	data->dma_rx.offset = 0;
+
+	async_evt_rx_buf_release(data, done);
+	async_user_callback(data, &event);
+
+	irq_unlock(key);
+}
+
+/* The line went idle, report the data once the timeout has elapsed */
+static void uart_stm32_dma_rx_idle(const struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	if (data->dma_rx.timeout == 0) {
+		uart_stm32_dma_rx_flush(dev);
+	} else {
+		async_timer_start(&data->dma_rx.timeout_work,
+				  data->dma_rx.timeout);
+	}
+}
+
+static void uart_stm32_async_rx_timeout(struct k_work *work)
+{
+	struct uart_dma_stream *rx_stream = CONTAINER_OF(work,
+			struct uart_dma_stream, timeout_work);
+	struct uart_stm32_data *data = CONTAINER_OF(rx_stream,
+			struct uart_stm32_data, dma_rx);
+	unsigned int key = irq_lock();
+
+	if (data->dma_rx.enabled) {
+		uart_stm32_dma_rx_flush(data->dev);
+	}
+
+	irq_unlock(key);
+}
+
+static void uart_stm32_dma_tx_cb(const struct device *dma_dev, void *user_data,
+				 uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = status ? UART_TX_ABORTED : UART_TX_DONE,
+		.data.tx.buf = data->dma_tx.buffer,
+		.data.tx.len = data->dma_tx.buffer_length,
+	};
+	unsigned int key = irq_lock();
+
+	k_delayed_work_cancel(&data->dma_tx.timeout_work);
+	LL_USART_DisableDMAReq_TX(UartInstance);
+
+	data->dma_tx.buffer = NULL;
+	data->dma_tx.buffer_length = 0;
+
+	irq_unlock(key);
+
+	async_user_callback(data, &event);
+}
+
+static int uart_stm32_async_callback_set(const struct device *dev,
+					 uart_callback_t callback,
+					 void *user_data)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return 0;
+}
+
+static int uart_stm32_async_tx(const struct device *dev,
+			       const uint8_t *tx_data, size_t buf_size,
+			       int32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	unsigned int key;
+	int ret;
+
+	if (data->dma_tx.dma_dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+	if (data->dma_tx.buffer_length != 0) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	data->dma_tx.buffer = (uint8_t *)tx_data;
+	data->dma_tx.buffer_length = buf_size;
+	irq_unlock(key);
+
+	data->dma_tx.blk_cfg.source_address = (uint32_t)tx_data;
+	data->dma_tx.blk_cfg.source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	data->dma_tx.blk_cfg.dest_address =
+		uart_stm32_dma_tx_addr(UartInstance);
+	data->dma_tx.blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	data->dma_tx.blk_cfg.block_size = buf_size;
+	data->dma_tx.dma_cfg.head_block = &data->dma_tx.blk_cfg;
+	data->dma_tx.dma_cfg.user_data = (void *)dev;
+
+	ret = dma_config(data->dma_tx.dma_dev, data->dma_tx.dma_channel,
+			 &data->dma_tx.dma_cfg);
+	if (ret == 0) {
+		ret = dma_start(data->dma_tx.dma_dev,
+				data->dma_tx.dma_channel);
+	}
+
+	if (ret != 0) {
+		LOG_ERR("Cannot start the TX DMA (%d)", ret);
+		data->dma_tx.buffer_length = 0;
+		return ret;
+	}
+
+	LL_USART_ClearFlag_TC(UartInstance);
+	LL_USART_EnableDMAReq_TX(UartInstance);
+
+	async_timer_start(&data->dma_tx.timeout_work, timeout);
+
+	return 0;
+}
+
+static int uart_stm32_async_tx_abort(const struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_TX_ABORTED,
+	};
+	struct dma_status stat;
+	unsigned int key;
+
+	if (data->dma_tx.dma_dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+	if (data->dma_tx.buffer_length == 0) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	k_delayed_work_cancel(&data->dma_tx.timeout_work);
+	dma_stop(data->dma_tx.dma_dev, data->dma_tx.dma_channel);
+	LL_USART_DisableDMAReq_TX(UartInstance);
+
+	event.data.tx.buf = data->dma_tx.buffer;
+	event.data.tx.len = 0;
+	if (dma_get_status(data->dma_tx.dma_dev, data->dma_tx.dma_channel,
+			   &stat) == 0) {
+		event.data.tx.len = data->dma_tx.buffer_length -
+				    stat.pending_length;
+	}
+
+	data->dma_tx.buffer = NULL;
+	data->dma_tx.buffer_length = 0;
+	irq_unlock(key);
+
+	async_user_callback(data, &event);
+
+	return 0;
+}
+
+static void uart_stm32_async_tx_timeout(struct k_work *work)
+{
+	struct uart_dma_stream *tx_stream = CONTAINER_OF(work,
+			struct uart_dma_stream, timeout_work);
+	struct uart_stm32_data *data = CONTAINER_OF(tx_stream,
+			struct uart_stm32_data, dma_tx);
+
+	uart_stm32_async_tx_abort(data->dev);
+}
+
+static int uart_stm32_async_rx_enable(const struct device *dev,
+				      uint8_t *rx_buf, size_t buf_size,
+				      int32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	int ret;
+
+	if (data->dma_rx.dma_dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (data->dma_rx.enabled) {
+		return -EBUSY;
+	}
+
+	data->dma_rx.buffer = rx_buf;
+	data->dma_rx.buffer_length = buf_size;
+	data->dma_rx.offset = 0;
+	data->dma_rx.timeout = timeout;
+
+	data->dma_rx.blk_cfg.source_address =
+		uart_stm32_dma_rx_addr(UartInstance);
+	data->dma_rx.blk_cfg.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	data->dma_rx.blk_cfg.dest_address = (uint32_t)rx_buf;
+	data->dma_rx.blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	data->dma_rx.blk_cfg.block_size = buf_size;
+	data->dma_rx.dma_cfg.head_block = &data->dma_rx.blk_cfg;
+	data->dma_rx.dma_cfg.user_data = (void *)dev;
+
+	ret = dma_config(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+			 &data->dma_rx.dma_cfg);
+	if (ret == 0) {
+		ret = dma_start(data->dma_rx.dma_dev,
+				data->dma_rx.dma_channel);
+	}
+
+	if (ret != 0) {
+		LOG_ERR("Cannot start the RX DMA (%d)", ret);
+		return ret;
+	}
+
+	data->dma_rx.enabled = true;
+
+	/* Drop what was received before, the DMA reads from now on */
+	if (LL_USART_IsActiveFlag_ORE(UartInstance)) {
+		LL_USART_ClearFlag_ORE(UartInstance);
+	}
+
+	LL_USART_EnableDMAReq_RX(UartInstance);
+	LL_USART_ClearFlag_IDLE(UartInstance);
+	LL_USART_EnableIT_IDLE(UartInstance);
+
+	async_user_callback(data, &event);
+
+	return 0;
+}
+
+static int uart_stm32_async_rx_buf_rsp(const struct device *dev, uint8_t *buf,
+				       size_t len)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key = irq_lock();
+	int ret = 0;
+
+	if (!data->dma_rx.enabled) {
+		ret = -EACCES;
+	} else if (data->rx_next_buffer) {
+		ret = -EBUSY;
+	} else {
+		data->rx_next_buffer = buf;
+		data->rx_next_buffer_len = len;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int uart_stm32_async_rx_disable(const struct device *dev)
+{
+	unsigned int key = irq_lock();
+	int ret;
+
+	ret = uart_stm32_dma_rx_stop(dev);
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int uart_stm32_async_init(const struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	data->dev = dev;
+
+	if (data->dma_rx.dma_name != NULL) {
+		data->dma_rx.dma_dev = device_get_binding(data->dma_rx.dma_name);
+		if (data->dma_rx.dma_dev == NULL) {
+			LOG_ERR("%s device not found", data->dma_rx.dma_name);
+			return -ENODEV;
+		}
+	}
+
+	if (data->dma_tx.dma_name != NULL) {
+		data->dma_tx.dma_dev = device_get_binding(data->dma_tx.dma_name);
+		if (data->dma_tx.dma_dev == NULL) {
+			LOG_ERR("%s device not found", data->dma_tx.dma_name);
+			return -ENODEV;
+		}
+	}
+
+	k_delayed_work_init(&data->dma_rx.timeout_work,
+			    uart_stm32_async_rx_timeout);
+	k_delayed_work_init(&data->dma_tx.timeout_work,
+			    uart_stm32_async_tx_timeout);
+
+	return 0;
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 static void uart_stm32_isr(const struct device *dev)
 {
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	struct uart_stm32_data *data = DEV_DATA(dev);
+#endif
+#ifdef CONFIG_UART_ASYNC_API
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+
+	if (LL_USART_IsEnabledIT_IDLE(UartInstance) &&
+	    LL_USART_IsActiveFlag_IDLE(UartInstance)) {
+		LL_USART_ClearFlag_IDLE(UartInstance);
+		uart_stm32_dma_rx_idle(dev);
+	}
+#endif
 
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	if (data->user_cb) {
 		data->user_cb(dev, data->user_data);
 	}
+#endif
 }
-
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif
 
 static const struct uart_driver_api uart_stm32_driver_api = {
 	.poll_in = uart_stm32_poll_in,
@@ -651,6 +1130,14 @@ static const struct uart_driver_api uart_stm32_driver_api = {
 	.irq_update = uart_stm32_irq_update,
 	.irq_callback_set = uart_stm32_irq_callback_set,
 #endif	/* CONFIG_UART_INTERRUPT_DRIVEN */
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_stm32_async_callback_set,
+	.tx = uart_stm32_async_tx,
+	.tx_abort = uart_stm32_async_tx_abort,
+	.rx_enable = uart_stm32_async_rx_enable,
+	.rx_disable = uart_stm32_async_rx_disable,
+	.rx_buf_rsp = uart_stm32_async_rx_buf_rsp,
+#endif	/* CONFIG_UART_ASYNC_API */
 };
 
 /**
@@ -741,14 +1228,19 @@ static int uart_stm32_init(const struct device *dev)
 	}
 #endif /* !USART_ISR_REACK */
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	config->uconf.irq_config_func(dev);
 #endif
+
+#ifdef CONFIG_UART_ASYNC_API
+	return uart_stm32_async_init(dev);
+#else
 	return 0;
+#endif
 }
 
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 #define STM32_UART_IRQ_HANDLER_DECL(index)				\
 	static void uart_stm32_irq_config_func_##index(const struct device *dev)
 #define STM32_UART_IRQ_HANDLER_FUNC(index)				\
@@ -768,6 +1260,39 @@ static void uart_stm32_irq_config_func_##index(const struct device *dev)	\
 #define STM32_UART_IRQ_HANDLER(index)
 #endif
 
+#ifdef CONFIG_UART_ASYNC_API
+#define UART_DMA_CHANNEL_CONFIG(index, dir)				\
+	DT_INST_DMAS_CELL_BY_NAME(index, dir, channel_config)
+
+#define UART_DMA_CHANNEL_INIT(index, dir, src_dev, dest_dev)		\
+	.dma_name = DT_INST_DMAS_LABEL_BY_NAME(index, dir),		\
+	.dma_channel = DT_INST_DMAS_CELL_BY_NAME(index, dir, channel),	\
+	.dma_cfg = {							\
+		.dma_slot = DT_INST_DMAS_CELL_BY_NAME(index, dir, slot),\
+		.channel_direction = STM32_DMA_CONFIG_DIRECTION(	\
+				UART_DMA_CHANNEL_CONFIG(index, dir)),	\
+		.channel_priority = STM32_DMA_CONFIG_PRIORITY(		\
+				UART_DMA_CHANNEL_CONFIG(index, dir)),	\
+		.source_data_size = STM32_DMA_CONFIG_##src_dev##_DATA_SIZE(\
+				UART_DMA_CHANNEL_CONFIG(index, dir)),	\
+		.dest_data_size = STM32_DMA_CONFIG_##dest_dev##_DATA_SIZE(\
+				UART_DMA_CHANNEL_CONFIG(index, dir)),	\
+		.source_burst_length = 1, /* SINGLE transfer */		\
+		.dest_burst_length = 1, /* SINGLE transfer */		\
+		.block_count = 1,					\
+		.dma_callback = uart_stm32_dma_##dir##_cb,		\
+	},
+
+#define UART_DMA_CHANNEL(index, dir, src, dest)				\
+	.dma_##dir = {							\
+		COND_CODE_1(DT_INST_DMAS_HAS_NAME(index, dir),		\
+			    (UART_DMA_CHANNEL_INIT(index, dir, src, dest)),\
+			    (NULL))					\
+	},
+#else
+#define UART_DMA_CHANNEL(index, dir, src, dest)
+#endif
+
 #define STM32_UART_INIT(index)						\
 STM32_UART_IRQ_HANDLER_DECL(index);					\
 									\
@@ -790,6 +1315,8 @@ static const struct uart_stm32_config uart_stm32_cfg_##index = {	\
 									\
 static struct uart_stm32_data uart_stm32_data_##index = {		\
 	.baud_rate = DT_INST_PROP(index, current_speed),		\
+	UART_DMA_CHANNEL(index, rx, PERIPHERAL, MEMORY)			\
+	UART_DMA_CHANNEL(index, tx, MEMORY, PERIPHERAL)			\
 };									\
 									\
 DEVICE_AND_API_INIT(uart_stm32_##index, DT_INST_LABEL(index),		\
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <drivers/spi_queue.h>
+
+#define LOG_LEVEL CONFIG_SPI_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(spi_queue);
+
+static struct spi_transaction *queue_next(struct spi_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	sys_snode_t *node;
+
+	node = sys_slist_get(&queue->pending);
+	if (node) {
+		queue->current = CONTAINER_OF(node, struct spi_transaction,
+					      node);
+	} else {
+		queue->current = NULL;
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	return queue->current;
+}
+
+static void queue_complete(struct spi_transaction *txn, int result)
+{
+	if (txn->cb) {
+		txn->cb(txn, result);
+	}
+}
+
+/* Start txn, the current transaction of the queue. Transactions that can't
+ * be started are completed with the error right away.
+ */
+static void queue_start(struct spi_queue *queue, struct spi_transaction *txn)
+{
+	int err;
+
+	while (txn) {
+		k_poll_signal_reset(&queue->signal);
+		k_poll_event_init(&queue->event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &queue->signal);
+
+		err = k_work_poll_submit(&queue->work, &queue->event, 1,
+					 K_FOREVER);
+		if (!err) {
+			err = spi_transceive_async(queue->dev, txn->config,
+						   txn->tx_bufs, txn->rx_bufs,
+						   &queue->signal);
+			if (!err) {
+				return;
+			}
+
+			k_work_poll_cancel(&queue->work);
+		}
+
+		LOG_ERR("Cannot start transaction %p (%d)", txn, err);
+
+		/* Move on before calling back, so that the callback can
+		 * submit again.
+		 */
+		struct spi_transaction *failed = txn;
+
+		txn = queue_next(queue);
+		queue_complete(failed, err);
+	}
+}
+
+static void queue_work(struct k_work *work)
+{
+	struct k_work_poll *poll = CONTAINER_OF(work, struct k_work_poll,
+						work);
+	struct spi_queue *queue = CONTAINER_OF(poll, struct spi_queue, work);
+	struct spi_transaction *txn = queue->current;
+	unsigned int signaled;
+	int result;
+
+	k_poll_signal_check(&queue->signal, &signaled, &result);
+
+	/* Keep the bus busy while the previous transaction is handled */
+	queue_start(queue, queue_next(queue));
+	queue_complete(txn, result);
+}
+
+void spi_queue_init(struct spi_queue *queue, const struct device *dev)
+{
+	queue->dev = dev;
+	queue->current = NULL;
+	sys_slist_init(&queue->pending);
+	k_poll_signal_init(&queue->signal);
+	k_work_poll_init(&queue->work, queue_work);
+}
+
+int spi_queue_submit(struct spi_queue *queue, struct spi_transaction *txn)
+{
+	k_spinlock_key_t key;
+	bool idle;
+
+	if (!txn->config) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&queue->lock);
+
+	idle = (queue->current == NULL);
+	if (idle) {
+		queue->current = txn;
+	} else {
+		sys_slist_append(&queue->pending, &txn->node);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	if (idle) {
+		queue_start(queue, txn);
+	}
+
+	return 0;
+}
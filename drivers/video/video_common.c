@@ -6,6 +6,11 @@
 #include <zephyr.h>
 
 #include <drivers/video.h>
+#include <sys/atomic.h>
+
+#ifdef CONFIG_DISPLAY
+#include <drivers/display.h>
+#endif
 
 K_MEM_POOL_DEFINE(video_buffer_pool,
 		  CONFIG_VIDEO_BUFFER_POOL_ALIGN,
@@ -15,6 +20,7 @@ K_MEM_POOL_DEFINE(video_buffer_pool,
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 static struct k_mem_block video_block[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
+static atomic_t video_ref[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
 struct video_buffer *video_buffer_alloc(size_t size)
 {
@@ -43,6 +49,14 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	vbuf->buffer = block->data;
 	vbuf->size = size;
 	vbuf->bytesused = 0;
+	atomic_set(&video_ref[i], 1);
+
+	return vbuf;
+}
+
+struct video_buffer *video_buffer_ref(struct video_buffer *vbuf)
+{
+	atomic_inc(&video_ref[vbuf - video_buf]);
 
 	return vbuf;
 }
@@ -52,6 +66,10 @@ void video_buffer_release(struct video_buffer *vbuf)
 	struct k_mem_block *block = NULL;
 	int i;
 
+	if (atomic_dec(&video_ref[vbuf - video_buf]) > 1) {
+		return;
+	}
+
 	/* vbuf to block */
 	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
 		if (video_block[i].data == vbuf->buffer) {
@@ -63,3 +81,71 @@ void video_buffer_release(struct video_buffer *vbuf)
 	vbuf->buffer = NULL;
 	k_mem_pool_free(block);
 }
+
+#ifdef CONFIG_DISPLAY
+int video_buffer_display_desc(const struct video_buffer *vbuf,
+			      const struct video_format *fmt,
+			      struct display_buffer_descriptor *desc)
+{
+	uint32_t bpp;
+
+	if (fmt->width == 0U || fmt->width > UINT16_MAX ||
+	    fmt->height > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	/* The display pitch is in pixels, the video one in bytes */
+	bpp = fmt->pitch / fmt->width;
+	if (bpp == 0U || fmt->pitch % bpp || fmt->pitch / bpp > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	desc->buf_size = vbuf->bytesused;
+	desc->width = fmt->width;
+	desc->height = fmt->height;
+	desc->pitch = fmt->pitch / bpp;
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_VIDEO_BUFFER_NET_BUF
+void video_buffer_net_buf_destroy(struct net_buf *buf)
+{
+	struct video_buffer *vbuf = *(struct video_buffer **)buf->user_data;
+
+	net_buf_destroy(buf);
+	video_buffer_release(vbuf);
+}
+
+struct net_buf *video_buffer_net_buf(struct net_buf_pool *pool,
+				     struct video_buffer *vbuf,
+				     k_timeout_t timeout)
+{
+	struct net_buf *head = NULL;
+	struct net_buf *frag;
+	uint32_t offset = 0U;
+	size_t len;
+
+	while (offset < vbuf->bytesused) {
+		/* The length of a network buffer is 16 bit */
+		len = MIN(vbuf->bytesused - offset, UINT16_MAX);
+
+		frag = net_buf_alloc_with_data(pool, vbuf->buffer + offset,
+					       len, timeout);
+		if (frag == NULL) {
+			if (head != NULL) {
+				net_buf_unref(head);
+			}
+			return NULL;
+		}
+
+		*(struct video_buffer **)frag->user_data =
+			video_buffer_ref(vbuf);
+		head = head ? net_buf_frag_add(head, frag) : frag;
+		offset += len;
+	}
+
+	return head;
+}
+#endif
@@ -21,12 +21,17 @@ LOG_MODULE_DECLARE(LOG_MODULE_NAME);
 #define ESWIFI_SPI_THREAD_STACK_SIZE 1024
 K_KERNEL_STACK_MEMBER(eswifi_spi_poll_stack, ESWIFI_SPI_THREAD_STACK_SIZE);
 
-#define SPI_READ_CHUNK_SIZE 32
+#define SPI_READ_CHUNK_SIZE CONFIG_WIFI_ESWIFI_SPI_READ_CHUNK_SIZE
+
+/* The module finishes a phase in a minute at worst */
+#define CMDDATA_READY_TIMEOUT K_SECONDS(60)
 
 struct eswifi_spi_data {
 	const struct device *spi_dev;
 	struct eswifi_gpio csn;
 	struct eswifi_gpio dr;
+	struct gpio_callback dr_cb;
+	struct k_sem dr_sem;
 	struct k_thread poll_thread;
 	struct spi_config spi_cfg;
 	struct spi_cs_control spi_cs;
@@ -39,16 +44,29 @@ static bool eswifi_spi_cmddata_ready(struct eswifi_spi_data *spi)
 	return gpio_pin_get(spi->dr.dev, spi->dr.pin) > 0;
 }
 
-static int eswifi_spi_wait_cmddata_ready(struct eswifi_spi_data *spi)
+static void eswifi_spi_dr_handler(const struct device *port,
+				  struct gpio_callback *cb,
+				  gpio_port_pins_t pins)
 {
-	unsigned int max_retries = 60 * 1000; /* 1 minute */
+	struct eswifi_spi_data *spi = CONTAINER_OF(cb, struct eswifi_spi_data,
+						   dr_cb);
 
-	do {
-		/* allow other threads to be scheduled */
-		k_sleep(K_MSEC(1));
-	} while (!eswifi_spi_cmddata_ready(spi) && --max_retries);
+	k_sem_give(&spi->dr_sem);
+}
 
-	return max_retries ? 0 : -ETIMEDOUT;
+static int eswifi_spi_wait_cmddata_ready(struct eswifi_spi_data *spi)
+{
+	/*
+	 * The level is checked again after each edge, an edge left over
+	 * from a previous phase only costs one more iteration.
+	 */
+	while (!eswifi_spi_cmddata_ready(spi)) {
+		if (k_sem_take(&spi->dr_sem, CMDDATA_READY_TIMEOUT)) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	return 0;
 }
 
 static int eswifi_spi_write(struct eswifi_dev *eswifi, char *data, size_t dlen)
@@ -160,7 +178,6 @@ data:
 		memset(rsp + offset, 0, to_read);
 		eswifi_spi_read(eswifi, rsp + offset, to_read);
 		offset += to_read;
-		k_yield();
 	}
 
 	/* Flush remaining data if receiving buffer not large enough */
@@ -246,6 +263,17 @@ int eswifi_spi_init(struct eswifi_dev *eswifi)
 			   DT_INST_GPIO_FLAGS(0, data_gpios) |
 			   GPIO_INPUT);
 
+	/* Waiting for the module is driven by the data ready edges */
+	k_sem_init(&spi->dr_sem, 0, 1);
+	gpio_init_callback(&spi->dr_cb, eswifi_spi_dr_handler,
+			   BIT(spi->dr.pin));
+	if (gpio_add_callback(spi->dr.dev, &spi->dr_cb) ||
+	    gpio_pin_interrupt_configure(spi->dr.dev, spi->dr.pin,
+					 GPIO_INT_EDGE_TO_ACTIVE)) {
+		LOG_ERR("Failed to configure data ready interrupt");
+		return -EIO;
+	}
+
 	/* SPI CONFIG/CS */
 	spi->spi_cfg.frequency = DT_INST_PROP(0, spi_max_frequency);
 	spi->spi_cfg.operation = (SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB |
@@ -48,6 +48,7 @@ struct eswifi_off_socket {
 	struct k_sem accept_sem;
 	uint16_t port;
 	bool is_server;
+	bool read_configured;
 	int usage;
 	struct k_fifo fifo;
 	struct net_pkt *prev_pkt_rem;
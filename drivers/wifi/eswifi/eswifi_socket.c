@@ -33,13 +33,20 @@ static int __stop_socket(struct eswifi_dev *eswifi,
 	return eswifi_at_cmd(eswifi, socket->is_server ? cmd_srv : cmd_cli);
 }
 
-static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
+static int __read_data(struct eswifi_dev *eswifi,
+		       struct eswifi_off_socket *socket, size_t len,
+		       char **data)
 {
 	char cmd[] = "R0\r";
 	char size[] = "R1=9999\r";
 	char timeout[] = "R2=30000\r";
 	int ret;
 
+	/* The module keeps the read settings of each socket */
+	if (socket->read_configured) {
+		return eswifi_at_cmd_rsp(eswifi, cmd, data);
+	}
+
 	/* Set max read size */
 	snprintk(size, sizeof(size), "R1=%u\r", len);
 	ret = eswifi_at_cmd(eswifi, size);
@@ -56,6 +63,8 @@ static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
 		return -EIO;
 	}
 
+	socket->read_configured = true;
+
 	return eswifi_at_cmd_rsp(eswifi, cmd, data);
 }
 
@@ -107,7 +116,7 @@ static void eswifi_off_read_work(struct k_work *work)
 
 	__select_socket(eswifi, socket->index);
 
-	len = __read_data(eswifi, 1460, &data); /* 1460 is max size */
+	len = __read_data(eswifi, socket, 1460, &data); /* 1460 is max size */
 	if (len < 0) {
 		__stop_socket(eswifi, socket);
 
@@ -299,6 +308,7 @@ int __eswifi_socket_new(struct eswifi_dev *eswifi, int family, int type,
 	}
 
 	k_delayed_work_init(&socket->read_work, eswifi_off_read_work);
+	socket->read_configured = false;
 	socket->usage = 1;
 	LOG_DBG("Socket index %d", socket->index);
 
@@ -183,6 +183,30 @@ extern void k_mem_domain_add_partition(struct k_mem_domain *domain,
 extern void k_mem_domain_remove_partition(struct k_mem_domain *domain,
 					 struct k_mem_partition *part);
 
+/**
+ * @brief Remove and add several memory partitions of a memory domain.
+ *
+ * Remove then add memory partitions as k_mem_domain_remove_partition() and
+ * k_mem_domain_add_partition() do, as a single update. The threads of the
+ * domain never see only part of the changes, and the architecture may
+ * apply them all at once, for instance with a single TLB shootdown, where
+ * every partition change would otherwise be applied on its own.
+ *
+ * The constraints of k_mem_domain_add_partition() apply to the partitions
+ * added, which may overlap the partitions removed.
+ *
+ * @param domain The memory domain to be updated.
+ * @param remove Array of the memory partitions to be removed.
+ * @param num_remove Number of memory partitions to be removed.
+ * @param add Array of the memory partitions to be added.
+ * @param num_add Number of memory partitions to be added.
+ */
+extern void k_mem_domain_update(struct k_mem_domain *domain,
+				struct k_mem_partition *remove[],
+				uint8_t num_remove,
+				struct k_mem_partition *add[],
+				uint8_t num_add);
+
 /**
  * @brief Add a thread into a memory domain.
  *
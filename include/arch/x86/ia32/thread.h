@@ -47,6 +47,9 @@
 #define X86_THREAD_FLAG_EXC 0x02
 #define X86_THREAD_FLAG_ALL (X86_THREAD_FLAG_INT | X86_THREAD_FLAG_EXC)
 
+/* The saved floating point context is to be restored (LAZY_FPU_SWITCH) */
+#define X86_THREAD_FLAG_FP_SAVED 0x04
+
 #ifndef _ASMLANGUAGE
 #include <stdint.h>
 #include <arch/x86/mmustructs.h>
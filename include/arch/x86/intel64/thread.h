@@ -118,6 +118,13 @@ struct _thread_arch {
 #ifndef CONFIG_X86_COMMON_PAGE_TABLE
 	/* Physical address of the page tables used by this thread */
 	uintptr_t ptables;
+
+#ifdef CONFIG_X86_PCID
+	/* CR3 value switching to these page tables: their address, their
+	 * PCID, and the bit keeping the TLB entries of that PCID
+	 */
+	uint64_t cr3;
+#endif /* CONFIG_X86_PCID */
 #endif /* CONFIG_X86_COMMON_PAGE_TABLE */
 
 	/* Initial privilege mode stack pointer when doing a system call.
@@ -66,6 +66,11 @@ struct arch_mem_domain {
 	/* Pointer to top-level structure, either a PML4, PDPT, PD */
 	pentry_t *ptables;
 
+#ifdef CONFIG_X86_PCID
+	/* PCID tagging the TLB entries of these page tables */
+	uint16_t pcid;
+#endif
+
 	/* Linked list of all active memory domains */
 	sys_snode_t node;
 #ifdef CONFIG_X86_PAE
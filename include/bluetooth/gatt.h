@@ -919,6 +919,12 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 		      struct bt_gatt_notify_params *params);
 
 /** @brief Notify multiple attribute value change.
+ *
+ *  Send the notifications as a batch. If the peer supports the Multiple
+ *  Handle Value Notification procedure, the values are packed up to the
+ *  ATT MTU into as few PDUs as possible, which are queued for sending before
+ *  the function returns. Otherwise one notification is queued per value,
+ *  back to back.
  *
  *  @param conn Connection object.
  *  @param num_params Number of notification parameters.
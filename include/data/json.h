@@ -592,6 +592,110 @@ int json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/**
+ * @brief Token reported by the streaming parser
+ */
+struct json_sax_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_LIST_START,
+	 * JSON_TOK_LIST_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE or JSON_TOK_NULL
+	 */
+	enum json_tokens type;
+	/** True for a string that is the key of an object member */
+	bool key;
+	/** Nesting level of the token, 0 for the top-level value */
+	uint8_t depth;
+	/** Text of strings, without the quotes and not unescaped, and of
+	 * numbers. Only valid during the callback.
+	 */
+	const char *str;
+	/** Length of the text */
+	size_t len;
+};
+
+/**
+ * @brief Function pointer type to receive tokens from the streaming parser
+ *
+ * @param token Token parsed.
+ * @param user_data User-provided pointer.
+ *
+ * @return 0 to continue parsing, a negative number to abort it (which will
+ * be propagated to the return value of json_sax_feed()).
+ */
+typedef int (*json_sax_cb_t)(const struct json_sax_token *token,
+			     void *user_data);
+
+/**
+ * @brief Streaming JSON parser
+ *
+ * The fields are internal.
+ */
+struct json_sax {
+	json_sax_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t len;
+	/* Bit per nesting level, set for objects */
+	uint32_t objects;
+	uint8_t depth;
+	uint8_t expect;
+	uint8_t lex;
+	uint8_t escape;
+	bool buffered;
+};
+
+/**
+ * @brief Initialize a streaming JSON parser
+ *
+ * The streaming parser reports the tokens of a JSON value as they are
+ * parsed, from chunks of input of any size, so the whole payload never
+ * needs to be held in memory, nor to be writable.
+ *
+ * @param sax Parser to initialize.
+ *
+ * @param buf Buffer for the tokens spanning two chunks, strings and numbers
+ * that are longer than it cannot be parsed unless they lie within a chunk.
+ *
+ * @param buf_size Size of the buffer.
+ *
+ * @param cb Function called for every token.
+ *
+ * @param user_data User-provided pointer passed to the callback.
+ */
+void json_sax_init(struct json_sax *sax, char *buf, size_t buf_size,
+		   json_sax_cb_t cb, void *user_data);
+
+/**
+ * @brief Parse the next chunk of a JSON value
+ *
+ * Nesting is limited to 32 levels.
+ *
+ * @param sax Parser.
+ *
+ * @param data Next chunk of the JSON-encoded value.
+ *
+ * @param len Length of the chunk.
+ *
+ * @return 0 on success, -EINVAL if the input is not valid JSON, -ENOSPC if
+ * a token does not fit the buffer or the nesting is too deep, or the
+ * negative value returned by the callback. The parser stays in error
+ * afterwards.
+ */
+int json_sax_feed(struct json_sax *sax, const char *data, size_t len);
+
+/**
+ * @brief End parsing a JSON value
+ *
+ * Reports a number still pending at the end of the input, and checks that
+ * the value is complete.
+ *
+ * @param sax Parser.
+ *
+ * @return 0 on success, or a negative value as for json_sax_feed().
+ */
+int json_sax_finish(struct json_sax *sax);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -93,6 +93,80 @@ static inline size_t jwt_payload_len(struct jwt_builder *builder)
 	return (builder->buf - builder->base);
 }
 
+/**
+ * @brief Cached JWT token.
+ *
+ * Signing a token is slow, RSA in particular. This structure keeps a
+ * signed token around, to be reused until it is about to expire. It
+ * should be initialized with jwt_cache_init().
+ */
+struct jwt_cache {
+	/** The buffer holding the token. */
+	char *buf;
+
+	/** The size of this buffer. */
+	size_t size;
+
+	/** Length of the cached token, 0 if there is none. */
+	size_t len;
+
+	/** Expiration time of the cached token. */
+	int32_t exp;
+};
+
+/**
+ * @brief Initialize a JWT token cache.
+ *
+ * @param cache The cache to initialize.
+ * @param buffer The buffer to keep the token in.
+ * @param buffer_size The size of this buffer, including the NULL
+ * terminator of the token.
+ */
+void jwt_cache_init(struct jwt_cache *cache,
+		    char *buffer,
+		    size_t buffer_size);
+
+/**
+ * @brief Get a signed JWT token from the cache.
+ *
+ * The cached token is returned as long as it is valid for more than
+ * CONFIG_JWT_CACHE_MARGIN seconds. Otherwise a fresh token is built and
+ * signed, valid from @a now for @a lifetime seconds.
+ *
+ * The audience and key are expected to stay the same from one call to
+ * the next, jwt_cache_invalidate() must be called when they change.
+ *
+ * @param cache The cache to get the token from.
+ * @param now The current time, in seconds since the epoch.
+ * @param lifetime Validity of a fresh token, in seconds.
+ * @param aud The audience of the token.
+ * @param der_key The key to sign a fresh token with.
+ * @param der_key_len The length of this key.
+ *
+ * @retval 0 Success, the token is in the buffer of the cache and its
+ * length in @a len.
+ * @retval -ENOMEM Buffer is too small for the token
+ * @retval other Error signing the token
+ */
+int jwt_cache_get(struct jwt_cache *cache,
+		  int32_t now,
+		  int32_t lifetime,
+		  const char *aud,
+		  const char *der_key,
+		  size_t der_key_len);
+
+/**
+ * @brief Drop the token of a JWT token cache.
+ *
+ * The next call to jwt_cache_get() signs a fresh token.
+ *
+ * @param cache The cache to drop the token of.
+ */
+static inline void jwt_cache_invalidate(struct jwt_cache *cache)
+{
+	cache->len = 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -192,6 +192,20 @@ struct device_pm {
 	struct k_poll_event event;
 	/** Signal to notify the Async API callers */
 	struct k_poll_signal signal;
+#ifdef CONFIG_DEVICE_IDLE_PM
+	/** Parent device, resumed before the device and suspended after */
+	const struct device *parent;
+	/** Children devices, resumed once the device is active */
+	sys_slist_t children;
+	/** Node in the children list of the parent */
+	sys_snode_t sibling;
+	/** Whether the device holds a usage count of its parent */
+	bool parent_used;
+	/** Delay before suspending the unused device, in milliseconds */
+	uint32_t autosuspend_ms;
+	/** Work object for the autosuspend delay */
+	struct k_delayed_work autosuspend_work;
+#endif
 };
 
 /**
@@ -558,6 +572,39 @@ int device_pm_put(const struct device *dev);
  * @retval Errno Negative errno code if failure.
  */
 int device_pm_put_sync(const struct device *dev);
+
+/**
+ * @brief Set the parent of a device
+ *
+ * Called by a device driver, before enabling device idle PM, to declare
+ * the device it depends on, e.g. the bus it sits on. The parent is used
+ * and resumed before the device is resumed, and released once the device
+ * is suspended, so a whole chain of devices is brought up by using the
+ * last one. The children of a device are resumed together once it is
+ * active.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param parent Pointer to device structure of the parent device.
+ */
+void device_pm_parent_set(const struct device *dev,
+			  const struct device *parent);
+
+/**
+ * @brief Set the autosuspend delay of a device
+ *
+ * Once released by device_pm_put(), the device is only suspended if it
+ * was not used again during this delay. This avoids suspending and
+ * resuming a device between uses which follow each other closely.
+ * device_pm_put_sync() still suspends the device immediately.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param delay_ms Autosuspend delay in milliseconds, 0 to suspend the
+ * device as soon as it is released.
+ */
+void device_pm_autosuspend_delay_set(const struct device *dev,
+				     uint32_t delay_ms);
 #else
 static inline void device_pm_enable(const struct device *dev) { }
 static inline void device_pm_disable(const struct device *dev) { }
@@ -565,6 +612,10 @@ static inline int device_pm_get(const struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_get_sync(const struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put(const struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put_sync(const struct device *dev) { return -ENOTSUP; }
+static inline void device_pm_parent_set(const struct device *dev,
+					const struct device *parent) { }
+static inline void device_pm_autosuspend_delay_set(const struct device *dev,
+						   uint32_t delay_ms) { }
 #endif
 #else
 #define device_pm_control_nop(...) NULL
@@ -9,17 +9,75 @@
 #define ZEPHYR_INCLUDE_DFU_FLASH_IMG_H_
 
 #include <storage/stream_flash.h>
+#ifdef CONFIG_IMG_STREAM_HASH
+#include <tinycrypt/sha256.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_STREAM_HASH
+/**
+ * @brief SHA-256 state of the first bytes of an image
+ *
+ * The structure holds no pointer, it can be stored as is to resume an
+ * interrupted download with flash_img_init_resume().
+ */
+struct flash_img_hash_ckpt {
+	struct tc_sha256_state_struct sha; /** Hash state */
+	size_t len; /** Number of image bytes hashed */
+};
+#endif
+
 struct flash_img_context {
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	/* One half is written while the other one is filled */
+	uint8_t buf[2 * CONFIG_IMG_BLOCK_BUF_SIZE];
+#else
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#ifdef CONFIG_IMG_STREAM_HASH
+	struct flash_img_hash_ckpt hash; /* Hash of the bytes accepted */
+	size_t start; /* Image offset where the stream starts */
+	uint8_t area_id; /* Flash area the hash belongs to */
+	bool hash_valid; /* Cleared when a write fails */
+#endif
 };
 
+#ifdef CONFIG_IMG_DELTA
+/** Magic word starting a delta patch, "ZDLT" in little endian */
+#define FLASH_IMG_DELTA_MAGIC 0x544c445aU
+
+/**
+ * @brief Delta patch applier context
+ *
+ * A patch starts with a header of three little endian 32-bit words: the
+ * magic, the size of the source image and the size of the target image.
+ * It is followed by records made of three little endian 32-bit words, the
+ * diff length, the extra length and the signed source seek, followed by
+ * the diff bytes, added to the source bytes, and the extra bytes, copied
+ * as is. The source offset advances by the diff length and the seek.
+ */
+struct flash_img_delta_ctx {
+	struct flash_img_context *img; /* Target image writer */
+	const struct flash_area *src; /* Area holding the source image */
+	uint8_t hdr[12]; /* Header or record being received */
+	uint8_t hdr_len;
+	uint8_t state;
+	uint32_t src_size;
+	uint32_t dst_size;
+	uint32_t diff_left;
+	uint32_t extra_left;
+	size_t src_next; /* Source offset after the record */
+	size_t src_off;
+	size_t dst_off;
+	uint8_t buf[CONFIG_IMG_DELTA_BUF_SIZE]; /* Source bytes being patched */
+};
+#endif
+
 #if defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
 /**
  * @brief Structure for verify flash region integrity
@@ -81,6 +139,93 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+#ifdef CONFIG_IMG_STREAM_HASH
+/**
+ * @brief Save the hash of the image bytes accepted so far.
+ *
+ * The checkpoint can be stored with the download progress, so that an
+ * interrupted download resumed with flash_img_init_resume() does not hash
+ * the whole written image again.
+ *
+ * @param ctx  context
+ * @param ckpt checkpoint to fill
+ *
+ * @return  0 on success, -EINVAL if a write failed and the hash does not
+ *          match the flash contents.
+ */
+int flash_img_hash_checkpoint(struct flash_img_context *ctx,
+			      struct flash_img_hash_ckpt *ckpt);
+
+/**
+ * @brief Initialize context to go on writing an interrupted download.
+ *
+ * The writing starts at @p offset in the image, which has to be at most the
+ * number of bytes reported by flash_img_bytes_written() before the
+ * interruption, and a multiple of the flash page size when
+ * CONFIG_IMG_ERASE_PROGRESSIVELY is enabled. The image bytes written before
+ * @p offset but not covered by @p ckpt are hashed from flash.
+ *
+ * @param ctx     context to be initialized
+ * @param area_id flash area id of partition where the image is written
+ * @param ckpt    checkpoint saved before the interruption
+ * @param offset  image offset of the next byte to write
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_init_resume(struct flash_img_context *ctx, uint8_t area_id,
+			  const struct flash_img_hash_ckpt *ckpt,
+			  size_t offset);
+#endif /* CONFIG_IMG_STREAM_HASH */
+
+#ifdef CONFIG_IMG_DELTA
+/**
+ * @brief Initialize context needed to apply a delta patch.
+ *
+ * The image built from the source image and the patch is written through
+ * @p img, which has to be initialized with flash_img_init() or
+ * flash_img_init_id(). The source area must not be the one written.
+ *
+ * @param dctx        context to be initialized
+ * @param img         image writer context
+ * @param src_area_id flash area id of partition holding the source image
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init_id(struct flash_img_delta_ctx *dctx,
+			    struct flash_img_context *img,
+			    uint8_t src_area_id);
+
+/**
+ * @brief Initialize context needed to apply a delta patch to the running
+ * image.
+ *
+ * @param dctx context to be initialized
+ * @param img  image writer context
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init(struct flash_img_delta_ctx *dctx,
+			 struct flash_img_context *img);
+
+/**
+ * @brief Apply the next bytes of a delta patch.
+ *
+ * The patch can be split in any way. A final call with @p flush set to true
+ * writes out the end of the target image, like flash_img_buffered_write().
+ *
+ * @param dctx  context
+ * @param data  patch data
+ * @param len   Number of bytes of patch data
+ * @param flush when true the patch is complete
+ *
+ * @return  0 on success, -EINVAL if the patch is malformed, does not match
+ *          the source image or is incomplete on flush, -EFBIG if the target
+ *          image does not fit, other negative errno code on flash fail
+ */
+int flash_img_delta_write(struct flash_img_delta_ctx *dctx,
+			  const uint8_t *data, size_t len, bool flush);
+#endif /* CONFIG_IMG_DELTA */
+
 #if defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
 /**
  * @brief  Verify flash memory length bytes integrity from a flash area. The
@@ -91,6 +236,10 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
  * @param[in] area_id flash area id of partition where the image should be
  * verified.
  *
+ * With CONFIG_IMG_STREAM_HASH, the hash of the bytes written through @p ctx
+ * is used when it covers the image length, instead of reading the image
+ * back from flash.
+ *
  * @return  0 on success, negative errno code on fail
  */
 int flash_img_check(struct flash_img_context *ctx,
@@ -59,6 +59,11 @@ struct disk_info {
 	/* Disk device associated to this disk.
 	 */
 	const struct device *dev;
+#ifdef CONFIG_DISK_CACHE
+	/* Number of sectors of the disk, 0 if its sectors are not cached.
+	 */
+	uint32_t cache_sector_count;
+#endif
 };
 
 struct disk_operations {
@@ -347,6 +347,38 @@ typedef int (*adc_api_read_async)(const struct device *dev,
 				  struct k_poll_signal *async);
 #endif
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Type definition of the callback called when a half of a stream
+ *        buffer is filled.
+ *
+ * It is called from the ADC interrupt, the half must be processed or
+ * copied before the other half is filled in turn.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param buffer    Pointer to the filled half of the stream buffer.
+ * @param size      Size of the filled half, in bytes.
+ * @param user_data User data provided to adc_stream_start().
+ */
+typedef void (*adc_stream_callback)(const struct device *dev, void *buffer,
+				    size_t size, void *user_data);
+
+/**
+ * @brief Type definition of ADC API function for starting a stream.
+ * See adc_stream_start() for argument descriptions.
+ */
+typedef int (*adc_api_stream_start)(const struct device *dev,
+				    const struct adc_sequence *sequence,
+				    adc_stream_callback callback,
+				    void *user_data);
+
+/**
+ * @brief Type definition of ADC API function for stopping a stream.
+ * See adc_stream_stop() for argument descriptions.
+ */
+typedef int (*adc_api_stream_stop)(const struct device *dev);
+#endif
+
 /**
  * @brief ADC driver API
  *
@@ -357,6 +389,10 @@ __subsystem struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_stream_start  stream_start;
+	adc_api_stream_stop   stream_stop;
 #endif
 	uint16_t ref_internal;	/* mV */
 };
@@ -451,6 +487,72 @@ static inline int z_impl_adc_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Start a continuous acquisition.
+ *
+ * The selected channels are sampled by a hardware timer every
+ * @p sequence->options->interval_us and the results are written by DMA
+ * in the two halves of @p sequence->buffer in turn. @p callback is called
+ * each time a half is filled, while the other one is being written,
+ * until adc_stream_stop() is called. The extra_samplings and callback
+ * fields of the sequence options are not used.
+ *
+ * The ADC is reserved for the stream, other requests wait until it is
+ * stopped. This function can only be called from kernel mode.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param sequence  Channels, resolution, sampling interval and buffer.
+ * @param callback  Called with every filled half of the buffer.
+ * @param user_data User data passed to @p callback.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided,
+ *                  e.g. an interval the hardware timer cannot produce.
+ * @retval -ENOMEM  If a half of the buffer cannot hold one sampling.
+ * @retval -ENOTSUP If the driver does not support streaming or the
+ *                  requested configuration.
+ */
+static inline int adc_stream_start(const struct device *dev,
+				   const struct adc_sequence *sequence,
+				   adc_stream_callback callback,
+				   void *user_data)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, sequence, callback, user_data);
+}
+
+/**
+ * @brief Stop a continuous acquisition.
+ *
+ * The samples of the half being filled are dropped. No callback is called
+ * once this function returns.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ *
+ * @retval 0        On success.
+ * @retval -EALREADY If no stream is running.
+ * @retval -ENOTSUP If the driver does not support streaming.
+ */
+static inline int adc_stream_stop(const struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for CAN identifier sets and batched reception
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_CAN_ID_FILTER_H_
+#define ZEPHYR_INCLUDE_DRIVERS_CAN_ID_FILTER_H_
+
+/**
+ * @brief CAN Identifier Filter
+ * @defgroup can_id_filter_interface CAN Identifier Filter
+ * @ingroup can_interface
+ * @{
+ */
+
+#include <kernel.h>
+#include <sys/ring_buffer.h>
+#include <drivers/can.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Ring of received CAN frames
+ *
+ * Frames are added from the receive interrupt and read in batches by a
+ * thread, which only wakes up when the ring goes from empty to non-empty.
+ * The fields are internal.
+ */
+struct can_rx_ring {
+	struct ring_buf rb;
+	struct k_sem sem;
+	struct k_spinlock lock;
+	/** Number of frames dropped because the ring was full */
+	uint32_t dropped;
+};
+
+/** @cond INTERNAL_HIDDEN */
+struct can_id_mask {
+	uint32_t id;
+	uint32_t mask;
+};
+
+#define CAN_ID_FILTER_HASH_SIZE (2 * CONFIG_CAN_ID_FILTER_MAX_IDS)
+/** @endcond */
+
+/**
+ * @brief Set of CAN identifiers
+ *
+ * The identifiers are compacted into at most CONFIG_CAN_ID_FILTER_HW_MAX
+ * masked hardware filters, fewer if the controller runs out of them. The
+ * frames the masks let through without being part of the set are dropped
+ * by a hashed software filter. The fields are internal.
+ */
+struct can_id_filter {
+	const struct device *dev;
+	struct can_rx_ring *ring;
+	uint32_t hash[CAN_ID_FILTER_HASH_SIZE];
+	struct can_id_mask masks[CONFIG_CAN_ID_FILTER_MAX_IDS];
+	int filter_ids[CONFIG_CAN_ID_FILTER_HW_MAX];
+	uint16_t num_masks;
+	uint8_t id_type;
+};
+
+/**
+ * @brief Initialize a ring of received CAN frames.
+ *
+ * @param ring Pointer to the ring.
+ * @param frames Storage for the frames.
+ * @param count Number of frames in the storage.
+ */
+void can_rx_ring_init(struct can_rx_ring *ring, struct zcan_frame *frames,
+		      size_t count);
+
+/**
+ * @brief Read a batch of frames from a ring.
+ *
+ * Wait for at least one frame to be available, then copy as many as are
+ * available, up to @a count.
+ *
+ * @param ring Pointer to the ring.
+ * @param frames Array to copy the frames to.
+ * @param count Size of the array, in frames.
+ * @param timeout Time to wait for a frame.
+ *
+ * @retval Number of frames copied.
+ * @retval -EAGAIN If no frame was received before the timeout.
+ */
+int can_rx_ring_get(struct can_rx_ring *ring, struct zcan_frame *frames,
+		    size_t count, k_timeout_t timeout);
+
+/**
+ * @brief Receive a set of CAN identifiers into a ring.
+ *
+ * Data frames with one of the identifiers are added to the ring. Many
+ * identifiers can be received this way without using as many filters of the
+ * controller.
+ *
+ * @param filter Pointer to the identifier set, it is initialized.
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param ids Identifiers to receive.
+ * @param count Number of identifiers, at most CONFIG_CAN_ID_FILTER_MAX_IDS.
+ * @param id_type CAN_STANDARD_IDENTIFIER or CAN_EXTENDED_IDENTIFIER.
+ * @param ring Ring the frames are added to.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL If there are no or too many identifiers.
+ * @retval CAN_NO_FREE_FILTER if the controller has no filter left.
+ */
+int can_id_filter_attach(struct can_id_filter *filter,
+			 const struct device *dev, const uint32_t *ids,
+			 size_t count, enum can_ide id_type,
+			 struct can_rx_ring *ring);
+
+/**
+ * @brief Stop receiving a set of CAN identifiers.
+ *
+ * @param filter Pointer to the identifier set.
+ */
+void can_id_filter_detach(struct can_id_filter *filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_CAN_ID_FILTER_H_ */
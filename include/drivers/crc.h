@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for CRC unit drivers
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+
+/**
+ * @brief CRC Interface
+ * @defgroup crc_interface CRC Interface
+ * @ingroup io_interfaces
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <errno.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef crc_crc32_ieee_update_t
+ * @brief Callback API to update a CRC-32/IEEE.
+ *
+ * See crc_crc32_ieee_update() for argument description
+ */
+typedef int (*crc_crc32_ieee_update_t)(const struct device *dev,
+				       uint32_t *crc, const uint8_t *data,
+				       size_t len);
+
+__subsystem struct crc_driver_api {
+	crc_crc32_ieee_update_t crc32_ieee_update;
+};
+
+/**
+ * @brief Update a CRC-32/IEEE with the CRC unit.
+ *
+ * Computes the same value as crc32_ieee_update(). The call does not wait
+ * for the unit, it fails instead if another context is using it, so that
+ * it can be used from any supervisor context.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param crc CRC of the previous data, 0 for the first block. Updated with
+ *	      the CRC including @a data on success, unchanged otherwise.
+ * @param data Data to add to the CRC.
+ * @param len Length of the data in bytes.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if the unit is in use.
+ * @retval -ENOTSUP if the unit cannot compute this CRC.
+ */
+static inline int crc_crc32_ieee_update(const struct device *dev,
+					uint32_t *crc, const uint8_t *data,
+					size_t len)
+{
+	const struct crc_driver_api *api =
+		(const struct crc_driver_api *)dev->api;
+
+	if (api->crc32_ieee_update == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->crc32_ieee_update(dev, crc, data, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_CRC_H_ */
@@ -23,6 +23,10 @@
 #include <stddef.h>
 #include <zephyr/types.h>
 
+#ifdef CONFIG_DISPLAY_ASYNC
+#include <kernel.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -157,6 +161,19 @@ typedef int (*display_write_api)(const struct device *dev, const uint16_t x,
 				 const struct display_buffer_descriptor *desc,
 				 const void *buf);
 
+#ifdef CONFIG_DISPLAY_ASYNC
+/**
+ * @typedef display_write_async_api
+ * @brief Callback API for writing data to the display asynchronously
+ * See display_write_async() for argument description
+ */
+typedef int (*display_write_async_api)(const struct device *dev,
+				       const uint16_t x, const uint16_t y,
+				       const struct display_buffer_descriptor *desc,
+				       const void *buf,
+				       struct k_poll_signal *signal);
+#endif
+
 /**
  * @typedef display_read_api
  * @brief Callback API for reading data from the display
@@ -232,6 +249,9 @@ struct display_driver_api {
 	display_get_capabilities_api get_capabilities;
 	display_set_pixel_format_api set_pixel_format;
 	display_set_orientation_api set_orientation;
+#ifdef CONFIG_DISPLAY_ASYNC
+	display_write_async_api write_async;
+#endif
 };
 
 /**
@@ -256,6 +276,44 @@ static inline int display_write(const struct device *dev, const uint16_t x,
 	return api->write(dev, x, y, desc, buf);
 }
 
+#ifdef CONFIG_DISPLAY_ASYNC
+/**
+ * @brief Write data to display asynchronously
+ *
+ * Start writing the buffer and return without waiting for the transfer to
+ * complete, so that the caller can prepare the next buffer meanwhile. The
+ * buffer must not be modified until the signal has been raised, with the
+ * result of the transfer. A write waits for the previous asynchronous write
+ * to the same display to complete before it is started.
+ *
+ * @param dev Pointer to device structure
+ * @param x x Coordinate of the upper left corner where to write the buffer
+ * @param y y Coordinate of the upper left corner where to write the buffer
+ * @param desc Pointer to a structure describing the buffer layout
+ * @param buf Pointer to buffer array
+ * @param signal Signal raised when the transfer has completed
+ *
+ * @retval 0 If the transfer was started.
+ * @retval -ENOTSUP If the driver does not support asynchronous writes.
+ * @retval Negative errno code on failure.
+ */
+static inline int display_write_async(const struct device *dev,
+				      const uint16_t x, const uint16_t y,
+				      const struct display_buffer_descriptor *desc,
+				      const void *buf,
+				      struct k_poll_signal *signal)
+{
+	struct display_driver_api *api =
+		(struct display_driver_api *)dev->api;
+
+	if (api->write_async == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->write_async(dev, x, y, desc, buf, signal);
+}
+#endif
+
 /**
  * @brief Read data from display
  *
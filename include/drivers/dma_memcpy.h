@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for DMA memory copy offload
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_DMA_MEMCPY_H_
+#define ZEPHYR_INCLUDE_DRIVERS_DMA_MEMCPY_H_
+
+/**
+ * @brief DMA Memory Copy Offload
+ * @defgroup dma_memcpy_interface DMA Memory Copy Offload
+ * @ingroup dma_interface
+ * @{
+ */
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <drivers/dma.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef dma_memcpy_callback_t
+ * @brief Callback called when an offloaded copy has completed.
+ *
+ * The callback is called from the DMA controller interrupt. A new copy
+ * may be submitted from the callback.
+ *
+ * @param user_data Opaque pointer given with the copy.
+ * @param status 0 on success, a negative errno otherwise.
+ */
+typedef void (*dma_memcpy_callback_t)(void *user_data, int status);
+
+/**
+ * @brief Segment of a scatter-gather copy
+ */
+struct dma_memcpy_seg {
+	/** Destination address */
+	void *dst;
+	/** Source address */
+	const void *src;
+	/** Number of bytes to copy */
+	size_t len;
+};
+
+struct dma_memcpy;
+
+/** @cond INTERNAL_HIDDEN */
+struct dma_memcpy_chan {
+	struct dma_memcpy *mc;
+	struct dma_config cfg;
+	struct dma_block_config block;
+	struct dma_memcpy_seg seg;
+	const struct dma_memcpy_seg *segs;
+	size_t count;
+	size_t next;
+	dma_memcpy_callback_t cb;
+	void *user_data;
+};
+/** @endcond */
+
+/**
+ * @brief DMA memory copy service
+ *
+ * The service owns CONFIG_DMA_MEMCPY_CHANNELS consecutive channels of a
+ * DMA controller and hands them out to the copies submitted to it. The
+ * fields are internal.
+ */
+struct dma_memcpy {
+	const struct device *dev;
+	uint32_t first_channel;
+	atomic_t used;
+	struct dma_memcpy_chan chan[CONFIG_DMA_MEMCPY_CHANNELS];
+};
+
+/**
+ * @brief Initialize a DMA memory copy service.
+ *
+ * @param mc Pointer to the service.
+ * @param dev Pointer to the device structure of the DMA controller.
+ * @param first_channel First of the channels reserved for the service,
+ *        they must not be used by other DMA clients.
+ */
+void dma_memcpy_init(struct dma_memcpy *mc, const struct device *dev,
+		     uint32_t first_channel);
+
+/**
+ * @brief Copy a list of segments with the DMA controller.
+ *
+ * The segments are copied in order on one channel, the callback is called
+ * once all of them are done or on the first error. The array and the
+ * memory it points to must stay valid until then. The caller is
+ * responsible for the cache maintenance of the buffers.
+ *
+ * @param mc Pointer to the service.
+ * @param segs Segments to copy.
+ * @param count Number of segments.
+ * @param cb Completion callback, or NULL if none.
+ * @param user_data Opaque pointer for the callback.
+ *
+ * @retval 0 If the copy was started.
+ * @retval -EINVAL If there is no segment or a segment is empty.
+ * @retval -EBUSY If all the channels of the service are in use, the
+ *         caller may then fall back to memcpy().
+ * @retval -errno Other negative errno code from the DMA driver.
+ */
+int dma_memcpy_sg_async(struct dma_memcpy *mc,
+			const struct dma_memcpy_seg *segs, size_t count,
+			dma_memcpy_callback_t cb, void *user_data);
+
+/**
+ * @brief Copy a buffer with the DMA controller.
+ *
+ * Same as dma_memcpy_sg_async() for a single segment, only the buffers
+ * have to stay valid until the callback is called.
+ *
+ * @param mc Pointer to the service.
+ * @param dst Destination address.
+ * @param src Source address.
+ * @param len Number of bytes to copy.
+ * @param cb Completion callback, or NULL if none.
+ * @param user_data Opaque pointer for the callback.
+ *
+ * @return See dma_memcpy_sg_async().
+ */
+int dma_memcpy_async(struct dma_memcpy *mc, void *dst, const void *src,
+		     size_t len, dma_memcpy_callback_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_DMA_MEMCPY_H_ */
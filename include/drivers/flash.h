@@ -108,6 +108,77 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 				   void *data, size_t len);
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 
+#if defined(CONFIG_FLASH_ASYNC)
+struct flash_async_req;
+
+/**
+ * @brief Callback called when an asynchronous flash operation completes.
+ *
+ * @param dev    flash device
+ * @param req    completed request, it may be reused from the callback
+ * @param result 0 on success, negative errno code otherwise
+ */
+typedef void (*flash_async_cb_t)(const struct device *dev,
+				 struct flash_async_req *req, int result);
+
+/** @brief Asynchronous flash operation */
+enum flash_async_op {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+/**
+ * @brief Asynchronous flash request
+ *
+ * The request is owned by the flash API from its submission until its
+ * completion is reported, through @a cb and/or @a signal which have to be
+ * set by the caller before submitting it.
+ */
+struct flash_async_req {
+	/** Called on completion from the flash work queue or from the
+	 *  driver interrupt, may be NULL.
+	 */
+	flash_async_cb_t cb;
+	/** Raised with the result on completion, may be NULL. */
+	struct k_poll_signal *signal;
+
+	/* Filled by the submit helpers */
+	enum flash_async_op op;
+	off_t offset;
+	void *data;
+	size_t len;
+
+	/* Private, used when the driver has no asynchronous support */
+	const struct device *dev;
+	struct k_work work;
+};
+
+/**
+ * @brief Start an asynchronous request, drivers which implement it call
+ * z_flash_async_done() when the request completes.
+ */
+typedef int (*flash_api_submit_async)(const struct device *dev,
+				      struct flash_async_req *req);
+#endif /* CONFIG_FLASH_ASYNC */
+
+#if defined(CONFIG_FLASH_XIP_API)
+/**
+ * @brief Get the address where a flash range is mapped for direct reads.
+ *
+ * @param dev    flash device
+ * @param offset offset of the range
+ * @param len    length of the range
+ * @param addr   the address of @p offset is returned in this argument
+ *
+ * @retval 0 on success, the whole range is readable at @p addr
+ * @retval -ENOTSUP if the range is not memory mapped
+ * @retval -EINVAL if the range is out of the device
+ */
+typedef int (*flash_api_xip_address)(const struct device *dev, off_t offset,
+				     size_t len, const void **addr);
+#endif /* CONFIG_FLASH_XIP_API */
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -121,6 +192,12 @@ __subsystem struct flash_driver_api {
 	flash_api_sfdp_read sfdp_read;
 	flash_api_read_jedec_id read_jedec_id;
 #endif /* CONFIG_FLASH_JESD216_API */
+#if defined(CONFIG_FLASH_ASYNC)
+	flash_api_submit_async submit_async;
+#endif /* CONFIG_FLASH_ASYNC */
+#if defined(CONFIG_FLASH_XIP_API)
+	flash_api_xip_address xip_address;
+#endif /* CONFIG_FLASH_XIP_API */
 };
 
 /**
@@ -444,6 +521,133 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ *  @brief  Submit an asynchronous flash request
+ *
+ *  The request is passed to the driver when it supports asynchronous
+ *  operations, otherwise it is executed by the flash work queue thread with
+ *  the synchronous API. Either way the caller does not wait for the
+ *  operation, which completes as described by @ref flash_async_req.
+ *
+ *  @param  dev flash device
+ *  @param  req request with its operation and completion fields set
+ *
+ *  @return  0 if the request was submitted, negative errno code otherwise.
+ *           The completion is not reported for a request which failed to be
+ *           submitted.
+ */
+int flash_submit_async(const struct device *dev, struct flash_async_req *req);
+
+/**
+ *  @brief  Read data from flash without waiting for the operation
+ *
+ *  @param  dev    flash device
+ *  @param  offset offset (byte aligned) to read
+ *  @param  data   buffer to store read data, valid until completion
+ *  @param  len    number of bytes to read
+ *  @param  req    request with its completion fields set
+ *
+ *  @return  0 if the request was submitted, negative errno code otherwise.
+ */
+static inline int flash_read_async(const struct device *dev, off_t offset,
+				   void *data, size_t len,
+				   struct flash_async_req *req)
+{
+	req->op = FLASH_ASYNC_READ;
+	req->offset = offset;
+	req->data = data;
+	req->len = len;
+
+	return flash_submit_async(dev, req);
+}
+
+/**
+ *  @brief  Write buffer into flash without waiting for the operation
+ *
+ *  @param  dev    flash device
+ *  @param  offset starting offset for the write
+ *  @param  data   data to write, valid until completion
+ *  @param  len    number of bytes to write
+ *  @param  req    request with its completion fields set
+ *
+ *  @return  0 if the request was submitted, negative errno code otherwise.
+ */
+static inline int flash_write_async(const struct device *dev, off_t offset,
+				    const void *data, size_t len,
+				    struct flash_async_req *req)
+{
+	req->op = FLASH_ASYNC_WRITE;
+	req->offset = offset;
+	req->data = (void *)data;
+	req->len = len;
+
+	return flash_submit_async(dev, req);
+}
+
+/**
+ *  @brief  Erase part or all of a flash memory without waiting for the
+ *          operation
+ *
+ *  @param  dev    flash device
+ *  @param  offset erase area starting offset
+ *  @param  size   size of area to be erased
+ *  @param  req    request with its completion fields set
+ *
+ *  @return  0 if the request was submitted, negative errno code otherwise.
+ */
+static inline int flash_erase_async(const struct device *dev, off_t offset,
+				    size_t size, struct flash_async_req *req)
+{
+	req->op = FLASH_ASYNC_ERASE;
+	req->offset = offset;
+	req->data = NULL;
+	req->len = size;
+
+	return flash_submit_async(dev, req);
+}
+
+/**
+ *  @brief  Report the completion of an asynchronous request, for drivers.
+ */
+void z_flash_async_done(const struct device *dev, struct flash_async_req *req,
+			int result);
+#endif /* CONFIG_FLASH_ASYNC */
+
+#if defined(CONFIG_FLASH_XIP_API)
+/**
+ *  @brief  Get the address where flash contents can be read directly
+ *
+ *  Memory mapped flash, like the internal flash of most SoCs, can be read
+ *  in place instead of being copied with flash_read(). The contents read
+ *  through the address change when the range is written or erased.
+ *
+ *  This function is not available from user mode.
+ *
+ *  @param  dev    flash device
+ *  @param  offset offset (byte aligned) of the range
+ *  @param  len    length of the range
+ *  @param  addr   the address of @p offset is returned in this argument
+ *
+ *  @retval 0 on success, the whole range is readable from @p addr
+ *  @retval -ENOTSUP if the flash device is not memory mapped
+ *  @retval -EINVAL if the range is out of the device
+ */
+static inline int flash_get_xip_address(const struct device *dev,
+					off_t offset, size_t len,
+					const void **addr)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if (api->xip_address == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->xip_address(dev, offset, len, addr);
+}
+#endif /* CONFIG_FLASH_XIP_API */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for queued I2C transfers
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_I2C_QUEUE_H_
+#define ZEPHYR_INCLUDE_DRIVERS_I2C_QUEUE_H_
+
+/**
+ * @brief I2C Transfer Queue
+ * @defgroup i2c_queue_interface I2C Transfer Queue
+ * @ingroup i2c_interface
+ * @{
+ */
+
+#include <kernel.h>
+#include <sys/slist.h>
+#include <drivers/i2c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct i2c_transaction;
+
+/**
+ * @typedef i2c_transaction_cb_t
+ * @brief Callback called when a queued I2C transfer has completed.
+ *
+ * The callback is called from the work queue of the I2C queue. The
+ * transaction may be submitted again from the callback.
+ *
+ * @param txn The completed transaction.
+ * @param result Result of i2c_transfer() for the transaction.
+ */
+typedef void (*i2c_transaction_cb_t)(struct i2c_transaction *txn,
+				     int result);
+
+/**
+ * @brief I2C transaction descriptor
+ *
+ * The descriptor and the messages it points to must stay valid until the
+ * callback has been called.
+ */
+struct i2c_transaction {
+	/** Queue node, used internally */
+	sys_snode_t node;
+	/** Messages to transfer, as for i2c_transfer() */
+	struct i2c_msg *msgs;
+	/** Number of messages */
+	uint8_t num_msgs;
+	/** Address of the I2C target device */
+	uint16_t addr;
+	/** Completion callback, or NULL if none */
+	i2c_transaction_cb_t cb;
+	/** Opaque pointer for the callback */
+	void *user_data;
+};
+
+/**
+ * @brief I2C transfer queue
+ *
+ * All users of an I2C bus submit their transactions to the same queue,
+ * which performs them in submission order from its work queue. The fields
+ * are internal.
+ */
+struct i2c_queue {
+	const struct device *dev;
+	struct k_work_q *work_q;
+	sys_slist_t pending;
+	struct k_work work;
+	struct k_spinlock lock;
+};
+
+/**
+ * @brief Initialize an I2C transfer queue.
+ *
+ * Transfers are blocking, so each work queue performs one transfer at a
+ * time. Give the queues of different buses their own work queue for the
+ * buses to be busy at the same time.
+ *
+ * @param queue Pointer to the queue.
+ * @param dev Pointer to the device structure of the I2C bus driver.
+ * @param work_q Work queue performing the transfers, or NULL for the
+ *        system work queue.
+ */
+void i2c_queue_init(struct i2c_queue *queue, const struct device *dev,
+		    struct k_work_q *work_q);
+
+/**
+ * @brief Submit a transaction to an I2C transfer queue.
+ *
+ * @param queue Pointer to the queue.
+ * @param txn Pointer to the transaction descriptor.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -EINVAL If the transaction has no messages.
+ */
+int i2c_queue_submit(struct i2c_queue *queue, struct i2c_transaction *txn);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_I2C_QUEUE_H_ */
@@ -233,6 +233,13 @@ enum sensor_trigger_type {
 	/** Trigger fires when a free fall is detected. */
 	SENSOR_TRIG_FREEFALL,
 
+	/**
+	 * Trigger fires when the sensor FIFO holds the number of frames
+	 * configured via the @ref SENSOR_ATTR_FIFO_WATERMARK attribute.
+	 * The frames are read with @ref sensor_fifo_read.
+	 */
+	SENSOR_TRIG_FIFO_WATERMARK,
+
 	/**
 	 * Number of all common sensor triggers.
 	 */
@@ -294,6 +301,12 @@ enum sensor_attribute {
 	 * algorithms to calibrate itself on a certain axis, or all of them.
 	 */
 	SENSOR_ATTR_CALIB_TARGET,
+	/**
+	 * Number of frames buffered in the sensor FIFO before the
+	 * @ref SENSOR_TRIG_FIFO_WATERMARK trigger fires. Setting it to 0
+	 * disables the FIFO.
+	 */
+	SENSOR_ATTR_FIFO_WATERMARK,
 
 	/**
 	 * Number of all common sensor attributes.
@@ -370,6 +383,24 @@ typedef int (*sensor_sample_fetch_t)(const struct device *dev,
 typedef int (*sensor_channel_get_t)(const struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
+/**
+ * @typedef sensor_fifo_read_t
+ * @brief Callback API for reading raw frames from a sensor FIFO
+ *
+ * See sensor_fifo_read() for argument description
+ */
+typedef int (*sensor_fifo_read_t)(const struct device *dev, void *buf,
+				  size_t len);
+/**
+ * @typedef sensor_fifo_decode_t
+ * @brief Callback API for converting raw FIFO frames
+ *
+ * See sensor_fifo_decode() for argument description
+ */
+typedef int (*sensor_fifo_decode_t)(const struct device *dev,
+				    enum sensor_channel chan,
+				    const void *buf, size_t len,
+				    struct sensor_value *val, size_t count);
 
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
@@ -377,6 +408,8 @@ __subsystem struct sensor_driver_api {
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+	sensor_fifo_read_t fifo_read;
+	sensor_fifo_decode_t fifo_decode;
 };
 
 /**
@@ -566,6 +599,74 @@ static inline int z_impl_sensor_channel_get(const struct device *dev,
 	return api->channel_get(dev, chan, val);
 }
 
+/**
+ * @brief Read raw frames from the sensor FIFO
+ *
+ * Reads as many complete frames as fit in @p buf in burst transfers. A
+ * frame holds one sample of every channel stored in the FIFO, in a
+ * driver specific layout. Use @ref sensor_fifo_decode to convert them.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Where to store the frames
+ * @param len Size of @p buf in bytes
+ *
+ * @return Number of bytes stored in @p buf if successful, negative errno
+ * code if failure.
+ */
+__syscall int sensor_fifo_read(const struct device *dev, void *buf,
+			       size_t len);
+
+static inline int z_impl_sensor_fifo_read(const struct device *dev,
+					  void *buf, size_t len)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->fifo_read == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->fifo_read(dev, buf, len);
+}
+
+/**
+ * @brief Convert raw FIFO frames to values of a channel
+ *
+ * Converts the frames read by @ref sensor_fifo_read, using the scale the
+ * sensor is configured with. Vectorial channels with the _XYZ suffix give
+ * three values per frame, X, Y and Z in that order.
+ *
+ * @param dev Pointer to the sensor device
+ * @param chan The channel to convert
+ * @param buf Frames returned by @ref sensor_fifo_read
+ * @param len Number of bytes in @p buf
+ * @param val Where to store the values
+ * @param count Number of entries in @p val
+ *
+ * @return Number of frames converted if successful, negative errno code if
+ * failure.
+ */
+__syscall int sensor_fifo_decode(const struct device *dev,
+				 enum sensor_channel chan,
+				 const void *buf, size_t len,
+				 struct sensor_value *val, size_t count);
+
+static inline int z_impl_sensor_fifo_decode(const struct device *dev,
+					    enum sensor_channel chan,
+					    const void *buf, size_t len,
+					    struct sensor_value *val,
+					    size_t count)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->fifo_decode == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->fifo_decode(dev, chan, buf, len, val, count);
+}
+
 /**
  * @brief The value of gravitational constant in micro m/s^2.
  */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for queued SPI transactions
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_SPI_QUEUE_H_
+#define ZEPHYR_INCLUDE_DRIVERS_SPI_QUEUE_H_
+
+/**
+ * @brief SPI Transaction Queue
+ * @defgroup spi_queue_interface SPI Transaction Queue
+ * @ingroup spi_interface
+ * @{
+ */
+
+#include <kernel.h>
+#include <sys/slist.h>
+#include <drivers/spi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct spi_transaction;
+
+/**
+ * @typedef spi_transaction_cb_t
+ * @brief Callback called when a queued SPI transaction has completed.
+ *
+ * The callback is called from the system work queue. The transaction
+ * may be submitted again from the callback.
+ *
+ * @param txn The completed transaction.
+ * @param result Result of spi_transceive_async() for the transaction.
+ */
+typedef void (*spi_transaction_cb_t)(struct spi_transaction *txn,
+				     int result);
+
+/**
+ * @brief SPI transaction descriptor
+ *
+ * The descriptor, the configuration and the buffers it points to must stay
+ * valid until the callback has been called. The configuration must not have
+ * SPI_LOCK_ON set, as that would keep the transactions of other slaves from
+ * running.
+ */
+struct spi_transaction {
+	/** Queue node, used internally */
+	sys_snode_t node;
+	/** Configuration of the slave the transaction is for */
+	const struct spi_config *config;
+	/** Buffers to send, or NULL if none */
+	const struct spi_buf_set *tx_bufs;
+	/** Buffers to receive into, or NULL if none */
+	const struct spi_buf_set *rx_bufs;
+	/** Completion callback, or NULL if none */
+	spi_transaction_cb_t cb;
+	/** Opaque pointer for the callback */
+	void *user_data;
+};
+
+/**
+ * @brief SPI transaction queue
+ *
+ * All users of a SPI bus submit their transactions to the same queue, which
+ * runs them back to back in submission order. The fields are internal.
+ */
+struct spi_queue {
+	const struct device *dev;
+	sys_slist_t pending;
+	struct spi_transaction *current;
+	struct k_poll_signal signal;
+	struct k_poll_event event;
+	struct k_work_poll work;
+	struct k_spinlock lock;
+};
+
+/**
+ * @brief Initialize a SPI transaction queue.
+ *
+ * @param queue Pointer to the queue.
+ * @param dev Pointer to the device structure of the SPI bus driver.
+ */
+void spi_queue_init(struct spi_queue *queue, const struct device *dev);
+
+/**
+ * @brief Submit a transaction to a SPI transaction queue.
+ *
+ * The transaction is started right away if the queue is idle, otherwise
+ * it is started from the system work queue once the transactions submitted
+ * before it have completed. Transactions for different slaves can be mixed,
+ * the configuration is switched by the driver as for spi_transceive().
+ *
+ * @note This function must not be called from an interrupt handler, as
+ * starting a transaction may wait for the bus lock.
+ *
+ * @param queue Pointer to the queue.
+ * @param txn Pointer to the transaction descriptor.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -EINVAL If the transaction has no configuration.
+ */
+int spi_queue_submit(struct spi_queue *queue, struct spi_transaction *txn);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_SPI_QUEUE_H_ */
@@ -27,6 +27,10 @@
 
 #include <drivers/video-controls.h>
 
+#ifdef CONFIG_VIDEO_BUFFER_NET_BUF
+#include <net/buf.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -534,19 +538,97 @@ static inline int video_set_signal(const struct device *dev,
 /**
  * @brief Allocate video buffer.
  *
+ * The buffer is returned with a single reference, held by the caller.
+ *
  * @param size Size of the video buffer.
  *
  * @retval pointer to allocated video buffer
  */
 struct video_buffer *video_buffer_alloc(size_t size);
 
+/**
+ * @brief Take a reference to a video buffer.
+ *
+ * A frame can be handed over to other users, such as the network stack or
+ * a display driver, without copying it. Each of them holds a reference and
+ * releases it once done with the frame.
+ *
+ * @param buf Pointer to the video buffer.
+ *
+ * @retval buf
+ */
+struct video_buffer *video_buffer_ref(struct video_buffer *buf);
+
 /**
  * @brief Release a video buffer.
  *
+ * Drop a reference to the buffer, its memory is returned to the pool when
+ * the last reference is dropped.
+ *
  * @param buf Pointer to the video buffer to release.
  */
 void video_buffer_release(struct video_buffer *buf);
 
+#ifdef CONFIG_DISPLAY
+struct display_buffer_descriptor;
+
+/**
+ * @brief Describe a video buffer as a display buffer.
+ *
+ * Fill a descriptor with which the frame can be written as is with
+ * display_write(), provided its pixel format matches the display one.
+ *
+ * @param buf Pointer to the video buffer.
+ * @param fmt Format of the frame in the buffer.
+ * @param desc Descriptor to fill.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL If the frame is too large for a display descriptor.
+ */
+int video_buffer_display_desc(const struct video_buffer *buf,
+			      const struct video_format *fmt,
+			      struct display_buffer_descriptor *desc);
+#endif
+
+#ifdef CONFIG_VIDEO_BUFFER_NET_BUF
+/** @cond INTERNAL_HIDDEN */
+void video_buffer_net_buf_destroy(struct net_buf *buf);
+/** @endcond */
+
+/**
+ * @brief Define a pool of network buffers wrapping video buffers.
+ *
+ * The network buffers carry no data of their own, they point into the
+ * video buffers they wrap.
+ *
+ * @param _name Name of the pool variable.
+ * @param _count Number of network buffers in the pool.
+ */
+#define VIDEO_NET_BUF_POOL_DEFINE(_name, _count)			\
+	NET_BUF_POOL_DEFINE(_name, _count, 0,				\
+			    sizeof(struct video_buffer *),		\
+			    video_buffer_net_buf_destroy)
+
+/**
+ * @brief Wrap the data of a video buffer in network buffers.
+ *
+ * The used part of the video buffer is referenced by a chain of network
+ * buffers, so that a frame larger than what a network buffer can describe
+ * can be sent without copy. Every network buffer holds a reference to the
+ * video buffer, which is released when the network buffer is freed.
+ *
+ * @param pool Pool defined with VIDEO_NET_BUF_POOL_DEFINE().
+ * @param buf Pointer to the video buffer.
+ * @param timeout Time to wait for network buffers.
+ *
+ * @retval Head of the network buffer chain, or NULL if the pool ran out of
+ *	   buffers.
+ */
+struct net_buf *video_buffer_net_buf(struct net_buf_pool *pool,
+				     struct video_buffer *buf,
+				     k_timeout_t timeout);
+#endif
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
@@ -76,6 +76,18 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+#ifdef CONFIG_FCB_INDEX
+/**
+ * @brief Location of an FCB entry kept in RAM, internal state
+ */
+struct fcb_index_entry {
+	uint32_t fi_elem_off; /**< Offset of the entry in its sector */
+	uint16_t fi_data_len; /**< Length of the entry data */
+	uint8_t fi_sector; /**< Index of the sector in the sector array */
+	uint8_t fi_hdr_len; /**< Offset of the data from the entry */
+};
+#endif /* CONFIG_FCB_INDEX */
+
 /**
  * @brief FCB instance structure
  *
@@ -117,6 +129,23 @@ struct fcb {
 	uint8_t f_align;
 	/**< writes to flash have to aligned to this, internal state */
 
+#ifdef CONFIG_FCB_INDEX
+	struct fcb_index_entry f_index[CONFIG_FCB_INDEX_SIZE];
+	/**< Ring of the entry locations in walk order, internal state */
+
+	uint16_t f_index_head;
+	/**< Ring position of the oldest entry, internal state */
+
+	uint16_t f_index_cnt;
+	/**< Number of entries in the ring, internal state */
+
+	uint16_t f_index_hint;
+	/**< Position of the last entry served, internal state */
+
+	uint8_t f_index_state;
+	/**< Whether the ring covers all the entries, internal state */
+#endif /* CONFIG_FCB_INDEX */
+
 	const struct flash_area *fap;
 	/**< Flash area used by the fcb instance, , internal state.
 	 * This can be transfer to FCB user
@@ -29,6 +29,9 @@ typedef long long int off_t;
 
 #include <sys/dlist.h>
 #include <fs/fs_interface.h>
+#if defined(CONFIG_FILE_SYSTEM_ASYNC)
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -302,6 +305,73 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+/**
+ * @brief Buffer of a vectored file read or write
+ */
+struct fs_iovec {
+	void *base; /**< Start of the buffer */
+	size_t len; /**< Length of the buffer in bytes */
+};
+
+/**
+ * @brief Read file into several buffers
+ *
+ * Reads data into the @p iovcnt buffers of @p iov in turn, as a sequence of
+ * fs_read() calls would, with one call when the underlying file system
+ * supports vectored reads. The read stops at the end of the file.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of the buffers to fill
+ * @param iovcnt Number of buffers in @p iov
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 size_t iovcnt);
+
+/**
+ * @brief Write several buffers to file
+ *
+ * Writes the @p iovcnt buffers of @p iov in turn, as a sequence of
+ * fs_write() calls would, with one call when the underlying file system
+ * supports vectored writes. A returned value lower than the total length of
+ * the buffers means that the volume is full, like for fs_write().
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of the buffers to write
+ * @param iovcnt Number of buffers in @p iov
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  size_t iovcnt);
+
+/**
+ * @brief Get read-only access to file data in place
+ *
+ * Gets the address of the @p len bytes of file data starting at @p off,
+ * when the file system keeps them contiguous in memory, so that they can be
+ * used without being copied with fs_read(). The file position is not
+ * changed. The data must not be modified and the address stays valid until
+ * the file is written, truncated or closed.
+ *
+ * @param zfp Pointer to the file object
+ * @param off Offset of the data in the file
+ * @param len Number of bytes to access
+ * @param addr Pointer to the address of the data
+ *
+ * @retval 0 on success;
+ * @retval -EINVAL if the data is not within the file;
+ * @retval -ENOTSUP if the data is not contiguous in memory or the
+ *         underlying file system driver does not support it;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_mmap(struct fs_file_t *zfp, off_t off, size_t len, const void **addr);
+
 /**
  * @brief Seek file
  *
@@ -336,6 +406,27 @@ int fs_seek(struct fs_file_t *zfp, off_t offset, int whence);
  */
 off_t fs_tell(struct fs_file_t *zfp);
 
+/**
+ * @brief Allocate contiguous storage to an empty file
+ *
+ * Allocates @p size bytes of contiguous storage to the file opened for
+ * writing, which has to be empty, and sets the file size to @p size. The
+ * content of the file is undefined until it is written. It suits recordings
+ * of a known maximal size, which are written without allocating storage on
+ * the way, and are then truncated to the recorded length with fs_truncate().
+ *
+ * @param zfp Pointer to the file object
+ * @param size Number of bytes to allocate
+ *
+ * @retval 0 on success;
+ * @retval -EINVAL if the file is not empty or @p size is not positive;
+ * @retval -EACCES if the file is not opened for writing;
+ * @retval -ENOSPC if there is no contiguous free space of that size;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_preallocate(struct fs_file_t *zfp, off_t size);
+
 /**
  * @brief Truncate or extend an open file to a given size
  *
@@ -373,6 +464,142 @@ int fs_truncate(struct fs_file_t *zfp, off_t length);
  */
 int fs_sync(struct fs_file_t *zfp);
 
+#if defined(CONFIG_FILE_SYSTEM_ASYNC)
+struct fs_async_req;
+
+/**
+ * @brief Callback called when an asynchronous file operation completes.
+ *
+ * @param req completed request, it may be reused from the callback
+ * @param result value the synchronous function would have returned
+ */
+typedef void (*fs_async_cb_t)(struct fs_async_req *req, ssize_t result);
+
+/** @brief Asynchronous file operation */
+enum fs_async_op {
+	FS_ASYNC_READ,
+	FS_ASYNC_WRITE,
+	FS_ASYNC_SYNC,
+};
+
+/**
+ * @brief Asynchronous file request
+ *
+ * The request, its file object and its buffers are owned by the file
+ * system API from the submission of the request until its completion is
+ * reported, through @a cb and/or @a signal which have to be set by the
+ * caller before submitting it.
+ */
+struct fs_async_req {
+	/** Called on completion from the file system work queue or from the
+	 *  file system, may be NULL.
+	 */
+	fs_async_cb_t cb;
+	/** Raised with the result on completion, may be NULL. */
+	struct k_poll_signal *signal;
+	/** Operation, set by the submission functions. */
+	enum fs_async_op op;
+	/** File to operate on, set by the submission functions. */
+	struct fs_file_t *zfp;
+	/** Buffers to read or write, set by the submission functions. */
+	const struct fs_iovec *iov;
+	/** Number of buffers, set by the submission functions. */
+	size_t iovcnt;
+	/** Internal: used by the file system work queue. */
+	struct k_work work;
+};
+
+/**
+ * @brief Submit an asynchronous file request
+ *
+ * The request is passed to the file system when it supports asynchronous
+ * operations, otherwise it is executed by the file system work queue thread
+ * with the synchronous API. Either way the caller does not wait for the
+ * operation. Requests are completed in their submission order, so that a
+ * record written with several requests stays in order in the file.
+ *
+ * @param req request with its operation and completion fields set
+ *
+ * @retval 0 if the request was submitted;
+ * @retval -EBADF when the file is not open;
+ * @retval <0 an other negative errno code on error. The completion is not
+ *         reported for a request which failed to be submitted.
+ */
+int fs_submit_async(struct fs_async_req *req);
+
+/**
+ * @brief Read file into several buffers without waiting for the operation
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of the buffers to fill, valid until completion
+ * @param iovcnt Number of buffers in @p iov
+ * @param req Request with its completion fields set
+ *
+ * @retval 0 if the request was submitted;
+ * @retval <0 a negative errno code on error.
+ */
+static inline int fs_readv_async(struct fs_file_t *zfp,
+				 const struct fs_iovec *iov, size_t iovcnt,
+				 struct fs_async_req *req)
+{
+	req->op = FS_ASYNC_READ;
+	req->zfp = zfp;
+	req->iov = iov;
+	req->iovcnt = iovcnt;
+
+	return fs_submit_async(req);
+}
+
+/**
+ * @brief Write several buffers to file without waiting for the operation
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of the buffers to write, valid until completion
+ * @param iovcnt Number of buffers in @p iov
+ * @param req Request with its completion fields set
+ *
+ * @retval 0 if the request was submitted;
+ * @retval <0 a negative errno code on error.
+ */
+static inline int fs_writev_async(struct fs_file_t *zfp,
+				  const struct fs_iovec *iov, size_t iovcnt,
+				  struct fs_async_req *req)
+{
+	req->op = FS_ASYNC_WRITE;
+	req->zfp = zfp;
+	req->iov = iov;
+	req->iovcnt = iovcnt;
+
+	return fs_submit_async(req);
+}
+
+/**
+ * @brief Flush the cache of an open file without waiting for the operation
+ *
+ * @param zfp Pointer to the file object
+ * @param req Request with its completion fields set
+ *
+ * @retval 0 if the request was submitted;
+ * @retval <0 a negative errno code on error.
+ */
+static inline int fs_sync_async(struct fs_file_t *zfp,
+				struct fs_async_req *req)
+{
+	req->op = FS_ASYNC_SYNC;
+	req->zfp = zfp;
+	req->iov = NULL;
+	req->iovcnt = 0;
+
+	return fs_submit_async(req);
+}
+
+/**
+ * @brief Report the completion of an asynchronous request, for file
+ *        systems.
+ */
+void z_fs_async_done(struct fs_async_req *req, ssize_t result);
+#endif /* CONFIG_FILE_SYSTEM_ASYNC */
+
 /**
  * @brief Directory create
  *
@@ -38,6 +38,12 @@ extern "C" {
  * @param stat Checks the status of a file or directory specified by the path
  * @param statvfs Returns the total and available space on the file system
  *        volume
+ * @param readv Optional, reads into several buffers in one call
+ * @param writev Optional, writes several buffers in one call
+ * @param mmap Optional, gets the address of file data contiguous in memory
+ * @param preallocate Optional, allocates contiguous storage to an empty file
+ * @param submit_async Optional, starts an asynchronous file operation and
+ *        reports its completion with z_fs_async_done()
  */
 struct fs_file_system_t {
 	/* File operations */
@@ -66,6 +72,17 @@ struct fs_file_system_t {
 					struct fs_dirent *entry);
 	int (*statvfs)(struct fs_mount_t *mountp, const char *path,
 					struct fs_statvfs *stat);
+	/* Optional vectored file operations */
+	ssize_t (*readv)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			 size_t iovcnt);
+	ssize_t (*writev)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			  size_t iovcnt);
+	int (*mmap)(struct fs_file_t *filp, off_t off, size_t len,
+		    const void **addr);
+	int (*preallocate)(struct fs_file_t *filp, off_t size);
+#if defined(CONFIG_FILE_SYSTEM_ASYNC)
+	int (*submit_async)(struct fs_async_req *req);
+#endif
 };
 
 /**
@@ -99,6 +99,23 @@ struct fs_littlefs {
 					  CONFIG_FS_LITTLEFS_CACHE_SIZE, \
 					  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE)
 
+/** @brief Mount point object of a devicetree fstab entry.
+ *
+ * Each node with the ``zephyr,fstab,littlefs`` compatible defines a
+ * :c:type:`struct fs_mount_t` configured from its properties, which can
+ * be passed to fs_mount() unless the node sets ``automount``.
+ *
+ * @param node_id devicetree node identifier of the entry
+ */
+#define FS_FSTAB_ENTRY(node_id) _CONCAT(z_fsmp_, node_id)
+
+/** @brief Declare the mount point object of a devicetree fstab entry.
+ *
+ * @param node_id devicetree node identifier of the entry
+ */
+#define FS_FSTAB_DECLARE_ENTRY(node_id)		\
+	extern struct fs_mount_t FS_FSTAB_ENTRY(node_id)
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,23 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection progress
+ *
+ * @param sec_addr Sector being collected
+ * @param addr Next allocation table entry to collect
+ * @param stop_addr Last allocation table entry of the sector
+ * @param data_wra Data write address when the last collection finished
+ * @param active Is a collection in progress ?
+ */
+struct nvs_gc_state {
+	uint32_t sec_addr;
+	uint32_t addr;
+	uint32_t stop_addr;
+	uint32_t data_wra;
+	bool active;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -43,6 +60,8 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Addresses of the latest allocation table entries
+ * @param gc Incremental garbage collection progress
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +76,12 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	struct nvs_gc_state gc;
+#endif
 };
 
 /**
@@ -170,6 +195,22 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Run one step of the incremental garbage collection. Once the free space in
+ * the write sector is below CONFIG_NVS_GC_INCREMENTAL_THRESHOLD the sector is
+ * closed and the oldest sector is collected, one entry per call, then erased.
+ * Calling it from a low priority thread or work item until it returns 0
+ * keeps nvs_write() from running the garbage collection itself.
+ *
+ * @param fs Pointer to file system
+ * @retval 1 More steps are needed
+ * @retval 0 Nothing to collect
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
 /**
  * @}
  */
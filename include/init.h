@@ -49,6 +49,13 @@ struct init_entry {
 	 * if the init entry is not used for a device driver but a services.
 	 */
 	const struct device *dev;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/** Priority of the entry within its level. Entries sharing a level
+	 * and a priority have no defined order between them, so they may
+	 * be initialized concurrently.
+	 */
+	uint8_t prio;
+#endif
 };
 
 void z_sys_init_run_level(int32_t _level);
@@ -88,8 +95,15 @@ void z_sys_init_run_level(int32_t _level);
 	__attribute__((__section__(".init_" #_level STRINGIFY(_prio)))) = { \
 		.init = (_init_fn),					\
 		.dev = (_device),					\
+		Z_INIT_ENTRY_PRIO(_prio)				\
 	}
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define Z_INIT_ENTRY_PRIO(_prio) .prio = (_prio),
+#else
+#define Z_INIT_ENTRY_PRIO(_prio)
+#endif
+
 /**
  * @def SYS_INIT
  *
@@ -189,6 +189,14 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Constant bandwidth server, in k_cycle_get_32() units */
+	uint32_t cbs_budget;
+	uint32_t cbs_period;
+	/* Execution cycles of the thread when the budget was replenished */
+	uint64_t cbs_mark;
+#endif
+
 	uint32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -203,6 +211,11 @@ struct _thread_base {
 
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Index of the CPU whose run queue holds this thread */
+	uint8_t runq_cpu;
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 	/* "May run on" bits for each CPU */
 	uint8_t cpu_mask;
@@ -280,6 +293,19 @@ struct z_poller {
 	uint8_t mode;
 };
 
+/**
+ * @ingroup thread_apis
+ * Thread runtime statistics
+ */
+typedef struct k_thread_runtime_stats {
+	/** Hardware cycles spent executing, see k_cycle_get_32() */
+	uint64_t execution_cycles;
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/** Times the thread ran out of its k_thread_cbs_set() budget */
+	uint32_t cbs_overruns;
+#endif
+} k_thread_runtime_stats_t;
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -384,6 +410,11 @@ struct k_thread {
 	uintptr_t tls;
 #endif /* CONFIG_THREAD_LOCAL_STORAGE */
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/** Runtime statistics */
+	struct k_thread_runtime_stats usage;
+#endif
+
 	/** arch-specifics: must always be at the end */
 	struct _thread_arch arch;
 };
@@ -629,6 +660,35 @@ static inline void k_thread_resource_pool_assign(struct k_thread *thread,
 }
 
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+/**
+ * @brief Get the runtime statistics of a thread
+ *
+ * Returns the hardware cycles @a thread has spent executing, including
+ * the current run if it is executing on the calling CPU.
+ *
+ * @note Requires CONFIG_THREAD_RUNTIME_STATS.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return 0 on success, -EINVAL if a parameter is NULL.
+ */
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       k_thread_runtime_stats_t *stats);
+
+/**
+ * @brief Get the runtime statistics of all threads
+ *
+ * Returns the hardware cycles accounted to any thread, idle threads
+ * included, summed over all CPUs. Dividing a thread's count from
+ * k_thread_runtime_stats_get() by this value gives its CPU share.
+ *
+ * @note Requires CONFIG_THREAD_RUNTIME_STATS.
+ *
+ * @param stats Pointer to struct to copy statistics into.
+ * @return 0 on success, -EINVAL if @a stats is NULL.
+ */
+int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
+
 /**
  * @brief Obtain stack usage information for the specified thread
  *
@@ -653,6 +713,37 @@ __syscall int k_thread_stack_space_get(const struct k_thread *thread,
 				       size_t *unused_ptr);
 #endif
 
+#ifdef CONFIG_THREAD_STACK_POOL
+/**
+ * @brief Allocate a thread stack from the kernel stack pool
+ *
+ * Returns one of the CONFIG_THREAD_STACK_POOL_NUM stacks of the kernel
+ * pool, to be passed to k_thread_create() with a size of at most
+ * K_THREAD_STACK_SIZEOF(CONFIG_THREAD_STACK_POOL_STACK_SIZE).  Pooled
+ * stacks may be used by user mode threads.
+ *
+ * @param size Stack size the thread needs, in bytes
+ * @param flags 0 or K_USER; all pooled stacks are suitable for both
+ *
+ * @return A stack object, or NULL if @a size is larger than the pool's
+ *         stacks or all of them are in use.
+ */
+k_thread_stack_t *k_thread_stack_alloc(size_t size, int flags);
+
+/**
+ * @brief Return a stack to the kernel stack pool
+ *
+ * The thread that used the stack must have exited, for example as
+ * observed through k_thread_join(), before its stack is freed.
+ *
+ * @param stack Stack obtained from k_thread_stack_alloc()
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @a stack doesn't belong to the pool or isn't allocated
+ */
+int k_thread_stack_free(k_thread_stack_t *stack);
+#endif /* CONFIG_THREAD_STACK_POOL */
+
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 /**
  * @brief Assign the system heap as a thread's resource pool
@@ -783,6 +874,11 @@ __syscall void k_wakeup(k_tid_t thread);
  */
 __syscall k_tid_t k_current_get(void);
 
+#ifdef CONFIG_CURRENT_THREAD_USE_TLS
+/* Thread ID of the running thread, set by z_thread_entry() */
+extern __thread k_tid_t z_tls_current;
+#endif
+
 /**
  * @brief Abort a thread.
  *
@@ -1007,6 +1103,39 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
  *
  */
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Set a constant bandwidth server budget for a thread
+ *
+ * Limits a deadline thread to @a budget cycles of execution every
+ * @a period cycles, in the same units used by k_cycle_get_32(). This
+ * sets the deadline of the thread to @a period from now. When the thread
+ * runs out of budget, its deadline is postponed by @a period and its
+ * budget replenished, which lets the other threads at the same static
+ * priority with earlier deadlines run first. The times this happens are
+ * counted in the cbs_overruns field of k_thread_runtime_stats_get().
+ *
+ * When the thread becomes ready again, it keeps its deadline and budget
+ * if the budget left is less than its bandwidth over the time to the
+ * deadline. Otherwise it gets a new deadline @a period from now and a
+ * full budget.
+ *
+ * The budget replaces the time slice of the thread, which must be
+ * preemptible. It is checked on system clock ticks, so a thread can
+ * overrun it by up to a tick.
+ *
+ * @note You should enable @option{CONFIG_SCHED_DEADLINE_CBS} in your
+ * project configuration.
+ *
+ * @param thread A thread on which to set the budget
+ * @param budget Execution cycles per period, 0 to remove the budget
+ * @param period Period, in cycle units
+ * @return 0 on success, -EINVAL if @a budget is larger than @a period
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, uint32_t budget,
+			       uint32_t period);
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -1893,22 +2022,67 @@ struct k_queue {
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* Lock-free MPSC staging list fed by k_queue_append_lockfree().
+	 * Producers exchange lf_tail; lf_head is only touched with the
+	 * queue lock held. lf_waiters counts pended getters and registered
+	 * pollers, which force producers onto the locked path.
+	 */
+	sys_sfnode_t lf_stub;
+	sys_sfnode_t *lf_head;
+	atomic_ptr_t lf_tail;
+	atomic_t lf_waiters;
+#endif
+
 	_POLL_EVENT;
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
 	_OBJECT_TRACING_LINKED_FLAG
 };
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+#define Z_QUEUE_LOCKFREE_INIT(obj) \
+	.lf_stub = { }, \
+	.lf_head = &obj.lf_stub, \
+	.lf_tail = &obj.lf_stub, \
+	.lf_waiters = ATOMIC_INIT(0),
+#else
+#define Z_QUEUE_LOCKFREE_INIT(obj)
+#endif
+
 #define Z_QUEUE_INITIALIZER(obj) \
 	{ \
 	.data_q = SYS_SFLIST_STATIC_INIT(&obj.data_q), \
 	.lock = { }, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),	\
+	Z_QUEUE_LOCKFREE_INIT(obj)		\
 	_POLL_EVENT_OBJ_INIT(obj)		\
 	_OBJECT_TRACING_INIT \
 	}
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+extern void z_queue_lockfree_flush(struct k_queue *queue);
+
+static inline bool z_queue_lockfree_is_empty(struct k_queue *queue)
+{
+	return (queue->lf_head == &queue->lf_stub) &&
+	       (atomic_ptr_get((atomic_ptr_t *)
+			       &queue->lf_stub.next_and_flags) == NULL);
+}
+#else
+static inline void z_queue_lockfree_flush(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline bool z_queue_lockfree_is_empty(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+	return true;
+}
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -1963,6 +2137,39 @@ __syscall void k_queue_cancel_wait(struct k_queue *queue);
  */
 extern void k_queue_append(struct k_queue *queue, void *data);
 
+/**
+ * @brief Append an element to the end of a queue without locking.
+ *
+ * This routine behaves like k_queue_append(), but when no thread is
+ * pended on @a queue and no k_poll() event is registered on it, the item
+ * is published with a single atomic exchange on a multi-producer,
+ * single-consumer list, without taking the queue lock or disabling
+ * interrupts. Otherwise it falls back to the locked path and wakes the
+ * first waiter.
+ *
+ * Ordering is FIFO with respect to other lock-free appends from the same
+ * producer; items move into the queue proper on the next locked operation,
+ * so an item appended concurrently with k_queue_append() may be observed
+ * in either order.
+ *
+ * @note Can be called by ISRs.
+ * @note Requires CONFIG_QUEUE_LOCKFREE_APPEND; otherwise this is
+ *	 k_queue_append().
+ *
+ * @param queue Address of the queue.
+ * @param data Address of the data item.
+ *
+ * @return N/A
+ */
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+extern void k_queue_append_lockfree(struct k_queue *queue, void *data);
+#else
+static inline void k_queue_append_lockfree(struct k_queue *queue, void *data)
+{
+	k_queue_append(queue, data);
+}
+#endif
+
 /**
  * @brief Append an element to a queue.
  *
@@ -2087,6 +2294,23 @@ extern int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
 
+/**
+ * @brief Get several elements from a queue at once.
+ *
+ * This routine removes up to @a count data items from the head of @a queue
+ * while taking the queue lock only once. It does not wait for data items to
+ * become available.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ * @param data Array filled with the addresses of the data items.
+ * @param count Maximum number of data items to remove.
+ *
+ * @return Number of data items stored in @a data.
+ */
+extern int k_queue_get_batch(struct k_queue *queue, void **data, int count);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -2103,6 +2327,7 @@ __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+	z_queue_lockfree_flush(queue);
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -2124,6 +2349,7 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+	z_queue_lockfree_flush(queue);
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -2151,7 +2377,8 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
-	return (int)sys_sflist_is_empty(&queue->data_q);
+	return (int)(sys_sflist_is_empty(&queue->data_q) &&
+		     z_queue_lockfree_is_empty(queue));
 }
 
 /**
@@ -2167,6 +2394,7 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	z_queue_lockfree_flush(queue);
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -2183,6 +2411,7 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	z_queue_lockfree_flush(queue);
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2346,6 +2575,24 @@ struct k_fifo {
 #define k_fifo_put(fifo, data) \
 	k_queue_append(&(fifo)->_queue, data)
 
+/**
+ * @brief Add an element to a FIFO queue without locking.
+ *
+ * This routine adds a data item to @a fifo through
+ * k_queue_append_lockfree(). A FIFO data item must be aligned on a word
+ * boundary, and the first word of the item is reserved for the kernel's
+ * use.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO.
+ * @param data Address of the data item.
+ *
+ * @return N/A
+ */
+#define k_fifo_put_lockfree(fifo, data) \
+	k_queue_append_lockfree(&(fifo)->_queue, data)
+
 /**
  * @brief Add an element to a FIFO queue.
  *
@@ -2420,6 +2667,24 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get(&(fifo)->_queue, timeout)
 
+/**
+ * @brief Get several elements from a FIFO queue at once.
+ *
+ * This routine removes up to @a count data items from @a fifo in a
+ * "first in, first out" manner, taking the queue lock only once. It does
+ * not wait for data items to become available.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param data Array filled with the addresses of the data items.
+ * @param count Maximum number of data items to remove.
+ *
+ * @return Number of data items stored in @a data.
+ */
+#define k_fifo_get_batch(fifo, data, count) \
+	k_queue_get_batch(&(fifo)->_queue, data, count)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -2779,6 +3044,16 @@ struct k_work_poll {
 
 extern struct k_work_q k_sys_work_q;
 
+struct k_work_pool {
+	/* Shared queue; its thread is the first worker */
+	struct k_work_q work_q;
+	struct k_thread *workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_stride;
+	uint8_t num_workers;
+};
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2970,6 +3245,72 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+/** Pin each worker of a work queue pool to its own CPU */
+#define K_WORK_POOL_PIN_CPU BIT(0)
+
+/**
+ * @brief Statically define a work queue pool.
+ *
+ * A work queue pool is a workqueue served by several threads. Items
+ * submitted to it are taken by whichever worker thread is idle first, so a
+ * slow handler only delays other items when all workers are busy.
+ *
+ * The pool must be started with k_work_pool_start() before use.
+ *
+ * @code extern struct k_work_pool <name>; @endcode
+ *
+ * @param name Name of the work queue pool.
+ * @param n_workers Number of worker threads, at least 2.
+ * @param stack_size Stack size of each worker thread (in bytes).
+ */
+#define K_WORK_POOL_DEFINE(name, n_workers, stack_size)			\
+	BUILD_ASSERT((n_workers) >= 2 && (n_workers) <= UINT8_MAX);	\
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_pool_stacks_##name,	\
+					   n_workers, stack_size);	\
+	static struct k_thread _k_work_pool_threads_##name[(n_workers) - 1]; \
+	struct k_work_pool name = {					\
+		.workers = _k_work_pool_threads_##name,			\
+		.stacks = (k_thread_stack_t *)_k_work_pool_stacks_##name, \
+		.stack_size = (stack_size),				\
+		.stack_stride = K_THREAD_STACK_LEN(stack_size),		\
+		.num_workers = (n_workers),				\
+	}
+
+/**
+ * @brief Get the workqueue of a work queue pool.
+ *
+ * The returned workqueue accepts work items and delayed work items like any
+ * other, through k_work_submit_to_queue(), k_delayed_work_submit_to_queue()
+ * and friends.
+ *
+ * @param pool Address of the work queue pool.
+ *
+ * @return Workqueue served by the pool's worker threads.
+ */
+static inline struct k_work_q *k_work_pool_queue(struct k_work_pool *pool)
+{
+	return &pool->work_q;
+}
+
+/**
+ * @brief Start a work queue pool.
+ *
+ * This routine starts all worker threads of @a pool, which run forever.
+ *
+ * With K_WORK_POOL_PIN_CPU in @a options and CONFIG_SCHED_CPU_MASK
+ * enabled, worker @p i only runs on CPU @p i modulo CONFIG_MP_NUM_CPUS.
+ * Otherwise the option is ignored.
+ *
+ * @param pool Address of the work queue pool, defined with
+ *             K_WORK_POOL_DEFINE().
+ * @param prio Priority of the worker threads.
+ * @param options Zero or K_WORK_POOL_PIN_CPU.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_start(struct k_work_pool *pool, int prio,
+			      uint32_t options);
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3739,6 +4080,59 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num messages, stored contiguously at @a data,
+ * to message queue @a msgq. All messages that fit are copied under a single
+ * lock acquisition, and the scheduler runs at most once per call.
+ *
+ * If the queue is full, the routine waits for room for the first message
+ * only, as k_msgq_put() would.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the first message.
+ * @param num Number of messages at @a data.
+ * @param timeout Non-negative waiting period to add the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_n(struct k_msgq *msgq, const void *data,
+			   uint32_t num, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num messages from message queue @a msgq in
+ * a "first in, first out" manner, storing them contiguously at @a data. All
+ * available messages are copied under a single lock acquisition, and the
+ * scheduler runs at most once per call.
+ *
+ * If the queue is empty, the routine waits for one message only, as
+ * k_msgq_get() would.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num received messages.
+ * @param num Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, which may be less than @a num.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num,
+			   k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4031,6 +4425,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4055,6 +4451,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4214,20 +4612,112 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim pipe storage for writing data in place.
+ *
+ * With this routine, memory copying can be avoided since the pipe's buffer
+ * can be written directly by the caller. Once data is written to the
+ * claimed area, the number of bytes written must be confirmed with
+ * k_pipe_put_finish().
+ *
+ * @warning
+ * Only one write claim may be outstanding at a time, and the pipe must not
+ * be written with k_pipe_put() or k_pipe_block_put() until it is finished.
+ *
+ * @note The claimed area is kernel memory, so this routine is not
+ * available to user mode threads.
+ *
+ * @param[in]  pipe Address of the pipe.
+ * @param[out] data Set to the claimed location within the pipe's buffer.
+ * @param[in]  size Requested claim size (in bytes).
+ *
+ * @return Size of the claimed area, which can be smaller than requested if
+ *	   there is not enough free space or the buffer wraps.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Indicate number of bytes written to the claimed pipe storage.
+ *
+ * The written data becomes readable, and is handed to threads waiting in
+ * k_pipe_get() if there are any.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of valid bytes in the claimed area.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed area.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim pipe storage for reading data in place.
+ *
+ * With this routine, memory copying can be avoided since the pipe's buffer
+ * can be read directly by the caller. Once data is consumed, the number of
+ * bytes read must be confirmed with k_pipe_get_finish().
+ *
+ * @warning
+ * Only one read claim may be outstanding at a time, and the pipe must not
+ * be read with k_pipe_get() until it is finished.
+ *
+ * @note The claimed area is kernel memory, so this routine is not
+ * available to user mode threads.
+ *
+ * @param[in]  pipe Address of the pipe.
+ * @param[out] data Set to the claimed location within the pipe's buffer.
+ * @param[in]  size Requested claim size (in bytes).
+ *
+ * @return Size of the claimed area, which can be smaller than requested if
+ *	   there is not enough data or the buffer wraps.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Indicate number of bytes read from the claimed pipe storage.
+ *
+ * The freed space is refilled from threads waiting in k_pipe_put() or
+ * k_pipe_block_put() if there are any.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed from the claimed area.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed area.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+/* Per-CPU magazine of free blocks sitting in front of the slab free list */
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	char *blocks[CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	uint32_t num_blocks;
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* blocks not on free_list, including the ones held in CPU caches */
 	uint32_t num_used;
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	atomic_t cache_waiters;
+	struct z_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
 };
@@ -4352,7 +4842,17 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4367,7 +4867,7 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -4431,6 +4931,31 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+/**
+ * @brief Get k_heap runtime statistics
+ *
+ * Synchronized wrapper around sys_heap_runtime_stats_get().
+ *
+ * @note Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap to query
+ * @param stats Struct into which to store the statistics
+ * @return 0 on success, -EINVAL if a parameter is NULL
+ */
+int k_heap_runtime_stats_get(struct k_heap *h, struct sys_memory_stats *stats);
+
+/**
+ * @brief Reset the k_heap allocation high-water mark
+ *
+ * Synchronized wrapper around sys_heap_runtime_stats_reset_max().
+ *
+ * @note Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap to reset
+ * @return 0 on success, -EINVAL if @a h is NULL
+ */
+int k_heap_runtime_stats_reset_max(struct k_heap *h);
+
 /**
  * @brief Define a static k_heap
  *
@@ -4887,6 +5412,89 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Persistent set of poll events.
+ *
+ * Unlike k_poll(), which registers all its events before waiting and
+ * unregisters them afterwards, a poll set keeps its events registered
+ * between waits and keeps a list of the events that are ready. The cost of
+ * k_poll_set_wait() depends on the number of ready events, not on the size
+ * of the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t returned;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init(), stays registered with its
+ * object until it is removed with k_poll_set_remove(). It must not be passed
+ * to k_poll() or added to another set meanwhile.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove, previously added to @a set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Store the ready events of @a set in @a ready, waiting for at least one if
+ * none is ready yet. The state field of each returned event tells which
+ * condition was met, as with k_poll().
+ *
+ * Events are level triggered: the events returned by the previous call are
+ * checked again first, and are returned again if their condition still
+ * holds. The caller should therefore consume the corresponding objects
+ * before waiting again.
+ *
+ * Only one thread at a time should wait on a given poll set.
+ *
+ * @param set The poll set.
+ * @param ready Array receiving the addresses of the ready events.
+ * @param max_events Size of the @a ready array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, at least 1.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+			   int max_events, k_timeout_t timeout);
+
 /**
  * @internal
  */
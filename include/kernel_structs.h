@@ -128,6 +128,20 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	uint8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_PARKING
+	/* True when the CPU is idle until the load needs it again */
+	uint8_t parked;
+#endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/* thread charged for the cycles elapsed since usage_start */
+	struct k_thread *usage_thread;
+	uint32_t usage_start;
+
+	/* all cycles accounted on this CPU */
+	uint64_t usage_total;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -148,7 +162,12 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* one run queue per CPU, indexed by _cpu.id */
+	struct _ready_q ready_q[CONFIG_MP_NUM_CPUS];
+#else
 	struct _ready_q ready_q;
+#endif
 
 #ifdef CONFIG_FPU_SHARING
 	/*
@@ -191,6 +210,17 @@ bool z_smp_cpu_mobile(void);
 
 #define _timeout_q _kernel.timeout_q
 
+/* Called by the architecture context switch code, with interrupts
+ * locked, right after _current has been updated to the incoming thread.
+ */
+#if defined(CONFIG_TRACING) || defined(CONFIG_THREAD_RUNTIME_STATS)
+void z_thread_mark_switched_in(void);
+#else
+static inline void z_thread_mark_switched_in(void)
+{
+}
+#endif
+
 /* kernel wait queue record */
 
 #ifdef CONFIG_WAITQ_SCALABLE
@@ -175,6 +175,10 @@ extern char __kernel_ram_size[];
 extern char __bss_start[];
 extern char __bss_end[];
 
+/* Objects defined __noinit, which the boot does not clear */
+extern char __noinit_start[];
+extern char __noinit_end[];
+
 /* Used by z_data_copy() or arch-specific implementation */
 #ifdef CONFIG_XIP
 extern char __data_rom_start[];
@@ -323,7 +323,8 @@ static inline char *log_strdup(const char *str)
 
 #define _LOG_MODULE_DYNAMIC_DATA_COND_CREATE(_name)		\
 	IF_ENABLED(CONFIG_LOG_RUNTIME_FILTERING,		\
-		  (_LOG_MODULE_DYNAMIC_DATA_CREATE(_name);))
+		  (_LOG_MODULE_DYNAMIC_DATA_CREATE(_name);	\
+		   Z_LOG_LEVEL_ITEM_REGISTER(_name);))
 
 #define _LOG_MODULE_DATA_CREATE(_name, _level)			\
 	_LOG_MODULE_CONST_DATA_CREATE(_name, _level);		\
@@ -415,6 +416,16 @@ static inline char *log_strdup(const char *str)
 			&LOG_ITEM_DYNAMIC_DATA(GET_ARG_N(1, __VA_ARGS__)) :   \
 			NULL;						      \
 									      \
+	extern struct log_source_level_data				      \
+			LOG_ITEM_LEVEL_DATA(GET_ARG_N(1, __VA_ARGS__));	      \
+									      \
+	static struct log_source_level_data *				      \
+		__log_current_level_data __unused =			      \
+			(_LOG_LEVEL_RESOLVE(__VA_ARGS__) &&		      \
+			IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) ?	      \
+			&LOG_ITEM_LEVEL_DATA(GET_ARG_N(1, __VA_ARGS__)) :     \
+			NULL;						      \
+									      \
 	static const uint32_t __log_level __unused =			      \
 					_LOG_LEVEL_RESOLVE(__VA_ARGS__)
 
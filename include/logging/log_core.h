@@ -129,6 +129,21 @@ extern "C" {
 #define LOG_CURRENT_DYNAMIC_DATA_ADDR()	(__log_level ? \
 	__log_current_dynamic_data : (struct log_source_dynamic_data *)0U)
 
+/**
+ * @def LOG_CURRENT_LEVEL_DATA_ADDR
+ * @brief Macro for getting address of runtime level of current module.
+ */
+#define LOG_CURRENT_LEVEL_DATA_ADDR() (__log_level ? \
+	__log_current_level_data : (struct log_source_level_data *)0U)
+
+/** @brief Macro for getting address of runtime level of an instance.
+ *
+ *  @param _addr Address of the dynamic data of the instance.
+ */
+#define LOG_INSTANCE_LEVEL_DATA_ADDR(_addr) \
+	(&__log_level_data_start[log_dynamic_source_id( \
+		(struct log_source_dynamic_data *)_addr)])
+
 /** @brief Macro for getting ID of the element of the section.
  *
  *  @param _addr Address of the element.
@@ -188,6 +203,9 @@ extern "C" {
 			log_from_user(_src_level, __VA_ARGS__);		 \
 		} else if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {		 \
 			log_string_sync(_src_level, __VA_ARGS__);	 \
+		} else if (IS_ENABLED(CONFIG_LOG2)) {			 \
+			Z_LOG2_INTERNAL_X(Z_LOG_NARGS_POSTFIX(__VA_ARGS__), \
+						_src_level, __VA_ARGS__);\
 		} else {						 \
 			Z_LOG_INTERNAL_X(Z_LOG_NARGS_POSTFIX(__VA_ARGS__), \
 						_src_level, __VA_ARGS__);\
@@ -216,6 +234,55 @@ extern "C" {
 		log_n(_str, args, ARRAY_SIZE(args), _src_level);  \
 	} while (false)
 
+/******************************************************************************/
+/****************** Internal macros for packed log messages *******************/
+/******************************************************************************/
+#ifdef __cplusplus
+#define Z_LOG_STR_ARG_CHECK(_x) 1
+#else
+/**@brief Check at build time if an argument may point to a transient string.
+ *
+ * Only character pointers which are not string literals qualify, the others
+ * are stored as they are. The comma operator makes arrays decay to pointers.
+ */
+#define Z_LOG_STR_ARG_CHECK(_x)						\
+	((__builtin_types_compatible_p(__typeof__(((void)0, (_x))), char *) || \
+	  __builtin_types_compatible_p(__typeof__(((void)0, (_x))),	\
+				       const char *) ||			\
+	  __builtin_types_compatible_p(__typeof__(((void)0, (_x))),	\
+				       unsigned char *) ||		\
+	  __builtin_types_compatible_p(__typeof__(((void)0, (_x))),	\
+				       const unsigned char *)) &&	\
+	 !__builtin_constant_p(_x))
+#endif
+
+#define Z_LOG_STR_ARG_BIT(_idx, _x) | (Z_LOG_STR_ARG_CHECK(_x) ? BIT(_idx) : 0U)
+
+/**@brief Bit mask of the arguments which may point to transient strings.
+ *
+ * Arguments selected here are copied into the message if the format string
+ * uses them as %s and they are not in read only memory.
+ */
+#define Z_LOG_STR_ARGS_MASK(...) \
+	(0U FOR_EACH_IDX(Z_LOG_STR_ARG_BIT, (), __VA_ARGS__))
+
+#define Z_LOG2_INTERNAL_X(N, ...)  UTIL_CAT(_LOG2_INTERNAL_, N)(__VA_ARGS__)
+
+#define _LOG2_INTERNAL_0(_src_level, _str) \
+	log_0(_str, _src_level)
+
+#define _LOG2_INTERNAL_N(_src_level, _str, ...)				\
+	do {								\
+		log_arg_t args[] = {__LOG_ARGUMENTS(__VA_ARGS__)};	\
+		z_log2_n(_str, Z_LOG_STR_ARGS_MASK(__VA_ARGS__), args,	\
+			 ARRAY_SIZE(args), _src_level);			\
+	} while (false)
+
+#define _LOG2_INTERNAL_1 _LOG2_INTERNAL_N
+#define _LOG2_INTERNAL_2 _LOG2_INTERNAL_N
+#define _LOG2_INTERNAL_3 _LOG2_INTERNAL_N
+#define _LOG2_INTERNAL_LONG _LOG2_INTERNAL_N
+
 #define Z_LOG_LEVEL_CHECK(_level, _check_level, _default_level) \
 	(_level <= Z_LOG_RESOLVED_LEVEL(_check_level, _default_level))
 
@@ -296,7 +363,7 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG(_level, ...)			       \
 	__LOG(_level,				       \
 	      (uint16_t)LOG_CURRENT_MODULE_ID(),	       \
-	      LOG_CURRENT_DYNAMIC_DATA_ADDR(),	       \
+	      LOG_CURRENT_LEVEL_DATA_ADDR(),	       \
 	      __VA_ARGS__)
 
 #define Z_LOG_INSTANCE(_level, _inst, ...)		 \
@@ -304,7 +371,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	      IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 	      LOG_DYNAMIC_ID_GET(_inst) :		 \
 	      LOG_CONST_ID_GET(_inst),			 \
-	      _inst,					 \
+	      LOG_INSTANCE_LEVEL_DATA_ADDR(_inst),	 \
 	      __VA_ARGS__)
 
 
@@ -350,7 +417,7 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG_HEXDUMP(_level, _data, _length, _str)	       \
 	__LOG_HEXDUMP(_level,				       \
 		      (uint16_t)LOG_CURRENT_MODULE_ID(),	       \
-		      LOG_CURRENT_DYNAMIC_DATA_ADDR(),	       \
+		      LOG_CURRENT_LEVEL_DATA_ADDR(),	       \
 		      _data, _length, _str)
 
 #define Z_LOG_HEXDUMP_INSTANCE(_level, _inst, _data, _length, _str) \
@@ -358,7 +425,7 @@ static inline char z_log_minimal_level_to_char(int level)
 		      IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?   \
 		      LOG_DYNAMIC_ID_GET(_inst) :		   \
 		      LOG_CONST_ID_GET(_inst),			   \
-		      _inst,					   \
+		      LOG_INSTANCE_LEVEL_DATA_ADDR(_inst),	   \
 		      _data,					   \
 		      _length,					   \
 		      _str)
@@ -404,10 +471,12 @@ static inline char z_log_minimal_level_to_char(int level)
 #define LOG_FILTER_FIRST_BACKEND_SLOT_IDX 1
 
 #ifdef CONFIG_LOG_RUNTIME_FILTERING
+/* _filter is the struct log_source_level_data of the source, one byte
+ * load and compare, before the arguments are evaluated.
+ */
 #define LOG_CHECK_CTX_LVL_FILTER(ctx, _level, _filter) \
 	(ctx || (_level <= LOG_RUNTIME_FILTER(_filter)))
-#define LOG_RUNTIME_FILTER(_filter) \
-	LOG_FILTER_SLOT_GET(&(_filter)->filters, LOG_FILTER_AGGR_SLOT_IDX)
+#define LOG_RUNTIME_FILTER(_filter) ((_filter)->level)
 #else
 #define LOG_CHECK_CTX_LVL_FILTER(ctx, _level, _filter) (true)
 #define LOG_RUNTIME_FILTER(_filter) LOG_LEVEL_DBG
@@ -470,6 +539,7 @@ static inline uint32_t log_sources_count(void)
 
 extern struct log_source_dynamic_data __log_dynamic_start[];
 extern struct log_source_dynamic_data __log_dynamic_end[];
+extern struct log_source_level_data __log_level_data_start[];
 
 /** @brief Creates name of variable and section for runtime log data.
  *
@@ -491,6 +561,17 @@ static inline uint32_t *log_dynamic_filters_get(uint32_t source_id)
 	return &__log_dynamic_start[source_id].filters;
 }
 
+/** @brief Get pointer to the aggregated runtime level of the log source.
+ *
+ * @param source_id Source ID.
+ *
+ * @return Pointer to the level, the maximal level of the backend filters.
+ */
+static inline uint8_t *log_dynamic_level_get(uint32_t source_id)
+{
+	return &__log_level_data_start[source_id].level;
+}
+
 /** @brief Get index of the log source based on the address of the dynamic data
  *         associated with the source.
  *
@@ -566,6 +647,17 @@ void log_n(const char *str,
 	   uint32_t narg,
 	   struct log_msg_ids src_level);
 
+/** @brief Standard log with arguments list, packed message only.
+ *
+ * @param str		String.
+ * @param str_mask	Arguments which may point to transient strings.
+ * @param args		Array with arguments.
+ * @param narg		Number of arguments in the array.
+ * @param src_level	Log identification.
+ */
+void z_log2_n(const char *str, uint32_t str_mask, log_arg_t *args,
+	      uint32_t narg, struct log_msg_ids src_level);
+
 /** @brief Hexdump log.
  *
  * @param str		String.
@@ -715,7 +807,7 @@ __syscall void z_log_hexdump_from_user(uint32_t src_level_val,
 #define Z_LOG_VA(_level, _str, _valist, _argnum, _strdup_action)\
 	__LOG_VA(_level,					\
 		  (uint16_t)LOG_CURRENT_MODULE_ID(),		\
-		  LOG_CURRENT_DYNAMIC_DATA_ADDR(),		\
+		  LOG_CURRENT_LEVEL_DATA_ADDR(),		\
 		  _str, _valist, _argnum, _strdup_action)
 
 #define __LOG_VA(_level, _id, _filter, _str, _valist, _argnum, _strdup_action) \
@@ -37,12 +37,40 @@ struct log_source_dynamic_data {
 #endif
 };
 
+/** @brief Aggregated runtime level of the source of log messages.
+ *
+ * Maximal level of the backend filters, checked by the log calls. Kept
+ * apart from the filters in a section of its own, in the same order as
+ * the dynamic data.
+ */
+struct log_source_level_data {
+	uint8_t level;
+#ifdef CONFIG_NIOS2
+	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
+	 * Nios2 uses global pointer register for structures <=8 bytes and
+	 * apparently does not handle well variables placed in custom sections.
+	 */
+	uint32_t dummy[2];
+#endif
+};
+
 /** @brief Creates name of variable and section for constant log data.
  *
  *  @param _name Name.
  */
 #define LOG_ITEM_CONST_DATA(_name) UTIL_CAT(log_const_, _name)
 
+/** @brief Creates name of variable and section for runtime log level.
+ *
+ *  @param _name Name.
+ */
+#define LOG_ITEM_LEVEL_DATA(_name) UTIL_CAT(log_level_data_, _name)
+
+#define Z_LOG_LEVEL_ITEM_REGISTER(_name)				     \
+	struct log_source_level_data LOG_ITEM_LEVEL_DATA(_name)		     \
+	__attribute__ ((section("." STRINGIFY(LOG_ITEM_LEVEL_DATA(_name))))) \
+	__attribute__((used))
+
 #define Z_LOG_CONST_ITEM_REGISTER(_name, _str_name, _level)		     \
 	const struct log_source_const_data LOG_ITEM_CONST_DATA(_name)	     \
 	__attribute__ ((section("." STRINGIFY(LOG_ITEM_CONST_DATA(_name))))) \
@@ -86,7 +114,9 @@ struct log_source_dynamic_data {
 				LOG_INSTANCE_DYNAMIC_DATA(_module_name,	   \
 						       _inst_name)	   \
 				)					   \
-		))) __attribute__((used))
+		))) __attribute__((used));				   \
+	Z_LOG_LEVEL_ITEM_REGISTER(					   \
+		LOG_INSTANCE_FULL_NAME(_module_name, _inst_name))
 
 #define LOG_INSTANCE_PTR_INIT(_name, _module_name, _inst_name)	   \
 	._name = &LOG_ITEM_DYNAMIC_DATA(			   \
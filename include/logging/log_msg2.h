@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_
+
+#include <logging/log_msg.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Packed log message (v2)
+ * @defgroup log_msg2 Packed log message
+ * @ingroup logger
+ * @{
+ */
+
+/** @brief Descriptor at the start of a packed log message.
+ *
+ * The descriptor is followed by the arguments of a standard message or by
+ * the data of a hexdump message, then by the copies of the transient
+ * strings. Packed messages are only word aligned, so they are accessed with
+ * memcpy().
+ */
+struct log_msg2_desc {
+	atomic_t strings;                   /*!< Number of string copies. */
+	uint32_t timestamp;                 /*!< Timestamp. */
+	struct log_msg_ids ids;             /*!< Source and level. */
+	union log_msg_hdr_params params;    /*!< Type and length. */
+	const char *str;                    /*!< Format string or metadata. */
+};
+
+/** @brief Initialize the buffer of packed log messages. */
+void z_log_msg2_init(void);
+
+/** @brief Pack a standard log message.
+ *
+ * Can be called from any context, no lock is taken.
+ *
+ * @param ids       Source and level.
+ * @param timestamp Timestamp.
+ * @param str       Format string.
+ * @param args      Arguments.
+ * @param nargs     Number of arguments.
+ * @param copy_mask Bit mask of the string arguments copied into the
+ *                  message, truncated to CONFIG_LOG_STRDUP_MAX_STRING
+ *                  characters.
+ *
+ * @return 0 on success, -ENOMEM if the buffer is full.
+ */
+int z_log_msg2_std_put(struct log_msg_ids ids, uint32_t timestamp,
+		       const char *str, const log_arg_t *args, uint32_t nargs,
+		       uint32_t copy_mask);
+
+/** @brief Pack a hexdump log message.
+ *
+ * @param ids       Source and level.
+ * @param timestamp Timestamp.
+ * @param str       Metadata string.
+ * @param data      Data. Longer data is truncated to
+ *                  @ref LOG_MSG_HEXDUMP_MAX_LENGTH bytes.
+ * @param length    Data length.
+ * @param copy_str  True to copy the metadata string into the message.
+ *
+ * @return 0 on success, -ENOMEM if the buffer is full.
+ */
+int z_log_msg2_hexdump_put(struct log_msg_ids ids, uint32_t timestamp,
+			   const char *str, const uint8_t *data,
+			   uint32_t length, bool copy_str);
+
+/** @brief Unpack the oldest packed message.
+ *
+ * The message is returned as a standard @ref log_msg, so that it can be
+ * passed to the backends. The packed message is removed from the buffer,
+ * unless the unpacked one refers to string copies. It is removed once they
+ * are all freed with z_log_msg2_str_free() in that case.
+ *
+ * @return Message, NULL if there is none or if it could not be unpacked.
+ */
+struct log_msg *z_log_msg2_get(void);
+
+/** @brief Check if packed messages are pending.
+ *
+ * @return True if some messages are pending.
+ */
+bool z_log_msg2_pending(void);
+
+/** @brief Check if a string is a copy held in a packed message.
+ *
+ * @param buf String.
+ *
+ * @return True if @p buf is in the buffer of packed messages.
+ */
+bool z_log_msg2_is_str(const void *buf);
+
+/** @brief Release a string copy held in a packed message.
+ *
+ * Can be called from any context.
+ *
+ * @param buf String for which z_log_msg2_is_str() returned true.
+ */
+void z_log_msg2_str_free(const void *buf);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_ */
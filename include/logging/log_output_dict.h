@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_
+
+#include <logging/log_output.h>
+#include <logging/log_msg.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Dictionary based log output
+ * @defgroup log_output_dict Dictionary based log output
+ * @ingroup logger
+ * @{
+ *
+ * Messages are output as binary records instead of text. Format strings are
+ * identified by their address, which the host decoder
+ * (scripts/logging/log_dict_decode.py) resolves with the ELF file of the
+ * application. Records are in the byte order of the target.
+ */
+
+/** @brief Standard message, followed by the arguments (one log_arg_t each)
+ * and by the NUL terminated value of every %s argument, in order.
+ */
+#define LOG_DICT_MSG_STD 0U
+
+/** @brief Hexdump message, followed by the data. */
+#define LOG_DICT_MSG_HEXDUMP 1U
+
+/** @brief Dropped messages notification, @ref log_dict_msg_hdr.length
+ * holds the number of dropped messages.
+ */
+#define LOG_DICT_MSG_DROPPED 2U
+
+/** @brief Header of a dictionary log record. */
+struct log_dict_msg_hdr {
+	uint8_t type;           /*!< Record type, LOG_DICT_MSG_*. */
+	uint8_t level;          /*!< Level, domain ID in bits 3 to 5. */
+	uint16_t source_id;     /*!< Source ID. */
+	uint32_t timestamp;     /*!< Timestamp. */
+	uint16_t length;        /*!< Number of arguments or data length. */
+	uintptr_t fmt;          /*!< Address of the format string. */
+} __packed;
+
+/** @brief Process log message in the dictionary format.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param msg Log message.
+ * @param flags Optional flags.
+ */
+void log_output_msg_dict_process(const struct log_output *log_output,
+				 struct log_msg *msg, uint32_t flags);
+
+/** @brief Output dropped messages notification in the dictionary format.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param cnt Number of dropped messages.
+ */
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     uint32_t cnt);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_ */
@@ -989,6 +989,69 @@ extern const struct net_buf_data_cb net_buf_var_cb;
 		NET_BUF_POOL_INITIALIZER(_name, &net_buf_data_alloc_##_name,  \
 					 _net_buf_##_name, _count, _destroy)
 
+/** Bytes used for bookkeeping at the start of each slab data block */
+#define NET_BUF_SLAB_HDR_SIZE 2
+
+struct net_buf_pool_slab {
+	/** Data size of the buffers allocated with net_buf_alloc_fixed() */
+	size_t data_size;
+	/** Memory slabs of the size classes, smallest blocks first */
+	struct k_mem_slab * const *slabs;
+	/** Number of size classes */
+	uint8_t slab_count;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct net_buf_data_cb net_buf_slab_cb;
+/** @endcond */
+
+/**
+ * @def NET_BUF_POOL_SLAB_DEFINE
+ * @brief Define a new pool for buffers with data from size classes
+ *
+ * Defines a net_buf_pool struct and the necessary memory storage (array of
+ * structs) for the needed amount of buffers. After this, the buffers can be
+ * accessed from the pool through net_buf_alloc. The pool is defined as a
+ * static variable, so if it needs to be exported outside the current module
+ * this needs to happen with the help of a separate pointer rather than an
+ * extern declaration.
+ *
+ * The data payload of the buffers will be allocated from the memory slab
+ * with the smallest blocks that can hold the requested size. If that slab
+ * is exhausted, the next larger one is tried, and the allocation only
+ * waits for a block of the best fitting size. Each block holds
+ * NET_BUF_SLAB_HDR_SIZE bytes of bookkeeping before the data, so a slab
+ * for 256 byte payloads needs blocks of NET_BUF_SLAB_HDR_SIZE + 256 bytes.
+ * Requests larger than the largest block fail.
+ *
+ * If provided with a custom destroy callback, this callback is
+ * responsible for eventually calling net_buf_destroy() to complete the
+ * process of returning the buffer to the pool.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _data_size Data size of the buffers allocated with
+ *                   net_buf_alloc_fixed().
+ * @param _slabs     Array of pointers to the memory slabs, sorted by
+ *                   increasing block size.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_SLAB_DEFINE(_name, _count, _data_size, _slabs, _destroy) \
+	static struct net_buf _net_buf_##_name[_count] __noinit;              \
+	static const struct net_buf_pool_slab net_buf_slab_##_name = {        \
+		.data_size = _data_size,                                      \
+		.slabs = _slabs,                                              \
+		.slab_count = ARRAY_SIZE(_slabs),                             \
+	};                                                                    \
+	static const struct net_buf_data_alloc net_buf_data_alloc_##_name = { \
+		.cb = &net_buf_slab_cb,                                       \
+		.alloc_data = (void *)&net_buf_slab_##_name,                  \
+	};                                                                    \
+	static struct net_buf_pool _name __net_buf_align                      \
+			__in_section(_net_buf_pool, static, _name) =          \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_data_alloc_##_name,  \
+					 _net_buf_##_name, _count, _destroy)
+
 /**
  * @def NET_BUF_POOL_DEFINE
  * @brief Define a new pool for buffers
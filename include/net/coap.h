@@ -204,6 +204,13 @@ struct coap_observer {
 /**
  * @brief Representation of a CoAP Packet.
  */
+#if defined(CONFIG_COAP_OPTION_INDEX)
+struct coap_option_index {
+	uint16_t code; /* Option number */
+	uint16_t offset; /* Offset of the first option with this number */
+};
+#endif
+
 struct coap_packet {
 	uint8_t *data; /* User allocated buffer */
 	uint16_t offset; /* CoAP lib maintains offset while adding data */
@@ -211,6 +218,24 @@ struct coap_packet {
 	uint8_t hdr_len; /* CoAP header length */
 	uint16_t opt_len; /* Total options length (delta + len + value) */
 	uint16_t delta; /* Used for delta calculation in CoAP packet */
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	/* Options of a parsed packet, in ascending order */
+	struct coap_option_index opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+	uint8_t opt_index_len; /* Number of used index entries */
+	bool opt_indexed; /* Index is valid */
+#endif
+};
+
+/**
+ * @brief Iterator over the options of a CoAP packet
+ *
+ * Initialize with coap_option_iter_init(), see coap_option_iter_next().
+ */
+struct coap_option_iter {
+	const struct coap_packet *cpkt;
+	uint16_t offset;
+	uint16_t delta;
+	uint16_t opt_len;
 };
 
 struct coap_option {
@@ -382,6 +407,32 @@ uint16_t coap_next_id(void);
 int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		      struct coap_option *options, uint16_t veclen);
 
+/**
+ * @brief Prepare to walk through the options of a CoAP packet
+ *
+ * @param iter Iterator to initialize
+ * @param cpkt Packet to walk through, parsed or being built
+ */
+void coap_option_iter_init(struct coap_option_iter *iter,
+			   const struct coap_packet *cpkt);
+
+/**
+ * @brief Get the next option of a CoAP packet
+ *
+ * The options are returned in the order of the packet, without copying
+ * their values, which stay valid as long as the packet data does.
+ *
+ * @param iter Iterator initialized by coap_option_iter_init()
+ * @param code Number of the option
+ * @param value Pointer to the value of the option in the packet
+ * @param len Length of the value
+ *
+ * @return 1 if an option was returned, 0 when there are no more
+ * options, or -EINVAL if the packet is malformed.
+ */
+int coap_option_iter_next(struct coap_option_iter *iter, uint16_t *code,
+			  const uint8_t **value, uint16_t *len);
+
 /**
  * @brief Appends an option to the packet.
  *
@@ -468,6 +519,60 @@ int coap_handle_request(struct coap_packet *cpkt,
 			uint8_t opt_num,
 			struct sockaddr *addr, socklen_t addr_len);
 
+/** Unused entry of a CoAP router table */
+#define COAP_ROUTER_EMPTY UINT16_MAX
+
+/**
+ * @brief Hash table to find the resource matching a request by its path.
+ */
+struct coap_router {
+	struct coap_resource *resources;
+	uint16_t *table; /* Indexes of the resources, by path hash */
+	uint16_t table_len;
+	bool wildcards; /* Some resource paths have wildcards */
+};
+
+/**
+ * @brief Index an array of resources by their paths.
+ *
+ * Resources whose path contains a wildcard are not indexed, they are
+ * matched in order as with coap_handle_request().
+ *
+ * @param router Router to initialize
+ * @param resources Array of resources, terminated by an empty entry
+ * @param table Storage for the table, at least one entry more than the
+ * number of resources, twice as many keeps the lookups short.
+ * @param table_len Number of entries in the table
+ *
+ * @return 0 in case of success, -ENOMEM if the table is too small,
+ * -EINVAL if no table is given.
+ */
+int coap_router_init(struct coap_router *router,
+		     struct coap_resource *resources,
+		     uint16_t *table, uint16_t table_len);
+
+/**
+ * @brief When a request is received, call the appropriate methods of
+ * the resource found by the router.
+ *
+ * Same as coap_handle_request(), with the resource looked up in the
+ * router table instead of compared with every resource in turn.
+ *
+ * @param router Router initialized by coap_router_init()
+ * @param cpkt Packet received
+ * @param options Parsed options from coap_packet_parse()
+ * @param opt_num Number of options
+ * @param addr Peer address
+ * @param addr_len Peer address length
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_router_handle_request(struct coap_router *router,
+			       struct coap_packet *cpkt,
+			       struct coap_option *options,
+			       uint8_t opt_num,
+			       struct sockaddr *addr, socklen_t addr_len);
+
 /**
  * Represents the size of each block that will be transferred using
  * block-wise transfers [RFC7959]:
@@ -216,6 +216,12 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** Query sent for the same name and type that this one is
+		 * waiting for, or NULL if this query was sent to the servers.
+		 * The results of that query are passed to this one too.
+		 */
+		struct dns_pending_query *leader;
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -305,6 +311,10 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
  * We might send the query to multiple servers (if there are more than one
  * server configured), but we only use the result of the first received
  * response.
+ * If the same name and type are already being resolved, no new query is
+ * sent and the results of the pending one are passed to the callback too.
+ * If CONFIG_DNS_RESOLVER_CACHE is enabled and the name is cached, the
+ * callback is called before this function returns.
  *
  * @param ctx DNS context
  * @param query What the caller wants to resolve.
@@ -399,6 +409,55 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_resolve_cache_cb_t
+ * @brief Callback used while iterating over the DNS cache.
+ *
+ * @param query Cached name
+ * @param type Query type of the cached name
+ * @param status DNS_EAI_ALLDONE if the name was resolved, DNS_EAI_NODATA
+ * if the name does not exist or has no address of the given type.
+ * @param addrs Cached addresses
+ * @param count Number of cached addresses
+ * @param ttl Seconds left until the entry expires
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*dns_resolve_cache_cb_t)(const char *query,
+				       enum dns_query_type type,
+				       enum dns_resolve_status status,
+				       const struct dns_addrinfo *addrs,
+				       int count, uint32_t ttl,
+				       void *user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Go through all the entries of the DNS cache.
+ *
+ * @param cb User-supplied callback function to call
+ * @param user_data User specified data
+ */
+void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove all the entries from the DNS cache.
+ *
+ * @details This can be used e.g., when the network configuration
+ * changes and the cached addresses might not be valid any more.
+ */
+void dns_resolve_cache_flush(void);
+#else
+static inline void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb,
+					     void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+}
+
+static inline void dns_resolve_cache_flush(void)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
@@ -130,6 +130,17 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload. The driver splits TCP packets larger
+	 * than the MTU into segments of net_pkt_tso_size() payload bytes.
+	 */
+	ETHERNET_HW_TSO			= BIT(15),
+
+	/** Multiple RX and TX rings. The driver sets the flow hash of
+	 * received packets and picks the TX ring of a packet from its flow
+	 * hash, see net_eth_queue_select().
+	 */
+	ETHERNET_HW_MULTI_QUEUE		= BIT(16),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -267,6 +278,15 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_IF_TX_BATCH)
+	/** Optional. Send several network packets, starting the transfer
+	 * once for all of them. Returns how many packets from the start of
+	 * the array were sent; the stack retries the rest with send().
+	 */
+	int (*send_batch)(const struct device *dev, struct net_pkt **pkts,
+			  int count);
+#endif
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -733,6 +753,24 @@ static inline int net_eth_get_ptp_port(struct net_if *iface)
 void net_eth_set_ptp_port(struct net_if *iface, int port);
 #endif /* CONFIG_NET_GPTP */
 
+/**
+ * @brief Select the hardware queue of a network packet.
+ *
+ * Used by drivers with several TX (or RX) rings so that all the packets
+ * of a flow go through the same ring and stay in order, while different
+ * flows are spread across the rings. Packets without a flow hash, which
+ * is always the case without CONFIG_NET_FLOW_STEERING, use ring 0.
+ *
+ * @param pkt Network packet
+ * @param count Number of rings, must be at least 1.
+ *
+ * @return Ring index between 0 and count - 1
+ */
+static inline int net_eth_queue_select(struct net_pkt *pkt, int count)
+{
+	return (int)(((uint64_t)net_pkt_flow_hash(pkt) * count) >> 32);
+}
+
 /**
  * @}
  */
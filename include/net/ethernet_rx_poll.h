@@ -0,0 +1,125 @@
+/** @file
+ * @brief Polled receive support for Ethernet drivers.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_ETHERNET_RX_POLL_H_
+#define ZEPHYR_INCLUDE_NET_ETHERNET_RX_POLL_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Polled receive for Ethernet drivers
+ * @defgroup eth_rx_poll Ethernet polled receive
+ * @ingroup ethernet
+ * @{
+ *
+ * Instead of handling every received frame from its interrupt, a driver
+ * masks the RX interrupt and calls net_eth_rx_poll_schedule(). Its poll
+ * callback then runs in the Ethernet RX poll thread and receives up to
+ * CONFIG_NET_ETHERNET_RX_POLL_BUDGET frames, handing each one over with
+ * net_eth_rx_poll_receive(). The frames of one poll are passed to the
+ * IP stack together. While the poll callback uses up its whole budget
+ * it is called again, after the other pending polls had their turn. Once
+ * it receives fewer frames the ring is empty, and the complete callback
+ * is called so that the driver unmasks the RX interrupt.
+ *
+ * The hardware must latch RX events while the interrupt is masked, so
+ * that a frame received between the last poll and the unmasking raises
+ * the interrupt once it is unmasked.
+ */
+
+struct net_eth_rx_poll;
+
+/**
+ * @typedef net_eth_rx_poll_cb_t
+ * @brief Receive up to @a budget frames.
+ *
+ * @param poll Polled receive context of the driver
+ * @param budget Maximum number of frames to receive
+ *
+ * @return Number of frames taken from the ring, including the dropped
+ * ones. Less than @a budget if the ring is empty.
+ */
+typedef int (*net_eth_rx_poll_cb_t)(struct net_eth_rx_poll *poll,
+				    int budget);
+
+/**
+ * @typedef net_eth_rx_poll_complete_cb_t
+ * @brief Called from the poll thread when the ring was found empty.
+ *
+ * The driver unmasks its RX interrupt here.
+ *
+ * @param poll Polled receive context of the driver
+ */
+typedef void (*net_eth_rx_poll_complete_cb_t)(struct net_eth_rx_poll *poll);
+
+/**
+ * @brief Polled receive context, one per RX ring.
+ *
+ * Embedded in the driver data. The fields are private.
+ */
+struct net_eth_rx_poll {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	net_eth_rx_poll_cb_t poll;
+	net_eth_rx_poll_complete_cb_t complete;
+	struct net_pkt *batch[CONFIG_NET_ETHERNET_RX_POLL_BUDGET];
+	int count;
+	atomic_t scheduled;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a polled receive context.
+ *
+ * @param poll Polled receive context
+ * @param poll_cb Function receiving the frames
+ * @param complete_cb Function unmasking the RX interrupt
+ */
+void net_eth_rx_poll_init(struct net_eth_rx_poll *poll,
+			  net_eth_rx_poll_cb_t poll_cb,
+			  net_eth_rx_poll_complete_cb_t complete_cb);
+
+/**
+ * @brief Schedule a poll of the RX ring.
+ *
+ * Called from the RX interrupt handler after masking the RX interrupt.
+ * Does nothing if a poll is already scheduled or running.
+ *
+ * @param poll Polled receive context
+ */
+void net_eth_rx_poll_schedule(struct net_eth_rx_poll *poll);
+
+/**
+ * @brief Hand over a received frame.
+ *
+ * Only called from the poll callback. The frame is passed to the network
+ * interface returned by net_pkt_iface() once the poll callback returns.
+ *
+ * @param poll Polled receive context
+ * @param pkt Received frame
+ */
+void net_eth_rx_poll_receive(struct net_eth_rx_poll *poll,
+			     struct net_pkt *pkt);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_ETHERNET_RX_POLL_H_ */
@@ -285,6 +285,80 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    int32_t timeout, void *user_data);
 
+/**
+ * @typedef http_client_connect_cb_t
+ * @brief Callback used by the connection pool to connect to a server.
+ *
+ * @param host Hostname of the request.
+ * @param port Port of the request, an empty string if the request did
+ *        not have any.
+ * @param user_data User specified data specified in http_client_pool_init()
+ *
+ * @return Connected socket (after the TLS handshake if any), or a negative
+ *         error code.
+ */
+typedef int (*http_client_connect_cb_t)(const char *host, const char *port,
+					void *user_data);
+
+/**
+ * @brief Initialize the HTTP client connection pool.
+ *
+ * The pool keeps the connections open after the requests, to reuse them
+ * for the next requests to the same host and port. Idle connections
+ * that are open are closed.
+ *
+ * @param connect_cb Callback used to open a new connection.
+ * @param user_data User specified data that is passed to the callback.
+ */
+void http_client_pool_init(http_client_connect_cb_t connect_cb,
+			   void *user_data);
+
+/**
+ * @brief Do a HTTP request on a connection of the pool.
+ *
+ * Like http_client_req(), but the connection to req->host and req->port
+ * is taken from the pool, or opened if there is none. The connection is
+ * kept in the pool after the response unless the server closes it. The
+ * request should use the HTTP/1.1 protocol, where connections persist by
+ * default. Idempotent requests are sent again once on a new connection if
+ * the server closed the kept one.
+ *
+ * The response callback of the request is called as the body is received,
+ * so the receive buffer does not need to hold the whole body.
+ *
+ * @param req HTTP request information
+ * @param timeout Max timeout to wait for the data, in milliseconds.
+ * @param user_data User specified data that is passed to the callback.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_pool_req(struct http_request *req, int32_t timeout,
+			 void *user_data);
+
+/**
+ * @brief Do pipelined HTTP requests on a connection of the pool.
+ *
+ * All the requests are sent to the server before their responses are
+ * received, in order. The requests shall use the same host and port.
+ * The server might answer a pipelined request only once it is done with
+ * the previous ones, so only idempotent requests should be pipelined.
+ *
+ * @param reqs HTTP requests
+ * @param count Number of requests
+ * @param timeout Max timeout to wait for the data of each response,
+ *        in milliseconds.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_pool_pipeline(struct http_request *reqs[], size_t count,
+			      int32_t timeout, void *user_data);
+
+/**
+ * @brief Close the idle connections of the pool.
+ */
+void http_client_pool_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
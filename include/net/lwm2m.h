@@ -902,5 +902,16 @@ void lwm2m_rd_client_start(struct lwm2m_ctx *client_ctx, const char *ep_name,
 void lwm2m_rd_client_stop(struct lwm2m_ctx *client_ctx,
 			  lwm2m_ctx_event_cb_t event_cb);
 
+/**
+ * @brief Trigger a Registration Update of the LwM2M RD Client
+ *
+ * In queue mode, notifications held while the client was offline
+ * (CONFIG_LWM2M_QUEUE_MODE_HOLD_NOTIFY) are sent together once the
+ * update has been sent. Applications can call this function when the
+ * link comes up for another reason, like the modem leaving its power
+ * saving mode, so that the notifications use the same radio wakeup.
+ */
+void lwm2m_rd_client_update(void);
+
 #endif	/* ZEPHYR_INCLUDE_NET_LWM2M_H_ */
 /**@}  */
@@ -257,6 +257,23 @@ struct mqtt_publish_param {
 	uint8_t retain_flag : 1;
 };
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+/** @brief Outstanding QoS 1 or QoS 2 publish message. */
+struct mqtt_inflight {
+	/** Publish parameters, message id 0 marks a free entry. */
+	struct mqtt_publish_param param;
+
+	/** Payload buffers, owned by the application. */
+	struct iovec payload[CONFIG_MQTT_PUBLISH_IOV_MAX];
+
+	/** Number of payload buffers. */
+	uint8_t payload_count;
+
+	/** PUBREC was received for a QoS 2 message, PUBCOMP is awaited. */
+	uint8_t released : 1;
+};
+#endif
+
 /** @brief List of topics in a subscription request. */
 struct mqtt_subscription_list {
 	/** Array containing topics along with QoS for each. */
@@ -450,6 +467,11 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/** Internal. Published messages waiting for their acknowledgment. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_INFLIGHT_WINDOW];
+#endif
 };
 
 /**
@@ -584,11 +606,45 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note With @option{CONFIG_MQTT_INFLIGHT}, QoS 1 and QoS 2 messages are
+ *       kept in the inflight window of the client until they are
+ *       acknowledged, and sent again when the client reconnects. The topic
+ *       and the payload shall then stay valid until the MQTT_EVT_PUBACK or
+ *       MQTT_EVT_PUBCOMP event of the message. Several messages can be
+ *       published without waiting for their acknowledgments, -EBUSY is
+ *       returned when the window is full.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish a message whose payload is split in several buffers.
+ *
+ * The payload buffers are sent in order, as they are, without being copied
+ * to the TX buffer of the client. Only the MQTT headers are encoded in the
+ * TX buffer. The buffers shall stay valid until the function returns.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  The payload of the message is ignored.
+ *                  Shall not be NULL.
+ * @param[in] payload Buffers holding the payload of the message.
+ * @param[in] payload_count Number of payload buffers, at most
+ *                          @option{CONFIG_MQTT_PUBLISH_IOV_MAX}.
+ *
+ * @note QoS 1 and QoS 2 messages are tracked as with mqtt_publish(), the
+ *       payload buffers shall then stay valid until the message is
+ *       acknowledged.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_iov(struct mqtt_client *client,
+		     const struct mqtt_publish_param *param,
+		     const struct iovec *payload, size_t payload_count);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -64,6 +64,9 @@ enum net_context_state {
 /** Is the socket closing / closed */
 #define NET_CONTEXT_CLOSING_SOCK  BIT(10)
 
+/** UDP checksums are verified by the socket when reading the data */
+#define NET_CONTEXT_CHKSUM_DEFER  BIT(11)
+
 struct net_context;
 
 /**
@@ -286,6 +289,11 @@ __net_socket struct net_context {
 	int can_filter_id;
 #endif /* CONFIG_NET_SOCKETS_CAN */
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	/** Receive ring of a packet socket */
+	void *packet_ring;
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 	/** Option values */
 	struct {
 #if defined(CONFIG_NET_CONTEXT_PRIORITY)
@@ -398,6 +406,43 @@ static inline void net_context_set_closing(struct net_context *context,
 	}
 }
 
+/**
+ * @brief Does the user of this context verify UDP checksums.
+ *
+ * @param context Network context.
+ *
+ * @return True if the checksum of received UDP packets is left to the
+ *         reader of the context, False otherwise.
+ */
+static inline bool net_context_is_chksum_deferred(struct net_context *context)
+{
+	NET_ASSERT(context);
+
+	return context->flags & NET_CONTEXT_CHKSUM_DEFER;
+}
+
+/**
+ * @brief Leave the UDP checksum verification to the user of this context.
+ *
+ * @details Only has an effect with CONFIG_NET_CHKSUM_COPY. The receiver
+ *          must then check net_pkt_is_chksum_pending() on the packets and
+ *          verify them before using the data.
+ *
+ * @param context Network context.
+ * @param defer True to defer the verification, False if not
+ */
+static inline void net_context_set_chksum_deferred(struct net_context *context,
+						   bool defer)
+{
+	NET_ASSERT(context);
+
+	if (defer) {
+		context->flags |= NET_CONTEXT_CHKSUM_DEFER;
+	} else {
+		context->flags &= ~NET_CONTEXT_CHKSUM_DEFER;
+	}
+}
+
 #define NET_CONTEXT_STATE_SHIFT 1
 #define NET_CONTEXT_STATE_MASK 0x03
 
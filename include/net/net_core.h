@@ -112,6 +112,22 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when several network packets
+ * have been received. Each packet is pushed up in the network stack on
+ * its own interface, as returned by net_pkt_iface().
+ *
+ * Packets going to the same RX queue are queued in one operation. The
+ * packets that cannot be accepted are released.
+ *
+ * @param pkts Array of received network packets. Its content is changed
+ *             by the call.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets passed to the network stack.
+ */
+int net_recv_data_batch(struct net_pkt **pkts, int count);
+
 /**
  * @brief Send data to network.
  *
@@ -144,6 +160,12 @@ int net_send_data(struct net_pkt *pkt);
 #define NET_TC_COUNT 1
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+#if defined(CONFIG_NET_TC_FLOW_QUEUES)
+#define NET_TC_FLOW_QUEUES CONFIG_NET_TC_FLOW_QUEUES
+#else
+#define NET_TC_FLOW_QUEUES 1
+#endif
+
 /* @endcond */
 
 /**
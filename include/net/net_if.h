@@ -441,6 +441,25 @@ struct net_if_dev {
 #endif /* CONFIG_NET_SOCKETS_OFFLOAD */
 };
 
+#if defined(CONFIG_NET_IF_TX_BATCH)
+/**
+ * @brief Queue of the packets waiting to be sent over an interface
+ *
+ * Packets are pushed on the head without locking, and the TX thread
+ * takes all of them at once and sends them in batches.
+ */
+struct net_if_tx_queue {
+	/** Work item sending the queued packets */
+	struct k_work work;
+
+	/** Most recently queued packet work, linked to the older ones */
+	atomic_ptr_t head;
+
+	/** Network interface the queue belongs to */
+	struct net_if *iface;
+};
+#endif /* CONFIG_NET_IF_TX_BATCH */
+
 /**
  * @brief Network Interface structure
  *
@@ -467,6 +486,11 @@ struct net_if {
 	 */
 	int tx_pending;
 #endif
+
+#if defined(CONFIG_NET_IF_TX_BATCH)
+	/** Packets waiting to be sent, one queue per traffic class */
+	struct net_if_tx_queue tx_queue[NET_TC_TX_COUNT];
+#endif
 };
 
 /**
@@ -234,6 +234,11 @@ struct msghdr {
 	int           msg_flags;      /* flags on received message */
 };
 
+struct mmsghdr {
+	struct msghdr msg_hdr;        /* message header */
+	unsigned int  msg_len;        /* number of bytes transferred */
+};
+
 struct cmsghdr {
 	socklen_t cmsg_len;    /* Number of bytes, including header */
 	int       cmsg_level;  /* Originating protocol */
@@ -1437,6 +1442,82 @@ static inline bool net_tcp_seq_greater(uint32_t seq1, uint32_t seq2)
 	return net_tcp_seq_cmp(seq1, seq2) > 0;
 }
 
+/**
+ * @brief Update an Internet checksum after a 16-bit field changed.
+ *
+ * @details Incremental update from RFC 1624, so that a rewritten header
+ *          field does not require the checksum of the whole packet to be
+ *          computed again. The values are used as they are stored in the
+ *          packet, in network byte order.
+ *
+ * @param chksum Checksum field of the packet
+ * @param old_val Previous value of the field
+ * @param new_val New value of the field
+ *
+ * @return Updated checksum field. A UDP checksum of 0 must be sent as
+ *         0xffff by the caller.
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m') */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val +
+		(uint32_t)new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a 32-bit field changed.
+ *
+ * @details Same as net_chksum_update16(), for example for an IPv4 address.
+ *
+ * @param chksum Checksum field of the packet
+ * @param old_val Previous value of the field
+ * @param new_val New value of the field
+ *
+ * @return Updated checksum field
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update16(chksum, old_val & 0xffff,
+				   new_val & 0xffff);
+}
+
+/**
+ * @brief Update an Internet checksum after a field of any size changed.
+ *
+ * @details Same as net_chksum_update16(), for example for an IPv6 address.
+ *          The field must be of even length and start at an even offset of
+ *          the checksummed data.
+ *
+ * @param chksum Checksum field of the packet
+ * @param old_val Previous value of the field
+ * @param new_val New value of the field
+ * @param len Length of the field in bytes
+ *
+ * @return Updated checksum field
+ */
+static inline uint16_t net_chksum_update(uint16_t chksum, const void *old_val,
+					 const void *new_val, size_t len)
+{
+	const uint16_t *old16 = (const uint16_t *)old_val;
+	const uint16_t *new16 = (const uint16_t *)new_val;
+
+	for (; len >= 2; len -= 2) {
+		chksum = net_chksum_update16(chksum, UNALIGNED_GET(old16++),
+					     UNALIGNED_GET(new16++));
+	}
+
+	return chksum;
+}
+
 /**
  * @brief Convert a string of hex values to array of bytes.
  *
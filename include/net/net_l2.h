@@ -64,6 +64,14 @@ struct net_l2 {
 	 */
 	int (*send)(struct net_if *iface, struct net_pkt *pkt);
 
+	/**
+	 * Optional, used by net core to push several packets to the L2 at
+	 * once. status[i] is set to what send() would have returned for
+	 * pkts[i].
+	 */
+	void (*send_batch)(struct net_if *iface, struct net_pkt **pkts,
+			   int *status, int count);
+
 	/**
 	 * This function is used to enable/disable traffic over a network
 	 * interface. The function returns <0 if error and >=0 if no error.
@@ -126,10 +134,16 @@ NET_L2_DECLARE_PUBLIC(CANBUS_L2);
 #endif /* CONFIG_NET_L2_CANBUS */
 
 #define NET_L2_INIT(_name, _recv_fn, _send_fn, _enable_fn, _get_flags_fn) \
+	NET_L2_INIT_BATCH(_name, _recv_fn, _send_fn, NULL, _enable_fn,	\
+			  _get_flags_fn)
+
+#define NET_L2_INIT_BATCH(_name, _recv_fn, _send_fn, _send_batch_fn,	\
+			  _enable_fn, _get_flags_fn)			\
 	const Z_STRUCT_SECTION_ITERABLE(net_l2,				\
 					NET_L2_GET_NAME(_name)) = {	\
 		.recv = (_recv_fn),					\
 		.send = (_send_fn),					\
+		.send_batch = (_send_batch_fn),				\
 		.enable = (_enable_fn),					\
 		.get_flags = (_get_flags_fn),				\
 	}
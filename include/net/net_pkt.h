@@ -53,6 +53,14 @@ struct net_pkt_cursor {
 	uint8_t *pos;
 };
 
+/* Partial Internet checksum of data copied into or out of a net_pkt */
+struct net_pkt_csum {
+	/** One's complement sum of the data, in network byte order */
+	uint16_t sum;
+	/** Amount of data summed */
+	size_t len;
+};
+
 /**
  * @brief Network packet.
  *
@@ -190,6 +198,13 @@ struct net_pkt {
 					*/
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	uint8_t ipv4_reassembled  : 1; /* Is this pkt reassembled from IPv4
+					* fragments, in which case it has no
+					* link layer header.
+					*/
+#endif
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -239,6 +254,32 @@ struct net_pkt {
 	uint8_t ipv6_next_hdr;	/* What is the very first next header */
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_TCP_TSO)
+	/* TCP payload size of each segment the driver should produce when
+	 * segmenting this packet, or 0 if the packet is not to be segmented.
+	 */
+	uint16_t tso_size;
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_FLOW_STEERING)
+	/* Hash of the flow this packet belongs to, either given by the
+	 * driver or computed by the stack. Zero means not yet known.
+	 */
+	uint32_t flow_hash;
+#endif /* CONFIG_NET_FLOW_STEERING */
+
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	/* Sum of the last payload_csum.len bytes of the packet, computed
+	 * while the payload was copied.
+	 */
+	struct net_pkt_csum payload_csum;
+
+	uint8_t chksum_pending : 1; /* Received UDP checksum not yet verified,
+				     * this is done when the payload is
+				     * copied to the application.
+				     */
+#endif /* CONFIG_NET_CHKSUM_COPY */
+
 #if defined(CONFIG_IEEE802154)
 	uint8_t ieee802154_rssi; /* Received Signal Strength Indication */
 	uint8_t ieee802154_lqi;  /* Link Quality Indicator */
@@ -462,6 +503,33 @@ static inline void net_pkt_set_ipv4_opts_len(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline bool net_pkt_ipv4_reassembled(struct net_pkt *pkt)
+{
+	return !!(pkt->ipv4_reassembled);
+}
+
+static inline void net_pkt_set_ipv4_reassembled(struct net_pkt *pkt,
+						bool reassembled)
+{
+	pkt->ipv4_reassembled = reassembled;
+}
+#else
+static inline bool net_pkt_ipv4_reassembled(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_ipv4_reassembled(struct net_pkt *pkt,
+						bool reassembled)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(reassembled);
+}
+#endif
+
 #if defined(CONFIG_NET_IPV6)
 static inline uint8_t net_pkt_ipv6_ext_opt_len(struct net_pkt *pkt)
 {
@@ -823,6 +891,112 @@ static inline void net_pkt_set_txtime(struct net_pkt *pkt, uint64_t txtime)
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_TCP_TSO)
+static inline uint16_t net_pkt_tso_size(struct net_pkt *pkt)
+{
+	return pkt->tso_size;
+}
+
+static inline void net_pkt_set_tso_size(struct net_pkt *pkt,
+					uint16_t tso_size)
+{
+	pkt->tso_size = tso_size;
+}
+#else
+static inline uint16_t net_pkt_tso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_tso_size(struct net_pkt *pkt,
+					uint16_t tso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(tso_size);
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_FLOW_STEERING)
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	return pkt->flow_hash;
+}
+
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt,
+					 uint32_t flow_hash)
+{
+	pkt->flow_hash = flow_hash;
+}
+#else
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt,
+					 uint32_t flow_hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(flow_hash);
+}
+#endif /* CONFIG_NET_FLOW_STEERING */
+
+#if defined(CONFIG_NET_CHKSUM_COPY)
+static inline struct net_pkt_csum *net_pkt_payload_csum(struct net_pkt *pkt)
+{
+	return &pkt->payload_csum;
+}
+
+static inline void net_pkt_set_payload_csum(struct net_pkt *pkt,
+					    const struct net_pkt_csum *csum)
+{
+	pkt->payload_csum = *csum;
+}
+
+static inline bool net_pkt_is_chksum_pending(struct net_pkt *pkt)
+{
+	return pkt->chksum_pending;
+}
+
+static inline void net_pkt_set_chksum_pending(struct net_pkt *pkt,
+					      bool pending)
+{
+	pkt->chksum_pending = pending;
+}
+#else
+static inline struct net_pkt_csum *net_pkt_payload_csum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NULL;
+}
+
+static inline void net_pkt_set_payload_csum(struct net_pkt *pkt,
+					    const struct net_pkt_csum *csum)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(csum);
+}
+
+static inline bool net_pkt_is_chksum_pending(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_chksum_pending(struct net_pkt *pkt,
+					      bool pending)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(pending);
+}
+#endif /* CONFIG_NET_CHKSUM_COPY */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL) || \
 	defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
 static inline uint32_t *net_pkt_stats_tick(struct net_pkt *pkt)
@@ -1701,6 +1875,23 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length);
 
+/**
+ * @brief Copy data from a packet into another one, summing it.
+ *
+ * @details Same as net_pkt_copy() but the Internet checksum of the copied
+ *          data is accumulated into csum at the same time.
+ *
+ * @param pkt_dst Destination network packet.
+ * @param pkt_src Source network packet.
+ * @param length  Length of data to be copied.
+ * @param csum    Partial checksum to update.
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_copy_csum(struct net_pkt *pkt_dst,
+		      struct net_pkt *pkt_src,
+		      size_t length, struct net_pkt_csum *csum);
+
 /**
  * @brief Clone pkt and its buffer.
  *
@@ -1737,6 +1928,23 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
  */
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length);
 
+/**
+ * @brief Read some data from a net_pkt, summing it.
+ *
+ * @details Same as net_pkt_read() but the Internet checksum of the read
+ *          data is accumulated into csum at the same time. If data is NULL
+ *          the data is only summed and skipped.
+ *
+ * @param pkt    The network packet from where to read some data
+ * @param data   The destination buffer where to copy the data, or NULL
+ * @param length The amount of data to read
+ * @param csum   Partial checksum to update
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_read_csum(struct net_pkt *pkt, void *data, size_t length,
+		      struct net_pkt_csum *csum);
+
 /* Read uint8_t data data a net_pkt */
 static inline int net_pkt_read_u8(struct net_pkt *pkt, uint8_t *data)
 {
@@ -1800,6 +2008,22 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt, summing it.
+ *
+ * @details Same as net_pkt_write() but the Internet checksum of the
+ *          written data is accumulated into csum at the same time.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ * @param csum   Partial checksum to update
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_csum(struct net_pkt *pkt, const void *data, size_t length,
+		       struct net_pkt_csum *csum);
+
 /* Write uint8_t data into a net_pkt. */
 static inline int net_pkt_write_u8(struct net_pkt *pkt, uint8_t data)
 {
@@ -205,12 +205,22 @@ struct net_stats_ipv6_mld {
 	net_stats_t drop;
 };
 
+/** Number of log2 buckets in the network packet time histograms */
+#define NET_STATS_TIME_HIST_BUCKETS 16
+
 /**
  * @brief Network packet transfer times for calculating average TX time
  */
 struct net_stats_tx_time {
 	uint64_t sum;
 	net_stats_t count;
+#if defined(CONFIG_NET_PKT_TIME_STATS_HISTOGRAM)
+	/** Number of packets per time range: bucket 0 counts the times
+	 *  below 1 us, bucket n the times from 2^(n-1) us up to 2^n us and
+	 *  the last bucket all the longer times.
+	 */
+	net_stats_t hist[NET_STATS_TIME_HIST_BUCKETS];
+#endif
 };
 
 /**
@@ -219,6 +229,10 @@ struct net_stats_tx_time {
 struct net_stats_rx_time {
 	uint64_t sum;
 	net_stats_t count;
+#if defined(CONFIG_NET_PKT_TIME_STATS_HISTOGRAM)
+	/** Number of packets per time range, see struct net_stats_tx_time */
+	net_stats_t hist[NET_STATS_TIME_HIST_BUCKETS];
+#endif
 };
 
 /**
@@ -468,7 +482,10 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_TCP,
 	NET_REQUEST_STATS_CMD_GET_ETHERNET,
 	NET_REQUEST_STATS_CMD_GET_PPP,
-	NET_REQUEST_STATS_CMD_GET_PM
+	NET_REQUEST_STATS_CMD_GET_PM,
+	NET_REQUEST_STATS_CMD_GET_TX_TIME,
+	NET_REQUEST_STATS_CMD_GET_RX_TIME,
+	NET_REQUEST_STATS_CMD_GET_TC
 };
 
 #define NET_REQUEST_STATS_GET_ALL				\
@@ -547,6 +564,27 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ETHERNET);
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PPP);
 #endif /* CONFIG_NET_STATISTICS_PPP */
 
+#if defined(CONFIG_NET_PKT_TXTIME_STATS)
+#define NET_REQUEST_STATS_GET_TX_TIME				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_TX_TIME)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_TX_TIME);
+#endif /* CONFIG_NET_PKT_TXTIME_STATS */
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+#define NET_REQUEST_STATS_GET_RX_TIME				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_RX_TIME)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_RX_TIME);
+#endif /* CONFIG_NET_PKT_RXTIME_STATS */
+
+#if NET_TC_COUNT > 1
+#define NET_REQUEST_STATS_GET_TC				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_TC)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_TC);
+#endif /* NET_TC_COUNT > 1 */
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
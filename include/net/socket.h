@@ -54,6 +54,8 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmmsg: Datagram was longer than the buffers (output value only) */
+#define ZSOCK_MSG_TRUNC 0x20
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
 
@@ -125,6 +127,17 @@ struct zsock_pollfd {
  *  the TLS handshake.
  */
 #define TLS_ALPN_LIST 7
+/** Socket option to enable TLS session resumption. It accepts and returns an
+ *  integer:
+ *    - 0 - disabled (default)
+ *    - 1 - enabled
+ *
+ *  On a TLS client, the session negotiated with the server is cached after
+ *  the handshake and resumed on the next connection to the same peer
+ *  address and hostname. On a TLS server, session tickets are issued to the
+ *  clients. Requires CONFIG_NET_SOCKETS_TLS_SESSION_CACHE.
+ */
+#define TLS_SESSION_CACHE 8
 
 /** @} */
 
@@ -137,6 +150,10 @@ struct zsock_pollfd {
 #define TLS_DTLS_ROLE_CLIENT 0 /**< Client role in a DTLS session. */
 #define TLS_DTLS_ROLE_SERVER 1 /**< Server role in a DTLS session. */
 
+/* Valid values for TLS_SESSION_CACHE option */
+#define TLS_SESSION_CACHE_DISABLED 0 /**< No TLS session caching. */
+#define TLS_SESSION_CACHE_ENABLED 1 /**< TLS session caching enabled. */
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -357,6 +374,76 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send several messages with one call
+ *
+ * @details
+ * Sends the messages of @p msgvec in order, as if zsock_sendmsg() was
+ * called for each of them, but with a single system call and socket
+ * lookup. The number of bytes sent is stored in the msg_len field of
+ * each message. Sending stops at the first message that fails.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags as for zsock_sendmsg(), applied to every message
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+struct fs_file_t;
+
+/**
+ * @brief Send data from a file
+ *
+ * @details
+ * Sends @p len bytes of @p file, starting at offset @p off, as a sequence
+ * of zsock_send() calls with blocking semantics would. The file data is
+ * sent in place when fs_mmap() supports it, otherwise it is read in chunks
+ * of :option:`CONFIG_NET_SOCKETS_SENDFILE_BUF_SIZE` bytes. The file
+ * position is undefined after the call.
+ *
+ * @param sock Socket descriptor
+ * @param file Open file to send from
+ * @param off Offset of the first byte to send
+ * @param len Number of bytes to send
+ *
+ * @return Number of bytes sent, lower than @p len if the end of the file
+ *         is reached, or -1 with errno set if nothing could be sent.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t off,
+		       size_t len);
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
+/**
+ * @brief Receive several datagrams with one call
+ *
+ * @details
+ * Waits for the first datagram as zsock_recvfrom() would, and then
+ * receives the datagrams which are already queued, up to @p vlen in
+ * total, without waiting further. Each datagram is scattered to the
+ * msg_iov buffers of its message and its length is stored in msg_len.
+ * If the buffers are too short, the rest of the datagram is discarded
+ * and ZSOCK_MSG_TRUNC is set in msg_flags. The source address is stored
+ * to msg_name if it is set. Ancillary data is not supported, so
+ * msg_controllen is always set to 0.
+ *
+ * Only supported for native datagram sockets.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ *
+ * @return Number of datagrams received, or -1 with errno set.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -391,6 +478,47 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Instead of copying the received data to a caller provided buffer, up to
+ * @p max_len bytes are handed over as a chain of the network buffers the
+ * data was received into. For a datagram socket, one datagram is received
+ * and any data beyond @p max_len is discarded. For a stream socket, the
+ * remaining data is left for the next receive call.
+ *
+ * The buffers are owned by the caller until they are returned with
+ * zsock_recv_zc_release(). Holding on to them keeps them away from the
+ * network stack, so they should be released as soon as possible.
+ *
+ * The buffers are kernel memory, so this function is only available to
+ * supervisor threads and only for native (not offloaded or TLS) sockets.
+ * The ZSOCK_MSG_PEEK flag is not supported.
+ *
+ * @param sock Socket descriptor
+ * @param frags Filled with the fragment chain holding the data
+ * @param max_len Maximum number of bytes to receive
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param src_addr Source address of the data, can be NULL
+ * @param addrlen Length of @p src_addr, value-result argument
+ *
+ * @return Number of bytes received, 0 at end of stream, or -1 with errno
+ *         set.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, size_t max_len,
+		      int flags, struct sockaddr *src_addr,
+		      socklen_t *addrlen);
+
+/**
+ * @brief Return buffers received with zsock_recv_zc() to their pool
+ *
+ * @param frags Fragment chain returned by zsock_recv_zc()
+ */
+void zsock_recv_zc_release(struct net_buf *frags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -691,12 +819,24 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -771,6 +911,7 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -817,6 +958,56 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** sockopt: Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
+/** sockopt: Packet socket level option */
+#define SOL_PACKET 263
+
+/* Socket options for SOL_PACKET level */
+/** sockopt: Deliver the received frames to a ring of frame slots.
+ *  The option value is a struct tpacket_req.
+ */
+#define PACKET_RX_RING 5
+
+/** Ring frame status: the slot is free and owned by the kernel */
+#define TP_STATUS_KERNEL 0
+/** Ring frame status: the slot holds a frame for the application */
+#define TP_STATUS_USER BIT(0)
+/** Ring frame status: the frame was truncated to fit in the slot */
+#define TP_STATUS_COPY BIT(1)
+/** Ring frame status: frames were dropped before this one */
+#define TP_STATUS_LOSING BIT(2)
+
+/** Header at the start of every ring frame slot */
+struct tpacket_hdr {
+	/** Slot status, TP_STATUS_USER is set by the kernel when the frame
+	 *  is ready and the application writes TP_STATUS_KERNEL back to
+	 *  release the slot.
+	 */
+	uint32_t tp_status;
+	/** Length of the received frame */
+	uint32_t tp_len;
+	/** Number of frame bytes copied to the slot */
+	uint32_t tp_snaplen;
+	/** Offset of the frame data from the start of the slot */
+	uint16_t tp_mac;
+};
+
+#define TPACKET_ALIGNMENT 16
+#define TPACKET_ALIGN(x) ROUND_UP(x, TPACKET_ALIGNMENT)
+#define TPACKET_HDRLEN TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+
+/** Ring description for the PACKET_RX_RING socket option */
+struct tpacket_req {
+	/** Memory of the ring, provided by the application as there is no
+	 *  mmap(). It must stay valid until the ring is removed or the
+	 *  socket is closed.
+	 */
+	void *tp_ring;
+	/** Size of a frame slot, a multiple of TPACKET_ALIGNMENT */
+	unsigned int tp_frame_size;
+	/** Number of frame slots, 0 to remove the ring */
+	unsigned int tp_frame_nr;
+};
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
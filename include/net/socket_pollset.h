@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_POLLSET_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_POLLSET_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct zsock_pollfd;
+
+/** Max number of kernel poll events registered for one socket */
+#define ZSOCK_POLLSET_FD_EVENTS 2
+
+/** @cond INTERNAL_HIDDEN */
+struct zsock_pollset_fd {
+	struct k_poll_event events[ZSOCK_POLLSET_FD_EVENTS];
+
+	/* Link in the list of sockets to check on the next wait */
+	sys_snode_t node;
+
+	/* Link in the list of sockets checked on every wait */
+	sys_snode_t always_node;
+
+	int fd;
+	short events_requested;
+	uint8_t event_count;
+
+	/* Already queued to be checked */
+	uint8_t queued : 1;
+};
+/** @endcond */
+
+/**
+ * @brief Persistent set of sockets to poll.
+ *
+ * Unlike zsock_poll(), which sets up the poll events of every socket on
+ * each call, the sockets of a poll set stay registered between waits.
+ * The cost of zsock_pollset_wait() depends on the number of ready
+ * sockets, not on the number of sockets in the set.
+ */
+struct zsock_pollset {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_poll_set set;
+	struct k_mutex lock;
+
+	/* Sockets returned by the previous wait, or ready when added */
+	sys_slist_t recheck;
+
+	/* Sockets polled for ZSOCK_POLLOUT, which are always writable */
+	sys_slist_t always;
+
+	struct zsock_pollset_fd fds[CONFIG_NET_SOCKETS_POLLSET_MAX];
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a socket poll set.
+ *
+ * @param pset Poll set to initialize.
+ */
+void zsock_pollset_init(struct zsock_pollset *pset);
+
+/**
+ * @brief Add a socket to a poll set.
+ *
+ * The socket shall be removed from the set with zsock_pollset_remove()
+ * before it is closed. Offloaded sockets are not supported.
+ *
+ * @param pset Poll set.
+ * @param fd Socket to add.
+ * @param events Events to poll for (ZSOCK_POLLIN, ZSOCK_POLLOUT).
+ *
+ * @return 0 on success, a negative error code otherwise. -ENOMEM if the
+ *         set is full, -EEXIST if the socket is already in the set.
+ */
+int zsock_pollset_add(struct zsock_pollset *pset, int fd, short events);
+
+/**
+ * @brief Remove a socket from a poll set.
+ *
+ * @param pset Poll set.
+ * @param fd Socket to remove.
+ *
+ * @return 0 on success, -ENOENT if the socket is not in the set.
+ */
+int zsock_pollset_remove(struct zsock_pollset *pset, int fd);
+
+/**
+ * @brief Wait for sockets of a poll set to be ready.
+ *
+ * The ready sockets are stored in @a fds with their returned events, as
+ * zsock_poll() would set them. Sockets stay ready (level triggered) until
+ * their data is consumed.
+ *
+ * Only one thread at a time should wait on a given poll set.
+ *
+ * @param pset Poll set.
+ * @param fds Array receiving the ready sockets.
+ * @param nfds Size of the @a fds array.
+ * @param timeout Timeout in milliseconds, -1 to wait forever.
+ *
+ * @return Number of ready sockets stored in @a fds, 0 if the timeout
+ *         expired, a negative error code otherwise.
+ */
+int zsock_pollset_wait(struct zsock_pollset *pset, struct zsock_pollfd *fds,
+		       int nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_POLLSET_H_ */
@@ -89,6 +89,9 @@ typedef struct pthread_rwlock_obj {
 	k_tid_t wr_owner;
 } pthread_rwlock_t;
 
+/* Spinlock */
+typedef atomic_t pthread_spinlock_t;
+
 #endif /* CONFIG_PTHREAD_IPC */
 
 #ifdef __cplusplus
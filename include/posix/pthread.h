@@ -404,6 +404,53 @@ static inline int pthread_barrierattr_destroy(pthread_barrierattr_t *b)
 	return 0;
 }
 
+/*
+ *  Spinlock attributes - pshared
+ *
+ *  Zephyr has a single process, both are the same.
+ */
+#ifndef PTHREAD_PROCESS_PRIVATE
+#define PTHREAD_PROCESS_PRIVATE     0
+#endif
+#ifndef PTHREAD_PROCESS_SHARED
+#define PTHREAD_PROCESS_SHARED      1
+#endif
+
+/**
+ * @brief POSIX threading compatibility API
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_init(pthread_spinlock_t *lock, int pshared);
+
+/**
+ * @brief POSIX threading compatibility API
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_destroy(pthread_spinlock_t *lock);
+
+/**
+ * @brief POSIX threading compatibility API
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_lock(pthread_spinlock_t *lock);
+
+/**
+ * @brief POSIX threading compatibility API
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_trylock(pthread_spinlock_t *lock);
+
+/**
+ * @brief POSIX threading compatibility API
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_unlock(pthread_spinlock_t *lock);
+
 /* Predicates and setters for various pthread attribute values that we
  * don't support (or always support: the "process shared" attribute
  * can only be true given the way Zephyr implements these
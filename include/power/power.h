@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <power/power_state.h>
+#include <sys/slist.h>
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -215,6 +216,64 @@ bool sys_pm_ctrl_is_state_enabled(enum power_states state);
 
 #endif /* CONFIG_SYS_PM_STATE_LOCK */
 
+#ifdef CONFIG_SYS_PM_LATENCY
+/** No wakeup latency constraint */
+#define SYS_PM_LATENCY_NONE UINT32_MAX
+
+/**
+ * @brief Wakeup latency constraint
+ *
+ * Registered by a device driver or a thread which must be able to respond
+ * within a given time, e.g. to a peripheral FIFO filling up or to a
+ * periodic deadline. The fields are internal.
+ */
+struct sys_pm_latency_request {
+	sys_snode_t node;
+	uint32_t max_latency_us;
+};
+
+/**
+ * @brief Add a wakeup latency constraint
+ *
+ * @details Until the constraint is removed, the Zephyr power management
+ *	    policies only select the power states whose exit latency is at
+ *	    most @p max_latency_us. Application defined policies should use
+ *	    @ref sys_pm_latency_max_get to honor the constraints.
+ *
+ * @param [in] req Constraint, not already added.
+ * @param [in] max_latency_us Maximum wakeup latency, in microseconds.
+ */
+void sys_pm_latency_request_add(struct sys_pm_latency_request *req,
+				uint32_t max_latency_us);
+
+/**
+ * @brief Change the maximum wakeup latency of a constraint
+ *
+ * @param [in] req Constraint, already added.
+ * @param [in] max_latency_us Maximum wakeup latency, in microseconds.
+ */
+void sys_pm_latency_request_update(struct sys_pm_latency_request *req,
+				   uint32_t max_latency_us);
+
+/**
+ * @brief Remove a wakeup latency constraint
+ *
+ * @param [in] req Constraint, already added.
+ */
+void sys_pm_latency_request_remove(struct sys_pm_latency_request *req);
+
+/**
+ * @brief Get the strictest wakeup latency constraint
+ *
+ * Cheap enough to be called by the policy on every idle entry.
+ *
+ * @return The smallest maximum wakeup latency of the constraints, in
+ *	   microseconds, or SYS_PM_LATENCY_NONE if there is none.
+ */
+uint32_t sys_pm_latency_max_get(void);
+
+#endif /* CONFIG_SYS_PM_LATENCY */
+
 /**
  * @}
  */
@@ -263,6 +322,30 @@ void _sys_resume_from_deep_sleep(void);
  */
 void _sys_resume(void);
 
+#ifdef CONFIG_SYS_PM_IDLE_PREDICT
+/**
+ * @brief Predict the duration of the idle period starting
+ *
+ * Called by _sys_suspend() when the kernel goes idle, before the policy
+ * selects the power state.
+ *
+ * @param ticks The number of ticks until the next timeout, or
+ *		K_TICKS_FOREVER if there is none.
+ *
+ * @return The number of ticks the system is expected to stay idle, or
+ *	   K_TICKS_FOREVER.
+ */
+int32_t sys_pm_idle_predict(int32_t ticks);
+
+/**
+ * @brief Record the end of the idle period
+ *
+ * Called from the ISR of the event that caused the exit from kernel
+ * idling, the idle periods measured being the base of the prediction.
+ */
+void sys_pm_idle_predict_exit(void);
+#endif /* CONFIG_SYS_PM_IDLE_PREDICT */
+
 /**
  * @brief Allow entry to power state
  *
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PROFILING_H_
+#define ZEPHYR_INCLUDE_PROFILING_PROFILING_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling profiler
+ * @defgroup profiling Sampling profiler
+ * @{
+ *
+ * The sampling profiler periodically records the context interrupted by
+ * the system timer. The samples are symbolized on the host, see
+ * scripts/profiling/profile_fold.py.
+ *
+ * The function instrumentation records the entries and exits of the
+ * functions of the libraries selected by
+ * CONFIG_PROFILING_INSTRUMENT_LIBRARIES.
+ */
+
+/** @brief Profiling sample. */
+struct profiling_sample {
+	/** Program counter, 0 when an interrupt was interrupted. */
+	uintptr_t pc;
+#if defined(CONFIG_PROFILING_SAMPLING_CALLER) || defined(__DOXYGEN__)
+	/** Return address of the interrupted function, 0 when unknown. */
+	uintptr_t caller;
+#endif
+	/** Interrupted thread. */
+	const struct k_thread *thread;
+};
+
+/**
+ * @brief Callback called for each sample.
+ *
+ * @param sample Sample.
+ * @param user_data User data.
+ */
+typedef void (*profiling_sample_cb_t)(const struct profiling_sample *sample,
+				      void *user_data);
+
+/**
+ * @brief Start sampling.
+ *
+ * Samples recorded by a previous run are discarded. Sampling stops once
+ * CONFIG_PROFILING_SAMPLING_BUFFER_SIZE samples are recorded.
+ *
+ * @param period Sampling period, rounded up to a system tick.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if sampling is already running.
+ */
+int profiling_start(k_timeout_t period);
+
+/**
+ * @brief Stop sampling.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if sampling is not running.
+ */
+int profiling_stop(void);
+
+/**
+ * @brief Iterate over the recorded samples, oldest first.
+ *
+ * Should be called while sampling is stopped.
+ *
+ * @param cb Callback.
+ * @param user_data User data passed to the callback.
+ */
+void profiling_sample_foreach(profiling_sample_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the number of samples lost since sampling was started.
+ *
+ * @return Number of samples which did not fit in the buffer.
+ */
+uint32_t profiling_dropped_get(void);
+
+/** @brief Statistics of an instrumented function. */
+struct profiling_func_stat {
+	/** Function address. */
+	void *func;
+	/** Number of returns from the function. */
+	uint32_t calls;
+	/** Cycles spent in the function and in the functions it called. */
+	uint64_t inclusive;
+	/** Cycles spent in the function only. */
+	uint64_t exclusive;
+};
+
+/**
+ * @brief Callback called for each function of the summary.
+ *
+ * @param stat Function statistics.
+ * @param user_data User data.
+ */
+typedef void (*profiling_func_cb_t)(const struct profiling_func_stat *stat,
+				    void *user_data);
+
+/**
+ * @brief Start recording the entries and exits of instrumented functions.
+ *
+ * Events recorded by a previous run are discarded.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if recording is already running.
+ */
+int profiling_instrument_start(void);
+
+/**
+ * @brief Stop recording the entries and exits of instrumented functions.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if recording is not running.
+ */
+int profiling_instrument_stop(void);
+
+/**
+ * @brief Summarize the recorded events.
+ *
+ * Only the calls which returned within the recorded events are accounted.
+ * Time spent in other threads is not accounted.
+ *
+ * @param count Number of functions to report.
+ * @param cb Callback called for the hottest functions by exclusive time,
+ *           hottest first.
+ * @param user_data User data passed to the callback.
+ *
+ * @return Number of distinct functions seen, or -EBUSY if recording is
+ *         running.
+ */
+int profiling_instrument_summarize(size_t count, profiling_func_cb_t cb,
+				   void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PROFILING_H_ */
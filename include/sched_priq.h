@@ -45,15 +45,28 @@ void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
 
 /* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
+ * fixed set of priorities, one per thread priority.  This corresponds
  * to the original Zephyr scheduler.  RAM requirements are
  * comparatively high, but performance is very fast.  Won't work with
  * features like deadline scheduling which need large priority spaces
  * to represent their requirements.
+ *
+ * Non-empty queues are tracked with a two-level bitmap: bit i of
+ * "bitmask[w]" is set when queues[w * 32 + i] is non-empty, and bit w
+ * of "bitmap" is set when bitmask[w] is non-zero.  Finding the best
+ * queue is therefore two count-trailing-zeros operations no matter
+ * how many priorities are configured (up to 32 * 32).  The bitmaps
+ * are kept at the head of the struct so the lookup touches a single
+ * cache line before reaching the selected list head.
  */
+#define PRIQ_MQ_NUM_PRIOS (CONFIG_NUM_COOP_PRIORITIES + \
+			   CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define PRIQ_MQ_BITMAP_SIZE DIV_ROUND_UP(PRIQ_MQ_NUM_PRIOS, 32)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
-	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
+	uint32_t bitmap; /* bit 1<<w set if bitmask[w] is non-zero */
+	uint32_t bitmask[PRIQ_MQ_BITMAP_SIZE]; /* bit 1<<i set if queue non-empty */
+	sys_dlist_t queues[PRIQ_MQ_NUM_PRIOS];
 };
 
 void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
@@ -321,6 +321,15 @@ int settings_save(void);
  */
 int settings_save_one(const char *name, const void *value, size_t val_len);
 
+/**
+ * Write the values kept by the write-back of settings_save_one() to
+ * persisted storage. Does nothing unless CONFIG_SETTINGS_WRITE_BACK is
+ * enabled.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_flush(void);
+
 /**
  * Delete a single serialized in persisted storage.
  *
@@ -713,6 +713,17 @@ struct shell {
 
 extern void shell_print_stream(const void *user_ctx, const char *data,
 			       size_t data_len);
+
+#if defined(CONFIG_SHELL_LOG_BACKEND) && !defined(CONFIG_SHELL_PRINTF_AUTOFLUSH)
+/* The print buffer holds pending output, the logger needs its own buffer. */
+#define Z_SHELL_LOG_BUFFER_DEFINE(_name) \
+	static uint8_t _name##_log_buffer[CONFIG_SHELL_PRINTF_BUFF_SIZE];
+#define Z_SHELL_LOG_BUFFER(_name) _name##_log_buffer
+#else
+/* The print buffer is empty between prints, the logger reuses it. */
+#define Z_SHELL_LOG_BUFFER_DEFINE(_name)
+#define Z_SHELL_LOG_BUFFER(_name) _name##_out_buffer
+#endif
 /**
  * @brief Macro for defining a shell instance.
  *
@@ -731,13 +742,15 @@ extern void shell_print_stream(const void *user_ctx, const char *data,
 	static const struct shell _name;				      \
 	static struct shell_ctx UTIL_CAT(_name, _ctx);			      \
 	static uint8_t _name##_out_buffer[CONFIG_SHELL_PRINTF_BUFF_SIZE];	      \
-	SHELL_LOG_BACKEND_DEFINE(_name, _name##_out_buffer,		      \
+	Z_SHELL_LOG_BUFFER_DEFINE(_name)				      \
+	SHELL_LOG_BACKEND_DEFINE(_name, Z_SHELL_LOG_BUFFER(_name),	      \
 				 CONFIG_SHELL_PRINTF_BUFF_SIZE,		      \
 				 _log_queue_size, _log_timeout);	      \
 	SHELL_HISTORY_DEFINE(_name##_history, CONFIG_SHELL_HISTORY_BUFFER);   \
 	SHELL_FPRINTF_DEFINE(_name##_fprintf, &_name, _name##_out_buffer,     \
 			     CONFIG_SHELL_PRINTF_BUFF_SIZE,		      \
-			     true, shell_print_stream);			      \
+			     IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH),	      \
+			     shell_print_stream);			      \
 	LOG_INSTANCE_REGISTER(shell, _name, CONFIG_SHELL_LOG_LEVEL);	      \
 	SHELL_STATS_DEFINE(_name);					      \
 	static K_KERNEL_STACK_DEFINE(_name##_stack, CONFIG_SHELL_STACK_SIZE); \
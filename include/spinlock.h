@@ -24,8 +24,22 @@ struct z_spinlock_key {
  */
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Next ticket to hand out, and ticket currently being served.
+	 * The lock is held whenever the two differ.
+	 */
+	atomic_t tail;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Number of acquisitions, and how many of them had to spin */
+	uint32_t acquired;
+	uint32_t contended;
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -77,6 +91,31 @@ BUILD_ASSERT(CONFIG_MP_NUM_CPUS < 4, "Too many CPUs for mask");
  */
 typedef struct z_spinlock_key k_spinlock_key_t;
 
+#ifdef CONFIG_SMP
+/* Internal function: hands the lock to the next waiter, if any.  Only
+ * the holder writes the owner counter, but it is still updated with an
+ * atomic operation for the barrier, see k_spin_unlock().
+ */
+static ALWAYS_INLINE void z_spin_release_smp(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	(void)atomic_inc(&l->owner);
+#else
+	atomic_clear(&l->locked);
+#endif
+}
+
+/* Internal function: true if some CPU holds the lock */
+static ALWAYS_INLINE bool z_spin_is_locked(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	return atomic_get(&l->tail) != atomic_get(&l->owner);
+#else
+	return atomic_get(&l->locked) != 0;
+#endif
+}
+#endif /* CONFIG_SMP */
+
 /**
  * @brief Lock a spinlock
  *
@@ -124,9 +163,26 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	atomic_val_t ticket = atomic_inc(&l->tail);
+	bool spun = atomic_get(&l->owner) != ticket;
+
+	while (atomic_get(&l->owner) != ticket) {
+	}
+#else
+	bool spun = false;
+
 	while (!atomic_cas(&l->locked, 0, 1)) {
+		spun = true;
 	}
 #endif
+#ifdef CONFIG_SPINLOCK_STATS
+	l->acquired++;
+	l->contended += spun ? 1U : 0U;
+#else
+	ARG_UNUSED(spun);
+#endif
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	z_spin_lock_set_owner(l);
@@ -171,7 +227,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	 * a memory barrier when used like this, and we don't have a
 	 * Zephyr framework for that.
 	 */
-	atomic_clear(&l->locked);
+	z_spin_release_smp(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -186,7 +242,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_release_smp(l);
 #endif
 }
 
@@ -23,6 +23,11 @@
  * these statistics as a global structure, and STATS_NAME_START/END are how
  * you name the statistics themselves.
  *
+ * With CONFIG_STATS_PER_CPU, every CPU increments its own copy of the
+ * entries, without atomic operations nor cache lines bouncing between the
+ * CPUs. The copies are summed into the group by stats_walk(), so the
+ * entries of the group itself are only up to date during a walk.
+ *
  * Statistics entries can be declared as any of several integer types.
  * However, all statistics in a given structure must be of the same size, and
  * they are all unsigned.
@@ -53,6 +58,9 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#ifdef CONFIG_STATS_PER_CPU
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +81,10 @@ struct stats_hdr {
 	int s_map_cnt;
 #endif
 	struct stats_hdr *s_next;
+#ifdef CONFIG_STATS_PER_CPU
+	/* One copy of the entries per CPU, NULL if the pool ran out */
+	uint8_t *s_shards;
+#endif
 };
 
 /**
@@ -140,8 +152,25 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_INCN(group__, var__, n__)					\
+	do {								\
+		if ((group__).s_hdr.s_shards != NULL) {			\
+			unsigned int key__ = arch_irq_lock();		\
+									\
+			*(__typeof__((group__).var__) *)z_stats_shard(	\
+				&(group__).s_hdr,			\
+				offsetof(__typeof__(group__), var__))	\
+				+= (n__);				\
+			arch_irq_unlock(key__);				\
+		} else {						\
+			(group__).var__ += (n__);			\
+		}							\
+	} while (false)
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -164,8 +193,30 @@ struct stats_hdr {
  * @param group__               The group containing the entry to clear.
  * @param var__                 The statistic entry to clear.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_CLEAR(group__, var__) \
+	z_stats_clear(&(group__).s_hdr, offsetof(__typeof__(group__), var__))
+#else
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
+#endif
+
+#ifdef CONFIG_STATS_PER_CPU
+/** @cond INTERNAL_HIDDEN */
+
+/* Entry at offset off of the group, in the copy of the current CPU. The
+ * caller keeps interrupts locked, so that it cannot migrate meanwhile.
+ */
+static inline void *z_stats_shard(struct stats_hdr *hdr, uint16_t off)
+{
+	return hdr->s_shards + arch_curr_cpu()->id * hdr->s_size * hdr->s_cnt +
+	       off - sizeof(*hdr);
+}
+
+void z_stats_clear(struct stats_hdr *hdr, uint16_t off);
+
+/** @endcond */
+#endif
 
 #define STATS_SIZE_16 (sizeof(uint16_t))
 #define STATS_SIZE_32 (sizeof(uint32_t))
@@ -284,6 +335,9 @@ typedef int stats_walk_fn(struct stats_hdr *hdr, void *arg,
 /**
  * @brief Applies a function to every stat entry in a group.
  *
+ * With CONFIG_STATS_PER_CPU, the entries are first set to the sum of their
+ * per-CPU copies, the callback can read them from the group.
+ *
  * @param hdr                   The stats group to operate on.
  * @param walk_cb               The function to apply to each stat entry.
  * @param arg                   Optional argument to pass to the callback.
@@ -149,6 +149,25 @@ void flash_area_close(const struct flash_area *fa);
 int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 		    size_t len);
 
+/**
+ * @brief Get a pointer to flash area contents for reading in place.
+ *
+ * Memory mapped flash can be read through the returned pointer instead of
+ * being copied with flash_area_read(). The pointer stays valid as long as
+ * the area is open, its contents change when the range is written or
+ * erased.
+ *
+ * @param[in]  fa  Flash area
+ * @param[in]  off Offset relative from beginning of flash area to map
+ * @param[in]  len Number of bytes to map
+ * @param[out] ptr The address of @p off is returned in this argument
+ *
+ * @return  0 on success, -ENOTSUP if the area is not memory mapped or
+ *          CONFIG_FLASH_XIP_API is disabled, negative errno code otherwise.
+ */
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **ptr);
+
 /**
  * @brief Write data to flash area
  *
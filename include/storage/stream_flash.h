@@ -21,6 +21,7 @@
  */
 
 #include <stdbool.h>
+#include <kernel.h>
 #include <drivers/flash.h>
 
 #ifdef __cplusplus
@@ -62,6 +63,18 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	bool pipelined; /* Set by stream_flash_pipeline_enable() */
+	uint8_t *buf2; /* Buffer written in the background */
+	size_t async_bytes; /* Number of bytes being written from buf2 */
+	int async_result; /* Result of the background write */
+	struct k_sem async_done; /* Given when the background write is done */
+	struct flash_async_req async_req;
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	off_t erase_offset; /* Page erased after the background write */
+	size_t erase_size;
+#endif
+#endif
 };
 
 /**
@@ -128,6 +141,28 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
  */
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off);
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+/**
+ * @brief Write the buffered data in the background.
+ *
+ * The buffer given to stream_flash_init() is split in two halves. Once a
+ * half is full it is written with the asynchronous flash API while the next
+ * writes go to the other half, stream_flash_buffered_write() only waits
+ * when both halves are full. With CONFIG_STREAM_FLASH_ERASE the page
+ * holding the end of the next half is erased right after each write.
+ *
+ * Data written in the background is accounted by
+ * stream_flash_bytes_written() once it has reached the flash, and errors are
+ * reported by the following call. The sequence must end with a flush write,
+ * which waits for all the data, before the context or its buffer is reused.
+ *
+ * @param ctx context initialized by stream_flash_init() and not written yet
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_pipeline_enable(struct stream_flash_ctx *ctx);
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 #ifdef __cplusplus
 }
 #endif
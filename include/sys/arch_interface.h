@@ -372,6 +372,18 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+#ifdef CONFIG_SCHED_IPI_MASK_SUPPORTED
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on each CPU whose bit is set in
+ * @a cpu_mask.  The bit of the current CPU may be set and is ignored.
+ *
+ * @param cpu_mask Bitmask of target CPU IDs
+ */
+void arch_sched_ipi_mask(uint32_t cpu_mask);
+#endif
 #endif /* CONFIG_SMP */
 
 /** @} */
@@ -601,6 +613,29 @@ void arch_mem_domain_partition_remove(struct k_mem_domain *domain,
 void arch_mem_domain_partition_add(struct k_mem_domain *domain,
 				   uint32_t partition_id);
 
+/**
+ * @brief Start a batch of partition changes of a memory domain
+ *
+ * Called by k_mem_domain_update() before the
+ * arch_mem_domain_partition_remove() and arch_mem_domain_partition_add()
+ * calls making up the update. Until arch_mem_domain_update_end() is
+ * called, the architecture may defer the work common to all the
+ * changes, such as flushing the TLBs of the other CPUs.
+ *
+ * @param domain The memory domain being updated
+ */
+void arch_mem_domain_update_begin(struct k_mem_domain *domain);
+
+/**
+ * @brief End a batch of partition changes of a memory domain
+ *
+ * Completes the work deferred since arch_mem_domain_update_begin(). The
+ * changes must be in effect when this returns.
+ *
+ * @param domain The memory domain being updated
+ */
+void arch_mem_domain_update_end(struct k_mem_domain *domain);
+
 /**
  * @brief Remove the memory domain
  *
@@ -810,6 +845,33 @@ void arch_gdb_step(void);
 #endif
 /** @} */
 
+/**
+ * @defgroup arch-profiling Architecture-specific profiling APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_PROFILING_SAMPLING
+/**
+ * @brief Get the context interrupted by the current interrupt
+ *
+ * Called from an interrupt handler by the sampling profiler, see
+ * @ref profiling_start().
+ *
+ * Required when ARCH_HAS_PROFILING_SAMPLE is true.
+ *
+ * @param pc Set to the program counter of the interrupted thread.
+ * @param caller Set to the return address of the interrupted function, or
+ *               to 0 when it is unknown. It is only a hint, it may not be
+ *               valid in a function which already called another one.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if another interrupt was interrupted.
+ */
+int arch_profiling_pc_get(uintptr_t *pc, uintptr_t *caller);
+#endif
+/** @} */
+
 /**
  * @defgroup arch_cache Architecture-specific cache functions
  * @ingroup arch-interface
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief B-tree ordered container
+ *
+ * A balanced tree holding up to CONFIG_BTREE_FANOUT - 1 elements per node,
+ * so that a lookup touches few nodes and compares elements laid out next
+ * to each other, instead of chasing a pointer per comparison as with
+ * struct rbtree.
+ *
+ * Like the red/black tree, the ordering is given by a "less than"
+ * predicate on the user elements, and equal elements are kept in
+ * insertion order. Elements are referenced by pointer, several of them
+ * share a node, so nothing needs to be embedded in them. The nodes come
+ * from a pool given to btree_init(), there is no dynamic allocation: a
+ * pool of N nodes holds at least N * (CONFIG_BTREE_FANOUT / 2 - 1)
+ * elements.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_BTREE_MAX_ELEMS (CONFIG_BTREE_FANOUT - 1)
+
+struct btree_node {
+	struct btree_node *parent;
+	uint8_t num;
+	bool leaf;
+	void *elems[Z_BTREE_MAX_ELEMS];
+	struct btree_node *children[CONFIG_BTREE_FANOUT];
+};
+/** @endcond */
+
+/**
+ * @typedef btree_lessthan_t
+ * @brief B-tree comparison predicate
+ *
+ * Returns true if element A is strictly less than element B. As with
+ * rb_lessthan_t, the element being inserted is always A.
+ */
+typedef bool (*btree_lessthan_t)(const void *a, const void *b);
+
+/**
+ * @brief B-tree
+ *
+ * The fields are internal.
+ */
+struct btree {
+	struct btree_node *root;
+	struct btree_node *free;
+	btree_lessthan_t lessthan_fn;
+	size_t count;
+};
+
+/**
+ * @brief Initialize an empty tree
+ *
+ * @param tree Tree to initialize.
+ * @param lessthan_fn Ordering of the elements.
+ * @param nodes Pool of nodes used by the tree.
+ * @param num_nodes Number of nodes in the pool.
+ */
+void btree_init(struct btree *tree, btree_lessthan_t lessthan_fn,
+		struct btree_node *nodes, size_t num_nodes);
+
+/**
+ * @brief Insert an element into the tree
+ *
+ * The element is placed after the elements comparing equal to it.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the node pool is exhausted.
+ */
+int btree_insert(struct btree *tree, void *elem);
+
+/**
+ * @brief Remove an element from the tree
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if the element is not in the tree.
+ */
+int btree_remove(struct btree *tree, void *elem);
+
+/**
+ * @brief Returns true if the given element is part of the tree
+ *
+ * As with rb_contains(), the element pointer is tested, not its value.
+ */
+bool btree_contains(struct btree *tree, void *elem);
+
+/**
+ * @brief Find the first element comparing equal to a key
+ *
+ * @param tree Tree to search.
+ * @param key Element to compare the tree elements to, it does not need
+ *	      to be in the tree.
+ *
+ * @return The element, or NULL if there is none.
+ */
+void *btree_find(struct btree *tree, const void *key);
+
+/**
+ * @brief Returns the lowest-sorted element of the tree, or NULL
+ */
+void *btree_get_min(struct btree *tree);
+
+/**
+ * @brief Returns the highest-sorted element of the tree, or NULL
+ */
+void *btree_get_max(struct btree *tree);
+
+/**
+ * @brief Returns the number of elements in the tree
+ */
+static inline size_t btree_count(const struct btree *tree)
+{
+	return tree->count;
+}
+
+/** @cond INTERNAL_HIDDEN */
+struct _btree_foreach {
+	struct btree_node *node;
+	int idx;
+};
+
+void *z_btree_foreach_next(struct btree *tree, struct _btree_foreach *f);
+/** @endcond */
+
+/**
+ * @brief Walk a tree in order
+ *
+ * As for RB_FOR_EACH(), the loop is not safe against modifications of the
+ * tree. No stack is needed, the nodes know their parent.
+ *
+ * @param tree A pointer to a struct btree to walk
+ * @param elem The symbol name of a local pointer variable to use as the
+ *	       iterator
+ */
+#define BTREE_FOR_EACH(tree, elem)					\
+	for (struct _btree_foreach __f = { .node = NULL, .idx = -1 };	\
+	     (elem = z_btree_foreach_next(tree, &__f)) != NULL;		\
+	     /**/)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CBPRINTF_H_
+#define ZEPHYR_INCLUDE_SYS_CBPRINTF_H_
+
+#include <toolchain.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup cbprintf_apis Formatted output packages
+ * @ingroup support_apis
+ *
+ * A package holds the format string pointer and the arguments of a printk()
+ * style call, so that the formatting can be done later by another context,
+ * for example a low priority thread draining a log buffer. Packaging only
+ * copies the arguments, which is much cheaper than formatting them.
+ *
+ * The conversions of printk() are supported. The format string and the
+ * strings of \%s arguments are referenced, not copied, they must remain
+ * valid until the package is formatted.
+ *
+ * @{
+ */
+
+/** @brief Required alignment of a package buffer */
+#define CBPRINTF_PACKAGE_ALIGNMENT __alignof__(long long)
+
+/**
+ * @brief Signature of the character output function.
+ *
+ * @param c Character to output.
+ * @param ctx Context passed to cbpprintf().
+ *
+ * @return The character, or a negative error code.
+ */
+typedef int (*cbprintf_cb)(int c, void *ctx);
+
+/**
+ * @brief Capture the arguments of a formatted output into a package.
+ *
+ * @param packaged Buffer aligned to CBPRINTF_PACKAGE_ALIGNMENT, or NULL to
+ *		   only get the size of the package.
+ * @param len Size of the buffer in bytes.
+ * @param fmt Format string.
+ * @param ... Arguments of the format string.
+ *
+ * @retval Size of the package in bytes.
+ * @retval -ENOSPC if the package does not fit in the buffer.
+ */
+__printf_like(3, 4)
+int cbprintf_package(void *packaged, size_t len, const char *fmt, ...);
+
+/**
+ * @brief Capture the arguments of a formatted output into a package.
+ *
+ * See cbprintf_package().
+ *
+ * @param packaged Buffer aligned to CBPRINTF_PACKAGE_ALIGNMENT, or NULL to
+ *		   only get the size of the package.
+ * @param len Size of the buffer in bytes.
+ * @param fmt Format string.
+ * @param ap Arguments of the format string.
+ *
+ * @retval Size of the package in bytes.
+ * @retval -ENOSPC if the package does not fit in the buffer.
+ */
+__printf_like(3, 0)
+int cbvprintf_package(void *packaged, size_t len, const char *fmt,
+		      va_list ap);
+
+/**
+ * @brief Format a package.
+ *
+ * @param out Character output function.
+ * @param ctx Context passed to @a out.
+ * @param packaged Package built by cbprintf_package().
+ *
+ * @return Number of characters output.
+ */
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CBPRINTF_H_ */
@@ -87,6 +87,24 @@ typedef struct _dnode sys_dnode_t;
 	     __dn != NULL; \
 	     __dn = sys_dlist_peek_next(__dl, __dn))
 
+/**
+ * @brief Provide the primitive to iterate on a list, prefetching the next node
+ * Note: the loop is unsafe and thus __dn should not be removed
+ *
+ * Same as SYS_DLIST_FOR_EACH_NODE(), the next node is read into the cache
+ * while the loop body runs, which helps with long lists of nodes scattered
+ * in memory.
+ *
+ * This and other SYS_DLIST_*() macros are not thread safe.
+ *
+ * @param __dl A pointer on a sys_dlist_t to iterate on
+ * @param __dn A sys_dnode_t pointer to peek each node of the list
+ */
+#define SYS_DLIST_FOR_EACH_NODE_PREFETCH(__dl, __dn)			\
+	for (__dn = sys_dlist_peek_head(__dl);				\
+	     __dn != NULL && (prefetch((__dn)->next), true);		\
+	     __dn = sys_dlist_peek_next_no_check(__dl, __dn))
+
 /**
  * @brief Provide the primitive to safely iterate on a list
  * Note: __dn can be removed, it will not break the loop.
@@ -160,6 +178,23 @@ typedef struct _dnode sys_dnode_t;
 	     __cn != NULL;                                              \
 	     __cn = SYS_DLIST_PEEK_NEXT_CONTAINER(__dl, __cn, __n))
 
+/**
+ * @brief Provide the primitive to iterate on a list under a container,
+ * prefetching the next node
+ * Note: the loop is unsafe and thus __cn should not be detached
+ *
+ * Same as SYS_DLIST_FOR_EACH_CONTAINER(), with the next node read into the
+ * cache while the loop body runs.
+ *
+ * @param __dl A pointer on a sys_dlist_t to iterate on
+ * @param __cn A pointer to peek each entry of the list
+ * @param __n The field name of sys_dnode_t within the container struct
+ */
+#define SYS_DLIST_FOR_EACH_CONTAINER_PREFETCH(__dl, __cn, __n)		\
+	for (__cn = SYS_DLIST_PEEK_HEAD_CONTAINER(__dl, __cn, __n);	\
+	     __cn != NULL && (prefetch((__cn)->__n.next), true);	\
+	     __cn = SYS_DLIST_PEEK_NEXT_CONTAINER(__dl, __cn, __n))
+
 /**
  * @brief Provide the primitive to safely iterate on a list under a container
  * Note: __cn can be detached, it will not break the loop.
@@ -521,6 +556,34 @@ static inline sys_dnode_t *sys_dlist_get(sys_dlist_t *list)
 	return node;
 }
 
+/**
+ * @brief move all the nodes of a list to the tail of another one
+ *
+ * The nodes are spliced in constant time, @a list_to_append is left empty.
+ *
+ * This and other sys_dlist_*() functions are not thread safe.
+ *
+ * @param list the doubly-linked list to append to
+ * @param list_to_append the doubly-linked list to take the nodes from
+ *
+ * @return N/A
+ */
+
+static inline void sys_dlist_merge_dlist(sys_dlist_t *list,
+					 sys_dlist_t *list_to_append)
+{
+	if (sys_dlist_is_empty(list_to_append)) {
+		return;
+	}
+
+	list_to_append->head->prev = list->tail;
+	list_to_append->tail->next = list;
+	list->tail->next = list_to_append->head;
+	list->tail = list_to_append->tail;
+
+	sys_dlist_init(list_to_append);
+}
+
 #ifdef __cplusplus
 }
 #endif
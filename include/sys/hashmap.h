@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Hash map
+ *
+ * Open addressing hash map with Robin Hood probing: an entry being
+ * inserted takes the slot of any entry closer to its home slot than
+ * itself, which keeps the probe sequences short and lets a lookup stop
+ * early on a missing key. Removals shift the following entries back
+ * instead of leaving tombstones.
+ *
+ * Keys and values are pointers. Integer keys can be stored in the key
+ * pointer itself with sys_hashmap_int_hash() and a NULL equality
+ * function, other keys are compared through the given callback.
+ *
+ * The slots either come from a static array, or are allocated and grown
+ * through a realloc-like callback. The map does no locking of its own, it
+ * can be used from an ISR under a spinlock held by the caller as long as
+ * it does not need to grow, which a static map never does.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASHMAP_H_
+#define ZEPHYR_INCLUDE_SYS_HASHMAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Hash map
+ * @defgroup hashmap_apis Hash map
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @typedef sys_hashmap_hash_t
+ * @brief Hash of a key
+ */
+typedef uint32_t (*sys_hashmap_hash_t)(const void *key);
+
+/**
+ * @typedef sys_hashmap_equal_t
+ * @brief Returns true if two keys are equal
+ */
+typedef bool (*sys_hashmap_equal_t)(const void *a, const void *b);
+
+/**
+ * @typedef sys_hashmap_realloc_t
+ * @brief Resize a block of memory, with the semantics of realloc()
+ *
+ * A size of 0 frees the block.
+ */
+typedef void *(*sys_hashmap_realloc_t)(void *ptr, size_t size);
+
+/** @cond INTERNAL_HIDDEN */
+struct sys_hashmap_slot {
+	const void *key;
+	void *value;
+	uint32_t hash;
+	/* Distance to the home slot plus one, 0 for a free slot */
+	uint32_t dist;
+};
+/** @endcond */
+
+/**
+ * @brief Hash map
+ *
+ * The fields are internal.
+ */
+struct sys_hashmap {
+	struct sys_hashmap_slot *slots;
+	sys_hashmap_hash_t hash_fn;
+	sys_hashmap_equal_t equal_fn;
+	sys_hashmap_realloc_t realloc_fn;
+	/* Number of slots, a power of two */
+	size_t capacity;
+	size_t size;
+};
+
+/**
+ * @brief Iterator over the entries of a hash map
+ */
+struct sys_hashmap_iter {
+	/** Key of the current entry */
+	const void *key;
+	/** Value of the current entry */
+	void *value;
+	/** @cond INTERNAL_HIDDEN */
+	size_t idx;
+	size_t remaining;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define and initialize a hash map with static storage
+ *
+ * @param name Name of the hash map.
+ * @param num_slots Number of slots, a power of two.
+ * @param hash Hash function.
+ * @param equal Key equality function, NULL to compare the key pointers.
+ */
+#define SYS_HASHMAP_DEFINE_STATIC(name, num_slots, hash, equal)		\
+	BUILD_ASSERT(((num_slots) & ((num_slots) - 1)) == 0,		\
+		     "Hash map size must be a power of two");		\
+	static struct sys_hashmap_slot _hashmap_slots_##name[num_slots];	\
+	struct sys_hashmap name = {					\
+		.slots = _hashmap_slots_##name,				\
+		.hash_fn = hash,					\
+		.equal_fn = equal,					\
+		.capacity = num_slots,					\
+	}
+
+/**
+ * @brief Initialize a hash map with static storage
+ *
+ * Inserts fail once all the slots are used.
+ *
+ * @param map Hash map to initialize.
+ * @param slots Slots of the map.
+ * @param num_slots Number of slots, a power of two.
+ * @param hash_fn Hash function.
+ * @param equal_fn Key equality function, NULL to compare the key pointers.
+ */
+void sys_hashmap_init(struct sys_hashmap *map, struct sys_hashmap_slot *slots,
+		      size_t num_slots, sys_hashmap_hash_t hash_fn,
+		      sys_hashmap_equal_t equal_fn);
+
+/**
+ * @brief Initialize a hash map with allocated storage
+ *
+ * The slots are allocated on the first insert, and reallocated as the
+ * map fills up.
+ *
+ * @param map Hash map to initialize.
+ * @param hash_fn Hash function.
+ * @param equal_fn Key equality function, NULL to compare the key pointers.
+ * @param realloc_fn Allocator of the slots.
+ */
+void sys_hashmap_init_dynamic(struct sys_hashmap *map,
+			      sys_hashmap_hash_t hash_fn,
+			      sys_hashmap_equal_t equal_fn,
+			      sys_hashmap_realloc_t realloc_fn);
+
+/**
+ * @brief Insert or replace an entry
+ *
+ * @param map Hash map.
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ * @param old_value If not NULL, set to the replaced value.
+ *
+ * @retval 1 if the entry was inserted.
+ * @retval 0 if the value of an existing entry was replaced.
+ * @retval -ENOSPC if a static map is full.
+ * @retval -ENOMEM if the slots cannot be grown.
+ */
+int sys_hashmap_insert(struct sys_hashmap *map, const void *key, void *value,
+		       void **old_value);
+
+/**
+ * @brief Look up an entry
+ *
+ * @param map Hash map.
+ * @param key Key of the entry.
+ * @param value If not NULL, set to the value of the entry.
+ *
+ * @return true if the entry exists.
+ */
+bool sys_hashmap_get(const struct sys_hashmap *map, const void *key,
+		     void **value);
+
+/**
+ * @brief Remove an entry
+ *
+ * @param map Hash map.
+ * @param key Key of the entry.
+ * @param value If not NULL, set to the value of the removed entry.
+ *
+ * @return true if the entry existed.
+ */
+bool sys_hashmap_remove(struct sys_hashmap *map, const void *key,
+			void **value);
+
+/**
+ * @brief Remove all the entries
+ *
+ * The storage of a dynamic map is freed.
+ *
+ * @param map Hash map.
+ */
+void sys_hashmap_clear(struct sys_hashmap *map);
+
+/**
+ * @brief Returns the number of entries of a hash map
+ */
+static inline size_t sys_hashmap_size(const struct sys_hashmap *map)
+{
+	return map->size;
+}
+
+/**
+ * @brief Start iterating over the entries of a hash map
+ *
+ * The entries come in no particular order. The map must not be modified
+ * during the iteration, except by sys_hashmap_iter_remove().
+ */
+static inline void sys_hashmap_iter_init(const struct sys_hashmap *map,
+					 struct sys_hashmap_iter *iter)
+{
+	iter->idx = 0;
+	iter->remaining = map->size;
+}
+
+/**
+ * @brief Move an iterator to the next entry
+ *
+ * @return true if the iterator is on an entry, false past the last one.
+ */
+bool sys_hashmap_iter_next(const struct sys_hashmap *map,
+			   struct sys_hashmap_iter *iter);
+
+/**
+ * @brief Remove the entry an iterator is on
+ *
+ * The following sys_hashmap_iter_next() moves to the entry after it.
+ */
+void sys_hashmap_iter_remove(struct sys_hashmap *map,
+			     struct sys_hashmap_iter *iter);
+
+/**
+ * @brief Hash of an integer stored in the key pointer
+ */
+uint32_t sys_hashmap_int_hash(const void *key);
+
+/**
+ * @brief Hash of a NUL-terminated string key
+ */
+uint32_t sys_hashmap_str_hash(const void *key);
+
+/**
+ * @brief Equality of NUL-terminated string keys
+ */
+bool sys_hashmap_str_equal(const void *a, const void *b);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASHMAP_H_ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief High resolution timers
+ *
+ * One-shot and periodic timers expiring with the resolution of a counter
+ * device instead of the system clock tick. The timers of the system share
+ * one alarm channel of the counter, programmed for the first timer to
+ * expire, and the handlers are called from the counter interrupt.
+ *
+ * The counter value is extended to 64 bits, so the timers never wrap.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HRTIMER_H_
+#define ZEPHYR_INCLUDE_SYS_HRTIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief High resolution timers
+ * @defgroup hrtimer_apis High resolution timers
+ * @ingroup kernel_apis
+ * @{
+ */
+
+struct sys_hrtimer;
+
+/**
+ * @typedef sys_hrtimer_handler_t
+ * @brief Function called in ISR context when a timer expires
+ *
+ * The handler may start or stop any timer, including its own.
+ */
+typedef void (*sys_hrtimer_handler_t)(struct sys_hrtimer *timer);
+
+/**
+ * @brief High resolution timer
+ *
+ * The fields are internal, a timer is set up with sys_hrtimer_init().
+ */
+struct sys_hrtimer {
+	/* Node in the list of pending timers, sorted by expiry */
+	sys_dnode_t node;
+	/* Expiry, in counter ticks */
+	uint64_t expiry;
+	/* Period, in counter ticks, 0 for a one-shot timer */
+	uint64_t period;
+	sys_hrtimer_handler_t handler;
+};
+
+/**
+ * @brief Initialize a high resolution timer
+ *
+ * @param timer Timer to initialize.
+ * @param handler Function called when the timer expires.
+ */
+void sys_hrtimer_init(struct sys_hrtimer *timer,
+		      sys_hrtimer_handler_t handler);
+
+/**
+ * @brief Start a high resolution timer
+ *
+ * A timer already running is restarted. The delay and the period are
+ * rounded up to counter ticks. A periodic timer keeps the phase of its
+ * first expiry, expiries missed because of a late interrupt or a handler
+ * running for longer than the period are dropped.
+ *
+ * @param timer Timer to start.
+ * @param delay_ns Time until the first expiry, in nanoseconds.
+ * @param period_ns Time between the next expiries, in nanoseconds, or 0
+ *		    for a one-shot timer.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if the counter is not initialized.
+ */
+int sys_hrtimer_start(struct sys_hrtimer *timer, uint64_t delay_ns,
+		      uint64_t period_ns);
+
+/**
+ * @brief Stop a high resolution timer
+ *
+ * Does nothing if the timer is not running. The handler may still be
+ * running on another CPU when this returns.
+ *
+ * @param timer Timer to stop.
+ */
+void sys_hrtimer_stop(struct sys_hrtimer *timer);
+
+/**
+ * @brief Check if a high resolution timer is running
+ *
+ * A one-shot timer stops running before its handler is called.
+ *
+ * @param timer Timer to check.
+ *
+ * @return true if the timer is due to expire.
+ */
+bool sys_hrtimer_is_running(const struct sys_hrtimer *timer);
+
+/**
+ * @brief Read the time base of the high resolution timers
+ *
+ * @return Time since the counter was started, in nanoseconds.
+ */
+uint64_t sys_hrtimer_ns_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HRTIMER_H_ */
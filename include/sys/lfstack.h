@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free stack
+ *
+ * Intrusive stack of nodes embedded in the elements of an array, pushed
+ * and popped with a compare-and-swap on a single word from any context,
+ * interrupts of any priority included, without a lock.
+ *
+ * The head holds the index of the top node rather than its address, next
+ * to a tag incremented by every operation. A pop that read the head, was
+ * preempted while the top node was popped and pushed again, and resumes
+ * with an outdated next index then fails its compare-and-swap because the
+ * tag changed, instead of corrupting the stack (the ABA problem). Indexes
+ * leave room for the tag even with 32-bit atomics, which is why the nodes
+ * must come from an array of at most 65535 elements.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_LFSTACK_H_
+#define ZEPHYR_INCLUDE_SYS_LFSTACK_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/atomic.h>
+#include <sys/__assert.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_LFSTACK_IDX_MASK 0xffffU
+#define Z_LFSTACK_TAG_INC 0x10000U
+/** @endcond */
+
+/** Maximum number of elements of the array holding the nodes */
+#define SYS_LFSTACK_MAX_NODES Z_LFSTACK_IDX_MASK
+
+/** @brief Lock-free stack node, embedded in the elements */
+struct sys_lfstack_node {
+	/** @cond INTERNAL_HIDDEN */
+	/* Index of the next node plus one, 0 for the last one */
+	atomic_t next;
+	/** @endcond */
+};
+
+/** @brief Lock-free stack */
+struct sys_lfstack {
+	/** @cond INTERNAL_HIDDEN */
+	/* Tag in the upper bits, index of the top node plus one below */
+	atomic_t head;
+	/* Node of the first element, and distance between elements */
+	char *base;
+	size_t stride;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an empty lock-free stack
+ *
+ * @param stack Stack to initialize.
+ * @param first Node of the first element of the array.
+ * @param stride Size of the elements of the array.
+ */
+static inline void sys_lfstack_init(struct sys_lfstack *stack,
+				    struct sys_lfstack_node *first,
+				    size_t stride)
+{
+	atomic_set(&stack->head, 0);
+	stack->base = (char *)first;
+	stack->stride = stride;
+}
+
+/** @cond INTERNAL_HIDDEN */
+static inline struct sys_lfstack_node *
+z_lfstack_node(struct sys_lfstack *stack, atomic_val_t idx)
+{
+	return (struct sys_lfstack_node *)(stack->base +
+		((size_t)(idx & Z_LFSTACK_IDX_MASK) - 1U) * stack->stride);
+}
+/** @endcond */
+
+/**
+ * @brief Push a node onto a lock-free stack
+ *
+ * Can be called from any context.
+ *
+ * @param stack Stack.
+ * @param node Node of an element of the stack array, not in the stack.
+ */
+static inline void sys_lfstack_push(struct sys_lfstack *stack,
+				    struct sys_lfstack_node *node)
+{
+	size_t idx = ((char *)node - stack->base) / stack->stride + 1U;
+	atomic_val_t head;
+
+	__ASSERT_NO_MSG(z_lfstack_node(stack, idx) == node &&
+			idx <= SYS_LFSTACK_MAX_NODES);
+
+	do {
+		head = atomic_get(&stack->head);
+		atomic_set(&node->next, head & Z_LFSTACK_IDX_MASK);
+	} while (!atomic_cas(&stack->head, head,
+			     (atomic_val_t)(((head & ~Z_LFSTACK_IDX_MASK) +
+					     Z_LFSTACK_TAG_INC) | idx)));
+}
+
+/**
+ * @brief Pop the top node off a lock-free stack
+ *
+ * Can be called from any context.
+ *
+ * @param stack Stack.
+ *
+ * @return The node, NULL if the stack is empty.
+ */
+static inline struct sys_lfstack_node *
+sys_lfstack_pop(struct sys_lfstack *stack)
+{
+	struct sys_lfstack_node *node;
+	atomic_val_t head, next;
+
+	do {
+		head = atomic_get(&stack->head);
+		if ((head & Z_LFSTACK_IDX_MASK) == 0) {
+			return NULL;
+		}
+
+		/* The node may be popped and reused meanwhile, its next
+		 * index is then stale but the tag check below fails.
+		 */
+		node = z_lfstack_node(stack, head);
+		next = atomic_get(&node->next);
+	} while (!atomic_cas(&stack->head, head,
+			     ((head & ~Z_LFSTACK_IDX_MASK) +
+			      Z_LFSTACK_TAG_INC) | next));
+
+	return node;
+}
+
+/**
+ * @brief Check if a lock-free stack is empty
+ *
+ * @param stack Stack.
+ *
+ * @return True if the stack held no node at the time of the call.
+ */
+static inline bool sys_lfstack_is_empty(struct sys_lfstack *stack)
+{
+	return (atomic_get(&stack->head) & Z_LFSTACK_IDX_MASK) == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_LFSTACK_H_ */
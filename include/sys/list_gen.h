@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <sys/util.h>
+#include <toolchain.h>
 
 #define Z_GENLIST_FOR_EACH_NODE(__lname, __l, __sn)			\
 	for (__sn = sys_ ## __lname ## _peek_head(__l); __sn != NULL;	\
@@ -28,6 +29,13 @@
 	     __sn != NULL ; __sn = __sns,				\
 		     __sns = sys_ ## __lname ## _peek_next(__sn))
 
+/* The next node is prefetched while the loop body runs on the current one */
+#define Z_GENLIST_FOR_EACH_NODE_PREFETCH(__lname, __l, __sn)		\
+	for (__sn = sys_ ## __lname ## _peek_head(__l);			\
+	     __sn != NULL &&						\
+	     (prefetch(sys_ ## __lname ## _peek_next_no_check(__sn)), true); \
+	     __sn = sys_ ## __lname ## _peek_next_no_check(__sn))
+
 #define Z_GENLIST_CONTAINER(__ln, __cn, __n)				\
 	((__ln) ? CONTAINER_OF((__ln), __typeof__(*(__cn)), __n) : NULL)
 
@@ -54,6 +62,16 @@
 	     __cn != NULL; __cn = __cns,				\
 	     __cns = Z_GENLIST_PEEK_NEXT_CONTAINER(__lname, __cn, __n))
 
+#define Z_GENLIST_FOR_EACH_CONTAINER_PREFETCH(__lname, __l, __cn, __n)	\
+	for (__cn = Z_GENLIST_PEEK_HEAD_CONTAINER(__lname, __l, __cn,	\
+						  __n);			\
+	     __cn != NULL &&						\
+	     (prefetch(sys_ ## __lname ## _peek_next_no_check(		\
+			       &(__cn)->__n)), true);			\
+	     __cn = Z_GENLIST_CONTAINER(				\
+		     sys_ ## __lname ## _peek_next_no_check(&(__cn)->__n), \
+		     __cn, __n))
+
 #define Z_GENLIST_IS_EMPTY(__lname)					\
 	static inline bool						\
 	sys_ ## __lname ## _is_empty(sys_ ## __lname ## _t *list)	\
@@ -232,4 +250,32 @@
 		return false;						 \
 	}
 
+#define Z_GENLIST_REMOVE_IF(__lname, __nname)				 \
+	static inline size_t						 \
+	sys_ ## __lname ## _remove_if(sys_ ## __lname ## _t *list,	 \
+			sys_ ## __lname ## _t *removed,			 \
+			bool (*cond)(sys_ ## __nname ## _t *node,	 \
+				     void *user_data),			 \
+			void *user_data)				 \
+	{								 \
+		sys_ ## __nname ## _t *prev = NULL;			 \
+		sys_ ## __nname ## _t *node, *next;			 \
+		size_t count = 0;					 \
+									 \
+		Z_GENLIST_FOR_EACH_NODE_SAFE(__lname, list, node, next) { \
+			if (!cond(node, user_data)) {			 \
+				prev = node;				 \
+				continue;				 \
+			}						 \
+									 \
+			sys_ ## __lname ## _remove(list, prev, node);	 \
+			if (removed != NULL) {				 \
+				sys_ ## __lname ## _append(removed, node); \
+			}						 \
+			count++;					 \
+		}							 \
+									 \
+		return count;						 \
+	}
+
 #endif /* ZEPHYR_INCLUDE_SYS_LIST_GEN_H_ */
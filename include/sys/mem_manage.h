@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <sys/__assert.h>
 
 #ifdef __cplusplus
@@ -103,6 +104,204 @@ void z_mem_map(uint8_t **linear_addr, uintptr_t phys_addr, size_t size,
 size_t k_mem_region_align(uintptr_t *aligned_addr, size_t *aligned_size,
 			  uintptr_t addr, size_t size, size_t align);
 
+/**
+ * Map anonymous memory into the kernel's address space
+ *
+ * Page frames are taken from the free RAM, not used by the kernel image,
+ * and mapped in the virtual region for runtime mappings. The memory is
+ * zeroed. With CONFIG_DEMAND_PAGING, pages may be evicted to make room
+ * and the returned pages may themselves be evicted later on, unless
+ * pinned with k_mem_pin().
+ *
+ * This API is only available if CONFIG_MMU is enabled.
+ *
+ * @param size Page-aligned size of the mapping
+ * @param flags Caching mode and access flags, see K_MEM_PERM_* macros. The
+ *        memory is always cached write-back.
+ * @return Base address of the mapping, NULL if there is not enough
+ *         virtual address space or free memory
+ */
+void *k_mem_map(size_t size, uint32_t flags);
+
+/**
+ * Number of page frames not used by any mapping
+ *
+ * With demand paging this may be 0 while k_mem_map() still succeeds, as
+ * pages are then evicted to make room.
+ */
+size_t k_mem_free_get(void);
+
+#ifdef CONFIG_DEMAND_PAGING
+/**
+ * @defgroup demand_paging Demand Paging
+ * @{
+ *
+ * With demand paging, page frames not pinned in memory may be evicted to a
+ * backing store, their virtual pages left non-present. Accessing such a
+ * page raises a page fault, handled by paging the page back in, evicting
+ * another one if no page frame is free. Which page is evicted is up to the
+ * eviction algorithm.
+ *
+ * The kernel image is pinned at boot: it holds the page tables, the
+ * exception and interrupt handlers and everything the page fault path
+ * touches. Regions of it which do not need to stay resident, such as
+ * large application code or data, can be released with k_mem_unpin().
+ */
+
+/** Demand paging statistics */
+struct k_mem_paging_stats_t {
+	/** Page faults handled by paging a page in */
+	unsigned long pagefaults;
+
+	/** Pages evicted which had not been written to */
+	unsigned long evictions_clean;
+
+	/** Pages evicted which had been written to */
+	unsigned long evictions_dirty;
+};
+
+/**
+ * Evict a region of memory
+ *
+ * The pages are written to the backing store and their page frames freed.
+ * Pages already evicted are skipped.
+ *
+ * @param addr Page-aligned base virtual address
+ * @param size Page-aligned region size
+ * @retval 0 Success
+ * @retval -EFAULT A page of the region is not mapped
+ * @retval -EPERM A page of the region is pinned
+ * @retval -ENOMEM The backing store is full
+ */
+int k_mem_page_out(void *addr, size_t size);
+
+/**
+ * Load a region of memory
+ *
+ * Evicted pages of the region are paged in ahead of being accessed. They
+ * may be evicted again at any time.
+ *
+ * @param addr Page-aligned base virtual address
+ * @param size Page-aligned region size
+ */
+void k_mem_page_in(void *addr, size_t size);
+
+/**
+ * Pin a region of memory
+ *
+ * The pages of the region are paged in if needed, and not evicted until
+ * unpinned. Memory accessed from interrupt handlers, or with interrupts
+ * locked, must be pinned.
+ *
+ * @param addr Page-aligned base virtual address
+ * @param size Page-aligned region size
+ */
+void k_mem_pin(void *addr, size_t size);
+
+/**
+ * Unpin a region of memory
+ *
+ * The pages of the region may then be evicted.
+ *
+ * @param addr Page-aligned base virtual address
+ * @param size Page-aligned region size
+ */
+void k_mem_unpin(void *addr, size_t size);
+
+/**
+ * Get the demand paging statistics
+ *
+ * Only counted with CONFIG_DEMAND_PAGING_STATS, all 0 otherwise.
+ *
+ * @param stats [out] Statistics
+ */
+void k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats);
+
+struct z_page_frame;
+
+/**
+ * @defgroup mem-demand-paging-eviction Eviction Algorithm APIs
+ * @{
+ */
+
+/**
+ * Select a page frame for eviction
+ *
+ * The kernel invokes this with interrupts locked when it needs a page
+ * frame and none is free. Only page frames for which
+ * z_page_frame_is_evictable() is true may be returned.
+ *
+ * @param [out] dirty Whether the page was written to since it was loaded
+ * @return The page frame, NULL if none can be evicted
+ */
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty);
+
+/**
+ * Initialize the eviction algorithm, invoked once at boot
+ */
+void k_mem_paging_eviction_init(void);
+
+/** @} */
+
+/**
+ * @defgroup mem-demand-paging-backing-store Backing Store APIs
+ * @{
+ *
+ * Evicted pages are kept at locations of the backing store, which are
+ * opaque values for the kernel: they are only stored in the non-present
+ * page table entries. Locations must be page-aligned and never 0.
+ *
+ * The page being paged in or out is accessed through the virtual page
+ * Z_SCRATCH_PAGE, which the kernel maps to the page frame beforehand.
+ * All of these are invoked with interrupts locked.
+ */
+
+/**
+ * Reserve a location for a page to be evicted
+ *
+ * @param pf Page frame being evicted
+ * @param [out] location Location reserved
+ * @param page_fault Whether the eviction makes room for a page fault.
+ *        Backing stores may keep a few locations for those, so that page
+ *        faults still get serviced once k_mem_page_out() filled them up.
+ * @retval 0 Success
+ * @retval -ENOMEM The backing store is full
+ */
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault);
+
+/**
+ * Release a location reserved by k_mem_paging_backing_store_location_get()
+ *
+ * @param location Location to release
+ */
+void k_mem_paging_backing_store_location_free(uintptr_t location);
+
+/**
+ * Copy the contents of Z_SCRATCH_PAGE to a location
+ *
+ * @param location Location reserved for the page
+ */
+void k_mem_paging_backing_store_page_out(uintptr_t location);
+
+/**
+ * Copy the contents of a location to Z_SCRATCH_PAGE
+ *
+ * @param location Location of the page
+ */
+void k_mem_paging_backing_store_page_in(uintptr_t location);
+
+/**
+ * Initialize the backing store, invoked once at boot
+ */
+void k_mem_paging_backing_store_init(void);
+
+/** @} */
+
+/** @} */
+#endif /* CONFIG_DEMAND_PAGING */
+
 #ifdef __cplusplus
 }
 #endif
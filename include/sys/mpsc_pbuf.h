@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+
+#include <zephyr/types.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multi producer, single consumer packet buffer
+ * @defgroup mpsc_pbuf MPSC packet buffer
+ * @ingroup datastructure_apis
+ * @{
+ *
+ * Variable size packets are stored contiguously in a ring of 32-bit words.
+ * Producers claim space for a packet with a compare-and-swap on the write
+ * index, fill it and commit it, without any lock. The consumer reads the
+ * packets in the order they were claimed. A packet that was claimed but not
+ * committed yet holds back the ones claimed after it. Packets can be freed
+ * in any order and from any context, the space of a packet is reused once
+ * the packets claimed before it are freed too.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define MPSC_PBUF_HDR_VALID BIT(31)
+#define MPSC_PBUF_HDR_SKIP BIT(30)
+#define MPSC_PBUF_HDR_FREED BIT(29)
+#define MPSC_PBUF_HDR_LEN_MASK BIT_MASK(16)
+/** @endcond */
+
+/** Maximum packet length, in 32-bit words. */
+#define MPSC_PBUF_MAX_WLEN (MPSC_PBUF_HDR_LEN_MASK - 1)
+
+/** @brief MPSC packet buffer. */
+struct mpsc_pbuf_buffer {
+	/** @cond INTERNAL_HIDDEN */
+	uint32_t *buf;
+
+	/* Size in words, a power of 2 */
+	uint32_t size;
+
+	/* Free running indexes of the words claimed by the producers, of the
+	 * words given back to them and of the words read by the consumer.
+	 */
+	atomic_t wr;
+	atomic_t rd;
+	atomic_t claim;
+
+	/* Set while a context is advancing the read index */
+	atomic_t releasing;
+
+	/* Packets which did not fit */
+	atomic_t dropped;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a packet buffer.
+ *
+ * @param buffer Packet buffer.
+ * @param buf Memory of the buffer.
+ * @param size Size of @p buf in 32-bit words. Must be a power of 2.
+ */
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer, uint32_t *buf,
+		    uint32_t size);
+
+/**
+ * @brief Claim space for a packet.
+ *
+ * Can be called from any context, including interrupts.
+ *
+ * @param buffer Packet buffer.
+ * @param wlen Length of the packet in 32-bit words.
+ *
+ * @return Word aligned space for @p wlen words, NULL if the buffer is full.
+ *         The dropped packet counter is incremented in that case.
+ */
+uint32_t *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen);
+
+/**
+ * @brief Commit a packet, making it available to the consumer.
+ *
+ * @param buffer Packet buffer.
+ * @param packet Packet returned by mpsc_pbuf_alloc().
+ * @param wlen Length passed to mpsc_pbuf_alloc().
+ */
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer, uint32_t *packet,
+		      uint32_t wlen);
+
+/**
+ * @brief Claim the oldest packet.
+ *
+ * Must only be called by the consumer. The packet stays in the buffer until
+ * it is freed with mpsc_pbuf_free(), the following packets can be claimed
+ * in the meantime.
+ *
+ * @param buffer Packet buffer.
+ * @param wlen Location where the length of the packet is stored.
+ *
+ * @return Oldest packet, NULL if there is none or if it is not committed yet.
+ */
+uint32_t *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer, uint32_t *wlen);
+
+/**
+ * @brief Get the oldest packet without claiming it.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param buffer Packet buffer.
+ * @param wlen Location where the length of the packet is stored.
+ *
+ * @return Packet which the next mpsc_pbuf_claim() would return, NULL if
+ *         there is none.
+ */
+uint32_t *mpsc_pbuf_peek(struct mpsc_pbuf_buffer *buffer, uint32_t *wlen);
+
+/**
+ * @brief Free a packet returned by mpsc_pbuf_claim().
+ *
+ * Can be called from any context, packets can be freed in any order.
+ *
+ * @param buffer Packet buffer.
+ * @param packet Packet to free.
+ */
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer, uint32_t *packet);
+
+/**
+ * @brief Check if the buffer holds any claimed packet.
+ *
+ * @param buffer Packet buffer.
+ *
+ * @return True if some packets were claimed and not freed yet.
+ */
+static inline bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
+{
+	return atomic_get(&buffer->wr) != atomic_get(&buffer->rd);
+}
+
+/**
+ * @brief Get and reset the number of dropped packets.
+ *
+ * @param buffer Packet buffer.
+ *
+ * @return Number of packets which did not fit since the last call.
+ */
+static inline uint32_t mpsc_pbuf_dropped_get(struct mpsc_pbuf_buffer *buffer)
+{
+	return (uint32_t)atomic_set(&buffer->dropped, 0);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_RING_BUF_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_RING_BUF_H_
+
+#include <sys/mpsc_pbuf.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multi producer, single consumer byte ring buffer
+ * @defgroup mpsc_ring_buf MPSC ring buffer
+ * @ingroup datastructure_apis
+ * @{
+ *
+ * Byte stream counterpart of struct ring_buf, with the same claim and
+ * finish API, that any number of contexts can write to without a lock.
+ * Every claim reserves a contiguous record in an MPSC packet buffer, the
+ * consumer reads the records in the order they were claimed as a single
+ * stream of bytes. A record that was claimed but not finished yet holds
+ * back the ones claimed after it.
+ */
+
+/** @brief MPSC byte ring buffer. */
+struct mpsc_ring_buf {
+	/** @cond INTERNAL_HIDDEN */
+	struct mpsc_pbuf_buffer pbuf;
+
+	/* Record being read by the consumer, its length and the number of
+	 * bytes of it read so far
+	 */
+	uint32_t *rd_packet;
+	uint32_t rd_len;
+	uint32_t rd_off;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define and initialize an MPSC ring buffer.
+ *
+ * @param name Name of the ring buffer.
+ * @param size8 Size of the ring buffer in bytes, a power of 2 and at
+ *		least 8.
+ */
+#define MPSC_RING_BUF_DECLARE(name, size8)				\
+	BUILD_ASSERT((size8) >= 8 && ((size8) & ((size8) - 1)) == 0,	\
+		     "MPSC ring buffer size must be a power of 2");	\
+	static uint32_t _mpsc_ring_buf_data_##name[(size8) / 4];	\
+	struct mpsc_ring_buf name = {					\
+		.pbuf = {						\
+			.buf = _mpsc_ring_buf_data_##name,		\
+			.size = (size8) / 4,				\
+		},							\
+	}
+
+/**
+ * @brief Initialize an MPSC ring buffer.
+ *
+ * Only used for ring buffers not defined with MPSC_RING_BUF_DECLARE.
+ *
+ * @param buf Ring buffer.
+ * @param size Size of @p data in bytes, a power of 2 and at least 8.
+ * @param data Memory of the ring buffer.
+ */
+void mpsc_ring_buf_init(struct mpsc_ring_buf *buf, uint32_t size,
+			uint32_t *data);
+
+/**
+ * @brief Allocate space for writing data to an MPSC ring buffer.
+ *
+ * Can be called from any context, including interrupts, concurrently with
+ * other writers. Each claim must be completed with
+ * mpsc_ring_buf_put_finish(), the data written by concurrent writers is
+ * never interleaved.
+ *
+ * @param[in]  buf  Ring buffer.
+ * @param[out] data Set to the allocated space.
+ * @param[in]  size Requested size in bytes.
+ *
+ * @return @p size, less if it is more than the largest record the buffer
+ *	   can hold, or 0 if there is not enough free space.
+ */
+uint32_t mpsc_ring_buf_put_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Indicate the number of bytes written to allocated space.
+ *
+ * @param buf  Ring buffer.
+ * @param data Space returned by mpsc_ring_buf_put_claim().
+ * @param size Number of bytes written, at most the claimed size.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @p size exceeds the claimed size.
+ */
+int mpsc_ring_buf_put_finish(struct mpsc_ring_buf *buf, uint8_t *data,
+			     uint32_t size);
+
+/**
+ * @brief Write (copy) data to an MPSC ring buffer.
+ *
+ * Can be called from any context, concurrently with other writers.
+ *
+ * @param buf  Ring buffer.
+ * @param data Address of data.
+ * @param size Data size in bytes.
+ *
+ * @return Number of bytes written.
+ */
+uint32_t mpsc_ring_buf_put(struct mpsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Get the address of valid data in an MPSC ring buffer.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in]  buf  Ring buffer.
+ * @param[out] data Set to the valid data.
+ * @param[in]  size Requested size in bytes.
+ *
+ * @return Number of valid bytes, which can be smaller than requested at
+ *	   the end of a record.
+ */
+uint32_t mpsc_ring_buf_get_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Indicate the number of bytes read from claimed data.
+ *
+ * @param buf  Ring buffer.
+ * @param size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @p size exceeds the claimed data.
+ */
+int mpsc_ring_buf_get_finish(struct mpsc_ring_buf *buf, uint32_t size);
+
+/**
+ * @brief Read data from an MPSC ring buffer.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param buf  Ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Size of the output buffer in bytes.
+ *
+ * @return Number of bytes written to the output buffer.
+ */
+uint32_t mpsc_ring_buf_get(struct mpsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Check if an MPSC ring buffer holds any data.
+ *
+ * Data claimed by a writer but not finished yet counts as held.
+ *
+ * @param buf Ring buffer.
+ *
+ * @return True if the ring buffer is empty.
+ */
+static inline bool mpsc_ring_buf_is_empty(struct mpsc_ring_buf *buf)
+{
+	return !mpsc_pbuf_is_pending(&buf->pbuf);
+}
+
+/**
+ * @brief Get and reset the number of failed claims.
+ *
+ * @param buf Ring buffer.
+ *
+ * @return Number of claims which did not fit since the last call.
+ */
+static inline uint32_t mpsc_ring_buf_dropped_get(struct mpsc_ring_buf *buf)
+{
+	return mpsc_pbuf_dropped_get(&buf->pbuf);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_RING_BUF_H_ */
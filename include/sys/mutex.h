@@ -11,7 +11,7 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked/unlocked
  * with simple atomic ops instead of syscalls, similar to Linux's
  * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
@@ -26,13 +26,37 @@ extern "C" {
 #include <sys_clock.h>
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST: ID of the owning thread, or 0 if the
+	 * mutex is free, ORed with SYS_MUTEX_CONTENDED once the kernel
+	 * tracks the owner because other threads wait for the mutex.
+	 * Otherwise unused.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* Number of recursive locks taken by the owner beyond the first */
+	uint32_t lock_count;
+#endif
 };
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <kernel.h>
+
+/* Set in sys_mutex::val while there are waiters, forcing a syscall to
+ * unlock. Thread objects are word aligned so bit 0 of an ID is free.
+ */
+#define SYS_MUTEX_CONTENDED	((atomic_val_t)1)
+
+struct k_mutex;
+
+/* Kernel-side slow paths, called with the system call already verified */
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex,
+			       struct k_mutex *kernel_mutex,
+			       k_timeout_t timeout);
+
+int z_sys_mutex_unlock_contended(struct sys_mutex *mutex,
+				 struct k_mutex *kernel_mutex);
+#endif
+
 #define SYS_MUTEX_DEFINE(name) \
 	struct sys_mutex name
 
@@ -86,7 +110,18 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_val_t self = (atomic_val_t)z_tls_current;
+
+	if (likely(atomic_cas(&mutex->val, 0, self))) {
+		return 0;
+	}
+
+	if ((atomic_get(&mutex->val) & ~SYS_MUTEX_CONTENDED) == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+#endif
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -108,7 +143,27 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_val_t self = (atomic_val_t)z_tls_current;
+	atomic_val_t val = atomic_get(&mutex->val);
+
+	if (val == 0) {
+		return -EINVAL;
+	}
+
+	if ((val & ~SYS_MUTEX_CONTENDED) != self) {
+		return -EPERM;
+	}
+
+	if (mutex->lock_count != 0U) {
+		mutex->lock_count--;
+		return 0;
+	}
+
+	if (likely(atomic_cas(&mutex->val, self, 0))) {
+		return 0;
+	}
+#endif
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
@@ -80,6 +80,20 @@ typedef struct _slist sys_slist_t;
 #define SYS_SLIST_ITERATE_FROM_NODE(__sl, __sn)				\
 	Z_GENLIST_ITERATE_FROM_NODE(slist, __sl, __sn)
 
+/**
+ * @brief Provide the primitive to iterate on a list, prefetching the next node
+ * Note: the loop is unsafe and thus __sn should not be removed
+ *
+ * Same as SYS_SLIST_FOR_EACH_NODE(), the next node is read into the cache
+ * while the loop body runs, which helps with long lists of nodes scattered
+ * in memory.
+ *
+ * @param __sl A pointer on a sys_slist_t to iterate on
+ * @param __sn A sys_snode_t pointer to peek each node of the list
+ */
+#define SYS_SLIST_FOR_EACH_NODE_PREFETCH(__sl, __sn)			\
+	Z_GENLIST_FOR_EACH_NODE_PREFETCH(slist, __sl, __sn)
+
 /**
  * @brief Provide the primitive to safely iterate on a list
  * Note: __sn can be removed, it will not break the loop.
@@ -156,6 +170,21 @@ typedef struct _slist sys_slist_t;
 #define SYS_SLIST_FOR_EACH_CONTAINER(__sl, __cn, __n)			\
 	Z_GENLIST_FOR_EACH_CONTAINER(slist, __sl, __cn, __n)
 
+/**
+ * @brief Provide the primitive to iterate on a list under a container,
+ * prefetching the next node
+ * Note: the loop is unsafe and thus __cn should not be detached
+ *
+ * Same as SYS_SLIST_FOR_EACH_CONTAINER(), with the next node read into the
+ * cache while the loop body runs.
+ *
+ * @param __sl A pointer on a sys_slist_t to iterate on
+ * @param __cn A pointer to peek each entry of the list
+ * @param __n The field name of sys_snode_t within the container struct
+ */
+#define SYS_SLIST_FOR_EACH_CONTAINER_PREFETCH(__sl, __cn, __n)		\
+	Z_GENLIST_FOR_EACH_CONTAINER_PREFETCH(slist, __sl, __cn, __n)
+
 /**
  * @brief Provide the primitive to safely iterate on a list under a container
  * Note: __cn can be detached, it will not break the loop.
@@ -409,6 +438,31 @@ static inline bool sys_slist_find_and_remove(sys_slist_t *list,
 
 Z_GENLIST_FIND_AND_REMOVE(slist, snode)
 
+/**
+ * @brief Remove all the nodes matching a condition
+ *
+ * The list is walked once, each node being unlinked from the one before
+ * it, where calling sys_slist_find_and_remove() on each of them would search
+ * the list again for every node.
+ *
+ * This and other sys_slist_*() functions are not thread safe.
+ *
+ * @param list A pointer on the list to affect
+ * @param removed A pointer on a list the removed nodes are appended to, in
+ *        their original order, or NULL
+ * @param cond Returns true if the node is to be removed, it must not
+ *        modify the list
+ * @param user_data Passed to cond
+ *
+ * @return The number of nodes removed
+ */
+static inline size_t sys_slist_remove_if(sys_slist_t *list,
+		sys_slist_t *removed,
+		bool (*cond)(sys_snode_t *node, void *user_data),
+		void *user_data);
+
+Z_GENLIST_REMOVE_IF(slist, snode)
+
 #ifdef __cplusplus
 }
 #endif
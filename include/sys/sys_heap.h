@@ -54,6 +54,25 @@ struct sys_heap {
 	size_t init_bytes;
 };
 
+/** @brief sys_heap runtime statistics
+ *
+ * Byte counts are in units of chunk payload (i.e. not counting the
+ * per-chunk header), so @a free_bytes + @a allocated_bytes stays
+ * constant over the life of the heap.
+ */
+struct sys_memory_stats {
+	/** Bytes in free chunks */
+	size_t free_bytes;
+	/** Bytes in allocated chunks */
+	size_t allocated_bytes;
+	/** High-water mark of @a allocated_bytes */
+	size_t max_allocated_bytes;
+	/** Size of the largest free chunk, i.e. the largest request that
+	 * is guaranteed to succeed
+	 */
+	size_t largest_free_bytes;
+};
+
 struct z_heap_stress_result {
 	uint32_t total_allocs;
 	uint32_t successful_allocs;
@@ -118,6 +137,37 @@ void *sys_heap_aligned_alloc(struct sys_heap *h, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *h, void *mem);
 
+/** @brief Get sys_heap runtime statistics
+ *
+ * Fills @a stats with the current allocation counters of @a h.  The
+ * counters are maintained incrementally; only finding the largest free
+ * chunk requires walking the biggest non-empty free bucket.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @note Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap to query
+ * @param stats Struct into which to store the statistics
+ * @return 0 on success, -EINVAL if a parameter is NULL
+ */
+int sys_heap_runtime_stats_get(struct sys_heap *h,
+			       struct sys_memory_stats *stats);
+
+/** @brief Reset the sys_heap allocation high-water mark
+ *
+ * Sets the high-water mark reported by sys_heap_runtime_stats_get()
+ * to the number of bytes currently allocated.
+ *
+ * @note Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap to reset
+ * @return 0 on success, -EINVAL if @a h is NULL
+ */
+int sys_heap_runtime_stats_reset_max(struct sys_heap *h);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief System call batching
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+
+#include <syscall.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run a sequence of system calls with a single kernel entry
+ *
+ * Each entry of @a entries, filled with the generated
+ * <tt>*_batch_entry()</tt> helper of a system call, is run in order
+ * exactly as if the thread had made that system call itself, and its
+ * return value is stored in the entry's @a ret field.  Arguments are
+ * verified per entry as usual, so an invalid argument makes the thread
+ * oops at that entry.  Entries may block.  Batches can't be nested.
+ *
+ * Intended for user mode threads issuing bursts of small calls, to pay
+ * for one privilege transition instead of one per call.  Supervisor
+ * threads call the kernel directly and get -ENOSYS.
+ *
+ * @param entries Array of system calls to run, writable by the caller
+ * @param num Number of entries
+ *
+ * @return Number of entries run, or -ENOSYS if not called from user mode
+ */
+__syscall int k_syscall_batch(struct k_syscall_entry *entries, size_t num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/syscall_batch.h>
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_ */
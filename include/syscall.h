@@ -105,6 +105,23 @@ static ALWAYS_INLINE bool z_syscall_trap(void)
 	return ret;
 }
 
+/**
+ * @brief One system call of a batch run by k_syscall_batch()
+ *
+ * Entries are normally filled with the generated helper of the system
+ * call, named after it: k_sem_give_batch_entry() for k_sem_give(), and
+ * so on.  Helpers are generated for system calls taking up to six
+ * marshalled words and not returning a 64-bit value.
+ */
+struct k_syscall_entry {
+	/** System call ID, one of the K_SYSCALL_* values */
+	uintptr_t id;
+	/** Marshalled arguments, as passed to the system call handler */
+	uintptr_t args[6];
+	/** Return value of the system call, set by k_syscall_batch() */
+	uintptr_t ret;
+};
+
 /**
  * Indicate whether the CPU is currently in user mode
  *
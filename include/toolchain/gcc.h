@@ -194,6 +194,9 @@ do {                                                                    \
 
 #define popcount(x) __builtin_popcount(x)
 
+/* Start loading the cache line at x, a hint which never faults */
+#define prefetch(x) __builtin_prefetch(x)
+
 #ifndef __no_optimization
 #define __no_optimization __attribute__((optimize("-O0")))
 #endif
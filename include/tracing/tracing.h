@@ -18,6 +18,7 @@
 #define SYS_TRACE_ID_SEMA_GIVE               (5u + SYS_TRACE_ID_OFFSET)
 #define SYS_TRACE_ID_SEMA_TAKE               (6u + SYS_TRACE_ID_OFFSET)
 #define SYS_TRACE_ID_SLEEP                   (7u + SYS_TRACE_ID_OFFSET)
+#define SYS_TRACE_ID_CLOCK_ANNOUNCE          (8u + SYS_TRACE_ID_OFFSET)
 
 #ifdef CONFIG_SEGGER_SYSTEMVIEW
 #include "tracing_sysview.h"
@@ -23,6 +23,7 @@
 
 #include <usb/usb_common.h>
 #include <device.h>
+#include <kernel.h>
 #include <net/buf.h>
 #include <sys/util.h>
 
@@ -283,4 +284,48 @@ void usb_audio_register(const struct device *dev,
 int usb_audio_send(const struct device *dev, struct net_buf *buffer,
 		   size_t len);
 
+/** Nominal feedback value, 48 samples per frame in 10.14 fixed point */
+#define USB_AUDIO_FEEDBACK_NOMINAL (48U << 14)
+
+/**
+ * @brief Set the rate reported on the feedback endpoint
+ *
+ * The OUT streams of the Headphones and Headset devices are asynchronous.
+ * With CONFIG_USB_AUDIO_FEEDBACK the device reports on an explicit feedback
+ * endpoint how many samples per frame the Host has to send, so that the
+ * stream follows the clock of the device instead of the one of the Host.
+ *
+ * @param dev   USB Audio device with an OUT stream
+ * @param value Samples per frame in 10.14 fixed point, within one sample
+ *		of USB_AUDIO_FEEDBACK_NOMINAL
+ *
+ * @return 0 on success, negative error on fail
+ */
+int usb_audio_feedback_set(const struct device *dev, uint32_t value);
+
+/**
+ * @brief Pass the OUT stream of the USB Audio device to an I2S device
+ *
+ * The data received from the Host is read straight into blocks of the
+ * memory slab of the I2S TX stream and queued with i2s_write(), with no
+ * copy and no allocation from the net_buf pool. The stream is started once
+ * half of the slab is queued, and the feedback endpoint keeps it there.
+ * The data_received_cb callback is not called while the bridge is set.
+ *
+ * The I2S TX stream must be configured by the application beforehand with:
+ * - the same sample rate, channels and word size as the OUT stream,
+ * - the slab given here, with blocks of at least one frame with one extra
+ *   sample (49 samples of all channels),
+ * - a timeout of 0, the data is queued from the endpoint callback.
+ *
+ * @param dev     USB Audio device with an OUT stream
+ * @param i2s_dev I2S device, NULL to remove the bridge
+ * @param slab    Memory slab of the I2S TX stream
+ *
+ * @return 0 on success, negative error on fail
+ */
+int usb_audio_i2s_bridge(const struct device *dev,
+			 const struct device *i2s_dev,
+			 struct k_mem_slab *slab);
+
 #endif /* ZEPHYR_INCLUDE_USB_CLASS_AUDIO_H_ */
@@ -28,6 +28,7 @@
 #define ACM_SUBCLASS			0x02
 #define ECM_SUBCLASS			0x06
 #define EEM_SUBCLASS			0x0c
+#define NCM_SUBCLASS			0x0d
 
 /** Communications Class Protocol Codes */
 #define AT_CMD_V250_PROTOCOL		0x01
@@ -39,6 +40,9 @@
  */
 #define DATA_INTERFACE_CLASS		0x0A
 
+/** Data Class Protocol Codes */
+#define NCM_DATA_PROTOCOL		0x01
+
 /**
  * @brief bDescriptor SubType for Communications
  * Class Functional Descriptors
@@ -49,6 +53,7 @@
 #define ACM_FUNC_DESC			0x02
 #define UNION_FUNC_DESC			0x06
 #define ETHERNET_FUNC_DESC		0x0F
+#define NCM_FUNC_DESC			0x1A
 
 /**
  * @brief PSTN Subclass Specific Requests
@@ -165,4 +170,16 @@ struct cdc_ecm_descriptor {
 	uint8_t bNumberPowerFilters;
 } __packed;
 
+/**
+ * @brief NCM Functional Descriptor
+ * @note NCM10.pdf, 5.2.1, Table 5-2
+ */
+struct cdc_ncm_descriptor {
+	uint8_t bFunctionLength;
+	uint8_t bDescriptorType;
+	uint8_t bDescriptorSubtype;
+	uint16_t bcdNcmVersion;
+	uint8_t bmNetworkCapabilities;
+} __packed;
+
 #endif /* ZEPHYR_INCLUDE_USB_CLASS_USB_CDC_H_ */
@@ -42,6 +42,92 @@ extern uint32_t __device_busy_end[];
  *
  * @param level init level to run.
  */
+static void init_entry_run(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+
+	if (dev != NULL) {
+		z_object_init(dev);
+	}
+
+	if ((entry->init(dev) != 0) && (dev != NULL)) {
+		/* Initialization failed.
+		 * Set the init status bit so device is not declared ready.
+		 */
+		atomic_set_bit((atomic_t *)__device_init_status_start,
+			       (dev - __device_start));
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+static K_KERNEL_STACK_ARRAY_DEFINE(init_stacks,
+				   CONFIG_DEVICE_INIT_PARALLEL_WORKERS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_DEVICE_INIT_PARALLEL_WORKERS];
+
+static struct k_spinlock init_lock;
+static const struct init_entry *init_next;
+static const struct init_entry *init_batch_end;
+
+/* Runs entries of the current batch until none is left */
+static void init_batch_drain(void)
+{
+	const struct init_entry *entry;
+	k_spinlock_key_t key;
+
+	for (;;) {
+		key = k_spin_lock(&init_lock);
+		entry = init_next;
+		if (entry < init_batch_end) {
+			init_next++;
+		}
+		k_spin_unlock(&init_lock, key);
+
+		if (entry >= init_batch_end) {
+			break;
+		}
+		init_entry_run(entry);
+	}
+}
+
+static void init_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	init_batch_drain();
+}
+
+/* Runs [start, end), entries sharing one level and priority, on the
+ * calling thread plus as many workers as are useful.
+ */
+static void init_batch_run(const struct init_entry *start,
+			   const struct init_entry *end)
+{
+	int workers = MIN(end - start - 1, CONFIG_DEVICE_INIT_PARALLEL_WORKERS);
+	int i;
+
+	init_next = start;
+	init_batch_end = end;
+
+	for (i = 0; i < workers; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_KERNEL_STACK_SIZEOF(init_stacks[i]),
+				init_worker, NULL, NULL, NULL,
+				k_thread_priority_get(k_current_get()),
+				0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "init_worker");
+	}
+
+	init_batch_drain();
+
+	for (i = 0; i < workers; i++) {
+		k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 void z_sys_init_run_level(int32_t level)
 {
 	static const struct init_entry *levels[] = {
@@ -57,21 +143,24 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
-	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if ((level == _SYS_INIT_LEVEL_POST_KERNEL) ||
+	    (level == _SYS_INIT_LEVEL_APPLICATION)) {
+		const struct init_entry *end;
 
-		if (dev != NULL) {
-			z_object_init(dev);
+		for (entry = levels[level]; entry < levels[level+1];
+		     entry = end) {
+			for (end = entry + 1; end < levels[level+1] &&
+				     end->prio == entry->prio; end++) {
+			}
+			init_batch_run(entry, end);
 		}
+		return;
+	}
+#endif
 
-		if ((entry->init(dev) != 0) && (dev != NULL)) {
-			/* Initialization failed.
-			 * Set the init status bit so device is not declared ready.
-			 */
-			sys_bitfield_set_bit(
-				(mem_addr_t) __device_init_status_start,
-				(dev - __device_start));
-		}
+	for (entry = levels[level]; entry < levels[level+1]; entry++) {
+		init_entry_run(entry);
 	}
 }
 
@@ -83,15 +172,20 @@ const struct device *z_impl_device_get_binding(const char *name)
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
 	 * performed. Reserve string comparisons for a fallback.
+	 *
+	 * Readiness is only checked for the matching devices, and the first
+	 * characters are compared before calling strcmp(), as most names
+	 * differ there.
 	 */
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_ready(dev) && (dev->name == name)) {
+		if ((dev->name == name) && z_device_ready(dev)) {
 			return dev;
 		}
 	}
 
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_ready(dev) && (strcmp(name, dev->name) == 0)) {
+		if ((dev->name[0] == name[0]) &&
+		    (strcmp(name, dev->name) == 0) && z_device_ready(dev)) {
 			return dev;
 		}
 	}
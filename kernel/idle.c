@@ -119,6 +119,10 @@ static void sys_power_save_idle(void)
 
 void z_sys_power_save_idle_exit(int32_t ticks)
 {
+#ifdef CONFIG_SYS_PM_IDLE_PREDICT
+	sys_pm_idle_predict_exit();
+#endif
+
 #if defined(CONFIG_SYS_POWER_SLEEP_STATES)
 	/* Some CPU low power states require notification at the ISR
 	 * to allow any operations that needs to be done before kernel
@@ -194,6 +198,15 @@ void idle(void *p1, void *unused2, void *unused3)
 		k_yield();
 #else
 		(void)arch_irq_lock();
+#ifdef CONFIG_SCHED_CPU_PARKING
+		/* Parked CPUs are only woken up by an IPI, once the load
+		 * needs them: no timeout is programmed for them
+		 */
+		if (z_sched_cpu_park()) {
+			k_cpu_idle();
+			continue;
+		}
+#endif
 		sys_power_save_idle();
 		IDLE_YIELD_IF_COOP();
 #endif
@@ -284,6 +284,97 @@ int arch_mem_map(void *dest, uintptr_t addr, size_t size, uint32_t flags);
  * @param size Page-aligned region size
  */
 void arch_mem_unmap(void *addr, size_t size);
+
+#ifdef CONFIG_DEMAND_PAGING
+/**
+ * Update the page tables of an evicted page
+ *
+ * Mark the page non-present in all page tables, keeping the backing store
+ * location in the entry and the access permissions of the mapping, then
+ * invalidate the TLBs on all CPUs. The page is no longer accessible when
+ * this returns.
+ *
+ * This is called with interrupts locked.
+ *
+ * @param addr Page-aligned virtual address of the page
+ * @param location Page-aligned, non-zero backing store location
+ */
+void arch_mem_page_out(void *addr, uintptr_t location);
+
+/**
+ * Update the page tables of a page which was paged in
+ *
+ * Map the page present again, to a new physical address, with the access
+ * permissions it had when it was evicted and its accessed and dirty state
+ * cleared.
+ *
+ * This is called with interrupts locked.
+ *
+ * @param addr Page-aligned virtual address of the page
+ * @param phys Page-aligned physical address of its new page frame
+ */
+void arch_mem_page_in(void *addr, uintptr_t phys);
+
+/**
+ * Map the scratch page to a page frame
+ *
+ * Map the virtual page Z_SCRATCH_PAGE, read-write and supervisor-only, to
+ * the given page frame, which the backing store then reads or writes. Only
+ * the current CPU needs to see the mapping.
+ *
+ * This is called with interrupts locked.
+ *
+ * @param phys Page-aligned physical address of the page frame
+ */
+void arch_mem_scratch(uintptr_t phys);
+
+/** Status of a virtual page, see arch_page_location_get() */
+enum arch_page_location {
+	ARCH_PAGE_LOCATION_PAGED_OUT,
+	ARCH_PAGE_LOCATION_PAGED_IN,
+	ARCH_PAGE_LOCATION_BAD
+};
+
+/**
+ * Get where a virtual page is
+ *
+ * @param addr Page-aligned virtual address
+ * @param [out] location Physical address of the page if paged in, backing
+ *        store location if paged out
+ * @retval ARCH_PAGE_LOCATION_PAGED_IN The page is mapped and present
+ * @retval ARCH_PAGE_LOCATION_PAGED_OUT The page was evicted
+ * @retval ARCH_PAGE_LOCATION_BAD The page is not mapped
+ */
+enum arch_page_location arch_page_location_get(void *addr,
+					       uintptr_t *location);
+
+/** The page was accessed since its accessed state was last cleared */
+#define ARCH_DATA_PAGE_ACCESSED		BIT(0)
+
+/** The page was written to since it was mapped or paged in */
+#define ARCH_DATA_PAGE_DIRTY		BIT(1)
+
+/** The page is present, its physical address is valid */
+#define ARCH_DATA_PAGE_LOADED		BIT(2)
+
+/** The page is not mapped at all */
+#define ARCH_DATA_PAGE_NOT_MAPPED	BIT(3)
+
+/**
+ * Get the state of a virtual page, for the eviction algorithm
+ *
+ * The accessed and dirty state is gathered from all page tables.
+ *
+ * This is called with interrupts locked.
+ *
+ * @param addr Page-aligned virtual address
+ * @param [out] phys Physical address of the page if loaded, may be NULL
+ * @param clear_accessed Clear the accessed state of the page in all page
+ *        tables, the TLBs need not be invalidated
+ * @return ARCH_DATA_PAGE_* flags
+ */
+uintptr_t arch_page_info_get(void *addr, uintptr_t *phys, bool clear_accessed);
+#endif /* CONFIG_DEMAND_PAGING */
 #endif /* CONFIG_MMU */
 /** @} */
 
@@ -26,6 +26,12 @@ extern "C" {
 
 /* Early boot functions */
 
+/* Word-wise clear and copy of the boot sections, usable before the C
+ * library is set up
+ */
+void z_early_memset(void *dst, int c, size_t n);
+void z_early_memcpy(void *dst, const void *src, size_t n);
+
 void z_bss_zero(void);
 #ifdef CONFIG_XIP
 void z_data_copy(void);
@@ -61,6 +67,14 @@ extern char *z_setup_new_thread(struct k_thread *new_thread,
  */
 void *z_thread_malloc(size_t size);
 
+#if defined(CONFIG_THREAD_STACK_POOL) && defined(CONFIG_INIT_STACKS)
+/* Paints the buffer of a new thread's stack with 0xaa, skipping what is
+ * known to be still painted if the stack comes from the stack pool
+ */
+void z_thread_stack_pool_paint(k_thread_stack_t *stack, char *buf,
+			       size_t size);
+#endif
+
 /* set and clear essential thread flag */
 
 extern void z_thread_essential_set(void);
@@ -107,6 +121,8 @@ extern int z_stack_adjust_initialized;
 #endif
 
 #ifdef CONFIG_BOOT_TIME_MEASUREMENT
+extern uint32_t z_timestamp_pre_kernel; /* timestamp when PRE_KERNEL done */
+extern uint32_t z_timestamp_post_kernel; /* timestamp when POST_KERNEL done */
 extern uint32_t z_timestamp_main; /* timestamp when main task starts */
 extern uint32_t z_timestamp_idle; /* timestamp when CPU goes idle */
 #endif
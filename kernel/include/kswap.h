@@ -93,7 +93,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 
 	if (new_thread != old_thread) {
 #ifdef CONFIG_TIMESLICING
-		z_reset_time_slice();
+		z_reset_time_slice(new_thread);
 #endif
 
 		old_thread->swap_retval = -EAGAIN;
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef KERNEL_INCLUDE_MMU_H
+#define KERNEL_INCLUDE_MMU_H
+
+#ifdef CONFIG_MMU
+
+#include <stdint.h>
+#include <sys/slist.h>
+#include <sys/__assert.h>
+#include <sys/util.h>
+#include <sys/mem_manage.h>
+#include <linker/linker-defs.h>
+
+/*
+ * At boot, all of physical RAM is mapped at the beginning of the kernel
+ * virtual address space, RAM of the kernel image included.
+ */
+#define Z_PHYS_RAM_START	((uintptr_t)CONFIG_SRAM_BASE_ADDRESS)
+#define Z_PHYS_RAM_SIZE		((size_t)CONFIG_KERNEL_RAM_SIZE)
+#define Z_PHYS_RAM_END		(Z_PHYS_RAM_START + Z_PHYS_RAM_SIZE)
+#define Z_NUM_PAGE_FRAMES	(Z_PHYS_RAM_SIZE / CONFIG_MMU_PAGE_SIZE)
+
+#define Z_VIRT_RAM_START	((uint8_t *)CONFIG_KERNEL_VM_BASE)
+
+/* Boot-time virtual address of a RAM physical address, and back */
+#define Z_BOOT_PHYS_TO_VIRT(phys) \
+	(Z_VIRT_RAM_START + ((uintptr_t)(phys) - Z_PHYS_RAM_START))
+#define Z_BOOT_VIRT_TO_PHYS(virt) \
+	(((uint8_t *)(virt) - Z_VIRT_RAM_START) + Z_PHYS_RAM_START)
+
+/* RAM pages of the kernel image, mapped at boot */
+#define Z_KERNEL_VIRT_START	Z_VIRT_RAM_START
+#define Z_KERNEL_VIRT_END \
+	((uint8_t *)ROUND_UP((uintptr_t)_image_ram_end, CONFIG_MMU_PAGE_SIZE))
+
+/*
+ * Page frames: one per page of physical RAM
+ */
+
+/* Never evicted, the page is resident for as long as it is mapped */
+#define Z_PAGE_FRAME_PINNED	BIT(0)
+
+/* Mapped in the virtual address space, at the addr field */
+#define Z_PAGE_FRAME_MAPPED	BIT(1)
+
+/* Being paged in or out, not to be selected for eviction */
+#define Z_PAGE_FRAME_BUSY	BIT(2)
+
+struct z_page_frame {
+	union {
+		/* Virtual address the frame is mapped at, if mapped */
+		void *addr;
+
+		/* Node in the free page frame list, if not mapped */
+		sys_snode_t node;
+	};
+
+	uint8_t flags;
+};
+
+extern struct z_page_frame z_page_frames[Z_NUM_PAGE_FRAMES];
+
+static inline bool z_page_frame_is_pinned(struct z_page_frame *pf)
+{
+	return (pf->flags & Z_PAGE_FRAME_PINNED) != 0U;
+}
+
+static inline bool z_page_frame_is_mapped(struct z_page_frame *pf)
+{
+	return (pf->flags & Z_PAGE_FRAME_MAPPED) != 0U;
+}
+
+static inline bool z_page_frame_is_busy(struct z_page_frame *pf)
+{
+	return (pf->flags & Z_PAGE_FRAME_BUSY) != 0U;
+}
+
+/* A page frame the eviction algorithm may select */
+static inline bool z_page_frame_is_evictable(struct z_page_frame *pf)
+{
+	return (pf->flags & (Z_PAGE_FRAME_PINNED | Z_PAGE_FRAME_MAPPED |
+			     Z_PAGE_FRAME_BUSY)) == Z_PAGE_FRAME_MAPPED;
+}
+
+static inline uintptr_t z_page_frame_to_phys(struct z_page_frame *pf)
+{
+	return Z_PHYS_RAM_START +
+	       (uintptr_t)(pf - z_page_frames) * CONFIG_MMU_PAGE_SIZE;
+}
+
+static inline bool z_is_page_frame(uintptr_t phys)
+{
+	return phys >= Z_PHYS_RAM_START && phys < Z_PHYS_RAM_END;
+}
+
+static inline struct z_page_frame *z_phys_to_page_frame(uintptr_t phys)
+{
+	__ASSERT(z_is_page_frame(phys),
+		 "0x%lx not an SRAM physical address", phys);
+
+	return &z_page_frames[(phys - Z_PHYS_RAM_START) /
+			      CONFIG_MMU_PAGE_SIZE];
+}
+
+#define Z_PAGE_FRAME_FOREACH(_phys, _pageframe) \
+	for (_phys = Z_PHYS_RAM_START, _pageframe = z_page_frames; \
+	     _phys < Z_PHYS_RAM_END; \
+	     _phys += CONFIG_MMU_PAGE_SIZE, _pageframe++)
+
+/* Set up the page frames, called once at boot */
+void z_mem_manage_init(void);
+
+#ifdef CONFIG_DEMAND_PAGING
+/* Virtual page used to access a page frame being paged in or out, see
+ * arch_mem_scratch(). It is taken from the top of the address space.
+ */
+#define Z_SCRATCH_PAGE	((void *)((uintptr_t)CONFIG_KERNEL_VM_BASE + \
+				  (uintptr_t)CONFIG_KERNEL_VM_SIZE - \
+				  CONFIG_MMU_PAGE_SIZE))
+
+/**
+ * Handle a page fault on a page which may be paged out
+ *
+ * Called by the architecture's fault handler when a non-present page is
+ * accessed.
+ *
+ * @param addr Faulting virtual address
+ * @retval true The page was paged in, the faulting access must be retried
+ * @retval false The address is not mapped, this is a genuine fault
+ */
+bool z_page_fault(void *addr);
+#endif /* CONFIG_DEMAND_PAGING */
+
+#endif /* CONFIG_MMU */
+#endif /* KERNEL_INCLUDE_MMU_H */
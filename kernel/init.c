@@ -29,6 +29,7 @@
 #include <sys/dlist.h>
 #include <kernel_internal.h>
 #include <kswap.h>
+#include <mmu.h>
 #include <drivers/entropy.h>
 #include <logging/log_ctrl.h>
 #include <tracing/tracing.h>
@@ -52,6 +53,8 @@ LOG_MODULE_REGISTER(os);
 /* boot time measurement items */
 
 #ifdef CONFIG_BOOT_TIME_MEASUREMENT
+uint32_t __noinit z_timestamp_pre_kernel; /* timestamp when PRE_KERNEL done */
+uint32_t __noinit z_timestamp_post_kernel; /* timestamp when POST_KERNEL done */
 uint32_t __noinit z_timestamp_main;  /* timestamp when main task starts */
 uint32_t __noinit z_timestamp_idle;  /* timestamp when CPU goes idle */
 #endif
@@ -95,6 +98,109 @@ extern void idle(void *unused1, void *unused2, void *unused3);
  * some like x86 do this with optimized assembly
  */
 
+/*
+ * The sections cleared and copied at boot are word aligned and mostly
+ * large, the early routines store a word at a time, four in a row in the
+ * main loop, without the alignment handling of the C library ones. The C
+ * library may not be set up yet and, with some of them, brings byte loops
+ * to the boot path of a part whose RAM is several times larger than its
+ * caches.
+ */
+void z_early_memset(void *dst, int c, size_t n)
+{
+	uint8_t *d_byte = dst;
+	uintptr_t c_word = (uint8_t)c;
+
+	c_word |= c_word << 8;
+	c_word |= c_word << 16;
+#if UINTPTR_MAX > UINT32_MAX
+	c_word |= c_word << 32;
+#endif
+
+	if (((uintptr_t)d_byte & (sizeof(uintptr_t) - 1)) == 0U) {
+		uintptr_t *d_word = (uintptr_t *)d_byte;
+
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+		register uintptr_t r2 __asm__("r2") = c_word;
+		register uintptr_t r3 __asm__("r3") = c_word;
+		register uintptr_t r4 __asm__("r4") = c_word;
+		register uintptr_t r5 __asm__("r5") = c_word;
+
+		while (n >= 4 * sizeof(uintptr_t)) {
+			__asm__ volatile("stmia %0!, {r2-r5}"
+					 : "+r" (d_word)
+					 : "r" (r2), "r" (r3), "r" (r4),
+					   "r" (r5)
+					 : "memory");
+			n -= 4 * sizeof(uintptr_t);
+		}
+#else
+		while (n >= 4 * sizeof(uintptr_t)) {
+			d_word[0] = c_word;
+			d_word[1] = c_word;
+			d_word[2] = c_word;
+			d_word[3] = c_word;
+			d_word += 4;
+			n -= 4 * sizeof(uintptr_t);
+		}
+#endif
+		while (n >= sizeof(uintptr_t)) {
+			*(d_word++) = c_word;
+			n -= sizeof(uintptr_t);
+		}
+
+		d_byte = (uint8_t *)d_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = (uint8_t)c;
+		n--;
+	}
+}
+
+void z_early_memcpy(void *dst, const void *src, size_t n)
+{
+	uint8_t *d_byte = dst;
+	const uint8_t *s_byte = src;
+
+	if ((((uintptr_t)d_byte | (uintptr_t)s_byte) &
+	     (sizeof(uintptr_t) - 1)) == 0U) {
+		uintptr_t *d_word = (uintptr_t *)d_byte;
+		const uintptr_t *s_word = (const uintptr_t *)s_byte;
+
+		while (n >= 4 * sizeof(uintptr_t)) {
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+			__asm__ volatile("ldmia %1!, {r2-r5}\n\t"
+					 "stmia %0!, {r2-r5}"
+					 : "+r" (d_word), "+r" (s_word)
+					 :
+					 : "r2", "r3", "r4", "r5", "memory");
+#else
+			d_word[0] = s_word[0];
+			d_word[1] = s_word[1];
+			d_word[2] = s_word[2];
+			d_word[3] = s_word[3];
+			d_word += 4;
+			s_word += 4;
+#endif
+			n -= 4 * sizeof(uintptr_t);
+		}
+
+		while (n >= sizeof(uintptr_t)) {
+			*(d_word++) = *(s_word++);
+			n -= sizeof(uintptr_t);
+		}
+
+		d_byte = (uint8_t *)d_word;
+		s_byte = (const uint8_t *)s_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+}
+
 /**
  *
  * @brief Clear BSS
@@ -105,14 +211,16 @@ extern void idle(void *unused1, void *unused2, void *unused3);
  */
 void z_bss_zero(void)
 {
-	(void)memset(__bss_start, 0, __bss_end - __bss_start);
+	z_early_memset(__bss_start, 0, __bss_end - __bss_start);
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_ccm), okay)
-	(void)memset(&__ccm_bss_start, 0,
-		     ((uint32_t) &__ccm_bss_end - (uint32_t) &__ccm_bss_start));
+	z_early_memset(&__ccm_bss_start, 0,
+		       ((uint32_t) &__ccm_bss_end -
+			(uint32_t) &__ccm_bss_start));
 #endif
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_dtcm), okay)
-	(void)memset(&__dtcm_bss_start, 0,
-		     ((uint32_t) &__dtcm_bss_end - (uint32_t) &__dtcm_bss_start));
+	z_early_memset(&__dtcm_bss_start, 0,
+		       ((uint32_t) &__dtcm_bss_end -
+			(uint32_t) &__dtcm_bss_start));
 #endif
 #ifdef CONFIG_CODE_DATA_RELOCATION
 	extern void bss_zeroing_relocation(void);
@@ -120,8 +228,9 @@ void z_bss_zero(void)
 	bss_zeroing_relocation();
 #endif	/* CONFIG_CODE_DATA_RELOCATION */
 #ifdef CONFIG_COVERAGE_GCOV
-	(void)memset(&__gcov_bss_start, 0,
-		 ((uint32_t) &__gcov_bss_end - (uint32_t) &__gcov_bss_start));
+	z_early_memset(&__gcov_bss_start, 0,
+		       ((uint32_t) &__gcov_bss_end -
+			(uint32_t) &__gcov_bss_start));
 #endif
 }
 
@@ -141,19 +250,19 @@ extern volatile uintptr_t __stack_chk_guard;
  */
 void z_data_copy(void)
 {
-	(void)memcpy(&__data_ram_start, &__data_rom_start,
-		 __data_ram_end - __data_ram_start);
+	z_early_memcpy(&__data_ram_start, &__data_rom_start,
+		       __data_ram_end - __data_ram_start);
 #ifdef CONFIG_ARCH_HAS_RAMFUNC_SUPPORT
-	(void)memcpy(&_ramfunc_ram_start, &_ramfunc_rom_start,
-		 (uintptr_t) &_ramfunc_ram_size);
+	z_early_memcpy(&_ramfunc_ram_start, &_ramfunc_rom_start,
+		       (uintptr_t) &_ramfunc_ram_size);
 #endif /* CONFIG_ARCH_HAS_RAMFUNC_SUPPORT */
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_ccm), okay)
-	(void)memcpy(&__ccm_data_start, &__ccm_data_rom_start,
-		 __ccm_data_end - __ccm_data_start);
+	z_early_memcpy(&__ccm_data_start, &__ccm_data_rom_start,
+		       __ccm_data_end - __ccm_data_start);
 #endif
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_dtcm), okay)
-	(void)memcpy(&__dtcm_data_start, &__dtcm_data_rom_start,
-		 __dtcm_data_end - __dtcm_data_start);
+	z_early_memcpy(&__dtcm_data_start, &__dtcm_data_rom_start,
+		       __dtcm_data_end - __dtcm_data_start);
 #endif
 #ifdef CONFIG_CODE_DATA_RELOCATION
 	extern void data_copy_xip_relocation(void);
@@ -180,8 +289,8 @@ void z_data_copy(void)
 	}
 	__stack_chk_guard = guard_copy;
 #else
-	(void)memcpy(&_app_smem_start, &_app_smem_rom_start,
-		 _app_smem_end - _app_smem_start);
+	z_early_memcpy(&_app_smem_start, &_app_smem_rom_start,
+		       _app_smem_end - _app_smem_start);
 #endif /* CONFIG_STACK_CANARIES */
 #endif /* CONFIG_USERSPACE */
 }
@@ -215,6 +324,9 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	z_sys_post_kernel = true;
 
 	z_sys_init_run_level(_SYS_INIT_LEVEL_POST_KERNEL);
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	z_timestamp_post_kernel = k_cycle_get_32();
+#endif
 #if CONFIG_STACK_POINTER_RANDOM
 	z_stack_adjust_initialized = 1;
 #endif
@@ -459,6 +571,11 @@ FUNC_NORETURN void z_cstart(void)
 	/* perform any architecture-specific initialization */
 	arch_kernel_init();
 
+#ifdef CONFIG_MMU
+	/* The page frames must be known before anything is mapped */
+	z_mem_manage_init();
+#endif
+
 #if defined(CONFIG_MULTITHREADING)
 	/* Note: The z_ready_thread() call in prepare_multithreading() requires
 	 * a dummy thread even if CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN=y
@@ -471,6 +588,10 @@ FUNC_NORETURN void z_cstart(void)
 	/* perform basic hardware initialization */
 	z_sys_init_run_level(_SYS_INIT_LEVEL_PRE_KERNEL_1);
 	z_sys_init_run_level(_SYS_INIT_LEVEL_PRE_KERNEL_2);
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	/* The system timer, which counts the cycles, is up from here */
+	z_timestamp_pre_kernel = k_cycle_get_32();
+#endif
 
 #ifdef CONFIG_STACK_CANARIES
 	uintptr_t stack_guard;
@@ -64,6 +64,34 @@ void k_heap_free(struct k_heap *h, void *mem)
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *h, struct sys_memory_stats *stats)
+{
+	if (h == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_runtime_stats_get(&h->heap, stats);
+
+	k_spin_unlock(&h->lock, key);
+	return ret;
+}
+
+int k_heap_runtime_stats_reset_max(struct k_heap *h)
+{
+	if (h == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_runtime_stats_reset_max(&h->heap);
+
+	k_spin_unlock(&h->lock, key);
+	return ret;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 #ifdef CONFIG_MEM_POOL_HEAP_BACKEND
 /* Compatibility layer for legacy k_mem_pool code on top of a k_heap
  * backend.
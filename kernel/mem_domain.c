@@ -138,18 +138,14 @@ void k_mem_domain_init(struct k_mem_domain *domain, uint8_t num_parts,
 	k_spin_unlock(&z_mem_domain_lock, key);
 }
 
-void k_mem_domain_add_partition(struct k_mem_domain *domain,
-				struct k_mem_partition *part)
+static void add_partition_locked(struct k_mem_domain *domain,
+				 struct k_mem_partition *part)
 {
 	int p_idx;
-	k_spinlock_key_t key;
 
-	__ASSERT_NO_MSG(domain != NULL);
 	__ASSERT(check_add_partition(domain, part),
 		 "invalid partition %p", part);
 
-	key = k_spin_lock(&z_mem_domain_lock);
-
 	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
 		/* A zero-sized partition denotes it's a free partition */
 		if (domain->partitions[p_idx].size == 0U) {
@@ -172,20 +168,15 @@ void k_mem_domain_add_partition(struct k_mem_domain *domain,
 #ifdef CONFIG_ARCH_MEM_DOMAIN_SYNCHRONOUS_API
 	arch_mem_domain_partition_add(domain, p_idx);
 #endif
-	k_spin_unlock(&z_mem_domain_lock, key);
 }
 
-void k_mem_domain_remove_partition(struct k_mem_domain *domain,
-				  struct k_mem_partition *part)
+static void remove_partition_locked(struct k_mem_domain *domain,
+				    struct k_mem_partition *part)
 {
 	int p_idx;
-	k_spinlock_key_t key;
 
-	__ASSERT_NO_MSG(domain != NULL);
 	__ASSERT_NO_MSG(part != NULL);
 
-	key = k_spin_lock(&z_mem_domain_lock);
-
 	/* find a partition that matches the given start and size */
 	for (p_idx = 0; p_idx < max_partitions; p_idx++) {
 		if (domain->partitions[p_idx].start == part->start &&
@@ -207,6 +198,63 @@ void k_mem_domain_remove_partition(struct k_mem_domain *domain,
 	domain->partitions[p_idx].size = 0U;
 
 	domain->num_partitions--;
+}
+
+void k_mem_domain_add_partition(struct k_mem_domain *domain,
+				struct k_mem_partition *part)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(domain != NULL);
+
+	key = k_spin_lock(&z_mem_domain_lock);
+	add_partition_locked(domain, part);
+	k_spin_unlock(&z_mem_domain_lock, key);
+}
+
+void k_mem_domain_remove_partition(struct k_mem_domain *domain,
+				  struct k_mem_partition *part)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(domain != NULL);
+
+	key = k_spin_lock(&z_mem_domain_lock);
+	remove_partition_locked(domain, part);
+	k_spin_unlock(&z_mem_domain_lock, key);
+}
+
+void k_mem_domain_update(struct k_mem_domain *domain,
+			 struct k_mem_partition *remove[], uint8_t num_remove,
+			 struct k_mem_partition *add[], uint8_t num_add)
+{
+	k_spinlock_key_t key;
+	uint8_t i;
+
+	__ASSERT_NO_MSG(domain != NULL);
+	__ASSERT(num_remove == 0U || remove != NULL,
+		 "remove array is NULL and num_remove is nonzero");
+	__ASSERT(num_add == 0U || add != NULL,
+		 "add array is NULL and num_add is nonzero");
+
+	key = k_spin_lock(&z_mem_domain_lock);
+
+#ifdef CONFIG_ARCH_MEM_DOMAIN_SYNCHRONOUS_API
+	arch_mem_domain_update_begin(domain);
+#endif
+
+	/* Removals first, partitions added may overlap the removed ones */
+	for (i = 0U; i < num_remove; i++) {
+		remove_partition_locked(domain, remove[i]);
+	}
+
+	for (i = 0U; i < num_add; i++) {
+		add_partition_locked(domain, add[i]);
+	}
+
+#ifdef CONFIG_ARCH_MEM_DOMAIN_SYNCHRONOUS_API
+	arch_mem_domain_update_end(domain);
+#endif
 
 	k_spin_unlock(&z_mem_domain_lock, key);
 }
@@ -88,6 +88,13 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	(void)atomic_set(&slab->cache_waiters, 0);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		slab->cache[i].lock = (struct k_spinlock) {};
+		slab->cache[i].count = 0U;
+	}
+#endif
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -101,8 +108,148 @@ out:
 	return rc;
 }
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+
+#define CACHE_SIZE CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE
+#define CACHE_BATCH (CACHE_SIZE / 2)
+
+/*
+ * Lock order is cache lock, then the slab lock. Interrupts stay masked
+ * from picking the local cache until it is unlocked, so the thread can't
+ * migrate in between; the cache lock itself is only contended when a
+ * CPU is reclaiming the other caches.
+ */
+struct cache_key {
+	unsigned int irq;
+	k_spinlock_key_t key;
+};
+
+static struct z_mem_slab_cache *cache_lock(struct k_mem_slab *slab,
+					   struct cache_key *ck)
+{
+	struct z_mem_slab_cache *cache;
+
+	ck->irq = arch_irq_lock();
+	cache = &slab->cache[_current_cpu->id];
+	ck->key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct z_mem_slab_cache *cache, struct cache_key *ck)
+{
+	k_spin_unlock(&cache->lock, ck->key);
+	arch_irq_unlock(ck->irq);
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct cache_key ck;
+	struct z_mem_slab_cache *cache = cache_lock(slab, &ck);
+	bool found;
+
+	if (cache->count == 0U) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		while ((cache->count < CACHE_BATCH) &&
+		       (slab->free_list != NULL)) {
+			cache->blocks[cache->count++] = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+			slab->num_used++;
+		}
+		k_spin_unlock(&lock, key);
+	}
+
+	found = cache->count != 0U;
+	if (found) {
+		*mem = cache->blocks[--cache->count];
+	}
+
+	cache_unlock(cache, &ck);
+
+	return found;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void **mem)
+{
+	struct cache_key ck;
+	struct z_mem_slab_cache *cache = cache_lock(slab, &ck);
+
+	/* Somebody is about to wait for a block: hand this one over
+	 * through the slab lock instead of hiding it in a cache.
+	 */
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		cache_unlock(cache, &ck);
+		return false;
+	}
+
+	if (cache->count == CACHE_SIZE) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		while (cache->count > (CACHE_SIZE - CACHE_BATCH)) {
+			char *block = cache->blocks[--cache->count];
+
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			slab->num_used--;
+		}
+		k_spin_unlock(&lock, key);
+	}
+
+	cache->blocks[cache->count++] = *mem;
+	cache_unlock(cache, &ck);
+
+	return true;
+}
+
+/* Return every cached block to the slab free list */
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_cache *cache = &slab->cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		while (cache->count != 0U) {
+			char *block = cache->blocks[--cache->count];
+
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			slab->num_used--;
+		}
+		k_spin_unlock(&lock, key);
+		k_spin_unlock(&cache->lock, ckey);
+	}
+}
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
+static inline void cache_waiter_put(struct k_mem_slab *slab,
+				    k_timeout_t timeout)
+{
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		(void)atomic_dec(&slab->cache_waiters);
+	}
+#endif
+}
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		return 0;
+	}
+
+	/* The free list is empty, but other CPUs may still be holding
+	 * blocks. Advertise a potential waiter first so that concurrent
+	 * frees bypass the caches, then pull everything back.
+	 */
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		(void)atomic_inc(&slab->cache_waiters);
+	}
+	cache_reclaim(slab);
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	int result;
 
@@ -122,16 +269,24 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
+		cache_waiter_put(slab, timeout);
 		return result;
 	}
 
 	k_spin_unlock(&lock, key);
+	cache_waiter_put(slab, timeout);
 
 	return result;
 }
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (cache_free(slab, mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
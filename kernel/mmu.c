@@ -7,8 +7,10 @@
  */
 
  #include <stdint.h>
+ #include <string.h>
  #include <kernel_arch_interface.h>
  #include <spinlock.h>
+ #include <mmu.h>
 
 #define LOG_LEVEL CONFIG_KERNEL_LOG_LEVEL
 #include <logging/log.h>
@@ -55,9 +57,14 @@ static struct k_spinlock mm_lock;
   *
   * All of this is under heavy development and is subject to change.
   */
+#ifdef CONFIG_DEMAND_PAGING
+/* The top page is the scratch page */
+static uint8_t *mapping_pos = Z_SCRATCH_PAGE;
+#else
 static uint8_t *mapping_pos =
 		(uint8_t *)((uintptr_t)CONFIG_KERNEL_VM_BASE +
 			    (uintptr_t)CONFIG_KERNEL_VM_SIZE);
+#endif
 
 /* Lower-limit of virtual address mapping. Immediately below this is the
  * permanent identity mapping for all SRAM.
@@ -66,6 +73,21 @@ static uint8_t *mapping_limit =
 	(uint8_t *)((uintptr_t)CONFIG_KERNEL_VM_BASE +
 		    (size_t)CONFIG_KERNEL_RAM_SIZE);
 
+/* Carve out some unused virtual memory from the top of the address space.
+ * Must be called with mm_lock held.
+ */
+static uint8_t *virt_region_get(size_t size)
+{
+	if ((mapping_pos - size) < mapping_limit) {
+		LOG_ERR("insufficient kernel virtual address space");
+		return NULL;
+	}
+
+	mapping_pos -= size;
+
+	return mapping_pos;
+}
+
 size_t k_mem_region_align(uintptr_t *aligned_addr, size_t *aligned_size,
 			  uintptr_t phys_addr, size_t size, size_t align)
 {
@@ -96,15 +118,10 @@ void z_mem_map(uint8_t **virt_addr, uintptr_t phys_addr, size_t size,
 
 	key = k_spin_lock(&mm_lock);
 
-	/* Carve out some unused virtual memory from the top of the
-	 * address space
-	 */
-	if ((mapping_pos - aligned_size) < mapping_limit) {
-		LOG_ERR("insufficient kernel virtual address space");
+	dest_virt = virt_region_get(aligned_size);
+	if (dest_virt == NULL) {
 		goto fail;
 	}
-	mapping_pos -= aligned_size;
-	dest_virt = mapping_pos;
 
 	LOG_DBG("arch_mem_map(%p, 0x%lx, %zu, %x) offset %lu\n", dest_virt,
 		aligned_addr, aligned_size, flags, addr_offset);
@@ -138,3 +155,384 @@ fail:
 		phys_addr, size, flags);
 	k_panic();
 }
+
+/*
+ * Page frame management
+ */
+
+struct z_page_frame z_page_frames[Z_NUM_PAGE_FRAMES];
+
+/* Page frames not mapped anywhere */
+static sys_slist_t free_page_frame_list;
+static size_t free_page_frame_count;
+
+static void free_page_frame_list_put(struct z_page_frame *pf)
+{
+	pf->flags = 0U;
+	sys_slist_append(&free_page_frame_list, &pf->node);
+	free_page_frame_count++;
+}
+
+static struct z_page_frame *free_page_frame_list_get(void)
+{
+	sys_snode_t *node = sys_slist_get(&free_page_frame_list);
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	free_page_frame_count--;
+
+	return CONTAINER_OF(node, struct z_page_frame, node);
+}
+
+static void frame_mapped_set(struct z_page_frame *pf, void *addr)
+{
+	pf->flags |= Z_PAGE_FRAME_MAPPED;
+	pf->addr = addr;
+}
+
+size_t k_mem_free_get(void)
+{
+	return free_page_frame_count;
+}
+
+#ifdef CONFIG_DEMAND_PAGING
+static struct k_mem_paging_stats_t paging_stats;
+
+/* Evict the page mapped to pf, leaving pf unmapped. Called with mm_lock
+ * held.
+ */
+static int page_frame_evict(struct z_page_frame *pf, bool dirty,
+			    bool page_fault)
+{
+	uintptr_t location;
+	int ret;
+
+	__ASSERT(z_page_frame_is_evictable(pf), "page frame %p not evictable",
+		 pf);
+
+	ret = k_mem_paging_backing_store_location_get(pf, &location,
+						      page_fault);
+	if (ret != 0) {
+		LOG_ERR("no backing store location for %p", pf->addr);
+		return ret;
+	}
+
+	/* Once non-present, no other CPU can write to the page while it is
+	 * copied. The backing store copy is released on page-in, so clean
+	 * pages are written back too.
+	 */
+	pf->flags |= Z_PAGE_FRAME_BUSY;
+	arch_mem_page_out(pf->addr, location);
+	arch_mem_scratch(z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_out(location);
+	pf->flags = 0U;
+	pf->addr = NULL;
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	if (dirty) {
+		paging_stats.evictions_dirty++;
+	} else {
+		paging_stats.evictions_clean++;
+	}
+#endif
+
+	return 0;
+}
+
+/* Get a free page frame, evicting a page if there is none. Called with
+ * mm_lock held.
+ */
+static struct z_page_frame *page_frame_get(bool page_fault)
+{
+	struct z_page_frame *pf = free_page_frame_list_get();
+	bool dirty;
+
+	if (pf != NULL) {
+		return pf;
+	}
+
+	pf = k_mem_paging_eviction_select(&dirty);
+	if (pf == NULL || page_frame_evict(pf, dirty, page_fault) != 0) {
+		return NULL;
+	}
+
+	return pf;
+}
+
+/* Make the page at addr resident, pinning it if requested. Called with
+ * mm_lock held.
+ */
+static bool do_page_in(void *addr, bool pin, bool page_fault)
+{
+	enum arch_page_location status;
+	struct z_page_frame *pf;
+	uintptr_t location, phys;
+
+	status = arch_page_location_get(addr, &location);
+	if (status == ARCH_PAGE_LOCATION_BAD) {
+		return false;
+	}
+
+	if (status == ARCH_PAGE_LOCATION_PAGED_IN) {
+		/* Possibly paged in by another CPU while this one waited for
+		 * the lock
+		 */
+		if (!z_is_page_frame(location)) {
+			/* Not RAM, a device mapping for instance */
+			return true;
+		}
+		pf = z_phys_to_page_frame(location);
+	} else {
+		pf = page_frame_get(page_fault);
+		if (pf == NULL) {
+			LOG_ERR("no page frame to page in %p", addr);
+			return false;
+		}
+
+		phys = z_page_frame_to_phys(pf);
+		pf->flags |= Z_PAGE_FRAME_BUSY;
+		arch_mem_scratch(phys);
+		k_mem_paging_backing_store_page_in(location);
+		k_mem_paging_backing_store_location_free(location);
+		arch_mem_page_in(addr, phys);
+		pf->flags &= ~Z_PAGE_FRAME_BUSY;
+		frame_mapped_set(pf, addr);
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+		if (page_fault) {
+			paging_stats.pagefaults++;
+		}
+#endif
+	}
+
+	if (pin) {
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+	}
+
+	return true;
+}
+
+bool z_page_fault(void *addr)
+{
+	k_spinlock_key_t key;
+	bool ret;
+
+	addr = (void *)ROUND_DOWN((uintptr_t)addr, CONFIG_MMU_PAGE_SIZE);
+
+	key = k_spin_lock(&mm_lock);
+	ret = do_page_in(addr, false, true);
+	k_spin_unlock(&mm_lock, key);
+
+	return ret;
+}
+
+static void page_in_region(void *addr, size_t size, bool pin)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT((((uintptr_t)addr | size) & (CONFIG_MMU_PAGE_SIZE - 1)) == 0U,
+		 "unaligned region %p (size %zu)", addr, size);
+
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		key = k_spin_lock(&mm_lock);
+		(void)do_page_in((uint8_t *)addr + offset, pin, false);
+		k_spin_unlock(&mm_lock, key);
+	}
+}
+
+void k_mem_page_in(void *addr, size_t size)
+{
+	page_in_region(addr, size, false);
+}
+
+void k_mem_pin(void *addr, size_t size)
+{
+	page_in_region(addr, size, true);
+}
+
+void k_mem_unpin(void *addr, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&mm_lock);
+	uintptr_t phys;
+
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		if (arch_page_location_get((uint8_t *)addr + offset, &phys) ==
+		    ARCH_PAGE_LOCATION_PAGED_IN && z_is_page_frame(phys)) {
+			z_phys_to_page_frame(phys)->flags &=
+				~Z_PAGE_FRAME_PINNED;
+		}
+	}
+
+	k_spin_unlock(&mm_lock, key);
+}
+
+int k_mem_page_out(void *addr, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&mm_lock);
+	enum arch_page_location status;
+	struct z_page_frame *pf;
+	uintptr_t phys, flags;
+	int ret = 0;
+
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		void *page = (uint8_t *)addr + offset;
+
+		status = arch_page_location_get(page, &phys);
+		if (status == ARCH_PAGE_LOCATION_PAGED_OUT) {
+			continue;
+		} else if (status == ARCH_PAGE_LOCATION_BAD) {
+			ret = -EFAULT;
+			break;
+		}
+
+		if (!z_is_page_frame(phys)) {
+			ret = -EPERM;
+			break;
+		}
+
+		pf = z_phys_to_page_frame(phys);
+		if (!z_page_frame_is_mapped(pf) || z_page_frame_is_pinned(pf)) {
+			ret = -EPERM;
+			break;
+		}
+
+		flags = arch_page_info_get(page, NULL, false);
+		ret = page_frame_evict(pf, (flags & ARCH_DATA_PAGE_DIRTY) != 0U,
+				       false);
+		if (ret != 0) {
+			break;
+		}
+
+		free_page_frame_list_put(pf);
+	}
+
+	k_spin_unlock(&mm_lock, key);
+
+	return ret;
+}
+
+void k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&mm_lock);
+
+	*stats = paging_stats;
+	k_spin_unlock(&mm_lock, key);
+}
+#endif /* CONFIG_DEMAND_PAGING */
+
+/* Map a page frame at addr, evicting a page to make room if needed.
+ * Called with mm_lock held.
+ */
+static int map_anon_page(void *addr, uint32_t flags)
+{
+	struct z_page_frame *pf;
+	int ret;
+
+#ifdef CONFIG_DEMAND_PAGING
+	pf = page_frame_get(false);
+#else
+	pf = free_page_frame_list_get();
+#endif
+	if (pf == NULL) {
+		return -ENOMEM;
+	}
+
+	ret = arch_mem_map(addr, z_page_frame_to_phys(pf), CONFIG_MMU_PAGE_SIZE,
+			   (flags & ~K_MEM_CACHE_MASK) | K_MEM_CACHE_WB);
+	if (ret != 0) {
+		free_page_frame_list_put(pf);
+		return ret;
+	}
+
+	frame_mapped_set(pf, addr);
+
+	return 0;
+}
+
+void *k_mem_map(size_t size, uint32_t flags)
+{
+	k_spinlock_key_t key;
+	uint8_t *dst;
+	int ret = 0;
+
+	__ASSERT((size % CONFIG_MMU_PAGE_SIZE) == 0U, "unaligned size %zu",
+		 size);
+
+	key = k_spin_lock(&mm_lock);
+
+	dst = virt_region_get(size);
+	if (dst == NULL) {
+		goto out;
+	}
+
+	/* NOTE: pages already mapped are neither unmapped nor is the virtual
+	 * region given back if this fails, mappings are permanent for now.
+	 */
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		ret = map_anon_page(dst + offset, flags | K_MEM_PERM_RW);
+		if (ret != 0) {
+			LOG_ERR("anonymous mapping of %zu bytes failed (%d)",
+				size, ret);
+			dst = NULL;
+			goto out;
+		}
+	}
+
+out:
+	k_spin_unlock(&mm_lock, key);
+
+	/* Page faults may happen here with demand paging, don't hold the
+	 * lock
+	 */
+	if (dst != NULL) {
+		(void)memset(dst, 0, size);
+	}
+
+	return dst;
+}
+
+#if defined(CONFIG_NEWLIB_LIBC) && !CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+/* Newlib uses all the RAM past the kernel image as its heap arena */
+#define PINNED_RAM_END	(Z_VIRT_RAM_START + Z_PHYS_RAM_SIZE)
+#else
+#define PINNED_RAM_END	Z_KERNEL_VIRT_END
+#endif
+
+void z_mem_manage_init(void)
+{
+	struct z_page_frame *pf;
+	uintptr_t phys;
+	uint8_t *addr;
+	k_spinlock_key_t key = k_spin_lock(&mm_lock);
+
+	/* All the pages of the kernel image are mapped at boot, at the same
+	 * offset in the RAM mapping as in physical memory. They hold the
+	 * page tables and the code and data the page fault path and the
+	 * interrupt handlers depend on, so all of them start pinned, see
+	 * k_mem_unpin().
+	 */
+	for (addr = Z_KERNEL_VIRT_START; addr < PINNED_RAM_END;
+	     addr += CONFIG_MMU_PAGE_SIZE) {
+		pf = z_phys_to_page_frame((uintptr_t)Z_BOOT_VIRT_TO_PHYS(addr));
+		frame_mapped_set(pf, addr);
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+	}
+
+	/* The remaining RAM is free for runtime mappings */
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_mapped(pf)) {
+			free_page_frame_list_put(pf);
+		}
+	}
+
+	LOG_DBG("%zu free page frames", free_page_frame_count);
+
+#ifdef CONFIG_DEMAND_PAGING
+	k_mem_paging_backing_store_init();
+	k_mem_paging_eviction_init();
+#endif
+
+	k_spin_unlock(&mm_lock, key);
+}
@@ -171,6 +171,105 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *q, const void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+/* Copy num messages into the ring buffer, splitting across the wrap */
+static void msgq_ring_write(struct k_msgq *msgq, const char *data,
+			    uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t tail = msgq->buffer_end - msgq->write_ptr;
+
+	if (len >= tail) {
+		(void)memcpy(msgq->write_ptr, data, tail);
+		data += tail;
+		len -= tail;
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	(void)memcpy(msgq->write_ptr, data, len);
+	msgq->write_ptr += len;
+	msgq->used_msgs += num;
+}
+
+/* Copy num messages out of the ring buffer, splitting across the wrap */
+static void msgq_ring_read(struct k_msgq *msgq, char *data, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t tail = msgq->buffer_end - msgq->read_ptr;
+
+	if (len >= tail) {
+		(void)memcpy(data, msgq->read_ptr, tail);
+		data += tail;
+		len -= tail;
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	(void)memcpy(data, msgq->read_ptr, len);
+	msgq->read_ptr += len;
+	msgq->used_msgs -= num;
+}
+
+int z_impl_k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t num,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t room;
+
+	if (num == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == msgq->max_msgs) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for room for the first message, like k_msgq_put() */
+		_current->base.swap_data = (void *) data;
+		int ret = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		return (ret == 0) ? 1 : ret;
+	}
+
+	/* threads only wait to read while the queue is empty: hand them
+	 * the first messages directly
+	 */
+	while (count < num &&
+	       (pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		(void)memcpy(pending_thread->base.swap_data, src,
+			     msgq->msg_size);
+		src += msgq->msg_size;
+		count++;
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	}
+
+	room = MIN(num - count, msgq->max_msgs - msgq->used_msgs);
+	msgq_ring_write(msgq, src, room);
+	count += room;
+
+	z_reschedule(&msgq->lock, key);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_n(struct k_msgq *q, const void *data,
+				      uint32_t num, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num, q->msg_size));
+
+	return z_impl_k_msgq_put_n(q, data, num, timeout);
+}
+#include <syscalls/k_msgq_put_n_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -253,6 +352,62 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *q, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count;
+
+	if (num == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for the first message, like k_msgq_get() */
+		_current->base.swap_data = data;
+		int ret = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		return (ret == 0) ? 1 : ret;
+	}
+
+	count = MIN(num, msgq->used_msgs);
+	msgq_ring_read(msgq, data, count);
+
+	/* refill the freed room from threads waiting to write (if any) */
+	while (msgq->used_msgs < msgq->max_msgs &&
+	       (pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		msgq_ring_write(msgq, pending_thread->base.swap_data, 1U);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	}
+
+	z_reschedule(&msgq->lock, key);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_n(struct k_msgq *q, void *data,
+				      uint32_t num, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num, q->msg_size));
+
+	return z_impl_k_msgq_get_n(q, data, num, timeout);
+}
+#include <syscalls/k_msgq_get_n_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -37,6 +37,7 @@
 #include <debug/object_tracing_common.h>
 #include <tracing/tracing.h>
 #include <sys/check.h>
+#include <sys/mutex.h>
 #include <logging/log.h>
 LOG_MODULE_DECLARE(os);
 
@@ -290,3 +291,188 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+/*
+ * Contended paths of the sys_mutex fast mutexes. While SYS_MUTEX_CONTENDED
+ * is set in the mutex word, the backing k_mutex records the owner and its
+ * original priority and holds the waiters, so the usual priority
+ * inheritance rules apply. Once the last waiter is gone, ownership is
+ * handed back to the mutex word alone and the owner may unlock with an
+ * atomic op again.
+ */
+
+static struct k_thread *sys_mutex_owner(atomic_val_t val)
+{
+	/* The mutex word lives in user memory: only trust it if it names
+	 * an initialized thread object
+	 */
+	struct k_thread *thread = (struct k_thread *)(val & ~SYS_MUTEX_CONTENDED);
+	struct z_object *ko = z_object_find(thread);
+
+	if (ko == NULL || ko->type != K_OBJ_THREAD ||
+	    (ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return NULL;
+	}
+
+	return thread;
+}
+
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex,
+			       struct k_mutex *kernel_mutex,
+			       k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	atomic_val_t val;
+	struct k_thread *owner;
+	int new_prio;
+	bool resched = false;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		val = atomic_get(&mutex->val);
+
+		if (val == 0) {
+			if (atomic_cas(&mutex->val, 0, self)) {
+				k_spin_unlock(&lock, key);
+				return 0;
+			}
+		} else if ((val & ~SYS_MUTEX_CONTENDED) == self) {
+			mutex->lock_count++;
+			k_spin_unlock(&lock, key);
+			return 0;
+		} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		} else if ((val & SYS_MUTEX_CONTENDED) != 0 ||
+			   atomic_cas(&mutex->val, val,
+				      val | SYS_MUTEX_CONTENDED)) {
+			break;
+		}
+	}
+
+	/* The owner can no longer release the mutex without us */
+	if (kernel_mutex->owner == NULL) {
+		owner = sys_mutex_owner(val);
+		if (owner == NULL) {
+			k_spin_unlock(&lock, key);
+			return -EINVAL;
+		}
+
+		kernel_mutex->owner = owner;
+		kernel_mutex->lock_count = 1U;
+		kernel_mutex->owner_orig_prio = owner->base.prio;
+	}
+
+	new_prio = new_prio_for_inheritance(_current->base.prio,
+					    kernel_mutex->owner->base.prio);
+
+	LOG_DBG("adjusting prio up on sys_mutex %p", mutex);
+
+	if (z_is_prio_higher(new_prio, kernel_mutex->owner->base.prio)) {
+		resched = adjust_owner_prio(kernel_mutex, new_prio);
+	}
+
+	int got_mutex = z_pend_curr(&lock, key, &kernel_mutex->wait_q,
+				    timeout);
+
+	if (got_mutex == 0) {
+		/* The unlocking thread stored our ID in the mutex word */
+		return 0;
+	}
+
+	/* timed out */
+
+	key = k_spin_lock(&lock);
+
+	if (kernel_mutex->owner != NULL) {
+		struct k_thread *waiter = z_waitq_head(&kernel_mutex->wait_q);
+
+		new_prio = (waiter != NULL) ?
+			new_prio_for_inheritance(waiter->base.prio,
+						 kernel_mutex->owner_orig_prio) :
+			kernel_mutex->owner_orig_prio;
+
+		LOG_DBG("adjusting prio down on sys_mutex %p", mutex);
+
+		resched = adjust_owner_prio(kernel_mutex, new_prio) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return -EAGAIN;
+}
+
+int z_sys_mutex_unlock_contended(struct sys_mutex *mutex,
+				 struct k_mutex *kernel_mutex)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	atomic_val_t val;
+	struct k_thread *new_owner;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+	val = atomic_get(&mutex->val);
+
+	if (val == 0) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	if ((val & ~SYS_MUTEX_CONTENDED) != self) {
+		k_spin_unlock(&lock, key);
+		return -EPERM;
+	}
+
+	if (mutex->lock_count != 0U) {
+		mutex->lock_count--;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	if (kernel_mutex->owner == _current) {
+		adjust_owner_prio(kernel_mutex, kernel_mutex->owner_orig_prio);
+	}
+
+	new_owner = z_unpend_first_thread(&kernel_mutex->wait_q);
+
+	LOG_DBG("new owner of sys_mutex %p: %p (prio: %d)",
+		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+
+	if (new_owner == NULL) {
+		kernel_mutex->owner = NULL;
+		kernel_mutex->lock_count = 0U;
+		atomic_set(&mutex->val, 0);
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	if (z_waitq_head(&kernel_mutex->wait_q) != NULL) {
+		/* Still contended: the kernel keeps tracking the owner */
+		kernel_mutex->owner = new_owner;
+		kernel_mutex->owner_orig_prio = new_owner->base.prio;
+		atomic_set(&mutex->val,
+			   (atomic_val_t)new_owner | SYS_MUTEX_CONTENDED);
+	} else {
+		kernel_mutex->owner = NULL;
+		kernel_mutex->lock_count = 0U;
+		atomic_set(&mutex->val, (atomic_val_t)new_owner);
+	}
+
+	arch_thread_return_value_set(new_owner, 0);
+	z_ready_thread(new_owner);
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
@@ -133,6 +133,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -804,6 +806,130 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 }
 #endif
 
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->put_claimed == 0, "write claim already outstanding");
+
+	size = MIN(size, MIN(pipe->size - pipe->bytes_used,
+			     pipe->size - pipe->write_index));
+	pipe->put_claimed = size;
+	*data = pipe->buffer + pipe->write_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty pipe: pass the new data on to them,
+	 * readying those whose request is complete.
+	 */
+	while ((pipe->bytes_used > 0) &&
+	       ((reader = z_waitq_head(&pipe->wait_q.readers)) != NULL)) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(reader);
+		z_ready_thread(reader);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->get_claimed == 0, "read claim already outstanding");
+
+	size = MIN(size, MIN(pipe->bytes_used,
+			     pipe->size - pipe->read_index));
+	pipe->get_claimed = size;
+	*data = pipe->buffer + pipe->read_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full pipe: refill the freed space from
+	 * them, readying those whose request is complete.
+	 */
+	while ((pipe->bytes_used < pipe->size) &&
+	       ((writer = z_waitq_head(&pipe->wait_q.writers)) != NULL)) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(writer);
+		pipe_thread_ready(writer);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
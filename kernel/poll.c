@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -98,16 +99,24 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread priority: they queue behind threads */
+	if (poller->mode == MODE_SET) {
+		sys_dlist_append(events, &event->_node);
+		return;
+	}
+
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-	    z_is_t1_higher_prio_than_t2(poller_thread(pending->poller),
-					poller_thread(poller))) {
+	    ((pending->poller->mode != MODE_SET) &&
+	     z_is_t1_higher_prio_than_t2(poller_thread(pending->poller),
+					 poller_thread(poller)))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_is_t1_higher_prio_than_t2(poller_thread(poller),
+		if ((pending->poller->mode == MODE_SET) ||
+		    z_is_t1_higher_prio_than_t2(poller_thread(poller),
 					poller_thread(pending->poller))) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
@@ -129,6 +138,9 @@ static inline int register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		add_event(&event->queue->poll_events, event, poller);
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+		(void)atomic_inc(&event->queue->lf_waiters);
+#endif
 		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
@@ -176,6 +188,11 @@ static inline void clear_event_registration(struct k_poll_event *event)
 	}
 	if (remove && sys_dnode_is_linked(&event->_node)) {
 		sys_dlist_remove(&event->_node);
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+		if (event->type == K_POLL_TYPE_DATA_AVAILABLE) {
+			(void)atomic_dec(&event->queue->lf_waiters);
+		}
+#endif
 	}
 }
 
@@ -219,6 +236,16 @@ static inline int register_events(struct k_poll_event *events,
 			} else {
 				__ASSERT(false, "unexpected return code\n");
 			}
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+			/* Lock-free queue producers don't take our lock:
+			 * check again now that they can see the registration.
+			 */
+			if (is_condition_met(&events[ii], &state)) {
+				clear_event_registration(&events[ii]);
+				set_event_ready(&events[ii], state);
+				poller->is_polling = false;
+			}
+#endif
 		}
 		k_spin_unlock(&lock, key);
 	}
@@ -393,6 +420,10 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if (poller && poller->mode == MODE_SET) {
+		return signal_poll_set(event, state);
+	}
+
 	if (poller) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -411,6 +442,142 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	/* The event was removed from its object's list: keep it, and its
+	 * poller, on the ready list until k_poll_set_wait() picks it up.
+	 */
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (!is_condition_met(event, &state)) {
+		(void)register_event(event, &set->poller);
+
+		/* Lock-free queue producers don't take our lock: check
+		 * again now that they can see the registration.
+		 */
+		if (!IS_ENABLED(CONFIG_QUEUE_LOCKFREE_APPEND) ||
+		    !is_condition_met(event, &state)) {
+			return;
+		}
+		clear_event_registration(event);
+	}
+
+	event->poller = &set->poller;
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_node);
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+	z_waitq_init(&set->wait_q);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(event->poller == NULL, "event already in use\n");
+
+	poll_set_arm(set, event);
+	if (!sys_dlist_is_empty(&set->ready)) {
+		struct k_thread *thread = z_unpend_first_thread(&set->wait_q);
+
+		if (thread != NULL) {
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+		}
+	}
+
+	z_reschedule(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(event->poller == &set->poller, "event not in set\n");
+
+	if (event->state == K_POLL_STATE_NOT_READY) {
+		/* Still registered with its object */
+		clear_event_registration(event);
+	} else {
+		sys_dlist_remove(&event->_node);
+		event->poller = NULL;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout)
+{
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	key = k_spin_lock(&lock);
+
+	/* Re-arm the events returned last time, only they need it */
+	while ((event = (struct k_poll_event *)
+			sys_dlist_get(&set->returned)) != NULL) {
+		poll_set_arm(set, event);
+	}
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		if (z_pend_curr(&lock, key, &set->wait_q, timeout) != 0) {
+			return -EAGAIN;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	while (count < max_events &&
+	       (event = (struct k_poll_event *)
+			sys_dlist_get(&set->ready)) != NULL) {
+		sys_dlist_append(&set->returned, &event->_node);
+		ready[count++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return (count > 0) ? count : -EAGAIN;
+}
+
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
@@ -81,6 +81,12 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	sys_sfnode_init(&queue->lf_stub, 0x0);
+	queue->lf_head = &queue->lf_stub;
+	(void)atomic_ptr_set(&queue->lf_tail, &queue->lf_stub);
+	(void)atomic_set(&queue->lf_waiters, 0);
+#endif
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -107,10 +113,131 @@ static void prepare_thread_to_run(struct k_thread *thread, void *data)
 static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 {
 #ifdef CONFIG_POLL
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* The signaled event gets unlinked here rather than by
+	 * clear_event_registration(), so drop its waiter count too.
+	 */
+	if (!sys_dlist_is_empty(&queue->poll_events)) {
+		(void)atomic_dec(&queue->lf_waiters);
+	}
+#endif
 	z_handle_obj_poll_events(&queue->poll_events, state);
 #endif
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/*
+ * Lock-free staging list: an intrusive multi-producer, single-consumer
+ * queue (D. Vyukov) reusing the sys_sfnode_t of each item. Producers swap
+ * themselves in as lf_tail and then link the previous tail to them, which
+ * is wait-free. The consumer side runs with queue->lock held and moves
+ * every fully linked item into data_q in order. A producer preempted
+ * between the exchange and the link leaves the remaining items in place;
+ * they are picked up by the next drain, and since that producer checks
+ * lf_waiters only after linking, it will take the locked path itself if
+ * anybody went to sleep in the meantime.
+ */
+static inline sys_sfnode_t *lf_next(sys_sfnode_t *node)
+{
+	return atomic_ptr_get((atomic_ptr_t *)&node->next_and_flags);
+}
+
+static inline void lf_push(struct k_queue *queue, sys_sfnode_t *node)
+{
+	sys_sfnode_t *prev;
+
+	sys_sfnode_init(node, 0x0);
+	prev = atomic_ptr_set(&queue->lf_tail, node);
+	(void)atomic_ptr_set((atomic_ptr_t *)&prev->next_and_flags, node);
+}
+
+/* must be called with queue->lock held */
+static void lf_drain(struct k_queue *queue)
+{
+	while (true) {
+		sys_sfnode_t *head = queue->lf_head;
+		sys_sfnode_t *next = lf_next(head);
+
+		if (head == &queue->lf_stub) {
+			if (next == NULL) {
+				break;
+			}
+			queue->lf_head = next;
+			continue;
+		}
+
+		if (next == NULL) {
+			if (head != atomic_ptr_get(&queue->lf_tail)) {
+				/* a producer has not linked its item yet */
+				break;
+			}
+			/* head is the last item: queue the stub behind it
+			 * so it can be handed over to data_q
+			 */
+			lf_push(queue, &queue->lf_stub);
+			next = lf_next(head);
+			if (next == NULL) {
+				break;
+			}
+		}
+
+		queue->lf_head = next;
+		sys_sflist_append(&queue->data_q, head);
+	}
+}
+
+void z_queue_lockfree_flush(struct k_queue *queue)
+{
+	k_spinlock_key_t key;
+
+	if (z_queue_lockfree_is_empty(queue)) {
+		return;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	lf_drain(queue);
+	k_spin_unlock(&queue->lock, key);
+}
+
+void k_queue_append_lockfree(struct k_queue *queue, void *data)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	lf_push(queue, data);
+
+	if (likely(atomic_get(&queue->lf_waiters) == 0)) {
+		return;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	lf_drain(queue);
+
+	/* If our item is stuck behind an unlinked one, the producer of
+	 * that one will see the waiter and get here after us.
+	 */
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread != NULL) {
+			sys_sfnode_t *node;
+
+			node = sys_sflist_get_not_empty(&queue->data_q);
+			prepare_thread_to_run(thread,
+					      z_queue_node_peek(node, true));
+		} else {
+			handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+		}
+	}
+
+	z_reschedule(&queue->lock, key);
+}
+#else
+static inline void lf_drain(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif /* CONFIG_QUEUE_LOCKFREE_APPEND */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
@@ -142,6 +269,8 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (is_append) {
+		/* keep lock-free appends ahead of this one */
+		lf_drain(queue);
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
 	first_pending_thread = z_unpend_first_thread(&queue->wait_q);
@@ -230,6 +359,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+	lf_drain(queue);
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -281,6 +412,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
+	lf_drain(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -295,11 +428,52 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* Advertise ourselves before the final check, so that a lock-free
+	 * producer either gets drained here or sees us and wakes us up.
+	 */
+	(void)atomic_inc(&queue->lf_waiters);
+	lf_drain(queue);
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		sys_sfnode_t *node;
+
+		(void)atomic_dec(&queue->lf_waiters);
+		node = sys_sflist_get_not_empty(&queue->data_q);
+		data = z_queue_node_peek(node, true);
+		k_spin_unlock(&queue->lock, key);
+		return data;
+	}
+#endif
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	(void)atomic_dec(&queue->lf_waiters);
+#endif
+
 	return (ret != 0) ? NULL : _current->base.swap_data;
 }
 
+int k_queue_get_batch(struct k_queue *queue, void **data, int count)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	int n = 0;
+
+	lf_drain(queue);
+
+	while ((n < count) && !sys_sflist_is_empty(&queue->data_q)) {
+		sys_sfnode_t *node;
+
+		node = sys_sflist_get_not_empty(&queue->data_q);
+		data[n++] = z_queue_node_peek(node, true);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	return n;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline void *z_vrfy_k_queue_get(struct k_queue *queue,
 				       k_timeout_t timeout)
@@ -60,6 +60,109 @@ static struct k_spinlock sched_spinlock;
 
 static void update_cache(int);
 
+#ifdef CONFIG_SMP
+static ALWAYS_INLINE bool cpu_is_parked(int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_PARKING
+	return _kernel.cpus[cpu].parked != 0U;
+#else
+	ARG_UNUSED(cpu);
+
+	return false;
+#endif
+}
+
+static ALWAYS_INLINE bool cpu_may_run(int cpu, struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(cpu);
+	ARG_UNUSED(thread);
+
+	return true;
+#endif
+}
+#endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Picks the run queue that a thread being made runnable is placed
+ * on.  Threads go back to the CPU they last ran on (which is the
+ * local CPU for _current) so they stay cache-hot, unless the CPU mask
+ * forbids it, in which case the lowest permitted CPU is used instead.
+ */
+static int runq_cpu_select(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+
+	if (thread == _current) {
+		cpu = _current_cpu->id;
+	}
+
+	__ASSERT_NO_MSG(cpu < CONFIG_MP_NUM_CPUS);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(cpu)) == 0) {
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if ((thread->base.cpu_mask & BIT(i)) != 0) {
+				cpu = i;
+				break;
+			}
+		}
+	}
+#endif
+
+#ifdef CONFIG_SCHED_CPU_PARKING
+	/* Concentrate the load on the running CPUs */
+	if (cpu_is_parked(cpu)) {
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (!cpu_is_parked(i) && cpu_may_run(i, thread)) {
+				cpu = i;
+				break;
+			}
+		}
+	}
+#endif
+
+	return cpu;
+}
+
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
+{
+	return &_kernel.ready_q[thread->base.runq_cpu];
+}
+
+static ALWAYS_INLINE struct _ready_q *curr_cpu_ready_q(void)
+{
+	return &_kernel.ready_q[_current_cpu->id];
+}
+#else
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+
+	return &_kernel.ready_q;
+}
+
+static ALWAYS_INLINE struct _ready_q *curr_cpu_ready_q(void)
+{
+	return &_kernel.ready_q;
+}
+#endif
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread->base.runq_cpu = runq_cpu_select(thread);
+#endif
+	_priq_run_add(&thread_ready_q(thread)->runq, thread);
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(&thread_ready_q(thread)->runq, thread);
+}
+
 #define LOCKED(lck) for (k_spinlock_key_t __i = {},			\
 					  __key = k_spin_lock(lck);	\
 			!__i.key;					\
@@ -181,6 +284,48 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Called when the local run queue has nothing this CPU may run.
+ * Scans the other CPUs' queues and takes the highest priority thread
+ * found that is permitted to run here.  The thread is left in the
+ * peer's queue; next_up() removes it from there like any other
+ * selection.
+ */
+static struct k_thread *runq_steal(void)
+{
+	struct k_thread *best = NULL;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *thread;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.ready_q[i].runq);
+		if (thread != NULL &&
+		    (best == NULL || z_is_t1_higher_prio_than_t2(thread, best))) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#endif
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	struct k_thread *thread = _priq_run_best(&curr_cpu_ready_q()->runq);
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	if (thread == NULL) {
+		thread = runq_steal();
+	}
+#endif
+
+	return thread;
+}
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 	struct k_thread *thread;
@@ -192,7 +337,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		return _current_cpu->idle_thread;
 	}
 
-	thread = _priq_run_best(&_kernel.ready_q.runq);
+	thread = runq_best();
 
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
@@ -262,16 +407,25 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	/* Put _current back into the queue */
 	if (thread != _current && active &&
 		!z_is_idle_thread_object(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 	}
 	z_mark_thread_as_not_queued(thread);
 
+#ifdef CONFIG_SCHED_CPU_PARKING
+	/* Running a thread, e.g. readied by an interrupt taken while
+	 * parked: the CPU must be signaled like the other running ones
+	 */
+	if (!z_is_idle_thread_object(thread)) {
+		_current_cpu->parked = 0U;
+	}
+#endif
+
 	return thread;
 #endif
 }
@@ -279,13 +433,94 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 	}
-	_priq_run_add(&_kernel.ready_q.runq, thread);
+	runq_add(thread);
 	z_mark_thread_as_queued(thread);
 	update_cache(thread == _current);
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Execution cycles of a thread, with its run in progress on this CPU */
+static uint64_t cbs_cycles(struct k_thread *thread)
+{
+	struct _cpu *cpu = _current_cpu;
+	uint64_t cycles = thread->usage.execution_cycles;
+
+	if (cpu->usage_thread == thread) {
+		cycles += k_cycle_get_32() - cpu->usage_start;
+	}
+
+	return cycles;
+}
+
+static uint32_t cbs_left(struct k_thread *thread)
+{
+	uint64_t used = cbs_cycles(thread) - thread->base.cbs_mark;
+
+	return (used < thread->base.cbs_budget) ?
+	       thread->base.cbs_budget - (uint32_t)used : 0U;
+}
+
+static void cbs_replenish(struct k_thread *thread, uint32_t deadline)
+{
+	thread->base.cbs_mark = cbs_cycles(thread);
+	thread->base.prio_deadline = deadline;
+}
+
+/* Called when the thread becomes ready, before it is queued */
+static void cbs_wakeup(struct k_thread *thread)
+{
+	uint32_t now = k_cycle_get_32();
+	int32_t to_deadline = thread->base.prio_deadline - (int32_t)now;
+	uint64_t left, allowed;
+
+	if (thread->base.cbs_budget == 0U) {
+		return;
+	}
+
+	if (to_deadline <= 0) {
+		cbs_replenish(thread, now + thread->base.cbs_period);
+		return;
+	}
+
+	/* Keeping the deadline would exceed the bandwidth of the server */
+	left = (uint64_t)cbs_left(thread) * thread->base.cbs_period;
+	allowed = (uint64_t)to_deadline * thread->base.cbs_budget;
+	if (left >= allowed) {
+		cbs_replenish(thread, now + thread->base.cbs_period);
+	}
+}
+
+/* Postpones the deadline of a thread out of budget */
+static void cbs_check(struct k_thread *thread)
+{
+	if (cbs_left(thread) != 0U) {
+		return;
+	}
+
+	thread->usage.cbs_overruns++;
+	cbs_replenish(thread, thread->base.prio_deadline +
+		      thread->base.cbs_period);
+
+	if (z_is_thread_queued(thread)) {
+		runq_remove(thread);
+		runq_add(thread);
+	}
+	update_cache(thread == _current);
+}
+#endif
+
+static inline bool cbs_enabled(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	return thread->base.cbs_budget != 0U && is_preempt(thread)
+		&& !z_is_thread_prevented_from_running(thread);
+#else
+	return false;
+#endif
+}
+
 #ifdef CONFIG_TIMESLICING
 
 static int slice_time;
@@ -300,15 +535,24 @@ static int slice_max_prio;
 static struct k_thread *pending_current;
 #endif
 
-void z_reset_time_slice(void)
+void z_reset_time_slice(struct k_thread *thread)
 {
+	int ticks = slice_time;
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* The budget left takes the place of the slice */
+	if (cbs_enabled(thread)) {
+		ticks = MAX(k_cyc_to_ticks_ceil32(cbs_left(thread)), 1U);
+	}
+#endif
+
 	/* Add the elapsed time since the last announced tick to the
 	 * slice count, as we'll see those "expired" ticks arrive in a
 	 * FUTURE z_time_slice() call.
 	 */
-	if (slice_time != 0) {
-		_current_cpu->slice_ticks = slice_time + z_clock_elapsed();
-		z_set_timeout_expiry(slice_time, false);
+	if (ticks != 0) {
+		_current_cpu->slice_ticks = ticks + z_clock_elapsed();
+		z_set_timeout_expiry(ticks, false);
 	}
 }
 
@@ -318,7 +562,7 @@ void k_sched_time_slice_set(int32_t slice, int prio)
 		_current_cpu->slice_ticks = 0;
 		slice_time = k_ms_to_ticks_ceil32(slice);
 		slice_max_prio = prio;
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
 	}
 }
 
@@ -344,17 +588,26 @@ void z_time_slice(int ticks)
 
 #ifdef CONFIG_SWAP_NONATOMIC
 	if (pending_current == _current) {
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
 		k_spin_unlock(&sched_spinlock, key);
 		return;
 	}
 	pending_current = NULL;
 #endif
 
-	if (slice_time && sliceable(_current)) {
+	if (cbs_enabled(_current)) {
+		if (ticks >= _current_cpu->slice_ticks) {
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+			cbs_check(_current);
+#endif
+			z_reset_time_slice(_current);
+		} else {
+			_current_cpu->slice_ticks -= ticks;
+		}
+	} else if (slice_time && sliceable(_current)) {
 		if (ticks >= _current_cpu->slice_ticks) {
 			move_thread_to_end_of_prio_q(_current);
-			z_reset_time_slice();
+			z_reset_time_slice(_current);
 		} else {
 			_current_cpu->slice_ticks -= ticks;
 		}
@@ -391,7 +644,7 @@ static void update_cache(int preempt_ok)
 	if (should_preempt(thread, preempt_ok)) {
 #ifdef CONFIG_TIMESLICING
 		if (thread != _current) {
-			z_reset_time_slice();
+			z_reset_time_slice(thread);
 		}
 #endif
 		update_metairq_preempt(thread);
@@ -411,6 +664,101 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+#ifdef CONFIG_SCHED_IPI_MASK_SUPPORTED
+#ifdef CONFIG_SCHED_CPU_PARKING
+/* Wakes up a parked CPU for @thread, which no running CPU would switch
+ * to: the runnable threads outnumber them.  The CPU the thread was
+ * queued on is preferred, as it's there only if no running CPU may run
+ * the thread.  Returns the mask of the CPU to interrupt, if any.
+ */
+static uint32_t cpu_unpark(struct k_thread *thread)
+{
+	int cpu = thread->base.runq_cpu;
+
+	if (!cpu_is_parked(cpu)) {
+		for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			if (cpu_is_parked(cpu) && cpu_may_run(cpu, thread)) {
+				break;
+			}
+		}
+
+		if (cpu == CONFIG_MP_NUM_CPUS) {
+			return 0;
+		}
+	}
+
+	_kernel.cpus[cpu].parked = 0U;
+
+	return BIT(cpu);
+}
+#endif
+
+/* True if the CPU would have to reschedule now that @thread has
+ * become runnable, or had its priority changed.  Must be called with
+ * the scheduler lock held, so the run queues and the set of threads
+ * running on each CPU can't change underneath us.
+ */
+static bool cpu_wants_ipi(struct _cpu *cpu, struct k_thread *thread)
+{
+	struct k_thread *curr = cpu->current;
+
+	if (curr == thread) {
+		/* It's running there, let that CPU re-evaluate it */
+		return true;
+	}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(cpu->id)) == 0) {
+		return false;
+	}
+#endif
+
+	if (curr == NULL || z_is_idle_thread_object(curr) ||
+	    z_is_thread_prevented_from_running(curr)) {
+		return true;
+	}
+
+	if (!is_preempt(curr) && !is_metairq(thread)) {
+		return false;
+	}
+
+	return z_is_t1_higher_prio_than_t2(thread, curr);
+}
+#endif
+
+/* Interrupts the other CPUs that may need to switch to @thread.
+ * Without a targeted IPI available this is a broadcast.
+ */
+static void signal_ipi(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_IPI_MASK_SUPPORTED
+	uint32_t mask = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (i != _current_cpu->id && !cpu_is_parked(i) &&
+		    cpu_wants_ipi(&_kernel.cpus[i], thread)) {
+			mask |= BIT(i);
+		}
+	}
+
+#ifdef CONFIG_SCHED_CPU_PARKING
+	if (mask == 0 && !cpu_wants_ipi(_current_cpu, thread)) {
+		mask = cpu_unpark(thread);
+	}
+#endif
+
+	if (mask != 0) {
+		arch_sched_ipi_mask(mask);
+	}
+#else
+	ARG_UNUSED(thread);
+
+	arch_sched_ipi();
+#endif
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef KERNEL_COHERENCE
@@ -422,11 +770,14 @@ static void ready_thread(struct k_thread *thread)
 	 */
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		sys_trace_thread_ready(thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		cbs_wakeup(thread);
+#endif
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		signal_ipi(thread);
 #endif
 	}
 }
@@ -465,7 +816,7 @@ void z_impl_k_thread_suspend(struct k_thread *thread)
 
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		z_mark_thread_as_suspended(thread);
@@ -552,8 +903,7 @@ void z_thread_single_abort(struct k_thread *thread)
 
 		if (z_is_thread_ready(thread)) {
 			if (z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 			update_cache(thread == _current);
@@ -637,7 +987,7 @@ void z_thread_single_abort(struct k_thread *thread)
 static void unready_thread(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 		z_mark_thread_as_not_queued(thread);
 	}
 	update_cache(thread == _current);
@@ -799,13 +1149,16 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				thread->base.prio = prio;
-				_priq_run_add(&_kernel.ready_q.runq, thread);
+				runq_add(thread);
 			} else {
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+			signal_ipi(thread);
+#endif
 		} else {
 			thread->base.prio = prio;
 		}
@@ -819,10 +1172,6 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = z_set_prio(thread, prio);
 
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
-#endif
-
 	if (need_sched && _current->base.sched_locked == 0) {
 		z_reschedule_unlocked();
 	}
@@ -936,7 +1285,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
 
 #ifdef CONFIG_TIMESLICING
-			z_reset_time_slice();
+			z_reset_time_slice(new_thread);
 #endif
 			_current_cpu->swap_ok = 0;
 			set_current(new_thread);
@@ -1071,17 +1420,20 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 }
 
 #ifdef CONFIG_SCHED_MULTIQ
-# if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
-# error Too many priorities for multiqueue scheduler (max 32)
-# endif
+BUILD_ASSERT(K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO < PRIQ_MQ_NUM_PRIOS,
+	     "multiqueue scheduler does not cover every thread priority");
+BUILD_ASSERT(PRIQ_MQ_BITMAP_SIZE <= 32,
+	     "Too many priorities for multiqueue scheduler (max 1024)");
 #endif
 
 ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = priority_bit / 32;
 
 	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= BIT(priority_bit);
+	pq->bitmask[word] |= BIT(priority_bit % 32);
+	pq->bitmap |= BIT(word);
 }
 
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
@@ -1093,21 +1445,27 @@ ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread
 	}
 #endif
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = priority_bit / 32;
 
 	sys_dlist_remove(&thread->base.qnode_dlist);
 	if (sys_dlist_is_empty(&pq->queues[priority_bit])) {
-		pq->bitmask &= ~BIT(priority_bit);
+		pq->bitmask[word] &= ~BIT(priority_bit % 32);
+		if (pq->bitmask[word] == 0U) {
+			pq->bitmap &= ~BIT(word);
+		}
 	}
 }
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
-	if (!pq->bitmask) {
+	if (!pq->bitmap) {
 		return NULL;
 	}
 
 	struct k_thread *thread = NULL;
-	sys_dlist_t *l = &pq->queues[__builtin_ctz(pq->bitmask)];
+	int word = __builtin_ctz(pq->bitmap);
+	int priority_bit = word * 32 + __builtin_ctz(pq->bitmask[word]);
+	sys_dlist_t *l = &pq->queues[priority_bit];
 	sys_dnode_t *n = sys_dlist_peek_head(l);
 
 	if (n != NULL) {
@@ -1130,14 +1488,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -1145,9 +1503,20 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
+	}
+#endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.ready_q[i]);
 	}
+#else
+	init_ready_q(&_kernel.ready_q);
 #endif
 
 #ifdef CONFIG_TIMESLICING
@@ -1207,8 +1576,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			_priq_run_add(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
+			runq_add(thread);
 		}
 	}
 }
@@ -1227,6 +1596,45 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 }
 #include <syscalls/k_thread_deadline_set_mrsh.c>
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+int z_impl_k_thread_cbs_set(k_tid_t tid, uint32_t budget, uint32_t period)
+{
+	struct k_thread *thread = tid;
+
+	if (budget > period) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		thread->base.cbs_budget = budget;
+		thread->base.cbs_period = period;
+		if (budget != 0U) {
+			cbs_replenish(thread, k_cycle_get_32() + period);
+		}
+		if (z_is_thread_queued(thread)) {
+			runq_remove(thread);
+			runq_add(thread);
+		}
+		if (thread == _current) {
+			z_reset_time_slice(thread);
+		}
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_set(k_tid_t tid, uint32_t budget,
+					  uint32_t period)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(tid, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set(tid, budget, period);
+}
+#include <syscalls/k_thread_cbs_set_mrsh.c>
+#endif
+#endif
 #endif
 
 void z_impl_k_yield(void)
@@ -1237,10 +1645,9 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
+				runq_remove(_current);
 			}
-			_priq_run_add(&_kernel.ready_q.runq, _current);
+			runq_add(_current);
 			z_mark_thread_as_queued(_current);
 			update_cache(1);
 		}
@@ -1369,10 +1776,6 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
-#endif
-
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
 	}
@@ -1393,6 +1796,40 @@ void z_sched_ipi(void)
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_PARKING
+bool z_sched_cpu_park(void)
+{
+	bool park = false;
+
+	LOCKED(&sched_spinlock) {
+		struct _cpu *cpu = _current_cpu;
+
+		/* CPU 0 keeps running, to serve the load when it comes
+		 * back.  The others park once they have nothing to run
+		 * while another running CPU is idle too: that one is
+		 * enough for the next thread made runnable.
+		 */
+		if (cpu->parked != 0U) {
+			park = true;
+		} else if (cpu->id != 0 && runq_best() == NULL) {
+			for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+				struct _cpu *peer = &_kernel.cpus[i];
+
+				if (peer != cpu && peer->parked == 0U &&
+				    z_is_idle_thread_object(peer->current)) {
+					park = true;
+					break;
+				}
+			}
+
+			cpu->parked = park ? 1U : 0U;
+		}
+	}
+
+	return park;
+}
+#endif
+
 void z_sched_abort(struct k_thread *thread)
 {
 	k_spinlock_key_t key;
@@ -1402,11 +1839,13 @@ void z_sched_abort(struct k_thread *thread)
 		return;
 	}
 
-	/* First broadcast an IPI to the other CPUs so they can stop
+	/* First send an IPI to the CPU it last ran on so it can stop
 	 * it locally.  Not all architectures support that, alas.  If
 	 * we don't have it, we need to wait for some other interrupt.
 	 */
-#ifdef CONFIG_SCHED_IPI_SUPPORTED
+#ifdef CONFIG_SCHED_IPI_MASK_SUPPORTED
+	arch_sched_ipi_mask(BIT(thread->base.cpu));
+#elif defined(CONFIG_SCHED_IPI_SUPPORTED)
 	arch_sched_ipi();
 #endif
 
@@ -1420,7 +1859,7 @@ void z_sched_abort(struct k_thread *thread)
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
 		} else if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
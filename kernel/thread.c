@@ -483,8 +483,12 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 		stack_buf_size, stack_ptr);
 
 #ifdef CONFIG_INIT_STACKS
+#ifdef CONFIG_THREAD_STACK_POOL
+	z_thread_stack_pool_paint(stack, stack_buf_start, stack_buf_size);
+#else
 	memset(stack_buf_start, 0xaa, stack_buf_size);
 #endif
+#endif
 #ifdef CONFIG_STACK_SENTINEL
 	/* Put the stack sentinel at the lowest 4 bytes of the stack area.
 	 * We periodically check that it's still present and kill the thread
@@ -569,6 +573,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_init_thread_base(&new_thread->base, prio, _THREAD_PRESTART, options);
 	stack_ptr = setup_thread_stack(new_thread, stack, stack_size);
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	new_thread->usage = (struct k_thread_runtime_stats) {};
+#endif
+
 #ifdef KERNEL_COHERENCE
 	/* Check that the thread object is safe, but that the stack is
 	 * still cached!
@@ -636,6 +644,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_SCHED_DEADLINE
 	new_thread->base.prio_deadline = 0;
+#endif
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	new_thread->base.cbs_budget = 0U;
 #endif
 	new_thread->resource_pool = _current->resource_pool;
 	sys_trace_thread_create(new_thread);
@@ -815,6 +826,7 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	thread_base->cpu = 0;
 #endif
 
 	/* swap_data does not need to be initialized */
@@ -1016,3 +1028,79 @@ static inline k_ticks_t z_vrfy_k_thread_timeout_expires_ticks(
 }
 #include <syscalls/k_thread_timeout_expires_ticks_mrsh.c>
 #endif
+
+#if defined(CONFIG_TRACING) || defined(CONFIG_THREAD_RUNTIME_STATS)
+void z_thread_mark_switched_in(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	struct _cpu *cpu = _current_cpu;
+	uint32_t now = k_cycle_get_32();
+
+	if (cpu->usage_thread != NULL) {
+		uint32_t cycles = now - cpu->usage_start;
+
+		cpu->usage_thread->usage.execution_cycles += cycles;
+		cpu->usage_total += cycles;
+	}
+
+	cpu->usage_thread = _current;
+	cpu->usage_start = now;
+#endif
+
+	sys_trace_thread_switched_in();
+}
+#endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/* Cycles of the run in progress on the calling CPU, if charged to
+ * @a thread (or to anybody, if NULL). Interrupts must be locked.
+ */
+static uint32_t usage_in_progress(struct k_thread *thread)
+{
+	struct _cpu *cpu = _current_cpu;
+
+	if ((cpu->usage_thread == NULL) ||
+	    ((thread != NULL) && (cpu->usage_thread != thread))) {
+		return 0;
+	}
+
+	return k_cycle_get_32() - cpu->usage_start;
+}
+
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       k_thread_runtime_stats_t *stats)
+{
+	unsigned int key;
+
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = arch_irq_lock();
+	*stats = thread->usage;
+	stats->execution_cycles += usage_in_progress(thread);
+	arch_irq_unlock(key);
+
+	return 0;
+}
+
+int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
+{
+	unsigned int key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = arch_irq_lock();
+	*stats = (k_thread_runtime_stats_t) {
+		.execution_cycles = usage_in_progress(NULL),
+	};
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->execution_cycles += _kernel.cpus[i].usage_total;
+	}
+	arch_irq_unlock(key);
+
+	return 0;
+}
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel pool of thread stacks
+ *
+ * Stacks are statically allocated with K_THREAD_STACK_ARRAY_DEFINE(), so
+ * every slot meets the MPU/MMU alignment and size constraints, and are
+ * handed out with a bitmap of used slots.
+ *
+ * With CONFIG_INIT_STACKS, freeing a stack records how much of its
+ * buffer, from the bottom up, still holds the 0xaa paint.  The next
+ * thread created on that stack then only needs to repaint the part above
+ * it, which for short-lived threads is a small fraction of the stack.
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <string.h>
+#include <sys/atomic.h>
+
+#define POOL_NUM	CONFIG_THREAD_STACK_POOL_NUM
+
+static K_THREAD_STACK_ARRAY_DEFINE(stack_pool, POOL_NUM,
+				   CONFIG_THREAD_STACK_POOL_STACK_SIZE);
+
+static ATOMIC_DEFINE(stack_pool_used, POOL_NUM);
+
+#ifdef CONFIG_INIT_STACKS
+struct stack_pool_slot {
+	/* Buffer painted for the last thread created on this stack */
+	char *buf;
+	size_t buf_size;
+	/* [clean_start, clean_end) is known to still be painted; only
+	 * valid between k_thread_stack_free() and the next thread creation
+	 */
+	char *clean_start;
+	char *clean_end;
+};
+
+static struct stack_pool_slot stack_pool_slots[POOL_NUM];
+#endif
+
+static int stack_pool_index(k_thread_stack_t *stack)
+{
+	uintptr_t offset = (uintptr_t)stack - (uintptr_t)stack_pool[0];
+	size_t slot_size = sizeof(stack_pool[0]);
+
+	if (((uintptr_t)stack < (uintptr_t)stack_pool[0]) ||
+	    (offset % slot_size != 0) ||
+	    (offset / slot_size >= POOL_NUM)) {
+		return -1;
+	}
+
+	return offset / slot_size;
+}
+
+k_thread_stack_t *k_thread_stack_alloc(size_t size, int flags)
+{
+	if (((flags & ~K_USER) != 0) ||
+	    (size > K_THREAD_STACK_SIZEOF(stack_pool[0]))) {
+		return NULL;
+	}
+
+	for (int i = 0; i < POOL_NUM; i++) {
+		if (!atomic_test_and_set_bit(stack_pool_used, i)) {
+			return stack_pool[i];
+		}
+	}
+
+	return NULL;
+}
+
+int k_thread_stack_free(k_thread_stack_t *stack)
+{
+	int i = stack_pool_index(stack);
+
+	if ((i < 0) || !atomic_test_bit(stack_pool_used, i)) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_INIT_STACKS
+	struct stack_pool_slot *slot = &stack_pool_slots[i];
+	char *p = slot->buf;
+	char *end = slot->buf + slot->buf_size;
+
+	/* Stacks grow down, so the untouched paint is at the bottom */
+	while ((p < end) && (*p == (char)0xaa)) {
+		p++;
+	}
+
+	slot->clean_start = slot->buf;
+	slot->clean_end = p;
+#endif
+
+	atomic_clear_bit(stack_pool_used, i);
+
+	return 0;
+}
+
+#ifdef CONFIG_INIT_STACKS
+void z_thread_stack_pool_paint(k_thread_stack_t *stack, char *buf,
+			       size_t size)
+{
+	int i = stack_pool_index(stack);
+	char *start = buf;
+	char *end = buf + size;
+
+	if (i >= 0) {
+		struct stack_pool_slot *slot = &stack_pool_slots[i];
+
+		if ((buf >= slot->clean_start) && (buf <= slot->clean_end)) {
+			start = MIN(slot->clean_end, end);
+		}
+
+		slot->buf = buf;
+		slot->buf_size = size;
+		slot->clean_start = NULL;
+		slot->clean_end = NULL;
+	}
+
+	(void)memset(start, 0xaa, end - start);
+}
+#endif
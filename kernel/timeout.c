@@ -11,6 +11,8 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
+#include <tracing/tracing.h>
 
 #define LOCKED(lck) for (k_spinlock_key_t __i = {},			\
 					  __key = k_spin_lock(lck);	\
@@ -19,7 +21,9 @@
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -29,6 +33,24 @@ static struct k_spinlock timeout_lock;
 /* Cycles left to process in the currently-executing z_clock_announce() */
 static int announce_remaining;
 
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* Timeouts detached from the queue by z_clock_announce() whose
+ * handlers have not run yet.  They stay linked (so they still look
+ * active) and are tagged with a dticks value no queued timeout can
+ * have, so z_abort_timeout() knows to take them off this list instead.
+ */
+static sys_dlist_t expired_list = SYS_DLIST_STATIC_INIT(&expired_list);
+
+#define BATCHED_DTICKS (-1)
+
+static inline bool is_batched(const struct _timeout *t)
+{
+	return t->dticks == BATCHED_DTICKS;
+}
+#else
+#define is_batched(t) false
+#endif
+
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
@@ -41,6 +63,177 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical timing wheel.  Each pending timeout stores its
+ * absolute expiry tick in dticks and lives in the slot of the level
+ * given by the most significant 6-bit group in which its expiry
+ * differs from curr_tick: level 0 holds timeouts due within the
+ * current 64 tick block, indexed by exact tick, level 1 those due
+ * within the current 4096 tick block, indexed by 64 tick block, and
+ * so on.  Expiries beyond the top level go on an unsorted overflow
+ * list.  Whenever curr_tick reaches the start of a non-empty slot
+ * above level 0 its timeouts are "cascaded" down to the levels
+ * below, so the level computed from (expiry ^ curr_tick) always
+ * finds a timeout's slot and insertion/removal are O(1).
+ *
+ * Slot list heads are only valid while the slot's bit is set in
+ * occupied[]: they are (re)initialized on first insertion instead of
+ * at boot.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS 5
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t occupied[WHEEL_LEVELS];
+static sys_dlist_t overflow = SYS_DLIST_STATIC_INIT(&overflow);
+
+/* Cached expiry of the soonest timeout, valid unless first_stale */
+static uint64_t first_expiry = UINT64_MAX;
+static bool first_stale;
+
+static int wheel_level(uint64_t expiry)
+{
+	uint64_t diff = expiry ^ curr_tick;
+
+	return diff == 0U ? 0 : (63 - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+}
+
+static int wheel_index(uint64_t expiry, int level)
+{
+	return (expiry >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+}
+
+static void wheel_insert(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+	int level = wheel_level(expiry);
+
+	if (level >= WHEEL_LEVELS) {
+		sys_dlist_append(&overflow, &t->node);
+		return;
+	}
+
+	int idx = wheel_index(expiry, level);
+
+	if ((occupied[level] & BIT64(idx)) == 0U) {
+		sys_dlist_init(&wheel[level][idx]);
+		occupied[level] |= BIT64(idx);
+	}
+	sys_dlist_append(&wheel[level][idx], &t->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+	int level = wheel_level(expiry);
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS) {
+		int idx = wheel_index(expiry, level);
+
+		if (sys_dlist_is_empty(&wheel[level][idx])) {
+			occupied[level] &= ~BIT64(idx);
+		}
+	}
+
+	if (expiry == first_expiry) {
+		first_stale = true;
+	}
+}
+
+/* Tick of the next point where the wheel needs servicing: the
+ * soonest level 0 expiry, or the start of the soonest slot (or
+ * overflow rotation) that must be cascaded.  Lower levels always
+ * come first, since everything they hold is due before the next
+ * slot of the level above begins.
+ */
+static uint64_t wheel_next_event(int *level)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (occupied[l] != 0U) {
+			int shift = l * WHEEL_BITS;
+			uint64_t base = curr_tick &
+				~(BIT64(shift + WHEEL_BITS) - 1U);
+
+			*level = l;
+			return base | ((uint64_t)u64_count_trailing_zeros(
+					       occupied[l]) << shift);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&overflow)) {
+		*level = WHEEL_LEVELS;
+		return (curr_tick | (BIT64(WHEEL_LEVELS * WHEEL_BITS) - 1U))
+			+ 1U;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Redistributes a slot reached by curr_tick to the levels below */
+static void wheel_cascade(int level)
+{
+	sys_dlist_t *src = &overflow;
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	if (level < WHEEL_LEVELS) {
+		int idx = wheel_index(curr_tick, level);
+
+		src = &wheel[level][idx];
+		occupied[level] &= ~BIT64(idx);
+	}
+
+	/* Overflow entries may land back on the overflow list, so
+	 * drain the source before reinserting anything
+	 */
+	sys_dlist_init(&pending);
+	while ((node = sys_dlist_get(src)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+static uint64_t soonest_expiry(sys_dlist_t *list)
+{
+	uint64_t ret = UINT64_MAX;
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		ret = MIN(ret, (uint64_t)t->dticks);
+	}
+	return ret;
+}
+
+/* Absolute expiry of the soonest timeout, UINT64_MAX if none.  Only
+ * the earliest occupied slot has to be looked at, and that only when
+ * the cached value was invalidated by removing the soonest timeout.
+ */
+static uint64_t wheel_first_expiry(void)
+{
+	if (first_stale) {
+		int level;
+		uint64_t ev = wheel_next_event(&level);
+
+		if (ev == UINT64_MAX || level == 0) {
+			first_expiry = ev;
+		} else if (level < WHEEL_LEVELS) {
+			first_expiry = soonest_expiry(
+				&wheel[level][wheel_index(ev, level)]);
+		} else {
+			first_expiry = soonest_expiry(&overflow);
+		}
+		first_stale = false;
+	}
+
+	return first_expiry;
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -63,6 +256,37 @@ static void remove_timeout(struct _timeout *t)
 
 	sys_dlist_remove(&t->node);
 }
+#endif
+
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* Moves a timeout already removed from the queue onto the batch */
+static void detach_expired(struct _timeout *t)
+{
+	t->dticks = BATCHED_DTICKS;
+	sys_dlist_append(&expired_list, &t->node);
+}
+
+/* Runs the handlers of the current batch.  Called and returns with
+ * timeout_lock held.  Each timeout is unlinked under the lock just
+ * before its handler executes, so handlers and other contexts can
+ * still abort batch members that have not fired yet.
+ */
+static k_spinlock_key_t run_expired(k_spinlock_key_t key)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(&expired_list)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks = 0;
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+	}
+
+	return key;
+}
+#endif
 
 static int32_t elapsed(void)
 {
@@ -71,10 +295,17 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+#ifdef CONFIG_TIMEOUT_WHEEL
+	uint64_t expiry = wheel_first_expiry();
+	int32_t ret = expiry == UINT64_MAX ? MAX_WAIT
+		: CLAMP((int64_t)(expiry - curr_tick) - ticks_elapsed,
+			0, MAX_WAIT);
+#else
+	struct _timeout *to = first();
 	int32_t ret = to == NULL ? MAX_WAIT
 		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -110,6 +341,17 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_WHEEL
+		uint64_t prev_first = wheel_first_expiry();
+
+		to->dticks = curr_tick + elapsed() + ticks;
+		wheel_insert(to);
+
+		if ((uint64_t)to->dticks < prev_first) {
+			first_expiry = to->dticks;
+			z_clock_set_timeout(next_timeout(), false);
+		}
+#else
 		struct _timeout *t;
 
 		to->dticks = ticks + elapsed();
@@ -129,6 +371,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -138,7 +381,11 @@ int z_abort_timeout(struct _timeout *to)
 
 	LOCKED(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+			if (is_batched(to)) {
+				sys_dlist_remove(&to->node);
+			} else {
+				remove_timeout(to);
+			}
 			ret = 0;
 		}
 	}
@@ -151,16 +398,20 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
 
-	if (z_is_inactive_timeout(timeout)) {
+	if (z_is_inactive_timeout(timeout) || is_batched(timeout)) {
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -223,6 +474,8 @@ void z_set_timeout_expiry(int32_t ticks, bool is_idle)
 
 void z_clock_announce(int32_t ticks)
 {
+	sys_trace_void(SYS_TRACE_ID_CLOCK_ANNOUNCE);
+
 #ifdef CONFIG_TIMESLICING
 	z_time_slice(ticks);
 #endif
@@ -231,18 +484,73 @@ void z_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	uint64_t end = curr_tick + ticks;
+	uint64_t ev;
+	int level;
+
+	while ((ev = wheel_next_event(&level)) <= end) {
+		curr_tick = ev;
+		announce_remaining = end - ev;
+
+		if (level > 0) {
+			wheel_cascade(level);
+			continue;
+		}
+
+		sys_dlist_t *slot = &wheel[0][wheel_index(ev, 0)];
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+		sys_dnode_t *node;
+
+		/* Everything in a level 0 slot is due on this tick */
+		while ((node = sys_dlist_peek_head(slot)) != NULL) {
+			struct _timeout *t = CONTAINER_OF(node,
+							  struct _timeout,
+							  node);
+
+			remove_timeout(t);
+			detach_expired(t);
+		}
+
+		key = run_expired(key);
+#else
+		struct _timeout *t = CONTAINER_OF(sys_dlist_peek_head(slot),
+						  struct _timeout, node);
+
+		remove_timeout(t);
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+#endif
+	}
+
+	curr_tick = end;
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
 
 		curr_tick += dt;
 		announce_remaining -= dt;
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+		/* Timeouts due on the same tick follow with a zero delta */
+		do {
+			t->dticks = 0;
+			remove_timeout(t);
+			detach_expired(t);
+			t = first();
+		} while (t != NULL && t->dticks == 0);
+
+		key = run_expired(key);
+#else
 		t->dticks = 0;
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
+#endif
 	}
 
 	if (first() != NULL) {
@@ -250,11 +558,14 @@ void z_clock_announce(int32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif
 	announce_remaining = 0;
 
 	z_clock_set_timeout(next_timeout(), false);
 
 	k_spin_unlock(&timeout_lock, key);
+
+	sys_trace_end_call(SYS_TRACE_ID_CLOCK_ANNOUNCE);
 }
 
 int64_t z_tick_get(void)
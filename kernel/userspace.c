@@ -7,6 +7,7 @@
 
 #include <kernel.h>
 #include <string.h>
+#include <limits.h>
 #include <sys/math_extras.h>
 #include <sys/rb.h>
 #include <kernel_structs.h>
@@ -20,6 +21,7 @@
 #include <app_memory/app_memdomain.h>
 #include <sys/libc-hooks.h>
 #include <sys/mutex.h>
+#include <sys/syscall_batch.h>
 #include <inttypes.h>
 
 #ifdef Z_LIBC_PARTITION_EXISTS
@@ -47,7 +49,7 @@ LOG_MODULE_DECLARE(os);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj table/rbtree/dlist */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -114,7 +116,9 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct z_object kobj;
 	sys_dnode_t obj_list;
+#ifndef CONFIG_DYNAMIC_OBJECTS_HASH
 	struct rbnode node; /* must be immediately before data member */
+#endif
 	uint8_t data[]; /* The object itself */
 };
 
@@ -122,6 +126,22 @@ extern struct z_object *z_object_gperf_find(const void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+/*
+ * Open addressing (linear probing) hash table of allocated kernel
+ * objects, keyed by object pointer value, so lookups take constant time.
+ * Freed slots become tombstones.  The table is allocated from the system
+ * heap and rebuilt, twice as large and without tombstones, when more
+ * than three quarters of its slots are in use.
+ */
+#define OBJ_TABLE_MIN_SIZE	16
+#define OBJ_TABLE_TOMBSTONE	((struct dyn_obj *)1)
+
+static struct dyn_obj **obj_table;
+static size_t obj_table_size;	/* Power of two, or 0 if not allocated */
+static size_t obj_table_used;	/* Live entries plus tombstones */
+static size_t obj_table_live;
+#else
 static bool node_lessthan(struct rbnode *a, struct rbnode *b);
 
 /*
@@ -131,6 +151,7 @@ static bool node_lessthan(struct rbnode *a, struct rbnode *b);
 static struct rbtree obj_rb_tree = {
 	.lessthan_fn = node_lessthan
 };
+#endif
 
 /*
  * Linked list of allocated kernel objects, for iteration over all allocated
@@ -138,11 +159,6 @@ static struct rbtree obj_rb_tree = {
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
- */
-
 static size_t obj_size_get(enum k_objects otype)
 {
 	size_t ret;
@@ -157,6 +173,90 @@ static size_t obj_size_get(enum k_objects otype)
 	return ret;
 }
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+static inline size_t obj_hash(const void *obj)
+{
+	/* Heap allocations are at least 8 byte aligned, and objects
+	 * allocated close together vary in the next few bits.
+	 */
+	uintptr_t h = (uintptr_t)obj >> 3;
+
+	return (size_t)(h ^ (h >> 10));
+}
+
+/* Returns the slot holding obj, or NULL */
+static struct dyn_obj **obj_table_slot(const void *obj)
+{
+	size_t mask = obj_table_size - 1;
+	size_t i = obj_hash(obj) & mask;
+
+	for (size_t n = 0; n < obj_table_size; n++) {
+		struct dyn_obj *dyn = obj_table[i];
+
+		if (dyn == NULL) {
+			break;
+		}
+
+		if ((dyn != OBJ_TABLE_TOMBSTONE) && (dyn->data == obj)) {
+			return &obj_table[i];
+		}
+
+		i = (i + 1) & mask;
+	}
+
+	return NULL;
+}
+
+static void obj_table_put(struct dyn_obj **table, size_t size,
+			  struct dyn_obj *dyn)
+{
+	size_t mask = size - 1;
+	size_t i = obj_hash(dyn->data) & mask;
+
+	while ((table[i] != NULL) && (table[i] != OBJ_TABLE_TOMBSTONE)) {
+		i = (i + 1) & mask;
+	}
+
+	if (table[i] == NULL) {
+		obj_table_used++;
+	}
+	table[i] = dyn;
+}
+
+static bool obj_table_insert(struct dyn_obj *dyn)
+{
+	if ((obj_table_used + 1) * 4 > obj_table_size * 3) {
+		size_t size = MAX(obj_table_size, OBJ_TABLE_MIN_SIZE);
+		struct dyn_obj **table;
+
+		while ((obj_table_live + 1) * 2 > size) {
+			size *= 2;
+		}
+
+		table = k_calloc(size, sizeof(*table));
+		if (table == NULL) {
+			return false;
+		}
+
+		obj_table_used = 0;
+		for (size_t i = 0; i < obj_table_size; i++) {
+			if ((obj_table[i] != NULL) &&
+			    (obj_table[i] != OBJ_TABLE_TOMBSTONE)) {
+				obj_table_put(table, size, obj_table[i]);
+			}
+		}
+
+		k_free(obj_table);
+		obj_table = table;
+		obj_table_size = size;
+	}
+
+	obj_table_put(obj_table, obj_table_size, dyn);
+	obj_table_live++;
+
+	return true;
+}
+#else
 static bool node_lessthan(struct rbnode *a, struct rbnode *b)
 {
 	return a < b;
@@ -166,11 +266,38 @@ static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
 {
 	return CONTAINER_OF(node, struct dyn_obj, node);
 }
+#endif
+
+/* Drops an object from the lookup structures.  Like the rest of the
+ * object teardown this relies on the locking of the callers.
+ */
+static void dyn_object_unlink(struct dyn_obj *dyn)
+{
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+	struct dyn_obj **slot = obj_table_slot(dyn->data);
+
+	__ASSERT_NO_MSG(slot != NULL);
+	*slot = OBJ_TABLE_TOMBSTONE;
+	obj_table_live--;
+#else
+	rb_remove(&obj_rb_tree, &dyn->node);
+#endif
+	sys_dlist_remove(&dyn->obj_list);
+}
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
 	struct dyn_obj *ret;
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+	struct dyn_obj **slot;
+
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	slot = obj_table_slot(obj);
+	ret = (slot != NULL) ? *slot : NULL;
+	k_spin_unlock(&lists_lock, key);
+#else
+	struct rbnode *node;
 
 	/* For any dynamically allocated kernel object, the object
 	 * pointer is just a member of the conatining struct dyn_obj,
@@ -186,6 +313,7 @@ static struct dyn_obj *dyn_object_find(void *obj)
 		ret = NULL;
 	}
 	k_spin_unlock(&lists_lock, key);
+#endif
 
 	return ret;
 }
@@ -270,7 +398,16 @@ struct z_object *z_dynamic_object_create(size_t size)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+	if (!obj_table_insert(dyn)) {
+		k_spin_unlock(&lists_lock, key);
+		LOG_ERR("could not grow kernel object table, out of memory");
+		k_free(dyn);
+		return NULL;
+	}
+#else
 	rb_insert(&obj_rb_tree, &dyn->node);
+#endif
 	sys_dlist_append(&obj_list, &dyn->obj_list);
 	k_spin_unlock(&lists_lock, key);
 
@@ -350,8 +487,7 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
-		sys_dlist_remove(&dyn->obj_list);
+		dyn_object_unlink(dyn);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -454,8 +590,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
-	sys_dlist_remove(&dyn->obj_list);
+	dyn_object_unlink(dyn);
 	k_free(dyn);
 out:
 #endif
@@ -823,6 +958,54 @@ static int app_shmem_bss_zero(const struct device *unused)
 
 SYS_INIT(app_shmem_bss_zero, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
 
+#ifdef CONFIG_SYSCALL_BATCH
+int z_impl_k_syscall_batch(struct k_syscall_entry *entries, size_t num)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(num);
+
+	/* Supervisor threads have nothing to gain from batching */
+	return -ENOSYS;
+}
+
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_entry *entries,
+					 size_t num)
+{
+	void *ssf = _current->syscall_frame;
+	struct k_syscall_entry entry;
+
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(num <= INT_MAX, "too many entries"));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(entries, num, sizeof(*entries)));
+
+	for (size_t i = 0; i < num; i++) {
+		/* Work on a copy so user mode can't change the entry
+		 * between the checks of the handler and its use
+		 */
+		(void)memcpy(&entry, &entries[i], sizeof(entry));
+
+		if ((entry.id >= K_SYSCALL_LIMIT) ||
+		    (entry.id == K_SYSCALL_K_SYSCALL_BATCH)) {
+			entry.args[0] = entry.id;
+			entry.id = K_SYSCALL_BAD;
+		}
+
+		entries[i].ret = _k_syscall_table[entry.id](entry.args[0],
+							    entry.args[1],
+							    entry.args[2],
+							    entry.args[3],
+							    entry.args[4],
+							    entry.args[5],
+							    ssf);
+	}
+
+	/* Each handler clears the frame when done */
+	_current->syscall_frame = ssf;
+
+	return (int)num;
+}
+#include <syscalls/syscall_batch_mrsh.c>
+#endif /* CONFIG_SYSCALL_BATCH */
+
 /*
  * Default handlers if otherwise unimplemented
  */
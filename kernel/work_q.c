@@ -36,6 +36,43 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+static void work_pool_worker_start(struct k_work_pool *pool,
+				   struct k_thread *thread, int idx, int prio,
+				   uint32_t options)
+{
+	k_thread_stack_t *stack = &pool->stacks[idx * pool->stack_stride];
+
+	(void)k_thread_create(thread, stack, pool->stack_size, z_work_q_main,
+			      &pool->work_q, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((options & K_WORK_POOL_PIN_CPU) != 0U) {
+		(void)k_thread_cpu_mask_clear(thread);
+		(void)k_thread_cpu_mask_enable(thread,
+					       idx % CONFIG_MP_NUM_CPUS);
+	}
+#else
+	ARG_UNUSED(options);
+#endif
+
+	k_thread_start(thread);
+}
+
+void k_work_pool_start(struct k_work_pool *pool, int prio, uint32_t options)
+{
+	/* All workers wait on the same queue: each submission goes to
+	 * whichever of them pends first, i.e. an idle one.
+	 */
+	k_queue_init(&pool->work_q.queue);
+
+	work_pool_worker_start(pool, &pool->work_q.thread, 0, prio, options);
+	for (int i = 1; i < pool->num_workers; i++) {
+		work_pool_worker_start(pool, &pool->workers[i - 1], i, prio,
+				       options);
+	}
+}
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -8,7 +8,6 @@
 #include "wrapper.h"
 
 #define DONT_CARE               (0)
-#define NSEC_PER_MSEC           (NSEC_PER_USEC * USEC_PER_MSEC)
 
 /**
  * @brief Set the specified Thread Flags of a thread.
@@ -80,6 +79,15 @@ uint32_t osThreadFlagsClear(uint32_t flags)
 	return sig;
 }
 
+static bool flags_satisfied(uint32_t sig, uint32_t flags, uint32_t options)
+{
+	if (options & osFlagsWaitAll) {
+		return (sig & flags) == flags;
+	}
+
+	return (sig & flags) != 0U;
+}
+
 /**
  * @brief Wait for one or more Thread Flags of the current running thread to
  *        become signalled.
@@ -87,10 +95,10 @@ uint32_t osThreadFlagsClear(uint32_t flags)
 uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
 {
 	struct cv2_thread *tid;
+	k_timeout_t wait = K_FOREVER;
+	int64_t end = 0;
 	int retval, key;
 	uint32_t sig;
-	uint32_t time_delta_ms, timeout_ms = k_ticks_to_ms_floor64(timeout);
-	uint64_t time_stamp_start, hwclk_cycles_delta, time_delta_ns;
 
 	if (k_is_in_isr()) {
 		return osFlagsErrorUnknown;
@@ -105,79 +113,41 @@ uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
 		return osFlagsErrorUnknown;
 	}
 
+	if (timeout != osWaitForever) {
+		end = k_uptime_ticks() + timeout;
+	}
+
 	for (;;) {
+		key = irq_lock();
 
-		time_stamp_start = (uint64_t)k_cycle_get_32();
-
-		switch (timeout) {
-		case 0:
-			retval = k_poll(&tid->poll_event, 1, K_NO_WAIT);
-			break;
-		case osWaitForever:
-			retval = k_poll(&tid->poll_event, 1, K_FOREVER);
-			break;
-		default:
-			retval = k_poll(&tid->poll_event, 1,
-					K_MSEC(timeout_ms));
-			break;
-		}
+		sig = tid->signal_results;
+		if (flags_satisfied(sig, flags, options)) {
+			if (!(options & osFlagsNoClear)) {
+				/* Consume the flags waited for */
+				tid->signal_results &= ~(flags);
+			}
 
-		switch (retval) {
-		case 0:
-			break;
-		case -EAGAIN:
-			return osFlagsErrorTimeout;
-		default:
-			return osFlagsErrorUnknown;
+			irq_unlock(key);
+			return sig;
 		}
 
-		__ASSERT(tid->poll_event.state == K_POLL_STATE_SIGNALED,
-			 "event state not signalled!");
-		__ASSERT(tid->poll_event.signal->signaled == 1U,
-			 "event signaled is not 1");
-
-		/* Reset the states to facilitate the next trigger */
-		tid->poll_event.signal->signaled = 0U;
+		/* Only the flags set from now on wake the thread up, the
+		 * ones set before were just checked.
+		 */
+		tid->poll_signal.signaled = 0U;
 		tid->poll_event.state = K_POLL_STATE_NOT_READY;
 
-		if (options & osFlagsWaitAll) {
-			/* Check if all events we are waiting on have
-			 * been signalled
-			 */
-			if ((tid->signal_results & flags) == flags) {
-				break;
-			}
-
-			/* If we need to wait on more signals, we need to
-			 * adjust the timeout value accordingly based on
-			 * the time that has already elapsed.
-			 */
-			hwclk_cycles_delta =
-				(uint64_t)k_cycle_get_32() - time_stamp_start;
-
-			time_delta_ns =
-				(uint32_t)k_cyc_to_ns_floor64(hwclk_cycles_delta);
-
-			time_delta_ms = (uint32_t)time_delta_ns / NSEC_PER_MSEC;
+		irq_unlock(key);
 
-			if (timeout_ms > time_delta_ms) {
-				timeout_ms -= time_delta_ms;
-			} else {
-				timeout_ms = 0U;
-			}
-		} else {
-			break;
+		if (timeout != osWaitForever) {
+			wait = K_TICKS(MAX(end - k_uptime_ticks(), 0));
 		}
-	}
-
-	sig = tid->signal_results;
-	if (!(options & osFlagsNoClear)) {
 
-		/* Clear signal flags as the thread is ready now */
-		key = irq_lock();
-		tid->signal_results &= ~(flags);
-		irq_unlock(key);
+		retval = k_poll(&tid->poll_event, 1, wait);
+		if (retval == -EAGAIN) {
+			return osFlagsErrorTimeout;
+		} else if (retval != 0) {
+			return osFlagsErrorUnknown;
+		}
 	}
-
-	return sig;
 }
@@ -4,8 +4,56 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr.h>
 #include "lvgl_display.h"
 
+#if defined(CONFIG_DISPLAY_ASYNC) && defined(CONFIG_LVGL_DOUBLE_VDB)
+/* With two buffers LVGL renders into one while the other is flushed, the
+ * flush is reported ready once the display has completed the transfer.
+ */
+static struct k_poll_signal flush_signal =
+	K_POLL_SIGNAL_INITIALIZER(flush_signal);
+static struct k_poll_event flush_event =
+	K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					K_POLL_MODE_NOTIFY_ONLY,
+					&flush_signal, 0);
+static struct k_work_poll flush_work;
+static struct _disp_drv_t *flush_drv;
+
+static void lvgl_flush_done(struct k_work *work)
+{
+	lv_disp_flush_ready(flush_drv);
+}
+
+int lvgl_flush_async(struct _disp_drv_t *disp_drv, const lv_area_t *area,
+		     const struct display_buffer_descriptor *desc,
+		     lv_color_t *color_p)
+{
+	const struct device *display_dev = (const struct device *)disp_drv->user_data;
+	int err;
+
+	if (flush_drv == NULL) {
+		k_work_poll_init(&flush_work, lvgl_flush_done);
+	}
+
+	flush_drv = disp_drv;
+	k_poll_signal_reset(&flush_signal);
+
+	err = k_work_poll_submit(&flush_work, &flush_event, 1, K_FOREVER);
+	if (err) {
+		return err;
+	}
+
+	err = display_write_async(display_dev, area->x1, area->y1, desc,
+				  (void *) color_p, &flush_signal);
+	if (err) {
+		k_work_poll_cancel(&flush_work);
+	}
+
+	return err;
+}
+#endif
+
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 {
 	int err = 0;
@@ -41,6 +89,7 @@ int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 		break;
 	case PIXEL_FORMAT_MONO01:
 	case PIXEL_FORMAT_MONO10:
+		lvgl_mono_caps_set(&cap);
 		disp_drv->flush_cb = lvgl_flush_cb_mono;
 		disp_drv->rounder_cb = lvgl_rounder_cb_mono;
 		disp_drv->set_px_cb = lvgl_set_px_cb_mono;
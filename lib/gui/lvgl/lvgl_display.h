@@ -38,6 +38,18 @@ void lvgl_set_px_cb_32bit(struct _disp_drv_t *disp_drv,
 
 void lvgl_rounder_cb_mono(struct _disp_drv_t *disp_drv, lv_area_t *area);
 
+/* Keeps the layout of monochrome displays for the per pixel callback */
+void lvgl_mono_caps_set(const struct display_capabilities *cap);
+
+#if defined(CONFIG_DISPLAY_ASYNC) && defined(CONFIG_LVGL_DOUBLE_VDB)
+/* Starts writing an area, lv_disp_flush_ready() is called on completion.
+ * An error is returned if the write could not be started.
+ */
+int lvgl_flush_async(struct _disp_drv_t *disp_drv, const lv_area_t *area,
+		     const struct display_buffer_descriptor *desc,
+		     lv_color_t *color_p);
+#endif
+
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv);
 
 #ifdef __cplusplus
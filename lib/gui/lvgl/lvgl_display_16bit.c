@@ -8,6 +8,30 @@
 #include <lvgl.h>
 #include "lvgl_display.h"
 
+#ifdef CONFIG_LVGL_FLUSH_16_SWAP
+/* Swaps the bytes of the pixels in place, two pixels at a time */
+static void lvgl_swap_16bit(uint16_t *px, size_t count)
+{
+	uint32_t *pair;
+
+	if (((uintptr_t)px & 2U) != 0U && count > 0) {
+		*px = __builtin_bswap16(*px);
+		px++;
+		count--;
+	}
+
+	for (pair = (uint32_t *)px; count >= 2; pair++, count -= 2) {
+		*pair = ((*pair & 0x00ff00ffU) << 8) |
+			((*pair >> 8) & 0x00ff00ffU);
+	}
+
+	if (count > 0) {
+		px = (uint16_t *)pair;
+		*px = __builtin_bswap16(*px);
+	}
+}
+#endif
+
 void lvgl_flush_cb_16bit(struct _disp_drv_t *disp_drv,
 		const lv_area_t *area, lv_color_t *color_p)
 {
@@ -20,6 +44,18 @@ void lvgl_flush_cb_16bit(struct _disp_drv_t *disp_drv,
 	desc.width = w;
 	desc.pitch = w;
 	desc.height = h;
+
+#ifdef CONFIG_LVGL_FLUSH_16_SWAP
+	/* LVGL is done with the buffer until the flush is reported ready */
+	lvgl_swap_16bit((uint16_t *)color_p, w * h);
+#endif
+
+#if defined(CONFIG_DISPLAY_ASYNC) && defined(CONFIG_LVGL_DOUBLE_VDB)
+	if (lvgl_flush_async(disp_drv, area, &desc, color_p) == 0) {
+		return;
+	}
+#endif
+
 	display_write(display_dev, area->x1, area->y1, &desc, (void *) color_p);
 
 	lv_disp_flush_ready(disp_drv);
@@ -20,6 +20,13 @@ void lvgl_flush_cb_24bit(struct _disp_drv_t *disp_drv,
 	desc.width = w;
 	desc.pitch = w;
 	desc.height = h;
+
+#if defined(CONFIG_DISPLAY_ASYNC) && defined(CONFIG_LVGL_DOUBLE_VDB)
+	if (lvgl_flush_async(disp_drv, area, &desc, color_p) == 0) {
+		return;
+	}
+#endif
+
 	display_write(display_dev, area->x1, area->y1, &desc, (void *) color_p);
 
 	lv_disp_flush_ready(disp_drv);
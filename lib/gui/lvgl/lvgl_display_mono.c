@@ -8,6 +8,18 @@
 #include <lvgl.h>
 #include "lvgl_display.h"
 
+/* Taken once from the display, LVGL calls set_px_cb for every pixel */
+static bool mono_vtiled;
+static bool mono_msb_first;
+static bool mono_10;
+
+void lvgl_mono_caps_set(const struct display_capabilities *cap)
+{
+	mono_vtiled = (cap->screen_info & SCREEN_INFO_MONO_VTILED) != 0U;
+	mono_msb_first = (cap->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0U;
+	mono_10 = cap->current_pixel_format == PIXEL_FORMAT_MONO10;
+}
+
 void lvgl_flush_cb_mono(struct _disp_drv_t *disp_drv,
 		const lv_area_t *area, lv_color_t *color_p)
 {
@@ -37,43 +49,26 @@ void lvgl_set_px_cb_mono(struct _disp_drv_t *disp_drv,
 		uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
 		lv_color_t color, lv_opa_t opa)
 {
-	const struct device *display_dev = (const struct device *)disp_drv->user_data;
 	uint8_t *buf_xy;
 	uint8_t bit;
-	struct display_capabilities cap;
 
-	display_get_capabilities(display_dev, &cap);
-
-	if (cap.screen_info & SCREEN_INFO_MONO_VTILED) {
-		buf_xy = buf + x + y/8 * buf_w;
-
-		if (cap.screen_info & SCREEN_INFO_MONO_MSB_FIRST) {
-			bit = 7 - y%8;
-		} else {
-			bit = y%8;
-		}
+	if (mono_vtiled) {
+		buf_xy = buf + x + (y >> 3) * buf_w;
+		bit = y & 7;
 	} else {
-		buf_xy = buf + x/8 + y * buf_w/8;
+		buf_xy = buf + (x >> 3) + ((y * buf_w) >> 3);
+		bit = x & 7;
+	}
 
-		if (cap.screen_info & SCREEN_INFO_MONO_MSB_FIRST) {
-			bit = 7 - x%8;
-		} else {
-			bit = x%8;
-		}
+	if (mono_msb_first) {
+		bit = 7 - bit;
 	}
 
-	if (cap.current_pixel_format == PIXEL_FORMAT_MONO10) {
-		if (color.full == 0) {
-			*buf_xy &= ~BIT(bit);
-		} else {
-			*buf_xy |= BIT(bit);
-		}
+	/* MONO10 sets the bits of the non zero pixels, MONO01 clears them */
+	if ((color.full != 0) == mono_10) {
+		*buf_xy |= BIT(bit);
 	} else {
-		if (color.full == 0) {
-			*buf_xy |= BIT(bit);
-		} else {
-			*buf_xy &= ~BIT(bit);
-		}
+		*buf_xy &= ~BIT(bit);
 	}
 }
 
@@ -10,6 +10,23 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+/* Word with every byte set to <b> */
+#define WORD_REPEAT(b) (((mem_word_t)-1 / 0xFF) * (b))
+
+/* Non-zero if one of the bytes of word <w> is zero */
+#define WORD_HAS_ZERO(w) (((w) - WORD_REPEAT(0x01)) & ~(w) & WORD_REPEAT(0x80))
+
+/* Bytes of two consecutive aligned words, starting <sh> bits into <lo> */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define WORD_MERGE(lo, hi, sh) \
+	(((lo) << (sh)) | ((hi) >> (Z_MEM_WORD_T_WIDTH - (sh))))
+#else
+#define WORD_MERGE(lo, hi, sh) \
+	(((lo) >> (sh)) | ((hi) << (Z_MEM_WORD_T_WIDTH - (sh))))
+#endif
+#endif /* CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING */
+
 /**
  *
  * @brief Copy a string
@@ -106,14 +123,36 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *start = s;
+
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	const mem_word_t *s_word;
+
+	while (((uintptr_t)s) & (sizeof(mem_word_t) - 1)) {
+		if (*s == '\0') {
+			return s - start;
+		}
+		s++;
+	}
+
+	/*
+	 * An aligned word holding the terminator never extends past the
+	 * memory the string is in.
+	 */
+	s_word = (const mem_word_t *)s;
+
+	while (!WORD_HAS_ZERO(*s_word)) {
+		s_word++;
+	}
+
+	s = (const char *)s_word;
+#endif
 
 	while (*s != '\0') {
 		s++;
-		n++;
 	}
 
-	return n;
+	return s - start;
 }
 
 /**
@@ -144,6 +183,33 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & mask) == 0) {
+		while (((uintptr_t)s1) & mask) {
+			if ((*s1 != *s2) || (*s1 == '\0')) {
+				return *s1 - *s2;
+			}
+			s1++;
+			s2++;
+		}
+
+		/* compare words until they differ or hold the terminator */
+
+		const mem_word_t *w1 = (const mem_word_t *)s1;
+		const mem_word_t *w2 = (const mem_word_t *)s2;
+
+		while ((*w1 == *w2) && !WORD_HAS_ZERO(*w1)) {
+			w1++;
+			w2++;
+		}
+
+		s1 = (const char *)w1;
+		s2 = (const char *)w2;
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -241,6 +307,34 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	const char *c1 = m1;
 	const char *c2 = m2;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & mask) == 0) {
+		while ((n > 0) && (((uintptr_t)c1) & mask) && (*c1 == *c2)) {
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* skip the equal words, the bytes compare the first other one */
+
+		if ((((uintptr_t)c1) & mask) == 0) {
+			const mem_word_t *w1 = (const mem_word_t *)c1;
+			const mem_word_t *w2 = (const mem_word_t *)c2;
+
+			while ((n >= sizeof(mem_word_t)) && (*w1 == *w2)) {
+				w1++;
+				w2++;
+				n -= sizeof(mem_word_t);
+			}
+
+			c1 = (const char *)w1;
+			c2 = (const char *)w2;
+		}
+	}
+#endif
+
 	if (!n) {
 		return 0;
 	}
@@ -297,10 +391,93 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
 	unsigned char *d_byte = (unsigned char *)d;
 	const unsigned char *s_byte = (const unsigned char *)s;
+
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) && defined(CONFIG_X86)
+	/*
+	 * With fast strings this is the quickest copy for any size and
+	 * alignment, and it stays short on processors without them.
+	 */
+	__asm__ volatile("rep movsb"
+			 : "+D" (d_byte), "+S" (s_byte), "+c" (n)
+			 :
+			 : "memory");
+#elif defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if (n >= 2 * sizeof(mem_word_t)) {
+
+		/* do byte-sized copying until the destination is aligned */
+
+		while (((uintptr_t)d_byte) & mask) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+
+		if ((((uintptr_t)s_byte) & mask) == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+			while (n >= 4 * sizeof(mem_word_t)) {
+				__asm__ volatile("ldmia %1!, {r2-r5}\n\t"
+						 "stmia %0!, {r2-r5}"
+						 : "+r" (d_word), "+r" (s_word)
+						 :
+						 : "r2", "r3", "r4", "r5",
+						   "memory");
+				n -= 4 * sizeof(mem_word_t);
+			}
+#else
+			while (n >= 4 * sizeof(mem_word_t)) {
+				d_word[0] = s_word[0];
+				d_word[1] = s_word[1];
+				d_word[2] = s_word[2];
+				d_word[3] = s_word[3];
+				d_word += 4;
+				s_word += 4;
+				n -= 4 * sizeof(mem_word_t);
+			}
+#endif
+
+			while (n >= sizeof(mem_word_t)) {
+				*(d_word++) = *(s_word++);
+				n -= sizeof(mem_word_t);
+			}
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			/*
+			 * Read the source with aligned words as well and
+			 * shift each destination word out of two of them.
+			 * The words read past either end of the source
+			 * still share a word with it.
+			 */
+			uintptr_t off = ((uintptr_t)s_byte) & mask;
+			unsigned int shift = off * 8U;
+			const mem_word_t *s_word =
+				(const mem_word_t *)(s_byte - off);
+			mem_word_t cur = *(s_word++);
+			mem_word_t next;
+
+			while (n >= sizeof(mem_word_t)) {
+				next = *(s_word++);
+				*(d_word++) = WORD_MERGE(cur, next, shift);
+				cur = next;
+				n -= sizeof(mem_word_t);
+			}
+
+			s_byte = (const unsigned char *)s_word -
+				 sizeof(mem_word_t) + off;
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+#else
+	/* attempt word-sized copying only if buffers have identical alignment */
+
 	const uintptr_t mask = sizeof(mem_word_t) - 1;
 
 	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
@@ -328,6 +505,7 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
 	}
+#endif
 
 	/* do byte-sized copying until finished */
 
@@ -353,6 +531,15 @@ void *memset(void *buf, int c, size_t n)
 	unsigned char *d_byte = (unsigned char *)buf;
 	unsigned char c_byte = (unsigned char)c;
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) && defined(CONFIG_X86)
+	__asm__ volatile("rep stosb"
+			 : "+D" (d_byte), "+c" (n)
+			 : "a" (c_byte)
+			 : "memory");
+
+	return buf;
+#endif
+
 	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
 		if (n == 0) {
 			return buf;
@@ -372,6 +559,17 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/btree.h>
+#include <sys/util.h>
+#include <toolchain.h>
+#include <errno.h>
+#include <string.h>
+
+/*
+ * Conventional B-tree of minimum degree T: every node but the root holds
+ * T - 1 to 2 * T - 1 elements, every internal node one child more than it
+ * has elements. Inserts split the full nodes on the way down, so that a
+ * split never needs to go back up; removals take the element out of a
+ * leaf and refill the nodes left under the minimum from a sibling, or
+ * merge them with it, on the way back up.
+ */
+#define T (CONFIG_BTREE_FANOUT / 2)
+#define MIN_ELEMS (T - 1)
+#define MAX_ELEMS Z_BTREE_MAX_ELEMS
+
+BUILD_ASSERT(CONFIG_BTREE_FANOUT >= 4 && (CONFIG_BTREE_FANOUT % 2) == 0,
+	     "B-tree fanout must be even and at least 4");
+BUILD_ASSERT(CONFIG_BTREE_FANOUT <= UINT8_MAX, "B-tree fanout too large");
+
+static struct btree_node *node_alloc(struct btree *tree, bool leaf)
+{
+	struct btree_node *node = tree->free;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	/* Free nodes are linked through their parent pointer */
+	tree->free = node->parent;
+	node->parent = NULL;
+	node->num = 0U;
+	node->leaf = leaf;
+
+	return node;
+}
+
+static void node_free(struct btree *tree, struct btree_node *node)
+{
+	node->parent = tree->free;
+	tree->free = node;
+}
+
+/* Index of the first element greater than elem */
+static int upper_bound(struct btree *tree, struct btree_node *node,
+		       const void *elem)
+{
+	int lo = 0, hi = node->num;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (tree->lessthan_fn(elem, node->elems[mid])) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return lo;
+}
+
+/* Index of the first element not less than key */
+static int lower_bound(struct btree *tree, struct btree_node *node,
+		       const void *key)
+{
+	int lo = 0, hi = node->num;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (tree->lessthan_fn(node->elems[mid], key)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static int child_index(struct btree_node *parent, struct btree_node *child)
+{
+	int i = 0;
+
+	while (parent->children[i] != child) {
+		i++;
+	}
+
+	return i;
+}
+
+static void set_children(struct btree_node *node, int from, int to)
+{
+	for (int i = from; i < to; i++) {
+		node->children[i]->parent = node;
+	}
+}
+
+void btree_init(struct btree *tree, btree_lessthan_t lessthan_fn,
+		struct btree_node *nodes, size_t num_nodes)
+{
+	tree->root = NULL;
+	tree->free = NULL;
+	tree->lessthan_fn = lessthan_fn;
+	tree->count = 0;
+
+	for (size_t i = 0; i < num_nodes; i++) {
+		node_free(tree, &nodes[i]);
+	}
+}
+
+/* Split the full child i of parent around its median element */
+static int split_child(struct btree *tree, struct btree_node *parent, int i)
+{
+	struct btree_node *child = parent->children[i];
+	struct btree_node *sibling = node_alloc(tree, child->leaf);
+
+	if (sibling == NULL) {
+		return -ENOMEM;
+	}
+
+	sibling->num = T - 1;
+	memcpy(sibling->elems, &child->elems[T],
+	       (T - 1) * sizeof(child->elems[0]));
+	if (!child->leaf) {
+		memcpy(sibling->children, &child->children[T],
+		       T * sizeof(child->children[0]));
+		set_children(sibling, 0, T);
+	}
+	child->num = T - 1;
+
+	memmove(&parent->elems[i + 1], &parent->elems[i],
+		(parent->num - i) * sizeof(parent->elems[0]));
+	memmove(&parent->children[i + 2], &parent->children[i + 1],
+		(parent->num - i) * sizeof(parent->children[0]));
+	parent->elems[i] = child->elems[T - 1];
+	parent->children[i + 1] = sibling;
+	sibling->parent = parent;
+	parent->num++;
+
+	return 0;
+}
+
+int btree_insert(struct btree *tree, void *elem)
+{
+	struct btree_node *node = tree->root;
+	int i;
+
+	if (node == NULL) {
+		node = node_alloc(tree, true);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+		tree->root = node;
+	} else if (node->num == MAX_ELEMS) {
+		struct btree_node *root = node_alloc(tree, false);
+
+		if (root == NULL) {
+			return -ENOMEM;
+		}
+
+		root->children[0] = node;
+		if (split_child(tree, root, 0) < 0) {
+			node_free(tree, root);
+			return -ENOMEM;
+		}
+
+		node->parent = root;
+		tree->root = root;
+		node = root;
+	}
+
+	/* A split that succeeded leaves a valid tree behind, a later one
+	 * failing needs no undoing.
+	 */
+	while (!node->leaf) {
+		i = upper_bound(tree, node, elem);
+
+		if (node->children[i]->num == MAX_ELEMS) {
+			if (split_child(tree, node, i) < 0) {
+				return -ENOMEM;
+			}
+
+			if (!tree->lessthan_fn(elem, node->elems[i])) {
+				i++;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	i = upper_bound(tree, node, elem);
+	memmove(&node->elems[i + 1], &node->elems[i],
+		(node->num - i) * sizeof(node->elems[0]));
+	node->elems[i] = elem;
+	node->num++;
+	tree->count++;
+
+	return 0;
+}
+
+/* Move the iterator to the next element in order, or past the end */
+static void step(struct _btree_foreach *f)
+{
+	struct btree_node *node = f->node;
+	int i = f->idx;
+
+	if (!node->leaf) {
+		node = node->children[i + 1];
+		while (!node->leaf) {
+			node = node->children[0];
+		}
+		i = 0;
+	} else {
+		i++;
+	}
+
+	while (i >= node->num) {
+		struct btree_node *parent = node->parent;
+
+		if (parent == NULL) {
+			f->node = NULL;
+			return;
+		}
+
+		i = child_index(parent, node);
+		node = parent;
+	}
+
+	f->node = node;
+	f->idx = i;
+}
+
+/*
+ * Position of the first element equal to key: the last equal element met
+ * descending along the lower bounds, the earlier ones being in the
+ * subtree on its left.
+ */
+static bool locate_first(struct btree *tree, const void *key,
+			 struct _btree_foreach *f)
+{
+	struct btree_node *node = tree->root;
+
+	f->node = NULL;
+
+	while (node != NULL) {
+		int i = lower_bound(tree, node, key);
+
+		if (i < node->num && !tree->lessthan_fn(key, node->elems[i])) {
+			f->node = node;
+			f->idx = i;
+		}
+
+		node = node->leaf ? NULL : node->children[i];
+	}
+
+	return f->node != NULL;
+}
+
+/* Position of elem, among the elements comparing equal to it */
+static bool locate(struct btree *tree, void *elem, struct _btree_foreach *f)
+{
+	if (!locate_first(tree, elem, f)) {
+		return false;
+	}
+
+	while (f->node != NULL && f->node->elems[f->idx] != elem) {
+		step(f);
+		if (f->node == NULL ||
+		    tree->lessthan_fn(elem, f->node->elems[f->idx])) {
+			return false;
+		}
+	}
+
+	return f->node != NULL;
+}
+
+/* Refill node i of parent from its left sibling */
+static void rotate_right(struct btree_node *parent, int i)
+{
+	struct btree_node *node = parent->children[i];
+	struct btree_node *left = parent->children[i - 1];
+
+	memmove(&node->elems[1], &node->elems[0],
+		node->num * sizeof(node->elems[0]));
+	node->elems[0] = parent->elems[i - 1];
+	parent->elems[i - 1] = left->elems[left->num - 1];
+
+	if (!node->leaf) {
+		memmove(&node->children[1], &node->children[0],
+			(node->num + 1) * sizeof(node->children[0]));
+		node->children[0] = left->children[left->num];
+		node->children[0]->parent = node;
+	}
+
+	left->num--;
+	node->num++;
+}
+
+/* Refill node i of parent from its right sibling */
+static void rotate_left(struct btree_node *parent, int i)
+{
+	struct btree_node *node = parent->children[i];
+	struct btree_node *right = parent->children[i + 1];
+
+	node->elems[node->num] = parent->elems[i];
+	parent->elems[i] = right->elems[0];
+	memmove(&right->elems[0], &right->elems[1],
+		(right->num - 1) * sizeof(right->elems[0]));
+
+	if (!node->leaf) {
+		node->children[node->num + 1] = right->children[0];
+		node->children[node->num + 1]->parent = node;
+		memmove(&right->children[0], &right->children[1],
+			right->num * sizeof(right->children[0]));
+	}
+
+	right->num--;
+	node->num++;
+}
+
+/* Merge child i + 1 of parent and their separator into child i */
+static void merge(struct btree *tree, struct btree_node *parent, int i)
+{
+	struct btree_node *node = parent->children[i];
+	struct btree_node *right = parent->children[i + 1];
+
+	node->elems[node->num] = parent->elems[i];
+	memcpy(&node->elems[node->num + 1], right->elems,
+	       right->num * sizeof(right->elems[0]));
+
+	if (!node->leaf) {
+		memcpy(&node->children[node->num + 1], right->children,
+		       (right->num + 1) * sizeof(right->children[0]));
+		set_children(node, node->num + 1, node->num + right->num + 2);
+	}
+
+	node->num += right->num + 1;
+
+	memmove(&parent->elems[i], &parent->elems[i + 1],
+		(parent->num - i - 1) * sizeof(parent->elems[0]));
+	memmove(&parent->children[i + 1], &parent->children[i + 2],
+		(parent->num - i - 1) * sizeof(parent->children[0]));
+	parent->num--;
+
+	node_free(tree, right);
+}
+
+int btree_remove(struct btree *tree, void *elem)
+{
+	struct _btree_foreach f;
+	struct btree_node *node;
+	int i;
+
+	if (!locate(tree, elem, &f)) {
+		return -ENOENT;
+	}
+
+	node = f.node;
+	i = f.idx;
+
+	/* Elements of internal nodes are replaced by their predecessor,
+	 * which is then taken out of its leaf.
+	 */
+	if (!node->leaf) {
+		struct btree_node *leaf = node->children[i];
+
+		while (!leaf->leaf) {
+			leaf = leaf->children[leaf->num];
+		}
+
+		node->elems[i] = leaf->elems[leaf->num - 1];
+		node = leaf;
+		i = leaf->num - 1;
+	}
+
+	memmove(&node->elems[i], &node->elems[i + 1],
+		(node->num - i - 1) * sizeof(node->elems[0]));
+	node->num--;
+	tree->count--;
+
+	while (node != tree->root && node->num < MIN_ELEMS) {
+		struct btree_node *parent = node->parent;
+
+		i = child_index(parent, node);
+
+		if (i > 0 && parent->children[i - 1]->num > MIN_ELEMS) {
+			rotate_right(parent, i);
+			break;
+		} else if (i < parent->num &&
+			   parent->children[i + 1]->num > MIN_ELEMS) {
+			rotate_left(parent, i);
+			break;
+		}
+
+		merge(tree, parent, i > 0 ? i - 1 : i);
+		node = parent;
+	}
+
+	node = tree->root;
+	if (node->num == 0U) {
+		tree->root = node->leaf ? NULL : node->children[0];
+		if (tree->root != NULL) {
+			tree->root->parent = NULL;
+		}
+		node_free(tree, node);
+	}
+
+	return 0;
+}
+
+bool btree_contains(struct btree *tree, void *elem)
+{
+	struct _btree_foreach f;
+
+	return locate(tree, elem, &f);
+}
+
+void *btree_find(struct btree *tree, const void *key)
+{
+	struct _btree_foreach f;
+
+	return locate_first(tree, key, &f) ? f.node->elems[f.idx] : NULL;
+}
+
+void *btree_get_min(struct btree *tree)
+{
+	struct btree_node *node = tree->root;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	while (!node->leaf) {
+		node = node->children[0];
+	}
+
+	return node->elems[0];
+}
+
+void *btree_get_max(struct btree *tree)
+{
+	struct btree_node *node = tree->root;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	while (!node->leaf) {
+		node = node->children[node->num];
+	}
+
+	return node->elems[node->num - 1];
+}
+
+void *z_btree_foreach_next(struct btree *tree, struct _btree_foreach *f)
+{
+	if (f->idx < 0) {
+		struct btree_node *node = tree->root;
+
+		if (node == NULL) {
+			f->idx = 0;
+			return NULL;
+		}
+
+		while (!node->leaf) {
+			node = node->children[0];
+		}
+
+		f->node = node;
+		f->idx = 0;
+	} else if (f->node != NULL) {
+		step(f);
+	}
+
+	return f->node != NULL ? f->node->elems[f->idx] : NULL;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/hashmap.h>
+#include <sys/__assert.h>
+#include <errno.h>
+#include <string.h>
+
+/* Slots of a dynamic map on the first insert */
+#define MIN_SLOTS 8
+/* A dynamic map grows once it is more than 3/4 full */
+#define LOAD_NUM 3
+#define LOAD_DEN 4
+
+static inline bool keys_equal(const struct sys_hashmap *map, const void *a,
+			      const void *b)
+{
+	return map->equal_fn == NULL ? a == b : map->equal_fn(a, b);
+}
+
+/*
+ * Probing stops at the first slot whose entry is closer to its home slot
+ * than the key would be: had the key been there, it would have taken that
+ * slot on insertion.
+ */
+static bool find(const struct sys_hashmap *map, const void *key,
+		 uint32_t hash, size_t *idx)
+{
+	size_t mask = map->capacity - 1;
+	size_t i = hash & mask;
+
+	for (uint32_t dist = 1U; dist <= map->capacity; dist++) {
+		const struct sys_hashmap_slot *slot = &map->slots[i];
+
+		if (slot->dist < dist) {
+			return false;
+		}
+
+		if (slot->hash == hash && keys_equal(map, slot->key, key)) {
+			*idx = i;
+			return true;
+		}
+
+		i = (i + 1) & mask;
+	}
+
+	return false;
+}
+
+/* Insert an entry known to be absent, into a map with a free slot */
+static void place(struct sys_hashmap_slot *slots, size_t capacity,
+		  const void *key, void *value, uint32_t hash)
+{
+	struct sys_hashmap_slot cur = {
+		.key = key,
+		.value = value,
+		.hash = hash,
+		.dist = 1U,
+	};
+	size_t mask = capacity - 1;
+	size_t i = hash & mask;
+
+	while (slots[i].dist != 0U) {
+		if (slots[i].dist < cur.dist) {
+			struct sys_hashmap_slot tmp = slots[i];
+
+			slots[i] = cur;
+			cur = tmp;
+		}
+
+		cur.dist++;
+		i = (i + 1) & mask;
+	}
+
+	slots[i] = cur;
+}
+
+static int grow(struct sys_hashmap *map)
+{
+	size_t capacity = map->capacity ? map->capacity * 2 : MIN_SLOTS;
+	struct sys_hashmap_slot *slots;
+
+	slots = map->realloc_fn(NULL, capacity * sizeof(*slots));
+	if (slots == NULL) {
+		return -ENOMEM;
+	}
+
+	memset(slots, 0, capacity * sizeof(*slots));
+
+	for (size_t i = 0; i < map->capacity; i++) {
+		if (map->slots[i].dist != 0U) {
+			place(slots, capacity, map->slots[i].key,
+			      map->slots[i].value, map->slots[i].hash);
+		}
+	}
+
+	if (map->slots != NULL) {
+		(void)map->realloc_fn(map->slots, 0);
+	}
+
+	map->slots = slots;
+	map->capacity = capacity;
+
+	return 0;
+}
+
+/* Shift the entries following a removed one back, instead of leaving a
+ * tombstone, up to a free slot or an entry in its home slot.
+ */
+static void remove_at(struct sys_hashmap *map, size_t i)
+{
+	size_t mask = map->capacity - 1;
+	size_t next = (i + 1) & mask;
+
+	while (map->slots[next].dist > 1U) {
+		map->slots[i] = map->slots[next];
+		map->slots[i].dist--;
+		i = next;
+		next = (next + 1) & mask;
+	}
+
+	map->slots[i].dist = 0U;
+	map->size--;
+}
+
+void sys_hashmap_init(struct sys_hashmap *map, struct sys_hashmap_slot *slots,
+		      size_t num_slots, sys_hashmap_hash_t hash_fn,
+		      sys_hashmap_equal_t equal_fn)
+{
+	__ASSERT((num_slots & (num_slots - 1)) == 0,
+		 "Hash map size must be a power of two");
+
+	map->slots = slots;
+	map->hash_fn = hash_fn;
+	map->equal_fn = equal_fn;
+	map->realloc_fn = NULL;
+	map->capacity = num_slots;
+	map->size = 0;
+
+	memset(slots, 0, num_slots * sizeof(*slots));
+}
+
+void sys_hashmap_init_dynamic(struct sys_hashmap *map,
+			      sys_hashmap_hash_t hash_fn,
+			      sys_hashmap_equal_t equal_fn,
+			      sys_hashmap_realloc_t realloc_fn)
+{
+	map->slots = NULL;
+	map->hash_fn = hash_fn;
+	map->equal_fn = equal_fn;
+	map->realloc_fn = realloc_fn;
+	map->capacity = 0;
+	map->size = 0;
+}
+
+int sys_hashmap_insert(struct sys_hashmap *map, const void *key, void *value,
+		       void **old_value)
+{
+	uint32_t hash = map->hash_fn(key);
+	size_t i;
+	int ret;
+
+	if (map->size != 0 && find(map, key, hash, &i)) {
+		if (old_value != NULL) {
+			*old_value = map->slots[i].value;
+		}
+		map->slots[i].value = value;
+		return 0;
+	}
+
+	if (map->realloc_fn == NULL) {
+		if (map->size == map->capacity) {
+			return -ENOSPC;
+		}
+	} else if ((map->size + 1) * LOAD_DEN > map->capacity * LOAD_NUM) {
+		ret = grow(map);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	place(map->slots, map->capacity, key, value, hash);
+	map->size++;
+
+	return 1;
+}
+
+bool sys_hashmap_get(const struct sys_hashmap *map, const void *key,
+		     void **value)
+{
+	size_t i;
+
+	if (map->size == 0 || !find(map, key, map->hash_fn(key), &i)) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = map->slots[i].value;
+	}
+
+	return true;
+}
+
+bool sys_hashmap_remove(struct sys_hashmap *map, const void *key,
+			void **value)
+{
+	size_t i;
+
+	if (map->size == 0 || !find(map, key, map->hash_fn(key), &i)) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = map->slots[i].value;
+	}
+
+	remove_at(map, i);
+
+	return true;
+}
+
+void sys_hashmap_clear(struct sys_hashmap *map)
+{
+	if (map->realloc_fn != NULL) {
+		if (map->slots != NULL) {
+			(void)map->realloc_fn(map->slots, 0);
+		}
+		map->slots = NULL;
+		map->capacity = 0;
+	} else {
+		memset(map->slots, 0, map->capacity * sizeof(*map->slots));
+	}
+
+	map->size = 0;
+}
+
+/*
+ * A removal during the iteration may wrap entries from the start of the
+ * slots around to the end, where they would be seen twice. They can only
+ * come after all the other entries, counting them down stops in time.
+ */
+bool sys_hashmap_iter_next(const struct sys_hashmap *map,
+			   struct sys_hashmap_iter *iter)
+{
+	if (iter->remaining == 0) {
+		return false;
+	}
+
+	while (map->slots[iter->idx].dist == 0U) {
+		iter->idx++;
+	}
+
+	iter->key = map->slots[iter->idx].key;
+	iter->value = map->slots[iter->idx].value;
+	iter->idx++;
+	iter->remaining--;
+
+	return true;
+}
+
+void sys_hashmap_iter_remove(struct sys_hashmap *map,
+			     struct sys_hashmap_iter *iter)
+{
+	/* The next entry, if any, is shifted into the current slot */
+	iter->idx--;
+	remove_at(map, iter->idx);
+}
+
+uint32_t sys_hashmap_int_hash(const void *key)
+{
+	uint64_t x = (uintptr_t)key;
+	uint32_t h = (uint32_t)(x ^ (x >> 32));
+
+	/* MurmurHash3 finalizer, every input bit affects the low bits */
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+
+	return h;
+}
+
+uint32_t sys_hashmap_str_hash(const void *key)
+{
+	const uint8_t *s = key;
+	uint32_t h = 2166136261U;
+
+	/* FNV-1a */
+	while (*s != '\0') {
+		h ^= *s++;
+		h *= 16777619U;
+	}
+
+	return h;
+}
+
+bool sys_hashmap_str_equal(const void *a, const void *b)
+{
+	return strcmp(a, b) == 0;
+}
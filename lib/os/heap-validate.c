@@ -89,6 +89,27 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks must be valid, used, of their class size, and
+	 * there must be exactly as many as the class count says.
+	 */
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		uint32_t n = 0;
+
+		for (c = h->cache[i]; c != 0; c = next_free_chunk(h, c)) {
+			if (!valid_chunk(h, c) || !chunk_used(h, c) ||
+			    cache_class(h, chunk_size(h, c)) != i ||
+			    ++n > h->cache_count[i]) {
+				return false;
+			}
+		}
+
+		if (n != h->cache_count[i]) {
+			return false;
+		}
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
@@ -126,6 +126,105 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+static inline void stats_alloc(struct z_heap *h, chunkid_t c)
+{
+	size_t bytes = chunksz_to_bytes(h, chunk_size(h, c));
+
+	h->free_bytes -= bytes;
+	h->allocated_bytes += bytes;
+	h->max_allocated_bytes = MAX(h->max_allocated_bytes,
+				     h->allocated_bytes);
+}
+
+static inline void stats_free(struct z_heap *h, chunkid_t c)
+{
+	size_t bytes = chunksz_to_bytes(h, chunk_size(h, c));
+
+	h->free_bytes += bytes;
+	h->allocated_bytes -= bytes;
+}
+#else
+static inline void stats_alloc(struct z_heap *h, chunkid_t c)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+}
+
+static inline void stats_free(struct z_heap *h, chunkid_t c)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Parked chunks keep their used bit, so neighbours never merge into
+ * them and the bucket lists never see them.
+ */
+static inline bool cache_contains(struct z_heap *h, int cls, chunkid_t c)
+{
+	for (chunkid_t i = h->cache[cls]; i != 0U; i = next_free_chunk(h, i)) {
+		if (i == c) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	int cls = cache_class(h, chunk_size(h, c));
+
+	if (cls < 0 || h->cache_count[cls] >= CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		return false;
+	}
+
+	CHECK(!cache_contains(h, cls, c));
+
+	set_next_free_chunk(h, c, h->cache[cls]);
+	h->cache[cls] = c;
+	h->cache_count[cls]++;
+	return true;
+}
+
+static chunkid_t cache_get(struct z_heap *h, size_t sz)
+{
+	int cls = cache_class(h, sz);
+	chunkid_t c;
+
+	if (cls < 0 || h->cache[cls] == 0U) {
+		return 0;
+	}
+
+	c = h->cache[cls];
+	h->cache[cls] = next_free_chunk(h, c);
+	h->cache_count[cls]--;
+	return c;
+}
+
+/* Hand every parked chunk back to the allocator.  Returns true if
+ * anything was released.
+ */
+static bool cache_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		while (h->cache[i] != 0U) {
+			chunkid_t c = h->cache[i];
+
+			h->cache[i] = next_free_chunk(h, c);
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+		h->cache_count[i] = 0U;
+	}
+	return flushed;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -162,6 +261,14 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
+	stats_free(h, c);
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cache_put(h, c)) {
+		return;
+	}
+#endif
+
 	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
@@ -228,7 +335,22 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 
 	struct z_heap *h = heap->heap;
 	size_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c;
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	c = cache_get(h, chunk_sz);
+	if (c != 0U) {
+		stats_alloc(h, c);
+		return chunk_mem(h, c);
+	}
+#endif
+
+	c = alloc_chunk(h, chunk_sz);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (c == 0U && cache_flush(h)) {
+		c = alloc_chunk(h, chunk_sz);
+	}
+#endif
 	if (c == 0U) {
 		return NULL;
 	}
@@ -240,6 +362,7 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	set_chunk_used(h, c, true);
+	stats_alloc(h, c);
 	return chunk_mem(h, c);
 }
 
@@ -264,6 +387,11 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	size_t padded_sz = bytes_to_chunksz(h, bytes + align - 1);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (c0 == 0 && cache_flush(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+#endif
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -290,6 +418,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	}
 
 	set_chunk_used(h, c, true);
+	stats_alloc(h, c);
 	return mem;
 }
 
@@ -326,6 +455,13 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		h->cache[i] = 0;
+		h->cache_count[i] = 0U;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_chunk_used(h, 0, true);
@@ -340,4 +476,53 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	set_chunk_used(h, buf_sz, true);
 
 	free_list_add(h, chunk0_size);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes = chunksz_to_bytes(h, buf_sz - chunk0_size);
+	h->allocated_bytes = 0;
+	h->max_allocated_bytes = 0;
+#endif
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_memory_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	size_t largest = 0;
+
+	/* Only the highest non-empty bucket can hold the largest chunk */
+	if (h->avail_buckets != 0U) {
+		int bidx = 31 - __builtin_clz(h->avail_buckets);
+		chunkid_t first = h->buckets[bidx].next;
+		chunkid_t c = first;
+
+		do {
+			largest = MAX(largest, chunk_size(h, c));
+			c = next_free_chunk(h, c);
+		} while (c != first);
+	}
+
+	stats->free_bytes = h->free_bytes;
+	stats->allocated_bytes = h->allocated_bytes;
+	stats->max_allocated_bytes = h->max_allocated_bytes;
+	stats->largest_free_bytes = largest ? chunksz_to_bytes(h, largest) : 0;
+
+	return 0;
+}
+
+int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	heap->heap->max_allocated_bytes = heap->heap->allocated_bytes;
+
+	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
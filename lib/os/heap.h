@@ -61,6 +61,19 @@ struct z_heap {
 	uint64_t chunk0_hdr_area;  /* matches the largest header */
 	uint32_t len;
 	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t free_bytes;
+	size_t allocated_bytes;
+	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Size-class cache: singly linked through FREE_NEXT of chunks
+	 * that are still marked used.  Class N holds chunks of
+	 * min_chunk_size() + N units.
+	 */
+	chunkid_t cache[CONFIG_SYS_HEAP_CACHE_CLASSES];
+	uint8_t cache_count[CONFIG_SYS_HEAP_CACHE_CLASSES];
+#endif
 	struct z_heap_bucket buckets[0];
 };
 
@@ -218,6 +231,11 @@ static inline size_t bytes_to_chunksz(struct z_heap *h, size_t bytes)
 	return chunksz(chunk_header_bytes(h) + bytes);
 }
 
+static inline size_t chunksz_to_bytes(struct z_heap *h, size_t chunksz)
+{
+	return chunksz * CHUNK_UNIT - chunk_header_bytes(h);
+}
+
 static inline int min_chunk_size(struct z_heap *h)
 {
 	return bytes_to_chunksz(h, 1);
@@ -229,6 +247,15 @@ static inline int bucket_idx(struct z_heap *h, size_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static inline int cache_class(struct z_heap *h, size_t sz)
+{
+	size_t cls = sz - min_chunk_size(h);
+
+	return (cls < CONFIG_SYS_HEAP_CACHE_CLASSES) ? (int)cls : -1;
+}
+#endif
+
 /* For debugging */
 void heap_dump(struct z_heap *h);
 
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <device.h>
+#include <drivers/counter.h>
+#include <sys/hrtimer.h>
+
+#define CHANNEL CONFIG_SYS_HRTIMER_COUNTER_CHANNEL
+
+static struct k_spinlock lock;
+static sys_dlist_t timers = SYS_DLIST_STATIC_INIT(&timers);
+
+/* NULL until the counter is started */
+static const struct device *counter;
+static uint32_t freq;
+static uint32_t top;
+static bool counting_up;
+static bool alarm_set;
+
+/*
+ * The alarm never is further than half a wraparound of the counter, which
+ * reads the counter often enough to count its wraparounds.
+ */
+static uint32_t alarm_max;
+
+/* Counter value and extended value when the counter was last read */
+static uint32_t last_count;
+static uint64_t last_ticks;
+
+static uint64_t ns_to_ticks(uint64_t ns)
+{
+	return (ns / NSEC_PER_SEC) * freq +
+	       ((ns % NSEC_PER_SEC) * freq + NSEC_PER_SEC - 1U) / NSEC_PER_SEC;
+}
+
+static uint64_t ticks_to_ns(uint64_t ticks)
+{
+	return (ticks / freq) * NSEC_PER_SEC +
+	       ((ticks % freq) * NSEC_PER_SEC) / freq;
+}
+
+/* Must be called with the lock held */
+static uint64_t ticks_now(void)
+{
+	uint32_t count, elapsed;
+
+	(void)counter_get_value(counter, &count);
+
+	if (counting_up) {
+		elapsed = (count >= last_count) ? count - last_count :
+			  count + (top - last_count) + 1U;
+	} else {
+		elapsed = (last_count >= count) ? last_count - count :
+			  last_count + (top - count) + 1U;
+	}
+
+	last_count = count;
+	last_ticks += elapsed;
+
+	return last_ticks;
+}
+
+static struct sys_hrtimer *first(void)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&timers);
+
+	return t == NULL ? NULL : CONTAINER_OF(t, struct sys_hrtimer, node);
+}
+
+static void insert(struct sys_hrtimer *timer)
+{
+	struct sys_hrtimer *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&timers, t, node) {
+		if (t->expiry > timer->expiry) {
+			sys_dlist_insert(&t->node, &timer->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&timers, &timer->node);
+}
+
+static void alarm_handler(const struct device *dev, uint8_t chan_id,
+			  uint32_t ticks, void *user_data);
+
+/* Must be called with the lock held */
+static void alarm_program(uint64_t now)
+{
+	struct sys_hrtimer *t = first();
+	struct counter_alarm_cfg cfg = {
+		.callback = alarm_handler,
+		.ticks = alarm_max,
+	};
+
+	if (t != NULL && t->expiry < now + alarm_max) {
+		cfg.ticks = (t->expiry > now) ?
+			    (uint32_t)(t->expiry - now) : 1U;
+	}
+
+	if (alarm_set) {
+		(void)counter_cancel_channel_alarm(counter, CHANNEL);
+	}
+
+	alarm_set = (counter_set_channel_alarm(counter, CHANNEL, &cfg) == 0);
+}
+
+static void alarm_handler(const struct device *dev, uint8_t chan_id,
+			  uint32_t ticks, void *user_data)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct sys_hrtimer *t;
+	uint64_t now = ticks_now();
+
+	alarm_set = false;
+
+	while ((t = first()) != NULL && t->expiry <= now) {
+		sys_dlist_remove(&t->node);
+
+		/* Requeued before the handler, which may stop it */
+		if (t->period != 0ULL) {
+			t->expiry += ((now - t->expiry) / t->period + 1U) *
+				     t->period;
+			insert(t);
+		}
+
+		k_spin_unlock(&lock, key);
+		t->handler(t);
+		key = k_spin_lock(&lock);
+
+		now = ticks_now();
+	}
+
+	alarm_program(now);
+
+	k_spin_unlock(&lock, key);
+}
+
+void sys_hrtimer_init(struct sys_hrtimer *timer,
+		      sys_hrtimer_handler_t handler)
+{
+	sys_dnode_init(&timer->node);
+	timer->expiry = 0U;
+	timer->period = 0U;
+	timer->handler = handler;
+}
+
+int sys_hrtimer_start(struct sys_hrtimer *timer, uint64_t delay_ns,
+		      uint64_t period_ns)
+{
+	k_spinlock_key_t key;
+	uint64_t now;
+
+	__ASSERT_NO_MSG(timer->handler != NULL);
+
+	if (counter == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	now = ticks_now();
+	timer->expiry = now + ns_to_ticks(delay_ns);
+	timer->period = ns_to_ticks(period_ns);
+	insert(timer);
+
+	/* A stopped timer instead leaves an early alarm, it does no harm */
+	if (first() == timer) {
+		alarm_program(now);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void sys_hrtimer_stop(struct sys_hrtimer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+bool sys_hrtimer_is_running(const struct sys_hrtimer *timer)
+{
+	return sys_dnode_is_linked(&timer->node);
+}
+
+uint64_t sys_hrtimer_ns_get(void)
+{
+	k_spinlock_key_t key;
+	uint64_t ticks;
+
+	if (counter == NULL) {
+		return 0U;
+	}
+
+	key = k_spin_lock(&lock);
+	ticks = ticks_now();
+	k_spin_unlock(&lock, key);
+
+	return ticks_to_ns(ticks);
+}
+
+static int hrtimer_init(const struct device *unused)
+{
+	const struct device *dev;
+	k_spinlock_key_t key;
+	int err;
+
+	ARG_UNUSED(unused);
+
+	dev = device_get_binding(CONFIG_SYS_HRTIMER_COUNTER_NAME);
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (counter_get_num_of_channels(dev) <= CHANNEL) {
+		return -EINVAL;
+	}
+
+	err = counter_start(dev);
+	if (err != 0 && err != -EALREADY) {
+		return err;
+	}
+
+	key = k_spin_lock(&lock);
+
+	freq = counter_get_frequency(dev);
+	top = counter_get_top_value(dev);
+	counting_up = counter_is_counting_up(dev);
+	alarm_max = top / 2U;
+
+	counter = dev;
+	(void)counter_get_value(counter, &last_count);
+	alarm_program(0U);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+SYS_INIT(hrtimer_init, POST_KERNEL, CONFIG_SYS_HRTIMER_INIT_PRIORITY);
@@ -24,11 +24,8 @@ struct token {
 };
 
 struct lexer {
-	void *(*state)(struct lexer *lexer);
-	char *start;
 	char *pos;
 	char *end;
-	struct token token;
 };
 
 struct json_obj {
@@ -41,248 +38,194 @@ struct json_obj_key_value {
 	struct token value;
 };
 
-static bool lexer_consume(struct lexer *lexer, struct token *token,
-			  enum json_tokens empty_token)
-{
-	if (lexer->token.type == empty_token) {
-		return false;
-	}
-
-	*token = lexer->token;
-	lexer->token.type = empty_token;
+/*
+ * The first character of a token is enough to tell its type, both lexers
+ * dispatch on it through this table instead of a chain of comparisons.
+ */
+enum char_class {
+	CC_INVALID,
+	CC_SPACE,
+	CC_STRUCT,
+	CC_QUOTE,
+	CC_MINUS,
+	CC_DIGIT,
+	CC_DOT,
+	CC_LITERAL,
+};
 
-	return true;
-}
+static const uint8_t char_class[256] = {
+	['\t'] = CC_SPACE, ['\n'] = CC_SPACE, ['\v'] = CC_SPACE,
+	['\f'] = CC_SPACE, ['\r'] = CC_SPACE, [' '] = CC_SPACE,
+	['{'] = CC_STRUCT, ['}'] = CC_STRUCT, ['['] = CC_STRUCT,
+	[']'] = CC_STRUCT, [','] = CC_STRUCT, [':'] = CC_STRUCT,
+	['"'] = CC_QUOTE,
+	['-'] = CC_MINUS,
+	['0'] = CC_DIGIT, ['1'] = CC_DIGIT, ['2'] = CC_DIGIT,
+	['3'] = CC_DIGIT, ['4'] = CC_DIGIT, ['5'] = CC_DIGIT,
+	['6'] = CC_DIGIT, ['7'] = CC_DIGIT, ['8'] = CC_DIGIT,
+	['9'] = CC_DIGIT,
+	['.'] = CC_DOT,
+	['t'] = CC_LITERAL, ['f'] = CC_LITERAL, ['n'] = CC_LITERAL,
+};
 
-static bool lexer_next(struct lexer *lexer, struct token *token)
+static inline enum char_class class_of(char chr)
 {
-	while (lexer->state) {
-		if (lexer_consume(lexer, token, JSON_TOK_NONE)) {
-			return true;
-		}
-
-		lexer->state = lexer->state(lexer);
-	}
-
-	return lexer_consume(lexer, token, JSON_TOK_EOF);
+	return (enum char_class)char_class[(uint8_t)chr];
 }
 
-static void *lexer_json(struct lexer *lexer);
-
-static void emit(struct lexer *lexer, enum json_tokens token)
+static inline bool is_number_char(char chr)
 {
-	lexer->token.type = token;
-	lexer->token.start = lexer->start;
-	lexer->token.end = lexer->pos;
-	lexer->start = lexer->pos;
+	return class_of(chr) == CC_DIGIT || class_of(chr) == CC_DOT;
 }
 
-static int next(struct lexer *lexer)
+static bool is_escape(char chr)
 {
-	if (lexer->pos >= lexer->end) {
-		lexer->pos = lexer->end + 1;
-
-		return '\0';
+	switch (chr) {
+	case '"':
+	case '\\':
+	case '/':
+	case 'b':
+	case 'f':
+	case 'n':
+	case 'r':
+	case 't':
+		return true;
+	default:
+		return false;
 	}
-
-	return *lexer->pos++;
-}
-
-static void ignore(struct lexer *lexer)
-{
-	lexer->start = lexer->pos;
 }
 
-static void backup(struct lexer *lexer)
+static enum json_tokens literal_type(const char *str, size_t len)
 {
-	lexer->pos--;
-}
-
-static int peek(struct lexer *lexer)
-{
-	int chr = next(lexer);
-
-	backup(lexer);
+	if (len == 4 && !memcmp(str, "true", 4)) {
+		return JSON_TOK_TRUE;
+	} else if (len == 5 && !memcmp(str, "false", 5)) {
+		return JSON_TOK_FALSE;
+	} else if (len == 4 && !memcmp(str, "null", 4)) {
+		return JSON_TOK_NULL;
+	}
 
-	return chr;
+	return JSON_TOK_ERROR;
 }
 
-static void *lexer_string(struct lexer *lexer)
+/* Returns the closing quote of the string starting at pos, or NULL */
+static char *lex_string(char *pos, char *end)
 {
-	ignore(lexer);
+	while (pos < end) {
+		char chr = *pos++;
 
-	while (true) {
-		int chr = next(lexer);
+		if (chr == '"') {
+			return pos - 1;
+		}
 
 		if (chr == '\0') {
-			emit(lexer, JSON_TOK_ERROR);
 			return NULL;
 		}
 
-		if (chr == '\\') {
-			switch (next(lexer)) {
-			case '"':
-			case '\\':
-			case '/':
-			case 'b':
-			case 'f':
-			case 'n':
-			case 'r':
-			case 't':
-				continue;
-			case 'u':
-				if (!isxdigit(next(lexer))) {
-					goto error;
-				}
-
-				if (!isxdigit(next(lexer))) {
-					goto error;
-				}
-
-				if (!isxdigit(next(lexer))) {
-					goto error;
-				}
-
-				if (!isxdigit(next(lexer))) {
-					goto error;
-				}
-
-				break;
-			default:
-				goto error;
-			}
+		if (chr != '\\') {
+			continue;
 		}
 
-		if (chr == '"') {
-			backup(lexer);
-			emit(lexer, JSON_TOK_STRING);
-
-			next(lexer);
-			ignore(lexer);
+		if (pos == end) {
+			return NULL;
+		}
 
-			return lexer_json;
+		chr = *pos++;
+		if (chr == 'u') {
+			if (end - pos < 4 || !isxdigit((unsigned char)pos[0]) ||
+			    !isxdigit((unsigned char)pos[1]) ||
+			    !isxdigit((unsigned char)pos[2]) ||
+			    !isxdigit((unsigned char)pos[3])) {
+				return NULL;
+			}
+			pos += 4;
+		} else if (!is_escape(chr)) {
+			return NULL;
 		}
 	}
 
-error:
-	emit(lexer, JSON_TOK_ERROR);
 	return NULL;
 }
 
-static int accept_run(struct lexer *lexer, const char *run)
+/*
+ * Scan the next token in a single pass over the input. Returns false at
+ * the end of the input, a lexing error is returned as a JSON_TOK_ERROR
+ * token after which the input is considered consumed.
+ */
+static bool lexer_next(struct lexer *lexer, struct token *token)
 {
-	for (; *run; run++) {
-		if (next(lexer) != *run) {
-			return -EINVAL;
-		}
+	char *pos = lexer->pos;
+	char *end = lexer->end;
+
+	while (pos < end && class_of(*pos) == CC_SPACE) {
+		pos++;
 	}
 
-	return 0;
-}
+	if (pos == end || *pos == '\0') {
+		lexer->pos = pos;
+		return false;
+	}
 
-static void *lexer_boolean(struct lexer *lexer)
-{
-	backup(lexer);
+	token->start = pos;
 
-	switch (next(lexer)) {
-	case 't':
-		if (!accept_run(lexer, "rue")) {
-			emit(lexer, JSON_TOK_TRUE);
-			return lexer_json;
-		}
+	switch (class_of(*pos)) {
+	case CC_STRUCT:
+		token->type = (enum json_tokens)*pos++;
 		break;
-	case 'f':
-		if (!accept_run(lexer, "alse")) {
-			emit(lexer, JSON_TOK_FALSE);
-			return lexer_json;
+	case CC_QUOTE:
+		token->start = ++pos;
+		pos = lex_string(pos, end);
+		if (pos == NULL) {
+			goto error;
+		}
+		token->type = JSON_TOK_STRING;
+		token->end = pos++;
+		lexer->pos = pos;
+		return true;
+	case CC_MINUS:
+		if (end - pos < 2 || class_of(pos[1]) != CC_DIGIT) {
+			goto error;
 		}
+		pos++;
+		__fallthrough;
+	case CC_DIGIT:
+		while (pos < end && is_number_char(*pos)) {
+			pos++;
+		}
+		token->type = JSON_TOK_NUMBER;
 		break;
-	}
-
-	emit(lexer, JSON_TOK_ERROR);
-	return NULL;
-}
-
-static void *lexer_null(struct lexer *lexer)
-{
-	if (accept_run(lexer, "ull") < 0) {
-		emit(lexer, JSON_TOK_ERROR);
-		return NULL;
-	}
-
-	emit(lexer, JSON_TOK_NULL);
-	return lexer_json;
-}
-
-static void *lexer_number(struct lexer *lexer)
-{
-	while (true) {
-		int chr = next(lexer);
-
-		if (isdigit(chr) || chr == '.') {
-			continue;
+	case CC_LITERAL:
+		/* Only the literal itself is consumed, as anything right
+		 * after it is a token of its own
+		 */
+		token->type = literal_type(pos, MIN(end - pos,
+						    *pos == 'f' ? 5 : 4));
+		if (token->type == JSON_TOK_ERROR) {
+			goto error;
 		}
-
-		backup(lexer);
-		emit(lexer, JSON_TOK_NUMBER);
-
-		return lexer_json;
+		pos += token->type == JSON_TOK_FALSE ? 5 : 4;
+		break;
+	default:
+		goto error;
 	}
-}
 
-static void *lexer_json(struct lexer *lexer)
-{
-	while (true) {
-		int chr = next(lexer);
-
-		switch (chr) {
-		case '\0':
-			emit(lexer, JSON_TOK_EOF);
-			return NULL;
-		case '}':
-		case '{':
-		case '[':
-		case ']':
-		case ',':
-		case ':':
-			emit(lexer, (enum json_tokens)chr);
-			return lexer_json;
-		case '"':
-			return lexer_string;
-		case 'n':
-			return lexer_null;
-		case 't':
-		case 'f':
-			return lexer_boolean;
-		case '-':
-			if (isdigit(peek(lexer))) {
-				return lexer_number;
-			}
+	token->end = pos;
+	lexer->pos = pos;
 
-			__fallthrough;
-		default:
-			if (isspace(chr)) {
-				ignore(lexer);
-				continue;
-			}
+	return true;
 
-			if (isdigit(chr)) {
-				return lexer_number;
-			}
+error:
+	token->type = JSON_TOK_ERROR;
+	token->end = end;
+	lexer->pos = end;
 
-			emit(lexer, JSON_TOK_ERROR);
-			return NULL;
-		}
-	}
+	return true;
 }
 
 static void lexer_init(struct lexer *lexer, char *data, size_t len)
 {
-	lexer->state = lexer_json;
-	lexer->start = data;
 	lexer->pos = data;
 	lexer->end = data + len;
-	lexer->token.type = JSON_TOK_NONE;
 }
 
 static int obj_init(struct json_obj *json, char *data, size_t len)
@@ -541,7 +484,8 @@ static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 {
 	struct json_obj_key_value kv;
 	int32_t decoded_fields = 0;
-	size_t i;
+	size_t next_field = 0;
+	size_t i, n;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -549,8 +493,19 @@ static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
+		/* Fields mostly come in the order of the descriptor, the search
+		 * starts after the previous match so that it usually succeeds
+		 * on the first comparison.
+		 */
+		for (n = 0; n < descr_len; n++) {
+			void *decode_field;
+
+			i = next_field + n;
+			if (i >= descr_len) {
+				i -= descr_len;
+			}
+
+			decode_field = (char *)val + descr[i].offset;
 
 			/* Field has been decoded already, skip */
 			if (decoded_fields & (1 << i)) {
@@ -575,6 +530,7 @@ static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			}
 
 			decoded_fields |= 1<<i;
+			next_field = i + 1;
 			break;
 		}
 	}
@@ -599,6 +555,353 @@ int json_obj_parse(char *payload, size_t len,
 	return obj_parse(&obj, descr, descr_len, val);
 }
 
+enum sax_expect {
+	SAX_VALUE,
+	SAX_VALUE_OR_END,
+	SAX_KEY,
+	SAX_KEY_OR_END,
+	SAX_COLON,
+	SAX_COMMA_OR_END,
+	SAX_DONE,
+	SAX_FAILED,
+};
+
+enum sax_lex {
+	SAX_LEX_NONE,
+	SAX_LEX_STRING,
+	SAX_LEX_NUMBER,
+	SAX_LEX_LITERAL,
+};
+
+/* Escape state of a string, after a backslash or else hex digits left */
+#define SAX_ESC_BACKSLASH 0xff
+
+#define SAX_MAX_DEPTH (sizeof(((struct json_sax *)0)->objects) * CHAR_BIT)
+
+void json_sax_init(struct json_sax *sax, char *buf, size_t buf_size,
+		   json_sax_cb_t cb, void *user_data)
+{
+	sax->cb = cb;
+	sax->user_data = user_data;
+	sax->buf = buf;
+	sax->buf_size = buf_size;
+	sax->len = 0;
+	sax->objects = 0U;
+	sax->depth = 0U;
+	sax->expect = SAX_VALUE;
+	sax->lex = SAX_LEX_NONE;
+	sax->escape = 0U;
+	sax->buffered = false;
+}
+
+static inline bool sax_in_object(const struct json_sax *sax)
+{
+	return sax->objects & BIT(sax->depth - 1);
+}
+
+static void sax_after_value(struct json_sax *sax)
+{
+	sax->expect = sax->depth == 0U ? SAX_DONE : SAX_COMMA_OR_END;
+}
+
+/* Check a token against the grammar, and report it */
+static int sax_emit(struct json_sax *sax, enum json_tokens type,
+		    const char *str, size_t len)
+{
+	struct json_sax_token token = {
+		.type = type,
+		.depth = sax->depth,
+		.str = str,
+		.len = len,
+	};
+	bool end = type == JSON_TOK_OBJECT_END || type == JSON_TOK_LIST_END;
+
+	switch (sax->expect) {
+	case SAX_KEY_OR_END:
+	case SAX_KEY:
+		if (type == JSON_TOK_STRING) {
+			token.key = true;
+			sax->expect = SAX_COLON;
+			return sax->cb(&token, sax->user_data);
+		}
+
+		if (type != JSON_TOK_OBJECT_END ||
+		    sax->expect != SAX_KEY_OR_END) {
+			return -EINVAL;
+		}
+		goto close;
+	case SAX_VALUE_OR_END:
+		if (type == JSON_TOK_LIST_END) {
+			goto close;
+		}
+		break;
+	case SAX_VALUE:
+		break;
+	case SAX_COMMA_OR_END:
+		if (end && (type == JSON_TOK_OBJECT_END) == sax_in_object(sax)) {
+			goto close;
+		}
+		return -EINVAL;
+	default:
+		return -EINVAL;
+	}
+
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+	case JSON_TOK_LIST_START:
+		if (sax->depth == SAX_MAX_DEPTH) {
+			return -ENOSPC;
+		}
+
+		WRITE_BIT(sax->objects, sax->depth,
+			  type == JSON_TOK_OBJECT_START);
+		sax->depth++;
+		sax->expect = type == JSON_TOK_OBJECT_START ?
+			      SAX_KEY_OR_END : SAX_VALUE_OR_END;
+		break;
+	case JSON_TOK_STRING:
+	case JSON_TOK_NUMBER:
+	case JSON_TOK_TRUE:
+	case JSON_TOK_FALSE:
+	case JSON_TOK_NULL:
+		sax_after_value(sax);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return sax->cb(&token, sax->user_data);
+
+close:
+	sax->depth--;
+	token.depth = sax->depth;
+	sax_after_value(sax);
+
+	return sax->cb(&token, sax->user_data);
+}
+
+static int sax_struct(struct json_sax *sax, char chr)
+{
+	switch (chr) {
+	case ':':
+		if (sax->expect != SAX_COLON) {
+			return -EINVAL;
+		}
+		sax->expect = SAX_VALUE;
+		return 0;
+	case ',':
+		if (sax->expect != SAX_COMMA_OR_END) {
+			return -EINVAL;
+		}
+		sax->expect = sax_in_object(sax) ? SAX_KEY : SAX_VALUE;
+		return 0;
+	default:
+		return sax_emit(sax, (enum json_tokens)chr, NULL, 0);
+	}
+}
+
+/* Keep the part of a token that lies within the current chunk */
+static int sax_buffer(struct json_sax *sax, const char *start, size_t len)
+{
+	if (len > sax->buf_size - sax->len) {
+		return -ENOSPC;
+	}
+
+	memcpy(&sax->buf[sax->len], start, len);
+	sax->len += len;
+	sax->buffered = true;
+
+	return 0;
+}
+
+/* Report a token ending at pos, that started at start or before the chunk */
+static int sax_token(struct json_sax *sax, const char *start, const char *pos)
+{
+	enum json_tokens type;
+	const char *str = start;
+	size_t len = pos - start;
+	int ret;
+
+	if (sax->buffered) {
+		ret = sax_buffer(sax, start, len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		str = sax->buf;
+		len = sax->len;
+	}
+
+	switch (sax->lex) {
+	case SAX_LEX_STRING:
+		type = JSON_TOK_STRING;
+		break;
+	case SAX_LEX_NUMBER:
+		if (str[0] == '-' && (len < 2 || class_of(str[1]) != CC_DIGIT)) {
+			return -EINVAL;
+		}
+		type = JSON_TOK_NUMBER;
+		break;
+	default:
+		type = literal_type(str, len);
+		if (type == JSON_TOK_ERROR) {
+			return -EINVAL;
+		}
+		str = NULL;
+		len = 0;
+		break;
+	}
+
+	sax->lex = SAX_LEX_NONE;
+	sax->len = 0;
+	sax->buffered = false;
+
+	return sax_emit(sax, type, str, len);
+}
+
+/*
+ * Advance pos to the end of the token being lexed. Returns 1 if the token
+ * ends within the chunk, 0 if it goes on in the next one.
+ */
+static int sax_scan(struct json_sax *sax, const char **pos, const char *end)
+{
+	const char *p = *pos;
+
+	switch (sax->lex) {
+	case SAX_LEX_STRING:
+		for (; p < end; p++) {
+			char chr = *p;
+
+			if (sax->escape == SAX_ESC_BACKSLASH) {
+				if (chr == 'u') {
+					sax->escape = 4U;
+				} else if (is_escape(chr)) {
+					sax->escape = 0U;
+				} else {
+					return -EINVAL;
+				}
+			} else if (sax->escape > 0U) {
+				if (!isxdigit((unsigned char)chr)) {
+					return -EINVAL;
+				}
+				sax->escape--;
+			} else if (chr == '\\') {
+				sax->escape = SAX_ESC_BACKSLASH;
+			} else if (chr == '"') {
+				*pos = p;
+				return 1;
+			} else if (chr == '\0') {
+				return -EINVAL;
+			}
+		}
+		break;
+	case SAX_LEX_NUMBER:
+		while (p < end && is_number_char(*p)) {
+			p++;
+		}
+		break;
+	default:
+		while (p < end && *p >= 'a' && *p <= 'z') {
+			p++;
+		}
+		break;
+	}
+
+	*pos = p;
+
+	return p < end;
+}
+
+int json_sax_feed(struct json_sax *sax, const char *data, size_t len)
+{
+	const char *end = data + len;
+	const char *pos = data;
+	const char *start = data;
+	int ret = 0;
+
+	if (sax->expect == SAX_FAILED) {
+		return -EINVAL;
+	}
+
+	while (pos < end) {
+		if (sax->lex != SAX_LEX_NONE) {
+			ret = sax_scan(sax, &pos, end);
+			if (ret <= 0) {
+				break;
+			}
+
+			if (sax->lex == SAX_LEX_STRING) {
+				ret = sax_token(sax, start, pos++);
+			} else {
+				ret = sax_token(sax, start, pos);
+			}
+		} else {
+			switch (class_of(*pos)) {
+			case CC_SPACE:
+				pos++;
+				continue;
+			case CC_STRUCT:
+				ret = sax_struct(sax, *pos++);
+				break;
+			case CC_QUOTE:
+				sax->lex = SAX_LEX_STRING;
+				sax->escape = 0U;
+				start = ++pos;
+				continue;
+			case CC_MINUS:
+			case CC_DIGIT:
+				/* A minus sign is only valid first */
+				sax->lex = SAX_LEX_NUMBER;
+				start = pos++;
+				continue;
+			case CC_LITERAL:
+				sax->lex = SAX_LEX_LITERAL;
+				start = pos;
+				continue;
+			default:
+				ret = -EINVAL;
+				break;
+			}
+		}
+
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (ret == 0 && sax->lex != SAX_LEX_NONE) {
+		ret = sax_buffer(sax, start, end - start);
+	}
+
+	if (ret < 0) {
+		sax->expect = SAX_FAILED;
+		return ret;
+	}
+
+	return 0;
+}
+
+int json_sax_finish(struct json_sax *sax)
+{
+	int ret = 0;
+
+	if (sax->expect == SAX_FAILED || sax->lex == SAX_LEX_STRING) {
+		ret = -EINVAL;
+	} else if (sax->lex != SAX_LEX_NONE) {
+		ret = sax_token(sax, sax->buf, sax->buf);
+	}
+
+	if (ret == 0 && sax->expect != SAX_DONE) {
+		ret = -EINVAL;
+	}
+
+	if (ret < 0) {
+		sax->expect = SAX_FAILED;
+	}
+
+	return ret;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpsc_pbuf.h>
+#include <sys/__assert.h>
+#include <sys/util.h>
+#include <string.h>
+
+/* Every packet starts with a header word holding its length (header
+ * included) and the MPSC_PBUF_HDR_VALID bit, set once it is committed.
+ * Freed words are zeroed, so the header of a claimed packet stays invalid
+ * until it is committed. A packet which would not fit before the end of
+ * the buffer is preceded by a skip packet covering the end.
+ *
+ * Packets may be freed in any order: freeing only sets the
+ * MPSC_PBUF_HDR_FREED bit, the space is given back to the producers once
+ * all the packets before it are freed as well. A single context at a time
+ * advances the read index, the others leave the packets they freed to it.
+ */
+
+static inline atomic_t *hdr_get(struct mpsc_pbuf_buffer *buffer, uint32_t idx)
+{
+	return (atomic_t *)&buffer->buf[idx];
+}
+
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer, uint32_t *buf,
+		    uint32_t size)
+{
+	__ASSERT_NO_MSG(size != 0U && (size & (size - 1)) == 0U);
+	__ASSERT_NO_MSG(size <= MPSC_PBUF_HDR_LEN_MASK + 1);
+
+	buffer->buf = buf;
+	buffer->size = size;
+	(void)memset(buf, 0, size * sizeof(uint32_t));
+	atomic_set(&buffer->wr, 0);
+	atomic_set(&buffer->rd, 0);
+	atomic_set(&buffer->claim, 0);
+	atomic_clear(&buffer->releasing);
+	atomic_set(&buffer->dropped, 0);
+}
+
+uint32_t *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
+{
+	uint32_t total = wlen + 1;
+	uint32_t wr, rd, idx, pad;
+
+	if (wlen > MPSC_PBUF_MAX_WLEN || total > buffer->size) {
+		atomic_inc(&buffer->dropped);
+		return NULL;
+	}
+
+	do {
+		wr = (uint32_t)atomic_get(&buffer->wr);
+		rd = (uint32_t)atomic_get(&buffer->rd);
+		idx = wr & (buffer->size - 1);
+		pad = (idx + total > buffer->size) ? (buffer->size - idx) : 0U;
+
+		if ((wr - rd) + pad + total > buffer->size) {
+			atomic_inc(&buffer->dropped);
+			return NULL;
+		}
+	} while (!atomic_cas(&buffer->wr, (atomic_val_t)wr,
+			     (atomic_val_t)(wr + pad + total)));
+
+	if (pad != 0U) {
+		atomic_set(hdr_get(buffer, idx),
+			   MPSC_PBUF_HDR_VALID | MPSC_PBUF_HDR_SKIP | pad);
+		idx = 0U;
+	}
+
+	return &buffer->buf[idx + 1];
+}
+
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer, uint32_t *packet,
+		      uint32_t wlen)
+{
+	uint32_t idx = (packet - buffer->buf) - 1;
+
+	/* Full barrier, the packet content is visible before the header */
+	atomic_set(hdr_get(buffer, idx), MPSC_PBUF_HDR_VALID | (wlen + 1));
+}
+
+static bool head_freed(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t idx = (uint32_t)atomic_get(&buffer->rd) & (buffer->size - 1);
+
+	return (atomic_get(hdr_get(buffer, idx)) & MPSC_PBUF_HDR_FREED) != 0;
+}
+
+static void release(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t rd, idx, len;
+
+	while (atomic_cas(&buffer->releasing, 0, 1)) {
+		while (head_freed(buffer)) {
+			rd = (uint32_t)atomic_get(&buffer->rd);
+			idx = rd & (buffer->size - 1);
+			len = (uint32_t)atomic_get(hdr_get(buffer, idx)) &
+			      MPSC_PBUF_HDR_LEN_MASK;
+
+			(void)memset(&buffer->buf[idx], 0,
+				     len * sizeof(uint32_t));
+			atomic_add(&buffer->rd, (atomic_val_t)len);
+		}
+
+		atomic_clear(&buffer->releasing);
+
+		/* A packet freed while the flag was held is released by the
+		 * context which held it, check once more after clearing it.
+		 */
+		if (!head_freed(buffer)) {
+			return;
+		}
+	}
+}
+
+static uint32_t *next_get(struct mpsc_pbuf_buffer *buffer, uint32_t *wlen,
+			  bool consume)
+{
+	uint32_t pos, idx, hdr, len;
+
+	while (true) {
+		pos = (uint32_t)atomic_get(&buffer->claim);
+		if (pos == (uint32_t)atomic_get(&buffer->wr)) {
+			return NULL;
+		}
+
+		idx = pos & (buffer->size - 1);
+		hdr = (uint32_t)atomic_get(hdr_get(buffer, idx));
+		if (!(hdr & MPSC_PBUF_HDR_VALID)) {
+			/* Claimed but not committed yet */
+			return NULL;
+		}
+
+		len = hdr & MPSC_PBUF_HDR_LEN_MASK;
+		if (!(hdr & MPSC_PBUF_HDR_SKIP)) {
+			if (consume) {
+				atomic_set(&buffer->claim,
+					   (atomic_val_t)(pos + len));
+			}
+
+			*wlen = len - 1;
+			return &buffer->buf[idx + 1];
+		}
+
+		/* Skip packets are consumed even when only peeking */
+		atomic_set(&buffer->claim, (atomic_val_t)(pos + len));
+		atomic_or(hdr_get(buffer, idx), MPSC_PBUF_HDR_FREED);
+		release(buffer);
+	}
+}
+
+uint32_t *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer, uint32_t *wlen)
+{
+	return next_get(buffer, wlen, true);
+}
+
+uint32_t *mpsc_pbuf_peek(struct mpsc_pbuf_buffer *buffer, uint32_t *wlen)
+{
+	return next_get(buffer, wlen, false);
+}
+
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer, uint32_t *packet)
+{
+	uint32_t idx = (packet - buffer->buf) - 1;
+
+	__ASSERT_NO_MSG(atomic_get(hdr_get(buffer, idx)) & MPSC_PBUF_HDR_VALID);
+
+	atomic_or(hdr_get(buffer, idx), MPSC_PBUF_HDR_FREED);
+	release(buffer);
+}
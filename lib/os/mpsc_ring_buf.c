@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpsc_ring_buf.h>
+#include <sys/__assert.h>
+#include <errno.h>
+#include <string.h>
+
+/* The first word of every record holds its length in words while it is
+ * being written, and its length in bytes once it is finished.
+ */
+#define REC_HDR_WLEN 1
+#define REC_MAX_LEN ((MPSC_PBUF_MAX_WLEN - REC_HDR_WLEN) * sizeof(uint32_t))
+
+void mpsc_ring_buf_init(struct mpsc_ring_buf *buf, uint32_t size,
+			uint32_t *data)
+{
+	__ASSERT_NO_MSG(size >= 8U && (size & (size - 1)) == 0U);
+
+	mpsc_pbuf_init(&buf->pbuf, data, size / sizeof(uint32_t));
+	buf->rd_packet = NULL;
+	buf->rd_len = 0U;
+	buf->rd_off = 0U;
+}
+
+uint32_t mpsc_ring_buf_put_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	uint32_t wlen, *packet;
+
+	if (size == 0U) {
+		return 0;
+	}
+
+	size = MIN(size, REC_MAX_LEN);
+	wlen = REC_HDR_WLEN + DIV_ROUND_UP(size, sizeof(uint32_t));
+
+	packet = mpsc_pbuf_alloc(&buf->pbuf, wlen);
+	if (packet == NULL) {
+		return 0;
+	}
+
+	packet[0] = wlen;
+	*data = (uint8_t *)&packet[REC_HDR_WLEN];
+
+	return size;
+}
+
+int mpsc_ring_buf_put_finish(struct mpsc_ring_buf *buf, uint8_t *data,
+			     uint32_t size)
+{
+	uint32_t *packet = (uint32_t *)data - REC_HDR_WLEN;
+	uint32_t wlen = packet[0];
+
+	if (size > (wlen - REC_HDR_WLEN) * sizeof(uint32_t)) {
+		return -EINVAL;
+	}
+
+	packet[0] = size;
+	mpsc_pbuf_commit(&buf->pbuf, packet, wlen);
+
+	return 0;
+}
+
+uint32_t mpsc_ring_buf_put(struct mpsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size)
+{
+	uint32_t written = 0U;
+
+	while (written < size) {
+		uint8_t *dst;
+		uint32_t len = mpsc_ring_buf_put_claim(buf, &dst,
+						       size - written);
+
+		if (len == 0U) {
+			break;
+		}
+
+		(void)memcpy(dst, &data[written], len);
+		(void)mpsc_ring_buf_put_finish(buf, dst, len);
+		written += len;
+	}
+
+	return written;
+}
+
+uint32_t mpsc_ring_buf_get_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	uint32_t wlen;
+
+	/* Empty records are finished claims that were not used */
+	while (buf->rd_packet == NULL) {
+		uint32_t *packet = mpsc_pbuf_claim(&buf->pbuf, &wlen);
+
+		if (packet == NULL) {
+			return 0;
+		}
+
+		if (packet[0] == 0U) {
+			mpsc_pbuf_free(&buf->pbuf, packet);
+			continue;
+		}
+
+		buf->rd_packet = packet;
+		buf->rd_len = packet[0];
+		buf->rd_off = 0U;
+	}
+
+	*data = (uint8_t *)&buf->rd_packet[REC_HDR_WLEN] + buf->rd_off;
+
+	return MIN(size, buf->rd_len - buf->rd_off);
+}
+
+int mpsc_ring_buf_get_finish(struct mpsc_ring_buf *buf, uint32_t size)
+{
+	if (buf->rd_packet == NULL) {
+		return size == 0U ? 0 : -EINVAL;
+	}
+
+	if (size > buf->rd_len - buf->rd_off) {
+		return -EINVAL;
+	}
+
+	buf->rd_off += size;
+	if (buf->rd_off == buf->rd_len) {
+		mpsc_pbuf_free(&buf->pbuf, buf->rd_packet);
+		buf->rd_packet = NULL;
+	}
+
+	return 0;
+}
+
+uint32_t mpsc_ring_buf_get(struct mpsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size)
+{
+	uint32_t read = 0U;
+
+	while (read < size) {
+		uint8_t *src;
+		uint32_t len = mpsc_ring_buf_get_claim(buf, &src, size - read);
+
+		if (len == 0U) {
+			break;
+		}
+
+		(void)memcpy(&data[read], src, len);
+		(void)mpsc_ring_buf_get_finish(buf, len);
+		read += len;
+	}
+
+	return read;
+}
@@ -23,9 +23,10 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is used to lookup the underlying k_mutex and,
+	 * with CONFIG_SYS_MUTEX_FAST, holds the owner and lock count, so
+	 * we don't want threads using mutexes that are outside their
+	 * memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
@@ -38,7 +39,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	return z_sys_mutex_lock_contended(mutex, kernel_mutex, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,6 +61,13 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return z_sys_mutex_unlock_contended(mutex, kernel_mutex);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
@@ -66,6 +78,7 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 
 	k_mutex_unlock(kernel_mutex);
 	return 0;
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
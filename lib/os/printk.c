@@ -20,6 +20,7 @@
 #include <syscall_handler.h>
 #include <logging/log.h>
 #include <sys/types.h>
+#include <sys/cbprintf.h>
 
 typedef int (*out_func_t)(int c, void *ctx);
 
@@ -46,6 +47,30 @@ typedef uint32_t printk_val_t;
 static struct k_spinlock lock;
 #endif
 
+/* Where the formatter takes the arguments from: a va_list or a package */
+struct arg_src {
+	va_list ap;
+	const uint8_t *pkg;
+	size_t off;
+};
+
+static inline const void *pkg_arg(struct arg_src *src, size_t size,
+				  size_t align)
+{
+	const void *arg;
+
+	src->off = ROUND_UP(src->off, align);
+	arg = &src->pkg[src->off];
+	src->off += size;
+
+	return arg;
+}
+
+#define ARG_GET(src, type) \
+	((src)->pkg != NULL ? \
+	 *(type const *)pkg_arg(src, sizeof(type), __alignof__(type)) : \
+	 va_arg((src)->ap, type))
+
 #ifdef CONFIG_PRINTK
 /**
  * @brief Default character output routine that does nothing
@@ -168,7 +193,8 @@ static bool negative(printk_val_t val)
  *
  * @return N/A
  */
-void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+static void vprintk_src(out_func_t out, void *ctx, const char *fmt,
+			struct arg_src *src)
 {
 	int might_format = 0; /* 1 if encountered a '%' */
 	enum pad_type padding = PAD_NONE;
@@ -238,19 +264,19 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				printk_val_t d;
 
 				if (length_mod == 'z') {
-					d = va_arg(ap, ssize_t);
+					d = ARG_GET(src, ssize_t);
 				} else if (length_mod == 'l') {
-					d = va_arg(ap, long);
+					d = ARG_GET(src, long);
 				} else if (length_mod == 'L') {
-					long long lld = va_arg(ap, long long);
+					long long lld = ARG_GET(src, long long);
 					if (!ok64(out, ctx, lld)) {
 						break;
 					}
 					d = (printk_val_t) lld;
 				} else if (*fmt == 'u') {
-					d = va_arg(ap, unsigned int);
+					d = ARG_GET(src, unsigned int);
 				} else {
-					d = va_arg(ap, int);
+					d = ARG_GET(src, int);
 				}
 
 				if (*fmt != 'u' && negative(d)) {
@@ -273,20 +299,20 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				printk_val_t x;
 
 				if (*fmt == 'p') {
-					x = (uintptr_t)va_arg(ap, void *);
+					x = (uintptr_t)ARG_GET(src, void *);
 				} else if (length_mod == 'l') {
-					x = va_arg(ap, unsigned long);
+					x = ARG_GET(src, unsigned long);
 				} else if (length_mod == 'L') {
-					x = va_arg(ap, unsigned long long);
+					x = ARG_GET(src, unsigned long long);
 				} else {
-					x = va_arg(ap, unsigned int);
+					x = ARG_GET(src, unsigned int);
 				}
 
 				print_hex(out, ctx, x, padding, min_width);
 				break;
 			}
 			case 's': {
-				char *s = va_arg(ap, char *);
+				char *s = ARG_GET(src, char *);
 				char *start = s;
 
 				while (*s) {
@@ -302,7 +328,7 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				break;
 			}
 			case 'c': {
-				int c = va_arg(ap, int);
+				int c = ARG_GET(src, int);
 
 				out(c, ctx);
 				break;
@@ -323,6 +349,188 @@ still_might_format:
 	}
 }
 
+void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+{
+	struct arg_src src = { .pkg = NULL };
+
+	va_copy(src.ap, ap);
+	vprintk_src(out, ctx, fmt, &src);
+	va_end(src.ap);
+}
+
+#ifdef CONFIG_CBPRINTF_PACKAGE
+/* Package argument types, as promoted when passed through "..." */
+enum pkg_arg {
+	PKG_NONE,
+	PKG_INT,
+	PKG_LONG,
+	PKG_LLONG,
+	PKG_SSIZE,
+	PKG_PTR,
+};
+
+/* Argument vprintk_src() takes for a conversion */
+static enum pkg_arg pkg_arg_type(char conv, char length_mod)
+{
+	switch (conv) {
+	case 'd':
+	case 'i':
+	case 'u':
+		if (length_mod == 'z') {
+			return PKG_SSIZE;
+		}
+		__fallthrough;
+	case 'x':
+	case 'X':
+		if (length_mod == 'l') {
+			return PKG_LONG;
+		} else if (length_mod == 'L') {
+			return PKG_LLONG;
+		}
+		return PKG_INT;
+	case 'c':
+		return PKG_INT;
+	case 'p':
+	case 's':
+		return PKG_PTR;
+	default:
+		return PKG_NONE;
+	}
+}
+
+#define PKG_PUT(buf, len, off, ap, type) do { \
+		off = ROUND_UP(off, __alignof__(type)); \
+		if (buf == NULL) { \
+			(void)va_arg(ap, type); \
+		} else if (off + sizeof(type) > len) { \
+			return -ENOSPC; \
+		} else { \
+			*(type *)&buf[off] = va_arg(ap, type); \
+		} \
+		off += sizeof(type); \
+	} while (false)
+
+static int vpackage(uint8_t *buf, size_t len, const char *fmt, va_list ap)
+{
+	bool might_format = false;
+	char length_mod = 0;
+	size_t off = sizeof(const char *);
+
+	if (buf != NULL) {
+		if (len < off) {
+			return -ENOSPC;
+		}
+		*(const char **)buf = fmt;
+	}
+
+	/* Parse the conversions the way vprintk_src() does */
+	for (; *fmt; fmt++) {
+		if (!might_format) {
+			might_format = *fmt == '%';
+			length_mod = 0;
+			continue;
+		}
+
+		if (*fmt == '-' || (*fmt >= '0' && *fmt <= '9')) {
+			continue;
+		}
+
+		if (*fmt == 'h' || *fmt == 'l' || *fmt == 'z') {
+			if (*fmt == 'h' && length_mod == 'h') {
+				length_mod = 'H';
+			} else if (*fmt == 'l' && length_mod == 'l') {
+				length_mod = 'L';
+			} else if (length_mod == 0) {
+				length_mod = *fmt;
+			} else {
+				might_format = false;
+			}
+			continue;
+		}
+
+		switch (pkg_arg_type(*fmt, length_mod)) {
+		case PKG_INT:
+			PKG_PUT(buf, len, off, ap, int);
+			break;
+		case PKG_LONG:
+			PKG_PUT(buf, len, off, ap, long);
+			break;
+		case PKG_LLONG:
+			PKG_PUT(buf, len, off, ap, long long);
+			break;
+		case PKG_SSIZE:
+			PKG_PUT(buf, len, off, ap, ssize_t);
+			break;
+		case PKG_PTR:
+			PKG_PUT(buf, len, off, ap, const void *);
+			break;
+		case PKG_NONE:
+			break;
+		}
+
+		might_format = false;
+	}
+
+	return off;
+}
+
+int cbvprintf_package(void *packaged, size_t len, const char *fmt,
+		      va_list ap)
+{
+	va_list ap2;
+	int ret;
+
+	__ASSERT_NO_MSG(((uintptr_t)packaged &
+			 (CBPRINTF_PACKAGE_ALIGNMENT - 1)) == 0U);
+
+	va_copy(ap2, ap);
+	ret = vpackage(packaged, len, fmt, ap2);
+	va_end(ap2);
+
+	return ret;
+}
+
+int cbprintf_package(void *packaged, size_t len, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = cbvprintf_package(packaged, len, fmt, ap);
+	va_end(ap);
+
+	return ret;
+}
+
+struct pkg_out_context {
+	cbprintf_cb out;
+	void *ctx;
+	int count;
+};
+
+static int pkg_char_out(int c, void *ctx_p)
+{
+	struct pkg_out_context *ctx = ctx_p;
+
+	ctx->count++;
+	return ctx->out(c, ctx->ctx);
+}
+
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged)
+{
+	struct pkg_out_context out_ctx = { .out = out, .ctx = ctx };
+	struct arg_src src = {
+		.pkg = packaged,
+		.off = sizeof(const char *),
+	};
+
+	vprintk_src(pkg_char_out, &out_ctx, *(const char *const *)packaged,
+		    &src);
+
+	return out_ctx.count;
+}
+#endif /* CONFIG_CBPRINTF_PACKAGE */
+
 #ifdef CONFIG_PRINTK
 #ifdef CONFIG_USERSPACE
 struct buf_out_context {
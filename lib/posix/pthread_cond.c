@@ -11,17 +11,21 @@
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
+extern struct k_spinlock z_pthread_spinlock;
+bool z_pthread_mutex_release(pthread_mutex_t *m);
+
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 		     k_timeout_t timeout)
 {
 	__ASSERT(mut->lock_count == 1U, "");
 
-	int ret, key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	int ret;
 
+	/* Releasing the mutex under the lock, no signal can be missed */
 	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
-	ret = z_pend_curr_irqlock(key, &cv->wait_q, timeout);
+	(void)z_pthread_mutex_release(mut);
+	ret = z_pend_curr(&z_pthread_spinlock, key, &cv->wait_q, timeout);
 
 	/* FIXME: this extra lock (and the potential context switch it
 	 * can cause) could be optimized out.  At the point of the
@@ -47,25 +51,48 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
  * https://blog.mozilla.org/nfroyd/2017/03/29/on-mutex-performance-part-1/
  */
 
+static bool cond_wake_one(pthread_cond_t *cv)
+{
+	struct k_thread *thread = z_unpend_first_thread(&cv->wait_q);
+
+	if (thread == NULL) {
+		return false;
+	}
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
+}
+
 int pthread_cond_signal(pthread_cond_t *cv)
 {
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
 
-	_ready_one_thread(&cv->wait_q);
-	z_reschedule_irqlock(key);
+	/* Nothing to reschedule for when nobody waits */
+	if (cond_wake_one(cv)) {
+		z_reschedule(&z_pthread_spinlock, key);
+	} else {
+		k_spin_unlock(&z_pthread_spinlock, key);
+	}
 
 	return 0;
 }
 
 int pthread_cond_broadcast(pthread_cond_t *cv)
 {
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	bool woken = false;
 
-	while (z_waitq_head(&cv->wait_q)) {
-		_ready_one_thread(&cv->wait_q);
+	while (cond_wake_one(cv)) {
+		woken = true;
 	}
 
-	z_reschedule_irqlock(key);
+	if (woken) {
+		z_reschedule(&z_pthread_spinlock, key);
+	} else {
+		k_spin_unlock(&z_pthread_spinlock, key);
+	}
 
 	return 0;
 }
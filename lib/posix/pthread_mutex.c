@@ -13,6 +13,15 @@ int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 #define MUTEX_MAX_REC_LOCK 32767
 
+/* Set in the owner of a mutex which threads may be waiting for, so that
+ * its unlock takes the slow path. Thread IDs are word aligned, bit 0 of
+ * them is free.
+ */
+#define MUTEX_CONTENDED ((uintptr_t)1)
+
+/* Protects the wait queues of the mutexes and condition variables */
+struct k_spinlock z_pthread_spinlock;
+
 /*
  *  Default mutex attrs.
  */
@@ -20,42 +29,90 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
-static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
+static inline pthread_t mutex_owner(pthread_mutex_t *m)
 {
-	int rc = 0, key = irq_lock();
+	return (pthread_t)((uintptr_t)atomic_ptr_get(&m->owner) &
+			   ~MUTEX_CONTENDED);
+}
 
-	if (m->lock_count == 0U && m->owner == NULL) {
-		m->lock_count++;
-		m->owner = pthread_self();
+static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
+{
+	pthread_t self = pthread_self();
+	k_spinlock_key_t key;
+	void *owner;
 
-		irq_unlock(key);
+	/* Uncontended, a single atomic operation and no lock */
+	if (likely(atomic_ptr_cas(&m->owner, NULL, self))) {
+		m->lock_count = 1U;
 		return 0;
-	} else if (m->owner == pthread_self()) {
+	}
+
+	if (mutex_owner(m) == self) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
 		    m->lock_count < MUTEX_MAX_REC_LOCK) {
 			m->lock_count++;
-			rc = 0;
+			return 0;
 		} else if (m->type == PTHREAD_MUTEX_ERRORCHECK) {
-			rc = EDEADLK;
-		} else {
-			rc = EINVAL;
+			return EDEADLK;
 		}
 
-		irq_unlock(key);
-		return rc;
+		return EINVAL;
 	}
 
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
-	rc = z_pend_curr_irqlock(key, &m->wait_q, timeout);
-	if (rc != 0) {
-		rc = ETIMEDOUT;
+	key = k_spin_lock(&z_pthread_spinlock);
+
+	/* Mark the mutex contended before waiting, unless it got unlocked */
+	while (true) {
+		owner = atomic_ptr_get(&m->owner);
+		if (owner == NULL) {
+			if (atomic_ptr_cas(&m->owner, NULL, self)) {
+				m->lock_count = 1U;
+				k_spin_unlock(&z_pthread_spinlock, key);
+				return 0;
+			}
+		} else if (atomic_ptr_cas(&m->owner, owner,
+					  (void *)((uintptr_t)owner |
+						   MUTEX_CONTENDED))) {
+			break;
+		}
+	}
+
+	/* The unlocking thread hands the mutex over before waking us up */
+	if (z_pend_curr(&z_pthread_spinlock, key, &m->wait_q, timeout) != 0) {
+		return ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/* Hands the mutex over to its first waiter, if any, or unlocks it.
+ * Called with z_pthread_spinlock held, returns true if a thread was woken.
+ */
+bool z_pthread_mutex_release(pthread_mutex_t *m)
+{
+	struct k_thread *thread = z_unpend_first_thread(&m->wait_q);
+	uintptr_t owner;
+
+	if (thread == NULL) {
+		atomic_ptr_set(&m->owner, NULL);
+		return false;
+	}
+
+	owner = (uintptr_t)thread;
+	if (z_waitq_head(&m->wait_q) != NULL) {
+		owner |= MUTEX_CONTENDED;
 	}
 
-	return rc;
+	atomic_ptr_set(&m->owner, (void *)owner);
+	m->lock_count = 1U;
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
 }
 
 /**
@@ -121,36 +178,32 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	unsigned int key = irq_lock();
-
-	k_tid_t thread;
+	pthread_t self = pthread_self();
+	k_spinlock_key_t key;
 
-	if (m->owner != pthread_self()) {
-		irq_unlock(key);
+	if (mutex_owner(m) != self) {
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
 	m->lock_count--;
 
-	if (m->lock_count == 0U) {
-		thread = z_unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			z_ready_thread(thread);
-			arch_thread_return_value_set(thread, 0);
-			z_reschedule_irqlock(key);
-			return 0;
-		}
-		m->owner = NULL;
+	if (m->lock_count != 0U ||
+	    likely(atomic_ptr_cas(&m->owner, self, NULL))) {
+		return 0;
+	}
 
+	key = k_spin_lock(&z_pthread_spinlock);
+
+	if (z_pthread_mutex_release(m)) {
+		z_reschedule(&z_pthread_spinlock, key);
+	} else {
+		k_spin_unlock(&z_pthread_spinlock, key);
 	}
-	irq_unlock(key);
+
 	return 0;
 }
 
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <posix/pthread.h>
+
+/*
+ * Spinlocks never block in the kernel: they are meant for the critical
+ * sections too short for a mutex. A uniprocessor gives the CPU away while
+ * spinning, the holder can't run before the waiter otherwise.
+ */
+
+/**
+ * @brief Initialize POSIX spinlock.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_init(pthread_spinlock_t *lock, int pshared)
+{
+	if (pshared != PTHREAD_PROCESS_PRIVATE &&
+	    pshared != PTHREAD_PROCESS_SHARED) {
+		return EINVAL;
+	}
+
+	atomic_clear(lock);
+
+	return 0;
+}
+
+/**
+ * @brief Destroy POSIX spinlock.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_destroy(pthread_spinlock_t *lock)
+{
+	return atomic_get(lock) != 0 ? EBUSY : 0;
+}
+
+/**
+ * @brief Lock POSIX spinlock with blocking call.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_lock(pthread_spinlock_t *lock)
+{
+	while (!atomic_cas(lock, 0, 1)) {
+		if (!IS_ENABLED(CONFIG_SMP)) {
+			k_yield();
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Lock POSIX spinlock with non-blocking call.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_trylock(pthread_spinlock_t *lock)
+{
+	return atomic_cas(lock, 0, 1) ? 0 : EBUSY;
+}
+
+/**
+ * @brief Unlock POSIX spinlock.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_spin_unlock(pthread_spinlock_t *lock)
+{
+	return atomic_cas(lock, 1, 0) ? 0 : EPERM;
+}
@@ -244,7 +244,7 @@ void mqtt_startup(char *hostname, int port)
 	char pub_msg[64];
 	struct sockaddr_in *broker4 = (struct sockaddr_in *)&broker;
 	struct mqtt_client *client = &client_ctx;
-	struct jwt_builder jb;
+	static struct jwt_cache jc;
 	static struct zsock_addrinfo hints;
 	struct zsock_addrinfo *haddr;
 	int res = 0;
@@ -281,22 +281,14 @@ void mqtt_startup(char *hostname, int port)
 
 		time_t now = my_k_time(NULL);
 
-		res = jwt_init_builder(&jb, token, sizeof(token));
-		if (res != 0) {
-			LOG_ERR("Error with JWT token");
-			return;
+		/* The token is only signed again when about to expire */
+		if (jc.buf == NULL) {
+			jwt_cache_init(&jc, token, sizeof(token));
 		}
 
-		res = jwt_add_payload(&jb, now + 60 * 60, now,
-				      CONFIG_CLOUD_AUDIENCE);
-		if (res != 0) {
-			LOG_ERR("Error with JWT token");
-			return;
-		}
-
-		res = jwt_sign(&jb, zepfull_private_der,
-			       zepfull_private_der_len);
-
+		res = jwt_cache_get(&jc, now, 60 * 60, CONFIG_CLOUD_AUDIENCE,
+				    zepfull_private_der,
+				    zepfull_private_der_len);
 		if (res != 0) {
 			LOG_ERR("Error with JWT token");
 			return;
@@ -314,7 +306,7 @@ void mqtt_startup(char *hostname, int port)
 		client->client_id.utf8 = client_id;
 		client->client_id.size = strlen(client_id);
 		client->password = &password;
-		password.size = jwt_payload_len(&jb);
+		password.size = jc.len;
 		client->user_name = &username;
 		client->protocol_version = MQTT_VERSION_3_1_1;
 
@@ -16,6 +16,10 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <drivers/gpio.h>
 #include <drivers/sensor.h>
 #include <net/lwm2m.h>
+#if defined(CONFIG_IMG_DELTA)
+#include <dfu/flash_img.h>
+#include <dfu/mcuboot.h>
+#endif
 
 #define APP_BANNER "Run LWM2M client"
 
@@ -171,7 +175,16 @@ static int firmware_update_cb(uint16_t obj_inst_id)
 {
 	LOG_DBG("UPDATE");
 
+#if defined(CONFIG_IMG_DELTA)
+	int ret = boot_request_upgrade(BOOT_UPGRADE_TEST);
+
+	if (ret < 0) {
+		LOG_ERR("Failed to request the upgrade (%d)", ret);
+		return ret;
+	}
+#else
 	/* TODO: kick off update process */
+#endif
 
 	/* If success, set the update result as RESULT_SUCCESS.
 	 * In reality, it should be set at function lwm2m_setup()
@@ -219,6 +232,39 @@ static void *firmware_get_buf(uint16_t obj_inst_id, uint16_t res_id,
 	return firmware_buf;
 }
 
+#if defined(CONFIG_IMG_DELTA)
+static struct flash_img_context flash_ctx;
+static struct flash_img_delta_ctx delta_ctx;
+static bool delta_started;
+
+/* The package is a patch against the running image */
+static int firmware_apply_delta(uint8_t *data, uint16_t data_len,
+				bool last_block)
+{
+	int ret;
+
+	if (!delta_started) {
+		ret = flash_img_init(&flash_ctx);
+		if (ret == 0) {
+			ret = flash_img_delta_init(&delta_ctx, &flash_ctx);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		delta_started = true;
+	}
+
+	ret = flash_img_delta_write(&delta_ctx, data, data_len, last_block);
+	if (ret < 0 || last_block) {
+		delta_started = false;
+	}
+
+	return ret;
+}
+#endif
+
 static int firmware_block_received_cb(uint16_t obj_inst_id,
 				      uint16_t res_id, uint16_t res_inst_id,
 				      uint8_t *data, uint16_t data_len,
@@ -226,6 +272,16 @@ static int firmware_block_received_cb(uint16_t obj_inst_id,
 {
 	LOG_INF("FIRMWARE: BLOCK RECEIVED: len:%u last_block:%d",
 		data_len, last_block);
+
+#if defined(CONFIG_IMG_DELTA)
+	int ret = firmware_apply_delta(data, data_len, last_block);
+
+	if (ret < 0) {
+		LOG_ERR("Failed to apply the firmware patch (%d)", ret);
+		return ret;
+	}
+#endif
+
 	return 0;
 }
 #endif
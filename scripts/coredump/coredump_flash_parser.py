@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import argparse
+import struct
+import sys
+
+
+# Note: keep sync with coredump_backend_flash_partition.c
+FLASH_HDR_ID = b'CD'
+FLASH_HDR_VER = 1
+FLASH_HDR_STRUCT = "<2sHHHI"
+FLASH_HDR_SIZE = struct.calcsize(FLASH_HDR_STRUCT)
+
+FLASH_HDR_FLAG_COMPRESSED = 1 << 0
+FLASH_HDR_FLAG_ERROR = 1 << 1
+
+RUN_MIN = 3
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+
+    parser.add_argument("infile",
+            help="Content of the coredump flash partition")
+    parser.add_argument("outfile",
+            help="Output file for use with coredump GDB server")
+    parser.add_argument("--chunk-size", type=int, default=256,
+            help="CONFIG_DEBUG_COREDUMP_FLASH_CHUNK_SIZE of the image")
+
+    return parser.parse_args()
+
+
+def decompress(data):
+    out = bytearray()
+    idx = 0
+
+    while idx < len(data):
+        ctrl = data[idx]
+
+        if ctrl & 0x80:
+            # Run: 15-bit count and the repeated byte
+            count = ((ctrl & 0x7f) << 8 | data[idx + 1]) + RUN_MIN
+            out += bytes([data[idx + 2]]) * count
+            idx += 3
+        else:
+            # Literal run of ctrl + 1 bytes
+            out += data[idx + 1:idx + 2 + ctrl]
+            idx += 2 + ctrl
+
+    return bytes(out)
+
+
+def main():
+    args = parse_args()
+
+    try:
+        with open(args.infile, "rb") as infile:
+            partition = infile.read()
+    except OSError:
+        print(f"ERROR: Cannot open input file: {args.infile}, exiting...")
+        sys.exit(1)
+
+    print(f"Input file {args.infile}")
+    print(f"Output file {args.outfile}")
+
+    if len(partition) < FLASH_HDR_SIZE:
+        print("ERROR: Input file too small!")
+        sys.exit(1)
+
+    hdr_id, hdr_ver, flags, _, size = struct.unpack(FLASH_HDR_STRUCT,
+            partition[:FLASH_HDR_SIZE])
+
+    if hdr_id != FLASH_HDR_ID:
+        print("ERROR: No coredump found in partition!")
+        sys.exit(1)
+
+    if hdr_ver != FLASH_HDR_VER:
+        print(f"ERROR: Header version: {hdr_ver}, expected {FLASH_HDR_VER}!")
+        sys.exit(1)
+
+    if flags & FLASH_HDR_FLAG_ERROR:
+        print("ERROR: coredump has error.")
+        sys.exit(1)
+
+    stream = partition[args.chunk_size:args.chunk_size + size]
+    if len(stream) < size:
+        print("WARN: Partition shorter than the coredump! Is it complete?")
+
+    if flags & FLASH_HDR_FLAG_COMPRESSED:
+        stream = decompress(stream)
+
+    with open(args.outfile, "wb") as outfile:
+        outfile.write(stream)
+
+    print(f"Bytes written {len(stream)}")
+
+
+if __name__ == "__main__":
+    main()
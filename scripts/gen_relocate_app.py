@@ -29,6 +29,12 @@ Configuration that needs to be sent to the python script.
 
 Multiple regions can be appended together like SRAM2_DATA_BSS
 this will place data and bss inside SRAM2.
+
+Single functions can be relocated by appending a comma separated list of
+function names to the file, e.g. SRAM:/path/to/file.c:func1,func2. Only the
+.text.<function> sections, created by -ffunction-sections, are relocated
+then. An empty file name stands for all the object files found, which is
+used for the function lists generated from a profile.
 """
 
 
@@ -145,7 +151,7 @@ MEMSET_TEMPLATE = """
 """
 
 
-def find_sections(filename, full_list_of_sections):
+def find_sections(filename, full_list_of_sections, functions=None):
     with open(filename, 'rb') as obj_file_desc:
         full_lib = ELFFile(obj_file_desc)
         if not full_lib:
@@ -155,6 +161,14 @@ def find_sections(filename, full_list_of_sections):
 
         for section in sections:
 
+            # Only the sections of the given functions, if any
+            if functions is not None:
+                func = section.name[len(".text."):]
+                if section.name.startswith(".text.") and func in functions:
+                    full_list_of_sections["text"].append(section.name)
+                    functions[func] = True
+                continue
+
             if ".text." in section.name:
                 full_list_of_sections["text"].append(section.name)
 
@@ -230,7 +244,8 @@ def assign_to_correct_mem_region(memory_type,
 
 def print_linker_sections(list_sections):
     print_string = ''
-    for section in sorted(list_sections):
+    # A function may be listed both on its own and with its file
+    for section in sorted(set(list_sections)):
         print_string += PRINT_TEMPLATE.format(section)
     return print_string
 
@@ -388,27 +403,47 @@ def get_obj_filename(searchpath, filename):
                     return fullname
 
 
-# Create a dict with key as memory type and files as a list of values.
+# return the absolute paths of all the object files.
+def get_all_obj_filenames(searchpath):
+    obj_filenames = []
+
+    for dirpath, _, files in os.walk(searchpath):
+        for filename in files:
+            if filename.endswith(".obj"):
+                obj_filenames.append(os.path.join(dirpath, filename))
+
+    return sorted(obj_filenames)
+
+
+# Create a dict with key as memory type and a list of (file, functions)
+# tuples as values, functions being None for the whole file.
 def create_dict_wrt_mem():
     # need to support wild card *
     rel_dict = dict()
     if args.input_rel_dict == '':
         sys.exit("Disable CONFIG_CODE_DATA_RELOCATION if no file needs relocation")
     for line in args.input_rel_dict.split(';'):
-        mem_region, file_name = line.split(':')
+        mem_region, file_name, *func_names = line.split(':', 2)
+        functions = func_names[0].split(',') if func_names else None
 
-        file_name_list = glob.glob(file_name)
+        if mem_region == '':
+            continue
+
+        if file_name == '' and functions is not None:
+            file_name_list = ['']
+        else:
+            file_name_list = glob.glob(file_name)
         if not file_name_list:
             warnings.warn("File: "+file_name+" Not found")
             continue
-        if mem_region == '':
-            continue
         if args.verbose:
-            print("Memory region ", mem_region, " Selected for file:", file_name_list)
+            print("Memory region ", mem_region, " Selected for file:",
+                  file_name_list, "functions:", functions or "all")
+        entries = [(name, functions) for name in file_name_list]
         if mem_region in rel_dict:
-            rel_dict[mem_region].extend(file_name_list)
+            rel_dict[mem_region].extend(entries)
         else:
-            rel_dict[mem_region] = file_name_list
+            rel_dict[mem_region] = entries
 
     return rel_dict
 
@@ -431,13 +466,29 @@ def main():
     for memory_type, files in rel_dict.items():
         full_list_of_sections = {"text": [], "rodata": [], "data": [], "bss": []}
 
-        for filename in files:
-            obj_filename = get_obj_filename(searchpath, filename)
-            # the obj file wasn't found. Probably not compiled.
-            if not obj_filename:
-                continue
+        for filename, functions in files:
+            if filename == '':
+                obj_filenames = get_all_obj_filenames(searchpath)
+            else:
+                obj_filenames = [get_obj_filename(searchpath, filename)]
+
+            if functions is not None:
+                # Whether each function was found
+                functions = dict.fromkeys(functions, False)
+
+            for obj_filename in obj_filenames:
+                # the obj file wasn't found. Probably not compiled.
+                if not obj_filename:
+                    continue
+
+                full_list_of_sections = find_sections(obj_filename,
+                                                      full_list_of_sections,
+                                                      functions)
 
-            full_list_of_sections = find_sections(obj_filename, full_list_of_sections)
+            for func, found in (functions or {}).items():
+                if not found:
+                    warnings.warn("Function: " + func + " Not found in " +
+                                  (filename or "any object file"))
 
         # cleanup and attach the sections to the memory type after cleanup.
         complete_list_of_sections = assign_to_correct_mem_region(memory_type,
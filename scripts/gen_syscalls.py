@@ -20,7 +20,7 @@ parse_syscalls.py to create several files:
 - A directory containing header files. Each header corresponds to a header
   that was identified as containing system call declarations. These
   generated headers contain the inline invocation functions for each system
-  call in that header.
+  call in that header, and the helpers filling k_syscall_batch() entries.
 """
 
 import sys
@@ -219,6 +219,48 @@ def wrapper_defs(func_name, func_type, args):
 
     return wrap
 
+# Syscalls that never get a batch entry helper
+nobatch = ["k_syscall_batch"]
+
+def batch_defs(func_name, func_type, args):
+    # Helper filling a struct k_syscall_entry for k_syscall_batch().  Only
+    # generated when all marshalled words fit in the entry and there is
+    # no 64-bit return value, which would need storage of its own.
+    if func_name in nobatch or need_split(func_type):
+        return ""
+
+    mrsh_args = []
+    split_args = []
+    for argtype, argname in args:
+        if need_split(argtype):
+            mrsh_args.append("parm%d.split.lo" % len(split_args))
+            mrsh_args.append("parm%d.split.hi" % len(split_args))
+            split_args.append((argtype, argname))
+        else:
+            mrsh_args.append("*(uintptr_t *)&" + argname)
+
+    if len(mrsh_args) > 6:
+        return ""
+
+    decl_arglist = ", ".join(["struct k_syscall_entry *entry"] +
+                             [" ".join(argrec) for argrec in args])
+
+    batch = "#ifdef CONFIG_SYSCALL_BATCH\n"
+    batch += "static inline void %s_batch_entry(%s)\n" % (func_name,
+                                                          decl_arglist)
+    batch += "{\n"
+    for parmnum, (argtype, argname) in enumerate(split_args):
+        batch += "\t%s parm%d;\n" % (union_decl(argtype), parmnum)
+        batch += "\t" + "parm%d.val = %s;\n" % (parmnum, argname)
+    batch += "\t" + "entry->id = K_SYSCALL_%s;\n" % func_name.upper()
+    for i in range(6):
+        val = mrsh_args[i] if i < len(mrsh_args) else "0"
+        batch += "\t" + "entry->args[%d] = %s;\n" % (i, val)
+    batch += "}\n"
+    batch += "#endif\n"
+
+    return batch
+
 # Returns an expression for the specified (zero-indexed!) marshalled
 # parameter to a syscall, with handling for a final "more" parameter.
 def mrsh_rval(mrsh_num, total):
@@ -322,6 +364,7 @@ def analyze_fn(match_group):
     marshaller = None
     marshaller, handler = marshall_defs(func_name, func_type, args)
     invocation = wrapper_defs(func_name, func_type, args)
+    invocation += batch_defs(func_name, func_type, args)
 
     # Entry in _k_syscall_table
     table_entry = "[%s] = %s" % (sys_id, handler)
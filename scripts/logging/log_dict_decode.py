@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode the dictionary based log output.
+
+The target sends binary records (see include/logging/log_output_dict.h)
+holding the address of the format string of each message. The format
+strings and the names of the log sources are read from the ELF file of
+the application.
+
+Example:
+    log_dict_decode.py build/zephyr/zephyr.elf log.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+# ELF section flags
+SHF_ALLOC = 0x2
+
+# Machine types with padded log_source_const_data (see log_instance.h)
+EM_ALTERA_NIOS2 = 113
+
+# Record types
+LOG_DICT_MSG_STD = 0
+LOG_DICT_MSG_HEXDUMP = 1
+LOG_DICT_MSG_DROPPED = 2
+
+LEVELS = ["", "err", "wrn", "inf", "dbg"]
+
+HEXDUMP_BYTES_IN_LINE = 16
+
+FMT_SPEC = re.compile(r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?"
+                      r"(?:\.(?P<prec>\*|\d+))?"
+                      r"(?P<len>hh|h|ll|l|z|j|t|L)?"
+                      r"(?P<conv>[diouxXcspeEfgG%])")
+
+
+class LogDictionary():
+    """Format strings and source names read from the ELF file."""
+
+    def __init__(self, elffile):
+        with open(elffile, "rb") as fd:
+            elf = ELFFile(fd)
+
+            self.endianness = "<" if elf.little_endian else ">"
+            self.ptr_size = elf.elfclass // 8
+            self.regions = []
+
+            for section in elf.iter_sections():
+                if (section["sh_flags"] & SHF_ALLOC) == 0 or \
+                   section["sh_type"] == "SHT_NOBITS":
+                    continue
+
+                self.regions.append((section["sh_addr"], section.data()))
+
+            self.sources = self._read_sources(elf)
+
+    def _read_sources(self, elf):
+        symtab = elf.get_section_by_name(".symtab")
+        if not isinstance(symtab, SymbolTableSection):
+            return []
+
+        start = symtab.get_symbol_by_name("__log_const_start")
+        end = symtab.get_symbol_by_name("__log_const_end")
+        if not start or not end:
+            return []
+
+        start = start[0]["st_value"]
+        end = end[0]["st_value"]
+
+        entry_size = 2 * self.ptr_size
+        if elf["e_machine"] == "EM_ALTERA_NIOS2" or \
+           elf["e_machine"] == EM_ALTERA_NIOS2:
+            entry_size = 12
+
+        ptr_fmt = self.endianness + ("I" if self.ptr_size == 4 else "Q")
+        sources = []
+
+        for addr in range(start, end, entry_size):
+            raw = self.read(addr, self.ptr_size)
+            if raw is None:
+                break
+
+            name = self.string(struct.unpack(ptr_fmt, raw)[0])
+            sources.append(name)
+
+        return sources
+
+    def read(self, addr, length):
+        for base, data in self.regions:
+            if base <= addr and addr + length <= base + len(data):
+                return data[addr - base:addr - base + length]
+
+        return None
+
+    def string(self, addr):
+        for base, data in self.regions:
+            if base <= addr < base + len(data):
+                off = addr - base
+                end = data.find(b"\0", off)
+                if end < 0:
+                    end = len(data)
+                return data[off:end].decode("utf-8", "replace")
+
+        return None
+
+    def source_name(self, source_id):
+        if source_id < len(self.sources) and self.sources[source_id]:
+            return self.sources[source_id]
+
+        return "source %d" % source_id
+
+
+class LogDecoder():
+    """Decode a stream of dictionary log records."""
+
+    def __init__(self, dictionary, freq=None):
+        self.dict = dictionary
+        self.freq = freq
+
+        ptr = "I" if dictionary.ptr_size == 4 else "Q"
+        self.hdr = struct.Struct(dictionary.endianness + "BBHIH" + ptr)
+        self.arg = struct.Struct(dictionary.endianness + ptr)
+
+    def _signed(self, value, bits):
+        value &= (1 << bits) - 1
+        if value & (1 << (bits - 1)):
+            value -= 1 << bits
+        return value
+
+    def format(self, fmt, args, strings):
+        args = list(args)
+        strings = list(strings)
+        out = []
+        pos = 0
+
+        def next_arg():
+            return args.pop(0) if args else 0
+
+        for spec in FMT_SPEC.finditer(fmt):
+            out.append(fmt[pos:spec.start()])
+            pos = spec.end()
+
+            conv = spec.group("conv")
+            if conv == "%":
+                out.append("%")
+                continue
+
+            width = spec.group("width")
+            if width == "*":
+                width = str(self._signed(next_arg(), 32))
+            prec = spec.group("prec")
+            if prec == "*":
+                prec = str(self._signed(next_arg(), 32))
+
+            pyspec = "%" + spec.group("flags") + (width or "")
+            if prec is not None:
+                pyspec += "." + prec
+
+            length = spec.group("len")
+            bits = 32
+            if length in ("l", "ll", "z", "j", "t"):
+                bits = 8 * self.dict.ptr_size
+
+            value = next_arg()
+
+            if conv == "s":
+                value = strings.pop(0) if strings else "(missing)"
+                out.append((pyspec + "s") % value)
+            elif conv == "c":
+                out.append((pyspec + "c") % chr(value & 0xff))
+            elif conv in "di":
+                out.append((pyspec + "d") % self._signed(value, bits))
+            elif conv == "u":
+                out.append((pyspec + "d") % (value & ((1 << bits) - 1)))
+            elif conv in "oxX":
+                out.append((pyspec + conv) % (value & ((1 << bits) - 1)))
+            elif conv == "p":
+                out.append("0x%x" % value)
+            else:
+                # Floating point values are not passed as log arguments
+                out.append("<%s 0x%x>" % (spec.group(0), value))
+
+        out.append(fmt[pos:])
+
+        return "".join(out)
+
+    def prefix(self, domain_id, level, source_id, timestamp):
+        if self.freq:
+            ts = "[%012.6f]" % (timestamp / self.freq)
+        else:
+            ts = "[%08u]" % timestamp
+
+        name = LEVELS[level] if level < len(LEVELS) else str(level)
+
+        source = self.dict.source_name(source_id)
+        if domain_id:
+            source = "%d/%s" % (domain_id, source)
+
+        return "%s <%s> %s: " % (ts, name, source)
+
+    def hexdump(self, prefix, data):
+        lines = []
+
+        for off in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+            part = data[off:off + HEXDUMP_BYTES_IN_LINE]
+            hexs = " ".join("%02x" % b for b in part)
+            text = "".join(chr(b) if 32 <= b < 127 else "."
+                           for b in part)
+            lines.append("%s%-48s |%s" % (" " * len(prefix), hexs, text))
+
+        return lines
+
+    def decode(self, stream):
+        """Yield the decoded lines of a binary stream."""
+
+        while True:
+            raw = stream.read(self.hdr.size)
+            if len(raw) < self.hdr.size:
+                return
+
+            (msg_type, level, source_id, timestamp, length,
+             fmt_addr) = self.hdr.unpack(raw)
+            domain_id = level >> 3
+            level &= 0x7
+
+            if msg_type == LOG_DICT_MSG_DROPPED:
+                yield "--- %d messages dropped ---" % length
+                continue
+
+            fmt = self.dict.string(fmt_addr) if fmt_addr else ""
+            if fmt is None:
+                fmt = "<unknown format 0x%x>" % fmt_addr
+
+            prefix = self.prefix(domain_id, level, source_id, timestamp)
+
+            if msg_type == LOG_DICT_MSG_STD:
+                args = []
+                for _ in range(length):
+                    args.append(self.arg.unpack(
+                        stream.read(self.arg.size))[0])
+
+                strings = []
+                for _ in range(self._count_strings(fmt, length)):
+                    strings.append(self._read_string(stream))
+
+                yield prefix + self.format(fmt, args, strings)
+            elif msg_type == LOG_DICT_MSG_HEXDUMP:
+                data = stream.read(length)
+
+                if level == 0:
+                    # printk() output
+                    lines = data.decode("utf-8", "replace")
+                    yield lines.rstrip("\n")
+                    continue
+
+                yield prefix + fmt
+                for line in self.hexdump(prefix, data):
+                    yield line
+            else:
+                sys.stderr.write("Unknown record type %d, stopping\n" %
+                                 msg_type)
+                return
+
+    def _count_strings(self, fmt, nargs):
+        """Number of %s among the first nargs conversions, the target sends
+        the value of each of them."""
+        convs = [spec.group("conv") for spec in FMT_SPEC.finditer(fmt)
+                 if spec.group("conv") != "%"]
+
+        return convs[:nargs].count("s")
+
+    def _read_string(self, stream):
+        chars = bytearray()
+
+        while True:
+            c = stream.read(1)
+            if not c or c == b"\0":
+                break
+            chars += c
+
+        return chars.decode("utf-8", "replace")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("elffile", help="ELF file of the application")
+    parser.add_argument("logfile", nargs="?", default="-",
+                        help="Binary log output, stdin if omitted")
+    parser.add_argument("--timestamp-freq", type=int,
+                        help="Timestamp frequency in Hz, to print seconds "
+                             "instead of raw timestamps")
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    dictionary = LogDictionary(args.elffile)
+    decoder = LogDecoder(dictionary, args.timestamp_freq)
+
+    if args.logfile == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.logfile, "rb")
+
+    try:
+        for line in decoder.decode(stream):
+            print(line, flush=True)
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Fold the samples of the sampling profiler into stacks.
+
+The samples printed by the "profiling dump" shell command are symbolized
+with the ELF file of the application, and counted per stack, one
+"thread;caller;function count" line each. The output can be fed to
+flamegraph.pl or to speedscope.
+
+Example:
+    profile_fold.py build/zephyr/zephyr.elf console.log > profile.folded
+    flamegraph.pl profile.folded > profile.svg
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+# Line printed for each sample: pc, caller and thread
+SAMPLE = re.compile(r"(0x[0-9a-fA-F]+) (0x[0-9a-fA-F]+) (0x[0-9a-fA-F]+)\s*$")
+
+# Prefix of the thread objects defined by K_THREAD_DEFINE()
+THREAD_OBJ_PREFIX = "_k_thread_obj_"
+
+
+class Symbols():
+    """Function and object symbols read from the ELF file."""
+
+    def __init__(self, elffile):
+        self.funcs = []
+        self.objects = {}
+
+        with open(elffile, "rb") as fd:
+            elf = ELFFile(fd)
+            symtab = elf.get_section_by_name(".symtab")
+            if not isinstance(symtab, SymbolTableSection):
+                sys.exit(f"{elffile}: no symbol table")
+
+            for sym in symtab.iter_symbols():
+                sym_type = sym["st_info"]["type"]
+                if sym_type == "STT_FUNC":
+                    # Clear the Thumb bit
+                    addr = sym["st_value"] & ~1
+                    self.funcs.append((addr, sym["st_size"], sym.name))
+                elif sym_type == "STT_OBJECT":
+                    self.objects[sym["st_value"]] = sym.name
+
+        self.funcs.sort()
+        self.addrs = [func[0] for func in self.funcs]
+
+    def func(self, addr):
+        """Name of the function holding addr, None if unknown."""
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx < 0:
+            return None
+
+        start, size, name = self.funcs[idx]
+        if addr >= start + max(size, 1):
+            return None
+
+        return name
+
+    def thread(self, addr):
+        """Name of the thread object at addr."""
+        name = self.objects.get(addr)
+        if name is None:
+            return f"thread_{addr:x}"
+
+        if name.startswith(THREAD_OBJ_PREFIX):
+            return name[len(THREAD_OBJ_PREFIX):]
+
+        return name
+
+
+def fold(symbols, lines, with_thread):
+    """Count the samples per stack."""
+    stacks = collections.Counter()
+
+    for line in lines:
+        match = SAMPLE.search(line)
+        if not match:
+            continue
+
+        pc, caller, thread = (int(val, 16) for val in match.groups())
+        frames = []
+
+        if with_thread:
+            frames.append(symbols.thread(thread))
+
+        if pc == 0:
+            frames.append("[interrupt]")
+        else:
+            func = symbols.func(pc) or f"0x{pc:x}"
+            # Thumb bit set in return addresses
+            caller_func = symbols.func(caller & ~1) if caller else None
+
+            if caller_func and caller_func != func:
+                frames.append(caller_func)
+            frames.append(func)
+
+        stacks[";".join(frames)] += 1
+
+    return stacks
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elffile", help="ELF file of the application")
+    parser.add_argument("logfile", nargs="?", default="-",
+                        help="Shell output holding the samples, '-' for "
+                             "standard input")
+    parser.add_argument("--no-thread", action="store_true",
+                        help="Do not split the stacks per thread")
+    args = parser.parse_args()
+
+    symbols = Symbols(args.elffile)
+
+    if args.logfile == "-":
+        stacks = fold(symbols, sys.stdin, not args.no_thread)
+    else:
+        with open(args.logfile, "r", errors="replace") as fd:
+            stacks = fold(symbols, fd, not args.no_thread)
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""List the hottest functions of a profile, for relocation to fast memory.
+
+The samples printed by the "profiling dump" shell command, or the functions
+printed by "profiling instrument hot", are symbolized with the ELF file of
+the application. The functions the most samples, or the most exclusive time,
+were spent in are listed one per line, hottest first, in the format read by
+zephyr_code_relocate_list().
+
+Example:
+    profile_hot.py --coverage 90 build/zephyr/zephyr.elf console.log > hot.txt
+
+and in the CMakeLists.txt of the application:
+    zephyr_code_relocate_list(hot.txt ITCM_TEXT)
+"""
+
+import argparse
+import collections
+import fnmatch
+import re
+import sys
+
+from profile_fold import SAMPLE, Symbols
+
+# Line printed for each function by "profiling instrument hot": address,
+# calls, inclusive and exclusive time
+INSTRUMENT_FUNC = re.compile(r"(0x[0-9a-fA-F]+)\s+(\d+)\s+(\d+)\s+(\d+)\s*$")
+
+# Functions running before, or doing, the copy of the relocated code
+DEFAULT_EXCLUDES = ["memcpy", "memset", "z_data_copy", "z_bss_zero",
+                    "data_copy_xip_relocation", "bss_zeroing_relocation"]
+
+
+def weigh(symbols, lines):
+    """Weight of each function: samples, or exclusive time."""
+    weights = collections.Counter()
+
+    for line in lines:
+        match = SAMPLE.search(line)
+        if match:
+            pc = int(match.group(1), 16)
+            # Samples of other interrupts have no program counter
+            if pc != 0:
+                weights[symbols.func(pc) or f"0x{pc:x}"] += 1
+            continue
+
+        match = INSTRUMENT_FUNC.search(line)
+        if match:
+            addr = int(match.group(1), 16)
+            weights[symbols.func(addr) or f"0x{addr:x}"] += \
+                int(match.group(4))
+
+    return weights
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elffile", help="ELF file of the application")
+    parser.add_argument("logfile", nargs="?", default="-",
+                        help="Shell output holding the profile, '-' for "
+                             "standard input")
+    parser.add_argument("-n", "--count", type=int, default=20,
+                        help="Maximum number of functions listed "
+                             "(default: %(default)s)")
+    parser.add_argument("-c", "--coverage", type=float, default=100.0,
+                        help="Stop once the listed functions account for "
+                             "this percentage of the profile")
+    parser.add_argument("-x", "--exclude", action="append", default=[],
+                        metavar="PATTERN",
+                        help="Do not list the functions matching this "
+                             "pattern, in addition to the ones copying the "
+                             "relocated code")
+    args = parser.parse_args()
+
+    symbols = Symbols(args.elffile)
+
+    if args.logfile == "-":
+        weights = weigh(symbols, sys.stdin)
+    else:
+        with open(args.logfile, "r", errors="replace") as fd:
+            weights = weigh(symbols, fd)
+
+    total = sum(weights.values())
+    if total == 0:
+        sys.exit(f"{args.logfile}: no profile found")
+
+    excludes = DEFAULT_EXCLUDES + args.exclude
+    listed = 0
+    covered = 0
+
+    print(f"# Hottest functions of {args.logfile}, "
+          "share of the profile and cumulated share")
+    for func, weight in weights.most_common():
+        if listed >= args.count or covered * 100.0 >= args.coverage * total:
+            break
+
+        # Unknown addresses, or code which must stay in place
+        if (func.startswith("0x") or
+                any(fnmatch.fnmatch(func, pat) for pat in excludes)):
+            continue
+
+        listed += 1
+        covered += weight
+        print(f"{func:<32} # {weight * 100.0 / total:5.1f}% "
+              f"{covered * 100.0 / total:5.1f}%")
+
+
+if __name__ == "__main__":
+    main()
@@ -1049,6 +1049,7 @@ class SizeCalculator:
         "uart_mux",
         'log_backends_sections',
         'log_dynamic_sections',
+        'log_level_data_sections',
         'log_const_sections',
         "app_smem",
         'shell_root_cmds_sections',
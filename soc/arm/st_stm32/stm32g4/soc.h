@@ -76,6 +76,10 @@
 #include <stm32g4xx_ll_rng.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32g4xx_ll_crc.h>
+#endif
+
 #if defined(CONFIG_COUNTER_RTC_STM32)
 #include <stm32g4xx_ll_rtc.h>
 #include <stm32g4xx_ll_exti.h>
@@ -220,4 +220,37 @@ void soc_sched_ipi(void)
 			 IPM_CAVS_IDC_MSG_SCHED_IPI_DATA, 0);
 	}
 }
+
+/* The IPM API can only broadcast, so targeted IPIs write the IDC
+ * registers of each target core directly, the same way cavs_idc_send()
+ * does.  A core with a message from us still pending is skipped: it
+ * will take the IDC interrupt and reschedule anyway.
+ */
+FUNC_ALIAS(soc_sched_ipi_mask, arch_sched_ipi_mask, void);
+void soc_sched_ipi_mask(uint32_t cpu_mask)
+{
+	uint32_t curr_cpu_id = arch_curr_cpu()->id;
+	uint32_t id = IPM_CAVS_IDC_MSG_SCHED_IPI_ID & IPC_IDCITC_MSG_MASK;
+	uint32_t ext = (IPM_CAVS_IDC_MSG_SCHED_IPI_DATA & IPC_IDCIETC_MSG_MASK)
+		       | IPC_IDCIETC_DONE;
+	int i;
+
+	if (idc == NULL) {
+		return;
+	}
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((i == curr_cpu_id) || ((cpu_mask & BIT(i)) == 0)) {
+			continue;
+		}
+
+		if ((idc_read(IPC_IDCITC(i), curr_cpu_id) &
+		     IPC_IDCITC_BUSY) != 0) {
+			continue;
+		}
+
+		idc_write(IPC_IDCIETC(i), curr_cpu_id, ext);
+		idc_write(IPC_IDCITC(i), curr_cpu_id, id | IPC_IDCITC_BUSY);
+	}
+}
 #endif
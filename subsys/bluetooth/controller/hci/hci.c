@@ -68,6 +68,9 @@ static uint16_t _opcode;
 struct dup {
 	uint8_t         mask;
 	bt_addr_le_t addr;
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+	uint32_t        time;
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
 };
 static struct dup dup_filter[CONFIG_BT_CTLR_DUP_FILTER_LEN];
 static int32_t dup_count;
@@ -3392,6 +3395,16 @@ static inline bool dup_found(struct pdu_adv *adv)
 				    sizeof(bt_addr_t)) &&
 			    adv->tx_addr == dup_filter[i].addr.type) {
 
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+				/* report the device again once it aged out */
+				if ((k_uptime_get_32() - dup_filter[i].time) >
+				    CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT) {
+					dup_filter[i].time = k_uptime_get_32();
+					dup_filter[i].mask = BIT(adv->type);
+					return false;
+				}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
+
 				if (dup_filter[i].mask & BIT(adv->type)) {
 					/* duplicate found */
 					return true;
@@ -3407,6 +3420,9 @@ static inline bool dup_found(struct pdu_adv *adv)
 		       &adv->adv_ind.addr[0], sizeof(bt_addr_t));
 		dup_filter[dup_curr].addr.type = adv->tx_addr;
 		dup_filter[dup_curr].mask = BIT(adv->type);
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+		dup_filter[dup_curr].time = k_uptime_get_32();
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
 
 		if (dup_count < CONFIG_BT_CTLR_DUP_FILTER_LEN) {
 			dup_count++;
@@ -65,6 +65,70 @@ static sys_slist_t hbuf_pend;
 static int32_t hbuf_count;
 #endif
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+/* Basic L2CAP header: PDU length and channel ID */
+#define L2CAP_HDR_SIZE 4
+
+/* Offset of the ACL header written in front of the Rx PDU payload */
+#define ACL_RX_HDR_OFFSET (offsetof(struct node_rx_pdu, pdu) + \
+			   offsetof(struct pdu_data, lldata) - \
+			   sizeof(struct bt_hci_acl_hdr))
+
+/* The ACL header shall only overwrite the footer of the node header,
+ * which is of no use once the node has been dequeued.
+ */
+BUILD_ASSERT(ACL_RX_HDR_OFFSET >= offsetof(struct node_rx_pdu, hdr) +
+				  offsetof(struct node_rx_hdr, rx_ftr));
+
+static void acl_rx_destroy(struct net_buf *buf)
+{
+	struct node_rx_pdu *node_rx = (void *)(buf->__buf - ACL_RX_HDR_OFFSET);
+
+	net_buf_destroy(buf);
+
+	/* The Link Layer memory is released in the receive thread, the
+	 * class tells it apart from the nodes to be encoded.
+	 */
+	node_rx->hdr.user_meta = HCI_CLASS_NONE;
+	k_fifo_put(&recv_fifo, node_rx);
+}
+
+NET_BUF_POOL_DEFINE(acl_rx_pool, CONFIG_BT_CTLR_RX_ZERO_COPY_COUNT, 0,
+		    BT_BUF_USER_DATA_MIN, acl_rx_destroy);
+
+static struct net_buf *acl_encode_zero_copy(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	struct bt_hci_acl_hdr *acl;
+	struct net_buf *buf;
+
+	/* Only complete L2CAP PDUs, so that the Host does not keep the node
+	 * while it waits for the continuation fragments.
+	 */
+	if (pdu_data->ll_id != PDU_DATA_LLID_DATA_START ||
+	    pdu_data->len < L2CAP_HDR_SIZE ||
+	    sys_get_le16(pdu_data->lldata) + L2CAP_HDR_SIZE != pdu_data->len) {
+		return NULL;
+	}
+
+	acl = (void *)((uint8_t *)node_rx + ACL_RX_HDR_OFFSET);
+	buf = net_buf_alloc_with_data(&acl_rx_pool, acl,
+				      sizeof(*acl) + pdu_data->len,
+				      K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	bt_buf_set_type(buf, BT_BUF_ACL_IN);
+
+	acl->handle = sys_cpu_to_le16(bt_acl_handle_pack(node_rx->hdr.handle,
+							  BT_ACL_START));
+	acl->len = sys_cpu_to_le16(pdu_data->len);
+
+	return buf;
+}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 static struct net_buf *process_prio_evt(struct node_rx_pdu *node_rx,
 					uint8_t *evt_flags)
 {
@@ -198,6 +262,14 @@ static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 		break;
 #if defined(CONFIG_BT_CONN)
 	case HCI_CLASS_ACL_DATA:
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		buf = acl_encode_zero_copy(node_rx);
+		if (buf) {
+			/* The node is released with the buffer */
+			return buf;
+		}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		/* generate ACL data */
 		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
 		hci_acl_encode(node_rx, buf);
@@ -389,6 +461,15 @@ static void recv_thread(void *p1, void *p2, void *p3)
 #endif
 		BT_DBG("unblocked");
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		/* Node given back by the Host, see acl_rx_destroy() */
+		if (node_rx->hdr.user_meta == HCI_CLASS_NONE) {
+			node_rx->hdr.next = NULL;
+			ll_rx_mem_release((void **)&node_rx);
+			continue;
+		}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		if (node_rx && !buf) {
 			/* process regular node from radio */
 			buf = process_node(node_rx);
@@ -249,6 +249,13 @@ struct ticker_instance {
 						     * the trigger (compare
 						     * value)
 						     */
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	uint32_t job_count;	   /* Number of completed ticker_job runs */
+	uint32_t job_ticks_last;   /* Duration of the last ticker_job run */
+	uint32_t job_ticks_max;	   /* Longest ticker_job run since the last
+				    * call to ticker_job_profile_get
+				    */
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 };
 
 BUILD_ASSERT(sizeof(struct ticker_node)    == TICKER_NODE_T_SIZE);
@@ -2241,6 +2248,9 @@ void ticker_job(void *param)
 	uint8_t flag_elapsed;
 	uint8_t pending;
 	uint8_t flag_compare_update;
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	uint32_t ticks_job_start;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -2251,6 +2261,10 @@ void ticker_job(void *param)
 	}
 	instance->job_guard = 1U;
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	ticks_job_start = cntr_cnt_get();
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
 
@@ -2339,6 +2353,15 @@ void ticker_job(void *param)
 				   instance);
 	}
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	instance->job_ticks_last = ticker_ticks_diff_get(cntr_cnt_get(),
+							 ticks_job_start);
+	if (instance->job_ticks_last > instance->job_ticks_max) {
+		instance->job_ticks_max = instance->job_ticks_last;
+	}
+	instance->job_count++;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	DEBUG_TICKER_JOB(0);
 }
 
@@ -2926,6 +2949,33 @@ void ticker_job_sched(uint8_t instance_index, uint8_t user_id)
 			   TICKER_CALL_ID_JOB, 0, instance);
 }
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/**
+ * @brief Get ticker job execution time
+ *
+ * @details Returns the duration of the last ticker_job run and of the
+ * longest run since the previous call, and resets the latter. Durations are
+ * in ticker ticks and include the time spent in higher priority contexts
+ * that preempted the job, e.g. ticker_worker and the radio ISR.
+ *
+ * @param instance_index Index of ticker instance
+ * @param ticks_last     Pointer to duration of the last run
+ * @param ticks_max      Pointer to duration of the longest run
+ * @param count          Pointer to number of completed runs
+ */
+void ticker_job_profile_get(uint8_t instance_index, uint32_t *ticks_last,
+			    uint32_t *ticks_max, uint32_t *count)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	*ticks_last = instance->job_ticks_last;
+	*ticks_max = instance->job_ticks_max;
+	*count = instance->job_count;
+
+	instance->job_ticks_max = 0U;
+}
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 /**
  * @brief Get current absolute tick count
  *
@@ -146,6 +146,10 @@ uint32_t ticker_job_idle_get(uint8_t instance_index, uint8_t user_id,
 void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+void ticker_job_profile_get(uint8_t instance_index, uint32_t *ticks_last,
+			    uint32_t *ticks_max, uint32_t *count);
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 #if !defined(CONFIG_BT_TICKER_COMPATIBILITY_MODE)
 uint32_t ticker_priority_set(uint8_t instance_index, uint8_t user_id, uint8_t ticker_id,
 			  int8_t priority, ticker_op_func fp_op_func,
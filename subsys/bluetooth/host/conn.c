@@ -416,6 +416,10 @@ struct bt_conn *bt_conn_new(struct bt_conn *conns, size_t size)
 
 	(void)memset(conn, 0, sizeof(*conn));
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	k_poll_signal_init(&conn->tx_resume);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	atomic_set(&conn->ref, 1);
 
 	return conn;
@@ -1263,6 +1267,74 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 	return send_frag(conn, buf, FRAG_END, false);
 }
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+/* Deficit round robin over the connections: each round grants a quantum
+ * of bytes and fragments are sent while the connection has some left,
+ * possibly overdrawing it by the last fragment. A packet that is not
+ * completely sent is resumed on the next round, so that the fragments
+ * of the other connections get their turn in between.
+ */
+static void conn_tx_sched(struct bt_conn *conn)
+{
+	conn->tx_deficit += CONFIG_BT_CONN_TX_SCHED_QUANTUM;
+
+	while (conn->tx_deficit > 0) {
+		struct net_buf *buf = conn->tx_frag;
+		struct net_buf *frag;
+
+		if (!buf) {
+			buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
+			if (!buf) {
+				/* Idle connections do not save up quanta */
+				conn->tx_deficit = 0;
+				return;
+			}
+
+			if (buf->len <= conn_mtu(conn)) {
+				conn->tx_deficit -= buf->len;
+				if (!send_frag(conn, buf, FRAG_SINGLE, false)) {
+					net_buf_unref(buf);
+					return;
+				}
+
+				continue;
+			}
+
+			conn->tx_frag = buf;
+			conn->tx_frag_flags = FRAG_START;
+		}
+
+		/* The last fragment is the original buffer */
+		if (buf->len <= conn_mtu(conn)) {
+			conn->tx_frag = NULL;
+			conn->tx_deficit -= buf->len;
+			if (!send_frag(conn, buf, FRAG_END, false)) {
+				net_buf_unref(buf);
+				return;
+			}
+
+			continue;
+		}
+
+		frag = create_frag(conn, buf);
+		if (!frag) {
+			conn->tx_frag = NULL;
+			net_buf_unref(buf);
+			return;
+		}
+
+		conn->tx_deficit -= frag->len;
+		if (!send_frag(conn, frag, conn->tx_frag_flags, true)) {
+			conn->tx_frag = NULL;
+			net_buf_unref(buf);
+			return;
+		}
+
+		conn->tx_frag_flags = FRAG_CONT;
+	}
+}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 static struct k_poll_signal conn_change =
 		K_POLL_SIGNAL_INITIALIZER(conn_change);
 
@@ -1270,6 +1342,19 @@ static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	if (conn->tx_frag) {
+		if (tx_data(conn->tx_frag)->tx) {
+			tx_free(tx_data(conn->tx_frag)->tx);
+		}
+
+		net_buf_unref(conn->tx_frag);
+		conn->tx_frag = NULL;
+	}
+
+	conn->tx_deficit = 0;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Give back any allocated buffers */
 	while ((buf = net_buf_get(&conn->tx_queue, K_NO_WAIT))) {
 		if (tx_data(buf)->tx) {
@@ -1306,6 +1391,18 @@ static int conn_prepare_events(struct bt_conn *conn,
 
 	BT_DBG("Adding conn %p to poll list", conn);
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* Resume the pending packet on this round */
+	if (conn->tx_frag) {
+		k_poll_signal_raise(&conn->tx_resume, 0);
+		k_poll_event_init(&events[0], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &conn->tx_resume);
+		events[0].tag = BT_EVENT_CONN_TX_RESUME;
+
+		return 0;
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	k_poll_event_init(&events[0],
 			K_POLL_TYPE_FIFO_DATA_AVAILABLE,
 			K_POLL_MODE_NOTIFY_ONLY,
@@ -1360,6 +1457,12 @@ void bt_conn_process_tx(struct bt_conn *conn)
 		return;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	k_poll_signal_reset(&conn->tx_resume);
+	conn_tx_sched(conn);
+	return;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Get next ACL packet for connection */
 	buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
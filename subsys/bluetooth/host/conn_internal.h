@@ -155,6 +155,15 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* Packet whose remaining fragments wait for the next round */
+	struct net_buf		*tx_frag;
+	uint8_t			tx_frag_flags;
+	/* Bytes the connection may still send in the current round */
+	int32_t			tx_deficit;
+	struct k_poll_signal	tx_resume;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Active L2CAP/ISO channels */
 	sys_slist_t		channels;
 
@@ -78,6 +78,22 @@ static const uint16_t gap_appearance = CONFIG_BT_DEVICE_APPEARANCE;
 static sys_slist_t db;
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Attributes by handle, the attribute of handle 1 is at index 0 */
+static const struct bt_gatt_attr *attr_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
+static inline void attr_index_set(uint16_t handle,
+				  const struct bt_gatt_attr *attr)
+{
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	/* Handles past the index are found by walking the database */
+	if (handle && handle <= CONFIG_BT_GATT_ATTR_INDEX_SIZE) {
+		attr_index[handle - 1] = attr;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+}
+
 static atomic_t init;
 static atomic_t service_init;
 
@@ -873,6 +889,10 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+	for (count = 0; count < svc->attr_count; count++) {
+		attr_index_set(svc->attrs[count].handle, &svc->attrs[count]);
+	}
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1046,6 +1066,11 @@ static void bt_gatt_service_init(void)
 	}
 
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			attr_index_set(last_static_handle + i + 1,
+				       &svc->attrs[i]);
+		}
+
 		last_static_handle += svc->attr_count;
 	}
 }
@@ -1067,6 +1092,10 @@ void bt_gatt_init(void)
 	k_delayed_work_submit(&db_hash_work, DB_HASH_TIMEOUT);
 #endif /* CONFIG_BT_GATT_CACHING */
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	k_delayed_work_init(&nfy_mult_work, notify_mult_process);
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
 #if defined(CONFIG_BT_GATT_SERVICE_CHANGED)
 	k_delayed_work_init(&gatt_sc.work, sc_process);
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -1186,6 +1215,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		if (attr->write == bt_gatt_attr_write_ccc) {
 			gatt_unregister_ccc(attr->user_data);
 		}
+
+		attr_index_set(attr->handle, NULL);
 	}
 
 	return 0;
@@ -1504,6 +1535,36 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static uint8_t foreach_attr_type_index(uint16_t start_handle,
+				       uint16_t end_handle,
+				       const struct bt_uuid *uuid,
+				       const void *attr_data,
+				       uint16_t *num_matches,
+				       bt_gatt_attr_func_t func,
+				       void *user_data)
+{
+	uint32_t last = MIN(end_handle, CONFIG_BT_GATT_ATTR_INDEX_SIZE);
+
+	for (uint32_t handle = MAX(start_handle, 1); handle <= last;
+	     handle++) {
+		const struct bt_gatt_attr *attr = attr_index[handle - 1];
+
+		if (!attr) {
+			continue;
+		}
+
+		if (gatt_foreach_iter(attr, handle, start_handle, end_handle,
+				      uuid, attr_data, num_matches, func,
+				      user_data) == BT_GATT_ITER_STOP) {
+			return BT_GATT_ITER_STOP;
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -1515,6 +1576,20 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (start_handle <= CONFIG_BT_GATT_ATTR_INDEX_SIZE) {
+		if (foreach_attr_type_index(start_handle, end_handle, uuid,
+					    attr_data, &num_matches, func,
+					    user_data) == BT_GATT_ITER_STOP ||
+		    end_handle <= CONFIG_BT_GATT_ATTR_INDEX_SIZE) {
+			return;
+		}
+
+		/* Walk the database for the handles past the index */
+		start_handle = CONFIG_BT_GATT_ATTR_INDEX_SIZE + 1;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -1773,7 +1848,7 @@ static int gatt_notify_mult_send(struct bt_conn *conn, struct net_buf **buf)
 	return ret;
 }
 
-static void notify_mult_process(struct k_work *work)
+static void notify_mult_flush(struct bt_conn *conn)
 {
 	int i;
 
@@ -1782,15 +1857,23 @@ static void notify_mult_process(struct k_work *work)
 		struct net_buf **buf = &nfy_mult[i];
 
 		if (*buf) {
-			struct bt_conn *conn = bt_conn_lookup_index(i);
+			struct bt_conn *c = bt_conn_lookup_index(i);
 
-			gatt_notify_mult_send(conn, buf);
-			bt_conn_unref(conn);
+			if (!conn || c == conn) {
+				gatt_notify_mult_send(c, buf);
+			}
+
+			bt_conn_unref(c);
 		}
 	}
 }
 
-K_WORK_DEFINE(nfy_mult_work, notify_mult_process);
+static void notify_mult_process(struct k_work *work)
+{
+	notify_mult_flush(NULL);
+}
+
+static struct k_delayed_work nfy_mult_work;
 
 static bool gatt_cf_notify_multi(struct bt_conn *conn)
 {
@@ -1832,6 +1915,12 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 		/* Set user_data so it can be restored when sending */
 		nfy_mult_user_data(*buf)->func = params->func;
 		nfy_mult_user_data(*buf)->user_data = params->user_data;
+
+		/* The timeout runs from the first value of the PDU, later
+		 * values do not postpone it.
+		 */
+		k_delayed_work_submit(&nfy_mult_work,
+			K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_TIMEOUT));
 	}
 
 	BT_DBG("handle 0x%04x len %u", handle, params->len);
@@ -1843,8 +1932,6 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	net_buf_add(*buf, params->len);
 	memcpy(nfy->value, params->data, params->len);
 
-	k_work_submit(&nfy_mult_work);
-
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
@@ -1870,8 +1957,11 @@ static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 	if (gatt_cf_notify_multi(conn)) {
 		int err;
 
+		/* Fall back to a single notification when no PDU can be
+		 * allocated.
+		 */
 		err = gatt_notify_mult(conn, handle, params);
-		if (err && err != -ENOMEM) {
+		if (err != -ENOMEM) {
 			return err;
 		}
 	}
@@ -2156,11 +2246,10 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 	return data.err;
 }
 
-#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
 int bt_gatt_notify_multiple(struct bt_conn *conn, uint16_t num_params,
 			    struct bt_gatt_notify_params *params)
 {
-	int i, ret;
+	int i, ret = 0;
 
 	__ASSERT(params, "invalid parameters\n");
 	__ASSERT(num_params, "invalid parameters\n");
@@ -2169,14 +2258,18 @@ int bt_gatt_notify_multiple(struct bt_conn *conn, uint16_t num_params,
 	for (i = 0; i < num_params; i++) {
 		ret = bt_gatt_notify_cb(conn, &params[i]);
 		if (ret < 0) {
-			return ret;
+			break;
 		}
 	}
 
-	return 0;
-}
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	/* The batch is complete, don't wait for the flush timeout */
+	notify_mult_flush(conn);
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
+	return ret < 0 ? ret : 0;
+}
+
 int bt_gatt_indicate(struct bt_conn *conn,
 		     struct bt_gatt_indicate_params *params)
 {
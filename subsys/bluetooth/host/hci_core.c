@@ -5182,6 +5182,15 @@ static void process_events(struct k_poll_event *ev, int count)
 
 		switch (ev->state) {
 		case K_POLL_STATE_SIGNALED:
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+			if (ev->tag == BT_EVENT_CONN_TX_RESUME) {
+				struct bt_conn *conn;
+
+				conn = CONTAINER_OF(ev->signal, struct bt_conn,
+						    tx_resume);
+				bt_conn_process_tx(conn);
+			}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 			break;
 		case K_POLL_STATE_FIFO_DATA_AVAILABLE:
 			if (ev->tag == BT_EVENT_CMD_TX) {
@@ -32,6 +32,42 @@ static struct bt_mesh_app_key apps[CONFIG_BT_MESH_APP_KEY_COUNT] = {
 	}
 };
 
+#if defined(CONFIG_BT_MESH_KEY_CACHE)
+/* Application key that last decrypted a message from a source address. A
+ * stale entry only costs one failed decryption attempt.
+ */
+static struct {
+	uint16_t src;
+	uint8_t app;
+} key_cache[CONFIG_BT_MESH_KEY_CACHE_SIZE];
+
+static int key_cache_get(uint16_t src)
+{
+	uint16_t i = src % ARRAY_SIZE(key_cache);
+
+	if (key_cache[i].src != src) {
+		return -1;
+	}
+
+	return key_cache[i].app;
+}
+
+static void key_cache_set(uint16_t src, int app)
+{
+	uint16_t i = src % ARRAY_SIZE(key_cache);
+
+	key_cache[i].src = src;
+	key_cache[i].app = app;
+}
+#else
+static inline int key_cache_get(uint16_t src)
+{
+	return -1;
+}
+
+static inline void key_cache_set(uint16_t src, int app) {}
+#endif
+
 static void app_key_evt(struct bt_mesh_app_key *app, enum bt_mesh_key_evt evt)
 {
 	Z_STRUCT_SECTION_FOREACH(bt_mesh_app_key_cb, cb) {
@@ -388,13 +424,42 @@ int bt_mesh_keys_resolve(struct bt_mesh_msg_ctx *ctx,
 	return 0;
 }
 
+static int app_key_try(const struct bt_mesh_app_key *app, uint8_t aid,
+		       struct bt_mesh_net_rx *rx,
+		       int (*cb)(struct bt_mesh_net_rx *rx,
+				 const uint8_t key[16], void *cb_data),
+		       void *cb_data)
+{
+	const struct bt_mesh_app_cred *cred;
+
+	if (app->app_idx == BT_MESH_KEY_UNUSED) {
+		return -ENOENT;
+	}
+
+	if (app->net_idx != rx->sub->net_idx) {
+		return -ENOENT;
+	}
+
+	if (rx->new_key && app->updated) {
+		cred = &app->keys[1];
+	} else {
+		cred = &app->keys[0];
+	}
+
+	if (cred->id != aid) {
+		return -ENOENT;
+	}
+
+	return cb(rx, cred->val, cb_data);
+}
+
 uint16_t bt_mesh_app_key_find(bool dev_key, uint8_t aid,
 			      struct bt_mesh_net_rx *rx,
 			      int (*cb)(struct bt_mesh_net_rx *rx,
 					const uint8_t key[16], void *cb_data),
 			      void *cb_data)
 {
-	int err, i;
+	int err, i, cached;
 
 	if (dev_key) {
 		/* Attempt remote dev key first, as that is only available for
@@ -424,34 +489,23 @@ uint16_t bt_mesh_app_key_find(bool dev_key, uint8_t aid,
 		return BT_MESH_KEY_UNUSED;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(apps); i++) {
-		const struct bt_mesh_app_key *app = &apps[i];
-		const struct bt_mesh_app_cred *cred;
-
-		if (app->app_idx == BT_MESH_KEY_UNUSED) {
-			continue;
-		}
-
-		if (app->net_idx != rx->sub->net_idx) {
-			continue;
-		}
-
-		if (rx->new_key && app->updated) {
-			cred = &app->keys[1];
-		} else {
-			cred = &app->keys[0];
-		}
+	/* rx->ctx.addr is always a unicast address here, so it can never
+	 * match an empty cache slot.
+	 */
+	cached = key_cache_get(rx->ctx.addr);
+	if (cached >= 0 && !app_key_try(&apps[cached], aid, rx, cb, cb_data)) {
+		return apps[cached].app_idx;
+	}
 
-		if (cred->id != aid) {
+	for (i = 0; i < ARRAY_SIZE(apps); i++) {
+		if (i == cached) {
 			continue;
 		}
 
-		err = cb(rx, cred->val, cb_data);
-		if (err) {
-			continue;
+		if (!app_key_try(&apps[i], aid, rx, cb, cb_data)) {
+			key_cache_set(rx->ctx.addr, i);
+			return apps[i].app_idx;
 		}
-
-		return app->app_idx;
 	}
 
 	return BT_MESH_KEY_UNUSED;
@@ -68,6 +68,64 @@ static struct {
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+/* Hash chains of the message cache entries. The values are entry indexes
+ * plus one, zero terminates a chain.
+ */
+static uint16_t msg_cache_head[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t msg_cache_chain[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
+static uint16_t msg_cache_hash(uint16_t src, uint32_t seq)
+{
+	uint32_t key = ((uint32_t)src << 17) | seq;
+
+	return ((key * 2654435761U) >> 16) % ARRAY_SIZE(msg_cache_head);
+}
+
+/* Unassigned entries are not in any chain */
+static void msg_cache_link(uint16_t idx)
+{
+	uint16_t *head;
+
+	if (msg_cache[idx].src == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
+
+	head = &msg_cache_head[msg_cache_hash(msg_cache[idx].src,
+					      msg_cache[idx].seq)];
+	msg_cache_chain[idx] = *head;
+	*head = idx + 1;
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *next;
+
+	if (msg_cache[idx].src == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
+
+	next = &msg_cache_head[msg_cache_hash(msg_cache[idx].src,
+					      msg_cache[idx].seq)];
+	while (*next) {
+		if (*next == idx + 1) {
+			*next = msg_cache_chain[idx];
+			return;
+		}
+
+		next = &msg_cache_chain[*next - 1];
+	}
+}
+#else
+static inline void msg_cache_link(uint16_t idx)
+{
+}
+
+static inline void msg_cache_unlink(uint16_t idx)
+{
+}
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -101,14 +159,25 @@ static bool check_dup(struct net_buf_simple *data)
 
 static bool msg_cache_match(struct net_buf_simple *pdu)
 {
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
 	uint16_t i;
 
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+	for (i = msg_cache_head[msg_cache_hash(src, seq)]; i;
+	     i = msg_cache_chain[i - 1]) {
+		if (msg_cache[i - 1].src == src &&
+		    msg_cache[i - 1].seq == seq) {
+			return true;
+		}
+	}
+#else
 	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
+		if (msg_cache[i].src == src && msg_cache[i].seq == seq) {
 			return true;
 		}
 	}
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
 
 	return false;
 }
@@ -116,8 +185,11 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
 	rx->msg_cache_idx = msg_cache_next++;
+	/* Replace the oldest entry */
+	msg_cache_unlink(rx->msg_cache_idx);
 	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
 	msg_cache[rx->msg_cache_idx].seq = rx->seq;
+	msg_cache_link(rx->msg_cache_idx);
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
 }
 
@@ -142,6 +214,9 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 	}
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+	(void)memset(msg_cache_head, 0, sizeof(msg_cache_head));
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
 	msg_cache_next = 0U;
 
 	bt_mesh.iv_index = iv_index;
@@ -786,6 +861,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
+		msg_cache_unlink(rx.msg_cache_idx);
 		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
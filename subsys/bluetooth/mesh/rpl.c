@@ -32,12 +32,41 @@
 
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+/* Last slot used by a source address, indexed by the address. The hints
+ * are checked against the list, so stale ones are harmless.
+ */
+static uint16_t rpl_hint[CONFIG_BT_MESH_CRPL];
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
+
+static struct bt_mesh_rpl *rpl_hint_get(uint16_t src)
+{
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+	struct bt_mesh_rpl *rpl;
+
+	rpl = &replay_list[rpl_hint[src % ARRAY_SIZE(rpl_hint)]];
+	if (src && rpl->src == src) {
+		return rpl;
+	}
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
+
+	return NULL;
+}
+
+static void rpl_hint_set(struct bt_mesh_rpl *rpl)
+{
+#if defined(CONFIG_BT_MESH_HASHED_LOOKUP)
+	rpl_hint[rpl->src % ARRAY_SIZE(rpl_hint)] = rpl - replay_list;
+#endif /* CONFIG_BT_MESH_HASHED_LOOKUP */
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
+	rpl_hint_set(rpl);
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_store_rpl(rpl);
@@ -49,9 +78,30 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
  * updated (needed for segmented messages), whereas if a NULL match is given
  * the RPL is immediately updated (used for unsegmented messages).
  */
+static bool rpl_check_slot(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx,
+			   struct bt_mesh_rpl **match)
+{
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	/* Don't bother checking messages from ourselves */
@@ -64,8 +114,13 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
+	rpl = rpl_hint_get(rx->ctx.addr);
+	if (rpl) {
+		return rpl_check_slot(rpl, rx, match);
+	}
+
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+		rpl = &replay_list[i];
 
 		/* Empty slot */
 		if (!rpl->src) {
@@ -80,22 +135,8 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 
 		/* Existing slot for given address */
 		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
-
-				return false;
-			} else {
-				return true;
-			}
+			rpl_hint_set(rpl);
+			return rpl_check_slot(rpl, rx, match);
 		}
 	}
 
@@ -116,10 +157,17 @@ void bt_mesh_rpl_clear(void)
 
 struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
+	rpl = rpl_hint_get(src);
+	if (rpl) {
+		return rpl;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (replay_list[i].src == src) {
+			rpl_hint_set(&replay_list[i]);
 			return &replay_list[i];
 		}
 	}
@@ -134,6 +182,7 @@ struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (!replay_list[i].src) {
 			replay_list[i].src = src;
+			rpl_hint_set(&replay_list[i]);
 			return &replay_list[i];
 		}
 	}
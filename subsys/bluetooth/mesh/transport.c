@@ -101,6 +101,12 @@ static struct seg_tx {
 	const struct bt_mesh_send_cb *cb;
 	void                  *cb_data;
 	struct k_delayed_work retransmit;    /* Retransmit timer */
+#if defined(CONFIG_BT_MESH_TX_SEG_RETRANS_ADAPTIVE)
+	uint32_t              sent;          /* End of the last round */
+	uint16_t              rtt_dst;       /* Destination of the estimate */
+	uint16_t              srtt;          /* Smoothed ack latency */
+	uint16_t              rttvar;        /* Ack latency variation */
+#endif
 } seg_tx[CONFIG_BT_MESH_TX_SEG_MSG_COUNT];
 
 static struct seg_rx {
@@ -283,6 +289,65 @@ static inline void seg_tx_complete(struct seg_tx *tx, int err)
 	}
 }
 
+#if defined(CONFIG_BT_MESH_TX_SEG_RETRANS_ADAPTIVE)
+static void seg_tx_rtt_init(struct seg_tx *tx, uint16_t dst)
+{
+	/* Keep the estimate for consecutive messages to the same node */
+	if (tx->rtt_dst != dst) {
+		tx->rtt_dst = dst;
+		tx->srtt = 0U;
+		tx->rttvar = 0U;
+	}
+}
+
+static void seg_tx_rtt_sample(struct seg_tx *tx)
+{
+	uint32_t rtt, delta;
+
+	/* Acks for a round that is still being sent can't be measured */
+	if (!tx->sent) {
+		return;
+	}
+
+	rtt = MIN(k_uptime_get_32() - tx->sent, UINT16_MAX);
+	tx->sent = 0U;
+
+	/* Same smoothing as the TCP retransmission timer, RFC 6298 */
+	if (!tx->srtt) {
+		tx->srtt = rtt;
+		tx->rttvar = rtt / 2;
+	} else {
+		delta = (tx->srtt > rtt) ? tx->srtt - rtt : rtt - tx->srtt;
+		tx->rttvar = (3 * tx->rttvar + delta) / 4;
+		tx->srtt = (7 * tx->srtt + rtt) / 8;
+	}
+
+	BT_DBG("rtt %u srtt %u rttvar %u", rtt, tx->srtt, tx->rttvar);
+}
+
+/* Called when all segments of a round are out, starts the measurement */
+static int32_t seg_tx_timeout(struct seg_tx *tx)
+{
+	tx->sent = k_uptime_get_32();
+
+	if (!BT_MESH_ADDR_IS_UNICAST(tx->dst) || !tx->srtt) {
+		return SEG_RETRANSMIT_TIMEOUT(tx);
+	}
+
+	/* Never go below the minimum of the specification */
+	return MAX(200 + 50 * tx->ttl, tx->srtt + 4 * tx->rttvar);
+}
+#else
+static inline void seg_tx_rtt_init(struct seg_tx *tx, uint16_t dst) {}
+
+static inline void seg_tx_rtt_sample(struct seg_tx *tx) {}
+
+static inline int32_t seg_tx_timeout(struct seg_tx *tx)
+{
+	return SEG_RETRANSMIT_TIMEOUT(tx);
+}
+#endif
+
 static void schedule_retransmit(struct seg_tx *tx)
 {
 	if (!tx->nack_count) {
@@ -302,7 +367,7 @@ static void schedule_retransmit(struct seg_tx *tx)
 	 */
 	k_delayed_work_submit(&tx->retransmit,
 			      tx->seg_o ? K_NO_WAIT :
-					  K_MSEC(SEG_RETRANSMIT_TIMEOUT(tx)));
+					  K_MSEC(seg_tx_timeout(tx)));
 }
 
 static void seg_send_start(uint16_t duration, int err, void *user_data)
@@ -389,6 +454,9 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 	       (uint16_t)(tx->seq_auth & TRANS_SEQ_ZERO_MASK), tx->attempts);
 
 	tx->sending = 1U;
+#if defined(CONFIG_BT_MESH_TX_SEG_RETRANS_ADAPTIVE)
+	tx->sent = 0U;
+#endif
 
 	for (; tx->seg_o <= tx->seg_n; tx->seg_o++) {
 		struct net_buf *seg;
@@ -426,7 +494,7 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 end:
 	if (!tx->seg_pending) {
 		k_delayed_work_submit(&tx->retransmit,
-				      K_MSEC(SEG_RETRANSMIT_TIMEOUT(tx)));
+				      K_MSEC(seg_tx_timeout(tx)));
 	}
 
 	tx->sending = 0U;
@@ -474,6 +542,8 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 		tx->hdr = SEG_HDR(1, net_tx->aid);
 	}
 
+	seg_tx_rtt_init(tx, net_tx->ctx->addr);
+
 	tx->src = net_tx->src;
 	tx->dst = net_tx->ctx->addr;
 	tx->seg_n = (sdu->len - 1) / seg_len(!!ctl_op);
@@ -845,6 +915,7 @@ static int trans_ack(struct bt_mesh_net_rx *rx, uint8_t hdr,
 	}
 
 	k_delayed_work_cancel(&tx->retransmit);
+	seg_tx_rtt_sample(tx);
 
 	while ((bit = find_lsb_set(ack))) {
 		if (tx->seg[bit - 1]) {
@@ -966,9 +1037,8 @@ static int trans_unseg(struct net_buf_simple *buf, struct bt_mesh_net_rx *rx,
 	return sdu_recv(rx, hdr, 0, buf, &sdu, NULL);
 }
 
-static inline int32_t ack_timeout(struct seg_rx *rx)
+static inline int32_t ack_timeout_min(struct seg_rx *rx)
 {
-	int32_t to;
 	uint8_t ttl;
 
 	if (rx->ttl == BT_MESH_TTL_DEFAULT) {
@@ -980,7 +1050,14 @@ static inline int32_t ack_timeout(struct seg_rx *rx)
 	/* The acknowledgment timer shall be set to a minimum of
 	 * 150 + 50 * TTL milliseconds.
 	 */
-	to = 150 + (ttl * 50U);
+	return 150 + (ttl * 50U);
+}
+
+static inline int32_t ack_timeout(struct seg_rx *rx)
+{
+	int32_t to;
+
+	to = ack_timeout_min(rx);
 
 	/* 100 ms for every not yet received segment */
 	to += ((rx->seg_n + 1) - popcount(rx->block)) * 100U;
@@ -991,6 +1068,19 @@ static inline int32_t ack_timeout(struct seg_rx *rx)
 	return MAX(to, 400);
 }
 
+/* The last segment of a round has been received, so the sender isn't going to
+ * fill the gaps before it gets an ack. Don't wait for the missing segments.
+ */
+static void seg_ack_early(struct seg_rx *rx)
+{
+	/* Same lower bound as ack_timeout() */
+	int32_t to = MAX(ack_timeout_min(rx), 400);
+
+	if (k_delayed_work_remaining_get(&rx->ack) > to) {
+		k_delayed_work_submit(&rx->ack, K_MSEC(to));
+	}
+}
+
 int bt_mesh_ctl_send(struct bt_mesh_net_tx *tx, uint8_t ctl_op, void *data,
 		     size_t data_len,
 		     const struct bt_mesh_send_cb *cb, void *cb_data)
@@ -1427,6 +1517,11 @@ found_rx:
 	rx->block |= BIT(seg_o);
 
 	if (rx->block != BLOCK_COMPLETE(seg_n)) {
+		if (IS_ENABLED(CONFIG_BT_MESH_RX_SEG_ACK_EARLY) &&
+		    seg_o == seg_n && !bt_mesh_lpn_established()) {
+			seg_ack_early(rx);
+		}
+
 		*pdu_type = BT_MESH_FRIEND_PDU_PARTIAL;
 		return 0;
 	}
@@ -56,7 +56,7 @@ static void receive_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.alloc_list, ctx_node) {
 		ctx = CONTAINER_OF(ctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 	}
 }
 
@@ -69,7 +69,7 @@ static void receive_ff_sf_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.ff_sf_alloc_list, ctx_node) {
 		ctx = CONTAINER_OF(ctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 	}
 }
 
@@ -97,7 +97,7 @@ void receive_can_tx_isr(uint32_t err_flags, void *arg)
 	if (err_flags) {
 		LOG_ERR("Error sending FC frame (%d)", err_flags);
 		receive_report_error(ctx, ISOTP_N_ERROR);
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 	}
 }
 
@@ -207,7 +207,7 @@ static void receive_timeout_handler(struct _timeout *to)
 		break;
 	}
 
-	k_work_submit(&ctx->work);
+	k_work_submit_to_queue(&isotp_workq, &ctx->work);
 }
 
 static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
@@ -455,7 +455,7 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 		LOG_DBG("Waiting for CF but got something else (%d)",
 			frame->data[index] >> ISOTP_PCI_TYPE_POS);
 		receive_report_error(ctx, ISOTP_N_UNEXP_PDU);
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 		return;
 	}
 
@@ -466,7 +466,7 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 	if ((frame->data[index++] & ISOTP_PCI_SN_MASK) != ctx->sn_expected++) {
 		LOG_ERR("Sequence number missmatch");
 		receive_report_error(ctx, ISOTP_N_WRONG_SN);
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 		return;
 	}
 
@@ -524,7 +524,7 @@ static void receive_can_rx_isr(struct zcan_frame *frame, void *arg)
 		LOG_INF("Got a frame in a state where it is unexpected.");
 	}
 
-	k_work_submit(&ctx->work);
+	k_work_submit_to_queue(&isotp_workq, &ctx->work);
 }
 
 static inline int attach_ff_filter(struct isotp_recv_ctx *ctx)
@@ -722,7 +722,7 @@ static void send_can_tx_isr(uint32_t err_flags, void *arg)
 		ctx->state = ISOTP_TX_WAIT_FIN;
 	}
 
-	k_work_submit(&ctx->work);
+	k_work_submit_to_queue(&isotp_workq, &ctx->work);
 }
 
 static void send_timeout_handler(struct _timeout *to)
@@ -735,7 +735,7 @@ static void send_timeout_handler(struct _timeout *to)
 		LOG_ERR("Reception of next FC has timed out");
 	}
 
-	k_work_submit(&ctx->work);
+	k_work_submit_to_queue(&isotp_workq, &ctx->work);
 }
 
 static void send_process_fc(struct isotp_send_ctx *ctx,
@@ -802,7 +802,7 @@ static void send_can_rx_isr(struct zcan_frame *frame, void *arg)
 		send_report_error(ctx, ISOTP_N_UNEXP_PDU);
 	}
 
-	k_work_submit(&ctx->work);
+	k_work_submit_to_queue(&isotp_workq, &ctx->work);
 }
 
 static size_t get_ctx_data_length(struct isotp_send_ctx *ctx)
@@ -973,19 +973,30 @@ static int alloc_ctx(struct isotp_send_ctx **ctx, k_timeout_t timeout)
 #define free_send_ctx(x)
 #endif /*CONFIG_ISOTP_ENABLE_CONTEXT_BUFFERS*/
 
-static k_timeout_t stmin_to_ticks(uint8_t stmin)
+static uint32_t stmin_to_us(uint8_t stmin)
 {
 	/* According to ISO 15765-2 stmin should be 127ms if value is corrupt */
 	if (stmin > ISOTP_STMIN_MAX ||
 	    (stmin > ISOTP_STMIN_MS_MAX && stmin < ISOTP_STMIN_US_BEGIN)) {
-		return K_MSEC(ISOTP_STMIN_MS_MAX);
+		return ISOTP_STMIN_MS_MAX * USEC_PER_MSEC;
 	}
 
 	if (stmin >= ISOTP_STMIN_US_BEGIN) {
-		return K_USEC((stmin + 1 - ISOTP_STMIN_US_BEGIN) * 100U);
+		return (stmin + 1 - ISOTP_STMIN_US_BEGIN) * 100U;
 	}
 
-	return K_MSEC(stmin);
+	return stmin * USEC_PER_MSEC;
+}
+
+/*
+ * A timeout is rounded up to the next tick, which would space consecutive
+ * frames by a whole tick for the 100 us steps of STmin. Shorter separation
+ * times are waited for in place instead.
+ */
+static inline bool stmin_busy_wait(uint8_t stmin)
+{
+	return IS_ENABLED(CONFIG_ISOTP_STMIN_BUSY_WAIT) &&
+	       stmin_to_us(stmin) < k_ticks_to_us_floor32(1);
 }
 
 static void send_state_machine(struct isotp_send_ctx *ctx)
@@ -1037,9 +1048,15 @@ static void send_state_machine(struct isotp_send_ctx *ctx)
 
 	case ISOTP_TX_WAIT_ST:
 		LOG_DBG("SM wait ST");
-		z_add_timeout(&ctx->timeout, send_timeout_handler,
-			      stmin_to_ticks(ctx->opts.stmin));
 		ctx->state = ISOTP_TX_SEND_CF;
+		if (stmin_busy_wait(ctx->opts.stmin)) {
+			k_busy_wait(stmin_to_us(ctx->opts.stmin));
+			send_state_machine(ctx);
+			break;
+		}
+
+		z_add_timeout(&ctx->timeout, send_timeout_handler,
+			      K_USEC(stmin_to_us(ctx->opts.stmin)));
 		break;
 
 	case ISOTP_TX_ERR:
@@ -1137,7 +1154,7 @@ static int send(struct isotp_send_ctx *ctx, const struct device *can_dev,
 
 		LOG_DBG("Starting work to send FF");
 		ctx->state = ISOTP_TX_SEND_FF;
-		k_work_submit(&ctx->work);
+		k_work_submit_to_queue(&isotp_workq, &ctx->work);
 	} else {
 		LOG_DBG("Sending single frame");
 		ctx->filter_id = -1;
@@ -12,34 +12,49 @@
 #define NOEXCEPT noexcept
 #endif /* __cplusplus */
 
-void* operator new(size_t size)
+#if defined(CONFIG_CPP_NEW_HEAP) || defined(CONFIG_CPP_NEW_SLABS)
+extern "C" void *z_cpp_new_alloc(size_t size);
+extern "C" void z_cpp_new_free(void *ptr);
+#else
+static inline void *z_cpp_new_alloc(size_t size)
 {
 	return malloc(size);
 }
 
+static inline void z_cpp_new_free(void *ptr)
+{
+	free(ptr);
+}
+#endif
+
+void* operator new(size_t size)
+{
+	return z_cpp_new_alloc(size);
+}
+
 void* operator new[](size_t size)
 {
-	return malloc(size);
+	return z_cpp_new_alloc(size);
 }
 
 void operator delete(void* ptr) NOEXCEPT
 {
-	free(ptr);
+	z_cpp_new_free(ptr);
 }
 
 void operator delete[](void* ptr) NOEXCEPT
 {
-	free(ptr);
+	z_cpp_new_free(ptr);
 }
 
 #if (__cplusplus > 201103L)
 void operator delete(void* ptr, size_t) NOEXCEPT
 {
-	free(ptr);
+	z_cpp_new_free(ptr);
 }
 
 void operator delete[](void* ptr, size_t) NOEXCEPT
 {
-	free(ptr);
+	z_cpp_new_free(ptr);
 }
 #endif // __cplusplus > 201103L
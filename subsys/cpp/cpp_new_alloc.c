@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <stdlib.h>
+
+/* Memory of the C++ objects, for the operator new backends other than
+ * malloc(). The kernel objects are defined here, their initializers
+ * aren't valid C++.
+ */
+
+void *z_cpp_new_alloc(size_t size);
+void z_cpp_new_free(void *ptr);
+
+#ifdef CONFIG_CPP_NEW_HEAP
+K_HEAP_DEFINE(cpp_new_heap, CONFIG_CPP_NEW_HEAP_SIZE);
+#endif
+
+#ifdef CONFIG_CPP_NEW_SLABS
+/* Blocks are aligned to their size, suitably for any object fitting */
+K_MEM_SLAB_DEFINE(cpp_new_slab_16, 16, CONFIG_CPP_NEW_SLAB_BLOCKS, 16);
+K_MEM_SLAB_DEFINE(cpp_new_slab_32, 32, CONFIG_CPP_NEW_SLAB_BLOCKS, 16);
+K_MEM_SLAB_DEFINE(cpp_new_slab_64, 64, CONFIG_CPP_NEW_SLAB_BLOCKS, 16);
+
+/* Smallest size class first */
+static struct k_mem_slab *const cpp_new_slabs[] = {
+	&cpp_new_slab_16,
+	&cpp_new_slab_32,
+	&cpp_new_slab_64,
+};
+
+static struct k_mem_slab *slab_of(void *ptr)
+{
+	for (int i = 0; i < ARRAY_SIZE(cpp_new_slabs); i++) {
+		struct k_mem_slab *slab = cpp_new_slabs[i];
+		char *end = slab->buffer + slab->num_blocks * slab->block_size;
+
+		if ((char *)ptr >= slab->buffer && (char *)ptr < end) {
+			return slab;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_CPP_NEW_SLABS */
+
+void *z_cpp_new_alloc(size_t size)
+{
+#ifdef CONFIG_CPP_NEW_SLABS
+	for (int i = 0; i < ARRAY_SIZE(cpp_new_slabs); i++) {
+		void *ptr;
+
+		if (size <= cpp_new_slabs[i]->block_size &&
+		    k_mem_slab_alloc(cpp_new_slabs[i], &ptr, K_NO_WAIT) == 0) {
+			return ptr;
+		}
+	}
+#endif
+
+#ifdef CONFIG_CPP_NEW_HEAP
+	return k_heap_alloc(&cpp_new_heap, size, K_NO_WAIT);
+#else
+	return malloc(size);
+#endif
+}
+
+void z_cpp_new_free(void *ptr)
+{
+#ifdef CONFIG_CPP_NEW_SLABS
+	struct k_mem_slab *slab = slab_of(ptr);
+
+	if (slab != NULL) {
+		k_mem_slab_free(slab, &ptr);
+		return;
+	}
+#endif
+
+#ifdef CONFIG_CPP_NEW_HEAP
+	k_heap_free(&cpp_new_heap, ptr);
+#else
+	free(ptr);
+#endif
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <sys/util.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+
+#include <debug/coredump.h>
+#include "coredump_internal.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(coredump, CONFIG_KERNEL_LOG_LEVEL);
+
+/*
+ * The partition starts with a header area, followed by the coredump
+ * stream. The header is written last, once the whole stream made it to
+ * flash, so a valid header always describes a complete coredump.
+ */
+
+#define FLASH_PARTITION_ID	FLASH_AREA_ID(coredump_partition)
+
+#define CHUNK_SIZE		CONFIG_DEBUG_COREDUMP_FLASH_CHUNK_SIZE
+
+/* The header area is a chunk, so that the stream starts aligned */
+#define HDR_AREA_SIZE		CHUNK_SIZE
+
+#define FLASH_HDR_VER		1
+
+/* The stream is compressed, see compress_byte() */
+#define FLASH_HDR_FLAG_COMPRESSED	BIT(0)
+
+/* An error was encountered while dumping, the stream is not usable */
+#define FLASH_HDR_FLAG_ERROR		BIT(1)
+
+struct flash_hdr_t {
+	/* 'C', 'D' */
+	char		id[2];
+
+	/* Header version */
+	uint16_t	hdr_version;
+
+	/* FLASH_HDR_FLAG_* */
+	uint16_t	flags;
+
+	uint16_t	reserved;
+
+	/* Number of bytes of the stream following the header area */
+	uint32_t	size;
+} __packed;
+
+BUILD_ASSERT(sizeof(struct flash_hdr_t) <= HDR_AREA_SIZE,
+	     "Coredump flash chunk too small for the header");
+
+/*
+ * Runs of at least RUN_MIN identical bytes, zeroes and fill patterns
+ * for the most part, are stored as a 15-bit count and the repeated
+ * byte. Anything else is stored in literal runs of up to LITERAL_MAX
+ * bytes:
+ *
+ *   0b0nnnnnnn <n + 1 bytes>        literal run
+ *   0b1nnnnnnn nnnnnnnn <byte>      n + RUN_MIN times byte
+ */
+#define LITERAL_MAX		128U
+#define RUN_MIN			3U
+#define RUN_MAX			(0x7fffU + RUN_MIN)
+
+static const struct flash_area *flash_area;
+
+static uint8_t chunk[CHUNK_SIZE] __aligned(4);
+static size_t chunk_len;
+
+/* Offsets within the partition */
+static off_t write_off;
+static off_t erased_off;
+
+static uint8_t literal[LITERAL_MAX];
+static size_t literal_len;
+static uint8_t run_byte;
+static size_t run_len;
+
+static uint32_t stream_size;
+static uint16_t hdr_flags;
+static int flash_error;
+
+/* Erase the sectors of the partition up to the given offset */
+static int erase_until(off_t off)
+{
+	const struct device *dev = flash_area_get_device(flash_area);
+	struct flash_pages_info info;
+	int ret;
+
+	while (erased_off < off) {
+		ret = flash_get_page_info_by_offs(dev,
+						  flash_area->fa_off +
+						  erased_off, &info);
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = flash_area_erase(flash_area,
+				       info.start_offset - flash_area->fa_off,
+				       info.size);
+		if (ret != 0) {
+			return ret;
+		}
+
+		erased_off = info.start_offset + info.size -
+			     flash_area->fa_off;
+	}
+
+	return 0;
+}
+
+static void chunk_flush(void)
+{
+	if (flash_error != 0 || chunk_len == 0) {
+		return;
+	}
+
+	/* The header records the size, the padding is not used */
+	memset(&chunk[chunk_len], flash_area_erased_val(flash_area),
+	       CHUNK_SIZE - chunk_len);
+
+	if (write_off + CHUNK_SIZE > flash_area->fa_size) {
+		flash_error = -ENOSPC;
+		return;
+	}
+
+	flash_error = erase_until(write_off + CHUNK_SIZE);
+	if (flash_error == 0) {
+		flash_error = flash_area_write(flash_area, write_off, chunk,
+					       CHUNK_SIZE);
+	}
+
+	write_off += CHUNK_SIZE;
+	chunk_len = 0;
+}
+
+static void stream_out(const uint8_t *buf, size_t buflen)
+{
+	size_t len;
+
+	stream_size += buflen;
+
+	while (buflen > 0 && flash_error == 0) {
+		len = MIN(buflen, CHUNK_SIZE - chunk_len);
+		memcpy(&chunk[chunk_len], buf, len);
+		chunk_len += len;
+		buf += len;
+		buflen -= len;
+
+		if (chunk_len == CHUNK_SIZE) {
+			chunk_flush();
+		}
+	}
+}
+
+static void literal_flush(void)
+{
+	uint8_t ctrl;
+
+	if (literal_len == 0) {
+		return;
+	}
+
+	ctrl = literal_len - 1;
+	stream_out(&ctrl, 1);
+	stream_out(literal, literal_len);
+	literal_len = 0;
+}
+
+static void run_flush(void)
+{
+	uint8_t code[3];
+	uint16_t count;
+
+	if (run_len == 0) {
+		return;
+	}
+
+	count = run_len - RUN_MIN;
+	code[0] = BIT(7) | (count >> 8);
+	code[1] = count & 0xff;
+	code[2] = run_byte;
+	stream_out(code, sizeof(code));
+	run_len = 0;
+}
+
+static void compress_byte(uint8_t byte)
+{
+	if (run_len > 0) {
+		if (byte == run_byte && run_len < RUN_MAX) {
+			run_len++;
+			return;
+		}
+
+		run_flush();
+	}
+
+	literal[literal_len++] = byte;
+
+	/* The last bytes of the literal run start a run */
+	if (literal_len >= RUN_MIN &&
+	    literal[literal_len - 2] == byte &&
+	    literal[literal_len - 3] == byte) {
+		literal_len -= RUN_MIN;
+		literal_flush();
+		run_byte = byte;
+		run_len = RUN_MIN;
+	} else if (literal_len == LITERAL_MAX) {
+		literal_flush();
+	}
+}
+
+static void coredump_flash_backend_start(void)
+{
+	int ret;
+
+	chunk_len = 0;
+	write_off = HDR_AREA_SIZE;
+	erased_off = 0;
+	literal_len = 0;
+	run_len = 0;
+	stream_size = 0;
+	hdr_flags = IS_ENABLED(CONFIG_DEBUG_COREDUMP_FLASH_COMPRESS) ?
+		    FLASH_HDR_FLAG_COMPRESSED : 0;
+
+	ret = flash_area_open(FLASH_PARTITION_ID, &flash_area);
+	if (ret != 0) {
+		LOG_ERR("Cannot open coredump partition (%d)", ret);
+		flash_area = NULL;
+		flash_error = ret;
+		return;
+	}
+
+	if (CHUNK_SIZE %
+	    flash_get_write_block_size(flash_area_get_device(flash_area))) {
+		LOG_ERR("Chunk size not a multiple of the flash write block");
+		flash_error = -EINVAL;
+		return;
+	}
+
+	/* A previous coredump is invalidated before anything else */
+	flash_error = erase_until(HDR_AREA_SIZE);
+	if (flash_error != 0) {
+		LOG_ERR("Cannot erase coredump partition (%d)", flash_error);
+	}
+}
+
+static void coredump_flash_backend_end(void)
+{
+	struct flash_hdr_t hdr = {
+		.id = {'C', 'D'},
+		.hdr_version = sys_cpu_to_le16(FLASH_HDR_VER),
+	};
+
+	if (flash_area == NULL) {
+		return;
+	}
+
+	run_flush();
+	literal_flush();
+	chunk_flush();
+
+	if (flash_error != 0) {
+		LOG_ERR("Cannot write coredump to flash (%d)", flash_error);
+		flash_area_close(flash_area);
+		flash_area = NULL;
+		return;
+	}
+
+	hdr.flags = sys_cpu_to_le16(hdr_flags);
+	hdr.size = sys_cpu_to_le32(stream_size);
+
+	memset(chunk, flash_area_erased_val(flash_area), CHUNK_SIZE);
+	memcpy(chunk, &hdr, sizeof(hdr));
+
+	flash_error = flash_area_write(flash_area, 0, chunk, HDR_AREA_SIZE);
+	if (flash_error != 0) {
+		LOG_ERR("Cannot write coredump header (%d)", flash_error);
+	}
+
+	flash_area_close(flash_area);
+	flash_area = NULL;
+}
+
+static void coredump_flash_backend_error(void)
+{
+	hdr_flags |= FLASH_HDR_FLAG_ERROR;
+}
+
+static int coredump_flash_backend_buffer_output(uint8_t *buf, size_t buflen)
+{
+	size_t i;
+
+	if ((buf == NULL) || (buflen == 0)) {
+		return -EINVAL;
+	}
+
+	if (flash_area == NULL) {
+		return -ENODEV;
+	}
+
+	if (IS_ENABLED(CONFIG_DEBUG_COREDUMP_FLASH_COMPRESS)) {
+		for (i = 0; i < buflen && flash_error == 0; i++) {
+			compress_byte(buf[i]);
+		}
+	} else {
+		stream_out(buf, buflen);
+	}
+
+	return flash_error;
+}
+
+struct z_coredump_backend_api z_coredump_backend_flash_partition = {
+	.start = coredump_flash_backend_start,
+	.end = coredump_flash_backend_end,
+	.error = coredump_flash_backend_error,
+	.buffer_output = coredump_flash_backend_buffer_output,
+};
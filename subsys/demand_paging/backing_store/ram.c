@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Backing store in RAM, for testing demand paging. It saves no memory at
+ * all, the pages it holds are part of the kernel image and pinned, but it
+ * exercises the page-out and page-in paths on any target and shows how a
+ * backing store plugs in: a flash or disk one copies the scratch page to
+ * and from its medium instead.
+ *
+ * Locations are the addresses of the store pages, allocated from a memory
+ * slab. The last free page is kept for page faults, so that eviction can
+ * always make room for a page being paged in, which frees its own
+ * location once copied.
+ */
+
+#include <kernel.h>
+#include <mmu.h>
+#include <string.h>
+#include <sys/mem_manage.h>
+
+BUILD_ASSERT(CONFIG_BACKING_STORE_RAM_PAGES > 1,
+	     "at least one page besides the page fault reserve is needed");
+
+static char __aligned(CONFIG_MMU_PAGE_SIZE)
+	backing_store[CONFIG_MMU_PAGE_SIZE * CONFIG_BACKING_STORE_RAM_PAGES];
+static struct k_mem_slab backing_slabs;
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	void *slab;
+
+	ARG_UNUSED(pf);
+
+	if (!page_fault && k_mem_slab_num_free_get(&backing_slabs) <= 1U) {
+		return -ENOMEM;
+	}
+
+	if (k_mem_slab_alloc(&backing_slabs, &slab, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+
+	*location = (uintptr_t)slab;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	void *slab = (void *)location;
+
+	k_mem_slab_free(&backing_slabs, &slab);
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	(void)memcpy((void *)location, Z_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	(void)memcpy(Z_SCRATCH_PAGE, (void *)location, CONFIG_MMU_PAGE_SIZE);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	/* Called at early boot, before statically defined slabs are set up */
+	int ret = k_mem_slab_init(&backing_slabs, backing_store,
+				  CONFIG_MMU_PAGE_SIZE,
+				  CONFIG_BACKING_STORE_RAM_PAGES);
+
+	__ASSERT(ret == 0, "backing store slab init failed (%d)", ret);
+	ARG_UNUSED(ret);
+}
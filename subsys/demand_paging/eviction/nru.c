@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Not Recently Used page eviction. The accessed bits of the evictable pages
+ * are cleared periodically, pages accessed or written since then are
+ * evicted last.
+ */
+
+#include <kernel.h>
+#include <kernel_arch_interface.h>
+#include <mmu.h>
+#include <sys/mem_manage.h>
+
+/* Selection classes, lowest evicted first */
+#define NRU_CLASS(accessed, dirty) (((accessed) ? 2 : 0) | ((dirty) ? 1 : 0))
+#define NRU_CLASS_LOWEST NRU_CLASS(false, false)
+#define NRU_CLASS_NONE (NRU_CLASS(true, true) + 1)
+
+static void nru_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+	int key;
+
+	ARG_UNUSED(timer);
+
+	/* Page frames only change state with interrupts locked */
+	key = irq_lock();
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		(void)arch_page_info_get(pf->addr, NULL, true);
+	}
+	irq_unlock(key);
+}
+
+static K_TIMER_DEFINE(nru_timer, nru_periodic_update, NULL);
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	uintptr_t phys, flags;
+	struct z_page_frame *pf, *last_pf = NULL;
+	int class, last_class = NRU_CLASS_NONE;
+	bool accessed, dirty, last_dirty = false;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		accessed = (flags & ARCH_DATA_PAGE_ACCESSED) != 0U;
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0U;
+		class = NRU_CLASS(accessed, dirty);
+
+		if (class < last_class) {
+			last_pf = pf;
+			last_class = class;
+			last_dirty = dirty;
+
+			if (class == NRU_CLASS_LOWEST) {
+				/* Can't do better */
+				break;
+			}
+		}
+	}
+
+	*dirty_ptr = last_dirty;
+
+	return last_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	/* Started once the system clock is up, see nru_timer_start() */
+}
+
+static int nru_timer_start(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_timer_start(&nru_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_NRU_PERIOD));
+
+	return 0;
+}
+
+SYS_INIT(nru_timer_start, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -17,6 +17,10 @@
 #include <dfu/mcuboot.h>
 #endif
 
+#ifdef CONFIG_IMG_STREAM_HASH
+#include <tinycrypt/constants.h>
+#endif
+
 #include <devicetree.h>
 /* FLASH_AREA_ID() values used below are auto-generated by DT */
 #ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
@@ -38,6 +42,17 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 	int rc;
 
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
+#ifdef CONFIG_IMG_STREAM_HASH
+	if (rc != 0) {
+		ctx->hash_valid = false;
+	} else if (len != 0 && ctx->hash_valid) {
+		if (tc_sha256_update(&ctx->hash.sha, data,
+				     len) != TC_CRYPTO_SUCCESS) {
+			ctx->hash_valid = false;
+		}
+		ctx->hash.len += len;
+	}
+#endif
 	if (!flush) {
 		return rc;
 	}
@@ -59,13 +74,35 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 
 size_t flash_img_bytes_written(struct flash_img_context *ctx)
 {
+#ifdef CONFIG_IMG_STREAM_HASH
+	return ctx->start + stream_flash_bytes_written(&ctx->stream);
+#else
 	return stream_flash_bytes_written(&ctx->stream);
+#endif
+}
+
+static int flash_img_stream_init(struct flash_img_context *ctx, size_t start)
+{
+	const struct device *flash_dev;
+	int rc;
+
+	flash_dev = flash_area_get_device(ctx->flash_area);
+
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+			sizeof(ctx->buf), ctx->flash_area->fa_off + start,
+			ctx->flash_area->fa_size - start, NULL);
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (rc == 0) {
+		rc = stream_flash_pipeline_enable(&ctx->stream);
+	}
+#endif
+
+	return rc;
 }
 
 int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 {
 	int rc;
-	const struct device *flash_dev;
 
 	rc = flash_area_open(area_id,
 			       (const struct flash_area **)&(ctx->flash_area));
@@ -73,12 +110,103 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 		return rc;
 	}
 
-	flash_dev = flash_area_get_device(ctx->flash_area);
+#ifdef CONFIG_IMG_STREAM_HASH
+	ctx->start = 0;
+	ctx->area_id = area_id;
+	ctx->hash.len = 0;
+	ctx->hash_valid = (tc_sha256_init(&ctx->hash.sha) == TC_CRYPTO_SUCCESS);
+#endif
+
+	return flash_img_stream_init(ctx, 0);
+}
+
+#ifdef CONFIG_IMG_STREAM_HASH
+int flash_img_hash_checkpoint(struct flash_img_context *ctx,
+			      struct flash_img_hash_ckpt *ckpt)
+{
+	if (!ctx->hash_valid) {
+		return -EINVAL;
+	}
+
+	*ckpt = ctx->hash;
+
+	return 0;
+}
+
+int flash_img_init_resume(struct flash_img_context *ctx, uint8_t area_id,
+			  const struct flash_img_hash_ckpt *ckpt,
+			  size_t offset)
+{
+#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+	struct flash_pages_info page;
+#endif
+	size_t pos;
+	size_t len;
+	int rc;
+
+	if (ckpt->len > offset) {
+		return -EINVAL;
+	}
+
+	rc = flash_area_open(area_id,
+			       (const struct flash_area **)&(ctx->flash_area));
+	if (rc) {
+		return rc;
+	}
+
+	if (offset > ctx->flash_area->fa_size) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+	/* The page holding offset is erased by the next write */
+	rc = flash_get_page_info_by_offs(
+		flash_area_get_device(ctx->flash_area),
+		ctx->flash_area->fa_off + offset, &page);
+	if (rc) {
+		goto out;
+	}
+
+	if (page.start_offset != ctx->flash_area->fa_off + offset) {
+		rc = -EINVAL;
+		goto out;
+	}
+#endif
+
+	ctx->start = offset;
+	ctx->area_id = area_id;
+	ctx->hash = *ckpt;
+	ctx->hash_valid = true;
+
+	/* Hash the bytes written after the checkpoint */
+	for (pos = ckpt->len; pos < offset; pos += len) {
+		len = MIN(sizeof(ctx->buf), offset - pos);
+
+		rc = flash_area_read(ctx->flash_area, pos, ctx->buf, len);
+		if (rc) {
+			goto out;
+		}
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
-			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
-			ctx->flash_area->fa_size, NULL);
+		if (tc_sha256_update(&ctx->hash.sha, ctx->buf,
+				     len) != TC_CRYPTO_SUCCESS) {
+			rc = -ESRCH;
+			goto out;
+		}
+	}
+	ctx->hash.len = offset;
+
+	rc = flash_img_stream_init(ctx, offset);
+
+out:
+	if (rc) {
+		flash_area_close(ctx->flash_area);
+		ctx->flash_area = NULL;
+	}
+
+	return rc;
 }
+#endif /* CONFIG_IMG_STREAM_HASH */
 
 int flash_img_init(struct flash_img_context *ctx)
 {
@@ -97,6 +225,20 @@ int flash_img_check(struct flash_img_context *ctx,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_IMG_STREAM_HASH
+	if (fic->match != NULL && fic->clen != 0 && ctx->hash_valid &&
+	    ctx->area_id == area_id && ctx->hash.len == fic->clen) {
+		struct tc_sha256_state_struct sha = ctx->hash.sha;
+		uint8_t hash[TC_SHA256_DIGEST_SIZE];
+
+		if (tc_sha256_final(hash, &sha) != TC_CRYPTO_SUCCESS) {
+			return -ESRCH;
+		}
+
+		return memcmp(hash, fic->match, sizeof(hash)) ? -EILSEQ : 0;
+	}
+#endif
+
 	rc = flash_area_open(area_id,
 			     (const struct flash_area **)&(ctx->flash_area));
 	if (rc) {
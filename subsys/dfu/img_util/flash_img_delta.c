@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <sys/util.h>
+#include <dfu/flash_img.h>
+#include <storage/flash_map.h>
+
+#include <devicetree.h>
+/* FLASH_AREA_ID() values used below are auto-generated by DT */
+#ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
+#define FLASH_AREA_IMAGE_PRIMARY FLASH_AREA_ID(image_0_nonsecure)
+#else
+#define FLASH_AREA_IMAGE_PRIMARY FLASH_AREA_ID(image_0)
+#endif /* CONFIG_TRUSTED_EXECUTION_NONSECURE */
+
+enum {
+	DELTA_HEADER,
+	DELTA_RECORD,
+	DELTA_DIFF,
+	DELTA_EXTRA,
+};
+
+static void delta_advance(struct flash_img_delta_ctx *dctx)
+{
+	if (dctx->state == DELTA_DIFF && dctx->diff_left == 0) {
+		dctx->state = DELTA_EXTRA;
+	}
+
+	if (dctx->state == DELTA_EXTRA && dctx->extra_left == 0) {
+		dctx->src_off = dctx->src_next;
+		dctx->state = DELTA_RECORD;
+	}
+}
+
+static int delta_parse_header(struct flash_img_delta_ctx *dctx)
+{
+	if (sys_get_le32(&dctx->hdr[0]) != FLASH_IMG_DELTA_MAGIC) {
+		return -EINVAL;
+	}
+
+	dctx->src_size = sys_get_le32(&dctx->hdr[4]);
+	dctx->dst_size = sys_get_le32(&dctx->hdr[8]);
+
+	if (dctx->src_size > dctx->src->fa_size) {
+		return -EINVAL;
+	}
+
+	if (dctx->dst_size > dctx->img->flash_area->fa_size) {
+		return -EFBIG;
+	}
+
+	dctx->state = DELTA_RECORD;
+
+	return 0;
+}
+
+static int delta_parse_record(struct flash_img_delta_ctx *dctx)
+{
+	int64_t next;
+
+	dctx->diff_left = sys_get_le32(&dctx->hdr[0]);
+	dctx->extra_left = sys_get_le32(&dctx->hdr[4]);
+
+	/* The record must stay within both images */
+	if (dctx->diff_left > dctx->src_size - dctx->src_off ||
+	    dctx->diff_left > dctx->dst_size - dctx->dst_off ||
+	    dctx->extra_left > dctx->dst_size - dctx->dst_off -
+			       dctx->diff_left) {
+		return -EINVAL;
+	}
+
+	next = (int64_t)dctx->src_off + dctx->diff_left +
+	       (int32_t)sys_get_le32(&dctx->hdr[8]);
+	if (next < 0 || next > dctx->src_size) {
+		return -EINVAL;
+	}
+
+	dctx->src_next = next;
+	dctx->state = DELTA_DIFF;
+	delta_advance(dctx);
+
+	return 0;
+}
+
+static int delta_hdr(struct flash_img_delta_ctx *dctx, const uint8_t *data,
+		     size_t len)
+{
+	(void)memcpy(&dctx->hdr[dctx->hdr_len], data, len);
+	dctx->hdr_len += len;
+	if (dctx->hdr_len < sizeof(dctx->hdr)) {
+		return 0;
+	}
+
+	dctx->hdr_len = 0;
+	if (dctx->state == DELTA_HEADER) {
+		return delta_parse_header(dctx);
+	}
+
+	return delta_parse_record(dctx);
+}
+
+static int delta_diff(struct flash_img_delta_ctx *dctx, const uint8_t *data,
+		      size_t len)
+{
+	int rc;
+
+	rc = flash_area_read(dctx->src, dctx->src_off, dctx->buf, len);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		dctx->buf[i] += data[i];
+	}
+
+	rc = flash_img_buffered_write(dctx->img, dctx->buf, len, false);
+	if (rc) {
+		return rc;
+	}
+
+	dctx->src_off += len;
+	dctx->dst_off += len;
+	dctx->diff_left -= len;
+
+	return 0;
+}
+
+static int delta_extra(struct flash_img_delta_ctx *dctx, const uint8_t *data,
+		       size_t len)
+{
+	int rc;
+
+	rc = flash_img_buffered_write(dctx->img, data, len, false);
+	if (rc) {
+		return rc;
+	}
+
+	dctx->dst_off += len;
+	dctx->extra_left -= len;
+
+	return 0;
+}
+
+int flash_img_delta_write(struct flash_img_delta_ctx *dctx,
+			  const uint8_t *data, size_t len, bool flush)
+{
+	size_t n;
+	int rc;
+
+	while (len > 0) {
+		switch (dctx->state) {
+		case DELTA_DIFF:
+			n = MIN(MIN(len, dctx->diff_left), sizeof(dctx->buf));
+			rc = delta_diff(dctx, data, n);
+			break;
+		case DELTA_EXTRA:
+			n = MIN(len, dctx->extra_left);
+			rc = delta_extra(dctx, data, n);
+			break;
+		default:
+			n = MIN(len, sizeof(dctx->hdr) - dctx->hdr_len);
+			rc = delta_hdr(dctx, data, n);
+			break;
+		}
+
+		if (rc) {
+			return rc;
+		}
+
+		data += n;
+		len -= n;
+		delta_advance(dctx);
+	}
+
+	if (!flush) {
+		return 0;
+	}
+
+	if (dctx->state != DELTA_RECORD || dctx->hdr_len != 0 ||
+	    dctx->dst_off != dctx->dst_size) {
+		return -EINVAL;
+	}
+
+	rc = flash_img_buffered_write(dctx->img, dctx->buf, 0, true);
+
+	flash_area_close(dctx->src);
+	dctx->src = NULL;
+
+	return rc;
+}
+
+int flash_img_delta_init_id(struct flash_img_delta_ctx *dctx,
+			    struct flash_img_context *img,
+			    uint8_t src_area_id)
+{
+	int rc;
+
+	if (img->flash_area == NULL || img->flash_area->fa_id == src_area_id) {
+		return -EINVAL;
+	}
+
+	rc = flash_area_open(src_area_id, &dctx->src);
+	if (rc) {
+		return rc;
+	}
+
+	dctx->img = img;
+	dctx->hdr_len = 0;
+	dctx->state = DELTA_HEADER;
+	dctx->src_off = 0;
+	dctx->dst_off = 0;
+
+	return 0;
+}
+
+int flash_img_delta_init(struct flash_img_delta_ctx *dctx,
+			 struct flash_img_context *img)
+{
+	return flash_img_delta_init_id(dctx, img, FLASH_AREA_IMAGE_PRIMARY);
+}
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -60,7 +62,11 @@ int disk_access_init(const char *pdrv)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
+		disk_cache_detach(disk);
 		rc = disk->ops->init(disk);
+		if (rc == 0) {
+			disk_cache_attach(disk);
+		}
 	}
 
 	return rc;
@@ -87,7 +93,13 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
-		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (disk_cache_enabled(disk)) {
+			rc = disk_cache_read(disk, data_buf, start_sector,
+					     num_sector);
+		} else {
+			rc = disk->ops->read(disk, data_buf, start_sector,
+					     num_sector);
+		}
 	}
 
 	return rc;
@@ -101,7 +113,13 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
-		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (disk_cache_enabled(disk)) {
+			rc = disk_cache_write(disk, data_buf, start_sector,
+					      num_sector);
+		} else {
+			rc = disk->ops->write(disk, data_buf, start_sector,
+					      num_sector);
+		}
 	}
 
 	return rc;
@@ -114,6 +132,16 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+		/* Sectors held by the cache have to reach the driver before it
+		 * commits its own.
+		 */
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			rc = disk_cache_sync(disk);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +189,7 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+	disk_cache_detach(disk);
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistred", disk->name);
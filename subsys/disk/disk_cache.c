@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+#include <sys/util.h>
+#include <disk/disk_access.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define NUM_LINES CONFIG_DISK_CACHE_SECTORS
+#define BURST CONFIG_DISK_CACHE_BURST
+
+/* A read-ahead allocates BURST lines which must not evict each other */
+BUILD_ASSERT(BURST <= NUM_LINES / 2,
+	     "CONFIG_DISK_CACHE_BURST must be at most half of the cache");
+
+struct disk_cache_line {
+	/* Disk the sector belongs to, NULL if the line is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	uint32_t used;
+	bool dirty;
+};
+
+static struct disk_cache_line lines[NUM_LINES];
+static uint8_t __aligned(4) line_data[NUM_LINES][SECTOR_SIZE];
+
+/* Sectors read ahead or written together go through this buffer, the
+ * drivers need them to be contiguous.
+ */
+static uint8_t __aligned(4) burst_buf[BURST][SECTOR_SIZE];
+
+static uint32_t lru_clock;
+
+/* Sector following the last read, a read starting there is sequential */
+static struct disk_info *seq_disk;
+static uint32_t seq_sector;
+
+static K_MUTEX_DEFINE(cache_mutex);
+
+static struct disk_cache_line *line_find(struct disk_info *disk,
+					 uint32_t sector)
+{
+	for (int i = 0; i < NUM_LINES; i++) {
+		if (lines[i].disk == disk && lines[i].sector == sector) {
+			return &lines[i];
+		}
+	}
+
+	return NULL;
+}
+
+static inline uint8_t *line_buf(const struct disk_cache_line *line)
+{
+	return line_data[line - lines];
+}
+
+static inline void line_touch(struct disk_cache_line *line)
+{
+	line->used = ++lru_clock;
+}
+
+/* Write the dirty sectors of a disk, contiguous sectors are written by a
+ * single driver call.
+ */
+static int cache_flush(struct disk_info *disk)
+{
+	struct disk_cache_line *first;
+	struct disk_cache_line *line;
+	uint32_t cnt;
+	int rc;
+
+	for (;;) {
+		first = NULL;
+		for (int i = 0; i < NUM_LINES; i++) {
+			if (lines[i].disk == disk && lines[i].dirty &&
+			    (first == NULL || lines[i].sector < first->sector)) {
+				first = &lines[i];
+			}
+		}
+
+		if (first == NULL) {
+			return 0;
+		}
+
+		memcpy(burst_buf[0], line_buf(first), SECTOR_SIZE);
+		for (cnt = 1U; cnt < BURST; cnt++) {
+			line = line_find(disk, first->sector + cnt);
+			if (line == NULL || !line->dirty) {
+				break;
+			}
+			memcpy(burst_buf[cnt], line_buf(line), SECTOR_SIZE);
+		}
+
+		rc = disk->ops->write(disk, burst_buf[0], first->sector, cnt);
+		if (rc != 0) {
+			LOG_ERR("Failed to write back %u sectors at %u (%d)",
+				cnt, first->sector, rc);
+			return rc;
+		}
+
+		for (uint32_t i = 0U; i < cnt; i++) {
+			line_find(disk, first->sector + i)->dirty = false;
+		}
+	}
+}
+
+/* Take the least recently used line for a sector, writing back the dirty
+ * sectors of its disk first.
+ */
+static int line_alloc(struct disk_info *disk, uint32_t sector,
+		      struct disk_cache_line **out)
+{
+	struct disk_cache_line *line = &lines[0];
+	int rc;
+
+	for (int i = 0; i < NUM_LINES; i++) {
+		if (lines[i].disk == NULL) {
+			line = &lines[i];
+			break;
+		}
+		if ((int32_t)(lines[i].used - line->used) < 0) {
+			line = &lines[i];
+		}
+	}
+
+	if (line->dirty) {
+		rc = cache_flush(line->disk);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	line->disk = disk;
+	line->sector = sector;
+	line->dirty = false;
+	line_touch(line);
+	*out = line;
+
+	return 0;
+}
+
+/* Read sectors missing from the cache through the burst buffer, reading
+ * ahead up to the size of the buffer when the access is sequential.
+ */
+static int cache_fill(struct disk_info *disk, uint32_t sector, uint32_t cnt,
+		      bool sequential)
+{
+	struct disk_cache_line *fill[BURST];
+	uint32_t max = sequential ? BURST : cnt;
+	uint32_t n;
+	int rc = 0;
+
+	max = MIN(max, disk->cache_sector_count - sector);
+	for (n = 0U; n < max; n++) {
+		if (line_find(disk, sector + n) != NULL) {
+			break;
+		}
+		rc = line_alloc(disk, sector + n, &fill[n]);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+	if (rc == 0) {
+		rc = disk->ops->read(disk, burst_buf[0], sector, n);
+	}
+
+	for (uint32_t i = 0U; i < n; i++) {
+		if (rc == 0) {
+			memcpy(line_buf(fill[i]), burst_buf[i], SECTOR_SIZE);
+		} else {
+			fill[i]->disk = NULL;
+		}
+	}
+
+	return rc;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_line *line;
+	bool sequential;
+	uint32_t i = 0U;
+	uint32_t run;
+	int rc = 0;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	sequential = (disk == seq_disk && start_sector == seq_sector);
+
+	while (i < num_sector) {
+		line = line_find(disk, start_sector + i);
+		if (line != NULL) {
+			memcpy(data_buf + i * SECTOR_SIZE, line_buf(line),
+			       SECTOR_SIZE);
+			line_touch(line);
+			i++;
+			continue;
+		}
+
+		for (run = 1U; i + run < num_sector; run++) {
+			if (line_find(disk, start_sector + i + run) != NULL) {
+				break;
+			}
+		}
+
+		/* Long reads bypass the cache instead of evicting it, reads
+		 * past the end of the disk are left to the driver to reject.
+		 */
+		if (run > BURST ||
+		    start_sector + i + run > disk->cache_sector_count) {
+			rc = disk->ops->read(disk, data_buf + i * SECTOR_SIZE,
+					     start_sector + i, run);
+			if (rc != 0) {
+				break;
+			}
+			i += run;
+			continue;
+		}
+
+		rc = cache_fill(disk, start_sector + i, run, sequential);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+	if (rc == 0) {
+		seq_disk = disk;
+		seq_sector = start_sector + num_sector;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_line *line;
+	int rc = 0;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* Long writes go to the disk directly, the cached copies of the
+	 * sectors they cover are replaced and no longer dirty.
+	 */
+	if (num_sector > BURST) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		for (int i = 0; rc == 0 && i < NUM_LINES; i++) {
+			if (lines[i].disk == disk &&
+			    lines[i].sector - start_sector < num_sector) {
+				memcpy(line_buf(&lines[i]), data_buf +
+				       (lines[i].sector - start_sector) *
+				       SECTOR_SIZE, SECTOR_SIZE);
+				lines[i].dirty = false;
+			}
+		}
+		goto out;
+	}
+
+	for (uint32_t i = 0U; i < num_sector; i++) {
+		line = line_find(disk, start_sector + i);
+		if (line == NULL) {
+			rc = line_alloc(disk, start_sector + i, &line);
+			if (rc != 0) {
+				break;
+			}
+		} else {
+			line_touch(line);
+		}
+
+		memcpy(line_buf(line), data_buf + i * SECTOR_SIZE, SECTOR_SIZE);
+		line->dirty = true;
+	}
+
+out:
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	rc = cache_flush(disk);
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+void disk_cache_attach(struct disk_info *disk)
+{
+	uint32_t sector_size = 0U;
+	uint32_t sector_count = 0U;
+
+	disk->cache_sector_count = 0U;
+
+	if (disk->ops->ioctl == NULL ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+			     &sector_size) != 0 ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			     &sector_count) != 0) {
+		return;
+	}
+
+	if (sector_size != SECTOR_SIZE) {
+		LOG_INF("%s: %u byte sectors are not cached", disk->name,
+			sector_size);
+		return;
+	}
+
+	disk->cache_sector_count = sector_count;
+}
+
+void disk_cache_detach(struct disk_info *disk)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	if (disk_cache_enabled(disk)) {
+		(void)cache_flush(disk);
+		disk->cache_sector_count = 0U;
+	}
+
+	for (int i = 0; i < NUM_LINES; i++) {
+		if (lines[i].disk == disk) {
+			lines[i].disk = NULL;
+			lines[i].dirty = false;
+		}
+	}
+
+	if (seq_disk == disk) {
+		seq_disk = NULL;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+}
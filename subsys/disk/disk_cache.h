@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <disk/disk_access.h>
+
+#ifdef CONFIG_DISK_CACHE
+
+void disk_cache_attach(struct disk_info *disk);
+void disk_cache_detach(struct disk_info *disk);
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+int disk_cache_sync(struct disk_info *disk);
+
+static inline bool disk_cache_enabled(const struct disk_info *disk)
+{
+	return disk->cache_sector_count != 0U;
+}
+
+#else
+
+static inline void disk_cache_attach(struct disk_info *disk)
+{
+}
+
+static inline void disk_cache_detach(struct disk_info *disk)
+{
+}
+
+static inline int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+				  uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_write(struct disk_info *disk,
+				   const uint8_t *data_buf,
+				   uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_sync(struct disk_info *disk)
+{
+	return 0;
+}
+
+static inline bool disk_cache_enabled(const struct disk_info *disk)
+{
+	return false;
+}
+
+#endif /* CONFIG_DISK_CACHE */
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -59,10 +59,33 @@ struct char_framebuffer {
 
 	/** Invertedj*/
 	bool inverted;
+
+	/** First tile row changed since the last finalize */
+	uint16_t dirty_first;
+
+	/** Last tile row changed since the last finalize, plus one */
+	uint16_t dirty_end;
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+	/** Glyphs of the current font in the framebuffer layout, or NULL */
+	uint8_t *glyphs;
+#endif
 };
 
 static struct char_framebuffer char_fb;
 
+static inline uint16_t cfb_num_rows(const struct char_framebuffer *fb)
+{
+	return fb->y_res / fb->ppt;
+}
+
+static inline void cfb_mark_dirty(struct char_framebuffer *fb, uint16_t first,
+				  uint16_t end)
+{
+	fb->dirty_first = MIN(fb->dirty_first, first);
+	fb->dirty_end = MAX(fb->dirty_end, MIN(end, cfb_num_rows(fb)));
+}
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	if (fptr->caps & CFB_FONT_MONO_VPACKED) {
@@ -74,17 +97,97 @@ static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 	return NULL;
 }
 
+static inline bool glyph_need_reverse(const struct char_framebuffer *fb,
+				      const struct cfb_font *fptr)
+{
+	return ((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0) !=
+	       ((fptr->caps & CFB_FONT_MSB_FIRST) != 0);
+}
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+/*
+ * The cached glyphs are stored one tile row after the other, each row
+ * being the bytes of the glyph columns in the bit order of the display,
+ * so that a tile row of a character is drawn with a single copy.
+ */
+static void glyph_cache_update(struct char_framebuffer *fb)
+{
+	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
+	size_t rows = fptr->height / 8U;
+	size_t glyph_size = fptr->width * rows;
+	size_t count = fptr->last_char - fptr->first_char + 1;
+	bool need_reverse = glyph_need_reverse(fb, fptr);
+
+	k_free(fb->glyphs);
+	fb->glyphs = NULL;
+
+	if (!(fptr->caps & CFB_FONT_MONO_VPACKED) || (fptr->height % 8U)) {
+		return;
+	}
+
+	fb->glyphs = k_malloc(count * glyph_size);
+	if (!fb->glyphs) {
+		LOG_WRN("No memory to cache the glyphs");
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t *src = (const uint8_t *)fptr->data +
+				     i * glyph_size;
+		uint8_t *dst = fb->glyphs + i * glyph_size;
+
+		for (size_t g_x = 0; g_x < fptr->width; g_x++) {
+			for (size_t g_y = 0; g_y < rows; g_y++) {
+				uint8_t byte = src[g_x * rows + g_y];
+
+				if (need_reverse) {
+					byte = byte_reverse(byte);
+				}
+
+				dst[g_y * fptr->width + g_x] = byte;
+			}
+		}
+	}
+}
+
+static uint8_t draw_char_cached(struct char_framebuffer *fb,
+				const struct cfb_font *fptr, char c,
+				uint16_t x, uint16_t y)
+{
+	size_t rows = fptr->height / 8U;
+	const uint8_t *glyph = fb->glyphs +
+			       (c - fptr->first_char) * fptr->width * rows;
+	uint32_t fb_off = (y / 8U) * fb->x_res + x;
+
+	if (fb_off + (rows - 1U) * fb->x_res + fptr->width > fb->size) {
+		return 0;
+	}
+
+	for (size_t g_y = 0; g_y < rows; g_y++) {
+		memcpy(fb->buf + fb_off, glyph, fptr->width);
+		fb_off += fb->x_res;
+		glyph += fptr->width;
+	}
+
+	return fptr->width;
+}
+#else
+static inline void glyph_cache_update(struct char_framebuffer *fb)
+{
+	ARG_UNUSED(fb);
+}
+#endif /* CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE */
+
 /*
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
  */
-static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
+static uint8_t draw_char_vtmono(struct char_framebuffer *fb,
 			     char c, uint16_t x, uint16_t y)
 {
 	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
 	uint8_t *glyph_ptr;
-	bool need_reverse = (((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0)
-			     != ((fptr->caps & CFB_FONT_MSB_FIRST) != 0));
+	bool need_reverse = glyph_need_reverse(fb, fptr);
 
 	if (c < fptr->first_char || c > fptr->last_char) {
 		c = ' ';
@@ -95,6 +198,14 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		return 0;
 	}
 
+	cfb_mark_dirty(fb, y / 8U, y / 8U + fptr->height / 8U);
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE
+	if (fb->glyphs) {
+		return draw_char_cached(fb, fptr, c, x, y);
+	}
+#endif
+
 	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
 		uint32_t y_segment = y / 8U;
 
@@ -121,7 +232,7 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 
 int cfb_print(const struct device *dev, char *str, uint16_t x, uint16_t y)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr;
 
 	if (!fb->fonts || !fb->buf) {
@@ -161,7 +272,7 @@ static int cfb_invert(const struct char_framebuffer *fb)
 
 int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
 
 	if (!fb || !fb->buf) {
@@ -173,6 +284,7 @@ int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 	desc.height = fb->y_res;
 	desc.pitch = fb->x_res;
 	memset(fb->buf, 0, fb->size);
+	cfb_mark_dirty(fb, 0, cfb_num_rows(fb));
 
 	return 0;
 }
@@ -187,6 +299,7 @@ int cfb_framebuffer_invert(const struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	cfb_mark_dirty(fb, 0, cfb_num_rows(fb));
 
 	return 0;
 }
@@ -194,23 +307,51 @@ int cfb_framebuffer_invert(const struct device *dev)
 int cfb_framebuffer_finalize(const struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	uint16_t first, rows;
+	size_t row_size;
+	int err;
 
 	if (!fb || !fb->buf) {
 		return -1;
 	}
 
-	desc.buf_size = fb->size;
+	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
+		cfb_invert(fb);
+		cfb_mark_dirty(fb, 0, cfb_num_rows(fb));
+	}
+
+	/* Only the tile rows that changed are sent, the others are
+	 * unchanged on the display. A tile row is contiguous in the
+	 * framebuffer when the tiles are vertical.
+	 */
+	if (fb->screen_info & SCREEN_INFO_MONO_VTILED) {
+		if (fb->dirty_first >= fb->dirty_end) {
+			return 0;
+		}
+
+		first = fb->dirty_first;
+		rows = fb->dirty_end - fb->dirty_first;
+	} else {
+		first = 0U;
+		rows = cfb_num_rows(fb);
+	}
+
+	row_size = fb->x_res * fb->ppt / 8U;
+	desc.buf_size = rows * row_size;
 	desc.width = fb->x_res;
-	desc.height = fb->y_res;
+	desc.height = rows * fb->ppt;
 	desc.pitch = fb->x_res;
 
-	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
-		cfb_invert(fb);
+	err = api->write(dev, 0, first * fb->ppt, &desc,
+			 fb->buf + first * row_size);
+	if (err == 0) {
+		fb->dirty_first = cfb_num_rows(fb);
+		fb->dirty_end = 0U;
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+	return err;
 }
 
 int cfb_get_display_parameter(const struct device *dev,
@@ -248,6 +389,7 @@ int cfb_framebuffer_set_font(const struct device *dev, uint8_t idx)
 	}
 
 	fb->font_idx = idx;
+	glyph_cache_update(fb);
 
 	return 0;
 }
@@ -302,6 +444,8 @@ int cfb_framebuffer_init(const struct device *dev)
 	fb->font_idx = 0U;
 	fb->kerning = 0;
 	fb->inverted = false;
+	fb->dirty_first = 0U;
+	fb->dirty_end = 0U;
 
 	fb->fonts = __font_entry_start;
 	fb->font_idx = 0U;
@@ -313,6 +457,9 @@ int cfb_framebuffer_init(const struct device *dev)
 	}
 
 	memset(fb->buf, 0, fb->size);
+	cfb_mark_dirty(fb, 0, cfb_num_rows(fb));
+
+	glyph_cache_update(fb);
 
 	return 0;
 }
@@ -21,10 +21,55 @@
 K_MEM_SLAB_DEFINE(fatfs_dirp_pool, sizeof(DIR),
 			CONFIG_FS_FATFS_NUM_DIRS, 4);
 
+/* FatFs file object, the file pointer of the Zephyr file points to fil */
+struct fatfs_file {
+	FIL fil;
+#if defined(CONFIG_FS_FATFS_FASTSEEK)
+	/* Cluster link map table used in fast seek mode */
+	DWORD clmt[CONFIG_FS_FATFS_FASTSEEK_CLMT_SIZE];
+#endif
+};
+
 /* Memory pool for FatFs file objects */
-K_MEM_SLAB_DEFINE(fatfs_filep_pool, sizeof(FIL),
+K_MEM_SLAB_DEFINE(fatfs_filep_pool, sizeof(struct fatfs_file),
 			CONFIG_FS_FATFS_NUM_FILES, 4);
 
+#if defined(CONFIG_FS_FATFS_FASTSEEK)
+BUILD_ASSERT(FF_USE_FASTSEEK, "FatFs is not configured for fast seek");
+
+/* Map the cluster chain of the file, a file too fragmented for the table
+ * stays in normal mode.
+ */
+static void fast_seek_enable(FIL *fp)
+{
+	struct fatfs_file *file = CONTAINER_OF(fp, struct fatfs_file, fil);
+
+	file->clmt[0] = ARRAY_SIZE(file->clmt);
+	fp->cltbl = file->clmt;
+	if (f_lseek(fp, CREATE_LINKMAP) != FR_OK) {
+		fp->cltbl = NULL;
+	}
+}
+
+/* The map cannot follow a change of the cluster chain */
+static inline void fast_seek_disable(FIL *fp)
+{
+	fp->cltbl = NULL;
+}
+#else
+static inline void fast_seek_enable(FIL *fp)
+{
+}
+
+static inline void fast_seek_disable(FIL *fp)
+{
+}
+#endif /* CONFIG_FS_FATFS_FASTSEEK */
+
+#if defined(CONFIG_FS_FATFS_EXPAND)
+BUILD_ASSERT(FF_USE_EXPAND, "FatFs is not configured for f_expand()");
+#endif
+
 static int translate_error(int error)
 {
 	switch (error) {
@@ -89,7 +134,7 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	void *ptr;
 
 	if (k_mem_slab_alloc(&fatfs_filep_pool, &ptr, K_NO_WAIT) == 0) {
-		(void)memset(ptr, 0, sizeof(FIL));
+		(void)memset(ptr, 0, sizeof(struct fatfs_file));
 		zfp->filep = ptr;
 	} else {
 		return -ENOMEM;
@@ -102,6 +147,8 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	if (res != FR_OK) {
 		k_mem_slab_free(&fatfs_filep_pool, &ptr);
 		zfp->filep = NULL;
+	} else if ((mode & FS_O_WRITE) == 0) {
+		fast_seek_enable(zfp->filep);
 	}
 
 	return translate_error(res);
@@ -187,6 +234,11 @@ static ssize_t fatfs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 		res = f_lseek(zfp->filep, pos);
 	}
 
+	/* Writing past the end extends the cluster chain */
+	if (f_tell((FIL *)zfp->filep) + size > pos) {
+		fast_seek_disable(zfp->filep);
+	}
+
 	if (res == FR_OK) {
 		res = f_write(zfp->filep, ptr, size, &bw);
 	}
@@ -241,6 +293,8 @@ static int fatfs_truncate(struct fs_file_t *zfp, off_t length)
 #if !defined(CONFIG_FS_FATFS_READ_ONLY)
 	off_t cur_length = f_size((FIL *)zfp->filep);
 
+	fast_seek_disable(zfp->filep);
+
 	/* f_lseek expands file if new position is larger than file size */
 	res = f_lseek(zfp->filep, length);
 	if (res != FR_OK) {
@@ -285,6 +339,37 @@ static int fatfs_truncate(struct fs_file_t *zfp, off_t length)
 	return res;
 }
 
+static int fatfs_preallocate(struct fs_file_t *zfp, off_t size)
+{
+	int res = -ENOTSUP;
+
+#if defined(CONFIG_FS_FATFS_EXPAND)
+	FIL *fp = zfp->filep;
+
+	if ((size <= 0) || (f_size(fp) != 0)) {
+		return -EINVAL;
+	}
+
+	if ((zfp->flags & FS_O_WRITE) == 0) {
+		return -EACCES;
+	}
+
+	/* With the other checks done, a denial means no contiguous space */
+	res = f_expand(fp, size, 1);
+	if (res == FR_DENIED) {
+		return -ENOSPC;
+	}
+
+	if (res == FR_OK) {
+		fast_seek_enable(fp);
+	}
+
+	res = translate_error(res);
+#endif
+
+	return res;
+}
+
 static int fatfs_sync(struct fs_file_t *zfp)
 {
 	int res = -ENOTSUP;
@@ -450,6 +535,7 @@ static const struct fs_file_system_t fatfs_fs = {
 	.tell = fatfs_tell,
 	.truncate = fatfs_truncate,
 	.sync = fatfs_sync,
+	.preallocate = fatfs_preallocate,
 	.opendir = fatfs_opendir,
 	.readdir = fatfs_readdir,
 	.closedir = fatfs_closedir,
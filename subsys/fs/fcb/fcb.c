@@ -153,6 +153,7 @@ fcb_init(int f_area_id, struct fcb *fcb)
 	fcb->f_active.fe_sector = newest_sector;
 	fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
 	fcb->f_active_id = newest;
+	fcb_index_reset(fcb);
 
 	while (1) {
 		rc = fcb_getnext_in_sector(fcb, &fcb->f_active);
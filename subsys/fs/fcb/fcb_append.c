@@ -133,5 +133,12 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+	if (IS_ENABLED(CONFIG_FCB_INDEX)) {
+		k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+		fcb_index_append(fcb, loc);
+		k_mutex_unlock(&fcb->f_mtx);
+	}
+
 	return 0;
 }
@@ -45,6 +45,19 @@ fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc)
 {
 	int rc;
 
+	rc = fcb_index_getnext(fcb, loc);
+	if (rc != -EAGAIN) {
+		return rc;
+	}
+
+	return fcb_getnext_in_flash(fcb, loc);
+}
+
+int
+fcb_getnext_in_flash(struct fcb *fcb, struct fcb_entry *loc)
+{
+	int rc;
+
 	if (loc->fe_sector == NULL) {
 		/*
 		 * Find the first one we have in flash.
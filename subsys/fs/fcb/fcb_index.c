@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * The index is a ring of the valid entries, in the order fcb_getnext()
+ * serves them: by sector from the oldest one, then by offset.
+ */
+
+#define FCB_INDEX_NONE     0 /* Built by the next walk */
+#define FCB_INDEX_BUILT    1
+#define FCB_INDEX_OVERFLOW 2 /* Too small, retried after a rotation */
+
+#define FCB_INDEX_NO_HINT  0xffff
+
+static inline struct fcb_index_entry *index_at(struct fcb *fcb, uint16_t pos)
+{
+	return &fcb->f_index[(fcb->f_index_head + pos) % CONFIG_FCB_INDEX_SIZE];
+}
+
+static inline uint8_t sector_order(const struct fcb *fcb, uint8_t sector)
+{
+	int order = sector - (fcb->f_oldest - fcb->f_sectors);
+
+	return (order < 0) ? order + fcb->f_sector_cnt : order;
+}
+
+/* Compare an entry with a location in walk order */
+static int index_cmp(const struct fcb *fcb, const struct fcb_index_entry *e,
+		     uint8_t order, uint32_t elem_off)
+{
+	uint8_t e_order = sector_order(fcb, e->fi_sector);
+
+	if (e_order != order) {
+		return (e_order < order) ? -1 : 1;
+	}
+	if (e->fi_elem_off != elem_off) {
+		return (e->fi_elem_off < elem_off) ? -1 : 1;
+	}
+	return 0;
+}
+
+static void index_push(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	struct fcb_index_entry *e = index_at(fcb, fcb->f_index_cnt);
+
+	e->fi_elem_off = loc->fe_elem_off;
+	e->fi_data_len = loc->fe_data_len;
+	e->fi_sector = loc->fe_sector - fcb->f_sectors;
+	e->fi_hdr_len = loc->fe_data_off - loc->fe_elem_off;
+	fcb->f_index_cnt++;
+}
+
+static void index_build(struct fcb *fcb)
+{
+	struct fcb_entry loc = {
+		.fe_sector = NULL,
+		.fe_elem_off = 0U,
+	};
+	int rc;
+
+	fcb_index_reset(fcb);
+
+	while ((rc = fcb_getnext_in_flash(fcb, &loc)) == 0) {
+		if (fcb->f_index_cnt == CONFIG_FCB_INDEX_SIZE) {
+			fcb->f_index_state = FCB_INDEX_OVERFLOW;
+			return;
+		}
+		index_push(fcb, &loc);
+	}
+
+	/* Read errors leave the index to be built again */
+	if (rc == -ENOTSUP) {
+		fcb->f_index_state = FCB_INDEX_BUILT;
+	}
+}
+
+void fcb_index_reset(struct fcb *fcb)
+{
+	fcb->f_index_head = 0U;
+	fcb->f_index_cnt = 0U;
+	fcb->f_index_hint = FCB_INDEX_NO_HINT;
+	fcb->f_index_state = FCB_INDEX_NONE;
+}
+
+int fcb_index_getnext(struct fcb *fcb, struct fcb_entry *loc)
+{
+	struct fcb_index_entry *e;
+	uint32_t elem_off = 0U;
+	uint8_t order = 0U;
+	uint16_t lo;
+	uint16_t hi;
+
+	if (fcb->f_index_state == FCB_INDEX_NONE) {
+		index_build(fcb);
+	}
+	if (fcb->f_index_state != FCB_INDEX_BUILT) {
+		return -EAGAIN;
+	}
+
+	if (loc->fe_sector != NULL) {
+		order = sector_order(fcb, loc->fe_sector - fcb->f_sectors);
+		elem_off = loc->fe_elem_off;
+	}
+
+	/* A walk asks for the entry following the one served last */
+	if (fcb->f_index_hint < fcb->f_index_cnt &&
+	    index_cmp(fcb, index_at(fcb, fcb->f_index_hint), order,
+		      elem_off) == 0) {
+		lo = fcb->f_index_hint + 1U;
+	} else {
+		/* First entry after the location */
+		lo = 0U;
+		hi = fcb->f_index_cnt;
+		while (lo < hi) {
+			uint16_t mid = lo + (hi - lo) / 2U;
+
+			if (index_cmp(fcb, index_at(fcb, mid), order,
+				      elem_off) <= 0) {
+				lo = mid + 1U;
+			} else {
+				hi = mid;
+			}
+		}
+	}
+
+	if (lo >= fcb->f_index_cnt) {
+		return -ENOTSUP;
+	}
+
+	e = index_at(fcb, lo);
+	loc->fe_sector = &fcb->f_sectors[e->fi_sector];
+	loc->fe_elem_off = e->fi_elem_off;
+	loc->fe_data_off = e->fi_elem_off + e->fi_hdr_len;
+	loc->fe_data_len = e->fi_data_len;
+	fcb->f_index_hint = lo;
+
+	return 0;
+}
+
+void fcb_index_append(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	if (fcb->f_index_state != FCB_INDEX_BUILT) {
+		return;
+	}
+
+	if (fcb->f_index_cnt == CONFIG_FCB_INDEX_SIZE) {
+		fcb->f_index_state = FCB_INDEX_OVERFLOW;
+		return;
+	}
+
+	/* Appends finished out of order are left to the next build */
+	if (fcb->f_index_cnt != 0U &&
+	    index_cmp(fcb, index_at(fcb, fcb->f_index_cnt - 1U),
+		      sector_order(fcb, loc->fe_sector - fcb->f_sectors),
+		      loc->fe_elem_off) >= 0) {
+		fcb->f_index_state = FCB_INDEX_NONE;
+		return;
+	}
+
+	index_push(fcb, loc);
+}
+
+void fcb_index_rotate(struct fcb *fcb, const struct flash_sector *sector)
+{
+	uint8_t erased = sector - fcb->f_sectors;
+	uint16_t dropped = 0U;
+
+	if (fcb->f_index_state != FCB_INDEX_BUILT) {
+		fcb->f_index_state = FCB_INDEX_NONE;
+		return;
+	}
+
+	while (fcb->f_index_cnt != 0U &&
+	       fcb->f_index[fcb->f_index_head].fi_sector == erased) {
+		fcb->f_index_head = (fcb->f_index_head + 1U) %
+				    CONFIG_FCB_INDEX_SIZE;
+		fcb->f_index_cnt--;
+		dropped++;
+	}
+
+	if (fcb->f_index_hint != FCB_INDEX_NO_HINT) {
+		fcb->f_index_hint = (fcb->f_index_hint >= dropped) ?
+				    fcb->f_index_hint - dropped :
+				    FCB_INDEX_NO_HINT;
+	}
+}
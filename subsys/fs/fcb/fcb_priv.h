@@ -8,6 +8,8 @@
 #ifndef __FCB_PRIV_H_
 #define __FCB_PRIV_H_
 
+#include <errno.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -43,6 +45,7 @@ int fcb_getnext_in_sector(struct fcb *fcb, struct fcb_entry *loc);
 struct flash_sector *fcb_getnext_sector(struct fcb *fcb,
 					struct flash_sector *sector);
 int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
+int fcb_getnext_in_flash(struct fcb *fcb, struct fcb_entry *loc);
 
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *crc8p);
@@ -51,6 +54,32 @@ int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t i
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
 
+#ifdef CONFIG_FCB_INDEX
+void fcb_index_reset(struct fcb *fcb);
+int fcb_index_getnext(struct fcb *fcb, struct fcb_entry *loc);
+void fcb_index_append(struct fcb *fcb, const struct fcb_entry *loc);
+void fcb_index_rotate(struct fcb *fcb, const struct flash_sector *sector);
+#else
+static inline void fcb_index_reset(struct fcb *fcb)
+{
+}
+
+static inline int fcb_index_getnext(struct fcb *fcb, struct fcb_entry *loc)
+{
+	return -EAGAIN;
+}
+
+static inline void fcb_index_append(struct fcb *fcb,
+				    const struct fcb_entry *loc)
+{
+}
+
+static inline void fcb_index_rotate(struct fcb *fcb,
+				    const struct flash_sector *sector)
+{
+}
+#endif /* CONFIG_FCB_INDEX */
+
 #ifdef __cplusplus
 }
 #endif
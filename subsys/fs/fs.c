@@ -11,6 +11,7 @@
 #include <zephyr/types.h>
 #include <errno.h>
 #include <init.h>
+#include <kernel.h>
 #include <fs/fs.h>
 #include <fs/fs_sys.h>
 #include <sys/check.h>
@@ -21,12 +22,17 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(fs);
 
-/* list of mounted file systems */
+/* list of mounted file systems, by decreasing mount point length */
 static sys_dlist_t fs_mnt_list;
 
-/* lock to protect mount list operations */
+/* lock to serialize mount, unmount and registry operations */
 static struct k_mutex mutex;
 
+/* lock to protect mount list accesses, path resolution does not wait for
+ * the mount and unmount operations of the file systems
+ */
+static struct k_spinlock mnt_list_lock;
+
 /* Maps an identifier used in mount points to the file system
  * implementation.
  */
@@ -83,21 +89,20 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			    const char *name, size_t *match_len)
 {
 	struct fs_mount_t *mnt_p = NULL, *itr;
-	size_t longest_match = 0;
 	size_t len, name_len = strlen(name);
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		itr = CONTAINER_OF(node, struct fs_mount_t, node);
 		len = itr->mountp_len;
 
 		/*
-		 * Move to next node if mount point length is
-		 * shorter than longest_match match or if path
-		 * name is shorter than the mount point name.
+		 * Move to next node if path name is shorter than the
+		 * mount point name.
 		 */
-		if ((len < longest_match) || (len > name_len)) {
+		if (len > name_len) {
 			continue;
 		}
 
@@ -109,13 +114,16 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			continue;
 		}
 
-		/* Check for mount point match */
+		/*
+		 * Check for mount point match, the list being sorted the
+		 * first match is the longest one.
+		 */
 		if (strncmp(name, itr->mnt_point, len) == 0) {
 			mnt_p = itr;
-			longest_match = len;
+			break;
 		}
 	}
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (mnt_p == NULL) {
 		return -ENOENT;
@@ -231,6 +239,94 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 size_t iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->readv != NULL) {
+		rc = zfp->mp->fs->readv(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file read error (%d)", (int)rc);
+		}
+
+		return rc;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		rc = fs_read(zfp, iov[i].base, iov[i].len);
+		if (rc < 0) {
+			/* Report the bytes already read, like read() */
+			return (total != 0) ? total : rc;
+		}
+
+		total += rc;
+		if (rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  size_t iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->writev != NULL) {
+		rc = zfp->mp->fs->writev(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file write error (%d)", (int)rc);
+		}
+
+		return rc;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		rc = fs_write(zfp, iov[i].base, iov[i].len);
+		if (rc < 0) {
+			/* Report the bytes already written, like write() */
+			return (total != 0) ? total : rc;
+		}
+
+		total += rc;
+		if (rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+int fs_mmap(struct fs_file_t *zfp, off_t off, size_t len, const void **addr)
+{
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (off < 0) {
+		return -EINVAL;
+	}
+
+	/* Not an error, the caller is expected to fall back to fs_read() */
+	if (zfp->mp->fs->mmap == NULL) {
+		return -ENOTSUP;
+	}
+
+	return zfp->mp->fs->mmap(zfp, off, len, addr);
+}
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -ENOTSUP;
@@ -291,6 +387,26 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 	return rc;
 }
 
+int fs_preallocate(struct fs_file_t *zfp, off_t size)
+{
+	int rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->preallocate == NULL) {
+		return -ENOTSUP;
+	}
+
+	rc = zfp->mp->fs->preallocate(zfp, size);
+	if (rc < 0) {
+		LOG_ERR("file preallocate error (%d)", rc);
+	}
+
+	return rc;
+}
+
 int fs_sync(struct fs_file_t *zfp)
 {
 	int rc = -EINVAL;
@@ -325,12 +441,12 @@ int fs_opendir(struct fs_dir_t *zdp, const char *abs_path)
 
 	if (strcmp(abs_path, "/") == 0) {
 		/* Open VFS root dir, marked by zdp->mp == NULL */
-		k_mutex_lock(&mutex, K_FOREVER);
+		k_spinlock_key_t key = k_spin_lock(&mnt_list_lock);
 
 		zdp->mp = NULL;
 		zdp->dirp = sys_dlist_peek_head(&fs_mnt_list);
 
-		k_mutex_unlock(&mutex);
+		k_spin_unlock(&mnt_list_lock, key);
 
 		return 0;
 	}
@@ -398,8 +514,9 @@ int fs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
 	/* Find the current and next entries in the mount point dlist */
 	sys_dnode_t *node, *next = NULL;
 	bool found = false;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		if (node == zdp->dirp) {
@@ -422,7 +539,7 @@ int fs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
 		}
 	}
 
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (!found) {
 		/* Current entry must have been removed before this
@@ -621,11 +738,19 @@ int fs_statvfs(const char *abs_path, struct fs_statvfs *stat)
 	return rc;
 }
 
+static bool mnt_point_shorter(sys_dnode_t *node, void *data)
+{
+	struct fs_mount_t *itr = CONTAINER_OF(node, struct fs_mount_t, node);
+
+	return itr->mountp_len < *(size_t *)data;
+}
+
 int fs_mount(struct fs_mount_t *mp)
 {
 	struct fs_mount_t *itr;
 	const struct fs_file_system_t *fs;
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 	int rc = -EINVAL;
 	size_t len = 0;
 
@@ -686,11 +811,13 @@ int fs_mount(struct fs_mount_t *mp)
 		goto mount_err;
 	}
 
-	/* Update mount point data and append it to the list */
+	/* Update mount point data and insert it in the list */
 	mp->mountp_len = len;
 	mp->fs = fs;
 
-	sys_dlist_append(&fs_mnt_list, &mp->node);
+	key = k_spin_lock(&mnt_list_lock);
+	sys_dlist_insert_at(&fs_mnt_list, &mp->node, mnt_point_shorter, &len);
+	k_spin_unlock(&mnt_list_lock, key);
 	LOG_DBG("fs mounted at %s", log_strdup(mp->mnt_point));
 
 mount_err:
@@ -701,6 +828,7 @@ mount_err:
 
 int fs_unmount(struct fs_mount_t *mp)
 {
+	k_spinlock_key_t key;
 	int rc = -EINVAL;
 
 	if (mp == NULL) {
@@ -730,7 +858,9 @@ int fs_unmount(struct fs_mount_t *mp)
 	mp->fs = NULL;
 
 	/* remove mount node from the list */
+	key = k_spin_lock(&mnt_list_lock);
 	sys_dlist_remove(&mp->node);
+	k_spin_unlock(&mnt_list_lock, key);
 	LOG_DBG("fs unmounted from %s", log_strdup(mp->mnt_point));
 
 unmount_err:
@@ -744,10 +874,11 @@ int fs_readmount(int *index, const char **name)
 	int rc = -ENOENT;
 	int cnt = 0;
 	struct fs_mount_t *itr = NULL;
+	k_spinlock_key_t key;
 
 	*name = NULL;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		if (*index == cnt) {
@@ -758,7 +889,7 @@ int fs_readmount(int *index, const char **name)
 		++cnt;
 	}
 
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (itr != NULL) {
 		rc = 0;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <errno.h>
+#include <fs/fs.h>
+#include <fs/fs_sys.h>
+
+static K_KERNEL_STACK_DEFINE(fs_async_stack,
+			     CONFIG_FILE_SYSTEM_ASYNC_STACK_SIZE);
+static struct k_work_q fs_async_q;
+
+void z_fs_async_done(struct fs_async_req *req, ssize_t result)
+{
+	struct k_poll_signal *signal = req->signal;
+
+	/* The callback may reuse the request, take what is needed first */
+	if (req->cb != NULL) {
+		req->cb(req, result);
+	}
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, (int)result);
+	}
+}
+
+static void fs_async_work(struct k_work *work)
+{
+	struct fs_async_req *req =
+		CONTAINER_OF(work, struct fs_async_req, work);
+	ssize_t rc;
+
+	switch (req->op) {
+	case FS_ASYNC_READ:
+		rc = fs_readv(req->zfp, req->iov, req->iovcnt);
+		break;
+	case FS_ASYNC_WRITE:
+		rc = fs_writev(req->zfp, req->iov, req->iovcnt);
+		break;
+	case FS_ASYNC_SYNC:
+		rc = fs_sync(req->zfp);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	z_fs_async_done(req, rc);
+}
+
+int fs_submit_async(struct fs_async_req *req)
+{
+	const struct fs_mount_t *mp = req->zfp->mp;
+
+	if (req->op > FS_ASYNC_SYNC) {
+		return -EINVAL;
+	}
+
+	if (mp == NULL) {
+		return -EBADF;
+	}
+
+	if (mp->fs->submit_async != NULL) {
+		return mp->fs->submit_async(req);
+	}
+
+	k_work_init(&req->work, fs_async_work);
+	k_work_submit_to_queue(&fs_async_q, &req->work);
+
+	return 0;
+}
+
+static int fs_async_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&fs_async_q, fs_async_stack,
+		       K_KERNEL_STACK_SIZEOF(fs_async_stack),
+		       K_PRIO_PREEMPT(CONFIG_FILE_SYSTEM_ASYNC_PRIORITY));
+	k_thread_name_set(&fs_async_q.thread, "fs_async");
+
+	return 0;
+}
+
+SYS_INIT(fs_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -41,6 +41,33 @@ static const char default_fuse_mountpoint[] = "flash";
 
 static const char *fuse_mountpoint;
 
+#if defined(CONFIG_FUSE_FS_ACCESS_MULTITHREAD)
+/* The file systems and the file handles are not protected against
+ * concurrent host threads, the requests are handled one at a time.
+ */
+static pthread_mutex_t fuse_fs_access_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define FUSE_FS_ACCESS_LOCKED(_op, _params, _args)			\
+	static int _op##_locked _params					\
+	{								\
+		int ret;						\
+									\
+		pthread_mutex_lock(&fuse_fs_access_mutex);		\
+		ret = _op _args;					\
+		pthread_mutex_unlock(&fuse_fs_access_mutex);		\
+									\
+		return ret;						\
+	}
+#define FUSE_FS_ACCESS_OP(_op) _op##_locked
+#else
+#define FUSE_FS_ACCESS_LOCKED(_op, _params, _args)
+#define FUSE_FS_ACCESS_OP(_op) _op
+#endif /* CONFIG_FUSE_FS_ACCESS_MULTITHREAD */
+
+#define FUSE_FS_ACCESS_MOUNT_OPTS					\
+	"big_writes,max_write=" STRINGIFY(CONFIG_FUSE_FS_ACCESS_MAX_IO)	\
+	",max_read=" STRINGIFY(CONFIG_FUSE_FS_ACCESS_MAX_IO)
+
 static ssize_t get_new_file_handle(void)
 {
 	size_t idx;
@@ -252,7 +279,7 @@ static int fuse_fs_access_create(const char *path, mode_t mode,
 
 	fi->fh = handle;
 
-	err = fs_open(&files[handle], path, FS_O_CREATE | FS_O_WRITE);
+	err = fs_open(&files[handle], path, FS_O_CREATE | FS_O_RDWR);
 	if (err != 0) {
 		release_file_handle(handle);
 		fi->fh = INVALID_FILE_HANDLE;
@@ -345,7 +372,7 @@ static int fuse_fs_access_truncate(const char *path, off_t size)
 	int err;
 	static struct fs_file_t file;
 
-	err = fs_open(&file, path);
+	err = fs_open(&file, path, FS_O_WRITE);
 	if (err != 0) {
 		return err;
 	}
@@ -394,42 +421,76 @@ static int fuse_fs_access_utimens(const char *path, const struct timespec tv[2])
 	return 0;
 }
 
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_getattr,
+		      (const char *path, struct stat *stat), (path, stat))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_mkdir,
+		      (const char *path, mode_t mode), (path, mode))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_unlink, (const char *path), (path))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_rmdir, (const char *path), (path))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_truncate,
+		      (const char *path, off_t size), (path, size))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_open,
+		      (const char *path, struct fuse_file_info *fi),
+		      (path, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_read,
+		      (const char *path, char *buf, size_t size, off_t off,
+		       struct fuse_file_info *fi),
+		      (path, buf, size, off, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_write,
+		      (const char *path, const char *buf, size_t size,
+		       off_t off, struct fuse_file_info *fi),
+		      (path, buf, size, off, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_release,
+		      (const char *path, struct fuse_file_info *fi),
+		      (path, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_readdir,
+		      (const char *path, void *buf, fuse_fill_dir_t filler,
+		       off_t off, struct fuse_file_info *fi),
+		      (path, buf, filler, off, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_create,
+		      (const char *path, mode_t mode,
+		       struct fuse_file_info *fi),
+		      (path, mode, fi))
+FUSE_FS_ACCESS_LOCKED(fuse_fs_access_ftruncate,
+		      (const char *path, off_t size,
+		       struct fuse_file_info *fi),
+		      (path, size, fi))
 
 static struct fuse_operations fuse_fs_access_oper = {
-	.getattr = fuse_fs_access_getattr,
+	.getattr = FUSE_FS_ACCESS_OP(fuse_fs_access_getattr),
 	.readlink = NULL,
 	.getdir = NULL,
 	.mknod = NULL,
-	.mkdir = fuse_fs_access_mkdir,
-	.unlink = fuse_fs_access_unlink,
-	.rmdir = fuse_fs_access_rmdir,
+	.mkdir = FUSE_FS_ACCESS_OP(fuse_fs_access_mkdir),
+	.unlink = FUSE_FS_ACCESS_OP(fuse_fs_access_unlink),
+	.rmdir = FUSE_FS_ACCESS_OP(fuse_fs_access_rmdir),
 	.symlink = NULL,
 	.rename = NULL,
 	.link = NULL,
 	.chmod = NULL,
 	.chown = NULL,
-	.truncate = fuse_fs_access_truncate,
+	.truncate = FUSE_FS_ACCESS_OP(fuse_fs_access_truncate),
 	.utime = NULL,
-	.open = fuse_fs_access_open,
-	.read = fuse_fs_access_read,
-	.write = fuse_fs_access_write,
+	.open = FUSE_FS_ACCESS_OP(fuse_fs_access_open),
+	.read = FUSE_FS_ACCESS_OP(fuse_fs_access_read),
+	.write = FUSE_FS_ACCESS_OP(fuse_fs_access_write),
 	.statfs = fuse_fs_access_statfs,
 	.flush = NULL,
-	.release = fuse_fs_access_release,
+	.release = FUSE_FS_ACCESS_OP(fuse_fs_access_release),
 	.fsync = NULL,
 	.setxattr = NULL,
 	.getxattr = NULL,
 	.listxattr = NULL,
 	.removexattr = NULL,
 	.opendir  = NULL,
-	.readdir = fuse_fs_access_readdir,
+	.readdir = FUSE_FS_ACCESS_OP(fuse_fs_access_readdir),
 	.releasedir = NULL,
 	.fsyncdir = NULL,
 	.init = NULL,
 	.destroy = NULL,
 	.access = NULL,
-	.create = fuse_fs_access_create,
-	.ftruncate = fuse_fs_access_ftruncate,
+	.create = FUSE_FS_ACCESS_OP(fuse_fs_access_create),
+	.ftruncate = FUSE_FS_ACCESS_OP(fuse_fs_access_ftruncate),
 	.fgetattr = NULL,
 	.lock = NULL,
 	.utimens = fuse_fs_access_utimens,
@@ -453,7 +514,11 @@ static void *fuse_fs_access_main(void *arg)
 	char *argv[] = {
 		"",
 		"-f",
+#if !defined(CONFIG_FUSE_FS_ACCESS_MULTITHREAD)
 		"-s",
+#endif
+		"-o",
+		FUSE_FS_ACCESS_MOUNT_OPTS,
 		(char *) fuse_mountpoint
 	};
 	int argc = ARRAY_SIZE(argv);
@@ -310,6 +310,31 @@ BUILD_ASSERT((FS_SEEK_SET == LFS_SEEK_SET)
 	     && (FS_SEEK_CUR == LFS_SEEK_CUR)
 	     && (FS_SEEK_END == LFS_SEEK_END));
 
+/* The data of an inlined file is kept whole in the file cache, as long as
+ * the file stays open and inlined.
+ */
+static int littlefs_mmap(struct fs_file_t *fp, off_t off, size_t len,
+			 const void **addr)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	struct lfs_file *file = LFS_FILEP(fp);
+	int ret = 0;
+
+	fs_lock(fs);
+
+	if ((file->flags & LFS_F_INLINE) == 0) {
+		ret = -ENOTSUP;
+	} else if (off > file->ctz.size || len > file->ctz.size - off) {
+		ret = -EINVAL;
+	} else {
+		*addr = file->cache.buffer + off;
+	}
+
+	fs_unlock(fs);
+
+	return ret;
+}
+
 static int littlefs_seek(struct fs_file_t *fp, off_t off, int whence)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
@@ -737,6 +762,7 @@ static const struct fs_file_system_t littlefs_fs = {
 	.read = littlefs_read,
 	.write = littlefs_write,
 	.lseek = littlefs_seek,
+	.mmap = littlefs_mmap,
 	.tell = littlefs_tell,
 	.truncate = littlefs_truncate,
 	.sync = littlefs_sync,
@@ -752,6 +778,41 @@ static const struct fs_file_system_t littlefs_fs = {
 	.statvfs = littlefs_statvfs,
 };
 
+#define DT_DRV_COMPAT zephyr_fstab_littlefs
+#define FS_PARTITION(inst) DT_PHANDLE(DT_DRV_INST(inst), partition)
+
+#define FS_MOUNT_FLAGS(inst)						\
+	((DT_INST_PROP(inst, no_format) ? FS_MOUNT_FLAG_NO_FORMAT : 0) |	\
+	 (DT_INST_PROP(inst, read_only) ? FS_MOUNT_FLAG_READ_ONLY : 0))
+
+#define DEFINE_FS(inst)							\
+	BUILD_ASSERT(DT_INST_PROP(inst, cache_size) <=			\
+		     CONFIG_FS_LITTLEFS_FC_MEM_POOL_MAX_SIZE,		\
+		     "cache-size does not fit in the file cache pool");	\
+	FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(fs_data_##inst,		\
+					  DT_INST_PROP(inst, read_size),	\
+					  DT_INST_PROP(inst, prog_size),	\
+					  DT_INST_PROP(inst, cache_size),	\
+					  DT_INST_PROP(inst, lookahead_size)); \
+	struct fs_mount_t FS_FSTAB_ENTRY(DT_DRV_INST(inst)) = {		\
+		.type = FS_LITTLEFS,					\
+		.mnt_point = DT_INST_PROP(inst, mount_point),		\
+		.fs_data = &fs_data_##inst,				\
+		.storage_dev = (void *)					\
+			DT_FIXED_PARTITION_ID(FS_PARTITION(inst)),	\
+		.flags = FS_MOUNT_FLAGS(inst),				\
+	};
+
+DT_INST_FOREACH_STATUS_OKAY(DEFINE_FS)
+
+#define REFERENCE_AUTOMOUNT(inst)					\
+	COND_CODE_1(DT_INST_PROP(inst, automount),			\
+		    (&FS_FSTAB_ENTRY(DT_DRV_INST(inst)),), ())
+
+static struct fs_mount_t *const automounts[] = {
+	DT_INST_FOREACH_STATUS_OKAY(REFERENCE_AUTOMOUNT)
+};
+
 static int littlefs_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -759,3 +820,23 @@ static int littlefs_init(const struct device *dev)
 }
 
 SYS_INIT(littlefs_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* After the flash drivers the partitions live on */
+static int littlefs_automount(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (size_t i = 0; i < ARRAY_SIZE(automounts); i++) {
+		int rc = fs_mount(automounts[i]);
+
+		if (rc < 0) {
+			LOG_ERR("Automount %s failed: %d",
+				automounts[i]->mnt_point, rc);
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(littlefs_automount, APPLICATION,
+	 CONFIG_APPLICATION_INIT_PRIORITY);
@@ -27,6 +27,35 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (write_block_size - 1U)) & ~(write_block_size - 1U);
 }
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* lookup cache slot of an id, the id is hashed so that consecutive ids
+ * spread over the cache.
+ */
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	uint32_t hash = id;
+
+	hash ^= hash >> 8;
+	hash *= 0x88b5U;
+	hash ^= hash >> 7;
+	hash *= 0xdb2dU;
+	hash ^= hash >> 9;
+
+	return (hash & 0xFFFF) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+/* drop the cache slots pointing to a sector which is about to be erased */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t addr)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] & ADDR_SECT_MASK) ==
+		    (addr & ADDR_SECT_MASK)) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
 /* end basic routines */
 
 /* flash routines */
@@ -106,6 +135,12 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* the new ate is the most recent one of its cache slot */
+	if (!rc && (entry->id != NVS_CLOSE_ATE_ID)) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -229,6 +264,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	off_t offset;
 
 	addr &= ADDR_SECT_MASK;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, addr);
+#endif
 	rc = nvs_flash_cmp_const(fs, addr, fs->flash_parameters->erase_value,
 			fs->sector_size);
 	if (rc <= 0) {
@@ -428,6 +466,52 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 	return nvs_recover_last_ate(fs, addr);
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* fill the lookup cache by walking through all ate's from newest to oldest,
+ * each slot gets the address of the first valid ate found for it.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	addr = fs->ate_wra;
+
+	do {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+		if ((ate.id != NVS_CLOSE_ATE_ID) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    !nvs_ate_crc8_check(&ate)) {
+			*cache_entry = ate_addr;
+		}
+	} while (addr != fs->ate_wra);
+
+	return 0;
+}
+#endif
+
+/* address of the ate to start searching the latest ate of id from, returns
+ * NVS_LOOKUP_CACHE_NO_ADDR when the lookup cache knows there is none.
+ */
+static uint32_t nvs_lookup_start(struct nvs_fs *fs, uint16_t id)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (id != NVS_CLOSE_ATE_ID) {
+		return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	}
+#endif
+	return fs->ate_wra;
+}
+
 static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 {
 	*addr += (1 << ADDR_SECT_SHIFT);
@@ -468,17 +552,18 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. A sector which is not closed is erased right away, otherwise gc is
+ * prepared to walk through the ate's of the sector with nvs_gc_next().
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, struct nvs_gc_state *gc)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
+	uint32_t sec_addr, gc_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	gc->active = false;
 
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
 	nvs_sector_advance(fs, &sec_addr);
@@ -512,67 +597,119 @@ static int nvs_gc(struct nvs_fs *fs)
 		}
 	}
 
+	gc->sec_addr = sec_addr;
+	gc->addr = gc_addr;
+	gc->stop_addr = stop_addr;
+	gc->active = true;
+
+	return 0;
+}
+
+/* garbage collection step: copy the ate at gc->addr if it is the latest one
+ * of its id, erase the sector after its last ate and clear gc->active.
+ */
+static int nvs_gc_next(struct nvs_fs *fs, struct nvs_gc_state *gc)
+{
+	int rc;
+	struct nvs_ate gc_ate, wlk_ate;
+	uint32_t gc_prev_addr, wlk_addr, wlk_prev_addr, data_addr;
+
+	gc_prev_addr = gc->addr;
+	rc = nvs_prev_ate(fs, &gc->addr, &gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	if (nvs_ate_crc8_check(&gc_ate)) {
+		goto next;
+	}
+
+	wlk_addr = nvs_lookup_start(fs, gc_ate.id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
 	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
 			return rc;
 		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate.id) &&
+		    (!nvs_ate_crc8_check(&wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		/* copy needed */
+		LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+
+		data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate.offset;
 
-		if (nvs_ate_crc8_check(&gc_ate)) {
-			continue;
+		gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+		nvs_ate_crc8_update(&gc_ate);
+
+		rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
+		if (rc) {
+			return rc;
 		}
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (!nvs_ate_crc8_check(&wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
+		rc = nvs_flash_ate_wrt(fs, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+	}
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+next:
+	if (gc_prev_addr != gc->stop_addr) {
+		return 0;
+	}
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	gc->active = false;
+	return nvs_flash_erase_sector(fs, gc->sec_addr);
+}
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_gc_state gc;
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+	rc = nvs_gc_start(fs, &gc);
+	while (!rc && gc.active) {
+		rc = nvs_gc_next(fs, &gc);
+	}
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
-		}
-	} while (gc_prev_addr != stop_addr);
+	return rc;
+}
 
-	rc = nvs_flash_erase_sector(fs, sec_addr);
-	if (rc) {
-		return rc;
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* complete the garbage collection started ahead of time, writes are only
+ * done once it is finished so that the sector holds the same content as
+ * after a synchronous gc.
+ */
+static int nvs_gc_finish(struct nvs_fs *fs)
+{
+	int rc = 0;
+
+	while (!rc && fs->gc.active) {
+		rc = nvs_gc_next(fs, &fs->gc);
 	}
-	return 0;
+
+	fs->gc.active = false;
+	return rc;
 }
 
+#endif
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -585,6 +722,7 @@ static int nvs_startup(struct nvs_fs *fs)
 	uint32_t addr = 0U;
 	uint16_t i, closed_sectors = 0;
 	uint8_t erase_value = fs->flash_parameters->erase_value;
+	bool gc_restart = false;
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
@@ -702,6 +840,18 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+		gc_restart = true;
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* gc keeps the cache up to date, it has to be filled first */
+	rc = nvs_lookup_cache_rebuild(fs);
+	if (rc) {
+		goto end;
+	}
+#endif
+
+	if (gc_restart) {
 		rc = nvs_gc(fs);
 		if (rc) {
 			goto end;
@@ -723,6 +873,10 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.active = false;
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -741,6 +895,9 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	size_t write_block_size;
 
 	k_mutex_init(&fs->nvs_lock);
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.active = false;
+#endif
 
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
@@ -784,6 +941,10 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 		return rc;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.data_wra = fs->data_wra;
+#endif
+
 	/* nvs is ready for use */
 	fs->ready = true;
 
@@ -825,10 +986,10 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
@@ -879,6 +1040,13 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	rc = nvs_gc_finish(fs);
+	if (rc) {
+		goto end;
+	}
+#endif
+
 	gc_count = 0;
 	while (1) {
 		if (gc_count == fs->sector_count) {
@@ -921,6 +1089,45 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+int nvs_gc_step(struct nvs_fs *fs)
+{
+	int rc = 0;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (fs->gc.active) {
+		rc = nvs_gc_next(fs, &fs->gc);
+	} else if ((fs->ate_wra - fs->data_wra <
+		    CONFIG_NVS_GC_INCREMENTAL_THRESHOLD) &&
+		   (fs->data_wra != fs->gc.data_wra)) {
+		/* close the sector early, unless it only holds the data moved
+		 * by the previous gc, which would erase a sector per write.
+		 */
+		rc = nvs_sector_close(fs);
+		if (!rc) {
+			rc = nvs_gc_start(fs, &fs->gc);
+		}
+	}
+
+	if (rc) {
+		fs->gc.active = false;
+	} else if (fs->gc.active) {
+		rc = 1;
+	} else {
+		fs->gc.data_wra = fs->data_wra;
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -943,7 +1150,10 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return -ENOENT;
+	}
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -28,6 +28,10 @@ extern "C" {
 
 #define NVS_BLOCK_SIZE 32
 
+/* Lookup cache slot holding no entry, or id of the sector close ate */
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+#define NVS_CLOSE_ATE_ID 0xFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
@@ -206,6 +206,7 @@ int jwt_sign(struct jwt_builder *builder,
 	res = mbedtls_pk_parse_key(&ctx, der_key, der_key_len,
 				       NULL, 0);
 	if (res != 0) {
+		mbedtls_pk_free(&ctx);
 		return res;
 	}
 
@@ -223,6 +224,7 @@ int jwt_sign(struct jwt_builder *builder,
 			      hash, sizeof(hash),
 			      sig, &sig_len,
 			      NULL, NULL);
+	mbedtls_pk_free(&ctx);
 	if (res != 0) {
 		return res;
 	}
@@ -300,7 +302,7 @@ int jwt_sign(struct jwt_builder *builder,
 	base64_append_bytes(sig, sizeof(sig), builder);
 	base64_flush(builder);
 
-	return 0;
+	return builder->overflowed ? -ENOMEM : 0;
 }
 #endif
 
@@ -318,3 +320,55 @@ int jwt_init_builder(struct jwt_builder *builder,
 
 	return 0;
 }
+
+void jwt_cache_init(struct jwt_cache *cache,
+		    char *buffer,
+		    size_t buffer_size)
+{
+	cache->buf = buffer;
+	cache->size = buffer_size;
+	cache->len = 0;
+	cache->exp = 0;
+}
+
+int jwt_cache_get(struct jwt_cache *cache,
+		  int32_t now,
+		  int32_t lifetime,
+		  const char *aud,
+		  const char *der_key,
+		  size_t der_key_len)
+{
+	struct jwt_builder builder;
+	int res;
+
+	if (cache->len > 0 &&
+	    (int64_t)now + CONFIG_JWT_CACHE_MARGIN < cache->exp) {
+		return 0;
+	}
+
+	cache->len = 0;
+
+	res = jwt_init_builder(&builder, cache->buf, cache->size);
+	if (res != 0) {
+		return res;
+	}
+
+	res = jwt_add_payload(&builder, now + lifetime, now, aud);
+	if (res != 0) {
+		return res;
+	}
+
+	res = jwt_sign(&builder, der_key, der_key_len);
+	if (res != 0) {
+		return res;
+	}
+
+	if (builder.overflowed) {
+		return -ENOMEM;
+	}
+
+	cache->len = jwt_payload_len(&builder);
+	cache->exp = now + lifetime;
+
+	return 0;
+}
@@ -8,6 +8,7 @@
 #include <logging/log_core.h>
 #include <logging/log_msg.h>
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
 #include <SEGGER_RTT.h>
 
@@ -240,6 +241,10 @@ static void put(const struct log_backend *const backend,
 	uint32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_RTT_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_DICT_ENABLE)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_put(&log_output_rtt, flag, msg);
 }
 
@@ -270,6 +275,11 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_DICT_ENABLE)) {
+		log_output_dropped_dict_process(&log_output_rtt, cnt);
+		return;
+	}
+
 	log_backend_std_dropped(&log_output_rtt, cnt);
 }
 
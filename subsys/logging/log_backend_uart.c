@@ -8,17 +8,124 @@
 #include <logging/log_core.h>
 #include <logging/log_msg.h>
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
+#include <kernel.h>
 #include <device.h>
 #include <drivers/uart.h>
 #include <sys/__assert.h>
+#include <string.h>
 
 static const struct device *uart_dev;
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+#define UART_OUTPUT_BUF_SIZE 16
+
+/* Output is formatted into one buffer while the other one is transmitted. */
+static uint8_t tx_buf[2][CONFIG_LOG_BACKEND_UART_ASYNC_BUF_SIZE];
+static uint8_t fill_idx;
+static size_t fill_len;
+static bool tx_busy;
+static bool async_active;
+static struct k_spinlock tx_lock;
+static K_SEM_DEFINE(tx_sem, 0, 1);
+
+/* Set when output is dropped, messages cut this way are reported as
+ * dropped once the transmission is flowing again.
+ */
+static bool tx_truncated;
+static uint32_t truncated_cnt;
+
+static void tx_start(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_lock);
+	uint8_t *buf = tx_buf[fill_idx];
+	size_t len = fill_len;
+	int err;
+
+	if (tx_busy || len == 0U || !async_active) {
+		k_spin_unlock(&tx_lock, key);
+		return;
+	}
+
+	tx_busy = true;
+	fill_idx ^= 1U;
+	fill_len = 0U;
+	k_spin_unlock(&tx_lock, key);
+
+	err = uart_tx(uart_dev, buf, len, SYS_FOREVER_MS);
+	if (err != 0) {
+		key = k_spin_lock(&tx_lock);
+		tx_busy = false;
+		tx_truncated = true;
+		k_spin_unlock(&tx_lock, key);
+	}
+}
+
+static void uart_callback(const struct device *dev, struct uart_event *evt,
+			  void *user_data)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	if (evt->type != UART_TX_DONE && evt->type != UART_TX_ABORTED) {
+		return;
+	}
+
+	key = k_spin_lock(&tx_lock);
+	tx_busy = false;
+	k_spin_unlock(&tx_lock, key);
+
+	/* Data formatted during the transfer is sent right away. */
+	tx_start();
+	k_sem_give(&tx_sem);
+}
+
+/* Copy data to the buffer being filled. When both buffers are in use, wait
+ * for the transfer to complete. Data is dropped if it does not complete in
+ * time, e.g. when the receiver holds the flow control lines.
+ */
+static void async_out(const uint8_t *data, size_t length)
+{
+	k_timeout_t timeout = k_is_in_isr() ? K_NO_WAIT :
+		K_MSEC(CONFIG_LOG_BACKEND_UART_ASYNC_TIMEOUT_MS);
+
+	while (length > 0U) {
+		k_spinlock_key_t key = k_spin_lock(&tx_lock);
+		size_t part = MIN(length, sizeof(tx_buf[0]) - fill_len);
+
+		(void)memcpy(&tx_buf[fill_idx][fill_len], data, part);
+		fill_len += part;
+		k_spin_unlock(&tx_lock, key);
+
+		data += part;
+		length -= part;
+		tx_start();
+
+		if (part == 0U &&
+		    k_sem_take(&tx_sem, timeout) != 0) {
+			tx_truncated = true;
+			return;
+		}
+	}
+}
+#else
+#define UART_OUTPUT_BUF_SIZE 1
+#endif /* CONFIG_LOG_BACKEND_UART_ASYNC */
+
 static int char_out(uint8_t *data, size_t length, void *ctx)
 {
 	ARG_UNUSED(ctx);
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	if (async_active) {
+		async_out(data, length);
+		return length;
+	}
+#endif
+
 	for (size_t i = 0; i < length; i++) {
 		uart_poll_out(uart_dev, data[i]);
 	}
@@ -26,9 +133,12 @@ static int char_out(uint8_t *data, size_t length, void *ctx)
 	return length;
 }
 
-static uint8_t uart_output_buf;
+static uint8_t uart_output_buf[UART_OUTPUT_BUF_SIZE];
+
+LOG_OUTPUT_DEFINE(log_output_uart, char_out, uart_output_buf,
+		  sizeof(uart_output_buf));
 
-LOG_OUTPUT_DEFINE(log_output_uart, char_out, &uart_output_buf, 1);
+static void dropped(const struct log_backend *const backend, uint32_t cnt);
 
 static void put(const struct log_backend *const backend,
 		struct log_msg *msg)
@@ -36,17 +146,59 @@ static void put(const struct log_backend *const backend,
 	uint32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_UART_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_DICT_ENABLE)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	if (truncated_cnt != 0U && !tx_busy) {
+		uint32_t cnt = truncated_cnt;
+
+		truncated_cnt = 0U;
+		dropped(backend, cnt);
+	}
+#endif
+
 	log_backend_std_put(&log_output_uart, flag, msg);
+
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	if (tx_truncated) {
+		tx_truncated = false;
+		truncated_cnt++;
+	}
+#endif
 }
 
 static void log_backend_uart_init(void)
 {
 	uart_dev = device_get_binding(CONFIG_UART_CONSOLE_ON_DEV_NAME);
 	__ASSERT_NO_MSG((void *)uart_dev);
+
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	/* Fall back to polling if the driver has no asynchronous API. */
+	async_active = (uart_callback_set(uart_dev, uart_callback,
+					  NULL) == 0);
+#endif
 }
 
 static void panic(struct log_backend const *const backend)
 {
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	if (async_active) {
+		k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+		/* Completion events are not processed anymore, the ongoing
+		 * transfer is aborted and pending data is polled out.
+		 */
+		async_active = false;
+		k_spin_unlock(&tx_lock, key);
+
+		(void)uart_tx_abort(uart_dev);
+		(void)char_out(tx_buf[fill_idx], fill_len, NULL);
+		fill_len = 0U;
+	}
+#endif
+
 	log_backend_std_panic(&log_output_uart);
 }
 
@@ -54,6 +206,11 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_DICT_ENABLE)) {
+		log_output_dropped_dict_process(&log_output_uart, cnt);
+		return;
+	}
+
 	log_backend_std_dropped(&log_output_uart, cnt);
 }
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <logging/log_msg.h>
+#include <logging/log_msg2.h>
 #include "log_list.h"
 #include <logging/log.h>
 #include <logging/log_backend.h>
@@ -182,22 +183,11 @@ static void detect_missed_strdup(struct log_msg *msg)
 #undef ERR_MSG
 }
 
-static inline void msg_finalize(struct log_msg *msg,
-				struct log_msg_ids src_level)
+/* Called once a new message is buffered, wakes up the processing. */
+static void msg_trigger(void)
 {
 	unsigned int key;
 
-	msg->hdr.ids = src_level;
-	msg->hdr.timestamp = timestamp_func();
-
-	atomic_inc(&buffered_cnt);
-
-	key = irq_lock();
-
-	log_list_add_tail(&list, msg);
-
-	irq_unlock(key);
-
 	if (panic_mode) {
 		key = irq_lock();
 		(void)log_process(false);
@@ -215,10 +205,99 @@ static inline void msg_finalize(struct log_msg *msg,
 	}
 }
 
+static inline void msg_finalize(struct log_msg *msg,
+				struct log_msg_ids src_level)
+{
+	unsigned int key;
+
+	msg->hdr.ids = src_level;
+	msg->hdr.timestamp = timestamp_func();
+
+	atomic_inc(&buffered_cnt);
+
+	key = irq_lock();
+
+	log_list_add_tail(&list, msg);
+
+	irq_unlock(key);
+
+	msg_trigger();
+}
+
+/* Select the string arguments copied into a packed message: the ones
+ * which may be transient according to str_mask and which are not in read
+ * only memory.
+ */
+static uint32_t msg2_copy_mask(const char *str, const log_arg_t *args,
+			       uint32_t nargs, uint32_t str_mask)
+{
+	uint32_t mask;
+	uint32_t copy_mask = 0U;
+
+	if (str_mask == 0U || nargs == 0U) {
+		return 0U;
+	}
+
+	mask = z_log_get_s_mask(str, nargs) & str_mask;
+	while (mask) {
+		uint32_t idx = 31 - __builtin_clz(mask);
+		const char *arg = (const char *)args[idx];
+
+		if (arg != NULL && !is_rodata(arg)) {
+			copy_mask |= BIT(idx);
+		}
+
+		mask &= ~BIT(idx);
+	}
+
+	return copy_mask;
+}
+
+/* Pack the message in the log buffer, without locking interrupts. */
+static void msg2_std_put(const char *str, const log_arg_t *args,
+			 uint32_t nargs, uint32_t str_mask,
+			 struct log_msg_ids src_level)
+{
+	uint32_t copy_mask = msg2_copy_mask(str, args, nargs, str_mask);
+
+	atomic_inc(&buffered_cnt);
+
+	if (z_log_msg2_std_put(src_level, timestamp_func(), str, args,
+			       nargs, copy_mask) != 0) {
+		atomic_dec(&buffered_cnt);
+		log_dropped();
+		return;
+	}
+
+	msg_trigger();
+}
+
+static void msg2_hexdump_put(const char *str, const uint8_t *data,
+			     uint32_t length, struct log_msg_ids src_level)
+{
+	/* Only metadata coming from user mode is transient, see msg_free() */
+	bool copy_str = IS_ENABLED(CONFIG_USERSPACE) && (str != NULL) &&
+			(src_level.level != LOG_LEVEL_INTERNAL_RAW_STRING) &&
+			!is_rodata(str);
+
+	atomic_inc(&buffered_cnt);
+
+	if (z_log_msg2_hexdump_put(src_level, timestamp_func(), str, data,
+				   length, copy_str) != 0) {
+		atomic_dec(&buffered_cnt);
+		log_dropped();
+		return;
+	}
+
+	msg_trigger();
+}
+
 void log_0(const char *str, struct log_msg_ids src_level)
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_0(str, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_std_put(str, NULL, 0, 0U, src_level);
 	} else {
 		struct log_msg *msg = log_msg_create_0(str);
 
@@ -235,6 +314,11 @@ void log_1(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_1(str, arg0, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		log_arg_t args[] = { arg0 };
+
+		msg2_std_put(str, args, ARRAY_SIZE(args), UINT32_MAX,
+			     src_level);
 	} else {
 		struct log_msg *msg = log_msg_create_1(str, arg0);
 
@@ -252,6 +336,11 @@ void log_2(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_2(str, arg0, arg1, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		log_arg_t args[] = { arg0, arg1 };
+
+		msg2_std_put(str, args, ARRAY_SIZE(args), UINT32_MAX,
+			     src_level);
 	} else {
 		struct log_msg *msg = log_msg_create_2(str, arg0, arg1);
 
@@ -271,6 +360,11 @@ void log_3(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_3(str, arg0, arg1, arg2, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		log_arg_t args[] = { arg0, arg1, arg2 };
+
+		msg2_std_put(str, args, ARRAY_SIZE(args), UINT32_MAX,
+			     src_level);
 	} else {
 		struct log_msg *msg = log_msg_create_3(str, arg0, arg1, arg2);
 
@@ -289,6 +383,8 @@ void log_n(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_n(str, args, narg, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_std_put(str, args, narg, UINT32_MAX, src_level);
 	} else {
 		struct log_msg *msg = log_msg_create_n(str, args, narg);
 
@@ -300,12 +396,21 @@ void log_n(const char *str,
 	}
 }
 
+void z_log2_n(const char *str, uint32_t str_mask, log_arg_t *args,
+	      uint32_t narg, struct log_msg_ids src_level)
+{
+	msg2_std_put(str, args, narg, str_mask, src_level);
+}
+
 void log_hexdump(const char *str, const void *data, uint32_t length,
 		 struct log_msg_ids src_level)
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_hexdump(str, (const uint8_t *)data, length,
 				     src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_hexdump_put(str, (const uint8_t *)data, length,
+				 src_level);
 	} else {
 		struct log_msg *msg =
 			log_msg_hexdump_create(str, (const uint8_t *)data, length);
@@ -347,6 +452,12 @@ void log_printk(const char *fmt, va_list ap)
 			length = vsnprintk(str, sizeof(str), fmt, ap);
 			length = MIN(length, sizeof(str));
 
+			if (IS_ENABLED(CONFIG_LOG2)) {
+				msg2_hexdump_put(NULL, str, length,
+						 src_level_union.structure);
+				return;
+			}
+
 			msg = log_msg_hexdump_create(NULL, str, length);
 			if (msg == NULL) {
 				return;
@@ -484,9 +595,13 @@ void log_core_init(void)
 		log_msg_pool_init();
 		log_list_init(&list);
 
-		k_mem_slab_init(&log_strdup_pool, log_strdup_pool_buf,
+		if (IS_ENABLED(CONFIG_LOG2)) {
+			z_log_msg2_init();
+		} else {
+			k_mem_slab_init(&log_strdup_pool, log_strdup_pool_buf,
 					sizeof(struct log_strdup_buf),
 					CONFIG_LOG_STRDUP_BUF_COUNT);
+		}
 	}
 
 	/* Set default timestamp. */
@@ -517,6 +632,7 @@ void log_core_init(void)
 			LOG_FILTER_SLOT_SET(filters,
 					    LOG_FILTER_AGGR_SLOT_IDX,
 					    level);
+			*log_dynamic_level_get(i) = level;
 		}
 	}
 }
@@ -684,10 +800,15 @@ bool z_impl_log_process(bool bypass)
 	if (!backend_attached && !bypass) {
 		return false;
 	}
-	unsigned int key = irq_lock();
 
-	msg = log_list_head_get(&list);
-	irq_unlock(key);
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		msg = z_log_msg2_get();
+	} else {
+		unsigned int key = irq_lock();
+
+		msg = log_list_head_get(&list);
+		irq_unlock(key);
+	}
 
 	if (msg != NULL) {
 		atomic_dec(&buffered_cnt);
@@ -698,6 +819,10 @@ bool z_impl_log_process(bool bypass)
 		dropped_notify();
 	}
 
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		return z_log_msg2_pending();
+	}
+
 	return (log_list_head_peek(&list) != NULL);
 }
 
@@ -798,6 +923,7 @@ uint32_t z_impl_log_filter_set(struct log_backend const *const backend,
 			LOG_FILTER_SLOT_SET(filters,
 					    LOG_FILTER_AGGR_SLOT_IDX,
 					    new_aggr_filter);
+			*log_dynamic_level_get(src_id) = new_aggr_filter;
 		}
 	}
 
@@ -886,7 +1012,8 @@ char *log_strdup(const char *str)
 	struct log_strdup_buf *dup;
 	int err;
 
-	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) ||
+	/* Packed messages copy transient strings themselves. */
+	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) || IS_ENABLED(CONFIG_LOG2) ||
 	    is_rodata(str) || _is_user_context()) {
 		return (char *)str;
 	}
@@ -933,12 +1060,21 @@ uint32_t log_get_strdup_longest_string(void)
 
 bool log_is_strdup(const void *buf)
 {
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		return z_log_msg2_is_str(buf);
+	}
+
 	return PART_OF_ARRAY(log_strdup_pool_buf, (uint8_t *)buf);
 
 }
 
 void log_free(void *str)
 {
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		z_log_msg2_str_free(str);
+		return;
+	}
+
 	struct log_strdup_buf *dup = CONTAINER_OF(str, struct log_strdup_buf,
 						  buf);
 
@@ -985,8 +1121,7 @@ void z_vrfy_z_log_string_from_user(uint32_t src_level_val, const char *str)
 
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) &&
 	    (level != LOG_LEVEL_INTERNAL_RAW_STRING) &&
-	    (level > LOG_FILTER_SLOT_GET(log_dynamic_filters_get(source_id),
-					LOG_FILTER_AGGR_SLOT_IDX))) {
+	    (level > *log_dynamic_level_get(source_id))) {
 		/* Skip filtered out messages. */
 		return;
 	}
@@ -1009,6 +1144,12 @@ void z_vrfy_z_log_string_from_user(uint32_t src_level_val, const char *str)
 		   (level == LOG_LEVEL_INTERNAL_RAW_STRING)) {
 		struct log_msg *msg;
 
+		if (IS_ENABLED(CONFIG_LOG2)) {
+			msg2_hexdump_put(NULL, str, len,
+					 src_level_union.structure);
+			return;
+		}
+
 		msg = log_msg_hexdump_create(NULL, str, len);
 		if (msg != NULL) {
 			msg_finalize(msg, src_level_union.structure);
@@ -1080,9 +1221,8 @@ void z_vrfy_z_log_hexdump_from_user(uint32_t src_level_val, const char *metadata
 		"Invalid log source id"));
 
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) &&
-	    (src_level_union.structure.level > LOG_FILTER_SLOT_GET(
-	     log_dynamic_filters_get(src_level_union.structure.source_id),
-	     LOG_FILTER_AGGR_SLOT_IDX))) {
+	    (src_level_union.structure.level > *log_dynamic_level_get(
+	     src_level_union.structure.source_id))) {
 		/* Skip filtered out messages. */
 		return;
 	}
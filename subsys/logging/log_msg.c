@@ -37,12 +37,21 @@ BUILD_ASSERT((sizeof(union log_msg_head_data) ==
 #define CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS 0
 #endif
 
+/* With packed messages, the log buffer holds the pending messages and the
+ * pool only the ones unpacked for the backends.
+ */
+#if defined(CONFIG_LOG2)
+#define MSG_POOL_SIZE CONFIG_LOG2_MSG_POOL_SIZE
+#else
+#define MSG_POOL_SIZE CONFIG_LOG_BUFFER_SIZE
+#endif
+
 #define MSG_SIZE sizeof(union log_msg_chunk)
-#define NUM_OF_MSGS (CONFIG_LOG_BUFFER_SIZE / MSG_SIZE)
+#define NUM_OF_MSGS (MSG_POOL_SIZE / MSG_SIZE)
 
 struct k_mem_slab log_msg_pool;
 static uint8_t __noinit __aligned(sizeof(void *))
-		log_msg_pool_buf[CONFIG_LOG_BUFFER_SIZE];
+		log_msg_pool_buf[MSG_POOL_SIZE];
 
 void log_msg_pool_init(void)
 {
@@ -165,7 +174,10 @@ union log_msg_chunk *log_msg_no_space_handle(void)
 	bool more;
 	int err;
 
-	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
+	/* Unpacked messages are only allocated while processing, the oldest
+	 * ones cannot be discarded from there.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) && !IS_ENABLED(CONFIG_LOG2)) {
 		do {
 			more = log_process(true);
 			log_dropped();
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <kernel.h>
+#include <logging/log_msg2.h>
+#include <sys/mpsc_pbuf.h>
+#include <sys/__assert.h>
+#include <string.h>
+#include <errno.h>
+
+BUILD_ASSERT((CONFIG_LOG_BUFFER_SIZE & (CONFIG_LOG_BUFFER_SIZE - 1)) == 0,
+	     "CONFIG_LOG_BUFFER_SIZE must be a power of 2");
+
+#define MSG2_WLEN(len) \
+	((sizeof(struct log_msg2_desc) + (len) + sizeof(uint32_t) - 1) / \
+	 sizeof(uint32_t))
+
+/* Copied strings are preceded by their offset in the packet, so that the
+ * packet can be found when the string is freed.
+ */
+#define MSG2_STR_HDR_LEN sizeof(uint32_t)
+
+static uint32_t __noinit log_msg2_buf[CONFIG_LOG_BUFFER_SIZE /
+				      sizeof(uint32_t)];
+static struct mpsc_pbuf_buffer log_msg2_pbuf;
+
+/* Set while a message is being unpacked, log_process() can be reentered
+ * from the panic path.
+ */
+static atomic_t consumer_busy;
+
+void z_log_msg2_init(void)
+{
+	mpsc_pbuf_init(&log_msg2_pbuf, log_msg2_buf, ARRAY_SIZE(log_msg2_buf));
+	atomic_clear(&consumer_busy);
+}
+
+static size_t str_copy_len(const char *str)
+{
+	return strnlen(str, CONFIG_LOG_STRDUP_MAX_STRING) + 1;
+}
+
+/* Copy a string at the given offset of the packet, truncated strings end
+ * with '~' like the ones duplicated by log_strdup() used to.
+ */
+static const char *str_copy(uint32_t *packet, size_t offset, const char *str)
+{
+	uint32_t str_offset = offset + MSG2_STR_HDR_LEN;
+	char *dst = (char *)packet + str_offset;
+	size_t len = str_copy_len(str) - 1;
+
+	(void)memcpy((uint8_t *)packet + offset, &str_offset,
+		     sizeof(str_offset));
+	(void)memcpy(dst, str, len);
+	if (len != 0U && str[len] != '\0') {
+		dst[len - 1] = '~';
+	}
+	dst[len] = '\0';
+
+	return dst;
+}
+
+static uint32_t *msg2_alloc(const struct log_msg2_desc *desc,
+			    const void *payload, size_t payload_len,
+			    size_t len, uint32_t *wlen)
+{
+	uint32_t *packet;
+
+	*wlen = MSG2_WLEN(len);
+	packet = mpsc_pbuf_alloc(&log_msg2_pbuf, *wlen);
+	if (packet == NULL) {
+		return NULL;
+	}
+
+	(void)memcpy(packet, desc, sizeof(*desc));
+	if (payload_len != 0U) {
+		(void)memcpy((uint8_t *)packet + sizeof(*desc), payload,
+			     payload_len);
+	}
+
+	return packet;
+}
+
+int z_log_msg2_std_put(struct log_msg_ids ids, uint32_t timestamp,
+		       const char *str, const log_arg_t *args, uint32_t nargs,
+		       uint32_t copy_mask)
+{
+	struct log_msg2_desc desc = {
+		.timestamp = timestamp,
+		.ids = ids,
+		.str = str,
+	};
+	size_t args_len = nargs * sizeof(log_arg_t);
+	size_t len = args_len;
+	uint32_t *packet;
+	uint32_t wlen;
+	uint32_t mask;
+
+	__ASSERT_NO_MSG(nargs < LOG_MAX_NARGS);
+
+	desc.params.std.type = LOG_MSG_TYPE_STD;
+	desc.params.std.nargs = nargs;
+
+	for (mask = copy_mask; mask != 0U; mask &= mask - 1U) {
+		uint32_t idx = __builtin_ctz(mask);
+
+		len += MSG2_STR_HDR_LEN + str_copy_len((const char *)args[idx]);
+		desc.strings++;
+	}
+
+	packet = msg2_alloc(&desc, args, args_len, len, &wlen);
+	if (packet == NULL) {
+		return -ENOMEM;
+	}
+
+	len = sizeof(desc) + args_len;
+	for (mask = copy_mask; mask != 0U; mask &= mask - 1U) {
+		uint32_t idx = __builtin_ctz(mask);
+		const char *src = (const char *)args[idx];
+		log_arg_t arg = (log_arg_t)str_copy(packet, len, src);
+
+		(void)memcpy((uint8_t *)packet + sizeof(desc) +
+			     idx * sizeof(log_arg_t), &arg, sizeof(arg));
+		len += MSG2_STR_HDR_LEN + str_copy_len(src);
+	}
+
+	mpsc_pbuf_commit(&log_msg2_pbuf, packet, wlen);
+
+	return 0;
+}
+
+int z_log_msg2_hexdump_put(struct log_msg_ids ids, uint32_t timestamp,
+			   const char *str, const uint8_t *data,
+			   uint32_t length, bool copy_str)
+{
+	struct log_msg2_desc desc = {
+		.timestamp = timestamp,
+		.ids = ids,
+		.str = str,
+		.strings = copy_str ? 1U : 0U,
+	};
+	size_t len;
+	uint32_t *packet;
+	uint32_t wlen;
+
+	length = MIN(length, LOG_MSG_HEXDUMP_MAX_LENGTH);
+
+	desc.params.hexdump.type = LOG_MSG_TYPE_HEXDUMP;
+	desc.params.hexdump.length = length;
+
+	len = length + (copy_str ? MSG2_STR_HDR_LEN + str_copy_len(str) : 0U);
+	packet = msg2_alloc(&desc, data, length, len, &wlen);
+	if (packet == NULL) {
+		return -ENOMEM;
+	}
+
+	if (copy_str) {
+		desc.str = str_copy(packet, sizeof(desc) + length, str);
+		(void)memcpy(packet, &desc, sizeof(desc));
+	}
+
+	mpsc_pbuf_commit(&log_msg2_pbuf, packet, wlen);
+
+	return 0;
+}
+
+static struct log_msg *msg2_unpack(const uint32_t *packet,
+				   const struct log_msg2_desc *desc)
+{
+	const uint8_t *payload = (const uint8_t *)packet +
+				 sizeof(struct log_msg2_desc);
+	struct log_msg *msg;
+
+	if (desc->params.generic.type == LOG_MSG_TYPE_HEXDUMP) {
+		msg = log_msg_hexdump_create(desc->str, payload,
+					     desc->params.hexdump.length);
+	} else {
+		log_arg_t args[LOG_MAX_NARGS];
+		uint32_t nargs = desc->params.std.nargs;
+
+		(void)memcpy(args, payload, nargs * sizeof(log_arg_t));
+		msg = log_msg_create_n(desc->str, args, nargs);
+	}
+
+	if (msg != NULL) {
+		msg->hdr.ids = desc->ids;
+		msg->hdr.timestamp = desc->timestamp;
+	}
+
+	return msg;
+}
+
+struct log_msg *z_log_msg2_get(void)
+{
+	struct log_msg *msg = NULL;
+	struct log_msg2_desc desc;
+	uint32_t *packet;
+	uint32_t wlen;
+
+	if (!atomic_cas(&consumer_busy, 0, 1)) {
+		return NULL;
+	}
+
+	packet = mpsc_pbuf_claim(&log_msg2_pbuf, &wlen);
+	if (packet != NULL) {
+		(void)memcpy(&desc, packet, sizeof(desc));
+
+		/* A message which cannot be unpacked is dropped, the
+		 * allocator already counted it. A message holding string
+		 * copies stays in the buffer until the unpacked message
+		 * releases them.
+		 */
+		msg = msg2_unpack(packet, &desc);
+		if (msg == NULL || desc.strings == 0U) {
+			mpsc_pbuf_free(&log_msg2_pbuf, packet);
+		} else {
+			(void)atomic_set((atomic_t *)packet, desc.strings);
+		}
+	}
+
+	atomic_clear(&consumer_busy);
+
+	return msg;
+}
+
+bool z_log_msg2_pending(void)
+{
+	uint32_t wlen;
+	bool pending;
+
+	if (!atomic_cas(&consumer_busy, 0, 1)) {
+		return true;
+	}
+
+	/* Only committed messages count, a message interrupted in the middle
+	 * of its packing would otherwise keep the panic flush looping.
+	 */
+	pending = (mpsc_pbuf_peek(&log_msg2_pbuf, &wlen) != NULL);
+
+	atomic_clear(&consumer_busy);
+
+	return pending;
+}
+
+bool z_log_msg2_is_str(const void *buf)
+{
+	return PART_OF_ARRAY(log_msg2_buf, (const uint32_t *)buf);
+}
+
+void z_log_msg2_str_free(const void *buf)
+{
+	uint32_t offset;
+	uint32_t *packet;
+
+	(void)memcpy(&offset, (const uint8_t *)buf - MSG2_STR_HDR_LEN,
+		     sizeof(offset));
+	packet = (uint32_t *)((uint8_t *)buf - offset);
+
+	if (atomic_dec((atomic_t *)packet) == 1) {
+		mpsc_pbuf_free(&log_msg2_pbuf, packet);
+	}
+}
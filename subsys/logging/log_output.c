@@ -5,6 +5,7 @@
  */
 
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
 #include <sys/__assert.h>
@@ -538,6 +539,12 @@ void log_output_msg_process(const struct log_output *log_output,
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY) &&
+	    flags & LOG_OUTPUT_FLAG_FORMAT_DICT) {
+		log_output_msg_dict_process(log_output, msg, flags);
+		return;
+	}
+
 	prefix_offset = raw_string ?
 			0 : prefix_print(log_output, flags, std_msg, timestamp,
 					 level, domain_id, source_id);
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output_dict.h>
+#include <sys/__assert.h>
+#include <string.h>
+
+#define HEXDUMP_CHUNK_LEN 16
+
+static void dict_out(const struct log_output *log_output,
+		     const void *data, size_t len)
+{
+	const uint8_t *ptr = data;
+
+	while (len > 0) {
+		size_t part = MIN(len, log_output->size -
+				       log_output->control_block->offset);
+
+		(void)memcpy(&log_output->buf[log_output->control_block->offset],
+			     ptr, part);
+		log_output->control_block->offset += part;
+		ptr += part;
+		len -= part;
+
+		if (log_output->control_block->offset == log_output->size) {
+			log_output_flush(log_output);
+		}
+	}
+}
+
+static void hdr_out(const struct log_output *log_output, uint8_t type,
+		    struct log_msg *msg, uint16_t length)
+{
+	struct log_dict_msg_hdr hdr = {
+		.type = type,
+		.level = log_msg_level_get(msg) |
+			 (log_msg_domain_id_get(msg) << 3),
+		.source_id = log_msg_source_id_get(msg),
+		.timestamp = log_msg_timestamp_get(msg),
+		.length = length,
+		.fmt = (uintptr_t)log_msg_str_get(msg),
+	};
+
+	dict_out(log_output, &hdr, sizeof(hdr));
+}
+
+static void std_out(const struct log_output *log_output, struct log_msg *msg)
+{
+	uint32_t nargs = log_msg_nargs_get(msg);
+	uint32_t mask;
+	uint32_t i;
+
+	hdr_out(log_output, LOG_DICT_MSG_STD, msg, nargs);
+
+	for (i = 0; i < nargs; i++) {
+		log_arg_t arg = log_msg_arg_get(msg, i);
+
+		dict_out(log_output, &arg, sizeof(arg));
+	}
+
+	/* String arguments may be transient, their value is sent. */
+	mask = z_log_get_s_mask(log_msg_str_get(msg), nargs);
+	for (i = 0; i < nargs; i++) {
+		const char *str;
+
+		if (!(mask & BIT(i))) {
+			continue;
+		}
+
+		str = (const char *)log_msg_arg_get(msg, i);
+		if (str == NULL) {
+			str = "(null)";
+		}
+
+		dict_out(log_output, str, strlen(str) + 1);
+	}
+}
+
+static void hexdump_out(const struct log_output *log_output,
+			struct log_msg *msg)
+{
+	uint8_t buf[HEXDUMP_CHUNK_LEN];
+	uint32_t offset = 0U;
+	size_t length;
+
+	hdr_out(log_output, LOG_DICT_MSG_HEXDUMP, msg,
+		msg->hdr.params.hexdump.length);
+
+	do {
+		length = sizeof(buf);
+		log_msg_hexdump_data_get(msg, buf, &length, offset);
+		dict_out(log_output, buf, length);
+		offset += length;
+	} while (length > 0);
+}
+
+void log_output_msg_dict_process(const struct log_output *log_output,
+				 struct log_msg *msg, uint32_t flags)
+{
+	ARG_UNUSED(flags);
+
+	if (log_msg_is_std(msg)) {
+		std_out(log_output, msg);
+	} else {
+		hexdump_out(log_output, msg);
+	}
+
+	log_output_flush(log_output);
+}
+
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     uint32_t cnt)
+{
+	struct log_dict_msg_hdr hdr = {
+		.type = LOG_DICT_MSG_DROPPED,
+		.length = MIN(cnt, UINT16_MAX),
+	};
+
+	dict_out(log_output, &hdr, sizeof(hdr));
+	log_output_flush(log_output);
+}
@@ -5,12 +5,19 @@
  */
 
 #include <zephyr.h>
+#include <init.h>
 #include "net/buf.h"
 #include "mgmt/mgmt.h"
 #include "mgmt/mcumgr/buf.h"
 #include "smp/smp.h"
 #include "mgmt/mcumgr/smp.h"
 
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+static K_KERNEL_STACK_DEFINE(smp_work_queue_stack,
+			     CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
+static struct k_work_q smp_work_queue;
+#endif
+
 static mgmt_alloc_rsp_fn zephyr_smp_alloc_rsp;
 static mgmt_trim_front_fn zephyr_smp_trim_front;
 static mgmt_reset_buf_fn zephyr_smp_reset_buf;
@@ -300,5 +307,26 @@ void
 zephyr_smp_rx_req(struct zephyr_smp_transport *zst, struct net_buf *nb)
 {
 	k_fifo_put(&zst->zst_fifo, nb);
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+	k_work_submit_to_queue(&smp_work_queue, &zst->zst_work);
+#else
 	k_work_submit(&zst->zst_work);
+#endif
 }
+
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+static int
+zephyr_smp_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&smp_work_queue, smp_work_queue_stack,
+		       K_KERNEL_STACK_SIZEOF(smp_work_queue_stack),
+		       K_PRIO_PREEMPT(CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO));
+	k_thread_name_set(&smp_work_queue.thread, "mcumgr smp");
+
+	return 0;
+}
+
+SYS_INIT(zephyr_smp_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_MCUMGR_SMP_WORKQUEUE */
@@ -94,11 +94,37 @@ static struct bt_gatt_attr smp_bt_attrs[] = {
 static struct bt_gatt_service smp_bt_svc = BT_GATT_SERVICE(smp_bt_attrs);
 
 /**
- * Transmits an SMP response over the specified Bluetooth connection.
+ * Transmits an SMP response over the specified Bluetooth connection.  The
+ * response is sent straight from its buffer, as a sequence of notifications
+ * which fit in the ATT MTU.
  */
 static int smp_bt_tx_rsp(struct bt_conn *conn, const void *data, uint16_t len)
 {
-	return bt_gatt_notify(conn, smp_bt_attrs + 2, data, len);
+	const uint8_t *src = data;
+	uint16_t frag_len;
+	uint16_t mtu;
+	int rc = 0;
+
+	mtu = bt_gatt_get_mtu(conn);
+	if (mtu <= 3U) {
+		return -ENOTCONN;
+	}
+
+	/* Account for the three-byte notification header. */
+	mtu -= 3U;
+
+	while (len > 0U) {
+		frag_len = MIN(len, mtu);
+		rc = bt_gatt_notify(conn, smp_bt_attrs + 2, src, frag_len);
+		if (rc != 0) {
+			break;
+		}
+
+		src += frag_len;
+		len -= frag_len;
+	}
+
+	return rc;
 }
 
 /**
@@ -117,23 +143,22 @@ static struct bt_conn *smp_bt_conn_from_pkt(const struct net_buf *nb)
 
 /**
  * Calculates the maximum fragment size to use when sending the specified
- * response packet.
+ * response packet.  smp_bt_tx_rsp() splits responses in notifications
+ * itself, so that the SMP layer does not copy each fragment into a buffer
+ * of its own.
  */
 static uint16_t smp_bt_get_mtu(const struct net_buf *nb)
 {
 	struct bt_conn *conn;
-	uint16_t mtu;
 
 	conn = smp_bt_conn_from_pkt(nb);
 	if (conn == NULL) {
 		return 0;
 	}
 
-	mtu = bt_gatt_get_mtu(conn);
 	bt_conn_unref(conn);
 
-	/* Account for the three-byte notification header. */
-	return mtu - 3;
+	return CONFIG_MCUMGR_BUF_SIZE;
 }
 
 static void smp_bt_ud_free(void *ud)
@@ -159,6 +159,74 @@ const struct net_buf_data_cb net_buf_fixed_cb = {
 	.unref = fixed_data_unref,
 };
 
+static uint8_t *slab_data_alloc(struct net_buf *buf, size_t *size,
+			       k_timeout_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_slab *slab = pool->alloc->alloc_data;
+	size_t needed = NET_BUF_SLAB_HDR_SIZE + *size;
+	uint8_t *block;
+	int first = -1;
+	int i;
+
+	/* Take the smallest block that fits, and only fall back to the larger
+	 * size classes if the smaller ones are exhausted.
+	 */
+	for (i = 0; i < slab->slab_count; i++) {
+		if (slab->slabs[i]->block_size < needed) {
+			continue;
+		}
+
+		if (first < 0) {
+			first = i;
+		}
+
+		if (!k_mem_slab_alloc(slab->slabs[i], (void **)&block,
+				      K_NO_WAIT)) {
+			goto found;
+		}
+	}
+
+	if (first < 0 || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return NULL;
+	}
+
+	/* Wait for a block of the best fitting size */
+	i = first;
+	if (k_mem_slab_alloc(slab->slabs[i], (void **)&block, timeout)) {
+		return NULL;
+	}
+
+found:
+	/* Size class of the block, followed by the ref count (uint8_t) */
+	block[0] = i;
+	block[1] = 1U;
+
+	return block + NET_BUF_SLAB_HDR_SIZE;
+}
+
+static void slab_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_slab *slab = pool->alloc->alloc_data;
+	uint8_t *ref_count;
+	void *block;
+
+	ref_count = data - 1;
+	if (--(*ref_count)) {
+		return;
+	}
+
+	block = data - NET_BUF_SLAB_HDR_SIZE;
+	k_mem_slab_free(slab->slabs[*(uint8_t *)block], &block);
+}
+
+const struct net_buf_data_cb net_buf_slab_cb = {
+	.alloc = slab_data_alloc,
+	.ref   = generic_data_ref,
+	.unref = slab_data_unref,
+};
+
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
 static uint8_t *heap_data_alloc(struct net_buf *buf, size_t *size,
@@ -352,23 +420,31 @@ success:
 	return buf;
 }
 
+static size_t fixed_data_size(struct net_buf_pool *pool)
+{
+	if (pool->alloc->cb == &net_buf_slab_cb) {
+		const struct net_buf_pool_slab *slab = pool->alloc->alloc_data;
+
+		return slab->data_size;
+	}
+
+	return ((const struct net_buf_pool_fixed *)
+		pool->alloc->alloc_data)->data_size;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_fixed_debug(struct net_buf_pool *pool,
 					  k_timeout_t timeout, const char *func,
 					  int line)
 {
-	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
-
-	return net_buf_alloc_len_debug(pool, fixed->data_size, timeout, func,
-				       line);
+	return net_buf_alloc_len_debug(pool, fixed_data_size(pool), timeout,
+				       func, line);
 }
 #else
 struct net_buf *net_buf_alloc_fixed(struct net_buf_pool *pool,
 				    k_timeout_t timeout)
 {
-	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
-
-	return net_buf_alloc_len(pool, fixed->data_size, timeout);
+	return net_buf_alloc_len(pool, fixed_data_size(pool), timeout);
 }
 #endif
 
@@ -229,24 +229,44 @@ get_6lo_context_by_cid(struct net_if *iface, uint8_t cid)
 	return NULL;
 }
 
-/* Get the context by addr */
-static inline struct net_6lo_context *
-get_6lo_context_by_addr(struct net_if *iface, struct in6_addr *addr)
+/* Get the contexts by src and dst addr in one pass, an addr is not looked up
+ * if it is NULL. If compress flag is unset means use only in uncompression,
+ * such a context is not returned.
+ */
+static inline void get_6lo_contexts_by_addr(struct net_if *iface,
+					    struct in6_addr *src_addr,
+					    struct in6_addr *dst_addr,
+					    struct net_6lo_context **src,
+					    struct net_6lo_context **dst)
 {
 	uint8_t i;
 
+	*src = NULL;
+	*dst = NULL;
+
 	for (i = 0U; i < CONFIG_NET_MAX_6LO_CONTEXTS; i++) {
-		if (!ctx_6co[i].is_used) {
+		struct net_6lo_context *ctx = &ctx_6co[i];
+
+		if (!src_addr && !dst_addr) {
+			break;
+		}
+
+		if (!ctx->is_used || ctx->iface != iface) {
 			continue;
 		}
 
-		if (ctx_6co[i].iface == iface &&
-		    !memcmp(ctx_6co[i].prefix.s6_addr, addr->s6_addr, 8)) {
-			return &ctx_6co[i];
+		if (src_addr &&
+		    !memcmp(ctx->prefix.s6_addr, src_addr->s6_addr, 8)) {
+			*src = ctx->compress ? ctx : NULL;
+			src_addr = NULL;
 		}
-	}
 
-	return NULL;
+		if (dst_addr &&
+		    !memcmp(ctx->prefix.s6_addr, dst_addr->s6_addr, 8)) {
+			*dst = ctx->compress ? ctx : NULL;
+			dst_addr = NULL;
+		}
+	}
 }
 
 #endif
@@ -679,37 +699,6 @@ static inline uint8_t *compress_nh_udp(struct net_udp_hdr *udp, uint8_t *inline_
 	return inline_ptr_udp;
 }
 
-#if defined(CONFIG_NET_6LO_CONTEXT)
-
-static struct net_6lo_context *get_src_addr_ctx(struct net_pkt *pkt,
-						struct net_ipv6_hdr *ipv6)
-{
-	/* If compress flag is unset means use only in uncompression. */
-	struct net_6lo_context *src;
-
-	src = get_6lo_context_by_addr(net_pkt_iface(pkt), &ipv6->src);
-	if (!src || !src->compress) {
-		return NULL;
-	}
-
-	return src;
-}
-
-static struct net_6lo_context *get_dst_addr_ctx(struct net_pkt *pkt,
-						struct net_ipv6_hdr *ipv6)
-{
-	/* If compress flag is unset means use only in uncompression. */
-	struct net_6lo_context *dst;
-
-	dst = get_6lo_context_by_addr(net_pkt_iface(pkt), &ipv6->dst);
-	if (!dst || !dst->compress) {
-		return NULL;
-	}
-
-	return dst;
-}
-#endif /* CONFIG_NET_6LO_CONTEXT */
-
 /* RFC 6282 LOWPAN IPHC Encoding format (3.1)
  *  Base Format
  *   0                                       1
@@ -723,12 +712,15 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 #if defined(CONFIG_NET_6LO_CONTEXT)
 	struct net_6lo_context *src_ctx = NULL;
 	struct net_6lo_context *dst_ctx = NULL;
+	struct in6_addr *src_addr = NULL;
+	struct in6_addr *dst_addr = NULL;
 #endif
 	uint8_t compressed = 0;
 	uint16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
 	struct net_udp_hdr *udp;
 	uint8_t *inline_pos;
+	bool src_ll, dst_ll;
 
 	if (pkt->frags->len < NET_IPV6H_LEN) {
 		NET_ERR("Invalid length %d, min %d",
@@ -752,7 +744,24 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
 	}
 
-	if (net_6lo_ll_prefix_padded_with_zeros(&ipv6->dst)) {
+	src_ll = net_6lo_ll_prefix_padded_with_zeros(&ipv6->src);
+	dst_ll = net_6lo_ll_prefix_padded_with_zeros(&ipv6->dst);
+
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	/* Look up the contexts of the addresses that can use one at once */
+	if (!src_ll && !net_ipv6_is_addr_unspecified(&ipv6->src)) {
+		src_addr = &ipv6->src;
+	}
+
+	if (!dst_ll && !net_ipv6_is_addr_mcast(&ipv6->dst)) {
+		dst_addr = &ipv6->dst;
+	}
+
+	get_6lo_contexts_by_addr(net_pkt_iface(pkt), src_addr, dst_addr,
+				 &src_ctx, &dst_ctx);
+#endif
+
+	if (dst_ll) {
 		inline_pos = compress_da(ipv6, pkt, inline_pos, &iphc);
 		goto da_end;
 	}
@@ -763,7 +772,6 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	}
 
 #if defined(CONFIG_NET_6LO_CONTEXT)
-	dst_ctx = get_dst_addr_ctx(pkt, ipv6);
 	if (dst_ctx) {
 		iphc |= NET_6LO_IPHC_CID_1;
 		inline_pos = compress_da_ctx(ipv6, inline_pos, pkt, &iphc,
@@ -774,7 +782,7 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	inline_pos = set_da_inline(ipv6, inline_pos, &iphc);
 da_end:
 
-	if (net_6lo_ll_prefix_padded_with_zeros(&ipv6->src)) {
+	if (src_ll) {
 		inline_pos = compress_sa(ipv6, pkt, inline_pos, &iphc);
 		goto sa_end;
 	}
@@ -789,7 +797,6 @@ da_end:
 	}
 
 #if defined(CONFIG_NET_6LO_CONTEXT)
-	src_ctx = get_src_addr_ctx(pkt, ipv6);
 	if (src_ctx) {
 		inline_pos = compress_sa_ctx(ipv6, inline_pos, pkt, &iphc,
 					     src_ctx);
@@ -1491,6 +1498,11 @@ static inline int compress_ipv6_header(struct net_pkt *pkt)
 {
 	struct net_buf *buffer = pkt->buffer;
 
+	if (net_buf_headroom(buffer) >= 1U) {
+		*(uint8_t *)net_buf_push(buffer, 1U) = NET_6LO_DISPATCH_IPV6;
+		return 0;
+	}
+
 	if (net_buf_tailroom(buffer) >= 1U) {
 		memmove(buffer->data + 1U, buffer->data, buffer->len);
 		net_buf_add(buffer, 1U);
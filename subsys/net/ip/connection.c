@@ -59,6 +59,17 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Used connections indexed by local port. Handlers without a local port
+ * (wildcard, packet and CAN sockets) are kept in conn_any_port.
+ */
+static sys_slist_t conn_port_buckets[CONFIG_NET_CONN_PORT_BUCKETS];
+static sys_slist_t conn_any_port;
+
+struct conn_lookup {
+	sys_slist_t *bucket;
+	bool any_port;
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -127,11 +138,50 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+static sys_slist_t *conn_port_bucket(uint16_t port)
+{
+	/* port is in network byte order */
+	return &conn_port_buckets[ntohs(port) % CONFIG_NET_CONN_PORT_BUCKETS];
+}
+
+static sys_slist_t *conn_lookup_list(struct net_conn *conn)
+{
+	if (!(conn->flags & NET_CONN_LOCAL_PORT_SPEC)) {
+		return &conn_any_port;
+	}
+
+	return conn_port_bucket(net_sin(&conn->local_addr)->sin_port);
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_lookup_list(conn), &conn->port_node);
+}
+
+/* Iterate over the handlers that can match a packet sent to dst_port:
+ * first the ones in the bucket of that port, then the ones bound to any
+ * local port.
+ */
+static struct net_conn *conn_lookup_next(struct conn_lookup *lookup,
+					 struct net_conn *conn)
+{
+	sys_snode_t *node;
+
+	if (conn) {
+		node = sys_slist_peek_next(&conn->port_node);
+	} else {
+		node = sys_slist_peek_head(lookup->bucket);
+	}
+
+	if (node == NULL && !lookup->any_port) {
+		lookup->any_port = true;
+		node = sys_slist_peek_head(&conn_any_port);
+	}
+
+	return node ? CONTAINER_OF(node, struct net_conn, port_node) : NULL;
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -378,6 +428,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_lookup_list(conn), &conn->port_node);
 
 	conn_set_unused(conn);
 
@@ -505,6 +556,19 @@ static bool conn_are_end_points_valid(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+/* The UDP checksum of a packet may be left for the socket to verify while
+ * it copies the payload, anyone else needs the packet verified here.
+ */
+static bool conn_chksum_ok(struct net_conn *conn, struct net_pkt *pkt)
+{
+	if (!net_pkt_is_chksum_pending(pkt) ||
+	    (conn && conn->cb == net_context_packet_received)) {
+		return true;
+	}
+
+	return net_udp_verify_chksum(pkt);
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -512,6 +576,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 {
 	struct net_if *pkt_iface = net_pkt_iface(pkt);
 	struct net_conn *best_match = NULL;
+	struct conn_lookup lookup;
 	bool is_mcast_pkt = false, mcast_pkt_delivered = false;
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
@@ -580,7 +645,11 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	lookup.bucket = conn_port_bucket(dst_port);
+	lookup.any_port = false;
+
+	for (conn = conn_lookup_next(&lookup, NULL); conn;
+	     conn = conn_lookup_next(&lookup, conn)) {
 		/* For packet socket data, the proto is set to ETH_P_ALL but
 		 * the listener might have a specific protocol set. This is ok
 		 * and let the packet pass this check in this case.
@@ -667,6 +736,11 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 					goto drop;
 				}
 
+				if (!conn_chksum_ok(conn, mcast_pkt)) {
+					net_pkt_unref(mcast_pkt);
+					goto drop;
+				}
+
 				if (conn->cb(conn, mcast_pkt, ip_hdr,
 					     proto_hdr, conn->user_data) ==
 								NET_DROP) {
@@ -735,6 +809,10 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
 			conn, conn->cb, conn->user_data, conn->flags);
 
+		if (!conn_chksum_ok(conn, pkt)) {
+			goto drop;
+		}
+
 		if (conn->cb(conn, pkt, ip_hdr, proto_hdr,
 			     conn->user_data) == NET_DROP) {
 			goto drop;
@@ -747,6 +825,10 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	NET_DBG("No match found.");
 
+	if (!conn_chksum_ok(NULL, pkt)) {
+		goto drop;
+	}
+
 	/* Do not send ICMP error for Packet socket as that makes no
 	 * sense here.
 	 */
@@ -789,6 +871,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_any_port);
+
+	for (i = 0; i < CONFIG_NET_CONN_PORT_BUCKETS; i++) {
+		sys_slist_init(&conn_port_buckets[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
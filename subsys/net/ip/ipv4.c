@@ -208,6 +208,7 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 	union net_ip_header ip;
 	uint8_t hdr_len;
 	uint8_t opts_len;
+	uint16_t flag;
 	int pkt_len;
 
 	net_stats_update_ipv4_recv(net_pkt_iface(pkt));
@@ -295,6 +296,17 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		log_strdup(net_sprint_ipv4_addr(&hdr->src)),
 		log_strdup(net_sprint_ipv4_addr(&hdr->dst)));
 
+	flag = (hdr->offset[0] << 8) | hdr->offset[1];
+	if (flag & (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) {
+		/* Fragments are dropped if reassembly is not enabled */
+		verdict = net_ipv4_handle_fragment_hdr(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	switch (hdr->proto) {
 	case IPPROTO_ICMP:
 		verdict = net_icmpv4_input(pkt, hdr);
@@ -20,8 +20,15 @@
 #include <net/net_if.h>
 #include <net/net_context.h>
 
+#include "reassembly.h"
+
 #define NET_IPV4_IHL_MASK 0x0F
 
+/* IPv4 fragment offset field */
+#define NET_IPV4_DO_NOT_FRAG_MASK  0x4000
+#define NET_IPV4_MORE_FRAG_MASK    0x2000
+#define NET_IPV4_FRAGH_OFFSET_MASK 0x1fff
+
 /* IPv4 Options */
 #define NET_IPV4_OPTS_EO   0   /* End of Options */
 #define NET_IPV4_OPTS_NOP  1   /* No operation */
@@ -132,4 +139,51 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+/** Store pending IPv4 fragment information that is needed for reassembly. */
+struct net_ipv4_reassembly {
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_delayed_work timer;
+
+	/** Pending fragments */
+	struct net_reass core;
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** Protocol of the fragmented datagram */
+	uint8_t proto;
+};
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * @param pkt Network head packet.
+ * @param hdr The IPv4 header of the current packet
+ *
+ * @return Return verdict about the packet
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif
+
 #endif /* __IPV4_H */
@@ -0,0 +1,248 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_stats.h>
+#include "net_private.h"
+#include "ipv4.h"
+#include "reassembly.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+static void reassembly_timeout(struct k_work *work);
+static void reassembly_evict(struct net_reass *core);
+static bool reassembly_init_done;
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+/* The datagram is identified by source, destination, protocol and
+ * identification (RFC 791 ch 3.2).
+ */
+static struct net_ipv4_reassembly *reassembly_get(uint16_t id, uint8_t proto,
+						  struct in_addr *src,
+						  struct in_addr *dst)
+{
+	int i, avail = -1;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+
+		if (k_delayed_work_remaining_get(&reassembly[i].timer) &&
+		    reassembly[i].id == id &&
+		    reassembly[i].proto == proto &&
+		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
+		    net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+			return &reassembly[i];
+		}
+
+		if (k_delayed_work_remaining_get(&reassembly[i].timer)) {
+			continue;
+		}
+
+		if (avail < 0) {
+			avail = i;
+		}
+	}
+
+	if (avail < 0) {
+		return NULL;
+	}
+
+	k_delayed_work_submit(&reassembly[avail].timer,
+			      IPV4_REASSEMBLY_TIMEOUT);
+
+	net_ipaddr_copy(&reassembly[avail].src, src);
+	net_ipaddr_copy(&reassembly[avail].dst, dst);
+
+	reassembly[avail].id = id;
+	reassembly[avail].proto = proto;
+
+	net_reass_start(&reassembly[avail].core, reassembly_evict);
+
+	return &reassembly[avail];
+}
+
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
+{
+	int32_t remaining;
+
+	remaining = k_delayed_work_remaining_get(&reass->timer);
+	if (remaining) {
+		k_delayed_work_cancel(&reass->timer);
+	}
+
+	NET_DBG("IPv4 reassembly id 0x%x remaining %d ms",
+		reass->id, remaining);
+
+	reass->id = 0U;
+
+	net_reass_release(&reass->core);
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		log_strdup(net_sprint_ipv4_addr(&reass->src)),
+		log_strdup(net_sprint_ipv4_addr(&reass->dst)),
+		k_delayed_work_remaining_get(&reass->timer));
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(work, struct net_ipv4_reassembly, timer);
+
+	reassembly_info("Reassembly cancelled", reass);
+
+	reassembly_cancel(reass);
+}
+
+static void reassembly_evict(struct net_reass *core)
+{
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(core, struct net_ipv4_reassembly, core);
+
+	reassembly_info("Reassembly evicted", reass);
+
+	reassembly_cancel(reass);
+}
+
+static void reassemble_packet(struct net_ipv4_reassembly *reass)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+
+	k_delayed_work_cancel(&reass->timer);
+
+	/* The payload of the other fragments is chained to the first
+	 * one as is, only its header needs to be updated.
+	 */
+	pkt = net_reass_finish(&reass->core);
+	reass->id = 0U;
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		goto error;
+	}
+
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->offset[0] = 0U;
+	hdr->offset[1] = 0U;
+	hdr->chksum = 0U;
+
+	net_pkt_set_data(pkt, &ipv4_access);
+
+	/* The options are part of the checksum, so it is computed from
+	 * the packet buffer once the header has been written back.
+	 */
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt,
+		net_pkt_get_len(pkt));
+
+	/* As with IPv6, the packet is fed back through the RX queue and
+	 * must not be passed to L2 as it has no link layer header.
+	 */
+	net_pkt_set_ipv4_reassembled(pkt, true);
+
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass;
+	uint16_t hdr_len;
+	uint16_t offset;
+	uint16_t flag;
+	uint16_t len;
+	uint16_t id;
+	bool more;
+	int ret;
+	int i;
+
+	if (!reassembly_init_done) {
+		/* Static initializing does not work here because of the array
+		 * so we must do it at runtime.
+		 */
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			k_delayed_work_init(&reassembly[i].timer,
+					    reassembly_timeout);
+		}
+
+		reassembly_init_done = true;
+	}
+
+	flag = (hdr->offset[0] << 8) | hdr->offset[1];
+	id = (hdr->id[0] << 8) | hdr->id[1];
+
+	more = !!(flag & NET_IPV4_MORE_FRAG_MASK);
+	offset = (flag & NET_IPV4_FRAGH_OFFSET_MASK) * 8U;
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+	len = net_pkt_get_len(pkt) - hdr_len;
+
+	if (!len || (more && (len % 8))) {
+		NET_DBG("Invalid fragment length %u", len);
+		goto drop;
+	}
+
+	if ((uint32_t)hdr_len + offset + len > UINT16_MAX) {
+		NET_DBG("Fragment offset %u too large", offset);
+		goto drop;
+	}
+
+	reass = reassembly_get(id, hdr->proto, &hdr->src, &hdr->dst);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		goto drop;
+	}
+
+	/* The fragments might come in any order, they are kept sorted
+	 * by offset until all of them have been received.
+	 */
+	ret = net_reass_add(&reass->core, pkt, hdr_len, offset, len, more);
+	if (ret == -EINVAL) {
+		NET_DBG("Reassembled IPv4 verify failed, dropping id 0x%x",
+			reass->id);
+		reassembly_cancel(reass);
+		goto drop;
+	} else if (ret < 0) {
+		NET_DBG("Cannot store pkt %p offset %u for 0x%x (%d)",
+			pkt, offset, reass->id, ret);
+		goto drop;
+	}
+
+	if (ret == 0) {
+		reassembly_info("Reassembly nth pkt", reass);
+		return NET_OK;
+	}
+
+	reassembly_info("Reassembly last pkt", reass);
+
+	reassemble_packet(reass);
+
+	return NET_OK;
+
+drop:
+	return NET_DROP;
+}
@@ -22,6 +22,7 @@
 
 #include "icmpv6.h"
 #include "nbr.h"
+#include "reassembly.h"
 
 #define NET_IPV6_ND_HOP_LIMIT 255
 #define NET_IPV6_ND_INFINITE_LIFETIME 0xFFFFFFFF
@@ -107,6 +108,11 @@ struct net_ipv6_nbr_data {
 	/** Is the neighbor a router */
 	bool is_router;
 
+#if CONFIG_NET_IPV6_NBR_HASH_SIZE > 0
+	/** Link in the neighbor hash bucket */
+	sys_snode_t hash_node;
+#endif
+
 #if defined(CONFIG_NET_IPV6_NBR_CACHE) || defined(CONFIG_NET_IPV6_ND)
 	/** Stale counter used to removed oldest nbr in STALE state,
 	 *  when table is full.
@@ -382,14 +388,6 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 }
 #endif
 
-/* We do not have to accept larger than 1500 byte IPv6 packet (RFC 2460 ch 5).
- * This means that we should receive everything within first two fragments.
- * The first one being 1280 bytes and the second one 220 bytes.
- */
-#if !defined(NET_IPV6_FRAGMENTS_MAX_PKT)
-#define NET_IPV6_FRAGMENTS_MAX_PKT 2
-#endif
-
 /** Store pending IPv6 fragment information that is needed for reassembly. */
 struct net_ipv6_reassembly {
 	/** IPv6 source address of the fragment */
@@ -404,8 +402,8 @@ struct net_ipv6_reassembly {
 	 */
 	struct k_delayed_work timer;
 
-	/** Pointers to pending fragments */
-	struct net_pkt *pkt[NET_IPV6_FRAGMENTS_MAX_PKT];
+	/** Pending fragments */
+	struct net_reass core;
 
 	/** IPv6 fragment identification */
 	uint32_t id;
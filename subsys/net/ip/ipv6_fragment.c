@@ -28,6 +28,7 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "6lo.h"
 #include "route.h"
 #include "net_stats.h"
+#include "reassembly.h"
 
 /* Timeout for various buffer allocations in this file. */
 #define NET_BUF_TIMEOUT K_MSEC(50)
@@ -120,6 +121,8 @@ fail:
 	return -EINVAL;
 }
 
+static void reassembly_evict(struct net_reass *core);
+
 static struct net_ipv6_reassembly *reassembly_get(uint32_t id,
 						  struct in6_addr *src,
 						  struct in6_addr *dst)
@@ -156,53 +159,28 @@ static struct net_ipv6_reassembly *reassembly_get(uint32_t id,
 
 	reassembly[avail].id = id;
 
+	net_reass_start(&reassembly[avail].core, reassembly_evict);
+
 	return &reassembly[avail];
 }
 
-static bool reassembly_cancel(uint32_t id,
-			      struct in6_addr *src,
-			      struct in6_addr *dst)
+static void reassembly_cancel(struct net_ipv6_reassembly *reass)
 {
-	int i, j;
-
-	NET_DBG("Cancel 0x%x", id);
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
+	int32_t remaining;
 
-		if (reassembly[i].id != id ||
-		    !net_ipv6_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			continue;
-		}
+	NET_DBG("Cancel 0x%x", reass->id);
 
-		remaining = k_delayed_work_remaining_get(&reassembly[i].timer);
-		if (remaining) {
-			k_delayed_work_cancel(&reassembly[i].timer);
-		}
-
-		NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
-			reassembly[i].id, remaining);
-
-		reassembly[i].id = 0U;
-
-		for (j = 0; j < NET_IPV6_FRAGMENTS_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
-
-			NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
-				j, reassembly[i].pkt[j],
-				net_pkt_get_len(reassembly[i].pkt[j]));
+	remaining = k_delayed_work_remaining_get(&reass->timer);
+	if (remaining) {
+		k_delayed_work_cancel(&reass->timer);
+	}
 
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
-		}
+	NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
+		reass->id, remaining);
 
-		return true;
-	}
+	reass->id = 0U;
 
-	return false;
+	net_reass_release(&reass->core);
 }
 
 static void reassembly_info(char *str, struct net_ipv6_reassembly *reass)
@@ -220,7 +198,45 @@ static void reassembly_timeout(struct k_work *work)
 
 	reassembly_info("Reassembly cancelled", reass);
 
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+	reassembly_cancel(reass);
+}
+
+static void reassembly_evict(struct net_reass *core)
+{
+	struct net_ipv6_reassembly *reass =
+		CONTAINER_OF(core, struct net_ipv6_reassembly, core);
+
+	reassembly_info("Reassembly evicted", reass);
+
+	reassembly_cancel(reass);
+}
+
+/* Remove the fragment header from the first fragment. The headers in
+ * front of it are moved instead of the payload behind it, as they are
+ * much shorter.
+ */
+static int remove_fragment_hdr(struct net_pkt *pkt)
+{
+	uint16_t start = net_pkt_ipv6_fragment_start(pkt);
+	struct net_buf *buf = pkt->buffer;
+
+	if (buf->len < start + sizeof(struct net_ipv6_frag_hdr)) {
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_skip(pkt, start)) {
+			return -ENOBUFS;
+		}
+
+		return net_pkt_pull(pkt, sizeof(struct net_ipv6_frag_hdr));
+	}
+
+	memmove(buf->data + sizeof(struct net_ipv6_frag_hdr), buf->data,
+		start);
+	net_buf_pull(buf, sizeof(struct net_ipv6_frag_hdr));
+
+	net_pkt_cursor_init(pkt);
+
+	return 0;
 }
 
 static void reassemble_packet(struct net_ipv6_reassembly *reass)
@@ -233,53 +249,16 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	} ipv6;
 
 	struct net_pkt *pkt;
-	struct net_buf *last;
 	uint8_t next_hdr;
-	int i, len;
+	int len;
 
 	k_delayed_work_cancel(&reass->timer);
 
-	NET_ASSERT(reass->pkt[0]);
-
-	last = net_buf_frag_last(reass->pkt[0]->buffer);
-
-	/* We start from 2nd packet which is then appended to
-	 * the first one.
+	/* The payload of the other fragments is chained to the first
+	 * one as is.
 	 */
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		int removed_len;
-
-		pkt = reass->pkt[i];
-
-		net_pkt_cursor_init(pkt);
-
-		/* Get rid of IPv6 and fragment header which are at
-		 * the beginning of the fragment.
-		 */
-		removed_len = net_pkt_ipv6_fragment_start(pkt) +
-			      sizeof(struct net_ipv6_frag_hdr);
-
-		NET_DBG("Removing %d bytes from start of pkt %p",
-			removed_len, pkt->buffer);
-
-		if (net_pkt_pull(pkt, removed_len)) {
-			NET_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
-			return;
-		}
-
-		/* Attach the data to previous pkt */
-		last->frags = pkt->buffer;
-		last = net_buf_frag_last(pkt->buffer);
-
-		pkt->buffer = NULL;
-		reass->pkt[i] = NULL;
-
-		net_pkt_unref(pkt);
-	}
-
-	pkt = reass->pkt[0];
-	reass->pkt[0] = NULL;
+	pkt = net_reass_finish(&reass->core);
+	reass->id = 0U;
 
 	/* Next we need to strip away the fragment header from the first packet
 	 * and set the various pointers and values in packet.
@@ -300,7 +279,7 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 
 	next_hdr = ipv6.frag_hdr->nexthdr;
 
-	if (net_pkt_pull(pkt, sizeof(struct net_ipv6_frag_hdr))) {
+	if (remove_fragment_hdr(pkt)) {
 		NET_ERR("Failed to remove fragment header");
 		goto error;
 	}
@@ -362,77 +341,18 @@ void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- */
-static bool fragment_verify(struct net_ipv6_reassembly *reass)
-{
-	uint16_t offset;
-	int i, prev_len;
-
-	prev_len = net_pkt_get_len(reass->pkt[0]);
-	offset = net_pkt_ipv6_fragment_offset(reass->pkt[0]);
-
-	NET_DBG("pkt %p offset %u", reass->pkt[0], offset);
-
-	if (offset != 0U) {
-		return false;
-	}
-
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		offset = net_pkt_ipv6_fragment_offset(reass->pkt[i]);
-
-		NET_DBG("pkt %p offset %u prev_len %d", reass->pkt[i],
-			offset, prev_len);
-
-		if (prev_len < offset) {
-			/* Something wrong with the offset value */
-			return false;
-		}
-
-		prev_len = net_pkt_get_len(reass->pkt[i]);
-	}
-
-	return true;
-}
-
-static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
-{
-	int i;
-
-	for (i = pos + 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
-				pos, reass->pkt[pos],
-				net_pkt_ipv6_fragment_offset(reass->pkt[pos]),
-				i);
-
-			/* Do we have enough space in packet array to make
-			 * the move?
-			 */
-			if (((i - pos) + 1) >
-			    (NET_IPV6_FRAGMENTS_MAX_PKT - i)) {
-				return -ENOMEM;
-			}
-
-			memmove(&reass->pkt[i], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
-
-			return 0;
-		}
-	}
-
-	return -EINVAL;
-}
-
 enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 					      struct net_ipv6_hdr *hdr,
 					      uint8_t nexthdr)
 {
-	struct net_ipv6_reassembly *reass = NULL;
+	struct net_ipv6_reassembly *reass;
+	uint16_t hdr_len;
+	uint16_t offset;
 	uint16_t flag;
-	bool found;
+	uint16_t len;
 	uint8_t more;
 	uint32_t id;
+	int ret;
 	int i;
 
 	if (!reassembly_init_done) {
@@ -458,105 +378,64 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	reass = reassembly_get(id, &hdr->src, &hdr->dst);
-	if (!reass) {
-		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
-	}
-
 	more = flag & 0x01;
-	net_pkt_set_ipv6_fragment_offset(pkt, flag & 0xfff8);
-
-	if (!reass->pkt[0]) {
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, 0, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[0] = pkt;
+	offset = flag & 0xfff8;
+	net_pkt_set_ipv6_fragment_offset(pkt, offset);
 
-		reassembly_info("Reassembly 1st pkt", reass);
+	hdr_len = net_pkt_ipv6_fragment_start(pkt) +
+		  sizeof(struct net_ipv6_frag_hdr);
+	len = net_pkt_get_len(pkt) - hdr_len;
 
-		/* Wait for more fragments to receive. */
-		goto accept;
+	if (more && (len % 8)) {
+		/* Fragment length is not multiple of 8, discard
+		 * the packet and send parameter problem error.
+		 */
+		net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
+				      NET_ICMPV6_PARAM_PROB_OPTION, 0);
+		goto drop;
 	}
 
-	/* The fragments might come in wrong order so place them
-	 * in reassembly chain in correct order.
-	 */
-	for (i = 0, found = false; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv6_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv6_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room,
-			 * then it will discard the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, i, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
+	if (!len || (uint32_t)offset + len > UINT16_MAX) {
+		NET_DBG("Invalid fragment length %u offset %u", len, offset);
+		goto drop;
 	}
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment
-		 * list. We must discard the whole packet at this point.
-		 */
-		NET_DBG("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
+	reass = reassembly_get(id, &hdr->src, &hdr->dst);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
 		goto drop;
 	}
 
-	if (more) {
-		if (net_pkt_get_len(pkt) % 8) {
-			/* Fragment length is not multiple of 8, discard
-			 * the packet and send parameter problem error.
-			 */
-			net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
-					      NET_ICMPV6_PARAM_PROB_OPTION, 0);
-			goto drop;
-		}
+	/* The fragments might come in any order, they are kept sorted
+	 * by offset until all of them have been received.
+	 */
+	ret = net_reass_add(&reass->core, pkt, hdr_len, offset, len, more);
+	if (ret == -EINVAL) {
+		NET_DBG("Reassembled IPv6 verify failed, dropping id 0x%x",
+			reass->id);
+		reassembly_cancel(reass);
+		goto drop;
+	} else if (ret < 0) {
+		NET_DBG("Cannot store pkt %p offset %u for 0x%x (%d)",
+			pkt, offset, reass->id, ret);
+		goto drop;
+	}
 
+	if (ret == 0) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		NET_DBG("More fragments to be received");
-		goto accept;
+		return NET_OK;
 	}
 
 	reassembly_info("Reassembly last pkt", reass);
 
-	if (!fragment_verify(reass)) {
-		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
-			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < NET_IPV6_FRAGMENTS_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
-		goto drop;
-	}
-
 	/* The last fragment received, reassemble the packet */
 	reassemble_packet(reass);
 
-accept:
 	return NET_OK;
 
 drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
-	}
-
 	return NET_DROP;
 }
 
@@ -97,6 +97,13 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+#if CONFIG_NET_IPV6_NBR_HASH_SIZE > 0
+/* Index of the used neighbors by IPv6 address. The interface is not part
+ * of the key as the neighbor can be looked up without one.
+ */
+static sys_slist_t nbr_hash[CONFIG_NET_IPV6_NBR_HASH_SIZE];
+#endif
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -255,10 +262,66 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+#if CONFIG_NET_IPV6_NBR_HASH_SIZE > 0
+static sys_slist_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	/* Multiplicative hashing, the upper bits are the best mixed */
+	hash = (hash * 2654435761U) >> 16;
+
+	return &nbr_hash[hash % CONFIG_NET_IPV6_NBR_HASH_SIZE];
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+
+	sys_slist_prepend(nbr_hash_bucket(&data->addr), &data->hash_node);
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+
+	sys_slist_find_and_remove(nbr_hash_bucket(&data->addr),
+				  &data->hash_node);
+}
+#else
+static inline void nbr_hash_add(struct net_nbr *nbr)
+{
+	ARG_UNUSED(nbr);
+}
+
+static inline void nbr_hash_del(struct net_nbr *nbr)
+{
+	ARG_UNUSED(nbr);
+}
+#endif /* CONFIG_NET_IPV6_NBR_HASH_SIZE > 0 */
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
+#if CONFIG_NET_IPV6_NBR_HASH_SIZE > 0
+	struct net_ipv6_nbr_data *data;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nbr_hash_bucket(addr), data, hash_node) {
+		struct net_nbr *nbr = CONTAINER_OF((uint8_t *)data,
+						   struct net_nbr, __nbr);
+
+		if (iface && nbr->iface != iface) {
+			continue;
+		}
+
+		if (net_ipv6_addr_cmp(&data->addr, addr)) {
+			return nbr;
+		}
+	}
+#else
 	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
@@ -276,6 +339,7 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 			return nbr;
 		}
 	}
+#endif
 
 	return NULL;
 }
@@ -417,6 +481,8 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	net_ipv6_nbr_data(nbr)->reachable = 0;
 	net_ipv6_nbr_data(nbr)->reachable_timeout = 0;
 #endif
+
+	nbr_hash_add(nbr);
 }
 
 static struct net_nbr *nbr_new(struct net_if *iface,
@@ -653,7 +719,7 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	nbr_hash_del(nbr);
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -787,9 +853,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. Packets
+	 * that the driver segments itself are not fragmented either.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U &&
+	    net_pkt_tso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -1214,11 +1214,23 @@ static int get_context_txtime(struct net_context *context,
 #endif
 }
 
+static int pkt_write_data(struct net_pkt *pkt, const void *data, size_t len,
+			  struct net_pkt_csum *csum)
+{
+	if (csum) {
+		return net_pkt_write_csum(pkt, data, len, csum);
+	}
+
+	return net_pkt_write(pkt, data, len);
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. If csum is not NULL, the data is summed into it
+ * while being written.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      struct net_pkt_csum *csum)
 {
 	int ret = 0;
 
@@ -1226,14 +1238,14 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    msghdr->msg_iov[i].iov_len);
+			ret = pkt_write_data(pkt, msghdr->msg_iov[i].iov_base,
+					     msghdr->msg_iov[i].iov_len, csum);
 			if (ret < 0) {
 				break;
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = pkt_write_data(pkt, buf, buf_len, csum);
 	}
 
 	return ret;
@@ -1285,7 +1297,16 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY) &&
+	    net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		struct net_pkt_csum csum = { 0 };
+
+		ret = context_write_data(pkt, buf, len, msg, &csum);
+		net_pkt_set_payload_csum(pkt, &csum);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg, NULL);
+	}
+
 	if (ret) {
 		return ret;
 	}
@@ -1617,7 +1638,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1646,7 +1667,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1660,7 +1681,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1671,7 +1692,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1803,6 +1824,12 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 		goto unlock;
 	}
 
+	if (net_pkt_is_chksum_pending(pkt) &&
+	    !net_context_is_chksum_deferred(context) &&
+	    !net_udp_verify_chksum(pkt)) {
+		goto unlock;
+	}
+
 	if (net_context_get_ip_proto(context) == IPPROTO_TCP) {
 		net_stats_update_tcp_recv(net_pkt_iface(pkt),
 					  net_pkt_remaining_data(pkt));
@@ -55,6 +55,40 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
+static enum net_verdict process_l3(struct net_pkt *pkt, bool is_loopback)
+{
+	int ret;
+
+	ret = net_canbus_socket_input(pkt);
+	if (ret != NET_CONTINUE) {
+		return ret;
+	}
+
+	/* L2 has modified the buffer starting point, it is easier
+	 * to re-initialize the cursor rather than updating it.
+	 */
+	net_pkt_cursor_init(pkt);
+
+	/* IP version and header length. */
+	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
+#if defined(CONFIG_NET_IPV6)
+	case 0x60:
+		return net_ipv6_input(pkt, is_loopback);
+#endif
+#if defined(CONFIG_NET_IPV4)
+	case 0x40:
+		return net_ipv4_input(pkt);
+#endif
+	}
+
+	NET_DBG("Unknown IP family packet (0x%x)",
+		NET_IPV6_HDR(pkt)->vtc & 0xf0);
+	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
+	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
+
+	return NET_DROP;
+}
+
 static inline enum net_verdict process_data(struct net_pkt *pkt,
 					    bool is_loopback)
 {
@@ -76,6 +110,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	}
 #endif
 
+	/* Same for a reassembled IPv4 datagram */
+	if (net_pkt_ipv4_reassembled(pkt)) {
+		locally_routed = true;
+	}
+
 	/* If there is no data, then drop the packet. */
 	if (!pkt->frags) {
 		NET_DBG("Corrupted packet (frags %p)", pkt->frags);
@@ -97,34 +136,16 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
-	ret = net_canbus_socket_input(pkt);
-	if (ret != NET_CONTINUE) {
-		return ret;
-	}
-
-	/* L2 has modified the buffer starting point, it is easier
-	 * to re-initialize the cursor rather than updating it.
-	 */
-	net_pkt_cursor_init(pkt);
+	return process_l3(pkt, is_loopback);
+}
 
-	/* IP version and header length. */
-	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
-#if defined(CONFIG_NET_IPV6)
-	case 0x60:
-		return net_ipv6_input(pkt, is_loopback);
-#endif
-#if defined(CONFIG_NET_IPV4)
-	case 0x40:
-		return net_ipv4_input(pkt);
-#endif
+/* Called for packets that have already been through L2 processing */
+void net_l3_input(struct net_pkt *pkt)
+{
+	if (process_l3(pkt, false) != NET_OK) {
+		NET_DBG("Dropping pkt %p", pkt);
+		net_pkt_unref(pkt);
 	}
-
-	NET_DBG("Unknown IP family packet (0x%x)",
-		NET_IPV6_HDR(pkt)->vtc & 0xf0);
-	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
-	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
-
-	return NET_DROP;
 }
 
 static void processing_data(struct net_pkt *pkt, bool is_loopback)
@@ -355,7 +376,7 @@ static void process_rx_packet(struct k_work *work)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_queue_rx_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
@@ -371,12 +392,17 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 #if NET_TC_RX_COUNT > 1
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_queue_rx_prepare(iface, pkt);
 
-	net_tc_submit_to_rx_queue(tc, pkt);
+	net_tc_submit_to_rx_queue(net_rx_priority2tc(net_pkt_priority(pkt)),
+				  pkt);
 }
 
-/* Called by driver when an IP packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+static int net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
 	if (!pkt || !iface) {
 		return -EINVAL;
@@ -402,11 +428,58 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_set_iface(pkt, iface);
 
+#if defined(CONFIG_NET_FLOW_STEERING)
+	/* Multi-queue drivers may already have set the hardware hash */
+	if (!net_pkt_flow_hash(pkt)) {
+		bool ethernet = false;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+		ethernet = net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET);
+#endif
+		net_pkt_set_flow_hash(pkt, net_tc_flow_hash(pkt, ethernet));
+	}
+#endif
+
+	return 0;
+}
+
+/* Called by driver when an IP packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	int ret;
+
+	ret = net_recv_prepare(iface, pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
 	net_queue_rx(iface, pkt);
 
 	return 0;
 }
 
+int net_recv_data_batch(struct net_pkt **pkts, int count)
+{
+	int i, queued = 0;
+
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+		struct net_if *iface = net_pkt_iface(pkt);
+
+		if (net_recv_prepare(iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		net_queue_rx_prepare(iface, pkt);
+		pkts[queued++] = pkt;
+	}
+
+	net_tc_submit_batch_to_rx_queue(pkts, queued);
+
+	return queued;
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
@@ -200,150 +200,311 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
-static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
-{
-	struct net_linkaddr ll_dst = {
-		.addr = NULL
-	};
+/* What net_if_tx() keeps about a packet while it is being sent */
+struct net_if_tx_state {
+	struct net_linkaddr ll_dst;
 	struct net_linkaddr_storage ll_dst_storage;
 	struct net_context *context;
-	int status;
 
 	/* Timestamp of the current network packet sent if enabled */
 	struct net_ptp_time start_timestamp;
-	uint32_t curr_time = 0;
+	uint32_t curr_time;
 
 	/* We collect send statistics for each socket priority if enabled */
 	uint8_t pkt_priority;
+};
 
-	if (!pkt) {
-		return false;
-	}
-
+static void net_if_tx_start(struct net_if *iface, struct net_pkt *pkt,
+			    struct net_if_tx_state *state)
+{
 	debug_check_packet(pkt);
 
+	state->ll_dst.addr = NULL;
+	state->curr_time = 0;
+
 	/* If there're any link callbacks, with such a callback receiving
 	 * a destination address, copy that address out of packet, just in
 	 * case packet is freed before callback is called.
 	 */
 	if (!sys_slist_is_empty(&link_callbacks)) {
-		if (net_linkaddr_set(&ll_dst_storage,
+		if (net_linkaddr_set(&state->ll_dst_storage,
 				     net_pkt_lladdr_dst(pkt)->addr,
 				     net_pkt_lladdr_dst(pkt)->len) == 0) {
-			ll_dst.addr = ll_dst_storage.addr;
-			ll_dst.len = ll_dst_storage.len;
-			ll_dst.type = net_pkt_lladdr_dst(pkt)->type;
+			state->ll_dst.addr = state->ll_dst_storage.addr;
+			state->ll_dst.len = state->ll_dst_storage.len;
+			state->ll_dst.type = net_pkt_lladdr_dst(pkt)->type;
 		}
 	}
 
-	context = net_pkt_context(pkt);
+	state->context = net_pkt_context(pkt);
 
-	if (net_if_flag_is_set(iface, NET_IF_UP)) {
-		if (IS_ENABLED(CONFIG_NET_TCP) &&
-		    net_pkt_family(pkt) != AF_UNSPEC) {
-			net_pkt_set_queued(pkt, false);
-		}
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return;
+	}
 
-		if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && context) {
-			if (net_context_get_timestamp(context, pkt,
-						      &start_timestamp) < 0) {
-				start_timestamp.nanosecond = 0;
-			} else {
-				pkt_priority = net_pkt_priority(pkt);
-			}
+	if (IS_ENABLED(CONFIG_NET_TCP) &&
+	    net_pkt_family(pkt) != AF_UNSPEC) {
+		net_pkt_set_queued(pkt, false);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && state->context) {
+		if (net_context_get_timestamp(state->context, pkt,
+					      &state->start_timestamp) < 0) {
+			state->start_timestamp.nanosecond = 0;
+		} else {
+			state->pkt_priority = net_pkt_priority(pkt);
 		}
+	}
 
-		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
-			memcpy(&start_timestamp, net_pkt_timestamp(pkt),
-			       sizeof(start_timestamp));
-			pkt_priority = net_pkt_priority(pkt);
+	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+		memcpy(&state->start_timestamp, net_pkt_timestamp(pkt),
+		       sizeof(state->start_timestamp));
+		state->pkt_priority = net_pkt_priority(pkt);
 
-			if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
-				/* Make sure the statistics information is not
-				 * lost by keeping the net_pkt over L2 send.
-				 */
-				net_pkt_ref(pkt);
-			}
+		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
+			/* Make sure the statistics information is not
+			 * lost by keeping the net_pkt over L2 send.
+			 */
+			net_pkt_ref(pkt);
 		}
+	}
+}
 
-		status = net_if_l2(iface)->send(iface, pkt);
-
-		if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && status >= 0 &&
-		    context) {
-			if (start_timestamp.nanosecond > 0) {
-				curr_time = k_cycle_get_32();
-			}
+/* Called after L2 send of a packet on an interface that is up */
+static void net_if_tx_sent(struct net_if *iface, struct net_pkt *pkt,
+			   struct net_if_tx_state *state, int status)
+{
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && status >= 0 &&
+	    state->context) {
+		if (state->start_timestamp.nanosecond > 0) {
+			state->curr_time = k_cycle_get_32();
 		}
+	}
 
-		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
-			uint32_t end_tick = k_cycle_get_32();
+	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+		uint32_t end_tick = k_cycle_get_32();
 
-			net_pkt_set_tx_stats_tick(pkt, end_tick);
+		net_pkt_set_tx_stats_tick(pkt, end_tick);
 
-			net_stats_update_tc_tx_time(iface,
-						    pkt_priority,
-						    start_timestamp.nanosecond,
-						    end_tick);
-
-			if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
-				update_txtime_stats_detail(
-					pkt,
-					start_timestamp.nanosecond,
-					end_tick);
-
-				net_stats_update_tc_tx_time_detail(
-					iface, pkt_priority,
-					net_pkt_stats_tick(pkt));
-
-				/* For TCP connections, we might keep the pkt
-				 * longer so that we can resend it if needed.
-				 * Because of that we need to clear the
-				 * statistics here.
-				 */
-				net_pkt_stats_tick_reset(pkt);
-
-				net_pkt_unref(pkt);
-			}
-		}
+		net_stats_update_tc_tx_time(iface,
+					    state->pkt_priority,
+					    state->start_timestamp.nanosecond,
+					    end_tick);
 
-	} else {
-		/* Drop packet if interface is not up */
-		NET_WARN("iface %p is down", iface);
-		status = -ENETDOWN;
+		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
+			update_txtime_stats_detail(
+				pkt,
+				state->start_timestamp.nanosecond,
+				end_tick);
+
+			net_stats_update_tc_tx_time_detail(
+				iface, state->pkt_priority,
+				net_pkt_stats_tick(pkt));
+
+			/* For TCP connections, we might keep the pkt
+			 * longer so that we can resend it if needed.
+			 * Because of that we need to clear the
+			 * statistics here.
+			 */
+			net_pkt_stats_tick_reset(pkt);
+
+			net_pkt_unref(pkt);
+		}
 	}
+}
 
+static void net_if_tx_done(struct net_if *iface, struct net_pkt *pkt,
+			   struct net_if_tx_state *state, int status)
+{
 	if (status < 0) {
 		net_pkt_unref(pkt);
 	} else {
 		net_stats_update_bytes_sent(iface, status);
 	}
 
-	if (context) {
+	if (state->context) {
 		NET_DBG("Calling context send cb %p status %d",
-			context, status);
+			state->context, status);
 
-		net_context_send_cb(context, status);
+		net_context_send_cb(state->context, status);
 
 		if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && status >= 0 &&
-		    start_timestamp.nanosecond && curr_time > 0) {
+		    state->start_timestamp.nanosecond &&
+		    state->curr_time > 0) {
 			/* So we know now how long the network packet was in
 			 * transit from when it was allocated to when we
 			 * got information that it was sent successfully.
 			 */
 			net_stats_update_tc_tx_time(iface,
-						    pkt_priority,
-						    start_timestamp.nanosecond,
-						    curr_time);
+						    state->pkt_priority,
+						    state->start_timestamp.nanosecond,
+						    state->curr_time);
+		}
+	}
+
+	if (state->ll_dst.addr) {
+		net_if_call_link_cb(iface, &state->ll_dst, status);
+	}
+}
+
+#if defined(CONFIG_NET_IF_TX_BATCH)
+#define TX_BATCH CONFIG_NET_IF_TX_BATCH_SIZE
+
+/* Same as net_if_tx() for several packets, which are handed to the L2
+ * together if it can send them in one go.
+ */
+static void net_if_tx_batch(struct net_if *iface, struct net_pkt **pkts,
+			    int count)
+{
+	const struct net_l2 *l2 = net_if_l2(iface);
+	struct net_if_tx_state state[TX_BATCH];
+	int status[TX_BATCH];
+	bool up;
+	int i;
+
+	/* The flag is checked once so that all the packets take the same
+	 * path even if the interface goes down meanwhile.
+	 */
+	up = net_if_flag_is_set(iface, NET_IF_UP);
+
+	for (i = 0; i < count; i++) {
+		net_if_tx_start(iface, pkts[i], &state[i]);
+	}
+
+	if (!up) {
+		/* Drop packets if interface is not up */
+		NET_WARN("iface %p is down", iface);
+
+		for (i = 0; i < count; i++) {
+			status[i] = -ENETDOWN;
+		}
+	} else if (l2->send_batch && count > 1) {
+		l2->send_batch(iface, pkts, status, count);
+	} else {
+		for (i = 0; i < count; i++) {
+			status[i] = l2->send(iface, pkts[i]);
 		}
 	}
 
-	if (ll_dst.addr) {
-		net_if_call_link_cb(iface, &ll_dst, status);
+	for (i = 0; i < count; i++) {
+		if (up) {
+			net_if_tx_sent(iface, pkts[i], &state[i], status[i]);
+		}
+
+		net_if_tx_done(iface, pkts[i], &state[i], status[i]);
+	}
+}
+
+/* The packets are pushed on the queue head, so taking the whole list
+ * returns them newest first.
+ */
+static void process_tx_queue(struct k_work *work)
+{
+	struct net_if_tx_queue *queue =
+		CONTAINER_OF(work, struct net_if_tx_queue, work);
+	struct net_if *iface = queue->iface;
+	struct net_pkt *pkts[TX_BATCH];
+	struct k_work *next, *fifo = NULL;
+	int count = 0;
+
+	next = atomic_ptr_clear(&queue->head);
+	while (next) {
+		struct k_work *tmp = next;
+
+		next = tmp->_reserved;
+		tmp->_reserved = fifo;
+		fifo = tmp;
+	}
+
+	while (fifo) {
+		struct net_pkt *pkt = CONTAINER_OF(fifo, struct net_pkt, work);
+
+		fifo = fifo->_reserved;
+
+		atomic_clear_bit(pkt->work.flags, K_WORK_STATE_PENDING);
+		net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
+
+		pkts[count++] = pkt;
+		if (count < TX_BATCH && fifo) {
+			continue;
+		}
+
+		net_if_tx_batch(iface, pkts, count);
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending -= count;
+#endif
+		count = 0;
+	}
+}
+
+/* Lock-free: producers only ever push on the head and the TX thread
+ * takes the whole list at once, so a compare-and-swap loop is enough.
+ * Only the packet finding the queue empty submits the work item, the
+ * ones pushed after it are sent by that same run.
+ */
+static bool tx_queue_push(struct net_if *iface, uint8_t tc,
+			  struct net_pkt *pkt)
+{
+	struct net_if_tx_queue *queue = &iface->tx_queue[tc];
+	struct k_work *work = net_pkt_work(pkt);
+	void *head;
+
+	if (atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+		return false;
+	}
+
+	net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
+
+	do {
+		head = atomic_ptr_get(&queue->head);
+		work->_reserved = head;
+	} while (!atomic_ptr_cas(&queue->head, head, work));
+
+	if (!head) {
+		net_tc_submit_iface_to_tx_queue(tc, iface, &queue->work);
 	}
 
 	return true;
 }
 
+static void tx_queue_init(struct net_if *iface)
+{
+	int tc;
+
+	for (tc = 0; tc < NET_TC_TX_COUNT; tc++) {
+		k_work_init(&iface->tx_queue[tc].work, process_tx_queue);
+		iface->tx_queue[tc].iface = iface;
+		atomic_ptr_clear(&iface->tx_queue[tc].head);
+	}
+}
+#else /* CONFIG_NET_IF_TX_BATCH */
+static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_if_tx_state state;
+	int status;
+
+	if (!pkt) {
+		return false;
+	}
+
+	net_if_tx_start(iface, pkt, &state);
+
+	if (net_if_flag_is_set(iface, NET_IF_UP)) {
+		status = net_if_l2(iface)->send(iface, pkt);
+
+		net_if_tx_sent(iface, pkt, &state, status);
+	} else {
+		/* Drop packet if interface is not up */
+		NET_WARN("iface %p is down", iface);
+		status = -ENETDOWN;
+	}
+
+	net_if_tx_done(iface, pkt, &state, status);
+
+	return true;
+}
+
 static void process_tx_packet(struct k_work *work)
 {
 	struct net_if *iface;
@@ -361,13 +522,23 @@ static void process_tx_packet(struct k_work *work)
 	iface->tx_pending--;
 #endif
 }
+#endif /* CONFIG_NET_IF_TX_BATCH */
 
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_tx_priority2tc(prio);
 
+#if !defined(CONFIG_NET_IF_TX_BATCH)
 	k_work_init(net_pkt_work(pkt), process_tx_packet);
+#endif
+
+#if defined(CONFIG_NET_FLOW_STEERING)
+	/* The L2 header is only added when the packet is sent */
+	if (!net_pkt_flow_hash(pkt)) {
+		net_pkt_set_flow_hash(pkt, net_tc_flow_hash(pkt, false));
+	}
+#endif
 
 	net_stats_update_tc_sent_pkt(iface, tc);
 	net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
@@ -381,7 +552,11 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 	iface->tx_pending++;
 #endif
 
+#if defined(CONFIG_NET_IF_TX_BATCH)
+	if (!tx_queue_push(iface, tc, pkt)) {
+#else
 	if (!net_tc_submit_to_tx_queue(tc, pkt)) {
+#endif
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 		iface->tx_pending--
 #endif
@@ -426,6 +601,10 @@ static inline void init_iface(struct net_if *iface)
 	z_object_init(iface);
 #endif
 
+#if defined(CONFIG_NET_IF_TX_BATCH)
+	tx_queue_init(iface);
+#endif
+
 	api->init(iface);
 }
 
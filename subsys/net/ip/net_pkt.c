@@ -119,7 +119,43 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, NULL);
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#elif defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+
+#define SLAB_BLOCK_SIZE(_size) (NET_BUF_SLAB_HDR_SIZE + (_size))
+
+K_MEM_SLAB_DEFINE(rx_data_small,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_SMALL_SIZE),
+		  CONFIG_NET_BUF_SLAB_SMALL_COUNT, 4);
+K_MEM_SLAB_DEFINE(rx_data_medium,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_MEDIUM_SIZE),
+		  CONFIG_NET_BUF_SLAB_MEDIUM_COUNT, 4);
+K_MEM_SLAB_DEFINE(rx_data_large,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_LARGE_SIZE),
+		  CONFIG_NET_BUF_SLAB_LARGE_COUNT, 4);
+K_MEM_SLAB_DEFINE(tx_data_small,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_SMALL_SIZE),
+		  CONFIG_NET_BUF_SLAB_SMALL_COUNT, 4);
+K_MEM_SLAB_DEFINE(tx_data_medium,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_MEDIUM_SIZE),
+		  CONFIG_NET_BUF_SLAB_MEDIUM_COUNT, 4);
+K_MEM_SLAB_DEFINE(tx_data_large,
+		  SLAB_BLOCK_SIZE(CONFIG_NET_BUF_SLAB_LARGE_SIZE),
+		  CONFIG_NET_BUF_SLAB_LARGE_COUNT, 4);
+
+static struct k_mem_slab * const rx_data_slabs[] = {
+	&rx_data_small, &rx_data_medium, &rx_data_large,
+};
+
+static struct k_mem_slab * const tx_data_slabs[] = {
+	&tx_data_small, &tx_data_medium, &tx_data_large,
+};
+
+NET_BUF_POOL_SLAB_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
+			 CONFIG_NET_BUF_DATA_SIZE, rx_data_slabs, NULL);
+NET_BUF_POOL_SLAB_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
+			 CONFIG_NET_BUF_DATA_SIZE, tx_data_slabs, NULL);
+
+#else /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 			CONFIG_NET_BUF_DATA_POOL_SIZE, NULL);
@@ -846,7 +882,20 @@ void net_pkt_print(void)
 
 /* New allocator and API starts here */
 
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE) || \
+	defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+
+#if defined(CONFIG_NET_BUF_SLAB_DATA_SIZE)
+/* Take the smallest size class that holds what is left of the request,
+ * so that a small packet does not pin a block sized for a full frame.
+ */
+#define pkt_alloc_frag(pool, size, timeout)				\
+	net_buf_alloc_len(pool, MIN(size, CONFIG_NET_BUF_SLAB_LARGE_SIZE), \
+			  timeout)
+#else
+#define pkt_alloc_frag(pool, size, timeout)				\
+	net_buf_alloc_fixed(pool, timeout)
+#endif
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
@@ -864,7 +913,7 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 	while (size) {
 		struct net_buf *new;
 
-		new = net_buf_alloc_fixed(pool, timeout);
+		new = pkt_alloc_frag(pool, size, timeout);
 		if (!new) {
 			goto error;
 		}
@@ -913,7 +962,7 @@ error:
 	return NULL;
 }
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#else /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
@@ -941,7 +990,7 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 	return buf;
 }
 
-#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#endif /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 static size_t pkt_buffer_length(struct net_pkt *pkt,
 				size_t size,
@@ -1548,7 +1597,8 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write,
+				  struct net_pkt_csum *csum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
@@ -1578,7 +1628,11 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy) {
+		if (copy && csum) {
+			/* A read without destination only sums the data */
+			net_chksum_copy(csum, write ? c_op->pos : data,
+					write ? data : c_op->pos, len);
+		} else if (copy) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1611,21 +1665,29 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, NULL);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true, NULL);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, NULL);
+}
+
+int net_pkt_read_csum(struct net_pkt *pkt, void *data, size_t length,
+		      struct net_pkt_csum *csum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, data, length, true, false, csum);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
@@ -1672,12 +1734,27 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      NULL);
 }
 
-int net_pkt_copy(struct net_pkt *pkt_dst,
-		 struct net_pkt *pkt_src,
-		 size_t length)
+int net_pkt_write_csum(struct net_pkt *pkt, const void *data, size_t length,
+		       struct net_pkt_csum *csum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	if (data == pkt->cursor.pos && net_pkt_is_contiguous(pkt, length)) {
+		net_chksum_copy(csum, NULL, data, length);
+
+		return net_pkt_skip(pkt, length);
+	}
+
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      csum);
+}
+
+static int pkt_copy(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+		    size_t length, struct net_pkt_csum *csum)
 {
 	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
 	struct net_pkt_cursor *c_src = &pkt_src->cursor;
@@ -1708,7 +1785,11 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 			break;
 		}
 
-		memcpy(c_dst->pos, c_src->pos, len);
+		if (csum) {
+			net_chksum_copy(csum, c_dst->pos, c_src->pos, len);
+		} else {
+			memcpy(c_dst->pos, c_src->pos, len);
+		}
 
 		if (!net_pkt_is_being_overwritten(pkt_dst)) {
 			net_buf_add(c_dst->buf, len);
@@ -1728,6 +1809,20 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_copy(struct net_pkt *pkt_dst,
+		 struct net_pkt *pkt_src,
+		 size_t length)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, NULL);
+}
+
+int net_pkt_copy_csum(struct net_pkt *pkt_dst,
+		      struct net_pkt *pkt_src,
+		      size_t length, struct net_pkt_csum *csum)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, csum);
+}
+
 static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
 	net_pkt_set_family(clone_pkt, net_pkt_family(pkt));
@@ -1737,6 +1832,9 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_tso_size(clone_pkt, net_pkt_tso_size(pkt));
+	net_pkt_set_flow_hash(clone_pkt, net_pkt_flow_hash(pkt));
+	net_pkt_set_chksum_pending(clone_pkt, net_pkt_is_chksum_pending(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -87,7 +87,18 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 }
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_iface_to_tx_queue(uint8_t tc, struct net_if *iface,
+					    struct k_work *work);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_batch_to_rx_queue(struct net_pkt **pkts, int count);
+extern int net_tc_rx_queue(struct net_pkt *pkt);
+extern int net_tc_submit_delayed_to_rx_queue(uint8_t queue,
+					     struct k_delayed_work *work,
+					     k_timeout_t delay);
+#if defined(CONFIG_NET_FLOW_STEERING)
+extern uint32_t net_tc_flow_hash(struct net_pkt *pkt, bool ethernet);
+#endif
+extern void net_l3_input(struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -159,6 +170,12 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Copy len bytes from src to dst, adding their sum to csum. If dst is NULL
+ * the data is only summed.
+ */
+extern void net_chksum_copy(struct net_pkt_csum *csum, void *dst,
+			    const void *src, size_t len);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
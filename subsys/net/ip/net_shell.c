@@ -248,6 +248,8 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
+	EC(ETHERNET_HW_MULTI_QUEUE,       "Multiple RX/TX rings"),
 };
 
 static void print_supported_ethernet_capabilities(
@@ -898,10 +900,76 @@ static char *get_net_pkt_stats_detail(struct net_if *iface, bool is_tx)
 #endif /* CONFIG_NET_PKT_TXTIME_STATS_DETAIL ||
 	  CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 
+#if defined(CONFIG_NET_PKT_TIME_STATS_HISTOGRAM)
+/* Print the percentiles and the non empty buckets of a time histogram.
+ * A percentile is given as the upper bound of the bucket it falls in.
+ */
+static void print_time_hist(const struct shell *shell, const char *label,
+			    int stage, const net_stats_t *hist)
+{
+	static const uint8_t percentiles[] = { 50, 90, 99 };
+	net_stats_t count = 0U, total;
+	int i, j;
+
+	for (i = 0; i < NET_STATS_TIME_HIST_BUCKETS; i++) {
+		count += hist[i];
+	}
+
+	if (count == 0U) {
+		return;
+	}
+
+	if (stage < 0) {
+		PR("\t%s", label);
+	} else {
+		PR("\t%s[%d]", label, stage);
+	}
+
+	for (j = 0; j < ARRAY_SIZE(percentiles); j++) {
+		uint64_t limit = ceiling_fraction((uint64_t)count *
+						  percentiles[j], 100U);
+
+		total = 0U;
+
+		for (i = 0; i < NET_STATS_TIME_HIST_BUCKETS - 1; i++) {
+			total += hist[i];
+			if (total >= limit) {
+				break;
+			}
+		}
+
+		if (i < NET_STATS_TIME_HIST_BUCKETS - 1) {
+			PR(" p%d <%lu us", percentiles[j], BIT(i));
+		} else {
+			PR(" p%d >=%lu us", percentiles[j], BIT(i - 1));
+		}
+	}
+
+	PR("\n\t");
+
+	for (i = 0; i < NET_STATS_TIME_HIST_BUCKETS - 1; i++) {
+		if (hist[i]) {
+			PR(" <%lu:%u", BIT(i), hist[i]);
+		}
+	}
+
+	if (hist[i]) {
+		PR(" >=%lu:%u", BIT(i - 1), hist[i]);
+	}
+
+	PR("\n");
+}
+#else
+#define print_time_hist(...)
+#endif /* CONFIG_NET_PKT_TIME_STATS_HISTOGRAM */
+
 static void print_tc_tx_stats(const struct shell *shell, struct net_if *iface)
 {
 #if NET_TC_TX_COUNT > 1
 	int i;
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+	int j;
+#endif
 
 	PR("TX traffic class statistics:\n");
 
@@ -928,6 +996,17 @@ static void print_tc_tx_stats(const struct shell *shell, struct net_if *iface)
 					    tc.sent[i].tx_time.sum) /
 				   (uint64_t)count),
 			   get_net_pkt_tc_stats_detail(iface, i, true));
+
+			print_time_hist(shell, "TX", -1,
+					GET_STAT(iface,
+						 tc.sent[i].tx_time.hist));
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+			for (j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+				print_time_hist(shell, "TX", j,
+					GET_STAT(iface,
+					  tc.sent[i].tx_time_detail[j].hist));
+			}
+#endif
 		}
 	}
 #else
@@ -946,11 +1025,23 @@ static void print_tc_tx_stats(const struct shell *shell, struct net_if *iface)
 
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	net_stats_t count = GET_STAT(iface, tx_time.count);
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+	int j;
+#endif
 
 	if (count != 0) {
 		PR("Avg %s net_pkt (%u) time %lu us%s\n", "TX", count,
 		   (uint32_t)(GET_STAT(iface, tx_time.sum) / (uint64_t)count),
 		   get_net_pkt_stats_detail(iface, true));
+
+		print_time_hist(shell, "TX", -1,
+				GET_STAT(iface, tx_time.hist));
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+		for (j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+			print_time_hist(shell, "TX", j,
+				GET_STAT(iface, tx_time_detail[j].hist));
+		}
+#endif
 	}
 #else
 	ARG_UNUSED(iface);
@@ -962,6 +1053,9 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 {
 #if NET_TC_RX_COUNT > 1
 	int i;
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	int j;
+#endif
 
 	PR("RX traffic class statistics:\n");
 
@@ -987,6 +1081,17 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 					    tc.recv[i].rx_time.sum) /
 				   (uint64_t)count),
 			   get_net_pkt_tc_stats_detail(iface, i, false));
+
+			print_time_hist(shell, "RX", -1,
+					GET_STAT(iface,
+						 tc.recv[i].rx_time.hist));
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+			for (j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+				print_time_hist(shell, "RX", j,
+					GET_STAT(iface,
+					  tc.recv[i].rx_time_detail[j].hist));
+			}
+#endif
 		}
 	}
 #else
@@ -1005,11 +1110,23 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 
 #if defined(CONFIG_NET_PKT_RXTIME_STATS)
 	net_stats_t count = GET_STAT(iface, rx_time.count);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	int j;
+#endif
 
 	if (count != 0) {
 		PR("Avg %s net_pkt (%u) time %lu us%s\n", "RX", count,
 		   (uint32_t)(GET_STAT(iface, rx_time.sum) / (uint64_t)count),
 		   get_net_pkt_stats_detail(iface, false));
+
+		print_time_hist(shell, "RX", -1,
+				GET_STAT(iface, rx_time.hist));
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+		for (j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+			print_time_hist(shell, "RX", j,
+				GET_STAT(iface, rx_time_detail[j].hist));
+		}
+#endif
 	}
 #else
 	ARG_UNUSED(iface);
@@ -1049,6 +1166,8 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 		   iface2str(iface, &extra), net_if_get_by_iface(iface));
 		PR("===========================%s\n", extra);
 	} else {
+		net_stats_fold();
+
 		PR("\nGlobal statistics\n");
 		PR("=================\n");
 	}
@@ -1398,8 +1517,8 @@ static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 	struct net_shell_user_data *data = user_data;
 	const struct shell *shell = data->shell;
 	int *count = data->user_data;
+	struct net_reass_frag *reass_frag;
 	char src[ADDR_LEN];
-	int i;
 
 	if (!*count) {
 		PR("\nIPv6 reassembly Id         Remain "
@@ -1413,23 +1532,25 @@ static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 	   k_delayed_work_remaining_get(&reass->timer),
 	   src, net_sprint_ipv6_addr(&reass->dst));
 
-	for (i = 0; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			struct net_buf *frag = reass->pkt[i]->frags;
+	SYS_SLIST_FOR_EACH_CONTAINER(&reass->core.frags, reass_frag, node) {
+		struct net_buf *frag = reass_frag->buf;
 
-			PR("[%d] pkt %p->", i, reass->pkt[i]);
+		if (!frag) {
+			frag = reass->core.pkt->frags;
+		}
 
-			while (frag) {
-				PR("%p", frag);
+		PR("[%u] %u bytes->", reass_frag->offset, reass_frag->len);
 
-				frag = frag->frags;
-				if (frag) {
-					PR("->");
-				}
-			}
+		while (frag) {
+			PR("%p", frag);
 
-			PR("\n");
+			frag = frag->frags;
+			if (frag) {
+				PR("->");
+			}
 		}
+
+		PR("\n");
 	}
 
 	(*count)++;
@@ -1811,6 +1932,66 @@ static int cmd_net_dns_cancel(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void dns_cache_cb(const char *query, enum dns_query_type type,
+			 enum dns_resolve_status status,
+			 const struct dns_addrinfo *addrs, int count,
+			 uint32_t ttl, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *entries = data->user_data;
+	int i;
+
+	PR("%s %s ttl %u s%s\n", type == DNS_QUERY_TYPE_A ? "IPv4" : "IPv6",
+	   query, ttl, status == DNS_EAI_NODATA ? " (no such name)" : "");
+
+	for (i = 0; i < count; i++) {
+		if (addrs[i].ai_family == AF_INET) {
+			PR("\t%s\n", net_sprint_ipv4_addr(
+				   &net_sin(&addrs[i].ai_addr)->sin_addr));
+		} else if (addrs[i].ai_family == AF_INET6) {
+			PR("\t%s\n", net_sprint_ipv6_addr(
+				   &net_sin6(&addrs[i].ai_addr)->sin6_addr));
+		}
+	}
+
+	(*entries)++;
+}
+#endif
+
+static int cmd_net_dns_cache(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct net_shell_user_data user_data;
+	int entries = 0;
+
+	if (argv[1] && !strcmp(argv[1], "flush")) {
+		dns_resolve_cache_flush();
+		PR("DNS cache flushed.\n");
+		return 0;
+	}
+
+	user_data.shell = shell;
+	user_data.user_data = &entries;
+
+	dns_resolve_cache_foreach(dns_cache_cb, &user_data);
+
+	if (!entries) {
+		PR("DNS cache is empty.\n");
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *shell, size_t argc,
 			     char *argv[])
 {
@@ -4871,6 +5052,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_arp,
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, NULL,
+		  "'net dns cache' shows the cached names, "
+		  "'net dns cache flush' removes them.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
 	SHELL_CMD(query, NULL,
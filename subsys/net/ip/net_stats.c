@@ -29,6 +29,41 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+struct net_stats net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+/* The counters kept per CPU come first, all of them net_stats_t */
+#if NET_TC_COUNT > 1
+#define NET_STATS_CPU_END offsetof(struct net_stats, tc)
+#elif defined(CONFIG_NET_CONTEXT_TIMESTAMP) || \
+	defined(CONFIG_NET_PKT_TXTIME_STATS)
+#define NET_STATS_CPU_END offsetof(struct net_stats, tx_time)
+#elif defined(CONFIG_NET_PKT_RXTIME_STATS)
+#define NET_STATS_CPU_END offsetof(struct net_stats, rx_time)
+#elif defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
+#define NET_STATS_CPU_END offsetof(struct net_stats, pm)
+#else
+#define NET_STATS_CPU_END sizeof(struct net_stats)
+#endif
+
+void net_stats_fold(void)
+{
+	net_stats_t *counters = (net_stats_t *)&net_stats;
+	net_stats_t sum;
+	size_t i;
+	int cpu;
+
+	for (i = 0; i < NET_STATS_CPU_END / sizeof(net_stats_t); i++) {
+		sum = 0U;
+		for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			sum += ((net_stats_t *)&net_stats_cpu[cpu])[i];
+		}
+
+		counters[i] = sum;
+	}
+}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL (30 * MSEC_PER_SEC)
@@ -72,6 +107,8 @@ static inline void stats(struct net_if *iface)
 	int i;
 
 	if (!next_print || (abs(cmp) > PRINT_STATISTICS_INTERVAL)) {
+		net_stats_fold();
+
 		if (iface) {
 			NET_INFO("Interface %p [%d]", iface,
 				 net_if_get_by_iface(iface));
@@ -240,6 +277,8 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 	size_t len_chk = 0;
 	void *src = NULL;
 
+	net_stats_fold();
+
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
@@ -302,6 +341,24 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 		len_chk = sizeof(struct net_stats_pm);
 		src = GET_STAT_ADDR(iface, pm);
 		break;
+#endif
+#if defined(CONFIG_NET_PKT_TXTIME_STATS)
+	case NET_REQUEST_STATS_CMD_GET_TX_TIME:
+		len_chk = sizeof(struct net_stats_tx_time);
+		src = GET_STAT_ADDR(iface, tx_time);
+		break;
+#endif
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+	case NET_REQUEST_STATS_CMD_GET_RX_TIME:
+		len_chk = sizeof(struct net_stats_rx_time);
+		src = GET_STAT_ADDR(iface, rx_time);
+		break;
+#endif
+#if NET_TC_COUNT > 1
+	case NET_REQUEST_STATS_CMD_GET_TC:
+		len_chk = sizeof(struct net_stats_tc);
+		src = GET_STAT_ADDR(iface, tc);
+		break;
 #endif
 	}
 
@@ -361,6 +418,21 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_PKT_TXTIME_STATS)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_TX_TIME,
+				  net_stats_get);
+#endif
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_RX_TIME,
+				  net_stats_get);
+#endif
+
+#if NET_TC_COUNT > 1
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_TC,
+				  net_stats_get);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 void net_stats_reset(struct net_if *iface)
@@ -372,4 +444,7 @@ void net_stats_reset(struct net_if *iface)
 
 	net_if_stats_reset_all();
 	memset(&net_stats, 0, sizeof(net_stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	memset(net_stats_cpu, 0, sizeof(net_stats_cpu));
+#endif
 }
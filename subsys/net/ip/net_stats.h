@@ -31,35 +31,83 @@ extern struct net_stats net_stats;
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
 	  SET_STAT(_iface->_cmd); }
+
+/* The plain counters, from processing_error up to the traffic class and
+ * timing statistics, can be kept per CPU: each CPU then increments its own
+ * copy of the global ones, which net_stats_fold() sums into net_stats
+ * before they are read.
+ */
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+extern struct net_stats net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+/* Pasted with the command like net_stats in UPDATE_STAT_GLOBAL() */
+#define net_cpu_stats (net_stats_cpu[arch_curr_cpu()->id])
+
+#define UPDATE_COUNTER_GLOBAL(cmd) \
+	{ unsigned int _key = arch_irq_lock(); (net_cpu_##cmd); \
+	  arch_irq_unlock(_key); }
+
+void net_stats_fold(void);
+#else
+#define UPDATE_COUNTER_GLOBAL(cmd) UPDATE_STAT_GLOBAL(cmd)
+
+static inline void net_stats_fold(void) { }
+#endif
+
+#define UPDATE_COUNTER(_iface, _cmd) \
+	{ NET_ASSERT(_iface); UPDATE_COUNTER_GLOBAL(_cmd); \
+	  SET_STAT(_iface->_cmd); }
+
+#if defined(CONFIG_NET_PKT_TIME_STATS_HISTOGRAM)
+/* Bucket 0 is for times below 1 us, bucket n for times from 2^(n-1) us
+ * up to 2^n us and the last bucket for all the longer times.
+ */
+static inline int net_stats_time_hist_bucket(uint64_t usec)
+{
+	if (usec == 0U) {
+		return 0;
+	}
+
+	return MIN(64 - __builtin_clzll(usec),
+		   NET_STATS_TIME_HIST_BUCKETS - 1);
+}
+
+#define UPDATE_TIME_HIST(_iface, _time, _usec)				\
+	{ int _bucket = net_stats_time_hist_bucket(_usec);		\
+	  UPDATE_STAT(_iface, _time.hist[_bucket]++); }
+#else
+#define UPDATE_TIME_HIST(_iface, _time, _usec)
+#endif /* CONFIG_NET_PKT_TIME_STATS_HISTOGRAM */
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.processing_error++);
+	UPDATE_COUNTER(iface, stats.processing_error++);
 }
 
 static inline void net_stats_update_ip_errors_protoerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ip_errors.protoerr++);
+	UPDATE_COUNTER(iface, stats.ip_errors.protoerr++);
 }
 
 static inline void net_stats_update_ip_errors_vhlerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ip_errors.vhlerr++);
+	UPDATE_COUNTER(iface, stats.ip_errors.vhlerr++);
 }
 
 static inline void net_stats_update_bytes_recv(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.bytes.received += bytes);
+	UPDATE_COUNTER(iface, stats.bytes.received += bytes);
 }
 
 static inline void net_stats_update_bytes_sent(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.bytes.sent += bytes);
+	UPDATE_COUNTER(iface, stats.bytes.sent += bytes);
 }
 #else
+#define net_stats_fold()
 #define net_stats_update_processing_error(iface)
 #define net_stats_update_ip_errors_protoerr(iface)
 #define net_stats_update_ip_errors_vhlerr(iface)
@@ -72,17 +120,17 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 
 static inline void net_stats_update_ipv6_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.sent++);
+	UPDATE_COUNTER(iface, stats.ipv6.sent++);
 }
 
 static inline void net_stats_update_ipv6_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.recv++);
+	UPDATE_COUNTER(iface, stats.ipv6.recv++);
 }
 
 static inline void net_stats_update_ipv6_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.drop++);
+	UPDATE_COUNTER(iface, stats.ipv6.drop++);
 }
 #else
 #define net_stats_update_ipv6_drop(iface)
@@ -95,17 +143,17 @@ static inline void net_stats_update_ipv6_drop(struct net_if *iface)
 
 static inline void net_stats_update_ipv6_nd_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.sent++);
+	UPDATE_COUNTER(iface, stats.ipv6_nd.sent++);
 }
 
 static inline void net_stats_update_ipv6_nd_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.recv++);
+	UPDATE_COUNTER(iface, stats.ipv6_nd.recv++);
 }
 
 static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.drop++);
+	UPDATE_COUNTER(iface, stats.ipv6_nd.drop++);
 }
 #else
 #define net_stats_update_ipv6_nd_sent(iface)
@@ -118,17 +166,17 @@ static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 
 static inline void net_stats_update_ipv4_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.drop++);
+	UPDATE_COUNTER(iface, stats.ipv4.drop++);
 }
 
 static inline void net_stats_update_ipv4_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.sent++);
+	UPDATE_COUNTER(iface, stats.ipv4.sent++);
 }
 
 static inline void net_stats_update_ipv4_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.recv++);
+	UPDATE_COUNTER(iface, stats.ipv4.recv++);
 }
 #else
 #define net_stats_update_ipv4_drop(iface)
@@ -140,17 +188,17 @@ static inline void net_stats_update_ipv4_recv(struct net_if *iface)
 /* Common ICMPv4/ICMPv6 stats */
 static inline void net_stats_update_icmp_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.sent++);
+	UPDATE_COUNTER(iface, stats.icmp.sent++);
 }
 
 static inline void net_stats_update_icmp_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.recv++);
+	UPDATE_COUNTER(iface, stats.icmp.recv++);
 }
 
 static inline void net_stats_update_icmp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.drop++);
+	UPDATE_COUNTER(iface, stats.icmp.drop++);
 }
 #else
 #define net_stats_update_icmp_sent(iface)
@@ -162,22 +210,22 @@ static inline void net_stats_update_icmp_drop(struct net_if *iface)
 /* UDP stats */
 static inline void net_stats_update_udp_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.sent++);
+	UPDATE_COUNTER(iface, stats.udp.sent++);
 }
 
 static inline void net_stats_update_udp_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.recv++);
+	UPDATE_COUNTER(iface, stats.udp.recv++);
 }
 
 static inline void net_stats_update_udp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.drop++);
+	UPDATE_COUNTER(iface, stats.udp.drop++);
 }
 
 static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.chkerr++);
+	UPDATE_COUNTER(iface, stats.udp.chkerr++);
 }
 #else
 #define net_stats_update_udp_sent(iface)
@@ -190,73 +238,73 @@ static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 /* TCP stats */
 static inline void net_stats_update_tcp_sent(struct net_if *iface, uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.bytes.sent += bytes);
+	UPDATE_COUNTER(iface, stats.tcp.bytes.sent += bytes);
 }
 
 static inline void net_stats_update_tcp_recv(struct net_if *iface, uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.bytes.received += bytes);
+	UPDATE_COUNTER(iface, stats.tcp.bytes.received += bytes);
 }
 
 static inline void net_stats_update_tcp_resent(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.resent += bytes);
+	UPDATE_COUNTER(iface, stats.tcp.resent += bytes);
 }
 
 static inline void net_stats_update_tcp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.drop++);
+	UPDATE_COUNTER(iface, stats.tcp.drop++);
 }
 
 static inline void net_stats_update_tcp_seg_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.sent++);
+	UPDATE_COUNTER(iface, stats.tcp.sent++);
 }
 
 static inline void net_stats_update_tcp_seg_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.recv++);
+	UPDATE_COUNTER(iface, stats.tcp.recv++);
 }
 
 static inline void net_stats_update_tcp_seg_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.seg_drop++);
+	UPDATE_COUNTER(iface, stats.tcp.seg_drop++);
 }
 
 static inline void net_stats_update_tcp_seg_rst(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rst++);
+	UPDATE_COUNTER(iface, stats.tcp.rst++);
 }
 
 static inline void net_stats_update_tcp_seg_conndrop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.conndrop++);
+	UPDATE_COUNTER(iface, stats.tcp.conndrop++);
 }
 
 static inline void net_stats_update_tcp_seg_connrst(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.connrst++);
+	UPDATE_COUNTER(iface, stats.tcp.connrst++);
 }
 
 static inline void net_stats_update_tcp_seg_chkerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.chkerr++);
+	UPDATE_COUNTER(iface, stats.tcp.chkerr++);
 }
 
 static inline void net_stats_update_tcp_seg_ackerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.ackerr++);
+	UPDATE_COUNTER(iface, stats.tcp.ackerr++);
 }
 
 static inline void net_stats_update_tcp_seg_rsterr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rsterr++);
+	UPDATE_COUNTER(iface, stats.tcp.rsterr++);
 }
 
 static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rexmit++);
+	UPDATE_COUNTER(iface, stats.tcp.rexmit++);
 }
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
@@ -306,17 +354,17 @@ static inline void net_stats_update_per_proto_drop(struct net_if *iface,
 #if defined(CONFIG_NET_STATISTICS_MLD) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_update_ipv6_mld_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.recv++);
+	UPDATE_COUNTER(iface, stats.ipv6_mld.recv++);
 }
 
 static inline void net_stats_update_ipv6_mld_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.sent++);
+	UPDATE_COUNTER(iface, stats.ipv6_mld.sent++);
 }
 
 static inline void net_stats_update_ipv6_mld_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.drop++);
+	UPDATE_COUNTER(iface, stats.ipv6_mld.drop++);
 }
 #else
 #define net_stats_update_ipv6_mld_recv(iface)
@@ -331,10 +379,11 @@ static inline void net_stats_update_tx_time(struct net_if *iface,
 					    uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t usec = k_cyc_to_ns_floor64(diff) / 1000;
 
-	UPDATE_STAT(iface, stats.tx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.tx_time.sum += usec);
 	UPDATE_STAT(iface, stats.tx_time.count += 1);
+	UPDATE_TIME_HIST(iface, stats.tx_time, usec);
 }
 #else
 #define net_stats_update_tx_time(iface, start_time, end_time)
@@ -347,11 +396,11 @@ static inline void net_stats_update_tx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tx_time_detail[i].count += 1);
+		uint64_t usec = k_cyc_to_ns_floor64(detail_stat[i]) / 1000;
+
+		UPDATE_STAT(iface, stats.tx_time_detail[i].sum += usec);
+		UPDATE_STAT(iface, stats.tx_time_detail[i].count += 1);
+		UPDATE_TIME_HIST(iface, stats.tx_time_detail[i], usec);
 	}
 }
 #else
@@ -364,10 +413,11 @@ static inline void net_stats_update_rx_time(struct net_if *iface,
 					    uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t usec = k_cyc_to_ns_floor64(diff) / 1000;
 
-	UPDATE_STAT(iface, stats.rx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.rx_time.sum += usec);
 	UPDATE_STAT(iface, stats.rx_time.count += 1);
+	UPDATE_TIME_HIST(iface, stats.rx_time, usec);
 }
 #else
 #define net_stats_update_rx_time(iface, start_time, end_time)
@@ -380,11 +430,11 @@ static inline void net_stats_update_rx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.rx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.rx_time_detail[i].count += 1);
+		uint64_t usec = k_cyc_to_ns_floor64(detail_stat[i]) / 1000;
+
+		UPDATE_STAT(iface, stats.rx_time_detail[i].sum += usec);
+		UPDATE_STAT(iface, stats.rx_time_detail[i].count += 1);
+		UPDATE_TIME_HIST(iface, stats.rx_time_detail[i], usec);
 	}
 }
 #else
@@ -419,11 +469,12 @@ static inline void net_stats_update_tc_tx_time(struct net_if *iface,
 					       uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t usec = k_cyc_to_ns_floor64(diff) / 1000;
 	int tc = net_tx_priority2tc(priority);
 
-	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.sum += usec);
 	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.count += 1);
+	UPDATE_TIME_HIST(iface, stats.tc.sent[tc].tx_time, usec);
 
 	net_stats_update_tx_time(iface, start_time, end_time);
 }
@@ -440,11 +491,11 @@ static inline void net_stats_update_tc_tx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tc.sent[tc].tx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tc.sent[tc].tx_time_detail[i].count += 1);
+		uint64_t usec = k_cyc_to_ns_floor64(detail_stat[i]) / 1000;
+
+		UPDATE_STAT(iface, stats.tc.sent[tc].tx_time_detail[i].sum += usec);
+		UPDATE_STAT(iface, stats.tc.sent[tc].tx_time_detail[i].count += 1);
+		UPDATE_TIME_HIST(iface, stats.tc.sent[tc].tx_time_detail[i], usec);
 	}
 
 	net_stats_update_tx_time_detail(iface, detail_stat);
@@ -461,11 +512,12 @@ static inline void net_stats_update_tc_rx_time(struct net_if *iface,
 					       uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t usec = k_cyc_to_ns_floor64(diff) / 1000;
 	int tc = net_rx_priority2tc(priority);
 
-	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.sum += usec);
 	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.count += 1);
+	UPDATE_TIME_HIST(iface, stats.tc.recv[tc].rx_time, usec);
 
 	net_stats_update_rx_time(iface, start_time, end_time);
 }
@@ -482,11 +534,11 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.tc.recv[tc].rx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
-		UPDATE_STAT(iface,
-			    stats.tc.recv[tc].rx_time_detail[i].count += 1);
+		uint64_t usec = k_cyc_to_ns_floor64(detail_stat[i]) / 1000;
+
+		UPDATE_STAT(iface, stats.tc.recv[tc].rx_time_detail[i].sum += usec);
+		UPDATE_STAT(iface, stats.tc.recv[tc].rx_time_detail[i].count += 1);
+		UPDATE_TIME_HIST(iface, stats.tc.recv[tc].rx_time_detail[i], usec);
 	}
 
 	net_stats_update_rx_time_detail(iface, detail_stat);
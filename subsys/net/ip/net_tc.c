@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -21,19 +22,146 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With flow queues, ".z" is appended where z is the flow queue of the class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
 
 /* Stacks for TX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT * NET_TC_FLOW_QUEUES,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * NET_TC_FLOW_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
-static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The flow queues of traffic class tc are at index
+ * tc * NET_TC_FLOW_QUEUES .. tc * NET_TC_FLOW_QUEUES + NET_TC_FLOW_QUEUES - 1
+ */
+static struct net_traffic_class tx_classes[NET_TC_TX_COUNT *
+					   NET_TC_FLOW_QUEUES];
+static struct net_traffic_class rx_classes[NET_TC_RX_COUNT *
+					   NET_TC_FLOW_QUEUES];
+
+#if defined(CONFIG_NET_FLOW_STEERING)
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+static uint32_t flow_hash_add(uint32_t hash, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+
+	while (len--) {
+		hash = (hash ^ *p++) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/* Hash the IP addresses, the protocol and, when present in the packet,
+ * the TCP or UDP ports. Ports are left out of IPv4 fragments, so that all
+ * fragments of a datagram get the same hash. The parsing starts from the
+ * beginning of the packet, behind the Ethernet header if there is one.
+ */
+uint32_t net_tc_flow_hash(struct net_pkt *pkt, bool ethernet)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} hdr;
+	uint32_t hash = FNV_OFFSET_BASIS;
+	uint16_t ports[2];
+	bool has_ports;
+	uint8_t proto;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (ethernet) {
+		struct net_eth_hdr eth;
+		uint16_t type;
+
+		if (net_pkt_read(pkt, &eth, sizeof(eth))) {
+			goto out;
+		}
+
+		type = ntohs(eth.type);
+
+		if (type == NET_ETH_PTYPE_VLAN &&
+		    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+		     net_pkt_read_be16(pkt, &type))) {
+			goto out;
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			goto out;
+		}
+	}
+#else
+	ARG_UNUSED(ethernet);
+#endif
+
+	if (net_pkt_read(pkt, &hdr.ipv4, sizeof(hdr.ipv4))) {
+		goto out;
+	}
+
+	if ((hdr.ipv4.vhl & 0xf0) == 0x40) {
+		hash = flow_hash_add(hash, &hdr.ipv4.src,
+				     2 * sizeof(struct in_addr));
+		proto = hdr.ipv4.proto;
+		has_ports = !(hdr.ipv4.offset[0] & 0x3f) &&
+			    !hdr.ipv4.offset[1] &&
+			    !net_pkt_skip(pkt, ((hdr.ipv4.vhl & 0x0f) * 4) -
+					  sizeof(hdr.ipv4));
+	} else if ((hdr.ipv4.vhl & 0xf0) == 0x60) {
+		if (net_pkt_read(pkt, (uint8_t *)&hdr + sizeof(hdr.ipv4),
+				 sizeof(hdr.ipv6) - sizeof(hdr.ipv4))) {
+			goto out;
+		}
+
+		hash = flow_hash_add(hash, &hdr.ipv6.src,
+				     2 * sizeof(struct in6_addr));
+		proto = hdr.ipv6.nexthdr;
+		has_ports = true;
+	} else {
+		goto out;
+	}
+
+	hash = flow_hash_add(hash, &proto, sizeof(proto));
+
+	if (has_ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, ports, sizeof(ports))) {
+		hash = flow_hash_add(hash, ports, sizeof(ports));
+	}
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	/* Zero is reserved for packets that have not been hashed yet */
+	return hash ? hash : 1U;
+}
+#endif /* CONFIG_NET_FLOW_STEERING */
+
+/* Map the flow hash onto one of the flow queues of a traffic class. The
+ * hash is scaled rather than reduced modulo the number of queues, so
+ * that every bit of it contributes.
+ */
+static inline int tc_flow_queue(uint8_t tc, struct net_pkt *pkt)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	return tc * NET_TC_FLOW_QUEUES +
+		(int)(((uint64_t)net_pkt_flow_hash(pkt) *
+		       NET_TC_FLOW_QUEUES) >> 32);
+#else
+	ARG_UNUSED(pkt);
+
+	return tc;
+#endif
+}
 
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 {
@@ -43,16 +171,95 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 
 	net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
 
-	k_work_submit_to_queue(&tx_classes[tc].work_q, net_pkt_work(pkt));
+	k_work_submit_to_queue(&tx_classes[tc_flow_queue(tc, pkt)].work_q,
+			       net_pkt_work(pkt));
 
 	return true;
 }
 
+/* The TX queue of an interface always goes to the same flow queue of the
+ * class, so that its packets are sent in order.
+ */
+void net_tc_submit_iface_to_tx_queue(uint8_t tc, struct net_if *iface,
+				     struct k_work *work)
+{
+#if NET_TC_FLOW_QUEUES > 1
+	int queue = tc * NET_TC_FLOW_QUEUES +
+		(net_if_get_by_iface(iface) - 1) % NET_TC_FLOW_QUEUES;
+#else
+	int queue = tc;
+
+	ARG_UNUSED(iface);
+#endif
+
+	k_work_submit_to_queue(&tx_classes[queue].work_q, work);
+}
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+	k_work_submit_to_queue(&rx_classes[tc_flow_queue(tc, pkt)].work_q,
+			       net_pkt_work(pkt));
+}
+
+/* Index of the RX queue that handles the packet, see
+ * net_tc_submit_delayed_to_rx_queue()
+ */
+int net_tc_rx_queue(struct net_pkt *pkt)
+{
+	return tc_flow_queue(net_rx_priority2tc(net_pkt_priority(pkt)), pkt);
+}
+
+int net_tc_submit_delayed_to_rx_queue(uint8_t queue,
+				      struct k_delayed_work *work,
+				      k_timeout_t delay)
+{
+	return k_delayed_work_submit_to_queue(&rx_classes[queue].work_q, work,
+					      delay);
+}
+
+/* Packets that go to the same RX queue one after another are linked
+ * through their work items and appended with a single queue operation,
+ * marking each work item pending the same way k_work_submit_to_queue()
+ * does.
+ */
+void net_tc_submit_batch_to_rx_queue(struct net_pkt **pkts, int count)
+{
+	uint32_t tick = k_cycle_get_32();
+	int i = 0;
+
+	while (i < count) {
+		int queue = net_tc_rx_queue(pkts[i]);
+		struct k_work *head = NULL;
+		struct k_work *tail = NULL;
+
+		for (; i < count && net_tc_rx_queue(pkts[i]) == queue; i++) {
+			struct k_work *work = net_pkt_work(pkts[i]);
+
+			if (atomic_test_and_set_bit(work->flags,
+						    K_WORK_STATE_PENDING)) {
+				continue;
+			}
+
+			net_pkt_set_rx_stats_tick(pkts[i], tick);
+
+			work->_reserved = NULL;
+
+			if (tail) {
+				tail->_reserved = work;
+			} else {
+				head = work;
+			}
+
+			tail = work;
+		}
+
+		if (head) {
+			k_queue_append_list(&rx_classes[queue].work_q.queue,
+					    head, tail);
+		}
+	}
 }
 
 int net_tx_priority2tc(enum net_priority prio)
@@ -222,9 +429,9 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 }
 #endif
 
-/* Create workqueue for each traffic class we are using. All the network
- * traffic goes through these classes. There needs to be at least one traffic
- * class in the system.
+/* Create workqueue for each traffic class we are using, or for each flow
+ * queue of it. All the network traffic goes through these classes. There
+ * needs to be at least one traffic class in the system.
  */
 void net_tc_tx_init(void)
 {
@@ -236,10 +443,11 @@ void net_tc_tx_init(void)
 	net_if_foreach(net_tc_tx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_TX_COUNT; i++) {
+	for (i = 0; i < NET_TC_TX_COUNT * NET_TC_FLOW_QUEUES; i++) {
+		int tc = i / NET_TC_FLOW_QUEUES;
 		uint8_t thread_priority;
 
-		thread_priority = tx_tc2thread(i);
+		thread_priority = tx_tc2thread(tc);
 
 		NET_DBG("[%d] Starting TX queue %p stack size %zd "
 			"prio %d (%d)", i,
@@ -255,7 +463,13 @@ void net_tc_tx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "tx_q[%d]", i);
+			if (NET_TC_FLOW_QUEUES > 1) {
+				snprintk(name, sizeof(name), "tx_q[%d.%d]", tc,
+					 i % NET_TC_FLOW_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "tx_q[%d]", tc);
+			}
+
 			k_thread_name_set(&tx_classes[i].work_q.thread, name);
 		}
 	}
@@ -271,10 +485,11 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_COUNT * NET_TC_FLOW_QUEUES; i++) {
+		int tc = i / NET_TC_FLOW_QUEUES;
 		uint8_t thread_priority;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(tc);
 
 		NET_DBG("[%d] Starting RX queue %p stack size %zd "
 			"prio %d (%d)", i,
@@ -290,7 +505,13 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_TC_FLOW_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]", tc,
+					 i % NET_TC_FLOW_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", tc);
+			}
+
 			k_thread_name_set(&rx_classes[i].work_q.thread, name);
 		}
 	}
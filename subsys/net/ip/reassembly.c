@@ -0,0 +1,253 @@
+/** @file
+ * @brief IP fragment reassembly
+ *
+ * Fragment bookkeeping shared by IPv6 and IPv4 reassembly.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_reass, CONFIG_NET_REASSEMBLY_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+
+#include "reassembly.h"
+
+/* All the fragments held by the IPv6 and IPv4 reassemblies */
+static K_MEM_SLAB_DEFINE(reass_frags, sizeof(struct net_reass_frag),
+			 CONFIG_NET_REASSEMBLY_MAX_FRAGMENTS, 4);
+
+/* Pending reassemblies, oldest first */
+static sys_dlist_t reass_pending = SYS_DLIST_STATIC_INIT(&reass_pending);
+
+/* Fragments are added from the RX threads and released from the
+ * reassembly timeouts.
+ */
+static K_MUTEX_DEFINE(reass_lock);
+
+void net_reass_start(struct net_reass *reass,
+		     void (*evict)(struct net_reass *reass))
+{
+	sys_slist_init(&reass->frags);
+	reass->pkt = NULL;
+	reass->evict = evict;
+	reass->received = 0U;
+	reass->total_len = 0U;
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+	sys_dlist_append(&reass_pending, &reass->node);
+	k_mutex_unlock(&reass_lock);
+}
+
+static struct net_reass_frag *frag_alloc(struct net_reass *reass)
+{
+	struct net_reass_frag *frag;
+	struct net_reass *oldest;
+
+	if (!k_mem_slab_alloc(&reass_frags, (void **)&frag, K_NO_WAIT)) {
+		return frag;
+	}
+
+	/* Out of fragments: rather than letting every pending datagram
+	 * starve, give up the oldest one, which is the least likely to
+	 * ever complete.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(&reass_pending, oldest, node) {
+		if (oldest == reass || sys_slist_is_empty(&oldest->frags)) {
+			continue;
+		}
+
+		NET_DBG("Evicting reassembly %p (%u bytes)", oldest,
+			oldest->received);
+
+		oldest->evict(oldest);
+		break;
+	}
+
+	if (!k_mem_slab_alloc(&reass_frags, (void **)&frag, K_NO_WAIT)) {
+		return frag;
+	}
+
+	return NULL;
+}
+
+/* Remove the headers from the front of the buffers. The headers are
+ * dropped by moving the buffer data pointer so that the payload is not
+ * moved around.
+ */
+static struct net_buf *strip_headers(struct net_buf *buf, size_t len)
+{
+	while (buf && len) {
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			break;
+		}
+
+		len -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	return buf;
+}
+
+int net_reass_add(struct net_reass *reass, struct net_pkt *pkt,
+		  uint16_t hdr_len, uint16_t offset, uint16_t len, bool more)
+{
+	struct net_reass_frag *frag, *prev = NULL, *next;
+	uint32_t end = (uint32_t)offset + len;
+	int ret;
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	if (reass->total_len &&
+	    (end > reass->total_len || (!more && end != reass->total_len))) {
+		NET_DBG("Fragment %u-%u past the end %u", offset, end,
+			reass->total_len);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&reass->frags, next, node) {
+		if (next->offset >= offset) {
+			break;
+		}
+
+		prev = next;
+	}
+
+	if (next && next->offset == offset && next->len == len) {
+		NET_DBG("Duplicate fragment %u-%u", offset, end);
+		ret = -EALREADY;
+		goto out;
+	}
+
+	/* Overlapping fragments are not accepted (RFC 5722) */
+	if ((prev && prev->offset + prev->len > offset) ||
+	    (next && end > next->offset)) {
+		NET_DBG("Fragment %u-%u overlaps", offset, end);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (!more) {
+		frag = SYS_SLIST_PEEK_TAIL_CONTAINER(&reass->frags, frag, node);
+		if (frag && frag->offset + frag->len > end) {
+			NET_DBG("Data past the last fragment %u-%u", offset,
+				end);
+			ret = -EINVAL;
+			goto out;
+		}
+	}
+
+	frag = frag_alloc(reass);
+	if (!frag) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	frag->offset = offset;
+	frag->len = len;
+
+	if (offset == 0U) {
+		frag->buf = NULL;
+		reass->pkt = pkt;
+	} else {
+		/* Only the payload is kept, free the packet right away */
+		frag->buf = strip_headers(pkt->buffer, hdr_len);
+		pkt->buffer = NULL;
+		net_pkt_unref(pkt);
+	}
+
+	if (prev) {
+		sys_slist_insert(&reass->frags, &prev->node, &frag->node);
+	} else {
+		sys_slist_prepend(&reass->frags, &frag->node);
+	}
+
+	if (!more) {
+		reass->total_len = end;
+	}
+
+	reass->received += len;
+
+	NET_DBG("Fragment %u-%u, %u/%u bytes", offset, end, reass->received,
+		reass->total_len);
+
+	ret = (reass->received == reass->total_len) ? 1 : 0;
+
+out:
+	k_mutex_unlock(&reass_lock);
+
+	return ret;
+}
+
+struct net_pkt *net_reass_finish(struct net_reass *reass)
+{
+	struct net_reass_frag *frag, *next;
+	struct net_buf *last;
+	struct net_pkt *pkt;
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	pkt = reass->pkt;
+	reass->pkt = NULL;
+
+	NET_ASSERT(pkt);
+
+	last = net_buf_frag_last(pkt->buffer);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&reass->frags, frag, next, node) {
+		if (frag->buf) {
+			last->frags = frag->buf;
+			last = net_buf_frag_last(frag->buf);
+		}
+
+		k_mem_slab_free(&reass_frags, (void **)&frag);
+	}
+
+	sys_slist_init(&reass->frags);
+	reass->received = 0U;
+	reass->total_len = 0U;
+
+	sys_dlist_remove(&reass->node);
+
+	k_mutex_unlock(&reass_lock);
+
+	return pkt;
+}
+
+void net_reass_release(struct net_reass *reass)
+{
+	struct net_reass_frag *frag, *next;
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	if (reass->pkt) {
+		net_pkt_unref(reass->pkt);
+		reass->pkt = NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&reass->frags, frag, next, node) {
+		if (frag->buf) {
+			net_buf_unref(frag->buf);
+		}
+
+		k_mem_slab_free(&reass_frags, (void **)&frag);
+	}
+
+	sys_slist_init(&reass->frags);
+	reass->received = 0U;
+	reass->total_len = 0U;
+
+	if (sys_dnode_is_linked(&reass->node)) {
+		sys_dlist_remove(&reass->node);
+	}
+
+	k_mutex_unlock(&reass_lock);
+}
@@ -0,0 +1,136 @@
+/** @file
+ * @brief IP fragment reassembly
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __REASSEMBLY_H
+#define __REASSEMBLY_H
+
+#include <kernel.h>
+#include <sys/slist.h>
+#include <sys/dlist.h>
+
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fragment held for reassembly.
+ *
+ * Only the fragment payload is kept, the IP headers have been removed
+ * from the buffers and the net_pkt has been released already.
+ */
+struct net_reass_frag {
+	/** Link in the fragment list of the reassembly */
+	sys_snode_t node;
+
+	/** Fragment payload, NULL for the first fragment as its payload
+	 * is kept in the reassembly head packet.
+	 */
+	struct net_buf *buf;
+
+	/** Offset of the payload in the original datagram */
+	uint16_t offset;
+
+	/** Length of the payload */
+	uint16_t len;
+};
+
+/**
+ * @brief Protocol independent part of a pending reassembly.
+ *
+ * The fragments are kept sorted by offset and overlapping fragments are
+ * rejected, so the datagram is complete as soon as the amount of payload
+ * received equals its total length. There is no need to keep an explicit
+ * list of holes (RFC 815) for that.
+ */
+struct net_reass {
+	/** Link in the list of pending reassemblies, oldest first */
+	sys_dnode_t node;
+
+	/** Received fragments, ordered by offset */
+	sys_slist_t frags;
+
+	/** The fragment at offset 0, its headers are used for the
+	 * reassembled datagram.
+	 */
+	struct net_pkt *pkt;
+
+	/** Called when the reassembly is evicted to make room for
+	 * fragments of another datagram.
+	 */
+	void (*evict)(struct net_reass *reass);
+
+	/** Amount of payload received */
+	uint32_t received;
+
+	/** Total payload length, 0 until the last fragment is received */
+	uint32_t total_len;
+};
+
+/**
+ * @brief Start a new reassembly.
+ *
+ * @param reass Reassembly to start
+ * @param evict Function that cancels the reassembly when its fragments
+ * are needed for another datagram. It must call net_reass_release().
+ */
+void net_reass_start(struct net_reass *reass,
+		     void (*evict)(struct net_reass *reass));
+
+/**
+ * @brief Add a fragment to a reassembly.
+ *
+ * On success the packet is owned by the reassembly. The IP headers are
+ * stripped from all but the first fragment, whose packet becomes the
+ * head of the reassembled datagram.
+ *
+ * @param reass Pending reassembly
+ * @param pkt Fragment
+ * @param hdr_len Length of the headers preceding the fragment payload
+ * @param offset Offset of the fragment payload in the datagram
+ * @param len Length of the fragment payload
+ * @param more True if more fragments follow this one
+ *
+ * @return 1 if the datagram is complete, 0 if more fragments are needed,
+ * -EALREADY if the fragment is a duplicate, -ENOMEM if there is no room
+ * for the fragment, -EINVAL if the fragment is inconsistent with the
+ * ones already received and the reassembly must be cancelled. In the
+ * error cases the packet is not consumed.
+ */
+int net_reass_add(struct net_reass *reass, struct net_pkt *pkt,
+		  uint16_t hdr_len, uint16_t offset, uint16_t len, bool more);
+
+/**
+ * @brief Complete a reassembly.
+ *
+ * Chains the payload of all the fragments to the first fragment without
+ * copying them. The reassembly is released.
+ *
+ * @param reass Complete reassembly
+ *
+ * @return The first fragment with all the payload appended to it.
+ */
+struct net_pkt *net_reass_finish(struct net_reass *reass);
+
+/**
+ * @brief Release all the fragments of a reassembly.
+ *
+ * @param reass Reassembly to release
+ */
+void net_reass_release(struct net_reass *reass);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REASSEMBLY_H */
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <limits.h>
 #include <zephyr/types.h>
 #include <sys/slist.h>
+#include <sys/math_extras.h>
 
 #include <net/net_pkt.h>
 #include <net/net_core.h>
@@ -36,7 +37,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
@@ -253,12 +254,312 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Routes are indexed by a path compressed binary trie of their prefixes.
+ * The children of a node extend its prefix, child[b] having b as the
+ * next bit. Nodes without routes are only kept where two branches meet,
+ * so N prefixes need less than 2N nodes.
+ */
+struct route_lpm_node {
+	struct route_lpm_node *parent;
+	struct route_lpm_node *child[2];
+
+	/* Routes to this prefix, one per interface */
+	struct net_route_entry *routes;
+
+	struct in6_addr prefix;
+	uint8_t len;
+};
+
+K_MEM_SLAB_DEFINE(route_lpm_slab, sizeof(struct route_lpm_node),
+		  2 * CONFIG_NET_MAX_ROUTES, 4);
+
+static struct route_lpm_node *lpm_root;
+
+static inline int lpm_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8] >> (7 - pos % 8)) & 1;
+}
+
+/* Length of the common prefix of a and b, at most max bits */
+static uint8_t lpm_common_len(const struct in6_addr *a,
+			      const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(a->s6_addr) && len < max; i++, len += 8) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			len += u32_count_leading_zeros(diff) - 24;
+			break;
+		}
+	}
+
+	return MIN(len, max);
+}
+
+static inline bool lpm_node_match(struct route_lpm_node *node,
+				  const struct in6_addr *addr)
+{
+	return lpm_common_len(&node->prefix, addr, node->len) == node->len;
+}
+
+static inline struct route_lpm_node **lpm_link(struct route_lpm_node *node)
+{
+	struct route_lpm_node *parent = node->parent;
+
+	if (!parent) {
+		return &lpm_root;
+	}
+
+	return &parent->child[parent->child[1] == node];
+}
+
+static struct route_lpm_node *lpm_node_alloc(const struct in6_addr *prefix,
+					     uint8_t len,
+					     struct route_lpm_node *parent)
+{
+	struct route_lpm_node *node;
+
+	if (k_mem_slab_alloc(&route_lpm_slab, (void **)&node, K_NO_WAIT)) {
+		return NULL;
+	}
+
+	(void)memset(node, 0, sizeof(*node));
+
+	net_ipaddr_copy(&node->prefix, prefix);
+	if (len < 128) {
+		node->prefix.s6_addr[len / 8] &= ~(0xff >> (len % 8));
+		(void)memset(&node->prefix.s6_addr[len / 8 + 1], 0,
+			     15 - len / 8);
+	}
+
+	node->len = len;
+	node->parent = parent;
+
+	return node;
+}
+
+static inline void lpm_node_free(struct route_lpm_node *node)
+{
+	k_mem_slab_free(&route_lpm_slab, (void **)&node);
+}
+
+/* Find the node of a prefix, creating it if needed */
+static struct route_lpm_node *lpm_node_get(const struct in6_addr *prefix,
+					   uint8_t len)
+{
+	struct route_lpm_node **link = &lpm_root;
+	struct route_lpm_node *parent = NULL;
+	struct route_lpm_node *node, *new, *glue;
+	uint8_t common;
+
+	while ((node = *link) != NULL) {
+		common = lpm_common_len(&node->prefix, prefix,
+					MIN(node->len, len));
+		if (common == node->len) {
+			if (node->len == len) {
+				return node;
+			}
+
+			parent = node;
+			link = &node->child[lpm_bit(prefix, node->len)];
+			continue;
+		}
+
+		/* The prefix branches off above this node */
+		new = lpm_node_alloc(prefix, len, parent);
+		if (!new) {
+			return NULL;
+		}
+
+		if (common == len) {
+			new->child[lpm_bit(&node->prefix, len)] = node;
+			node->parent = new;
+			*link = new;
+
+			return new;
+		}
+
+		glue = lpm_node_alloc(prefix, common, parent);
+		if (!glue) {
+			lpm_node_free(new);
+			return NULL;
+		}
+
+		glue->child[lpm_bit(prefix, common)] = new;
+		glue->child[lpm_bit(&node->prefix, common)] = node;
+		new->parent = glue;
+		node->parent = glue;
+		*link = glue;
+
+		return new;
+	}
+
+	new = lpm_node_alloc(prefix, len, parent);
+	if (new) {
+		*link = new;
+	}
+
+	return new;
+}
+
+/* Free nodes left without routes that no longer join two branches */
+static void lpm_node_put(struct route_lpm_node *node)
+{
+	while (node && !node->routes &&
+	       !(node->child[0] && node->child[1])) {
+		struct route_lpm_node *parent = node->parent;
+		struct route_lpm_node *child;
+
+		child = node->child[0] ? node->child[0] : node->child[1];
+		if (child) {
+			child->parent = parent;
+		}
+
+		*lpm_link(node) = child;
+		lpm_node_free(node);
+
+		node = parent;
+	}
+}
+
+static struct route_lpm_node *lpm_node_find(const struct in6_addr *prefix,
+					    uint8_t len)
+{
+	struct route_lpm_node *node = lpm_root;
+
+	while (node && node->len <= len && lpm_node_match(node, prefix)) {
+		if (node->len == len) {
+			return node;
+		}
+
+		node = node->child[lpm_bit(prefix, node->len)];
+	}
+
+	return NULL;
+}
+
+static int lpm_insert(struct net_route_entry *route)
+{
+	struct route_lpm_node *node;
+
+	node = lpm_node_get(&route->addr, route->prefix_len);
+	if (!node) {
+		return -ENOMEM;
+	}
+
+	route->lpm_next = node->routes;
+	node->routes = route;
+
+	return 0;
+}
+
+static void lpm_remove(struct net_route_entry *route)
+{
+	struct net_route_entry **prev;
+	struct route_lpm_node *node;
+
+	node = lpm_node_find(&route->addr, route->prefix_len);
+	if (!node) {
+		return;
+	}
+
+	for (prev = &node->routes; *prev; prev = &(*prev)->lpm_next) {
+		if (*prev == route) {
+			*prev = route->lpm_next;
+			break;
+		}
+	}
+
+	lpm_node_put(node);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	struct net_route_entry *route = NULL;
+	struct route_lpm_node *node;
+
+	node = lpm_node_find(addr, prefix_len);
+	if (node) {
+		for (route = node->routes; route; route = route->lpm_next) {
+			if (route->iface == iface) {
+				break;
+			}
+		}
+	}
+
+	return route;
+}
+
+/* Walk down the path of dst, the last route met is the longest match */
+static struct net_route_entry *route_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
+{
+	struct net_route_entry *route, *found = NULL;
+	struct route_lpm_node *node = lpm_root;
+
+	while (node && lpm_node_match(node, dst)) {
+		for (route = node->routes; route; route = route->lpm_next) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len == 128) {
+			break;
+		}
+
+		node = node->child[lpm_bit(dst, node->len)];
+	}
+
+	return found;
+}
+#else
+static inline int lpm_insert(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+
+	return 0;
+}
+
+static inline void lpm_remove(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+		struct net_route_entry *route = net_route_data(nbr);
+
+		if (nbr->ref && nbr->iface == iface &&
+		    route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+static struct net_route_entry *route_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
@@ -286,6 +587,95 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Last routes found for some destinations of each interface */
+static struct route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+} route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static inline struct route_cache_entry *route_cache_slot(struct net_if *iface,
+							 struct in6_addr *dst)
+{
+	uint32_t hash = UNALIGNED_GET(&dst->s6_addr32[2]) ^
+			UNALIGNED_GET(&dst->s6_addr32[3]) ^
+			POINTER_TO_UINT(iface);
+
+	hash ^= hash >> 16;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->route && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_store(struct net_if *iface, struct in6_addr *dst,
+			      struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	entry->iface = iface;
+	entry->route = route;
+	net_ipaddr_copy(&entry->dst, dst);
+}
+
+/* Any change of the routes may change the best match of a destination */
+static inline void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+static inline struct net_route_entry *route_cache_lookup(struct net_if *iface,
+							 struct in6_addr *dst)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+
+	return NULL;
+}
+
+static inline void route_cache_store(struct net_if *iface,
+				     struct in6_addr *dst,
+				     struct net_route_entry *route)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(route);
+}
+
+static inline void route_cache_flush(void)
+{
+}
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	found = route_cache_lookup(iface, dst);
+	if (!found) {
+		found = route_lookup(iface, dst);
+		if (found) {
+			route_cache_store(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -333,7 +723,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		log_strdup(net_sprint_ll_addr(nexthop_lladdr->addr,
 					      nexthop_lladdr->len)));
 
-	route = net_route_lookup(iface, addr);
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -353,9 +743,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -401,7 +791,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -412,6 +802,14 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	if (lpm_insert(route) < 0) {
+		NET_ERR("Route index full!");
+		net_route_del(route);
+		return NULL;
+	}
+
+	route_cache_flush();
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -454,21 +852,28 @@ int net_route_del(struct net_route_entry *route)
 	net_mgmt_event_notify(NET_EVENT_IPV6_ROUTE_DEL, route->iface);
 #endif
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		return -ENOENT;
 	}
 
+	lpm_remove(route);
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
-		if (!nexthop_route->nbr) {
-			continue;
+		if (nexthop_route->nbr) {
+			nbr_nexthop_put(nexthop_route->nbr);
 		}
 
-		nbr_nexthop_put(nexthop_route->nbr);
+		/* Give the nexthop entry back to its pool */
+		net_nbr_unref(CONTAINER_OF((uint8_t *)nexthop_route,
+					   struct net_nbr, __nbr));
 	}
 
 	nbr_free(nbr);
@@ -15,16 +15,21 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <net/net_pkt.h>
 #include <net/net_context.h>
 #include <net/udp.h>
+#include <net/ethernet.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp2_priv.h"
+#include "tcp2_cc.h"
 
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
 
+#define TCP_DUP_ACK_THRESHOLD 3
+#define TCP_CWND_MAX ((uint32_t)UINT16_MAX << TCP_WSCALE_MAX)
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_window = NET_IPV6_MTU;
@@ -34,6 +39,15 @@ static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
+#if CONFIG_NET_TCP_CONN_HASH_SIZE > 0
+struct tcp_conn_bucket {
+	struct k_spinlock lock;
+	sys_slist_t conns;
+};
+
+static struct tcp_conn_bucket tcp_conn_hash[CONFIG_NET_TCP_CONN_HASH_SIZE];
+#endif
+
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
@@ -120,6 +134,75 @@ static size_t tcp_endpoint_len(sa_family_t af)
 		sizeof(struct sockaddr_in6);
 }
 
+#if CONFIG_NET_TCP_CONN_HASH_SIZE > 0
+/* FNV-1a over the local and remote endpoints. The endpoints are always
+ * zero filled before being set, so hashing the raw bytes is consistent
+ * with the memcmp() done by the lookup.
+ */
+static uint16_t tcp_conn_hash_bucket(const union tcp_endpoint *src,
+				     const union tcp_endpoint *dst)
+{
+	size_t len = tcp_endpoint_len(src->sa.sa_family);
+	const uint8_t *p;
+	uint32_t hash = 2166136261U;
+	size_t i;
+
+	for (p = (const uint8_t *)src, i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	for (p = (const uint8_t *)dst, i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash % CONFIG_NET_TCP_CONN_HASH_SIZE;
+}
+
+static void tcp_conn_hash_del(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	if (!conn->in_hash) {
+		return;
+	}
+
+	bucket = &tcp_conn_hash[conn->hash_bucket];
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_find_and_remove(&bucket->conns, &conn->hash_next);
+	conn->in_hash = false;
+	k_spin_unlock(&bucket->lock, key);
+}
+
+/* Must be called whenever conn->src and conn->dst have been (re)set */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	tcp_conn_hash_del(conn);
+
+	conn->hash_bucket = tcp_conn_hash_bucket(&conn->src, &conn->dst);
+	bucket = &tcp_conn_hash[conn->hash_bucket];
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_append(&bucket->conns, &conn->hash_next);
+	conn->in_hash = true;
+	k_spin_unlock(&bucket->lock, key);
+}
+#else
+static inline void tcp_conn_hash_del(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static inline void tcp_conn_hash_add(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH_SIZE > 0 */
+
 static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 			    enum pkt_addr src)
 {
@@ -379,6 +462,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_delayed_work_cancel(&conn->timewait_timer);
 	k_delayed_work_cancel(&conn->fin_timer);
 
+	tcp_conn_hash_del(conn);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
 	memset(conn, 0, sizeof(*conn));
@@ -554,8 +638,32 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+static bool tcp_options_sack(struct tcp_options *recv_options,
+			     uint8_t *options, uint8_t opt_len)
+{
+	int i;
+
+	if (opt_len < 10 || ((opt_len - 2) % 8) != 0) {
+		return false;
+	}
+
+	recv_options->sack_cnt = MIN((opt_len - 2) / 8, TCP_SACK_BLOCKS);
+
+	for (i = 0; i < recv_options->sack_cnt; i++) {
+		recv_options->sack[i].start =
+			ntohl(UNALIGNED_GET((uint32_t *)(options + 2 + i * 8)));
+		recv_options->sack[i].end =
+			ntohl(UNALIGNED_GET((uint32_t *)(options + 6 + i * 8)));
+	}
+
+	return true;
+}
+
+/* MSS, window scale and SACK permitted are only valid in SYN segments,
+ * so they are only updated when syn is set and kept otherwise.
+ */
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -565,8 +673,13 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+
+	recv_options->sack_cnt = 0;
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -599,6 +712,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -610,8 +727,29 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2], TCP_WSCALE_MAX);
 			recv_options->wnd_found = true;
+			NET_DBG("WSCALE=%hu", recv_options->window);
+			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+		case TCPOPT_SACK:
+			if (!tcp_options_sack(recv_options, options, opt_len)) {
+				result = false;
+				goto end;
+			}
 			break;
 		default:
 			continue;
@@ -677,11 +815,50 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window scale and SACK permitted are offered in a SYN and, in a SYN-ACK,
+ * only echoed if the peer offered them.
+ */
+static size_t tcp_syn_options(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	size_t len = 0;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (!(flags & ACK) || conn->wscale_ok)) {
+		opts[len++] = TCPOPT_NOP;
+		opts[len++] = TCPOPT_WINDOW;
+		opts[len++] = 3;
+		opts[len++] = conn->rcv_wscale;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (!(flags & ACK) || conn->sack_ok)) {
+		opts[len++] = TCPOPT_NOP;
+		opts[len++] = TCPOPT_NOP;
+		opts[len++] = TCPOPT_SACK_PERM;
+		opts[len++] = 2;
+	}
+
+	return len;
+}
+
+static uint16_t tcp_recv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	/* The window in a SYN segment is never scaled */
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, const uint8_t *opts, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -693,16 +870,21 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 	th->th_sport = conn->src.sin.sin_port;
 	th->th_dport = conn->dst.sin.sin_port;
 
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 	th->th_flags = flags;
-	th->th_win = htons(conn->recv_win);
+	th->th_win = htons(tcp_recv_win(conn, flags));
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
 		th->th_ack = htonl(conn->ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0 || !opts_len) {
+		return ret;
+	}
+
+	return net_pkt_write(pkt, opts, opts_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -725,10 +907,16 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t opts[8];
+	size_t opts_len = 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	if (flags & SYN) {
+		opts_len = tcp_syn_options(conn, flags, opts);
+	}
+
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -737,6 +925,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_tso_size(pkt, net_pkt_tso_size(data));
+		if (net_pkt_payload_csum(data)) {
+			net_pkt_set_payload_csum(pkt,
+						 net_pkt_payload_csum(data));
+		}
+
 		data->buffer = NULL;
 	}
 
@@ -746,7 +940,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -808,12 +1002,119 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 		net_pkt_skip(from, pos);
 	}
 
+	/* Sum the payload while copying it, the checksum of the segment
+	 * then only needs to sum the headers.
+	 */
+	if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY) &&
+	    net_if_need_calc_tx_checksum(net_pkt_iface(to))) {
+		struct net_pkt_csum csum = { 0 };
+		int ret;
+
+		ret = net_pkt_copy_csum(to, from, len, &csum);
+		if (ret == 0) {
+			net_pkt_set_payload_csum(to, &csum);
+		}
+
+		return ret;
+	}
+
 	return net_pkt_copy(to, from, len);
 }
 
+/* Make the to packet reference len bytes of the from packet, starting at
+ * pos, by cloning the fragments. The data of variable sized buffers is
+ * reference counted, so the payload itself is not copied.
+ */
+static int tcp_pkt_ref_range(struct net_pkt *to, struct net_pkt *from,
+			     size_t pos, size_t len)
+{
+	struct net_buf *frag, *clone;
+	size_t frag_len;
+
+	for (frag = from->buffer; frag && len > 0; frag = frag->frags) {
+		if (pos >= frag->len) {
+			pos -= frag->len;
+			continue;
+		}
+
+		clone = net_buf_clone(frag, TCP_PKT_ALLOC_TIMEOUT);
+		if (!clone) {
+			return -ENOBUFS;
+		}
+
+		net_buf_pull(clone, pos);
+		frag_len = MIN(len, clone->len);
+		clone->len = frag_len;
+
+		net_pkt_append_buffer(to, clone);
+
+		len -= frag_len;
+		pos = 0;
+	}
+
+	return len ? -EINVAL : 0;
+}
+
+/* Get a packet holding len bytes of the queued send data at offset pos.
+ * Fixed size buffers cannot share their data, so for those the payload
+ * is copied instead.
+ */
+static struct net_pkt *tcp_send_data_get(struct tcp *conn, size_t pos,
+					 size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_BUF_VARIABLE_DATA_SIZE)) {
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (!pkt) {
+			return NULL;
+		}
+
+		net_pkt_set_iface(pkt, conn->iface);
+
+		ret = tcp_pkt_ref_range(pkt, conn->send_data, pos, len);
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+		if (!pkt) {
+			return NULL;
+		}
+
+		ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
+	}
+
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static bool tcp_tso_enabled(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	return conn->iface &&
+		net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET) &&
+		(net_eth_get_hw_capabilities(conn->iface) & ETHERNET_HW_TSO);
+#else
+	ARG_UNUSED(conn);
+
+	return false;
+#endif
+}
+
+/* The amount of unacknowledged data is bounded by both the peer's receive
+ * window and the congestion window.
+ */
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+	return MIN(conn->send_win, conn->cwnd);
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -838,36 +1139,26 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of the queued data starting at offset pos */
+static int tcp_send_segment(struct tcp *conn, int pos, int len, bool rexmit)
 {
 	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-
-	pkt = tcp_pkt_alloc(conn, len);
+	pkt = tcp_send_data_get(conn, pos, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+	if (len > conn_mss(conn) && tcp_tso_enabled(conn)) {
+		net_pkt_set_tso_size(pkt, conn_mss(conn));
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (rexmit) {
 			net_stats_update_tcp_resent(net_pkt_iface(pkt), len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -882,9 +1173,37 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+ out:
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret;
+	int len, seg_len;
+
+	/* With segmentation offload the driver cuts the data into MSS
+	 * sized segments, so hand it as much as the window allows.
+	 */
+	seg_len = conn_mss(conn);
+#if defined(CONFIG_NET_TCP_TSO)
+	if (tcp_tso_enabled(conn)) {
+		seg_len = CONFIG_NET_TCP_TSO_MAX_SIZE;
+	}
+#endif
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   seg_len);
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
- out:
 	return ret;
 }
 
@@ -936,6 +1255,276 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Add a block to the SACK scoreboard, which is kept sorted and free of
+ * overlapping blocks. If it is full, the highest block is dropped.
+ */
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block blocks[TCP_SACK_BLOCKS + 1];
+	bool added = false;
+	int i, cnt = 0;
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block *b = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(b->start, end) <= 0 &&
+		    net_tcp_seq_cmp(b->end, start) >= 0) {
+			if (net_tcp_seq_cmp(b->start, start) < 0) {
+				start = b->start;
+			}
+
+			if (net_tcp_seq_cmp(b->end, end) > 0) {
+				end = b->end;
+			}
+
+			continue;
+		}
+
+		if (!added && net_tcp_seq_cmp(end, b->start) < 0) {
+			blocks[cnt].start = start;
+			blocks[cnt++].end = end;
+			added = true;
+		}
+
+		blocks[cnt++] = *b;
+	}
+
+	if (!added) {
+		blocks[cnt].start = start;
+		blocks[cnt++].end = end;
+	}
+
+	conn->sacked_cnt = MIN(cnt, TCP_SACK_BLOCKS);
+	memcpy(conn->sacked, blocks, conn->sacked_cnt * sizeof(blocks[0]));
+}
+
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	int i;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (i = 0; i < opts->sack_cnt; i++) {
+		uint32_t start = opts->sack[i].start;
+		uint32_t end = opts->sack[i].end;
+
+		/* Ignore blocks which are acked or were never sent */
+		if (net_tcp_seq_cmp(start, end) >= 0 ||
+		    net_tcp_seq_cmp(end, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(end, snd_nxt) > 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		tcp_sack_add(conn, start, end);
+	}
+}
+
+/* Drop the parts of the scoreboard covered by the cumulative ACK */
+static void tcp_sack_trim(struct tcp *conn)
+{
+	int i, cnt = 0;
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block *b = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(b->end, conn->seq) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(b->start, conn->seq) < 0) {
+			b->start = conn->seq;
+		}
+
+		conn->sacked[cnt++] = *b;
+	}
+
+	conn->sacked_cnt = cnt;
+}
+
+static void tcp_sack_clear(struct tcp *conn)
+{
+	conn->sacked_cnt = 0;
+}
+
+/* Find the next hole below the highest SACKed sequence number that has not
+ * been retransmitted in this recovery yet. The offset and length are
+ * relative to the start of the queued data.
+ */
+static bool tcp_sack_next_hole(struct tcp *conn, uint32_t *pos,
+			       uint32_t *len)
+{
+	uint32_t from = conn->sack_rexmit;
+	int i;
+
+	if (net_tcp_seq_cmp(from, conn->seq) < 0) {
+		from = conn->seq;
+	}
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block *b = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(from, b->start) < 0) {
+			*pos = from - conn->seq;
+			*len = MIN(b->start - from, conn_mss(conn));
+			conn->sack_rexmit = from + *len;
+			return true;
+		}
+
+		if (net_tcp_seq_cmp(from, b->end) < 0) {
+			from = b->end;
+		}
+	}
+
+	return false;
+}
+
+static bool tcp_sack_empty(struct tcp *conn)
+{
+	return conn->sacked_cnt == 0;
+}
+#else
+static inline void tcp_sack_update(struct tcp *conn) { }
+static inline void tcp_sack_trim(struct tcp *conn) { }
+static inline void tcp_sack_clear(struct tcp *conn) { }
+static inline bool tcp_sack_next_hole(struct tcp *conn, uint32_t *pos,
+				      uint32_t *len)
+{
+	return false;
+}
+static inline bool tcp_sack_empty(struct tcp *conn)
+{
+	return true;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Take the options of the peer's SYN into use */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		conn->recv_options.wnd_found;
+	conn->snd_wscale = conn->wscale_ok ? conn->recv_options.window : 0;
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		conn->recv_options.sack_perm_found;
+
+	/* The initial window depends on the MSS of the peer */
+	tcp_cc->init(conn);
+}
+
+/* Retransmit the first segment that is presumed lost. Without SACK
+ * information that is the head of the queued data.
+ */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	uint32_t pos = 0, len = MIN(conn_mss(conn), conn->unacked_len);
+
+	if (!tcp_sack_empty(conn) && !tcp_sack_next_hole(conn, &pos, &len)) {
+		return;
+	}
+
+	if (len == 0) {
+		return;
+	}
+
+	NET_DBG("conn: %p retransmit pos=%u len=%u", conn, pos, len);
+
+	(void)tcp_send_segment(conn, pos, len, true);
+}
+
+/* RFC 5681 and RFC 6582, enter fast recovery after three duplicate ACKs */
+static void tcp_dup_ack(struct tcp *conn)
+{
+	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	if (conn->in_recovery) {
+		/* Each duplicate ACK tells that a segment has left the
+		 * network, which allows one more segment to be sent.
+		 */
+		conn->cwnd = MIN(conn->cwnd + conn_mss(conn), TCP_CWND_MAX);
+
+		if (!tcp_sack_empty(conn)) {
+			tcp_fast_retransmit(conn);
+		}
+
+		(void)tcp_send_queued_data(conn);
+		return;
+	}
+
+	if (++conn->dup_acks < TCP_DUP_ACK_THRESHOLD) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit, cwnd=%u", conn, conn->cwnd);
+
+	conn->ssthresh = tcp_cc->ssthresh(conn);
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = true;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_rexmit = conn->seq;
+#endif
+
+	tcp_fast_retransmit(conn);
+
+	conn->cwnd = conn->ssthresh + TCP_DUP_ACK_THRESHOLD * conn_mss(conn);
+	conn->cwnd_cnt = 0;
+
+	(void)tcp_send_queued_data(conn);
+}
+
+/* Called after acked bytes of new data were acknowledged */
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->dup_acks = 0;
+	tcp_sack_trim(conn);
+
+	if (!conn->in_recovery) {
+		tcp_cc->cong_avoid(conn, acked);
+		conn->cwnd = MIN(conn->cwnd, TCP_CWND_MAX);
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+		/* Full acknowledgment, leave fast recovery */
+		conn->cwnd = MIN(conn->ssthresh,
+				 MAX((uint32_t)conn->unacked_len, mss) + mss);
+		conn->in_recovery = false;
+		return;
+	}
+
+	/* Partial acknowledgment, the next segment was lost too. Deflate the
+	 * window by the amount acked and add back one segment.
+	 */
+	conn->cwnd -= MIN(conn->cwnd, acked);
+	if (acked >= mss) {
+		conn->cwnd += mss;
+	}
+	conn->cwnd = MAX(conn->cwnd, mss);
+
+	tcp_fast_retransmit(conn);
+}
+
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	conn->ssthresh = tcp_cc->ssthresh(conn);
+	conn->cwnd = conn_mss(conn);
+	conn->cwnd_cnt = 0;
+	conn->dup_acks = 0;
+	conn->in_recovery = false;
+	tcp_sack_clear(conn);
+}
+
 static void tcp_resend_data(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, send_data_timer);
@@ -952,6 +1541,13 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	/* Only the first timeout after progress shrinks the window, the
+	 * consecutive ones just resend.
+	 */
+	if (conn->send_data_retries == 0) {
+		tcp_cc_timeout(conn);
+	}
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1034,6 +1630,13 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->recv_win = tcp_window;
 
+	while (conn->rcv_wscale < TCP_WSCALE_MAX &&
+	       (conn->recv_win >> conn->rcv_wscale) > UINT16_MAX) {
+		conn->rcv_wscale++;
+	}
+
+	tcp_cc->init(conn);
+
 	conn->seq = (IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
 
@@ -1079,6 +1682,39 @@ out:
 	return ret;
 }
 
+#if CONFIG_NET_TCP_CONN_HASH_SIZE > 0
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+{
+	struct tcp_conn_bucket *bucket;
+	union tcp_endpoint src, dst;
+	struct tcp *found = NULL;
+	k_spinlock_key_t key;
+	struct tcp *conn;
+	size_t len;
+
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	len = tcp_endpoint_len(src.sa.sa_family);
+	bucket = &tcp_conn_hash[tcp_conn_hash_bucket(&src, &dst)];
+
+	key = k_spin_lock(&bucket->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&bucket->conns, conn, hash_next) {
+		if (!memcmp(&conn->src, &src, len) &&
+		    !memcmp(&conn->dst, &dst, len)) {
+			found = conn;
+			break;
+		}
+	}
+
+	k_spin_unlock(&bucket->lock, key);
+
+	return found;
+}
+#else
 static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
 			     enum pkt_addr which)
 {
@@ -1113,6 +1749,7 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	return found ? conn : NULL;
 }
+#endif /* CONFIG_NET_TCP_CONN_HASH_SIZE > 0 */
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
@@ -1196,6 +1833,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		log_strdup(net_sprint_addr(conn->dst.sa.sa_family,
 				(const void *)&conn->dst.sin.sin_addr)));
 
+	tcp_conn_hash_add(conn);
+
 	memcpy(&context->remote, &conn->dst, sizeof(context->remote));
 	context->flags |= NET_CONTEXT_REMOTE_ADDR_SET;
 
@@ -1264,6 +1903,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint32_t prev_send_win = 0;
 	size_t len;
 	int ret;
 
@@ -1282,8 +1922,11 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
-	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+	conn->recv_options.sack_cnt = 0;
+
+	if (tcp_options_len &&
+	    !tcp_options_check(&conn->recv_options, pkt, tcp_options_len,
+			       fl & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
@@ -1293,8 +1936,14 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	if (th) {
 		size_t max_win;
 
+		prev_send_win = conn->send_win;
 		conn->send_win = ntohs(th->th_win);
 
+		/* The window in a SYN segment is never scaled */
+		if (conn->wscale_ok && !(fl & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 #if IS_ENABLED(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
 			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -1329,6 +1978,7 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_options_negotiate(conn);
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
@@ -1375,6 +2025,7 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			tcp_options_negotiate(conn);
 			if (len) {
 				if (tcp_data_get(conn, pkt) < 0) {
 					break;
@@ -1420,6 +2071,16 @@ next_state:
 			break;
 		}
 
+		if (th && conn->recv_options.sack_cnt) {
+			tcp_sack_update(conn);
+		}
+
+		if (th && len == 0 && !(fl & (SYN | FIN)) &&
+		    th_ack(th) == conn->seq && conn->unacked_len > 0 &&
+		    conn->send_win == prev_send_win) {
+			tcp_dup_ack(conn);
+		}
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -1442,6 +2103,8 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_cc_ack(conn, len_acked);
+
 			conn_send_data_dump(conn);
 
 			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
@@ -1809,6 +2472,10 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	if (ret == 0) {
+		tcp_conn_hash_add(conn);
+	}
+
 	NET_DBG("conn: %p src: %s, dst: %s", conn,
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -2002,6 +2669,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -2123,6 +2791,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
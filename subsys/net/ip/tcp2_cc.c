@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+#include "tcp2_cc.h"
+
+/* Initial window of RFC 3390 */
+#define TCP_INIT_CWND(_mss) MIN(4 * (_mss), MAX(2 * (_mss), 4380))
+
+static void newreno_init(struct tcp *conn)
+{
+	conn->cwnd = TCP_INIT_CWND(conn_mss(conn));
+	conn->ssthresh = UINT32_MAX;
+	conn->cwnd_cnt = 0;
+}
+
+static bool tcp_slow_start(struct tcp *conn, uint32_t acked)
+{
+	if (conn->cwnd >= conn->ssthresh) {
+		return false;
+	}
+
+	conn->cwnd += MIN(acked, conn_mss(conn));
+
+	return true;
+}
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* RFC 8312 constants: beta = 0.7 scaled by 1024, C = 0.4 */
+#define CUBIC_BETA		717U
+#define CUBIC_BETA_SCALE	1024U
+/* Limit of |t - K| in ms, keeps the cube within 64 bits */
+#define CUBIC_T_MAX		100000
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0U, b;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		x <<= 1;
+		b = 3U * x * (x + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			x++;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	newreno_init(conn);
+
+	conn->cubic.w_max = 0U;
+	conn->cubic.epoch_start = 0U;
+}
+
+static void cubic_epoch_start(struct tcp *conn, uint32_t now)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cubic.epoch_start = now ? now : 1U;
+	conn->cubic.w_est = conn->cwnd;
+	conn->cubic.est_cnt = 0U;
+
+	if (conn->cwnd < conn->cubic.w_max) {
+		/* K^3 = (W_max - cwnd) / C, in ms and segments */
+		conn->cubic.k = cubic_root((uint64_t)(conn->cubic.w_max -
+						      conn->cwnd) *
+					   2500000000ULL / mss);
+		conn->cubic.origin = conn->cubic.w_max;
+	} else {
+		conn->cubic.k = 0U;
+		conn->cubic.origin = conn->cwnd;
+	}
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	int64_t d, target;
+	uint64_t need;
+
+	if (tcp_slow_start(conn, acked)) {
+		return;
+	}
+
+	if (conn->cubic.epoch_start == 0U) {
+		cubic_epoch_start(conn, now);
+	}
+
+	d = (int64_t)(now - conn->cubic.epoch_start) - conn->cubic.k;
+	d = CLAMP(d, -CUBIC_T_MAX, CUBIC_T_MAX);
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max, in bytes */
+	target = (int64_t)conn->cubic.origin +
+		d * d * d / 1000 * 4 * mss / 10000000;
+
+	/* Bytes to be acked per segment of window growth, limited so that
+	 * the window grows at most by half of itself per round trip.
+	 */
+	if (target > (int64_t)conn->cwnd) {
+		need = (uint64_t)conn->cwnd * mss / (target - conn->cwnd);
+		need = MAX(need, 2U * mss);
+	} else {
+		need = 100U * (uint64_t)conn->cwnd;
+	}
+
+	conn->cwnd_cnt += acked;
+	if (conn->cwnd_cnt >= need) {
+		conn->cwnd_cnt = 0U;
+		conn->cwnd += mss;
+	}
+
+	/* TCP friendly region, follow the window a Reno flow with the
+	 * same loss rate would have.
+	 */
+	conn->cubic.est_cnt += acked;
+	if ((uint64_t)conn->cubic.est_cnt * 17U >=
+	    (uint64_t)conn->cubic.w_est * 9U) {
+		conn->cubic.est_cnt = 0U;
+		conn->cubic.w_est += mss;
+	}
+
+	conn->cwnd = MAX(conn->cwnd, conn->cubic.w_est);
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	uint32_t cwnd = conn->cwnd;
+
+	conn->cubic.epoch_start = 0U;
+
+	/* Fast convergence, release bandwidth for newer flows */
+	if (cwnd < conn->cubic.w_max) {
+		conn->cubic.w_max = (uint64_t)cwnd *
+			(CUBIC_BETA_SCALE + CUBIC_BETA) /
+			(2U * CUBIC_BETA_SCALE);
+	} else {
+		conn->cubic.w_max = cwnd;
+	}
+
+	return MAX((uint64_t)cwnd * CUBIC_BETA / CUBIC_BETA_SCALE,
+		   2U * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
+
+const struct tcp_cc_ops *const tcp_cc = &tcp_cc_cubic;
+#else
+/* RFC 5681, increase the window by one segment per window acknowledged */
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	if (tcp_slow_start(conn, acked)) {
+		return;
+	}
+
+	conn->cwnd_cnt += acked;
+	if (conn->cwnd_cnt >= conn->cwnd) {
+		conn->cwnd_cnt -= conn->cwnd;
+		conn->cwnd += conn_mss(conn);
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2, 2 * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
+
+const struct tcp_cc_ops *const tcp_cc = &tcp_cc_newreno;
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
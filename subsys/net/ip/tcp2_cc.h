@@ -0,0 +1,46 @@
+/** @file
+ @brief TCP congestion control algorithms.
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TCP2_CC_H
+#define __TCP2_CC_H
+
+#include <zephyr/types.h>
+
+struct tcp;
+
+/**
+ * @brief Congestion control algorithm.
+ *
+ * The algorithm only decides how the congestion window grows and how far
+ * it is reduced after a loss. Loss detection, fast retransmit and fast
+ * recovery are done by the TCP state machine.
+ */
+struct tcp_cc_ops {
+	/** Name of the algorithm, for debug output. */
+	const char *name;
+
+	/** Set the initial congestion window and slow start threshold. */
+	void (*init)(struct tcp *conn);
+
+	/** Grow the congestion window after acked bytes of new data were
+	 * acknowledged outside of fast recovery.
+	 */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+
+	/** Return the slow start threshold to use after a loss. */
+	uint32_t (*ssthresh)(struct tcp *conn);
+};
+
+/** Congestion control algorithm selected in Kconfig. */
+extern const struct tcp_cc_ops *const tcp_cc;
+
+#endif /* __TCP2_CC_H */
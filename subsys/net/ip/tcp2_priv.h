@@ -96,7 +96,7 @@
 #define conn_send_data_dump(_conn)					\
 ({									\
 	NET_DBG("conn: %p total=%zd, unacked_len=%d, "			\
-		"send_win=%hu, mss=%hu",				\
+		"send_win=%u, mss=%hu",					\
 		(_conn), net_pkt_get_len((_conn)->send_data),		\
 		conn->unacked_len, conn->send_win,			\
 		conn_mss((_conn)));					\
@@ -110,6 +110,11 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+#define TCP_WSCALE_MAX	14 /* RFC 7323, section 2.3 */
+#define TCP_SACK_BLOCKS	4
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -171,15 +176,26 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint16_t window; /* window scale shift count */
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	uint8_t sack_cnt;
+	struct tcp_sack_block sack[TCP_SACK_BLOCKS];
 };
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+#if CONFIG_NET_TCP_CONN_HASH_SIZE > 0
+	sys_snode_t hash_next;
+#endif
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_if *iface;
@@ -207,12 +223,41 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t send_win;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t cwnd_cnt;
+	uint32_t recover;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct {
+		uint32_t w_max;
+		uint32_t origin;
+		uint32_t k;
+		uint32_t epoch_start;
+		uint32_t w_est;
+		uint32_t est_cnt;
+	} cubic;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sacked[TCP_SACK_BLOCKS];
+	uint32_t sack_rexmit;
+	uint8_t sacked_cnt;
+#endif
 	uint8_t send_data_retries;
+	uint8_t dup_acks;
+	uint8_t snd_wscale;
+	uint8_t rcv_wscale;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool in_recovery : 1;
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
+#if CONFIG_NET_TCP_CONN_HASH_SIZE > 0
+	bool in_hash : 1;
+	uint16_t hash_bucket;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
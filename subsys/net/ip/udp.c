@@ -172,6 +172,12 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 			goto drop;
 		}
 
+		/* Sockets verify it while copying the payload out */
+		if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY)) {
+			net_pkt_set_chksum_pending(pkt, true);
+			goto out;
+		}
+
 		if (net_calc_verify_chksum_udp(pkt) != 0U) {
 			NET_DBG("DROP: checksum mismatch");
 			goto drop;
@@ -183,3 +189,16 @@ drop:
 	net_stats_update_udp_chkerr(net_pkt_iface(pkt));
 	return NULL;
 }
+
+bool net_udp_verify_chksum(struct net_pkt *pkt)
+{
+	net_pkt_set_chksum_pending(pkt, false);
+
+	if (net_calc_verify_chksum_udp(pkt) != 0U) {
+		NET_DBG("DROP: checksum mismatch");
+		net_stats_update_udp_chkerr(net_pkt_iface(pkt));
+		return false;
+	}
+
+	return true;
+}
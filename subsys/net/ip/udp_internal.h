@@ -96,6 +96,26 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Verify the UDP checksum of a packet whose verification was
+ * deferred by net_udp_input().
+ *
+ * @param pkt Network packet, a payload sum set with
+ *            net_pkt_set_payload_csum() is used if present.
+ *
+ * @return True if the checksum is valid, false otherwise.
+ */
+#if defined(CONFIG_NET_NATIVE_UDP)
+bool net_udp_verify_chksum(struct net_pkt *pkt);
+#else
+static inline bool net_udp_verify_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return true;
+}
+#endif
+
 /**
  * @brief Register a callback to be called when UDP packet
  * is received corresponding to received packet.
@@ -489,37 +489,235 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* The checksum is computed on the native 16-bit words, which on a little
+ * endian CPU gives the byte swapped sum (RFC 1071, section 2). Starting at
+ * an odd address or at an odd offset of the data swaps it too, so the sum
+ * is swapped back once at the end. Carries are accumulated in a 64-bit
+ * value and only folded when the sum is returned.
+ */
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	return acc;
+}
+
+static inline uint16_t chksum_swap(uint16_t sum)
+{
+	return (sum << 8) | (sum >> 8);
+}
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t val)
+{
+	sum += val;
+
+	return sum < val ? sum + 1 : sum;
+}
+
+#if defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+/* Thumb-2 add with carry chain keeps the end around carry in a 32-bit
+ * sum, one instruction per word instead of two for a 64-bit add.
+ */
+static inline uint64_t chksum_words(uint64_t acc, const uint32_t *words,
+				    size_t count)
+{
+	uint32_t sum = 0U;
+
+	for (; count >= 4; count -= 4, words += 4) {
+		__asm__ ("adds %0, %0, %1\n\t"
+			 "adcs %0, %0, %2\n\t"
+			 "adcs %0, %0, %3\n\t"
+			 "adcs %0, %0, %4\n\t"
+			 "adc %0, %0, #0"
+			 : "+r" (sum)
+			 : "r" (words[0]), "r" (words[1]),
+			   "r" (words[2]), "r" (words[3])
+			 : "cc");
+	}
+
+	acc += sum;
+
+	while (count--) {
+		acc += *words++;
+	}
+
+	return acc;
+}
+#else
+static inline uint64_t chksum_words(uint64_t acc, const uint32_t *words,
+				    size_t count)
+{
+	for (; count >= 4; count -= 4, words += 4) {
+		acc += (uint64_t)words[0] + words[1] + words[2] + words[3];
+	}
+
+	while (count--) {
+		acc += *words++;
+	}
+
+	return acc;
+}
+#endif
+
+/* Second half of the native word at the address before the byte */
+static inline uint32_t chksum_odd_byte(uint8_t byte)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return byte;
+#else
+	return byte << 8;
+#endif
+}
+
+/* First half of the native word at the address of the byte */
+static inline uint32_t chksum_last_byte(uint8_t byte)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return byte << 8;
+#else
+	return byte;
+#endif
+}
+
+/* Back to the network order sum, see above */
+static inline uint16_t chksum_result(uint64_t acc, bool odd)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return odd ? chksum_swap(chksum_fold(acc)) : chksum_fold(acc);
+#else
+	return odd ? chksum_fold(acc) : chksum_swap(chksum_fold(acc));
+#endif
+}
+
 static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	bool odd = POINTER_TO_UINT(data) & 1;
+	uint64_t acc = 0U;
 
-	end = data + len - 1;
+	if (!len) {
+		return sum;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (odd) {
+		acc = chksum_odd_byte(data[0]);
+		data++;
+		len--;
+	}
 
+	if ((POINTER_TO_UINT(data) & 2) && len >= 2) {
+		acc += *(const uint16_t *)data;
 		data += 2;
+		len -= 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	acc = chksum_words(acc, (const uint32_t *)data, len / 4);
+	data += len & ~3;
+	len &= 3;
+
+	if (len >= 2) {
+		acc += *(const uint16_t *)data;
+		data += 2;
+		len -= 2;
 	}
 
-	return sum;
+	if (len) {
+		acc += chksum_last_byte(data[0]);
+	}
+
+	return chksum_add(sum, chksum_result(acc, odd));
+}
+
+/* Same as calc_chksum() while copying the data. Words are only loaded
+ * once when the source and the destination have the same alignment,
+ * otherwise the data is copied first and the copy summed.
+ */
+static uint16_t copy_chksum(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	bool odd = POINTER_TO_UINT(src) & 1;
+	uint64_t acc = 0U;
+
+	if ((POINTER_TO_UINT(dst) ^ POINTER_TO_UINT(src)) & 3) {
+		memcpy(dst, src, len);
+
+		return calc_chksum(0U, dst, len);
+	}
+
+	if (!len) {
+		return 0U;
+	}
+
+	if (odd) {
+		*dst++ = *src;
+		acc = chksum_odd_byte(*src++);
+		len--;
+	}
+
+	if ((POINTER_TO_UINT(src) & 2) && len >= 2) {
+		uint16_t word = *(const uint16_t *)src;
+
+		*(uint16_t *)dst = word;
+		acc += word;
+		src += 2;
+		dst += 2;
+		len -= 2;
+	}
+
+	for (; len >= 4; len -= 4) {
+		uint32_t word = *(const uint32_t *)src;
+
+		*(uint32_t *)dst = word;
+		acc += word;
+		src += 4;
+		dst += 4;
+	}
+
+	if (len >= 2) {
+		uint16_t word = *(const uint16_t *)src;
+
+		*(uint16_t *)dst = word;
+		acc += word;
+		src += 2;
+		dst += 2;
+		len -= 2;
+	}
+
+	if (len) {
+		*dst = *src;
+		acc += chksum_last_byte(*src);
+	}
+
+	return chksum_result(acc, odd);
+}
+
+void net_chksum_copy(struct net_pkt_csum *csum, void *dst, const void *src,
+		     size_t len)
+{
+	uint16_t part;
+
+	if (dst) {
+		part = copy_chksum(dst, src, len);
+	} else {
+		part = calc_chksum(0U, src, len);
+	}
+
+	/* Data following an odd number of bytes has its sum swapped */
+	csum->sum = chksum_add(csum->sum, (csum->len & 1) ?
+			       chksum_swap(part) : part);
+	csum->len += len;
 }
 
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+/* Each fragment is summed on its own. One that starts at an odd offset of
+ * the data has its bytes on the wrong halves of the words and its sum is
+ * swapped before being added. At most max_len bytes are summed.
+ */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum,
+				       size_t max_len)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
+	bool odd = false;
 	size_t len;
 
 	if (!cur->buf || !cur->pos) {
@@ -528,8 +726,16 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+	while (cur->buf && max_len) {
+		uint16_t part;
+
+		len = MIN(len, max_len);
+		max_len -= len;
+
+		part = calc_chksum(0U, cur->pos, len);
+
+		sum = chksum_add(sum, odd ? chksum_swap(part) : part);
+		odd ^= len & 1;
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -537,18 +743,7 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
+		len = cur->buf->len;
 	}
 
 	return sum;
@@ -556,25 +751,27 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 {
+	const struct net_pkt_csum *payload = net_pkt_payload_csum(pkt);
 	size_t len = 0U;
+	size_t data_len;
 	uint16_t sum = 0U;
 	struct net_pkt_cursor backup;
 	bool ow;
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
+		data_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv4_opts_len(pkt);
 		if (proto != IPPROTO_ICMP) {
 			len = 2 * sizeof(struct in_addr);
-			sum = net_pkt_get_len(pkt) -
-				net_pkt_ip_hdr_len(pkt) -
-				net_pkt_ipv4_opts_len(pkt) + proto;
+			sum = data_len + proto;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		   net_pkt_family(pkt) == AF_INET6) {
+		data_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv6_ext_len(pkt);
 		len = 2 * sizeof(struct in6_addr);
-		sum =  net_pkt_get_len(pkt) -
-			net_pkt_ip_hdr_len(pkt) -
-			net_pkt_ipv6_ext_len(pkt) + proto;
+		sum = data_len + proto;
 	} else {
 		NET_DBG("Unknown protocol family %d", net_pkt_family(pkt));
 		return 0;
@@ -591,7 +788,16 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	/* The payload may have been summed already when it was copied */
+	if (payload && payload->len && payload->len <= data_len) {
+		size_t hdr_len = data_len - payload->len;
+
+		sum = pkt_calc_chksum(pkt, sum, hdr_len);
+		sum = chksum_add(sum, (hdr_len & 1) ?
+				 chksum_swap(payload->sum) : payload->sum);
+	} else {
+		sum = pkt_calc_chksum(pkt, sum, data_len);
+	}
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
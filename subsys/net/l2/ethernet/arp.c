@@ -26,9 +26,14 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
-static sys_slist_t arp_free_entries;
-static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+static sys_dlist_t arp_free_entries;
+static sys_dlist_t arp_pending_entries;
+static sys_dlist_t arp_table;
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+/* Index of the entries in arp_table, keyed by interface and address */
+static sys_slist_t arp_hash[CONFIG_NET_ARP_HASH_SIZE];
+#endif
 
 struct k_delayed_work arp_request_timer;
 
@@ -50,14 +55,13 @@ static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
 }
 
-static struct arp_entry *arp_entry_find(sys_slist_t *list,
+static struct arp_entry *arp_entry_find(sys_dlist_t *list,
 					struct net_if *iface,
-					struct in_addr *dst,
-					sys_snode_t **previous)
+					struct in_addr *dst)
 {
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(list, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(list, entry, node) {
 		NET_DBG("iface %p dst %s",
 			iface, log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
@@ -65,33 +69,83 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 		    net_ipv4_addr_cmp(&entry->ip, dst)) {
 			return entry;
 		}
+	}
+
+	return NULL;
+}
 
-		if (previous) {
-			*previous = &entry->node;
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+static sys_slist_t *arp_hash_bucket(struct net_if *iface,
+				    const struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr) ^
+			(uint32_t)(uintptr_t)iface;
+
+	/* Multiplicative hashing, the upper bits are the best mixed */
+	hash = (hash * 2654435761U) >> 16;
+
+	return &arp_hash[hash % CONFIG_NET_ARP_HASH_SIZE];
+}
+#endif
+
+static struct arp_entry *arp_table_find(struct net_if *iface,
+					struct in_addr *dst)
+{
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+	struct arp_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(iface, dst), entry,
+				     hash_node) {
+		if (entry->iface == iface &&
+		    net_ipv4_addr_cmp(&entry->ip, dst)) {
+			return entry;
 		}
 	}
 
 	return NULL;
+#else
+	return arp_entry_find(&arp_table, iface, dst);
+#endif
+}
+
+/* The entry iface and ip must be set before it is added to the table */
+static void arp_table_add(struct arp_entry *entry)
+{
+	sys_dlist_prepend(&arp_table, &entry->node);
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+	sys_slist_prepend(arp_hash_bucket(entry->iface, &entry->ip),
+			  &entry->hash_node);
+#endif
+}
+
+static void arp_table_remove(struct arp_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+	sys_slist_find_and_remove(arp_hash_bucket(entry->iface, &entry->ip),
+				  &entry->hash_node);
+#endif
 }
 
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_table_find(iface, dst);
 	if (entry) {
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
 		 * place the entry first in position into the table
 		 * in order to reduce subsequent find.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+		if (!sys_dlist_is_head(&arp_table, &entry->node)) {
+			sys_dlist_remove(&entry->node);
+			sys_dlist_prepend(&arp_table, &entry->node);
 		}
 	}
 
@@ -104,24 +158,23 @@ struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	return arp_entry_find(&arp_pending_entries, iface, dst, NULL);
+	return arp_entry_find(&arp_pending_entries, iface, dst);
 }
 
 static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 					       struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_pending_entries, iface, dst, &prev);
+	entry = arp_entry_find(&arp_pending_entries, iface, dst);
 	if (entry) {
 		/* We remove the entry from the pending list */
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
+		sys_dlist_remove(&entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_delayed_work_cancel(&arp_request_timer);
 	}
 
@@ -130,35 +183,35 @@ static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 
 static struct arp_entry *arp_entry_get_free(void)
 {
-	sys_snode_t *node;
+	sys_dnode_t *node;
 
-	node = sys_slist_peek_head(&arp_free_entries);
+	/* We remove the node from the free list */
+	node = sys_dlist_get(&arp_free_entries);
 	if (!node) {
 		return NULL;
 	}
 
-	/* We remove the node from the free list */
-	sys_slist_remove(&arp_free_entries, NULL, node);
-
 	return CONTAINER_OF(node, struct arp_entry, node);
 }
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry;
+	sys_dnode_t *node;
 
 	/* We assume last entry is the oldest one,
 	 * so is the preferred one to be taken out.
 	 */
 
-	node = sys_slist_peek_tail(&arp_table);
+	node = sys_dlist_peek_tail(&arp_table);
 	if (!node) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	entry = CONTAINER_OF(node, struct arp_entry, node);
+	arp_table_remove(entry);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return entry;
 }
 
 
@@ -166,7 +219,7 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
-	sys_slist_append(&arp_pending_entries, &entry->node);
+	sys_dlist_append(&arp_pending_entries, &entry->node);
 
 	entry->req_start = k_uptime_get_32();
 
@@ -184,7 +237,7 @@ static void arp_request_timeout(struct k_work *work)
 
 	ARG_UNUSED(work);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if ((int32_t)(entry->req_start +
 			    ARP_REQUEST_TIMEOUT - current) > 0) {
@@ -193,8 +246,8 @@ static void arp_request_timeout(struct k_work *work)
 
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, NULL, &entry->node);
-		sys_slist_append(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_append(&arp_free_entries, &entry->node);
 
 		entry = NULL;
 	}
@@ -399,10 +452,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_table_find(iface, src);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -434,10 +486,9 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_table_find(iface, src);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -456,7 +507,7 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					arp_table_add(entry);
 				}
 			}
 		}
@@ -479,7 +530,7 @@ static void arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_table_add(entry);
 
 	net_if_queue_tx(iface, pkt);
 }
@@ -669,41 +720,36 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 void net_arp_clear_cache(struct net_if *iface)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry, *next;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
+		arp_table_remove(entry);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	prev = NULL;
-
 	NET_DBG("Flushing ARP pending requests");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_delayed_work_cancel(&arp_request_timer);
 	}
 }
@@ -713,7 +759,7 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	int ret = 0;
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
 		ret++;
 		cb(entry, user_data);
 	}
@@ -729,13 +775,19 @@ void net_arp_init(void)
 		return;
 	}
 
-	sys_slist_init(&arp_free_entries);
-	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	sys_dlist_init(&arp_free_entries);
+	sys_dlist_init(&arp_pending_entries);
+	sys_dlist_init(&arp_table);
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		sys_slist_init(&arp_hash[i]);
+	}
+#endif
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
-		sys_slist_prepend(&arp_free_entries, &arp_entries[i].node);
+		sys_dlist_prepend(&arp_free_entries, &arp_entries[i].node);
 	}
 
 	k_delayed_work_init(&arp_request_timer, arp_request_timeout);
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #endif
 
 #include "arp.h"
+#include "gro.h"
 #include "eth_stats.h"
 #include "net_private.h"
 #include "ipv6.h"
@@ -310,7 +311,7 @@ static enum net_verdict ethernet_recv(struct net_if *iface,
 
 	ethernet_update_length(iface, pkt);
 
-	return NET_CONTINUE;
+	return net_eth_gro_input(iface, pkt);
 drop:
 	eth_stats_update_errors_rx(iface);
 	return NET_DROP;
@@ -566,18 +567,16 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
-static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+/* Add the L2 header. The packet to send may be replaced by an ARP request,
+ * in which case the original packet waits in the ARP queue.
+ */
+static int ethernet_prepare(struct net_if *iface, struct net_pkt **pkt_ptr)
 {
-	const struct ethernet_api *api = net_if_get_device(iface)->api;
 	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct net_pkt *pkt = *pkt_ptr;
 	uint16_t ptype;
 	int ret;
 
-	if (!api) {
-		ret = -ENOENT;
-		goto error;
-	}
-
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
 		struct net_pkt *tmp;
@@ -594,6 +593,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 				 * by an ARP request packet.
 				 */
 				pkt = tmp;
+				*pkt_ptr = pkt;
 				ptype = htons(NET_ETH_PTYPE_ARP);
 				net_pkt_set_family(pkt, AF_INET);
 			} else {
@@ -625,7 +625,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 						sizeof(struct net_eth_addr);
 			ptype = dst_addr->sll_protocol;
 		} else {
-			goto send;
+			return 0;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_GPTP) && net_pkt_is_gptp(pkt)) {
 		ptype = htons(NET_ETH_PTYPE_PTP);
@@ -669,12 +669,18 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_cursor_init(pkt);
 
-send:
-	ret = api->send(net_if_get_device(iface), pkt);
+	return 0;
+error:
+	return ret;
+}
+
+/* Account for the driver send result of a prepared packet */
+static int ethernet_sent(struct net_if *iface, struct net_pkt *pkt, int ret)
+{
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
 		ethernet_remove_l2_header(pkt);
-		goto error;
+		return ret;
 	}
 
 	ethernet_update_tx_stats(iface, pkt);
@@ -683,10 +689,85 @@ send:
 	ethernet_remove_l2_header(pkt);
 
 	net_pkt_unref(pkt);
-error:
+
 	return ret;
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	int ret;
+
+	if (!api) {
+		return -ENOENT;
+	}
+
+	ret = ethernet_prepare(iface, &pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = api->send(net_if_get_device(iface), pkt);
+
+	return ethernet_sent(iface, pkt, ret);
+}
+
+#if defined(CONFIG_NET_IF_TX_BATCH)
+/* Prepare all the packets and hand them to the driver in one call. If it
+ * stops early, the packet it stopped at and the ones after it are passed
+ * to send() one by one so that each gets its own error.
+ */
+static void ethernet_send_batch(struct net_if *iface, struct net_pkt **pkts,
+				int *status, int count)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct net_pkt *frames[CONFIG_NET_IF_TX_BATCH_SIZE];
+	int index[CONFIG_NET_IF_TX_BATCH_SIZE];
+	int frame_count = 0;
+	int sent = 0;
+	int i;
+
+	if (!api || !api->send_batch) {
+		for (i = 0; i < count; i++) {
+			status[i] = ethernet_send(iface, pkts[i]);
+		}
+
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+
+		status[i] = ethernet_prepare(iface, &pkt);
+		if (status[i] < 0) {
+			continue;
+		}
+
+		frames[frame_count] = pkt;
+		index[frame_count] = i;
+		frame_count++;
+	}
+
+	if (frame_count > 0) {
+		sent = api->send_batch(net_if_get_device(iface), frames,
+				       frame_count);
+		if (sent < 0) {
+			sent = 0;
+		}
+	}
+
+	for (i = 0; i < frame_count; i++) {
+		int ret = 0;
+
+		if (i >= sent) {
+			ret = api->send(net_if_get_device(iface), frames[i]);
+		}
+
+		status[index[i]] = ethernet_sent(iface, frames[i], ret);
+	}
+}
+#endif /* CONFIG_NET_IF_TX_BATCH */
+
 static inline int ethernet_enable(struct net_if *iface, bool state)
 {
 	const struct ethernet_api *eth =
@@ -999,8 +1080,13 @@ int net_eth_vlan_disable(struct net_if *iface, uint16_t tag)
 }
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_IF_TX_BATCH)
+NET_L2_INIT_BATCH(ETHERNET_L2, ethernet_recv, ethernet_send,
+		  ethernet_send_batch, ethernet_enable, ethernet_flags);
+#else
 NET_L2_INIT(ETHERNET_L2, ethernet_recv, ethernet_send, ethernet_enable,
 	    ethernet_flags);
+#endif
 
 static void carrier_on(struct k_work *work)
 {
@@ -1175,6 +1261,7 @@ void ethernet_init(struct net_if *iface)
 #endif
 
 	net_arp_init();
+	net_eth_gro_init();
 
 	ctx->is_init = true;
 }
@@ -919,7 +919,9 @@ static void init_ports(void)
 	tid = k_thread_create(&gptp_thread_data, gptp_stack,
 			      K_KERNEL_STACK_SIZEOF(gptp_stack),
 			      (k_thread_entry_t)gptp_thread,
-			      NULL, NULL, NULL, K_PRIO_COOP(5), 0, K_NO_WAIT);
+			      NULL, NULL, NULL,
+			      K_PRIO_COOP(CONFIG_NET_GPTP_THREAD_PRIO), 0,
+			      K_NO_WAIT);
 	k_thread_name_set(&gptp_thread_data, "gptp");
 }
 
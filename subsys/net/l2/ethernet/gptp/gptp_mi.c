@@ -734,6 +734,32 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+/* Largest frequency correction of the servo, in ppb */
+#define GPTP_PI_SERVO_MAX_PPB 100000
+
+static int64_t servo_drift_ppb;
+
+/*
+ * Rate ratio steering the local clock towards the grand master: the
+ * neighbor rate ratio, corrected proportionally to the offset in
+ * nanoseconds and by the drift integrated from the past offsets.
+ */
+static double gptp_pi_servo(double rate_ratio, int64_t offset)
+{
+	int64_t ppb;
+
+	servo_drift_ppb += offset * CONFIG_NET_GPTP_PI_SERVO_KI / 1000;
+	servo_drift_ppb = CLAMP(servo_drift_ppb, -GPTP_PI_SERVO_MAX_PPB,
+				GPTP_PI_SERVO_MAX_PPB);
+
+	ppb = offset * CONFIG_NET_GPTP_PI_SERVO_KP / 1000 + servo_drift_ppb;
+	ppb = CLAMP(ppb, -GPTP_PI_SERVO_MAX_PPB, GPTP_PI_SERVO_MAX_PPB);
+
+	return rate_ratio * (1.0 + (double)ppb / NSEC_PER_SEC);
+}
+#endif /* CONFIG_NET_GPTP_PI_SERVO */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -781,8 +807,6 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
-	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
-
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
 	 */
@@ -791,6 +815,13 @@ static void gptp_update_local_port_clock(void)
 			     nanosecond_diff > 5000))) {
 		bool underflow = false;
 
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+		/* The drift integrated so far doesn't apply to the new time */
+		servo_drift_ppb = 0;
+#endif
+
 		key = irq_lock();
 		ptp_clock_get(clk, &tm);
 
@@ -832,6 +863,17 @@ static void gptp_update_local_port_clock(void)
 	skip_clock_set:
 		irq_unlock(key);
 	} else {
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+		/* The offset is corrected by the rate only, without the
+		 * phase steps disturbing the time in between.
+		 */
+		double rate_ratio = port_ds->neighbor_rate_ratio;
+
+		ptp_clock_rate_adjust(clk, gptp_pi_servo(rate_ratio,
+							 nanosecond_diff));
+#else
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+
 		if (nanosecond_diff < -200) {
 			nanosecond_diff = -200;
 		} else if (nanosecond_diff > 200) {
@@ -839,6 +881,7 @@ static void gptp_update_local_port_clock(void)
 		}
 
 		ptp_clock_adjust(clk, nanosecond_diff);
+#endif
 	}
 }
 #endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
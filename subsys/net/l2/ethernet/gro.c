@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <sys/byteorder.h>
+#include <net/net_core.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+#include "gro.h"
+
+struct gro_hdrs {
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+	};
+	struct net_tcp_hdr *tcp;
+	uint16_t ip_hdr_len;
+	uint16_t hdr_len;
+	uint16_t payload_len;
+};
+
+/* Coalesced segment pending in one RX queue, that is one traffic class or
+ * one flow queue of it. Each queue is served by a single RX thread, and
+ * the timer runs on that thread's work queue too, so the state needs no
+ * locking.
+ */
+struct gro_flow {
+	struct k_delayed_work timer;
+	struct net_pkt *pkt;
+	struct net_if *iface;
+	struct gro_hdrs hdrs;
+	uint32_t next_seq;
+	uint8_t queue;
+};
+
+static struct gro_flow gro_flows[NET_TC_RX_COUNT * NET_TC_FLOW_QUEUES];
+static bool gro_initialized;
+
+/* Both the IP and TCP headers are expected in the first fragment, which
+ * is where the drivers put them. Only plain ACK segments with payload,
+ * optionally with PSH set, are coalesced.
+ */
+static bool gro_parse(struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t ip_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)buf->data;
+
+		/* No options and no fragments (MF bit or offset) */
+		if (buf->len < NET_IPV4H_LEN || ip->vhl != 0x45 ||
+		    ip->proto != IPPROTO_TCP ||
+		    (ip->offset[0] & 0x3f) || ip->offset[1]) {
+			return false;
+		}
+
+		hdrs->ipv4 = ip;
+		hdrs->ip_hdr_len = NET_IPV4H_LEN;
+		ip_len = ntohs(ip->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)buf->data;
+
+		/* No extension headers */
+		if (buf->len < NET_IPV6H_LEN || (ip->vtc & 0xf0) != 0x60 ||
+		    ip->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		hdrs->ipv6 = ip;
+		hdrs->ip_hdr_len = NET_IPV6H_LEN;
+		ip_len = NET_IPV6H_LEN + ntohs(ip->len);
+	} else {
+		return false;
+	}
+
+	if (ip_len != net_pkt_get_len(pkt) ||
+	    buf->len < hdrs->ip_hdr_len + NET_TCPH_LEN) {
+		return false;
+	}
+
+	hdrs->tcp = (struct net_tcp_hdr *)(buf->data + hdrs->ip_hdr_len);
+	hdrs->hdr_len = hdrs->ip_hdr_len + NET_TCP_HDR_LEN(hdrs->tcp);
+
+	if (NET_TCP_HDR_LEN(hdrs->tcp) < NET_TCPH_LEN ||
+	    buf->len < hdrs->hdr_len || ip_len <= hdrs->hdr_len) {
+		return false;
+	}
+
+	if ((NET_TCP_FLAGS(hdrs->tcp) & ~NET_TCP_PSH) != NET_TCP_ACK) {
+		return false;
+	}
+
+	hdrs->payload_len = ip_len - hdrs->hdr_len;
+
+	return true;
+}
+
+static bool gro_can_merge(struct gro_flow *flow, struct net_pkt *pkt,
+			  struct gro_hdrs *hdrs)
+{
+	struct gro_hdrs *prev = &flow->hdrs;
+
+	if (flow->iface != net_pkt_iface(pkt) ||
+	    net_pkt_family(flow->pkt) != net_pkt_family(pkt) ||
+	    prev->hdr_len != hdrs->hdr_len ||
+	    (prev->tcp->flags & NET_TCP_PSH) ||
+	    sys_get_be32(hdrs->tcp->seq) != flow->next_seq ||
+	    prev->payload_len + hdrs->payload_len >
+	    CONFIG_NET_ETHERNET_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		if (!net_ipv4_addr_cmp(&prev->ipv4->src, &hdrs->ipv4->src) ||
+		    !net_ipv4_addr_cmp(&prev->ipv4->dst, &hdrs->ipv4->dst)) {
+			return false;
+		}
+	} else {
+		if (!net_ipv6_addr_cmp(&prev->ipv6->src, &hdrs->ipv6->src) ||
+		    !net_ipv6_addr_cmp(&prev->ipv6->dst, &hdrs->ipv6->dst)) {
+			return false;
+		}
+	}
+
+	/* Same ports, acknowledgment, window and options */
+	return prev->tcp->src_port == hdrs->tcp->src_port &&
+		prev->tcp->dst_port == hdrs->tcp->dst_port &&
+		!memcmp(prev->tcp->ack, hdrs->tcp->ack, 4) &&
+		!memcmp(prev->tcp->wnd, hdrs->tcp->wnd, 2) &&
+		!memcmp(prev->tcp->optdata, hdrs->tcp->optdata,
+			hdrs->hdr_len - hdrs->ip_hdr_len - NET_TCPH_LEN);
+}
+
+/* Move the payload of pkt to the end of the pending packet and fix up the
+ * IP length. The checksums are not updated, coalescing is only done on
+ * interfaces that verify them in hardware.
+ */
+static void gro_merge(struct gro_flow *flow, struct net_pkt *pkt,
+		      struct gro_hdrs *hdrs)
+{
+	struct gro_hdrs *prev = &flow->hdrs;
+	struct net_buf *payload;
+
+	prev->payload_len += hdrs->payload_len;
+	prev->tcp->flags |= hdrs->tcp->flags & NET_TCP_PSH;
+	flow->next_seq += hdrs->payload_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		prev->ipv4->len = htons(prev->hdr_len + prev->payload_len);
+	} else {
+		prev->ipv6->len = htons(prev->hdr_len - NET_IPV6H_LEN +
+					prev->payload_len);
+	}
+
+	/* The headers of pkt are not needed after this */
+	net_buf_pull(pkt->buffer, hdrs->hdr_len);
+
+	payload = pkt->buffer;
+	if (payload->len == 0U) {
+		payload = net_buf_frag_del(NULL, payload);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_append_buffer(flow->pkt, payload);
+
+	net_pkt_unref(pkt);
+}
+
+static void gro_flush(struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	if (!pkt) {
+		return;
+	}
+
+	flow->pkt = NULL;
+	k_delayed_work_cancel(&flow->timer);
+
+	NET_DBG("pkt %p payload %u", pkt, flow->hdrs.payload_len);
+
+	net_l3_input(pkt);
+}
+
+static void gro_timeout(struct k_work *work)
+{
+	struct gro_flow *flow = CONTAINER_OF(work, struct gro_flow, timer);
+
+	gro_flush(flow);
+}
+
+enum net_verdict net_eth_gro_input(struct net_if *iface,
+				   struct net_pkt *pkt)
+{
+	struct gro_flow *flow;
+	struct gro_hdrs hdrs;
+
+	if (net_if_need_calc_rx_checksum(iface) || net_if_is_promisc(iface)) {
+		return NET_CONTINUE;
+	}
+
+	flow = &gro_flows[net_tc_rx_queue(pkt)];
+
+	if (!gro_parse(pkt, &hdrs)) {
+		/* Deliver a pending segment first so that, for example, a FIN
+		 * is not handled before the data preceding it.
+		 */
+		gro_flush(flow);
+		return NET_CONTINUE;
+	}
+
+	if (flow->pkt && gro_can_merge(flow, pkt, &hdrs)) {
+		gro_merge(flow, pkt, &hdrs);
+
+		if (flow->hdrs.tcp->flags & NET_TCP_PSH) {
+			gro_flush(flow);
+		}
+
+		return NET_OK;
+	}
+
+	gro_flush(flow);
+
+	if (hdrs.tcp->flags & NET_TCP_PSH) {
+		return NET_CONTINUE;
+	}
+
+	flow->pkt = pkt;
+	flow->iface = iface;
+	flow->hdrs = hdrs;
+	flow->next_seq = sys_get_be32(hdrs.tcp->seq) + hdrs.payload_len;
+
+	net_tc_submit_delayed_to_rx_queue(flow->queue, &flow->timer,
+				K_MSEC(CONFIG_NET_ETHERNET_GRO_TIMEOUT));
+
+	return NET_OK;
+}
+
+void net_eth_gro_init(void)
+{
+	int i;
+
+	if (gro_initialized) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(gro_flows); i++) {
+		gro_flows[i].queue = i;
+		k_delayed_work_init(&gro_flows[i].timer, gro_timeout);
+	}
+
+	gro_initialized = true;
+}
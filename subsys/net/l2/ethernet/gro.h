@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __GRO_H
+#define __GRO_H
+
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_ETHERNET_GRO)
+/**
+ * @brief Try to coalesce a received TCP segment with the previous one.
+ *
+ * Called after the Ethernet header has been removed. In-order segments
+ * of the same flow are merged into one packet, which is passed to the
+ * IP layer when a segment that cannot be merged arrives, when the size
+ * budget is reached, or after CONFIG_NET_ETHERNET_GRO_TIMEOUT ms.
+ *
+ * @param iface Network interface the packet was received on
+ * @param pkt Received packet
+ *
+ * @return NET_OK if the packet was consumed, NET_CONTINUE if the caller
+ * should pass it to the IP layer itself.
+ */
+enum net_verdict net_eth_gro_input(struct net_if *iface,
+				   struct net_pkt *pkt);
+
+void net_eth_gro_init(void);
+#else
+static inline enum net_verdict net_eth_gro_input(struct net_if *iface,
+						 struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+
+#define net_eth_gro_init(...)
+#endif /* CONFIG_NET_ETHERNET_GRO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GRO_H */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <init.h>
+#include <net/net_core.h>
+#include <net/ethernet_rx_poll.h>
+
+#define BUDGET CONFIG_NET_ETHERNET_RX_POLL_BUDGET
+
+/* All the polls run on one work queue, in the order they were scheduled.
+ * A poll that used up its budget is queued again behind the others.
+ */
+K_KERNEL_STACK_DEFINE(rx_poll_stack, CONFIG_NET_ETHERNET_RX_POLL_STACK_SIZE);
+static struct k_work_q rx_poll_q;
+
+static void rx_poll_flush(struct net_eth_rx_poll *poll)
+{
+	int queued;
+
+	if (!poll->count) {
+		return;
+	}
+
+	queued = net_recv_data_batch(poll->batch, poll->count);
+	if (queued < poll->count) {
+		NET_DBG("%d of %d frames dropped", poll->count - queued,
+			poll->count);
+	}
+
+	poll->count = 0;
+}
+
+static void rx_poll_handler(struct k_work *work)
+{
+	struct net_eth_rx_poll *poll =
+		CONTAINER_OF(work, struct net_eth_rx_poll, work);
+	int done;
+
+	done = poll->poll(poll, BUDGET);
+
+	rx_poll_flush(poll);
+
+	if (done >= BUDGET) {
+		k_work_submit_to_queue(&rx_poll_q, &poll->work);
+		return;
+	}
+
+	/* Clear the flag before the interrupt is unmasked, so that an
+	 * interrupt coming right after reschedules the poll.
+	 */
+	atomic_clear(&poll->scheduled);
+
+	poll->complete(poll);
+}
+
+void net_eth_rx_poll_init(struct net_eth_rx_poll *poll,
+			  net_eth_rx_poll_cb_t poll_cb,
+			  net_eth_rx_poll_complete_cb_t complete_cb)
+{
+	k_work_init(&poll->work, rx_poll_handler);
+	poll->poll = poll_cb;
+	poll->complete = complete_cb;
+	poll->count = 0;
+	atomic_clear(&poll->scheduled);
+}
+
+void net_eth_rx_poll_schedule(struct net_eth_rx_poll *poll)
+{
+	if (atomic_set(&poll->scheduled, 1)) {
+		return;
+	}
+
+	k_work_submit_to_queue(&rx_poll_q, &poll->work);
+}
+
+void net_eth_rx_poll_receive(struct net_eth_rx_poll *poll,
+			     struct net_pkt *pkt)
+{
+	/* A poll callback ignoring its budget only costs an extra flush */
+	if (poll->count == BUDGET) {
+		rx_poll_flush(poll);
+	}
+
+	poll->batch[poll->count++] = pkt;
+}
+
+static int rx_poll_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&rx_poll_q, rx_poll_stack,
+		       K_KERNEL_STACK_SIZEOF(rx_poll_stack),
+		       K_PRIO_COOP(CONFIG_NET_ETHERNET_RX_POLL_THREAD_PRIO));
+	k_thread_name_set(&rx_poll_q.thread, "eth_rx_poll");
+
+	return 0;
+}
+
+/* Before the Ethernet drivers, which may schedule polls from their
+ * interrupt handlers as soon as they are enabled.
+ */
+SYS_INIT(rx_poll_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
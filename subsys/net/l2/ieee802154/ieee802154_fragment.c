@@ -427,22 +427,25 @@ static void fragment_move_back(struct net_pkt *pkt,
 	}
 }
 
+/* The headers are pulled, the data of the received frames stays where it
+ * is. Only the first fragment's is moved over its header, as the tailroom
+ * lets the IPv6 header be uncompressed in place.
+ */
 static inline void fragment_remove_headers(struct net_pkt *pkt)
 {
 	struct net_buf *frag;
 
 	frag = pkt->buffer;
 	while (frag) {
-		uint16_t hdr_len = NET_6LO_FRAGN_HDR_LEN;
-
 		if ((frag->data[0] & NET_FRAG_DISPATCH_MASK) ==
 		    NET_6LO_DISPATCH_FRAG1) {
-			hdr_len = NET_6LO_FRAG1_HDR_LEN;
+			memmove(frag->data, frag->data + NET_6LO_FRAG1_HDR_LEN,
+				frag->len - NET_6LO_FRAG1_HDR_LEN);
+			frag->len -= NET_6LO_FRAG1_HDR_LEN;
+		} else {
+			net_buf_pull(frag, NET_6LO_FRAGN_HDR_LEN);
 		}
 
-		memmove(frag->data, frag->data + hdr_len, frag->len - hdr_len);
-		frag->len -= hdr_len;
-
 		frag = frag->frags;
 	}
 }
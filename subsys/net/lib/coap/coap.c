@@ -269,6 +269,10 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 	cpkt->opt_len += r;
 	cpkt->delta += code;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_indexed = false;
+#endif
+
 	return 0;
 }
 
@@ -430,7 +434,7 @@ static int decode_delta(uint8_t *data, uint16_t offset, uint16_t *pos, uint16_t
 
 static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 			uint16_t max_len, uint16_t *opt_delta, uint16_t *opt_len,
-			struct coap_option *option)
+			struct coap_option *option, uint16_t *value_len)
 {
 	uint16_t hdr_len;
 	uint16_t delta;
@@ -501,6 +505,10 @@ static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 		return -EINVAL;
 	}
 
+	if (value_len) {
+		*value_len = len;
+	}
+
 	if (option) {
 		/*
 		 * Make sure the option data will fit into the value field of
@@ -532,6 +540,70 @@ static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 	return r;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static void option_index_add(struct coap_packet *cpkt, uint16_t code,
+			     uint16_t offset)
+{
+	uint8_t len = cpkt->opt_index_len;
+
+	/* Options with the same number follow each other */
+	if (len > 0 && cpkt->opt_index[len - 1].code == code) {
+		return;
+	}
+
+	if (len == ARRAY_SIZE(cpkt->opt_index)) {
+		return;
+	}
+
+	cpkt->opt_index[len].code = code;
+	cpkt->opt_index[len].offset = offset;
+	cpkt->opt_index_len++;
+}
+
+/* Find where to start decoding the options to find the first option
+ * numbered code. Returns false if the packet has no such option.
+ */
+static bool option_index_find(const struct coap_packet *cpkt, uint16_t code,
+			      uint16_t *offset, uint16_t *delta)
+{
+	uint8_t i;
+
+	*offset = cpkt->hdr_len;
+	*delta = 0U;
+
+	if (!cpkt->opt_indexed) {
+		return true;
+	}
+
+	for (i = 0U; i < cpkt->opt_index_len; i++) {
+		if (cpkt->opt_index[i].code > code) {
+			return false;
+		}
+
+		/* The option delta is relative to the previous option */
+		*offset = cpkt->opt_index[i].offset;
+		*delta = i > 0 ? cpkt->opt_index[i - 1].code : 0U;
+
+		if (cpkt->opt_index[i].code == code) {
+			return true;
+		}
+	}
+
+	/* Options past a full index are not indexed */
+	return cpkt->opt_index_len == ARRAY_SIZE(cpkt->opt_index);
+}
+#else
+static inline bool option_index_find(const struct coap_packet *cpkt,
+				     uint16_t code, uint16_t *offset,
+				     uint16_t *delta)
+{
+	*offset = cpkt->hdr_len;
+	*delta = 0U;
+
+	return true;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 		      struct coap_option *options, uint8_t opt_num)
 {
@@ -561,6 +633,11 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_index_len = 0U;
+	cpkt->opt_indexed = false;
+#endif
+
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
 	if (tkl > 8) {
@@ -574,6 +651,9 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 
 	cpkt->offset = cpkt->hdr_len;
 	if (cpkt->hdr_len == len) {
+#if defined(CONFIG_COAP_OPTION_INDEX)
+		cpkt->opt_indexed = true;
+#endif
 		return 0;
 	}
 
@@ -584,13 +664,24 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 
 	while (1) {
 		struct coap_option *option;
+		uint16_t start = offset;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
-				   &delta, &opt_len, option);
+				   &delta, &opt_len, option, NULL);
 		if (ret < 0) {
 			return ret;
-		} else if (ret == 0) {
+		}
+
+#if defined(CONFIG_COAP_OPTION_INDEX)
+		if (cpkt->data[start] != COAP_MARKER) {
+			option_index_add(cpkt, delta, start);
+		}
+#else
+		ARG_UNUSED(start);
+#endif
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -599,6 +690,10 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->delta = delta;
 	cpkt->offset = offset;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_indexed = true;
+#endif
+
 	return 0;
 }
 
@@ -611,15 +706,17 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 	uint8_t num;
 	int r;
 
-	offset = cpkt->hdr_len;
+	if (!option_index_find(cpkt, code, &offset, &delta)) {
+		return 0;
+	}
+
 	opt_len = 0U;
-	delta = 0U;
 	num = 0U;
 
 	while (delta <= code && num < veclen) {
 		r = parse_option(cpkt->data, offset, &offset,
 				 cpkt->max_len, &delta, &opt_len,
-				 &options[num]);
+				 &options[num], NULL);
 		if (r < 0) {
 			return -EINVAL;
 		}
@@ -636,6 +733,41 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 	return num;
 }
 
+void coap_option_iter_init(struct coap_option_iter *iter,
+			   const struct coap_packet *cpkt)
+{
+	iter->cpkt = cpkt;
+	iter->offset = cpkt->hdr_len;
+	iter->delta = 0U;
+	iter->opt_len = 0U;
+}
+
+int coap_option_iter_next(struct coap_option_iter *iter, uint16_t *code,
+			  const uint8_t **value, uint16_t *len)
+{
+	const struct coap_packet *cpkt = iter->cpkt;
+	uint16_t value_len;
+	int r;
+
+	if (iter->offset >= cpkt->hdr_len + cpkt->opt_len ||
+	    cpkt->data[iter->offset] == COAP_MARKER) {
+		return 0;
+	}
+
+	r = parse_option(cpkt->data, iter->offset, &iter->offset,
+			 cpkt->max_len, &iter->delta, &iter->opt_len, NULL,
+			 &value_len);
+	if (r < 0) {
+		return -EINVAL;
+	}
+
+	*code = iter->delta;
+	*value = cpkt->data + iter->offset - value_len;
+	*len = value_len;
+
+	return 1;
+}
+
 uint8_t coap_header_get_version(const struct coap_packet *cpkt)
 {
 	if (!cpkt || !cpkt->data) {
@@ -822,6 +954,20 @@ static bool is_request(const struct coap_packet *cpkt)
 	return !(code & ~COAP_REQUEST_MASK);
 }
 
+static int call_method(struct coap_resource *resource,
+		       struct coap_packet *cpkt,
+		       struct sockaddr *addr, socklen_t addr_len)
+{
+	coap_method_t method;
+
+	method = method_from_code(resource, coap_header_get_code(cpkt));
+	if (!method) {
+		return -EPERM;
+	}
+
+	return method(resource, cpkt, addr, addr_len);
+}
+
 int coap_handle_request(struct coap_packet *cpkt,
 			struct coap_resource *resources,
 			struct coap_option *options,
@@ -836,26 +982,161 @@ int coap_handle_request(struct coap_packet *cpkt,
 
 	/* FIXME: deal with hierarchical resources */
 	for (resource = resources; resource && resource->path; resource++) {
-		coap_method_t method;
-		uint8_t code;
-
 		if (!uri_path_eq(cpkt, resource->path, options, opt_num)) {
 			continue;
 		}
 
-		code = coap_header_get_code(cpkt);
-		method = method_from_code(resource, code);
-		if (!method) {
-			return -EPERM;
-		}
-
-		return method(resource, cpkt, addr, addr_len);
+		return call_method(resource, cpkt, addr, addr_len);
 	}
 
 	NET_DBG("%d", __LINE__);
 	return -ENOENT;
 }
 
+/* FNV-1a over the path segments, each followed by a separator */
+static uint32_t path_hash_add(uint32_t hash, const uint8_t *segment,
+			      size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ segment[i]) * 16777619U;
+	}
+
+	return (hash ^ '/') * 16777619U;
+}
+
+#define PATH_HASH_INIT 2166136261U
+
+static bool path_has_wildcard(const char * const *path)
+{
+	for (; *path; path++) {
+		if (IS_ENABLED(CONFIG_COAP_URI_WILDCARD) &&
+		    (!strcmp(*path, "+") || !strcmp(*path, "#"))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int coap_router_init(struct coap_router *router,
+		     struct coap_resource *resources,
+		     uint16_t *table, uint16_t table_len)
+{
+	const char * const *path;
+	uint16_t i, slot, used = 0U;
+	uint32_t hash;
+
+	if (!router || !table || !table_len) {
+		return -EINVAL;
+	}
+
+	router->resources = resources;
+	router->table = table;
+	router->table_len = table_len;
+	router->wildcards = false;
+
+	for (slot = 0U; slot < table_len; slot++) {
+		table[slot] = COAP_ROUTER_EMPTY;
+	}
+
+	for (i = 0U; resources && resources[i].path; i++) {
+		if (path_has_wildcard(resources[i].path)) {
+			router->wildcards = true;
+			continue;
+		}
+
+		/* Keep one entry free to end the lookups */
+		if (++used >= table_len || i == COAP_ROUTER_EMPTY) {
+			return -ENOMEM;
+		}
+
+		hash = PATH_HASH_INIT;
+		for (path = resources[i].path; *path; path++) {
+			hash = path_hash_add(hash, (const uint8_t *)*path,
+					     strlen(*path));
+		}
+
+		/* Linear probing */
+		slot = hash % table_len;
+		while (table[slot] != COAP_ROUTER_EMPTY) {
+			slot = (slot + 1U) % table_len;
+		}
+
+		table[slot] = i;
+	}
+
+	return 0;
+}
+
+static struct coap_resource *router_find(struct coap_router *router,
+					 struct coap_packet *cpkt,
+					 struct coap_option *options,
+					 uint8_t opt_num)
+{
+	struct coap_resource *resource;
+	uint32_t hash = PATH_HASH_INIT;
+	uint16_t slot, index;
+	uint8_t i;
+
+	for (i = 0U; i < opt_num; i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			hash = path_hash_add(hash, options[i].value,
+					     options[i].len);
+		}
+	}
+
+	index = COAP_ROUTER_EMPTY;
+
+	for (slot = hash % router->table_len;
+	     router->table[slot] != COAP_ROUTER_EMPTY;
+	     slot = (slot + 1U) % router->table_len) {
+		resource = &router->resources[router->table[slot]];
+		if (uri_path_eq(cpkt, resource->path, options, opt_num)) {
+			index = router->table[slot];
+			break;
+		}
+	}
+
+	if (!router->wildcards) {
+		return index == COAP_ROUTER_EMPTY ? NULL :
+		       &router->resources[index];
+	}
+
+	/* A resource with wildcards listed first takes precedence */
+	for (resource = router->resources;
+	     resource->path && resource - router->resources < index;
+	     resource++) {
+		if (path_has_wildcard(resource->path) &&
+		    uri_path_eq(cpkt, resource->path, options, opt_num)) {
+			return resource;
+		}
+	}
+
+	return index == COAP_ROUTER_EMPTY ? NULL : &router->resources[index];
+}
+
+int coap_router_handle_request(struct coap_router *router,
+			       struct coap_packet *cpkt,
+			       struct coap_option *options,
+			       uint8_t opt_num,
+			       struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_resource *resource;
+
+	if (!is_request(cpkt)) {
+		return 0;
+	}
+
+	resource = router_find(router, cpkt, options, opt_num);
+	if (!resource) {
+		return -ENOENT;
+	}
+
+	return call_method(resource, cpkt, addr, addr_len);
+}
+
 int coap_block_transfer_init(struct coap_block_context *ctx,
 			      enum coap_block_size block_size,
 			      size_t total_size)
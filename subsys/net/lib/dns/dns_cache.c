@@ -0,0 +1,215 @@
+/** @file
+ * @brief DNS resolver cache
+ *
+ * Keeps the results of DNS queries until their TTL expires.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/dlist.h>
+
+#include <net/dns_resolve.h>
+#include "dns_internal.h"
+
+struct dns_cache_entry {
+	/** Link in the cache, most recently used first */
+	sys_dnode_t node;
+
+	/** Uptime (in ms) when the entry expires */
+	int64_t expires;
+
+	/** Cached addresses */
+	struct dns_addrinfo addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+
+	/** Cached name */
+	char query[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+
+	/** Query type (A or AAAA) */
+	enum dns_query_type type;
+
+	/** DNS_EAI_ALLDONE or DNS_EAI_NODATA */
+	enum dns_resolve_status status;
+
+	/** Number of cached addresses */
+	uint8_t count;
+};
+
+static struct dns_cache_entry cache[CONFIG_DNS_RESOLVER_CACHE_SIZE];
+
+/* Cached entries, most recently used first */
+static sys_dlist_t cache_lru = SYS_DLIST_STATIC_INIT(&cache_lru);
+
+/* The cache is filled from the network RX path and read by the
+ * applications resolving names.
+ */
+static K_MUTEX_DEFINE(cache_lock);
+
+static void cache_remove(struct dns_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+	entry->query[0] = '\0';
+}
+
+static void cache_expire(void)
+{
+	struct dns_cache_entry *entry, *next;
+	int64_t now = k_uptime_get();
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&cache_lru, entry, next, node) {
+		if (entry->expires <= now) {
+			NET_DBG("Entry %s expired",
+				log_strdup(entry->query));
+			cache_remove(entry);
+		}
+	}
+}
+
+static struct dns_cache_entry *cache_lookup(const char *query,
+					    enum dns_query_type type)
+{
+	struct dns_cache_entry *entry;
+
+	cache_expire();
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, entry, node) {
+		if (entry->type == type && !strcmp(entry->query, query)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   dns_resolve_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry *entry;
+	struct dns_cache_entry found;
+	int i;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(query, type);
+	if (!entry) {
+		k_mutex_unlock(&cache_lock);
+		return -ENOENT;
+	}
+
+	sys_dlist_remove(&entry->node);
+	sys_dlist_prepend(&cache_lru, &entry->node);
+
+	/* The callback is called without holding the lock, as it might
+	 * very well resolve another name.
+	 */
+	memcpy(&found, entry, sizeof(found));
+
+	k_mutex_unlock(&cache_lock);
+
+	NET_DBG("Cache hit for %s (%d addresses)", log_strdup(query),
+		found.count);
+
+	for (i = 0; i < found.count; i++) {
+		cb(DNS_EAI_INPROGRESS, &found.addrs[i], user_data);
+	}
+
+	cb(found.status, NULL, user_data);
+
+	return 0;
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   enum dns_resolve_status status,
+		   const struct dns_addrinfo *addrs, int count,
+		   uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	int i;
+
+	if (ttl == 0U || strlen(query) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(query, type);
+	if (entry) {
+		sys_dlist_remove(&entry->node);
+		goto found;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!sys_dnode_is_linked(&cache[i].node)) {
+			entry = &cache[i];
+			goto found;
+		}
+	}
+
+	/* Replace the least recently used entry */
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache_lru),
+			     struct dns_cache_entry, node);
+
+	NET_DBG("Replacing %s", log_strdup(entry->query));
+
+	sys_dlist_remove(&entry->node);
+
+found:
+	strcpy(entry->query, query);
+	entry->type = type;
+	entry->status = status;
+	entry->count = MIN(count, ARRAY_SIZE(entry->addrs));
+	memcpy(entry->addrs, addrs, entry->count * sizeof(entry->addrs[0]));
+	entry->expires = k_uptime_get() + (int64_t)ttl * MSEC_PER_SEC;
+
+	sys_dlist_prepend(&cache_lru, &entry->node);
+
+	k_mutex_unlock(&cache_lock);
+
+	NET_DBG("Cached %s (%d addresses) for %u s", log_strdup(query),
+		entry->count, ttl);
+}
+
+void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry *entry;
+	int64_t now;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	cache_expire();
+
+	now = k_uptime_get();
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, entry, node) {
+		cb(entry->query, entry->type, entry->status, entry->addrs,
+		   entry->count,
+		   (uint32_t)((entry->expires - now) / MSEC_PER_SEC),
+		   user_data);
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void dns_resolve_cache_flush(void)
+{
+	struct dns_cache_entry *entry, *next;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&cache_lru, entry, next, node) {
+		cache_remove(entry);
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	NET_DBG("DNS cache flushed");
+}
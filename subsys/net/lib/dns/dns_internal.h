@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/types.h>
+#include <errno.h>
 #include <net/buf.h>
 #include <net/dns_resolve.h>
 
@@ -16,3 +17,25 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     int *query_idx,
 		     struct net_buf *dns_cname,
 		     uint16_t *query_hash);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Pass the cached result for the query to the callback. Returns 0 if the
+ * name was found in the cache, -ENOENT otherwise.
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   dns_resolve_cb_t cb, void *user_data);
+
+/* Store the result of a query. The status is DNS_EAI_ALLDONE if addresses
+ * were received or DNS_EAI_NODATA if the name does not exist.
+ */
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   enum dns_resolve_status status,
+		   const struct dns_addrinfo *addrs, int count,
+		   uint32_t ttl);
+#else
+static inline int dns_cache_find(const char *query, enum dns_query_type type,
+				 dns_resolve_cb_t cb, void *user_data)
+{
+	return -ENOENT;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
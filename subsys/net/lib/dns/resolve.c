@@ -361,6 +361,49 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+static inline int get_slot_by_query(struct dns_resolve_context *ctx,
+				    const char *query,
+				    enum dns_query_type query_type)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].cb && !ctx->queries[i].leader &&
+		    ctx->queries[i].query_type == query_type &&
+		    !strcmp(ctx->queries[i].query, query)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Pass the result to the query and to the queries waiting for it. When
+ * the result is final, the waiting queries are done.
+ */
+static void query_cb(struct dns_resolve_context *ctx, int idx,
+		     enum dns_resolve_status status,
+		     struct dns_addrinfo *info)
+{
+	struct dns_pending_query *leader = &ctx->queries[idx];
+	int i;
+
+	leader->cb(status, info, leader->user_data);
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (!ctx->queries[i].cb || ctx->queries[i].leader != leader) {
+			continue;
+		}
+
+		ctx->queries[i].cb(status, info, ctx->queries[i].user_data);
+
+		if (status != DNS_EAI_INPROGRESS) {
+			ctx->queries[i].cb = NULL;
+			ctx->queries[i].leader = NULL;
+		}
+	}
+}
+
 int dns_validate_msg(struct dns_resolve_context *ctx,
 		     struct dns_msg_t *dns_msg,
 		     uint16_t *dns_id,
@@ -369,7 +412,11 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     uint16_t *query_hash)
 {
 	struct dns_addrinfo info = { 0 };
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_addrinfo cache_addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+	uint32_t cache_ttl = UINT32_MAX;
+#endif
+	uint32_t ttl; /* RR ttl, only used for caching */
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -450,22 +497,31 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 			goto quit;
 		}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/* The answer is valid as long as all the records of the
+		 * CNAME chain are.
+		 */
+		cache_ttl = MIN(cache_ttl, ttl);
+#endif
+
 		switch (dns_msg->response_type) {
 		case DNS_RESPONSE_IP:
-			if (*query_idx >= 0) {
-				goto query_known;
-			}
-
-			query_name = dns_msg->msg + dns_msg->query_offset;
+			if (*query_idx < 0) {
+				query_name = dns_msg->msg +
+					dns_msg->query_offset;
 
-			/* Add \0 and query type (A or AAAA) to the hash */
-			*query_hash = crc16_ansi(query_name,
-						 strlen(query_name) + 1 + 2);
+				/* Add \0 and query type (A or AAAA) to the
+				 * hash
+				 */
+				*query_hash = crc16_ansi(query_name,
+						strlen(query_name) + 1 + 2);
 
-			*query_idx = get_slot_by_id(ctx, *dns_id, *query_hash);
-			if (*query_idx < 0) {
-				ret = DNS_EAI_SYSTEM;
-				goto quit;
+				*query_idx = get_slot_by_id(ctx, *dns_id,
+							    *query_hash);
+				if (*query_idx < 0) {
+					ret = DNS_EAI_SYSTEM;
+					goto quit;
+				}
 			}
 
 			if (ctx->queries[*query_idx].query_type ==
@@ -528,9 +584,14 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
-		query_known:
-			ctx->queries[*query_idx].cb(DNS_EAI_INPROGRESS, &info,
-					ctx->queries[*query_idx].user_data);
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(cache_addrs)) {
+				memcpy(&cache_addrs[items], &info,
+				       sizeof(info));
+			}
+#endif
+
+			query_cb(ctx, *query_idx, DNS_EAI_INPROGRESS, &info);
 			items++;
 			break;
 
@@ -602,6 +663,22 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		ret = DNS_EAI_ALLDONE;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (items) {
+		dns_cache_add(ctx->queries[*query_idx].query,
+			      ctx->queries[*query_idx].query_type, ret,
+			      cache_addrs, items, cache_ttl);
+	} else if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NOERROR ||
+		   dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		/* Only an authoritative "no such name" or "no such
+		 * address" is cached, not a server failure (RFC 2308).
+		 */
+		dns_cache_add(ctx->queries[*query_idx].query,
+			      ctx->queries[*query_idx].query_type, ret,
+			      NULL, 0, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+	}
+#endif
+
 quit:
 	return ret;
 }
@@ -647,8 +724,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 	}
 
 	/* Marks the end of the results */
-	ctx->queries[query_idx].cb(ret, NULL,
-				   ctx->queries[query_idx].user_data);
+	query_cb(ctx, query_idx, ret, NULL);
 	ctx->queries[query_idx].cb = NULL;
 
 	net_pkt_unref(pkt);
@@ -750,7 +826,7 @@ quit:
 	}
 
 	/* Marks the end of the results */
-	ctx->queries[i].cb(ret, NULL, ctx->queries[i].user_data);
+	query_cb(ctx, i, ret, NULL);
 	ctx->queries[i].cb = NULL;
 
 free_buf:
@@ -859,8 +935,9 @@ static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 		k_delayed_work_cancel(&ctx->queries[i].timer);
 	}
 
-	ctx->queries[i].cb(DNS_EAI_CANCELED, NULL, ctx->queries[i].user_data);
+	query_cb(ctx, i, DNS_EAI_CANCELED, NULL);
 	ctx->queries[i].cb = NULL;
+	ctx->queries[i].leader = NULL;
 
 	return 0;
 }
@@ -1012,11 +1089,21 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (!dns_cache_find(query, type, cb, user_data)) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
 	}
 
+	j = get_slot_by_query(ctx, query, type);
+
 	ctx->queries[i].cb = cb;
 	ctx->queries[i].timeout = tout;
 	ctx->queries[i].query = query;
@@ -1024,9 +1111,27 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].leader = NULL;
 
 	k_delayed_work_init(&ctx->queries[i].timer, query_timeout);
 
+	if (j >= 0) {
+		/* The same name is being resolved already, wait for the
+		 * result of that query instead of sending another one. The
+		 * id is only used for cancelling this query.
+		 */
+		ctx->queries[i].leader = &ctx->queries[j];
+		ctx->queries[i].id = sys_rand32_get();
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		NET_DBG("[%u] waiting for query %d", i, j);
+
+		return 0;
+	}
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
@@ -352,6 +352,9 @@ static int on_message_complete(struct http_parser *parser)
 
 	req->internal.response.message_complete = 1;
 
+	/* Whatever follows belongs to the next pipelined response */
+	http_parser_pause(parser, 1);
+
 	if (req->internal.response.cb) {
 		req->internal.response.cb(&req->internal.response,
 					  HTTP_DATA_FINAL,
@@ -406,16 +409,32 @@ static void http_client_init_parser(struct http_parser *parser,
 	settings->on_url = on_url;
 }
 
-static int http_wait_data(int sock, struct http_request *req)
+/* The first pending bytes of the receive buffer were received with the
+ * previous response of the connection. The bytes received past the end of
+ * the response are returned in unparsed and unparsed_len.
+ */
+static int http_wait_data(int sock, struct http_request *req, size_t pending,
+			  uint8_t **unparsed, size_t *unparsed_len)
 {
 	int total_received = 0;
 	size_t offset = 0;
+	size_t parsed;
 	int received, ret;
 
+	*unparsed = NULL;
+	*unparsed_len = 0;
+
 	do {
-		received = recv(sock, req->internal.response.recv_buf + offset,
+		if (pending > 0) {
+			received = pending;
+			pending = 0;
+		} else {
+			received = recv(
+				sock, req->internal.response.recv_buf + offset,
 				req->internal.response.recv_buf_len - offset,
 				0);
+		}
+
 		if (received == 0) {
 			/* Connection closed */
 			LOG_DBG("Connection closed");
@@ -429,11 +448,18 @@ static int http_wait_data(int sock, struct http_request *req)
 		} else {
 			req->internal.response.data_len += received;
 
-			(void)http_parser_execute(
+			parsed = http_parser_execute(
 				&req->internal.parser,
 				&req->internal.parser_settings,
 				req->internal.response.recv_buf + offset,
 				received);
+
+			if (req->internal.response.message_complete &&
+			    parsed < (size_t)received) {
+				*unparsed = req->internal.response.recv_buf +
+					    offset + parsed;
+				*unparsed_len = received - parsed;
+			}
 		}
 
 		total_received += received;
@@ -461,15 +487,15 @@ static void http_timeout(struct k_work *work)
 	(void)close(data->sock);
 }
 
-int http_client_req(int sock, struct http_request *req,
-		    int32_t timeout, void *user_data)
+static int http_send_req(int sock, struct http_request *req,
+			 int32_t timeout, void *user_data)
 {
 	/* Utilize the network usage by sending data in bigger blocks */
 	char send_buf[MAX_SEND_BUF_LEN];
 	const size_t send_buf_max_len = sizeof(send_buf);
 	size_t send_buf_pos = 0;
 	int total_sent = 0;
-	int ret, total_recv, i;
+	int ret, i;
 	const char *method;
 
 	if (sock < 0 || req == NULL || req->response == NULL ||
@@ -650,6 +676,17 @@ int http_client_req(int sock, struct http_request *req,
 	http_client_init_parser(&req->internal.parser,
 				&req->internal.parser_settings);
 
+	return total_sent;
+
+out:
+	return ret;
+}
+
+static int http_recv_rsp(struct http_request *req, size_t pending,
+			 uint8_t **unparsed, size_t *unparsed_len)
+{
+	int total_recv;
+
 	if (!K_TIMEOUT_EQ(req->internal.timeout, K_FOREVER) &&
 	    !K_TIMEOUT_EQ(req->internal.timeout, K_NO_WAIT)) {
 		k_delayed_work_init(&req->internal.work, http_timeout);
@@ -658,7 +695,8 @@ int http_client_req(int sock, struct http_request *req,
 	}
 
 	/* Request is sent, now wait data to be received */
-	total_recv = http_wait_data(sock, req);
+	total_recv = http_wait_data(req->internal.sock, req, pending, unparsed,
+				    unparsed_len);
 	if (total_recv < 0) {
 		NET_DBG("Wait data failure (%d)", total_recv);
 	} else {
@@ -670,8 +708,347 @@ int http_client_req(int sock, struct http_request *req,
 		(void)k_delayed_work_cancel(&req->internal.work);
 	}
 
+	return total_recv;
+}
+
+int http_client_req(int sock, struct http_request *req,
+		    int32_t timeout, void *user_data)
+{
+	uint8_t *unparsed;
+	size_t unparsed_len;
+	int total_sent;
+
+	total_sent = http_send_req(sock, req, timeout, user_data);
+	if (total_sent < 0) {
+		return total_sent;
+	}
+
+	(void)http_recv_rsp(req, 0, &unparsed, &unparsed_len);
+
 	return total_sent;
+}
+
+#if defined(CONFIG_HTTP_CLIENT_POOL)
+struct http_pool_conn {
+	/** Server of the connection */
+	char host[CONFIG_HTTP_CLIENT_POOL_HOST_LEN + 1];
+	char port[sizeof("65535")];
+
+	/** Uptime (in ms) when the connection was last used */
+	int64_t last_used;
+
+	/** Connected socket, -1 if the entry is free */
+	int sock;
+
+	/** A request is using the connection */
+	bool busy;
+};
+
+static struct http_pool_conn pool[CONFIG_HTTP_CLIENT_POOL_SIZE];
+static http_client_connect_cb_t pool_connect;
+static void *pool_user_data;
+static K_MUTEX_DEFINE(pool_lock);
+
+static void pool_close(struct http_pool_conn *conn)
+{
+	NET_DBG("Closing connection to %s:%s", log_strdup(conn->host),
+		log_strdup(conn->port));
+
+	(void)close(conn->sock);
+	conn->sock = -1;
+}
+
+static bool pool_match(struct http_pool_conn *conn, const char *host,
+		       const char *port)
+{
+	return !strcmp(conn->host, host) && !strcmp(conn->port, port);
+}
+
+static int pool_get(const char *host, const char *port,
+		    struct http_pool_conn **found, bool *reused)
+{
+	struct http_pool_conn *conn = NULL;
+	int64_t now = k_uptime_get();
+	int sock;
+	int i;
+
+	if (strlen(host) >= sizeof(pool[0].host) ||
+	    strlen(port) >= sizeof(pool[0].port)) {
+		return -ENAMETOOLONG;
+	}
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	/* Servers close idle connections, do not try to reuse them */
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].sock >= 0 && !pool[i].busy &&
+		    now - pool[i].last_used >
+		    CONFIG_HTTP_CLIENT_POOL_IDLE_TIMEOUT * MSEC_PER_SEC) {
+			pool_close(&pool[i]);
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].sock >= 0 && !pool[i].busy &&
+		    pool_match(&pool[i], host, port)) {
+			pool[i].busy = true;
+			k_mutex_unlock(&pool_lock);
+
+			NET_DBG("Reusing connection to %s:%s",
+				log_strdup(host), log_strdup(port));
+
+			*found = &pool[i];
+			*reused = true;
+
+			return 0;
+		}
+	}
+
+	/* Take a free entry or the least recently used idle connection */
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].busy) {
+			continue;
+		}
+
+		if (pool[i].sock < 0) {
+			conn = &pool[i];
+			break;
+		}
+
+		if (conn == NULL || pool[i].last_used < conn->last_used) {
+			conn = &pool[i];
+		}
+	}
+
+	if (conn == NULL) {
+		k_mutex_unlock(&pool_lock);
+		return -EBUSY;
+	}
+
+	if (conn->sock >= 0) {
+		pool_close(conn);
+	}
+
+	conn->busy = true;
+	strcpy(conn->host, host);
+	strcpy(conn->port, port);
+
+	k_mutex_unlock(&pool_lock);
+
+	sock = pool_connect(host, port, pool_user_data);
+	if (sock < 0) {
+		NET_DBG("Cannot connect to %s:%s (%d)", log_strdup(host),
+			log_strdup(port), sock);
+
+		k_mutex_lock(&pool_lock, K_FOREVER);
+		conn->busy = false;
+		k_mutex_unlock(&pool_lock);
+
+		return sock;
+	}
+
+	conn->sock = sock;
+
+	*found = conn;
+	*reused = false;
+
+	return 0;
+}
+
+static void pool_put(struct http_pool_conn *conn, bool keep)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	if (keep) {
+		conn->last_used = k_uptime_get();
+	} else {
+		pool_close(conn);
+	}
+
+	conn->busy = false;
+
+	k_mutex_unlock(&pool_lock);
+}
+
+/* The server may close a kept connection at any time, such requests are
+ * sent again on a new connection (RFC 7230 ch 6.3.1).
+ */
+static bool is_idempotent(enum http_method method)
+{
+	return method == HTTP_GET || method == HTTP_HEAD ||
+	       method == HTTP_OPTIONS || method == HTTP_PUT ||
+	       method == HTTP_DELETE;
+}
+
+static bool rsp_started(struct http_request *req)
+{
+	return req->internal.response.http_status[0] != '\0';
+}
+
+/* Sends the requests on the connection, without waiting for the responses
+ * in between, and receives the responses in order.
+ */
+static int pool_send_reqs(struct http_pool_conn *conn,
+			  struct http_request *reqs[], size_t count,
+			  int32_t timeout, void *user_data, bool *keep)
+{
+	uint8_t *unparsed = NULL;
+	size_t unparsed_len = 0;
+	int total_sent = 0;
+	int ret;
+	size_t i;
+
+	*keep = false;
+
+	for (i = 0; i < count; i++) {
+		ret = http_send_req(conn->sock, reqs[i], timeout, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		total_sent += ret;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (unparsed_len > reqs[i]->recv_buf_len) {
+			NET_DBG("Pipelined response does not fit (%zd > %zd)",
+				unparsed_len, reqs[i]->recv_buf_len);
+			return -EMSGSIZE;
+		}
+
+		if (unparsed_len > 0) {
+			memmove(reqs[i]->recv_buf, unparsed, unparsed_len);
+		}
+
+		ret = http_recv_rsp(reqs[i], unparsed_len, &unparsed,
+				    &unparsed_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (!rsp_started(reqs[i])) {
+			return -ECONNRESET;
+		}
+
+		/* The server closes the connection, possibly to end the
+		 * body. The requests left were not handled.
+		 */
+		if (!reqs[i]->internal.response.message_complete ||
+		    !http_should_keep_alive(&reqs[i]->internal.parser)) {
+			return i + 1 < count ? -ECONNRESET : total_sent;
+		}
+	}
+
+	/* Nothing more is expected from this server */
+	*keep = (unparsed_len == 0);
+
+	return total_sent;
+}
+
+void http_client_pool_init(http_client_connect_cb_t connect_cb,
+			   void *user_data)
+{
+	int i;
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].busy) {
+			continue;
+		}
+
+		/* The connections are only valid once initialized */
+		if (pool_connect != NULL && pool[i].sock >= 0) {
+			pool_close(&pool[i]);
+		}
+
+		pool[i].sock = -1;
+	}
+
+	pool_connect = connect_cb;
+	pool_user_data = user_data;
+
+	k_mutex_unlock(&pool_lock);
+}
+
+int http_client_pool_pipeline(struct http_request *reqs[], size_t count,
+			      int32_t timeout, void *user_data)
+{
+	struct http_pool_conn *conn;
+	const char *port;
+	bool reused, keep;
+	int ret;
+	size_t i;
+
+	if (pool_connect == NULL || reqs == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (reqs[i] == NULL || reqs[i]->host == NULL ||
+		    strcmp(reqs[i]->host, reqs[0]->host) ||
+		    (reqs[i]->port == NULL) != (reqs[0]->port == NULL) ||
+		    (reqs[i]->port && strcmp(reqs[i]->port, reqs[0]->port))) {
+			return -EINVAL;
+		}
+	}
+
+	port = reqs[0]->port ? reqs[0]->port : "";
+
+	ret = pool_get(reqs[0]->host, port, &conn, &reused);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = pool_send_reqs(conn, reqs, count, timeout, user_data, &keep);
+
+	/* Nothing was received on a kept connection: it was closed by the
+	 * server before the requests reached it, try again once.
+	 */
+	if (ret < 0 && reused && !rsp_started(reqs[0])) {
+		for (i = 0; i < count; i++) {
+			if (!is_idempotent(reqs[i]->method)) {
+				goto out;
+			}
+		}
+
+		NET_DBG("Kept connection closed, reconnecting");
+
+		pool_put(conn, false);
+
+		ret = pool_get(reqs[0]->host, port, &conn, &reused);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = pool_send_reqs(conn, reqs, count, timeout, user_data,
+				     &keep);
+	}
 
 out:
+	pool_put(conn, ret >= 0 && keep);
+
 	return ret;
 }
+
+int http_client_pool_req(struct http_request *req, int32_t timeout,
+			 void *user_data)
+{
+	return http_client_pool_pipeline(&req, 1, timeout, user_data);
+}
+
+void http_client_pool_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].sock >= 0 && !pool[i].busy) {
+			pool_close(&pool[i]);
+		}
+	}
+
+	k_mutex_unlock(&pool_lock);
+}
+#endif /* CONFIG_HTTP_CLIENT_POOL */
@@ -84,6 +84,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 struct observe_node {
 	sys_snode_t node;
+	/* link in the observers of the observed object or instance */
+	sys_snode_t target_node;
+	sys_slist_t *target;
 	struct lwm2m_ctx *ctx;
 	struct lwm2m_obj_path path;
 	uint8_t  token[MAX_TOKEN_LEN];
@@ -124,6 +127,9 @@ static sys_slist_t engine_obj_inst_list;
 static sys_slist_t engine_observer_list;
 static sys_slist_t engine_service_list;
 
+/* object instances hashed by object and instance ID */
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_OBJ_INST_HASH_SIZE];
+
 static K_KERNEL_STACK_DEFINE(engine_thread_stack,
 			      CONFIG_LWM2M_ENGINE_STACK_SIZE);
 static struct k_thread engine_thread_data;
@@ -356,22 +362,21 @@ static void clear_attrs(void *ref)
 	}
 }
 
-int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
+static int notify_observers(sys_slist_t *observers, uint16_t obj_inst_id,
+			    uint16_t res_id)
 {
 	struct observe_node *obs;
 	int ret = 0;
 
-	/* look for observers which match our resource */
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
-		if (obs->path.obj_id == obj_id &&
-		    obs->path.obj_inst_id == obj_inst_id &&
+	SYS_SLIST_FOR_EACH_CONTAINER(observers, obs, target_node) {
+		if (obs->path.obj_inst_id == obj_inst_id &&
 		    (obs->path.level < 3 ||
 		     obs->path.res_id == res_id)) {
 			/* update the event time for this observer */
 			obs->event_timestamp = k_uptime_get();
 
 			LOG_DBG("NOTIFY EVENT %u/%u/%u",
-				obj_id, obj_inst_id, res_id);
+				obs->path.obj_id, obj_inst_id, res_id);
 
 			ret++;
 		}
@@ -380,6 +385,34 @@ int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id
 	return ret;
 }
 
+static int engine_notify_obj_inst(struct lwm2m_engine_obj_inst *obj_inst,
+				  uint16_t res_id)
+{
+	return notify_observers(&obj_inst->obj->observers,
+				obj_inst->obj_inst_id, res_id) +
+	       notify_observers(&obj_inst->observers,
+				obj_inst->obj_inst_id, res_id);
+}
+
+int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_obj *obj;
+
+	/* only the observers of this object and instance can match */
+	obj_inst = get_engine_obj_inst(obj_id, obj_inst_id);
+	if (obj_inst) {
+		return engine_notify_obj_inst(obj_inst, res_id);
+	}
+
+	obj = get_engine_obj(obj_id);
+	if (!obj) {
+		return 0;
+	}
+
+	return notify_observers(&obj->observers, obj_inst_id, res_id);
+}
+
 int lwm2m_notify_observer_path(struct lwm2m_obj_path *path)
 {
 	return lwm2m_notify_observer(path->obj_id, path->obj_inst_id,
@@ -523,8 +556,12 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].max_period_sec = MAX(attrs.pmax, attrs.pmin);
 	observe_node_data[i].format = format;
 	observe_node_data[i].counter = OBSERVE_COUNTER_START;
+	observe_node_data[i].target = obj_inst ? &obj_inst->observers :
+						 &obj->observers;
 	sys_slist_append(&engine_observer_list,
 			 &observe_node_data[i].node);
+	sys_slist_append(observe_node_data[i].target,
+			 &observe_node_data[i].target_node);
 
 	LOG_DBG("OBSERVER ADDED %u/%u/%u(%u) token:'%s' addr:%s",
 		msg->path.obj_id, msg->path.obj_inst_id,
@@ -535,6 +572,14 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	return 0;
 }
 
+static void engine_free_observer(sys_snode_t *prev_node,
+				 struct observe_node *obs)
+{
+	sys_slist_remove(&engine_observer_list, prev_node, &obs->node);
+	sys_slist_find_and_remove(obs->target, &obs->target_node);
+	(void)memset(obs, 0, sizeof(*obs));
+}
+
 static int engine_remove_observer(const uint8_t *token, uint8_t tkl)
 {
 	struct observe_node *obs, *found_obj = NULL;
@@ -560,8 +605,7 @@ static int engine_remove_observer(const uint8_t *token, uint8_t tkl)
 		return -ENOENT;
 	}
 
-	sys_slist_remove(&engine_observer_list, prev_node, &found_obj->node);
-	(void)memset(found_obj, 0, sizeof(*found_obj));
+	engine_free_observer(prev_node, found_obj);
 
 	LOG_DBG("observer '%s' removed", log_strdup(sprint_token(token, tkl)));
 
@@ -582,8 +626,7 @@ static void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id)
 			continue;
 		}
 
-		sys_slist_remove(&engine_observer_list, prev_node, &obs->node);
-		(void)memset(obs, 0, sizeof(*obs));
+		engine_free_observer(prev_node, obs);
 	}
 }
 
@@ -591,6 +634,7 @@ static void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id)
 
 void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 {
+	sys_slist_init(&obj->observers);
 	sys_slist_append(&engine_obj_list, &obj->node);
 }
 
@@ -631,9 +675,20 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 /* engine object instance */
 
+static sys_slist_t *obj_inst_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = (uint32_t)obj_id * 31U + obj_inst_id;
+
+	return &engine_obj_inst_hash[hash % ARRAY_SIZE(engine_obj_inst_hash)];
+}
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
+	sys_slist_init(&obj_inst->observers);
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_prepend(obj_inst_bucket(obj_inst->obj->obj_id,
+					  obj_inst->obj_inst_id),
+			  &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -641,6 +696,9 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_bucket(obj_inst->obj->obj_id,
+						  obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
@@ -648,8 +706,13 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX ||
+	    obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_bucket(obj_id, obj_inst_id),
+				     obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -1550,7 +1613,7 @@ static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
 	}
 
 	if (changed) {
-		NOTIFY_OBSERVER_PATH(&path);
+		engine_notify_obj_inst(obj_inst, path.res_id);
 	}
 
 	return ret;
@@ -2464,7 +2527,7 @@ int lwm2m_write_handler(struct lwm2m_engine_obj_inst *obj_inst,
 					 last_block, total_size);
 	}
 
-	NOTIFY_OBSERVER_PATH(&msg->path);
+	engine_notify_obj_inst(obj_inst, msg->path.res_id);
 
 	return ret;
 }
@@ -4011,11 +4074,50 @@ cleanup:
 	return ret;
 }
 
+static bool engine_notify_held(void)
+{
+	/* the notifications are sent after the next registration update */
+	return IS_ENABLED(CONFIG_LWM2M_QUEUE_MODE_HOLD_NOTIFY) &&
+	       engine_is_rx_off();
+}
+
+/* Uptime (in ms) after which the observer is to be notified */
+static int64_t observer_next_due(struct observe_node *obs)
+{
+	/* pending change, notify once pmin has elapsed */
+	if (obs->event_timestamp > obs->last_timestamp) {
+		return obs->last_timestamp +
+		       MSEC_PER_SEC * (int64_t)obs->min_period_sec;
+	}
+
+	/* no change, notify when pmax expires */
+	return obs->last_timestamp +
+	       MSEC_PER_SEC * (int64_t)obs->max_period_sec;
+}
+
 int32_t engine_next_service_timeout_ms(uint32_t max_timeout)
 {
+	struct observe_node *obs;
 	struct service_node *srv;
 	uint64_t time_left_ms, timestamp = k_uptime_get();
 	uint32_t timeout = max_timeout;
+	int64_t due;
+
+	/* observers are notified once the due time has passed */
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		if (engine_notify_held()) {
+			break;
+		}
+
+		due = observer_next_due(obs) + 1 - (int64_t)timestamp;
+		if (due <= 0) {
+			return 0;
+		}
+
+		if (due < timeout) {
+			timeout = due;
+		}
+	}
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_service_list, srv, node) {
 		time_left_ms = srv->last_timestamp + srv->min_call_period;
@@ -4060,9 +4162,75 @@ int lwm2m_engine_add_service(k_work_handler_t service, uint32_t period_ms)
 	return 0;
 }
 
-static int lwm2m_engine_service(void)
+/* Was a notification sent to the server of this observer in this round */
+static bool observer_ctx_notified(struct observe_node *obs, int64_t round)
+{
+	struct observe_node *other;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, other, node) {
+		if (other->ctx == obs->ctx && other->last_timestamp == round) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void engine_service_observers(int64_t timestamp)
 {
 	struct observe_node *obs;
+	bool manual;
+
+	if (engine_notify_held()) {
+		return;
+	}
+
+	/*
+	 * manual notify requirements:
+	 * - event_timestamp > last_timestamp
+	 * - current timestamp > last_timestamp + min_period_sec
+	 *
+	 * automatic time-based notify requirements:
+	 * - current timestamp > last_timestamp + max_period_sec
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		if (timestamp > observer_next_due(obs)) {
+			manual = obs->event_timestamp > obs->last_timestamp;
+			obs->last_timestamp = timestamp;
+			generate_notify_message(obs, manual);
+		}
+	}
+
+	if (CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS == 0) {
+		return;
+	}
+
+	/*
+	 * The radio is up for the server anyway, so send the time-based
+	 * notifications that would be due shortly after along with this
+	 * round. pmin is still honored.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		if (obs->last_timestamp == timestamp ||
+		    timestamp <= obs->last_timestamp +
+				 MSEC_PER_SEC * (int64_t)obs->min_period_sec ||
+		    observer_next_due(obs) >
+				timestamp + CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS ||
+		    !observer_ctx_notified(obs, timestamp)) {
+			continue;
+		}
+
+		LOG_DBG("NOTIFY EARLY %u/%u/%u(%u)", obs->path.obj_id,
+			obs->path.obj_inst_id, obs->path.res_id,
+			obs->path.level);
+
+		obs->last_timestamp = timestamp;
+		generate_notify_message(obs, false);
+	}
+}
+
+static int lwm2m_engine_service(void)
+{
 	struct service_node *srv;
 	int64_t timestamp, service_due_timestamp;
 
@@ -4072,30 +4240,7 @@ static int lwm2m_engine_service(void)
 	 * 3. For each observer match, generate a NOTIFY message,
 	 *    attaching the notify response handler
 	 */
-	timestamp = k_uptime_get();
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
-		/*
-		 * manual notify requirements:
-		 * - event_timestamp > last_timestamp
-		 * - current timestamp > last_timestamp + min_period_sec
-		 */
-		if (obs->event_timestamp > obs->last_timestamp &&
-		    timestamp > obs->last_timestamp +
-				MSEC_PER_SEC * obs->min_period_sec) {
-			obs->last_timestamp = k_uptime_get();
-			generate_notify_message(obs, true);
-
-		/*
-		 * automatic time-based notify requirements:
-		 * - current timestamp > last_timestamp + max_period_sec
-		 */
-		} else if (timestamp > obs->last_timestamp +
-				MSEC_PER_SEC * obs->max_period_sec) {
-			obs->last_timestamp = k_uptime_get();
-			generate_notify_message(obs, false);
-		}
-
-	}
+	engine_service_observers(k_uptime_get());
 
 	timestamp = k_uptime_get();
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_service_list, srv, node) {
@@ -4127,9 +4272,7 @@ int lwm2m_engine_context_close(struct lwm2m_ctx *client_ctx)
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&engine_observer_list,
 					  obs, tmp, node) {
 		if (obs->ctx == client_ctx) {
-			sys_slist_remove(&engine_observer_list, prev_node,
-					 &obs->node);
-			(void)memset(obs, 0, sizeof(*obs));
+			engine_free_observer(prev_node, obs);
 		} else {
 			prev_node = &obs->node;
 		}
@@ -177,6 +177,9 @@ struct lwm2m_engine_obj {
 	/* object list */
 	sys_snode_t node;
 
+	/* observers of the whole object */
+	sys_slist_t observers;
+
 	/* object field definitions */
 	struct lwm2m_engine_obj_field *fields;
 
@@ -347,6 +350,12 @@ struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
 
+	/* instance lookup table bucket */
+	sys_snode_t hash_node;
+
+	/* observers of the instance and of its resources */
+	sys_slist_t observers;
+
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
 
@@ -125,6 +125,11 @@ void engine_update_tx_time(void)
 	client.last_tx = k_uptime_get();
 }
 
+bool engine_is_rx_off(void)
+{
+	return client.engine_state == ENGINE_REGISTRATION_DONE_RX_OFF;
+}
+
 static void set_sm_state(uint8_t sm_state)
 {
 	enum lwm2m_rd_client_event event = LWM2M_RD_CLIENT_EVENT_NONE;
@@ -1057,6 +1062,11 @@ void lwm2m_rd_client_stop(struct lwm2m_ctx *client_ctx,
 	LOG_INF("Stop LWM2M Client: %s", log_strdup(client.ep_name));
 }
 
+void lwm2m_rd_client_update(void)
+{
+	engine_trigger_update(false);
+}
+
 static int lwm2m_rd_client_init(const struct device *dev)
 {
 	return lwm2m_engine_add_service(lwm2m_rd_client_service,
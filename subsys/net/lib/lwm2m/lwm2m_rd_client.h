@@ -44,5 +44,6 @@ void engine_bootstrap_finish(void);
 #endif
 
 void engine_update_tx_time(void);
+bool engine_is_rx_off(void);
 
 #endif /* LWM2M_RD_CLIENT_H */
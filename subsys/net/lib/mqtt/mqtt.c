@@ -236,49 +236,291 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
-int mqtt_publish(struct mqtt_client *client,
-		 const struct mqtt_publish_param *param)
+/* Only the headers are encoded in the TX buffer, the payload is sent from
+ * the buffers of the caller.
+ */
+static int publish_write(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param,
+			 const struct iovec *payload, size_t payload_count)
 {
-	int err_code;
+	struct iovec io_vector[1 + CONFIG_MQTT_PUBLISH_IOV_MAX];
 	struct buf_ctx packet;
-	struct iovec io_vector[2];
 	struct msghdr msg;
+	int err_code;
+	size_t i;
 
-	NULL_PARAM_CHECK(client);
-	NULL_PARAM_CHECK(param);
-
-	MQTT_TRC("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
-		 "Data size 0x%08x", client, client->internal.state,
-		 param->message.topic.topic.size,
-		 param->message.payload.len);
-
-	mqtt_mutex_lock(client);
+	if (payload_count > CONFIG_MQTT_PUBLISH_IOV_MAX) {
+		return -EINVAL;
+	}
 
 	tx_buf_init(client, &packet);
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
-		goto error;
+		return err_code;
 	}
 
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
-		goto error;
+		return err_code;
 	}
 
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
+
+	for (i = 0; i < payload_count; i++) {
+		io_vector[1 + i] = payload[i];
+	}
 
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_iovlen = 1 + payload_count;
 
-	err_code = client_write_msg(client, &msg);
+	return client_write_msg(client, &msg);
+}
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+static struct mqtt_inflight *inflight_find(struct mqtt_client *client,
+					   uint16_t message_id)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		if (client->internal.inflight[i].param.message_id ==
+		    message_id) {
+			return &client->internal.inflight[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void inflight_free(struct mqtt_inflight *entry)
+{
+	memset(entry, 0, sizeof(*entry));
+}
+
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			const struct iovec *payload, size_t payload_count,
+			struct mqtt_inflight **entry)
+{
+	*entry = NULL;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if (param->message_id == 0U) {
+		return -EINVAL;
+	}
+
+	/* A message sent again by the application keeps its entry */
+	*entry = inflight_find(client, param->message_id);
+	if (*entry == NULL) {
+		*entry = inflight_find(client, 0U);
+	}
+
+	if (*entry == NULL) {
+		MQTT_TRC("[CID %p]: Inflight window full", client);
+		return -EBUSY;
+	}
+
+	(*entry)->param = *param;
+	(*entry)->released = 0U;
+	(*entry)->payload_count = payload_count;
+	memcpy((*entry)->payload, payload, payload_count * sizeof(*payload));
+
+	return 0;
+}
+
+void mqtt_inflight_ack(struct mqtt_client *client, uint16_t message_id)
+{
+	struct mqtt_inflight *entry;
+
+	if (message_id == 0U) {
+		return;
+	}
+
+	entry = inflight_find(client, message_id);
+	if (entry != NULL) {
+		inflight_free(entry);
+	}
+}
+
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id)
+{
+	struct mqtt_inflight *entry;
+
+	if (message_id == 0U) {
+		return;
+	}
+
+	entry = inflight_find(client, message_id);
+	if (entry != NULL) {
+		entry->released = 1U;
+	}
+}
+
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present)
+{
+	struct mqtt_inflight *entry;
+	struct buf_ctx packet;
+	int err_code;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		entry = &client->internal.inflight[i];
+
+		if (entry->param.message_id == 0U) {
+			continue;
+		}
+
+		if (entry->released) {
+			struct mqtt_pubrel_param rel_param = {
+				.message_id = entry->param.message_id,
+			};
+
+			/* Without a session the broker has nothing left to
+			 * release, the message was already delivered.
+			 */
+			if (!session_present) {
+				inflight_free(entry);
+				continue;
+			}
+
+			MQTT_TRC("[CID %p]: Resending PUBREL 0x%04x", client,
+				 rel_param.message_id);
+
+			tx_buf_init(client, &packet);
+
+			err_code = publish_release_encode(&rel_param, &packet);
+			if (err_code < 0) {
+				return err_code;
+			}
+
+			err_code = client_write(client, packet.cur,
+						packet.end - packet.cur);
+		} else {
+			MQTT_TRC("[CID %p]: Resending PUBLISH 0x%04x", client,
+				 entry->param.message_id);
+
+			entry->param.dup_flag = 1U;
+
+			err_code = publish_write(client, &entry->param,
+						 entry->payload,
+						 entry->payload_count);
+		}
+
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_INFLIGHT */
+
+static int publish_payload(struct mqtt_client *client,
+			   const struct mqtt_publish_param *param,
+			   const struct iovec *payload, size_t payload_count)
+{
+#if defined(CONFIG_MQTT_INFLIGHT)
+	struct mqtt_inflight *entry;
+	int err_code;
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	if (payload_count > CONFIG_MQTT_PUBLISH_IOV_MAX) {
+		return -EINVAL;
+	}
+
+	err_code = inflight_add(client, param, payload, payload_count, &entry);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	err_code = publish_write(client, param, payload, payload_count);
+	if (err_code < 0 && entry != NULL) {
+		/* The application gets the error and owns the message again */
+		inflight_free(entry);
+	}
+
+	return err_code;
+#else
+	return publish_write(client, param, payload, payload_count);
+#endif
+}
+
+int mqtt_publish(struct mqtt_client *client,
+		 const struct mqtt_publish_param *param)
+{
+	int err_code;
+	struct iovec payload;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	MQTT_TRC("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
+		 "Data size 0x%08x", client, client->internal.state,
+		 param->message.topic.topic.size,
+		 param->message.payload.len);
+
+	mqtt_mutex_lock(client);
+
+	payload.iov_base = param->message.payload.data;
+	payload.iov_len = param->message.payload.len;
+
+	err_code = publish_payload(client, param, &payload, 1);
+
+	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_iov(struct mqtt_client *client,
+		     const struct mqtt_publish_param *param,
+		     const struct iovec *payload, size_t payload_count)
+{
+	struct mqtt_publish_param iov_param;
+	int err_code;
+	size_t i;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+	NULL_PARAM_CHECK(payload);
+
+	/* The payload length goes into the fixed header */
+	iov_param = *param;
+	iov_param.message.payload.data = NULL;
+	iov_param.message.payload.len = 0U;
+
+	for (i = 0; i < payload_count; i++) {
+		if (payload[i].iov_len > MQTT_MAX_PAYLOAD_SIZE -
+					 iov_param.message.payload.len) {
+			return -EMSGSIZE;
+		}
+
+		iov_param.message.payload.len += payload[i].iov_len;
+	}
+
+	MQTT_TRC("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
+		 "Data size 0x%08x in %zu buffers", client,
+		 client->internal.state, param->message.topic.topic.size,
+		 iov_param.message.payload.len, payload_count);
+
+	mqtt_mutex_lock(client);
+
+	err_code = publish_payload(client, &iov_param, payload,
+				   payload_count);
 
-error:
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
 			 client, client->internal.state, err_code);
 
@@ -162,6 +162,50 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+/**@brief Removes an acknowledged message from the inflight window.
+ *
+ * @param[in] client Identifies the client that published the message.
+ * @param[in] message_id Message id from the PUBACK or PUBCOMP packet.
+ */
+void mqtt_inflight_ack(struct mqtt_client *client, uint16_t message_id);
+
+/**@brief Marks a QoS 2 message of the inflight window as received.
+ *
+ * @param[in] client Identifies the client that published the message.
+ * @param[in] message_id Message id from the PUBREC packet.
+ */
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id);
+
+/**@brief Sends the messages of the inflight window again after a reconnect.
+ *
+ * PUBLISH packets are sent with the duplicate flag set, PUBREL packets
+ * are sent for QoS 2 messages already received by the broker.
+ *
+ * @param[in] client Identifies the client that reconnected.
+ * @param[in] session_present Session present flag of the CONNACK packet.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present);
+#else
+static inline void mqtt_inflight_ack(struct mqtt_client *client,
+				     uint16_t message_id)
+{
+}
+
+static inline void mqtt_inflight_release(struct mqtt_client *client,
+					 uint16_t message_id)
+{
+}
+
+static inline int mqtt_inflight_resend(struct mqtt_client *client,
+				       bool session_present)
+{
+	return 0;
+}
+#endif
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
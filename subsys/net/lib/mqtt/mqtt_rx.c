@@ -77,6 +77,11 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+		if (err_code == 0) {
+			mqtt_inflight_ack(client, evt.param.puback.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -85,6 +90,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBREC;
 		err_code = publish_receive_decode(buf, &evt.param.pubrec);
 		evt.result = err_code;
+
+		if (err_code == 0) {
+			mqtt_inflight_release(client,
+					      evt.param.pubrec.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -101,6 +112,11 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+		if (err_code == 0) {
+			mqtt_inflight_ack(client, evt.param.pubcomp.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -142,6 +158,16 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		event_notify(client, &evt);
 	}
 
+	/* Unacknowledged messages are sent once the application knows it is
+	 * connected. A failure closes the connection, the messages stay in
+	 * the window for the next one.
+	 */
+	if (notify_event && evt.type == MQTT_EVT_CONNACK && err_code == 0 &&
+	    MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		(void)mqtt_inflight_resend(
+			client, evt.param.connack.session_present_flag);
+	}
+
 	return err_code;
 }
 
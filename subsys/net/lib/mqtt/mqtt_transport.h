@@ -87,7 +87,9 @@ int mqtt_transport_write(struct mqtt_client *client, const uint8_t *data,
  *
  * @param[in] client Identifies the client on which the procedure is requested.
  * @param[in] message Pointer to the `struct msghdr` structure, containing data
- *            to be written on the transport.
+ *            to be written on the transport. The whole message is written,
+ *            the `struct iovec` entries it points to may be modified in
+ *            the process.
  *
  * @retval 0 or an error code indicating reason for failure.
  */
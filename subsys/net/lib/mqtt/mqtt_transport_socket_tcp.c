@@ -83,11 +83,28 @@ int mqtt_client_tcp_write_msg(struct mqtt_client *client,
 			      const struct msghdr *message)
 
 {
+	struct msghdr msg = *message;
 	int ret;
 
-	ret = zsock_sendmsg(client->transport.tcp.sock, message, 0);
-	if (ret < 0) {
-		return -errno;
+	while (msg.msg_iovlen > 0) {
+		ret = zsock_sendmsg(client->transport.tcp.sock, &msg, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		/* Skip what was sent, the stream socket may send less */
+		while (msg.msg_iovlen > 0 &&
+		       (size_t)ret >= msg.msg_iov->iov_len) {
+			ret -= msg.msg_iov->iov_len;
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+		}
+
+		if (msg.msg_iovlen > 0) {
+			msg.msg_iov->iov_base = (uint8_t *)msg.msg_iov->iov_base +
+						ret;
+			msg.msg_iov->iov_len -= ret;
+		}
 	}
 
 	return 0;
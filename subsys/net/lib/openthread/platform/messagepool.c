@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <logging/log.h>
+
+#include <openthread/platform/messagepool.h>
+
+#include "platform-zephyr.h"
+
+LOG_MODULE_REGISTER(net_otPlat_messagepool, CONFIG_OPENTHREAD_L2_LOG_LEVEL);
+
+/* OpenThread message buffers, instead of the static array within the
+ * OpenThread instance.
+ */
+K_MEM_SLAB_DEFINE(ot_message_slab, CONFIG_OPENTHREAD_MESSAGE_BUFFER_SIZE,
+		  CONFIG_OPENTHREAD_NUM_MESSAGE_BUFFERS, 4);
+
+static bool buffer_size_valid;
+
+void otPlatMessagePoolInit(otInstance *aInstance, uint16_t aMinNumFreeBuffers,
+			   size_t aBufferSize)
+{
+	ARG_UNUSED(aInstance);
+
+	buffer_size_valid =
+		(aBufferSize <= CONFIG_OPENTHREAD_MESSAGE_BUFFER_SIZE);
+	if (!buffer_size_valid) {
+		LOG_ERR("Message buffers of %zu bytes do not fit slab blocks",
+			aBufferSize);
+	}
+
+	if (aMinNumFreeBuffers > CONFIG_OPENTHREAD_NUM_MESSAGE_BUFFERS) {
+		LOG_WRN("%u free message buffers requested, %u available",
+			aMinNumFreeBuffers,
+			CONFIG_OPENTHREAD_NUM_MESSAGE_BUFFERS);
+	}
+}
+
+otMessageBuffer *otPlatMessagePoolNew(otInstance *aInstance)
+{
+	void *buffer;
+
+	ARG_UNUSED(aInstance);
+
+	if (!buffer_size_valid ||
+	    k_mem_slab_alloc(&ot_message_slab, &buffer, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	return buffer;
+}
+
+void otPlatMessagePoolFree(otInstance *aInstance, otMessageBuffer *aBuffer)
+{
+	void *buffer = aBuffer;
+
+	ARG_UNUSED(aInstance);
+
+	k_mem_slab_free(&ot_message_slab, &buffer);
+}
+
+uint16_t otPlatMessagePoolNumFreeBuffers(otInstance *aInstance)
+{
+	ARG_UNUSED(aInstance);
+
+	return k_mem_slab_num_free_get(&ot_message_slab);
+}
@@ -28,6 +28,16 @@
 	CONFIG_OPENTHREAD_NUM_MESSAGE_BUFFERS
 #endif
 
+/**
+ * @def OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT
+ *
+ * Define to 1 to allocate the message buffers through the platform.
+ *
+ */
+#ifdef CONFIG_OPENTHREAD_PLATFORM_MESSAGE_MANAGEMENT
+#define OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT 1
+#endif
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_STATECHANGE_HANDLERS
  *
@@ -40,6 +40,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_OPENTHREAD_L2_LOG_LEVEL);
 
 #define FCS_SIZE 2
 #define ACK_PKT_LENGTH 3
+#define MAX_PSDU_LENGTH 127
 
 #define FRAME_TYPE_MASK 0x07
 #define FRAME_TYPE_ACK 0x02
@@ -304,9 +305,22 @@ static void openthread_handle_received_frame(otInstance *instance,
 {
 	otRadioFrame recv_frame;
 
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
-	/* Length inc. CRC. */
-	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+	/* OpenThread reads the frame in place from the buffer of the
+	 * radio driver, unless the driver split it in fragments.
+	 */
+	if (pkt->buffer->frags == NULL) {
+		recv_frame.mPsdu = pkt->buffer->data;
+		/* Length inc. CRC. */
+		recv_frame.mLength = pkt->buffer->len;
+	} else {
+		static uint8_t rx_psdu[MAX_PSDU_LENGTH];
+
+		recv_frame.mPsdu = rx_psdu;
+		recv_frame.mLength = net_buf_linearize(rx_psdu,
+						       sizeof(rx_psdu),
+						       pkt->buffer, 0,
+						       sizeof(rx_psdu));
+	}
 	recv_frame.mChannel = platformRadioChannelGet(instance);
 	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
 	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
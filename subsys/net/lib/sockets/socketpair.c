@@ -372,27 +372,40 @@ out:
  *    ("Write on a pipe with no one to read it."). In this case, the function
  *    will return -1 and set @ref errno to @ref EPIPE.
  *
+ * The buffers of @p iov are written in turn, with the endpoints locked once
+ * and the reader woken up once for all of them.
+ *
  * @param obj the address of an @ref spair object cast to `void *`
- * @param buffer the buffer to write
- * @param count the number of bytes to write from @p buffer
+ * @param iov the buffers to write
+ * @param iovlen the number of buffers in @p iov
  *
  * @return on success, a number > 0 representing the number of bytes written
  * @return -1 on error, with @ref errno set appropriately.
  */
-static ssize_t spair_write(void *obj, const void *buffer, size_t count)
+static ssize_t spair_writev(void *obj, const struct iovec *iov, size_t iovlen)
 {
 	int res;
 	int key;
 	size_t avail;
 	bool is_nonblock;
 	size_t bytes_written;
+	size_t count = 0;
 	bool have_local_sem = false;
 	bool have_remote_sem = false;
 	bool will_block = false;
 	struct spair *const spair = (struct spair *)obj;
 	struct spair *remote = NULL;
 
-	if (obj == NULL || buffer == NULL || count == 0) {
+	for (size_t i = 0; iov != NULL && i < iovlen; i++) {
+		if (iov[i].iov_base == NULL && iov[i].iov_len > 0) {
+			count = 0;
+			break;
+		}
+
+		count += iov[i].iov_len;
+	}
+
+	if (obj == NULL || count == 0) {
 		errno = EINVAL;
 		res = -1;
 		goto out;
@@ -528,14 +541,27 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 		}
 	}
 
-	res = k_pipe_put(&remote->recv_q, (void *)buffer, count,
-			 &bytes_written, 1, K_NO_WAIT);
-	__ASSERT(res == 0, "k_pipe_put() failed: %d", res);
+	count = 0;
+
+	for (size_t i = 0; i < iovlen; i++) {
+		if (iov[i].iov_len == 0) {
+			continue;
+		}
+
+		res = k_pipe_put(&remote->recv_q, iov[i].iov_base,
+				 iov[i].iov_len, &bytes_written, 0, K_NO_WAIT);
+		__ASSERT(res == 0, "k_pipe_put() failed: %d", res);
+
+		count += bytes_written;
+		if (bytes_written < iov[i].iov_len) {
+			break;
+		}
+	}
 
 	res = k_poll_signal_raise(&remote->write_signal, SPAIR_SIG_DATA);
 	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
 
-	res = bytes_written;
+	res = count;
 
 out:
 
@@ -549,6 +575,16 @@ out:
 	return res;
 }
 
+static ssize_t spair_write(void *obj, const void *buffer, size_t count)
+{
+	const struct iovec iov = {
+		.iov_base = (void *)buffer,
+		.iov_len = count,
+	};
+
+	return spair_writev(obj, &iov, 1);
+}
+
 /**
  * Read data from one end of a @ref spair
  *
@@ -1056,15 +1092,7 @@ static ssize_t spair_sendmsg(void *obj, const struct msghdr *msg,
 		goto out;
 	}
 
-	for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-		res = spair_write(spair, msg->msg_iov[i].iov_base,
-			msg->msg_iov[i].iov_len);
-		if (res == -1) {
-			goto out;
-		}
-	}
-
-	res = len;
+	res = spair_writev(spair, msg->msg_iov, msg->msg_iovlen);
 
 out:
 	return res;
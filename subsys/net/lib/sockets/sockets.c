@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #endif
 
 #include "../../ip/net_stats.h"
+#include "../../ip/udp_internal.h"
 
 #include "sockets_internal.h"
 
@@ -169,6 +170,11 @@ int zsock_socket_internal(int family, int type, int proto)
 	/* recv_q and accept_q are in union */
 	k_fifo_init(&ctx->recv_q);
 
+	/* UDP checksums are verified while copying the data out */
+	if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY) && proto == IPPROTO_UDP) {
+		net_context_set_chksum_deferred(ctx, true);
+	}
+
 	/* TCP context is effectively owned by both application
 	 * and the stack: stack may detect that peer closed/aborted
 	 * connection, but it must not dispose of the context behind
@@ -787,6 +793,177 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	ssize_t ret;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	/* Like sendmsg(), report an error only if nothing was sent */
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static void mmsg_free_copy(struct mmsghdr *kvec, unsigned int vlen,
+			   bool send)
+{
+	unsigned int i;
+
+	for (i = 0; i < vlen; i++) {
+		k_free(kvec[i].msg_hdr.msg_iov);
+
+		if (send) {
+			k_free(kvec[i].msg_hdr.msg_name);
+			k_free(kvec[i].msg_hdr.msg_control);
+		}
+	}
+
+	k_free(kvec);
+}
+
+/* Copy the message descriptors of a user thread to the kernel. The data
+ * buffers are only verified to be accessible, like with sendto() and
+ * recvfrom(), and are used in place. For sending, the address and the
+ * ancillary data are copied, while for receiving the address buffer is
+ * used in place too.
+ */
+static struct mmsghdr *mmsg_copy_from_user(struct mmsghdr *msgvec,
+					   unsigned int vlen, bool send)
+{
+	struct mmsghdr *kvec;
+	unsigned int i;
+	size_t size, j;
+
+	if (size_mul_overflow(vlen, sizeof(struct mmsghdr), &size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	kvec = z_user_alloc_from_copy(msgvec, size);
+	if (!kvec) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &kvec[i].msg_hdr;
+		const struct iovec *iov = msg->msg_iov;
+		void *name = msg->msg_name;
+		void *control = msg->msg_control;
+
+		msg->msg_iov = NULL;
+		msg->msg_control = NULL;
+		if (send) {
+			msg->msg_name = NULL;
+		}
+
+		if (size_mul_overflow(msg->msg_iovlen, sizeof(struct iovec),
+				      &size)) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		msg->msg_iov = z_user_alloc_from_copy(iov, size);
+		if (!msg->msg_iov && msg->msg_iovlen) {
+			errno = ENOMEM;
+			goto fail;
+		}
+
+		for (j = 0; j < msg->msg_iovlen; j++) {
+			if (Z_SYSCALL_MEMORY(msg->msg_iov[j].iov_base,
+					     msg->msg_iov[j].iov_len,
+					     !send)) {
+				errno = EFAULT;
+				goto fail;
+			}
+		}
+
+		if (!send) {
+			msg->msg_controllen = 0;
+
+			if (name && Z_SYSCALL_MEMORY_WRITE(name,
+							   msg->msg_namelen)) {
+				errno = EFAULT;
+				goto fail;
+			}
+
+			continue;
+		}
+
+		if (name && msg->msg_namelen > 0) {
+			msg->msg_name = z_user_alloc_from_copy(name,
+							msg->msg_namelen);
+			if (!msg->msg_name) {
+				errno = ENOMEM;
+				goto fail;
+			}
+		}
+
+		if (control && msg->msg_controllen > 0) {
+			msg->msg_control = z_user_alloc_from_copy(control,
+							msg->msg_controllen);
+			if (!msg->msg_control) {
+				errno = ENOMEM;
+				goto fail;
+			}
+		}
+	}
+
+	return kvec;
+
+fail:
+	mmsg_free_copy(kvec, i + 1, send);
+
+	return NULL;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *kvec;
+	int i;
+	int ret;
+
+	kvec = mmsg_copy_from_user(msgvec, vlen, true);
+	if (!kvec) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, kvec, vlen, flags);
+
+	for (i = 0; i < ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &kvec[i].msg_len,
+				      sizeof(kvec[i].msg_len)));
+	}
+
+	mmsg_free_copy(kvec, vlen, true);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -920,6 +1097,37 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 	}
 }
 
+/* Read data of a datagram, summing it if its UDP checksum is still to be
+ * verified.
+ */
+static int sock_pkt_read(struct net_pkt *pkt, void *buf, size_t len,
+			 struct net_pkt_csum *csum)
+{
+	if (net_pkt_is_chksum_pending(pkt)) {
+		return net_pkt_read_csum(pkt, buf, len, csum);
+	}
+
+	return net_pkt_read(pkt, buf, len);
+}
+
+/* Verify the UDP checksum left to the socket. The data read so far was
+ * summed into csum, the rest of it is summed here.
+ */
+static bool sock_pkt_chksum_ok(struct net_pkt *pkt, struct net_pkt_csum *csum)
+{
+	if (!net_pkt_is_chksum_pending(pkt)) {
+		return true;
+	}
+
+	if (net_pkt_read_csum(pkt, NULL, net_pkt_remaining_data(pkt), csum)) {
+		return false;
+	}
+
+	net_pkt_set_payload_csum(pkt, csum);
+
+	return net_udp_verify_chksum(pkt);
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       void *buf,
 				       size_t max_len,
@@ -930,12 +1138,14 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	struct net_pkt_cursor backup;
+	struct net_pkt_csum csum;
 	struct net_pkt *pkt;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
 	}
 
+again:
 	if (flags & ZSOCK_MSG_PEEK) {
 		int res;
 
@@ -986,11 +1196,23 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		recv_len = max_len;
 	}
 
-	if (net_pkt_read(pkt, buf, recv_len)) {
+	csum = (struct net_pkt_csum){ 0 };
+
+	if (sock_pkt_read(pkt, buf, recv_len, &csum)) {
 		errno = ENOBUFS;
 		goto fail;
 	}
 
+	if (!sock_pkt_chksum_ok(pkt, &csum)) {
+		/* Drop the corrupted datagram and wait for the next one */
+		if (flags & ZSOCK_MSG_PEEK) {
+			k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		}
+
+		net_pkt_unref(pkt);
+		goto again;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
 	    !(flags & ZSOCK_MSG_PEEK)) {
 		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
@@ -1162,6 +1384,435 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Datagrams are taken from the receive queue this many at a time */
+#define RECVMMSG_BATCH 16
+
+/* Scatter one datagram to the buffers of msg and free it. Returns -1 if the
+ * datagram had a bad checksum and was dropped.
+ */
+static ssize_t zsock_recv_msg_pkt(struct net_context *ctx, struct msghdr *msg,
+				  struct net_pkt *pkt)
+{
+	size_t remaining = net_pkt_remaining_data(pkt);
+	struct net_pkt_csum csum = { 0 };
+	size_t recv_len = 0, len;
+	size_t i;
+
+	msg->msg_flags = 0;
+	msg->msg_controllen = 0;
+
+	if (msg->msg_name && msg->msg_namelen > 0) {
+		struct sockaddr *addr = msg->msg_name;
+
+		if (sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					  addr, msg->msg_namelen) < 0) {
+			msg->msg_namelen = 0;
+		} else if (addr->sa_family == AF_INET) {
+			msg->msg_namelen = sizeof(struct sockaddr_in);
+		} else if (addr->sa_family == AF_INET6) {
+			msg->msg_namelen = sizeof(struct sockaddr_in6);
+		}
+	}
+
+	for (i = 0; i < msg->msg_iovlen && remaining > 0; i++) {
+		len = MIN(msg->msg_iov[i].iov_len, remaining);
+
+		if (sock_pkt_read(pkt, msg->msg_iov[i].iov_base, len, &csum)) {
+			break;
+		}
+
+		recv_len += len;
+		remaining -= len;
+	}
+
+	if (!sock_pkt_chksum_ok(pkt, &csum)) {
+		net_pkt_unref(pkt);
+		return -1;
+	}
+
+	if (remaining > 0) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	return recv_len;
+}
+
+static int zsock_recvmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	struct net_pkt *pkts[RECVMMSG_BATCH];
+	k_timeout_t timeout = K_FOREVER;
+	unsigned int count = 0;
+	ssize_t len;
+	int i, n;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	do {
+		pkts[0] = k_fifo_get(&ctx->recv_q, timeout);
+		if (!pkts[0]) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		len = zsock_recv_msg_pkt(ctx, &msgvec[0].msg_hdr, pkts[0]);
+	} while (len < 0);
+
+	msgvec[0].msg_len = len;
+	count++;
+
+	while (count < vlen) {
+		n = k_fifo_get_batch(&ctx->recv_q, (void **)pkts,
+				     MIN(vlen - count, RECVMMSG_BATCH));
+
+		for (i = 0; i < n; i++) {
+			len = zsock_recv_msg_pkt(ctx, &msgvec[count].msg_hdr,
+						 pkts[i]);
+			if (len < 0) {
+				continue;
+			}
+
+			msgvec[count++].msg_len = len;
+		}
+
+		if (n < RECVMMSG_BATCH) {
+			break;
+		}
+	}
+
+	return count;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return zsock_recvmmsg_ctx(ctx, msgvec, vlen, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *kvec;
+	int i;
+	int ret;
+
+	kvec = mmsg_copy_from_user(msgvec, vlen, false);
+	if (!kvec) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, kvec, vlen, flags);
+
+	for (i = 0; i < ret; i++) {
+		struct msghdr *msg = &kvec[i].msg_hdr;
+
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &kvec[i].msg_len,
+				      sizeof(kvec[i].msg_len)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_namelen,
+				      &msg->msg_namelen,
+				      sizeof(msg->msg_namelen)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_controllen,
+				      &msg->msg_controllen,
+				      sizeof(msg->msg_controllen)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_flags,
+				      &msg->msg_flags,
+				      sizeof(msg->msg_flags)));
+	}
+
+	mmsg_free_copy(kvec, vlen, false);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Detach up to *len bytes of data at the cursor of pkt as a fragment chain.
+ * Whole fragments are handed over as they are. Only a fragment straddling
+ * the end is cloned, and the clone only shares the data if the buffer pool
+ * supports that. On return *len holds the number of bytes detached.
+ */
+static struct net_buf *zsock_pkt_detach(struct net_pkt *pkt, size_t *len)
+{
+	size_t skip = net_pkt_get_len(pkt) - net_pkt_remaining_data(pkt);
+	size_t left = *len;
+	struct net_buf *head, *buf, *last = NULL;
+
+	/* Drop the headers and the data read already */
+	while (pkt->buffer && skip >= pkt->buffer->len) {
+		buf = pkt->buffer;
+		skip -= buf->len;
+		pkt->buffer = buf->frags;
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+
+	if (pkt->buffer && skip) {
+		net_buf_pull(pkt->buffer, skip);
+	}
+
+	head = pkt->buffer;
+
+	for (buf = head; buf && left >= buf->len; buf = buf->frags) {
+		left -= buf->len;
+		last = buf;
+	}
+
+	if (buf && left) {
+		struct net_buf *clone = net_buf_clone(buf, K_NO_WAIT);
+
+		if (clone) {
+			clone->len = left;
+			net_buf_pull(buf, left);
+			left = 0;
+
+			if (last) {
+				last->frags = clone;
+			} else {
+				head = clone;
+			}
+
+			last = clone;
+		}
+	}
+
+	*len -= left;
+
+	if (!last) {
+		net_pkt_cursor_init(pkt);
+		return NULL;
+	}
+
+	if (last->frags == buf) {
+		last->frags = NULL;
+	}
+
+	pkt->buffer = buf;
+	net_pkt_cursor_init(pkt);
+
+	return head;
+}
+
+static ssize_t zsock_recv_zc_dgram(struct net_context *ctx,
+				   struct net_buf **frags, size_t max_len,
+				   k_timeout_t timeout,
+				   struct sockaddr *src_addr,
+				   socklen_t *addrlen)
+{
+	struct net_pkt_cursor backup;
+	struct net_pkt_csum csum;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	bool chksum_ok;
+
+again:
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Nothing is copied, only sum the data */
+	csum = (struct net_pkt_csum){ 0 };
+	net_pkt_cursor_backup(pkt, &backup);
+	chksum_ok = sock_pkt_chksum_ok(pkt, &csum);
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if (!chksum_ok) {
+		net_pkt_unref(pkt);
+		goto again;
+	}
+
+	if (src_addr && addrlen) {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			errno = -rv;
+			goto fail;
+		}
+
+		if (src_addr->sa_family == AF_INET) {
+			*addrlen = sizeof(struct sockaddr_in);
+		} else if (src_addr->sa_family == AF_INET6) {
+			*addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			errno = ENOTSUP;
+			goto fail;
+		}
+	}
+
+	recv_len = MIN(net_pkt_remaining_data(pkt), max_len);
+	*frags = zsock_pkt_detach(pkt, &recv_len);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	/* Whatever did not fit is discarded, like with recv() */
+	net_pkt_unref(pkt);
+
+	return recv_len;
+
+fail:
+	net_pkt_unref(pkt);
+
+	return -1;
+}
+
+static ssize_t zsock_recv_zc_stream(struct net_context *ctx,
+				    struct net_buf **frags, size_t max_len,
+				    k_timeout_t timeout)
+{
+	size_t recv_len;
+	int res;
+
+	do {
+		struct net_pkt *pkt;
+		size_t data_len;
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		res = k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled */
+		if (res && res != -EAGAIN && res != -EINTR) {
+			errno = -res;
+			return -1;
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		data_len = net_pkt_remaining_data(pkt);
+		recv_len = MIN(data_len, max_len);
+
+		*frags = zsock_pkt_detach(pkt, &recv_len);
+		if (!*frags && data_len) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		if (recv_len == data_len) {
+			k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+				net_socket_update_tc_rx_time(pkt,
+							     k_cycle_get_32());
+			}
+
+			net_pkt_unref(pkt);
+		}
+	} while (recv_len == 0);
+
+	net_context_update_recv_wnd(ctx, recv_len);
+
+	return recv_len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, size_t max_len,
+		      int flags, struct sockaddr *src_addr,
+		      socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Offloaded and TLS sockets do not queue net_pkts */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	*frags = NULL;
+
+	if (max_len == 0) {
+		return 0;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	switch (net_context_get_type(ctx)) {
+	case SOCK_DGRAM:
+		return zsock_recv_zc_dgram(ctx, frags, max_len, timeout,
+					   src_addr, addrlen);
+	case SOCK_STREAM:
+		if (!net_context_is_used(ctx)) {
+			errno = EBADF;
+			return -1;
+		}
+
+		return zsock_recv_zc_stream(ctx, frags, max_len, timeout);
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+void zsock_recv_zc_release(struct net_buf *frags)
+{
+	if (frags) {
+		net_buf_unref(frags);
+	}
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -28,6 +28,273 @@ extern const struct socket_op_vtable sock_fd_op_vtable;
 
 static const struct socket_op_vtable packet_sock_fd_op_vtable;
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+struct packet_ring {
+	/** Socket the ring is attached to, NULL if the ring is free */
+	struct net_context *ctx;
+
+	/** Frame slots, in application memory */
+	uint8_t *frames;
+
+	/** Raised when the ring goes from empty to non empty */
+	struct k_poll_signal signal;
+
+	/** Size of a frame slot */
+	uint32_t frame_size;
+
+	/** Number of frame slots */
+	uint32_t frame_nr;
+
+	/** Next slot filled by the kernel */
+	uint32_t head;
+
+	/** Frames were dropped since the last one was delivered */
+	bool losing;
+};
+
+static struct packet_ring rings[CONFIG_NET_SOCKETS_PACKET_RING_COUNT];
+
+/* A mutex for protecting the ring allocation, also serializing the RX path
+ * with the ring removal.
+ */
+static K_MUTEX_DEFINE(rings_lock);
+
+static inline struct tpacket_hdr *packet_ring_frame(struct packet_ring *ring,
+						    uint32_t idx)
+{
+	return (struct tpacket_hdr *)(ring->frames + idx * ring->frame_size);
+}
+
+static inline uint32_t packet_ring_status(struct tpacket_hdr *hdr)
+{
+	return atomic_get((atomic_t *)&hdr->tp_status);
+}
+
+/* The application releases the slots in order, so the ring is empty when
+ * the most recently filled slot has been given back.
+ */
+static bool packet_ring_is_empty(struct packet_ring *ring)
+{
+	uint32_t last = (ring->head + ring->frame_nr - 1) % ring->frame_nr;
+
+	return packet_ring_status(packet_ring_frame(ring, last)) ==
+		TP_STATUS_KERNEL;
+}
+
+static int packet_ring_attach(struct net_context *ctx,
+			      const struct tpacket_req *req)
+{
+	struct packet_ring *ring = NULL;
+	int i;
+
+	if (!req->tp_ring || req->tp_frame_size < TPACKET_HDRLEN + 1 ||
+	    req->tp_frame_size % TPACKET_ALIGNMENT ||
+	    POINTER_TO_UINT(req->tp_ring) % sizeof(atomic_t)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+
+	if (ctx->packet_ring) {
+		k_mutex_unlock(&rings_lock);
+		return -EBUSY;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (!rings[i].ctx) {
+			ring = &rings[i];
+			break;
+		}
+	}
+
+	if (!ring) {
+		k_mutex_unlock(&rings_lock);
+		return -ENOMEM;
+	}
+
+	ring->ctx = ctx;
+	ring->frames = req->tp_ring;
+	ring->frame_size = req->tp_frame_size;
+	ring->frame_nr = req->tp_frame_nr;
+	ring->head = 0U;
+	ring->losing = false;
+
+	k_poll_signal_init(&ring->signal);
+
+	for (i = 0; i < ring->frame_nr; i++) {
+		atomic_set((atomic_t *)&packet_ring_frame(ring, i)->tp_status,
+			   TP_STATUS_KERNEL);
+	}
+
+	ctx->packet_ring = ring;
+
+	k_mutex_unlock(&rings_lock);
+
+	NET_DBG("ctx=%p, ring %p with %u frames of %u bytes", ctx,
+		ring->frames, ring->frame_nr, ring->frame_size);
+
+	return 0;
+}
+
+static void packet_ring_detach(struct net_context *ctx)
+{
+	struct packet_ring *ring;
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ctx->packet_ring;
+	if (ring) {
+		ctx->packet_ring = NULL;
+		ring->ctx = NULL;
+	}
+
+	k_mutex_unlock(&rings_lock);
+}
+
+static int packet_ring_setsockopt(struct net_context *ctx,
+				  const void *optval, socklen_t optlen)
+{
+	const struct tpacket_req *req = optval;
+
+	if (!optval || optlen != sizeof(struct tpacket_req)) {
+		return -EINVAL;
+	}
+
+	if (req->tp_frame_nr == 0U) {
+		packet_ring_detach(ctx);
+		return 0;
+	}
+
+	return packet_ring_attach(ctx, req);
+}
+
+/* Copy the frame to the next free slot. Returns false if the socket has no
+ * ring and the frame should be queued.
+ */
+static bool packet_ring_input(struct net_context *ctx, struct net_pkt *pkt)
+{
+	uint32_t status = TP_STATUS_USER;
+	struct packet_ring *ring;
+	struct tpacket_hdr *hdr;
+	size_t len, snaplen;
+	bool was_empty;
+
+	if (!ctx->packet_ring) {
+		return false;
+	}
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ctx->packet_ring;
+	if (!ring) {
+		/* Removed while we were waiting for the lock */
+		k_mutex_unlock(&rings_lock);
+		return false;
+	}
+
+	hdr = packet_ring_frame(ring, ring->head);
+	if (packet_ring_status(hdr) != TP_STATUS_KERNEL) {
+		NET_DBG("ctx=%p, ring full, dropping pkt %p", ctx, pkt);
+		ring->losing = true;
+		goto out;
+	}
+
+	len = net_pkt_get_len(pkt);
+	snaplen = MIN(len, ring->frame_size - TPACKET_HDRLEN);
+
+	if (net_pkt_read(pkt, (uint8_t *)hdr + TPACKET_HDRLEN, snaplen)) {
+		ring->losing = true;
+		goto out;
+	}
+
+	if (snaplen < len) {
+		status |= TP_STATUS_COPY;
+	}
+
+	if (ring->losing) {
+		status |= TP_STATUS_LOSING;
+		ring->losing = false;
+	}
+
+	hdr->tp_len = len;
+	hdr->tp_snaplen = snaplen;
+	hdr->tp_mac = TPACKET_HDRLEN;
+
+	was_empty = packet_ring_is_empty(ring);
+
+	/* Hand the slot over only after its content has been written */
+	atomic_set((atomic_t *)&hdr->tp_status, status);
+
+	ring->head = (ring->head + 1) % ring->frame_nr;
+
+	if (was_empty) {
+		k_poll_signal_raise(&ring->signal, 0);
+	}
+
+out:
+	k_mutex_unlock(&rings_lock);
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+static int packet_ring_poll_prepare(struct packet_ring *ring,
+				    struct zsock_pollfd *pfd,
+				    struct k_poll_event **pev,
+				    struct k_poll_event *pev_end)
+{
+	int ret = 0;
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		/* Reset before checking the ring, so that a frame received
+		 * after the check raises the signal again.
+		 */
+		k_poll_signal_reset(&ring->signal);
+
+		k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ring->signal);
+		(*pev)++;
+
+		if (!packet_ring_is_empty(ring)) {
+			ret = -EALREADY;
+		}
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		return -EALREADY;
+	}
+
+	return ret;
+}
+
+static int packet_ring_poll_update(struct packet_ring *ring,
+				   struct zsock_pollfd *pfd,
+				   struct k_poll_event **pev)
+{
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if ((*pev)->state != K_POLL_STATE_NOT_READY ||
+		    !packet_ring_is_empty(ring)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	return 0;
+}
+#else
+#define packet_ring_input(...) false
+#define packet_ring_detach(...)
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 static inline int k_fifo_wait_non_empty(struct k_fifo *fifo,
 					k_timeout_t timeout)
 {
@@ -107,6 +374,10 @@ static void zpacket_received_cb(struct net_context *ctx,
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
+	if (packet_ring_input(ctx, pkt)) {
+		return;
+	}
+
 	k_fifo_put(&ctx->recv_q, pkt);
 }
 
@@ -266,6 +537,19 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		int ret = packet_ring_setsockopt(ctx, optval, optlen);
+
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -284,9 +568,43 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	struct net_context *ctx = obj;
+	struct packet_ring *ring = ctx->packet_ring;
+
+	if (ring && request == ZFD_IOCTL_POLL_PREPARE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		return packet_ring_poll_prepare(ring, pfd, pev, pev_end);
+	}
+
+	if (ring && request == ZFD_IOCTL_POLL_UPDATE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		return packet_ring_poll_update(ring, pfd, pev);
+	}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+static int packet_sock_close_vmeth(void *obj)
+{
+	packet_ring_detach(obj);
+
+	return sock_fd_op_vtable.fd_vtable.close(obj);
+}
+
 /*
  * TODO: A packet socket can be bound to a network device using SO_BINDTODEVICE.
  */
@@ -358,6 +676,7 @@ static const struct socket_op_vtable packet_sock_fd_op_vtable = {
 		.read = packet_sock_read_vmeth,
 		.write = packet_sock_write_vmeth,
 		.ioctl = packet_sock_ioctl_vmeth,
+		.close = packet_sock_close_vmeth,
 	},
 	.bind = packet_sock_bind_vmeth,
 	.connect = packet_sock_connect_vmeth,
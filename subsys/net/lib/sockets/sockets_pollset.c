@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/fdtable.h>
+#include <net/socket.h>
+#include <net/socket_pollset.h>
+
+/* Max number of ready kernel events handled by one wait iteration, the
+ * others are picked up by the next one.
+ */
+#define POLLSET_READY_BATCH 8
+
+static struct zsock_pollset_fd *pollset_find(struct zsock_pollset *pset,
+					     int fd)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(pset->fds); i++) {
+		if (pset->fds[i].fd == fd) {
+			return &pset->fds[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct zsock_pollset_fd *event_to_fd(struct zsock_pollset *pset,
+					    struct k_poll_event *event)
+{
+	uintptr_t offset = (uint8_t *)event - (uint8_t *)pset->fds;
+	struct zsock_pollset_fd *entry;
+
+	if (offset >= sizeof(pset->fds)) {
+		return NULL;
+	}
+
+	entry = &pset->fds[offset / sizeof(pset->fds[0])];
+	if (entry->fd < 0) {
+		/* Removed since the event was returned */
+		return NULL;
+	}
+
+	return entry;
+}
+
+static void queue_check(sys_slist_t *list, struct zsock_pollset_fd *entry)
+{
+	if (!entry->queued) {
+		entry->queued = 1U;
+		sys_slist_append(list, &entry->node);
+	}
+}
+
+/* Same update as zsock_poll() does after k_poll(), on the persistent events
+ * of the socket.
+ */
+static short check_fd(struct zsock_pollset_fd *entry)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events_requested,
+	};
+	struct k_poll_event *pev = entry->events;
+	void *ctx;
+	int ret;
+
+	ctx = z_get_fd_obj_and_vtable(entry->fd, &vtable);
+	if (ctx == NULL) {
+		return ZSOCK_POLLNVAL;
+	}
+
+	ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_UPDATE,
+				   &pfd, &pev);
+	if (ret < 0 && ret != -EAGAIN) {
+		return ZSOCK_POLLERR;
+	}
+
+	return pfd.revents;
+}
+
+void zsock_pollset_init(struct zsock_pollset *pset)
+{
+	int i;
+
+	k_poll_set_init(&pset->set);
+	k_mutex_init(&pset->lock);
+	sys_slist_init(&pset->recheck);
+	sys_slist_init(&pset->always);
+
+	for (i = 0; i < ARRAY_SIZE(pset->fds); i++) {
+		pset->fds[i].fd = -1;
+	}
+}
+
+int zsock_pollset_add(struct zsock_pollset *pset, int fd, short events)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_pollset_fd *entry;
+	struct k_poll_event *pev;
+	struct zsock_pollfd pfd = {
+		.fd = fd,
+		.events = events,
+	};
+	void *ctx;
+	int ret;
+	int i;
+
+	if (fd < 0) {
+		return -EBADF;
+	}
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	k_mutex_lock(&pset->lock, K_FOREVER);
+
+	if (pollset_find(pset, fd) != NULL) {
+		ret = -EEXIST;
+		goto out;
+	}
+
+	entry = pollset_find(pset, -1);
+	if (entry == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	memset(entry->events, 0, sizeof(entry->events));
+	pev = entry->events;
+
+	ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE,
+				   &pfd, &pev,
+				   entry->events + ARRAY_SIZE(entry->events));
+	if (ret == -EXDEV) {
+		ret = -ENOTSUP;
+		goto out;
+	} else if (ret < 0 && ret != -EALREADY) {
+		goto out;
+	}
+
+	entry->fd = fd;
+	entry->events_requested = events;
+	entry->event_count = pev - entry->events;
+	entry->queued = 0U;
+
+	for (i = 0; i < entry->event_count; i++) {
+		k_poll_set_add(&pset->set, &entry->events[i]);
+	}
+
+	if (events & ZSOCK_POLLOUT) {
+		sys_slist_append(&pset->always, &entry->always_node);
+	}
+
+	/* The socket has data that is not signaled by its events, such as
+	 * an EOF or decrypted TLS data.
+	 */
+	if (ret == -EALREADY) {
+		queue_check(&pset->recheck, entry);
+	}
+
+	ret = 0;
+
+out:
+	k_mutex_unlock(&pset->lock);
+
+	return ret;
+}
+
+int zsock_pollset_remove(struct zsock_pollset *pset, int fd)
+{
+	struct zsock_pollset_fd *entry;
+	int i;
+
+	if (fd < 0) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&pset->lock, K_FOREVER);
+
+	entry = pollset_find(pset, fd);
+	if (entry == NULL) {
+		k_mutex_unlock(&pset->lock);
+		return -ENOENT;
+	}
+
+	for (i = 0; i < entry->event_count; i++) {
+		k_poll_set_remove(&pset->set, &entry->events[i]);
+	}
+
+	if (entry->events_requested & ZSOCK_POLLOUT) {
+		(void)sys_slist_find_and_remove(&pset->always,
+						&entry->always_node);
+	}
+
+	if (entry->queued) {
+		(void)sys_slist_find_and_remove(&pset->recheck, &entry->node);
+		entry->queued = 0U;
+	}
+
+	entry->fd = -1;
+
+	k_mutex_unlock(&pset->lock);
+
+	return 0;
+}
+
+/* Check the sockets of the ready events, the sockets returned last time
+ * and the writable ones. The returned sockets are checked again on the
+ * next call, as TLS sockets can have data that their events do not signal.
+ */
+static int pollset_collect(struct zsock_pollset *pset,
+			   struct k_poll_event **ready, int ready_count,
+			   struct zsock_pollfd *fds, int nfds)
+{
+	struct zsock_pollset_fd *entry;
+	sys_slist_t candidates;
+	sys_snode_t *node;
+	int count = 0;
+	int i;
+
+	k_mutex_lock(&pset->lock, K_FOREVER);
+
+	candidates = pset->recheck;
+	sys_slist_init(&pset->recheck);
+
+	for (i = 0; i < ready_count; i++) {
+		entry = event_to_fd(pset, ready[i]);
+		if (entry != NULL) {
+			queue_check(&candidates, entry);
+		}
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&pset->always, entry, always_node) {
+		queue_check(&candidates, entry);
+	}
+
+	while ((node = sys_slist_get(&candidates)) != NULL) {
+		short revents;
+
+		entry = CONTAINER_OF(node, struct zsock_pollset_fd, node);
+		entry->queued = 0U;
+
+		if (count == nfds) {
+			/* No room left, report it next time */
+			queue_check(&pset->recheck, entry);
+			continue;
+		}
+
+		revents = check_fd(entry);
+		if (revents == 0) {
+			continue;
+		}
+
+		fds[count].fd = entry->fd;
+		fds[count].events = entry->events_requested;
+		fds[count].revents = revents;
+		count++;
+
+		queue_check(&pset->recheck, entry);
+	}
+
+	k_mutex_unlock(&pset->lock);
+
+	return count;
+}
+
+int zsock_pollset_wait(struct zsock_pollset *pset, struct zsock_pollfd *fds,
+		       int nfds, int timeout)
+{
+	struct k_poll_event *ready[POLLSET_READY_BATCH];
+	k_timeout_t tout;
+	uint64_t end;
+	int ready_count;
+	int count;
+
+	if (nfds <= 0) {
+		return -EINVAL;
+	}
+
+	tout = (timeout < 0) ? K_FOREVER : K_MSEC(timeout);
+	end = z_timeout_end_calc(tout);
+
+	/* Re-arm the events returned last time and pick up the ready ones */
+	ready_count = k_poll_set_wait(&pset->set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT);
+
+	while (true) {
+		count = pollset_collect(pset, ready,
+					MAX(ready_count, 0), fds, nfds);
+		if (count > 0) {
+			return count;
+		}
+
+		if (!K_TIMEOUT_EQ(tout, K_NO_WAIT) &&
+		    !K_TIMEOUT_EQ(tout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			if (remaining <= 0) {
+				return 0;
+			}
+
+			tout = Z_TIMEOUT_TICKS(remaining);
+		} else if (K_TIMEOUT_EQ(tout, K_NO_WAIT)) {
+			return 0;
+		}
+
+		ready_count = k_poll_set_wait(&pset->set, ready,
+					      ARRAY_SIZE(ready), tout);
+		if (ready_count == -EAGAIN) {
+			return 0;
+		}
+	}
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <kernel.h>
 #include <net/socket.h>
 
 /* Get size, in elements, of an array within a struct. */
@@ -71,10 +72,8 @@ int zsock_select(int nfds, zsock_fd_set *readfds, zsock_fd_set *writefds,
 	int i, res, poll_timeout;
 	int num_pfds = 0;
 	int num_selects = 0;
-	int fd_no = 0;
 
 	for (i = 0; i < STRUCT_MEMBER_ARRAY_SIZE(zsock_fd_set, bitset); i++) {
-		uint32_t bit_mask = 1U;
 		uint32_t read_mask = 0U, write_mask = 0U, except_mask = 0U;
 		uint32_t ored_mask;
 
@@ -95,34 +94,34 @@ int zsock_select(int nfds, zsock_fd_set *readfds, zsock_fd_set *writefds,
 			continue;
 		}
 
-		do {
-			if (ored_mask & bit_mask) {
-				int events = 0;
+		/* Only visit the set bits of the word */
+		while (ored_mask != 0U) {
+			unsigned int b_idx = find_lsb_set(ored_mask) - 1;
+			uint32_t bit_mask = BIT(b_idx);
+			int events = 0;
 
-				if (num_pfds >= ARRAY_SIZE(pfds)) {
-					errno = ENOMEM;
-					return -1;
-				}
+			ored_mask &= ~bit_mask;
 
-				if (read_mask & bit_mask) {
-					events |= ZSOCK_POLLIN;
-				}
+			if (num_pfds >= ARRAY_SIZE(pfds)) {
+				errno = ENOMEM;
+				return -1;
+			}
 
-				if (write_mask & bit_mask) {
-					events |= ZSOCK_POLLOUT;
-				}
+			if (read_mask & bit_mask) {
+				events |= ZSOCK_POLLIN;
+			}
 
-				if (except_mask & bit_mask) {
-					events |= ZSOCK_POLLPRI;
-				}
+			if (write_mask & bit_mask) {
+				events |= ZSOCK_POLLOUT;
+			}
 
-				pfds[num_pfds].fd = fd_no;
-				pfds[num_pfds++].events = events;
+			if (except_mask & bit_mask) {
+				events |= ZSOCK_POLLPRI;
 			}
 
-			bit_mask <<= 1;
-			fd_no++;
-		} while (bit_mask != 0U);
+			pfds[num_pfds].fd = i * 32 + b_idx;
+			pfds[num_pfds++].events = events;
+		}
 	}
 
 	poll_timeout = -1;
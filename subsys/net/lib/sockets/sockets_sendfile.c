@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <net/socket.h>
+#include <fs/fs.h>
+
+/* Send the whole buffer, a stream socket may take it in several parts */
+static ssize_t send_all(int sock, const uint8_t *buf, size_t len)
+{
+	size_t sent = 0;
+	ssize_t ret;
+
+	while (sent < len) {
+		ret = zsock_send(sock, buf + sent, len - sent, 0);
+		if (ret < 0) {
+			return (sent != 0) ? sent : ret;
+		}
+
+		sent += ret;
+	}
+
+	return sent;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t off,
+		       size_t len)
+{
+	uint8_t buf[CONFIG_NET_SOCKETS_SENDFILE_BUF_SIZE];
+	const void *addr;
+	ssize_t sent, ret;
+
+	/* Any failure to map, like a range past the end of the file, is left
+	 * to the read path to handle.
+	 */
+	if (fs_mmap(file, off, len, &addr) == 0) {
+		return send_all(sock, addr, len);
+	}
+
+	ret = fs_seek(file, off, FS_SEEK_SET);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	sent = 0;
+	while (sent < len) {
+		ssize_t rd = fs_read(file, buf, MIN(sizeof(buf), len - sent));
+
+		if (rd <= 0) {
+			if (rd < 0 && sent == 0) {
+				errno = -rd;
+				return -1;
+			}
+
+			break;
+		}
+
+		ret = send_all(sock, buf, rd);
+		if (ret < 0) {
+			return (sent != 0) ? sent : -1;
+		}
+
+		sent += ret;
+		if (ret < rd) {
+			break;
+		}
+	}
+
+	return sent;
+}
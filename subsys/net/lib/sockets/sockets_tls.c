@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <random/rand32.h>
 #include <syscall_handler.h>
 #include <sys/fdtable.h>
+#include <sys/crc.h>
 
 #if defined(CONFIG_MBEDTLS)
 #if !defined(CONFIG_MBEDTLS_CFG_FILE)
@@ -34,6 +35,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -120,6 +124,9 @@ struct tls_context {
 		 * protocols.
 		 */
 		const char *alpn_list[ALPN_MAX_PROTOCOLS];
+
+		/** Information if TLS sessions should be resumed. */
+		bool cache_enabled;
 	} options;
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
@@ -169,6 +176,36 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+/** A TLS client session kept for resumption. */
+struct tls_session_cache {
+	/** Uptime (in ms) when the session was stored, 0 if unused. */
+	int64_t timestamp;
+
+	/** Address of the server the session was negotiated with. */
+	struct sockaddr peer_addr;
+
+	/** Hash of the server hostname, 0 if no hostname was set. */
+	uint32_t hostname_hash;
+
+	/** mbedTLS session. */
+	mbedtls_ssl_session session;
+};
+
+/* A global pool of client sessions. */
+static struct tls_session_cache
+		client_sessions[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+
+/* A mutex for protecting the session cache and the ticket keys. */
+static struct k_mutex session_lock;
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Session ticket keys shared by all TLS servers. */
+static mbedtls_ssl_ticket_context tls_tickets;
+static bool tls_tickets_ready;
+#endif
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 bool net_socket_is_tls(void *obj)
 {
 	return PART_OF_ARRAY(tls_contexts, (struct tls_context *)obj);
@@ -276,6 +313,240 @@ static int dtls_timing_get_delay(void *data)
 }
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+static void tls_session_cache_init(void)
+{
+	int i;
+
+	k_mutex_init(&session_lock);
+
+	for (i = 0; i < ARRAY_SIZE(client_sessions); i++) {
+		mbedtls_ssl_session_init(&client_sessions[i].session);
+	}
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&tls_tickets);
+
+	i = mbedtls_ssl_ticket_setup(&tls_tickets, mbedtls_ctr_drbg_random,
+				     &tls_ctr_drbg, MBEDTLS_CIPHER_AES_256_GCM,
+				     CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+	if (i != 0) {
+		NET_WARN("TLS session tickets not available (-%x)", -i);
+	} else {
+		tls_tickets_ready = true;
+	}
+#endif
+}
+
+static bool tls_session_addr_cmp(const struct sockaddr *a,
+				 const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && a->sa_family == AF_INET6) {
+		return net_sin6(a)->sin6_port == net_sin6(b)->sin6_port &&
+		       net_ipv6_addr_cmp(&net_sin6(a)->sin6_addr,
+					 &net_sin6(b)->sin6_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && a->sa_family == AF_INET) {
+		return net_sin(a)->sin_port == net_sin(b)->sin_port &&
+		       net_ipv4_addr_cmp(&net_sin(a)->sin_addr,
+					 &net_sin(b)->sin_addr);
+	}
+
+	return false;
+}
+
+static uint32_t tls_session_hostname_hash(struct tls_context *ctx)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (ctx->options.is_hostname_set && ctx->ssl.hostname) {
+		return crc32_ieee(ctx->ssl.hostname,
+				  strlen(ctx->ssl.hostname));
+	}
+#endif
+
+	return 0;
+}
+
+static void tls_session_free(struct tls_session_cache *entry)
+{
+	mbedtls_ssl_session_free(&entry->session);
+	mbedtls_ssl_session_init(&entry->session);
+	entry->timestamp = 0;
+}
+
+/* Must be called with session_lock held. */
+static struct tls_session_cache *tls_session_find(struct tls_context *ctx,
+						  const struct sockaddr *addr)
+{
+	uint32_t hash = tls_session_hostname_hash(ctx);
+	int64_t now = k_uptime_get();
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client_sessions); i++) {
+		struct tls_session_cache *entry = &client_sessions[i];
+
+		if (entry->timestamp == 0) {
+			continue;
+		}
+
+		if (now - entry->timestamp >
+		    CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME * MSEC_PER_SEC) {
+			tls_session_free(entry);
+			continue;
+		}
+
+		if (entry->hostname_hash == hash &&
+		    tls_session_addr_cmp(&entry->peer_addr, addr)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Offer the session cached for the peer, if any, in the next handshake. */
+static void tls_session_restore(struct tls_context *ctx,
+				const struct sockaddr *addr)
+{
+	struct tls_session_cache *entry;
+	int ret;
+
+	if (!ctx->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(ctx, addr);
+	if (entry) {
+		ret = mbedtls_ssl_set_session(&ctx->ssl, &entry->session);
+		if (ret != 0) {
+			NET_DBG("Cannot resume TLS session (-%x)", -ret);
+		} else {
+			NET_DBG("Resuming TLS session %p", entry);
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+
+/* Store the session after a successful handshake, replacing the session
+ * previously cached for the same peer or the oldest one.
+ */
+static void tls_session_store(struct tls_context *ctx,
+			      const struct sockaddr *addr)
+{
+	struct tls_session_cache *entry;
+	int i, ret;
+
+	if (!ctx->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(ctx, addr);
+	if (!entry) {
+		/* Unused entries have the lowest timestamp */
+		entry = &client_sessions[0];
+
+		for (i = 1; i < ARRAY_SIZE(client_sessions); i++) {
+			if (client_sessions[i].timestamp < entry->timestamp) {
+				entry = &client_sessions[i];
+			}
+		}
+	}
+
+	tls_session_free(entry);
+
+	ret = mbedtls_ssl_get_session(&ctx->ssl, &entry->session);
+	if (ret != 0) {
+		NET_DBG("Cannot store TLS session (-%x)", -ret);
+		tls_session_free(entry);
+	} else {
+		entry->timestamp = k_uptime_get();
+		entry->hostname_hash = tls_session_hostname_hash(ctx);
+		memcpy(&entry->peer_addr, addr, sizeof(entry->peer_addr));
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+
+/* Forget the session of a peer, e.g. after a failed handshake. */
+static void tls_session_purge(struct tls_context *ctx,
+			      const struct sockaddr *addr)
+{
+	struct tls_session_cache *entry;
+
+	if (!ctx->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(ctx, addr);
+	if (entry) {
+		tls_session_free(entry);
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* The ticket keys are rotated by mbedTLS, serialize the accesses made by
+ * the different TLS contexts.
+ */
+static int tls_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+			    unsigned char *start, const unsigned char *end,
+			    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+			    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_tickets_enable(struct tls_context *ctx)
+{
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (!ctx->options.cache_enabled || !tls_tickets_ready) {
+		return;
+	}
+
+	mbedtls_ssl_conf_session_tickets_cb(&ctx->config, tls_ticket_write,
+					    tls_ticket_parse, &tls_tickets);
+#endif
+}
+#else
+#define tls_session_cache_init(...)
+#define tls_session_restore(...)
+#define tls_session_store(...)
+#define tls_session_purge(...)
+#define tls_session_tickets_enable(...)
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 /* Initialize TLS internals. */
 static int tls_init(const struct device *unused)
 {
@@ -313,6 +584,8 @@ static int tls_init(const struct device *unused)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+	tls_session_cache_init();
+
 	return 0;
 }
 
@@ -989,6 +1262,10 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif /* CONFIG_MBEDTLS_SSL_ALPN */
 
+	if (is_server) {
+		tls_session_tickets_enable(context);
+	}
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -1249,6 +1526,51 @@ static int tls_opt_dtls_role_set(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_set(struct tls_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *enabled;
+
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)) {
+		return -ENOPROTOOPT;
+	}
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	enabled = (int *)optval;
+	if (*enabled != TLS_SESSION_CACHE_DISABLED &&
+	    *enabled != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->options.cache_enabled = *enabled;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct tls_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)) {
+		return -ENOPROTOOPT;
+	}
+
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->options.cache_enabled ?
+		TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+
+	return 0;
+}
+
 static int protocol_check(int family, int type, int *proto)
 {
 	if (family != AF_INET && family != AF_INET6) {
@@ -1369,13 +1691,18 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 		/* Do not use any socket flags during the handshake. */
 		ctx->flags = 0;
 
+		tls_session_restore(ctx, addr);
+
 		/* TODO For simplicity, TLS handshake blocks the socket
 		 * even for non-blocking socket.
 		 */
 		ret = tls_mbedtls_handshake(ctx, true);
 		if (ret < 0) {
+			tls_session_purge(ctx, addr);
 			goto error;
 		}
+
+		tls_session_store(ctx, addr);
 	} else {
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 		/* Just store the address. */
@@ -1509,13 +1836,18 @@ static ssize_t sendto_dtls_client(struct tls_context *ctx, const void *buf,
 	}
 
 	if (!is_handshake_complete(ctx)) {
+		tls_session_restore(ctx, &ctx->dtls_peer_addr);
+
 		/* TODO For simplicity, TLS handshake blocks the socket even for
 		 * non-blocking socket.
 		 */
 		ret = tls_mbedtls_handshake(ctx, true);
 		if (ret < 0) {
+			tls_session_purge(ctx, &ctx->dtls_peer_addr);
 			goto error;
 		}
+
+		tls_session_store(ctx, &ctx->dtls_peer_addr);
 	}
 
 	return send_tls(ctx, buf, len, flags);
@@ -2056,6 +2388,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_alpn_list_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or write-only option. */
 		err = -ENOPROTOOPT;
@@ -2105,6 +2441,10 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_alpn_list_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or read-only option. */
 		err = -ENOPROTOOPT;
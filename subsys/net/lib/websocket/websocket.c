@@ -440,6 +440,44 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+/* Mask or unmask the data in place. The offset is the position of the
+ * data in the payload, it selects the first byte of the masking key.
+ */
+static void websocket_mask(uint8_t *buf, size_t len, uint32_t masking_value,
+			   uint64_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	uint32_t word;
+	size_t i = 0;
+	int j;
+
+	sys_put_be32(masking_value, key);
+
+	/* Byte by byte until the buffer is aligned */
+	while (i < len && ((uintptr_t)&buf[i] & (sizeof(word) - 1))) {
+		buf[i] ^= key[(offset + i) % sizeof(key)];
+		i++;
+	}
+
+	if (len - i >= sizeof(word)) {
+		uint8_t rotated[sizeof(word)];
+
+		for (j = 0; j < sizeof(rotated); j++) {
+			rotated[j] = key[(offset + i + j) % sizeof(key)];
+		}
+
+		memcpy(&word, rotated, sizeof(word));
+
+		for (; len - i >= sizeof(word); i += sizeof(word)) {
+			*(uint32_t *)&buf[i] ^= word;
+		}
+	}
+
+	for (; i < len; i++) {
+		buf[i] ^= key[(offset + i) % sizeof(key)];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
@@ -550,8 +588,6 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
@@ -564,12 +600,13 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 			return -ENOMEM;
 		}
 
+		/* The payload of the caller is const, it is masked in the
+		 * copy that is sent in one go with the header.
+		 */
 		memcpy(data_to_send, payload, payload_len);
 
-		for (i = 0; i < payload_len; i++) {
-			data_to_send[i] ^=
-				ctx->masking_value >> (8 * (3 - i % 4));
-		}
+		websocket_mask(data_to_send, payload_len, ctx->masking_value,
+			       0);
 	}
 
 	ret = websocket_prepare_and_send(ctx, header, hdr_len,
@@ -778,16 +815,20 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 	/* Now read the whole payload or parts of it */
 
 	if (ctx->tmp_buf_pos == 0) {
-		/* Read more data into temp buffer */
+		/* Nothing is buffered, read the data of this frame straight
+		 * to the buffer of the caller.
+		 */
+		can_copy = MIN(ctx->message_len - ctx->total_read, buf_len);
+
 #if defined(CONFIG_NET_TEST)
-		size_t input_len = MIN(ctx->tmp_buf_len, test_data->input_len);
+		size_t input_len = MIN(can_copy, test_data->input_len);
 
-		memcpy(ctx->tmp_buf, test_data->input_buf, input_len);
+		memcpy(buf, test_data->input_buf, input_len);
 		test_data->input_buf += input_len;
 
 		ret = input_len;
 #else
-		ret = recv(ctx->real_sock, ctx->tmp_buf, ctx->tmp_buf_len,
+		ret = recv(ctx->real_sock, buf, can_copy,
 			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
 #endif /* CONFIG_NET_TEST */
 
@@ -799,7 +840,9 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 			return 0;
 		}
 
-		ctx->tmp_buf_pos = ret;
+		recv_len = ret;
+
+		goto received;
 	}
 
 	if (ctx->tmp_buf_pos <= buf_len) {
@@ -827,21 +870,14 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 	}
 
 	ctx->tmp_buf_pos = left;
+
+received:
 	ctx->total_read += recv_len;
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		/* As we might have less than 4 received bytes, we must select
-		 * which byte from masking value to take. The mask_shift will
-		 * tell that.
-		 */
-		int mask_shift = (ctx->total_read - recv_len) % sizeof(uint32_t);
-		int i;
-
-		for (i = 0; i < recv_len; i++) {
-			buf[i] ^= ctx->masking_value >>
-				(8 * (3 - (i + mask_shift) % 4));
-		}
+		websocket_mask(buf, recv_len, ctx->masking_value,
+			       ctx->total_read - recv_len);
 	}
 
 #if HEXDUMP_RECV_PACKETS
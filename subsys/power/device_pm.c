@@ -17,21 +17,95 @@ LOG_MODULE_DECLARE(power);
 #define DEVICE_PM_SYNC			(0 << 0)
 #define DEVICE_PM_ASYNC			(1 << 0)
 
+#if CONFIG_DEVICE_IDLE_PM_WORKERS > 0
+static struct k_work_q pm_work_qs[CONFIG_DEVICE_IDLE_PM_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(pm_work_q_stacks,
+				   CONFIG_DEVICE_IDLE_PM_WORKERS,
+				   CONFIG_DEVICE_IDLE_PM_WORKER_STACK_SIZE);
+
+static int pm_work_qs_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (int i = 0; i < CONFIG_DEVICE_IDLE_PM_WORKERS; i++) {
+		k_work_q_start(&pm_work_qs[i], pm_work_q_stacks[i],
+			       K_THREAD_STACK_SIZEOF(pm_work_q_stacks[i]),
+			       CONFIG_DEVICE_IDLE_PM_WORKER_PRIORITY);
+		k_thread_name_set(&pm_work_qs[i].thread, "device_pm");
+	}
+
+	return 0;
+}
+
+/* Started along with the system workqueue, which is used otherwise */
+SYS_INIT(pm_work_qs_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_DEVICE_IDLE_PM_WORKERS > 0 */
+
+/* Devices are spread over the workers, in the order they are defined */
+static struct k_work_q *pm_work_q(const struct device *dev)
+{
+#if CONFIG_DEVICE_IDLE_PM_WORKERS > 0
+	return &pm_work_qs[((uintptr_t)dev / sizeof(*dev)) %
+			   CONFIG_DEVICE_IDLE_PM_WORKERS];
+#else
+	return &k_sys_work_q;
+#endif
+}
+
+static void pm_work_submit(const struct device *dev)
+{
+	k_work_submit_to_queue(pm_work_q(dev), &dev->pm->work);
+}
+
 static void device_pm_callback(const struct device *dev,
 			       int retval, void *context, void *arg)
 {
+	struct device_pm *child;
+
 	__ASSERT(retval == 0, "Device set power state failed");
 
 	/* Set the fsm_state */
 	if (*((uint32_t *)context) == DEVICE_PM_ACTIVE_STATE) {
 		atomic_set(&dev->pm->fsm_state,
 			   DEVICE_PM_FSM_STATE_ACTIVE);
+
+		/* Resume the children waiting for their parent */
+		SYS_SLIST_FOR_EACH_CONTAINER(&dev->pm->children, child,
+					     sibling) {
+			if (child->dev != NULL) {
+				pm_work_submit(child->dev);
+			}
+		}
 	} else {
 		atomic_set(&dev->pm->fsm_state,
 			   DEVICE_PM_FSM_STATE_SUSPENDED);
+
+		if (dev->pm->parent_used) {
+			dev->pm->parent_used = false;
+			(void)device_pm_put(dev->pm->parent);
+		}
+	}
+
+	pm_work_submit(dev);
+}
+
+/* Use the parent before resuming, returns true until it is active */
+static bool parent_wait(const struct device *dev)
+{
+	const struct device *parent = dev->pm->parent;
+
+	/* Devices without idle PM are always active */
+	if ((parent == NULL) || (parent->pm->dev == NULL)) {
+		return false;
 	}
 
-	k_work_submit(&dev->pm->work);
+	if (!dev->pm->parent_used) {
+		dev->pm->parent_used = true;
+		(void)device_pm_get(parent);
+	}
+
+	return atomic_get(&parent->pm->fsm_state) !=
+	       DEVICE_PM_FSM_STATE_ACTIVE;
 }
 
 static void pm_work_handler(struct k_work *work)
@@ -59,6 +133,11 @@ static void pm_work_handler(struct k_work *work)
 	case DEVICE_PM_FSM_STATE_SUSPENDED:
 		if ((atomic_get(&dev->pm->usage) > 0) ||
 					!dev->pm->enable) {
+			if (parent_wait(dev)) {
+				/* Resubmitted once the parent is active */
+				break;
+			}
+
 			atomic_set(&dev->pm->fsm_state,
 				   DEVICE_PM_FSM_STATE_RESUMING);
 			ret = device_set_power_state(dev,
@@ -85,6 +164,16 @@ fsm_out:
 	k_poll_signal_raise(&dev->pm->signal, pm_state);
 }
 
+static void pm_autosuspend_handler(struct k_work *work)
+{
+	struct k_delayed_work *autosuspend_work = CONTAINER_OF(work,
+					struct k_delayed_work, work);
+	struct device_pm *pm = CONTAINER_OF(autosuspend_work,
+					struct device_pm, autosuspend_work);
+
+	pm_work_submit(pm->dev);
+}
+
 static int device_pm_request(const struct device *dev,
 			     uint32_t target_state, uint32_t pm_flags)
 {
@@ -98,13 +187,24 @@ static int device_pm_request(const struct device *dev,
 		if (atomic_inc(&dev->pm->usage) < 0) {
 			return 0;
 		}
+
+		/* Used again before the autosuspend delay expired */
+		(void)k_delayed_work_cancel(&dev->pm->autosuspend_work);
 	} else {
 		if (atomic_dec(&dev->pm->usage) > 1) {
 			return 0;
 		}
+
+		if ((pm_flags & DEVICE_PM_ASYNC) &&
+		    (dev->pm->autosuspend_ms > 0U)) {
+			(void)k_delayed_work_submit_to_queue(pm_work_q(dev),
+				&dev->pm->autosuspend_work,
+				K_MSEC(dev->pm->autosuspend_ms));
+			return 0;
+		}
 	}
 
-	k_work_submit(&dev->pm->work);
+	pm_work_submit(dev);
 
 	/* Return in case of Async request */
 	if (pm_flags & DEVICE_PM_ASYNC) {
@@ -161,8 +261,10 @@ void device_pm_enable(const struct device *dev)
 		atomic_set(&dev->pm->fsm_state,
 			   DEVICE_PM_FSM_STATE_SUSPENDED);
 		k_work_init(&dev->pm->work, pm_work_handler);
+		k_delayed_work_init(&dev->pm->autosuspend_work,
+				    pm_autosuspend_handler);
 	} else {
-		k_work_submit(&dev->pm->work);
+		pm_work_submit(dev);
 	}
 	k_sem_give(&dev->pm->lock);
 }
@@ -172,6 +274,24 @@ void device_pm_disable(const struct device *dev)
 	k_sem_take(&dev->pm->lock, K_FOREVER);
 	dev->pm->enable = false;
 	/* Bring up the device before disabling the Idle PM */
-	k_work_submit(&dev->pm->work);
+	pm_work_submit(dev);
 	k_sem_give(&dev->pm->lock);
 }
+
+void device_pm_parent_set(const struct device *dev,
+			  const struct device *parent)
+{
+	__ASSERT(dev->pm->dev == NULL, "Device idle PM already enabled");
+
+	dev->pm->parent = parent;
+
+	k_sem_take(&parent->pm->lock, K_FOREVER);
+	sys_slist_append(&parent->pm->children, &dev->pm->sibling);
+	k_sem_give(&parent->pm->lock);
+}
+
+void device_pm_autosuspend_delay_set(const struct device *dev,
+				     uint32_t delay_ms)
+{
+	dev->pm->autosuspend_ms = delay_ms;
+}
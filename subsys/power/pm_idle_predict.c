@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <kernel.h>
+#include <power/power.h>
+
+#define LOG_LEVEL CONFIG_SYS_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+/*
+ * The prediction combines two estimates of the idle time, as the Linux menu
+ * governor does:
+ *
+ * - The time until the next timeout, scaled by how much of it the idle
+ *   periods with a similar timeout actually lasted. Timeouts are grouped in
+ *   buckets of powers of two ticks, each with its own correction factor.
+ *
+ * - The interval with which the last idle periods repeat, if they do, for
+ *   the interrupts waking the system at a steady rate.
+ */
+
+/* Fixed point of the correction factors, decayed by 1/DECAY on each update */
+#define RESOLUTION 1024U
+#define DECAY 8U
+#define UNITY (RESOLUTION * DECAY)
+
+#define BUCKETS 8
+
+#define HISTORY CONFIG_SYS_PM_IDLE_PREDICT_HISTORY
+
+/* Longer idle periods are recorded as this, sums of squares can't overflow */
+#define INTERVAL_MAX BIT(27)
+
+static uint32_t correction[BUCKETS] = { [0 ... (BUCKETS - 1)] = UNITY };
+
+static uint32_t intervals[HISTORY];
+static uint8_t interval_next;
+static uint8_t interval_count;
+
+/* Idle period in progress */
+static bool idle_pending;
+static int64_t idle_start;
+static int32_t idle_expected;
+
+static int bucket_get(int32_t ticks)
+{
+	int bucket = 0;
+
+	while (ticks > 1 && bucket < (BUCKETS - 1)) {
+		ticks >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+/*
+ * Average of the recorded idle periods, if their standard deviation is
+ * small. Otherwise the longest periods are dropped as outliers and the
+ * remaining ones tried again, as long as they are three quarters of them
+ * or are all the same.
+ */
+static int32_t typical_interval(void)
+{
+	uint32_t thresh = UINT32_MAX;
+
+	if (interval_count < HISTORY) {
+		return K_TICKS_FOREVER;
+	}
+
+	while (true) {
+		uint64_t sum = 0U, variance = 0U, avg;
+		uint32_t max = 0U;
+		unsigned int i, n = 0U;
+
+		for (i = 0U; i < HISTORY; i++) {
+			if (intervals[i] <= thresh) {
+				sum += intervals[i];
+				max = MAX(max, intervals[i]);
+				n++;
+			}
+		}
+
+		avg = sum / n;
+
+		for (i = 0U; i < HISTORY; i++) {
+			if (intervals[i] <= thresh) {
+				int64_t diff = (int64_t)intervals[i] - avg;
+
+				variance += diff * diff;
+			}
+		}
+
+		variance /= n;
+
+		if (variance <= 1U ||
+		    (avg * avg > 36U * variance && n * 4U >= HISTORY * 3U)) {
+			return (int32_t)avg;
+		}
+
+		if (n * 4U <= HISTORY * 3U) {
+			return K_TICKS_FOREVER;
+		}
+
+		thresh = max - 1U;
+	}
+}
+
+int32_t sys_pm_idle_predict(int32_t ticks)
+{
+	int32_t typical = typical_interval();
+	int32_t predicted;
+
+	idle_pending = true;
+	idle_start = k_uptime_ticks();
+	idle_expected = ticks;
+
+	if (ticks == K_TICKS_FOREVER) {
+		return typical;
+	}
+
+	predicted = ((uint64_t)ticks * correction[bucket_get(ticks)]) / UNITY;
+
+	if (typical != K_TICKS_FOREVER) {
+		predicted = MIN(predicted, typical);
+	}
+
+	LOG_DBG("Idle for %d ticks, predicted %d", ticks, predicted);
+
+	return predicted;
+}
+
+void sys_pm_idle_predict_exit(void)
+{
+	int64_t measured;
+
+	if (!idle_pending) {
+		return;
+	}
+
+	idle_pending = false;
+	measured = MIN(k_uptime_ticks() - idle_start, (int64_t)INTERVAL_MAX);
+
+	if (idle_expected > 0) {
+		uint32_t *factor = &correction[bucket_get(idle_expected)];
+
+		/* Waking up late still is a timeout, not a longer idle time */
+		measured = MIN(measured, (int64_t)idle_expected);
+
+		*factor -= *factor / DECAY;
+		*factor += (uint32_t)((RESOLUTION * measured) / idle_expected);
+	}
+
+	intervals[interval_next] = (uint32_t)measured;
+	interval_next = (interval_next + 1U) % HISTORY;
+	interval_count = MIN(interval_count + 1U, HISTORY);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/slist.h>
+#include <spinlock.h>
+#include <power/power.h>
+
+#define LOG_LEVEL CONFIG_SYS_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+static sys_slist_t latency_requests;
+static struct k_spinlock latency_lock;
+
+/* Strictest constraint, kept up to date for the idle path */
+static uint32_t latency_max_us = SYS_PM_LATENCY_NONE;
+
+static void max_latency_update(void)
+{
+	struct sys_pm_latency_request *req;
+	uint32_t max = SYS_PM_LATENCY_NONE;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&latency_requests, req, node) {
+		max = MIN(max, req->max_latency_us);
+	}
+
+	if (max != latency_max_us) {
+		LOG_DBG("Maximum wakeup latency %u us", max);
+	}
+
+	latency_max_us = max;
+}
+
+void sys_pm_latency_request_add(struct sys_pm_latency_request *req,
+				uint32_t max_latency_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	req->max_latency_us = max_latency_us;
+	sys_slist_append(&latency_requests, &req->node);
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void sys_pm_latency_request_update(struct sys_pm_latency_request *req,
+				   uint32_t max_latency_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	req->max_latency_us = max_latency_us;
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void sys_pm_latency_request_remove(struct sys_pm_latency_request *req)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+	bool found;
+
+	found = sys_slist_find_and_remove(&latency_requests, &req->node);
+	__ASSERT(found, "Latency request not added");
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+
+	/* Make compiler happy when assertions are disabled. */
+	(void)(found);
+}
+
+uint32_t sys_pm_latency_max_get(void)
+{
+	return latency_max_us;
+}
@@ -45,8 +45,46 @@ static const unsigned int pm_min_residency[] = {
 #endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
 };
 
+#ifdef CONFIG_SYS_PM_LATENCY
+/* Exit latencies in microseconds, in the order of pm_min_residency */
+static const uint32_t pm_exit_latency[] = {
+#ifdef CONFIG_SYS_POWER_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_1
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_1,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_2
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_2,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_3
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_3,
+#endif
+#endif /* CONFIG_SYS_POWER_SLEEP_STATES */
+
+#ifdef CONFIG_SYS_POWER_DEEP_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_1
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_1,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_2
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_2,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_3
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_3,
+#endif
+#endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
+};
+
+BUILD_ASSERT(ARRAY_SIZE(pm_exit_latency) == ARRAY_SIZE(pm_min_residency));
+#endif /* CONFIG_SYS_PM_LATENCY */
+
 enum power_states sys_pm_policy_next_state(int32_t ticks)
 {
+#ifdef CONFIG_SYS_PM_LATENCY
+	uint32_t max_latency_us = sys_pm_latency_max_get();
+#endif
 	int i;
 
 	if ((ticks != K_TICKS_FOREVER) && (ticks < pm_min_residency[0])) {
@@ -59,6 +97,12 @@ enum power_states sys_pm_policy_next_state(int32_t ticks)
 		if (!sys_pm_ctrl_is_state_enabled((enum power_states)(i))) {
 			continue;
 		}
+#endif
+#ifdef CONFIG_SYS_PM_LATENCY
+		/* Deeper states wake up more slowly */
+		if (pm_exit_latency[i] > max_latency_us) {
+			continue;
+		}
 #endif
 		if ((ticks == K_TICKS_FOREVER) ||
 		    (ticks >= pm_min_residency[i])) {
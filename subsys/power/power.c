@@ -96,8 +96,14 @@ enum power_states _sys_suspend(int32_t ticks)
 	bool low_power = false;
 #endif
 
-	pm_state = (forced_pm_state == SYS_POWER_STATE_AUTO) ?
-		   sys_pm_policy_next_state(ticks) : forced_pm_state;
+	if (forced_pm_state == SYS_POWER_STATE_AUTO) {
+#ifdef CONFIG_SYS_PM_IDLE_PREDICT
+		ticks = sys_pm_idle_predict(ticks);
+#endif
+		pm_state = sys_pm_policy_next_state(ticks);
+	} else {
+		pm_state = forced_pm_state;
+	}
 
 	if (pm_state == SYS_POWER_STATE_ACTIVE) {
 		LOG_DBG("No PM operations done.");
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <profiling/profiling.h>
+#include <string.h>
+#include <errno.h>
+
+/* Threads and call depth followed when the events are summarized */
+#define REPLAY_THREADS 8
+#define REPLAY_DEPTH 32
+
+/* Set in the thread field of the exit events, threads are word aligned */
+#define EVENT_EXIT BIT(0)
+
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+struct event {
+	void *func;
+	uintptr_t thread;
+	uint32_t cycles;
+};
+
+struct event_ring {
+	struct event events[CONFIG_PROFILING_INSTRUMENT_BUFFER_SIZE];
+	uint32_t wr;
+	bool busy;
+};
+
+struct frame {
+	void *func;
+	uint64_t exclusive;
+	uint64_t children;
+};
+
+struct replay_thread {
+	uintptr_t thread;
+	uint32_t depth;
+	struct frame frames[REPLAY_DEPTH];
+};
+
+static struct event_ring rings[CONFIG_MP_NUM_CPUS];
+static atomic_t running;
+
+static struct profiling_func_stat stats[CONFIG_PROFILING_INSTRUMENT_FUNCS];
+static struct replay_thread replay[REPLAY_THREADS];
+
+static NO_INSTRUMENT void record(void *func, uintptr_t flags)
+{
+	struct event_ring *ring;
+	struct event *event;
+	unsigned int key;
+
+	if (!atomic_get(&running)) {
+		return;
+	}
+
+	key = irq_lock();
+	ring = &rings[_current_cpu->id];
+
+	/* Functions called from here may be instrumented as well */
+	if (!ring->busy) {
+		ring->busy = true;
+
+		event = &ring->events[ring->wr % ARRAY_SIZE(ring->events)];
+		event->func = func;
+		event->thread = (uintptr_t)_current | flags;
+		event->cycles = k_cycle_get_32();
+		ring->wr++;
+
+		ring->busy = false;
+	}
+
+	irq_unlock(key);
+}
+
+NO_INSTRUMENT void __cyg_profile_func_enter(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	record(func, 0U);
+}
+
+NO_INSTRUMENT void __cyg_profile_func_exit(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	record(func, EVENT_EXIT);
+}
+
+int profiling_instrument_start(void)
+{
+	if (atomic_get(&running)) {
+		return -EALREADY;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(rings); i++) {
+		rings[i].wr = 0U;
+	}
+
+	atomic_set(&running, 1);
+
+	return 0;
+}
+
+int profiling_instrument_stop(void)
+{
+	if (!atomic_cas(&running, 1, 0)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static struct profiling_func_stat *stat_get(void *func)
+{
+	uint32_t idx = ((uintptr_t)func >> 1) % ARRAY_SIZE(stats);
+
+	for (int i = 0; i < ARRAY_SIZE(stats); i++) {
+		struct profiling_func_stat *stat = &stats[idx];
+
+		if (stat->func == func || stat->func == NULL) {
+			stat->func = func;
+			return stat;
+		}
+
+		idx = (idx + 1U) % ARRAY_SIZE(stats);
+	}
+
+	return NULL;
+}
+
+static struct replay_thread *replay_thread_get(uintptr_t thread)
+{
+	for (int i = 0; i < ARRAY_SIZE(replay); i++) {
+		if (replay[i].thread == thread || replay[i].thread == 0U) {
+			replay[i].thread = thread;
+			return &replay[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void replay_exit(struct replay_thread *rt, void *func)
+{
+	struct profiling_func_stat *stat;
+	struct frame *frame;
+	uint64_t inclusive;
+
+	rt->depth--;
+	if (rt->depth >= REPLAY_DEPTH) {
+		/* Too deep to be followed */
+		return;
+	}
+
+	frame = &rt->frames[rt->depth];
+	inclusive = frame->exclusive + frame->children;
+
+	if (rt->depth > 0U) {
+		rt->frames[rt->depth - 1U].children += inclusive;
+	}
+
+	stat = stat_get(func);
+	if (stat != NULL) {
+		stat->calls++;
+		stat->inclusive += inclusive;
+		stat->exclusive += frame->exclusive;
+	}
+}
+
+/* Replay the events of a CPU, oldest first. The time between two
+ * consecutive events of the same thread is spent in the function on top of
+ * its stack. The time between events of different threads, which includes
+ * the context switch, is not accounted.
+ */
+static void replay_ring(const struct event_ring *ring)
+{
+	uint32_t cnt = MIN(ring->wr, ARRAY_SIZE(ring->events));
+	struct replay_thread *prev = NULL;
+	uint32_t prev_cycles = 0U;
+
+	(void)memset(replay, 0, sizeof(replay));
+
+	for (uint32_t i = ring->wr - cnt; i != ring->wr; i++) {
+		const struct event *event =
+			&ring->events[i % ARRAY_SIZE(ring->events)];
+		struct replay_thread *rt;
+
+		rt = replay_thread_get(event->thread & ~EVENT_EXIT);
+		if (rt == NULL) {
+			prev = NULL;
+			continue;
+		}
+
+		if (rt == prev && rt->depth > 0U && rt->depth <= REPLAY_DEPTH) {
+			rt->frames[rt->depth - 1U].exclusive +=
+				event->cycles - prev_cycles;
+		}
+
+		if ((event->thread & EVENT_EXIT) == 0U) {
+			if (rt->depth < REPLAY_DEPTH) {
+				rt->frames[rt->depth] = (struct frame){
+					.func = event->func,
+				};
+			}
+			rt->depth++;
+		} else if (rt->depth > 0U) {
+			replay_exit(rt, event->func);
+		} else {
+			/* Entered before the oldest recorded event */
+		}
+
+		prev = rt;
+		prev_cycles = event->cycles;
+	}
+}
+
+int profiling_instrument_summarize(size_t count, profiling_func_cb_t cb,
+				   void *user_data)
+{
+	int funcs = 0;
+
+	if (atomic_get(&running)) {
+		return -EBUSY;
+	}
+
+	(void)memset(stats, 0, sizeof(stats));
+
+	for (int i = 0; i < ARRAY_SIZE(rings); i++) {
+		replay_ring(&rings[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(stats); i++) {
+		funcs += (stats[i].func != NULL) ? 1 : 0;
+	}
+
+	/* Hottest first, by exclusive time */
+	while (count-- > 0U) {
+		struct profiling_func_stat *hot = NULL;
+
+		for (int i = 0; i < ARRAY_SIZE(stats); i++) {
+			if (stats[i].calls != 0U &&
+			    (hot == NULL || stats[i].exclusive > hot->exclusive)) {
+				hot = &stats[i];
+			}
+		}
+
+		if (hot == NULL) {
+			break;
+		}
+
+		cb(hot, user_data);
+		hot->calls = 0U;
+	}
+
+	return funcs;
+}
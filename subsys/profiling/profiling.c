@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <profiling/profiling.h>
+#include <errno.h>
+
+static struct profiling_sample samples[CONFIG_PROFILING_SAMPLING_BUFFER_SIZE];
+static atomic_t sample_cnt;
+static atomic_t dropped_cnt;
+static atomic_t running;
+
+static void sample_handler(struct k_timer *timer)
+{
+	struct profiling_sample *sample;
+	uintptr_t pc, caller;
+	uint32_t idx;
+
+	ARG_UNUSED(timer);
+
+	idx = (uint32_t)atomic_get(&sample_cnt);
+	if (idx >= ARRAY_SIZE(samples)) {
+		atomic_inc(&dropped_cnt);
+		return;
+	}
+
+	if (arch_profiling_pc_get(&pc, &caller) != 0) {
+		/* Counted, so the time spent in interrupts is accounted */
+		pc = 0U;
+		caller = 0U;
+	}
+
+	sample = &samples[idx];
+	sample->pc = pc;
+#ifdef CONFIG_PROFILING_SAMPLING_CALLER
+	sample->caller = caller;
+#endif
+	sample->thread = k_current_get();
+
+	atomic_set(&sample_cnt, (atomic_val_t)(idx + 1));
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_handler, NULL);
+
+int profiling_start(k_timeout_t period)
+{
+	if (!atomic_cas(&running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	atomic_clear(&sample_cnt);
+	atomic_clear(&dropped_cnt);
+	k_timer_start(&sample_timer, period, period);
+
+	return 0;
+}
+
+int profiling_stop(void)
+{
+	if (!atomic_cas(&running, 1, 0)) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&sample_timer);
+
+	return 0;
+}
+
+void profiling_sample_foreach(profiling_sample_cb_t cb, void *user_data)
+{
+	uint32_t cnt = (uint32_t)atomic_get(&sample_cnt);
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		cb(&samples[i], user_data);
+	}
+}
+
+uint32_t profiling_dropped_get(void)
+{
+	return (uint32_t)atomic_get(&dropped_cnt);
+}
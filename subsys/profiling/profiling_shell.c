@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <shell/shell.h>
+#include <profiling/profiling.h>
+#include <stdlib.h>
+
+#define HOT_FUNCS_DEFAULT 10
+
+#ifdef CONFIG_PROFILING_SAMPLING
+static int cmd_start(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t period_us = CONFIG_PROFILING_SAMPLING_PERIOD_US;
+	int err;
+
+	if (argc > 1) {
+		period_us = strtoul(argv[1], NULL, 10);
+		if (period_us == 0U) {
+			shell_error(shell, "Invalid period: %s", argv[1]);
+			return -EINVAL;
+		}
+	}
+
+	err = profiling_start(K_USEC(period_us));
+	if (err != 0) {
+		shell_error(shell, "Sampling already running");
+		return err;
+	}
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (profiling_stop() != 0) {
+		shell_error(shell, "Sampling not running");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static void sample_print(const struct profiling_sample *sample,
+			 void *user_data)
+{
+	const struct shell *shell = user_data;
+	uintptr_t caller = 0U;
+
+#ifdef CONFIG_PROFILING_SAMPLING_CALLER
+	caller = sample->caller;
+#endif
+
+	shell_print(shell, "0x%lx 0x%lx 0x%lx", (unsigned long)sample->pc,
+		    (unsigned long)caller, (unsigned long)sample->thread);
+}
+
+static int cmd_dump(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	/* One "pc caller thread" line per sample, for profile_fold.py */
+	shell_print(shell, "profiling samples:");
+	profiling_sample_foreach(sample_print, (void *)shell);
+	shell_print(shell, "profiling dropped: %u", profiling_dropped_get());
+
+	return 0;
+}
+#endif /* CONFIG_PROFILING_SAMPLING */
+
+#ifdef CONFIG_PROFILING_INSTRUMENT
+static int cmd_instrument_start(const struct shell *shell, size_t argc,
+				char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (profiling_instrument_start() != 0) {
+		shell_error(shell, "Recording already running");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int cmd_instrument_stop(const struct shell *shell, size_t argc,
+			       char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (profiling_instrument_stop() != 0) {
+		shell_error(shell, "Recording not running");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static void func_print(const struct profiling_func_stat *stat,
+		       void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	shell_print(shell, "0x%08lx %10u %12llu %12llu",
+		    (unsigned long)stat->func, stat->calls,
+		    (unsigned long long)k_cyc_to_us_floor64(stat->inclusive),
+		    (unsigned long long)k_cyc_to_us_floor64(stat->exclusive));
+}
+
+static int cmd_instrument_hot(const struct shell *shell, size_t argc,
+			      char **argv)
+{
+	size_t count = HOT_FUNCS_DEFAULT;
+	int funcs;
+
+	if (argc > 1) {
+		count = strtoul(argv[1], NULL, 10);
+	}
+
+	shell_print(shell, "%-10s %10s %12s %12s", "function", "calls",
+		    "incl [us]", "excl [us]");
+
+	funcs = profiling_instrument_summarize(count, func_print,
+					       (void *)shell);
+	if (funcs < 0) {
+		shell_error(shell, "Recording running, stop it first");
+		return funcs;
+	}
+
+	shell_print(shell, "%d functions", funcs);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_instrument,
+	SHELL_CMD(start, NULL, "Start recording.", cmd_instrument_start),
+	SHELL_CMD(stop, NULL, "Stop recording.", cmd_instrument_stop),
+	SHELL_CMD_ARG(hot, NULL, "Print the hottest functions [count].",
+		      cmd_instrument_hot, 1, 1),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif /* CONFIG_PROFILING_INSTRUMENT */
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiling,
+#ifdef CONFIG_PROFILING_SAMPLING
+	SHELL_CMD_ARG(start, NULL, "Start sampling [period in us].",
+		      cmd_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_stop),
+	SHELL_CMD(dump, NULL, "Print the recorded samples.", cmd_dump),
+#endif
+#ifdef CONFIG_PROFILING_INSTRUMENT
+	SHELL_CMD(instrument, &sub_instrument, "Function instrumentation.",
+		  NULL),
+#endif
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiling, &sub_profiling, "Profiling commands", NULL);
@@ -26,35 +26,53 @@
 
 #endif /* CONFIG_MBEDTLS */
 
-static K_SEM_DEFINE(state_sem, 1, 1);
+#define BUFFER_SIZE CONFIG_CS_CTR_DRBG_BUFFER_SIZE
 
 static const struct device *entropy_driver;
 static const unsigned char drbg_seed[] = CONFIG_CS_CTR_DRBG_PERSONALIZATION;
 
+/* One generator per CPU, each seeded from the entropy driver on its first
+ * use. They are only used with the interrupts of their CPU locked, so the
+ * CPUs never wait for each other.
+ */
+struct ctr_drbg {
 #if defined(CONFIG_MBEDTLS)
+	mbedtls_ctr_drbg_context ctx;
+#elif defined(CONFIG_TINYCRYPT)
+	TCCtrPrng_t ctx;
+#endif
+	bool initialized;
+#if BUFFER_SIZE > 0
+	/* Output generated ahead, the unused bytes are at its end */
+	uint8_t buf[BUFFER_SIZE];
+	uint16_t buf_len;
+#endif
+};
 
-static mbedtls_ctr_drbg_context ctr_ctx;
+static struct ctr_drbg drbgs[CONFIG_MP_NUM_CPUS];
+
+#if defined(CONFIG_MBEDTLS)
 
 static int ctr_drbg_entropy_func(void *ctx, unsigned char *buf, size_t len)
 {
 	return entropy_get_entropy(entropy_driver, (void *)buf, len);
 }
 
-#elif defined(CONFIG_TINYCRYPT)
-
-static TCCtrPrng_t ctr_ctx;
-
 #endif /* CONFIG_MBEDTLS */
 
 
-static int ctr_drbg_initialize(void)
+static int ctr_drbg_initialize(struct ctr_drbg *drbg)
 {
 	int ret;
 
 	/* Only one entropy device exists, so this is safe even
 	 * if the whole operation isn't atomic.
 	 */
-	entropy_driver = device_get_binding(DT_CHOSEN_ZEPHYR_ENTROPY_LABEL);
+	if (!entropy_driver) {
+		entropy_driver =
+			device_get_binding(DT_CHOSEN_ZEPHYR_ENTROPY_LABEL);
+	}
+
 	if (!entropy_driver) {
 		__ASSERT((entropy_driver != NULL),
 			"Device driver for %s (DT_CHOSEN_ZEPHYR_ENTROPY_LABEL) not found. "
@@ -65,16 +83,16 @@ static int ctr_drbg_initialize(void)
 
 #if defined(CONFIG_MBEDTLS)
 
-	mbedtls_ctr_drbg_init(&ctr_ctx);
+	mbedtls_ctr_drbg_init(&drbg->ctx);
 
-	ret = mbedtls_ctr_drbg_seed(&ctr_ctx,
+	ret = mbedtls_ctr_drbg_seed(&drbg->ctx,
 				    ctr_drbg_entropy_func,
 				    NULL,
 				    drbg_seed,
 				    sizeof(drbg_seed));
 
 	if (ret != 0) {
-		mbedtls_ctr_drbg_free(&ctr_ctx);
+		mbedtls_ctr_drbg_free(&drbg->ctx);
 		return -EIO;
 	}
 
@@ -88,7 +106,7 @@ static int ctr_drbg_initialize(void)
 		return -EIO;
 	}
 
-	ret = tc_ctr_prng_init(&ctr_ctx,
+	ret = tc_ctr_prng_init(&drbg->ctx,
 			       (uint8_t *)&entropy,
 			       sizeof(entropy),
 			       (uint8_t *)drbg_seed,
@@ -100,31 +118,25 @@ static int ctr_drbg_initialize(void)
 
 #endif
 
+	drbg->initialized = true;
+
 	return 0;
 }
 
-
-int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+static int ctr_drbg_generate(struct ctr_drbg *drbg, void *dst, size_t outlen)
 {
 	int ret;
-	unsigned int key = irq_lock();
-
-	if (unlikely(!entropy_driver)) {
-		ret = ctr_drbg_initialize();
-		if (ret != 0) {
-			return ret;
-		}
-	}
 
 #if defined(CONFIG_MBEDTLS)
 
-	ret = mbedtls_ctr_drbg_random(&ctr_ctx, (unsigned char *)dst, outlen);
+	ret = mbedtls_ctr_drbg_random(&drbg->ctx, (unsigned char *)dst,
+				      outlen);
 
 #elif defined(CONFIG_TINYCRYPT)
 
 	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
 
-	ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, (uint8_t *)dst, outlen);
+	ret = tc_ctr_prng_generate(&drbg->ctx, 0, 0, (uint8_t *)dst, outlen);
 
 	if (ret == TC_CRYPTO_SUCCESS) {
 		ret = 0;
@@ -133,13 +145,13 @@ int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 		entropy_get_entropy(entropy_driver,
 				    (void *)&entropy, sizeof(entropy));
 
-		ret = tc_ctr_prng_reseed(&ctr_ctx,
+		ret = tc_ctr_prng_reseed(&drbg->ctx,
 					entropy,
 					sizeof(entropy),
 					drbg_seed,
 					sizeof(drbg_seed));
 
-		ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0,
+		ret = tc_ctr_prng_generate(&drbg->ctx, 0, 0,
 					   (uint8_t *)dst, outlen);
 
 		ret = (ret == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
@@ -147,7 +159,64 @@ int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 		ret = -EIO;
 	}
 #endif
-	irq_unlock(key);
+
+	return ret;
+}
+
+/* Short requests are served from the output generated ahead, which is
+ * regenerated as a whole when too little of it is left. The bytes handed
+ * out are wiped from the buffer.
+ */
+static int ctr_drbg_get(struct ctr_drbg *drbg, void *dst, uint32_t outlen)
+{
+#if BUFFER_SIZE > 0
+	uint8_t *src;
+	int ret;
+
+	if (outlen > BUFFER_SIZE) {
+		return ctr_drbg_generate(drbg, dst, outlen);
+	}
+
+	if (outlen > drbg->buf_len) {
+		ret = ctr_drbg_generate(drbg, drbg->buf, sizeof(drbg->buf));
+		if (ret != 0) {
+			drbg->buf_len = 0U;
+			return ret;
+		}
+
+		drbg->buf_len = sizeof(drbg->buf);
+	}
+
+	src = &drbg->buf[sizeof(drbg->buf) - drbg->buf_len];
+	memcpy(dst, src, outlen);
+	(void)memset(src, 0, outlen);
+	drbg->buf_len -= outlen;
+
+	return 0;
+#else
+	return ctr_drbg_generate(drbg, dst, outlen);
+#endif
+}
+
+int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+{
+	struct ctr_drbg *drbg;
+	unsigned int key;
+	int ret = 0;
+
+	/* Locking the local interrupts also keeps the thread on its CPU */
+	key = arch_irq_lock();
+	drbg = &drbgs[arch_curr_cpu()->id];
+
+	if (unlikely(!drbg->initialized)) {
+		ret = ctr_drbg_initialize(drbg);
+	}
+
+	if (ret == 0) {
+		ret = ctr_drbg_get(drbg, dst, outlen);
+	}
+
+	arch_irq_unlock(key);
 
 	return ret;
 }
@@ -15,9 +15,25 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+/* Latest record of a settings name */
+struct settings_fcb_index_entry {
+	struct fcb_entry loc;
+	uint32_t name_hash;
+	uint32_t root_hash; /* hash of the first component of the name */
+};
+#endif
+
 struct settings_fcb {
 	struct settings_store cf_store;
 	struct fcb cf_fcb;
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	/* Index entries in storage order, built on first use */
+	struct settings_fcb_index_entry cf_index[CONFIG_SETTINGS_FCB_INDEX_SIZE];
+	uint16_t cf_index_cnt;
+	bool cf_index_built;
+	bool cf_index_full;
+#endif
 };
 
 extern int settings_fcb_src(struct settings_fcb *cf);
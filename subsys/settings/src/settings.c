@@ -239,7 +239,7 @@ int settings_commit_subtree(const char *subtree)
 	int rc;
 	int rc2;
 
-	rc = 0;
+	rc = settings_flush();
 
 	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (subtree && !settings_name_steq(ch->name, subtree, NULL)) {
@@ -26,6 +26,9 @@ static int settings_fcb_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+static void settings_fcb_index_reset(struct settings_fcb *cf);
+#endif
 
 static const struct settings_store_itf settings_fcb_itf = {
 	.csi_load = settings_fcb_load,
@@ -64,6 +67,9 @@ int settings_fcb_src(struct settings_fcb *cf)
 		}
 	}
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_reset(cf);
+#endif
 	cf->cf_store.cs_itf = &settings_fcb_itf;
 	settings_src_register(&cf->cf_store);
 
@@ -72,6 +78,9 @@ int settings_fcb_src(struct settings_fcb *cf)
 
 int settings_fcb_dst(struct settings_fcb *cf)
 {
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_reset(cf);
+#endif
 	cf->cf_store.cs_itf = &settings_fcb_itf;
 	settings_dst_register(&cf->cf_store);
 
@@ -121,6 +130,201 @@ static int read_entry_len(const struct fcb_entry_ctx *entry_ctx, off_t off)
 	return entry_ctx->loc.fe_data_len - off;
 }
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+/* FNV-1a hash of a name, or of its first component if root is set */
+static uint32_t settings_fcb_hash(const char *name, bool root)
+{
+	uint32_t hash = 2166136261U;
+
+	while ((*name != '\0') && (*name != SETTINGS_NAME_END) &&
+	       !(root && (*name == SETTINGS_NAME_SEPARATOR))) {
+		hash = (hash ^ (uint8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void settings_fcb_index_reset(struct settings_fcb *cf)
+{
+	cf->cf_index_cnt = 0U;
+	cf->cf_index_built = false;
+	cf->cf_index_full = false;
+}
+
+/* Find the entry of a name, names sharing a hash are told apart by reading
+ * them back from flash.
+ */
+static struct settings_fcb_index_entry *
+settings_fcb_index_find(struct settings_fcb *cf, const char *name,
+			uint32_t hash)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		.fap = cf->cf_fcb.fap
+	};
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t name2_len;
+
+	for (uint16_t i = 0; i < cf->cf_index_cnt; i++) {
+		struct settings_fcb_index_entry *entry = &cf->cf_index[i];
+
+		if (entry->name_hash != hash) {
+			continue;
+		}
+
+		entry_ctx.loc = entry->loc;
+		if (settings_line_name_read(name2, sizeof(name2), &name2_len,
+					    &entry_ctx)) {
+			continue;
+		}
+		name2[name2_len] = '\0';
+
+		if (!strcmp(name, name2)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Record loc as the latest record of name, the new entry goes last to keep
+ * the entries in storage order.
+ */
+static void settings_fcb_index_update(struct settings_fcb *cf,
+				      const char *name,
+				      const struct fcb_entry *loc)
+{
+	struct settings_fcb_index_entry *entry;
+	uint32_t hash;
+
+	if (!cf->cf_index_built || cf->cf_index_full) {
+		return;
+	}
+
+	hash = settings_fcb_hash(name, false);
+	entry = settings_fcb_index_find(cf, name, hash);
+	if (entry != NULL) {
+		cf->cf_index_cnt--;
+		memmove(entry, entry + 1,
+			(uint8_t *)&cf->cf_index[cf->cf_index_cnt] -
+			(uint8_t *)entry);
+	} else if (cf->cf_index_cnt == ARRAY_SIZE(cf->cf_index)) {
+		LOG_WRN("Settings index full, scanning FCB instead");
+		cf->cf_index_full = true;
+		return;
+	}
+
+	entry = &cf->cf_index[cf->cf_index_cnt++];
+	entry->loc = *loc;
+	entry->name_hash = hash;
+	entry->root_hash = settings_fcb_hash(name, true);
+}
+
+/* Drop the entries of a sector which is about to be erased */
+static void settings_fcb_index_sector_drop(struct settings_fcb *cf,
+					   const struct flash_sector *sector)
+{
+	uint16_t cnt = 0U;
+
+	for (uint16_t i = 0; i < cf->cf_index_cnt; i++) {
+		if (cf->cf_index[i].loc.fe_sector != sector) {
+			cf->cf_index[cnt++] = cf->cf_index[i];
+		}
+	}
+
+	cf->cf_index_cnt = cnt;
+}
+
+/* Build the index by walking through the FCB once, returns true if it can be
+ * used.
+ */
+static bool settings_fcb_index_ready(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		{.fe_sector = NULL, .fe_elem_off = 0},
+		.fap = cf->cf_fcb.fap
+	};
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t name_len;
+
+	if (cf->cf_index_built || cf->cf_index_full) {
+		return !cf->cf_index_full;
+	}
+
+	cf->cf_index_built = true;
+	while (!cf->cf_index_full &&
+	       fcb_getnext(&cf->cf_fcb, &entry_ctx.loc) == 0) {
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx)) {
+			continue;
+		}
+		name[name_len] = '\0';
+
+		settings_fcb_index_update(cf, name, &entry_ctx.loc);
+	}
+
+	return !cf->cf_index_full;
+}
+
+/* Check the latest record of a name against the value to save, returns false
+ * if the index cannot be used.
+ */
+static bool settings_fcb_index_dup_check(struct settings_fcb *cf,
+					 struct settings_line_dup_check_arg *cdca)
+{
+	struct settings_fcb_index_entry *entry;
+	struct fcb_entry_ctx entry_ctx = {
+		.fap = cf->cf_fcb.fap
+	};
+
+	if (!cdca->name || !settings_fcb_index_ready(cf)) {
+		return false;
+	}
+
+	entry = settings_fcb_index_find(cf, cdca->name,
+					settings_fcb_hash(cdca->name, false));
+	if (entry != NULL) {
+		entry_ctx.loc = entry->loc;
+		settings_line_dup_check_cb(cdca->name, &entry_ctx,
+					   strlen(cdca->name) + 1, cdca);
+	}
+
+	return true;
+}
+
+/* Load the latest records of the names in subtree, records of other top level
+ * names are skipped without reading them.
+ */
+static void settings_fcb_index_load(struct settings_fcb *cf, line_load_cb cb,
+				    void *cb_arg, const char *subtree)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		.fap = cf->cf_fcb.fap
+	};
+	uint32_t root_hash = subtree ? settings_fcb_hash(subtree, true) : 0U;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t name_len;
+
+	for (uint16_t i = 0; i < cf->cf_index_cnt; i++) {
+		if (subtree && (cf->cf_index[i].root_hash != root_hash)) {
+			continue;
+		}
+
+		entry_ctx.loc = cf->cf_index[i].loc;
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx)) {
+			LOG_ERR("Failed to load line name");
+			continue;
+		}
+		name[name_len] = '\0';
+
+		/* skip deletion records */
+		if (read_entry_len(&entry_ctx, name_len + 1)) {
+			cb(name, &entry_ctx, name_len + 1, cb_arg);
+		}
+	}
+}
+#endif
+
 static int settings_fcb_load_priv(struct settings_store *cs,
 				  line_load_cb cb,
 				  void *cb_arg,
@@ -167,6 +371,15 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 static int settings_fcb_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	struct settings_fcb *cf = (struct settings_fcb *)cs;
+
+	if (settings_fcb_index_ready(cf)) {
+		settings_fcb_index_load(cf, settings_line_load_cb, (void *)arg,
+					arg ? arg->subtree : NULL);
+		return 0;
+	}
+#endif
 	return settings_fcb_load_priv(
 		cs,
 		settings_line_load_cb,
@@ -197,10 +410,16 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 	int rc;
 	struct fcb_entry_ctx loc1;
 	struct fcb_entry_ctx loc2;
-	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
+	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
 	int copy;
 	uint8_t rbs;
+	bool indexed = false;
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	const struct flash_sector *oldest = cf->cf_fcb.f_oldest;
+
+	indexed = settings_fcb_index_ready(cf);
+#endif
 
 	rc = fcb_append_to_scratch(&cf->cf_fcb);
 	if (rc) {
@@ -221,8 +440,8 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 
 		size_t val1_off;
 
-		rc = settings_line_name_read(name1, sizeof(name1), &val1_off,
-					     &loc1);
+		rc = settings_line_name_read(name1, sizeof(name1) - 1,
+					     &val1_off, &loc1);
 		if (rc) {
 			continue;
 		}
@@ -237,7 +456,20 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 		loc2 = loc1;
 		copy = 1;
 
-		while (fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0) {
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+		if (indexed) {
+			struct settings_fcb_index_entry *entry;
+
+			/* Copy the record only if it is the latest one. */
+			name1[val1_off] = '\0';
+			entry = settings_fcb_index_find(cf, name1,
+					settings_fcb_hash(name1, false));
+			copy = (entry != NULL) &&
+			       (entry->loc.fe_sector == loc1.loc.fe_sector) &&
+			       (entry->loc.fe_elem_off == loc1.loc.fe_elem_off);
+		}
+#endif
+		while (!indexed && fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0) {
 			size_t val2_off;
 
 			rc = settings_line_name_read(name2, sizeof(name2),
@@ -273,8 +505,18 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 
 		if (rc != 0) {
 			LOG_ERR("Failed to finish fcb_append (%d)", rc);
+			continue;
+		}
+
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+		if (indexed) {
+			settings_fcb_index_update(cf, name1, &loc2.loc);
 		}
+#endif
 	}
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_sector_drop(cf, oldest);
+#endif
 	rc = fcb_rotate(&cf->cf_fcb);
 
 	if (rc != 0) {
@@ -341,6 +583,12 @@ static int settings_fcb_save_priv(struct settings_store *cs, const char *name,
 			rc = i;
 		}
 	}
+
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	if (!rc) {
+		settings_fcb_index_update(cf, name, &loc.loc);
+	}
+#endif
 	return rc;
 }
 
@@ -348,6 +596,7 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len)
 {
 	struct settings_line_dup_check_arg cdca;
+	bool checked = false;
 
 	if (val_len > 0 && value == NULL) {
 		return -EINVAL;
@@ -360,7 +609,14 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
-	settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	checked = settings_fcb_index_dup_check((struct settings_fcb *)cs,
+					       &cdca);
+#endif
+	if (!checked) {
+		settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca,
+				       false);
+	}
 	if (cdca.is_dup == 1) {
 		return 0;
 	}
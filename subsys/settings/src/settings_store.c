@@ -54,6 +54,7 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+	(void)settings_flush();
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -81,6 +82,7 @@ int settings_load_subtree_direct(
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+	(void)settings_flush();
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -88,6 +90,106 @@ int settings_load_subtree_direct(
 	return 0;
 }
 
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+/* Value waiting to be written to the save destination, a free entry has an
+ * empty name.
+ */
+struct settings_wb_entry {
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint8_t val[CONFIG_SETTINGS_WRITE_BACK_VAL_LEN];
+	size_t val_len;
+};
+
+static struct settings_wb_entry settings_wb[CONFIG_SETTINGS_WRITE_BACK_ENTRIES];
+static struct k_delayed_work settings_wb_work;
+
+static void settings_wb_work_handler(struct k_work *work)
+{
+	int rc;
+
+	rc = settings_flush();
+	if (rc) {
+		LOG_ERR("Failed to flush settings (%d)", rc);
+	}
+}
+
+/*
+ * Keep the value until the write-back delay expires, later saves of the same
+ * name replace it. Returns -ENOMEM if the value has to be written through.
+ */
+static int settings_wb_save(const char *name, const void *value,
+			    size_t val_len)
+{
+	struct settings_wb_entry *free_entry = NULL;
+	struct settings_wb_entry *entry = NULL;
+
+	if ((val_len > sizeof(entry->val)) ||
+	    (strlen(name) >= sizeof(entry->name))) {
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(settings_wb); i++) {
+		if (settings_wb[i].name[0] == '\0') {
+			if (!free_entry) {
+				free_entry = &settings_wb[i];
+			}
+		} else if (!strcmp(settings_wb[i].name, name)) {
+			entry = &settings_wb[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		if (!free_entry) {
+			return -ENOMEM;
+		}
+
+		entry = free_entry;
+		strcpy(entry->name, name);
+		k_delayed_work_submit(&settings_wb_work,
+				K_MSEC(CONFIG_SETTINGS_WRITE_BACK_DELAY));
+	}
+
+	if (val_len) {
+		memcpy(entry->val, value, val_len);
+	}
+	entry->val_len = val_len;
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
+
+int settings_flush(void)
+{
+	int rc = 0;
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+	struct settings_store *cs;
+	int rc2;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	cs = settings_save_dst;
+	for (int i = 0; cs && i < ARRAY_SIZE(settings_wb); i++) {
+		struct settings_wb_entry *entry = &settings_wb[i];
+
+		if (entry->name[0] == '\0') {
+			continue;
+		}
+
+		rc2 = cs->cs_itf->csi_save(cs, entry->name,
+					   entry->val_len ? entry->val : NULL,
+					   entry->val_len);
+		if (!rc) {
+			rc = rc2;
+		}
+		entry->name[0] = '\0';
+	}
+
+	k_mutex_unlock(&settings_lock);
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
+	return rc;
+}
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -103,6 +205,13 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+	if (name && settings_wb_save(name, value, val_len) == 0) {
+		k_mutex_unlock(&settings_lock);
+		return 0;
+	}
+#endif
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -152,6 +261,11 @@ int settings_save(void)
 	}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
+	rc2 = settings_flush();
+	if (!rc) {
+		rc = rc2;
+	}
+
 	if (cs->cs_itf->csi_save_end) {
 		cs->cs_itf->csi_save_end(cs);
 	}
@@ -161,4 +275,7 @@ int settings_save(void)
 void settings_store_init(void)
 {
 	sys_slist_init(&settings_load_srcs);
+#ifdef CONFIG_SETTINGS_WRITE_BACK
+	k_delayed_work_init(&settings_wb_work, settings_wb_work_handler);
+#endif
 }
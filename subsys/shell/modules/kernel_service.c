@@ -74,6 +74,22 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      thread->base.timeout.dticks);
 	shell_print(shell, "\tstate: %s", k_thread_state_str(thread));
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	k_thread_runtime_stats_t rt_stats_thread;
+	k_thread_runtime_stats_t rt_stats_all;
+
+	if ((k_thread_runtime_stats_get(thread, &rt_stats_thread) == 0) &&
+	    (k_thread_runtime_stats_all_get(&rt_stats_all) == 0)) {
+		pcnt = (rt_stats_all.execution_cycles != 0U) ?
+			(unsigned int)((rt_stats_thread.execution_cycles * 100U) /
+				       rt_stats_all.execution_cycles) : 0U;
+
+		shell_print(shell, "\tTotal execution cycles: %llu (%u %%)",
+			    (unsigned long long)rt_stats_thread.execution_cycles,
+			    pcnt);
+	}
+#endif
+
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
 		shell_print(shell,
@@ -171,6 +187,35 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+static int cmd_kernel_heap(const struct shell *shell,
+			   size_t argc, char **argv)
+{
+	bool reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+	struct sys_memory_stats stats;
+
+	shell_print(shell, "%-20s %10s %10s %10s %10s", "heap",
+		    "free", "allocated", "max alloc", "largest");
+
+	Z_STRUCT_SECTION_FOREACH(k_heap, h) {
+		if (k_heap_runtime_stats_get(h, &stats) != 0) {
+			continue;
+		}
+
+		shell_print(shell, "%-20p %10zu %10zu %10zu %10zu", h,
+			    stats.free_bytes, stats.allocated_bytes,
+			    stats.max_allocated_bytes,
+			    stats.largest_free_bytes);
+
+		if (reset) {
+			(void)k_heap_runtime_stats_reset_max(h);
+		}
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -206,6 +251,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
 	SHELL_CMD(threads, NULL, "List kernel threads.", cmd_kernel_threads),
+#endif
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	SHELL_CMD_ARG(heap, NULL,
+		      "Heap usage statistics; 'reset' clears the high-water marks.",
+		      cmd_kernel_heap, 1, 1),
 #endif
 	SHELL_CMD(uptime, NULL, "Kernel uptime.", cmd_kernel_uptime),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
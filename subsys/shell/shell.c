@@ -311,6 +311,18 @@ static void find_completion_candidates(const struct shell *shell,
 	*longest = 0U;
 	*cnt = 0;
 
+	if (cmd == NULL) {
+		/* Root commands are sorted, the candidates are contiguous. */
+		*cnt = shell_root_cmd_range(incompl_cmd, incompl_cmd_len,
+					    first_idx);
+		for (idx = *first_idx; idx < *first_idx + *cnt; idx++) {
+			candidate = shell_cmd_get(NULL, idx, NULL);
+			*longest = Z_MAX(strlen(candidate->syntax), *longest);
+		}
+
+		return;
+	}
+
 	while ((candidate = shell_cmd_get(cmd, idx, &dloc)) != NULL) {
 		bool is_candidate;
 		is_candidate = is_completion_candidate(candidate->syntax,
@@ -508,6 +520,8 @@ static int exec_cmd(const struct shell *shell, size_t argc, const char **argv,
 	}
 
 	if (!ret_val) {
+		/* Send the echoed command before it runs */
+		transport_buffer_flush(shell);
 		flag_cmd_ctx_set(shell, true);
 		/* Unlock thread mutex in case command would like to borrow
 		 * shell context to other thread to avoid mutex deadlock.
@@ -1256,6 +1270,7 @@ void shell_thread(void *shell_handle, void *arg_log_backend,
 					    shell_log_process);
 		}
 
+		transport_buffer_flush(shell);
 		k_mutex_unlock(&shell->ctx->wr_mtx);
 	}
 }
@@ -1401,7 +1416,13 @@ void shell_vfprintf(const struct shell *shell, enum shell_vt100_color color,
 	if (!flag_cmd_ctx_get(shell)) {
 		shell_print_prompt_and_cmd(shell);
 	}
-	transport_buffer_flush(shell);
+	/* Without autoflush, the output of a command is sent when the buffer
+	 * is full or when the command returns.
+	 */
+	if (IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH) ||
+	    !flag_cmd_ctx_get(shell)) {
+		transport_buffer_flush(shell);
+	}
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 }
 
@@ -1524,6 +1545,7 @@ int shell_execute_cmd(const struct shell *shell, const char *cmd)
 
 	k_mutex_lock(&shell->ctx->wr_mtx, K_FOREVER);
 	ret_val = execute(shell);
+	transport_buffer_flush(shell);
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 
 	return ret_val;
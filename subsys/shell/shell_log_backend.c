@@ -11,6 +11,11 @@
 
 int shell_log_backend_output_func(uint8_t *data, size_t length, void *ctx)
 {
+	if (!IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH)) {
+		/* Keep the pending shell output in order */
+		transport_buffer_flush((const struct shell *)ctx);
+	}
+
 	shell_print_stream(ctx, data, length);
 	return length;
 }
@@ -236,6 +236,18 @@ static void reprint_from_cursor(const struct shell *shell, uint16_t diff,
 	shell_op_cursor_move(shell, -diff);
 }
 
+/* Edits inside a line which does not wrap can be done by the terminal with
+ * the VT100 insert and delete character sequences instead of reprinting the
+ * rest of the command.
+ */
+static bool line_edit_in_place(const struct shell *shell)
+{
+	return IS_ENABLED(CONFIG_SHELL_VT100_LINE_EDIT) &&
+	       flag_echo_get(shell) &&
+	       ((shell_strlen(shell->ctx->prompt) + shell->ctx->cmd_buff_len) <
+		shell->ctx->vt100_ctx.cons.terminal_wid);
+}
+
 static void data_insert(const struct shell *shell, const char *data, uint16_t len)
 {
 	uint16_t after = shell->ctx->cmd_buff_len - shell->ctx->cmd_buff_pos;
@@ -255,6 +267,13 @@ static void data_insert(const struct shell *shell, const char *data, uint16_t le
 		return;
 	}
 
+	if ((after != 0U) && line_edit_in_place(shell)) {
+		shell_raw_fprintf(shell->fprintf_ctx, "\033[%d@%.*s",
+				  len, len, data);
+		shell->ctx->cmd_buff_pos += len;
+		return;
+	}
+
 	reprint_from_cursor(shell, after, false);
 }
 
@@ -297,13 +316,21 @@ void shell_op_char_delete(const struct shell *shell)
 {
 	uint16_t diff = shell->ctx->cmd_buff_len - shell->ctx->cmd_buff_pos;
 	char *str = &shell->ctx->cmd_buff[shell->ctx->cmd_buff_pos];
+	bool in_place;
 
 	if (diff == 0U) {
 		return;
 	}
 
+	in_place = line_edit_in_place(shell);
 	memmove(str, str + 1, diff);
 	--shell->ctx->cmd_buff_len;
+
+	if (in_place) {
+		shell_raw_fprintf(shell->fprintf_ctx, "\033[1P");
+		return;
+	}
+
 	reprint_from_cursor(shell, --diff, true);
 }
 
@@ -227,14 +227,37 @@ static inline uint32_t shell_root_cmd_count(void)
 				sizeof(struct shell_cmd_entry);
 }
 
+/* Index of the first root command not lower than the first len characters
+ * of syntax. Root commands are placed in sections named after their syntax
+ * and sorted by name by the linker, so the table can be searched.
+ */
+static size_t shell_root_cmd_lower_bound(const char *syntax, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = shell_root_cmd_count();
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const char *cmd_syntax = shell_root_cmd_get(mid)->u.entry->syntax;
+
+		if (strncmp(cmd_syntax, syntax, len) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
 /* Function returning pointer to parent command matching requested syntax. */
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax)
 {
-	const size_t cmd_count = shell_root_cmd_count();
+	size_t idx = shell_root_cmd_lower_bound(syntax, SIZE_MAX);
 	const struct shell_cmd_entry *cmd;
 
-	for (size_t cmd_idx = 0; cmd_idx < cmd_count; ++cmd_idx) {
-		cmd = shell_root_cmd_get(cmd_idx);
+	if (idx < shell_root_cmd_count()) {
+		cmd = shell_root_cmd_get(idx);
 		if (strcmp(syntax, cmd->u.entry->syntax) == 0) {
 			return cmd->u.entry;
 		}
@@ -243,6 +266,21 @@ const struct shell_static_entry *shell_root_cmd_find(const char *syntax)
 	return NULL;
 }
 
+size_t shell_root_cmd_range(const char *prefix, size_t len, size_t *first)
+{
+	const size_t cmd_count = shell_root_cmd_count();
+	size_t idx = shell_root_cmd_lower_bound(prefix, len);
+
+	*first = idx;
+	while ((idx < cmd_count) &&
+	       (strncmp(shell_root_cmd_get(idx)->u.entry->syntax,
+			prefix, len) == 0)) {
+		idx++;
+	}
+
+	return idx - *first;
+}
+
 const struct shell_static_entry *shell_cmd_get(
 					const struct shell_static_entry *parent,
 					size_t idx,
@@ -291,6 +329,10 @@ const struct shell_static_entry *shell_find_cmd(
 	const struct shell_static_entry *entry;
 	size_t idx = 0;
 
+	if (parent == NULL) {
+		return shell_root_cmd_find(cmd_str);
+	}
+
 	while ((entry = shell_cmd_get(parent, idx++, dloc)) != NULL) {
 		if (strcmp(cmd_str, entry->syntax) == 0) {
 			return entry;
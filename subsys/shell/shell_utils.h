@@ -82,6 +82,11 @@ int shell_command_add(char *buff, uint16_t *buff_len,
 
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax);
 
+/* Returns the number of root commands starting with the first len characters
+ * of prefix and sets first to the index of the first of them.
+ */
+size_t shell_root_cmd_range(const char *prefix, size_t len, size_t *first);
+
 void shell_spaces_trim(char *str);
 
 static inline void transport_buffer_flush(const struct shell *shell)
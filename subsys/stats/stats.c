@@ -9,12 +9,111 @@
 #include <errno.h>
 #include <zephyr/types.h>
 #include <stats/stats.h>
+#include <sys/util.h>
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
 
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+#ifdef CONFIG_STATS_PER_CPU
+static uint8_t __aligned(8) stats_shard_pool[CONFIG_STATS_PER_CPU_POOL_SIZE];
+static size_t stats_shard_used;
+static struct k_spinlock stats_shard_lock;
+
+static uint8_t *
+stats_shard_alloc(size_t size)
+{
+	uint8_t *shards;
+	k_spinlock_key_t key;
+
+	size = ROUND_UP(size, 8);
+
+	key = k_spin_lock(&stats_shard_lock);
+	if (stats_shard_used + size > sizeof(stats_shard_pool)) {
+		shards = NULL;
+	} else {
+		shards = stats_shard_pool + stats_shard_used;
+		stats_shard_used += size;
+	}
+	k_spin_unlock(&stats_shard_lock, key);
+
+	return shards;
+}
+
+static uint64_t
+stats_entry_get(const uint8_t *entry, uint8_t size)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		return *(const uint16_t *)entry;
+	case sizeof(uint32_t):
+		return *(const uint32_t *)entry;
+	default:
+		return *(const uint64_t *)entry;
+	}
+}
+
+static void
+stats_entry_set(uint8_t *entry, uint8_t size, uint64_t val)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		*(uint16_t *)entry = val;
+		break;
+	case sizeof(uint32_t):
+		*(uint32_t *)entry = val;
+		break;
+	default:
+		*(uint64_t *)entry = val;
+		break;
+	}
+}
+
+/**
+ * Sets the entries of a group to the sum of their per-CPU copies.  The
+ * entries wrap around as the counters themselves do.
+ */
+static void
+stats_fold(struct stats_hdr *hdr)
+{
+	size_t stride = hdr->s_size * hdr->s_cnt;
+	uint8_t *entries = (uint8_t *)hdr + sizeof(*hdr);
+	uint64_t sum;
+
+	if (hdr->s_shards == NULL) {
+		return;
+	}
+
+	for (size_t off = 0; off < stride; off += hdr->s_size) {
+		uint8_t *shard = hdr->s_shards + off;
+
+		sum = 0U;
+		for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			sum += stats_entry_get(shard, hdr->s_size);
+			shard += stride;
+		}
+		stats_entry_set(entries + off, hdr->s_size, sum);
+	}
+}
+
+void
+z_stats_clear(struct stats_hdr *hdr, uint16_t off)
+{
+	size_t stride = hdr->s_size * hdr->s_cnt;
+
+	(void)memset((uint8_t *)hdr + off, 0, hdr->s_size);
+	if (hdr->s_shards == NULL) {
+		return;
+	}
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		(void)memset(hdr->s_shards + cpu * stride + off - sizeof(*hdr),
+			     0, hdr->s_size);
+	}
+}
+#endif /* CONFIG_STATS_PER_CPU */
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -100,6 +199,10 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 	int rc;
 	int i;
 
+#ifdef CONFIG_STATS_PER_CPU
+	stats_fold(hdr);
+#endif
+
 	for (i = 0; i < hdr->s_cnt; i++) {
 		name = stats_get_name(hdr, i);
 		if (name == NULL) {
@@ -139,6 +242,9 @@ stats_init(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
 #endif
+#ifdef CONFIG_STATS_PER_CPU
+	hdr->s_shards = stats_shard_alloc(size * cnt * CONFIG_MP_NUM_CPUS);
+#endif
 
 	stats_reset(hdr);
 }
@@ -281,4 +387,10 @@ void
 stats_reset(struct stats_hdr *hdr)
 {
 	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+#ifdef CONFIG_STATS_PER_CPU
+	if (hdr->s_shards != NULL) {
+		(void)memset(hdr->s_shards, 0,
+			     hdr->s_size * hdr->s_cnt * CONFIG_MP_NUM_CPUS);
+	}
+#endif
 }
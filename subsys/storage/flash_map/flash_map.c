@@ -198,6 +198,24 @@ int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 	return flash_read(dev, fa->fa_off + off, dst, len);
 }
 
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **ptr)
+{
+#if defined(CONFIG_FLASH_XIP_API)
+	const struct device *dev;
+
+	if (!is_in_flash_area_bounds(fa, off, len)) {
+		return -EINVAL;
+	}
+
+	dev = device_get_binding(fa->fa_dev_name);
+
+	return flash_get_xip_address(dev, fa->fa_off + off, len, ptr);
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
 		     size_t len)
 {
@@ -286,6 +304,7 @@ int flash_area_check_int_sha256(const struct flash_area *fa,
 	unsigned char hash[TC_SHA256_DIGEST_SIZE];
 	struct tc_sha256_state_struct sha;
 	const struct device *dev;
+	const void *data;
 	int to_read;
 	int pos;
 	int rc;
@@ -303,6 +322,16 @@ int flash_area_check_int_sha256(const struct flash_area *fa,
 		return -ESRCH;
 	}
 
+	/* Memory mapped flash is hashed in place */
+	if (flash_area_mmap(fa, fac->off, fac->clen, &data) == 0) {
+		if (tc_sha256_update(&sha, data,
+				     fac->clen) != TC_CRYPTO_SUCCESS) {
+			return -ESRCH;
+		}
+
+		goto final;
+	}
+
 	dev = device_get_binding(fa->fa_dev_name);
 	to_read = fac->rblen;
 
@@ -324,6 +353,7 @@ int flash_area_check_int_sha256(const struct flash_area *fa,
 		}
 	}
 
+final:
 	if (tc_sha256_final(hash, &sha) != TC_CRYPTO_SUCCESS) {
 		return -ESRCH;
 	}
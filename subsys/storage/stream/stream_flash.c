@@ -16,6 +16,12 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#define STREAM_FLASH_ASYNC_BYTES(ctx) ((ctx)->async_bytes)
+#else
+#define STREAM_FLASH_ASYNC_BYTES(ctx) 0
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -49,11 +55,209 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
+static int flash_verify(struct stream_flash_ctx *ctx, uint8_t *buf,
+			size_t len, size_t write_addr)
+{
+	int rc;
+
+	/* Invert to ensure that caller is able to discover a faulty
+	 * flash_read() even if no error code is returned.
+	 */
+	for (int i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
+	}
+
+	rc = flash_read(ctx->fdev, write_addr, buf, len);
+	if (rc != 0) {
+		LOG_ERR("flash read failed: %d", rc);
+		return rc;
+	}
+
+	rc = ctx->callback(buf, len, write_addr);
+	if (rc != 0) {
+		LOG_ERR("callback failed: %d", rc);
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+/* Plan the erase of the page holding the given offset after the next write,
+ * the page is then considered erased.
+ */
+static void flash_pre_erase_set(struct stream_flash_ctx *ctx, size_t off)
+{
+	struct flash_pages_info page;
+
+	ctx->erase_size = 0U;
+
+	if (off >= ctx->offset + ctx->available ||
+	    flash_get_page_info_by_offs(ctx->fdev, off, &page) != 0 ||
+	    ctx->last_erased_page_start_offset == page.start_offset) {
+		return;
+	}
+
+	ctx->last_erased_page_start_offset = page.start_offset;
+	ctx->erase_offset = page.start_offset;
+	ctx->erase_size = page.size;
+}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+
+static void flash_async_done(const struct device *dev,
+			     struct flash_async_req *req, int result)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(req, struct stream_flash_ctx, async_req);
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	/* The page holding the end of the next buffer is erased while the
+	 * caller fills it.
+	 */
+	if (result == 0 && ctx->erase_size != 0U) {
+		off_t off = ctx->erase_offset;
+		size_t size = ctx->erase_size;
+
+		ctx->erase_size = 0U;
+		result = flash_erase_async(dev, off, size, req);
+		if (result == 0) {
+			return;
+		}
+	}
+#endif
+
+	ctx->async_result = result;
+	k_sem_give(&ctx->async_done);
+}
+
+/* Wait for the buffer being written in the background, the bytes are
+ * accounted as written once they have reached the flash.
+ */
+static int flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	size_t write_addr = ctx->offset + ctx->bytes_written;
+	size_t len = ctx->async_bytes;
+	int rc;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	k_sem_take(&ctx->async_done, K_FOREVER);
+	flash_write_protection_set(ctx->fdev, true);
+	ctx->async_bytes = 0U;
+
+	rc = ctx->async_result;
+	if (rc != 0) {
+		LOG_ERR("flash_write error %d offset=0x%08zx", rc, write_addr);
+		return rc;
+	}
+
+	if (ctx->callback) {
+		rc = flash_verify(ctx, ctx->buf2, len, write_addr);
+	}
+
+	ctx->bytes_written += len;
+
+	return rc;
+}
+
+static int flash_sync_async(struct stream_flash_ctx *ctx)
+{
+	size_t write_addr;
+	uint8_t *buf;
+	int rc;
+
+	rc = flash_async_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+	write_addr = ctx->offset + ctx->bytes_written;
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	rc = stream_flash_erase_page(ctx, write_addr + ctx->buf_bytes - 1);
+	if (rc < 0) {
+		LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
+			rc, write_addr);
+		return rc;
+	}
+
+	flash_pre_erase_set(ctx, write_addr + ctx->buf_bytes +
+			    ctx->buf_len - 1);
+#endif
+
+	flash_write_protection_set(ctx->fdev, false);
+	rc = flash_write_async(ctx->fdev, write_addr, ctx->buf,
+			       ctx->buf_bytes, &ctx->async_req);
+	if (rc != 0) {
+		flash_write_protection_set(ctx->fdev, true);
+		LOG_ERR("flash_write_async error %d offset=0x%08zx", rc,
+			write_addr);
+		return rc;
+	}
+
+	/* Swap the buffers, the caller goes on with the idle one */
+	ctx->async_bytes = ctx->buf_bytes;
+	buf = ctx->buf;
+	ctx->buf = ctx->buf2;
+	ctx->buf2 = buf;
+	ctx->buf_bytes = 0U;
+
+	return 0;
+}
+
+int stream_flash_pipeline_enable(struct stream_flash_ctx *ctx)
+{
+	size_t half;
+
+	if (!ctx || !ctx->fdev) {
+		return -EFAULT;
+	}
+
+	if (ctx->pipelined) {
+		return 0;
+	}
+
+	if (ctx->buf_bytes != 0U) {
+		return -EBUSY;
+	}
+
+	half = ctx->buf_len / 2;
+	if (half == 0U || half % flash_get_write_block_size(ctx->fdev)) {
+		LOG_ERR("Half buffer is not aligned to minimal write-block-size");
+		return -EFAULT;
+	}
+
+	ctx->buf2 = ctx->buf + half;
+	ctx->buf_len = half;
+	ctx->async_bytes = 0U;
+	ctx->async_req.cb = flash_async_done;
+	ctx->async_req.signal = NULL;
+	k_sem_init(&ctx->async_done, 0, 1);
+	ctx->pipelined = true;
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 static int flash_sync(struct stream_flash_ctx *ctx)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (ctx->pipelined) {
+		return flash_sync_async(ctx);
+	}
+#endif
+
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 		if (ctx->buf_bytes == 0) {
@@ -80,24 +284,7 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	if (ctx->callback) {
-		/* Invert to ensure that caller is able to discover a faulty
-		 * flash_read() even if no error code is returned.
-		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
-		}
-
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
-		if (rc != 0) {
-			LOG_ERR("flash read failed: %d", rc);
-			return rc;
-		}
-
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
-		if (rc != 0) {
-			LOG_ERR("callback failed: %d", rc);
-		}
+		rc = flash_verify(ctx, ctx->buf, ctx->buf_bytes, write_addr);
 	}
 
 	ctx->bytes_written += ctx->buf_bytes;
@@ -119,7 +306,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (ctx->bytes_written + STREAM_FLASH_ASYNC_BYTES(ctx) +
+	    ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -145,6 +333,16 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		ctx->buf_bytes += len - processed;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	/* The padding below reads the flash following the data in flight */
+	if (flush && ctx->pipelined) {
+		rc = flash_async_wait(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+#endif
+
 	if (flush && ctx->buf_bytes > 0) {
 		fill_length = flash_get_write_block_size(ctx->fdev);
 		if (ctx->buf_bytes % fill_length) {
@@ -170,6 +368,11 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		}
 
 		rc = flash_sync(ctx);
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+		if (rc == 0 && ctx->pipelined) {
+			rc = flash_async_wait(ctx);
+		}
+#endif
 		ctx->bytes_written -= fill_length;
 	}
 
@@ -232,6 +435,10 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	ctx->pipelined = false;
+	ctx->async_bytes = 0U;
+#endif
 
 	return 0;
 }
@@ -9,6 +9,23 @@
 #include <kernel_internal.h>
 #include <ctf_top.h>
 
+static atomic_t ctf_filter = ATOMIC_INIT(CONFIG_TRACING_CTF_FILTER_DEFAULT);
+
+void ctf_trace_filter_set(uint32_t classes)
+{
+	(void)atomic_set(&ctf_filter, (atomic_val_t)classes);
+}
+
+uint32_t ctf_trace_filter_get(void)
+{
+	return (uint32_t)atomic_get(&ctf_filter);
+}
+
+/* Checked first, a filtered out event costs no name lookup or copy */
+static inline bool ctf_class_enabled(uint32_t class)
+{
+	return (atomic_get(&ctf_filter) & class) != 0;
+}
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
@@ -22,52 +39,179 @@ static void _get_thread_name(struct k_thread *thread,
 	}
 }
 
-void sys_trace_thread_switched_out(void)
+#ifdef CONFIG_TRACING_CTF_COMPACT
+#define CTF_COMPACT_EXTENDED 0xFF
+#define CTF_THREAD_REFS CONFIG_TRACING_CTF_COMPACT_THREADS
+
+static struct k_thread *thread_refs[CTF_THREAD_REFS];
+static uint8_t thread_ref_next;
+static uint32_t last_cycles;
+static uint64_t cycles;
+static uint64_t last_us;
+
+void ctf_compact_emit(uint8_t *epacket, uint32_t length)
 {
-	ctf_bounded_string_t name = { "unknown" };
-	struct k_thread *thread;
+	uint8_t id = epacket[CTF_COMPACT_HDR_ROOM];
+	unsigned int key;
+	uint32_t now;
+	uint64_t us;
+
+	key = irq_lock();
+
+	/* Extend the cycle counter, events are frequent enough to see it
+	 * wrap at most once between two of them.
+	 */
+	now = k_cycle_get_32();
+	cycles += (uint32_t)(now - last_cycles);
+	last_cycles = now;
+	us = k_cyc_to_us_floor64(cycles);
+
+	/* The header holds the low bits of the timestamp, the decoder
+	 * recovers the upper ones from the previous event as long as less
+	 * than a wrap of the field elapsed.
+	 */
+	if (us - last_us <= UINT16_MAX) {
+		uint16_t ts = (uint16_t)us;
+
+		epacket += CTF_COMPACT_HDR_ROOM - sizeof(ts);
+		length -= CTF_COMPACT_HDR_ROOM - sizeof(ts);
+		epacket[0] = id;
+		(void)memcpy(&epacket[1], &ts, sizeof(ts));
+	} else {
+		uint32_t ts = (uint32_t)us;
+
+		epacket[0] = CTF_COMPACT_EXTENDED;
+		epacket[1] = id;
+		(void)memcpy(&epacket[2], &ts, sizeof(ts));
+	}
+	last_us = us;
 
-	thread = k_current_get();
-	_get_thread_name(thread, &name);
+	tracing_format_raw_data(epacket, length);
 
-	ctf_top_thread_switched_out((uint32_t)(uintptr_t)thread, name);
+	irq_unlock(key);
 }
 
-void sys_trace_thread_switched_in(void)
+/*
+ * Threads are interned: the first event of a thread, or the first one after
+ * it was renamed, is preceded by a thread_name_set event which maps its
+ * index to its address and name.
+ */
+static ctf_thread_ref_t thread_ref_get(struct k_thread *thread, bool renamed)
 {
-	struct k_thread *thread;
 	ctf_bounded_string_t name = { "unknown" };
+	uint8_t ref, free_ref = CTF_THREAD_REFS;
+	unsigned int key;
+
+	key = irq_lock();
+
+	for (ref = 0U; ref < CTF_THREAD_REFS; ref++) {
+		if (thread_refs[ref] == thread) {
+			break;
+		}
+
+		if (thread_refs[ref] == NULL && free_ref == CTF_THREAD_REFS) {
+			free_ref = ref;
+		}
+	}
+
+	if (ref == CTF_THREAD_REFS) {
+		if (free_ref == CTF_THREAD_REFS) {
+			free_ref = thread_ref_next;
+			thread_ref_next = (free_ref + 1U) % CTF_THREAD_REFS;
+		}
+
+		ref = free_ref;
+		thread_refs[ref] = thread;
+		renamed = true;
+	}
+
+	if (renamed) {
+		_get_thread_name(thread, &name);
+		ctf_top_thread_name_set(ref, (uint32_t)(uintptr_t)thread, name);
+	}
+
+	irq_unlock(key);
+
+	return ref;
+}
+
+static void thread_ref_put(struct k_thread *thread)
+{
+	unsigned int key = irq_lock();
+	uint8_t ref;
+
+	for (ref = 0U; ref < CTF_THREAD_REFS; ref++) {
+		if (thread_refs[ref] == thread) {
+			thread_refs[ref] = NULL;
+			break;
+		}
+	}
 
-	thread = k_current_get();
-	_get_thread_name(thread, &name);
+	irq_unlock(key);
+}
+#else
+static ctf_thread_ref_t thread_ref_get(struct k_thread *thread, bool renamed)
+{
+	ctf_thread_ref_t ref = {
+		.id = (uint32_t)(uintptr_t)thread,
+		.name = { "unknown" },
+	};
+
+	ARG_UNUSED(renamed);
+
+	_get_thread_name(thread, &ref.name);
+
+	return ref;
+}
+
+static inline void thread_ref_put(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif /* CONFIG_TRACING_CTF_COMPACT */
+
+void sys_trace_thread_switched_out(void)
+{
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
+
+	ctf_top_thread_switched_out(thread_ref_get(k_current_get(), false));
+}
+
+void sys_trace_thread_switched_in(void)
+{
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	ctf_top_thread_switched_in((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_switched_in(thread_ref_get(k_current_get(), false));
 }
 
 void sys_trace_thread_priority_set(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	_get_thread_name(thread, &name);
-	ctf_top_thread_priority_set((uint32_t)(uintptr_t)thread,
-				    thread->base.prio, name);
+	ctf_top_thread_priority_set(thread_ref_get(thread, false),
+				    thread->base.prio);
 }
 
 void sys_trace_thread_create(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
+	ctf_thread_ref_t ref;
 
-	_get_thread_name(thread, &name);
-	ctf_top_thread_create(
-		(uint32_t)(uintptr_t)thread,
-		thread->base.prio,
-		name
-		);
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
+
+	ref = thread_ref_get(thread, false);
+	ctf_top_thread_create(ref);
 
 #if defined(CONFIG_THREAD_STACK_INFO)
 	ctf_top_thread_info(
-		(uint32_t)(uintptr_t)thread,
-		name,
+		ref,
 		thread->stack_info.start,
 		thread->stack_info.size
 		);
@@ -76,55 +220,59 @@ void sys_trace_thread_create(struct k_thread *thread)
 
 void sys_trace_thread_abort(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	_get_thread_name(thread, &name);
-	ctf_top_thread_abort((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_abort(thread_ref_get(thread, false));
+	thread_ref_put(thread);
 }
 
 void sys_trace_thread_suspend(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	_get_thread_name(thread, &name);
-	ctf_top_thread_suspend((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_suspend(thread_ref_get(thread, false));
 }
 
 void sys_trace_thread_resume(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
-
-	_get_thread_name(thread, &name);
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	ctf_top_thread_resume((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_resume(thread_ref_get(thread, false));
 }
 
 void sys_trace_thread_ready(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
-
-	_get_thread_name(thread, &name);
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	ctf_top_thread_ready((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_ready(thread_ref_get(thread, false));
 }
 
 void sys_trace_thread_pend(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	_get_thread_name(thread, &name);
-	ctf_top_thread_pend((uint32_t)(uintptr_t)thread, name);
+	ctf_top_thread_pend(thread_ref_get(thread, false));
 }
 
 void sys_trace_thread_info(struct k_thread *thread)
 {
 #if defined(CONFIG_THREAD_STACK_INFO)
-	ctf_bounded_string_t name = { "unknown" };
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
-	_get_thread_name(thread, &name);
 	ctf_top_thread_info(
-		(uint32_t)(uintptr_t)thread,
-		name,
+		thread_ref_get(thread, false),
 		thread->stack_info.start,
 		thread->stack_info.size
 		);
@@ -133,43 +281,69 @@ void sys_trace_thread_info(struct k_thread *thread)
 
 void sys_trace_thread_name_set(struct k_thread *thread)
 {
-	ctf_bounded_string_t name = { "unknown" };
-
-	_get_thread_name(thread, &name);
-	ctf_top_thread_name_set(
-		(uint32_t)(uintptr_t)thread,
-		name
-		);
+	if (!ctf_class_enabled(CTF_CLASS_THREAD)) {
+		return;
+	}
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+	/* Announcing the new name is the event itself */
+	(void)thread_ref_get(thread, true);
+#else
+	ctf_top_thread_name_set(thread_ref_get(thread, false));
+#endif
 }
 
 void sys_trace_isr_enter(void)
 {
+	if (!ctf_class_enabled(CTF_CLASS_ISR)) {
+		return;
+	}
+
 	ctf_top_isr_enter();
 }
 
 void sys_trace_isr_exit(void)
 {
+	if (!ctf_class_enabled(CTF_CLASS_ISR)) {
+		return;
+	}
+
 	ctf_top_isr_exit();
 }
 
 void sys_trace_isr_exit_to_scheduler(void)
 {
+	if (!ctf_class_enabled(CTF_CLASS_ISR)) {
+		return;
+	}
+
 	ctf_top_isr_exit_to_scheduler();
 }
 
 void sys_trace_idle(void)
 {
+	if (!ctf_class_enabled(CTF_CLASS_IDLE)) {
+		return;
+	}
+
 	ctf_top_idle();
 }
 
 void sys_trace_void(unsigned int id)
 {
+	if (!ctf_class_enabled(CTF_CLASS_CALL)) {
+		return;
+	}
+
 	ctf_top_void(id);
 }
 
 void sys_trace_semaphore_init(struct k_sem *sem)
 {
+	if (!ctf_class_enabled(CTF_CLASS_SEMAPHORE)) {
+		return;
+	}
+
 	ctf_top_semaphore_init(
 		(uint32_t)(uintptr_t)sem
 		);
@@ -177,6 +351,10 @@ void sys_trace_semaphore_init(struct k_sem *sem)
 
 void sys_trace_semaphore_take(struct k_sem *sem)
 {
+	if (!ctf_class_enabled(CTF_CLASS_SEMAPHORE)) {
+		return;
+	}
+
 	ctf_top_semaphore_take(
 		(uint32_t)(uintptr_t)sem
 		);
@@ -184,6 +362,10 @@ void sys_trace_semaphore_take(struct k_sem *sem)
 
 void sys_trace_semaphore_give(struct k_sem *sem)
 {
+	if (!ctf_class_enabled(CTF_CLASS_SEMAPHORE)) {
+		return;
+	}
+
 	ctf_top_semaphore_give(
 		(uint32_t)(uintptr_t)sem
 		);
@@ -191,6 +373,10 @@ void sys_trace_semaphore_give(struct k_sem *sem)
 
 void sys_trace_mutex_init(struct k_mutex *mutex)
 {
+	if (!ctf_class_enabled(CTF_CLASS_MUTEX)) {
+		return;
+	}
+
 	ctf_top_mutex_init(
 		(uint32_t)(uintptr_t)mutex
 		);
@@ -198,6 +384,10 @@ void sys_trace_mutex_init(struct k_mutex *mutex)
 
 void sys_trace_mutex_lock(struct k_mutex *mutex)
 {
+	if (!ctf_class_enabled(CTF_CLASS_MUTEX)) {
+		return;
+	}
+
 	ctf_top_mutex_lock(
 		(uint32_t)(uintptr_t)mutex
 		);
@@ -205,6 +395,10 @@ void sys_trace_mutex_lock(struct k_mutex *mutex)
 
 void sys_trace_mutex_unlock(struct k_mutex *mutex)
 {
+	if (!ctf_class_enabled(CTF_CLASS_MUTEX)) {
+		return;
+	}
+
 	ctf_top_mutex_unlock(
 		(uint32_t)(uintptr_t)mutex
 		);
@@ -212,5 +406,9 @@ void sys_trace_mutex_unlock(struct k_mutex *mutex)
 
 void sys_trace_end_call(unsigned int id)
 {
+	if (!ctf_class_enabled(CTF_CLASS_CALL)) {
+		return;
+	}
+
 	ctf_top_end_call(id);
 }
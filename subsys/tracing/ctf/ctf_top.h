@@ -32,16 +32,35 @@
 /*
  * Gather fields to a contiguous event-packet, then atomically emit.
  */
-#define CTF_GATHER_FIELDS(...)						    \
+#define CTF_GATHER_FIELDS_EMIT(_emit, ...)				    \
 {									    \
 	uint8_t epacket[0 MAP(CTF_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)];	    \
 	uint8_t *epacket_cursor = &epacket[0];				    \
 									    \
 	MAP(CTF_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)			    \
-	tracing_format_raw_data(epacket, sizeof(epacket));		    \
+	_emit(epacket, sizeof(epacket));				    \
 }
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#define CTF_GATHER_FIELDS(...) \
+	CTF_GATHER_FIELDS_EMIT(tracing_format_raw_data, __VA_ARGS__)
+
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+/*
+ * Room for the event header, which is only known once the event is
+ * stamped (see tsdl/metadata_compact). The event ID follows it.
+ */
+#define CTF_COMPACT_HDR_ROOM 5
+
+void ctf_compact_emit(uint8_t *epacket, uint32_t length);
+
+#define CTF_EVENT(...)							    \
+	{								    \
+		const uint8_t hdr_room[CTF_COMPACT_HDR_ROOM] = { 0 };	    \
+									    \
+		CTF_GATHER_FIELDS_EMIT(ctf_compact_emit, hdr_room,	    \
+				       __VA_ARGS__)			    \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)							    \
 	{								    \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(		    \
@@ -98,137 +117,131 @@ typedef struct {
 	char buf[CTF_MAX_STRING_LEN];
 } ctf_bounded_string_t;
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+/* Threads are referred to by an index, which a thread_name_set event maps
+ * to the thread ID and name.
+ */
+typedef uint8_t ctf_thread_ref_t;
+#else
+typedef struct {
+	uint32_t id;
+	ctf_bounded_string_t name;
+} __packed ctf_thread_ref_t;
+#endif
+
 
-static inline void ctf_top_thread_switched_out(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_switched_out(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_OUT),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_switched_in(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_switched_in(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_IN),
-		thread_id,
-		name
+		thread
 		);
 }
 
 static inline void ctf_top_thread_priority_set(
-	uint32_t thread_id,
-	int8_t prio,
-	ctf_bounded_string_t name)
+	ctf_thread_ref_t thread,
+	int8_t prio)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_PRIORITY_SET),
-		thread_id,
-		name,
+		thread,
 		prio
 		);
 }
 
-static inline void ctf_top_thread_create(
-	uint32_t thread_id,
-	int8_t prio,
-	ctf_bounded_string_t name
-	)
+static inline void ctf_top_thread_create(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_CREATE),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_abort(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_abort(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_ABORT),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_suspend(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_suspend(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SUSPEND),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_resume(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_resume(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_RESUME),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_ready(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_ready(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_READY),
-		thread_id,
-		name
+		thread
 		);
 }
 
-static inline void ctf_top_thread_pend(
-	uint32_t thread_id,
-	ctf_bounded_string_t name)
+static inline void ctf_top_thread_pend(ctf_thread_ref_t thread)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_PENDING),
-		thread_id,
-		name
+		thread
 		);
 }
 
 static inline void ctf_top_thread_info(
-	uint32_t thread_id,
-	ctf_bounded_string_t name,
+	ctf_thread_ref_t thread,
 	uint32_t stack_base,
 	uint32_t stack_size
 	)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_INFO),
-		thread_id,
-		name,
+		thread,
 		stack_base,
 		stack_size
 		);
 }
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
 static inline void ctf_top_thread_name_set(
+	ctf_thread_ref_t thread,
 	uint32_t thread_id,
 	ctf_bounded_string_t name
 	)
 {
 	CTF_EVENT(
 		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_NAME_SET),
+		thread,
 		thread_id,
 		name
 		);
 }
+#else
+static inline void ctf_top_thread_name_set(ctf_thread_ref_t thread)
+{
+	CTF_EVENT(
+		CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_NAME_SET),
+		thread
+		);
+}
+#endif
 
 static inline void ctf_top_isr_enter(void)
 {
@@ -15,6 +15,31 @@
 extern "C" {
 #endif
 
+/** @brief CTF event classes, see ctf_trace_filter_set(). */
+#define CTF_CLASS_THREAD    BIT(0)
+#define CTF_CLASS_ISR       BIT(1)
+#define CTF_CLASS_IDLE      BIT(2)
+#define CTF_CLASS_CALL      BIT(3)
+#define CTF_CLASS_SEMAPHORE BIT(4)
+#define CTF_CLASS_MUTEX     BIT(5)
+
+/**
+ * @brief Select the CTF event classes which are traced.
+ *
+ * Events of the other classes are dropped before being serialized. The
+ * classes traced at boot are set by CONFIG_TRACING_CTF_FILTER_DEFAULT.
+ *
+ * @param classes Mask of CTF_CLASS_* values.
+ */
+void ctf_trace_filter_set(uint32_t classes);
+
+/**
+ * @brief Get the CTF event classes which are traced.
+ *
+ * @return Mask of CTF_CLASS_* values.
+ */
+uint32_t ctf_trace_filter_get(void);
+
 void sys_trace_thread_switched_out(void);
 void sys_trace_thread_switched_in(void);
 void sys_trace_thread_priority_set(struct k_thread *thread);
@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <tracing/tracing_format.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +114,40 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+/**
+ * @brief Store a packet in the buffer of the current CPU.
+ *
+ * Only available with CONFIG_TRACING_PER_CPU_BUFFERS. No lock is taken,
+ * the packet is stored whole or not at all.
+ *
+ * @param tracing_data_array Pieces of the packet.
+ * @param count Number of pieces.
+ *
+ * @return true if the packet was stored, false if the buffer is full.
+ */
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array,
+			    uint32_t count);
+
+/**
+ * @brief Claim the oldest packet of all the CPU buffers.
+ *
+ * Packets are merged by the time at which they were stored.
+ *
+ * @param data Location where the address of the packet data is stored.
+ * @param length Location where the packet length (in bytes) is stored.
+ *
+ * @return Packet handle to pass to tracing_cpu_buffer_free(), NULL if
+ *         there is none.
+ */
+uint32_t *tracing_cpu_buffer_claim(uint8_t **data, uint32_t *length);
+
+/**
+ * @brief Free a packet returned by tracing_cpu_buffer_claim().
+ *
+ * @param packet Packet handle.
+ */
+void tracing_cpu_buffer_free(uint32_t *packet);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/mpsc_pbuf.h>
+#include <tracing_buffer.h>
+
+BUILD_ASSERT((CONFIG_TRACING_BUFFER_SIZE &
+	      (CONFIG_TRACING_BUFFER_SIZE - 1)) == 0,
+	     "CONFIG_TRACING_BUFFER_SIZE must be a power of 2");
+
+/* Each packet starts with the cycle count at which it was stored and with
+ * its length in bytes, the data follows.
+ */
+#define PACKET_HDR_WLEN 2
+
+static uint32_t cpu_buf[CONFIG_MP_NUM_CPUS]
+		       [CONFIG_TRACING_BUFFER_SIZE / sizeof(uint32_t)];
+static struct mpsc_pbuf_buffer cpu_pbuf[CONFIG_MP_NUM_CPUS];
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+
+static inline struct mpsc_pbuf_buffer *current_pbuf(void)
+{
+#if CONFIG_MP_NUM_CPUS > 1
+	/* The thread may migrate, the buffers accept any producer anyway */
+	return &cpu_pbuf[arch_curr_cpu()->id];
+#else
+	return &cpu_pbuf[0];
+#endif
+}
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+void tracing_buffer_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		mpsc_pbuf_init(&cpu_pbuf[i], cpu_buf[i],
+			       ARRAY_SIZE(cpu_buf[i]));
+	}
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (mpsc_pbuf_is_pending(&cpu_pbuf[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array,
+			    uint32_t count)
+{
+	struct mpsc_pbuf_buffer *pbuf = current_pbuf();
+	uint32_t length = 0U;
+	uint32_t wlen;
+	uint32_t *packet;
+	uint8_t *cursor;
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	wlen = PACKET_HDR_WLEN + DIV_ROUND_UP(length, sizeof(uint32_t));
+	packet = mpsc_pbuf_alloc(pbuf, wlen);
+	if (packet == NULL) {
+		return false;
+	}
+
+	packet[0] = k_cycle_get_32();
+	packet[1] = length;
+
+	cursor = (uint8_t *)&packet[PACKET_HDR_WLEN];
+	for (uint32_t i = 0; i < count; i++) {
+		(void)memcpy(cursor, tracing_data_array[i].data,
+			     tracing_data_array[i].length);
+		cursor += tracing_data_array[i].length;
+	}
+
+	mpsc_pbuf_commit(pbuf, packet, wlen);
+
+	return true;
+}
+
+uint32_t *tracing_cpu_buffer_claim(uint8_t **data, uint32_t *length)
+{
+	struct mpsc_pbuf_buffer *oldest = NULL;
+	uint32_t oldest_stamp = 0U;
+	uint32_t *packet;
+	uint32_t wlen;
+
+	/* Merge the buffers, the packet stored first comes out first */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		packet = mpsc_pbuf_peek(&cpu_pbuf[i], &wlen);
+		if (packet == NULL) {
+			continue;
+		}
+
+		if (oldest == NULL ||
+		    (int32_t)(packet[0] - oldest_stamp) < 0) {
+			oldest = &cpu_pbuf[i];
+			oldest_stamp = packet[0];
+		}
+	}
+
+	if (oldest == NULL) {
+		return NULL;
+	}
+
+	packet = mpsc_pbuf_claim(oldest, &wlen);
+	*data = (uint8_t *)&packet[PACKET_HDR_WLEN];
+	*length = packet[1];
+
+	return packet;
+}
+
+void tracing_cpu_buffer_free(uint32_t *packet)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (PART_OF_ARRAY(cpu_buf[i], packet)) {
+			mpsc_pbuf_free(&cpu_pbuf[i], packet);
+			return;
+		}
+	}
+}
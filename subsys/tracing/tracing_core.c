@@ -45,6 +45,54 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+static uint8_t tracing_batch[CONFIG_TRACING_PER_CPU_BATCH_SIZE];
+
+/* Drain the CPU buffers in time order, packets are passed to the backend
+ * in batches.
+ */
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	uint32_t batch_length = 0U;
+	uint32_t *packet;
+	uint8_t *data;
+	uint32_t length;
+
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		packet = tracing_cpu_buffer_claim(&data, &length);
+		if (packet == NULL) {
+			if (batch_length != 0U) {
+				tracing_buffer_handle(tracing_batch,
+						      batch_length);
+				batch_length = 0U;
+			}
+
+			/* Wake up periodically as well, so that a capture
+			 * keeps streaming whatever triggered the thread.
+			 */
+			(void)k_sem_take(&tracing_thread_sem,
+				K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD));
+			continue;
+		}
+
+		if (batch_length + length > sizeof(tracing_batch)) {
+			tracing_buffer_handle(tracing_batch, batch_length);
+			batch_length = 0U;
+		}
+
+		if (length > sizeof(tracing_batch)) {
+			tracing_buffer_handle(data, length);
+		} else {
+			memcpy(&tracing_batch[batch_length], data, length);
+			batch_length += length;
+		}
+
+		tracing_cpu_buffer_free(packet);
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -68,6 +116,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
@@ -8,6 +8,65 @@
 #include <tracing_buffer.h>
 #include <tracing_format_common.h>
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#include <sys/printk.h>
+
+static void packet_put(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	bool before_put_is_empty = tracing_buffer_is_empty();
+
+	if (tracing_cpu_buffer_put(tracing_data_array, count)) {
+		tracing_trigger_output(before_put_is_empty);
+	} else {
+		tracing_packet_drop_handle();
+	}
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	uint8_t buf[CONFIG_TRACING_PACKET_MAX_SIZE];
+	tracing_data_t tracing_data = {
+		.data = buf,
+	};
+	va_list args;
+	int length;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+	length = vsnprintk((char *)buf, sizeof(buf), str, args);
+	va_end(args);
+
+	/* Longer strings are truncated, the terminator is not sent */
+	tracing_data.length = CLAMP(length, 0, (int)sizeof(buf) - 1);
+	packet_put(&tracing_data, 1);
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	tracing_data_t tracing_data = {
+		.data = data,
+		.length = length,
+	};
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	packet_put(&tracing_data, 1);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	packet_put(tracing_data_array, count);
+}
+#else
 void tracing_format_string(const char *str, ...)
 {
 	va_list args;
@@ -72,3 +131,4 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 		tracing_packet_drop_handle();
 	}
 }
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
@@ -17,6 +17,7 @@
 #include <usb_descriptor.h>
 #include <usb/usbstruct.h>
 #include <usb/class/usb_audio.h>
+#include <drivers/i2s.h>
 #include "usb_audio_internal.h"
 
 #include <sys/byteorder.h>
@@ -45,6 +46,22 @@ struct usb_audio_dev_data {
 
 	bool rx_enable;
 	bool tx_enable;
+
+	/* Feedback endpoint index in the endpoint table, 0 if none */
+	uint8_t fb_ep_idx;
+
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+	uint32_t fb_value;
+	uint8_t fb_buf[3];
+	uint16_t fb_frames;
+	bool fb_busy;
+#endif
+
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+	const struct device *i2s_dev;
+	struct k_mem_slab *i2s_slab;
+	bool i2s_started;
+#endif
 };
 
 static sys_slist_t usb_audio_data_devlist;
@@ -78,14 +95,17 @@ struct dev##_descriptor_##i dev##_desc_##i = {				      \
 	.feature_unit = INIT_FEATURE_UNIT(dev, i, id + 1, id),		      \
 	.output_terminal = INIT_OUT_TERMINAL(id + 2, id + 1, ot_type),	      \
 	.as_interface_alt_0 = INIT_STD_IF(USB_AUDIO_AUDIOSTREAMING, 1, 0, 0), \
-	.as_interface_alt_1 = INIT_STD_IF(USB_AUDIO_AUDIOSTREAMING, 1, 1, 1), \
+	.as_interface_alt_1 = INIT_STD_IF(USB_AUDIO_AUDIOSTREAMING, 1, 1,     \
+					  1 + FB_EP_NUM_##dev),		      \
 	.as_cs_interface = INIT_AS_GENERAL(link),			      \
 	.format = INIT_AS_FORMAT_I(CH_CNT(dev, i), GET_RES(dev, i)),	      \
 	.std_ep = INIT_STD_AS_AD_EP(dev, i, addr),			      \
 	.cs_ep = INIT_CS_AS_AD_EP,					      \
+	FB_EP_INIT_##dev						      \
 };									      \
 static struct usb_ep_cfg_data dev##_usb_audio_ep_data_##i[] = {		      \
 	INIT_EP_DATA(cb, addr),						      \
+	FB_EP_DATA_##dev						      \
 }
 
 /**
@@ -133,17 +153,19 @@ struct dev##_descriptor_##i dev##_desc_##i = {				  \
 	.as_interface_alt_1_0 = INIT_STD_IF(USB_AUDIO_AUDIOSTREAMING,	  \
 						2, 0, 0),		  \
 	.as_interface_alt_1_1 = INIT_STD_IF(USB_AUDIO_AUDIOSTREAMING,	  \
-						2, 1, 1),		  \
+						2, 1, 1 + FB_EP_NUM),	  \
 		.as_cs_interface_1 = INIT_AS_GENERAL(id+3),		  \
 		.format_1 = INIT_AS_FORMAT_I(CH_CNT(dev##_HP, i),	  \
 					     GET_RES(dev##_HP, i)),	  \
 		.std_ep_1 = INIT_STD_AS_AD_EP(dev##_HP, i,		  \
 						   AUTO_EP_OUT),	  \
 		.cs_ep_1 = INIT_CS_AS_AD_EP,				  \
+		USB_AUDIO_FB_EP(fb_ep_1)				  \
 };									  \
 static struct usb_ep_cfg_data dev##_usb_audio_ep_data_##i[] = {		  \
 	INIT_EP_DATA(usb_transfer_ep_callback, AUTO_EP_IN),		  \
 	INIT_EP_DATA(audio_receive_cb, AUTO_EP_OUT),			  \
+	USB_AUDIO_FB_EP_DATA						  \
 }
 
 #define DEFINE_AUDIO_DEV_DATA(dev, i, __out_pool, __in_pool_size)   \
@@ -152,7 +174,8 @@ static struct usb_ep_cfg_data dev##_usb_audio_ep_data_##i[] = {		  \
 		{ .pool = __out_pool,				    \
 		  .in_frame_size = __in_pool_size,		    \
 		  .controls = {dev##_controls_##i, NULL},	    \
-		  .ch_cnt = {(CH_CNT(dev, i) + 1), 0}		    \
+		  .ch_cnt = {(CH_CNT(dev, i) + 1), 0},		    \
+		  .fb_ep_idx = FB_EP_NUM_##dev			    \
 		}
 
 #define DEFINE_AUDIO_DEV_DATA_BIDIR(dev, i, __out_pool, __in_pool_size)	   \
@@ -163,7 +186,8 @@ static struct usb_ep_cfg_data dev##_usb_audio_ep_data_##i[] = {		  \
 		  .in_frame_size = __in_pool_size,			   \
 		  .controls = {dev##_controls0_##i, dev##_controls1_##i},  \
 		  .ch_cnt = {(CH_CNT(dev##_MIC, i) + 1),		   \
-			     (CH_CNT(dev##_HP, i) + 1)}			   \
+			     (CH_CNT(dev##_HP, i) + 1)},		   \
+		  .fb_ep_idx = 2 * FB_EP_NUM_##dev##_HP			   \
 		}
 
 /**
@@ -328,6 +352,143 @@ static void audio_interface_config(struct usb_desc_header *head,
 	}
 }
 
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+/**
+ * Helper function for getting the descriptor of the OUT data endpoint,
+ * the feedback endpoint descriptor follows its class specific one.
+ */
+static struct std_as_ad_endpoint_descriptor *get_out_ep_desc(
+				struct usb_audio_dev_data *audio_dev_data)
+{
+	const struct cs_ac_if_descriptor *header = audio_dev_data->desc_hdr;
+	uint8_t *iface;
+
+	/* Skip to the first active interface */
+	iface = (uint8_t *)header + header->wTotalLength +
+		USB_PASSIVE_IF_DESC_SIZE;
+
+	/* The OUT stream is the second one of a Headset */
+	if (header->bInCollection == 2) {
+		iface += USB_ACTIVE_IF_DESC_SIZE + USB_PASSIVE_IF_DESC_SIZE;
+	}
+
+	return (struct std_as_ad_endpoint_descriptor *)(iface +
+						USB_PASSIVE_IF_DESC_SIZE +
+						USB_AC_CS_IF_DESC_SIZE +
+						USB_FORMAT_TYPE_I_DESC_SIZE);
+}
+
+/**
+ * The endpoint addresses are assigned in usb_fix_descriptor(), after
+ * interface_config is called, so the data endpoint is linked to its
+ * feedback endpoint on the bus reset preceding the enumeration.
+ */
+static void audio_fb_fix_descriptor(struct usb_cfg_data *cfg,
+				    struct usb_audio_dev_data *audio_dev_data)
+{
+	if (!audio_dev_data->fb_ep_idx) {
+		return;
+	}
+
+	get_out_ep_desc(audio_dev_data)->bSynchAddress =
+		cfg->endpoint[audio_dev_data->fb_ep_idx].ep_addr;
+}
+
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+/**
+ * Feedback keeping half of the I2S slab queued: each block above or below
+ * it asks the Host for a quarter of a sample less or more per frame, up to
+ * one sample.
+ */
+static uint32_t audio_i2s_feedback(struct usb_audio_dev_data *audio_dev_data)
+{
+	const int32_t sample = BIT(14);
+	struct k_mem_slab *slab = audio_dev_data->i2s_slab;
+	int32_t queued = slab->num_blocks - k_mem_slab_num_free_get(slab);
+	int32_t diff = (int32_t)(slab->num_blocks / 2U) - queued;
+
+	diff = CLAMP(diff * (sample / 4), -sample, sample);
+
+	return (uint32_t)((int32_t)USB_AUDIO_FEEDBACK_NOMINAL + diff);
+}
+#endif
+
+static void audio_fb_write_cb(uint8_t ep, int size, void *priv)
+{
+	struct usb_audio_dev_data *audio_dev_data = priv;
+
+	audio_dev_data->fb_busy = false;
+}
+
+/**
+ * @brief Send the feedback value every 2^bRefresh frames, as long as the
+ * active OUT interface is selected.
+ */
+static void audio_fb_sof(struct usb_cfg_data *cfg,
+			 struct usb_audio_dev_data *audio_dev_data)
+{
+	uint8_t ep;
+
+	if (!audio_dev_data->fb_ep_idx || !audio_dev_data->rx_enable) {
+		return;
+	}
+
+	if (++audio_dev_data->fb_frames <
+	    BIT(CONFIG_USB_AUDIO_FEEDBACK_REFRESH)) {
+		return;
+	}
+
+	audio_dev_data->fb_frames = 0U;
+
+	if (audio_dev_data->fb_busy) {
+		/* The Host did not read the previous value yet */
+		return;
+	}
+
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+	if (audio_dev_data->i2s_dev) {
+		audio_dev_data->fb_value = audio_i2s_feedback(audio_dev_data);
+	}
+#endif
+
+	ep = cfg->endpoint[audio_dev_data->fb_ep_idx].ep_addr;
+	sys_put_le24(audio_dev_data->fb_value, audio_dev_data->fb_buf);
+	audio_dev_data->fb_busy = true;
+
+	if (usb_transfer(ep, audio_dev_data->fb_buf,
+			 sizeof(audio_dev_data->fb_buf),
+			 USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+			 audio_fb_write_cb, audio_dev_data)) {
+		audio_dev_data->fb_busy = false;
+	}
+}
+#endif /* CONFIG_USB_AUDIO_FEEDBACK */
+
+/**
+ * @brief Stop what the OUT stream feeds when the Host selects the
+ * passive interface.
+ */
+static void audio_rx_stop(struct usb_audio_dev_data *audio_dev_data)
+{
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+	const struct usb_cfg_data *cfg = audio_dev_data->common.dev->config;
+
+	if (audio_dev_data->fb_ep_idx) {
+		usb_cancel_transfer(
+			cfg->endpoint[audio_dev_data->fb_ep_idx].ep_addr);
+		audio_dev_data->fb_busy = false;
+	}
+#endif
+
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+	if (audio_dev_data->i2s_dev && audio_dev_data->i2s_started) {
+		(void)i2s_trigger(audio_dev_data->i2s_dev, I2S_DIR_TX,
+				  I2S_TRIGGER_DROP);
+		audio_dev_data->i2s_started = false;
+	}
+#endif
+}
+
 static void audio_cb_usb_status(struct usb_cfg_data *cfg,
 			 enum usb_dc_status_code cb_status,
 			 const uint8_t *param)
@@ -348,7 +509,15 @@ static void audio_cb_usb_status(struct usb_cfg_data *cfg,
 	switch (cb_status) {
 	case USB_DC_SOF:
 		audio_dc_sof(cfg, audio_dev_data);
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+		audio_fb_sof(cfg, audio_dev_data);
+#endif
+		break;
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+	case USB_DC_RESET:
+		audio_fb_fix_descriptor(cfg, audio_dev_data);
 		break;
+#endif
 	default:
 		break;
 	}
@@ -732,6 +901,9 @@ static int audio_custom_handler(struct usb_setup_packet *pSetup, int32_t *len,
 				audio_dev_data->tx_enable = pSetup->wValue;
 			} else {
 				audio_dev_data->rx_enable = pSetup->wValue;
+				if (!audio_dev_data->rx_enable) {
+					audio_rx_stop(audio_dev_data);
+				}
 			}
 			return -EINVAL;
 		case REQ_GET_INTERFACE:
@@ -844,6 +1016,49 @@ size_t usb_audio_get_in_frame_size(const struct device *dev)
 	return audio_dev_data->in_frame_size;
 }
 
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+/**
+ * @brief Read the frame straight into a block of the I2S slab and queue it,
+ * the I2S driver frees the block once it is played.
+ */
+static void audio_i2s_receive(struct usb_audio_dev_data *audio_dev_data,
+			      uint8_t ep)
+{
+	struct k_mem_slab *slab = audio_dev_data->i2s_slab;
+	const struct device *i2s_dev = audio_dev_data->i2s_dev;
+	void *block;
+	int ret_bytes;
+	int ret;
+
+	if (k_mem_slab_alloc(slab, &block, K_NO_WAIT)) {
+		LOG_ERR("Failed to allocate I2S block");
+		return;
+	}
+
+	ret = usb_read(ep, block, slab->block_size, &ret_bytes);
+	if (ret || !ret_bytes) {
+		k_mem_slab_free(slab, &block);
+		return;
+	}
+
+	ret = i2s_write(i2s_dev, block, ret_bytes);
+	if (ret) {
+		LOG_ERR("I2S write failed, ret=%d", ret);
+		k_mem_slab_free(slab, &block);
+		/* Underrun, the stream is restarted once refilled */
+		(void)i2s_trigger(i2s_dev, I2S_DIR_TX, I2S_TRIGGER_PREPARE);
+		audio_dev_data->i2s_started = false;
+		return;
+	}
+
+	if (!audio_dev_data->i2s_started &&
+	    k_mem_slab_num_free_get(slab) <= slab->num_blocks / 2) {
+		ret = i2s_trigger(i2s_dev, I2S_DIR_TX, I2S_TRIGGER_START);
+		audio_dev_data->i2s_started = (ret == 0);
+	}
+}
+#endif
+
 static void audio_receive_cb(uint8_t ep, enum usb_dc_ep_cb_status_code status)
 {
 	struct usb_audio_dev_data *audio_dev_data;
@@ -869,6 +1084,13 @@ static void audio_receive_cb(uint8_t ep, enum usb_dc_ep_cb_status_code status)
 		return;
 	}
 
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+	if (audio_dev_data->i2s_dev) {
+		audio_i2s_receive(audio_dev_data, ep);
+		return;
+	}
+#endif
+
 	/* Check if application installed callback and process the data.
 	 * In case no callback is installed do not alloc the buffer at all.
 	 */
@@ -912,6 +1134,9 @@ void usb_audio_register(const struct device *dev,
 	audio_dev_data->rx_enable = false;
 	audio_dev_data->tx_enable = false;
 	audio_dev_data->desc_hdr = header;
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+	audio_dev_data->fb_value = USB_AUDIO_FEEDBACK_NOMINAL;
+#endif
 
 	sys_slist_append(&usb_audio_data_devlist, &audio_dev_data->common.node);
 
@@ -920,6 +1145,57 @@ void usb_audio_register(const struct device *dev,
 		&usb_audio_data_devlist);
 }
 
+int usb_audio_feedback_set(const struct device *dev, uint32_t value)
+{
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+	struct usb_audio_dev_data *audio_dev_data = dev->data;
+
+	if (!audio_dev_data->fb_ep_idx) {
+		LOG_ERR("Device has no feedback endpoint");
+		return -EINVAL;
+	}
+
+	if (value < USB_AUDIO_FEEDBACK_NOMINAL - BIT(14) ||
+	    value > USB_AUDIO_FEEDBACK_NOMINAL + BIT(14)) {
+		return -EINVAL;
+	}
+
+	audio_dev_data->fb_value = value;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int usb_audio_i2s_bridge(const struct device *dev,
+			 const struct device *i2s_dev,
+			 struct k_mem_slab *slab)
+{
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+	struct usb_audio_dev_data *audio_dev_data = dev->data;
+
+	if (!audio_dev_data->fb_ep_idx || !audio_dev_data->desc_hdr) {
+		LOG_ERR("Device has no OUT stream or is not registered");
+		return -EINVAL;
+	}
+
+	if (i2s_dev && slab->block_size <
+	    sys_le16_to_cpu(get_out_ep_desc(audio_dev_data)->wMaxPacketSize)) {
+		LOG_ERR("I2S blocks smaller than the frames");
+		return -EINVAL;
+	}
+
+	audio_rx_stop(audio_dev_data);
+	audio_dev_data->i2s_slab = slab;
+	audio_dev_data->i2s_dev = i2s_dev;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 #define DEFINE_AUDIO_DEVICE(dev, i)					  \
 	USBD_CFG_DATA_DEFINE(primary, audio)				  \
 	struct usb_cfg_data dev##_audio_config_##i = {			  \
@@ -944,7 +1220,8 @@ void usb_audio_register(const struct device *dev,
 			    DUMMY_API)
 
 #define DEFINE_BUF_POOL(name, size) \
-	NET_BUF_POOL_FIXED_DEFINE(name, 5, size, net_buf_destroy)
+	NET_BUF_POOL_FIXED_DEFINE(name, CONFIG_USB_AUDIO_BUF_COUNT, size, \
+				  net_buf_destroy)
 
 #define UNIDIR_DEVICE(dev, i, out_pool, in_size, it_type, ot_type, cb, addr) \
 	UTIL_EXPAND( \
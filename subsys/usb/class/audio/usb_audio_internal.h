@@ -166,8 +166,47 @@
 #define SYNC_TYPE_HS_MIC(i) DT_ENUM_IDX(DT_INST(i, COMPAT_HS), mic_sync_type)
 #define SYNC_TYPE(dev, i) (SYNC_TYPE_##dev(i) << 2)
 
+/* Usage type of a feedback endpoint in bmAttributes */
+#define USB_AUDIO_EP_FEEDBACK (1 << 4)
+
+/* Bytes each sample of a channel takes in the stream */
+#ifdef CONFIG_USB_AUDIO_I2S_BRIDGE
+/* I2S drivers take 24-bit samples in 32-bit words */
+#define SUBFRAME_SIZE(res) ((res) == 24 ? 4 : (res)/8)
+#else
+#define SUBFRAME_SIZE(res) ((res)/8)
+#endif
+
+/* Feedback endpoints of the devices, the OUT streams only have one */
+#ifdef CONFIG_USB_AUDIO_FEEDBACK
+#define FB_EP_NUM 1
+#define USB_AUDIO_FB_EP_DECLARE(name) \
+	struct std_as_ad_endpoint_descriptor name;
+#define USB_AUDIO_FB_EP(name) .name = INIT_STD_AS_FB_EP,
+#define USB_AUDIO_FB_EP_DATA INIT_EP_DATA(usb_transfer_ep_callback, AUTO_EP_IN),
+#else
+#define FB_EP_NUM 0
+#define USB_AUDIO_FB_EP_DECLARE(name)
+#define USB_AUDIO_FB_EP(name)
+#define USB_AUDIO_FB_EP_DATA
+#endif
+
+#define FB_EP_NUM_HP     FB_EP_NUM
+#define FB_EP_NUM_MIC    0
+#define FB_EP_NUM_HS_HP  FB_EP_NUM
+#define FB_EP_NUM_HS_MIC 0
+
+#define FB_EP_DECLARE_HP  USB_AUDIO_FB_EP_DECLARE(fb_ep)
+#define FB_EP_DECLARE_MIC
+#define FB_EP_INIT_HP     USB_AUDIO_FB_EP(fb_ep)
+#define FB_EP_INIT_MIC
+#define FB_EP_DATA_HP     USB_AUDIO_FB_EP_DATA
+#define FB_EP_DATA_MIC
+
+/* With a feedback endpoint the Host may send one sample more per frame */
 #define EP_SIZE(dev, i) \
-	((GET_RES(dev, i)/8) * CH_CNT(dev, i) * 48)
+	(SUBFRAME_SIZE(GET_RES(dev, i)) * CH_CNT(dev, i) * \
+	 (48 + FB_EP_NUM_##dev))
 
 /* *_ID() macros are used to give proper Id to each entity describing
  * the device. Entities Id must start from 1 that's why 1 is added.
@@ -352,6 +391,7 @@ struct dev##_descriptor_##i {						\
 		struct format_type_i_descriptor format;			\
 		struct std_as_ad_endpoint_descriptor std_ep;		\
 		struct cs_as_ad_ep_descriptor cs_ep;			\
+		FB_EP_DECLARE_##dev					\
 } __packed
 
 #define DECLARE_DESCRIPTOR_BIDIR(dev, i, ifaces)			\
@@ -380,6 +420,7 @@ struct dev##_descriptor_##i {						\
 		struct format_type_i_descriptor format_1;		\
 		struct std_as_ad_endpoint_descriptor std_ep_1;		\
 		struct cs_as_ad_ep_descriptor cs_ep_1;			\
+		USB_AUDIO_FB_EP_DECLARE(fb_ep_1)			\
 } __packed
 
 #define INIT_STD_IF(iface_subclass, iface_num, alt_setting, eps_num)	\
@@ -488,7 +529,7 @@ struct dev##_descriptor_##i {						\
 	.bDescriptorSubtype = USB_AUDIO_FORMAT_TYPE,		\
 	.bFormatType = 0x01,					\
 	.bNrChannels = MAX(1, ch_cnt),				\
-	.bSubframeSize = res/8,					\
+	.bSubframeSize = SUBFRAME_SIZE(res),			\
 	.bBitResolution = res,					\
 	.bSamFreqType = 1,					\
 	.tSamFreq = {0x80, 0xBB, 0x00},				\
@@ -506,6 +547,19 @@ struct dev##_descriptor_##i {						\
 	.bSynchAddress = 0x00,						\
 }
 
+/* Feedback endpoint, Table 4-22 audio10.pdf */
+#define INIT_STD_AS_FB_EP						\
+{									\
+	.bLength = sizeof(struct std_as_ad_endpoint_descriptor),	\
+	.bDescriptorType = USB_ENDPOINT_DESC,				\
+	.bEndpointAddress = AUTO_EP_IN,					\
+	.bmAttributes = (USB_DC_EP_ISOCHRONOUS | USB_AUDIO_EP_FEEDBACK), \
+	.wMaxPacketSize = sys_cpu_to_le16(3),				\
+	.bInterval = 0x01,						\
+	.bRefresh = CONFIG_USB_AUDIO_FEEDBACK_REFRESH,			\
+	.bSynchAddress = 0x00,						\
+}
+
 #define INIT_CS_AS_AD_EP					\
 {								\
 	.bLength = sizeof(struct cs_as_ad_ep_descriptor),	\
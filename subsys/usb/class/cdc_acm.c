@@ -69,6 +69,10 @@ LOG_MODULE_REGISTER(usb_cdc_acm);
 /* Size of the internal buffer used for storing received data */
 #define CDC_ACM_BUFFER_SIZE (CONFIG_CDC_ACM_BULK_EP_MPS)
 
+/* Reception waits for the ring buffer to have room for a full buffer */
+BUILD_ASSERT(CONFIG_USB_CDC_ACM_RINGBUF_SIZE >= CDC_ACM_BUFFER_SIZE,
+	     "CDC ACM ring buffer smaller than the bulk endpoint size");
+
 /* Serial state notification timeout */
 #define CDC_CONTROL_SERIAL_STATE_TIMEOUT_US 100000
 
@@ -183,7 +187,11 @@ struct cdc_acm_dev_data_t {
 	bool rx_ready;				/* Rx ready status */
 	bool tx_irq_ena;			/* Tx interrupt enable status */
 	bool rx_irq_ena;			/* Rx interrupt enable status */
-	uint8_t rx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal RX buffer */
+	/* Internal RX buffers, one receiving while the other is copied */
+	uint8_t rx_buf[2][CDC_ACM_BUFFER_SIZE];
+	uint8_t rx_buf_idx;			/* Rx buffer receiving */
+	atomic_t rx_paused;			/* Rx stopped, no room */
+	size_t tx_len;				/* Data claimed for Tx */
 	struct ring_buf *rx_ringbuf;
 	struct ring_buf *tx_ringbuf;
 	/* Interface data buffer */
@@ -282,6 +290,10 @@ static void cdc_acm_write_cb(uint8_t ep, int size, void *priv)
 
 	LOG_DBG("ep %x: written %d bytes dev_data %p", ep, size, dev_data);
 
+	/* Release the data only now the transfer is done with it */
+	ring_buf_get_finish(dev_data->tx_ringbuf, dev_data->tx_len);
+	dev_data->tx_len = 0;
+
 	dev_data->tx_ready = true;
 
 	k_sem_give(&dev_data->poll_wait_sem);
@@ -308,12 +320,19 @@ static void tx_work_handler(struct k_work *work)
 	uint8_t ep = cfg->endpoint[ACM_IN_EP_IDX].ep_addr;
 	uint8_t *data;
 	size_t len;
+	int ret;
 
-	if (usb_transfer_is_busy(ep)) {
+	if (usb_transfer_is_busy(ep) || dev_data->tx_len != 0) {
 		LOG_DBG("Transfer is ongoing");
 		return;
 	}
 
+	/*
+	 * Send all the contiguous data of the ring buffer in one transfer
+	 * of as many packets as needed. A transfer of a multiple of the
+	 * endpoint MPS is ended by a zero-length packet, for the host not
+	 * to wait for the rest of it.
+	 */
 	len = ring_buf_get_claim(dev_data->tx_ringbuf, &data,
 				 CONFIG_USB_CDC_ACM_RINGBUF_SIZE);
 
@@ -322,37 +341,75 @@ static void tx_work_handler(struct k_work *work)
 		return;
 	}
 
-	/*
-	 * Transfer less data to avoid zero-length packet. The application
-	 * running on the host may conclude that there is no more data to be
-	 * received (i.e. the transaction has completed), hence not triggering
-	 * another I/O Request Packet (IRP).
-	 */
-	if (!(len % CONFIG_CDC_ACM_BULK_EP_MPS)) {
-		len -= 1;
+	LOG_DBG("Got %zd bytes from ringbuffer send to ep %x", len, ep);
+
+	dev_data->tx_len = len;
+	ret = usb_transfer(ep, data, len, USB_TRANS_WRITE,
+			   cdc_acm_write_cb, dev_data);
+	if (ret < 0) {
+		LOG_WRN("Failed to send %zd bytes, ep %x", len, ep);
+		dev_data->tx_len = 0;
+		ring_buf_get_finish(dev_data->tx_ringbuf, 0);
 	}
+}
 
-	LOG_DBG("Got %zd bytes from ringbuffer send to ep %x", len, ep);
+static void cdc_acm_read_cb(uint8_t ep, int size, void *priv);
 
-	usb_transfer(ep, data, len, USB_TRANS_WRITE,
-		     cdc_acm_write_cb, dev_data);
+static void cdc_acm_rx_start(struct cdc_acm_dev_data_t *dev_data, uint8_t ep)
+{
+	dev_data->rx_buf_idx ^= 1U;
 
-	ring_buf_get_finish(dev_data->tx_ringbuf, len);
+	usb_transfer(ep, dev_data->rx_buf[dev_data->rx_buf_idx],
+		     CDC_ACM_BUFFER_SIZE, USB_TRANS_READ,
+		     cdc_acm_read_cb, dev_data);
+}
+
+/*
+ * Restart the reception stopped for lack of room in the ring buffer, once
+ * it can take a full buffer again. Until then, the endpoint NAKs the host.
+ */
+static void cdc_acm_rx_resume(struct cdc_acm_dev_data_t *dev_data)
+{
+	const struct device *dev = dev_data->common.dev;
+	struct usb_cfg_data *cfg = (void *)dev->config;
+
+	if (ring_buf_space_get(dev_data->rx_ringbuf) >= CDC_ACM_BUFFER_SIZE &&
+	    atomic_cas(&dev_data->rx_paused, 1, 0)) {
+		LOG_DBG("Resume receiving, dev_data %p", dev_data);
+		cdc_acm_rx_start(dev_data,
+				 cfg->endpoint[ACM_OUT_EP_IDX].ep_addr);
+	}
 }
 
 static void cdc_acm_read_cb(uint8_t ep, int size, void *priv)
 {
 	struct cdc_acm_dev_data_t *dev_data = priv;
+	uint8_t *buf = dev_data->rx_buf[dev_data->rx_buf_idx];
+	bool restarted = false;
 	size_t wrote;
 
 	LOG_DBG("ep %x size %d dev_data %p rx_ringbuf space %u",
 		ep, size, dev_data, ring_buf_space_get(dev_data->rx_ringbuf));
 
-	if (size <= 0) {
+	if (size < 0) {
+		size = 0;
+	}
+
+	/*
+	 * Receive the next packet into the other buffer while this one is
+	 * copied, if the ring buffer has room for both.
+	 */
+	if (ring_buf_space_get(dev_data->rx_ringbuf) >=
+	    size + CDC_ACM_BUFFER_SIZE) {
+		cdc_acm_rx_start(dev_data, ep);
+		restarted = true;
+	}
+
+	if (size == 0) {
 		goto done;
 	}
 
-	wrote = ring_buf_put(dev_data->rx_ringbuf, dev_data->rx_buf, size);
+	wrote = ring_buf_put(dev_data->rx_ringbuf, buf, size);
 	if (wrote < size) {
 		LOG_ERR("Ring buffer full, drop %zd bytes", size - wrote);
 	}
@@ -365,9 +422,12 @@ done:
 		k_work_submit_to_queue(&USB_WORK_Q, &dev_data->cb_work);
 	}
 
-	usb_transfer(ep, dev_data->rx_buf, sizeof(dev_data->rx_buf),
-		     USB_TRANS_READ, cdc_acm_read_cb, dev_data);
-
+	if (!restarted) {
+		LOG_DBG("Ring buffer full, stop receiving");
+		atomic_set(&dev_data->rx_paused, 1);
+		/* The application may have made room in the meantime */
+		cdc_acm_rx_resume(dev_data);
+	}
 }
 
 /**
@@ -408,7 +468,8 @@ static void cdc_acm_reset_port(struct cdc_acm_dev_data_t *dev_data)
 				CDC_ACM_DEFAULT_BAUDRATE;
 	dev_data->serial_state = 0;
 	dev_data->line_state = 0;
-	memset(&dev_data->rx_buf, 0, CDC_ACM_BUFFER_SIZE);
+	atomic_set(&dev_data->rx_paused, 0);
+	memset(&dev_data->rx_buf, 0, sizeof(dev_data->rx_buf));
 }
 
 static void cdc_acm_do_cb(struct cdc_acm_dev_data_t *dev_data,
@@ -614,6 +675,8 @@ static int cdc_acm_fifo_read(const struct device *dev, uint8_t *rx_data,
 		dev_data->rx_ready = false;
 	}
 
+	cdc_acm_rx_resume(dev_data);
+
 	return len;
 }
 
@@ -58,6 +58,8 @@ LOG_MODULE_REGISTER(usb_msc);
 #define THREAD_OP_READ_QUEUED		1
 #define THREAD_OP_WRITE_QUEUED		3
 #define THREAD_OP_WRITE_DONE		4
+#define THREAD_OP_READ_PIPELINE		5
+#define THREAD_OP_WRITE_PIPELINE	6
 
 #define MASS_STORAGE_IN_EP_ADDR		0x82
 #define MASS_STORAGE_OUT_EP_ADDR	0x01
@@ -119,6 +121,41 @@ static volatile uint32_t defered_wr_sz;
  */
 static uint8_t __aligned(4) page[BLOCK_SIZE + CONFIG_MASS_STORAGE_BULK_EP_MPS];
 
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+#define PIPE_SIZE	(CONFIG_MASS_STORAGE_PIPELINE_BLOCKS * BLOCK_SIZE)
+
+BUILD_ASSERT(BLOCK_SIZE % MAX_PACKET == 0,
+	     "Blocks must be sent in whole packets");
+
+/*
+ * While the USB side sends one buffer to the host, or fills it from the
+ * host, the disk side reads the other one, or writes it.
+ */
+static struct pipe_buf {
+	uint8_t __aligned(4) data[PIPE_SIZE];
+	/* Bytes read from the disk or received from the host */
+	uint32_t len;
+	/* Bytes already sent to the host */
+	uint32_t pos;
+	/* Owned by the disk side: to be sent, or to be written */
+	bool ready;
+	/* Last buffer of the command */
+	bool last;
+} pipe_bufs[2];
+
+/* Buffer the USB side works on and whether it waits for the disk side */
+static uint8_t pipe_usb;
+static bool pipe_usb_waiting;
+
+static uint32_t pipe_disk_addr;
+static bool pipe_error;
+static volatile bool pipe_abort;
+
+/* Buffers free for the disk reads, or ready for the disk writes */
+static struct k_sem pipe_sem;
+static struct k_spinlock pipe_lock;
+#endif
+
 /* Initialized during mass_storage_init() */
 static uint32_t memory_size;
 static uint32_t block_count;
@@ -503,6 +540,234 @@ static void fail(void)
 	sendCSW();
 }
 
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+static void pipe_start(int op)
+{
+	pipe_bufs[0].len = pipe_bufs[0].pos = 0U;
+	pipe_bufs[1].len = pipe_bufs[1].pos = 0U;
+	pipe_bufs[0].ready = pipe_bufs[1].ready = false;
+	pipe_bufs[0].last = pipe_bufs[1].last = false;
+	pipe_usb = 0U;
+	pipe_disk_addr = addr;
+	pipe_error = false;
+	pipe_abort = false;
+
+	k_sem_reset(&pipe_sem);
+
+	if (op == THREAD_OP_READ_PIPELINE) {
+		/* The USB side waits for the first buffer, both are free */
+		pipe_usb_waiting = true;
+		k_sem_give(&pipe_sem);
+		k_sem_give(&pipe_sem);
+	} else {
+		pipe_usb_waiting = false;
+	}
+
+	thread_op = op;
+	k_sem_give(&disk_wait_sem);
+}
+
+/* Send the next packet of a READ, called with pipe_lock held */
+static void pipe_read_send(void)
+{
+	struct pipe_buf *buf = &pipe_bufs[pipe_usb];
+	uint32_t n;
+
+	if (buf->ready && buf->pos == buf->len) {
+		/* Buffer sent, give it back to the disk side */
+		buf->ready = false;
+		k_sem_give(&pipe_sem);
+
+		pipe_usb ^= 1U;
+		buf = &pipe_bufs[pipe_usb];
+	}
+
+	if (!buf->ready) {
+		pipe_usb_waiting = true;
+		return;
+	}
+
+	n = MIN(MAX_PACKET, buf->len - buf->pos);
+	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
+		      &buf->data[buf->pos], n, NULL) != 0) {
+		LOG_ERR("Failed to write EP 0x%x",
+			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
+	}
+
+	buf->pos += n;
+	addr += n;
+	length -= n;
+	csw.DataResidue -= n;
+
+	if (!length) {
+		csw.Status = pipe_error ? CSW_FAILED : CSW_PASSED;
+		stage = MSC_SEND_CSW;
+	} else if (addr >= memory_size) {
+		csw.Status = CSW_FAILED;
+		stage = MSC_ERROR;
+	}
+}
+
+static void pipe_read_in(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe_lock);
+
+	pipe_read_send();
+
+	k_spin_unlock(&pipe_lock, key);
+}
+
+static void pipe_read_thread(void)
+{
+	uint32_t left = MIN(length, memory_size - addr);
+	uint8_t i = 0U;
+
+	while (left) {
+		struct pipe_buf *buf = &pipe_bufs[i];
+		uint32_t n = MIN(left, PIPE_SIZE);
+		k_spinlock_key_t key;
+
+		k_sem_take(&pipe_sem, K_FOREVER);
+		if (pipe_abort) {
+			return;
+		}
+
+		if (disk_access_read(disk_pdrv, buf->data,
+				     pipe_disk_addr / BLOCK_SIZE,
+				     n / BLOCK_SIZE)) {
+			LOG_ERR("!! Disk Read Error %d !",
+				pipe_disk_addr / BLOCK_SIZE);
+			pipe_error = true;
+		}
+
+		if (pipe_abort) {
+			return;
+		}
+
+		pipe_disk_addr += n;
+		left -= n;
+
+		key = k_spin_lock(&pipe_lock);
+
+		buf->len = n;
+		buf->pos = 0U;
+		buf->ready = true;
+
+		if (pipe_usb_waiting && pipe_usb == i) {
+			pipe_usb_waiting = false;
+			pipe_read_send();
+		}
+
+		k_spin_unlock(&pipe_lock, key);
+
+		i ^= 1U;
+	}
+}
+
+static void pipe_write_out(uint8_t *buf, uint16_t size)
+{
+	k_spinlock_key_t key;
+	struct pipe_buf *pbuf;
+
+	if ((addr + size) > memory_size) {
+		size = memory_size - addr;
+		stage = MSC_ERROR;
+		usb_ep_set_stall(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		LOG_WRN("Stall OUT endpoint");
+	}
+
+	key = k_spin_lock(&pipe_lock);
+
+	pbuf = &pipe_bufs[pipe_usb];
+	size = MIN(size, PIPE_SIZE - pbuf->len);
+	memcpy(&pbuf->data[pbuf->len], buf, size);
+	pbuf->len += size;
+
+	addr += size;
+	length -= size;
+	csw.DataResidue -= size;
+
+	if (pbuf->len == PIPE_SIZE || !length || stage != MSC_PROCESS_CBW) {
+		/* Hand the buffer to the disk side, it sends the CSW */
+		pbuf->last = !length || stage != MSC_PROCESS_CBW;
+		pbuf->ready = true;
+		k_sem_give(&pipe_sem);
+
+		pipe_usb ^= 1U;
+
+		if (pbuf->last || pipe_bufs[pipe_usb].ready) {
+			/* Hold the host until the disk side is done */
+			pipe_usb_waiting = !pbuf->last;
+			k_spin_unlock(&pipe_lock, key);
+			return;
+		}
+	}
+
+	k_spin_unlock(&pipe_lock, key);
+
+	usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+}
+
+static void pipe_write_thread(void)
+{
+	uint8_t i = 0U;
+
+	while (true) {
+		struct pipe_buf *buf = &pipe_bufs[i];
+		k_spinlock_key_t key;
+		bool resume;
+
+		k_sem_take(&pipe_sem, K_FOREVER);
+		if (pipe_abort) {
+			return;
+		}
+
+		if (!(disk_access_status(disk_pdrv) &
+		      DISK_STATUS_WR_PROTECT) &&
+		    disk_access_write(disk_pdrv, buf->data,
+				      pipe_disk_addr / BLOCK_SIZE,
+				      buf->len / BLOCK_SIZE)) {
+			LOG_ERR("!!!!! Disk Write Error %d !!!!!",
+				pipe_disk_addr / BLOCK_SIZE);
+			pipe_error = true;
+		}
+
+		if (pipe_abort) {
+			return;
+		}
+
+		pipe_disk_addr += buf->len;
+
+		if (buf->last) {
+			csw.Status = (stage == MSC_ERROR || pipe_error) ?
+				CSW_FAILED : CSW_PASSED;
+			sendCSW();
+			usb_ep_read_continue(
+				mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+			return;
+		}
+
+		key = k_spin_lock(&pipe_lock);
+
+		buf->len = 0U;
+		buf->ready = false;
+
+		/* The host was held while both buffers were full */
+		resume = pipe_usb_waiting;
+		pipe_usb_waiting = false;
+
+		k_spin_unlock(&pipe_lock, key);
+
+		if (resume) {
+			usb_ep_read_continue(
+				mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		}
+
+		i ^= 1U;
+	}
+}
+#endif /* CONFIG_MASS_STORAGE_PIPELINE */
+
 static void CBWDecode(uint8_t *buf, uint16_t size)
 {
 	if (size != sizeof(cbw)) {
@@ -564,7 +829,11 @@ static void CBWDecode(uint8_t *buf, uint16_t size)
 			if (infoTransfer()) {
 				if ((cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+					pipe_start(THREAD_OP_READ_PIPELINE);
+#else
 					memoryRead();
+#endif
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
@@ -580,6 +849,9 @@ static void CBWDecode(uint8_t *buf, uint16_t size)
 			if (infoTransfer()) {
 				if (!(cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+					pipe_start(THREAD_OP_WRITE_PIPELINE);
+#endif
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_IN_EP_IDX].ep_addr);
@@ -724,8 +996,14 @@ static void mass_storage_bulk_out(uint8_t ep,
 		case WRITE10:
 		case WRITE12:
 			/* LOG_DBG("> BO - PROC_CBW WR");*/
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+			/* Resumes the endpoint once the data has room */
+			pipe_write_out(bo_buf, bytes_read);
+			return;
+#else
 			memoryWrite(bo_buf, bytes_read);
 			break;
+#endif
 		case VERIFY10:
 			LOG_DBG("> BO - PROC_CBW VER");
 			memoryVerify(bo_buf, bytes_read);
@@ -798,7 +1076,11 @@ static void mass_storage_bulk_in(uint8_t ep,
 		case READ10:
 		case READ12:
 			/* LOG_DBG("< BI - PROC_CBW  READ"); */
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+			pipe_read_in();
+#else
 			memoryRead();
+#endif
 			break;
 		default:
 			LOG_ERR("< BI-PROC_CBW default <<ERROR!!>>");
@@ -852,6 +1134,11 @@ static void mass_storage_status_cb(struct usb_cfg_data *cfg,
 		LOG_DBG("USB device reset detected");
 		msd_state_machine_reset();
 		msd_init();
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+		/* Stop the disk side of an interrupted command */
+		pipe_abort = true;
+		k_sem_give(&pipe_sem);
+#endif
 		break;
 	case USB_DC_CONNECTED:
 		LOG_DBG("USB device connected");
@@ -929,6 +1216,14 @@ static void mass_thread_main(int arg1, int unused)
 			}
 			thread_memory_write_done();
 			break;
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+		case THREAD_OP_READ_PIPELINE:
+			pipe_read_thread();
+			break;
+		case THREAD_OP_WRITE_PIPELINE:
+			pipe_write_thread();
+			break;
+#endif
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
 		}
@@ -985,6 +1280,9 @@ static int mass_storage_init(const struct device *dev)
 	msd_init();
 
 	k_sem_init(&disk_wait_sem, 0, 1);
+#ifdef CONFIG_MASS_STORAGE_PIPELINE
+	k_sem_init(&pipe_sem, 0, ARRAY_SIZE(pipe_bufs));
+#endif
 
 	/* Start a thread to offload disk ops */
 	k_thread_create(&mass_thread_data, mass_thread_stack,
@@ -30,7 +30,12 @@ LOG_MODULE_REGISTER(usb_ecm);
 #define ECM_IN_EP_IDX			2
 
 
-static uint8_t tx_buf[NET_ETH_MAX_FRAME_SIZE], rx_buf[NET_ETH_MAX_FRAME_SIZE];
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+static uint8_t tx_buf[CONFIG_CDC_ECM_BULK_EP_MPS];
+#else
+static uint8_t tx_buf[NET_ETH_MAX_FRAME_SIZE];
+#endif
+static uint8_t rx_buf[NET_ETH_MAX_FRAME_SIZE];
 
 struct usb_cdc_ecm_config {
 #ifdef CONFIG_USB_COMPOSITE_DEVICE
@@ -257,11 +262,25 @@ static int ecm_send(struct net_pkt *pkt)
 		net_pkt_hexdump(pkt, "<");
 	}
 
-	if (len > sizeof(tx_buf)) {
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+	struct netusb_tx tx;
+
+	/* transfer data to host, straight from the packet buffers */
+	netusb_tx_init(&tx, ecm_ep_data[ECM_IN_EP_IDX].ep_addr,
+		       tx_buf, sizeof(tx_buf));
+
+	ret = netusb_tx_write_pkt(&tx, pkt);
+	if (ret) {
+		return ret;
+	}
+
+	return netusb_tx_finish(&tx);
+#else
 	if (net_pkt_read(pkt, tx_buf, len)) {
 		return -ENOBUFS;
 	}
@@ -275,6 +294,7 @@ static int ecm_send(struct net_pkt *pkt)
 	}
 
 	return 0;
+#endif
 }
 
 static void ecm_read_cb(uint8_t ep, int size, void *priv)
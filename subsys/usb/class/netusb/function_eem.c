@@ -23,7 +23,12 @@ static uint8_t sentinel[] = { 0xde, 0xad, 0xbe, 0xef };
 #define EEM_FRAME_SIZE (NET_ETH_MAX_FRAME_SIZE + sizeof(sentinel) + \
 			sizeof(uint16_t)) /* EEM header */
 
-static uint8_t tx_buf[EEM_FRAME_SIZE], rx_buf[EEM_FRAME_SIZE];
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+static uint8_t tx_buf[CONFIG_CDC_EEM_BULK_EP_MPS];
+#else
+static uint8_t tx_buf[EEM_FRAME_SIZE];
+#endif
+static uint8_t rx_buf[EEM_FRAME_SIZE];
 
 struct usb_cdc_eem_config {
 	struct usb_if_descriptor if0;
@@ -101,19 +106,44 @@ static inline uint16_t eem_pkt_size(uint16_t hdr)
 
 static int eem_send(struct net_pkt *pkt)
 {
-	uint16_t *hdr = (uint16_t *)&tx_buf[0];
-	int ret, len, b_idx = 0;
+	int ret, len;
 
 	/* With EEM, it's possible to send multiple ethernet packets in one
 	 * transfer, we don't do that for now.
 	 */
 	len = net_pkt_get_len(pkt) + sizeof(sentinel);
 
-	if (len + sizeof(uint16_t) > sizeof(tx_buf)) {
+	if (len + sizeof(uint16_t) > EEM_FRAME_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+	struct netusb_tx tx;
+	uint16_t eem_hdr = sys_cpu_to_le16(0x3FFF & len);
+
+	netusb_tx_init(&tx, eem_ep_data[EEM_IN_EP_IDX].ep_addr,
+		       tx_buf, sizeof(tx_buf));
+
+	/* EEM header, packet buffers and crc-sentinel, in one transfer */
+	ret = netusb_tx_write(&tx, (uint8_t *)&eem_hdr, sizeof(eem_hdr));
+	if (!ret) {
+		ret = netusb_tx_write_pkt(&tx, pkt);
+	}
+
+	if (!ret) {
+		ret = netusb_tx_write(&tx, sentinel, sizeof(sentinel));
+	}
+
+	if (ret) {
+		return ret;
+	}
+
+	return netusb_tx_finish(&tx);
+#else
+	uint16_t *hdr = (uint16_t *)&tx_buf[0];
+	int b_idx = 0;
+
 	/* Add EEM header */
 	*hdr = sys_cpu_to_le16(0x3FFF & len);
 	b_idx += sizeof(uint16_t);
@@ -138,6 +168,7 @@ static int eem_send(struct net_pkt *pkt)
 	}
 
 	return 0;
+#endif
 }
 
 static void eem_read_cb(uint8_t ep, int size, void *priv)
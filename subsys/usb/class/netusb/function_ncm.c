@@ -0,0 +1,748 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_LEVEL CONFIG_USB_DEVICE_NETWORK_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(usb_ncm);
+
+/* Enable verbose debug printing extra hexdumps */
+#define VERBOSE_DEBUG	0
+
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+#include <net_private.h>
+
+#include <usb/usb_device.h>
+#include <usb/usb_common.h>
+#include <usb/class/usb_cdc.h>
+#include <usb_descriptor.h>
+
+#include "netusb.h"
+
+#define USB_CDC_NCM_REQ_TYPE_OUT	0x21
+#define USB_CDC_NCM_REQ_TYPE_IN		0xA1
+#define USB_CDC_SET_ETH_PKT_FILTER	0x43
+#define USB_CDC_GET_NTB_PARAMETERS	0x80
+
+#define USB_CDC_NOTIFY_NETWORK_CONNECTION	0x00
+#define USB_CDC_NOTIFY_SPEED_CHANGE		0x2A
+
+#define NCM_INT_EP_IDX			0
+#define NCM_OUT_EP_IDX			1
+#define NCM_IN_EP_IDX			2
+
+/* NCM Transfer Block, 16-bit format, NCM10.pdf 3.2 and 3.3 */
+#define NCM_NTH16_SIGNATURE		0x484D434E /* "NCMH" */
+#define NCM_NDP16_SIGNATURE		0x304D434E /* "NCM0", no CRC */
+
+#define NCM_NTB_SIZE			CONFIG_CDC_NCM_NTB_SIZE
+#define NCM_NDP_ALIGNMENT		4
+#define NCM_DATAGRAM_ALIGNMENT		4
+#define NCM_NTB_DATAGRAMS_MAX		32
+
+struct ncm_nth16 {
+	uint32_t dwSignature;
+	uint16_t wHeaderLength;
+	uint16_t wSequence;
+	uint16_t wBlockLength;
+	uint16_t wNdpIndex;
+} __packed;
+
+struct ncm_datagram16 {
+	uint16_t wDatagramIndex;
+	uint16_t wDatagramLength;
+} __packed;
+
+struct ncm_ndp16 {
+	uint32_t dwSignature;
+	uint16_t wLength;
+	uint16_t wNextNdpIndex;
+	struct ncm_datagram16 datagram[];
+} __packed;
+
+/* NDP16 of a block, with the null entry ending the datagram list */
+#define NCM_NDP16_SIZE(count) \
+	(sizeof(struct ncm_ndp16) + \
+	 ((count) + 1) * sizeof(struct ncm_datagram16))
+
+struct ncm_ntb_parameters {
+	uint16_t wLength;
+	uint16_t bmNtbFormatsSupported;
+	uint32_t dwNtbInMaxSize;
+	uint16_t wNdpInDivisor;
+	uint16_t wNdpInPayloadRemainder;
+	uint16_t wNdpInAlignment;
+	uint16_t wReserved;
+	uint32_t dwNtbOutMaxSize;
+	uint16_t wNdpOutDivisor;
+	uint16_t wNdpOutPayloadRemainder;
+	uint16_t wNdpOutAlignment;
+	uint16_t wNtbOutMaxDatagrams;
+} __packed;
+
+static const struct ncm_ntb_parameters ntb_parameters = {
+	.wLength = sys_cpu_to_le16(sizeof(struct ncm_ntb_parameters)),
+	.bmNtbFormatsSupported = sys_cpu_to_le16(BIT(0)), /* NTB16 only */
+	.dwNtbInMaxSize = sys_cpu_to_le32(NCM_NTB_SIZE),
+	.wNdpInDivisor = sys_cpu_to_le16(NCM_DATAGRAM_ALIGNMENT),
+	.wNdpInPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpInAlignment = sys_cpu_to_le16(NCM_NDP_ALIGNMENT),
+	.dwNtbOutMaxSize = sys_cpu_to_le32(NCM_NTB_SIZE),
+	.wNdpOutDivisor = sys_cpu_to_le16(NCM_DATAGRAM_ALIGNMENT),
+	.wNdpOutPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpOutAlignment = sys_cpu_to_le16(NCM_NDP_ALIGNMENT),
+	.wNtbOutMaxDatagrams = sys_cpu_to_le16(0), /* No limit */
+};
+
+/*
+ * Frames are gathered in a transmit block while the other one is in
+ * flight, and sent on its completion: a single block is sent at a time,
+ * holding all the frames queued meanwhile.
+ */
+struct ncm_ntb_tx {
+	uint8_t buf[NCM_NTB_SIZE] __aligned(4);
+	struct ncm_datagram16 datagram[NCM_NTB_DATAGRAMS_MAX];
+	uint16_t len;
+	uint8_t count;
+};
+
+static struct ncm_ntb_tx ntb_tx[2];
+static uint8_t ntb_tx_fill;
+static bool ntb_tx_busy;
+static uint16_t ntb_tx_sequence;
+
+static K_MUTEX_DEFINE(ntb_tx_mutex);
+static K_SEM_DEFINE(ntb_tx_done, 0, 1);
+
+static uint8_t rx_buf[NCM_NTB_SIZE] __aligned(4);
+
+struct ncm_notification {
+	uint8_t bmRequestType;
+	uint8_t bNotificationType;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} __packed;
+
+static struct ncm_notification connection_notification;
+
+static struct {
+	struct ncm_notification hdr;
+	uint32_t DLBitRate;
+	uint32_t ULBitRate;
+} __packed speed_notification;
+
+struct usb_cdc_ncm_config {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	struct usb_association_descriptor iad;
+#endif
+	struct usb_if_descriptor if0;
+	struct cdc_header_descriptor if0_header;
+	struct cdc_union_descriptor if0_union;
+	struct cdc_ecm_descriptor if0_netfun_ecm;
+	struct cdc_ncm_descriptor if0_netfun_ncm;
+	struct usb_ep_descriptor if0_int_ep;
+
+	struct usb_if_descriptor if1_0;
+
+	struct usb_if_descriptor if1_1;
+	struct usb_ep_descriptor if1_1_in_ep;
+	struct usb_ep_descriptor if1_1_out_ep;
+} __packed;
+
+USBD_CLASS_DESCR_DEFINE(primary, 0) struct usb_cdc_ncm_config cdc_ncm_cfg = {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	.iad = {
+		.bLength = sizeof(struct usb_association_descriptor),
+		.bDescriptorType = USB_ASSOCIATION_DESC,
+		.bFirstInterface = 0,
+		.bInterfaceCount = 0x02,
+		.bFunctionClass = COMMUNICATION_DEVICE_CLASS,
+		.bFunctionSubClass = NCM_SUBCLASS,
+		.bFunctionProtocol = 0,
+		.iFunction = 0,
+	},
+#endif
+	/* Interface descriptor 0 */
+	/* CDC Communication interface */
+	.if0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 0,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 1,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS,
+		.bInterfaceSubClass = NCM_SUBCLASS,
+		.bInterfaceProtocol = 0,
+		.iInterface = 0,
+	},
+	/* Header Functional Descriptor */
+	.if0_header = {
+		.bFunctionLength = sizeof(struct cdc_header_descriptor),
+		.bDescriptorType = USB_CS_INTERFACE_DESC,
+		.bDescriptorSubtype = HEADER_FUNC_DESC,
+		.bcdCDC = sys_cpu_to_le16(USB_1_1),
+	},
+	/* Union Functional Descriptor */
+	.if0_union = {
+		.bFunctionLength = sizeof(struct cdc_union_descriptor),
+		.bDescriptorType = USB_CS_INTERFACE_DESC,
+		.bDescriptorSubtype = UNION_FUNC_DESC,
+		.bControlInterface = 0,
+		.bSubordinateInterface0 = 1,
+	},
+	/* Ethernet Networking Functional descriptor */
+	.if0_netfun_ecm = {
+		.bFunctionLength = sizeof(struct cdc_ecm_descriptor),
+		.bDescriptorType = USB_CS_INTERFACE_DESC,
+		.bDescriptorSubtype = ETHERNET_FUNC_DESC,
+		.iMACAddress = 4,
+		.bmEthernetStatistics = sys_cpu_to_le32(0), /* None */
+		.wMaxSegmentSize = sys_cpu_to_le16(NET_ETH_MAX_FRAME_SIZE),
+		.wNumberMCFilters = sys_cpu_to_le16(0), /* None */
+		.bNumberPowerFilters = 0, /* No wake up */
+	},
+	/* NCM Functional descriptor */
+	.if0_netfun_ncm = {
+		.bFunctionLength = sizeof(struct cdc_ncm_descriptor),
+		.bDescriptorType = USB_CS_INTERFACE_DESC,
+		.bDescriptorSubtype = NCM_FUNC_DESC,
+		.bcdNcmVersion = sys_cpu_to_le16(0x0100),
+		.bmNetworkCapabilities = 0, /* No optional requests */
+	},
+	/* Notification EP Descriptor */
+	.if0_int_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_INT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_INTERRUPT,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_INTERRUPT_EP_MPS),
+		.bInterval = 0x09,
+	},
+
+	/* Interface descriptor 1/0 */
+	/* CDC Data Interface */
+	.if1_0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 0,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+
+	/* Interface descriptor 1/1 */
+	/* CDC Data Interface */
+	.if1_1 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 1,
+		.bNumEndpoints = 2,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+	/* Data Endpoint IN */
+	.if1_1_in_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_IN_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+	/* Data Endpoint OUT */
+	.if1_1_out_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_OUT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+};
+
+static uint8_t ncm_get_first_iface_number(void)
+{
+	return cdc_ncm_cfg.if0.bInterfaceNumber;
+}
+
+static struct usb_ep_cfg_data ncm_ep_data[] = {
+	/* Configuration NCM */
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_INT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_OUT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_IN_EP_ADDR
+	},
+};
+
+static int ncm_class_handler(struct usb_setup_packet *setup, int32_t *len,
+			     uint8_t **data)
+{
+	LOG_DBG("len %d req_type 0x%x req 0x%x enabled %u",
+		*len, setup->bmRequestType, setup->bRequest,
+		netusb_enabled());
+
+	if (setup->bmRequestType == USB_CDC_NCM_REQ_TYPE_IN &&
+	    setup->bRequest == USB_CDC_GET_NTB_PARAMETERS) {
+		/* Asked before the data interface is enabled */
+		*data = (uint8_t *)&ntb_parameters;
+		*len = MIN(sizeof(ntb_parameters), setup->wLength);
+		return 0;
+	}
+
+	if (setup->bmRequestType == USB_CDC_NCM_REQ_TYPE_OUT &&
+	    setup->bRequest == USB_CDC_SET_ETH_PKT_FILTER) {
+		LOG_DBG("intf 0x%x filter 0x%x", setup->wIndex, setup->wValue);
+		return 0;
+	}
+
+	LOG_WRN("Unhandled req_type 0x%x req 0x%x", setup->bmRequestType,
+		setup->bRequest);
+
+	return -ENOTSUP;
+}
+
+static void ncm_ntb_tx_reset(struct ncm_ntb_tx *ntb)
+{
+	ntb->len = sizeof(struct ncm_nth16);
+	ntb->count = 0U;
+}
+
+/* Whether a frame still fits in the block, along with the grown NDP16 */
+static bool ncm_ntb_tx_room(struct ncm_ntb_tx *ntb, size_t len)
+{
+	size_t end = ROUND_UP(ntb->len, NCM_DATAGRAM_ALIGNMENT) + len;
+
+	return ntb->count < NCM_NTB_DATAGRAMS_MAX &&
+	       ROUND_UP(end, NCM_NDP_ALIGNMENT) +
+	       NCM_NDP16_SIZE(ntb->count + 1) <= NCM_NTB_SIZE;
+}
+
+static void ncm_write_cb(uint8_t ep, int size, void *priv);
+
+/* Write the NTH16 and NDP16 around the gathered frames, then send them */
+static void ncm_ntb_tx_submit(void)
+{
+	struct ncm_ntb_tx *ntb = &ntb_tx[ntb_tx_fill];
+	struct ncm_nth16 *nth = (void *)ntb->buf;
+	struct ncm_ndp16 *ndp;
+	uint16_t ndp_index = ROUND_UP(ntb->len, NCM_NDP_ALIGNMENT);
+	uint16_t ndp_len = NCM_NDP16_SIZE(ntb->count);
+	int ret;
+
+	ndp = (void *)&ntb->buf[ndp_index];
+	ndp->dwSignature = sys_cpu_to_le32(NCM_NDP16_SIGNATURE);
+	ndp->wLength = sys_cpu_to_le16(ndp_len);
+	ndp->wNextNdpIndex = sys_cpu_to_le16(0);
+	memcpy(ndp->datagram, ntb->datagram,
+	       ntb->count * sizeof(struct ncm_datagram16));
+	(void)memset(&ndp->datagram[ntb->count], 0,
+		     sizeof(struct ncm_datagram16));
+
+	ntb->len = ndp_index + ndp_len;
+
+	nth->dwSignature = sys_cpu_to_le32(NCM_NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(struct ncm_nth16));
+	nth->wSequence = sys_cpu_to_le16(ntb_tx_sequence++);
+	nth->wBlockLength = sys_cpu_to_le16(ntb->len);
+	nth->wNdpIndex = sys_cpu_to_le16(ndp_index);
+
+	LOG_DBG("NTB %u datagrams len %u", ntb->count, ntb->len);
+
+	ret = usb_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr, ntb->buf,
+			   ntb->len, USB_TRANS_WRITE, ncm_write_cb, NULL);
+	if (ret < 0) {
+		LOG_ERR("Transfer failure, ret %d", ret);
+		ncm_ntb_tx_reset(ntb);
+		return;
+	}
+
+	ntb_tx_busy = true;
+	ntb_tx_fill ^= 1U;
+}
+
+static void ncm_write_cb(uint8_t ep, int size, void *priv)
+{
+	LOG_DBG("ep %x size %u", ep, size);
+
+	k_mutex_lock(&ntb_tx_mutex, K_FOREVER);
+
+	ntb_tx_busy = false;
+
+	if (ntb_tx[ntb_tx_fill].count) {
+		ncm_ntb_tx_submit();
+	}
+
+	k_sem_give(&ntb_tx_done);
+
+	k_mutex_unlock(&ntb_tx_mutex);
+}
+
+static int ncm_send(struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	struct ncm_ntb_tx *ntb;
+	uint16_t index;
+
+	if (VERBOSE_DEBUG) {
+		net_pkt_hexdump(pkt, "<");
+	}
+
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
+		LOG_WRN("Trying to send too large packet, drop");
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&ntb_tx_mutex, K_FOREVER);
+
+	/* Only the block being filled while the other is in flight fills up */
+	while (!ncm_ntb_tx_room(&ntb_tx[ntb_tx_fill], len)) {
+		k_sem_reset(&ntb_tx_done);
+		k_mutex_unlock(&ntb_tx_mutex);
+
+		k_sem_take(&ntb_tx_done, K_FOREVER);
+
+		if (!netusb_enabled()) {
+			return -ENODEV;
+		}
+
+		k_mutex_lock(&ntb_tx_mutex, K_FOREVER);
+	}
+
+	ntb = &ntb_tx[ntb_tx_fill];
+	index = ROUND_UP(ntb->len, NCM_DATAGRAM_ALIGNMENT);
+
+	if (net_pkt_read(pkt, &ntb->buf[index], len)) {
+		k_mutex_unlock(&ntb_tx_mutex);
+		return -ENOBUFS;
+	}
+
+	/* The alignment padding is not sent uninitialized */
+	(void)memset(&ntb->buf[ntb->len], 0, index - ntb->len);
+
+	ntb->datagram[ntb->count].wDatagramIndex = sys_cpu_to_le16(index);
+	ntb->datagram[ntb->count].wDatagramLength = sys_cpu_to_le16(len);
+	ntb->count++;
+	ntb->len = index + len;
+
+	if (!ntb_tx_busy) {
+		ncm_ntb_tx_submit();
+	}
+
+	k_mutex_unlock(&ntb_tx_mutex);
+
+	return 0;
+}
+
+static void ncm_recv_datagram(const uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(netusb_net_iface(), len,
+					AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		LOG_ERR("no memory for network packet");
+		return;
+	}
+
+	if (net_pkt_write(pkt, data, len)) {
+		LOG_ERR("Unable to write into pkt");
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	if (VERBOSE_DEBUG) {
+		net_pkt_hexdump(pkt, ">");
+	}
+
+	netusb_recv(pkt);
+}
+
+/* Hand the datagrams of a received NTB16 to the stack, dropping bad ones */
+static void ncm_recv_ntb(const uint8_t *ntb, size_t size)
+{
+	const struct ncm_nth16 *nth = (const void *)ntb;
+	uint16_t ndp_index;
+	int ndp_count = 0;
+
+	if (size < sizeof(*nth) ||
+	    sys_le32_to_cpu(nth->dwSignature) != NCM_NTH16_SIGNATURE ||
+	    sys_le16_to_cpu(nth->wBlockLength) > size) {
+		LOG_WRN("Bad NTB header, size %zu", size);
+		return;
+	}
+
+	/* A null block length stands for the whole transfer */
+	if (nth->wBlockLength) {
+		size = sys_le16_to_cpu(nth->wBlockLength);
+	}
+
+	ndp_index = sys_le16_to_cpu(nth->wNdpIndex);
+
+	/* The count bounds a chain of NDPs looping back on itself */
+	while (ndp_index && ndp_count++ < NCM_NTB_DATAGRAMS_MAX) {
+		const struct ncm_ndp16 *ndp = (const void *)&ntb[ndp_index];
+		size_t count, i;
+
+		if (ndp_index % NCM_NDP_ALIGNMENT ||
+		    ndp_index + NCM_NDP16_SIZE(0) > size ||
+		    sys_le32_to_cpu(ndp->dwSignature) != NCM_NDP16_SIGNATURE ||
+		    sys_le16_to_cpu(ndp->wLength) < NCM_NDP16_SIZE(1) ||
+		    ndp_index + sys_le16_to_cpu(ndp->wLength) > size) {
+			LOG_WRN("Bad NDP at %u", ndp_index);
+			return;
+		}
+
+		count = (sys_le16_to_cpu(ndp->wLength) -
+			 sizeof(struct ncm_ndp16)) /
+			sizeof(struct ncm_datagram16);
+
+		for (i = 0; i < count; i++) {
+			const struct ncm_datagram16 *dg = &ndp->datagram[i];
+			uint16_t index = sys_le16_to_cpu(dg->wDatagramIndex);
+			uint16_t len = sys_le16_to_cpu(dg->wDatagramLength);
+
+			if (!index || !len) {
+				break;
+			}
+
+			if (index + len > size ||
+			    len < sizeof(struct net_eth_hdr)) {
+				LOG_WRN("Bad datagram at %u len %u", index,
+					len);
+				continue;
+			}
+
+			ncm_recv_datagram(&ntb[index], len);
+		}
+
+		ndp_index = sys_le16_to_cpu(ndp->wNextNdpIndex);
+	}
+}
+
+static void ncm_read_cb(uint8_t ep, int size, void *priv)
+{
+	if (size > 0) {
+		ncm_recv_ntb(rx_buf, size);
+	}
+
+	usb_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr, rx_buf,
+		     sizeof(rx_buf), USB_TRANS_READ, ncm_read_cb, NULL);
+}
+
+static void ncm_notify_cb(uint8_t ep, int size, void *priv)
+{
+	int ret;
+
+	LOG_DBG("ep %x size %u", ep, size);
+
+	if (priv != &connection_notification) {
+		return;
+	}
+
+	/* Host drivers take the link up from the connection notification */
+	ret = usb_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr,
+			   (uint8_t *)&connection_notification,
+			   sizeof(connection_notification),
+			   USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+			   ncm_notify_cb, NULL);
+	if (ret < 0) {
+		LOG_ERR("Transfer failure, ret %d", ret);
+	}
+}
+
+static void ncm_notify_connection(void)
+{
+	uint16_t iface = sys_cpu_to_le16(ncm_get_first_iface_number());
+	/* Bulk packets of 512 bytes are high-speed ones */
+	uint32_t speed = usb_dc_ep_mps(ncm_ep_data[NCM_IN_EP_IDX].ep_addr) ==
+			 512U ? 480000000U : 12000000U;
+	int ret;
+
+	speed_notification.hdr.bmRequestType = USB_CDC_NCM_REQ_TYPE_IN;
+	speed_notification.hdr.bNotificationType = USB_CDC_NOTIFY_SPEED_CHANGE;
+	speed_notification.hdr.wValue = sys_cpu_to_le16(0);
+	speed_notification.hdr.wIndex = iface;
+	speed_notification.hdr.wLength = sys_cpu_to_le16(2 * sizeof(speed));
+	speed_notification.DLBitRate = sys_cpu_to_le32(speed);
+	speed_notification.ULBitRate = sys_cpu_to_le32(speed);
+
+	connection_notification.bmRequestType = USB_CDC_NCM_REQ_TYPE_IN;
+	connection_notification.bNotificationType =
+		USB_CDC_NOTIFY_NETWORK_CONNECTION;
+	connection_notification.wValue = sys_cpu_to_le16(1); /* Connected */
+	connection_notification.wIndex = iface;
+	connection_notification.wLength = sys_cpu_to_le16(0);
+
+	ret = usb_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr,
+			   (uint8_t *)&speed_notification,
+			   sizeof(speed_notification),
+			   USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+			   ncm_notify_cb, &connection_notification);
+	if (ret < 0) {
+		LOG_ERR("Transfer failure, ret %d", ret);
+	}
+}
+
+static int ncm_connect(bool connected)
+{
+	if (connected) {
+		ncm_read_cb(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr, 0, NULL);
+		ncm_notify_connection();
+		return 0;
+	}
+
+	/* Cancel any transfer */
+	usb_cancel_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr);
+	usb_cancel_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr);
+	usb_cancel_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr);
+
+	k_mutex_lock(&ntb_tx_mutex, K_FOREVER);
+
+	ncm_ntb_tx_reset(&ntb_tx[0]);
+	ncm_ntb_tx_reset(&ntb_tx[1]);
+	ntb_tx_busy = false;
+
+	/* Release a sender waiting for the cancelled transfer */
+	k_sem_give(&ntb_tx_done);
+
+	k_mutex_unlock(&ntb_tx_mutex);
+
+	return 0;
+}
+
+static struct netusb_function ncm_function = {
+	.connect_media = ncm_connect,
+	.send_pkt = ncm_send,
+};
+
+static inline void ncm_status_interface(const uint8_t *desc)
+{
+	const struct usb_if_descriptor *if_desc = (void *)desc;
+	uint8_t iface_num = if_desc->bInterfaceNumber;
+	uint8_t alt_set = if_desc->bAlternateSetting;
+
+	LOG_DBG("iface %u alt_set %u", iface_num, if_desc->bAlternateSetting);
+
+	/* First interface is CDC Comm interface */
+	if (iface_num != ncm_get_first_iface_number() + 1 || !alt_set) {
+		LOG_DBG("Skip iface_num %u alt_set %u", iface_num, alt_set);
+		return;
+	}
+
+	netusb_enable(&ncm_function);
+}
+
+static void ncm_status_cb(struct usb_cfg_data *cfg,
+			  enum usb_dc_status_code status,
+			  const uint8_t *param)
+{
+	ARG_UNUSED(cfg);
+
+	/* Check the USB status and do needed action if required */
+	switch (status) {
+	case USB_DC_DISCONNECTED:
+		LOG_DBG("USB device disconnected");
+		netusb_disable();
+		break;
+
+	case USB_DC_INTERFACE:
+		LOG_DBG("USB interface selected");
+		ncm_status_interface(param);
+		break;
+
+	case USB_DC_ERROR:
+	case USB_DC_RESET:
+	case USB_DC_CONNECTED:
+	case USB_DC_CONFIGURED:
+	case USB_DC_SUSPEND:
+	case USB_DC_RESUME:
+		LOG_DBG("USB unhandlded state: %d", status);
+		break;
+
+	case USB_DC_SOF:
+		break;
+
+	case USB_DC_UNKNOWN:
+	default:
+		LOG_DBG("USB unknown state: %d", status);
+		break;
+	}
+}
+
+struct usb_cdc_ncm_mac_descr {
+	uint8_t bLength;
+	uint8_t bDescriptorType;
+	uint8_t bString[USB_BSTRING_LENGTH(CONFIG_USB_DEVICE_NETWORK_NCM_MAC)];
+} __packed;
+
+USBD_STRING_DESCR_DEFINE(primary) struct usb_cdc_ncm_mac_descr utf16le_mac = {
+	.bLength = USB_STRING_DESCRIPTOR_LENGTH(
+			CONFIG_USB_DEVICE_NETWORK_NCM_MAC),
+	.bDescriptorType = USB_STRING_DESC,
+	.bString = CONFIG_USB_DEVICE_NETWORK_NCM_MAC
+};
+
+static void ncm_interface_config(struct usb_desc_header *head,
+				 uint8_t bInterfaceNumber)
+{
+	int idx = usb_get_str_descriptor_idx(&utf16le_mac);
+
+	ARG_UNUSED(head);
+
+	if (idx) {
+		LOG_DBG("fixup string %d", idx);
+		cdc_ncm_cfg.if0_netfun_ecm.iMACAddress = idx;
+	}
+
+	cdc_ncm_cfg.if0.bInterfaceNumber = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bControlInterface = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bSubordinateInterface0 = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_0.bInterfaceNumber = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_1.bInterfaceNumber = bInterfaceNumber + 1;
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	cdc_ncm_cfg.iad.bFirstInterface = bInterfaceNumber;
+#endif
+
+	ncm_ntb_tx_reset(&ntb_tx[0]);
+	ncm_ntb_tx_reset(&ntb_tx[1]);
+}
+
+USBD_CFG_DATA_DEFINE(primary, netusb) struct usb_cfg_data netusb_config = {
+	.usb_device_description = NULL,
+	.interface_config = ncm_interface_config,
+	.interface_descriptor = &cdc_ncm_cfg.if0,
+	.cb_usb_status = ncm_status_cb,
+	.interface = {
+		.class_handler = ncm_class_handler,
+		.custom_handler = NULL,
+		.vendor_handler = NULL,
+	},
+	.num_endpoints = ARRAY_SIZE(ncm_ep_data),
+	.endpoint = ncm_ep_data,
+};
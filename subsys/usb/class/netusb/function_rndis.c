@@ -213,8 +213,12 @@ static struct __rndis {
 static uint8_t manufacturer[] = CONFIG_USB_DEVICE_MANUFACTURER;
 static uint32_t drv_version = 1U;
 
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+static uint8_t tx_buf[CONFIG_RNDIS_BULK_EP_MPS];
+#else
 static uint8_t tx_buf[NET_ETH_MAX_FRAME_SIZE +
 				sizeof(struct rndis_payload_packet)];
+#endif
 
 static uint32_t object_id_supported[] = {
 	RNDIS_OBJECT_ID_GEN_SUPP_LIST,
@@ -977,11 +981,31 @@ static int rndis_send(struct net_pkt *pkt)
 		net_pkt_hexdump(pkt, "<");
 	}
 
-	if (len + sizeof(struct rndis_payload_packet) > sizeof(tx_buf)) {
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+	struct rndis_payload_packet hdr;
+	struct netusb_tx tx;
+
+	rndis_hdr_add((uint8_t *)&hdr, len);
+
+	netusb_tx_init(&tx, rndis_ep_data[RNDIS_IN_EP_IDX].ep_addr,
+		       tx_buf, sizeof(tx_buf));
+
+	ret = netusb_tx_write(&tx, (uint8_t *)&hdr, sizeof(hdr));
+	if (!ret) {
+		ret = netusb_tx_write_pkt(&tx, pkt);
+	}
+
+	if (ret) {
+		return ret;
+	}
+
+	return netusb_tx_finish(&tx);
+#else
 	rndis_hdr_add(tx_buf, len);
 
 	ret = net_pkt_read(pkt,
@@ -1000,6 +1024,7 @@ static int rndis_send(struct net_pkt *pkt)
 	}
 
 	return 0;
+#endif
 }
 
 #if defined(CONFIG_USB_DEVICE_OS_DESC)
@@ -62,6 +62,98 @@ void netusb_recv(struct net_pkt *pkt)
 	}
 }
 
+#ifdef CONFIG_USB_DEVICE_NETWORK_TX_SG
+static int netusb_tx_sync(struct netusb_tx *tx, const uint8_t *data,
+			  size_t len, unsigned int flags)
+{
+	int ret;
+
+	ret = usb_transfer_sync(tx->ep, (uint8_t *)data, len,
+				USB_TRANS_WRITE | flags);
+	if (ret != len) {
+		LOG_ERR("Transfer failure");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void netusb_tx_init(struct netusb_tx *tx, uint8_t ep,
+		    uint8_t *bounce, size_t bounce_size)
+{
+	tx->ep = ep;
+	tx->bounce = bounce;
+	tx->mps = usb_dc_ep_mps(ep);
+	tx->pending = 0U;
+
+	__ASSERT(tx->mps > 0 && tx->mps <= bounce_size,
+		 "Bounce buffer smaller than the MPS %u", tx->mps);
+}
+
+int netusb_tx_write(struct netusb_tx *tx, const uint8_t *data, size_t len)
+{
+	while (len > 0) {
+		size_t chunk;
+		int ret;
+
+		if (tx->pending > 0 || len < tx->mps) {
+			/* Packet spanning this buffer and the next one */
+			chunk = MIN(len, tx->mps - tx->pending);
+			memcpy(tx->bounce + tx->pending, data, chunk);
+			tx->pending += chunk;
+
+			if (tx->pending == tx->mps) {
+				ret = netusb_tx_sync(tx, tx->bounce, tx->mps,
+						     USB_TRANS_NO_ZLP);
+				tx->pending = 0U;
+			} else {
+				ret = 0;
+			}
+		} else {
+			/* Full packets, the transfer goes on after them */
+			chunk = ROUND_DOWN(len, tx->mps);
+			ret = netusb_tx_sync(tx, data, chunk,
+					     USB_TRANS_NO_ZLP);
+		}
+
+		if (ret) {
+			tx->pending = 0U;
+			return ret;
+		}
+
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+int netusb_tx_write_pkt(struct netusb_tx *tx, struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+	int ret;
+
+	for (buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+		ret = netusb_tx_write(tx, buf->data, buf->len);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int netusb_tx_finish(struct netusb_tx *tx)
+{
+	size_t len = tx->pending;
+
+	tx->pending = 0U;
+
+	/* The short packet, or zero-length one, ending the transfer */
+	return netusb_tx_sync(tx, tx->bounce, len, 0);
+}
+#endif /* CONFIG_USB_DEVICE_NETWORK_TX_SG */
+
 static int netusb_connect_media(void)
 {
 	LOG_DBG("");
@@ -19,6 +19,10 @@
 #define RNDIS_IN_EP_ADDR		0x82
 #define RNDIS_OUT_EP_ADDR		0x01
 
+#define CDC_NCM_INT_EP_ADDR		0x83
+#define CDC_NCM_IN_EP_ADDR		0x82
+#define CDC_NCM_OUT_EP_ADDR		0x01
+
 struct netusb_function {
 	int (*connect_media)(bool status);
 	int (*send_pkt)(struct net_pkt *pkt);
@@ -30,3 +34,21 @@ void netusb_recv(struct net_pkt *pkt);
 void netusb_enable(const struct netusb_function *func);
 void netusb_disable(void);
 bool netusb_enabled(void);
+
+/*
+ * Scatter-gather transmission: a frame is written buffer by buffer, the
+ * full packets straight from them and only the packets spanning two
+ * buffers through the bounce buffer, of the endpoint MPS.
+ */
+struct netusb_tx {
+	uint8_t *bounce;
+	uint16_t mps;
+	uint16_t pending;
+	uint8_t ep;
+};
+
+void netusb_tx_init(struct netusb_tx *tx, uint8_t ep,
+		    uint8_t *bounce, size_t bounce_size);
+int netusb_tx_write(struct netusb_tx *tx, const uint8_t *data, size_t len);
+int netusb_tx_write_pkt(struct netusb_tx *tx, struct net_pkt *pkt);
+int netusb_tx_finish(struct netusb_tx *tx);
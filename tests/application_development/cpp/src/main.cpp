@@ -65,10 +65,45 @@ static void test_new_delete(void)
 	delete test_foo;
 }
 
+#define NEW_DELETE_LOOPS 100
+#define NEW_DELETE_OBJECTS 4
+
+static void test_new_delete_cycles(void)
+{
+	foo_class *test_foos[NEW_DELETE_OBJECTS];
+	uint32_t start, cycles;
+	int i, j;
+
+	for (i = 0; i < NEW_DELETE_OBJECTS; i++) {
+		test_foos[i] = new foo_class(i);
+		zassert_not_null(test_foos[i], NULL);
+	}
+
+	for (i = 0; i < NEW_DELETE_OBJECTS; i++) {
+		zassert_equal(test_foos[i]->get_foo(), i, NULL);
+		delete test_foos[i];
+	}
+
+	start = k_cycle_get_32();
+	for (i = 0; i < NEW_DELETE_LOOPS; i++) {
+		for (j = 0; j < NEW_DELETE_OBJECTS; j++) {
+			test_foos[j] = new foo_class(j);
+		}
+		for (j = 0; j < NEW_DELETE_OBJECTS; j++) {
+			delete test_foos[j];
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("new and delete of %d objects: %u cycles\n",
+		 NEW_DELETE_LOOPS * NEW_DELETE_OBJECTS, cycles);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(cpp_tests,
-			 ztest_unit_test(test_new_delete)
+			 ztest_unit_test(test_new_delete),
+			 ztest_unit_test(test_new_delete_cycles)
 		);
 
 	ztest_run_test_suite(cpp_tests);
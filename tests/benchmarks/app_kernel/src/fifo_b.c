@@ -10,6 +10,8 @@
 
 #ifdef FIFO_BENCH
 
+static void kfifo_test(void);
+
 /**
  *
  * @brief Queue transfer speed test
@@ -84,6 +86,65 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT,
 			"enqueue 4 bytes in FIFO to a waiting higher priority task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	kfifo_test();
+}
+
+/* k_fifo items; the first word is reserved for the kernel */
+static struct {
+	void *fifo_reserved;
+} fifo_items[NR_OF_FIFO_RUNS];
+
+/**
+ *
+ * @brief k_fifo put/get speed test, locked and lock-free producer paths
+ *
+ * @return N/A
+ */
+static void kfifo_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&DEMOFIFO, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "put item in k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&DEMOFIFO, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "get item from k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put_lockfree(&DEMOFIFO, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "put item in k_fifo (lock-free path)",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&DEMOFIFO, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "get lock-free put item from k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 }
 
 #endif /* FIFO_BENCH */
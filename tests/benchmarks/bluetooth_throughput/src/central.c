@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/gatt.h>
+
+#include "throughput.h"
+
+static struct bt_conn *default_conn;
+static struct bt_gatt_exchange_params exchange_params;
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+static atomic_t received;
+
+static void start_scan(void);
+
+static uint8_t notify_func(struct bt_conn *conn,
+			   struct bt_gatt_subscribe_params *params,
+			   const void *data, uint16_t length)
+{
+	if (!data) {
+		params->value_handle = 0U;
+		return BT_GATT_ITER_STOP;
+	}
+
+	atomic_add(&received, length);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static uint8_t discover_func(struct bt_conn *conn,
+			     const struct bt_gatt_attr *attr,
+			     struct bt_gatt_discover_params *params)
+{
+	int err;
+
+	if (!attr) {
+		printk("Data characteristic not found\n");
+		return BT_GATT_ITER_STOP;
+	}
+
+	/* The CCC descriptor follows the characteristic value */
+	subscribe_params.notify = notify_func;
+	subscribe_params.value = BT_GATT_CCC_NOTIFY;
+	subscribe_params.value_handle = bt_gatt_attr_value_handle(attr);
+	subscribe_params.ccc_handle = subscribe_params.value_handle + 1;
+
+	err = bt_gatt_subscribe(conn, &subscribe_params);
+	if (err && err != -EALREADY) {
+		printk("Subscribe failed (err %d)\n", err);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void exchange_func(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	printk("MTU exchange %s, MTU %u\n", err ? "failed" : "done",
+	       bt_gatt_get_mtu(conn));
+
+	discover_params.uuid = BT_UUID_THROUGHPUT_DATA;
+	discover_params.func = discover_func;
+	discover_params.start_handle = 0x0001;
+	discover_params.end_handle = 0xffff;
+	discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+	err = bt_gatt_discover(conn, &discover_params);
+	if (err) {
+		printk("Discover failed (err %d)\n", err);
+	}
+}
+
+static bool ad_found(struct bt_data *data, void *user_data)
+{
+	bool *found = user_data;
+
+	if (data->type == BT_DATA_NAME_COMPLETE &&
+	    data->data_len == strlen(CONFIG_BT_DEVICE_NAME) &&
+	    !memcmp(data->data, CONFIG_BT_DEVICE_NAME, data->data_len)) {
+		*found = true;
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	bool found = false;
+	int err;
+
+	if (default_conn || type != BT_GAP_ADV_TYPE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(ad, ad_found, &found);
+	if (!found) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		printk("Stop LE scan failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN,
+				BT_LE_CONN_PARAM_DEFAULT, &default_conn);
+	if (err) {
+		printk("Create conn failed (err %d)\n", err);
+		start_scan();
+	}
+}
+
+static void start_scan(void)
+{
+	int err;
+
+	err = bt_le_scan_start(BT_LE_SCAN_ACTIVE, device_found);
+	if (err) {
+		printk("Scanning failed to start (err %d)\n", err);
+	}
+}
+
+static void connected(struct bt_conn *conn, uint8_t conn_err)
+{
+	int err;
+
+	if (conn_err) {
+		printk("Failed to connect (%u)\n", conn_err);
+		bt_conn_unref(default_conn);
+		default_conn = NULL;
+		start_scan();
+		return;
+	}
+
+	printk("Connected\n");
+
+	exchange_params.func = exchange_func;
+	err = bt_gatt_exchange_mtu(conn, &exchange_params);
+	if (err) {
+		printk("MTU exchange failed (err %d)\n", err);
+	}
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+
+	if (default_conn != conn) {
+		return;
+	}
+
+	bt_conn_unref(default_conn);
+	default_conn = NULL;
+	start_scan();
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+void role_run(void)
+{
+	bt_conn_cb_register(&conn_callbacks);
+	start_scan();
+
+	/* The peripheral reports the results, the received rate is a cross
+	 * check that the notifications actually reached the peer.
+	 */
+	while (1) {
+		uint32_t start = k_uptime_get_32();
+		uint32_t bytes;
+
+		k_sleep(K_SECONDS(1));
+		bytes = atomic_clear(&received);
+		if (bytes) {
+			printk("rx kbps %u\n",
+			       bytes * 8U / (k_uptime_get_32() - start));
+		}
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <bluetooth/bluetooth.h>
+
+#include "throughput.h"
+
+static void thread_usage(const struct k_thread *thread, void *user_data)
+{
+	struct cpu_usage *usage = user_data;
+	k_thread_runtime_stats_t stats;
+	const char *name;
+
+	name = k_thread_name_get((k_tid_t)thread);
+	if (!name || k_thread_runtime_stats_get((k_tid_t)thread, &stats)) {
+		return;
+	}
+
+	if (strncmp(name, "idle", 4) == 0) {
+		usage->idle += stats.execution_cycles;
+	} else if (strncmp(name, "BT", 2) == 0) {
+		usage->bt += stats.execution_cycles;
+	}
+}
+
+void cpu_usage_get(struct cpu_usage *usage)
+{
+	k_thread_runtime_stats_t stats;
+
+	(void)memset(usage, 0, sizeof(*usage));
+
+	k_thread_runtime_stats_all_get(&stats);
+	usage->total = stats.execution_cycles;
+
+	k_thread_foreach(thread_usage, usage);
+}
+
+void cpu_usage_diff(const struct cpu_usage *start,
+		    const struct cpu_usage *end,
+		    uint32_t *busy, uint32_t *bt)
+{
+	uint64_t total = end->total - start->total;
+
+	if (!total) {
+		*busy = 0U;
+		*bt = 0U;
+		return;
+	}
+
+	*busy = 100U - (uint32_t)((end->idle - start->idle) * 100U / total);
+	*bt = (uint32_t)((end->bt - start->bt) * 100U / total);
+}
+
+void main(void)
+{
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	role_run();
+}
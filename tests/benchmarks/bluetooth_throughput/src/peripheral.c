@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <string.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/gatt.h>
+
+#include "throughput.h"
+
+/* Notifications in flight, each one has a slot for its send time */
+#define TX_SLOTS 16
+#define LAT_SAMPLES 4096
+
+struct step {
+	uint16_t interval; /* 1.25 ms units */
+	uint8_t phy;
+	uint16_t data_len;
+};
+
+static const struct step steps[] = {
+	{ 6, BT_GAP_LE_PHY_1M, BT_GAP_DATA_LEN_DEFAULT },
+	{ 6, BT_GAP_LE_PHY_1M, BT_GAP_DATA_LEN_MAX },
+	{ 6, BT_GAP_LE_PHY_2M, BT_GAP_DATA_LEN_DEFAULT },
+	{ 6, BT_GAP_LE_PHY_2M, BT_GAP_DATA_LEN_MAX },
+	{ 40, BT_GAP_LE_PHY_2M, BT_GAP_DATA_LEN_MAX },
+	{ 80, BT_GAP_LE_PHY_2M, BT_GAP_DATA_LEN_MAX },
+};
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA(BT_DATA_NAME_COMPLETE, CONFIG_BT_DEVICE_NAME,
+		sizeof(CONFIG_BT_DEVICE_NAME) - 1),
+};
+
+static struct bt_conn *default_conn;
+static K_SEM_DEFINE(subscribed_sem, 0, 1);
+static K_SEM_DEFINE(tx_sem, TX_SLOTS, TX_SLOTS);
+static bool subscribed;
+
+static uint8_t payload[CONFIG_BT_L2CAP_TX_MTU - 3];
+static uint16_t payload_len;
+static uint32_t sent_at[TX_SLOTS];
+static uint32_t lat[LAT_SAMPLES];
+static uint32_t lat_count;
+static uint32_t completed;
+
+static void ccc_cfg_changed(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	subscribed = (value == BT_GATT_CCC_NOTIFY);
+	if (subscribed) {
+		k_sem_give(&subscribed_sem);
+	}
+}
+
+BT_GATT_SERVICE_DEFINE(throughput_svc,
+	BT_GATT_PRIMARY_SERVICE(BT_UUID_THROUGHPUT),
+	BT_GATT_CHARACTERISTIC(BT_UUID_THROUGHPUT_DATA, BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_NONE, NULL, NULL, NULL),
+	BT_GATT_CCC(ccc_cfg_changed, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+);
+
+/* Called once the packet has been acknowledged by the peer */
+static void notify_complete(struct bt_conn *conn, void *user_data)
+{
+	uint32_t slot = POINTER_TO_UINT(user_data);
+
+	if (lat_count < ARRAY_SIZE(lat)) {
+		lat[lat_count++] = k_cycle_get_32() - sent_at[slot];
+	}
+
+	completed += payload_len;
+	k_sem_give(&tx_sem);
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err) {
+		printk("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	printk("Connected\n");
+	default_conn = bt_conn_ref(conn);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+
+	subscribed = false;
+	if (default_conn) {
+		bt_conn_unref(default_conn);
+		default_conn = NULL;
+	}
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void sort_lat(uint32_t *v, size_t n)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		size_t j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+static const char *phy_str(uint8_t phy)
+{
+	switch (phy) {
+	case BT_GAP_LE_PHY_1M:
+		return "1M";
+	case BT_GAP_LE_PHY_2M:
+		return "2M";
+	case BT_GAP_LE_PHY_CODED:
+		return "coded";
+	default:
+		return "?";
+	}
+}
+
+static int step_apply(struct bt_conn *conn, const struct step *step)
+{
+	int err;
+
+	err = bt_conn_le_param_update(conn,
+				      BT_LE_CONN_PARAM(step->interval,
+						       step->interval, 0, 400));
+	if (err && err != -EALREADY) {
+		printk("Connection update failed (err %d)\n", err);
+		return err;
+	}
+
+	err = bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM(step->phy,
+							       step->phy));
+	if (err) {
+		printk("PHY update failed (err %d)\n", err);
+		return err;
+	}
+
+	err = bt_conn_le_data_len_update(conn,
+				BT_CONN_LE_DATA_LEN_PARAM(step->data_len,
+							  BT_GAP_DATA_TIME_MAX));
+	if (err) {
+		printk("Data length update failed (err %d)\n", err);
+		return err;
+	}
+
+	/* Give the procedures time to complete */
+	k_sleep(K_SECONDS(2));
+
+	return 0;
+}
+
+static int step_run(struct bt_conn *conn, int index)
+{
+	struct bt_gatt_notify_params params = {
+		.attr = &throughput_svc.attrs[1],
+		.data = payload,
+		.func = notify_complete,
+	};
+	struct cpu_usage cpu_start, cpu_end;
+	uint32_t start, elapsed, seq = 0U;
+	uint32_t busy, bt;
+	struct bt_conn_info info;
+	int err = 0;
+
+	payload_len = MIN(bt_gatt_get_mtu(conn) - 3, sizeof(payload));
+	params.len = payload_len;
+	lat_count = 0U;
+	completed = 0U;
+
+	cpu_usage_get(&cpu_start);
+	start = k_uptime_get_32();
+
+	while (k_uptime_get_32() - start <
+	       CONFIG_BT_THROUGHPUT_STEP_DURATION * MSEC_PER_SEC) {
+		uint32_t slot;
+
+		if (k_sem_take(&tx_sem, K_MSEC(100))) {
+			continue;
+		}
+
+		if (!subscribed) {
+			k_sem_give(&tx_sem);
+			return -ENOTCONN;
+		}
+
+		slot = seq++ % TX_SLOTS;
+		sent_at[slot] = k_cycle_get_32();
+		params.user_data = UINT_TO_POINTER(slot);
+
+		err = bt_gatt_notify_cb(conn, &params);
+		if (err) {
+			k_sem_give(&tx_sem);
+			if (err != -ENOMEM) {
+				printk("Notify failed (err %d)\n", err);
+				return err;
+			}
+
+			k_yield();
+		}
+	}
+
+	/* Wait for the notifications in flight */
+	for (int i = 0; i < TX_SLOTS; i++) {
+		k_sem_take(&tx_sem, K_SECONDS(1));
+	}
+
+	elapsed = k_uptime_get_32() - start;
+	cpu_usage_get(&cpu_end);
+	k_sem_reset(&tx_sem);
+	for (int i = 0; i < TX_SLOTS; i++) {
+		k_sem_give(&tx_sem);
+	}
+
+	cpu_usage_diff(&cpu_start, &cpu_end, &busy, &bt);
+	sort_lat(lat, lat_count);
+	bt_conn_get_info(conn, &info);
+
+	if (!lat_count) {
+		printk("step %d: no notification completed\n", index);
+		return -EIO;
+	}
+
+	printk("step %d interval %u us phy %s data_len %u mtu %u kbps %u "
+	       "p50 %u us p99 %u us cpu %u%% bt %u%%\n", index,
+	       info.le.interval * 1250U, phy_str(info.le.phy->tx_phy),
+	       info.le.data_len->tx_max_len, bt_gatt_get_mtu(conn),
+	       completed * 8U / elapsed,
+	       k_cyc_to_us_floor32(lat[lat_count / 2]),
+	       k_cyc_to_us_floor32(lat[lat_count * 99 / 100]), busy, bt);
+
+	return 0;
+}
+
+void role_run(void)
+{
+	int err;
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("Waiting for a subscribed central\n");
+	k_sem_take(&subscribed_sem, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(steps); i++) {
+		struct bt_conn *conn = default_conn;
+
+		if (!conn || step_apply(conn, &steps[i]) ||
+		    step_run(conn, i)) {
+			printk("Benchmark aborted\n");
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
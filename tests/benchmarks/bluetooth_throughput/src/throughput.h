@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef THROUGHPUT_H_
+#define THROUGHPUT_H_
+
+#include <bluetooth/uuid.h>
+
+#define BT_UUID_THROUGHPUT_VAL \
+	BT_UUID_128_ENCODE(0x6e1f0001, 0x8c5a, 0x4d5e, 0x9c2b, 0x2f43b1a7d0c4)
+#define BT_UUID_THROUGHPUT_DATA_VAL \
+	BT_UUID_128_ENCODE(0x6e1f0002, 0x8c5a, 0x4d5e, 0x9c2b, 0x2f43b1a7d0c4)
+
+#define BT_UUID_THROUGHPUT BT_UUID_DECLARE_128(BT_UUID_THROUGHPUT_VAL)
+#define BT_UUID_THROUGHPUT_DATA \
+	BT_UUID_DECLARE_128(BT_UUID_THROUGHPUT_DATA_VAL)
+
+/* CPU time of the whole system and of the Bluetooth threads */
+struct cpu_usage {
+	uint64_t total;
+	uint64_t idle;
+	uint64_t bt;
+};
+
+void cpu_usage_get(struct cpu_usage *usage);
+
+/* Percentages of busy and Bluetooth thread time between two samples */
+void cpu_usage_diff(const struct cpu_usage *start,
+		    const struct cpu_usage *end,
+		    uint32_t *busy, uint32_t *bt);
+
+void role_run(void);
+
+#endif /* THROUGHPUT_H_ */
@@ -10,14 +10,90 @@
  * @brief Measure boot time
  *
  * Measuring the boot time
- *  1. From __start to main()
- *  2. From __start to task
- *  3. From __start to idle
+ *  1. From __start to the end of the PRE_KERNEL and POST_KERNEL init levels
+ *  2. From __start to main()
+ *  3. From __start to task
+ *  4. From __start to idle
+ *
+ * along with the size of the sections cleared and copied at boot, and the
+ * speed of the routines doing it.
  */
 
 #include <zephyr.h>
 #include <tc_util.h>
 #include <kernel_internal.h>
+#include <init.h>
+#include <linker/linker-defs.h>
+#include <string.h>
+
+#define EARLY_MEM_BUF_SIZE 1024
+#define EARLY_MEM_RUNS 16
+
+static uint8_t __aligned(sizeof(uintptr_t))
+	early_mem_buf[2][EARLY_MEM_BUF_SIZE];
+
+#if CONFIG_BOOT_TIME_SLOW_INITS > 0
+/* Stands in for a driver waiting on its hardware during init */
+static int slow_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_sleep(K_MSEC(CONFIG_BOOT_TIME_SLOW_INIT_MS));
+
+	return 0;
+}
+
+#define SLOW_INIT_DEFINE(i, _) \
+	SYS_INIT(slow_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+UTIL_LISTIFY(CONFIG_BOOT_TIME_SLOW_INITS, SLOW_INIT_DEFINE, _)
+#endif
+
+static uint32_t cyc_to_us(uint32_t cycles)
+{
+	return (uint32_t)ceiling_fraction(USEC_PER_SEC * (uint64_t)cycles,
+					  sys_clock_hw_cycles_per_sec());
+}
+
+/* Cycles taken to clear, or copy, one KiB */
+static uint32_t early_mem_cycles(bool copy, bool early)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < EARLY_MEM_RUNS; i++) {
+		if (copy && early) {
+			z_early_memcpy(early_mem_buf[0], early_mem_buf[1],
+				       EARLY_MEM_BUF_SIZE);
+		} else if (copy) {
+			(void)memcpy(early_mem_buf[0], early_mem_buf[1],
+				     EARLY_MEM_BUF_SIZE);
+		} else if (early) {
+			z_early_memset(early_mem_buf[0], 0, EARLY_MEM_BUF_SIZE);
+		} else {
+			(void)memset(early_mem_buf[0], 0, EARLY_MEM_BUF_SIZE);
+		}
+	}
+
+	return (k_cycle_get_32() - start) /
+	       (EARLY_MEM_RUNS * EARLY_MEM_BUF_SIZE / 1024);
+}
+
+static void ram_sections_print(void)
+{
+	uint32_t data_size = 0;
+
+#ifdef CONFIG_XIP
+	data_size = __data_ram_end - __data_ram_start;
+#endif
+
+	TC_PRINT("bss: %u bytes, data: %u bytes, noinit: %u bytes\n",
+		 (uint32_t)(__bss_end - __bss_start), data_size,
+		 (uint32_t)(__noinit_end - __noinit_start));
+	TC_PRINT("early clear   : %u cycles/KiB (memset: %u)\n",
+		 early_mem_cycles(false, true), early_mem_cycles(false, false));
+	TC_PRINT("early copy    : %u cycles/KiB (memcpy: %u)\n",
+		 early_mem_cycles(true, true), early_mem_cycles(true, false));
+}
 
 void main(void)
 {
@@ -33,25 +109,30 @@ void main(void)
 	 */
 	k_sleep(K_MSEC(1));
 
-	main_us = (uint32_t)ceiling_fraction(USEC_PER_SEC *
-					  (uint64_t)z_timestamp_main,
-					  sys_clock_hw_cycles_per_sec());
-	task_us = (uint32_t)ceiling_fraction(USEC_PER_SEC *
-					  (uint64_t)task_time_stamp,
-					  sys_clock_hw_cycles_per_sec());
-	idle_us = (uint32_t)ceiling_fraction(USEC_PER_SEC *
-					  (uint64_t)z_timestamp_idle,
-					  sys_clock_hw_cycles_per_sec());
+	main_us = cyc_to_us(z_timestamp_main);
+	task_us = cyc_to_us(task_time_stamp);
+	idle_us = cyc_to_us(z_timestamp_idle);
 
 	TC_START("Boot Time Measurement");
 	TC_PRINT("Boot Result: Clock Frequency: %d Hz\n",
 					  sys_clock_hw_cycles_per_sec());
+	TC_PRINT("_start->pre-kernel : %u cycles, %u us\n",
+		 z_timestamp_pre_kernel, cyc_to_us(z_timestamp_pre_kernel));
+	TC_PRINT("_start->post-kernel: %u cycles, %u us\n",
+		 z_timestamp_post_kernel, cyc_to_us(z_timestamp_post_kernel));
 	TC_PRINT("_start->main(): %u cycles, %u us\n", z_timestamp_main,
 						       main_us);
 	TC_PRINT("_start->task  : %u cycles, %u us\n", task_time_stamp,
 						       task_us);
 	TC_PRINT("_start->idle  : %u cycles, %u us\n", z_timestamp_idle,
 						       idle_us);
+#if CONFIG_BOOT_TIME_SLOW_INITS > 0
+	TC_PRINT("slow inits    : %d x %d ms, %s\n",
+		 CONFIG_BOOT_TIME_SLOW_INITS, CONFIG_BOOT_TIME_SLOW_INIT_MS,
+		 IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL) ?
+		 "parallel" : "sequential");
+#endif
+	ram_sections_print();
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	TC_END_RESULT(TC_PASS);
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/rb.h>
+#include <sys/btree.h>
+
+/* Compares the B-tree to the red/black tree on the same workload: N
+ * elements with scattered keys are inserted, each of them is looked up,
+ * the whole set is walked in order and then every element is removed.
+ * Cycle counts per operation are printed for several set sizes.
+ */
+
+#define MAX_ELEMS 1024
+
+struct elem {
+	struct rbnode node;
+	uint32_t key;
+};
+
+static struct elem elems[MAX_ELEMS];
+static struct rbtree rb;
+static struct btree bt;
+static struct btree_node
+	bt_nodes[MAX_ELEMS / (CONFIG_BTREE_FANOUT / 2 - 1) + 1];
+
+static const int elem_counts[] = { 16, 128, MAX_ELEMS };
+
+struct cycles {
+	uint32_t insert;
+	uint32_t lookup;
+	uint32_t walk;
+	uint32_t remove;
+};
+
+static bool rb_elem_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct elem, node)->key <
+	       CONTAINER_OF(b, struct elem, node)->key;
+}
+
+static bool bt_elem_lessthan(const void *a, const void *b)
+{
+	return ((const struct elem *)a)->key < ((const struct elem *)b)->key;
+}
+
+static void setup_elems(int count)
+{
+	for (int i = 0; i < count; i++) {
+		/* Scatter keys so insertion order is not sorted */
+		elems[i].key = (i * 2654435761U) % (4 * MAX_ELEMS);
+	}
+}
+
+static void run_rbtree(int count, struct cycles *c)
+{
+	struct rbnode *node;
+	uint32_t start, key = 0U;
+	int n = 0;
+
+	rb = (struct rbtree) { .lessthan_fn = rb_elem_lessthan };
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		rb_insert(&rb, &elems[i].node);
+	}
+	c->insert = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		zassert_true(rb_contains(&rb, &elems[i].node), "rb lookup");
+	}
+	c->lookup = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	RB_FOR_EACH(&rb, node) {
+		struct elem *e = CONTAINER_OF(node, struct elem, node);
+
+		zassert_true(e->key >= key, "rb order");
+		key = e->key;
+		n++;
+	}
+	c->walk = k_cycle_get_32() - start;
+	zassert_equal(n, count, "rb walk");
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		rb_remove(&rb, &elems[i].node);
+	}
+	c->remove = k_cycle_get_32() - start;
+	zassert_is_null(rb_get_min(&rb), "rb not empty");
+}
+
+static void run_btree(int count, struct cycles *c)
+{
+	struct elem *e;
+	uint32_t start, key = 0U;
+	int n = 0;
+
+	btree_init(&bt, bt_elem_lessthan, bt_nodes, ARRAY_SIZE(bt_nodes));
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		zassert_equal(btree_insert(&bt, &elems[i]), 0, "btree insert");
+	}
+	c->insert = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		zassert_true(btree_contains(&bt, &elems[i]), "btree lookup");
+	}
+	c->lookup = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	BTREE_FOR_EACH(&bt, e) {
+		zassert_true(e->key >= key, "btree order");
+		key = e->key;
+		n++;
+	}
+	c->walk = k_cycle_get_32() - start;
+	zassert_equal(n, count, "btree walk");
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		zassert_equal(btree_remove(&bt, &elems[i]), 0, "btree remove");
+	}
+	c->remove = k_cycle_get_32() - start;
+	zassert_equal(btree_count(&bt), 0, "btree not empty");
+}
+
+static void print_cycles(const char *name, int count, struct cycles *c)
+{
+	TC_PRINT("%-6s elems %4d insert %5u lookup %5u walk %4u remove %5u"
+		 " (cycles per op)\n", name, count, c->insert / count,
+		 c->lookup / count, c->walk / count, c->remove / count);
+}
+
+/**
+ * @brief Compare the B-tree to the red/black tree
+ *
+ * @details Runs the same inserts, lookups, in order walk and removals
+ * through both trees at increasing sizes, verifying the order of the
+ * walks and printing the average cost of each operation.
+ *
+ * @ingroup lib_rbtree_tests
+ */
+void test_btree_perf(void)
+{
+	struct cycles c;
+
+	TC_PRINT("btree fanout %d\n", CONFIG_BTREE_FANOUT);
+
+	for (int i = 0; i < ARRAY_SIZE(elem_counts); i++) {
+		setup_elems(elem_counts[i]);
+
+		run_rbtree(elem_counts[i], &c);
+		print_cycles("rbtree", elem_counts[i], &c);
+
+		run_btree(elem_counts[i], &c);
+		print_cycles("btree", elem_counts[i], &c);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(btree_perf,
+			 ztest_unit_test(test_btree_perf));
+	ztest_run_test_suite(btree_perf);
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sched_priq.h>
+
+/* Compares the three scheduler priority queue backends (dumb list,
+ * red/black tree and multi-queue) on the same workload: N threads with
+ * priorities spread over the whole configured range are added, then
+ * repeatedly "best" is taken and removed until the queue is empty,
+ * which is what the scheduler does as threads become ready and get
+ * switched in.  Cycle counts per operation are printed for several
+ * thread counts, and each backend is checked to hand threads back in
+ * priority order.
+ */
+
+#define MAX_THREADS 128
+#define N_PRIOS (K_LOWEST_APPLICATION_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+static struct k_thread threads[MAX_THREADS];
+
+static const int thread_counts[] = { 4, 16, 64, MAX_THREADS };
+
+static sys_dlist_t dumb_q;
+static struct _priq_rb rb_q;
+static struct _priq_mq mq_q;
+
+struct priq_ops {
+	const char *name;
+	void (*init)(void);
+	void (*add)(struct k_thread *thread);
+	void (*remove)(struct k_thread *thread);
+	struct k_thread *(*best)(void);
+};
+
+static void dumb_init(void)
+{
+	sys_dlist_init(&dumb_q);
+}
+
+static void dumb_add(struct k_thread *thread)
+{
+	z_priq_dumb_add(&dumb_q, thread);
+}
+
+static void dumb_remove(struct k_thread *thread)
+{
+	z_priq_dumb_remove(&dumb_q, thread);
+}
+
+static struct k_thread *dumb_best(void)
+{
+	return z_priq_dumb_best(&dumb_q);
+}
+
+static void rb_init(void)
+{
+	rb_q = (struct _priq_rb) {
+		.tree = {
+			.lessthan_fn = z_priq_rb_lessthan,
+		}
+	};
+}
+
+static void rb_add(struct k_thread *thread)
+{
+	z_priq_rb_add(&rb_q, thread);
+}
+
+static void rb_remove(struct k_thread *thread)
+{
+	z_priq_rb_remove(&rb_q, thread);
+}
+
+static struct k_thread *rb_best(void)
+{
+	return z_priq_rb_best(&rb_q);
+}
+
+static void mq_init(void)
+{
+	memset(&mq_q, 0, sizeof(mq_q));
+	for (int i = 0; i < ARRAY_SIZE(mq_q.queues); i++) {
+		sys_dlist_init(&mq_q.queues[i]);
+	}
+}
+
+static void mq_add(struct k_thread *thread)
+{
+	z_priq_mq_add(&mq_q, thread);
+}
+
+static void mq_remove(struct k_thread *thread)
+{
+	z_priq_mq_remove(&mq_q, thread);
+}
+
+static struct k_thread *mq_best(void)
+{
+	return z_priq_mq_best(&mq_q);
+}
+
+static const struct priq_ops backends[] = {
+	{ "dumb", dumb_init, dumb_add, dumb_remove, dumb_best },
+	{ "rbtree", rb_init, rb_add, rb_remove, rb_best },
+	{ "multiq", mq_init, mq_add, mq_remove, mq_best },
+};
+
+static void setup_threads(int count)
+{
+	for (int i = 0; i < count; i++) {
+		/* Scatter priorities so insertion order is not sorted */
+		threads[i].base.prio = K_HIGHEST_THREAD_PRIO +
+			((i * 7) % N_PRIOS);
+	}
+}
+
+static void run_backend(const struct priq_ops *ops, int count)
+{
+	uint32_t start, add_cycles, pop_cycles = 0U;
+	int last_prio = K_HIGHEST_THREAD_PRIO;
+
+	ops->init();
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < count; i++) {
+		ops->add(&threads[i]);
+	}
+	add_cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < count; i++) {
+		struct k_thread *thread;
+
+		start = k_cycle_get_32();
+		thread = ops->best();
+		ops->remove(thread);
+		pop_cycles += k_cycle_get_32() - start;
+
+		zassert_not_null(thread, "%s: queue empty early", ops->name);
+		zassert_true(thread->base.prio >= last_prio,
+			     "%s: priority order violated", ops->name);
+		last_prio = thread->base.prio;
+	}
+
+	zassert_is_null(ops->best(), "%s: queue not empty", ops->name);
+
+	TC_PRINT("%-6s threads %3d add %6u best+remove %6u"
+		 " (cycles per op)\n", ops->name, count,
+		 add_cycles / count, pop_cycles / count);
+}
+
+/**
+ * @brief Compare scheduler priority queue backends
+ *
+ * @details Adds and drains the same set of threads through every
+ * priq backend at increasing thread counts, verifying each hands
+ * threads back in priority order and printing the average cost of
+ * an add and of a best+remove pair.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_priq_perf(void)
+{
+	for (int c = 0; c < ARRAY_SIZE(thread_counts); c++) {
+		setup_threads(thread_counts[c]);
+
+		for (int b = 0; b < ARRAY_SIZE(backends); b++) {
+			run_backend(&backends[b], thread_counts[c]);
+		}
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(priq_perf,
+			 ztest_unit_test(test_priq_perf));
+	ztest_run_test_suite(priq_perf);
+}
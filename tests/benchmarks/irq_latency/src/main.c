@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#ifdef CONFIG_IRQ_LATENCY_COUNTER
+#include <drivers/counter.h>
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_LOAD_FLASH
+#include <storage/flash_map.h>
+#include <drivers/flash.h>
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_LOAD_LOGGING
+#include <logging/log.h>
+LOG_MODULE_REGISTER(irq_latency, LOG_LEVEL_INF);
+#endif
+
+#define SAMPLES CONFIG_IRQ_LATENCY_SAMPLES
+#define PERIOD_US CONFIG_IRQ_LATENCY_PERIOD_US
+
+/* Power of two buckets in microseconds, the last one takes the rest */
+#define HIST_BUCKETS 12
+
+#define LOAD_STACK_SIZE 1024
+#define LOAD_PRIO K_LOWEST_APPLICATION_THREAD_PRIO
+
+static uint32_t isr_lat[SAMPLES];
+static uint32_t wakeup_lat[SAMPLES];
+
+/* Written by the ISR, read by the measuring thread once woken up */
+static volatile uint32_t isr_cycle;
+static volatile uint32_t isr_ns;
+static K_SEM_DEFINE(isr_sem, 0, 1);
+
+static bool loaded;
+static uint32_t load_count;
+
+#ifdef CONFIG_IRQ_LATENCY_COUNTER
+static const struct device *counter;
+static struct counter_alarm_cfg alarm_cfg;
+static uint32_t period_ticks;
+
+static uint32_t counter_ticks_to_ns(uint32_t ticks)
+{
+	return (uint32_t)((uint64_t)ticks * NSEC_PER_SEC /
+			  counter_get_frequency(counter));
+}
+
+/* Counter ticks from a to b, in the counting direction, across wraps */
+static uint32_t counter_distance(uint32_t a, uint32_t b)
+{
+	uint64_t top = (uint64_t)counter_get_top_value(counter) + 1;
+
+	if (!counter_is_counting_up(counter)) {
+		uint32_t tmp = a;
+
+		a = b;
+		b = tmp;
+	}
+
+	return (uint32_t)(((uint64_t)b + top - a) % top);
+}
+
+/* Counter value one period after the given one */
+static uint32_t counter_next(uint32_t ticks)
+{
+	uint64_t top = (uint64_t)counter_get_top_value(counter) + 1;
+
+	if (counter_is_counting_up(counter)) {
+		return (uint32_t)(((uint64_t)ticks + period_ticks) % top);
+	}
+
+	return (uint32_t)(((uint64_t)ticks + top - period_ticks) % top);
+}
+
+static void counter_isr(const struct device *dev, uint8_t chan_id,
+			uint32_t ticks, void *user_data)
+{
+	uint32_t now;
+
+	isr_cycle = k_cycle_get_32();
+	(void)counter_get_value(dev, &now);
+
+	isr_ns = counter_ticks_to_ns(counter_distance(ticks, now));
+
+	alarm_cfg.ticks = counter_next(ticks);
+	(void)counter_set_channel_alarm(dev, 0, &alarm_cfg);
+	k_sem_give(&isr_sem);
+}
+
+static int source_start(void)
+{
+	uint32_t now;
+	int rc;
+
+	counter = device_get_binding(CONFIG_IRQ_LATENCY_COUNTER_NAME);
+	if (counter == NULL) {
+		return -ENODEV;
+	}
+
+	period_ticks = counter_us_to_ticks(counter, PERIOD_US);
+
+	rc = counter_start(counter);
+	if (rc && rc != -EALREADY) {
+		return rc;
+	}
+
+	(void)counter_get_value(counter, &now);
+
+	alarm_cfg.flags = COUNTER_ALARM_CFG_ABSOLUTE |
+			  COUNTER_ALARM_CFG_EXPIRE_WHEN_LATE;
+	alarm_cfg.callback = counter_isr;
+	alarm_cfg.ticks = counter_next(now);
+
+	return counter_set_channel_alarm(counter, 0, &alarm_cfg);
+}
+
+static void source_stop(void)
+{
+	(void)counter_cancel_channel_alarm(counter, 0);
+}
+#else
+static uint32_t period_cycles;
+static uint32_t last_cycle;
+static bool first;
+
+/*
+ * The kernel timer expiry is not latched in hardware, the ISR entry
+ * latency is estimated from how far the interval between two expiries
+ * is from the timer period.
+ */
+static void timer_isr(struct k_timer *timer)
+{
+	uint32_t now = k_cycle_get_32();
+	uint32_t interval = now - last_cycle;
+
+	last_cycle = now;
+	if (first) {
+		first = false;
+		return;
+	}
+
+	isr_cycle = now;
+	isr_ns = (uint32_t)k_cyc_to_ns_floor64(interval > period_cycles ?
+					       interval - period_cycles :
+					       period_cycles - interval);
+	k_sem_give(&isr_sem);
+}
+
+static K_TIMER_DEFINE(timer, timer_isr, NULL);
+
+static int source_start(void)
+{
+	k_timeout_t period = K_USEC(PERIOD_US);
+
+	period_cycles = k_ticks_to_cyc_floor32(period.ticks);
+	first = true;
+	last_cycle = k_cycle_get_32();
+	k_timer_start(&timer, period, period);
+
+	return 0;
+}
+
+static void source_stop(void)
+{
+	k_timer_stop(&timer);
+}
+#endif /* CONFIG_IRQ_LATENCY_COUNTER */
+
+#if CONFIG_IRQ_LATENCY_LOAD_IRQ_LOCK_US > 0
+static void irq_lock_load(void *p1, void *p2, void *p3)
+{
+	unsigned int key;
+
+	while (loaded) {
+		key = irq_lock();
+		k_busy_wait(CONFIG_IRQ_LATENCY_LOAD_IRQ_LOCK_US);
+		irq_unlock(key);
+		load_count++;
+		k_busy_wait(CONFIG_IRQ_LATENCY_LOAD_IRQ_LOCK_US);
+	}
+}
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_LOAD_LOGGING
+static void logging_load(void *p1, void *p2, void *p3)
+{
+	while (loaded) {
+		LOG_INF("load message %u", load_count++);
+		k_yield();
+	}
+}
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_LOAD_FLASH
+static void flash_load(void *p1, void *p2, void *p3)
+{
+	const struct flash_area *fap;
+	struct flash_pages_info page;
+	uint8_t buf[64];
+
+	if (flash_area_open(FLASH_AREA_ID(storage), &fap) ||
+	    flash_get_page_info_by_offs(flash_area_get_device(fap),
+					fap->fa_off, &page)) {
+		printk("Cannot open the storage partition\n");
+		return;
+	}
+
+	while (loaded) {
+		if (flash_area_erase(fap, 0, page.size)) {
+			break;
+		}
+
+		for (off_t off = 0; off + sizeof(buf) <= page.size && loaded;
+		     off += sizeof(buf)) {
+			(void)memset(buf, load_count, sizeof(buf));
+			(void)flash_area_write(fap, off, buf, sizeof(buf));
+		}
+		load_count++;
+	}
+
+	flash_area_close(fap);
+}
+#endif
+
+static const k_thread_entry_t loads[] = {
+#if CONFIG_IRQ_LATENCY_LOAD_IRQ_LOCK_US > 0
+	irq_lock_load,
+#endif
+#ifdef CONFIG_IRQ_LATENCY_LOAD_LOGGING
+	logging_load,
+#endif
+#ifdef CONFIG_IRQ_LATENCY_LOAD_FLASH
+	flash_load,
+#endif
+};
+
+#define NUM_LOADS MAX(ARRAY_SIZE(loads), 1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(load_stacks, NUM_LOADS, LOAD_STACK_SIZE);
+static struct k_thread load_threads[NUM_LOADS];
+
+static void loads_start(void)
+{
+	loaded = true;
+	load_count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(loads); i++) {
+		k_thread_create(&load_threads[i], load_stacks[i],
+				LOAD_STACK_SIZE, loads[i], NULL, NULL, NULL,
+				LOAD_PRIO, 0, K_NO_WAIT);
+	}
+}
+
+static void loads_stop(void)
+{
+	loaded = false;
+
+	for (int i = 0; i < ARRAY_SIZE(loads); i++) {
+		k_thread_join(&load_threads[i], K_FOREVER);
+	}
+}
+
+static void sort_lat(uint32_t *v, size_t n)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		size_t j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+static void report(const char *phase, const char *name, uint32_t *v,
+		   size_t n)
+{
+	uint32_t hist[HIST_BUCKETS] = { 0 };
+	uint64_t sum = 0;
+
+	if (n == 0) {
+		printk("%s %s no samples\n", phase, name);
+		return;
+	}
+
+	sort_lat(v, n);
+
+	for (size_t i = 0; i < n; i++) {
+		uint32_t us = v[i] / NSEC_PER_USEC;
+		int b = 0;
+
+		while (us > 0 && b < HIST_BUCKETS - 1) {
+			us >>= 1;
+			b++;
+		}
+
+		hist[b]++;
+		sum += v[i];
+	}
+
+	printk("%s %-6s min %7u avg %7u p99 %7u max %7u ns\n", phase, name,
+	       v[0], (uint32_t)(sum / n), v[n * 99 / 100], v[n - 1]);
+
+	printk("%s %-6s hist", phase, name);
+	for (int b = 0; b < HIST_BUCKETS; b++) {
+		printk(" %u", hist[b]);
+	}
+	printk("\n");
+}
+
+static void run(const char *phase)
+{
+	uint32_t overruns = 0;
+	size_t n = 0;
+	int rc;
+
+	(void)k_sem_take(&isr_sem, K_NO_WAIT);
+
+	rc = source_start();
+	if (rc) {
+		printk("Cannot start the interrupt source (%d)\n", rc);
+		return;
+	}
+
+	while (n < SAMPLES) {
+		if (k_sem_take(&isr_sem, K_USEC(100 * PERIOD_US))) {
+			printk("%s interrupt source stalled\n", phase);
+			break;
+		}
+
+		wakeup_lat[n] = (uint32_t)k_cyc_to_ns_floor64(k_cycle_get_32() -
+							      isr_cycle);
+		isr_lat[n] = isr_ns;
+		n++;
+
+		/* Another interrupt came before this one was handled */
+		if (k_sem_count_get(&isr_sem) > 0) {
+			overruns++;
+		}
+	}
+
+	source_stop();
+
+	report(phase, "isr", isr_lat, n);
+	report(phase, "wakeup", wakeup_lat, n);
+	printk("%s overruns %u\n", phase, overruns);
+}
+
+void main(void)
+{
+	/* The measuring thread preempts the loads as soon as it is woken up */
+	k_thread_priority_set(k_current_get(),
+			      K_HIGHEST_APPLICATION_THREAD_PRIO);
+
+	printk("source %s period %u us samples %u\n",
+	       IS_ENABLED(CONFIG_IRQ_LATENCY_COUNTER) ? "counter" : "timer",
+	       PERIOD_US, SAMPLES);
+
+	run("idle");
+
+	if (ARRAY_SIZE(loads) > 0) {
+		loads_start();
+		run("load");
+		loads_stop();
+		printk("load iterations %u\n", load_count);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief measure preemptive switches between FP-capable threads
+ *
+ * An FP-capable thread using the FPU is preempted from an interrupt by a
+ * higher priority FP-capable thread which does not use it, and resumes.
+ * Depending on the FP sharing scheme, the floating point context is saved
+ * and restored on every round trip, or left in place.
+ */
+
+#include <zephyr.h>
+#include <irq_offload.h>
+
+#include "utils.h"
+
+#ifdef CONFIG_FPU_SHARING
+
+#define NB_OF_SWITCHES	1000
+#define FP_STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_THREAD_STACK_DEFINE(fp_user_stack, FP_STACK_SIZE);
+K_THREAD_STACK_DEFINE(fp_idle_stack, FP_STACK_SIZE);
+static struct k_thread fp_user_thread;
+static struct k_thread fp_idle_thread;
+
+static K_SEM_DEFINE(fp_wake_sem, 0, 1);
+static K_SEM_DEFINE(fp_done_sem, 0, 1);
+
+static volatile double fp_acc = 1.0;
+static uint32_t fp_cycles;
+
+static void fp_wake_isr(const void *unused)
+{
+	ARG_UNUSED(unused);
+
+	k_sem_give(&fp_wake_sem);
+}
+
+/* Higher priority, FP-capable but never using the FPU */
+static void fp_idle(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&fp_wake_sem, K_FOREVER);
+	}
+}
+
+static void fp_user(void *p1, void *p2, void *p3)
+{
+	timing_t start, end;
+
+	fp_acc = fp_acc * 1.0001;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NB_OF_SWITCHES; i++) {
+		/* Preempted by fp_idle until it blocks again */
+		irq_offload(fp_wake_isr, NULL);
+		fp_acc = fp_acc * 1.0001;
+	}
+	end = timing_counter_get();
+
+	fp_cycles = timing_cycles_get(&start, &end);
+	k_sem_give(&fp_done_sem);
+}
+
+int fpu_ctx_switch(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	timing_start();
+
+	k_thread_create(&fp_idle_thread, fp_idle_stack, FP_STACK_SIZE,
+			fp_idle, NULL, NULL, NULL, prio - 1, K_FP_REGS,
+			K_NO_WAIT);
+	k_thread_create(&fp_user_thread, fp_user_stack, FP_STACK_SIZE,
+			fp_user, NULL, NULL, NULL, prio + 1, K_FP_REGS,
+			K_NO_WAIT);
+
+	k_sem_take(&fp_done_sem, K_FOREVER);
+
+	PRINT_STATS_AVG("Average preemption by FP-capable thread not using FPU",
+			fp_cycles, NB_OF_SWITCHES);
+
+	k_thread_abort(&fp_user_thread);
+	k_thread_abort(&fp_idle_thread);
+
+	timing_stop();
+
+	return 0;
+}
+#endif /* CONFIG_FPU_SHARING */
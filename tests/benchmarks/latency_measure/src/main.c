@@ -23,10 +23,13 @@ extern void int_to_thread(void);
 extern void int_to_thread_evt(void);
 extern void sema_test_signal(void);
 extern void mutex_lock_unlock(void);
+extern void sys_mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
 extern int sema_test(void);
 extern int sema_context_switch(void);
 extern int suspend_resume(void);
+extern int thread_stack_pool_create(void);
+extern int fpu_ctx_switch(void);
 
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
@@ -51,12 +54,22 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	suspend_resume();
 
+#ifdef CONFIG_THREAD_STACK_POOL
+	thread_stack_pool_create();
+#endif
+
+#ifdef CONFIG_FPU_SHARING
+	fpu_ctx_switch();
+#endif
+
 	sema_test_signal();
 
 	sema_context_switch();
 
 	mutex_lock_unlock();
 
+	sys_mutex_lock_unlock();
+
 	TC_END_REPORT(error_count);
 }
 
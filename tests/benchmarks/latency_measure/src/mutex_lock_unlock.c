@@ -7,12 +7,14 @@
 
 #include <zephyr.h>
 #include <timing/timing.h>
+#include <sys/mutex.h>
 #include "utils.h"
 
 /* the number of mutex lock/unlock cycles */
 #define N_TEST_MUTEX 1000
 
 K_MUTEX_DEFINE(test_mutex);
+SYS_MUTEX_DEFINE(test_sys_mutex);
 
 
 /**
@@ -57,3 +59,52 @@ int mutex_lock_unlock(void)
 	timing_stop();
 	return 0;
 }
+
+/**
+ *
+ * @brief Compare uncontended sys_mutex and k_mutex lock/unlock pairs
+ *
+ * With CONFIG_SYS_MUTEX_FAST enabled, an uncontended sys_mutex is locked
+ * and unlocked with an atomic compare-and-swap each, without entering the
+ * kernel.
+ *
+ * @return 0 on success
+ */
+int sys_mutex_lock_unlock(void)
+{
+	int i;
+	uint32_t diff;
+	timing_t timestamp_start;
+	timing_t timestamp_end;
+
+	timing_start();
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_MUTEX; i++) {
+		k_mutex_lock(&test_mutex, K_FOREVER);
+		k_mutex_unlock(&test_mutex);
+	}
+
+	timestamp_end = timing_counter_get();
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+
+	PRINT_STATS_AVG("Average time to lock and unlock a k_mutex", diff,
+			N_TEST_MUTEX);
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_MUTEX; i++) {
+		sys_mutex_lock(&test_sys_mutex, K_FOREVER);
+		sys_mutex_unlock(&test_sys_mutex);
+	}
+
+	timestamp_end = timing_counter_get();
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+
+	PRINT_STATS_AVG("Average time to lock and unlock a sys_mutex", diff,
+			N_TEST_MUTEX);
+
+	timing_stop();
+	return 0;
+}
@@ -85,3 +85,49 @@ int suspend_resume(void)
 	timing_stop();
 	return 0;
 }
+
+#ifdef CONFIG_THREAD_STACK_POOL
+static void thread_pool_entry(void *p1, void *p2, void *p3)
+{
+}
+
+/* Creates, runs and recycles one short-lived thread on a pooled stack,
+ * returning the cycles spent allocating the stack and creating the thread
+ */
+static uint32_t thread_pool_spawn(void)
+{
+	timing_t start, end;
+	k_thread_stack_t *stack;
+
+	start = timing_counter_get();
+	stack = k_thread_stack_alloc(STACK_SIZE, 0);
+	k_tid_t tid = k_thread_create(&t1, stack, STACK_SIZE,
+				      thread_pool_entry, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(6), 0, K_FOREVER);
+	end = timing_counter_get();
+
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+	k_thread_stack_free(stack);
+
+	return timing_cycles_get(&start, &end);
+}
+
+int thread_stack_pool_create(void)
+{
+	uint32_t diff;
+
+	timing_start();
+
+	/* The first use of a pooled stack paints all of it */
+	diff = thread_pool_spawn();
+	PRINT_STATS("Time to create a thread from a new pooled stack", diff);
+
+	diff = thread_pool_spawn();
+	PRINT_STATS("Time to create a thread from a recycled pooled stack",
+		    diff);
+
+	timing_stop();
+	return 0;
+}
+#endif
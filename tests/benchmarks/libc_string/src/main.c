@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#define MAX_SIZE 4096
+#define ALIGN_SPAN 8
+#define BYTES_PER_SIZE (64 * 1024)
+
+static const uint32_t sizes[] = { 8, 32, 128, 512, 4096 };
+
+/* The source and destination offsets of every measurement */
+static const uint8_t aligns[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { 3, 0 } };
+
+static uint8_t src[MAX_SIZE + ALIGN_SPAN] __aligned(ALIGN_SPAN);
+static uint8_t dst[MAX_SIZE + ALIGN_SPAN] __aligned(ALIGN_SPAN);
+
+enum bench_op {
+	OP_MEMCPY,
+	OP_MEMSET,
+	OP_MEMCMP,
+	OP_STRLEN,
+	OP_STRCMP,
+};
+
+static const char *const op_names[] = {
+	[OP_MEMCPY] = "memcpy",
+	[OP_MEMSET] = "memset",
+	[OP_MEMCMP] = "memcmp",
+	[OP_STRLEN] = "strlen",
+	[OP_STRCMP] = "strcmp",
+};
+
+/* Results are summed up so that the calls cannot be left out */
+static volatile uint32_t sink;
+
+static void call(enum bench_op op, uint8_t *d, const uint8_t *s, size_t size)
+{
+	switch (op) {
+	case OP_MEMCPY:
+		memcpy(d, s, size);
+		break;
+	case OP_MEMSET:
+		memset(d, 0x5A, size);
+		break;
+	case OP_MEMCMP:
+		sink += memcmp(d, s, size);
+		break;
+	case OP_STRLEN:
+		sink += strlen((const char *)s);
+		break;
+	case OP_STRCMP:
+		sink += strcmp((const char *)d, (const char *)s);
+		break;
+	}
+}
+
+static void run(enum bench_op op, uint32_t size, uint32_t s_off,
+		uint32_t d_off)
+{
+	uint8_t *d = &dst[d_off];
+	const uint8_t *s = &src[s_off];
+	uint32_t loops = MAX(BYTES_PER_SIZE / size, 1U);
+	uint32_t start, us;
+
+	/* Equal strings of the given length, compared to the end */
+	(void)memset(src, 'a', sizeof(src));
+	src[s_off + size - 1] = '\0';
+	memcpy(dst, src, sizeof(dst));
+	if (d_off != s_off) {
+		memcpy(d, s, size);
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < loops; i++) {
+		call(op, d, s, size);
+	}
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	printk("%s %6u align %u/%u MB/s %6u\n", op_names[op], size,
+	       s_off, d_off,
+	       us ? (uint32_t)((uint64_t)loops * size / us) : 0U);
+}
+
+void main(void)
+{
+	printk("optimized %s\n",
+	       IS_ENABLED(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) ? "y" : "n");
+
+	for (int op = 0; op < ARRAY_SIZE(op_names); op++) {
+		for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+			for (int a = 0; a < ARRAY_SIZE(aligns); a++) {
+				run(op, sizes[i], aligns[a][0], aligns[a][1]);
+			}
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+
+#define UDP_PORT 4242
+#define TCP_PORT 4243
+#define POLL_PORT 5000
+
+#define UDP_BATCH 8
+#define UDP_ITERATIONS 64
+#define UDP_MAX_LEN 1472
+
+#define TCP_CHUNK 1024
+#define TCP_CHUNKS 256
+#define TCP_ROUNDS 256
+
+#define POLL_MAX_FDS CONFIG_NET_SOCKETS_POLL_MAX
+#define POLL_ITERATIONS 256
+
+#define LAYERS (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS) || \
+		IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS))
+
+static const uint16_t udp_lens[] = { 64, 128, 256, 512, 1024, 1472 };
+static const int poll_counts[] = { 1, 8, 32, POLL_MAX_FDS };
+
+static uint8_t buf[MAX(UDP_MAX_LEN, TCP_CHUNK)];
+static uint32_t rtt[TCP_ROUNDS];
+static struct sockaddr_in addr;
+static struct pollfd fds[POLL_MAX_FDS];
+
+#if LAYERS
+static struct net_stats stats_before, stats_after;
+#endif
+
+static uint32_t rate(uint32_t count, uint32_t cycles)
+{
+	if (cycles == 0U) {
+		return 0;
+	}
+
+	return (uint32_t)((uint64_t)count * sys_clock_hw_cycles_per_sec() /
+			  cycles);
+}
+
+static void sort_lat(uint32_t *v, size_t n)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		size_t j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+static int socket_open(int type, int proto, uint16_t port, bool bound)
+{
+	int sock = socket(AF_INET, type, proto);
+
+	addr.sin_port = htons(port);
+	if (sock >= 0 && bound &&
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static int recv_all(int sock, size_t len)
+{
+	ssize_t ret;
+
+	while (len > 0) {
+		ret = recv(sock, buf, MIN(len, sizeof(buf)), 0);
+		if (ret <= 0) {
+			return -1;
+		}
+
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/*
+ * The per layer times come from the packet timestamps, as shown by the
+ * net shell: the total time a packet took through the stack and the
+ * time between each of the points it was stamped at, in microseconds.
+ */
+#if LAYERS
+static void layers_start(void)
+{
+	net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats_before,
+		 sizeof(stats_before));
+}
+
+static uint32_t avg_us(uint64_t sum_before, net_stats_t count_before,
+		       uint64_t sum_after, net_stats_t count_after)
+{
+	if (count_after == count_before) {
+		return 0;
+	}
+
+	return (uint32_t)((sum_after - sum_before) /
+			  (count_after - count_before));
+}
+
+#define AVG_US(field) avg_us(stats_before.field.sum,			\
+			     stats_before.field.count,			\
+			     stats_after.field.sum,			\
+			     stats_after.field.count)
+
+static void layers_report(const char *name)
+{
+	net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats_after,
+		 sizeof(stats_after));
+
+#if defined(CONFIG_NET_PKT_TXTIME_STATS)
+	printk("%s tx %u us", name, AVG_US(tx_time));
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+	for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		printk("%s%u", i ? "->" : " [", AVG_US(tx_time_detail[i]));
+	}
+	printk("]");
+#endif
+	printk("\n");
+#endif
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+	printk("%s rx %u us", name, AVG_US(rx_time));
+/* The RX details are only kept along with the TX times */
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL) && \
+	defined(CONFIG_NET_PKT_TXTIME_STATS)
+	for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		printk("%s%u", i ? "->" : " [", AVG_US(rx_time_detail[i]));
+	}
+	printk("]");
+#endif
+	printk("\n");
+#endif
+}
+#else
+static void layers_start(void)
+{
+}
+
+static void layers_report(const char *name)
+{
+	ARG_UNUSED(name);
+}
+#endif /* LAYERS */
+
+/* Datagrams are sent a batch at a time so that none is dropped */
+static void run_udp(int rx_sock, int tx_sock, uint16_t len)
+{
+	uint32_t start, cycles, count = 0U;
+	char name[16];
+
+	layers_start();
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < UDP_ITERATIONS; i++) {
+		for (int j = 0; j < UDP_BATCH; j++) {
+			if (send(tx_sock, buf, len, 0) < 0) {
+				printk("send failed (%d)\n", errno);
+				return;
+			}
+		}
+
+		for (int j = 0; j < UDP_BATCH; j++) {
+			if (recv(rx_sock, buf, len, 0) < 0) {
+				printk("recv failed (%d)\n", errno);
+				return;
+			}
+
+			count++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	printk("udp %4u B %7u dgrams/s %5u us/dgram\n", len,
+	       rate(count, cycles),
+	       (uint32_t)(k_cyc_to_ns_floor64(cycles) / NSEC_PER_USEC /
+			  count));
+
+	snprintk(name, sizeof(name), "udp %u B", len);
+	layers_report(name);
+}
+
+static void udp(void)
+{
+	int rx_sock, tx_sock;
+
+	rx_sock = socket_open(SOCK_DGRAM, IPPROTO_UDP, UDP_PORT, true);
+	tx_sock = socket_open(SOCK_DGRAM, IPPROTO_UDP, UDP_PORT, false);
+	if (rx_sock < 0 || tx_sock < 0 ||
+	    connect(tx_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot set up UDP sockets (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(udp_lens); i++) {
+		run_udp(rx_sock, tx_sock, udp_lens[i]);
+	}
+
+	close(rx_sock);
+	close(tx_sock);
+}
+
+static void run_tcp_bulk(int rx_sock, int tx_sock)
+{
+	uint32_t start;
+
+	layers_start();
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < TCP_CHUNKS; i++) {
+		if (send(tx_sock, buf, TCP_CHUNK, 0) != TCP_CHUNK ||
+		    recv_all(rx_sock, TCP_CHUNK) < 0) {
+			printk("bulk transfer failed (%d)\n", errno);
+			return;
+		}
+	}
+
+	printk("tcp bulk %7u KiB/s\n",
+	       rate(TCP_CHUNKS * TCP_CHUNK / 1024, k_cycle_get_32() - start));
+	layers_report("tcp bulk");
+}
+
+static void run_tcp_rtt(int a, int b)
+{
+	uint32_t start;
+
+	for (int i = 0; i < TCP_ROUNDS; i++) {
+		start = k_cycle_get_32();
+
+		if (send(a, buf, 1, 0) != 1 || recv_all(b, 1) < 0 ||
+		    send(b, buf, 1, 0) != 1 || recv_all(a, 1) < 0) {
+			printk("round trip failed (%d)\n", errno);
+			return;
+		}
+
+		rtt[i] = (uint32_t)(k_cyc_to_ns_floor64(k_cycle_get_32() -
+							start) /
+				    NSEC_PER_USEC);
+	}
+
+	sort_lat(rtt, TCP_ROUNDS);
+	printk("tcp rtt p50 %5u p99 %5u max %5u us\n", rtt[TCP_ROUNDS / 2],
+	       rtt[TCP_ROUNDS * 99 / 100], rtt[TCP_ROUNDS - 1]);
+}
+
+static void tcp(void)
+{
+	int listen_sock, client, server;
+	int one = 1;
+
+	listen_sock = socket_open(SOCK_STREAM, IPPROTO_TCP, TCP_PORT, true);
+	client = socket_open(SOCK_STREAM, IPPROTO_TCP, TCP_PORT, false);
+	if (listen_sock < 0 || client < 0 || listen(listen_sock, 1) < 0 ||
+	    connect(client, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot set up TCP sockets (%d)\n", errno);
+		return;
+	}
+
+	server = accept(listen_sock, NULL, NULL);
+	if (server < 0) {
+		printk("accept failed (%d)\n", errno);
+		return;
+	}
+
+	/* Single byte messages must not wait for more data */
+	(void)setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	(void)setsockopt(server, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+	run_tcp_bulk(server, client);
+	run_tcp_rtt(client, server);
+
+	close(server);
+	close(client);
+	close(listen_sock);
+}
+
+/* One datagram to the last socket, then a poll() over all of them */
+static void run_poll(int tx_sock, int nfds)
+{
+	struct sockaddr_in dst = addr;
+	uint32_t start;
+
+	dst.sin_port = htons(POLL_PORT + nfds - 1);
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < POLL_ITERATIONS; i++) {
+		if (sendto(tx_sock, buf, 1, 0, (struct sockaddr *)&dst,
+			   sizeof(dst)) < 0 ||
+		    poll(fds, nfds, 1000) != 1 ||
+		    recv(fds[nfds - 1].fd, buf, 1, 0) != 1) {
+			printk("poll of %d fds failed (%d)\n", nfds, errno);
+			return;
+		}
+	}
+
+	printk("poll %2d fds %7u polls/s\n", nfds,
+	       rate(POLL_ITERATIONS, k_cycle_get_32() - start));
+}
+
+static void polling(void)
+{
+	int tx_sock, i;
+
+	tx_sock = socket_open(SOCK_DGRAM, IPPROTO_UDP, 0, false);
+
+	for (i = 0; i < POLL_MAX_FDS; i++) {
+		fds[i].fd = socket_open(SOCK_DGRAM, IPPROTO_UDP,
+					POLL_PORT + i, true);
+		fds[i].events = POLLIN;
+		if (fds[i].fd < 0) {
+			break;
+		}
+	}
+
+	if (tx_sock < 0 || i < POLL_MAX_FDS) {
+		printk("cannot open %d sockets (%d)\n", POLL_MAX_FDS, errno);
+	} else {
+		for (i = 0; i < ARRAY_SIZE(poll_counts); i++) {
+			run_poll(tx_sock, poll_counts[i]);
+		}
+	}
+
+	for (i = 0; i < POLL_MAX_FDS && fds[i].fd >= 0; i++) {
+		close(fds[i].fd);
+	}
+
+	if (tx_sock >= 0) {
+		close(tx_sock);
+	}
+}
+
+void main(void)
+{
+	addr.sin_family = AF_INET;
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	udp();
+	tcp();
+	polling();
+
+	printk("fin\n");
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+
+#define ITERATIONS 1000
+#define MAX_PAYLOAD 1500
+
+static const size_t payload_sizes[] = { 64, 128, 256, 512, 1024, 1500 };
+static uint8_t data[NET_IPV4UDPH_LEN + MAX_PAYLOAD];
+
+/* One 16-bit word at a time */
+static uint16_t ref_chksum(uint16_t sum, const uint8_t *ptr, size_t len)
+{
+	const uint8_t *end = ptr + len - 1;
+	uint16_t tmp;
+
+	while (ptr < end) {
+		tmp = (ptr[0] << 8) + ptr[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		ptr += 2;
+	}
+
+	if (ptr == end) {
+		tmp = ptr[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static struct net_pkt *build_pkt(struct net_if *iface, size_t payload_len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, payload_len + NET_UDPH_LEN,
+					AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_pkt_write(pkt, data, NET_IPV4UDPH_LEN + payload_len)) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void run(struct net_if *iface, size_t payload_len)
+{
+	volatile uint16_t chksum;
+	uint32_t start, pkt_cycles, ref_cycles;
+	struct net_pkt *pkt;
+	int i;
+
+	pkt = build_pkt(iface, payload_len);
+	if (!pkt) {
+		printk("Cannot build %zu B packet\n", payload_len);
+		return;
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	}
+
+	pkt_cycles = (k_cycle_get_32() - start) / ITERATIONS;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		chksum = ref_chksum(0U, data + NET_IPV4H_LEN,
+				    NET_UDPH_LEN + payload_len);
+	}
+
+	ref_cycles = (k_cycle_get_32() - start) / ITERATIONS;
+
+	printk("%5zu B %8u cycles %8u cycles\n", payload_len, pkt_cycles,
+	       ref_cycles);
+
+	net_pkt_unref(pkt);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i * 37 + 11;
+	}
+
+	/* Version 4, 20 bytes header */
+	data[0] = 0x45;
+
+	printk("payload   net_calc_chksum   reference\n");
+
+	for (i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		run(iface, payload_sizes[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/dummy.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+#include "connection.h"
+
+#define LOCAL_PORT_BASE 5000
+#define REMOTE_PORT 4242
+#define ITERATIONS 10000
+
+static const int conn_counts[] = { 1, 16, 64 };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handles[64];
+static uint32_t received;
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_conn_bench, "net_conn_bench",
+		bench_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict bench_recv(struct net_conn *conn,
+				   struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   union net_proto_header *proto_hdr,
+				   void *user_data)
+{
+	/* Keep the packet so that it can be fed in again */
+	received++;
+
+	return NET_OK;
+}
+
+static struct net_pkt *create_pkt(struct net_if *iface, uint16_t dst_port)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, AF_INET, IPPROTO_UDP,
+					K_SECONDS(1));
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(REMOTE_PORT), htons(dst_port))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static int register_conns(int count)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+	};
+	int i, ret;
+
+	for (i = 0; i < count; i++) {
+		local.sin_port = htons(LOCAL_PORT_BASE + i);
+
+		ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+					(struct sockaddr *)&local,
+					0, LOCAL_PORT_BASE + i,
+					bench_recv, NULL, &handles[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void unregister_conns(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		net_conn_unregister(handles[i]);
+	}
+}
+
+static void run(struct net_if *iface, int count)
+{
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	uint32_t start, cycles;
+	struct net_pkt *pkt;
+	uint64_t rate;
+	int i;
+
+	if (register_conns(count) < 0) {
+		printk("cannot register %d connections\n", count);
+		return;
+	}
+
+	/* handles[0] was registered first and is the last one in the list */
+	pkt = create_pkt(iface, LOCAL_PORT_BASE);
+	if (!pkt) {
+		printk("cannot create packet\n");
+		unregister_conns(count);
+		return;
+	}
+
+	ip_hdr.ipv4 = NET_IPV4_HDR(pkt);
+	proto_hdr.udp = (struct net_udp_hdr *)((uint8_t *)ip_hdr.ipv4 +
+					       sizeof(struct net_ipv4_hdr));
+
+	received = 0U;
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	net_pkt_unref(pkt);
+	unregister_conns(count);
+
+	if (received != ITERATIONS || cycles == 0U) {
+		printk("conns %d: %u of %u packets delivered\n",
+		       count, received, ITERATIONS);
+		return;
+	}
+
+	rate = (uint64_t)ITERATIONS * sys_clock_hw_cycles_per_sec() / cycles;
+
+	printk("conns %3d buckets %d %u pkts/s\n", count,
+	       CONFIG_NET_CONN_PORT_BUCKETS, (uint32_t)rate);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	int i;
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add IPv4 address\n");
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(conn_counts); i++) {
+		run(iface, conn_counts[i]);
+	}
+
+	printk("fin\n");
+}
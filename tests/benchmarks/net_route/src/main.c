@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <random/rand32.h>
+#include <net/net_core.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/dummy.h>
+
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+#define DESTS 16
+#define ITERATIONS 20000
+
+static const int route_counts[] = { 16, 64, 256 };
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr nexthop_addr = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct in6_addr prefixes[CONFIG_NET_MAX_ROUTES];
+static struct in6_addr dests[DESTS];
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench",
+		bench_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static int add_routes(struct net_if *iface, int from, int to)
+{
+	int i;
+
+	for (i = from; i < to; i++) {
+		uint8_t prefix_len = 48 + sys_rand32_get() % 17;
+
+		prefixes[i] = my_addr;
+		sys_rand_get(&prefixes[i].s6_addr[4], 4);
+		prefixes[i].s6_addr[15] = 0U;
+
+		if (!net_route_add(iface, &prefixes[i], prefix_len,
+				   &nexthop_addr)) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static void run(struct net_if *iface, int count)
+{
+	uint32_t start, cycles;
+	uint32_t found = 0U;
+	uint64_t rate;
+	int i;
+
+	/* Destinations inside the prefixes of some of the routes */
+	for (i = 0; i < DESTS; i++) {
+		dests[i] = prefixes[sys_rand32_get() % count];
+		dests[i].s6_addr[15] = i + 1;
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		if (net_route_lookup(iface, &dests[i % DESTS])) {
+			found++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (found != ITERATIONS || cycles == 0U) {
+		printk("routes %d: %u of %u lookups found a route\n",
+		       count, found, ITERATIONS);
+		return;
+	}
+
+	rate = (uint64_t)ITERATIONS * sys_clock_hw_cycles_per_sec() / cycles;
+
+	printk("routes %4d %u lookups/s\n", count, (uint32_t)rate);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct net_linkaddr lladdr = {
+		.addr = (uint8_t []){ 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 },
+		.len = 6,
+		.type = NET_LINK_ETHERNET,
+	};
+	int i, added = 0;
+
+	if (!net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add IPv6 address\n");
+		return;
+	}
+
+	if (!net_ipv6_nbr_add(iface, &nexthop_addr, &lladdr, false,
+			      NET_IPV6_NBR_STATE_REACHABLE)) {
+		printk("cannot add nexthop neighbor\n");
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(route_counts); i++) {
+		if (add_routes(iface, added, route_counts[i]) < 0) {
+			printk("cannot add %d routes\n", route_counts[i]);
+			return;
+		}
+
+		added = route_counts[i];
+
+		run(iface, added);
+	}
+
+	printk("fin\n");
+}
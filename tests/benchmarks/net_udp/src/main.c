@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#define PORT 4242
+#define BATCH 16
+#define DGRAM_LEN 64
+#define ITERATIONS 256
+
+static uint8_t tx_buf[BATCH][DGRAM_LEN];
+static uint8_t rx_buf[BATCH][DGRAM_LEN];
+static struct iovec tx_iov[BATCH];
+static struct iovec rx_iov[BATCH];
+static struct mmsghdr tx_msgs[BATCH];
+static struct mmsghdr rx_msgs[BATCH];
+
+static void report(const char *name, uint32_t count, uint32_t cycles)
+{
+	uint64_t rate;
+
+	if (cycles == 0U) {
+		printk("%s: no time elapsed\n", name);
+		return;
+	}
+
+	rate = (uint64_t)count * sys_clock_hw_cycles_per_sec() / cycles;
+
+	printk("%-18s %u dgrams/s\n", name, (uint32_t)rate);
+}
+
+static void run_single(int rx_sock, int tx_sock)
+{
+	uint32_t start, count = 0U;
+	int i, j;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		for (j = 0; j < BATCH; j++) {
+			if (send(tx_sock, tx_buf[j], DGRAM_LEN, 0) < 0) {
+				printk("send failed (%d)\n", errno);
+				return;
+			}
+		}
+
+		for (j = 0; j < BATCH; j++) {
+			if (recvfrom(rx_sock, rx_buf[j], DGRAM_LEN, 0,
+				     NULL, NULL) < 0) {
+				printk("recvfrom failed (%d)\n", errno);
+				return;
+			}
+
+			count++;
+		}
+	}
+
+	report("sendto/recvfrom", count, k_cycle_get_32() - start);
+}
+
+static void run_batched(int rx_sock, int tx_sock)
+{
+	uint32_t start, count = 0U;
+	int i, ret, got;
+
+	for (i = 0; i < BATCH; i++) {
+		tx_iov[i].iov_base = tx_buf[i];
+		tx_iov[i].iov_len = DGRAM_LEN;
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = DGRAM_LEN;
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		ret = sendmmsg(tx_sock, tx_msgs, BATCH, 0);
+		if (ret != BATCH) {
+			printk("sendmmsg failed (%d, %d)\n", ret, errno);
+			return;
+		}
+
+		/* The loopback may still be delivering the tail of the
+		 * batch when the first datagrams are picked up.
+		 */
+		for (got = 0; got < BATCH; got += ret) {
+			ret = recvmmsg(rx_sock, rx_msgs, BATCH - got, 0);
+			if (ret < 0) {
+				printk("recvmmsg failed (%d)\n", errno);
+				return;
+			}
+		}
+
+		count += got;
+	}
+
+	report("sendmmsg/recvmmsg", count, k_cycle_get_32() - start);
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	int rx_sock, tx_sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	rx_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	tx_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (rx_sock < 0 || tx_sock < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return;
+	}
+
+	if (bind(rx_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    connect(tx_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot set up sockets (%d)\n", errno);
+		return;
+	}
+
+	run_single(rx_sock, tx_sock);
+	run_batched(rx_sock, tx_sock);
+
+	close(rx_sock);
+	close(tx_sock);
+
+	printk("fin\n");
+}
@@ -86,8 +86,15 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+void smp_sched_bench(void);
+
 void main(void)
 {
+	if (IS_ENABLED(CONFIG_SMP)) {
+		smp_sched_bench();
+		return;
+	}
+
 	z_waitq_init(&waitq);
 
 	int main_prio = k_thread_priority_get(k_current_get());
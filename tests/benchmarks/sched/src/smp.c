@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* SMP switch throughput benchmark.  For each worker count from one
+ * to CONFIG_MP_NUM_CPUS, start two equal priority threads per
+ * worker that do nothing but k_yield() in a loop, so every
+ * iteration is a full trip through the scheduler and (with a peer
+ * thread ready) a context switch.  The main thread sleeps for a
+ * fixed window at cooperative priority, then stops the workers and
+ * reports the total number of switches.  With a scalable run queue
+ * design the result grows roughly linearly with the worker count.
+ */
+
+#define THREADS_PER_CPU 2
+#define N_THREADS (CONFIG_MP_NUM_CPUS * THREADS_PER_CPU)
+#define STACK_SIZE 1024
+#define WINDOW_MS 1000
+#define WORKER_PRIO K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, N_THREADS, STACK_SIZE);
+static struct k_thread worker_threads[N_THREADS];
+
+static uint32_t switch_counts[N_THREADS];
+static volatile bool stop_workers;
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t *count = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!stop_workers) {
+		k_yield();
+		(*count)++;
+	}
+}
+
+static uint32_t run_window(int n_threads)
+{
+	uint32_t total = 0U;
+
+	stop_workers = false;
+
+	for (int i = 0; i < n_threads; i++) {
+		switch_counts[i] = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker_fn,
+				&switch_counts[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(WINDOW_MS));
+	stop_workers = true;
+
+	for (int i = 0; i < n_threads; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		total += switch_counts[i];
+	}
+
+	return total;
+}
+
+void smp_sched_bench(void)
+{
+	/* Run the controlling thread cooperatively so it always gets
+	 * the CPU back as soon as its window expires
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(1));
+
+	for (int cpus = 1; cpus <= CONFIG_MP_NUM_CPUS; cpus++) {
+		uint32_t switches = run_window(cpus * THREADS_PER_CPU);
+
+		printk("cpus %d threads %d switches %u (%u/s)\n",
+		       cpus, cpus * THREADS_PER_CPU, switches,
+		       switches * 1000U / WINDOW_MS);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <settings/settings.h>
+#include <storage/flash_map.h>
+#include <string.h>
+
+#ifdef CONFIG_FLASH_SIMULATOR
+#include <stats/stats.h>
+#endif
+
+#ifdef CONFIG_SETTINGS_FS
+#include <fs/fs.h>
+#include <fs/littlefs.h>
+#endif
+
+#define PASSES 4
+#define MAX_KEYS 256
+#define VAL_LEN 16
+
+static const uint32_t key_counts[] = { 16, 64, 256 };
+static uint32_t lat[MAX_KEYS * PASSES];
+static uint32_t loaded;
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint8_t val[VAL_LEN];
+
+	if (read_cb(cb_arg, val, sizeof(val)) > 0) {
+		loaded++;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static const char *backend_name(void)
+{
+	if (IS_ENABLED(CONFIG_SETTINGS_NVS)) {
+		return "nvs";
+	} else if (IS_ENABLED(CONFIG_SETTINGS_FCB)) {
+		return "fcb";
+	} else {
+		return "fs";
+	}
+}
+
+/* Start from an empty storage partition */
+static int clear_storage(void)
+{
+#ifdef CONFIG_SETTINGS_FS
+	FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(cstorage);
+	static struct fs_mount_t littlefs_mnt = {
+		.type = FS_LITTLEFS,
+		.fs_data = &cstorage,
+		.storage_dev = (void *)FLASH_AREA_ID(storage),
+		.mnt_point = "/ff",
+	};
+#endif
+	const struct flash_area *fap;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fap);
+	if (rc) {
+		return rc;
+	}
+
+	rc = flash_area_erase(fap, 0, fap->fa_size);
+	flash_area_close(fap);
+
+#ifdef CONFIG_SETTINGS_FS
+	if (rc == 0) {
+		rc = fs_mount(&littlefs_mnt);
+	}
+#endif
+
+	return rc;
+}
+
+struct flash_counters {
+	uint32_t erases;
+	uint32_t written;
+};
+
+#ifdef CONFIG_FLASH_SIMULATOR
+static int stats_cb(struct stats_hdr *hdr, void *arg, const char *name,
+		    uint16_t off)
+{
+	struct flash_counters *cnt = arg;
+	uint32_t val = *(uint32_t *)((uint8_t *)hdr + off);
+
+	if (strcmp(name, "flash_erase_calls") == 0) {
+		cnt->erases = val;
+	} else if (strcmp(name, "bytes_written") == 0) {
+		cnt->written = val;
+	}
+
+	return 0;
+}
+#endif
+
+/* Flash counters are only kept by the flash simulator */
+static bool flash_counters_get(struct flash_counters *cnt)
+{
+#ifdef CONFIG_FLASH_SIMULATOR
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	if (hdr != NULL) {
+		return stats_walk(hdr, stats_cb, cnt) == 0;
+	}
+#endif
+
+	return false;
+}
+
+static uint32_t cyc_to_us(uint32_t cycles)
+{
+	return k_cyc_to_us_floor32(cycles);
+}
+
+static void sort_lat(uint32_t *v, size_t n)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		size_t j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+static void run(uint32_t keys)
+{
+	struct flash_counters before = { 0 }, after = { 0 };
+	uint8_t val[VAL_LEN];
+	uint32_t start, total, load, ops, payload;
+	char erases[12] = "n/a", wa[12] = "n/a";
+	char name[16];
+	bool counters;
+	size_t n = 0;
+	int rc;
+
+	counters = flash_counters_get(&before);
+
+	/* Every key is written PASSES times, the backends have to collect
+	 * the outdated values on the way.
+	 */
+	total = 0;
+	for (int pass = 0; pass < PASSES; pass++) {
+		for (uint32_t k = 0; k < keys; k++) {
+			(void)memset(val, pass + k, sizeof(val));
+			snprintk(name, sizeof(name), "bench/k%u", k);
+
+			start = k_cycle_get_32();
+			rc = settings_save_one(name, val, sizeof(val));
+			lat[n] = k_cycle_get_32() - start;
+			if (rc) {
+				printk("Cannot save %s (%d)\n", name, rc);
+				return;
+			}
+
+			total += lat[n++];
+		}
+	}
+
+	counters = counters && flash_counters_get(&after);
+
+	loaded = 0;
+	start = k_cycle_get_32();
+	rc = settings_load();
+	load = k_cycle_get_32() - start;
+	if (rc || loaded < keys) {
+		printk("Cannot load %u keys (%d)\n", keys, rc);
+		return;
+	}
+
+	sort_lat(lat, n);
+	total = cyc_to_us(total);
+	ops = total ? (uint32_t)(n * 1000000ULL / total) : 0;
+
+	if (counters) {
+		payload = n * sizeof(val);
+		snprintk(erases, sizeof(erases), "%u",
+			 after.erases - before.erases);
+		snprintk(wa, sizeof(wa), "%u.%02u",
+			 (after.written - before.written) / payload,
+			 (after.written - before.written) % payload * 100 /
+			 payload);
+	}
+
+	printk("keys %4u ops/s %7u p50 %6u p99 %6u max %6u load %7u "
+	       "erases %4s wa %s\n", keys, ops, cyc_to_us(lat[n / 2]),
+	       cyc_to_us(lat[n * 99 / 100]), cyc_to_us(lat[n - 1]),
+	       cyc_to_us(load), erases, wa);
+}
+
+void main(void)
+{
+	uint32_t start;
+	int rc;
+
+	printk("backend %s\n", backend_name());
+
+	rc = clear_storage();
+	if (rc) {
+		printk("Cannot clear the storage partition (%d)\n", rc);
+		return;
+	}
+
+	start = k_cycle_get_32();
+	rc = settings_subsys_init();
+	if (rc) {
+		printk("Cannot initialize settings (%d)\n", rc);
+		return;
+	}
+	printk("init %u us\n", cyc_to_us(k_cycle_get_32() - start));
+
+	for (int i = 0; i < ARRAY_SIZE(key_counts); i++) {
+		run(key_counts[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#define CPUS CONFIG_MP_NUM_CPUS
+#define DURATION_MS CONFIG_SMP_SCALING_DURATION_MS
+#define IPI_ROUNDS CONFIG_SMP_SCALING_IPI_ROUNDS
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+/* Below the main thread, so that it can stop the workers on time */
+#define WORKER_PRIO 1
+
+#define QUEUE_ITEMS (2 * CPUS)
+#define SLAB_BLOCKS (4 * CPUS)
+#define BLOCK_SIZE 32
+
+struct bench {
+	const char *name;
+	/* Worker thread body, NULL if the benchmark brings its own threads */
+	k_thread_entry_t entry;
+	void (*start)(int cpus);
+	void (*stop)(int cpus);
+};
+
+/* One cache line each, the counters must not be contended themselves */
+struct counter {
+	uint32_t ops;
+} __aligned(64);
+
+static struct counter counters[CPUS];
+static atomic_t stopping;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CPUS, STACK_SIZE);
+static struct k_thread threads[CPUS];
+
+static struct k_sem ring[CPUS];
+
+static struct k_queue queue;
+static struct {
+	void *reserved;
+	uint8_t data[BLOCK_SIZE];
+} queue_items[QUEUE_ITEMS];
+
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, SLAB_BLOCKS, 4);
+K_HEAP_DEFINE(heap, SLAB_BLOCKS * BLOCK_SIZE * 2);
+
+static K_THREAD_STACK_ARRAY_DEFINE(work_stacks, CPUS, STACK_SIZE);
+static struct k_work_q work_qs[CPUS];
+static struct k_work works[CPUS];
+static struct k_work flushes[CPUS];
+static K_SEM_DEFINE(flushed, 0, CPUS);
+
+static K_SEM_DEFINE(ping_sem, 0, 1);
+static K_SEM_DEFINE(pong_sem, 0, 1);
+static uint32_t rtt[IPI_ROUNDS];
+
+static void pin(k_tid_t thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	(void)k_thread_cpu_mask_clear(thread);
+	(void)k_thread_cpu_mask_enable(thread, cpu);
+#endif
+}
+
+static bool stopped(void)
+{
+	return atomic_get(&stopping) != 0;
+}
+
+/*
+ * Semaphore ping-pong: the workers pass a token around a ring, each
+ * handoff waking the worker on the next CPU.
+ */
+static void sem_worker(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	uintptr_t cpus = (uintptr_t)p2;
+
+	while (true) {
+		(void)k_sem_take(&ring[id], K_FOREVER);
+		k_sem_give(&ring[(id + 1) % cpus]);
+		if (stopped()) {
+			break;
+		}
+		counters[id].ops++;
+	}
+}
+
+static void sem_start(int cpus)
+{
+	for (int i = 0; i < cpus; i++) {
+		k_sem_init(&ring[i], 0, 1);
+	}
+
+	k_sem_give(&ring[0]);
+}
+
+/* MPMC queue: every worker takes an item and puts it back */
+static void queue_worker(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+
+	while (!stopped()) {
+		void *item = k_queue_get(&queue, K_FOREVER);
+
+		k_queue_append(&queue, item);
+		counters[id].ops++;
+	}
+}
+
+static void queue_start(int cpus)
+{
+	k_queue_init(&queue);
+
+	for (int i = 0; i < QUEUE_ITEMS; i++) {
+		k_queue_append(&queue, &queue_items[i]);
+	}
+}
+
+static void slab_worker(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	void *block;
+
+	while (!stopped()) {
+		if (k_mem_slab_alloc(&slab, &block, K_NO_WAIT) == 0) {
+			k_mem_slab_free(&slab, &block);
+			counters[id].ops++;
+		}
+	}
+}
+
+static void heap_worker(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	void *block;
+
+	while (!stopped()) {
+		block = k_heap_alloc(&heap, BLOCK_SIZE, K_NO_WAIT);
+		if (block != NULL) {
+			k_heap_free(&heap, block);
+			counters[id].ops++;
+		}
+	}
+}
+
+/* Work queues: one per CPU, each running a work item resubmitting itself */
+static void work_handler(struct k_work *work)
+{
+	int id = work - works;
+
+	if (!stopped()) {
+		counters[id].ops++;
+		k_work_submit_to_queue(&work_qs[id], work);
+	}
+}
+
+static void flush_handler(struct k_work *work)
+{
+	k_sem_give(&flushed);
+}
+
+static void work_start(int cpus)
+{
+	for (int i = 0; i < cpus; i++) {
+		k_work_submit_to_queue(&work_qs[i], &works[i]);
+	}
+}
+
+static void work_stop(int cpus)
+{
+	for (int i = 0; i < cpus; i++) {
+		k_work_submit_to_queue(&work_qs[i], &flushes[i]);
+	}
+
+	for (int i = 0; i < cpus; i++) {
+		(void)k_sem_take(&flushed, K_FOREVER);
+	}
+}
+
+static void work_init(void)
+{
+	for (int i = 0; i < CPUS; i++) {
+		k_work_init(&works[i], work_handler);
+		k_work_init(&flushes[i], flush_handler);
+		k_work_q_start(&work_qs[i], work_stacks[i], STACK_SIZE,
+			       WORKER_PRIO);
+
+		/* Pinning needs the thread not to be running */
+		k_thread_suspend(&work_qs[i].thread);
+		pin(&work_qs[i].thread, i);
+		k_thread_resume(&work_qs[i].thread);
+	}
+}
+
+static const struct bench benches[] = {
+	{ "sem", sem_worker, sem_start, NULL },
+	{ "queue", queue_worker, queue_start, NULL },
+	{ "slab", slab_worker, NULL, NULL },
+	{ "heap", heap_worker, NULL, NULL },
+	{ "work", NULL, work_start, work_stop },
+};
+
+static void run(const struct bench *bench, int cpus)
+{
+	uint64_t total = 0;
+	int64_t start, elapsed;
+
+	(void)memset(counters, 0, sizeof(counters));
+	atomic_set(&stopping, 0);
+
+	if (bench->start != NULL) {
+		bench->start(cpus);
+	}
+
+	for (int i = 0; bench->entry != NULL && i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				bench->entry, (void *)(uintptr_t)i,
+				(void *)(uintptr_t)cpus, NULL, WORKER_PRIO, 0,
+				K_FOREVER);
+		pin(&threads[i], i);
+		k_thread_start(&threads[i]);
+	}
+
+	start = k_uptime_get();
+	k_msleep(DURATION_MS);
+	atomic_set(&stopping, 1);
+	elapsed = k_uptime_get() - start;
+
+	for (int i = 0; i < cpus; i++) {
+		total += counters[i].ops;
+	}
+
+	for (int i = 0; bench->entry != NULL && i < cpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	if (bench->stop != NULL) {
+		bench->stop(cpus);
+	}
+
+	printk("%s,%d,%u\n", bench->name, cpus,
+	       (uint32_t)(total * MSEC_PER_SEC / MAX(elapsed, 1)));
+}
+
+static void pong(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < IPI_ROUNDS; i++) {
+		(void)k_sem_take(&ping_sem, K_FOREVER);
+		k_sem_give(&pong_sem);
+	}
+}
+
+static void ping(void *p1, void *p2, void *p3)
+{
+	uint32_t start;
+
+	for (int i = 0; i < IPI_ROUNDS; i++) {
+		/* Let the other CPU go idle */
+		k_busy_wait(100);
+
+		start = k_cycle_get_32();
+		k_sem_give(&ping_sem);
+		(void)k_sem_take(&pong_sem, K_FOREVER);
+		rtt[i] = (uint32_t)k_cyc_to_ns_floor64(k_cycle_get_32() -
+						       start);
+	}
+}
+
+static void sort_lat(uint32_t *v, size_t n)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		size_t j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+/*
+ * Round trip from a thread on the first CPU to one waiting on the second
+ * CPU, which has to be woken up by an IPI, and back. Both ends of the
+ * round trip are timed on the first CPU.
+ */
+static void ipi_run(void)
+{
+	k_thread_entry_t entries[] = { ping, pong };
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entries[i],
+				NULL, NULL, NULL, WORKER_PRIO, 0, K_FOREVER);
+		pin(&threads[i], i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	sort_lat(rtt, IPI_ROUNDS);
+	printk("ipi,%u,%u,%u\n", rtt[IPI_ROUNDS / 2],
+	       rtt[IPI_ROUNDS * 99 / 100], rtt[IPI_ROUNDS - 1]);
+}
+
+void main(void)
+{
+	work_init();
+
+	printk("test,cpus,ops_per_sec\n");
+	for (int b = 0; b < ARRAY_SIZE(benches); b++) {
+		for (int cpus = 1; cpus <= CPUS; cpus++) {
+			run(&benches[b], cpus);
+		}
+	}
+
+	printk("latency,p50_ns,p99_ns,max_ns\n");
+	ipi_run();
+
+	printk("fin\n");
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <timeout_q.h>
+
+/* Timeout queue stress benchmark.  Keeps NUM_TIMEOUTS kernel
+ * timeouts outstanding at once and reports the average cost of
+ * adding and aborting a timeout at that depth, then checks that a
+ * large batch of short timeouts all expire, and none of them early.
+ * Run it once with the default delta list and once with
+ * CONFIG_TIMEOUT_WHEEL to compare the two.
+ */
+
+#define NUM_TIMEOUTS 10000
+
+/* Spread of the long timeouts used for the insert/abort costs */
+#define LONG_MIN_TICKS 1000
+#define LONG_SPAN_TICKS 100000
+
+/* Spread of the short timeouts used for the expiry check */
+#define SHORT_SPAN_TICKS 50
+
+struct stress_timeout {
+	struct _timeout timeout;
+	int64_t due;
+	bool fired;
+	bool early;
+};
+
+static struct stress_timeout timeouts[NUM_TIMEOUTS];
+static atomic_t fired_count;
+static uint32_t rand_state = 2463534242U;
+
+/* xorshift32, cheap and deterministic across runs */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static void stress_handler(struct _timeout *t)
+{
+	struct stress_timeout *st = CONTAINER_OF(t, struct stress_timeout,
+						 timeout);
+
+	st->early = k_uptime_ticks() < st->due;
+	st->fired = true;
+	atomic_inc(&fired_count);
+}
+
+static void add_all(uint32_t min_ticks, uint32_t span, uint32_t *cycles)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < NUM_TIMEOUTS; i++) {
+		struct stress_timeout *st = &timeouts[i];
+		k_ticks_t ticks = min_ticks + (next_rand() % span);
+		unsigned int key;
+		uint32_t start;
+
+		st->fired = false;
+		st->early = false;
+		st->due = k_uptime_ticks() + ticks;
+		z_init_timeout(&st->timeout);
+
+		key = irq_lock();
+		start = k_cycle_get_32();
+		z_add_timeout(&st->timeout, stress_handler,
+			      Z_TIMEOUT_TICKS(ticks));
+		total += k_cycle_get_32() - start;
+		irq_unlock(key);
+	}
+
+	*cycles = total;
+}
+
+static uint32_t abort_range(int first, int step)
+{
+	uint32_t total = 0U;
+
+	for (int i = first; i < NUM_TIMEOUTS; i += step) {
+		unsigned int key = irq_lock();
+		uint32_t start = k_cycle_get_32();
+
+		zassert_equal(z_abort_timeout(&timeouts[i].timeout), 0,
+			      "timeout %d was not pending", i);
+		total += k_cycle_get_32() - start;
+		irq_unlock(key);
+	}
+
+	return total;
+}
+
+/**
+ * @brief Measure timeout add/abort cost with 10k timeouts pending
+ *
+ * @ingroup kernel_timeout_tests
+ */
+void test_timeout_insert_abort(void)
+{
+	uint32_t add_cycles, abort_cycles;
+
+	add_all(LONG_MIN_TICKS, LONG_SPAN_TICKS, &add_cycles);
+
+	for (int i = 0; i < NUM_TIMEOUTS; i += NUM_TIMEOUTS / 16) {
+		k_ticks_t rem = z_timeout_remaining(&timeouts[i].timeout);
+
+		zassert_true(rem > 0 && rem <= LONG_MIN_TICKS + LONG_SPAN_TICKS,
+			     "bad remaining time %d for timeout %d",
+			     (int)rem, i);
+	}
+
+	/* Abort half from the middle of the queue, then the rest */
+	abort_cycles = abort_range(0, 2);
+	abort_cycles += abort_range(1, 2);
+
+	TC_PRINT("%d timeouts: add %u cycles, abort %u cycles (avg)\n",
+		 NUM_TIMEOUTS, add_cycles / NUM_TIMEOUTS,
+		 abort_cycles / NUM_TIMEOUTS);
+
+	zassert_equal(atomic_get(&fired_count), 0,
+		      "long timeouts expired during the test");
+}
+
+/**
+ * @brief Check that 10k concurrent short timeouts all expire on time
+ *
+ * @ingroup kernel_timeout_tests
+ */
+void test_timeout_mass_expiry(void)
+{
+	uint32_t add_cycles;
+
+	atomic_set(&fired_count, 0);
+	add_all(1, SHORT_SPAN_TICKS, &add_cycles);
+
+	k_sleep(K_TICKS(SHORT_SPAN_TICKS + 2));
+
+	zassert_equal(atomic_get(&fired_count), NUM_TIMEOUTS,
+		      "only %d of %d timeouts expired",
+		      (int)atomic_get(&fired_count), NUM_TIMEOUTS);
+
+	for (int i = 0; i < NUM_TIMEOUTS; i++) {
+		zassert_true(timeouts[i].fired, "timeout %d lost", i);
+		zassert_false(timeouts[i].early, "timeout %d fired early", i);
+	}
+
+	TC_PRINT("%d short timeouts: add %u cycles (avg), all expired\n",
+		 NUM_TIMEOUTS, add_cycles / NUM_TIMEOUTS);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(timeout_stress,
+			 ztest_unit_test(test_timeout_insert_abort),
+			 ztest_unit_test(test_timeout_mass_expiry));
+	ztest_run_test_suite(timeout_stress);
+}
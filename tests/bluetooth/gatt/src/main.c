@@ -222,6 +222,15 @@ void test_gatt_foreach(void)
 		zassert_equal(attr->user_data, &nfy_enabled,
 			      "Attribute value don't match");
 	}
+
+	/* Unregistered attributes shall no longer be found */
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		     "Test service1 unregister failed");
+	num = 0;
+	bt_gatt_foreach_attr(test_attrs[0].handle, 0xffff, count_attr, &num);
+	zassert_equal(num, 3, "Number of attributes don't match");
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		     "Test service1 re-registration failed");
 }
 
 void test_gatt_read(void)
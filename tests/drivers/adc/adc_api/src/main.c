@@ -15,6 +15,7 @@ extern void test_adc_asynchronous_call(void);
 extern void test_adc_sample_with_interval(void);
 extern void test_adc_repeated_samplings(void);
 extern void test_adc_invalid_request(void);
+extern void test_adc_stream(void);
 extern const struct device *get_adc_device(void);
 extern struct k_poll_signal async_sig;
 
@@ -33,6 +34,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_adc_asynchronous_call),
 			 ztest_unit_test(test_adc_sample_with_interval),
 			 ztest_unit_test(test_adc_repeated_samplings),
-			 ztest_user_unit_test(test_adc_invalid_request));
+			 ztest_user_unit_test(test_adc_invalid_request),
+			 ztest_unit_test(test_adc_stream));
 	ztest_run_test_suite(adc_basic_test);
 }
@@ -611,3 +611,73 @@ void test_adc_invalid_request(void)
 {
 	zassert_true(test_task_invalid_request() == TC_PASS, NULL);
 }
+
+/*
+ * test_adc_stream
+ */
+#if defined(CONFIG_ADC_STREAM)
+#define STREAM_HALVES 4
+static int16_t m_stream_buffer[2 * 16];
+static size_t m_stream_size;
+static K_SEM_DEFINE(m_stream_sem, 0, STREAM_HALVES);
+
+/* Called from the ADC interrupt */
+static void stream_callback(const struct device *dev, void *buffer,
+			    size_t size, void *user_data)
+{
+	m_stream_size = size;
+	k_sem_give(&m_stream_sem);
+}
+
+static int test_task_stream(void)
+{
+	int ret;
+	const struct adc_sequence_options options = {
+		.interval_us = 20,
+	};
+	const struct adc_sequence sequence = {
+		.options     = &options,
+		.channels    = BIT(ADC_1ST_CHANNEL_ID),
+		.buffer      = m_stream_buffer,
+		.buffer_size = sizeof(m_stream_buffer),
+		.resolution  = ADC_RESOLUTION,
+	};
+
+	const struct device *adc_dev = init_adc();
+
+	if (!adc_dev) {
+		return TC_FAIL;
+	}
+
+	ret = adc_stream_start(adc_dev, &sequence, stream_callback, NULL);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0, "adc_stream_start() failed with code %d", ret);
+
+	for (int i = 0; i < STREAM_HALVES; i++) {
+		ret = k_sem_take(&m_stream_sem, K_MSEC(100));
+		zassert_equal(ret, 0, "Half %d was not filled", i);
+		zassert_equal(m_stream_size, sizeof(m_stream_buffer) / 2,
+			      "Unexpected half size %u", m_stream_size);
+	}
+
+	ret = adc_stream_stop(adc_dev);
+	zassert_equal(ret, 0, "adc_stream_stop() failed with code %d", ret);
+
+	ret = adc_stream_stop(adc_dev);
+	zassert_equal(ret, -EALREADY, "Stream was not stopped");
+
+	/* Regular requests are served again once the stream is stopped */
+	return test_task_one_channel();
+}
+#endif /* defined(CONFIG_ADC_STREAM) */
+
+void test_adc_stream(void)
+{
+#if defined(CONFIG_ADC_STREAM)
+	zassert_true(test_task_stream() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_STREAM) */
+}
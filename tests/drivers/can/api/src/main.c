@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <drivers/can.h>
+#include <drivers/can_id_filter.h>
 #include <ztest.h>
 #include <strings.h>
 
@@ -606,6 +607,60 @@ static void test_send_invalid_dlc(void)
 		      "ret [%d] not equal to %d", ret, CAN_TX_EINVAL);
 }
 
+#ifdef CONFIG_CAN_ID_FILTER
+static const uint32_t test_id_set[] = {
+	0x100, 0x101, 0x102, 0x200, 0x201, 0x300
+};
+
+static struct can_id_filter test_id_filter;
+static struct can_rx_ring test_rx_ring;
+static struct zcan_frame test_rx_ring_frames[8];
+
+/*
+ * Receive a set of identifiers with fewer hardware filters than
+ * identifiers. Frames that pass a mask without being part of the set must
+ * be dropped, the others are read in a single batch.
+ */
+static void test_id_filter_batch(void)
+{
+	static const uint32_t sent_ids[] = { 0x101, 0x103, 0x301, 0x300 };
+	struct zcan_frame frames[ARRAY_SIZE(test_rx_ring_frames)];
+	struct zcan_frame msg = test_std_msg;
+	int ret;
+
+	can_rx_ring_init(&test_rx_ring, test_rx_ring_frames,
+			 ARRAY_SIZE(test_rx_ring_frames));
+
+	ret = can_id_filter_attach(&test_id_filter, can_dev, test_id_set,
+				   ARRAY_SIZE(test_id_set),
+				   CAN_STANDARD_IDENTIFIER, &test_rx_ring);
+	zassert_equal(ret, 0, "Can't attach the identifier set (%d)", ret);
+
+	for (int i = 0; i < ARRAY_SIZE(sent_ids); i++) {
+		msg.std_id = sent_ids[i];
+		send_test_msg(can_dev, &msg);
+	}
+
+	ret = can_rx_ring_get(&test_rx_ring, frames, ARRAY_SIZE(frames),
+			      TEST_RECEIVE_TIMEOUT);
+	zassert_equal(ret, 2, "Got %d frames instead of 2", ret);
+	zassert_equal(frames[0].std_id, 0x101, "Wrong first frame");
+	zassert_equal(frames[1].std_id, 0x300, "Wrong second frame");
+	check_msg(&frames[0], &test_std_msg, 0x7FF);
+
+	ret = can_rx_ring_get(&test_rx_ring, frames, ARRAY_SIZE(frames),
+			      TEST_RECEIVE_TIMEOUT);
+	zassert_equal(ret, -EAGAIN, "Got a frame not part of the set");
+
+	can_id_filter_detach(&test_id_filter);
+}
+#else
+static void test_id_filter_batch(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	k_sem_init(&rx_isr_sem, 0, 1);
@@ -626,6 +681,7 @@ void test_main(void)
 			 ztest_unit_test(test_send_receive_ext_masked),
 			 ztest_unit_test(test_send_receive_buffer),
 			 ztest_unit_test(test_send_receive_wrong_id),
+			 ztest_unit_test(test_id_filter_batch),
 			 ztest_unit_test(test_send_invalid_dlc));
 	ztest_run_test_suite(can_driver);
 }
@@ -12,6 +12,7 @@ extern void test_dma_m2m_chan0_burst8(void);
 extern void test_dma_m2m_chan1_burst8(void);
 extern void test_dma_m2m_chan0_burst16(void);
 extern void test_dma_m2m_chan1_burst16(void);
+extern void test_dma_memcpy_sg(void);
 
 #ifdef CONFIG_SHELL
 TC_CMD_DEFINE(test_dma_m2m_chan0_burst8)
@@ -36,7 +37,8 @@ void test_main(void)
 			 ztest_unit_test(test_dma_m2m_chan0_burst8),
 			 ztest_unit_test(test_dma_m2m_chan1_burst8),
 			 ztest_unit_test(test_dma_m2m_chan0_burst16),
-			 ztest_unit_test(test_dma_m2m_chan1_burst16));
+			 ztest_unit_test(test_dma_m2m_chan1_burst16),
+			 ztest_unit_test(test_dma_memcpy_sg));
 	ztest_run_test_suite(dma_m2m_test);
 #endif
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Verify the DMA memory copy service
+ * @details
+ * - Test Steps
+ *   -# Copy a scatter-gather list of three segments
+ *   -# Copy a single buffer from the completion callback
+ * - Expected Results
+ *   -# The data is copied to the destination segments
+ *   -# A busy service reports -EBUSY rather than blocking
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#ifdef CONFIG_DMA_MEMCPY
+#include <drivers/dma_memcpy.h>
+
+#define DMA_DEVICE_NAME CONFIG_DMA_0_NAME
+#define SEG_SIZE 16
+
+static const char src_data[3 * SEG_SIZE] =
+	"It is harder to be kind than to be wise........";
+static char dst_data[3 * SEG_SIZE];
+static char copy_data[sizeof(src_data)];
+
+static struct dma_memcpy mc;
+static K_SEM_DEFINE(done_sem, 0, 2);
+static int done_status;
+
+static void copy_done(void *user_data, int status)
+{
+	done_status = status;
+	k_sem_give(&done_sem);
+}
+
+static void sg_done(void *user_data, int status)
+{
+	done_status = status;
+	if (status == 0) {
+		/* The channel is free again when the callback runs */
+		status = dma_memcpy_async(&mc, copy_data, dst_data,
+					  sizeof(dst_data), copy_done, NULL);
+	}
+
+	if (status != 0) {
+		done_status = status;
+		k_sem_give(&done_sem);
+	}
+
+	k_sem_give(&done_sem);
+}
+#endif /* CONFIG_DMA_MEMCPY */
+
+void test_dma_memcpy_sg(void)
+{
+#ifdef CONFIG_DMA_MEMCPY
+	const struct device *dma = device_get_binding(DMA_DEVICE_NAME);
+	/* Copy the segments out of order to check the list is followed */
+	const struct dma_memcpy_seg segs[] = {
+		{ &dst_data[2 * SEG_SIZE], &src_data[2 * SEG_SIZE], SEG_SIZE },
+		{ &dst_data[0], &src_data[0], SEG_SIZE },
+		{ &dst_data[SEG_SIZE], &src_data[SEG_SIZE], SEG_SIZE },
+	};
+	int ret;
+
+	zassert_not_null(dma, "Cannot get dma controller");
+
+	dma_memcpy_init(&mc, dma, 0);
+
+	ret = dma_memcpy_sg_async(&mc, segs, 0, sg_done, NULL);
+	zassert_equal(ret, -EINVAL, "Empty list accepted");
+
+	ret = dma_memcpy_sg_async(&mc, segs, ARRAY_SIZE(segs), sg_done, NULL);
+	zassert_equal(ret, 0, "Cannot start the copy (%d)", ret);
+
+	for (int i = 0; i < 2; i++) {
+		ret = k_sem_take(&done_sem, K_MSEC(1000));
+		zassert_equal(ret, 0, "Copy %d timed out", i);
+		zassert_equal(done_status, 0, "Copy %d failed (%d)", i,
+			      done_status);
+	}
+
+	zassert_mem_equal(dst_data, src_data, sizeof(src_data), NULL);
+	zassert_mem_equal(copy_data, src_data, sizeof(src_data), NULL);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_DMA_MEMCPY */
+}
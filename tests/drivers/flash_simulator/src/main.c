@@ -306,6 +306,84 @@ static void test_get_erase_value(void)
 		      FLASH_SIMULATOR_ERASE_VALUE);
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+static int async_cb_result;
+static int async_cb_cnt;
+
+static void async_cb(const struct device *dev, struct flash_async_req *req,
+		     int result)
+{
+	async_cb_result = result;
+	async_cb_cnt++;
+}
+
+static int async_wait(struct k_poll_signal *signal)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, signal);
+	int rc;
+
+	rc = k_poll(&event, 1, K_SECONDS(1));
+	zassert_equal(0, rc, "request did not complete");
+	zassert_true(signal->signaled, NULL);
+
+	rc = signal->result;
+	k_poll_signal_reset(signal);
+
+	return rc;
+}
+
+static void test_async(void)
+{
+	struct k_poll_signal signal;
+	struct flash_async_req req = {
+		.cb = async_cb,
+		.signal = &signal,
+	};
+	uint32_t data = ~(PATTERN8TO32BIT(FLASH_SIMULATOR_ERASE_VALUE));
+	uint32_t r_data = 0;
+	int rc;
+
+	k_poll_signal_init(&signal);
+	async_cb_cnt = 0;
+
+	rc = flash_write_protection_set(flash_dev, false);
+	zassert_equal(0, rc, NULL);
+
+	rc = flash_erase_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       FLASH_SIMULATOR_ERASE_UNIT, &req);
+	zassert_equal(0, rc, "flash_erase_async should succeed");
+	zassert_equal(0, async_wait(&signal), "erase failed");
+
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       &data, sizeof(data), &req);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+	zassert_equal(0, async_wait(&signal), "write failed");
+
+	rc = flash_read_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			      &r_data, sizeof(r_data), &req);
+	zassert_equal(0, rc, "flash_read_async should succeed");
+	zassert_equal(0, async_wait(&signal), "read failed");
+	zassert_equal(data, r_data, "read 0x%08x, expected 0x%08x",
+		      r_data, data);
+
+	/* Errors of the operation are reported on completion */
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       &data, sizeof(data), &req);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+	zassert_equal(-EIO, async_wait(&signal), "double write succeeded");
+
+	zassert_equal(4, async_cb_cnt, "callback called %d times",
+		      async_cb_cnt);
+	zassert_equal(-EIO, async_cb_result, NULL);
+}
+#else
+static void test_async(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -317,7 +395,8 @@ void test_main(void)
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
@@ -13,6 +13,7 @@
  */
 
 #include <drivers/i2c.h>
+#include <drivers/i2c_queue.h>
 #include <zephyr.h>
 #include <ztest.h>
 
@@ -127,6 +128,70 @@ static int test_burst_gy271(void)
 	return TC_PASS;
 }
 
+#ifdef CONFIG_I2C_QUEUE
+static K_SEM_DEFINE(queue_done, 0, 1);
+static int queue_result;
+
+static void queue_cb(struct i2c_transaction *txn, int result)
+{
+	queue_result = result;
+	k_sem_give(&queue_done);
+}
+
+static int test_queue_gy271(void)
+{
+	unsigned char datas[6];
+	uint8_t reg = 0x03;
+	struct i2c_msg msgs[2];
+	struct i2c_transaction txn = {
+		.msgs = msgs,
+		.num_msgs = ARRAY_SIZE(msgs),
+		.addr = 0x1E,
+		.cb = queue_cb,
+	};
+	static struct i2c_queue queue;
+	const struct device *i2c_dev = device_get_binding(I2C_DEV_NAME);
+
+	if (!i2c_dev) {
+		TC_PRINT("Cannot get I2C device\n");
+		return TC_FAIL;
+	}
+
+	if (i2c_configure(i2c_dev, i2c_cfg)) {
+		TC_PRINT("I2C config failed\n");
+		return TC_FAIL;
+	}
+
+	msgs[0].buf = &reg;
+	msgs[0].len = 1U;
+	msgs[0].flags = I2C_MSG_WRITE;
+
+	msgs[1].buf = datas;
+	msgs[1].len = sizeof(datas);
+	msgs[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+
+	i2c_queue_init(&queue, i2c_dev, NULL);
+
+	/* 1. verify i2c_queue_submit() */
+	if (i2c_queue_submit(&queue, &txn)) {
+		TC_PRINT("Fail to queue read from sensor GY271\n");
+		return TC_FAIL;
+	}
+
+	/* 2. verify the completion callback */
+	if (k_sem_take(&queue_done, K_MSEC(100)) || queue_result) {
+		TC_PRINT("Fail to fetch sample from sensor GY271\n");
+		return TC_FAIL;
+	}
+
+	TC_PRINT("axis raw data: %d %d %d %d %d %d\n",
+				datas[0], datas[1], datas[2],
+				datas[3], datas[4], datas[5]);
+
+	return TC_PASS;
+}
+#endif
+
 void test_i2c_gy271(void)
 {
 	zassert_true(test_gy271() == TC_PASS, NULL);
@@ -136,3 +201,12 @@ void test_i2c_burst_gy271(void)
 {
 	zassert_true(test_burst_gy271() == TC_PASS, NULL);
 }
+
+void test_i2c_queue_gy271(void)
+{
+#ifdef CONFIG_I2C_QUEUE
+	zassert_true(test_queue_gy271() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -15,6 +15,9 @@ LOG_MODULE_REGISTER(main);
 #include <ztest.h>
 
 #include <drivers/spi.h>
+#if defined(CONFIG_SPI_QUEUE)
+#include <drivers/spi_queue.h>
+#endif
 
 #define SPI_DRV_NAME	CONFIG_SPI_LOOPBACK_DRV_NAME
 #define SPI_SLAVE	CONFIG_SPI_LOOPBACK_SLAVE_NUMBER
@@ -550,6 +553,88 @@ static int spi_async_call(const struct device *dev,
 }
 #endif
 
+#if defined(CONFIG_SPI_QUEUE)
+static struct spi_queue queue;
+static K_SEM_DEFINE(queue_done, 0, 2);
+
+static void spi_queue_cb(struct spi_transaction *txn, int result)
+{
+	zassert_false(result, "Queued transaction failed");
+
+	k_sem_give(&queue_done);
+}
+
+/* two transactions submitted back to back, each with its own config */
+static int spi_queue_call(const struct device *dev,
+			  struct spi_config *spi_conf_1,
+			  struct spi_config *spi_conf_2)
+{
+	const struct spi_buf tx_bufs[] = {
+		{ .buf = buffer_tx, .len = BUF_SIZE, },
+		{ .buf = buffer2_tx, .len = BUF2_SIZE, },
+	};
+	const struct spi_buf rx_bufs[] = {
+		{ .buf = buffer_rx, .len = BUF_SIZE, },
+		{ .buf = buffer2_rx, .len = BUF2_SIZE, },
+	};
+	const struct spi_buf_set tx[] = {
+		{ .buffers = &tx_bufs[0], .count = 1 },
+		{ .buffers = &tx_bufs[1], .count = 1 },
+	};
+	const struct spi_buf_set rx[] = {
+		{ .buffers = &rx_bufs[0], .count = 1 },
+		{ .buffers = &rx_bufs[1], .count = 1 },
+	};
+	struct spi_transaction txn[] = {
+		{
+			.config = spi_conf_1,
+			.tx_bufs = &tx[0],
+			.rx_bufs = &rx[0],
+			.cb = spi_queue_cb,
+		},
+		{
+			.config = spi_conf_2,
+			.tx_bufs = &tx[1],
+			.rx_bufs = &rx[1],
+			.cb = spi_queue_cb,
+		},
+	};
+	int ret;
+
+	LOG_INF("Start queued calls");
+
+	(void)memset(buffer_rx, 0, sizeof(buffer_rx));
+	(void)memset(buffer2_rx, 0, sizeof(buffer2_rx));
+
+	spi_queue_init(&queue, dev);
+
+	for (int i = 0; i < ARRAY_SIZE(txn); i++) {
+		ret = spi_queue_submit(&queue, &txn[i]);
+		if (ret) {
+			LOG_ERR("Code %d", ret);
+			zassert_false(ret, "SPI queue submit failed");
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(txn); i++) {
+		ret = k_sem_take(&queue_done, K_MSEC(1000));
+		zassert_false(ret, "Queued transaction timed out");
+	}
+
+	if (memcmp(buffer_tx, buffer_rx, BUF_SIZE) ||
+	    memcmp(buffer2_tx, buffer2_rx, BUF2_SIZE)) {
+		LOG_ERR("Buffer contents are different");
+		zassert_false(1, "Buffer contents are different");
+		return -1;
+	}
+
+	LOG_INF("Passed");
+
+	return 0;
+}
+#endif
+
 static int spi_resource_lock_test(const struct device *lock_dev,
 				  struct spi_config *spi_conf_lock,
 				  const struct device *try_dev,
@@ -643,6 +728,15 @@ void test_spi_loopback(void)
 		goto end;
 	}
 
+#if defined(CONFIG_SPI_QUEUE)
+	/* a locked config would keep the other one off the bus */
+	spi_cfg_slow.operation &= ~SPI_LOCK_ON;
+
+	if (spi_queue_call(spi_slow, &spi_cfg_slow, &spi_cfg_fast)) {
+		goto end;
+	}
+#endif
+
 	LOG_INF("All tx/rx passed");
 end:
 #if (CONFIG_SPI_ASYNC)
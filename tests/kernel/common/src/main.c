@@ -34,6 +34,7 @@ extern void test_sys_get_le64(void);
 extern void test_sys_put_le64(void);
 extern void test_atomic(void);
 extern void test_printk(void);
+extern void test_printk_package(void);
 extern void test_timeout_order(void);
 extern void test_clock_cycle(void);
 extern void test_clock_uptime(void);
@@ -135,6 +136,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_atomic),
 			 ztest_unit_test(test_bitfield),
 			 ztest_unit_test(test_printk),
+			 ztest_unit_test(test_printk_package),
 			 ztest_1cpu_unit_test(test_timeout_order),
 			 ztest_1cpu_user_unit_test(test_clock_uptime),
 			 ztest_unit_test(test_clock_cycle),
@@ -5,6 +5,7 @@
  */
 
 #include <ztest.h>
+#include <sys/cbprintf.h>
 
 #define BUF_SZ 1024
 
@@ -155,3 +156,58 @@ void test_printk(void)
 /**
  * @}
  */
+
+#ifdef CONFIG_CBPRINTF_PACKAGE
+static int pkg_out(int character, void *ctx)
+{
+	pk_console[pos++] = (char)character;
+	return character;
+}
+
+#define PKG_TEST(...) do { \
+		int len = cbprintf_package(pkg, sizeof(pkg), __VA_ARGS__); \
+		zassert_true(len > 0, "cbprintf_package failed"); \
+		zassert_equal(cbprintf_package(NULL, 0, __VA_ARGS__), len, \
+			      "cbprintf_package size mismatch"); \
+		count += cbpprintf(pkg_out, NULL, pkg); \
+	} while (false)
+
+/**
+ * @brief Test formatting deferred through cbprintf_package()
+ *
+ * @see cbprintf_package(), cbpprintf()
+ */
+void test_printk_package(void)
+{
+	static long long pkg[16];
+	int count = 0;
+
+	pos = 0;
+	PKG_TEST("%zu %hhu %hu %u %lu %llu\n", stv, uc, usi, ui, ul, ull);
+	PKG_TEST("%c %hhd %hd %d %ld %lld\n", c, c, ssi, si, sl, sll);
+	PKG_TEST("0x%x 0x%02x 0x%04x 0x%08x 0x%016x\n", 1, 1, 1, 1, 1);
+	PKG_TEST("0x%x 0x%2x 0x%4x 0x%8x\n", 1, 1, 1, 1);
+	PKG_TEST("%d %02d %04d %08d\n", 42, 42, 42, 42);
+	PKG_TEST("%d %02d %04d %08d\n", -42, -42, -42, -42);
+	PKG_TEST("%u %2u %4u %8u\n", 42, 42, 42, 42);
+	PKG_TEST("%u %02u %04u %08u\n", 42, 42, 42, 42);
+	PKG_TEST("%-8u%-6d%-4x  %8d\n", 0xFF, 42, 0xABCDEF, 42);
+	PKG_TEST("%lld %lld %llu %llx\n", 0xFFFFFFFFFULL, -1LL, -1ULL, -1ULL);
+	pk_console[pos] = '\0';
+	zassert_equal(count, strlen(expected), "cbpprintf count");
+	zassert_true((strcmp(pk_console, expected) == 0), "cbpprintf failed");
+
+	pos = 0;
+	PKG_TEST("0x%x %p %-2p\n", hex, ptr, (char *)42);
+	pk_console[pos] = '\0';
+	zassert_true((strcmp(pk_console, expected2) == 0), "cbpprintf failed");
+
+	zassert_equal(cbprintf_package(pkg, sizeof(void *) + 4, "%d %d", 1, 2),
+		      -ENOSPC, "package should not fit");
+}
+#else
+void test_printk_package(void)
+{
+	ztest_test_skip();
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/mem_manage.h>
+
+/* More anonymous memory than there are free page frames, up to the backing
+ * store capacity minus its page fault reserve
+ */
+#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES / 2)
+
+static uint8_t *arena;
+static size_t arena_size;
+
+static uint8_t pattern(size_t i)
+{
+	return (uint8_t)((i / CONFIG_MMU_PAGE_SIZE) + (i % 251));
+}
+
+/**
+ * Show that more anonymous memory than physical RAM can be used
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_demand_paging_overcommit(void)
+{
+	struct k_mem_paging_stats_t stats;
+
+	arena_size = (k_mem_free_get() + EXTRA_PAGES) * CONFIG_MMU_PAGE_SIZE;
+	arena = k_mem_map(arena_size, K_MEM_PERM_RW);
+	zassert_not_null(arena, "overcommitted mapping failed");
+
+	for (size_t i = 0; i < arena_size; i++) {
+		arena[i] = pattern(i);
+	}
+
+	/* The first pages were evicted to make room for the last ones */
+	for (size_t i = 0; i < arena_size; i++) {
+		zassert_equal(arena[i], pattern(i), "bad value at %zu", i);
+	}
+
+	k_mem_paging_stats_get(&stats);
+	zassert_true(stats.pagefaults > 0, "no page faults");
+	zassert_true(stats.evictions_dirty > 0, "no dirty evictions");
+}
+
+/**
+ * Show that pinned pages stay resident and others can be paged out
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_demand_paging_pin(void)
+{
+	struct k_mem_paging_stats_t before, after;
+
+	zassert_not_null(arena, "no arena");
+
+	k_mem_pin(arena, CONFIG_MMU_PAGE_SIZE);
+	zassert_equal(k_mem_page_out(arena, CONFIG_MMU_PAGE_SIZE), -EPERM,
+		      "pinned page paged out");
+	k_mem_unpin(arena, CONFIG_MMU_PAGE_SIZE);
+
+	zassert_equal(k_mem_page_out(arena, CONFIG_MMU_PAGE_SIZE), 0,
+		      "page out failed");
+
+	k_mem_paging_stats_get(&before);
+	zassert_equal(arena[0], pattern(0), "bad value after page out");
+	k_mem_paging_stats_get(&after);
+	zassert_equal(after.pagefaults, before.pagefaults + 1,
+		      "no page fault on paged out page");
+
+	/* Paged in ahead of the access, no fault */
+	zassert_equal(k_mem_page_out(arena, CONFIG_MMU_PAGE_SIZE), 0,
+		      "page out failed");
+	k_mem_page_in(arena, CONFIG_MMU_PAGE_SIZE);
+	k_mem_paging_stats_get(&before);
+	zassert_equal(arena[1], pattern(1), "bad value after page in");
+	k_mem_paging_stats_get(&after);
+	zassert_equal(after.pagefaults, before.pagefaults,
+		      "page fault on paged in page");
+}
+
+/**
+ * Show that the kernel image is never paged out
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_demand_paging_kernel_pinned(void)
+{
+	void *page = (void *)ROUND_DOWN((uintptr_t)&arena,
+					CONFIG_MMU_PAGE_SIZE);
+
+	zassert_equal(k_mem_page_out(page, CONFIG_MMU_PAGE_SIZE), -EPERM,
+		      "kernel image paged out");
+}
+
+/* ztest main entry*/
+void test_main(void)
+{
+	ztest_test_suite(test_demand_paging,
+			ztest_unit_test(test_demand_paging_overcommit),
+			ztest_unit_test(test_demand_paging_pin),
+			ztest_unit_test(test_demand_paging_kernel_pinned)
+			);
+	ztest_run_test_suite(test_demand_paging);
+}
@@ -128,6 +128,38 @@ void test_z_mem_map_exec(void)
 }
 #endif /* SKIP_EXECUTE_TESTS */
 
+/**
+ * Show that anonymous memory mappings are zeroed and consume free page frames
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_k_mem_map(void)
+{
+	size_t free_before = k_mem_free_get();
+	uint8_t *mapped;
+
+	expect_fault = false;
+
+	if (free_before < 2) {
+		ztest_test_skip();
+	}
+
+	mapped = k_mem_map(2 * CONFIG_MMU_PAGE_SIZE, K_MEM_PERM_RW);
+	zassert_not_null(mapped, "no anonymous memory mapping");
+	zassert_equal(k_mem_free_get(), free_before - 2,
+		      "free page frames not consumed");
+
+	for (int i = 0; i < 2 * CONFIG_MMU_PAGE_SIZE; i++) {
+		zassert_equal(mapped[i], 0, "not zeroed at %d", i);
+		mapped[i] = (uint8_t)(i % 256);
+	}
+
+	for (int i = 0; i < 2 * CONFIG_MMU_PAGE_SIZE; i++) {
+		zassert_equal(mapped[i], (uint8_t)(i % 256),
+			      "bad value at %d", i);
+	}
+}
+
 /**
  * Show that memory mapping doesn't have unintended side effects
  *
@@ -162,6 +194,7 @@ void test_main(void)
 	ztest_test_suite(test_mem_map,
 			ztest_unit_test(test_z_mem_map_rw),
 			ztest_unit_test(test_z_mem_map_exec),
+			ztest_unit_test(test_k_mem_map),
 			ztest_unit_test(test_z_mem_map_side_effect)
 			);
 	ztest_run_test_suite(test_mem_map);
@@ -30,6 +30,7 @@ void test_main(void)
 		ztest_unit_test(test_mem_domain_invalid_access),
 		ztest_unit_test(test_mem_domain_no_writes_to_ro),
 		ztest_unit_test(test_mem_domain_remove_add_partition),
+		ztest_unit_test(test_mem_domain_update),
 		ztest_unit_test(test_mem_domain_api_supervisor_only),
 		ztest_unit_test(test_mem_domain_boot_threads),
 		ztest_unit_test(test_mem_domain_migration),
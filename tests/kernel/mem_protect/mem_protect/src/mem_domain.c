@@ -193,6 +193,32 @@ void test_mem_domain_remove_add_partition(void)
 	spawn_child_thread(rw_part_access, &test_domain, false);
 }
 
+/**
+ * @brief Show that several partitions can be updated at once
+ *
+ * Show that the partitions removed by one update generate faults if their
+ * data is accessed, and that adding them back in one update restores access.
+ *
+ * @see k_mem_domain_update()
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_mem_domain_update(void)
+{
+	struct k_mem_partition *parts[] = { &rw_parts[0], &ro_part };
+
+	k_mem_domain_update(&test_domain, parts, ARRAY_SIZE(parts), NULL, 0);
+
+	spawn_child_thread(rw_part_access, &test_domain, true);
+	spawn_child_thread(ro_part_access, &test_domain, true);
+
+	/* Restore test_domain contents so we don't mess up other tests */
+	k_mem_domain_update(&test_domain, NULL, 0, parts, ARRAY_SIZE(parts));
+
+	spawn_child_thread(rw_part_access, &test_domain, false);
+	spawn_child_thread(ro_part_access, &test_domain, false);
+}
+
 /* user mode will attempt to initialize this and fail */
 static struct k_mem_domain no_access_domain;
 
@@ -18,6 +18,7 @@ extern void test_mem_domain_valid_access(void);
 extern void test_mem_domain_invalid_access(void);
 extern void test_mem_domain_no_writes_to_ro(void);
 extern void test_mem_domain_remove_add_partition(void);
+extern void test_mem_domain_update(void);
 extern void test_mem_domain_api_supervisor_only(void);
 extern void test_mem_domain_boot_threads(void);
 extern void test_mem_domain_migration(void);
@@ -10,6 +10,7 @@
 #include <kernel_internal.h>
 
 #define SEM_ARRAY_SIZE	16
+#define DYN_SEM_COUNT	48
 
 /* Show that extern declarations don't interfere with detecting kernel
  * objects, this was at one point a problem.
@@ -112,10 +113,63 @@ void test_generic_object(void)
 	}
 }
 
+/**
+ * @brief Test lookups of many dynamic objects
+ *
+ * @details Allocate enough objects for the dynamic object index to grow
+ * several times, free every other one and check that exactly the live
+ * objects are still found, then reuse the freed slots.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_free()
+ */
+void test_dyn_object_lookup(void)
+{
+	static struct k_sem *sems[DYN_SEM_COUNT];
+	int i;
+
+	for (i = 0; i < DYN_SEM_COUNT; i++) {
+		sems[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(sems[i], "couldn't allocate semaphore %d", i);
+	}
+
+	for (i = 0; i < DYN_SEM_COUNT; i++) {
+		zassert_not_null(z_object_find(sems[i]), "lost object %d", i);
+	}
+
+	for (i = 0; i < DYN_SEM_COUNT; i += 2) {
+		k_object_free(sems[i]);
+	}
+
+	for (i = 0; i < DYN_SEM_COUNT; i++) {
+		if ((i % 2) == 0) {
+			zassert_is_null(z_object_find(sems[i]),
+					"freed object %d still found", i);
+		} else {
+			zassert_not_null(z_object_find(sems[i]),
+					 "lost object %d", i);
+		}
+	}
+
+	for (i = 0; i < DYN_SEM_COUNT; i += 2) {
+		sems[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(sems[i], "couldn't allocate semaphore %d", i);
+	}
+
+	for (i = 0; i < DYN_SEM_COUNT; i++) {
+		zassert_not_null(z_object_find(sems[i]), "lost object %d", i);
+		k_object_free(sems[i]);
+		zassert_is_null(z_object_find(sems[i]),
+				"freed object %d still found", i);
+	}
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_dyn_object_lookup));
 	ztest_run_test_suite(object_validation);
 }
@@ -7,6 +7,7 @@
 #include <zephyr.h>
 #include <syscall_handler.h>
 #include <ztest.h>
+#include <sys/syscall_batch.h>
 #include "test_syscalls.h"
 
 #define BUF_SIZE	32
@@ -383,6 +384,39 @@ void test_syscall_context(void)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+#ifdef CONFIG_SYSCALL_BATCH
+K_SEM_DEFINE(batch_sem, 0, 10);
+
+/* Show that a batch runs every entry in order, with its own result */
+void test_syscall_batch(void)
+{
+	struct k_syscall_entry entries[4];
+
+	k_sem_give_batch_entry(&entries[0], &batch_sem);
+	k_sem_give_batch_entry(&entries[1], &batch_sem);
+	k_sem_count_get_batch_entry(&entries[2], &batch_sem);
+	k_sem_take_batch_entry(&entries[3], &batch_sem, K_NO_WAIT);
+
+	if (arch_is_user_context()) {
+		zassert_equal(k_syscall_batch(entries, ARRAY_SIZE(entries)),
+			      ARRAY_SIZE(entries), "not all entries run");
+		zassert_equal(entries[2].ret, 2, "wrong semaphore count");
+		zassert_equal(entries[3].ret, 0, "semaphore take failed");
+		zassert_equal(k_sem_count_get(&batch_sem), 1, NULL);
+		k_sem_reset(&batch_sem);
+	} else {
+		zassert_equal(k_syscall_batch(entries, ARRAY_SIZE(entries)),
+			      -ENOSYS, "batch run in supervisor mode");
+		zassert_equal(k_sem_count_get(&batch_sem), 0, NULL);
+	}
+}
+#else
+void test_syscall_batch(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 K_MEM_POOL_DEFINE(test_pool, BUF_SIZE, BUF_SIZE, 4 * NR_THREADS, 4);
 
 void test_main(void)
@@ -390,6 +424,9 @@ void test_main(void)
 	sprintf(kernel_string, "this is a kernel string");
 	sprintf(user_string, "this is a user string");
 	k_thread_resource_pool_assign(k_current_get(), &test_pool);
+#ifdef CONFIG_SYSCALL_BATCH
+	k_object_access_grant(&batch_sem, k_current_get());
+#endif
 
 	ztest_test_suite(syscalls,
 			 ztest_unit_test(test_string_nlen),
@@ -399,7 +436,9 @@ void test_main(void)
 			 ztest_user_unit_test(test_user_string_alloc_copy),
 			 ztest_user_unit_test(test_arg64),
 			 ztest_unit_test(test_syscall_torture),
-			 ztest_unit_test(test_syscall_context)
+			 ztest_unit_test(test_syscall_context),
+			 ztest_unit_test(test_syscall_batch),
+			 ztest_user_unit_test(test_syscall_batch)
 			 );
 	ztest_run_test_suite(syscalls);
 }
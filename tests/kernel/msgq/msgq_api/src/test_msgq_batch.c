@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 5
+
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t batch_send[2 * BATCH_LEN];
+static ZTEST_BMEM uint32_t batch_rec[2 * BATCH_LEN];
+
+static void batch_put_get(struct k_msgq *q)
+{
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < ARRAY_SIZE(batch_send); i++) {
+		batch_send[i] = MSG0 + i;
+	}
+
+	zassert_equal(k_msgq_put_n(q, batch_send, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_n(q, batch_rec, 2, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/* move the read and write pointers away from the buffer start */
+	zassert_equal(k_msgq_put_n(q, batch_send, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_get_n(q, batch_rec, 2, K_NO_WAIT), 2, NULL);
+	zassert_equal(batch_rec[0], MSG0, NULL);
+	zassert_equal(batch_rec[1], MSG0 + 1, NULL);
+
+	/**TESTPOINT: only the messages that fit are sent, across the wrap */
+	ret = k_msgq_put_n(q, &batch_send[3], 2 * BATCH_LEN - 3, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 1, NULL);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN, NULL);
+	zassert_equal(k_msgq_put_n(q, batch_send, 1, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/**TESTPOINT: messages come out in order, across the wrap */
+	ret = k_msgq_get_n(q, batch_rec, ARRAY_SIZE(batch_rec), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	for (i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(batch_rec[i], MSG0 + 2 + i, NULL);
+	}
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test putting and getting batches of messages
+ *
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+void test_msgq_batch(void)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+	batch_put_get(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test putting and getting batches of messages from user mode
+ *
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+void test_msgq_user_batch(void)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN), NULL);
+	batch_put_get(q);
+}
+#endif
+
+/**
+ * @}
+ */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe zero-copy claim API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define CLAIM_PIPE_SIZE 8
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static unsigned char __aligned(4) claim_buf[CLAIM_PIPE_SIZE];
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_SIZE, 4);
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char claim_rx[4];
+static size_t claim_rx_len;
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	(void)k_pipe_get(&claim_pipe, claim_rx, sizeof(claim_rx),
+			 &claim_rx_len, sizeof(claim_rx), K_FOREVER);
+}
+
+/**
+ * @brief Write and read a pipe's buffer in place
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim(void)
+{
+	struct k_pipe pipe;
+	unsigned char *data;
+
+	k_pipe_init(&pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_claim(&pipe, &data, 5), 5, NULL);
+	memcpy(data, "abcde", 5);
+	zassert_equal(k_pipe_put_finish(&pipe, 5), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&pipe), 5, NULL);
+
+	/* claims stop at the end of the buffer */
+	zassert_equal(k_pipe_put_claim(&pipe, &data, 8), 3, NULL);
+	zassert_equal(k_pipe_put_finish(&pipe, 4), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_finish(&pipe, 0), 0, NULL);
+
+	zassert_equal(k_pipe_get_claim(&pipe, &data, 8), 5, NULL);
+	zassert_mem_equal(data, "abcde", 5, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, 2), 0, NULL);
+
+	zassert_equal(k_pipe_get_claim(&pipe, &data, 8), 3, NULL);
+	zassert_mem_equal(data, "cde", 3, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, 4), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, 3), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&pipe), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&pipe, &data, 8), 0, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, 0), 0, NULL);
+}
+
+/**
+ * @brief Committed data is handed to a waiting reader
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish()
+ */
+void test_pipe_claim_reader_wait(void)
+{
+	unsigned char *data;
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			claim_reader, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* the reader pends on the empty pipe */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 4), 4, NULL);
+	memcpy(data, "wxyz", 4);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 4), 0, NULL);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(claim_rx_len, 4, NULL);
+	zassert_mem_equal(claim_rx, "wxyz", 4, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -679,3 +679,78 @@ void test_poll_zero_events(void)
 
 	zassert_equal(k_poll(&event, 0, K_MSEC(50)), -EAGAIN, NULL);
 }
+
+#define SET_NUM_SEMS 4
+
+static struct k_sem set_sems[SET_NUM_SEMS];
+static struct k_poll_event set_events[SET_NUM_SEMS];
+static struct k_poll_set poll_set;
+
+static void poll_set_giver(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+	k_sem_give(&set_sems[1]);
+}
+
+/**
+ * @brief Test persistent poll sets
+ *
+ * @details Check that a poll set only reports the events that are ready,
+ * keeps reporting them while their condition holds, wakes up a waiting
+ * thread and stops reporting events that were removed.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait(),
+ * k_poll_set_remove()
+ */
+void test_poll_set(void)
+{
+	struct k_poll_event *ready[SET_NUM_SEMS];
+	int i;
+
+	k_poll_set_init(&poll_set);
+	for (i = 0; i < SET_NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		k_poll_set_add(&poll_set, &set_events[i]);
+	}
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	k_sem_give(&set_sems[2]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[2], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/* Still available: reported again */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[2], NULL);
+
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* Wake up a waiting thread */
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack), poll_set_giver,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_FOREVER), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[1], NULL);
+	zassert_equal(k_sem_take(&set_sems[1], K_NO_WAIT), 0, NULL);
+	k_thread_join(&test_thread, K_FOREVER);
+
+	for (i = 0; i < SET_NUM_SEMS; i++) {
+		k_poll_set_remove(&poll_set, &set_events[i]);
+	}
+
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, SET_NUM_SEMS,
+				      K_MSEC(20)), -EAGAIN, NULL);
+}
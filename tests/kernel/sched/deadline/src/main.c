@@ -91,9 +91,76 @@ void test_deadline(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+struct k_thread cbs_threads[2];
+
+K_THREAD_STACK_ARRAY_DEFINE(cbs_stacks, 2, STACK_SIZE);
+
+void spinner(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+	}
+}
+#endif
+
+void test_cbs_budget(void)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	k_thread_runtime_stats_t hog, victim;
+	int i;
+
+	/* The hog has the earliest deadline, but may only run for 10ms
+	 * every 100ms. Once it ran out of budget a few times, its
+	 * deadline is after the one of the victim, which gets the CPU.
+	 */
+	for (i = 0; i < 2; i++) {
+		k_thread_create(&cbs_threads[i],
+				cbs_stacks[i], STACK_SIZE,
+				spinner, NULL, NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO,
+				0, K_FOREVER);
+	}
+
+	zassert_equal(k_thread_cbs_set(&cbs_threads[0],
+				       k_ms_to_cyc_ceil32(100),
+				       k_ms_to_cyc_ceil32(10)), -EINVAL,
+		      "budget larger than period accepted");
+	zassert_equal(k_thread_cbs_set(&cbs_threads[0],
+				       k_ms_to_cyc_ceil32(10),
+				       k_ms_to_cyc_ceil32(100)), 0, NULL);
+	k_thread_deadline_set(&cbs_threads[1], k_ms_to_cyc_ceil32(300));
+
+	for (i = 0; i < 2; i++) {
+		k_thread_start(&cbs_threads[i]);
+	}
+
+	k_sleep(K_MSEC(200));
+
+	k_thread_runtime_stats_get(&cbs_threads[0], &hog);
+	k_thread_runtime_stats_get(&cbs_threads[1], &victim);
+
+	for (i = 0; i < 2; i++) {
+		k_thread_abort(&cbs_threads[i]);
+	}
+
+	zassert_true(hog.cbs_overruns >= 3, "hog ran out of budget %u times",
+		     hog.cbs_overruns);
+	zassert_true(victim.execution_cycles > hog.execution_cycles,
+		     "hog took most of the CPU");
+	zassert_equal(victim.cbs_overruns, 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
-			 ztest_unit_test(test_deadline));
+			 ztest_unit_test(test_deadline),
+			 ztest_unit_test(test_cbs_budget));
 	ztest_run_test_suite(suite_deadline);
 }
@@ -544,6 +544,63 @@ void test_get_cpu(void)
 	k_thread_abort(thread_id);
 }
 
+#ifdef CONFIG_SCHED_CPU_PARKING
+static int parked_cpus(void)
+{
+	int parked = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		parked += _kernel.cpus[i].parked;
+	}
+
+	return parked;
+}
+#endif
+
+/**
+ * @brief Test CPUs are parked at low load and woken up when it grows
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details With the test thread alone running, all the other CPUs
+ * park.  Spawning one busy thread per other CPU wakes them all up,
+ * each thread running on its own CPU, and they park again once the
+ * threads exit.
+ */
+void test_cpu_parking(void)
+{
+#ifdef CONFIG_SCHED_CPU_PARKING
+	k_msleep(100);
+	zassert_equal(parked_cpus(), CONFIG_MP_NUM_CPUS - 1,
+		      "idle CPUs not parked");
+
+	spawn_threads(K_PRIO_PREEMPT(10), THREADS_NUM - 1, EQUAL_PRIORITY,
+		      &thread_entry, 0);
+
+	k_msleep(DELAY_US / USEC_PER_MSEC);
+	zassert_equal(parked_cpus(), 0, "CPUs parked under load");
+
+	spin_for_threads_exit();
+
+	for (int i = 0; i < THREADS_NUM - 1; i++) {
+		zassert_true(tinfo[i].executed == 1, "thread %d not run", i);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(tinfo[i].cpu_id, tinfo[j].cpu_id,
+					  "threads %d and %d on one CPU",
+					  i, j);
+		}
+	}
+
+	k_msleep(100);
+	zassert_equal(parked_cpus(), CONFIG_MP_NUM_CPUS - 1,
+		      "idle CPUs not parked again");
+
+	cleanup_resources();
+#else
+	ztest_test_skip();
+#endif
+}
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 /* global variable for testing send IPI */
 static volatile int sched_ipi_has_called;
@@ -641,6 +698,7 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
+			 ztest_unit_test(test_cpu_parking),
 			 ztest_unit_test(test_get_cpu)
 			 );
 	ztest_run_test_suite(smp);
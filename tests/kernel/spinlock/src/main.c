@@ -43,15 +43,15 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!z_spin_is_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(z_spin_is_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!z_spin_is_locked(&l), "Spinlock failed to unlock");
 }
 
 void bounce_once(int id)
@@ -151,7 +151,8 @@ void test_spinlock_mutual_exclusion(void)
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(z_spin_is_locked(&lock_runtime),
+		     "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -171,7 +172,105 @@ void test_spinlock_mutual_exclusion(void)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!z_spin_is_locked(&lock_runtime),
+		     "Spinlock failed to unlock");
+}
+
+#define FAIR_ROUNDS 20000
+
+K_THREAD_STACK_ARRAY_DEFINE(fair_stacks, CONFIG_MP_NUM_CPUS - 1,
+			    CPU1_STACK_SIZE);
+static struct k_thread fair_threads[CONFIG_MP_NUM_CPUS - 1];
+
+static struct k_spinlock fair_lock;
+static atomic_t fair_ready;
+static volatile bool fair_stop;
+static uint32_t fair_total;
+static uint32_t fair_count[CONFIG_MP_NUM_CPUS];
+
+static void fair_contend(int id)
+{
+	k_spinlock_key_t key;
+
+	/* Start hammering the lock only once every CPU is ready */
+	atomic_inc(&fair_ready);
+	while (atomic_get(&fair_ready) < CONFIG_MP_NUM_CPUS) {
+	}
+
+	while (!fair_stop) {
+		key = k_spin_lock(&fair_lock);
+
+		fair_count[id]++;
+		if (++fair_total >= FAIR_ROUNDS) {
+			fair_stop = true;
+		}
+		k_busy_wait(1);
+
+		k_spin_unlock(&fair_lock, key);
+	}
+}
+
+static void fair_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	fair_contend(POINTER_TO_INT(p1));
+}
+
+/**
+ * @brief Test spinlock fairness under contention
+ *
+ * @details Every CPU repeatedly takes and releases the same lock
+ * until FAIR_ROUNDS acquisitions have been made, then the share of
+ * acquisitions each CPU got is reported.  With ticket spinlocks the
+ * lock is handed out in arrival order, so every CPU must get a fair
+ * share.
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_lock(), k_spin_unlock()
+ */
+void test_spinlock_fairness(void)
+{
+	uint32_t min = UINT32_MAX, max = 0;
+	int i;
+
+	/* The bounce test leaves its helper spinning forever */
+	k_thread_abort(&cpu1_thread);
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_create(&fair_threads[i], fair_stacks[i],
+				CPU1_STACK_SIZE, fair_fn,
+				INT_TO_POINTER(i + 1), NULL, NULL,
+				0, 0, K_NO_WAIT);
+	}
+
+	fair_contend(0);
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_join(&fair_threads[i], K_FOREVER);
+	}
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		TC_PRINT("contender %d: %u acquisitions\n", i, fair_count[i]);
+		min = MIN(min, fair_count[i]);
+		max = MAX(max, fair_count[i]);
+	}
+	TC_PRINT("spread (max - min): %u of %u\n", max - min, fair_total);
+
+#ifdef CONFIG_SPINLOCK_STATS
+	TC_PRINT("acquired %u, contended %u\n", fair_lock.acquired,
+		 fair_lock.contended);
+	zassert_equal(fair_lock.acquired, fair_total,
+		      "Acquisition counter mismatch");
+	zassert_true(fair_lock.contended <= fair_lock.acquired,
+		     "More contended than total acquisitions");
+#endif
+
+#ifdef CONFIG_SPINLOCK_TICKET
+	zassert_true(min * 2 >= max, "Ticket lock starved a CPU");
+#endif
 }
 
 void test_main(void)
@@ -179,6 +278,7 @@ void test_main(void)
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
 			 ztest_unit_test(test_spinlock_bounce),
-			 ztest_unit_test(test_spinlock_mutual_exclusion));
+			 ztest_unit_test(test_spinlock_mutual_exclusion),
+			 ztest_unit_test(test_spinlock_fairness));
 	ztest_run_test_suite(spinlock);
 }
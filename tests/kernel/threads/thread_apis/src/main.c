@@ -39,6 +39,7 @@ extern void test_threads_suspend_timeout(void);
 extern void test_threads_suspend(void);
 extern void test_abort_from_isr(void);
 extern void test_essential_thread_abort(void);
+extern void test_thread_runtime_stats_get(void);
 
 struct k_thread tdata;
 #define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
@@ -516,6 +517,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_thread_join),
 			 ztest_unit_test(test_thread_join_isr),
 			 ztest_user_unit_test(test_thread_join_deadlock),
+			 ztest_1cpu_unit_test(test_thread_runtime_stats_get),
 			 ztest_unit_test(test_abort_from_isr)
 			 );
 
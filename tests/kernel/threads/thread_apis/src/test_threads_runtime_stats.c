@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <kernel.h>
+
+#include "tests_thread_apis.h"
+
+#define BUSY_CYCLES 10000U
+
+/**
+ * @brief Test thread runtime statistics
+ *
+ * @details Spin for a while and verify that the cycles charged to the
+ * current thread grow, and that the totals reported for all threads
+ * are never smaller than those of the current thread.
+ *
+ * @ingroup kernel_thread_tests
+ */
+void test_thread_runtime_stats_get(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	k_thread_runtime_stats_t before, after, all;
+	uint32_t start;
+	int ret;
+
+	ret = k_thread_runtime_stats_get(NULL, &before);
+	zassert_equal(ret, -EINVAL, "NULL thread accepted");
+
+	ret = k_thread_runtime_stats_all_get(NULL);
+	zassert_equal(ret, -EINVAL, "NULL stats accepted");
+
+	ret = k_thread_runtime_stats_get(k_current_get(), &before);
+	zassert_equal(ret, 0, "failed to get thread stats");
+
+	start = k_cycle_get_32();
+	while ((k_cycle_get_32() - start) < BUSY_CYCLES) {
+		/* spin */
+	}
+
+	ret = k_thread_runtime_stats_get(k_current_get(), &after);
+	zassert_equal(ret, 0, "failed to get thread stats");
+	zassert_true(after.execution_cycles > before.execution_cycles,
+		     "runtime did not advance");
+
+	ret = k_thread_runtime_stats_all_get(&all);
+	zassert_equal(ret, 0, "failed to get total stats");
+	zassert_true(all.execution_cycles >= after.execution_cycles,
+		     "total runtime smaller than thread runtime");
+#else
+	ztest_test_skip();
+#endif
+}
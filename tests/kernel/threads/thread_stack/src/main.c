@@ -476,6 +476,89 @@ void test_idle_stack(void)
 
 }
 
+#ifdef CONFIG_THREAD_STACK_POOL
+#define POOL_STACKSIZE	CONFIG_THREAD_STACK_POOL_STACK_SIZE
+#define POOL_DIRTY_SIZE	(POOL_STACKSIZE / 2)
+
+static void dirty_stack_entry(void *p1, void *p2, void *p3)
+{
+	volatile char buf[POOL_DIRTY_SIZE];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = 0x55;
+	}
+}
+
+/**
+ * @brief Test the kernel thread stack pool
+ *
+ * @details Exhaust and refill the pool, then check that a stack which
+ * the previous thread dirtied is fully repainted for its next thread.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_thread_stack_alloc(), k_thread_stack_free()
+ */
+void test_stack_pool(void)
+{
+	k_thread_stack_t *stacks[CONFIG_THREAD_STACK_POOL_NUM];
+	k_thread_stack_t *stack;
+	size_t dirty_unused, clean_unused;
+	int i;
+
+	zassert_is_null(k_thread_stack_alloc(POOL_STACKSIZE + 1, 0),
+			"oversized stack allocated");
+
+	for (i = 0; i < CONFIG_THREAD_STACK_POOL_NUM; i++) {
+		stacks[i] = k_thread_stack_alloc(POOL_STACKSIZE, K_USER);
+		zassert_not_null(stacks[i], "pool stack %d not allocated", i);
+	}
+	zassert_is_null(k_thread_stack_alloc(POOL_STACKSIZE, 0),
+			"allocated from an empty pool");
+
+	zassert_equal(k_thread_stack_free(user_stack), -EINVAL,
+		      "freed a stack not from the pool");
+	for (i = 0; i < CONFIG_THREAD_STACK_POOL_NUM; i++) {
+		zassert_equal(k_thread_stack_free(stacks[i]), 0, NULL);
+	}
+	zassert_equal(k_thread_stack_free(stacks[0]), -EINVAL,
+		      "double free accepted");
+
+	stack = k_thread_stack_alloc(POOL_STACKSIZE, 0);
+	zassert_not_null(stack, NULL);
+	k_thread_create(&test_thread, stack, POOL_STACKSIZE,
+			dirty_stack_entry, NULL, NULL, NULL,
+			-1, 0, K_NO_WAIT);
+	k_thread_join(&test_thread, K_FOREVER);
+	zassert_equal(k_thread_stack_space_get(&test_thread, &dirty_unused),
+		      0, NULL);
+	zassert_equal(k_thread_stack_free(stack), 0, NULL);
+
+	/* The same slot comes back, and must look unused again */
+	zassert_equal(k_thread_stack_alloc(POOL_STACKSIZE, 0), stack, NULL);
+	k_thread_create(&test_thread, stack, POOL_STACKSIZE,
+			dirty_stack_entry, NULL, NULL, NULL,
+			-1, 0, K_FOREVER);
+	zassert_equal(k_thread_stack_space_get(&test_thread, &clean_unused),
+		      0, NULL);
+	zassert_true(clean_unused >= dirty_unused + POOL_DIRTY_SIZE / 2,
+		     "stack not repainted (%zu then %zu unused)",
+		     dirty_unused, clean_unused);
+
+	k_thread_abort(&test_thread);
+	zassert_equal(k_thread_stack_free(stack), 0, NULL);
+}
+#else
+void test_stack_pool(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -483,7 +566,8 @@ void test_main(void)
 	/* Run a thread that self-exits, triggering idle cleanup */
 	ztest_test_suite(userspace,
 			 ztest_1cpu_unit_test(test_stack_buffer),
-			 ztest_1cpu_unit_test(test_idle_stack)
+			 ztest_1cpu_unit_test(test_idle_stack),
+			 ztest_1cpu_unit_test(test_stack_pool)
 			 );
 	ztest_run_test_suite(userspace);
 }
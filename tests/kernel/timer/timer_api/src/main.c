@@ -709,6 +709,56 @@ void test_timeout_abs(void)
 #endif
 }
 
+static struct k_timer same_tick_timers[3];
+static int same_tick_expired[ARRAY_SIZE(same_tick_timers)];
+
+static void same_tick_expire(struct k_timer *timer)
+{
+	int idx = timer - same_tick_timers;
+
+	same_tick_expired[idx]++;
+
+	/* The first timer to fire cancels the last one, which is due
+	 * on the very same tick and has not had its handler run yet
+	 */
+	if (idx == 0) {
+		k_timer_stop(&same_tick_timers[2]);
+	}
+}
+
+/**
+ * @brief Test stopping a timer from a handler of a timer that expires
+ * on the same tick
+ *
+ * Starts several timers aligned to expire on one tick, where the
+ * first handler stops the last timer.  The stopped timer's handler
+ * must not run, while the others must all run exactly once.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_stop()
+ */
+void test_timer_stop_same_tick(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(same_tick_timers); i++) {
+		k_timer_init(&same_tick_timers[i], same_tick_expire, NULL);
+		same_tick_expired[i] = 0;
+	}
+
+	/* Start all timers within one tick so they share an expiry */
+	k_usleep(1);
+	for (int i = 0; i < ARRAY_SIZE(same_tick_timers); i++) {
+		k_timer_start(&same_tick_timers[i], K_TICKS(2), K_NO_WAIT);
+	}
+
+	k_sleep(K_TICKS(5));
+
+	zassert_equal(same_tick_expired[0], 1, "first timer did not fire");
+	zassert_equal(same_tick_expired[1], 1, "second timer did not fire");
+	zassert_equal(same_tick_expired[2], 0,
+		      "timer stopped on its expiry tick still fired");
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -744,6 +794,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
-			 ztest_user_unit_test(test_timeout_abs));
+			 ztest_user_unit_test(test_timeout_abs),
+			 ztest_unit_test(test_timer_stop_same_tick));
 	ztest_run_test_suite(timer_api);
 }
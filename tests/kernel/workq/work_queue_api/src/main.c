@@ -50,6 +50,12 @@ static struct k_sem sync_sema;
 static struct k_sem dummy_sema;
 static struct k_thread *main_thread;
 
+#define NUM_POOL_WORKERS 2
+K_WORK_POOL_DEFINE(work_pool, NUM_POOL_WORKERS, STACK_SIZE);
+static struct k_work pool_slow_work, pool_fast_work;
+static struct k_delayed_work pool_delayed_work;
+static struct k_sem pool_block_sema, pool_done_sema;
+
 /**
  * @brief Common function using like a handler for workqueue tests
  * API call in it means successful execution of that function
@@ -1352,6 +1358,52 @@ void test_cancel_processed_work_item(void)
 	k_sleep(TIMEOUT);
 }
 
+static void pool_slow_handler(struct k_work *unused)
+{
+	k_sem_take(&pool_block_sema, K_FOREVER);
+	k_sem_give(&pool_done_sema);
+}
+
+static void pool_fast_handler(struct k_work *unused)
+{
+	k_sem_give(&pool_done_sema);
+}
+
+/**
+ * @brief Test work queue pool
+ * @details Block one worker of a two worker pool in a handler, and check
+ * that work items and delayed work items submitted afterwards are still
+ * processed by the other worker.
+ * @ingroup kernel_workqueue_tests
+ * @see k_work_pool_start(), k_work_pool_queue()
+ */
+void test_work_pool(void)
+{
+	struct k_work_q *pool_q = k_work_pool_queue(&work_pool);
+
+	k_sem_init(&pool_block_sema, 0, 1);
+	k_sem_init(&pool_done_sema, 0, NUM_OF_WORK);
+	k_work_init(&pool_slow_work, pool_slow_handler);
+	k_work_init(&pool_fast_work, pool_fast_handler);
+	k_delayed_work_init(&pool_delayed_work, pool_fast_handler);
+
+	k_work_pool_start(&work_pool, MY_PRIORITY, 0);
+
+	k_work_submit_to_queue(pool_q, &pool_slow_work);
+	k_work_submit_to_queue(pool_q, &pool_fast_work);
+
+	/**TESTPOINT: work is processed while another worker is blocked */
+	zassert_equal(k_sem_take(&pool_done_sema, TIMEOUT), 0, NULL);
+
+	zassert_equal(k_delayed_work_submit_to_queue(pool_q,
+						     &pool_delayed_work,
+						     K_MSEC(1)), 0, NULL);
+	zassert_equal(k_sem_take(&pool_done_sema, TIMEOUT), 0, NULL);
+
+	k_sem_give(&pool_block_sema);
+	zassert_equal(k_sem_take(&pool_done_sema, TIMEOUT), 0, NULL);
+}
+
 void test_main(void)
 {
 	main_thread = k_current_get();
@@ -1400,6 +1452,7 @@ void test_main(void)
 			 ztest_unit_test(test_process_work_items_fifo),
 			 ztest_unit_test(test_sched_delayed_work_item),
 			 ztest_unit_test(test_workqueue_max_number),
-			 ztest_unit_test(test_cancel_processed_work_item));
+			 ztest_unit_test(test_cancel_processed_work_item),
+			 ztest_unit_test(test_work_pool));
 	ztest_run_test_suite(workqueue_api);
 }
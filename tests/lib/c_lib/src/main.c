@@ -296,6 +296,101 @@ void test_memcmp(void)
 	zassert_true((ret != 0), "memcmp 5");
 }
 
+/**
+ *
+ * @brief Test memory and string functions on every alignment
+ *
+ * The word accesses of the string functions must not depend on the
+ * buffers being aligned, nor touch the bytes around them.
+ */
+
+#define ALIGN_SPAN 8
+#define ALIGN_MAX_LEN 40
+#define ALIGN_BUFSIZE (ALIGN_MAX_LEN + 2 * ALIGN_SPAN)
+
+static uint8_t align_src[ALIGN_BUFSIZE] __aligned(ALIGN_SPAN);
+static uint8_t align_dst[ALIGN_BUFSIZE] __aligned(ALIGN_SPAN);
+
+void test_mem_align(void)
+{
+	unsigned int i, len, s_off, d_off;
+
+	for (i = 0; i < ALIGN_BUFSIZE; i++) {
+		align_src[i] = i + 1;
+	}
+
+	for (s_off = 0; s_off < ALIGN_SPAN; s_off++) {
+		for (d_off = 0; d_off < ALIGN_SPAN; d_off++) {
+			for (len = 0; len <= ALIGN_MAX_LEN; len++) {
+				(void)memset(align_dst, 0xA5, ALIGN_BUFSIZE);
+				memcpy(&align_dst[d_off], &align_src[s_off], len);
+
+				for (i = 0; i < ALIGN_BUFSIZE; i++) {
+					uint8_t exp = (i >= d_off && i < d_off + len) ?
+						align_src[s_off + i - d_off] : 0xA5;
+
+					zassert_equal(align_dst[i], exp,
+						      "memcpy %u %u %u",
+						      s_off, d_off, len);
+				}
+			}
+		}
+	}
+
+	for (d_off = 0; d_off < ALIGN_SPAN; d_off++) {
+		for (len = 0; len <= ALIGN_MAX_LEN; len++) {
+			(void)memset(align_dst, 0xA5, ALIGN_BUFSIZE);
+			(void)memset(&align_dst[d_off], 0x3C, len);
+
+			for (i = 0; i < ALIGN_BUFSIZE; i++) {
+				uint8_t exp = (i >= d_off && i < d_off + len) ?
+					0x3C : 0xA5;
+
+				zassert_equal(align_dst[i], exp, "memset %u %u",
+					      d_off, len);
+			}
+		}
+	}
+
+	for (s_off = 0; s_off < ALIGN_SPAN; s_off++) {
+		memcpy(align_dst, align_src, ALIGN_BUFSIZE);
+		zassert_equal(memcmp(&align_dst[s_off], &align_src[s_off],
+				     ALIGN_MAX_LEN), 0, "memcmp %u", s_off);
+
+		for (i = 0; i < ALIGN_MAX_LEN; i++) {
+			align_dst[s_off + i]++;
+			zassert_true(memcmp(&align_dst[s_off], &align_src[s_off],
+					    ALIGN_MAX_LEN) > 0,
+				     "memcmp %u %u", s_off, i);
+			zassert_equal(memcmp(&align_dst[s_off], &align_src[s_off],
+					     i), 0, "memcmp %u %u", s_off, i);
+			align_dst[s_off + i]--;
+		}
+	}
+
+	for (s_off = 0; s_off < ALIGN_SPAN; s_off++) {
+		for (len = 0; len < ALIGN_MAX_LEN; len++) {
+			char *str = (char *)&align_dst[s_off];
+
+			(void)memset(align_dst, 'a', ALIGN_BUFSIZE);
+			str[len] = '\0';
+			zassert_equal(strlen(str), len, "strlen %u %u",
+				      s_off, len);
+
+			memcpy(align_src, align_dst, ALIGN_BUFSIZE);
+			zassert_equal(strcmp(str, (char *)&align_src[s_off]), 0,
+				      "strcmp %u %u", s_off, len);
+
+			if (len > 0) {
+				str[len - 1] = 'b';
+				zassert_true(strcmp(str,
+						    (char *)&align_src[s_off]) > 0,
+					     "strcmp %u %u", s_off, len);
+			}
+		}
+	}
+}
+
 /**
  *
  * @brief Test binary search function
@@ -607,6 +702,7 @@ void test_main(void)
 			 ztest_unit_test(test_stddef),
 			 ztest_unit_test(test_stdint),
 			 ztest_unit_test(test_memcmp),
+			 ztest_unit_test(test_mem_align),
 			 ztest_unit_test(test_strchr),
 			 ztest_unit_test(test_strcpy),
 			 ztest_unit_test(test_strncpy),
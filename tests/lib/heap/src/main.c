@@ -204,12 +204,100 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* With CONFIG_SYS_HEAP_CACHE a freed small block must be handed
+ * straight back to the next request of the same size, and parked
+ * blocks must be returned to the heap once it runs out of memory.
+ */
+static void test_size_class_cache(void)
+{
+	struct sys_heap heap;
+	void **blocks = (void **)scratchmem;
+	size_t n = 0;
+	void *p, *q;
+
+	if (!IS_ENABLED(CONFIG_SYS_HEAP_CACHE)) {
+		ztest_test_skip();
+		return;
+	}
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	p = sys_heap_alloc(&heap, 16);
+	zassert_not_null(p, "");
+	sys_heap_free(&heap, p);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	q = sys_heap_alloc(&heap, 16);
+	zassert_equal(p, q, "cached block not reused");
+	sys_heap_free(&heap, q);
+
+	while ((p = sys_heap_alloc(&heap, 16)) != NULL) {
+		blocks[n++] = p;
+	}
+	while (n > 0) {
+		sys_heap_free(&heap, blocks[--n]);
+	}
+	zassert_true(sys_heap_validate(&heap), "");
+
+	p = sys_heap_alloc(&heap, SMALL_HEAP_SZ / 2);
+	zassert_not_null(p, "cached blocks not released on exhaustion");
+	sys_heap_free(&heap, p);
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+/* Runtime statistics must follow every alloc/free exactly and add
+ * up to a constant, and the high-water mark must survive frees.
+ */
+static void test_runtime_stats(void)
+{
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_heap heap;
+	struct sys_memory_stats stats;
+	size_t total;
+	void *p, *q;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	zassert_equal(sys_heap_runtime_stats_get(&heap, &stats), 0, "");
+	zassert_equal(stats.allocated_bytes, 0, "");
+	zassert_equal(stats.max_allocated_bytes, 0, "");
+	zassert_equal(stats.largest_free_bytes, stats.free_bytes, "");
+	total = stats.free_bytes;
+
+	p = sys_heap_alloc(&heap, 100);
+	q = sys_heap_alloc(&heap, 200);
+	zassert_not_null(p, "");
+	zassert_not_null(q, "");
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_true(stats.allocated_bytes >= 300, "");
+	zassert_equal(stats.free_bytes + stats.allocated_bytes, total, "");
+	zassert_equal(stats.max_allocated_bytes, stats.allocated_bytes, "");
+	zassert_true(stats.largest_free_bytes <= stats.free_bytes, "");
+
+	sys_heap_free(&heap, p);
+	sys_heap_free(&heap, q);
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.allocated_bytes, 0, "");
+	zassert_equal(stats.free_bytes, total, "");
+	zassert_true(stats.max_allocated_bytes >= 300, "");
+
+	zassert_equal(sys_heap_runtime_stats_reset_max(&heap), 0, "");
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.max_allocated_bytes, 0, "");
+
+	zassert_equal(sys_heap_runtime_stats_get(&heap, NULL), -EINVAL, "");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_size_class_cache),
+			 ztest_unit_test(test_runtime_stats)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
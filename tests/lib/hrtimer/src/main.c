@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <sys/hrtimer.h>
+
+/* Allowed lateness of an expiry, interrupt latency included */
+#define SLACK_NS 50000U
+
+#define NUM_TIMERS 3
+
+static struct sys_hrtimer timers[NUM_TIMERS];
+static uint64_t expired_ns[NUM_TIMERS];
+static int expired_count[NUM_TIMERS];
+
+/* Indexes of the timers in the order they expired */
+static int order[NUM_TIMERS];
+static int num_expired;
+
+static int periodic_stop_at;
+
+static K_SEM_DEFINE(expired_sem, 0, NUM_TIMERS);
+
+static void handler(struct sys_hrtimer *timer)
+{
+	int i = timer - timers;
+
+	expired_ns[i] = sys_hrtimer_ns_get();
+	expired_count[i]++;
+
+	if (num_expired < NUM_TIMERS) {
+		order[num_expired] = i;
+	}
+	num_expired++;
+
+	if (expired_count[i] == periodic_stop_at) {
+		sys_hrtimer_stop(timer);
+	}
+
+	k_sem_give(&expired_sem);
+}
+
+static void reset(void)
+{
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		sys_hrtimer_init(&timers[i], handler);
+		expired_ns[i] = 0U;
+		expired_count[i] = 0;
+	}
+
+	num_expired = 0;
+	periodic_stop_at = 0;
+	k_sem_reset(&expired_sem);
+}
+
+static void expiry_check(int i, uint64_t start_ns, uint64_t delay_ns)
+{
+	zassert_true(expired_ns[i] >= start_ns + delay_ns,
+		     "timer %d expired early", i);
+	zassert_true(expired_ns[i] < start_ns + delay_ns + SLACK_NS,
+		     "timer %d expired %llu ns late", i,
+		     (unsigned long long)(expired_ns[i] - start_ns - delay_ns));
+}
+
+/**
+ * @brief Test a one-shot timer expires once, on time
+ *
+ * @see sys_hrtimer_start()
+ */
+static void test_one_shot(void)
+{
+	uint64_t start;
+
+	reset();
+
+	start = sys_hrtimer_ns_get();
+	zassert_equal(sys_hrtimer_start(&timers[0], 100000U, 0U), 0, NULL);
+	zassert_true(sys_hrtimer_is_running(&timers[0]), NULL);
+
+	zassert_equal(k_sem_take(&expired_sem, K_MSEC(10)), 0, NULL);
+	expiry_check(0, start, 100000U);
+	zassert_false(sys_hrtimer_is_running(&timers[0]), NULL);
+
+	k_msleep(1);
+	zassert_equal(expired_count[0], 1, "one-shot timer expired again");
+}
+
+/**
+ * @brief Test a periodic timer keeps the phase of its first expiry
+ *
+ * @see sys_hrtimer_start(), sys_hrtimer_stop()
+ */
+static void test_periodic(void)
+{
+	uint64_t start;
+
+	reset();
+	periodic_stop_at = 10;
+
+	start = sys_hrtimer_ns_get();
+	zassert_equal(sys_hrtimer_start(&timers[0], 200000U, 200000U), 0,
+		      NULL);
+
+	zassert_equal(k_sem_take(&expired_sem, K_MSEC(100)), 0, NULL);
+	while (expired_count[0] < periodic_stop_at) {
+		zassert_equal(k_sem_take(&expired_sem, K_MSEC(10)), 0, NULL);
+	}
+
+	expiry_check(0, start, 10 * 200000U);
+	zassert_false(sys_hrtimer_is_running(&timers[0]),
+		      "timer not stopped by its handler");
+}
+
+/**
+ * @brief Test timers expire in the order of their expiry
+ *
+ * @see sys_hrtimer_start()
+ */
+static void test_order(void)
+{
+	static const uint64_t delays[NUM_TIMERS] = {
+		300000U, 100000U, 200000U
+	};
+	uint64_t start;
+
+	reset();
+
+	start = sys_hrtimer_ns_get();
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		zassert_equal(sys_hrtimer_start(&timers[i], delays[i], 0U), 0,
+			      NULL);
+	}
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		zassert_equal(k_sem_take(&expired_sem, K_MSEC(10)), 0, NULL);
+	}
+
+	zassert_equal(order[0], 1, NULL);
+	zassert_equal(order[1], 2, NULL);
+	zassert_equal(order[2], 0, NULL);
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		expiry_check(i, start, delays[i]);
+	}
+}
+
+/**
+ * @brief Test a stopped timer does not expire
+ *
+ * @see sys_hrtimer_stop()
+ */
+static void test_stop(void)
+{
+	reset();
+
+	zassert_equal(sys_hrtimer_start(&timers[0], 1000000U, 0U), 0, NULL);
+	zassert_equal(sys_hrtimer_start(&timers[1], 2000000U, 0U), 0, NULL);
+	sys_hrtimer_stop(&timers[0]);
+	zassert_false(sys_hrtimer_is_running(&timers[0]), NULL);
+
+	zassert_equal(k_sem_take(&expired_sem, K_MSEC(10)), 0, NULL);
+	zassert_equal(expired_count[0], 0, "stopped timer expired");
+	zassert_equal(expired_count[1], 1, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(hrtimer_test,
+			 ztest_unit_test(test_one_shot),
+			 ztest_unit_test(test_periodic),
+			 ztest_unit_test(test_order),
+			 ztest_unit_test(test_stop));
+	ztest_run_test_suite(hrtimer_test);
+}
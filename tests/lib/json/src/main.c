@@ -539,6 +539,115 @@ static void test_json_encode_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
 }
 
+struct sax_record {
+	char out[256];
+	size_t len;
+};
+
+/* Write the tokens as text, to compare the results of different chunkings */
+static int sax_record_cb(const struct json_sax_token *token, void *user_data)
+{
+	struct sax_record *rec = user_data;
+	int ret;
+
+	ret = snprintk(&rec->out[rec->len], sizeof(rec->out) - rec->len,
+		       "%c%u%s%.*s ", token->type, token->depth,
+		       token->key ? "k" : "", (int)token->len,
+		       token->str ? token->str : "");
+	zassert_true(ret > 0 && ret < sizeof(rec->out) - rec->len,
+		     "Token record overflow");
+	rec->len += ret;
+
+	return 0;
+}
+
+static int sax_parse(const char *json, size_t chunk, char *buf,
+		     size_t buf_size, struct sax_record *rec)
+{
+	struct json_sax sax;
+	size_t len = strlen(json);
+	int ret;
+
+	rec->len = 0;
+	rec->out[0] = '\0';
+	json_sax_init(&sax, buf, buf_size, sax_record_cb, rec);
+
+	for (size_t pos = 0; pos < len; pos += chunk) {
+		ret = json_sax_feed(&sax, &json[pos], MIN(chunk, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_sax_finish(&sax);
+}
+
+static void test_json_sax(void)
+{
+	const char json[] = "{\"a\": [1, -20, true, false, null], "
+			    "\"b\\\"c\": {\"d\": \"e\\u00e9f\"}, \"g\": {}, "
+			    "\"h\": []}";
+	const char expected[] = "{0 \"1ka [1 021 02-20 t2 f2 n2 ]1 "
+				"\"1kb\\\"c {1 \"2kd \"2e\\u00e9f }1 "
+				"\"1kg {1 }1 \"1kh [1 ]1 }0 ";
+	struct sax_record whole, chunked;
+	char buf[16];
+
+	zassert_equal(sax_parse(json, sizeof(json), buf, sizeof(buf), &whole),
+		      0, "Parsing failed");
+	zassert_true(!strcmp(whole.out, expected), "Wrong tokens: %s",
+		     whole.out);
+
+	/* Tokens spanning chunks come out the same */
+	for (size_t chunk = 1; chunk < sizeof(json); chunk++) {
+		zassert_equal(sax_parse(json, chunk, buf, sizeof(buf),
+					&chunked), 0,
+			      "Parsing failed in chunks of %u",
+			      (unsigned int)chunk);
+		zassert_true(!strcmp(chunked.out, expected),
+			     "Wrong tokens in chunks of %u: %s",
+			     (unsigned int)chunk, chunked.out);
+	}
+
+	/* A top-level number only ends with the input */
+	zassert_equal(sax_parse("-42", 1, buf, sizeof(buf), &chunked), 0,
+		      "Parsing failed");
+	zassert_true(!strcmp(chunked.out, "00-42 "), "Wrong tokens: %s",
+		     chunked.out);
+}
+
+static void test_json_sax_invalid(void)
+{
+	static const char * const encoded[] = {
+		"", "{", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "[1,]", "[1 2]",
+		"{1:2}", "[}", "{]", "\"abc", "\"\\X\"", "\"\\u12G4\"",
+		"truffle", "nul", "-", "-x", ".5", "1 2", "[]]", "{\"a\" 1}",
+	};
+	struct sax_record rec;
+	char buf[16];
+
+	for (size_t i = 0; i < ARRAY_SIZE(encoded); i++) {
+		for (size_t chunk = 1; chunk <= 4; chunk++) {
+			zassert_equal(sax_parse(encoded[i], chunk, buf,
+						sizeof(buf), &rec), -EINVAL,
+				      "Parsing '%s' has to fail", encoded[i]);
+		}
+	}
+}
+
+static void test_json_sax_buffer(void)
+{
+	const char json[] = "[\"0123456789abcdef\"]";
+	struct sax_record rec;
+	char buf[8];
+
+	/* Tokens within a chunk do not need the buffer */
+	zassert_equal(sax_parse(json, sizeof(json), buf, sizeof(buf), &rec), 0,
+		      "Parsing failed");
+	zassert_equal(sax_parse(json, 4, buf, sizeof(buf), &rec), -ENOSPC,
+		      "Parsing has to run out of buffer");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -560,7 +669,10 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
 			 ztest_unit_test(test_json_escape_bounds_check),
-			 ztest_unit_test(test_json_encode_bounds_check)
+			 ztest_unit_test(test_json_encode_bounds_check),
+			 ztest_unit_test(test_json_sax),
+			 ztest_unit_test(test_json_sax_invalid),
+			 ztest_unit_test(test_json_sax_buffer)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
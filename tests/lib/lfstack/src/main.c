@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/lfstack.h>
+
+#define NUM_ELEMS 8
+#define NUM_THREADS 2
+#define ITERATIONS 2000
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+struct elem {
+	uint32_t value;
+	struct sys_lfstack_node node;
+};
+
+static struct elem elems[NUM_ELEMS];
+static struct sys_lfstack stack;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static struct elem *elem_pop(void)
+{
+	struct sys_lfstack_node *node = sys_lfstack_pop(&stack);
+
+	return node ? CONTAINER_OF(node, struct elem, node) : NULL;
+}
+
+static void setup(void)
+{
+	sys_lfstack_init(&stack, &elems[0].node, sizeof(elems[0]));
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		elems[i].value = i;
+		sys_lfstack_push(&stack, &elems[i].node);
+	}
+}
+
+static void test_lfstack_lifo(void)
+{
+	setup();
+
+	zassert_false(sys_lfstack_is_empty(&stack), "");
+
+	for (int i = NUM_ELEMS - 1; i >= 0; i--) {
+		zassert_equal_ptr(elem_pop(), &elems[i], "wrong order");
+	}
+
+	zassert_true(sys_lfstack_is_empty(&stack), "");
+	zassert_is_null(elem_pop(), "stack not empty");
+
+	sys_lfstack_push(&stack, &elems[3].node);
+	zassert_equal_ptr(elem_pop(), &elems[3], "");
+}
+
+static void push_from_isr(const void *param)
+{
+	sys_lfstack_push(&stack, (struct sys_lfstack_node *)param);
+}
+
+static void test_lfstack_isr(void)
+{
+	struct elem *e;
+
+	setup();
+
+	e = elem_pop();
+	zassert_equal_ptr(e, &elems[NUM_ELEMS - 1], "");
+
+	irq_offload(push_from_isr, &e->node);
+	zassert_equal_ptr(elem_pop(), e, "pushed from ISR");
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct elem *e = elem_pop();
+
+		if (e == NULL) {
+			k_yield();
+			continue;
+		}
+
+		e->value++;
+		if (i % 16 == 0) {
+			k_yield();
+		}
+		sys_lfstack_push(&stack, &e->node);
+	}
+}
+
+static void test_lfstack_threads(void)
+{
+	bool seen[NUM_ELEMS] = { false };
+	struct elem *e;
+	int count = 0;
+
+	setup();
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+				K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	/* Every element is back exactly once */
+	while ((e = elem_pop()) != NULL) {
+		int i = e - elems;
+
+		zassert_false(seen[i], "element %d popped twice", i);
+		seen[i] = true;
+		count++;
+	}
+
+	zassert_equal(count, NUM_ELEMS, "elements lost");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_lfstack,
+			 ztest_unit_test(test_lfstack_lifo),
+			 ztest_unit_test(test_lfstack_isr),
+			 ztest_unit_test(test_lfstack_threads));
+	ztest_run_test_suite(test_lfstack);
+}
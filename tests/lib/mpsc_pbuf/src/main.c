@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/mpsc_pbuf.h>
+#include <sys/mpsc_ring_buf.h>
+
+#define BUF_WLEN 16
+
+static uint32_t buf32[BUF_WLEN];
+static struct mpsc_pbuf_buffer pbuf;
+
+static uint32_t *packet_put(uint32_t wlen, uint32_t value)
+{
+	uint32_t *packet = mpsc_pbuf_alloc(&pbuf, wlen);
+
+	zassert_not_null(packet, "alloc failed");
+
+	for (int i = 0; i < wlen; i++) {
+		packet[i] = value + i;
+	}
+
+	mpsc_pbuf_commit(&pbuf, packet, wlen);
+
+	return packet;
+}
+
+static void packet_check(uint32_t exp_wlen, uint32_t value)
+{
+	uint32_t *packet;
+	uint32_t wlen;
+
+	packet = mpsc_pbuf_claim(&pbuf, &wlen);
+	zassert_not_null(packet, "no packet");
+	zassert_equal(wlen, exp_wlen, "wrong length %u", wlen);
+
+	for (int i = 0; i < wlen; i++) {
+		zassert_equal(packet[i], value + i, "wrong content");
+	}
+
+	mpsc_pbuf_free(&pbuf, packet);
+}
+
+static void setup(void)
+{
+	mpsc_pbuf_init(&pbuf, buf32, ARRAY_SIZE(buf32));
+}
+
+static void test_mpsc_pbuf_fifo(void)
+{
+	uint32_t wlen;
+
+	setup();
+
+	zassert_is_null(mpsc_pbuf_claim(&pbuf, &wlen), "unexpected packet");
+
+	(void)packet_put(3, 0x100);
+	(void)packet_put(2, 0x200);
+	zassert_true(mpsc_pbuf_is_pending(&pbuf), "");
+
+	packet_check(3, 0x100);
+	packet_check(2, 0x200);
+
+	zassert_is_null(mpsc_pbuf_claim(&pbuf, &wlen), "unexpected packet");
+	zassert_false(mpsc_pbuf_is_pending(&pbuf), "");
+}
+
+static void test_mpsc_pbuf_uncommitted(void)
+{
+	uint32_t *first;
+	uint32_t wlen;
+
+	setup();
+
+	first = mpsc_pbuf_alloc(&pbuf, 2);
+	zassert_not_null(first, "alloc failed");
+	(void)packet_put(1, 0x300);
+
+	/* The second packet is held back by the first one */
+	zassert_is_null(mpsc_pbuf_claim(&pbuf, &wlen), "unexpected packet");
+
+	first[0] = 0x400;
+	first[1] = 0x401;
+	mpsc_pbuf_commit(&pbuf, first, 2);
+
+	packet_check(2, 0x400);
+	packet_check(1, 0x300);
+}
+
+static void test_mpsc_pbuf_full(void)
+{
+	uint32_t *packet;
+
+	setup();
+
+	(void)packet_put(BUF_WLEN - 1, 0x500);
+
+	packet = mpsc_pbuf_alloc(&pbuf, 1);
+	zassert_is_null(packet, "buffer should be full");
+	zassert_equal(mpsc_pbuf_dropped_get(&pbuf), 1, "");
+	zassert_equal(mpsc_pbuf_dropped_get(&pbuf), 0, "");
+
+	packet = mpsc_pbuf_alloc(&pbuf, BUF_WLEN);
+	zassert_is_null(packet, "packet bigger than the buffer");
+
+	packet_check(BUF_WLEN - 1, 0x500);
+	(void)packet_put(1, 0x600);
+	packet_check(1, 0x600);
+}
+
+static void test_mpsc_pbuf_wrap(void)
+{
+	uint32_t *packet;
+
+	setup();
+
+	(void)packet_put(9, 0x700);
+	packet_check(9, 0x700);
+
+	/* Does not fit before the end, stored at the start of the buffer */
+	packet = packet_put(7, 0x800);
+	zassert_equal_ptr(packet, &buf32[1], "packet not wrapped");
+	packet_check(7, 0x800);
+
+	for (int i = 0; i < 2 * BUF_WLEN; i++) {
+		(void)packet_put(3, i);
+		packet_check(3, i);
+	}
+}
+
+static void test_mpsc_pbuf_free_order(void)
+{
+	uint32_t *first, *second;
+	uint32_t wlen;
+
+	setup();
+
+	(void)packet_put(7, 0xb00);
+	(void)packet_put(7, 0xc00);
+
+	zassert_equal_ptr(mpsc_pbuf_peek(&pbuf, &wlen), &buf32[1], "");
+	first = mpsc_pbuf_claim(&pbuf, &wlen);
+	second = mpsc_pbuf_claim(&pbuf, &wlen);
+	zassert_not_null(second, "second packet not claimable");
+	zassert_is_null(mpsc_pbuf_peek(&pbuf, &wlen), "unexpected packet");
+
+	/* Space is only reused once the oldest packet is freed */
+	mpsc_pbuf_free(&pbuf, second);
+	zassert_is_null(mpsc_pbuf_alloc(&pbuf, 7), "space reused too early");
+	(void)mpsc_pbuf_dropped_get(&pbuf);
+
+	mpsc_pbuf_free(&pbuf, first);
+	zassert_false(mpsc_pbuf_is_pending(&pbuf), "");
+	(void)packet_put(BUF_WLEN - 1, 0xd00);
+	packet_check(BUF_WLEN - 1, 0xd00);
+}
+
+static void put_from_isr(const void *param)
+{
+	ARG_UNUSED(param);
+
+	(void)packet_put(2, 0x900);
+}
+
+static void test_mpsc_pbuf_isr(void)
+{
+	uint32_t *packet;
+
+	setup();
+
+	/* Producer interrupted between claim and commit */
+	packet = mpsc_pbuf_alloc(&pbuf, 1);
+	zassert_not_null(packet, "alloc failed");
+
+	irq_offload(put_from_isr, NULL);
+
+	packet[0] = 0xa00;
+	mpsc_pbuf_commit(&pbuf, packet, 1);
+
+	packet_check(1, 0xa00);
+	packet_check(2, 0x900);
+}
+
+MPSC_RING_BUF_DECLARE(rbuf, 64);
+
+static void test_mpsc_ring_buf_stream(void)
+{
+	uint8_t in[40], out[sizeof(in)];
+	uint32_t len, n;
+	uint8_t *data;
+
+	for (int i = 0; i < sizeof(in); i++) {
+		in[i] = i;
+	}
+
+	zassert_true(mpsc_ring_buf_is_empty(&rbuf), "");
+
+	/* Records come out as a single stream, across wrap-arounds */
+	for (int i = 0; i < 8; i++) {
+		zassert_equal(mpsc_ring_buf_put(&rbuf, in, 10), 10, "");
+		zassert_equal(mpsc_ring_buf_put(&rbuf, &in[10], 7), 7, "");
+		zassert_equal(mpsc_ring_buf_get(&rbuf, out, 3), 3, "");
+		zassert_equal(mpsc_ring_buf_get(&rbuf, &out[3], sizeof(out)),
+			      14, "");
+		zassert_mem_equal(out, in, 17, "wrong content");
+		zassert_true(mpsc_ring_buf_is_empty(&rbuf), "");
+	}
+
+	/* Claims can be finished with less than claimed */
+	len = mpsc_ring_buf_put_claim(&rbuf, &data, 12);
+	zassert_equal(len, 12, "");
+	memcpy(data, in, 5);
+	zassert_equal(mpsc_ring_buf_put_finish(&rbuf, data, 13), -EINVAL, "");
+	zassert_equal(mpsc_ring_buf_put_finish(&rbuf, data, 5), 0, "");
+
+	len = mpsc_ring_buf_get_claim(&rbuf, &data, sizeof(out));
+	zassert_equal(len, 5, "");
+	zassert_mem_equal(data, in, 5, "wrong content");
+	zassert_equal(mpsc_ring_buf_get_finish(&rbuf, 6), -EINVAL, "");
+	zassert_equal(mpsc_ring_buf_get_finish(&rbuf, 5), 0, "");
+	zassert_true(mpsc_ring_buf_is_empty(&rbuf), "");
+
+	/* Fill the buffer until a record does not fit */
+	for (n = 0; mpsc_ring_buf_put(&rbuf, in, 8) == 8; n++) {
+	}
+
+	zassert_true(n > 0, "");
+	zassert_equal(mpsc_ring_buf_dropped_get(&rbuf), 1, "");
+	zassert_equal(mpsc_ring_buf_get(&rbuf, out, sizeof(out)), n * 8, "");
+	zassert_true(mpsc_ring_buf_is_empty(&rbuf), "");
+}
+
+static uint8_t *isr_claim;
+
+static void ring_put_from_isr(const void *param)
+{
+	ARG_UNUSED(param);
+
+	zassert_equal(mpsc_ring_buf_put(&rbuf, (const uint8_t *)"isr", 3), 3, "");
+}
+
+static void test_mpsc_ring_buf_isr(void)
+{
+	uint8_t out[8];
+
+	/* Writer interrupted between claim and finish */
+	zassert_equal(mpsc_ring_buf_put_claim(&rbuf, &isr_claim, 6), 6, "");
+
+	irq_offload(ring_put_from_isr, NULL);
+	zassert_equal(mpsc_ring_buf_get(&rbuf, out, sizeof(out)), 0,
+		      "record not held back");
+
+	memcpy(isr_claim, "thread", 6);
+	zassert_equal(mpsc_ring_buf_put_finish(&rbuf, isr_claim, 6), 0, "");
+
+	zassert_equal(mpsc_ring_buf_get(&rbuf, out, sizeof(out)), 8, "");
+	zassert_mem_equal(out, "threadis", 8, "wrong content");
+	zassert_equal(mpsc_ring_buf_get(&rbuf, out, sizeof(out)), 1, "");
+	zassert_equal(out[0], 'r', "wrong content");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_mpsc_pbuf,
+			 ztest_unit_test(test_mpsc_pbuf_fifo),
+			 ztest_unit_test(test_mpsc_pbuf_uncommitted),
+			 ztest_unit_test(test_mpsc_pbuf_full),
+			 ztest_unit_test(test_mpsc_pbuf_wrap),
+			 ztest_unit_test(test_mpsc_pbuf_free_order),
+			 ztest_unit_test(test_mpsc_pbuf_isr),
+			 ztest_unit_test(test_mpsc_ring_buf_stream),
+			 ztest_unit_test(test_mpsc_ring_buf_isr));
+
+	ztest_run_test_suite(test_mpsc_pbuf);
+}
@@ -62,11 +62,21 @@ static int destroy_called;
 static void buf_destroy(struct net_buf *buf);
 static void fixed_destroy(struct net_buf *buf);
 static void var_destroy(struct net_buf *buf);
+static void slab_destroy(struct net_buf *buf);
 
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, 128, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, var_destroy);
 
+K_MEM_SLAB_DEFINE(slab_small, NET_BUF_SLAB_HDR_SIZE + 32, 2, 4);
+K_MEM_SLAB_DEFINE(slab_large, NET_BUF_SLAB_HDR_SIZE + 256, 2, 4);
+
+static struct k_mem_slab * const data_slabs[] = {
+	&slab_small, &slab_large,
+};
+
+NET_BUF_POOL_SLAB_DEFINE(slab_pool, 10, 32, data_slabs, slab_destroy);
+
 static void buf_destroy(struct net_buf *buf)
 {
 	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
@@ -94,6 +104,15 @@ static void var_destroy(struct net_buf *buf)
 	net_buf_destroy(buf);
 }
 
+static void slab_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	destroy_called++;
+	zassert_equal(pool, &slab_pool, "Invalid free pointer in buffer");
+	net_buf_destroy(buf);
+}
+
 static const char example_data[] = "0123456789"
 				   "abcdefghijklmnopqrstuvxyz"
 				   "!#¤%&/()=?";
@@ -457,6 +476,52 @@ static void test_net_buf_var_pool(void)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void test_net_buf_slab_pool(void)
+{
+	struct net_buf *buf1, *buf2, *buf3, *buf4;
+
+	destroy_called = 0;
+
+	buf1 = net_buf_alloc_fixed(&slab_pool, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer");
+	zassert_equal(buf1->size, 32, "Invalid buffer size");
+
+	buf2 = net_buf_alloc_len(&slab_pool, 20, K_NO_WAIT);
+	zassert_not_null(buf2, "Failed to get buffer");
+	zassert_equal(k_mem_slab_num_used_get(&slab_small), 2,
+		      "Small buffer not taken from the small slab");
+	zassert_equal(k_mem_slab_num_used_get(&slab_large), 0,
+		      "Small buffer taken from the large slab");
+
+	/* The small slab is exhausted, so this falls back to a large block */
+	buf3 = net_buf_alloc_len(&slab_pool, 20, K_NO_WAIT);
+	zassert_not_null(buf3, "Failed to get buffer");
+	zassert_equal(k_mem_slab_num_used_get(&slab_large), 1,
+		      "Small buffer not taken from the large slab");
+
+	buf4 = net_buf_alloc_len(&slab_pool, 300, K_NO_WAIT);
+	zassert_is_null(buf4, "Got a buffer bigger than the largest block");
+
+	buf4 = net_buf_clone(buf3, K_NO_WAIT);
+	zassert_not_null(buf4, "Failed to clone buffer");
+	zassert_equal(buf4->data, buf3->data, "Cloned data doesn't match");
+
+	net_buf_unref(buf1);
+	net_buf_unref(buf2);
+	net_buf_unref(buf3);
+
+	zassert_equal(k_mem_slab_num_used_get(&slab_small), 0,
+		      "Small blocks not freed");
+	zassert_equal(k_mem_slab_num_used_get(&slab_large), 1,
+		      "Cloned block freed");
+
+	net_buf_unref(buf4);
+
+	zassert_equal(k_mem_slab_num_used_get(&slab_large), 0,
+		      "Large block not freed");
+	zassert_equal(destroy_called, 4, "Incorrect destroy callback count");
+}
+
 static void test_net_buf_byte_order(void)
 {
 	struct net_buf *buf;
@@ -585,6 +650,7 @@ void test_main(void)
 			 ztest_unit_test(test_net_buf_clone),
 			 ztest_unit_test(test_net_buf_fixed_pool),
 			 ztest_unit_test(test_net_buf_var_pool),
+			 ztest_unit_test(test_net_buf_slab_pool),
 			 ztest_unit_test(test_net_buf_byte_order)
 			 );
 
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <irq_offload.h>
+
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+#include <net/ethernet_rx_poll.h>
+
+#include <ztest.h>
+
+#define BUDGET CONFIG_NET_ETHERNET_RX_POLL_BUDGET
+
+/* Local experimental EtherType, dropped by the Ethernet L2 */
+#define TEST_PTYPE 0x88b5
+
+#define WAIT_TIME K_MSEC(100)
+
+struct eth_fake_context {
+	struct net_if *iface;
+	uint8_t mac_address[6];
+
+	struct net_eth_rx_poll rx_poll;
+	/* Frames waiting in the fake RX ring */
+	int pending;
+	int polls;
+	int completions;
+	bool irq_masked;
+};
+
+static struct eth_fake_context eth_fake_data = {
+	.mac_address = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static bool rx_frame(struct eth_fake_context *ctx)
+{
+	struct net_eth_hdr hdr = {
+		.type = htons(TEST_PTYPE),
+	};
+	struct net_pkt *pkt;
+
+	if (!ctx->pending) {
+		return false;
+	}
+
+	ctx->pending--;
+
+	memcpy(hdr.dst.addr, ctx->mac_address, sizeof(hdr.dst.addr));
+
+	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, sizeof(hdr) + 46,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate frame");
+
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "Cannot write header");
+	zassert_equal(net_pkt_memset(pkt, 0, 46), 0, "Cannot write payload");
+
+	net_eth_rx_poll_receive(&ctx->rx_poll, pkt);
+
+	return true;
+}
+
+static int eth_fake_rx_poll(struct net_eth_rx_poll *poll, int budget)
+{
+	struct eth_fake_context *ctx =
+		CONTAINER_OF(poll, struct eth_fake_context, rx_poll);
+	int count = 0;
+
+	zassert_true(ctx->irq_masked, "Polled with RX interrupt unmasked");
+	zassert_equal(budget, BUDGET, "Wrong budget");
+
+	ctx->polls++;
+
+	while (count < budget && rx_frame(ctx)) {
+		count++;
+	}
+
+	return count;
+}
+
+static void eth_fake_rx_poll_complete(struct net_eth_rx_poll *poll)
+{
+	struct eth_fake_context *ctx =
+		CONTAINER_OF(poll, struct eth_fake_context, rx_poll);
+
+	zassert_equal(ctx->pending, 0, "Completed with frames pending");
+
+	ctx->completions++;
+	ctx->irq_masked = false;
+}
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_address,
+			     sizeof(ctx->mac_address),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.send = eth_fake_send,
+};
+
+static int eth_fake_init(const struct device *dev)
+{
+	struct eth_fake_context *ctx = dev->data;
+
+	net_eth_rx_poll_init(&ctx->rx_poll, eth_fake_rx_poll,
+			     eth_fake_rx_poll_complete);
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_fake, "eth_fake", eth_fake_init, device_pm_control_nop,
+		    &eth_fake_data, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &eth_fake_api_funcs, NET_ETH_MTU);
+
+/* What the RX interrupt handler of a driver does */
+static void eth_fake_isr(const void *param)
+{
+	struct eth_fake_context *ctx = (struct eth_fake_context *)param;
+
+	ctx->irq_masked = true;
+	net_eth_rx_poll_schedule(&ctx->rx_poll);
+
+	/* A second event before the poll ran must not add a poll */
+	net_eth_rx_poll_schedule(&ctx->rx_poll);
+}
+
+static void rx_frames(int count)
+{
+	struct eth_fake_context *ctx = &eth_fake_data;
+
+	ctx->pending = count;
+	ctx->polls = 0;
+	ctx->completions = 0;
+
+	irq_offload(eth_fake_isr, ctx);
+
+	k_sleep(WAIT_TIME);
+
+	zassert_equal(ctx->pending, 0, "Frames left in ring");
+	zassert_equal(ctx->completions, 1, "Wrong number of completions");
+	zassert_false(ctx->irq_masked, "RX interrupt left masked");
+}
+
+static void test_rx_poll_empty(void)
+{
+	rx_frames(0);
+
+	zassert_equal(eth_fake_data.polls, 1, "Wrong number of polls");
+}
+
+static void test_rx_poll_below_budget(void)
+{
+	rx_frames(BUDGET - 1);
+
+	zassert_equal(eth_fake_data.polls, 1, "Wrong number of polls");
+}
+
+static void test_rx_poll_over_budget(void)
+{
+	/* The poll that uses up its budget is repeated, and the one that
+	 * finds the ring empty completes.
+	 */
+	rx_frames(2 * BUDGET + 1);
+
+	zassert_equal(eth_fake_data.polls, 3, "Wrong number of polls");
+}
+
+static void test_rx_poll_exact_budget(void)
+{
+	rx_frames(BUDGET);
+
+	zassert_equal(eth_fake_data.polls, 2, "Wrong number of polls");
+}
+
+static void test_rx_poll_frames_released(void)
+{
+	struct k_mem_slab *rx;
+
+	net_pkt_get_info(&rx, NULL, NULL, NULL);
+
+	rx_frames(3 * BUDGET);
+
+	zassert_equal(k_mem_slab_num_free_get(rx), rx->num_blocks,
+		      "Received frames not released");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ethernet_rx_poll,
+			 ztest_unit_test(test_rx_poll_empty),
+			 ztest_unit_test(test_rx_poll_below_budget),
+			 ztest_unit_test(test_rx_poll_over_budget),
+			 ztest_unit_test(test_rx_poll_exact_budget),
+			 ztest_unit_test(test_rx_poll_frames_released));
+
+	ztest_run_test_suite(ethernet_rx_poll);
+}
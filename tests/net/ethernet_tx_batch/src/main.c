@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/ethernet.h>
+
+#include <ztest.h>
+
+#define BATCH CONFIG_NET_IF_TX_BATCH_SIZE
+#define MAX_PKTS (3 * BATCH)
+
+#define WAIT_TIME K_MSEC(100)
+
+struct eth_fake_context {
+	struct net_if *iface;
+	uint8_t mac_address[6];
+
+	/* Packets in the order the driver got them */
+	struct net_pkt *sent[MAX_PKTS];
+	int sent_count;
+	int send_calls;
+	int batch_calls;
+	int batch_max;
+	/* How many packets of a batch the driver accepts */
+	int batch_limit;
+};
+
+static struct eth_fake_context eth_fake_data = {
+	.mac_address = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 },
+};
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_address,
+			     sizeof(ctx->mac_address),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->send_calls++;
+	ctx->sent[ctx->sent_count++] = pkt;
+
+	return 0;
+}
+
+static int eth_fake_send_batch(const struct device *dev,
+			       struct net_pkt **pkts, int count)
+{
+	struct eth_fake_context *ctx = dev->data;
+	int i;
+
+	ctx->batch_calls++;
+	ctx->batch_max = MAX(ctx->batch_max, count);
+
+	count = MIN(count, ctx->batch_limit);
+
+	for (i = 0; i < count; i++) {
+		ctx->sent[ctx->sent_count++] = pkts[i];
+	}
+
+	return count;
+}
+
+static struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.send = eth_fake_send,
+	.send_batch = eth_fake_send_batch,
+};
+
+static int eth_fake_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_fake, "eth_fake", eth_fake_init, device_pm_control_nop,
+		    &eth_fake_data, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &eth_fake_api_funcs, NET_ETH_MTU);
+
+static struct net_pkt *alloc_pkt(struct net_if *iface)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv6_hdr),
+					AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	/* An all zeros IPv6 header is not multicast, so the frame goes to
+	 * the broadcast address.
+	 */
+	zassert_equal(net_pkt_memset(pkt, 0, sizeof(struct net_ipv6_hdr)), 0,
+		      "Cannot write header");
+
+	net_pkt_lladdr_src(pkt)->addr = net_if_get_link_addr(iface)->addr;
+	net_pkt_lladdr_src(pkt)->len = net_if_get_link_addr(iface)->len;
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void send_pkts(int count, int batch_limit)
+{
+	struct eth_fake_context *ctx = &eth_fake_data;
+	struct net_pkt *pkts[MAX_PKTS];
+	int i;
+
+	ctx->sent_count = 0;
+	ctx->send_calls = 0;
+	ctx->batch_calls = 0;
+	ctx->batch_max = 0;
+	ctx->batch_limit = batch_limit;
+
+	/* Keep the TX thread off until all the packets are queued */
+	k_sched_lock();
+
+	for (i = 0; i < count; i++) {
+		pkts[i] = alloc_pkt(ctx->iface);
+		net_if_queue_tx(ctx->iface, pkts[i]);
+	}
+
+	k_sched_unlock();
+
+	k_sleep(WAIT_TIME);
+
+	zassert_equal(ctx->sent_count, count, "Wrong number of packets sent");
+
+	for (i = 0; i < count; i++) {
+		zassert_equal_ptr(ctx->sent[i], pkts[i],
+				  "Packet %d sent out of order", i);
+	}
+}
+
+static void test_tx_batch_single(void)
+{
+	send_pkts(1, BATCH);
+
+	zassert_equal(eth_fake_data.batch_calls, 0, "Single packet batched");
+	zassert_equal(eth_fake_data.send_calls, 1, "Wrong number of sends");
+}
+
+static void test_tx_batch_full(void)
+{
+	send_pkts(2 * BATCH + 2, BATCH);
+
+	zassert_equal(eth_fake_data.batch_calls, 3, "Wrong number of batches");
+	zassert_equal(eth_fake_data.batch_max, BATCH, "Batch too large");
+	zassert_equal(eth_fake_data.send_calls, 0, "Packet sent on its own");
+}
+
+static void test_tx_batch_partial(void)
+{
+	/* The packets the driver did not take are sent one by one */
+	send_pkts(BATCH, 1);
+
+	zassert_equal(eth_fake_data.batch_calls, 1, "Wrong number of batches");
+	zassert_equal(eth_fake_data.send_calls, BATCH - 1,
+		      "Wrong number of sends");
+}
+
+static void test_tx_batch_released(void)
+{
+	struct k_mem_slab *tx;
+
+	net_pkt_get_info(NULL, &tx, NULL, NULL);
+
+	send_pkts(MAX_PKTS, BATCH);
+
+	zassert_equal(k_mem_slab_num_free_get(tx), tx->num_blocks,
+		      "Sent packets not released");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ethernet_tx_batch,
+			 ztest_unit_test(test_tx_batch_single),
+			 ztest_unit_test(test_tx_batch_full),
+			 ztest_unit_test(test_tx_batch_partial),
+			 ztest_unit_test(test_tx_batch_released));
+
+	ztest_run_test_suite(ethernet_tx_batch);
+}
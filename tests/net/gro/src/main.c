@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/byteorder.h>
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "connection.h"
+#include "tcp_internal.h"
+
+#define TEST_PORT 4242
+#define PEER_PORT 5555
+#define SEG_LEN 100
+#define FRAME_LEN (sizeof(struct net_eth_hdr) + NET_IPV4TCPH_LEN + SEG_LEN)
+#define WAIT_TIME K_MSEC(200)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static uint8_t peer_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+static struct net_if *iface;
+static K_SEM_DEFINE(recv_sem, 0, UINT_MAX);
+static size_t recv_len;
+static int recv_count;
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_ctx = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+};
+
+static void eth_iface_init(struct net_if *net_iface)
+{
+	net_if_set_link_addr(net_iface, eth_ctx.mac_addr,
+			     sizeof(eth_ctx.mac_addr), NET_LINK_ETHERNET);
+
+	ethernet_init(net_iface);
+}
+
+static int eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps(const struct device *dev)
+{
+	return ETHERNET_HW_TX_CHKSUM_OFFLOAD |
+		ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+	.get_capabilities = eth_caps,
+	.send = eth_send,
+};
+
+static int eth_init(const struct device *dev)
+{
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_gro_test, "eth_gro_test",
+		    eth_init, device_pm_control_nop, &eth_ctx, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+static enum net_verdict tcp_received(struct net_conn *conn,
+				     struct net_pkt *pkt,
+				     union net_ip_header *ip_hdr,
+				     union net_proto_header *proto_hdr,
+				     void *user_data)
+{
+	recv_len += net_pkt_get_len(pkt) - NET_IPV4TCPH_LEN;
+	recv_count++;
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+static void send_segment(uint32_t seq, uint8_t flags)
+{
+	uint8_t frame[FRAME_LEN];
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)frame;
+	struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)(eth + 1);
+	struct net_tcp_hdr *tcp = (struct net_tcp_hdr *)(ip + 1);
+	struct net_pkt *pkt;
+
+	memset(frame, 0, sizeof(frame));
+
+	memcpy(eth->dst.addr, eth_ctx.mac_addr, sizeof(eth->dst.addr));
+	memcpy(eth->src.addr, peer_mac, sizeof(eth->src.addr));
+	eth->type = htons(NET_ETH_PTYPE_IP);
+
+	ip->vhl = 0x45;
+	ip->len = htons(NET_IPV4TCPH_LEN + SEG_LEN);
+	ip->ttl = 64;
+	ip->proto = IPPROTO_TCP;
+	net_ipaddr_copy(&ip->src, &peer_addr);
+	net_ipaddr_copy(&ip->dst, &my_addr);
+
+	tcp->src_port = htons(PEER_PORT);
+	tcp->dst_port = htons(TEST_PORT);
+	sys_put_be32(seq, tcp->seq);
+	sys_put_be32(1, tcp->ack);
+	tcp->offset = (NET_TCPH_LEN / 4) << 4;
+	tcp->flags = flags;
+	sys_put_be16(8192, tcp->wnd);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(frame), AF_UNSPEC,
+					   0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_equal(net_pkt_write(pkt, frame, sizeof(frame)), 0,
+		      "Cannot write packet");
+
+	zassert_equal(net_recv_data(iface, pkt), 0, "Cannot receive packet");
+}
+
+static void wait_for(int count, size_t len)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&recv_sem, WAIT_TIME), 0,
+			      "Packet %d not delivered", i);
+	}
+
+	zassert_equal(k_sem_take(&recv_sem, WAIT_TIME), -EAGAIN,
+		      "Too many packets delivered");
+	zassert_equal(recv_count, count, "Wrong packet count %d",
+		      recv_count);
+	zassert_equal(recv_len, len, "Wrong payload length %zu", recv_len);
+
+	recv_count = 0;
+	recv_len = 0;
+}
+
+static void test_gro_setup(void)
+{
+	struct net_conn_handle *handle;
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+	};
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(iface, "No Ethernet interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET, NULL,
+				(struct sockaddr *)&local, 0, TEST_PORT,
+				tcp_received, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register TCP handler (%d)", ret);
+}
+
+static void test_gro_coalesce(void)
+{
+	uint32_t seq = 1000;
+
+	/* PSH on the last segment passes the merged packet up at once */
+	send_segment(seq, NET_TCP_ACK);
+	send_segment(seq + SEG_LEN, NET_TCP_ACK);
+	send_segment(seq + 2 * SEG_LEN, NET_TCP_ACK);
+	send_segment(seq + 3 * SEG_LEN, NET_TCP_ACK | NET_TCP_PSH);
+
+	wait_for(1, 4 * SEG_LEN);
+}
+
+static void test_gro_timeout(void)
+{
+	uint32_t seq = 2000;
+
+	send_segment(seq, NET_TCP_ACK);
+	send_segment(seq + SEG_LEN, NET_TCP_ACK);
+
+	wait_for(1, 2 * SEG_LEN);
+}
+
+static void test_gro_out_of_order(void)
+{
+	uint32_t seq = 3000;
+
+	/* A gap in the sequence numbers must not be merged */
+	send_segment(seq, NET_TCP_ACK);
+	send_segment(seq + 2 * SEG_LEN, NET_TCP_ACK);
+
+	wait_for(2, 2 * SEG_LEN);
+}
+
+static void test_gro_flush_on_fin(void)
+{
+	uint32_t seq = 4000;
+
+	/* FIN is not coalesced, the pending data goes up before it */
+	send_segment(seq, NET_TCP_ACK);
+	send_segment(seq + SEG_LEN, NET_TCP_ACK | NET_TCP_FIN);
+
+	wait_for(2, 2 * SEG_LEN);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_gro_test,
+			 ztest_unit_test(test_gro_setup),
+			 ztest_unit_test(test_gro_coalesce),
+			 ztest_unit_test(test_gro_timeout),
+			 ztest_unit_test(test_gro_out_of_order),
+			 ztest_unit_test(test_gro_flush_on_fin));
+
+	ztest_run_test_suite(net_gro_test);
+}
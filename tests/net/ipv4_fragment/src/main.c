@@ -0,0 +1,336 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <linker/sections.h>
+#include <random/rand32.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+#define MY_PORT 4243
+#define PEER_PORT 4242
+
+/* Each fragment but the last carries a multiple of 8 bytes */
+#define PAYLOAD_LEN 1000
+#define FRAG_LEN 400
+#define DATAGRAM_LEN (sizeof(struct net_udp_hdr) + PAYLOAD_LEN)
+
+#define WAIT_TIME K_MSEC(500)
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+/* UDP header and payload of the datagram that is being fragmented */
+static uint8_t datagram[DATAGRAM_LEN];
+
+static struct net_if *iface;
+static struct k_sem wait_data;
+static bool test_failed;
+
+struct net_if_test {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	struct net_if_test *data = net_if_get_device(iface)->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	data->mac_addr[0] = 0x00;
+	data->mac_addr[1] = 0x00;
+	data->mac_addr[2] = 0x5E;
+	data->mac_addr[3] = 0x00;
+	data->mac_addr[4] = 0x53;
+	data->mac_addr[5] = sys_rand32_get();
+
+	net_if_set_link_addr(iface, data->mac_addr,
+			     sizeof(data->mac_addr), NET_LINK_ETHERNET);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+static struct net_if_test net_iface_data;
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_ipv4_fragment_test, "net_ipv4_fragment_test",
+		net_iface_dev_init, device_pm_control_nop,
+		&net_iface_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	static uint8_t data[PAYLOAD_LEN];
+	int i;
+
+	NET_DBG("Data %p received", pkt);
+
+	if (net_pkt_get_len(pkt) != sizeof(struct net_ipv4_hdr) +
+	    DATAGRAM_LEN) {
+		NET_DBG("Invalid length %zd", net_pkt_get_len(pkt));
+		test_failed = true;
+		goto out;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, sizeof(struct net_ipv4_hdr) +
+			 sizeof(struct net_udp_hdr)) ||
+	    net_pkt_read(pkt, data, sizeof(data))) {
+		test_failed = true;
+		goto out;
+	}
+
+	for (i = 0; i < PAYLOAD_LEN; i++) {
+		if (data[i] != (uint8_t)i) {
+			NET_DBG("Invalid data at %d", i);
+			test_failed = true;
+			break;
+		}
+	}
+
+out:
+	net_pkt_unref(pkt);
+
+	k_sem_give(&wait_data);
+
+	return NET_OK;
+}
+
+static struct net_pkt *create_fragment(uint16_t id, uint16_t offset,
+				       uint16_t len)
+{
+	struct net_ipv4_hdr hdr = { 0 };
+	struct net_pkt *pkt;
+	uint16_t flag;
+
+	flag = offset / 8U;
+	if (offset + len < DATAGRAM_LEN) {
+		flag |= NET_IPV4_MORE_FRAG_MASK;
+	}
+
+	hdr.vhl = 0x45;
+	hdr.len = htons(sizeof(hdr) + len);
+	hdr.id[0] = id >> 8;
+	hdr.id[1] = id;
+	hdr.offset[0] = flag >> 8;
+	hdr.offset[1] = flag;
+	hdr.ttl = 64U;
+	hdr.proto = IPPROTO_UDP;
+	net_ipaddr_copy(&hdr.src, &peer_addr);
+	net_ipaddr_copy(&hdr.dst, &my_addr);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(hdr) + len,
+					   AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate fragment");
+
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "Cannot write IPv4 header");
+	zassert_equal(net_pkt_write(pkt, datagram + offset, len), 0,
+		      "Cannot write fragment payload");
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(hdr));
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static enum net_verdict recv_fragment(uint16_t id, int idx)
+{
+	uint16_t offset = idx * FRAG_LEN;
+	uint16_t len = MIN(FRAG_LEN, DATAGRAM_LEN - offset);
+	struct net_pkt *pkt = create_fragment(id, offset, len);
+	enum net_verdict verdict;
+
+	verdict = net_ipv4_input(pkt);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
+static void test_setup(void)
+{
+	struct net_conn_handle *handle;
+	struct sockaddr remote_addr = { 0 };
+	struct sockaddr local_addr = { 0 };
+	struct net_udp_hdr *udp_hdr;
+	int ret, i;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface = net_if_get_default();
+	zassert_not_null(iface, "Interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	net_if_up(iface);
+
+	udp_hdr = (struct net_udp_hdr *)datagram;
+	udp_hdr->src_port = htons(PEER_PORT);
+	udp_hdr->dst_port = htons(MY_PORT);
+	udp_hdr->len = htons(DATAGRAM_LEN);
+	udp_hdr->chksum = 0U;
+
+	for (i = 0; i < PAYLOAD_LEN; i++) {
+		datagram[sizeof(struct net_udp_hdr) + i] = i;
+	}
+
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	net_ipaddr_copy(&net_sin(&remote_addr)->sin_addr, &peer_addr);
+	remote_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, &remote_addr, &local_addr,
+			       PEER_PORT, MY_PORT, udp_data_received,
+			       NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+}
+
+static void check_received(bool received)
+{
+	int ret = k_sem_take(&wait_data, WAIT_TIME);
+
+	if (received) {
+		zassert_equal(ret, 0, "Datagram not received");
+		zassert_false(test_failed, "Invalid datagram received");
+	} else {
+		zassert_not_equal(ret, 0, "Datagram received");
+	}
+}
+
+static void test_recv_ipv4_fragment(void)
+{
+	zassert_equal(recv_fragment(0x1000, 0), NET_OK, "Fragment 0");
+	zassert_equal(recv_fragment(0x1000, 1), NET_OK, "Fragment 1");
+	zassert_equal(recv_fragment(0x1000, 2), NET_OK, "Fragment 2");
+
+	check_received(true);
+}
+
+static void test_recv_ipv4_fragment_out_of_order(void)
+{
+	zassert_equal(recv_fragment(0x1001, 2), NET_OK, "Fragment 2");
+	zassert_equal(recv_fragment(0x1001, 0), NET_OK, "Fragment 0");
+	zassert_equal(recv_fragment(0x1001, 1), NET_OK, "Fragment 1");
+
+	check_received(true);
+}
+
+static void test_recv_ipv4_fragment_duplicate(void)
+{
+	zassert_equal(recv_fragment(0x1002, 1), NET_OK, "Fragment 1");
+	zassert_equal(recv_fragment(0x1002, 1), NET_DROP, "Duplicate");
+	zassert_equal(recv_fragment(0x1002, 0), NET_OK, "Fragment 0");
+	zassert_equal(recv_fragment(0x1002, 2), NET_OK, "Fragment 2");
+
+	check_received(true);
+}
+
+static void test_recv_ipv4_fragment_evict(void)
+{
+	/* The first datagram is missing its last fragment when the
+	 * second one uses up the fragment budget, so the first one is
+	 * given up to let the second one complete.
+	 */
+	zassert_equal(recv_fragment(0x1003, 0), NET_OK, "Fragment 0");
+	zassert_equal(recv_fragment(0x1003, 1), NET_OK, "Fragment 1");
+
+	zassert_equal(recv_fragment(0x1004, 0), NET_OK, "Fragment 0");
+	zassert_equal(recv_fragment(0x1004, 1), NET_OK, "Fragment 1");
+	zassert_equal(recv_fragment(0x1004, 2), NET_OK, "Fragment 2");
+
+	check_received(true);
+
+	zassert_equal(recv_fragment(0x1003, 2), NET_OK, "Fragment 2");
+
+	check_received(false);
+}
+
+static void test_recv_ipv4_fragment_overlap(void)
+{
+	struct net_pkt *pkt;
+
+	zassert_equal(recv_fragment(0x1005, 0), NET_OK, "Fragment 0");
+
+	/* Starts 8 bytes before the end of the first fragment */
+	pkt = create_fragment(0x1005, FRAG_LEN - 8, FRAG_LEN);
+	zassert_equal(net_ipv4_input(pkt), NET_DROP,
+		      "Overlapping fragment accepted");
+	net_pkt_unref(pkt);
+
+	zassert_equal(recv_fragment(0x1005, 1), NET_OK, "Fragment 1");
+	zassert_equal(recv_fragment(0x1005, 2), NET_OK, "Fragment 2");
+
+	check_received(false);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_recv_ipv4_fragment),
+			 ztest_unit_test(test_recv_ipv4_fragment_out_of_order),
+			 ztest_unit_test(test_recv_ipv4_fragment_duplicate),
+			 ztest_unit_test(test_recv_ipv4_fragment_evict),
+			 ztest_unit_test(test_recv_ipv4_fragment_overlap)
+			 );
+
+	ztest_run_test_suite(net_ipv4_fragment_test);
+}
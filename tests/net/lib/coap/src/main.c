@@ -378,6 +378,125 @@ done:
 	return result;
 }
 
+static int test_parse_options(void)
+{
+	static const struct {
+		uint16_t code;
+		const char *value;
+	} ref[] = {
+		{ COAP_OPTION_URI_PATH, "s" },
+		{ COAP_OPTION_URI_PATH, "1" },
+		{ COAP_OPTION_CONTENT_FORMAT, "\x2a" },
+		{ COAP_OPTION_URI_QUERY, "a=1" },
+	};
+	struct coap_option options[4] = {};
+	struct coap_packet cpkt;
+	struct coap_option_iter iter;
+	const uint8_t *value;
+	uint8_t *data;
+	uint16_t code, len;
+	int result = TC_FAIL;
+	int r, i;
+
+	data = (uint8_t *)k_malloc(COAP_BUF_SIZE);
+	if (!data) {
+		goto done;
+	}
+
+	r = coap_packet_init(&cpkt, data, COAP_BUF_SIZE,
+			     1, COAP_TYPE_CON, 0, NULL,
+			     COAP_METHOD_GET, 0x1234);
+	if (r < 0) {
+		TC_PRINT("Could not initialize packet\n");
+		goto done;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(ref); i++) {
+		r = coap_packet_append_option(&cpkt, ref[i].code,
+					      (const uint8_t *)ref[i].value,
+					      strlen(ref[i].value));
+		if (r < 0) {
+			TC_PRINT("Could not append option\n");
+			goto done;
+		}
+	}
+
+	r = coap_packet_append_payload_marker(&cpkt);
+	if (r < 0) {
+		TC_PRINT("Failed to set the payload marker\n");
+		goto done;
+	}
+
+	r = coap_packet_append_payload(&cpkt, (uint8_t *)"payload", 7);
+	if (r < 0) {
+		TC_PRINT("Failed to set the payload\n");
+		goto done;
+	}
+
+	r = coap_packet_parse(&cpkt, data, cpkt.offset, NULL, 0);
+	if (r) {
+		TC_PRINT("Could not parse packet\n");
+		goto done;
+	}
+
+	coap_option_iter_init(&iter, &cpkt);
+
+	for (i = 0; i < ARRAY_SIZE(ref); i++) {
+		r = coap_option_iter_next(&iter, &code, &value, &len);
+		if (r != 1 || code != ref[i].code ||
+		    len != strlen(ref[i].value) ||
+		    memcmp(value, ref[i].value, len)) {
+			TC_PRINT("Option %d doesn't match the reference\n", i);
+			goto done;
+		}
+	}
+
+	if (coap_option_iter_next(&iter, &code, &value, &len) != 0) {
+		TC_PRINT("Unexpected option after the last one\n");
+		goto done;
+	}
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_PATH, options,
+			      ARRAY_SIZE(options));
+	if (r != 2 || options[1].len != 1U || options[1].value[0] != '1') {
+		TC_PRINT("URI path options don't match the reference\n");
+		goto done;
+	}
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, options,
+			      ARRAY_SIZE(options));
+	if (r != 1 || options[0].len != 3U ||
+	    memcmp(options[0].value, "a=1", 3)) {
+		TC_PRINT("URI query option doesn't match the reference\n");
+		goto done;
+	}
+
+	if (coap_get_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT) != 42) {
+		TC_PRINT("Content format doesn't match the reference\n");
+		goto done;
+	}
+
+	/* Not existent, before, between and after the present ones */
+	if (coap_find_options(&cpkt, COAP_OPTION_ETAG, options,
+			      ARRAY_SIZE(options)) ||
+	    coap_find_options(&cpkt, COAP_OPTION_MAX_AGE, options,
+			      ARRAY_SIZE(options)) ||
+	    coap_find_options(&cpkt, COAP_OPTION_ACCEPT, options,
+			      ARRAY_SIZE(options))) {
+		TC_PRINT("Found an option that is not in the packet\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	k_free(data);
+
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int test_parse_malformed_opt(void)
 {
 	uint8_t opt[] = { 0x55, 0xA5, 0x12, 0x34, 't', 'o', 'k', 'e', 'n',
@@ -1454,6 +1573,119 @@ done:
 	return result;
 }
 
+static int router_hits;
+
+static int router_resource_get(struct coap_resource *resource,
+			       struct coap_packet *request,
+			       struct sockaddr *addr, socklen_t addr_len)
+{
+	router_hits = POINTER_TO_INT(resource->user_data);
+
+	return 0;
+}
+
+static const char * const router_path_a[] = { "a", NULL };
+static const char * const router_path_ab[] = { "a", "b", NULL };
+static const char * const router_path_c[] = { "c", "+", NULL };
+static struct coap_resource router_resources[] = {
+	{ .path = router_path_a, .get = router_resource_get,
+	  .user_data = INT_TO_POINTER(1) },
+	{ .path = router_path_ab, .get = router_resource_get,
+	  .user_data = INT_TO_POINTER(2) },
+	{ .path = router_path_c, .get = router_resource_get,
+	  .user_data = INT_TO_POINTER(3) },
+	{ },
+};
+
+static int router_request(struct coap_router *router, const char *seg1,
+			  const char *seg2)
+{
+	struct coap_option options[4];
+	struct coap_packet cpkt;
+	uint8_t data[COAP_BUF_SIZE];
+	int r;
+
+	r = coap_packet_init(&cpkt, data, sizeof(data), 1, COAP_TYPE_CON,
+			     0, NULL, COAP_METHOD_GET, coap_next_id());
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+				      (const uint8_t *)seg1, strlen(seg1));
+	if (r < 0) {
+		return r;
+	}
+
+	if (seg2) {
+		r = coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+					      (const uint8_t *)seg2,
+					      strlen(seg2));
+		if (r < 0) {
+			return r;
+		}
+	}
+
+	r = coap_packet_parse(&cpkt, data, cpkt.offset, options,
+			      ARRAY_SIZE(options));
+	if (r < 0) {
+		return r;
+	}
+
+	router_hits = 0;
+
+	return coap_router_handle_request(router, &cpkt, options,
+					  seg2 ? 2 : 1,
+					  (struct sockaddr *)&dummy_addr,
+					  sizeof(dummy_addr));
+}
+
+static int test_router(void)
+{
+	struct coap_router router;
+	uint16_t table[8];
+	int result = TC_FAIL;
+
+	if (coap_router_init(&router, router_resources, table, 2) !=
+	    -ENOMEM) {
+		TC_PRINT("Router accepted a too small table\n");
+		goto done;
+	}
+
+	if (coap_router_init(&router, router_resources, table,
+			     ARRAY_SIZE(table))) {
+		TC_PRINT("Could not initialize the router\n");
+		goto done;
+	}
+
+	if (router_request(&router, "a", "b") || router_hits != 2) {
+		TC_PRINT("Request for /a/b not routed\n");
+		goto done;
+	}
+
+	if (router_request(&router, "a", NULL) || router_hits != 1) {
+		TC_PRINT("Request for /a not routed\n");
+		goto done;
+	}
+
+	if (router_request(&router, "c", "x") || router_hits != 3) {
+		TC_PRINT("Request for /c/x not routed\n");
+		goto done;
+	}
+
+	if (router_request(&router, "b", NULL) != -ENOENT || router_hits) {
+		TC_PRINT("Request for /b routed\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static const struct {
 	const char *name;
 	int (*func)(void);
@@ -1463,6 +1695,7 @@ static const struct {
 	{ "Parse empty PDU test", test_parse_empty_pdu, },
 	{ "Parse empty PDU test no marker", test_parse_empty_pdu_1, },
 	{ "Parse simple PDU test", test_parse_simple_pdu, },
+	{ "Parse options test", test_parse_options, },
 	{ "Parse malformed option", test_parse_malformed_opt },
 	{ "Parse malformed option length", test_parse_malformed_opt_len },
 	{ "Parse malformed option ext", test_parse_malformed_opt_ext },
@@ -1476,6 +1709,7 @@ static const struct {
 	{ "Test retransmission", test_retransmit_second_round, },
 	{ "Test observer server", test_observer_server, },
 	{ "Test observer client", test_observer_client, },
+	{ "Test router", test_router, },
 };
 
 void main(void)
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <string.h>
+#include <net/net_ip.h>
+#include <dns_internal.h>
+
+#define NAME1 "www.zephyrproject.org"
+#define NAME2 "docs.zephyrproject.org"
+#define NAME3 "github.com"
+
+static struct dns_resolve_context dns_ctx;
+
+static struct dns_addrinfo addrs[2];
+
+static struct dns_addrinfo results[2];
+static int result_count;
+static int result_status;
+
+static void resolve_cb(enum dns_resolve_status status,
+		       struct dns_addrinfo *info,
+		       void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == DNS_EAI_INPROGRESS) {
+		zassert_not_null(info, "No address info");
+		zassert_true(result_count < ARRAY_SIZE(results),
+			     "Too many addresses");
+
+		memcpy(&results[result_count++], info, sizeof(*info));
+		return;
+	}
+
+	zassert_is_null(info, "Address info with status %d", status);
+
+	result_status = status;
+}
+
+static int find(const char *query, enum dns_query_type type)
+{
+	result_count = 0;
+	result_status = 0;
+
+	return dns_cache_find(query, type, resolve_cb, NULL);
+}
+
+static void test_setup(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(addrs); i++) {
+		addrs[i].ai_family = AF_INET;
+		addrs[i].ai_addrlen = sizeof(struct sockaddr_in);
+		addrs[i].ai_addr.sa_family = AF_INET;
+		net_sin(&addrs[i].ai_addr)->sin_addr.s4_addr[0] = 192;
+		net_sin(&addrs[i].ai_addr)->sin_addr.s4_addr[1] = 0;
+		net_sin(&addrs[i].ai_addr)->sin_addr.s4_addr[2] = 2;
+		net_sin(&addrs[i].ai_addr)->sin_addr.s4_addr[3] = i + 1;
+	}
+
+	dns_ctx.is_used = true;
+}
+
+static void test_dns_cache_positive(void)
+{
+	int ret;
+
+	dns_cache_add(NAME1, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+		      addrs, ARRAY_SIZE(addrs), 60);
+
+	ret = find(NAME1, DNS_QUERY_TYPE_A);
+	zassert_equal(ret, 0, "Name not cached");
+	zassert_equal(result_count, 2, "Invalid address count %d",
+		      result_count);
+	zassert_equal(result_status, DNS_EAI_ALLDONE, "Invalid status %d",
+		      result_status);
+	zassert_mem_equal(results, addrs, sizeof(addrs), "Invalid addresses");
+
+	ret = find(NAME1, DNS_QUERY_TYPE_AAAA);
+	zassert_equal(ret, -ENOENT, "Wrong query type found");
+
+	ret = find(NAME2, DNS_QUERY_TYPE_A);
+	zassert_equal(ret, -ENOENT, "Wrong name found");
+}
+
+static void test_dns_cache_negative(void)
+{
+	int ret;
+
+	dns_cache_add(NAME2, DNS_QUERY_TYPE_AAAA, DNS_EAI_NODATA, NULL, 0,
+		      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+
+	ret = find(NAME2, DNS_QUERY_TYPE_AAAA);
+	zassert_equal(ret, 0, "Name not cached");
+	zassert_equal(result_count, 0, "Addresses for a missing name");
+	zassert_equal(result_status, DNS_EAI_NODATA, "Invalid status %d",
+		      result_status);
+}
+
+static void test_dns_cache_expire(void)
+{
+	int ret;
+
+	dns_cache_add(NAME3, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE, addrs, 1, 1);
+
+	ret = find(NAME3, DNS_QUERY_TYPE_A);
+	zassert_equal(ret, 0, "Name not cached");
+
+	k_sleep(K_MSEC(1100));
+
+	ret = find(NAME3, DNS_QUERY_TYPE_A);
+	zassert_equal(ret, -ENOENT, "Expired name found");
+}
+
+static void test_dns_cache_lru(void)
+{
+	int ret;
+
+	dns_resolve_cache_flush();
+
+	dns_cache_add(NAME1, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE, addrs, 1, 60);
+	dns_cache_add(NAME2, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE, addrs, 1, 60);
+
+	/* NAME1 is now the most recently used one */
+	ret = find(NAME1, DNS_QUERY_TYPE_A);
+	zassert_equal(ret, 0, "Name not cached");
+
+	dns_cache_add(NAME3, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE, addrs, 1, 60);
+
+	zassert_equal(find(NAME1, DNS_QUERY_TYPE_A), 0, "Name1 evicted");
+	zassert_equal(find(NAME2, DNS_QUERY_TYPE_A), -ENOENT,
+		      "Name2 not evicted");
+	zassert_equal(find(NAME3, DNS_QUERY_TYPE_A), 0, "Name3 not cached");
+}
+
+static void test_dns_cache_resolve(void)
+{
+	uint16_t dns_id = 1U;
+	int ret;
+
+	dns_cache_add(NAME1, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+		      addrs, ARRAY_SIZE(addrs), 60);
+
+	result_count = 0;
+	result_status = 0;
+
+	/* The context has no servers, so the result can only come from
+	 * the cache.
+	 */
+	ret = dns_resolve_name(&dns_ctx, NAME1, DNS_QUERY_TYPE_A, &dns_id,
+			       resolve_cb, NULL, 1000);
+	zassert_equal(ret, 0, "Cannot resolve (%d)", ret);
+	zassert_equal(dns_id, 0U, "Invalid DNS id %u", dns_id);
+	zassert_equal(result_count, 2, "Invalid address count %d",
+		      result_count);
+	zassert_equal(result_status, DNS_EAI_ALLDONE, "Invalid status %d",
+		      result_status);
+}
+
+static void test_dns_cache_flush(void)
+{
+	dns_resolve_cache_flush();
+
+	zassert_equal(find(NAME1, DNS_QUERY_TYPE_A), -ENOENT,
+		      "Name found after flush");
+	zassert_equal(find(NAME3, DNS_QUERY_TYPE_A), -ENOENT,
+		      "Name found after flush");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(dns_cache_tests,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_dns_cache_positive),
+			 ztest_unit_test(test_dns_cache_negative),
+			 ztest_unit_test(test_dns_cache_expire),
+			 ztest_unit_test(test_dns_cache_lru),
+			 ztest_unit_test(test_dns_cache_resolve),
+			 ztest_unit_test(test_dns_cache_flush)
+		);
+
+	ztest_run_test_suite(dns_cache_tests);
+}
@@ -10,6 +10,7 @@ extern void test_mqtt_init(void);
 extern void test_mqtt_connect(void);
 extern void test_mqtt_pingreq(void);
 extern void test_mqtt_publish(void);
+extern void test_mqtt_publish_pipelined(void);
 extern void test_mqtt_disconnect(void);
 
 void test_main(void)
@@ -18,6 +19,7 @@ void test_main(void)
 			ztest_unit_test(test_mqtt_connect),
 			ztest_unit_test(test_mqtt_pingreq),
 			ztest_unit_test(test_mqtt_publish),
+			ztest_unit_test(test_mqtt_publish_pipelined),
 			ztest_unit_test(test_mqtt_disconnect));
 	ztest_run_test_suite(mqtt_test);
 }
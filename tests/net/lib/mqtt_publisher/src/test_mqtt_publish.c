@@ -30,6 +30,7 @@ static struct sockaddr broker;
 static struct zsock_pollfd fds[1];
 static int nfds;
 static bool connected;
+static int puback_count;
 
 static void broker_init(void)
 {
@@ -108,6 +109,8 @@ void mqtt_evt_handler(struct mqtt_client *const client,
 		TC_PRINT("[%s:%d] MQTT_EVT_PUBACK packet id: %u\n",
 			 __func__, __LINE__, evt->param.puback.message_id);
 
+		puback_count++;
+
 		break;
 
 	case MQTT_EVT_PUBREC:
@@ -280,6 +283,70 @@ static int test_publish(enum mqtt_qos qos)
 	return TC_PASS;
 }
 
+static int publish_pipelined(void)
+{
+	struct mqtt_publish_param param = { 0 };
+	int64_t start;
+	int rc, i;
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size =
+			strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = get_mqtt_payload(MQTT_QOS_1_AT_LEAST_ONCE);
+	param.message.payload.len =
+			strlen(param.message.payload.data);
+
+	puback_count = 0;
+	start = k_uptime_get();
+
+	/* Fill the whole window without waiting for any PUBACK */
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		param.message_id = 1 + i;
+
+		rc = mqtt_publish(&client_ctx, &param);
+		if (rc != 0) {
+			TC_PRINT("Publish %d failed %d\n", i, rc);
+			return TC_FAIL;
+		}
+	}
+
+	param.message_id = 1 + i;
+
+	rc = mqtt_publish(&client_ctx, &param);
+	if (rc != -EBUSY) {
+		TC_PRINT("Publish past the window returned %d\n", rc);
+		return TC_FAIL;
+	}
+
+	for (i = 0; i < APP_MAX_ITERATIONS &&
+		    puback_count < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		wait(APP_SLEEP_MSECS);
+		mqtt_input(&client_ctx);
+	}
+
+	if (puback_count < CONFIG_MQTT_INFLIGHT_WINDOW) {
+		TC_PRINT("Got %d PUBACKs\n", puback_count);
+		return TC_FAIL;
+	}
+
+	TC_PRINT("%d QoS 1 messages acknowledged in %lld ms\n",
+		 puback_count, (long long)(k_uptime_get() - start));
+
+	/* The window is empty again */
+	param.message_id = 1 + CONFIG_MQTT_INFLIGHT_WINDOW;
+
+	rc = mqtt_publish(&client_ctx, &param);
+	if (rc != 0) {
+		return TC_FAIL;
+	}
+
+	wait(APP_SLEEP_MSECS);
+	mqtt_input(&client_ctx);
+
+	return TC_PASS;
+}
+
 static int test_disconnect(void)
 {
 	int rc;
@@ -311,6 +378,11 @@ void test_mqtt_publish(void)
 	zassert_true(test_publish(MQTT_QOS_2_EXACTLY_ONCE) == TC_PASS, NULL);
 }
 
+void test_mqtt_publish_pipelined(void)
+{
+	zassert_true(publish_pipelined() == TC_PASS, NULL);
+}
+
 void test_mqtt_disconnect(void)
 {
 	zassert_true(test_disconnect() == TC_PASS, NULL);
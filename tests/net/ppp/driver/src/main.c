@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 #include <net/buf.h>
 #include <net/net_ip.h>
 #include <net/net_if.h>
+#include <net/ppp.h>
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -34,6 +35,7 @@ typedef enum net_verdict (*ppp_l2_callback_t)(struct net_if *iface,
 					      struct net_pkt *pkt);
 void ppp_l2_register_pkt_cb(ppp_l2_callback_t cb); /* found in ppp_l2.c */
 void ppp_driver_feed_data(uint8_t *data, int data_len);
+void ppp_driver_set_tx_cb(void (*cb)(const uint8_t *data, size_t len));
 
 static struct net_if *iface;
 
@@ -537,6 +539,85 @@ static void test_send_ppp_8(void)
 	}
 }
 
+/* Protocol and every byte value twice */
+static uint8_t loopback_data[2 + 2 * 256];
+static uint8_t loopback_wire[2 * (4 + sizeof(loopback_data) + 2) + 1];
+static size_t loopback_wire_len;
+
+static void ppp_tx_capture(const uint8_t *data, size_t len)
+{
+	if (loopback_wire_len + len > sizeof(loopback_wire)) {
+		test_failed = true;
+		return;
+	}
+
+	memcpy(loopback_wire + loopback_wire_len, data, len);
+	loopback_wire_len += len;
+}
+
+static void test_ppp_loopback(void)
+{
+	const struct device *dev = net_if_get_device(iface);
+	const struct ppp_api *api = dev->api;
+	struct net_pkt *pkt;
+	size_t i, escapes = 0;
+	bool ret;
+
+	loopback_data[0] = 0x00;
+	loopback_data[1] = 0x21;
+	for (i = 2; i < sizeof(loopback_data); i++) {
+		loopback_data[i] = i - 2;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(loopback_data),
+					AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_ppp(pkt, true);
+	zassert_equal(net_pkt_write(pkt, loopback_data, sizeof(loopback_data)),
+		      0, "Cannot write pkt");
+
+	test_failed = false;
+	loopback_wire_len = 0;
+
+	ppp_driver_set_tx_cb(ppp_tx_capture);
+	zassert_equal(api->send(dev, pkt), 0, "Cannot send pkt");
+	ppp_driver_set_tx_cb(NULL);
+
+	net_pkt_unref(pkt);
+
+	zassert_false(test_failed, "Too much data sent");
+	zassert_true(loopback_wire_len > 2, "No data sent");
+	zassert_equal(loopback_wire[0], 0x7e, "No start flag");
+	zassert_equal(loopback_wire[loopback_wire_len - 1], 0x7e,
+		      "No end flag");
+
+	for (i = 1; i < loopback_wire_len - 1; i++) {
+		zassert_false(loopback_wire[i] == 0x7e ||
+			      loopback_wire[i] < 0x20,
+			      "Byte %zd not escaped", i);
+
+		if (loopback_wire[i] == 0x7d) {
+			escapes++;
+		}
+	}
+
+	/* Control field and the first protocol byte, then the control
+	 * characters, flag and escape in each round of the data.
+	 */
+	zassert_true(escapes >= 2 + 2 * (0x20 + 2), "Only %zd escapes",
+		     escapes);
+
+	ret = send_iface(iface, loopback_wire, loopback_wire_len,
+			 loopback_data, sizeof(loopback_data));
+
+	zassert_true(ret, "iface");
+
+	if (k_sem_take(&wait_data, WAIT_TIME_LONG)) {
+		zassert_true(false, "Timeout, packet not received");
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_ppp_test,
@@ -551,7 +632,8 @@ void test_main(void)
 			 ztest_unit_test(test_send_ppp_5),
 			 ztest_unit_test(test_send_ppp_6),
 			 ztest_unit_test(test_send_ppp_7),
-			 ztest_unit_test(test_send_ppp_8)
+			 ztest_unit_test(test_send_ppp_8),
+			 ztest_unit_test(test_ppp_loopback)
 		);
 
 	ztest_run_test_suite(net_ppp_test);
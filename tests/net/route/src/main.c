@@ -473,6 +473,55 @@ static void test_route_del_many(void)
 	}
 }
 
+static void test_route_longest_match(void)
+{
+	static const uint8_t prefix_lens[] = { 32, 48, 64, 128 };
+	struct net_route_entry *routes[ARRAY_SIZE(prefix_lens)];
+	struct in6_addr other = dest_addr;
+	struct net_route_entry *found;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(prefix_lens); i++) {
+		routes[i] = net_route_add(my_iface, &dest_addr,
+					  prefix_lens[i], &peer_addr);
+		zassert_not_null(routes[i], "Route /%d add failed",
+				 prefix_lens[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(prefix_lens); i++) {
+		zassert_true(routes[i]->prefix_len == prefix_lens[i],
+			     "Route /%d replaced", prefix_lens[i]);
+	}
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, routes[3], "Host route not matched");
+
+	/* Differs from dest_addr in the last 64 bits */
+	other.s6_addr[15] ^= 0x01;
+	found = net_route_lookup(my_iface, &other);
+	zassert_equal_ptr(found, routes[2], "/64 route not matched");
+
+	/* Differs from dest_addr in bits 48 to 63 */
+	other.s6_addr[6] ^= 0x80;
+	found = net_route_lookup(NULL, &other);
+	zassert_equal_ptr(found, routes[1], "/48 route not matched");
+
+	zassert_false(net_route_del(routes[1]), "Route del failed");
+
+	found = net_route_lookup(my_iface, &other);
+	zassert_equal_ptr(found, routes[0], "/32 route not matched");
+
+	found = net_route_lookup(peer_iface, &other);
+	zassert_is_null(found, "Route of the other interface matched");
+
+	zassert_false(net_route_del(routes[0]), "Route del failed");
+	zassert_false(net_route_del(routes[2]), "Route del failed");
+	zassert_false(net_route_del(routes[3]), "Route del failed");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(found, "Deleted route matched");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -492,6 +541,7 @@ void test_main(void)
 			ztest_unit_test(test_route_del_nexthop_again),
 			ztest_unit_test(test_populate_nbr_cache),
 			ztest_unit_test(test_route_add_many),
-			ztest_unit_test(test_route_del_many));
+			ztest_unit_test(test_route_del_many),
+			ztest_unit_test(test_route_longest_match));
 	ztest_run_test_suite(test_route);
 }
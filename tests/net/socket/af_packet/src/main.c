@@ -263,10 +263,92 @@ static void test_packet_sockets_dgram(void)
 		      -errno);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+#define RING_FRAME_SIZE 128
+#define RING_FRAME_NR 2
+
+static uint8_t ring[RING_FRAME_SIZE * RING_FRAME_NR]
+	__aligned(TPACKET_ALIGNMENT);
+
+static void test_packet_sockets_rx_ring(void)
+{
+	uint8_t data_to_send[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	struct tpacket_req req = {
+		.tp_ring = ring,
+		.tp_frame_size = RING_FRAME_SIZE,
+		.tp_frame_nr = RING_FRAME_NR,
+	};
+	struct user_data ud = { 0 };
+	struct tpacket_hdr *hdr;
+	struct sockaddr_ll dst;
+	struct pollfd pfd;
+	int ret, sock;
+
+	net_if_foreach(iface_cb, &ud);
+
+	zassert_not_null(ud.first, "1st Ethernet interface not found");
+	zassert_not_null(ud.second, "2nd Ethernet interface not found");
+
+	sock = setup_socket(ud.second, SOCK_DGRAM, ETH_P_TSN);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", sock);
+
+	ret = bind_socket(sock, ud.second);
+	zassert_equal(ret, 0, "Cannot bind socket (%d)", -errno);
+
+	ret = setsockopt(sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot set RX ring (%d)", -errno);
+
+	ret = setsockopt(sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, -1, "RX ring set twice");
+	zassert_equal(errno, EBUSY, "Wrong errno (%d)", errno);
+
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+
+	ret = poll(&pfd, 1, 0);
+	zassert_equal(ret, 0, "Empty ring reported readable");
+
+	memset(&dst, 0, sizeof(dst));
+	dst.sll_ifindex = net_if_get_by_iface(ud.first);
+	dst.sll_family = AF_PACKET;
+
+	ret = sendto(sock, data_to_send, sizeof(data_to_send), 0,
+		     (const struct sockaddr *)&dst, sizeof(struct sockaddr_ll));
+	zassert_equal(ret, sizeof(data_to_send), "Cannot send all data (%d)",
+		      -errno);
+
+	ret = poll(&pfd, 1, 1000);
+	zassert_equal(ret, 1, "Ring not readable (%d)", ret);
+	zassert_true(pfd.revents & POLLIN, "No POLLIN (%x)", pfd.revents);
+
+	hdr = (struct tpacket_hdr *)ring;
+	zassert_true(hdr->tp_status & TP_STATUS_USER, "Slot not filled");
+	zassert_true(hdr->tp_snaplen >= sizeof(data_to_send),
+		     "Frame too short (%u)", hdr->tp_snaplen);
+	zassert_mem_equal((uint8_t *)hdr + hdr->tp_mac, data_to_send,
+			  sizeof(data_to_send), "Invalid frame data");
+
+	/* Give the slot back, the ring is empty again */
+	hdr->tp_status = TP_STATUS_KERNEL;
+
+	ret = poll(&pfd, 1, 0);
+	zassert_equal(ret, 0, "Empty ring reported readable");
+
+	ret = close(sock);
+	zassert_equal(ret, 0, "Cannot close socket (%d)", -errno);
+}
+#else
+static void test_packet_sockets_rx_ring(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 void test_main(void)
 {
 	ztest_test_suite(socket_packet,
 			 ztest_unit_test(test_packet_sockets),
-			 ztest_unit_test(test_packet_sockets_dgram));
+			 ztest_unit_test(test_packet_sockets_dgram),
+			 ztest_unit_test(test_packet_sockets_rx_ring));
 	ztest_run_test_suite(socket_packet);
 }
@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 
 #include <net/socket.h>
+#include <net/socket_pollset.h>
 #include <sys/fdtable.h>
 
 #include "../../socket_helpers.h"
@@ -173,10 +174,89 @@ void test_poll(void)
 	zassert_equal(res, 0, "close failed");
 }
 
+void test_pollset(void)
+{
+	int res;
+	int c_sock;
+	int s_sock;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct zsock_pollset pset;
+	struct pollfd ready[2];
+	uint32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	zsock_pollset_init(&pset);
+
+	res = zsock_pollset_add(&pset, c_sock, POLLIN);
+	zassert_equal(res, 0, "add failed");
+	res = zsock_pollset_add(&pset, s_sock, POLLIN);
+	zassert_equal(res, 0, "add failed");
+	res = zsock_pollset_add(&pset, s_sock, POLLIN);
+	zassert_equal(res, -EEXIST, "");
+
+	/* Nothing ready */
+	tstamp = k_uptime_get_32();
+	res = zsock_pollset_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	tstamp = k_uptime_get_32();
+	res = zsock_pollset_wait(&pset, ready, ARRAY_SIZE(ready), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "");
+	zassert_equal(res, 0, "");
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_pollset_wait(&pset, ready, ARRAY_SIZE(ready), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(ready[0].fd, s_sock, "");
+	zassert_equal(ready[0].revents, POLLIN, "");
+
+	/* Level triggered: still ready until the data is read */
+	res = zsock_pollset_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(ready[0].fd, s_sock, "");
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_pollset_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+	zassert_equal(res, 0, "");
+
+	res = zsock_pollset_remove(&pset, c_sock);
+	zassert_equal(res, 0, "remove failed");
+	res = zsock_pollset_remove(&pset, c_sock);
+	zassert_equal(res, -ENOENT, "");
+	res = zsock_pollset_remove(&pset, s_sock);
+	zassert_equal(res, 0, "remove failed");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_poll,
-			 ztest_unit_test(test_poll));
+			 ztest_unit_test(test_poll),
+			 ztest_unit_test(test_pollset));
 
 	ztest_run_test_suite(socket_poll);
 }
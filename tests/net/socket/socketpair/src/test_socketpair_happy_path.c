@@ -36,6 +36,7 @@ static void happy_path(
 	char actual_msg[32];
 	size_t actual_msg_len;
 	struct iovec iovec;
+	struct iovec iovecs[2];
 	struct msghdr msghdr;
 
 	LOG_DBG("calling socketpair(%u, %u, %u, %p)", family, type, proto, sv);
@@ -146,6 +147,35 @@ static void happy_path(
 
 		res = read(sv[(!i) & 1], actual_msg, sizeof(actual_msg));
 
+		zassert_not_equal(res, -1, "read(2) failed: %d", errno);
+		actual_msg_len = res;
+		zassert_equal(actual_msg_len, expected_msg_len,
+			      "wrong return value");
+
+		zassert_true(strncmp(expected_msg, actual_msg,
+			actual_msg_len) == 0,
+			"the wrong message was passed through the socketpair");
+
+		/*
+		 * Test with sendmsg(2) of several buffers / recv(2)
+		 */
+
+		msghdr.msg_iov = iovecs;
+		msghdr.msg_iovlen = ARRAY_SIZE(iovecs);
+		iovecs[0].iov_base = (void *)expected_msg;
+		iovecs[0].iov_len = 5;
+		iovecs[1].iov_base = (void *)&expected_msg[5];
+		iovecs[1].iov_len = expected_msg_len - 5;
+
+		res = sendmsg(sv[i], &msghdr, 0);
+
+		zassert_not_equal(res, -1, "sendmsg(2) failed: %d", errno);
+		actual_msg_len = res;
+		zassert_equal(actual_msg_len, expected_msg_len,
+				  "did not sendmsg entire message");
+
+		res = read(sv[(!i) & 1], actual_msg, sizeof(actual_msg));
+
 		zassert_not_equal(res, -1, "read(2) failed: %d", errno);
 		actual_msg_len = res;
 		zassert_equal(actual_msg_len, expected_msg_len,
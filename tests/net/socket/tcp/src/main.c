@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 #include <fcntl.h>
 #include <net/socket.h>
+#include <net/buf.h>
 
 #include "../../socket_helpers.h"
 
@@ -184,6 +185,61 @@ void test_v4_send_recv(void)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+void test_v4_send_recv_zc(void)
+{
+	/* Test that zsock_recv_zc() hands over stream data in order. */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags;
+	char rx_buf[30] = {0};
+	ssize_t recved;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* Partial receive leaves the rest in the socket */
+	recved = zsock_recv_zc(new_sock, &frags, 2, 0, NULL, NULL);
+	zassert_equal(recved, 2, "unexpected received bytes");
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, recved);
+	zsock_recv_zc_release(frags);
+
+	recved = zsock_recv_zc(new_sock, &frags, sizeof(rx_buf), 0, NULL,
+			       NULL);
+	zassert_equal(recved, strlen(TEST_STR_SMALL) - 2,
+		      "unexpected received bytes");
+	net_buf_linearize(rx_buf + 2, sizeof(rx_buf) - 2, frags, 0, recved);
+	zsock_recv_zc_release(frags);
+
+	zassert_equal(strncmp(rx_buf, TEST_STR_SMALL, strlen(TEST_STR_SMALL)),
+		      0, "unexpected data");
+
+	test_close(c_sock);
+
+	recved = zsock_recv_zc(new_sock, &frags, sizeof(rx_buf), 0, NULL,
+			       NULL);
+	zassert_equal(recved, 0, "EOF not detected");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_v6_send_recv(void)
 {
 	/* Test if send() and recv() work on a ipv6 stream socket. */
@@ -517,6 +573,7 @@ void test_main(void)
 		socket_tcp,
 		ztest_user_unit_test(test_v4_send_recv),
 		ztest_user_unit_test(test_v6_send_recv),
+		ztest_unit_test(test_v4_send_recv_zc),
 		ztest_user_unit_test(test_v4_sendto_recvfrom),
 		ztest_user_unit_test(test_v6_sendto_recvfrom),
 		ztest_user_unit_test(test_v4_sendto_recvfrom_null_dest),
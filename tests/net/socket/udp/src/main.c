@@ -311,6 +311,155 @@ void test_send_recv_2_sock(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#define MMSG_COUNT 4
+
+static ZTEST_BMEM char mmsg_buf[MMSG_COUNT][32];
+
+void test_sendmmsg_recvmmsg(void)
+{
+	int sock1, sock2;
+	struct sockaddr_in bind_addr, conn_addr;
+	struct sockaddr_in addrs[MMSG_COUNT];
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec iov[MMSG_COUNT];
+	int i, rv;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55557,
+			    &sock1, &bind_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55557,
+			    &sock2, &conn_addr);
+
+	rv = bind(sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = connect(sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	/* Datagram i carries the first i + 1 bytes of the string */
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = TEST_STR_SMALL;
+		iov[i].iov_len = i + 1;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(sock2, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, i + 1, "wrong sent length");
+	}
+
+	/* Receive into buffers of two bytes, so that the last two
+	 * datagrams are truncated.
+	 */
+	memset(msgs, 0, sizeof(msgs));
+	clear_buf(mmsg_buf);
+	for (i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = mmsg_buf[i];
+		iov[i].iov_len = 2;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+
+	/* Give the loopback time to queue all of them */
+	k_sleep(K_MSEC(100));
+
+	rv = recvmmsg(sock1, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, MIN(i + 1, 2),
+			      "wrong received length");
+		zassert_mem_equal(mmsg_buf[i], TEST_STR_SMALL,
+				  msgs[i].msg_len, "wrong data");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen,
+			      sizeof(struct sockaddr_in), "wrong addrlen");
+		zassert_equal(!!(msgs[i].msg_hdr.msg_flags & MSG_TRUNC),
+			      i + 1 > 2, "wrong truncation flag");
+	}
+
+	rv = recvmmsg(sock1, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "unexpected datagrams");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_recv_zc(void)
+{
+	int sock1, sock2;
+	struct sockaddr_in bind_addr, conn_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags;
+	int len, rv;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55556,
+			    &sock1, &bind_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55556,
+			    &sock2, &conn_addr);
+
+	rv = bind(sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = connect(sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	/* Datagram spanning several buffers is received as a whole */
+	len = send(sock2, BUF_AND_SIZE(TEST_STR2), 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	len = zsock_recv_zc(sock1, &frags, sizeof(rx_buf), 0, &addr, &addrlen);
+	zassert_equal(len, STRLEN(TEST_STR2), "Invalid recv len");
+	zassert_equal(net_buf_frags_len(frags), len, "Invalid frags len");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "Invalid addrlen");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, len);
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "Wrong data");
+	zsock_recv_zc_release(frags);
+
+	/* The rest of a partially received datagram is discarded */
+	len = send(sock2, BUF_AND_SIZE(TEST_STR2), 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+	len = send(sock2, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	len = zsock_recv_zc(sock1, &frags, 16, 0, NULL, NULL);
+	zassert_equal(len, 16, "Invalid recv len");
+	zassert_equal(net_buf_frags_len(frags), 16, "Invalid frags len");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, len);
+	zassert_mem_equal(rx_buf, TEST_STR2, 16, "Wrong data");
+	zsock_recv_zc_release(frags);
+
+	len = zsock_recv_zc(sock1, &frags, sizeof(rx_buf), 0, NULL, NULL);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "Invalid recv len");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, len);
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR_SMALL), "Wrong data");
+	zsock_recv_zc_release(frags);
+
+	len = zsock_recv_zc(sock1, &frags, sizeof(rx_buf), MSG_DONTWAIT,
+			    NULL, NULL);
+	zassert_equal(len, -1, "Unexpected data");
+	zassert_equal(errno, EAGAIN, "Unexpected errno");
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_so_priority(void)
 {
 	struct sockaddr_in bind_addr4;
@@ -960,6 +1109,9 @@ void test_main(void)
 
 	ztest_test_suite(socket_udp,
 			 ztest_unit_test(test_send_recv_2_sock),
+			 ztest_unit_test(test_recv_zc),
+			 ztest_unit_test(test_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_sendmmsg_recvmmsg),
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
 			 ztest_unit_test(test_v4_bind_sendto),
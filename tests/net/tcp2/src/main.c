@@ -604,6 +604,16 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+		/* The SYN of test case 4 offers window scaling and SACK,
+		 * so the SYN | ACK has to echo them.
+		 */
+		if (test_case_no == 4U &&
+		    (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ||
+		     IS_ENABLED(CONFIG_NET_TCP_SACK))) {
+			zassert_true(th->th_off > 5U, "No SYN | ACK options");
+		} else {
+			zassert_equal(th->th_off, 5U, "Unexpected options");
+		}
 		seq++;
 		ack = ntohs(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
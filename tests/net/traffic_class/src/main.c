@@ -968,10 +968,78 @@ static void test_traffic_class_recv_data_mix_all_2(void)
 	zassert_false(test_failed, "Traffic class verification failed.");
 }
 
+#if defined(CONFIG_NET_FLOW_STEERING)
+static uint32_t flow_hash_get(uint16_t src_port, uint16_t dst_port)
+{
+	struct net_ipv6_hdr ipv6 = {
+		.vtc = 0x60,
+		.len = htons(sizeof(struct net_udp_hdr)),
+		.nexthdr = IPPROTO_UDP,
+		.hop_limit = 64,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(src_port),
+		.dst_port = htons(dst_port),
+		.len = htons(sizeof(struct net_udp_hdr)),
+	};
+	struct net_pkt *pkt;
+	uint32_t hash;
+
+	net_ipaddr_copy(&ipv6.src, &my_addr1);
+	net_ipaddr_copy(&ipv6.dst, &dst_addr);
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(),
+					sizeof(ipv6) + sizeof(udp),
+					AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_equal(net_pkt_write(pkt, &ipv6, sizeof(ipv6)), 0,
+		      "Cannot write IPv6 header");
+	zassert_equal(net_pkt_write(pkt, &udp, sizeof(udp)), 0,
+		      "Cannot write UDP header");
+
+	hash = net_tc_flow_hash(pkt, false);
+
+	zassert_equal(net_pkt_get_current_offset(pkt),
+		      sizeof(ipv6) + sizeof(udp), "Cursor was moved");
+
+	net_pkt_unref(pkt);
+
+	return hash;
+}
+#endif
+
+static void test_traffic_class_flow_hash(void)
+{
+#if defined(CONFIG_NET_FLOW_STEERING)
+	struct net_pkt pkt = { 0 };
+	uint32_t hash, queues = 0U;
+	int i;
+
+	hash = flow_hash_get(TEST_PORT, TEST_PORT);
+	zassert_not_equal(hash, 0U, "Flow hash not set");
+	zassert_equal(hash, flow_hash_get(TEST_PORT, TEST_PORT),
+		      "Same flow gives different hashes");
+	zassert_not_equal(hash, flow_hash_get(TEST_PORT + 1, TEST_PORT),
+			  "Source port not hashed");
+
+	/* Different flows should be spread over the rings */
+	for (i = 0; i < 64; i++) {
+		net_pkt_set_flow_hash(&pkt, flow_hash_get(1024 + i, TEST_PORT));
+		queues |= BIT(net_eth_queue_select(&pkt, 4));
+	}
+
+	zassert_not_equal(queues & (queues - 1), 0U, "All flows on one ring");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_traffic_class_test,
 			 ztest_unit_test(test_traffic_class_general_setup),
+			 ztest_unit_test(test_traffic_class_flow_hash),
 			 ztest_unit_test(test_traffic_class_setup_tx),
 			 /* Send only same priority packets and verify that
 			  * all are sent with proper traffic class.
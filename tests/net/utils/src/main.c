@@ -832,11 +832,209 @@ void test_addr_parse(void)
 #endif
 }
 
+#if defined(CONFIG_NET_IPV4)
+/* Byte at a time sum of the big endian words */
+static uint16_t ref_chksum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		sum += (i & 1) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static void test_chksum_fragments(void)
+{
+	/* Odd fragment lengths and odd start addresses */
+	static const struct {
+		size_t len;
+		size_t reserve;
+	} frags[] = {
+		{ NET_IPV4H_LEN + 3, 0 }, { 7, 1 }, { 1, 0 }, { 50, 1 },
+		{ 2, 0 }, { 11, 3 },
+	};
+	uint8_t data[NET_IPV4H_LEN + 3 + 7 + 1 + 50 + 2 + 11];
+	size_t payload_len = sizeof(data) - NET_IPV4H_LEN;
+	struct net_pkt *pkt;
+	uint16_t expected;
+	uint32_t sum;
+	size_t offset = 0;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i * 37 + 11;
+	}
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	for (i = 0; i < ARRAY_SIZE(frags); i++) {
+		struct net_buf *frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+
+		zassert_not_null(frag, "Cannot allocate frag");
+
+		net_buf_reserve(frag, frags[i].reserve);
+		net_buf_add_mem(frag, data + offset, frags[i].len);
+		net_pkt_frag_add(pkt, frag);
+
+		offset += frags[i].len;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	/* Pseudo header addresses, then the payload */
+	sum = ref_chksum(payload_len + IPPROTO_UDP,
+			 data + offsetof(struct net_ipv4_hdr, src),
+			 2 * sizeof(struct in_addr));
+	sum = ref_chksum(sum, data + NET_IPV4H_LEN, payload_len);
+	expected = ~((sum == 0U) ? 0xffff : htons(sum));
+
+	zassert_equal(net_calc_chksum(pkt, IPPROTO_UDP), expected,
+		      "Wrong checksum");
+
+	net_pkt_unref(pkt);
+}
+
+static void test_chksum_copy(void)
+{
+	uint8_t data[NET_IPV4H_LEN + 75];
+	uint8_t copy[10];
+	size_t payload_len = sizeof(data) - NET_IPV4H_LEN;
+	struct net_pkt_csum csum = { 0 };
+	struct net_pkt *pkt, *pkt2;
+	uint16_t expected;
+	uint32_t sum;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i * 53 + 7;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(NULL, sizeof(data), AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	/* Odd lengths and odd source addresses */
+	zassert_ok(net_pkt_write(pkt, data, NET_IPV4H_LEN), "Write failed");
+	zassert_ok(net_pkt_write_csum(pkt, data + NET_IPV4H_LEN, 3, &csum),
+		   "Write failed");
+	zassert_ok(net_pkt_write_csum(pkt, data + NET_IPV4H_LEN + 3, 41,
+				      &csum), "Write failed");
+	zassert_ok(net_pkt_write_csum(pkt, data + NET_IPV4H_LEN + 44, 31,
+				      &csum), "Write failed");
+
+	zassert_equal(csum.len, payload_len, "Wrong summed length");
+	zassert_equal(csum.sum, ref_chksum(0, data + NET_IPV4H_LEN,
+					   payload_len), "Wrong partial sum");
+
+	sum = ref_chksum(payload_len + IPPROTO_UDP,
+			 data + offsetof(struct net_ipv4_hdr, src),
+			 2 * sizeof(struct in_addr));
+	sum = ref_chksum(sum, data + NET_IPV4H_LEN, payload_len);
+	expected = ~((sum == 0U) ? 0xffff : htons(sum));
+
+	net_pkt_set_payload_csum(pkt, &csum);
+	zassert_equal(net_calc_chksum(pkt, IPPROTO_UDP), expected,
+		      "Wrong checksum with the whole payload summed");
+
+	/* Only the last 30 bytes summed, after an odd number of bytes */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, NET_IPV4H_LEN + 45);
+
+	csum = (struct net_pkt_csum){ 0 };
+	zassert_ok(net_pkt_read_csum(pkt, copy, sizeof(copy), &csum),
+		   "Read failed");
+	zassert_ok(net_pkt_read_csum(pkt, NULL, 20, &csum), "Sum failed");
+	zassert_mem_equal(copy, data + NET_IPV4H_LEN + 45, sizeof(copy),
+			  "Wrong data read");
+
+	net_pkt_set_payload_csum(pkt, &csum);
+	zassert_equal(net_calc_chksum(pkt, IPPROTO_UDP), expected,
+		      "Wrong checksum with part of the payload summed");
+
+	pkt2 = net_pkt_alloc_with_buffer(NULL, payload_len, AF_INET,
+					 IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt2, "Cannot allocate pkt");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, NET_IPV4H_LEN);
+
+	csum = (struct net_pkt_csum){ 0 };
+	zassert_ok(net_pkt_copy_csum(pkt2, pkt, payload_len, &csum),
+		   "Copy failed");
+	zassert_equal(csum.sum, ref_chksum(0, data + NET_IPV4H_LEN,
+					   payload_len), "Wrong copy sum");
+
+	net_pkt_unref(pkt2);
+	net_pkt_unref(pkt);
+}
+
+static void test_chksum_update(void)
+{
+	uint8_t hdr[NET_IPV4H_LEN] = {
+		0x45, 0x00, 0x00, 0x54, 0x12, 0x34, 0x40, 0x00,
+		0x40, 0x01, 0x00, 0x00, 192, 0, 2, 1, 192, 0, 2, 2,
+	};
+	struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)hdr;
+	struct in_addr addr = { { { 198, 51, 100, 7 } } };
+	uint16_t chksum;
+
+	ip->chksum = htons(~ref_chksum(0, hdr, sizeof(hdr)));
+
+	/* Like a NAT rewriting the source address */
+	chksum = net_chksum_update(ip->chksum, &ip->src, &addr,
+				   sizeof(addr));
+	memcpy(&ip->src, &addr, sizeof(addr));
+
+	ip->chksum = 0U;
+	zassert_equal(chksum, htons(~ref_chksum(0, hdr, sizeof(hdr))),
+		      "Wrong updated checksum");
+
+	ip->chksum = chksum;
+	chksum = net_chksum_update16(ip->chksum, htons(0x1234),
+				     htons(0xfedc));
+	ip->id[0] = 0xfe;
+	ip->id[1] = 0xdc;
+
+	ip->chksum = 0U;
+	zassert_equal(chksum, htons(~ref_chksum(0, hdr, sizeof(hdr))),
+		      "Wrong updated checksum");
+}
+#else
+static void test_chksum_fragments(void)
+{
+	ztest_test_skip();
+}
+
+static void test_chksum_copy(void)
+{
+	ztest_test_skip();
+}
+
+static void test_chksum_update(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_IPV4 */
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum_fragments),
+			 ztest_unit_test(test_chksum_copy),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }
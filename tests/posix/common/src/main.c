@@ -11,6 +11,7 @@ extern void test_posix_clock(void);
 extern void test_posix_mqueue(void);
 extern void test_posix_normal_mutex(void);
 extern void test_posix_recursive_mutex(void);
+extern void test_posix_spinlock(void);
 extern void test_posix_semaphore(void);
 extern void test_posix_rw_lock(void);
 extern void test_posix_realtime(void);
@@ -46,6 +47,7 @@ void test_main(void)
 			ztest_unit_test(test_posix_semaphore),
 			ztest_unit_test(test_posix_normal_mutex),
 			ztest_unit_test(test_posix_recursive_mutex),
+			ztest_unit_test(test_posix_spinlock),
 			ztest_unit_test(test_posix_mqueue),
 			ztest_unit_test(test_posix_realtime),
 			ztest_unit_test(test_posix_timer),
@@ -162,3 +162,32 @@ void test_posix_recursive_mutex(void)
 	temp = pthread_mutex_destroy(&mutex2);
 	zassert_false(temp, "Destroying mutex2 is failed");
 }
+
+/**
+ * @brief Test to demonstrate pthread spinlock locking
+ *
+ * @details Test locks and unlocks a spinlock, checking a busy one
+ * is reported by trylock and can't be destroyed.
+ */
+void test_posix_spinlock(void)
+{
+	pthread_spinlock_t lock;
+
+	zassert_equal(pthread_spin_init(&lock, PTHREAD_PROCESS_PRIVATE), 0,
+		      "spinlock initialization failed");
+	zassert_equal(pthread_spin_lock(&lock), 0, "spinlock locking failed");
+	zassert_equal(pthread_spin_trylock(&lock), EBUSY,
+		      "locked spinlock acquired");
+	zassert_equal(pthread_spin_destroy(&lock), EBUSY,
+		      "locked spinlock destroyed");
+	zassert_equal(pthread_spin_unlock(&lock), 0,
+		      "spinlock unlocking failed");
+	zassert_equal(pthread_spin_unlock(&lock), EPERM,
+		      "unlocked spinlock unlocked again");
+	zassert_equal(pthread_spin_trylock(&lock), 0,
+		      "free spinlock not acquired");
+	zassert_equal(pthread_spin_unlock(&lock), 0,
+		      "spinlock unlocking failed");
+	zassert_equal(pthread_spin_destroy(&lock), 0,
+		      "spinlock destruction failed");
+}
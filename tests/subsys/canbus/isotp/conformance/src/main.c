@@ -37,6 +37,8 @@
 #define STMIN_VAL_1        5
 #define STMIN_VAL_2        50
 #define STMIN_UPPER_TOLERANCE 5
+#define STMIN_VAL_US       0xF5
+#define STMIN_US           500
 
 #define CEIL(A, B) (((A) + (B) - 1) / (B))
 
@@ -756,6 +758,52 @@ static void test_stmin(void)
 	can_detach(can_dev, filter_id);
 }
 
+/*
+ * Separation times in the 100 us range are shorter than a tick on most
+ * boards, they must neither be shortened nor rounded up to a whole tick.
+ */
+static void test_stmin_us(void)
+{
+	int filter_id, ret;
+	struct frame_desired fc_frame, ff_frame;
+	struct zcan_frame raw_frame;
+	uint32_t start_time, time_diff;
+
+	ff_frame.data[0] = FF_PCI_BYTE_1(DATA_SIZE_FF + DATA_SIZE_CF * 2);
+	ff_frame.data[1] = FF_PCI_BYTE_2(DATA_SIZE_FF + DATA_SIZE_CF * 2);
+	memcpy(&ff_frame.data[2], random_data, DATA_SIZE_FF);
+	ff_frame.length = DATA_SIZE_FF + 2;
+
+	fc_frame.data[0] = FC_PCI_BYTE_1(FC_PCI_CTS);
+	fc_frame.data[1] = FC_PCI_BYTE_2(2);
+	fc_frame.data[2] = FC_PCI_BYTE_3(STMIN_VAL_US);
+	fc_frame.length = 3;
+
+	filter_id = attach_msgq(rx_addr.std_id);
+	zassert_true((filter_id >= 0), "Negative filter number [%d]",
+		     filter_id);
+
+	send_test_data(random_data, DATA_SIZE_FF + DATA_SIZE_CF * 2);
+
+	check_frame_series(&ff_frame, 1, &frame_msgq);
+
+	send_frame_series(&fc_frame, 1, tx_addr.std_id);
+
+	ret = k_msgq_get(&frame_msgq, &raw_frame, K_MSEC(100));
+	zassert_equal(ret, 0, "Expected to get a message. [%d]", ret);
+
+	start_time = k_cycle_get_32();
+	ret = k_msgq_get(&frame_msgq, &raw_frame,
+			 K_MSEC(STMIN_UPPER_TOLERANCE));
+	time_diff = k_cyc_to_us_floor32(k_cycle_get_32() - start_time);
+	zassert_equal(ret, 0, "Expected to get a message within %dms. [%d]",
+		      STMIN_UPPER_TOLERANCE, ret);
+	zassert_true(time_diff >= STMIN_US, "STmin too short (%dus)",
+		     time_diff);
+
+	can_detach(can_dev, filter_id);
+}
+
 void test_receiver_fc_errors(void)
 {
 	int ret, filter_id;
@@ -899,6 +947,7 @@ void test_main(void)
 			 ztest_unit_test(test_send_timeouts),
 			 ztest_unit_test(test_receive_timeouts),
 			 ztest_unit_test(test_stmin),
+			 ztest_unit_test(test_stmin_us),
 			 ztest_unit_test(test_receiver_fc_errors),
 			 ztest_unit_test(test_sender_fc_errors)
 			 );
@@ -158,12 +158,223 @@ void test_check_flash(void)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_STREAM_HASH
+#include <tinycrypt/sha256.h>
+
+#define RESUME_IMG_LEN 1500
+#define RESUME_CKPT_LEN 300
+
+static uint8_t resume_img[RESUME_IMG_LEN];
+
+void test_resume(void)
+{
+	uint8_t sha[TC_SHA256_DIGEST_SIZE];
+	struct tc_sha256_state_struct s;
+	struct flash_img_check fic = { sha, sizeof(resume_img) };
+	struct flash_img_hash_ckpt ckpt;
+	struct flash_img_context ctx;
+	size_t written;
+	int ret;
+
+	for (size_t i = 0; i < sizeof(resume_img); i++) {
+		resume_img[i] = i * 7;
+	}
+	(void)tc_sha256_init(&s);
+	(void)tc_sha256_update(&s, resume_img, sizeof(resume_img));
+	(void)tc_sha256_final(sha, &s);
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	/* Download interrupted after a checkpoint */
+	ret = flash_img_buffered_write(&ctx, resume_img, RESUME_CKPT_LEN,
+				       false);
+	zassert_true(ret == 0, "Flash img buffered write");
+	ret = flash_img_hash_checkpoint(&ctx, &ckpt);
+	zassert_true(ret == 0, "Flash img hash checkpoint");
+	zassert_equal(ckpt.len, RESUME_CKPT_LEN, "Wrong checkpoint length");
+	ret = flash_img_buffered_write(&ctx, resume_img + RESUME_CKPT_LEN,
+				       CONFIG_IMG_BLOCK_BUF_SIZE, false);
+	zassert_true(ret == 0, "Flash img buffered write");
+	written = flash_img_bytes_written(&ctx);
+	zassert_true(written > RESUME_CKPT_LEN, "Nothing written to flash");
+	flash_area_close(ctx.flash_area);
+
+	ret = flash_img_init_resume(&ctx, FLASH_AREA_ID(image_1), &ckpt,
+				    RESUME_CKPT_LEN - 1);
+	zassert_equal(ret, -EINVAL, "Resume before the checkpoint");
+
+	ret = flash_img_init_resume(&ctx, FLASH_AREA_ID(image_1), &ckpt,
+				    written);
+	zassert_true(ret == 0, "Flash img init resume (%d)", ret);
+	zassert_equal(flash_img_bytes_written(&ctx), written,
+		      "Resumed at a wrong offset");
+	ret = flash_img_buffered_write(&ctx, resume_img + written,
+				       sizeof(resume_img) - written, true);
+	zassert_true(ret == 0, "Flash img buffered write");
+
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	zassert_true(ret == 0, "Flash img check of the running hash");
+
+	/* The flash contents match the running hash too */
+	fic.clen--;
+	(void)tc_sha256_init(&s);
+	(void)tc_sha256_update(&s, resume_img, fic.clen);
+	(void)tc_sha256_final(sha, &s);
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	zassert_true(ret == 0, "Flash img check from flash");
+}
+#else
+void test_resume(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_IMG_STREAM_HASH */
+
+#ifdef CONFIG_IMG_DELTA
+#include <sys/byteorder.h>
+
+#define DELTA_SRC_LEN 1024
+#define DELTA_DST_LEN 1100
+#define DELTA_CHUNK 7
+
+static uint8_t delta_src[DELTA_SRC_LEN];
+static uint8_t delta_dst[DELTA_DST_LEN];
+static uint8_t delta_patch[12 + 2 * 12 + DELTA_DST_LEN];
+
+static size_t delta_record(uint8_t *p, uint32_t diff, uint32_t extra,
+			   int32_t seek)
+{
+	sys_put_le32(diff, &p[0]);
+	sys_put_le32(extra, &p[4]);
+	sys_put_le32(seek, &p[8]);
+
+	return 12;
+}
+
+static size_t delta_build(void)
+{
+	uint8_t *p = delta_patch;
+	size_t i;
+
+	for (i = 0; i < DELTA_SRC_LEN; i++) {
+		delta_src[i] = i * 3;
+	}
+
+	/* Some changed bytes, inserted bytes, then the source tail */
+	(void)memcpy(delta_dst, delta_src, 600);
+	delta_dst[10] ^= 0x55;
+	delta_dst[599] = 0;
+	for (i = 600; i < 700; i++) {
+		delta_dst[i] = i;
+	}
+	(void)memcpy(&delta_dst[700], &delta_src[624], 400);
+
+	sys_put_le32(FLASH_IMG_DELTA_MAGIC, &p[0]);
+	sys_put_le32(DELTA_SRC_LEN, &p[4]);
+	sys_put_le32(DELTA_DST_LEN, &p[8]);
+	p += 12;
+
+	p += delta_record(p, 600, 100, 24);
+	for (i = 0; i < 600; i++) {
+		*p++ = delta_dst[i] - delta_src[i];
+	}
+	(void)memcpy(p, &delta_dst[600], 100);
+	p += 100;
+
+	p += delta_record(p, 400, 0, 0);
+	for (i = 0; i < 400; i++) {
+		*p++ = delta_dst[700 + i] - delta_src[624 + i];
+	}
+
+	return p - delta_patch;
+}
+
+void test_delta(void)
+{
+	struct flash_img_delta_ctx dctx;
+	struct flash_img_context ctx;
+	const struct flash_area *fa;
+	uint8_t buf[DELTA_CHUNK];
+	size_t patch_len;
+	size_t i;
+	int ret;
+
+	patch_len = delta_build();
+
+	ret = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	zassert_true(ret == 0, "Flash area open");
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_area_write(fa, 0, delta_src, sizeof(delta_src));
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_img_delta_init_id(&dctx, &ctx, FLASH_AREA_ID(image_1));
+	zassert_equal(ret, -EINVAL, "Source and target are the same area");
+
+	/* A patch ending within a record is refused */
+	ret = flash_img_delta_init_id(&dctx, &ctx, FLASH_AREA_ID(storage));
+	zassert_true(ret == 0, "Flash img delta init (%d)", ret);
+	ret = flash_img_delta_write(&dctx, delta_patch, 20, true);
+	zassert_equal(ret, -EINVAL, "Truncated patch applied");
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_img_delta_init_id(&dctx, &ctx, FLASH_AREA_ID(storage));
+	zassert_true(ret == 0, "Flash img delta init (%d)", ret);
+	for (i = 0; i < patch_len; i += DELTA_CHUNK) {
+		ret = flash_img_delta_write(&dctx, &delta_patch[i],
+					    MIN(DELTA_CHUNK, patch_len - i),
+					    false);
+		zassert_true(ret == 0, "Flash img delta write (%d)", ret);
+	}
+	ret = flash_img_delta_write(&dctx, NULL, 0, true);
+	zassert_true(ret == 0, "Flash img delta flush (%d)", ret);
+	zassert_equal(flash_img_bytes_written(&ctx), DELTA_DST_LEN,
+		      "Wrong target image length");
+
+	ret = flash_area_open(FLASH_AREA_ID(image_1), &fa);
+	zassert_true(ret == 0, "Flash area open");
+	for (i = 0; i < DELTA_DST_LEN; i += sizeof(buf)) {
+		size_t n = MIN(sizeof(buf), DELTA_DST_LEN - i);
+
+		ret = flash_area_read(fa, i, buf, n);
+		zassert_true(ret == 0, "Flash read failure (%d)", ret);
+		zassert_true(memcmp(buf, &delta_dst[i], n) == 0,
+			     "Wrong target image at %zu", i);
+	}
+
+	/* A bad magic is refused */
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_img_delta_init_id(&dctx, &ctx, FLASH_AREA_ID(storage));
+	zassert_true(ret == 0, "Flash img delta init (%d)", ret);
+	delta_patch[0] ^= 1;
+	ret = flash_img_delta_write(&dctx, delta_patch, patch_len, true);
+	zassert_equal(ret, -EINVAL, "Bad magic accepted");
+}
+#else
+void test_delta(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_IMG_DELTA */
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
 			ztest_unit_test(test_collecting),
 			ztest_unit_test(test_init_id),
-			ztest_unit_test(test_check_flash)
+			ztest_unit_test(test_check_flash),
+			ztest_unit_test(test_resume),
+			ztest_unit_test(test_delta)
 			);
 	ztest_run_test_suite(test_util);
 }
@@ -17,6 +17,7 @@ void test_main(void)
 			 ztest_unit_test(test_fat_dir),
 			 ztest_unit_test(test_fat_fs),
 			 ztest_unit_test(test_fat_rename),
+			 ztest_unit_test(test_fat_prealloc),
 			 ztest_unit_test(test_fs_open_flags),
 			 ztest_unit_test(test_fat_unmount),
 			 ztest_unit_test(test_fat_mount_rd_only));
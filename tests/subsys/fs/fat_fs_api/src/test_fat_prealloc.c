@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fat.h"
+#include <string.h>
+
+#define PREALLOC_FILE	FATFS_MNTP"/prealloc.bin"
+#define PREALLOC_SIZE	16384
+#define CHUNK		512
+
+static uint8_t wbuf[CHUNK];
+static uint8_t rbuf[CHUNK];
+
+static void fill(uint8_t seed)
+{
+	for (size_t i = 0; i < sizeof(wbuf); i++) {
+		wbuf[i] = seed + i;
+	}
+}
+
+#if defined(CONFIG_FS_FATFS_EXPAND)
+void test_fat_prealloc(void)
+{
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	off_t pos;
+
+	zassert_equal(fs_open(&file, PREALLOC_FILE, FS_O_CREATE | FS_O_RDWR),
+		      0, "open failed");
+	zassert_equal(fs_preallocate(&file, 0), -EINVAL,
+		      "empty preallocation");
+	zassert_equal(fs_preallocate(&file, PREALLOC_SIZE), 0,
+		      "preallocation failed");
+	zassert_equal(fs_preallocate(&file, PREALLOC_SIZE), -EINVAL,
+		      "preallocation of a file which is not empty");
+	zassert_equal(fs_sync(&file), 0, "sync failed");
+	zassert_equal(fs_stat(PREALLOC_FILE, &entry), 0, "stat failed");
+	zassert_equal(entry.size, PREALLOC_SIZE, "wrong preallocated size");
+
+	/* Record within the preallocated storage, seeking back and forth */
+	for (pos = 0; pos < PREALLOC_SIZE; pos += CHUNK) {
+		fill(pos / CHUNK);
+		zassert_equal(fs_write(&file, wbuf, CHUNK), CHUNK,
+			      "write failed");
+	}
+
+	for (pos = PREALLOC_SIZE - CHUNK; pos >= 0; pos -= 4 * CHUNK) {
+		fill(pos / CHUNK);
+		zassert_equal(fs_seek(&file, pos, FS_SEEK_SET), 0,
+			      "seek failed");
+		zassert_equal(fs_read(&file, rbuf, CHUNK), CHUNK,
+			      "read failed");
+		zassert_mem_equal(rbuf, wbuf, CHUNK, "wrong data at %d",
+				  (int)pos);
+	}
+
+	/* Keep the recorded length, then grow past it */
+	zassert_equal(fs_truncate(&file, 4 * CHUNK), 0, "truncate failed");
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_END), 0, "seek failed");
+	fill(0xa5);
+	zassert_equal(fs_write(&file, wbuf, CHUNK), CHUNK, "write failed");
+	zassert_equal(fs_close(&file), 0, "close failed");
+
+	zassert_equal(fs_stat(PREALLOC_FILE, &entry), 0, "stat failed");
+	zassert_equal(entry.size, 5 * CHUNK, "wrong truncated size");
+
+	zassert_equal(fs_open(&file, PREALLOC_FILE, FS_O_READ), 0,
+		      "open failed");
+	zassert_equal(fs_preallocate(&file, PREALLOC_SIZE), -EINVAL,
+		      "preallocation of a file which is not empty");
+	zassert_equal(fs_seek(&file, 4 * CHUNK, FS_SEEK_SET), 0,
+		      "seek failed");
+	zassert_equal(fs_read(&file, rbuf, CHUNK), CHUNK, "read failed");
+	zassert_mem_equal(rbuf, wbuf, CHUNK, "wrong data past the truncation");
+	fill(2);
+	zassert_equal(fs_seek(&file, 2 * CHUNK, FS_SEEK_SET), 0,
+		      "seek failed");
+	zassert_equal(fs_read(&file, rbuf, CHUNK), CHUNK, "read failed");
+	zassert_mem_equal(rbuf, wbuf, CHUNK, "wrong data");
+	zassert_equal(fs_close(&file), 0, "close failed");
+
+	zassert_equal(fs_unlink(PREALLOC_FILE), 0, "unlink failed");
+}
+#else
+void test_fat_prealloc(void)
+{
+	struct fs_file_t file;
+
+	zassert_equal(fs_open(&file, PREALLOC_FILE, FS_O_CREATE | FS_O_RDWR),
+		      0, "open failed");
+	zassert_equal(fs_preallocate(&file, PREALLOC_SIZE), -ENOTSUP,
+		      "preallocation without CONFIG_FS_FATFS_EXPAND");
+	zassert_equal(fs_close(&file), 0, "close failed");
+	zassert_equal(fs_unlink(PREALLOC_FILE), 0, "unlink failed");
+}
+#endif /* CONFIG_FS_FATFS_EXPAND */
@@ -8,7 +8,8 @@
 /* amount of file system */
 #define NUM_FS 2
 #define TEST_FS_NAND1 "/NAND:"
-#define TEST_FS_NAND2 "/MMCBLOCK:"
+/* nested in the first one, to check the longest match wins */
+#define TEST_FS_NAND2 TEST_FS_NAND1"/MMCBLOCK:"
 
 static struct test_fs_data test_data;
 
@@ -67,6 +68,22 @@ static int test_fs_readmount(void)
 	return TC_FAIL;
 }
 
+static int test_fs_resolve(const char *path, struct fs_mount_t *expected)
+{
+	struct fs_dir_t dir = { 0 };
+	int ret;
+
+	ret = fs_opendir(&dir, path);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = (dir.mp == expected) ? 0 : TC_FAIL;
+	(void)fs_closedir(&dir);
+
+	return ret;
+}
+
 static int test_fs_deinit(void)
 {
 	if (fs_unregister(TEST_FS_1, &temp_fs)) {
@@ -117,6 +134,13 @@ void test_fs_register(void)
 {
 	zassert_true(test_fs_init() == 0, "Failed to register filesystems");
 	zassert_true(test_fs_readmount() == 0, "Failed to readmount");
+	zassert_true(test_fs_resolve(TEST_FS_NAND1"/dir", &test_fs_mnt_1) == 0,
+		     "Failed to resolve outer mount point");
+	zassert_true(test_fs_resolve(TEST_FS_NAND2"/dir", &test_fs_mnt_2) == 0,
+		     "Failed to resolve nested mount point");
+	zassert_true(test_fs_resolve(TEST_FS_NAND1"/MMCBLOCK:x",
+				     &test_fs_mnt_1) == 0,
+		     "Failed to resolve mount point prefix");
 	zassert_true(test_fs_external() == 0, "Supported other file system");
 	zassert_true(test_fs_deinit() == 0, "Failed to unregister filesystems");
 }
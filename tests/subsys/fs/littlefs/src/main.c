@@ -24,7 +24,9 @@ void test_main(void)
 			 ztest_unit_test(test_lfs_dirops),
 			 ztest_unit_test(test_lfs_perf),
 			 ztest_unit_test(test_fs_open_flags_lfs),
-			 ztest_unit_test(test_fs_mount_flags)
+			 ztest_unit_test(test_fs_mount_flags),
+			 ztest_unit_test(test_lfs_dt),
+			 ztest_unit_test(test_lfs_iov)
 			 );
 	ztest_run_test_suite(littlefs_test);
 }
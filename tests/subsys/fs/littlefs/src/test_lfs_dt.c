@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Mount point defined by a devicetree fstab entry */
+
+#include <string.h>
+#include <ztest.h>
+#include <fs/littlefs.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+
+#define FSTAB_NODE DT_NODELABEL(lfs_dt)
+
+#if DT_NODE_EXISTS(FSTAB_NODE)
+
+#define HELLO "hello"
+
+FS_FSTAB_DECLARE_ENTRY(FSTAB_NODE);
+
+void test_lfs_dt(void)
+{
+	struct fs_mount_t *mp = &FS_FSTAB_ENTRY(FSTAB_NODE);
+	struct fs_littlefs *fs = mp->fs_data;
+	struct fs_file_t file;
+	char buf[sizeof(HELLO)];
+	ssize_t len;
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_equal(fs_mount(mp), 0, "mount failed");
+
+	zassert_equal(fs->cfg.read_size, DT_PROP(FSTAB_NODE, read_size),
+		      "wrong read size");
+	zassert_equal(fs->cfg.cache_size, DT_PROP(FSTAB_NODE, cache_size),
+		      "wrong cache size");
+	zassert_equal(fs->cfg.lookahead_size,
+		      DT_PROP(FSTAB_NODE, lookahead_size),
+		      "wrong lookahead size");
+
+	zassert_equal(fs_open(&file, "/dtm/hello", FS_O_CREATE | FS_O_RDWR),
+		      0, "open failed");
+	len = fs_write(&file, HELLO, sizeof(HELLO));
+	zassert_equal(len, sizeof(HELLO), "write failed: %d", (int)len);
+	zassert_equal(fs_close(&file), 0, "close failed");
+
+	zassert_equal(fs_open(&file, "/dtm/hello", FS_O_READ), 0,
+		      "open failed");
+	len = fs_read(&file, buf, sizeof(buf));
+	zassert_equal(len, sizeof(HELLO), "read failed: %d", (int)len);
+	zassert_mem_equal(buf, HELLO, sizeof(HELLO), "wrong content");
+	zassert_equal(fs_close(&file), 0, "close failed");
+
+	zassert_equal(fs_unmount(mp), 0, "unmount failed");
+}
+
+#else
+
+void test_lfs_dt(void)
+{
+	ztest_test_skip();
+}
+
+#endif /* DT_NODE_EXISTS(FSTAB_NODE) */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Vectored, in place and asynchronous file operations */
+
+#include <string.h>
+#include <ztest.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+
+#define HDR "hdr:"
+#define PAYLOAD "payload"
+#define RECORD HDR PAYLOAD
+
+static struct fs_mount_t *mp = &testfs_small_mnt;
+
+static void check_record(struct fs_file_t *file)
+{
+	char hdr[sizeof(HDR) - 1];
+	char payload[sizeof(PAYLOAD) - 1];
+	struct fs_iovec iov[] = {
+		{ .base = hdr, .len = sizeof(hdr) },
+		{ .base = payload, .len = sizeof(payload) },
+	};
+	ssize_t len;
+
+	len = fs_readv(file, iov, ARRAY_SIZE(iov));
+	zassert_equal(len, sizeof(RECORD) - 1, "readv failed: %d", (int)len);
+	zassert_mem_equal(hdr, HDR, sizeof(hdr), "wrong header");
+	zassert_mem_equal(payload, PAYLOAD, sizeof(payload), "wrong payload");
+}
+
+static void test_iov(const char *path)
+{
+	struct fs_iovec iov[] = {
+		{ .base = (void *)HDR, .len = sizeof(HDR) - 1 },
+		{ .base = (void *)PAYLOAD, .len = sizeof(PAYLOAD) - 1 },
+	};
+	char buf[2 * sizeof(RECORD)];
+	struct fs_iovec tail = { .base = buf, .len = sizeof(buf) };
+	struct fs_file_t file;
+	ssize_t len;
+
+	zassert_equal(fs_open(&file, path, FS_O_CREATE | FS_O_RDWR), 0,
+		      "open failed");
+	len = fs_writev(&file, iov, ARRAY_SIZE(iov));
+	zassert_equal(len, sizeof(RECORD) - 1, "writev failed: %d", (int)len);
+	zassert_equal(fs_close(&file), 0, "close failed");
+
+	zassert_equal(fs_open(&file, path, FS_O_READ), 0, "open failed");
+	check_record(&file);
+
+	/* Reads stop at the end of the file */
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_SET), 0, "seek failed");
+	len = fs_readv(&file, &tail, 1);
+	zassert_equal(len, sizeof(RECORD) - 1, "readv failed: %d", (int)len);
+	zassert_mem_equal(buf, RECORD, sizeof(RECORD) - 1, "wrong content");
+	zassert_equal(fs_readv(&file, &tail, 1), 0, "read past the end");
+	zassert_equal(fs_close(&file), 0, "close failed");
+}
+
+/* A file this small is inlined, its data is in the file cache */
+static void test_mmap(const char *path)
+{
+	struct fs_file_t file;
+	const void *addr;
+
+	zassert_equal(fs_open(&file, path, FS_O_READ), 0, "open failed");
+	zassert_equal(fs_mmap(&file, 0, sizeof(RECORD) - 1, &addr), 0,
+		      "mmap failed");
+	zassert_mem_equal(addr, RECORD, sizeof(RECORD) - 1, "wrong content");
+	zassert_equal(fs_mmap(&file, sizeof(HDR) - 1, sizeof(PAYLOAD) - 1,
+			      &addr), 0, "mmap failed");
+	zassert_mem_equal(addr, PAYLOAD, sizeof(PAYLOAD) - 1,
+			  "wrong content");
+	zassert_equal(fs_mmap(&file, 1, sizeof(RECORD) - 1, &addr), -EINVAL,
+		      "mmap past the end");
+	zassert_equal(fs_close(&file), 0, "close failed");
+}
+
+#ifdef CONFIG_FILE_SYSTEM_ASYNC
+
+static void test_iov_async(const char *path)
+{
+	struct fs_iovec iov[] = {
+		{ .base = (void *)HDR, .len = sizeof(HDR) - 1 },
+		{ .base = (void *)PAYLOAD, .len = sizeof(PAYLOAD) - 1 },
+	};
+	struct k_poll_signal signal;
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &signal);
+	struct fs_async_req req = { .signal = &signal };
+	struct fs_file_t file;
+	unsigned int signaled;
+	int result;
+
+	zassert_equal(fs_open(&file, path, FS_O_CREATE | FS_O_RDWR), 0,
+		      "open failed");
+
+	k_poll_signal_init(&signal);
+	zassert_equal(fs_writev_async(&file, iov, ARRAY_SIZE(iov), &req), 0,
+		      "submit failed");
+	zassert_equal(k_poll(&event, 1, K_SECONDS(5)), 0, "no completion");
+	k_poll_signal_check(&signal, &signaled, &result);
+	zassert_equal(result, sizeof(RECORD) - 1, "write failed: %d", result);
+
+	event.state = K_POLL_STATE_NOT_READY;
+	k_poll_signal_init(&signal);
+	zassert_equal(fs_sync_async(&file, &req), 0, "submit failed");
+	zassert_equal(k_poll(&event, 1, K_SECONDS(5)), 0, "no completion");
+	k_poll_signal_check(&signal, &signaled, &result);
+	zassert_equal(result, 0, "sync failed: %d", result);
+
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_SET), 0, "seek failed");
+	check_record(&file);
+	zassert_equal(fs_close(&file), 0, "close failed");
+}
+
+#endif /* CONFIG_FILE_SYSTEM_ASYNC */
+
+void test_lfs_iov(void)
+{
+	struct testfs_path path;
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_equal(fs_mount(mp), 0, "mount failed");
+
+	test_iov(testfs_path_init(&path, mp, "iov", TESTFS_PATH_END));
+	test_mmap(path.path);
+
+#ifdef CONFIG_FILE_SYSTEM_ASYNC
+	test_iov_async(testfs_path_init(&path, mp, "async",
+					TESTFS_PATH_END));
+#endif
+
+	zassert_equal(fs_unmount(mp), 0, "unmount failed");
+}
@@ -30,4 +30,10 @@ void test_fs_open_flags_lfs(void);
 /* Test fs_mount flags */
 void test_fs_mount_flags(void);
 
+/* Tests in test_lfs_dt */
+void test_lfs_dt(void);
+
+/* Tests in test_lfs_iov */
+void test_lfs_iov(void);
+
 #endif /* _ZEPHYR_TESTS_SUBSYS_FS_LITTLEFS_TESTFS_TESTS_H_ */
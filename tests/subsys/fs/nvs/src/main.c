@@ -714,6 +714,116 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+void test_nvs_cache(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	int err;
+	ssize_t len;
+	uint8_t buf[32] = { 0x55 };
+	uint8_t rd_buf[32];
+	uint32_t cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	uint32_t *flash_read_stat;
+
+	fs.sector_count = TEST_SECTOR_COUNT;
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	stats_walk(sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+
+	/* An id missing from the empty cache is not searched in flash. */
+	*flash_read_stat = 0;
+	len = nvs_read(&fs, TEST_DATA_ID, rd_buf, sizeof(rd_buf));
+	zassert_true(len == -ENOENT, "nvs_read unexpected failure: %d", len);
+	zassert_equal(*flash_read_stat, 0, "Unexpected flash reads");
+
+	len = nvs_write(&fs, TEST_DATA_ID, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+
+	/* The cached ate is read directly, followed by the data. */
+	*flash_read_stat = 0;
+	len = nvs_read(&fs, TEST_DATA_ID, rd_buf, sizeof(rd_buf));
+	zassert_true(len == sizeof(rd_buf), "nvs_read unexpected failure: %d",
+		     len);
+	zassert_equal(*flash_read_stat, 2, "Unexpected flash reads");
+
+	write_content(64, 0, 3 * 64, &fs);
+	memcpy(cache, fs.lookup_cache, sizeof(cache));
+
+	/* The cache rebuilt from flash matches the one kept up to date. */
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	zassert_mem_equal(cache, fs.lookup_cache, sizeof(cache),
+			  "Rebuilt cache differs");
+	check_content(64, &fs);
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_nvs_gc_incremental(void)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint16_t writes = 0;
+	uint16_t steps, max_steps = 0;
+	uint32_t sector;
+	const uint16_t max_id = 10;
+
+	fs.sector_count = TEST_SECTOR_COUNT;
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	err = nvs_gc_step(&fs);
+	zassert_equal(err, 0, "Unexpected gc on an empty sector: %d", err);
+
+	/* Go around the sectors twice so that live entries get moved. */
+	for (int round = 0; round < 2 * TEST_SECTOR_COUNT; round++) {
+		while (fs.ate_wra - fs.data_wra >=
+		       CONFIG_NVS_GC_INCREMENTAL_THRESHOLD) {
+			write_content(max_id, writes, writes + 1, &fs);
+			writes++;
+		}
+		zassert_true(writes >= max_id, "Sector filled too early");
+
+		sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+		steps = 0;
+		do {
+			err = nvs_gc_step(&fs);
+			zassert_true(err >= 0, "nvs_gc_step call failure: %d",
+				     err);
+			steps++;
+		} while (err);
+
+		zassert_not_equal(fs.ate_wra >> ADDR_SECT_SHIFT, sector,
+				  "Write sector was not closed");
+		max_steps = MAX(max_steps, steps);
+		check_content(max_id, &fs);
+	}
+	zassert_true(max_steps > 1, "No sector collected incrementally");
+
+	/* The collection is not repeated until new data is written. */
+	err = nvs_gc_step(&fs);
+	zassert_equal(err, 0, "Unexpected gc: %d", err);
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	check_content(max_id, &fs);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -737,7 +847,11 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_incremental, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
@@ -19,6 +19,8 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <string.h>
+#include <errno.h>
 #include <ztest.h>
 #include <data/json.h>
 #include <data/jwt.h>
@@ -57,10 +59,51 @@ void test_jwt(void)
 	printk("len: %zd\n", jwt_payload_len(&build));
 }
 
+void test_jwt_cache(void)
+{
+	static char buf[460];
+	static char first[sizeof(buf)];
+	struct jwt_cache cache;
+	int32_t now = 1530308426;
+	int res;
+
+	jwt_cache_init(&cache, buf, sizeof(buf));
+
+	res = jwt_cache_get(&cache, now, 3600, "iot-work-199419",
+			    jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, 0, "Signing token");
+	zassert_equal(cache.len, strlen(buf), "Token length");
+	strcpy(first, buf);
+
+	/* Still valid, the same token is returned */
+	res = jwt_cache_get(&cache, now + 3600 - CONFIG_JWT_CACHE_MARGIN - 1,
+			    3600, "iot-work-199419",
+			    jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, 0, "Getting cached token");
+	zassert_equal(strcmp(buf, first), 0, "Token signed again");
+
+	/* About to expire, a fresh token is signed */
+	res = jwt_cache_get(&cache, now + 3600 - CONFIG_JWT_CACHE_MARGIN,
+			    3600, "iot-work-199419",
+			    jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, 0, "Signing fresh token");
+	zassert_not_equal(strcmp(buf, first), 0, "Token not signed again");
+	zassert_equal(cache.exp, now + 2 * 3600 - CONFIG_JWT_CACHE_MARGIN,
+		      "Fresh token expiration");
+
+	/* Too small a buffer leaves no token */
+	jwt_cache_init(&cache, buf, 64);
+	res = jwt_cache_get(&cache, now, 3600, "iot-work-199419",
+			    jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, -ENOMEM, "Overflow not detected");
+	zassert_equal(cache.len, 0, "Token cached after overflow");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_jwt_test,
-		ztest_unit_test(test_jwt));
+		ztest_unit_test(test_jwt),
+		ztest_unit_test(test_jwt_cache));
 
 	ztest_run_test_suite(lib_jwt_test);
 }
@@ -217,6 +217,54 @@ static void test_log_backend_runtime_filtering(void)
 		      "Unexpected amount of messages received by the backend.");
 }
 
+static int arg_evaluations;
+
+static int arg_get(void)
+{
+	arg_evaluations++;
+
+	return 0;
+}
+
+/*
+ * Test is using 2 backends and runtime filtering is enabled. The aggregated
+ * level checked by the log calls follows the most verbose backend filter, and
+ * the arguments of filtered out messages are not evaluated.
+ */
+static void test_log_runtime_level(void)
+{
+	log_setup(true);
+
+	arg_evaluations = 0;
+
+	log_filter_set(&backend1, CONFIG_LOG_DOMAIN_ID, test_source_id,
+		       LOG_LEVEL_WRN);
+	log_filter_set(&backend2, CONFIG_LOG_DOMAIN_ID, test_source_id,
+		       LOG_LEVEL_ERR);
+	zassert_equal(*log_dynamic_level_get(test_source_id), LOG_LEVEL_WRN,
+		      "Unexpected aggregated level.");
+
+	LOG_INF("test %d", arg_get());
+	while (log_process(false)) {
+	}
+
+	zassert_equal(0, arg_evaluations, "Filtered out arguments evaluated.");
+	zassert_equal(0, backend1_cb.counter, "Unexpected message.");
+
+	log_filter_set(&backend2, CONFIG_LOG_DOMAIN_ID, test_source_id,
+		       LOG_LEVEL_INF);
+	zassert_equal(*log_dynamic_level_get(test_source_id), LOG_LEVEL_INF,
+		      "Unexpected aggregated level.");
+
+	LOG_INF("test %d", arg_get());
+	while (log_process(false)) {
+	}
+
+	zassert_equal(1, arg_evaluations, "Arguments not evaluated.");
+	zassert_equal(0, backend1_cb.counter, "Unexpected message.");
+	zassert_equal(1, backend2_cb.counter, "Message not received.");
+}
+
 /*
  * When LOG_MOVE_OVERFLOW is enabled, logger should discard oldest messages when
  * there is no room. However, if after discarding all messages there is still no
@@ -531,6 +579,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_log_list,
 			 ztest_unit_test(test_log_backend_runtime_filtering),
+			 ztest_unit_test(test_log_runtime_level),
 			 ztest_unit_test(test_log_overflow),
 			 ztest_unit_test(test_log_arguments),
 			 ztest_unit_test(test_log_from_declared_module),
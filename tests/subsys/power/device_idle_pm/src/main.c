@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <device.h>
+#include <power/power.h>
+
+#define PARENT_NAME "pm_parent"
+#define CHILD_NAME "pm_child"
+
+#define AUTOSUSPEND_MS 50
+
+/* Power state transitions, in the order they happened */
+static const struct device *transitions[4];
+static uint32_t transition_states[4];
+static int num_transitions;
+
+static const struct device *parent;
+static const struct device *child;
+
+/*
+ * Weak power hook functions. Used on systems that have not implemented
+ * power management.
+ */
+__weak void sys_set_power_state(enum power_states state)
+{
+	ARG_UNUSED(state);
+}
+
+__weak void _sys_pm_power_state_exit_post_ops(enum power_states state)
+{
+	ARG_UNUSED(state);
+
+	irq_unlock(0);
+}
+
+enum power_states sys_pm_policy_next_state(int32_t ticks)
+{
+	ARG_UNUSED(ticks);
+
+	return SYS_POWER_STATE_ACTIVE;
+}
+
+static int dummy_pm_ctrl(const struct device *dev, uint32_t ctrl_command,
+			 void *context, device_pm_cb cb, void *arg)
+{
+	uint32_t *state = dev->data;
+	int ret = 0;
+
+	switch (ctrl_command) {
+	case DEVICE_PM_SET_POWER_STATE:
+		*state = *((uint32_t *)context);
+		if (num_transitions < ARRAY_SIZE(transitions)) {
+			transitions[num_transitions] = dev;
+			transition_states[num_transitions] = *state;
+		}
+		num_transitions++;
+		break;
+	case DEVICE_PM_GET_POWER_STATE:
+		*((uint32_t *)context) = *state;
+		break;
+	default:
+		ret = -EINVAL;
+	}
+
+	if (cb != NULL) {
+		cb(dev, ret, context, arg);
+	}
+
+	return ret;
+}
+
+static int parent_init(const struct device *dev)
+{
+	device_pm_enable(dev);
+
+	return 0;
+}
+
+static int child_init(const struct device *dev)
+{
+	device_pm_parent_set(dev, device_get_binding(PARENT_NAME));
+	device_pm_enable(dev);
+
+	return 0;
+}
+
+static uint32_t parent_state = DEVICE_PM_SUSPEND_STATE;
+static uint32_t child_state = DEVICE_PM_SUSPEND_STATE;
+
+DEVICE_DEFINE(pm_parent, PARENT_NAME, parent_init, dummy_pm_ctrl,
+	      &parent_state, NULL, APPLICATION, 0, NULL);
+DEVICE_DEFINE(pm_child, CHILD_NAME, child_init, dummy_pm_ctrl,
+	      &child_state, NULL, APPLICATION, 1, NULL);
+
+static void transition_check(int i, const struct device *dev,
+			     uint32_t state)
+{
+	zassert_equal(transitions[i], dev, "transition %d of wrong device", i);
+	zassert_equal(transition_states[i], state,
+		      "transition %d to wrong state", i);
+}
+
+/**
+ * @brief Test the parent is resumed before its child
+ *
+ * @see device_pm_parent_set(), device_pm_get_sync()
+ *
+ * @ingroup power_tests
+ */
+void test_parent_resumed_first(void)
+{
+	num_transitions = 0;
+
+	zassert_equal(device_pm_get_sync(child), 0, NULL);
+
+	zassert_equal(num_transitions, 2, NULL);
+	transition_check(0, parent, DEVICE_PM_ACTIVE_STATE);
+	transition_check(1, child, DEVICE_PM_ACTIVE_STATE);
+}
+
+/**
+ * @brief Test the parent is suspended after its child
+ *
+ * @see device_pm_put_sync()
+ *
+ * @ingroup power_tests
+ */
+void test_parent_suspended_last(void)
+{
+	num_transitions = 0;
+
+	zassert_equal(device_pm_put_sync(child), 0, NULL);
+	zassert_equal(child_state, DEVICE_PM_SUSPEND_STATE, NULL);
+
+	/* The parent is released asynchronously */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(num_transitions, 2, NULL);
+	transition_check(0, child, DEVICE_PM_SUSPEND_STATE);
+	transition_check(1, parent, DEVICE_PM_SUSPEND_STATE);
+}
+
+/**
+ * @brief Test a device used again within its autosuspend delay stays up
+ *
+ * @see device_pm_autosuspend_delay_set(), device_pm_put()
+ *
+ * @ingroup power_tests
+ */
+void test_autosuspend(void)
+{
+	device_pm_autosuspend_delay_set(child, AUTOSUSPEND_MS);
+
+	zassert_equal(device_pm_get_sync(child), 0, NULL);
+	num_transitions = 0;
+
+	zassert_equal(device_pm_put(child), 0, NULL);
+	k_sleep(K_MSEC(AUTOSUSPEND_MS / 5));
+	zassert_equal(child_state, DEVICE_PM_ACTIVE_STATE, NULL);
+
+	zassert_equal(device_pm_get_sync(child), 0, NULL);
+	zassert_equal(device_pm_put(child), 0, NULL);
+	zassert_equal(num_transitions, 0, "device suspended and resumed");
+
+	k_sleep(K_MSEC(2 * AUTOSUSPEND_MS));
+	zassert_equal(child_state, DEVICE_PM_SUSPEND_STATE, NULL);
+	zassert_equal(parent_state, DEVICE_PM_SUSPEND_STATE, NULL);
+
+	device_pm_autosuspend_delay_set(child, 0);
+}
+
+void test_main(void)
+{
+	parent = device_get_binding(PARENT_NAME);
+	child = device_get_binding(CHILD_NAME);
+	zassert_not_null(parent, NULL);
+	zassert_not_null(child, NULL);
+
+	ztest_test_suite(device_idle_pm_test,
+			 ztest_unit_test(test_parent_resumed_first),
+			 ztest_unit_test(test_parent_suspended_last),
+			 ztest_unit_test(test_autosuspend));
+	ztest_run_test_suite(device_idle_pm_test);
+}
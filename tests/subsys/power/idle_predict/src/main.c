@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <power/power.h>
+
+#define HISTORY CONFIG_SYS_PM_IDLE_PREDICT_HISTORY
+
+/*
+ * Weak power hook functions. Used on systems that have not implemented
+ * power management.
+ */
+__weak void sys_set_power_state(enum power_states state)
+{
+	ARG_UNUSED(state);
+}
+
+__weak void _sys_pm_power_state_exit_post_ops(enum power_states state)
+{
+	ARG_UNUSED(state);
+
+	irq_unlock(0);
+}
+
+/* Idle period of a given duration, as seen by the prediction */
+static void idle(int32_t ticks_expected, int32_t ticks)
+{
+	int64_t end;
+
+	(void)sys_pm_idle_predict(ticks_expected);
+
+	end = k_uptime_ticks() + ticks;
+	while (k_uptime_ticks() < end) {
+	}
+
+	sys_pm_idle_predict_exit();
+}
+
+/**
+ * @brief Test interrupts waking up before the timeout shorten the prediction
+ *
+ * @see sys_pm_idle_predict()
+ *
+ * @ingroup power_tests
+ */
+void test_predict_early_wakeups(void)
+{
+	int32_t predicted;
+	int i;
+
+	for (i = 0; i < HISTORY; i++) {
+		idle(10000, 3);
+	}
+
+	predicted = sys_pm_idle_predict(10000);
+	zassert_true(predicted >= 2 && predicted <= 4,
+		     "predicted %d ticks", predicted);
+
+	/* No timeout, the wakeup interval still is known */
+	predicted = sys_pm_idle_predict(K_TICKS_FOREVER);
+	zassert_true(predicted >= 2 && predicted <= 4,
+		     "predicted %d ticks", predicted);
+}
+
+/**
+ * @brief Test timeouts ending the idle periods are predicted as they are
+ *
+ * @see sys_pm_idle_predict()
+ *
+ * @ingroup power_tests
+ */
+void test_predict_timeouts(void)
+{
+	int32_t predicted;
+	int i;
+
+	for (i = 0; i < 2 * HISTORY; i++) {
+		idle(5, 5);
+	}
+
+	predicted = sys_pm_idle_predict(5);
+	zassert_true(predicted >= 4 && predicted <= 5,
+		     "predicted %d ticks", predicted);
+}
+
+/**
+ * @brief Test irregular wakeups give no prediction, one outlier does
+ *
+ * @see sys_pm_idle_predict()
+ *
+ * @ingroup power_tests
+ */
+void test_predict_irregular(void)
+{
+	int32_t predicted;
+	int i;
+
+	for (i = 0; i < HISTORY; i++) {
+		idle(K_TICKS_FOREVER, 3 * (i + 1));
+	}
+
+	predicted = sys_pm_idle_predict(K_TICKS_FOREVER);
+	zassert_equal(predicted, K_TICKS_FOREVER, "predicted %d ticks",
+		      predicted);
+
+	for (i = 0; i < HISTORY; i++) {
+		idle(K_TICKS_FOREVER, i == 1 ? 100 : 20);
+	}
+
+	predicted = sys_pm_idle_predict(K_TICKS_FOREVER);
+	zassert_true(predicted >= 19 && predicted <= 21,
+		     "predicted %d ticks", predicted);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(idle_predict_test,
+			 ztest_unit_test(test_predict_early_wakeups),
+			 ztest_unit_test(test_predict_timeouts),
+			 ztest_unit_test(test_predict_irregular));
+	ztest_run_test_suite(idle_predict_test);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <power/power.h>
+#include <pm_policy.h>
+
+#define TICKS_SLEEP_2 (CONFIG_SYS_PM_MIN_RESIDENCY_SLEEP_2 * \
+		       CONFIG_SYS_CLOCK_TICKS_PER_SEC / MSEC_PER_SEC)
+
+/*
+ * Weak power hook functions. Used on systems that have not implemented
+ * power management.
+ */
+__weak void sys_set_power_state(enum power_states state)
+{
+	ARG_UNUSED(state);
+}
+
+__weak void _sys_pm_power_state_exit_post_ops(enum power_states state)
+{
+	ARG_UNUSED(state);
+
+	/* _sys_suspend is entered with irq locked
+	 * unlock irq before leave _sys_suspend
+	 */
+	irq_unlock(0);
+}
+
+/**
+ * @brief Test the deepest state is selected without constraint
+ *
+ * @ingroup power_tests
+ */
+void test_latency_none(void)
+{
+	zassert_equal(sys_pm_latency_max_get(), SYS_PM_LATENCY_NONE, NULL);
+	zassert_equal(sys_pm_policy_next_state(K_TICKS_FOREVER),
+		      SYS_POWER_STATE_SLEEP_2, NULL);
+	zassert_equal(sys_pm_policy_next_state(TICKS_SLEEP_2),
+		      SYS_POWER_STATE_SLEEP_2, NULL);
+}
+
+/**
+ * @brief Test the states which wake up too slowly are not selected
+ *
+ * @see sys_pm_latency_request_add(), sys_pm_latency_request_update(),
+ *      sys_pm_latency_request_remove()
+ *
+ * @ingroup power_tests
+ */
+void test_latency_constraints(void)
+{
+	struct sys_pm_latency_request req1, req2;
+
+	sys_pm_latency_request_add(&req1, 500);
+	zassert_equal(sys_pm_latency_max_get(), 500, NULL);
+	zassert_equal(sys_pm_policy_next_state(K_TICKS_FOREVER),
+		      SYS_POWER_STATE_SLEEP_1, NULL);
+
+	/* The strictest constraint applies */
+	sys_pm_latency_request_add(&req2, 5);
+	zassert_equal(sys_pm_latency_max_get(), 5, NULL);
+	zassert_equal(sys_pm_policy_next_state(K_TICKS_FOREVER),
+		      SYS_POWER_STATE_ACTIVE, NULL);
+
+	sys_pm_latency_request_update(&req2, 2000);
+	zassert_equal(sys_pm_latency_max_get(), 500, NULL);
+	zassert_equal(sys_pm_policy_next_state(K_TICKS_FOREVER),
+		      SYS_POWER_STATE_SLEEP_1, NULL);
+
+	sys_pm_latency_request_remove(&req1);
+	zassert_equal(sys_pm_latency_max_get(), 2000, NULL);
+	zassert_equal(sys_pm_policy_next_state(K_TICKS_FOREVER),
+		      SYS_POWER_STATE_SLEEP_2, NULL);
+
+	sys_pm_latency_request_remove(&req2);
+	zassert_equal(sys_pm_latency_max_get(), SYS_PM_LATENCY_NONE, NULL);
+}
+
+/**
+ * @brief Test the idle time still limits the selected state
+ *
+ * @ingroup power_tests
+ */
+void test_latency_residency(void)
+{
+	struct sys_pm_latency_request req;
+
+	zassert_equal(sys_pm_policy_next_state(TICKS_SLEEP_2 - 1),
+		      SYS_POWER_STATE_SLEEP_1, NULL);
+
+	sys_pm_latency_request_add(&req, 5);
+	zassert_equal(sys_pm_policy_next_state(TICKS_SLEEP_2 - 1),
+		      SYS_POWER_STATE_ACTIVE, NULL);
+	sys_pm_latency_request_remove(&req);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(power_latency_test,
+			 ztest_unit_test(test_latency_none),
+			 ztest_unit_test(test_latency_constraints),
+			 ztest_unit_test(test_latency_residency));
+	ztest_run_test_suite(power_latency_test);
+}
@@ -158,6 +158,39 @@ void test_flash_area_check_int_sha256(void)
 	flash_area_close(fa);
 }
 
+void test_flash_area_mmap(void)
+{
+	const struct flash_area *fa;
+	const void *ptr;
+	uint8_t wd[64];
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(image_1), &fa);
+	zassert_true(rc == 0, "flash_area_open() fail");
+
+	rc = flash_area_mmap(fa, 0, sizeof(wd), &ptr);
+	if (!IS_ENABLED(CONFIG_FLASH_XIP_API)) {
+		zassert_equal(rc, -ENOTSUP, "mmap without XIP API, error %d",
+			      rc);
+		return;
+	}
+	zassert_true(rc == 0, "flash_area_mmap() fail, error %d", rc);
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(rc == 0, "flash area erase fail");
+
+	(void)memset(wd, 0x5a, sizeof(wd));
+	rc = flash_area_write(fa, 0, wd, sizeof(wd));
+	zassert_true(rc == 0, "flash_area_write() fail");
+	zassert_mem_equal(ptr, wd, sizeof(wd), "mapped data != write data");
+
+	rc = flash_area_mmap(fa, fa->fa_size - sizeof(wd), sizeof(wd) + 1,
+			     &ptr);
+	zassert_equal(rc, -EINVAL, "mmap out of the area, error %d", rc);
+
+	flash_area_close(fa);
+}
+
 void test_flash_area_erased_val(void)
 {
 	const struct flash_parameters *param;
@@ -181,7 +214,8 @@ void test_main(void)
 	ztest_test_suite(test_flash_map,
 			 ztest_unit_test(test_flash_area_erased_val),
 			 ztest_unit_test(test_flash_area_get_sectors),
-			 ztest_unit_test(test_flash_area_check_int_sha256)
+			 ztest_unit_test(test_flash_area_check_int_sha256),
+			 ztest_unit_test(test_flash_area_mmap)
 			);
 	ztest_run_test_suite(test_flash_map);
 }
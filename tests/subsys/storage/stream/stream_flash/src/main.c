@@ -375,6 +375,82 @@ static void test_stream_flash_buffered_write_whole_page(void)
 }
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+static void test_stream_flash_pipeline(void)
+{
+	int rc;
+	size_t len = BUF_LEN + BUF_LEN / 4;
+
+	init_target();
+
+	rc = stream_flash_pipeline_enable(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Fill two halves of the buffer and a quarter of the next one */
+	rc = stream_flash_buffered_write(&ctx, write_buf, len, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The first half is written, the second one may be in flight */
+	zassert_true(stream_flash_bytes_written(&ctx) >= BUF_LEN / 2,
+		     "first half should be written");
+
+	/* A flush waits for all the data */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "all the data should be written");
+
+	VERIFY_WRITTEN(0, len);
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+static void test_stream_flash_pipeline_pre_erase(void)
+{
+	int rc;
+
+	init_target();
+
+	/* Dirty the second page, which has to be erased ahead of the data */
+	rc = flash_write_protection_set(fdev, false);
+	zassert_equal(rc, 0, "should succeed");
+	rc = flash_write(fdev, FLASH_BASE + page_size, write_buf, BUF_LEN);
+	zassert_equal(rc, 0, "should succeed");
+	rc = flash_write_protection_set(fdev, true);
+	zassert_equal(rc, 0, "should succeed");
+
+	rc = stream_flash_pipeline_enable(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, page_size);
+	VERIFY_ERASED(page_size, page_size);
+
+	/* Data going into the erased page does not erase it again */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, page_size + BUF_LEN);
+}
+#else
+static void test_stream_flash_pipeline_pre_erase(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+#else
+static void test_stream_flash_pipeline(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_pipeline_pre_erase(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -395,7 +471,9 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_flush),
 	     ztest_unit_test(test_stream_flash_buffered_write_whole_page),
 	     ztest_unit_test(test_stream_flash_erase_page),
-	     ztest_unit_test(test_stream_flash_bytes_written)
+	     ztest_unit_test(test_stream_flash_bytes_written),
+	     ztest_unit_test(test_stream_flash_pipeline),
+	     ztest_unit_test(test_stream_flash_pipeline_pre_erase)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);
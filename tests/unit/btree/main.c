@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <sys/btree.h>
+
+#include "../../../lib/os/btree.c"
+
+#define NUM_ELEMS 256
+#define NUM_KEYS 64
+
+struct elem {
+	int key;
+	int id;
+};
+
+static struct elem elems[NUM_ELEMS];
+static bool in_tree[NUM_ELEMS];
+static struct btree_node nodes[NUM_ELEMS];
+static struct btree tree;
+
+static bool elem_lessthan(const void *a, const void *b)
+{
+	return ((const struct elem *)a)->key < ((const struct elem *)b)->key;
+}
+
+/* Check the order, the insertion order of equal elements and the count */
+static void check_tree(void)
+{
+	struct elem *e, *prev = NULL;
+	size_t count = 0, expected = 0;
+
+	BTREE_FOR_EACH(&tree, e) {
+		zassert_true(in_tree[e->id], "element %d not inserted", e->id);
+		if (prev != NULL) {
+			zassert_true(prev->key <= e->key, "order violated");
+		}
+		prev = e;
+		count++;
+	}
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		expected += in_tree[i];
+	}
+
+	zassert_equal(count, expected, "walked %u of %u elements",
+		      (unsigned int)count, (unsigned int)expected);
+	zassert_equal(btree_count(&tree), expected, "wrong count");
+}
+
+void test_btree_spam(void)
+{
+	uint32_t seed = 1U;
+
+	btree_init(&tree, elem_lessthan, nodes, ARRAY_SIZE(nodes));
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		elems[i].key = (i * 37) % NUM_KEYS;
+		elems[i].id = i;
+		in_tree[i] = false;
+	}
+
+	for (int n = 0; n < 20000; n++) {
+		int i;
+
+		seed = seed * 1103515245U + 12345U;
+		i = (seed >> 16) % NUM_ELEMS;
+
+		if (in_tree[i]) {
+			zassert_true(btree_contains(&tree, &elems[i]), NULL);
+			zassert_equal(btree_remove(&tree, &elems[i]), 0, NULL);
+			in_tree[i] = false;
+			zassert_false(btree_contains(&tree, &elems[i]), NULL);
+		} else {
+			zassert_equal(btree_remove(&tree, &elems[i]), -ENOENT,
+				      NULL);
+			zassert_equal(btree_insert(&tree, &elems[i]), 0, NULL);
+			in_tree[i] = true;
+		}
+
+		if (n % 101 == 0) {
+			check_tree();
+		}
+	}
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		if (in_tree[i]) {
+			zassert_equal(btree_remove(&tree, &elems[i]), 0, NULL);
+			in_tree[i] = false;
+		}
+	}
+
+	check_tree();
+	zassert_is_null(btree_get_min(&tree), "tree not empty");
+}
+
+void test_btree_equal_order(void)
+{
+	struct elem *e, *prev = NULL;
+	struct elem key = { .key = 3 };
+
+	btree_init(&tree, elem_lessthan, nodes, ARRAY_SIZE(nodes));
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		elems[i].key = i % 5;
+		elems[i].id = i;
+		zassert_equal(btree_insert(&tree, &elems[i]), 0, NULL);
+	}
+
+	/* Equal elements come out in insertion order */
+	BTREE_FOR_EACH(&tree, e) {
+		if (prev != NULL && prev->key == e->key) {
+			zassert_true(prev->id < e->id, "insertion order lost");
+		}
+		prev = e;
+	}
+
+	zassert_equal_ptr(btree_find(&tree, &key), &elems[3], NULL);
+	zassert_equal_ptr(btree_get_min(&tree), &elems[0], NULL);
+	zassert_equal(((struct elem *)btree_get_max(&tree))->key, 4, NULL);
+
+	key.key = 5;
+	zassert_is_null(btree_find(&tree, &key), NULL);
+}
+
+void test_btree_pool_exhausted(void)
+{
+	static struct btree_node few[2];
+	int inserted = 0;
+
+	btree_init(&tree, elem_lessthan, few, ARRAY_SIZE(few));
+
+	for (int i = 0; i < NUM_ELEMS; i++) {
+		elems[i].key = i;
+		elems[i].id = i;
+		in_tree[i] = false;
+	}
+
+	while (inserted < NUM_ELEMS &&
+	       btree_insert(&tree, &elems[inserted]) == 0) {
+		in_tree[inserted++] = true;
+	}
+
+	zassert_true(inserted < NUM_ELEMS, "pool never exhausted");
+	zassert_equal(btree_insert(&tree, &elems[inserted]), -ENOMEM, NULL);
+
+	/* The tree is still usable after a failed insert */
+	check_tree();
+	zassert_equal(btree_remove(&tree, &elems[0]), 0, NULL);
+	in_tree[0] = false;
+	check_tree();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_btree,
+			 ztest_unit_test(test_btree_spam),
+			 ztest_unit_test(test_btree_equal_order),
+			 ztest_unit_test(test_btree_pool_exhausted));
+	ztest_run_test_suite(test_btree);
+}
@@ -23,6 +23,23 @@ void test_crc32_ieee(void)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4, NULL);
 }
 
+void test_crc32_ieee_update(void)
+{
+	static uint8_t test[256 + 1];
+	uint32_t crc;
+
+	for (int i = 0; i < 256; i++) {
+		test[i + 1] = i;
+	}
+
+	/* Every split and alignment goes through the sliced loop */
+	for (size_t split = 0; split <= 256; split += 3) {
+		crc = crc32_ieee_update(0, &test[1], split);
+		crc = crc32_ieee_update(crc, &test[1 + split], 256 - split);
+		zassert_equal(crc, 0x29058C73, "split %u", (unsigned int)split);
+	}
+}
+
 void test_crc16(void)
 {
 	uint8_t test0[] = { };
@@ -206,6 +223,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_crc,
 			 ztest_unit_test(test_crc32_ieee),
+			 ztest_unit_test(test_crc32_ieee_update),
 			 ztest_unit_test(test_crc16),
 			 ztest_unit_test(test_crc16_ansi),
 			 ztest_unit_test(test_crc16_ccitt),
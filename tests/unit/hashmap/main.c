@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <stdlib.h>
+#include <sys/hashmap.h>
+
+#include "../../../lib/os/hashmap.c"
+
+#define NUM_KEYS 1000
+#define NUM_SLOTS 64
+
+static bool present[NUM_KEYS];
+static struct sys_hashmap_slot slots[NUM_SLOTS];
+static struct sys_hashmap map;
+
+static int num_allocs;
+
+static void *test_realloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		num_allocs--;
+		free(ptr);
+		return NULL;
+	}
+
+	num_allocs += ptr == NULL;
+
+	return realloc(ptr, size);
+}
+
+#define INT_KEY(i) ((const void *)(uintptr_t)(i))
+#define VALUE(i) ((void *)(uintptr_t)((i) * 3U))
+
+/* Check every key against the reference, and the iteration */
+static void check_map(void)
+{
+	struct sys_hashmap_iter iter;
+	size_t count = 0, expected = 0;
+	void *value;
+
+	for (int i = 0; i < NUM_KEYS; i++) {
+		bool found = sys_hashmap_get(&map, INT_KEY(i), &value);
+
+		zassert_equal(found, present[i], "key %d", i);
+		if (found) {
+			zassert_equal((uintptr_t)value, i * 3U, "key %d", i);
+		}
+		expected += present[i];
+	}
+
+	sys_hashmap_iter_init(&map, &iter);
+	while (sys_hashmap_iter_next(&map, &iter)) {
+		zassert_true(present[(uintptr_t)iter.key], NULL);
+		count++;
+	}
+
+	zassert_equal(count, expected, NULL);
+	zassert_equal(sys_hashmap_size(&map), expected, NULL);
+}
+
+static void spam(int range, int ops)
+{
+	uint32_t seed = 1U;
+
+	memset(present, 0, sizeof(present));
+
+	for (int n = 0; n < ops; n++) {
+		int i;
+
+		seed = seed * 1103515245U + 12345U;
+		i = (seed >> 16) % range;
+
+		if (present[i]) {
+			zassert_true(sys_hashmap_remove(&map, INT_KEY(i), NULL),
+				     NULL);
+			present[i] = false;
+		} else {
+			zassert_equal(sys_hashmap_insert(&map, INT_KEY(i),
+							 VALUE(i),
+							 NULL), 1, NULL);
+			present[i] = true;
+		}
+
+		if (n % 97 == 0) {
+			check_map();
+		}
+	}
+
+	check_map();
+}
+
+void test_hashmap_static(void)
+{
+	sys_hashmap_init(&map, slots, NUM_SLOTS, sys_hashmap_int_hash, NULL);
+
+	/* Fewer keys than slots, so the map never fills up */
+	spam(NUM_SLOTS, 20000);
+
+	sys_hashmap_clear(&map);
+	memset(present, 0, sizeof(present));
+	check_map();
+
+	for (int i = 0; i < NUM_SLOTS; i++) {
+		zassert_equal(sys_hashmap_insert(&map, INT_KEY(i),
+						 VALUE(i), NULL),
+			      1, NULL);
+		present[i] = true;
+	}
+
+	zassert_equal(sys_hashmap_insert(&map, INT_KEY(NUM_SLOTS), NULL, NULL),
+		      -ENOSPC, NULL);
+	check_map();
+}
+
+void test_hashmap_dynamic(void)
+{
+	sys_hashmap_init_dynamic(&map, sys_hashmap_int_hash, NULL,
+				 test_realloc);
+
+	zassert_false(sys_hashmap_get(&map, INT_KEY(0), NULL), NULL);
+	zassert_false(sys_hashmap_remove(&map, INT_KEY(0), NULL), NULL);
+
+	spam(NUM_KEYS, 50000);
+
+	zassert_equal(num_allocs, 1, NULL);
+	sys_hashmap_clear(&map);
+	zassert_equal(num_allocs, 0, NULL);
+}
+
+void test_hashmap_replace(void)
+{
+	void *old = NULL;
+
+	sys_hashmap_init(&map, slots, NUM_SLOTS, sys_hashmap_str_hash,
+			 sys_hashmap_str_equal);
+
+	zassert_equal(sys_hashmap_insert(&map, "foo", VALUE(1), NULL), 1,
+		      NULL);
+	zassert_equal(sys_hashmap_insert(&map, "bar", VALUE(2), NULL), 1,
+		      NULL);
+
+	/* Keys are compared by value, not by pointer */
+	zassert_equal(sys_hashmap_insert(&map, (char []){ "foo" }, VALUE(3),
+					 &old), 0, NULL);
+	zassert_equal_ptr(old, VALUE(1), NULL);
+	zassert_true(sys_hashmap_get(&map, "foo", &old), NULL);
+	zassert_equal_ptr(old, VALUE(3), NULL);
+	zassert_equal(sys_hashmap_size(&map), 2, NULL);
+}
+
+void test_hashmap_iter_remove(void)
+{
+	struct sys_hashmap_iter iter;
+	size_t visited = 0;
+
+	sys_hashmap_init(&map, slots, NUM_SLOTS, sys_hashmap_int_hash, NULL);
+	memset(present, 0, sizeof(present));
+
+	/* A full map maximizes the entries wrapping around the slots */
+	for (int i = 0; i < NUM_SLOTS; i++) {
+		zassert_equal(sys_hashmap_insert(&map, INT_KEY(i),
+						 VALUE(i), NULL),
+			      1, NULL);
+		present[i] = true;
+	}
+
+	sys_hashmap_iter_init(&map, &iter);
+	while (sys_hashmap_iter_next(&map, &iter)) {
+		uintptr_t i = (uintptr_t)iter.key;
+
+		zassert_true(present[i], "key %u seen twice", (unsigned int)i);
+		visited++;
+
+		if (i % 2 == 0) {
+			sys_hashmap_iter_remove(&map, &iter);
+			present[i] = false;
+		}
+	}
+
+	zassert_equal(visited, NUM_SLOTS, NULL);
+
+	for (int i = 0; i < NUM_SLOTS; i++) {
+		present[i] = i % 2;
+	}
+
+	check_map();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_hashmap,
+			 ztest_unit_test(test_hashmap_static),
+			 ztest_unit_test(test_hashmap_dynamic),
+			 ztest_unit_test(test_hashmap_replace),
+			 ztest_unit_test(test_hashmap_iter_remove));
+	ztest_run_test_suite(test_hashmap);
+}
@@ -8,6 +8,7 @@
 #include <sys/dlist.h>
 
 static sys_dlist_t test_list;
+static sys_dlist_t append_list;
 
 struct container_node {
 	sys_dnode_t node;
@@ -325,6 +326,57 @@ void test_dlist(void)
 		ii++;
 	}
 	zassert_equal(ii, 2, "");
+
+	/* test prefetching iterators */
+	ii = 0;
+	SYS_DLIST_FOR_EACH_NODE_PREFETCH(&test_list, node) {
+		zassert_equal(((struct data_node *)node)->data, ii, "");
+		ii++;
+	}
+	zassert_equal(ii, 6, "");
+
+	struct data_node *cnode;
+
+	ii = 0;
+	SYS_DLIST_FOR_EACH_CONTAINER_PREFETCH(&test_list, cnode, node) {
+		zassert_equal(cnode->data, ii, "");
+		ii++;
+	}
+	zassert_equal(ii, 6, "");
+
+	/* test sys_dlist_merge_dlist() */
+	sys_dlist_init(&append_list);
+	sys_dlist_merge_dlist(&test_list, &append_list);
+	zassert_true((verify_content_amount(&test_list, 6)),
+		     "test_list has wrong content");
+
+	for (ii = 3; ii < 6; ii++) {
+		sys_dlist_remove(&data_node[ii].node);
+		sys_dlist_append(&append_list, &data_node[ii].node);
+	}
+	sys_dlist_merge_dlist(&test_list, &append_list);
+	zassert_true((verify_emptyness(&append_list)),
+		     "merged list should be empty");
+	zassert_true((verify_tail_head(&test_list, &data_node[0].node,
+				       &data_node[5].node, false)),
+		     "test_list head/tail are wrong");
+
+	ii = 5;
+	for (node = sys_dlist_peek_tail(&test_list); node != NULL;
+	     node = sys_dlist_peek_prev(&test_list, node)) {
+		zassert_equal(((struct data_node *)node)->data, ii, "");
+		ii--;
+	}
+	zassert_equal(ii, -1, "");
+
+	sys_dlist_init(&test_list);
+	for (ii = 0; ii < 6; ii++) {
+		sys_dlist_append(&append_list, &data_node[ii].node);
+	}
+	sys_dlist_merge_dlist(&test_list, &append_list);
+	zassert_true((verify_tail_head(&test_list, &data_node[0].node,
+				       &data_node[5].node, false)),
+		     "test_list head/tail are wrong");
 }
 
 /**
@@ -178,6 +178,18 @@ static inline bool verify_tail_head(sys_slist_t *list,
  * sys_slist_remove(), sys_slist_get(), sys_slist_get_not_empty(),
  * sys_slist_append_list(), sys_slist_merge_list()
  */
+struct data_node {
+	sys_snode_t node;
+	int data;
+};
+
+static bool is_multiple_of(sys_snode_t *node, void *user_data)
+{
+	struct data_node *dnode = CONTAINER_OF(node, struct data_node, node);
+
+	return (dnode->data % (int)(uintptr_t)user_data) == 0;
+}
+
 void test_slist(void)
 {
 	sys_slist_init(&test_list);
@@ -283,10 +295,7 @@ void test_slist(void)
 		     "test_list should be empty");
 
 	/* test iterator from a node */
-	struct data_node {
-		sys_snode_t node;
-		int data;
-	} data_node[6] = {
+	struct data_node data_node[6] = {
 		{ .data = 0 },
 		{ .data = 1 },
 		{ .data = 2 },
@@ -385,6 +394,58 @@ void test_slist(void)
 	}
 	zassert_true(sys_slist_is_empty(&append_list),
 		     "merged list is not empty");
+
+	/* test prefetching iterators */
+	for (ii = 0; ii < 6; ii++) {
+		sys_slist_append(&test_list, &data_node[ii].node);
+	}
+
+	ii = 0;
+	SYS_SLIST_FOR_EACH_NODE_PREFETCH(&test_list, node) {
+		zassert_equal(((struct data_node *)node)->data, ii, "");
+		ii++;
+	}
+	zassert_equal(ii, 6, "");
+
+	struct data_node *cnode;
+
+	ii = 0;
+	SYS_SLIST_FOR_EACH_CONTAINER_PREFETCH(&test_list, cnode, node) {
+		zassert_equal(cnode->data, ii, "");
+		ii++;
+	}
+	zassert_equal(ii, 6, "");
+
+	/* test sys_slist_remove_if(), removing the head, the tail and a
+	 * node in the middle
+	 */
+	sys_slist_init(&append_list);
+	zassert_equal(sys_slist_remove_if(&test_list, &append_list,
+					  is_multiple_of, (void *)2), 3, "");
+	zassert_true((verify_tail_head(&test_list, &data_node[1].node,
+				       &data_node[5].node, false)),
+		     "test_list head/tail are wrong");
+	zassert_true((verify_tail_head(&append_list, &data_node[0].node,
+				       &data_node[4].node, false)),
+		     "removed list head/tail are wrong");
+
+	ii = 1;
+	SYS_SLIST_FOR_EACH_CONTAINER(&test_list, cnode, node) {
+		zassert_equal(cnode->data, ii, "");
+		ii += 2;
+	}
+	ii = 0;
+	SYS_SLIST_FOR_EACH_CONTAINER(&append_list, cnode, node) {
+		zassert_equal(cnode->data, ii, "");
+		ii += 2;
+	}
+
+	zassert_equal(sys_slist_remove_if(&test_list, NULL,
+					  is_multiple_of, (void *)2), 0, "");
+	zassert_equal(sys_slist_remove_if(&test_list, NULL,
+					  is_multiple_of, (void *)1), 3, "");
+	zassert_true((verify_emptyness(&test_list)),
+		     "test_list should be empty");
 }
 
 /**